@@ -0,0 +1,82 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Compare two benchmark results to detect regressions.
+see README.md for the usage of this script.
+
+Both the output of compile_and_run_bench.py and the JSON output of the C++ microbenchmarks
+(`cppbenchmark --benchmark_format=json`) are accepted. The exit code is 1 if any benchmark is
+slower than the baseline by more than the threshold, so that it can gate a CI job.
+"""
+import argparse
+import json
+import sys
+
+# The factors to convert the time units of Google Benchmark to nanoseconds
+_TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_results(path):
+    """Load the times of a result file in nanoseconds, keyed by the benchmark names"""
+    with open(path) as result_file:
+        report = json.load(result_file)
+    results = {}
+    for item in report["benchmarks"]:
+        # Only compare the aggregate of repeated runs, if any
+        if item.get("run_type") == "aggregate" and item.get("aggregate_name") != "median":
+            continue
+        if "error_occurred" in item:
+            continue
+        name = item.get("run_name", item["name"])
+        results[name] = item["real_time"] * _TIME_UNITS[item.get("time_unit", "ns")]
+    return results
+
+
+def compare(baseline, current, threshold):
+    """Print the relative change of each benchmark and return the names of the regressions"""
+    regressions = []
+    print("%-50s %12s %12s %8s" % ("Benchmark", "Baseline", "Current", "Change"))
+    for name in sorted(set(baseline) & set(current)):
+        change = current[name] / baseline[name] - 1 if baseline[name] > 0 else 0.0
+        flag = ""
+        if change > threshold:
+            regressions.append(name)
+            flag = "  <- regression"
+        print(
+            "%-50s %10.3fus %10.3fus %+7.1f%%%s"
+            % (name, baseline[name] / 1e3, current[name] / 1e3, change * 100, flag)
+        )
+    for name in sorted(set(baseline) - set(current)):
+        print("%-50s missing in the current results" % name)
+    return regressions
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("baseline", type=str, help="The JSON results of the baseline")
+    parser.add_argument("current", type=str, help="The JSON results to check")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.1,
+        help="The relative slowdown above which a benchmark is reported as a regression",
+    )
+    args = parser.parse_args()
+
+    found = compare(load_results(args.baseline), load_results(args.current), args.threshold)
+    if found:
+        print("%d benchmark(s) regressed by more than %.0f%%" % (len(found), args.threshold * 100))
+        sys.exit(1)
@@ -0,0 +1,179 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Compile-time and runtime benchmarks for regression tracking.
+see README.md for the usage of this script.
+
+The results are written as JSON, in the same layout as the output of the C++ microbenchmarks
+with `--benchmark_format=json`, so that both can be compared by compare_bench.py:
+
+    {"context": {...}, "benchmarks": [{"name": ..., "real_time": ..., "time_unit": "ms"}, ...]}
+"""
+import argparse
+import json
+import platform
+import time
+
+import numpy as np
+
+import tvm
+from tvm import relay, rpc
+from tvm.contrib import graph_executor
+from tvm.ir.instrument import PassProfilingInstrument
+from tvm.relay import vm as relay_vm
+from tvm.relay.scope_builder import ScopeBuilder
+from tvm.runtime import vm as runtime_vm
+
+from util import get_network
+
+# The passes whose compile time is reported on their own
+TRACKED_PASSES = ["InferType", "FuseOps", "EliminateCommonSubexpr", "FoldConstant", "AlterOpLayout"]
+
+
+def _result(name, value, unit="ms"):
+    return {"name": name, "real_time": value, "time_unit": unit}
+
+
+def _median_ms(func, repeat):
+    times = []
+    for _ in range(repeat):
+        start = time.perf_counter()
+        func()
+        times.append((time.perf_counter() - start) * 1e3)
+    return float(np.median(times))
+
+
+def benchmark_compile(network, target, repeat):
+    """Benchmark the whole build of a network, and the tracked passes in it"""
+    mod, params, _, _ = get_network(network, batch_size=1)
+    results = []
+    build_times = []
+    pass_times = {}
+    for _ in range(repeat):
+        profiler = PassProfilingInstrument(count_nodes=False)
+        start = time.perf_counter()
+        with tvm.transform.PassContext(opt_level=3, instruments=[profiler]):
+            lib = relay.build(mod, target=target, params=params)
+        build_times.append((time.perf_counter() - start) * 1e3)
+        totals = {}
+        for event in json.loads(profiler.as_trace_json())["traceEvents"]:
+            if event["cat"] == "pass" and event["name"] in TRACKED_PASSES:
+                totals[event["name"]] = totals.get(event["name"], 0.0) + event["dur"] / 1e3
+        for name, value in totals.items():
+            pass_times.setdefault(name, []).append(value)
+    results.append(_result("compile/%s/build" % network, float(np.median(build_times))))
+    for name, values in sorted(pass_times.items()):
+        results.append(_result("compile/%s/%s" % (network, name), float(np.median(values))))
+    return results, lib
+
+
+def benchmark_run(network, lib, dev, repeat):
+    """Benchmark the inference of a compiled network with the graph executor"""
+    module = graph_executor.GraphModule(lib["default"](dev))
+    _, _, input_shape, _ = get_network(network, batch_size=1)
+    module.set_input("data", np.random.uniform(size=input_shape).astype("float32"))
+    result = module.benchmark(dev, number=1, repeat=repeat)
+    return [_result("run/%s/graph_executor" % network, result.median * 1e3)]
+
+
+def benchmark_vm_dispatch(target, dev, repeat):
+    """Benchmark the dispatch of the VM on a loop of scalar operations, per iteration"""
+    mod = tvm.IRModule()
+    loop = relay.GlobalVar("loop")
+    i = relay.var("i", shape=[], dtype="int32")
+    accum = relay.var("accum", shape=[], dtype="int32")
+    sb = ScopeBuilder()
+    with sb.if_scope(relay.equal(i, relay.const(0, "int32"))):
+        sb.ret(accum)
+    with sb.else_scope():
+        one_less = relay.subtract(i, relay.const(1, "int32"))
+        sb.ret(relay.Call(loop, [one_less, relay.add(accum, i)]))
+    mod[loop] = relay.Function([i, accum], sb.get())
+    iarg = relay.var("i", shape=[], dtype="int32")
+    aarg = relay.var("accum", shape=[], dtype="int32")
+    mod["main"] = relay.Function([iarg, aarg], loop(iarg, aarg))
+    exe = relay_vm.compile(mod, target=target)
+    vm = runtime_vm.VirtualMachine(exe, dev)
+
+    num_iters = 1000
+    args = [np.array(num_iters, dtype="int32"), np.array(0, dtype="int32")]
+    vm.invoke("main", *args)
+    total_ms = _median_ms(lambda: vm.invoke("main", *args), repeat)
+    return [_result("run/vm_loop_iteration", total_ms * 1e3 / num_iters, "us")]
+
+
+def benchmark_rpc_round_trip(repeat):
+    """Benchmark the round trip of a remote call to a local RPC server"""
+    server = rpc.Server(host="127.0.0.1", port=9091, port_end=9199)
+    try:
+        remote = rpc.connect("127.0.0.1", server.port)
+        nop = remote.get_function("testing.nop")
+        nop()
+        num_calls = 100
+
+        def run():
+            for _ in range(num_calls):
+                nop()
+
+        total_ms = _median_ms(run, repeat)
+    finally:
+        server.terminate()
+    return [_result("run/rpc_round_trip", total_ms * 1e3 / num_calls, "us")]
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--network",
+        type=str,
+        choices=["resnet-18", "resnet-50", "mobilenet", "vgg-16", "squeezenet_v1.1"],
+        help="The name of neural network",
+    )
+    parser.add_argument("--target", type=str, default="llvm", help="The tvm compilation target")
+    parser.add_argument("--compile-repeat", type=int, default=3)
+    parser.add_argument("--repeat", type=int, default=50)
+    parser.add_argument("--output", type=str, help="The JSON file to write the results to")
+    args = parser.parse_args()
+
+    networks = ["resnet-18", "mobilenet"] if args.network is None else [args.network]
+    target = tvm.target.Target(args.target)
+    dev = tvm.device(str(target), 0)
+
+    benchmarks = []
+    for network in networks:
+        compile_results, compiled_lib = benchmark_compile(network, target, args.compile_repeat)
+        benchmarks += compile_results
+        benchmarks += benchmark_run(network, compiled_lib, dev, args.repeat)
+    benchmarks += benchmark_vm_dispatch(target, dev, args.repeat)
+    benchmarks += benchmark_rpc_round_trip(args.repeat)
+
+    report = {
+        "context": {
+            "tvm_version": tvm.__version__,
+            "target": str(target),
+            "host": platform.node(),
+            "date": time.strftime("%Y-%m-%d %H:%M:%S"),
+        },
+        "benchmarks": benchmarks,
+    }
+    print("--------------------------------------------------")
+    print("%-45s %s" % ("Benchmark", "Median Time"))
+    print("--------------------------------------------------")
+    for item in benchmarks:
+        print("%-45s %.3f %s" % (item["name"], item["real_time"], item["time_unit"]))
+    if args.output:
+        with open(args.output, "w") as out_file:
+            json.dump(report, out_file, indent=2)
@@ -0,0 +1,123 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file compile_bench.cc
+ * \brief Microbenchmarks of the compilation phases on a reference convolutional network: type
+ * inference, operator fusion, common subexpression elimination, and the LLVM codegen.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/driver/driver_api.h>
+#include <tvm/relay/parser.h>
+#include <tvm/relay/transform.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/target/target.h>
+#include <tvm/te/operation.h>
+
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+using namespace tvm;
+
+/*!
+ * \brief A ResNet-like chain of `num_layers` blocks of conv2d, bias add, relu and a residual add,
+ * which is the reference model of the compile benchmarks.
+ */
+IRModule ReferenceModel(int num_layers) {
+  std::ostringstream os;
+  os << "#[version = \"0.0.5\"]\n"
+     << "def @main(%data: Tensor[(1, 64, 56, 56), float32]";
+  for (int i = 0; i < num_layers; ++i) {
+    os << ", %w" << i << ": Tensor[(64, 64, 3, 3), float32], %b" << i
+       << ": Tensor[(64, 1, 1), float32]";
+  }
+  os << ") {\n  %x0 = %data;\n";
+  for (int i = 0; i < num_layers; ++i) {
+    os << "  %c" << i << " = nn.conv2d(%x" << i << ", %w" << i
+       << ", padding=[1, 1, 1, 1], channels=64, kernel_size=[3, 3]);\n"
+       << "  %r" << i << " = nn.relu(add(%c" << i << ", %b" << i << "));\n"
+       << "  %x" << i + 1 << " = add(%r" << i << ", %x" << i << ");\n";
+  }
+  os << "  %x" << num_layers << "\n}\n";
+  return relay::ParseModule("reference_model", os.str());
+}
+
+constexpr int kNumLayers = 32;
+
+void BM_InferType(benchmark::State& state) {
+  IRModule mod = ReferenceModel(kNumLayers);
+  transform::Pass pass = relay::transform::InferType();
+  for (auto _ : state) {
+    IRModule result = pass(mod);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_InferType)->Unit(benchmark::kMillisecond);
+
+void BM_FuseOps(benchmark::State& state) {
+  IRModule mod = relay::transform::InferType()(ReferenceModel(kNumLayers));
+  transform::Pass pass = relay::transform::FuseOps(2);
+  for (auto _ : state) {
+    IRModule result = pass(mod);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_FuseOps)->Unit(benchmark::kMillisecond);
+
+void BM_EliminateCommonSubexpr(benchmark::State& state) {
+  IRModule mod = relay::transform::InferType()(ReferenceModel(kNumLayers));
+  transform::Pass pass = relay::transform::EliminateCommonSubexpr();
+  for (auto _ : state) {
+    IRModule result = pass(mod);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_EliminateCommonSubexpr)->Unit(benchmark::kMillisecond);
+
+void BM_LLVMCodegen(benchmark::State& state) {
+  if (runtime::Registry::Get("target.build.llvm") == nullptr) {
+    state.SkipWithError("TVM is built without LLVM");
+    return;
+  }
+  // An elementwise kernel per output, so that the codegen of many small functions is measured
+  te::Tensor a = te::placeholder({1024}, DataType::Float(32), "A");
+  Target target("llvm");
+  Map<Target, IRModule> inputs;
+  IRModule mod;
+  GlobalVarSupply global_var_supply(NameSupply(""));
+  for (int i = 0; i < kNumLayers; ++i) {
+    te::Tensor b = te::compute(
+        {1024}, [&](tir::Var x) { return a(x) * static_cast<float>(i) + 1.0f; }, "B");
+    te::Schedule sch = te::create_schedule({b->op});
+    std::unordered_map<te::Tensor, tir::Buffer> binds;
+    mod->Update(LowerSchedule(sch, Array<te::Tensor>{a, b}, "kernel_" + std::to_string(i), binds,
+                              global_var_supply));
+  }
+  inputs.Set(target, mod);
+  for (auto _ : state) {
+    runtime::Module lib = build(inputs, target);
+    benchmark::DoNotOptimize(lib);
+  }
+}
+BENCHMARK(BM_LLVMCodegen)->Unit(benchmark::kMillisecond);
+
+}  // namespace
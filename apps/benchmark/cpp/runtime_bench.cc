@@ -0,0 +1,122 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file runtime_bench.cc
+ * \brief Microbenchmarks of the runtime hot paths: PackedFunc calls, the parallel launch of the
+ * thread pool, workspace allocation and NDArray copies.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+
+#include <atomic>
+
+namespace {
+
+using namespace tvm::runtime;
+
+void BM_PackedFuncCall(benchmark::State& state) {
+  PackedFunc f([](TVMArgs args, TVMRetValue* rv) { *rv = args[0].operator int() + 1; });
+  int x = 0;
+  for (auto _ : state) {
+    x = f(x);
+  }
+  benchmark::DoNotOptimize(x);
+}
+BENCHMARK(BM_PackedFuncCall);
+
+void BM_TypedPackedFuncCall(benchmark::State& state) {
+  TypedPackedFunc<int(int)> f([](int x) { return x + 1; });
+  int x = 0;
+  for (auto _ : state) {
+    x = f(x);
+  }
+  benchmark::DoNotOptimize(x);
+}
+BENCHMARK(BM_TypedPackedFuncCall);
+
+void BM_PackedFuncCallObjectArg(benchmark::State& state) {
+  PackedFunc f([](TVMArgs args, TVMRetValue* rv) { *rv = args[0]; });
+  NDArray arr = NDArray::Empty({1}, DLDataType{kDLFloat, 32, 1}, DLDevice{kDLCPU, 0});
+  for (auto _ : state) {
+    NDArray ret = f(arr);
+    benchmark::DoNotOptimize(ret);
+  }
+}
+BENCHMARK(BM_PackedFuncCallObjectArg);
+
+void BM_RegistryGet(benchmark::State& state) {
+  for (auto _ : state) {
+    const PackedFunc* f = Registry::Get("runtime.GetDeviceAttr");
+    benchmark::DoNotOptimize(f);
+  }
+}
+BENCHMARK(BM_RegistryGet);
+
+int ParallelNop(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  static_cast<std::atomic<int>*>(cdata)->fetch_add(1, std::memory_order_relaxed);
+  return 0;
+}
+
+void BM_ParallelLaunch(benchmark::State& state) {
+  int num_task = state.range(0);
+  std::atomic<int> counter{0};
+  for (auto _ : state) {
+    TVMBackendParallelLaunch(ParallelNop, &counter, num_task);
+  }
+  benchmark::DoNotOptimize(counter.load());
+}
+// 0 launches on all the threads of the pool
+BENCHMARK(BM_ParallelLaunch)->Arg(0)->Arg(1)->Arg(4);
+
+void BM_WorkspaceAllocFree(benchmark::State& state) {
+  uint64_t nbytes = state.range(0);
+  for (auto _ : state) {
+    void* ptr = TVMBackendAllocWorkspace(kDLCPU, 0, nbytes, kDLFloat, 32);
+    benchmark::DoNotOptimize(ptr);
+    TVMBackendFreeWorkspace(kDLCPU, 0, ptr);
+  }
+}
+BENCHMARK(BM_WorkspaceAllocFree)->Arg(1 << 10)->Arg(1 << 20);
+
+void BM_NDArrayEmpty(benchmark::State& state) {
+  DLDataType dtype{kDLFloat, 32, 1};
+  for (auto _ : state) {
+    NDArray arr = NDArray::Empty({state.range(0)}, dtype, DLDevice{kDLCPU, 0});
+    benchmark::DoNotOptimize(arr);
+  }
+}
+BENCHMARK(BM_NDArrayEmpty)->Arg(1 << 10)->Arg(1 << 20);
+
+void BM_NDArrayCopy(benchmark::State& state) {
+  DLDataType dtype{kDLFloat, 32, 1};
+  NDArray src = NDArray::Empty({state.range(0)}, dtype, DLDevice{kDLCPU, 0});
+  NDArray dst = NDArray::Empty({state.range(0)}, dtype, DLDevice{kDLCPU, 0});
+  for (auto _ : state) {
+    dst.CopyFrom(src);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(float));
+}
+BENCHMARK(BM_NDArrayCopy)->Arg(1 << 10)->Arg(1 << 20);
+
+}  // namespace
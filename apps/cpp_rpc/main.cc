@@ -57,6 +57,9 @@ static const string kUsage =
     "--custom-addr - Custom IP Address to Report to RPC Tracker. Default=\"\"\n"
     "--work-dir    - Custom work directory. Default=\"\"\n"
     "--silent      - Whether to run in silent mode. Default=False\n"
+    "--max-sessions - The number of sessions served at once, sessions beyond the first one are\n"
+    "                 multiplexed in the server process instead of a forked one. Default=1\n"
+    "--preload     - Shared libraries loaded once by the server, comma separated. Default=\"\"\n"
     "\n"
     "  Example\n"
     "  ./tvm_rpc server --host=0.0.0.0 --port=9000 --port-end=9090 "
@@ -73,6 +76,8 @@ static const string kUsage =
  * \arg custom_addr Custom IP Address to Report to RPC Tracker. Default=""
  * \arg work_dir Custom work directory. Default=""
  * \arg silent Whether run in silent mode. Default=False
+ * \arg max_sessions The number of sessions served at once. Default=1
+ * \arg preload The shared libraries loaded by the server, separated by commas. Default=""
  */
 struct RpcServerArgs {
   string host = "0.0.0.0";
@@ -83,6 +88,8 @@ struct RpcServerArgs {
   string custom_addr;
   string work_dir;
   bool silent = false;
+  int max_sessions = 1;
+  string preload;
 #if defined(WIN32)
   std::string mmap_path;
 #endif
@@ -101,6 +108,8 @@ void PrintArgs(const RpcServerArgs& args) {
   LOG(INFO) << "custom_addr = " << args.custom_addr;
   LOG(INFO) << "work_dir    = " << args.work_dir;
   LOG(INFO) << "silent      = " << ((args.silent) ? ("True") : ("False"));
+  LOG(INFO) << "max_sessions = " << args.max_sessions;
+  LOG(INFO) << "preload     = " << args.preload;
 }
 
 #if defined(__linux__) || defined(__ANDROID__)
@@ -246,6 +255,21 @@ void ParseCmdArgs(int argc, char* argv[], struct RpcServerArgs& args) {
   if (!work_dir.empty()) {
     args.work_dir = work_dir;
   }
+
+  const string max_sessions = GetCmdOption(argc, argv, "--max-sessions=");
+  if (!max_sessions.empty()) {
+    if (!IsNumber(max_sessions) || stoi(max_sessions) < 1) {
+      LOG(WARNING) << "Wrong max-sessions number.";
+      LOG(INFO) << kUsage;
+      exit(1);
+    }
+    args.max_sessions = stoi(max_sessions);
+  }
+
+  const string preload = GetCmdOption(argc, argv, "--preload=");
+  if (!preload.empty()) {
+    args.preload = preload;
+  }
 }
 
 /*!
@@ -282,7 +306,7 @@ int RpcServer(int argc, char* argv[]) {
 #endif
 
   RPCServerCreate(args.host, args.port, args.port_end, args.tracker, args.key, args.custom_addr,
-                  args.work_dir, args.silent);
+                  args.work_dir, args.silent, args.max_sessions, args.preload);
   return 0;
 }
 
@@ -27,12 +27,16 @@
 #include <sys/select.h>
 #include <sys/wait.h>
 #endif
+#include <algorithm>
 #include <chrono>
 #include <future>
 #include <iostream>
+#include <memory>
 #include <set>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "../../src/runtime/rpc/rpc_endpoint.h"
 #include "../../src/runtime/rpc/rpc_socket_impl.h"
@@ -101,6 +105,11 @@ static std::string getNextString(std::stringstream* iss) {
  * \param key The key used to identify the device type in tracker.
  *
  * \param custom_addr Custom IP Address to Report to RPC Tracker.
+ *
+ * \param max_sessions The number of sessions served at once. One session is served at a time by
+ *     a forked process, more sessions are multiplexed in the server process.
+ *
+ * \param preload The shared libraries loaded by the server process, separated by commas.
  */
 class RPCServer {
  public:
@@ -108,7 +117,8 @@ class RPCServer {
    * \brief Constructor.
    */
   RPCServer(std::string host, int port_search_start, int port_search_end, std::string tracker_addr,
-            std::string key, std::string custom_addr, std::string work_dir)
+            std::string key, std::string custom_addr, std::string work_dir, int max_sessions = 1,
+            std::string preload = "")
       : host_(std::move(host)),
         port_search_start_(port_search_start),
         my_port_(0),
@@ -116,7 +126,15 @@ class RPCServer {
         tracker_addr_(std::move(tracker_addr)),
         key_(std::move(key)),
         custom_addr_(std::move(custom_addr)),
-        work_dir_(std::move(work_dir)) {}
+        work_dir_(std::move(work_dir)),
+        max_sessions_(std::max(max_sessions, 1)) {
+    for (const std::string& path : support::Split(preload, ',')) {
+      if (!path.empty()) {
+        LOG(INFO) << "preload " << path;
+        preloaded_.push_back(Module::LoadFromFile(path));
+      }
+    }
+  }
 
   /*!
    * \brief Destructor.
@@ -137,8 +155,11 @@ class RPCServer {
     listen_sock_.Create();
     my_port_ = listen_sock_.TryBindHost(host_, port_search_start_, port_search_end_);
     LOG(INFO) << "bind to " << host_ << ":" << my_port_;
-    listen_sock_.Listen(1);
-    std::future<void> proc(std::async(std::launch::async, &RPCServer::ListenLoopProc, this));
+    listen_sock_.Listen(max_sessions_);
+    std::future<void> proc(std::async(std::launch::async,
+                                      max_sessions_ > 1 ? &RPCServer::MultiSessionLoopProc
+                                                        : &RPCServer::ListenLoopProc,
+                                      this));
     proc.get();
     // Close the listen socket
     listen_sock_.Close();
@@ -240,6 +261,210 @@ class RPCServer {
     }
   }
 
+  /*! \brief A session served by MultiSessionLoopProc. */
+  struct Session {
+    support::TCPSocket sock;
+    support::SockAddr addr;
+    /*! \brief The event driven server of the session. */
+    PackedFunc handler;
+    /*! \brief Whether the server has pending bytes to send. */
+    bool need_write{false};
+    /*! \brief The time after which the session is closed, if timeout is set. */
+    steady_clock::time_point deadline{steady_clock::time_point::max()};
+  };
+
+  /*!
+   * \brief MultiSessionLoopProc The listen process which serves up to max_sessions_ sessions.
+   *
+   *  The sessions and the listen socket are polled by a single thread, and each session is
+   *  served by an event driven RPC server in this process, so a session pays neither fork nor
+   *  the initialization of the runtime. The sessions share the device, their requests are
+   *  handled one at a time, and the session served first rotates at every turn of the loop so
+   *  that a busy client cannot starve the others. A timeout closes a session between two of its
+   *  requests, it cannot interrupt a running one.
+   */
+  void MultiSessionLoopProc() {
+#if defined(__linux__) || defined(__ANDROID__) || defined(__APPLE__)
+    // A client that goes away must not kill the server through a write to its socket.
+    signal(SIGPIPE, SIG_IGN);
+#endif
+    const auto env = RPCEnv(work_dir_);
+    TrackerClient tracker(tracker_addr_, key_, custom_addr_, my_port_);
+    // The match keys reported to the tracker, and the number of checks they were not pending at.
+    std::unordered_map<std::string, int> matchkeys;
+    std::vector<std::unique_ptr<Session>> sessions;
+    size_t first = 0;
+    auto last_check = steady_clock::now();
+    // The period in seconds at which the tracker is checked.
+    const int ping_period = 2;
+    const int unmatch_timeout = 4;
+
+    while (true) {
+      try {
+        tracker.TryConnect();
+        // Offer the free slots to the tracker, a server without tracker accepts its key.
+        if (!tracker.IsValid()) {
+          matchkeys.clear();
+          matchkeys[key_] = 0;
+        }
+        while (tracker.IsValid() && matchkeys.size() + sessions.size() < max_sessions_) {
+          std::string matchkey;
+          tracker.ReportResourceAndGetKey(my_port_, &matchkey);
+          matchkeys[matchkey] = 0;
+        }
+        // Withdraw the keys which a client acquired but did not use for a while.
+        if (tracker.IsValid() && steady_clock::now() - last_check > seconds(ping_period)) {
+          last_check = steady_clock::now();
+          std::string pending_keys = tracker.GetPendingMatchKeys();
+          for (auto it = matchkeys.begin(); it != matchkeys.end();) {
+            it->second = pending_keys.find(it->first) == std::string::npos ? it->second + 1 : 0;
+            if (it->second * ping_period > unmatch_timeout + ping_period) {
+              LOG(INFO) << "no incoming connections, regenerate key ...";
+              it = matchkeys.erase(it);
+            } else {
+              ++it;
+            }
+          }
+        }
+      } catch (const std::exception& e) {
+        LOG(WARNING) << "Tracker exception: " << e.what();
+        tracker.Close();
+        matchkeys.clear();
+      }
+
+      support::PollHelper poller;
+      bool accepting = sessions.size() < max_sessions_ && !matchkeys.empty();
+      if (accepting) {
+        poller.WatchRead(listen_sock_.sockfd);
+      }
+      for (const auto& session : sessions) {
+        poller.WatchRead(session->sock.sockfd);
+        if (session->need_write) {
+          poller.WatchWrite(session->sock.sockfd);
+        }
+      }
+      poller.Poll(ping_period * 1000);
+
+      if (accepting && poller.CheckRead(listen_sock_.sockfd)) {
+        std::unique_ptr<Session> session = AcceptSession(&matchkeys, tracker.IsValid());
+        if (session != nullptr) {
+          sessions.push_back(std::move(session));
+        }
+      }
+
+      for (size_t k = 0; k < sessions.size(); ++k) {
+        Session* session = sessions[(first + k) % sessions.size()].get();
+        if (steady_clock::now() > session->deadline) {
+          LOG(INFO) << "Session " << session->addr.AsString() << " timed out";
+          CloseSession(session);
+          continue;
+        }
+        bool can_read = poller.CheckRead(session->sock.sockfd);
+        if (!can_read && !poller.CheckWrite(session->sock.sockfd)) {
+          continue;
+        }
+        try {
+          std::string in_bytes;
+          if (can_read) {
+            in_bytes.resize(kRecvChunkSize);
+            ssize_t nread = session->sock.Recv(&in_bytes[0], in_bytes.size());
+            if (nread == 0 || (nread == -1 && !support::Socket::LastErrorWouldBlock())) {
+              LOG(INFO) << "Finish serving " << session->addr.AsString();
+              CloseSession(session);
+              continue;
+            }
+            in_bytes.resize(std::max<ssize_t>(nread, 0));
+          }
+          int state = session->handler(in_bytes, 3);
+          if (state == 0) {
+            LOG(INFO) << "Finish serving " << session->addr.AsString();
+            CloseSession(session);
+          } else {
+            session->need_write = state == 2;
+          }
+        } catch (const std::exception& e) {
+          LOG(WARNING) << "Session " << session->addr.AsString() << " failed: " << e.what();
+          CloseSession(session);
+        }
+      }
+      sessions.erase(std::remove_if(sessions.begin(), sessions.end(),
+                                    [](const std::unique_ptr<Session>& session) {
+                                      return session->sock.IsClosed();
+                                    }),
+                     sessions.end());
+      first = sessions.empty() ? 0 : (first + 1) % sessions.size();
+    }
+  }
+
+  /*!
+   * \brief AcceptSession Accepts a connection and creates its session.
+   * \param matchkeys The match keys which are accepted, the key used by the session is removed
+   *     if it comes from the tracker.
+   * \param from_tracker Whether the match keys are reported to the tracker.
+   * \return The session, or nullptr if the handshake failed.
+   */
+  std::unique_ptr<Session> AcceptSession(std::unordered_map<std::string, int>* matchkeys,
+                                         bool from_tracker) {
+    std::unique_ptr<Session> session = std::make_unique<Session>();
+    session->sock = listen_sock_.Accept(&session->addr);
+    std::string opts;
+    std::string matchkey;
+    try {
+      std::set<std::string> keys;
+      for (const auto& kv : *matchkeys) {
+        keys.insert(kv.first);
+      }
+      if (!Handshake(&session->sock, session->addr, keys, &matchkey, &opts)) {
+        return nullptr;
+      }
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Handshake with " << session->addr.AsString() << " failed: " << e.what();
+      if (!session->sock.IsClosed()) {
+        session->sock.Close();
+      }
+      return nullptr;
+    }
+    if (from_tracker) {
+      matchkeys->erase(matchkey);
+    }
+    session->sock.SetNonBlock(true);
+    int timeout = GetTimeOutFromOpts(opts);
+    if (timeout != 0) {
+      session->deadline = steady_clock::now() + seconds(timeout);
+    }
+    support::TCPSocket sock = session->sock;
+    PackedFunc fsend([sock](TVMArgs args, TVMRetValue* rv) mutable {
+      ICHECK_EQ(args.type_codes[0], kTVMBytes);
+      const TVMByteArray* bytes = static_cast<const TVMByteArray*>(args.values[0].v_handle);
+#ifdef MSG_NOSIGNAL
+      ssize_t nsend = sock.Send(bytes->data, bytes->size, MSG_NOSIGNAL);
+#else
+      ssize_t nsend = sock.Send(bytes->data, bytes->size);
+#endif
+      if (nsend == -1 && support::Socket::LastErrorWouldBlock()) {
+        nsend = 0;
+      }
+      *rv = static_cast<int64_t>(nsend);
+    });
+    const PackedFunc* fcreate = Registry::Get("rpc.CreateEventDrivenServer");
+    ICHECK(fcreate != nullptr);
+    session->handler = (*fcreate)(fsend, "MultiSessionServer", "");
+    return session;
+  }
+
+  /*!
+   * \brief CloseSession Shuts down the RPC server of a session and closes its socket.
+   * \param session The session.
+   */
+  static void CloseSession(Session* session) {
+    if (session->sock.IsClosed()) {
+      return;
+    }
+    // The server sends its shutdown message on destruction, before the socket is closed.
+    session->handler = PackedFunc();
+    session->sock.Close();
+  }
+
   /*!
    * \brief AcceptConnection Accepts the RPC Server connection.
    * \param tracker Tracker details.
@@ -259,63 +484,85 @@ class RPCServer {
     while (true) {
       tracker->WaitConnectionAndUpdateKey(listen_sock_, my_port_, ping_period, &matchkey);
       support::TCPSocket conn = listen_sock_.Accept(addr);
-
-      int code = kRPCMagic;
-      ICHECK_EQ(conn.RecvAll(&code, sizeof(code)), sizeof(code));
-      if (code != kRPCMagic) {
-        conn.Close();
-        LOG(FATAL) << "Client connected is not TVM RPC server";
-        continue;
+      std::string usedkey;
+      if (Handshake(&conn, *addr, {matchkey}, &usedkey, opts)) {
+        *conn_sock = conn;
+        return;
       }
+    }
+  }
+
+  /*!
+   * \brief Handshake Checks the header of a new connection and replies to it.
+   * \param conn_sock The connection, which is closed if the handshake fails.
+   * \param addr The address of the connection.
+   * \param matchkeys The match keys which are accepted.
+   * \param matchkey The match key used by the client.
+   * \param opts Parsed options for socket
+   * \return Whether the connection is accepted.
+   */
+  bool Handshake(support::TCPSocket* conn_sock, const support::SockAddr& addr,
+                 const std::set<std::string>& matchkeys, std::string* matchkey,
+                 std::string* opts) {
+    support::TCPSocket& conn = *conn_sock;
+    int code = kRPCMagic;
+    ICHECK_EQ(conn.RecvAll(&code, sizeof(code)), sizeof(code));
+    if (code != kRPCMagic) {
+      conn.Close();
+      LOG(FATAL) << "Client connected is not TVM RPC server";
+      return false;
+    }
 
-      int keylen = 0;
-      ICHECK_EQ(conn.RecvAll(&keylen, sizeof(keylen)), sizeof(keylen));
+    int keylen = 0;
+    ICHECK_EQ(conn.RecvAll(&keylen, sizeof(keylen)), sizeof(keylen));
 
-      const char* CLIENT_HEADER = "client:";
-      const char* SERVER_HEADER = "server:";
-      std::string expect_header = CLIENT_HEADER + matchkey;
-      std::string server_key = SERVER_HEADER + key_;
-      if (size_t(keylen) < expect_header.length()) {
-        conn.Close();
-        LOG(INFO) << "Wrong client header length";
-        continue;
-      }
+    const char* CLIENT_HEADER = "client:";
+    const char* SERVER_HEADER = "server:";
+    std::string server_key = SERVER_HEADER + key_;
+    size_t min_header_length = std::string::npos;
+    for (const std::string& key : matchkeys) {
+      min_header_length = std::min(min_header_length, std::string(CLIENT_HEADER + key).length());
+    }
+    if (size_t(keylen) < min_header_length) {
+      conn.Close();
+      LOG(INFO) << "Wrong client header length";
+      return false;
+    }
 
-      ICHECK_NE(keylen, 0);
-      std::string remote_key;
-      remote_key.resize(keylen);
-      ICHECK_EQ(conn.RecvAll(&remote_key[0], keylen), keylen);
+    ICHECK_NE(keylen, 0);
+    std::string remote_key;
+    remote_key.resize(keylen);
+    ICHECK_EQ(conn.RecvAll(&remote_key[0], keylen), keylen);
 
-      std::stringstream ssin(remote_key);
-      std::string arg0;
+    std::stringstream ssin(remote_key);
+    std::string arg0;
 #ifndef __ANDROID__
-      ssin >> arg0;
+    ssin >> arg0;
 #else
-      arg0 = getNextString(&ssin);
+    arg0 = getNextString(&ssin);
 #endif
 
-      if (arg0 != expect_header) {
-        code = kRPCMismatch;
-        ICHECK_EQ(conn.SendAll(&code, sizeof(code)), sizeof(code));
-        conn.Close();
-        LOG(WARNING) << "Mismatch key from" << addr->AsString();
-        continue;
-      } else {
-        code = kRPCSuccess;
-        ICHECK_EQ(conn.SendAll(&code, sizeof(code)), sizeof(code));
-        keylen = int(server_key.length());
-        ICHECK_EQ(conn.SendAll(&keylen, sizeof(keylen)), sizeof(keylen));
-        ICHECK_EQ(conn.SendAll(server_key.c_str(), keylen), keylen);
-        LOG(INFO) << "Connection success " << addr->AsString();
+    if (arg0.compare(0, strlen(CLIENT_HEADER), CLIENT_HEADER) != 0 ||
+        matchkeys.count(arg0.substr(strlen(CLIENT_HEADER))) == 0) {
+      code = kRPCMismatch;
+      ICHECK_EQ(conn.SendAll(&code, sizeof(code)), sizeof(code));
+      conn.Close();
+      LOG(WARNING) << "Mismatch key from" << addr.AsString();
+      return false;
+    }
+    *matchkey = arg0.substr(strlen(CLIENT_HEADER));
+    code = kRPCSuccess;
+    ICHECK_EQ(conn.SendAll(&code, sizeof(code)), sizeof(code));
+    keylen = int(server_key.length());
+    ICHECK_EQ(conn.SendAll(&keylen, sizeof(keylen)), sizeof(keylen));
+    ICHECK_EQ(conn.SendAll(server_key.c_str(), keylen), keylen);
+    LOG(INFO) << "Connection success " << addr.AsString();
 #ifndef __ANDROID__
-        ssin >> *opts;
+    ssin >> *opts;
 #else
-        *opts = getNextString(&ssin);
+    *opts = getNextString(&ssin);
 #endif
-        *conn_sock = conn;
-        return;
-      }
-    }
+    return true;
   }
 
   /*!
@@ -356,8 +603,12 @@ class RPCServer {
   std::string key_;
   std::string custom_addr_;
   std::string work_dir_;
+  size_t max_sessions_;
+  std::vector<Module> preloaded_;
   support::TCPSocket listen_sock_;
   support::TCPSocket tracker_sock_;
+  /*! \brief The number of bytes received from a session at a time. */
+  static constexpr size_t kRecvChunkSize = 64 << 10;
 };
 
 #if defined(WIN32)
@@ -384,22 +635,27 @@ void ServerLoopFromChild(SOCKET socket) {
  * \param tracker_addr The address of RPC tracker in host:port format e.g. 10.77.1.234:9190
  * Default="" \param key The key used to identify the device type in tracker. Default="" \param
  * custom_addr Custom IP Address to Report to RPC Tracker. Default="" \param silent Whether run in
- * silent mode. Default=True
+ * silent mode. Default=True \param max_sessions The number of sessions served at once. Default=1
+ * \param preload The shared libraries loaded by the server, separated by commas. Default=""
  */
 void RPCServerCreate(std::string host, int port, int port_end, std::string tracker_addr,
-                     std::string key, std::string custom_addr, std::string work_dir, bool silent) {
+                     std::string key, std::string custom_addr, std::string work_dir, bool silent,
+                     int max_sessions, std::string preload) {
   if (silent) {
     // Only errors and fatal is logged
     dmlc::InitLogging("--minloglevel=2");
   }
   // Start the rpc server
   RPCServer rpc(std::move(host), port, port_end, std::move(tracker_addr), std::move(key),
-                std::move(custom_addr), std::move(work_dir));
+                std::move(custom_addr), std::move(work_dir), max_sessions, std::move(preload));
   rpc.Start();
 }
 
 TVM_REGISTER_GLOBAL("rpc.ServerCreate").set_body([](TVMArgs args, TVMRetValue* rv) {
-  RPCServerCreate(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7]);
+  int max_sessions = args.num_args > 8 ? args[8].operator int() : 1;
+  std::string preload = args.num_args > 9 ? args[9].operator std::string() : "";
+  RPCServerCreate(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7],
+                  max_sessions, preload);
 });
 }  // namespace runtime
 }  // namespace tvm
@@ -115,6 +115,7 @@ class TrackerClient {
   void ReportResourceAndGetKey(int port, std::string* matchkey) {
     if (!tracker_sock_.IsClosed()) {
       *matchkey = RandomKey(key_ + ":", old_keyset_);
+      old_keyset_.insert(*matchkey);
 
       std::ostringstream ss;
       ss << "[" << static_cast<int>(TrackerCode::kPut) << ", \"" << key_ << "\", [" << port
@@ -130,6 +131,17 @@ class TrackerClient {
     }
   }
 
+  /*!
+   * \brief GetPendingMatchKeys Get the match keys which the tracker has not handed to a client.
+   * \return The pending match keys, as formatted by the tracker.
+   */
+  std::string GetPendingMatchKeys() {
+    std::ostringstream ss;
+    ss << "[" << int(TrackerCode::kGetPendingMatchKeys) << "]";
+    tracker_sock_.SendBytes(ss.str());
+    return tracker_sock_.RecvBytes();
+  }
+
   /*!
    * \brief ReportResourceAndGetKey Report resource to tracker.
    * \param listen_sock Listen socket details for select.
@@ -147,12 +159,7 @@ class TrackerClient {
         poller.WatchRead(listen_sock.sockfd);
         poller.Poll(ping_period * 1000);
         if (!poller.CheckRead(listen_sock.sockfd)) {
-          std::ostringstream ss;
-          ss << "[" << int(TrackerCode::kGetPendingMatchKeys) << "]";
-          tracker_sock_.SendBytes(ss.str());
-
-          // Receive status and validate
-          std::string pending_keys = tracker_sock_.RecvBytes();
+          std::string pending_keys = GetPendingMatchKeys();
           old_keyset_.insert(*matchkey);
 
           // if match key not in pending key set
@@ -0,0 +1,307 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file load_generator.cc
+ * \brief Concurrent serving benchmark on top of TVMRunner.
+ */
+#include "load_generator.h"
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include <tvm/runtime/threading_backend.h>
+
+#include "tvm_runner.h"
+
+namespace tvm {
+namespace runtime {
+
+using Clock = std::chrono::steady_clock;
+
+/*! \brief The resource usage of the process. */
+struct ResourceUsage {
+  /*! \brief The user and system CPU time in seconds */
+  double cpu_sec = 0;
+  /*! \brief The peak resident memory in megabytes */
+  double peak_rss_mb = 0;
+};
+
+/*!
+ * \brief Query the resource usage of the process.
+ * \return the resource usage, zero where the platform doesn't report it.
+ */
+ResourceUsage GetResourceUsage() {
+  ResourceUsage usage;
+#if !defined(_WIN32)
+  struct rusage ru;
+  if (getrusage(RUSAGE_SELF, &ru) == 0) {
+    usage.cpu_sec = ru.ru_utime.tv_sec + ru.ru_utime.tv_usec * 1e-6 + ru.ru_stime.tv_sec +
+                    ru.ru_stime.tv_usec * 1e-6;
+#if defined(__APPLE__)
+    // The peak resident memory is in bytes on macOS and in kilobytes elsewhere
+    usage.peak_rss_mb = ru.ru_maxrss / (1024.0 * 1024.0);
+#else
+    usage.peak_rss_mb = ru.ru_maxrss / 1024.0;
+#endif
+  }
+#endif
+  return usage;
+}
+
+/*!
+ * \brief The latency at the given quantile of the sorted latencies, by the nearest rank.
+ * \param sorted the sorted latencies.
+ * \param q the quantile in (0, 1].
+ * \return the latency.
+ */
+double Percentile(const std::vector<double>& sorted, double q) {
+  int64_t n = sorted.size();
+  int64_t rank = static_cast<int64_t>(std::ceil(q * n)) - 1;
+  return sorted[std::min(std::max<int64_t>(rank, 0), n - 1)];
+}
+
+/*! \brief The state shared by the sessions of a run. */
+struct LoadGenState {
+  /*! \brief Guards the start barrier */
+  std::mutex mutex;
+  /*! \brief Signals the changes of the start barrier */
+  std::condition_variable cv;
+  /*! \brief The number of sessions ready to measure */
+  int num_ready = 0;
+  /*! \brief Whether the measurement started */
+  bool started = false;
+  /*! \brief The start of the measurement */
+  Clock::time_point start;
+  /*! \brief The index of the next request */
+  std::atomic<int64_t> next{0};
+  /*! \brief The arrival offsets of the requests in the open loop, in seconds */
+  std::vector<double> arrivals;
+  /*! \brief The latency of every request in milliseconds */
+  std::vector<double> latencies;
+  /*! \brief The first error of the sessions */
+  std::exception_ptr error;
+};
+
+/*!
+ * \brief Load the model, warm it up and serve the requests of the run.
+ * \param config the settings.
+ * \param session_id the index of the session.
+ * \param state the shared state of the run.
+ */
+void RunSession(const LoadGenConfig& config, int session_id, LoadGenState* state) {
+  std::unique_ptr<TVMRunner> runner;
+  std::vector<std::pair<std::string, std::vector<char>>> inputs, outputs;
+  try {
+    if (config.threads > 0) {
+      // The thread pool is per calling thread, so every session configures its own
+      const PackedFunc* f_config = Registry::Get("runtime.config_threadpool");
+      ICHECK(f_config != nullptr);
+      (*f_config)(static_cast<int>(threading::ThreadGroup::kBig), config.threads);
+    }
+    runner = std::make_unique<TVMRunner>(config.model, config.device, config.backend);
+    runner->Load();
+    if (!config.input.empty()) {
+      runner->SetInput(config.input);
+    }
+    TVMMetaInfo info = runner->GetMetaInfo();
+    if (!config.partitions.empty()) {
+      int group = session_id % config.partitions.size();
+      runner->BindThreadPoolGroup("rtvm_partition_" + std::to_string(group));
+    }
+    std::mt19937 rng(session_id);
+    for (auto& elem : info.input_info) {
+      std::vector<char> data(runner->GetInputMemSize(elem.first));
+      if (config.input.empty()) {
+        for (char& c : data) c = static_cast<char>(rng());
+        runner->SetInput(elem.first, data.data());
+      } else {
+        runner->GetInput(elem.first, data.data());
+      }
+      inputs.emplace_back(elem.first, std::move(data));
+    }
+    for (int i = 0; i < std::max(config.warmup, 1); ++i) {
+      runner->Run();
+    }
+    // The outputs of the VM are known after the first run
+    info = runner->GetMetaInfo();
+    for (auto& elem : info.output_info) {
+      outputs.emplace_back(elem.first, std::vector<char>(runner->GetOutputMemSize(elem.first)));
+    }
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Session " << session_id << " failed to start: " << e.what();
+    runner.reset();
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (!state->error) state->error = std::current_exception();
+  }
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    ++state->num_ready;
+    state->cv.notify_all();
+    state->cv.wait(lock, [state] { return state->started; });
+  }
+  if (runner == nullptr || state->error) {
+    return;
+  }
+  const int64_t num_requests = state->latencies.size();
+  try {
+    for (int64_t i = state->next++; i < num_requests; i = state->next++) {
+      Clock::time_point begin = Clock::now();
+      if (!state->arrivals.empty()) {
+        // The latency of an open loop request starts at its arrival, queuing included
+        begin = state->start + std::chrono::duration_cast<Clock::duration>(
+                                   std::chrono::duration<double>(state->arrivals[i]));
+        std::this_thread::sleep_until(begin);
+      }
+      for (auto& elem : inputs) {
+        runner->SetInput(elem.first, elem.second.data());
+      }
+      runner->Run();
+      for (auto& elem : outputs) {
+        runner->GetOutput(elem.first, elem.second.data());
+      }
+      state->latencies[i] =
+          std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Session " << session_id << " failed: " << e.what();
+    // Stop the other sessions as well
+    state->next = num_requests;
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (!state->error) state->error = std::current_exception();
+  }
+}
+
+LoadGenReport RunLoadGenerator(const LoadGenConfig& config) {
+  CHECK_GT(config.sessions, 0) << "The number of sessions must be positive";
+  CHECK_GT(config.requests, 0) << "The number of requests must be positive";
+  CHECK_GE(config.rate, 0) << "The arrival rate must not be negative";
+  CHECK(config.backend != "vm" || !config.input.empty())
+      << "The vm backend needs the inputs in a npz file";
+  for (size_t i = 0; i < config.partitions.size(); ++i) {
+    const PackedFunc* f_create = Registry::Get("runtime.ThreadPoolGroupCreate");
+    ICHECK(f_create != nullptr);
+    Array<String> cpus;
+    for (const std::string& cpu : config.partitions[i]) cpus.push_back(cpu);
+    (*f_create)("rtvm_partition_" + std::to_string(i), cpus);
+  }
+
+  LoadGenState state;
+  state.latencies.resize(config.requests, 0);
+  if (config.rate > 0) {
+    std::mt19937_64 rng(config.seed);
+    std::exponential_distribution<double> gap(config.rate);
+    double arrival = 0;
+    for (int64_t i = 0; i < config.requests; ++i) {
+      state.arrivals.push_back(arrival);
+      arrival += gap(rng);
+    }
+  }
+
+  std::vector<std::thread> sessions;
+  for (int i = 0; i < config.sessions; ++i) {
+    sessions.emplace_back(RunSession, std::cref(config), i, &state);
+  }
+  ResourceUsage usage_begin;
+  {
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.cv.wait(lock, [&] { return state.num_ready == config.sessions; });
+    LOG(INFO) << "Sessions ready, measuring " << config.requests << " requests";
+    usage_begin = GetResourceUsage();
+    state.start = Clock::now();
+    state.started = true;
+    state.cv.notify_all();
+  }
+  for (std::thread& session : sessions) {
+    session.join();
+  }
+  Clock::time_point end = Clock::now();
+  ResourceUsage usage_end = GetResourceUsage();
+  if (state.error) {
+    std::rethrow_exception(state.error);
+  }
+
+  LoadGenReport report;
+  std::vector<double> sorted = state.latencies;
+  std::sort(sorted.begin(), sorted.end());
+  report.requests = config.requests;
+  report.wall_sec = std::chrono::duration<double>(end - state.start).count();
+  report.throughput = report.requests / report.wall_sec;
+  double total = 0;
+  for (double latency : sorted) total += latency;
+  report.mean_ms = total / sorted.size();
+  report.min_ms = sorted.front();
+  report.p50_ms = Percentile(sorted, 0.5);
+  report.p99_ms = Percentile(sorted, 0.99);
+  report.p999_ms = Percentile(sorted, 0.999);
+  report.max_ms = sorted.back();
+  report.cpu_sec = usage_end.cpu_sec - usage_begin.cpu_sec;
+  report.peak_rss_mb = usage_end.peak_rss_mb;
+  for (size_t i = 0; i < config.partitions.size(); ++i) {
+    const PackedFunc* f_remove = Registry::Get("runtime.ThreadPoolGroupRemove");
+    (*f_remove)("rtvm_partition_" + std::to_string(i));
+  }
+  return report;
+}
+
+void PrintLoadGenReport(const LoadGenConfig& config, const LoadGenReport& report) {
+  LOG(INFO) << "Load Generator Report:" << config.model;
+  LOG(INFO) << "    Backend:" << config.backend << " Sessions:" << config.sessions
+            << " Mode:" << (config.rate > 0 ? "open loop" : "closed loop");
+  if (config.rate > 0) {
+    LOG(INFO) << "    Arrival Rate:" << config.rate << " requests/s";
+  }
+  LOG(INFO) << "    Requests:" << report.requests << " in " << report.wall_sec << " s";
+  LOG(INFO) << "    Throughput:" << report.throughput << " requests/s";
+  LOG(INFO) << "    Latency (ms): mean " << report.mean_ms << ", min " << report.min_ms << ", p50 "
+            << report.p50_ms << ", p99 " << report.p99_ms << ", p999 " << report.p999_ms
+            << ", max " << report.max_ms;
+  LOG(INFO) << "    CPU Time:" << report.cpu_sec << " s ("
+            << report.cpu_sec / report.wall_sec << " cores)";
+  LOG(INFO) << "    Peak RSS:" << report.peak_rss_mb << " MB";
+  if (config.report.empty()) {
+    return;
+  }
+  std::ofstream os(config.report);
+  CHECK(!os.fail()) << "Failed to open report file:" << config.report;
+  os << "{\"model\": \"" << config.model << "\", \"device\": \"" << config.device
+     << "\", \"backend\": \"" << config.backend << "\", \"sessions\": " << config.sessions
+     << ", \"rate\": " << config.rate << ", \"threads\": " << config.threads
+     << ", \"requests\": " << report.requests << ", \"wall_sec\": " << report.wall_sec
+     << ", \"throughput\": " << report.throughput << ", \"latency_ms\": {\"mean\": "
+     << report.mean_ms << ", \"min\": " << report.min_ms << ", \"p50\": " << report.p50_ms
+     << ", \"p99\": " << report.p99_ms << ", \"p999\": " << report.p999_ms
+     << ", \"max\": " << report.max_ms << "}, \"cpu_sec\": " << report.cpu_sec
+     << ", \"peak_rss_mb\": " << report.peak_rss_mb << "}\n";
+}
+
+}  // namespace runtime
+}  // namespace tvm
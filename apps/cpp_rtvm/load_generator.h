@@ -0,0 +1,102 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file load_generator.h
+ * \brief Concurrent serving benchmark on top of TVMRunner.
+ */
+#ifndef TVM_APPS_CPP_RTVM_LOAD_GENERATOR_H_
+#define TVM_APPS_CPP_RTVM_LOAD_GENERATOR_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Settings of the load generator.
+ *
+ * Every session owns a TVMRunner and executes one request at a time, a request copies the inputs
+ * in, runs the model and copies the outputs out. In the closed loop (rate = 0) a session issues
+ * its next request as soon as the previous one completes. In the open loop the requests arrive
+ * with exponentially distributed gaps at the given rate, independently of the completions, and
+ * the latency includes the time a request waits for a free session.
+ */
+struct LoadGenConfig {
+  /*! \brief The folder containing the tvm artifacts */
+  std::string model;
+  /*! \brief The target device */
+  std::string device;
+  /*! \brief The executor backend {graph, vm, aot} */
+  std::string backend = "graph";
+  /*! \brief Numpy file for the model inputs, random inputs are used if empty */
+  std::string input;
+  /*! \brief The number of concurrent sessions */
+  int sessions = 1;
+  /*! \brief The number of measured requests over all the sessions */
+  int64_t requests = 100;
+  /*! \brief The number of unmeasured requests of every session before the measurement */
+  int warmup = 10;
+  /*! \brief The arrival rate of the requests per second, 0 for the closed loop */
+  double rate = 0;
+  /*! \brief The number of threads of the thread pool of every session, 0 for the default */
+  int threads = 0;
+  /*! \brief The CPUs of the thread pool groups, the sessions are assigned round robin */
+  std::vector<std::vector<std::string>> partitions;
+  /*! \brief The seed of the arrival process */
+  uint64_t seed = 0;
+  /*! \brief The JSON file to write the report to, if not empty */
+  std::string report;
+};
+
+/*! \brief The measurements of a load generator run. */
+struct LoadGenReport {
+  /*! \brief The number of measured requests */
+  int64_t requests = 0;
+  /*! \brief The wall time of the measurement in seconds */
+  double wall_sec = 0;
+  /*! \brief The completed requests per second */
+  double throughput = 0;
+  /*! \brief The request latencies in milliseconds */
+  double mean_ms = 0, min_ms = 0, p50_ms = 0, p99_ms = 0, p999_ms = 0, max_ms = 0;
+  /*! \brief The CPU time of the process during the measurement in seconds */
+  double cpu_sec = 0;
+  /*! \brief The peak resident memory of the process in megabytes */
+  double peak_rss_mb = 0;
+};
+
+/*!
+ * \brief Run the load generator.
+ * \param config the settings.
+ * \return the measurements.
+ */
+LoadGenReport RunLoadGenerator(const LoadGenConfig& config);
+
+/*!
+ * \brief Print the report, and write it to the JSON file of the config.
+ * \param config the settings of the run.
+ * \param report the measurements.
+ */
+void PrintLoadGenReport(const LoadGenConfig& config, const LoadGenReport& report);
+
+}  // namespace runtime
+}  // namespace tvm
+#endif  // TVM_APPS_CPP_RTVM_LOAD_GENERATOR_H_
@@ -36,6 +36,7 @@
 
 #include "../../src/support/socket.h"
 #include "../../src/support/utils.h"
+#include "load_generator.h"
 #include "tvm_runner.h"
 
 #if defined(_WIN32)
@@ -56,9 +57,22 @@ static const string kUsage =
     "--dump-meta    - Dump model meta information\n"
     "--pre-compiled - The file name of a file where pre-compiled programs should be stored"
     "\n"
+    "--backend      - The executor to run the model with {graph, vm, aot} (default graph)\n"
+    "Load generator options, enabled by --requests\n"
+    "--requests     - The number of measured requests over all the sessions\n"
+    "--sessions     - The number of concurrent sessions (default 1)\n"
+    "--warmup       - The number of unmeasured requests of every session (default 10)\n"
+    "--rate         - The arrival rate in requests per second, 0 for closed loop (default 0)\n"
+    "--seed         - The seed of the open loop arrivals (default 0)\n"
+    "--threads      - The number of threads of the thread pool of every session\n"
+    "--partition    - The CPUs of the thread pool groups, e.g. 0,1,2,3:4,5,6,7\n"
+    "--report       - The JSON file to write the load generator report to\n"
+    "\n"
     "  Example\n"
     "  ./rtvm --model=keras-resnet50 --device=\"opencl\" --dump-meta\n"
     "  ./rtvm --model=keras-resnet50 --device=\"opencl\" --input input.npz --output=output.npz\n"
+    "  ./rtvm --model=keras-resnet50 --device=\"cpu\" --requests=1000 --sessions=2 "
+    "--partition=0,1:2,3\n"
     "\n";
 
 /*!
@@ -68,6 +82,8 @@ static const string kUsage =
  * \arg input Numpy file for the model input
  * \arg output Numpy file name to dump the model output as numpy
  * \arg pre_compiled File name where pre-compiled programs should be stored
+ * \arg backend The executor to run the model with {graph, vm, aot}
+ * \arg load_gen The load generator settings, used if requests is given
  */
 struct ToolArgs {
   string model;
@@ -75,7 +91,10 @@ struct ToolArgs {
   string input;
   string output;
   string pre_compiled;
+  string backend = "graph";
   bool dump_meta = false;
+  bool run_load_gen = false;
+  LoadGenConfig load_gen;
 };
 
 /*!
@@ -88,7 +107,16 @@ void PrintArgs(const ToolArgs& args) {
   LOG(INFO) << "Input         = " << args.input;
   LOG(INFO) << "Output        = " << args.output;
   LOG(INFO) << "Pre-compiled  = " << args.pre_compiled;
+  LOG(INFO) << "Backend       = " << args.backend;
   LOG(INFO) << "Dump Metadata = " << ((args.dump_meta) ? ("True") : ("False"));
+  if (args.run_load_gen) {
+    LOG(INFO) << "Requests      = " << args.load_gen.requests;
+    LOG(INFO) << "Sessions      = " << args.load_gen.sessions;
+    LOG(INFO) << "Warmup        = " << args.load_gen.warmup;
+    LOG(INFO) << "Rate          = " << args.load_gen.rate;
+    LOG(INFO) << "Threads       = " << args.load_gen.threads;
+    LOG(INFO) << "Partitions    = " << args.load_gen.partitions.size();
+  }
 }
 
 #if defined(__linux__) || defined(__ANDROID__)
@@ -178,6 +206,38 @@ void ParseCmdArgs(int argc, char* argv[], struct ToolArgs& args) {
   }
 
   args.pre_compiled = GetCmdOption(argc, argv, "--pre-compiled=");
+
+  const string backend = GetCmdOption(argc, argv, "--backend=");
+  if (!backend.empty()) {
+    args.backend = backend;
+  }
+
+  const string requests = GetCmdOption(argc, argv, "--requests=");
+  if (!requests.empty()) {
+    LoadGenConfig& config = args.load_gen;
+    args.run_load_gen = true;
+    config.model = args.model;
+    config.device = args.device;
+    config.backend = args.backend;
+    config.input = args.input;
+    config.requests = stoll(requests);
+    const string sessions = GetCmdOption(argc, argv, "--sessions=");
+    if (!sessions.empty()) config.sessions = stoi(sessions);
+    const string warmup = GetCmdOption(argc, argv, "--warmup=");
+    if (!warmup.empty()) config.warmup = stoi(warmup);
+    const string rate = GetCmdOption(argc, argv, "--rate=");
+    if (!rate.empty()) config.rate = stod(rate);
+    const string seed = GetCmdOption(argc, argv, "--seed=");
+    if (!seed.empty()) config.seed = stoull(seed);
+    const string threads = GetCmdOption(argc, argv, "--threads=");
+    if (!threads.empty()) config.threads = stoi(threads);
+    // The groups are separated by ':' and the CPUs of a group by ','
+    const string partition = GetCmdOption(argc, argv, "--partition=");
+    for (const string& group : Split(partition, ':')) {
+      if (!group.empty()) config.partitions.push_back(Split(group, ','));
+    }
+    config.report = GetCmdOption(argc, argv, "--report=");
+  }
 }
 
 /*!
@@ -191,8 +251,14 @@ int ExecuteModel(ToolArgs& args) {
   HandleCtrlC();
 #endif
 
+  if (args.run_load_gen) {
+    LoadGenReport report = RunLoadGenerator(args.load_gen);
+    PrintLoadGenReport(args.load_gen, report);
+    return 0;
+  }
+
   // Initialize TVM Runner
-  TVMRunner runner = TVMRunner(args.model, args.device);
+  TVMRunner runner = TVMRunner(args.model, args.device, args.backend);
 
   // Load the model
   runner.Load();
@@ -207,6 +273,7 @@ int ExecuteModel(ToolArgs& args) {
   if (args.dump_meta) runner.PrintMetaInfo();
 
   if (args.input.empty() || args.output.empty()) {
+    CHECK(args.backend != "vm") << "The vm backend needs the --input and --output npz files";
     LOG(INFO) << "Executing dry run ... ";
     // Set random input for all inputs
     for (auto& elem : mInfo.input_info) {
@@ -63,14 +63,37 @@ int GetTVMDevice(std::string device) {
   }
 }
 
+/*!
+ * \brief Get the data type of a numpy array from its element size.
+ * \param word_size the element size in bytes.
+ * \return the data type, the numpy header doesn't tell integers from floats.
+ */
+DLDataType GetNpyDType(size_t word_size) {
+  if (word_size == 1) {
+    return DataType::Int(8);
+  } else if (word_size == 2) {
+    return DataType::Float(16);
+  } else if (word_size == 4) {
+    return DataType::Float(32);
+  } else if (word_size == 8) {
+    return DataType::Int(64);
+  } else {
+    LOG(FATAL) << "TVMRunner : Unsupported numpy element size :" << word_size;
+  }
+}
+
 /*!
  * \brief Constructor for TVMRunner.
  * \param path where the tfm compiler artifacts present.
  * \param device the target device where we need to load the compiled model.
+ * \param backend the executor to run the model with {graph, vm, aot}.
  */
-TVMRunner::TVMRunner(std::string path, std::string device)
-    : r_model_path(path), r_device(device), r_run_was_called(false) {
-  LOG(INFO) << "TVMRunner Constructor:" << r_model_path << " Devices:" << r_device;
+TVMRunner::TVMRunner(std::string path, std::string device, std::string backend)
+    : r_model_path(path), r_device(device), r_run_was_called(false), r_backend(backend) {
+  LOG(INFO) << "TVMRunner Constructor:" << r_model_path << " Devices:" << r_device
+            << " Backend:" << r_backend;
+  CHECK(r_backend == "graph" || r_backend == "vm" || r_backend == "aot")
+      << "TVMRunner : Unsupported backend :" << r_backend;
 }
 
 /*!
@@ -81,6 +104,35 @@ int TVMRunner::Load(void) {
   LOG(INFO) << "TVMRunner Load:" << r_model_path;
   // Load the lib file
   r_mod_handle = Module::LoadFromFile((r_model_path + "/mod.so").c_str(), "so");
+  int device_type = GetTVMDevice(r_device);
+
+  if (r_backend == "vm") {
+    // The exported library of a VM executable has the executable as its root module
+    PackedFunc f_load = r_mod_handle.GetFunction("vm_load_executable");
+    CHECK(f_load != nullptr) << "Failed to find a VM executable in:" << r_model_path << "/mod.so";
+    r_graph_handle = f_load();
+    // Use the pooled allocator, a session reuses its buffers across the requests
+    const int kPooled = 2;
+    if (device_type == static_cast<int>(kDLCPU)) {
+      r_graph_handle.GetFunction("init")(device_type, 0, kPooled);
+    } else {
+      r_graph_handle.GetFunction("init")(device_type, 0, kPooled, static_cast<int>(kDLCPU), 0,
+                                         kPooled);
+    }
+    int64_t arity = r_graph_handle.GetFunction("get_function_arity")("main");
+    for (int64_t i = 0; i < arity; ++i) {
+      std::string name = r_graph_handle.GetFunction("get_function_param_name")("main", i);
+      r_vm_inputs.emplace_back(name, NDArray());
+    }
+    return 0;
+  } else if (r_backend == "aot") {
+    // The AOT executor factory is named after the module name of the build
+    PackedFunc f_create = r_mod_handle.GetFunction("default");
+    CHECK(f_create != nullptr) << "Failed to find an AOT executor factory in:" << r_model_path
+                               << "/mod.so";
+    r_graph_handle = f_create(Device{static_cast<DLDeviceType>(device_type), 0});
+    return 0;
+  }
 
   // Read model json file
   std::ifstream json_reader((r_model_path + "/mod.json").c_str());
@@ -93,7 +145,7 @@ int TVMRunner::Load(void) {
   auto f_handle = tvm::runtime::Registry::Get("tvm.graph_executor.create");
 
   // Greate graph runtime
-  r_graph_handle = (*f_handle)(json_str, r_mod_handle, GetTVMDevice(r_device), 0);
+  r_graph_handle = (*f_handle)(json_str, r_mod_handle, device_type, 0);
 
   // Read params binary file
   std::ifstream params_reader((r_model_path + "/mod.params").c_str(), std::ios::binary);
@@ -150,6 +202,40 @@ inline size_t GetMemSize(NDArray& narr) {
   return size;
 }
 
+/*!
+ * \brief Get the input array of the executor.
+ * \param input_id The input name.
+ * \return The input array.
+ */
+NDArray TVMRunner::GetInputArray(const std::string& input_id) {
+  if (r_backend != "vm") {
+    return r_graph_handle.GetFunction("get_input")(input_id);
+  }
+  for (auto& elem : r_vm_inputs) {
+    if (elem.first == input_id) {
+      CHECK(elem.second.defined()) << "TVMRunner : The shape of VM input " << input_id
+                                   << " is unknown, set the inputs from a npz file first";
+      return elem.second;
+    }
+  }
+  LOG(FATAL) << "TVMRunner : Unknown input :" << input_id;
+}
+
+/*!
+ * \brief Get the output array of the executor.
+ * \param output_id The output name.
+ * \return The output array.
+ */
+NDArray TVMRunner::GetOutputArray(const std::string& output_id) {
+  if (r_backend == "graph") {
+    return r_graph_handle.GetFunction("get_output")(output_id);
+  }
+  // The VM and the AOT executor index their outputs
+  auto it = r_output_index.find(output_id);
+  CHECK(it != r_output_index.end()) << "TVMRunner : Unknown output :" << output_id;
+  return r_graph_handle.GetFunction("get_output")(it->second);
+}
+
 /*!
  * \brief Get the input alloc mem size.
  * \param input_id The input id to query the mem size.
@@ -158,7 +244,7 @@ inline size_t GetMemSize(NDArray& narr) {
 size_t TVMRunner::GetInputMemSize(std::string input_id) {
   LOG(INFO) << "TVMRunner::GetInputMemSize:" << input_id;
 
-  NDArray in_arr = r_graph_handle.GetFunction("get_input")(input_id);
+  NDArray in_arr = GetInputArray(input_id);
   auto ssize = GetMemSize(in_arr);
 
   return ssize;
@@ -172,7 +258,7 @@ size_t TVMRunner::GetInputMemSize(std::string input_id) {
 size_t TVMRunner::GetOutputMemSize(std::string output_id) {
   LOG(INFO) << "TVMRunner::GetOutputMemSize:" << output_id;
 
-  NDArray out_arr = r_graph_handle.GetFunction("get_output")(output_id);
+  NDArray out_arr = GetOutputArray(output_id);
   auto ssize = GetMemSize(out_arr);
 
   return ssize;
@@ -187,9 +273,25 @@ int TVMRunner::SetInput(std::string inputfile) {
   LOG(INFO) << "TVMRunner::SetInput (Numpy):" << inputfile;
   cnpy::npz_t npz_input = cnpy::npz_load(inputfile);
 
+  if (r_backend == "vm") {
+    // The VM knows the input shapes only at run time, so they come from the npz file
+    Device dev{static_cast<DLDeviceType>(GetTVMDevice(r_device)), 0};
+    for (auto& elem : r_vm_inputs) {
+      auto it = npz_input.find(elem.first);
+      if (it == npz_input.end()) {
+        LOG(WARNING) << "Couldn't find input " << elem.first << " in npy input file";
+        continue;
+      }
+      std::vector<int64_t> shape(it->second.shape.begin(), it->second.shape.end());
+      elem.second = NDArray::Empty(shape, GetNpyDType(it->second.word_size), dev);
+      elem.second.CopyFromBytes(it->second.data<char>(), GetMemSize(elem.second));
+    }
+    return 0;
+  }
+
   for (auto& elem : mInfo.input_info) {
     LOG(INFO) << "Set Numpy Input for :" << elem.first;
-    NDArray in_arr = r_graph_handle.GetFunction("get_input")(elem.first);
+    NDArray in_arr = GetInputArray(elem.first);
     auto ssize = GetMemSize(in_arr);
 
     if (npz_input.find(elem.first) != npz_input.end()) {
@@ -209,13 +311,27 @@ int TVMRunner::SetInput(std::string inputfile) {
  * \param 0 on success else error code.
  */
 int TVMRunner::SetInput(std::string input_id, char* raw_input) {
-  LOG(INFO) << "TVMRunner::SetInput (Raw)";
-  NDArray in_arr = r_graph_handle.GetFunction("get_input")(input_id);
+  VLOG(1) << "TVMRunner::SetInput (Raw)";
+  NDArray in_arr = GetInputArray(input_id);
   auto ssize = GetMemSize(in_arr);
   in_arr.CopyFromBytes(raw_input, ssize);
   return 0;
 }
 
+/*!
+ * \brief Get the model input as a binary buffer.
+ * \param input_id input node name to read the data.
+ * \param raw_input the buffer to copy the data to.
+ * \param 0 on success else error code.
+ */
+int TVMRunner::GetInput(std::string input_id, char* raw_input) {
+  VLOG(1) << "TVMRunner::GetInput (Raw)";
+  NDArray in_arr = GetInputArray(input_id);
+  auto ssize = GetMemSize(in_arr);
+  in_arr.CopyToBytes(raw_input, ssize);
+  return 0;
+}
+
 /*!
  * \brief Get the model outputs and dump them to npz file.
  * \param outputfile the npz file to where we dump the output data.
@@ -223,10 +339,14 @@ int TVMRunner::SetInput(std::string input_id, char* raw_input) {
  */
 int TVMRunner::GetOutput(std::string outputfile) {
   LOG(INFO) << "TVMRunner::GetOutput (Numpy):" << outputfile;
+  if (r_backend == "vm") {
+    // Refresh the outputs which are known after the run
+    GetMetaInfo();
+  }
 
   for (auto& elem : mInfo.output_info) {
     LOG(INFO) << "Get Output for :" << elem.first;
-    NDArray out_arr = r_graph_handle.GetFunction("get_output")(elem.first);
+    NDArray out_arr = GetOutputArray(elem.first);
     auto ssize = GetMemSize(out_arr);
     LOG(INFO) << "Output Size:" << ssize << "  bytes";
 
@@ -255,8 +375,8 @@ int TVMRunner::GetOutput(std::string outputfile) {
  * \param 0 on success else error code.
  */
 int TVMRunner::GetOutput(std::string output_id, char* raw_output) {
-  LOG(INFO) << "TVMRunner::GetOutput (Raw)";
-  NDArray out_arr = r_graph_handle.GetFunction("get_output")(output_id);
+  VLOG(1) << "TVMRunner::GetOutput (Raw)";
+  NDArray out_arr = GetOutputArray(output_id);
   auto ssize = GetMemSize(out_arr);
   out_arr.CopyToBytes(raw_output, ssize);
   return 0;
@@ -267,10 +387,24 @@ int TVMRunner::GetOutput(std::string output_id, char* raw_output) {
  * \param 0 on success else error code.
  */
 int TVMRunner::Run(void) {
-  LOG(INFO) << "TVMRunner::Run";
+  VLOG(1) << "TVMRunner::Run";
   r_run_was_called = true;
 
-  r_graph_handle.GetFunction("run")();
+  if (r_backend == "vm") {
+    std::vector<TVMValue> values(r_vm_inputs.size() + 1);
+    std::vector<int> type_codes(r_vm_inputs.size() + 1);
+    TVMArgsSetter setter(values.data(), type_codes.data());
+    setter(0, "main");
+    for (size_t i = 0; i < r_vm_inputs.size(); ++i) {
+      setter(i + 1, r_vm_inputs[i].second);
+    }
+    TVMRetValue rv;
+    r_graph_handle.GetFunction("set_input")
+        .CallPacked(TVMArgs(values.data(), type_codes.data(), values.size()), &rv);
+    r_graph_handle.GetFunction("invoke")("main");
+  } else {
+    r_graph_handle.GetFunction("run")();
+  }
   return 0;
 }
 
@@ -281,6 +415,46 @@ int TVMRunner::Run(void) {
 TVMMetaInfo TVMRunner::GetMetaInfo(void) {
   LOG(INFO) << "TVMRunner::GetMetaInfo";
 
+  if (r_backend != "graph") {
+    // The VM and the AOT executor have no graph json, the information comes from the arrays
+    auto f_info = [](const NDArray& arr) {
+      std::vector<int> vshape(arr->shape, arr->shape + arr->ndim);
+      return std::make_pair(vshape, std::string(DLDataType2String(arr->dtype)));
+    };
+    mInfo.input_info.clear();
+    mInfo.output_info.clear();
+    r_output_index.clear();
+    if (r_backend == "vm") {
+      mInfo.n_inputs = r_vm_inputs.size();
+      for (auto& elem : r_vm_inputs) {
+        auto value = elem.second.defined() ? f_info(elem.second)
+                                           : std::make_pair(std::vector<int>(), "unknown");
+        mInfo.input_info.insert({elem.first, value});
+      }
+      // The outputs of the VM are known after the first run
+      mInfo.n_outputs = 0;
+      if (r_run_was_called) {
+        int64_t n_outputs = r_graph_handle.GetFunction("get_num_outputs")();
+        mInfo.n_outputs = n_outputs;
+      }
+    } else {
+      mInfo.n_inputs = r_graph_handle.GetFunction("get_num_inputs")();
+      mInfo.n_outputs = r_graph_handle.GetFunction("get_num_outputs")();
+      for (int i = 0; i < mInfo.n_inputs; ++i) {
+        std::string name = r_graph_handle.GetFunction("get_input_name")(i);
+        NDArray in_arr = r_graph_handle.GetFunction("get_input")(i);
+        mInfo.input_info.insert({name, f_info(in_arr)});
+      }
+    }
+    for (int i = 0; i < mInfo.n_outputs; ++i) {
+      std::string name = "output_" + std::to_string(i);
+      NDArray out_arr = r_graph_handle.GetFunction("get_output")(i);
+      r_output_index[name] = i;
+      mInfo.output_info.insert({name, f_info(out_arr)});
+    }
+    return mInfo;
+  }
+
   mInfo.n_inputs = r_graph_handle.GetFunction("get_num_inputs")();
   mInfo.n_outputs = r_graph_handle.GetFunction("get_num_outputs")();
 
@@ -323,9 +497,12 @@ void TVMRunner::PrintMetaInfo(void) {
   for (auto& elem : mInfo.input_info) {
     std::ostringstream stream;
     stream << "[";
-    copy(elem.second.first.begin(), elem.second.first.end() - 1,
-         std::ostream_iterator<int>(stream, ", "));
-    stream << elem.second.first.back() << "]";
+    if (!elem.second.first.empty()) {
+      copy(elem.second.first.begin(), elem.second.first.end() - 1,
+           std::ostream_iterator<int>(stream, ", "));
+      stream << elem.second.first.back();
+    }
+    stream << "]";
     LOG(INFO) << "        Input:" << elem.first;
     LOG(INFO) << "            DType:" << elem.second.second;
     LOG(INFO) << "            Shape:" << stream.str();
@@ -334,14 +511,26 @@ void TVMRunner::PrintMetaInfo(void) {
   for (auto& elem : mInfo.output_info) {
     std::ostringstream stream;
     stream << "[";
-    copy(elem.second.first.begin(), elem.second.first.end() - 1,
-         std::ostream_iterator<int>(stream, ", "));
-    stream << elem.second.first.back() << "]";
+    if (!elem.second.first.empty()) {
+      copy(elem.second.first.begin(), elem.second.first.end() - 1,
+           std::ostream_iterator<int>(stream, ", "));
+      stream << elem.second.first.back();
+    }
+    stream << "]";
     LOG(INFO) << "        Output:" << elem.first;
     LOG(INFO) << "            DType:" << elem.second.second;
     LOG(INFO) << "            Shape:" << stream.str();
   }
 }
 
+/*!
+ * \brief Run the operators of the executor on the given thread pool group.
+ * \param name The name of the group created by runtime.ThreadPoolGroupCreate.
+ */
+void TVMRunner::BindThreadPoolGroup(std::string name) {
+  LOG(INFO) << "TVMRunner::BindThreadPoolGroup:" << name;
+  r_graph_handle.GetFunction("bind_thread_pool_group")(name);
+}
+
 }  // namespace runtime
 }  // namespace tvm
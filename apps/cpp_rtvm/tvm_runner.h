@@ -28,7 +28,9 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/registry.h>
 
+#include <map>
 #include <string>
+#include <vector>
 
 #include "tvm/runtime/c_runtime_api.h"
 
@@ -48,11 +50,14 @@ typedef struct {
 
 /*!
  * \brief encapsulates TVM graph runtime functionality with simplified API interface.
+ *
+ * The model can be executed by the graph executor ("graph"), the relay virtual machine ("vm") or
+ * the AOT executor ("aot"). A runner owns its executor, concurrent sessions need one runner each.
  */
 class TVMRunner {
  public:
   /*! \brief Constructor */
-  TVMRunner(std::string path, std::string device);
+  TVMRunner(std::string path, std::string device, std::string backend = "graph");
 
   /*! \brief Initiates graph runtime and with the compiled model */
   int Load(void);
@@ -64,6 +69,8 @@ class TVMRunner {
   int SetInput(std::string);
   /*! \brief To set the input from binary data */
   int SetInput(std::string, char*);
+  /*! \brief Get the model input in binary format */
+  int GetInput(std::string, char*);
   /*! \brief Save the model output into given npz file */
   int GetOutput(std::string);
   /*! \brief Get the model output in binary format */
@@ -76,6 +83,8 @@ class TVMRunner {
   TVMMetaInfo GetMetaInfo(void);
   /*! \brief Print function to show all meta information */
   void PrintMetaInfo(void);
+  /*! \brief Run the operators of the executor on the given thread pool group */
+  void BindThreadPoolGroup(std::string);
 
  private:
   /*! \brief Module handle for the shared object */
@@ -90,6 +99,17 @@ class TVMRunner {
   TVMMetaInfo mInfo;
   /*! \brief Mark if the run method was called */
   bool r_run_was_called;
+  /*! \brief The executor backend, one of graph, vm and aot */
+  std::string r_backend;
+  /*! \brief The input arrays of the virtual machine, in the order of its parameters */
+  std::vector<std::pair<std::string, NDArray>> r_vm_inputs;
+  /*! \brief The output index of every output name */
+  std::map<std::string, int> r_output_index;
+
+  /*! \brief Get the input array of the executor */
+  NDArray GetInputArray(const std::string& input_id);
+  /*! \brief Get the output array of the executor */
+  NDArray GetOutputArray(const std::string& output_id);
 };
 
 }  // namespace runtime
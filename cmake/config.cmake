@@ -125,6 +125,9 @@ set(USE_GRAPH_EXECUTOR ON)
 # Whether enable tiny graph executor with CUDA Graph
 set(USE_GRAPH_EXECUTOR_CUDA_GRAPH OFF)
 
+# Whether enable the Relay VM with CUDA Graph
+set(USE_VM_CUDA_GRAPH OFF)
+
 # Whether enable pipeline executor.
 set(USE_PIPELINE_EXECUTOR OFF)
 
@@ -192,6 +195,9 @@ set(USE_OPENMP none)
 # Whether use contrib.random in runtime
 set(USE_RANDOM ON)
 
+# Whether use contrib.collective (allreduce, allgather) in runtime
+set(USE_COLLECTIVE ON)
+
 # Whether use NNPack
 set(USE_NNPACK OFF)
 
@@ -311,6 +317,9 @@ set(USE_THRUST OFF)
 # Whether use cuRAND
 set(USE_CURAND OFF)
 
+# Whether use NCCL for the collectives between CUDA devices
+set(USE_NCCL OFF)
+
 # Whether to build the TensorFlow TVMDSOOp module
 set(USE_TF_TVMDSOOP OFF)
 
@@ -402,6 +411,14 @@ set(BACKTRACE_ON_SEGFAULT OFF)
 # - /path/to/folder/containing/: Path to folder containing papi.pc.
 set(USE_PAPI OFF)
 
+# Whether to enable the CUPTI metric collector in profiling. It reports per
+# kernel hardware metrics of NVIDIA GPUs, such as achieved occupancy, DRAM
+# throughput and L2 hit rate. Requires USE_CUDA and CUDA 11.6 or newer.
+# Possible values:
+# - ON: enable CUPTI support, searched under the CUDA toolkit in extras/CUPTI.
+# - OFF: disable CUPTI support.
+set(USE_CUPTI OFF)
+
 # Whether to use GoogleTest for C++ unit tests. When enabled, the generated
 # build file (e.g. Makefile) will have a target "cpptest".
 # Possible values:
@@ -414,6 +431,15 @@ set(USE_PAPI OFF)
 # predefined variables to specify the path to the GTest package if needed.
 set(USE_GTEST AUTO)
 
+# Whether to build the C++ microbenchmarks in apps/benchmark/cpp with Google Benchmark.
+# Possible values:
+# - ON: enable Google Benchmark. The package `benchmark` will be required for cmake
+#   to succeed.
+# - OFF: disable Google Benchmark.
+# - AUTO: cmake will attempt to find the `benchmark` package, if found the
+#   `cppbenchmark` target will be created, otherwise it will be disabled.
+set(USE_GBENCHMARK AUTO)
+
 # Enable using CUTLASS as a BYOC backend
 # Need to have USE_CUDA=ON
 set(USE_CUTLASS OFF)
@@ -60,6 +60,21 @@ if(USE_CUDA)
     endif()
   endif(USE_CUBLAS)
 
+  if(USE_CUPTI)
+    message(STATUS "Build with CUPTI profiler support")
+    set(CUPTI_ROOT_DIR ${CUDA_TOOLKIT_ROOT_DIR}/extras/CUPTI)
+    find_library(CUDA_CUPTI_LIBRARY cupti ${CUPTI_ROOT_DIR}/lib64 ${CUPTI_ROOT_DIR}/lib)
+    find_library(CUDA_NVPERF_HOST_LIBRARY nvperf_host ${CUPTI_ROOT_DIR}/lib64 ${CUPTI_ROOT_DIR}/lib)
+    if(NOT CUDA_CUPTI_LIBRARY OR NOT CUDA_NVPERF_HOST_LIBRARY)
+      message(FATAL_ERROR "Cannot find CUPTI under ${CUPTI_ROOT_DIR}, USE_CUPTI=" ${USE_CUPTI})
+    endif()
+    include_directories(SYSTEM ${CUPTI_ROOT_DIR}/include)
+    tvm_file_glob(GLOB CONTRIB_CUPTI_SRCS src/runtime/contrib/cupti/*.cc)
+    list(APPEND RUNTIME_SRCS ${CONTRIB_CUPTI_SRCS})
+    list(APPEND TVM_RUNTIME_LINKER_LIBS ${CUDA_CUPTI_LIBRARY})
+    list(APPEND TVM_RUNTIME_LINKER_LIBS ${CUDA_NVPERF_HOST_LIBRARY})
+  endif(USE_CUPTI)
+
   if(USE_THRUST)
     message(STATUS "Build with Thrust support")
     cmake_minimum_required(VERSION 3.13) # to compile CUDA code
@@ -81,6 +96,19 @@ if(USE_CUDA)
     list(APPEND RUNTIME_SRCS ${CONTRIB_CURAND_SRC_CU})
   endif(USE_CURAND)
 
+  if(USE_NCCL)
+    message(STATUS "Build with NCCL support")
+    find_path(NCCL_INCLUDE_DIR nccl.h HINTS ${CUDA_TOOLKIT_ROOT_DIR}/include /usr/include)
+    find_library(NCCL_LIBRARY nccl HINTS ${CUDA_TOOLKIT_ROOT_DIR}/lib64 ${CUDA_TOOLKIT_ROOT_DIR}/lib)
+    if(NOT NCCL_INCLUDE_DIR OR NOT NCCL_LIBRARY)
+      message(FATAL_ERROR "Cannot find NCCL, USE_NCCL=" ${USE_NCCL})
+    endif()
+    include_directories(SYSTEM ${NCCL_INCLUDE_DIR})
+    tvm_file_glob(GLOB CONTRIB_NCCL_SRCS src/runtime/contrib/nccl/*.cc)
+    list(APPEND RUNTIME_SRCS ${CONTRIB_NCCL_SRCS})
+    list(APPEND TVM_RUNTIME_LINKER_LIBS ${NCCL_LIBRARY})
+  endif(USE_NCCL)
+
   if(USE_GRAPH_EXECUTOR_CUDA_GRAPH)
     if(NOT USE_GRAPH_EXECUTOR)
       message(FATAL_ERROR "CUDA Graph is only supported by graph executor, please set USE_GRAPH_EXECUTOR=ON")
@@ -92,6 +120,15 @@ if(USE_CUDA)
     tvm_file_glob(GLOB RUNTIME_CUDA_GRAPH_SRCS src/runtime/graph_executor/cuda_graph/*.cc)
     list(APPEND RUNTIME_SRCS ${RUNTIME_CUDA_GRAPH_SRCS})
   endif()
+
+  if(USE_VM_CUDA_GRAPH)
+    if(CUDAToolkit_VERSION_MAJOR LESS "10")
+      message(FATAL_ERROR "CUDA Graph requires CUDA 10 or above, got=" ${CUDAToolkit_VERSION})
+    endif()
+    message(STATUS "Build with Relay VM with CUDA Graph support...")
+    tvm_file_glob(GLOB RUNTIME_VM_CUDA_GRAPH_SRCS src/runtime/vm/cuda_graph/*.cc)
+    list(APPEND RUNTIME_SRCS ${RUNTIME_VM_CUDA_GRAPH_SRCS})
+  endif()
 else(USE_CUDA)
   list(APPEND COMPILER_SRCS src/target/opt/build_cuda_off.cc)
 endif(USE_CUDA)
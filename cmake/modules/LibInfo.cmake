@@ -70,6 +70,7 @@ function(add_lib_info src_file)
     TVM_INFO_USE_DNNL="${USE_DNNL}"
     TVM_INFO_USE_ETHOSN="${USE_ETHOSN}"
     TVM_INFO_USE_FALLBACK_STL_MAP="${USE_FALLBACK_STL_MAP}"
+    TVM_INFO_USE_GBENCHMARK="${USE_GBENCHMARK}"
     TVM_INFO_USE_GRAPH_EXECUTOR_CUDA_GRAPH="${USE_GRAPH_EXECUTOR_CUDA_GRAPH}"
     TVM_INFO_USE_GRAPH_EXECUTOR="${USE_GRAPH_EXECUTOR}"
     TVM_INFO_USE_GTEST="${USE_GTEST}"
@@ -95,6 +96,7 @@ function(add_lib_info src_file)
     TVM_INFO_USE_OPENCL_GTEST="${USE_OPENCL_GTEST}"
     TVM_INFO_USE_OPENMP="${USE_OPENMP}"
     TVM_INFO_USE_PAPI="${USE_PAPI}"
+    TVM_INFO_USE_CUPTI="${USE_CUPTI}"
     TVM_INFO_USE_PROFILER="${USE_PROFILER}"
     TVM_INFO_USE_PT_TVMDSOOP="${USE_PT_TVMDSOOP}"
     TVM_INFO_USE_RANDOM="${USE_RANDOM}"
@@ -116,7 +118,10 @@ function(add_lib_info src_file)
     TVM_INFO_USE_THREADS="${USE_THREADS}"
     TVM_INFO_USE_THRUST="${USE_THRUST}"
     TVM_INFO_USE_CURAND="${USE_CURAND}"
+    TVM_INFO_USE_NCCL="${USE_NCCL}"
+    TVM_INFO_USE_COLLECTIVE="${USE_COLLECTIVE}"
     TVM_INFO_USE_VITIS_AI="${USE_VITIS_AI}"
+    TVM_INFO_USE_VM_CUDA_GRAPH="${USE_VM_CUDA_GRAPH}"
     TVM_INFO_USE_VULKAN="${USE_VULKAN}"
     TVM_INFO_USE_CLML="${USE_CLML}"
     TVM_INFO_USE_CLML_GRAPH_EXECUTOR="${USE_CLML_GRAPH_EXECUTOR}"
@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/*!
+ * \brief gotvm package source for zero copy Array views over golang slices.
+ * \file arrayview.go
+ */
+
+package gotvm
+
+//#include "gotvm.h"
+import "C"
+
+import (
+    "fmt"
+    "reflect"
+    "runtime"
+    "unsafe"
+)
+
+// ArrayView is a CPU Array whose data is a golang slice, no copy is involved.
+//
+// The backing array of the slice is pinned from NewArrayView until Release,
+// so TVM can read from and write into it directly. Needs go 1.21 or above.
+type ArrayView struct {
+    handle Array
+    data   interface{}
+    pinner runtime.Pinner
+}
+
+// NewArrayView creates an ArrayView over the given slice.
+//
+// `data` is a slice of any of the types supported by Array.CopyFrom.
+//
+// `shape` is int64 slice holding shape of the view, its product must match len(data).
+//
+// returns pointer to ArrayView and error if any.
+func NewArrayView(data interface{}, shape []int64) (retVal *ArrayView, err error) {
+    sliceVal := reflect.ValueOf(data)
+    if sliceVal.Kind() != reflect.Slice || sliceVal.Len() == 0 {
+        err = fmt.Errorf("Invalid data for ArrayView creation: %T", data)
+        return
+    }
+    tvmType, err := dtypeToTVMType(sliceVal.Type().Elem().Kind().String())
+    if err != nil {
+        return
+    }
+    if len(shape) < 1 {
+        err = fmt.Errorf("Invalid shape for ArrayView creation: %v", len(shape))
+        return
+    }
+    size := int64(1)
+    for ii := range shape {
+        size *= shape[ii]
+    }
+    if size != int64(sliceVal.Len()) {
+        err = fmt.Errorf("Shape %v does not match data length %v", shape, sliceVal.Len())
+        return
+    }
+
+    view := new(ArrayView)
+    view.data = data
+    view.pinner.Pin(sliceVal.Index(0).Addr().Interface())
+
+    ndim := len(shape)
+    tensor := (*C.DLTensor)(C.malloc(C.sizeof_DLTensor))
+    nshape := (*C.int64_t)(C.malloc(C.ulong(C.sizeof_int64_t * ndim)))
+    copy((*[1<<28] int64)(unsafe.Pointer(nshape))[:ndim:ndim], shape)
+
+    tensor.data = unsafe.Pointer(sliceVal.Pointer())
+    tensor.device.device_type = C.kDLCPU
+    tensor.device.device_id = 0
+    tensor.ndim = C.int32_t(ndim)
+    tensor.dtype.code = C.uint8_t(tvmType.code)
+    tensor.dtype.bits = C.uint8_t(tvmType.bits)
+    tensor.dtype.lanes = C.uint16_t(tvmType.lanes)
+    tensor.shape = nshape
+    tensor.strides = nil
+    tensor.byte_offset = 0
+    view.handle = Array(uintptr(unsafe.Pointer(tensor)))
+
+    finalizer := func(vhandle *ArrayView) {
+        vhandle.Release()
+        vhandle = nil
+    }
+    runtime.SetFinalizer(view, finalizer)
+    retVal = view
+    return
+}
+
+// AsArray returns the Array handle of the view.
+//
+// The handle is valid until Release is called.
+func (view *ArrayView) AsArray() (retVal *Array) {
+    handle := view.handle
+    retVal = &handle
+    return
+}
+
+// Release unpins the slice and frees the native tensor of the view.
+func (view *ArrayView) Release() {
+    if view.handle == 0 {
+        return
+    }
+    tensor := (*C.DLTensor)(unsafe.Pointer(view.handle.nativeCPtr()))
+    C.free(unsafe.Pointer(tensor.shape))
+    C.free(unsafe.Pointer(tensor))
+    view.handle = 0
+    view.pinner.Unpin()
+    view.data = nil
+}
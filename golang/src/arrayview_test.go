@@ -0,0 +1,91 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/*!
+ * \brief gotvm package
+ * \file arrayview_test.go
+ */
+
+
+package gotvm
+
+import (
+    "testing"
+    "math/rand"
+)
+
+// Check ArrayView arguments are read and written in place.
+func TestArrayViewInvoke(t *testing.T) {
+    modp, err := LoadModuleFromFile("./deploy.so")
+    if err != nil {
+        t.Error(err.Error())
+        return
+    }
+    funp, err := modp.GetFunction("myadd")
+    if err != nil {
+        t.Error(err.Error())
+        return
+    }
+
+    dlen := int64(1024)
+    shape := []int64{dlen}
+    dataX := make([]float32, (dlen))
+    dataY := make([]float32, (dlen))
+    dataOut := make([]float32, (dlen))
+    for i := range dataX {
+        dataX[i] = rand.Float32()
+        dataY[i] = rand.Float32()
+    }
+
+    inX, err := NewArrayView(dataX, shape)
+    if err != nil {
+        t.Error(err.Error())
+        return
+    }
+    defer inX.Release()
+    inY, _ := NewArrayView(dataY, shape)
+    defer inY.Release()
+    out, _ := NewArrayView(dataOut, shape)
+    defer out.Release()
+
+    if _, err = funp.Invoke(inX, inY, out); err != nil {
+        t.Error(err.Error())
+        return
+    }
+    for i := range dataOut {
+        if dataX[i] + dataY[i] != dataOut[i] {
+            t.Errorf("Data expected: %v Got :%v at index %v\n", dataX[i] + dataY[i], dataOut[i], i)
+            return
+        }
+    }
+}
+
+// Check ArrayView creation errors.
+func TestArrayViewErr(t *testing.T) {
+    if _, err := NewArrayView(make([]float32, 10), []int64{5}); err == nil {
+        t.Error("Expected an error for shape mismatch, but not received\n")
+    }
+    if _, err := NewArrayView(make([]int, 10), []int64{10}); err == nil {
+        t.Error("Expected an error for unsupported type, but not received\n")
+    }
+    if _, err := NewArrayView(int32(10), []int64{1}); err == nil {
+        t.Error("Expected an error for non slice data, but not received\n")
+    }
+}
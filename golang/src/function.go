@@ -34,6 +34,7 @@ import (
     "runtime"
     "reflect"
     "fmt"
+    "sync"
 )
 
 // Function type in golang hold pointer for the TVMFunction handle.
@@ -185,30 +186,74 @@ func nativeTVMFuncFree(funp *Function) (retVal int32) {
     return
 }
 
-// nativeToGoSlice converts native TVMValue array to Golang slice of TVMValue
+// nativeArgBuffer is a native TVMValue array reused across packed function calls.
+//
+// Allocating and freeing the native argument array on every call costs two extra
+// cgo crossings, so the buffers are recycled through nativeArgPool instead.
+type nativeArgBuffer struct {
+    nptr unsafe.Pointer
+    size int
+}
+
+// nativeArgPool holds the nativeArgBuffer objects available for reuse.
+var nativeArgPool sync.Pool
+
+// nativeArgBufferMinSize is the minimum number of TVMValue slots in a pooled buffer.
+const nativeArgBufferMinSize = 8
+
+// getNativeArgBuffer returns a native TVMValue array with at least `size` slots.
 //
+// The buffer must be handed back through putNativeArgBuffer once the call returns.
+func getNativeArgBuffer(size int) (retVal *nativeArgBuffer) {
+    if buf, ok := nativeArgPool.Get().(*nativeArgBuffer); ok {
+        if buf.size >= size {
+            retVal = buf
+            return
+        }
+        // Too small for this call, leave it to the finalizer.
+    }
+    if size < nativeArgBufferMinSize {
+        size = nativeArgBufferMinSize
+    }
+    retVal = &nativeArgBuffer{C.malloc(C.ulong(C.sizeof_TVMValue * size)), size}
+    finalizer := func(buf *nativeArgBuffer) {
+        C.free(buf.nptr)
+        buf.nptr = nil
+    }
+    runtime.SetFinalizer(retVal, finalizer)
+    return
+}
+
+// putNativeArgBuffer returns the buffer to nativeArgPool.
+func putNativeArgBuffer(buf *nativeArgBuffer) {
+    nativeArgPool.Put(buf)
+}
+
+// nativeValueSlice returns a golang view over `size` TVMValue entries at `nptr`.
+func nativeValueSlice(nptr unsafe.Pointer, size int) (retVal []C.TVMValue) {
+    retVal = (*[1<<28] C.TVMValue)(nptr)[:size:size]
+    return
+}
+
+// nativeToGoSlice converts native TVMValue array to Golang slice of TVMValue
 //
-func nativeToGoSlice(nargValues (*C.void), argValues []*Value, typeCodes []int32) {
+// The copy happens on golang side, hence no cgo call is made per argument.
+func nativeToGoSlice(nargValues unsafe.Pointer, argValues []*Value, typeCodes []int32) {
+    from := nativeValueSlice(nargValues, len(argValues))
     for ii := range argValues {
-        C._TVMValueNativeGet(unsafe.Pointer(argValues[ii].nativeCPtr()),
-                             unsafe.Pointer(nargValues),
-                             C.int(int32(ii)))
+        *(*C.TVMValue)(unsafe.Pointer(argValues[ii].nativeCPtr())) = from[ii]
         argValues[ii].dtype = typeCodes[ii]
     }
 }
 
 // nativeFromGoSlice converts golang slice of TVMValue to native TVMValue array.
 //
-//
-func nativeFromGoSlice(argValues []*Value) (nptr (*C.void)) {
-    nargValues := ((uintptr)(C.malloc(C.ulong(C.sizeof_TVMValue * len(argValues)))))
+// `nargValues` must have room for len(argValues) entries.
+func nativeFromGoSlice(nargValues unsafe.Pointer, argValues []*Value) {
+    to := nativeValueSlice(nargValues, len(argValues))
     for ii := range argValues {
-        C._TVMValueNativeSet(unsafe.Pointer(nargValues),
-                             unsafe.Pointer(argValues[ii].nativeCPtr()),
-                             C.int(int32(ii)))
+        to[ii] = *(*C.TVMValue)(unsafe.Pointer(argValues[ii].nativeCPtr()))
     }
-    nptr = (*C.void)(unsafe.Pointer(nargValues))
-    return
 }
 
 // nativeTVMFuncCall executes the function with given arguments
@@ -226,18 +271,21 @@ func nativeFromGoSlice(argValues []*Value) (nptr (*C.void)) {
 // Returns err indicating native error if any.
 func nativeTVMFuncCall(funp *Function, argValues []*Value, typeCodes []int32,
                  retValues []*Value, retTypeCode *int32) (err error) {
-    nargValues := nativeFromGoSlice(argValues)
-    nretValues := nativeFromGoSlice(retValues)
+    // Arguments and return values share one pooled native buffer.
+    buf := getNativeArgBuffer(len(argValues) + len(retValues))
+    nargValues := buf.nptr
+    nretValues := unsafe.Pointer(uintptr(buf.nptr) + uintptr(C.sizeof_TVMValue * len(argValues)))
+    nativeFromGoSlice(nargValues, argValues)
+    nativeFromGoSlice(nretValues, retValues)
 	result := (int32)(C.TVMFuncCall(C.TVMFunctionHandle(*funp),
-                                    (*C.TVMValue)(unsafe.Pointer(nargValues)),
+                                    (*C.TVMValue)(nargValues),
                                     (*C.int)(unsafe.Pointer(&(typeCodes[0]))),
                                     C.int(len(argValues)),
-                                    (*C.TVMValue)(unsafe.Pointer(nretValues)),
+                                    (*C.TVMValue)(nretValues),
                                     (*C.int)(unsafe.Pointer(retTypeCode))))
     nativeToGoSlice(nargValues, argValues, typeCodes)
     nativeToGoSlice(nretValues, retValues, (*[1<<31] int32)(unsafe.Pointer(retTypeCode))[:1:1])
-    C.free(unsafe.Pointer(nargValues))
-    C.free(unsafe.Pointer(nretValues))
+    putNativeArgBuffer(buf)
 
     if result != 0 {
 	    err = errors.New(getTVMLastError())
@@ -265,7 +313,7 @@ func goTVMCallback(args C.native_voidp, typeCodes C.native_voidp, numArgs int32,
     }
 
     // Prepare arguments for golang callback function
-    nativeToGoSlice((*C.void)(unsafe.Pointer(args)), argValues,
+    nativeToGoSlice(unsafe.Pointer(args), argValues,
                     (*[1<<31] int32)(unsafe.Pointer(typeCodes))[:numArgs:numArgs])
     cbargs := argValues
 
@@ -306,15 +354,16 @@ func goTVMCallback(args C.native_voidp, typeCodes C.native_voidp, numArgs int32,
             setTVMLastError(errStr)
             return -1
         }
-        nretValues := nativeFromGoSlice(retValues)
+        buf := getNativeArgBuffer(len(retValues))
+        nativeFromGoSlice(buf.nptr, retValues)
 
         // Handle KStr, KBytes: Local finalizers shouldn't try freeing them.
         retValues[0].isLocal = false
 
         apiRet := (int32) (C.TVMCFuncSetReturn(C.TVMRetValueHandle(retArg),
-                                               (*C.TVMValue)(unsafe.Pointer(nretValues)),
+                                               (*C.TVMValue)(buf.nptr),
                                                (*C.int)(unsafe.Pointer(&retTypeCode)), 1))
-        C.free(unsafe.Pointer(nretValues))
+        putNativeArgBuffer(buf)
         if apiRet != 0 {
             errStr := string("TVMCFuncSetReturn failed ")
             setTVMLastError(errStr)
@@ -135,34 +135,52 @@ int _TVMFuncListGlobalNames(_gostring_* names) {
   return result;
 }
 
-// Helpers for TVMValue
+// Helpers for graph executor
 
 /*!
- * \brief Native helper to copy TVMValue from golang slice to native array.
- * this helper is need as underlying momory for golang slice is not continueous.
+ * \brief Native helper to set inputs, run and fetch outputs of a graph executor
+ * within a single cgo call.
  *
- * \param to_ptr is the native pointer of TVMValue array.
- * \param from_ptr pointer to TVMValue in golang slice.
- * \param array index in native array.
- */
-void _TVMValueNativeSet(void* to_ptr, void* from_ptr, int ind) {
-  TVMValue* from_p = reinterpret_cast<TVMValue*>(from_ptr);
-  TVMValue* to_p = reinterpret_cast<TVMValue*>(to_ptr);
-  memcpy(to_p + ind, from_p, sizeof(TVMValue));
-}
-
-/*!
- * \brief Native helper to copy TVMValue from golang slice to native array.
- * this helper is need as underlying momory for golang slice is not continueous.
+ * \param set_input is the graph executor "set_input" packed function.
+ * \param run is the graph executor "run" packed function.
+ * \param get_output is the graph executor "get_output" packed function.
+ * \param inputs is the native array of input tensors, bound to input index 0..num_inputs-1.
+ * \param num_inputs is the number of input tensors.
+ * \param outputs is the native array of output tensors, filled from output 0..num_outputs-1.
+ * \param num_outputs is the number of output tensors.
  *
- * \param to_ptr pointer to TVMValue in golang slice.
- * \param from_ptr is the native pointer of TVMValue array.
- * \param array index in native array.
+ * \return c_runtime_api return status of the first failing call.
  */
-void _TVMValueNativeGet(void* to_ptr, void* from_ptr, int ind) {
-  TVMValue* from_p = reinterpret_cast<TVMValue*>(from_ptr);
-  TVMValue* to_p = reinterpret_cast<TVMValue*>(to_ptr);
-  memcpy(to_p, from_p + ind, sizeof(TVMValue));
+int _TVMGraphExecutorRun(TVMFunctionHandle set_input, TVMFunctionHandle run,
+                         TVMFunctionHandle get_output, DLTensor** inputs, int num_inputs,
+                         DLTensor** outputs, int num_outputs) {
+  TVMValue args[2];
+  int type_codes[2] = {kDLInt, kTVMDLTensorHandle};
+  TVMValue ret_val;
+  int ret_type_code;
+  int result;
+
+  for (int ii = 0; ii < num_inputs; ++ii) {
+    args[0].v_int64 = ii;
+    args[1].v_handle = inputs[ii];
+    result = TVMFuncCall(set_input, args, type_codes, 2, &ret_val, &ret_type_code);
+    if (result) {
+      return result;
+    }
+  }
+  result = TVMFuncCall(run, args, type_codes, 0, &ret_val, &ret_type_code);
+  if (result) {
+    return result;
+  }
+  for (int ii = 0; ii < num_outputs; ++ii) {
+    args[0].v_int64 = ii;
+    args[1].v_handle = outputs[ii];
+    result = TVMFuncCall(get_output, args, type_codes, 2, &ret_val, &ret_type_code);
+    if (result) {
+      return result;
+    }
+  }
+  return 0;
 }
 
 extern int goTVMCallback(void*, void*, int, void*, void*);
@@ -47,9 +47,10 @@ extern char* _TVM_VERSION(void);
 // Wrappers : For incompatible cgo API.
 // To handle array of strings wrapped into __gostring__
 extern int _TVMFuncListGlobalNames(void*);
-// To handle TVMValue slice to/from native sequential TVMValue array.
-extern void _TVMValueNativeSet(void* to, void* from, int index);
-extern void _TVMValueNativeGet(void* to, void* from, int index);
+// To run a graph executor with a single cgo call.
+extern int _TVMGraphExecutorRun(TVMFunctionHandle set_input, TVMFunctionHandle run,
+                                TVMFunctionHandle get_output, DLTensor** inputs, int num_inputs,
+                                DLTensor** outputs, int num_outputs);
 
 // Callbacks
 extern int _ConvertFunction(void* fptr, void* funp);
@@ -0,0 +1,122 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/*!
+ * \brief gotvm package source for single call graph executor inference.
+ * \file graphrunner.go
+ */
+
+package gotvm
+
+//#include "gotvm.h"
+import "C"
+
+import (
+    "errors"
+    "runtime"
+    "unsafe"
+)
+
+// GraphRunner runs a graph executor module with one cgo call per inference.
+//
+// Run binds the inputs, executes the graph and copies out the outputs from
+// native code, instead of a separate Invoke for each set_input, run and get_output.
+// GraphRunner is not safe for concurrent use, same as the graph executor.
+type GraphRunner struct {
+    setInput  *Function
+    run       *Function
+    getOutput *Function
+    // Native DLTensor pointer array reused across Run calls.
+    tensors   unsafe.Pointer
+    size      int
+}
+
+// NewGraphRunner creates a GraphRunner for the given graph executor module.
+//
+// `graphmod` is the Module returned by tvm.graph_executor.create.
+//
+// returns pointer to GraphRunner and error if any.
+func NewGraphRunner(graphmod *Module) (retVal *GraphRunner, err error) {
+    runner := new(GraphRunner)
+    if runner.setInput, err = graphmod.GetFunction("set_input"); err != nil {
+        return
+    }
+    if runner.run, err = graphmod.GetFunction("run"); err != nil {
+        return
+    }
+    if runner.getOutput, err = graphmod.GetFunction("get_output"); err != nil {
+        return
+    }
+    finalizer := func(rhandle *GraphRunner) {
+        C.free(rhandle.tensors)
+        rhandle = nil
+    }
+    runtime.SetFinalizer(runner, finalizer)
+    retVal = runner
+    return
+}
+
+// Run sets the inputs, executes the graph and fetches the outputs.
+//
+// `inputs` are bound to graph input index 0..len(inputs)-1.
+//
+// `outputs` receive graph output index 0..len(outputs)-1.
+//
+// returns err if any.
+func (runner *GraphRunner) Run(inputs []*ArrayView, outputs []*ArrayView) (err error) {
+    nin := len(inputs)
+    nout := len(outputs)
+    if runner.tensors == nil || runner.size < nin + nout {
+        C.free(runner.tensors)
+        runner.size = nin + nout + 1
+        runner.tensors = C.malloc(C.ulong(C.sizeof_uintptr_t * runner.size))
+    }
+
+    tensors := (*[1<<28] uintptr)(runner.tensors)[:nin + nout:nin + nout]
+    for ii := range inputs {
+        if inputs[ii].handle == 0 {
+            err = errors.New("Run called with a released ArrayView")
+            return
+        }
+        tensors[ii] = inputs[ii].handle.nativeCPtr()
+    }
+    for ii := range outputs {
+        if outputs[ii].handle == 0 {
+            err = errors.New("Run called with a released ArrayView")
+            return
+        }
+        tensors[nin + ii] = outputs[ii].handle.nativeCPtr()
+    }
+
+    ntensors := (**C.DLTensor)(runner.tensors)
+    ret := (int32)(C._TVMGraphExecutorRun(C.TVMFunctionHandle(*runner.setInput),
+                                          C.TVMFunctionHandle(*runner.run),
+                                          C.TVMFunctionHandle(*runner.getOutput),
+                                          ntensors, C.int(nin),
+                                          (**C.DLTensor)(unsafe.Pointer(uintptr(runner.tensors) +
+                                              uintptr(C.sizeof_uintptr_t * nin))),
+                                          C.int(nout)))
+    runtime.KeepAlive(inputs)
+    runtime.KeepAlive(outputs)
+    if ret != 0 {
+        err = errors.New(getTVMLastError())
+    }
+    return
+}
@@ -322,6 +322,8 @@ func (tvmval *Value) setValue(val interface{}) (retVal int32, err error) {
             tvmval.setVBHandle(barray)
         case *Array:
             tvmval.setVAHandle(*(val.(*Array)))
+        case *ArrayView:
+            tvmval.setVAHandle(val.(*ArrayView).handle)
         case func (args ...*Value) (interface{}, error):
             fhandle, apierr := ConvertFunction(val)
             if apierr != nil {
@@ -177,6 +177,8 @@ class ConstIntBoundAnalyzer {
   std::function<void()> EnterConstraint(const PrimExpr& constraint);
   struct Entry;
   class Impl;
+  /*! \brief The parent analyzer, whose result cache is used and invalidated. */
+  Analyzer* parent_;
   /*! \brief Internal impl */
   Impl* impl_;
 };
@@ -575,6 +577,12 @@ class IntSetAnalyzer {
  * NOTE for sub-analyzer developers:
  * If the analyzer uses memoization, we need to clear the internal
  * cache when information about a Var has been overridden.
+ *
+ * The results of Simplify and const_int_bound can also be memoized
+ * across calls by EnableCache. The cache is keyed on the structure
+ * of the expression and the active constraint scope, and is cleared
+ * by every Bind. Information given directly to a sub-analyzer other
+ * than const_int_bound is not tracked, call ClearCache after it.
  */
 class TVM_DLL Analyzer {
  public:
@@ -597,6 +605,8 @@ class TVM_DLL Analyzer {
   TransitiveComparisonAnalyzer transitive_comparisons;
   /*! \brief constructor */
   Analyzer();
+  /*! \brief destructor */
+  ~Analyzer();
   /*!
    * \brief Notify all the sub-analyzers that var
    *        is created and binded to expr.
@@ -713,6 +723,35 @@ class TVM_DLL Analyzer {
    * \note Analyzer will call into sub-analyzers to get the result.
    */
   PrimExpr Simplify(const PrimExpr& expr, int steps = 2);
+  /*!
+   * \brief Memoize the results of Simplify and const_int_bound across calls.
+   *
+   * \param max_entries The number of results kept for each of them,
+   *        the cache is emptied when it is full.
+   *
+   * \note The cache is off by default, as the structural hash of each
+   *       query only pays off when the same expressions are queried again.
+   */
+  void EnableCache(size_t max_entries = 4096);
+  /*! \brief Drop all the memoized results. */
+  void ClearCache();
+
+ private:
+  friend class ConstIntBoundAnalyzer;
+  friend class ConstraintContext;
+  class Cache;
+  /*! \brief Simplify expr without looking up the memoized results. */
+  PrimExpr SimplifyNoCache(const PrimExpr& expr, int steps);
+  /*! \brief The memoized const_int_bound of expr, NullOpt if there is none. */
+  Optional<ConstIntBound> LookupCachedBound(const PrimExpr& expr) const;
+  /*! \brief Memoize the const_int_bound of expr, if the cache is enabled. */
+  void CacheBound(const PrimExpr& expr, const ConstIntBound& bound);
+  /*! \brief The memoized results, nullptr if the cache is not enabled. */
+  std::unique_ptr<Cache> cache_;
+  /*! \brief The identifier of the active constraint scope. */
+  int64_t constraint_scope_{0};
+  /*! \brief The number of constraint scopes entered so far. */
+  int64_t num_constraint_scopes_{0};
 };
 
 }  // namespace arith
@@ -38,6 +38,7 @@
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/te/schedule.h>
 
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -165,6 +166,9 @@ class AccessAnalyzer : public ObjectRef {
   TVM_DEFINE_OBJECT_REF_METHODS(AccessAnalyzer, ObjectRef, AccessAnalyzerNode);
 };
 
+/*! \brief A memo of the states returned by ComputeDAG::InferBound, defined in compute_dag.cc */
+class InferBoundMemo;
+
 /*! \brief The auto-scheduler's computational graph and related program analyses. */
 class ComputeDAGNode : public Object {
  public:
@@ -181,6 +185,11 @@ class ComputeDAGNode : public Object {
   State init_state;
   /*! \brief The static read-write access analyzer. */
   AccessAnalyzer access_analyzer;
+  /*!
+   * \brief The memo of the bounds inferred for the states of this DAG, keyed by their transform
+   * steps. It is not visited, and is null for a DAG that was not built by a constructor.
+   */
+  std::shared_ptr<InferBoundMemo> infer_bound_memo;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("tensors", &tensors);
@@ -134,6 +134,30 @@ void WriteMeasureRecords(std::ostream* os, const Array<MeasureInput>& inputs,
 void ReadMeasureRecord(const std::string& str, MeasureInputNode* inp, MeasureResultNode* res,
                        std::string* log_version);
 
+/*!
+ * \brief Convert a JSON log file to the indexed binary record format, one line at a time.
+ * \param json_file The name of the JSON log file.
+ * \param binary_file The name of the binary file to be written.
+ */
+void ConvertRecordsToBinary(const String& json_file, const String& binary_file);
+
+/*!
+ * \brief Check whether a file is in the binary record format.
+ * \param filename The name of the file.
+ * \return Whether the file starts with the magic number of the binary record format.
+ */
+bool IsBinaryRecordFile(const String& filename);
+
+/*!
+ * \brief Load the best successful records of each workload key and target from a binary file.
+ * Only the selected records are parsed.
+ * \param filename The name of the binary record file.
+ * \param top_k The number of records to load for each workload key and target.
+ * \return The MeasureInputs and MeasureResults, sorted by cost within each workload key and target.
+ */
+std::pair<Array<MeasureInput>, Array<MeasureResult>> LoadBestBinaryRecords(const String& filename,
+                                                                           int top_k = 1);
+
 }  // namespace auto_scheduler
 }  // namespace tvm
 
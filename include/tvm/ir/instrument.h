@@ -151,6 +151,38 @@ class PassInstrument : public ObjectRef {
   TVM_DEFINE_OBJECT_REF_METHODS(PassInstrument, ObjectRef, PassInstrumentNode);
 };
 
+/*!
+ * \brief A scope that times a function-level pass on one function, for the function breakdown
+ * of the pass profiling instrument. It does nothing unless the enclosing pass is profiled on the
+ * current thread, so that it is cheap to leave in place.
+ *
+ * \code
+ *
+ *   for (auto& kv : *func_dict) {
+ *     instrument::FunctionPassProfileScope scope(kv.first);
+ *     kv.second = pass_func(...);
+ *   }
+ *
+ * \endcode
+ */
+class FunctionPassProfileScope {
+ public:
+  /*!
+   * \brief Start timing the pass on a function.
+   * \param function The GlobalVar of the function.
+   */
+  TVM_DLL explicit FunctionPassProfileScope(const ObjectRef& function);
+  TVM_DLL ~FunctionPassProfileScope();
+
+ private:
+  /*! \brief The profile of the enclosing pass, or nullptr if it is not profiled. */
+  void* profile_{nullptr};
+  /*! \brief The function being transformed. */
+  ObjectRef function_;
+  /*! \brief The start time, in nanoseconds of the steady clock. */
+  int64_t start_ns_{0};
+};
+
 }  // namespace instrument
 }  // namespace tvm
 
@@ -136,6 +136,13 @@ class Builder : public runtime::ObjectRef {
    * \return The Builder created.
    */
   static Builder PyBuilder(BuilderNode::FBuild f_build);
+  /*!
+   * \brief Create a builder that builds the inputs in parallel in the current process, and keeps
+   * the built modules in memory for the runners in the same process.
+   * \param max_workers The number of threads to build with.
+   * \return The Builder created.
+   */
+  TVM_DLL static Builder InProcessBuilder(int max_workers);
   TVM_DEFINE_MUTABLE_NOTNULLABLE_OBJECT_REF_METHODS(Builder, runtime::ObjectRef, BuilderNode);
 };
 
@@ -21,6 +21,7 @@
 #define TVM_META_SCHEDULE_COST_MODEL_H_
 
 #include <tvm/meta_schedule/arg_info.h>
+#include <tvm/meta_schedule/feature_extractor.h>
 #include <tvm/meta_schedule/measure_candidate.h>
 #include <tvm/meta_schedule/runner.h>
 #include <tvm/node/reflection.h>
@@ -165,6 +166,55 @@ class CostModel : public runtime::ObjectRef {
                                        PyCostModelNode::FUpdate f_update,    //
                                        PyCostModelNode::FPredict f_predict,  //
                                        PyCostModelNode::FAsString f_as_string);
+  /*!
+   * \brief Create a gradient-boosted decision tree cost model trained natively, which scores a
+   * candidate by the sum of the tree outputs of its feature rows, like the XGBoost cost model.
+   * The trees are grown with histograms over quantized features, and the model keeps boosting
+   * from its current trees as new results arrive.
+   * \param extractor The feature extractor.
+   * \param max_depth The maximum depth of a tree.
+   * \param eta The learning rate.
+   * \param gamma The minimum loss reduction of a split.
+   * \param min_child_weight The minimum sum of the hessians of a child.
+   * \param reg_lambda The L2 regularization on the leaf values.
+   * \param num_bins The maximum number of bins a feature is quantized into, at most 256.
+   * \param max_num_rounds The maximum number of boosting rounds of one training.
+   * \param early_stopping_rounds The number of rounds without improvement before a training stops.
+   * \param max_num_trees The number of trees beyond which the model is retrained from scratch.
+   * \param num_warmup_samples The number of samples before which the predictions are random.
+   * \param adaptive_training Whether to skip the training until the data grows by 20%.
+   * \param seed The random seed of the predictions during the warmup.
+   * \return The cost model created.
+   */
+  TVM_DLL static CostModel GBDTModel(FeatureExtractor extractor, int max_depth, double eta,
+                                     double gamma, double min_child_weight, double reg_lambda,
+                                     int num_bins, int max_num_rounds, int early_stopping_rounds,
+                                     int max_num_trees, int num_warmup_samples,
+                                     bool adaptive_training, int64_t seed);
+  /*!
+   * \brief Create a segment-sum MLP cost model trained and run natively, with the network and the
+   * training of the python MLP cost model. Its weights are saved and loaded as a TVM parameter
+   * dict named after the PyTorch state dict of `SegmentSumMLP`.
+   * \param extractor The feature extractor.
+   * \param hidden_dim The hidden dim of the layers.
+   * \param use_sigmoid Whether to apply a sigmoid on the output.
+   * \param batch_size The number of candidates in a training batch.
+   * \param learning_rate The learning rate.
+   * \param weight_decay The L2 penalty added to the gradients.
+   * \param num_epoch_full The number of epochs of a full training.
+   * \param num_epoch_incremental The number of epochs of an incremental training.
+   * \param grad_clip_norm The maximum norm of the gradients.
+   * \param test_split The fraction of the workloads held out to select the best epoch.
+   * \param frozen Whether to keep the weights as they are, e.g. when they are pre-trained.
+   * \param seed The random seed of the initialization and the shuffling.
+   * \return The cost model created.
+   */
+  TVM_DLL static CostModel SegmentSumMLPModel(FeatureExtractor extractor, int hidden_dim,
+                                              bool use_sigmoid, int batch_size,
+                                              double learning_rate, double weight_decay,
+                                              int num_epoch_full, int num_epoch_incremental,
+                                              double grad_clip_norm, double test_split,
+                                              bool frozen, int64_t seed);
   TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(CostModel, ObjectRef, CostModelNode);
 };
 
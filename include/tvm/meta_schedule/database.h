@@ -477,6 +477,28 @@ class Database : public runtime::ObjectRef {
    */
   TVM_DLL static Database JSONDatabase(String path_workload, String path_tuning_record,
                                        bool allow_missing, String mod_eq_name = "structural");
+  /*!
+   * \brief Create a database that stores the workloads and tuning records in a compact,
+   * append-only binary log, with an index at `path + ".index"`. Opening it only reads the index
+   * and the workloads, and the tuning records are decoded from a memory-mapped view of the log
+   * when queried.
+   * \param path The path to the binary log.
+   * \param allow_missing Whether to create new file when the given path is not found.
+   * \param mod_eq_name A string to specify the module equality testing and hashing method.
+   */
+  TVM_DLL static Database BinaryDatabase(String path, bool allow_missing,
+                                         String mod_eq_name = "structural");
+  /*!
+   * \brief Create a database that many processes, possibly on different hosts sharing a file
+   * system, commit to concurrently. Each process appends to a binary log of its own in the
+   * directory, and reads the logs of the others, which are refreshed incrementally.
+   * \param path The directory of the binary logs.
+   * \param refresh_interval_sec The minimum interval between two refreshes, in seconds.
+   * \param allow_missing Whether to create the directory when the given path is not found.
+   * \param mod_eq_name A string to specify the module equality testing and hashing method.
+   */
+  TVM_DLL static Database SharedDatabase(String path, double refresh_interval_sec,
+                                         bool allow_missing, String mod_eq_name = "structural");
   /*!
    * \brief A database composed of multiple databases, allowing users to guide IR rewriting using
    * combined knowledge of those databases. To each query, it returns the best record among all the
@@ -47,7 +47,11 @@ class ExtractedTaskNode : public runtime::Object {
   IRModule mod;
   /*! \brief Target */
   Target target;
-  /*! \brief A list of low-level IRs that the high-level IR could potentially dispatch to */
+  /*!
+   * \brief A list of low-level IRs that the high-level IR could potentially dispatch to. With the
+   * anchor-block module equality, the first one is tuned, and the others are the distinct
+   * subgraphs deduplicated into this task because they share its anchor block.
+   */
   Array<IRModule> dispatched;
   /*! \brief Weight of the task */
   int weight;
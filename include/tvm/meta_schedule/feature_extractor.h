@@ -108,6 +108,13 @@ class FeatureExtractor : public runtime::ObjectRef {
                                                   int arith_intensity_curve_num_samples = 10,
                                                   int cache_line_bytes = 64,
                                                   bool extract_workload = false);
+  /*!
+   * \brief Create a feature extractor that appends the features of the target, e.g. the number of
+   * cores and the vector ISA, to every feature vector extracted by another extractor.
+   * \param extractor The feature extractor whose features are extended.
+   * \return The feature extractor created.
+   */
+  TVM_DLL static FeatureExtractor TargetFeature(FeatureExtractor extractor);
   /*!
    * \brief Create a feature extractor with customized methods on the python-side.
    * \param f_extract_from The packed function of `ExtractFrom`.
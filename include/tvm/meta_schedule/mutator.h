@@ -98,6 +98,14 @@ class Mutator : public runtime::ObjectRef {
   using FAsString = runtime::TypedPackedFunc<String()>;
   /*! \brief Create a Mutator that mutates the decision of instruction Sample-Perfect-Tile */
   TVM_DLL static Mutator MutateTileSize();
+  /*!
+   * \brief Create a Mutator that mutates the decision of instruction Sample-Perfect-Tile, keeping
+   * among several proposals the one that makes the best use of the data caches of the target,
+   * using its `l1_cache_bytes` and `l2_cache_bytes` attributes
+   * \param num_proposals The number of proposals to choose from in each mutation.
+   * \return The created mutator.
+   */
+  TVM_DLL static Mutator MutateTileSizeCacheAware(int num_proposals);
   /*!
    * \brief Create a Mutator that mutates the parallel extent
    * \param max_jobs_per_core The maximum number of parallel jobs per core.
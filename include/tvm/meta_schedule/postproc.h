@@ -154,12 +154,28 @@ class Postproc : public runtime::ObjectRef {
    * \return The postprocessor created
    */
   TVM_DLL static Postproc VerifyVTCMLimit();
+  /*!
+   * \brief Creates a postprocessor that verifies that the estimated register pressure of the
+   * innermost loops, after vectorization and unrolling, does not exceed the vector registers of
+   * the target.
+   * \note It is not part of the default postprocessors, it has to be added explicitly.
+   * \param max_registers The number of vector registers, or -1 to infer it from the target.
+   * \param vector_bits The width of a vector register in bits, or -1 to infer it from the target.
+   * \return The postprocessor created
+   */
+  TVM_DLL static Postproc VerifyRegisterPressure(int max_registers = -1, int vector_bits = -1);
   /*!
    * \brief Creates a postprocessor that rewrites the layout of input tensor
    * \note Weight layout rewrite is supported so far, activation layout rewrite will be added.
    * \return The postprocessor created
    */
   TVM_DLL static Postproc RewriteLayout();
+  /*!
+   * \brief Creates a postprocessor that annotates the loops along which blocks read the inputs with
+   * a stride or a gather, so that InjectSoftwarePrefetch prefetches the loads ahead of their use
+   * \return The postprocessor created
+   */
+  TVM_DLL static Postproc RewriteSoftwarePrefetch();
   /*! \brief Create default postprocessors for LLVM */
   TVM_DLL static Array<Postproc, void> DefaultLLVM();
   /*! \brief Create default postprocessors for x86 (AVX512 and VNNI) */
@@ -202,13 +202,16 @@ class ScheduleRule : public runtime::ObjectRef {
    * \param reuse_read Data reuse configuration for reading. NullOpt means no reuse.
    * \param reuse_write Data reuse configuration for writing. NullOpt means no reuse.
    * \param use_software_pipeline Whether use the software pipeline.
+   * \param raster_group_sizes The candidate numbers of rows of tiles that the thread blocks are
+   * launched in groups of, for the L2 cache reuse between them. NullOpt means row-major order.
    * \return The schedule rule created
    */
   TVM_DLL static ScheduleRule MultiLevelTilingTensorCore(
       Array<Map<String, String>> intrin_groups, String structure,
       Optional<Array<String>> tile_binds, Optional<Integer> max_innermost_factor,
       Optional<Array<Integer>> vector_load_lens, Optional<Map<String, ObjectRef>> reuse_read,
-      Optional<Map<String, ObjectRef>> reuse_write, bool use_software_pipeline);
+      Optional<Map<String, ObjectRef>> reuse_write, bool use_software_pipeline,
+      Optional<Array<Integer>> raster_group_sizes);
 
   /*!
    * \brief Extension of MultiLevelTiling for backends with wide vectors.
@@ -247,6 +250,15 @@ class ScheduleRule : public runtime::ObjectRef {
    * \return The schedule rule created
    */
   TVM_DLL static ScheduleRule RandomComputeLocation();
+  /*!
+   * \brief Create a rule that fuses a producer into its only consumer, a reduction block such as
+   * a convolution, so that the intermediate tensor is not materialized. When the windows of the
+   * consumer overlap, e.g. the kernel of a convolution is larger than its stride, the producer
+   * keeps the lines of the windows in a rolling buffer, and computes each of them once. It is
+   * recommended to run the rule after MultiLevelTiling, so that the lines cover the tiles.
+   * \return The schedule rule created
+   */
+  TVM_DLL static ScheduleRule RollingBufferFusion();
   /*!
    * \brief Mark parallelize, vectorize and unroll to the root block. The mark will be applied to
    * each block in a follow-up post processor
@@ -290,12 +302,17 @@ class ScheduleRule : public runtime::ObjectRef {
 
   /*! \brief Create default schedule rules for LLVM */
   TVM_DLL static Array<ScheduleRule, void> DefaultLLVM();
-  /*! \brief Create default schedule rules for x86 (AVX512 and VNNI) */
+  /*!
+   * \brief Create default schedule rules for x86 (AVX512, VNNI and AMX). The AMX rules are only
+   * used on request, as measuring them needs runtime.amx_init in the measuring process.
+   */
   TVM_DLL static Array<ScheduleRule, void> DefaultX86(const String& type);
   /*! \brief Create default schedule rules for CUDA */
   TVM_DLL static Array<ScheduleRule, void> DefaultCUDA();
   /*! \brief Create default postprocessors for CUDA with TensorCore */
   TVM_DLL static Array<ScheduleRule, void> DefaultCUDATensorCore();
+  /*! \brief Create default schedule rules for Vulkan with cooperative matrices */
+  TVM_DLL static Array<ScheduleRule, void> DefaultVulkanCooperativeMatrix();
   /*! \brief Create default schedule rules for Hexagon */
   TVM_DLL static Array<ScheduleRule, void> DefaultHexagon();
   /*! \brief Create default schedule rules for Micro */
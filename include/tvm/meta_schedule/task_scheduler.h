@@ -277,6 +277,19 @@ class TaskScheduler : public runtime::ObjectRef {
    */
   TVM_DLL static TaskScheduler GradientBased(PackedFunc logger, double alpha, int window_size,
                                              support::LinearCongruentialEngine::TRandState seed);
+  /*!
+   * \brief Create a task scheduler that retires the tasks converged and spends the remaining
+   * trials on the ones with the highest weighted expected gain.
+   * \param logger The tuning task's logging function.
+   * \param window_size The number of recent rounds the convergence is detected over.
+   * \param tolerance The relative improvement per round below which a task is converged.
+   * \param confidence The confidence level of the upper bound on the mean improvement.
+   * \param seed The random seed.
+   * \return The task scheduler created.
+   */
+  TVM_DLL static TaskScheduler ConvergenceBased(PackedFunc logger, int window_size,
+                                                double tolerance, double confidence,
+                                                support::LinearCongruentialEngine::TRandState seed);
   /*!
    * \brief Create a task scheduler with customized methods on the python-side.
    * \param logger The tuning task's logging function.
@@ -47,5 +47,28 @@ TVM_DLL std::string SaveJSON(const runtime::ObjectRef& node);
  */
 TVM_DLL runtime::ObjectRef LoadJSON(std::string json_str);
 
+/*!
+ * \brief Save the node as well as all the nodes it depends on in a binary format.
+ *  It holds the same graph as SaveJSON, with the data of the NDArrays stored raw and aligned.
+ *
+ * \param node The node to save.
+ * \return The bytes of the node.
+ */
+TVM_DLL std::string SaveBinary(const runtime::ObjectRef& node);
+
+/*!
+ * \brief Load the node saved by SaveBinary.
+ * \param blob The bytes of the node.
+ * \return The node, with copies of its NDArrays.
+ */
+TVM_DLL runtime::ObjectRef LoadBinary(const std::string& blob);
+
+/*!
+ * \brief Load the node saved by SaveBinary into a file.
+ * \param path The path of the file.
+ * \return The node, the NDArrays of which point into the mapping of the file.
+ */
+TVM_DLL runtime::ObjectRef LoadBinaryFromFile(const std::string& path);
+
 }  // namespace tvm
 #endif  // TVM_NODE_SERIALIZATION_H_
@@ -27,6 +27,7 @@
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/ndarray.h>
 
+#include <atomic>
 #include <functional>
 #include <string>
 
@@ -153,6 +154,11 @@ class SHashReducer {
      *        Graph node hash will depends on the graph structure.
      */
     virtual void MarkGraphNode() = 0;
+    /*!
+     * \brief Mark that the current hash covers a floating point value. StructuralEqual compares
+     *        them with a tolerance and 0.0 equals -0.0, so equal nodes can hash differently.
+     */
+    virtual void MarkInexactValue() {}
   };
 
   /*! \brief default constructor */
@@ -174,6 +180,22 @@ class SHashReducer {
     // handle normal values.
     handler_->SHashReduceHashedValue(BaseValueHash()(key));
   }
+  /*!
+   * \brief Push hash of a floating point value to the current sequence of hash values.
+   * \param key The value to be hashed.
+   */
+  void operator()(const double& key) const {
+    handler_->SHashReduceHashedValue(BaseValueHash()(key));
+    handler_->MarkInexactValue();
+  }
+  /*!
+   * \brief Push hash of a floating point value to the current sequence of hash values.
+   * \param key The value to be hashed.
+   */
+  void operator()(const float& key) const {
+    handler_->SHashReduceHashedValue(BaseValueHash()(key));
+    handler_->MarkInexactValue();
+  }
   /*!
    * \brief Push hash of key to the current sequence of hash values.
    * \param key The key to be hashed.
@@ -223,6 +245,7 @@ class SHashHandlerDefault : public SHashReducer::Handler {
   void SHashReduceFreeVar(const runtime::Object* var, bool map_free_vars) override;
   bool LookupHashedValue(const ObjectRef& key, uint64_t* hashed_value) override;
   void MarkGraphNode() override;
+  void MarkInexactValue() override;
 
   /*!
    * \brief The entry point for hashing
@@ -246,6 +269,114 @@ class SHashHandlerDefault : public SHashReducer::Handler {
   Impl* impl;
 };
 
+/*!
+ * \brief A slot caching the structural hash of an immutable node, when it is hashed as a root.
+ *
+ * The node types opting in register the slot with TVM_REGISTER_SHASH_CACHE. The first
+ * StructuralHash of a node fills the slot, and the next ones return it. A copy of the node has an
+ * empty slot, and the CopyOnWrite of the type has to clear it, as it mutates a unique node in
+ * place. StructuralEqual returns false at once for two nodes whose cached hashes differ, unless
+ * one of them covers floating point values, as equal values can then have different hashes.
+ *
+ * \note Only the hashes of a node as a root are cached, as the hash of a node within another one
+ *  depends on the variables defined before it in the traversal.
+ */
+class SHashCache {
+ public:
+  SHashCache() = default;
+  SHashCache(const SHashCache&) {}
+  SHashCache& operator=(const SHashCache&) {
+    Clear();
+    return *this;
+  }
+
+  /*!
+   * \brief Get the cached hash.
+   * \param map_free_vars Whether the free variables were remapped.
+   * \param value The hash, set when it is cached.
+   * \return Whether the hash is cached.
+   */
+  bool Get(bool map_free_vars, uint64_t* value) const {
+    const Slot& slot = slots_[map_free_vars];
+    if (!slot.valid.load(std::memory_order_acquire)) return false;
+    *value = slot.value.load(std::memory_order_relaxed);
+    return true;
+  }
+
+  /*!
+   * \brief Get the cached hash, if nodes with different such hashes are never equal.
+   * \param map_free_vars Whether the free variables were remapped.
+   * \param value The hash, set when it is cached and consistent with StructuralEqual.
+   * \return Whether such a hash is cached.
+   */
+  bool GetExact(bool map_free_vars, uint64_t* value) const {
+    const Slot& slot = slots_[map_free_vars];
+    if (!slot.valid.load(std::memory_order_acquire) ||
+        !slot.exact.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    *value = slot.value.load(std::memory_order_relaxed);
+    return true;
+  }
+
+  /*!
+   * \brief Cache a hash.
+   * \param map_free_vars Whether the free variables were remapped.
+   * \param value The hash.
+   * \param exact Whether the hash is consistent with StructuralEqual, i.e. it covers no floating
+   *  point value.
+   */
+  void Set(bool map_free_vars, uint64_t value, bool exact) const {
+    Slot& slot = slots_[map_free_vars];
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.exact.store(exact, std::memory_order_relaxed);
+    slot.valid.store(true, std::memory_order_release);
+  }
+
+  /*! \brief Drop the cached hashes, when the node is mutated. */
+  void Clear() {
+    for (Slot& slot : slots_) slot.valid.store(false, std::memory_order_relaxed);
+  }
+
+  /*! \brief Get the slot of a node of a registered type. */
+  using FGetCache = const SHashCache* (*)(const runtime::Object* node);
+  /*!
+   * \brief Register the cache slot of a node type.
+   * \param type_index The type index of the node.
+   * \param fget The function getting the slot of a node.
+   * \return true, to be used by the registration macro.
+   */
+  TVM_DLL static bool RegisterType(uint32_t type_index, FGetCache fget);
+  /*!
+   * \brief Find the cache slot of a node.
+   * \param node The node.
+   * \return The slot, nullptr when the type of the node has none.
+   */
+  TVM_DLL static const SHashCache* Find(const runtime::Object* node);
+
+ private:
+  struct Slot {
+    std::atomic<bool> valid{false};
+    std::atomic<bool> exact{false};
+    std::atomic<uint64_t> value{0};
+  };
+  /*! \brief The hashes without and with the free variables remapped. */
+  mutable Slot slots_[2];
+};
+
+/*!
+ * \brief Register the SHashCache member of a node type.
+ * \param NodeType The node type.
+ * \param Field The SHashCache member.
+ */
+#define TVM_REGISTER_SHASH_CACHE(NodeType, Field)                                         \
+  static DMLC_ATTRIBUTE_UNUSED bool TVM_STR_CONCAT(__make_shash_cache_, __COUNTER__) =    \
+      ::tvm::SHashCache::RegisterType(                                                    \
+          NodeType::RuntimeTypeIndex(),                                                   \
+          [](const ::tvm::runtime::Object* node) -> const ::tvm::SHashCache* {            \
+            return &static_cast<const NodeType*>(node)->Field;                            \
+          })
+
 class SEqualReducer;
 struct NDArrayContainerTrait {
   static constexpr const std::nullptr_t VisitAttrs = nullptr;
@@ -1135,6 +1135,20 @@ struct BatchMatmulAttrs : public tvm::AttrsNode<BatchMatmulAttrs> {
   }
 };
 
+/*! \brief Attributes for attention operator */
+struct AttentionAttrs : public tvm::AttrsNode<AttentionAttrs> {
+  double scale;
+  bool causal;
+
+  TVM_DECLARE_ATTRS(AttentionAttrs, "relay.attrs.AttentionAttrs") {
+    TVM_ATTR_FIELD(scale).set_default(0.0).describe(
+        "The scale of the dot products of the query and the keys. If zero, 1/sqrt(head size) is "
+        "used.");
+    TVM_ATTR_FIELD(causal).set_default(false).describe(
+        "Whether a query only attends to the keys at or before its position.");
+  }
+};
+
 /*! \brief Attributes for sparse_dense operator */
 struct SparseDenseAttrs : public tvm::AttrsNode<SparseDenseAttrs> {
   bool sparse_lhs;
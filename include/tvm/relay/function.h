@@ -195,6 +195,28 @@ constexpr const char* kInline = "Inline";
 constexpr const char* kPartitionedFromPattern = "PartitionedFromPattern";
 /*! \brief Mark the function as only composed of reshape operations. */
 constexpr const char* kReshapeOnly = "relay.reshape_only";
+/*!
+ * \brief Mark the function as a slice of its input which is contiguous in the input, starting at
+ * this byte offset, so that its result can be a view of the input.
+ */
+constexpr const char* kViewByteOffset = "relay.view_byte_offset";
+/*!
+ * \brief The indices of the parameters of the function whose buffer can also hold its result, as
+ * each element of the result only depends on the element of the parameter at the same index.
+ */
+constexpr const char* kInplaceParams = "relay.inplace_params";
+/*!
+ * \brief The byte offset in the result of the function of each of its parameters, when the
+ * function concatenates its parameters into contiguous slices of the result, so that the producers
+ * of the parameters can write their results into the result of the function directly.
+ */
+constexpr const char* kConcatByteOffsets = "relay.concat_byte_offsets";
+/*!
+ * \brief Mark the function as a single weight layout transform of one of its parameters, as
+ * inserted by RewriteLayout, so that when the parameter is a parameter of the model the result can
+ * be computed once when the parameters are loaded rather than at every run.
+ */
+constexpr const char* kLayoutTransformOnly = "relay.layout_transform_only";
 
 }  // namespace attr
 
@@ -262,6 +262,10 @@ TVM_DLL Pass DynamicToStatic();
  * type information filled in, as well as it's checked type field
  * populated with the result type.
  *
+ * When the `relay.InferType.incremental` option of the pass context is set, the expressions
+ * produced by any pass since the previous InferType in the same pass context are re-checked
+ * together with the expressions using them, and the checked types of the others are reused.
+ *
  * \return The pass.
  */
 TVM_DLL Pass InferType();
@@ -327,6 +331,17 @@ TVM_DLL Pass CombineParallelDense(uint64_t min_num_branches = 3, bool to_batch_m
  */
 TVM_DLL Pass CombineParallelBatchMatmul(uint64_t min_num_branches = 3);
 
+/*!
+ * \brief Combine dense ops that have the same shapes and do not depend on each other into a
+ * single batch_matmul, if there are at least `min_num_ops` of them. Unlike
+ * CombineParallelDense, the dense ops do not need to share their input.
+ *
+ * \param min_num_ops The minimum number of dense ops to combine.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass CombineIndependentDense(uint64_t min_num_ops = 3);
+
 /*!
  * \brief Backward fold axis scaling into weights of conv/dense operators.
  *
@@ -474,6 +489,30 @@ TVM_DLL Pass SimplifyExpr();
  */
 TVM_DLL Pass SimplifyExprPostAlterOp();
 
+/*!
+ * \brief Choose the layout of each region of element-wise ops between layout_transforms to move
+ * the fewest bytes through layout_transforms, then merge consecutive layout_transforms.
+ *
+ * The pass runs at opt_level 4, after AlterOpLayout, or when it is a required pass.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass PlanLayoutTransforms();
+
+/*!
+ * \brief Recompute the outputs of injective ops next to their late consumers, instead of keeping
+ * them alive in between, until the estimated peak of live bytes fits in the memory budget.
+ *
+ * Only the tensors whose inputs are alive at their late consumers anyway are recomputed, so the
+ * pass trades a few element-wise ops for activation memory, e.g. in gradient graphs. It expects
+ * the graph normal form. The build runs it when "relay.Rematerialize.memory_budget" is set.
+ *
+ * \param memory_budget The bytes of the tensors alive at once to aim for.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass Rematerialize(Integer memory_budget);
+
 /*!
  * \brief Run any custom passes registered under "RelayToTIR" attributes on TargetKinds.
  *
@@ -539,6 +578,16 @@ TVM_DLL Pass ManifestAlloc(VirtualDevice cpu_virtual_device);
  */
 TVM_DLL Pass ManifestLifetimes();
 
+/*!
+ * \brief A pass packing the storages of statically known size allocated in the top-level let
+ * chain of each function into a single arena per virtual device, with offsets assigned at compile
+ * time from the storage lifetimes. Storages reachable from the result of the function are left
+ * alone. This pass should be run after ManifestLifetimes.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass PlanStaticStorage();
+
 /*!
  * \brief Uses existing "on_device" and "device_copy" CallNodes to infer the \p VirtualDevice on
  * which every Relay sub-expression should run and the result stored. Captures the result of that
@@ -554,6 +603,21 @@ TVM_DLL Pass ManifestLifetimes();
  */
 TVM_DLL Pass PlanDevices(CompilationConfig config);
 
+/*!
+ * \brief Shard the constant weights of nn.dense across the devices of a mesh, for tensor
+ * parallel execution of the models whose weights exceed the memory of one device.
+ *
+ * By column, every device computes a slice of the output columns, gathered by a concatenate. By
+ * row, every device computes a partial sum on a slice of the reduction axis, reduced by adds. The
+ * shards are annotated by on_device, so the pass must run before PlanDevices.
+ *
+ * \param devices The devices of the mesh, one shard per device.
+ * \param mode Split the weights by "column" or by "row".
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass ShardDense(Array<VirtualDevice> devices, String mode);
+
 /*!
  * \brief This transform flattens atrous convolution, which corresponds to the sequence of
  * operations: "space_to_batch_nd"->"conv2d"->"batch_to_space_nd" and convert them into subgraphs
@@ -166,6 +166,21 @@ TVM_DLL int TVMBackendParallelBarrier(int task_id, TVMParallelGroupEnv* penv);
  */
 TVM_DLL int TVMBackendRunOnce(void** handle, int (*f)(void*), void* cdata, int nbytes);
 
+/*!
+ * \brief Mark the beginning of a region inserted by the InstrumentProfileIntrinsics pass.
+ * \param func_name The name of the PrimFunc containing the region.
+ * \param region_id The id of the region.
+ * \return 0 when no error is thrown, -1 when failure happens
+ */
+TVM_DLL int TVMBackendProfileRegionBegin(const char* func_name, int32_t region_id);
+
+/*!
+ * \brief Mark the end of a region inserted by the InstrumentProfileIntrinsics pass.
+ * \param region_id The id of the region.
+ * \return 0 when no error is thrown, -1 when failure happens
+ */
+TVM_DLL int TVMBackendProfileRegionEnd(int32_t region_id);
+
 #ifdef __cplusplus
 }  // TVM_EXTERN_C
 #endif
@@ -95,7 +95,7 @@ class ADT : public ObjectRef {
   template <typename Iterator>
   ADT(int32_t tag, Iterator begin, Iterator end) {
     size_t num_elems = std::distance(begin, end);
-    auto ptr = make_inplace_array_object<ADTObj, ObjectRef>(num_elems);
+    auto ptr = PooledObjAllocator().make_inplace_array<ADTObj, ObjectRef>(num_elems);
     ptr->tag = tag;
     ptr->Init(begin, end);
     data_ = std::move(ptr);
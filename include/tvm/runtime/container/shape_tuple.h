@@ -164,7 +164,7 @@ class ShapeTuple : public ObjectRef {
 };
 
 inline ShapeTuple::ShapeTuple(std::vector<index_type> shape) {
-  auto ptr = make_object<ShapeTupleObj::FromStd>(std::move(shape));
+  auto ptr = PooledObjAllocator().make_object<ShapeTupleObj::FromStd>(std::move(shape));
   ptr->size = ptr->data_container.size();
   ptr->data = ptr->data_container.data();
   data_ = std::move(ptr);
@@ -46,6 +46,7 @@ typedef struct TVMOpParam {
 typedef struct TVMGraphExecutorGraphAttr {
   uint32_t storage_num_not_alloctaed;
   uint32_t* storage_id;
+  uint32_t* storage_offset;  // NULL when the entries are all at the start of their storage
   uint32_t* device_index;
   char* dltype;  // "int8", "int16", "float32"
   uint32_t dltype_count;
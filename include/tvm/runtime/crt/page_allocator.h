@@ -37,6 +37,21 @@ extern int vleak_size;
 
 typedef struct MemoryManagerInterface MemoryManagerInterface;
 
+/*! \brief The usage statistics of a memory manager, in bytes. */
+typedef struct MemoryManagerStats {
+  /*! \brief The number of bytes that can be allocated when nothing is allocated. */
+  size_t total_bytes;
+  /*! \brief The number of bytes taken by the allocated blocks, including their rounding. */
+  size_t used_bytes;
+  /*! \brief The largest used_bytes since the manager was created. */
+  size_t peak_used_bytes;
+  /*! \brief The size of the largest block that can be allocated, which is smaller than the free
+   *  bytes when the free memory is fragmented. */
+  size_t largest_free_bytes;
+  /*! \brief The number of allocated blocks. */
+  size_t num_allocations;
+} MemoryManagerStats;
+
 struct MemoryManagerInterface {
   /*!
    * \brief Allocate a chunk of memory.
@@ -59,6 +74,15 @@ struct MemoryManagerInterface {
    */
   tvm_crt_error_t (*Free)(MemoryManagerInterface* interface, void* ptr, DLDevice dev);
 
+  /*!
+   * \brief Get the usage statistics of the memory.
+   *
+   * \param interface Pointer to this structure.
+   * \param stats The statistics.
+   * \return kTvmErrorNoError if successful; a descriptive error code otherwise.
+   */
+  tvm_crt_error_t (*GetStats)(MemoryManagerInterface* interface, MemoryManagerStats* stats);
+
   /*! \brief Used in testing; the number of allocated objects. */
   int vleak_size;
 };
@@ -88,6 +88,16 @@ class Session {
    */
   typedef void (*MessageReceivedFunc)(void* context, MessageType message_type, FrameBuffer* buf);
 
+  /*! \brief Callback invoked when a part of a normal message of the session is received.
+   *
+   * It is called after the part is written to the receive buffer, until the message is complete or
+   * StreamMessageBody is called. It can then redirect the rest of the message body.
+   *
+   * \param context The value of `context` passed to SetMessageChunkReceivedFunc.
+   * \param buf The receive buffer, which starts with the SessionHeader of the message.
+   */
+  typedef void (*MessageChunkReceivedFunc)(void* context, FrameBuffer* buf);
+
   /*! \brief An invalid nonce value that typically indicates an unknown nonce. */
   static constexpr const uint8_t kInvalidNonce = 0;
 
@@ -182,6 +192,40 @@ class Session {
   /*! \brief Returns true if the session is in the established state. */
   bool IsEstablished() const { return state_ == State::kSessionEstablished; }
 
+  /*!
+   * \brief Set the callback invoked when a part of a normal message is received.
+   * \param func The callback, or nullptr.
+   * \param context A value passed to the callback.
+   */
+  void SetMessageChunkReceivedFunc(MessageChunkReceivedFunc func, void* context) {
+    message_chunk_received_func_ = func;
+    message_chunk_received_func_context_ = context;
+  }
+
+  /*!
+   * \brief Write the next bytes of the message being received to memory, instead of the receive
+   * buffer, so that the message can be larger than the receive buffer.
+   *
+   * Called from MessageChunkReceivedFunc. The bytes are written as they arrive, before the CRC of
+   * the packet is checked. A message dropped on a CRC error is never handled.
+   *
+   * \param data The memory where the bytes are written.
+   * \param size_bytes The number of bytes written there.
+   */
+  void StreamMessageBody(uint8_t* data, size_t size_bytes);
+
+  /*!
+   * \brief Read the bytes written by StreamMessageBody, while the message is handled.
+   *
+   * The bytes are already in place: they are only counted as read, when \p data is where the next
+   * unread byte was written.
+   *
+   * \param data The memory where the bytes are read.
+   * \param size_bytes The maximum number of bytes read.
+   * \return The number of bytes read.
+   */
+  size_t ReadStreamedMessageBody(uint8_t* data, size_t size_bytes);
+
   /*!
    * \brief Clear the receive buffer and prepare to receive next message.
    *
@@ -204,6 +248,9 @@ class Session {
     void PacketDone(bool is_valid) override;
 
    private:
+    void HandlePacket(bool is_valid);
+    /*! \brief Whether the receive buffer holds the start of a normal message of the session. */
+    bool IsNormalMessage();
     void operator delete(void*) noexcept {}  // NOLINT(readability/casting)
     Session* session_;
   };
@@ -247,6 +294,13 @@ class Session {
   bool receive_buffer_has_complete_message_;
   MessageReceivedFunc message_received_func_;
   void* message_received_func_context_;
+  MessageChunkReceivedFunc message_chunk_received_func_{nullptr};
+  void* message_chunk_received_func_context_{nullptr};
+  /*! \brief The memory where StreamMessageBody writes the message body, or nullptr. */
+  uint8_t* stream_data_{nullptr};
+  size_t stream_size_bytes_{0};
+  size_t stream_written_bytes_{0};
+  size_t stream_read_bytes_{0};
 };
 
 }  // namespace micro_rpc
@@ -166,6 +166,12 @@ class TVM_DLL DeviceAPI {
    * \param stream The stream to be set.
    */
   virtual void SetStream(Device dev, TVMStreamHandle stream) {}
+  /*!
+   * \brief Get the current stream, as set by SetStream.
+   * \param dev The device to get the stream of.
+   * \return The current stream of the device, nullptr for the default stream.
+   */
+  virtual TVMStreamHandle GetCurrentStream(Device dev) { return nullptr; }
   /*!
    * \brief Synchronize 2 streams of execution.
    *
@@ -179,6 +185,43 @@ class TVM_DLL DeviceAPI {
    * \param event_dst The destination stream to synchronize.
    */
   virtual void SyncStreamFromTo(Device dev, TVMStreamHandle event_src, TVMStreamHandle event_dst);
+  /*!
+   * \brief Record an event marking the completion of the work queued so far on a stream.
+   *
+   * \param dev The device of the stream.
+   * \param stream The stream, nullptr for the current stream of the calling thread.
+   * \return The event, nullptr when the device does not support events. Waiting for the work
+   *  then requires synchronizing the stream.
+   */
+  virtual void* RecordEvent(Device dev, TVMStreamHandle stream) { return nullptr; }
+  /*!
+   * \brief Query whether the work before an event has completed, without blocking.
+   * \param dev The device of the event.
+   * \param event The event returned by RecordEvent.
+   * \return Whether the work has completed.
+   */
+  virtual bool EventDone(Device dev, void* event) { return true; }
+  /*!
+   * \brief Block the calling thread until the work before an event has completed.
+   * \param dev The device of the event.
+   * \param event The event returned by RecordEvent.
+   */
+  virtual void EventSync(Device dev, void* event) {}
+  /*!
+   * \brief Make a stream wait for the work before an event, without blocking the host.
+   * \param dev The device of the stream and the event.
+   * \param stream The stream that waits, nullptr for the current stream of the calling thread.
+   * \param event The event returned by RecordEvent.
+   */
+  virtual void StreamWaitEvent(Device dev, TVMStreamHandle stream, void* event) {
+    EventSync(dev, event);
+  }
+  /*!
+   * \brief Free an event.
+   * \param dev The device of the event.
+   * \param event The event returned by RecordEvent.
+   */
+  virtual void FreeEvent(Device dev, void* event) {}
   /*!
    * \brief Allocate temporal workspace for backend execution.
    *
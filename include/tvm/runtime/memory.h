@@ -47,8 +47,9 @@ inline ObjectPtr<T> make_object(Args&&... args);
 //
 // Possible future allocator optimizations:
 // - Arena allocator that gives ownership of memory to arena (deleter_= nullptr)
-// - Thread-local object pools: one pool per size and alignment requirement.
 // - Can specialize by type of object to give the specific allocator to each object.
+//
+// PooledObjAllocator keeps thread-local pools of the memory of the freed objects, by size.
 
 /*!
  * \brief Base class of object allocators that implements make.
@@ -191,6 +192,88 @@ class SimpleObjAllocator : public ObjAllocatorBase<SimpleObjAllocator> {
   };
 };
 
+namespace detail {
+/*!
+ * \brief Allocate memory for a small object from the pool of the calling thread.
+ * \param size The size of the object.
+ * \return The memory, aligned to __STDCPP_DEFAULT_NEW_ALIGNMENT__.
+ */
+TVM_DLL void* ObjectPoolAlloc(size_t size);
+/*!
+ * \brief Return memory allocated by ObjectPoolAlloc to the pool of the calling thread.
+ * \param ptr The memory.
+ * \param size The size it was allocated with.
+ */
+TVM_DLL void ObjectPoolFree(void* ptr, size_t size);
+}  // namespace detail
+
+/*!
+ * \brief Allocator that reuses the memory of the freed objects.
+ *
+ *  The memory is taken from, and returned to, free lists of the calling thread by size
+ *  class, and comes from new/delete for the objects that are larger than the size classes.
+ *  It is meant for the objects that the executors create and free on every run, such as
+ *  the storage of the VM and the ADTs.
+ */
+class PooledObjAllocator : public ObjAllocatorBase<PooledObjAllocator> {
+ public:
+  template <typename T>
+  class Handler {
+   public:
+    using StorageType = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "the pool only aligns the objects to __STDCPP_DEFAULT_NEW_ALIGNMENT__");
+
+    template <typename... Args>
+    static T* New(PooledObjAllocator*, Args&&... args) {
+      void* data = detail::ObjectPoolAlloc(sizeof(StorageType));
+      new (data) T(std::forward<Args>(args)...);
+      return reinterpret_cast<T*>(data);
+    }
+
+    static Object::FDeleter Deleter() { return Deleter_; }
+
+   private:
+    static void Deleter_(Object* objptr) {
+      T* tptr = static_cast<T*>(objptr);
+      tptr->T::~T();
+      detail::ObjectPoolFree(tptr, sizeof(StorageType));
+    }
+  };
+
+  // Array handler that keeps the size of the allocation in front of the array.
+  template <typename ArrayType, typename ElemType>
+  class ArrayHandler {
+   public:
+    // The header holding the size keeps the alignment of the array
+    static constexpr size_t kHeaderSize = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    static_assert(alignof(ArrayType) <= kHeaderSize && sizeof(size_t) <= kHeaderSize,
+                  "the pool only aligns the objects to __STDCPP_DEFAULT_NEW_ALIGNMENT__");
+    static_assert(alignof(ArrayType) % alignof(ElemType) == 0 &&
+                      sizeof(ArrayType) % alignof(ElemType) == 0,
+                  "element alignment constraint");
+
+    template <typename... Args>
+    static ArrayType* New(PooledObjAllocator*, size_t num_elems, Args&&... args) {
+      size_t size = kHeaderSize + sizeof(ArrayType) + num_elems * sizeof(ElemType);
+      char* data = static_cast<char*>(detail::ObjectPoolAlloc(size));
+      *reinterpret_cast<size_t*>(data) = size;
+      new (data + kHeaderSize) ArrayType(std::forward<Args>(args)...);
+      return reinterpret_cast<ArrayType*>(data + kHeaderSize);
+    }
+
+    static Object::FDeleter Deleter() { return Deleter_; }
+
+   private:
+    static void Deleter_(Object* objptr) {
+      ArrayType* tptr = static_cast<ArrayType*>(objptr);
+      tptr->ArrayType::~ArrayType();
+      char* data = reinterpret_cast<char*>(tptr) - kHeaderSize;
+      detail::ObjectPoolFree(data, *reinterpret_cast<size_t*>(data));
+    }
+  };
+};
+
 template <typename T, typename... Args>
 inline ObjectPtr<T> make_object(Args&&... args) {
   return SimpleObjAllocator().make_object<T>(std::forward<Args>(args)...);
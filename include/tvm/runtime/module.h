@@ -286,6 +286,11 @@ constexpr const char* tvm_set_device = "__tvm_set_device";
 constexpr const char* tvm_global_barrier_state = "__tvm_global_barrier_state";
 /*! \brief Prepare the global barrier before kernels that uses global barrier. */
 constexpr const char* tvm_prepare_global_barrier = "__tvm_prepare_global_barrier";
+/*!
+ * \brief A PackedFunc that returns the address of the TVMBackendPackedCFunc of a function of the
+ *  module, to be called without going through a PackedFunc, or nullptr when there is none.
+ */
+constexpr const char* tvm_get_backend_func = "__tvm_get_backend_func";
 /*! \brief Placeholder for the module's entry function. */
 constexpr const char* tvm_module_main = "__tvm_main__";
 /*! \brief Prefix for parameter symbols emitted into the main program. */
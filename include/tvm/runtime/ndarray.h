@@ -29,6 +29,7 @@
 #include <tvm/runtime/container/shape_tuple.h>
 #include <tvm/runtime/container/string.h>
 #include <tvm/runtime/data_type.h>
+#include <tvm/runtime/memory.h>
 #include <tvm/runtime/object.h>
 #include <tvm/runtime/serializer.h>
 
@@ -128,9 +129,11 @@ class NDArray : public ObjectRef {
    * \brief Create a NDArray that shares the data memory with the current one.
    * \param shape The shape of the new array.
    * \param dtype The data type of the new array.
-   * \note The memory size of new array must be smaller than the current one.
+   * \param relative_byte_offset The byte offset of the new array within the current one.
+   * \note The memory of the new array must fit within the current one.
    */
-  TVM_DLL NDArray CreateView(ShapeTuple shape, DLDataType dtype);
+  TVM_DLL NDArray CreateView(ShapeTuple shape, DLDataType dtype,
+                             uint64_t relative_byte_offset = 0);
   /*!
    * \brief Create a reference view of NDArray that
    *  represents as DLManagedTensor.
@@ -314,6 +317,10 @@ class NDArray::Container : public Object, public NDArray::ContainerBase {
    */
   void SetDeleter(FDeleter deleter) { deleter_ = deleter; }
 
+  // The containers are created and deleted with new and delete, from the pools of small objects
+  static void* operator new(size_t size) { return detail::ObjectPoolAlloc(size); }
+  static void operator delete(void* ptr, size_t size) { detail::ObjectPoolFree(ptr, size); }
+
   // Expose DecRef and IncRef as public function
   // NOTE: they are only for developer purposes only.
   using Object::DecRef;
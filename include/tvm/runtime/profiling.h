@@ -326,6 +326,17 @@ class MetricCollector : public ObjectRef {
   TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(MetricCollector, ObjectRef, MetricCollectorNode);
 };
 
+/*! \brief Create metric collectors from the names of the global functions constructing them.
+ *
+ * MetricCollectors cannot be sent over RPC, so `profile_rpc` takes their names instead and
+ * constructs them on the remote.
+ *
+ * \param names Comma separated names of global functions taking no arguments and returning a
+ * MetricCollector, e.g. "runtime.profiling.HexagonMetricCollector".
+ * \returns The collectors, in the order of `names`.
+ */
+TVM_DLL Array<MetricCollector> MetricCollectorsFromNames(const String& names);
+
 /*! Information about a single function or operator call. */
 struct CallFrame {
   /*! Device on which the call was made */
@@ -340,6 +351,8 @@ struct CallFrame {
    * associated data (returned from MetricCollector.Start).
    */
   std::vector<std::pair<MetricCollector, ObjectRef>> extra_collectors;
+  /*! Host time the call started at on the trace clock, 0 when not tracing */
+  int64_t trace_begin_ns{0};
 };
 
 /*! Runtime profiler for function and/or operator calls. Used in the graph
@@ -417,6 +430,9 @@ class Profiler {
   bool IsRunning() const { return is_running_; }
 
  private:
+  /*! \brief Record the device time of finished calls as trace events of their stream. */
+  void TraceDeviceStreams();
+
   std::vector<Device> devs_;
   bool is_running_{false};
   std::vector<CallFrame> calls_;
@@ -587,6 +603,103 @@ PackedFunc WrapTimeEvaluator(PackedFunc f, Device dev, int number, int repeat, i
                              int limit_zero_time_iterations, int cooldown_interval_ms,
                              int repeats_to_cooldown, PackedFunc f_preproc = nullptr);
 
+/*! \brief Repeated timings of a function with the outliers dropped. */
+struct TimingSummary {
+  /*! \brief The timings kept, in seconds. */
+  std::vector<double> kept;
+  /*! \brief The timings dropped as outliers, in seconds. */
+  std::vector<double> dropped;
+  /*! \brief The mean of the kept timings. */
+  double mean{0};
+  /*! \brief The sample standard deviation of the kept timings. */
+  double std{0};
+  /*! \brief The half width of the 95% confidence interval of the mean. */
+  double ci{0};
+};
+
+/*!
+ * \brief Summarize repeated timings.
+ *
+ *  A timing is an outlier when its modified z-score, 0.6745 * (x - median) / MAD, exceeds
+ *  `outlier_threshold`. Only slow outliers are dropped: frequency throttling, preemption and
+ *  interrupts can only make a run slower.
+ * \param samples The timings.
+ * \param outlier_threshold The modified z-score above which a timing is dropped, 0 keeps all.
+ */
+TVM_DLL TimingSummary SummarizeTimings(const std::vector<double>& samples,
+                                       double outlier_threshold);
+
+/*!
+ * \brief Time candidate functions until the confidence interval of their means is narrow.
+ *
+ *  The candidates take the same arguments and are measured in interleaved rounds, with the
+ *  order rotated every round, so that a slowdown of the host affects all of them alike. Each
+ *  round adds one repeat of `number` runs per candidate (increased to last `min_repeat_ms` in
+ *  the first round). After `min_repeat` rounds, the measurement stops as soon as the
+ *  confidence interval of every candidate is within `max_rel_ci` of its mean, or after
+ *  `max_repeat` rounds.
+ *
+ *  The returned function takes the arguments of the candidates and returns a byte array of
+ *  doubles. For each candidate: the number of kept and dropped timings, the mean, the
+ *  standard deviation and the confidence interval half width, then the kept and the dropped
+ *  timings, all in seconds.
+ *
+ * \param fs The candidates.
+ * \param dev The device.
+ * \param number The number of runs in one repeat.
+ * \param min_repeat The minimum number of repeats.
+ * \param max_repeat The maximum number of repeats.
+ * \param min_repeat_ms The minimum duration of one repeat in milliseconds.
+ * \param max_rel_ci The target confidence interval half width relative to the mean.
+ * \param outlier_threshold See SummarizeTimings.
+ * \param cooldown_interval_ms The pause between the rounds in milliseconds.
+ * \param f_preproc The function run before each repeat, e.g. to flush the caches.
+ * \return The timer function.
+ */
+TVM_DLL PackedFunc WrapAdaptiveTimeEvaluator(std::vector<PackedFunc> fs, Device dev, int number,
+                                             int min_repeat, int max_repeat, int min_repeat_ms,
+                                             double max_rel_ci, double outlier_threshold,
+                                             int cooldown_interval_ms,
+                                             PackedFunc f_preproc = nullptr);
+
+/*!
+ * \brief Time a function with all the repeats enqueued before one synchronization.
+ *
+ *  Each repeat of `number` runs is bracketed by its own device timer, e.g. a pair of CUDA
+ *  events, and the gap between two repeats by another, so that the host only synchronizes
+ *  once after the last repeat. This avoids the synchronization overhead which dominates the
+ *  measurement of microsecond kernels. A `f_preproc` which synchronizes itself, e.g.
+ *  cache_flush_device, is timed in the gaps but not in the repeats.
+ *
+ *  The returned function takes the arguments of the function and returns a byte array of
+ *  doubles: the `repeat` mean times of one run, then the `repeat - 1` gaps between the
+ *  repeats, all in seconds.
+ *
+ * \param f The function.
+ * \param dev The device.
+ * \param number The number of runs in one repeat.
+ * \param repeat The number of repeats.
+ * \param f_preproc The function run before each repeat, e.g. to flush the caches.
+ * \return The timer function.
+ */
+TVM_DLL PackedFunc WrapBatchedTimeEvaluator(PackedFunc f, Device dev, int number, int repeat,
+                                            PackedFunc f_preproc = nullptr);
+
+/*!
+ * \brief Start recording the loop regions instrumented by the InstrumentProfileIntrinsics pass.
+ *
+ *  The CPU code generator lowers the profile intrinsics to TVMBackendProfileRegionBegin and
+ *  TVMBackendProfileRegionEnd, which only check a flag while the recording is off.
+ */
+TVM_DLL void StartLoopProfiling();
+
+/*!
+ * \brief Stop recording the loop regions.
+ * \return One call per region of each PrimFunc, named after the function and the ids of the
+ *  enclosing regions, with the total and the self time of the region.
+ */
+TVM_DLL Report StopLoopProfiling();
+
 }  // namespace profiling
 }  // namespace runtime
 }  // namespace tvm
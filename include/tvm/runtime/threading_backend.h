@@ -24,8 +24,11 @@
 #ifndef TVM_RUNTIME_THREADING_BACKEND_H_
 #define TVM_RUNTIME_THREADING_BACKEND_H_
 
+#include <tvm/runtime/c_runtime_api.h>
+
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #if defined(__linux__) || defined(__ANDROID__)
@@ -146,6 +149,99 @@ TVM_DLL void Configure(tvm::runtime::threading::ThreadGroup::AffinityMode mode,
  */
 int32_t NumThreads();
 
+/*!
+ * \brief Get the number of NUMA nodes of the system.
+ * \return The number of nodes, 1 when the topology is not available.
+ */
+TVM_DLL int NumaNodeCount();
+
+/*!
+ * \brief Get the CPUs which belong to a NUMA node.
+ * \param node The id of the node.
+ * \return The list of CPU ids, all the CPUs when the topology is not available.
+ */
+TVM_DLL std::vector<unsigned int> NumaNodeCpus(int node);
+
+/*!
+ * \brief Pin the worker threads of the calling thread's pool to the CPUs of one NUMA node.
+ *
+ *  This also records the node as the preferred node of the calling thread, CPU memory
+ *  allocated by this thread is then placed on that node.
+ *
+ * \param node The id of the node.
+ * \param nthreads The number of threads to use (0 = use all the CPUs of the node).
+ */
+TVM_DLL void ConfigureNumaNode(int node, int nthreads);
+
+/*!
+ * \brief Get the NUMA node the calling thread was bound to by ConfigureNumaNode.
+ * \return The id of the node, -1 when the thread is not bound.
+ */
+TVM_DLL int CurrentNumaNode();
+
+/*!
+ * \brief Place the pages of a memory region on a NUMA node, migrating the pages
+ *  that were already touched.
+ * \param ptr The start of the region.
+ * \param nbytes The size of the region.
+ * \param node The id of the node.
+ * \return Whether the placement succeeded, it is a no-op on systems without NUMA support.
+ */
+TVM_DLL bool BindMemoryToNumaNode(void* ptr, size_t nbytes, int node);
+
+/*!
+ * \brief Create a named group of worker threads, with one worker pinned to each CPU.
+ *
+ *  Groups must use disjoint CPUs, so that several executors in one process can run
+ *  at the same time without competing for workers. A group can be used by several
+ *  threads, their parallel launches into it are serialized.
+ *
+ * \param name The name of the group.
+ * \param cpus The CPUs of the group.
+ */
+TVM_DLL void CreateThreadPoolGroup(const std::string& name, const std::vector<unsigned int>& cpus);
+
+/*!
+ * \brief Remove a thread pool group, its workers exit once the last user is done.
+ * \param name The name of the group.
+ */
+TVM_DLL void RemoveThreadPoolGroup(const std::string& name);
+
+/*!
+ * \brief List the names of the thread pool groups.
+ * \return The names in sorted order.
+ */
+TVM_DLL std::vector<std::string> ListThreadPoolGroups();
+
+/*!
+ * \brief RAII guard which routes the parallel launches of the current thread to a
+ *  thread pool group instead of the thread local pool.
+ *
+ * \code
+ *   {
+ *     threading::ThreadPoolGroupScope scope("model_a");
+ *     executor->Run();
+ *   }
+ * \endcode
+ */
+class TVM_DLL ThreadPoolGroupScope {
+ public:
+  /*!
+   * \brief Enter the scope of a group.
+   * \param name The name of the group, an empty name leaves the current pool in place.
+   */
+  explicit ThreadPoolGroupScope(const std::string& name);
+  ~ThreadPoolGroupScope();
+  ThreadPoolGroupScope(const ThreadPoolGroupScope&) = delete;
+  ThreadPoolGroupScope& operator=(const ThreadPoolGroupScope&) = delete;
+
+ private:
+  /*! \brief Keeps the group alive while the scope is active. */
+  std::shared_ptr<void> group_;
+  /*! \brief The group of the enclosing scope. */
+  void* prev_{nullptr};
+};
+
 }  // namespace threading
 }  // namespace runtime
 }  // namespace tvm
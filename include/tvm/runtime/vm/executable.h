@@ -31,7 +31,9 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/vm/bytecode.h>
 
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -129,6 +131,12 @@ class TVM_DLL Executable : public ModuleNode {
    */
   void MoveLateBoundConstantsToFile(const std::string& path, size_t byte_limit);
 
+  /*!
+   * \brief As for \p MoveLateBoundConstantsToFile, but save in a page-aligned format which
+   * \p LoadLateBoundConstantsFromFile memory-maps instead of reading.
+   */
+  void MoveLateBoundConstantsToMappableFile(const std::string& path, size_t byte_limit);
+
   /*!
    * \brief Get a map of all constants with larger that byte_limit in size.
    */
@@ -152,6 +160,8 @@ class TVM_DLL Executable : public ModuleNode {
 
   /*!
    * \brief As for \p LoadLateBoundConstantsFromStream, but load from file at \p path.
+   * Files written by \p MoveLateBoundConstantsToMappableFile are memory-mapped, and the
+   * CPU constants point into the mapping.
    */
   void LoadLateBoundConstantsFromFile(const std::string& path);
 
@@ -256,6 +266,24 @@ class TVM_DLL Executable : public ModuleNode {
    */
   std::string GetFunctionParameterName(std::string func, uint32_t index) const;
 
+  /*!
+   * \brief Get a constant on a device, copying it there on first use.
+   *
+   * The copies are cached in the executable, so that all the virtual machines running it
+   * share a single copy of the constants per device. Thread-safe.
+   *
+   * \param const_index The index of the constant.
+   * \param dev The device.
+   * \return The constant on the device.
+   */
+  ObjectRef GetConstantOnDevice(Index const_index, Device dev);
+
+  /*!
+   * \brief Get the number of times the late-bound constants were loaded, which tells the virtual
+   * machines caching the constants when to fetch them again.
+   */
+  uint64_t GetConstantsVersion() const { return constants_version_.load(); }
+
   virtual ~Executable() {}
 
   const char* type_key() const final { return "VMExecutable"; }
@@ -369,6 +397,12 @@ class TVM_DLL Executable : public ModuleNode {
 
   /*! \brief The serialized bytecode. */
   std::string code_;
+  /*! \brief Protects the constants copied to the devices. */
+  std::mutex device_constants_mutex_;
+  /*! \brief The constants copied to each device, by constant index. */
+  std::unordered_map<Device, std::vector<ObjectRef>> device_constants_;
+  /*! \brief The number of times the late-bound constants were loaded. */
+  std::atomic<uint64_t> constants_version_{0};
 };
 
 }  // namespace vm
@@ -50,6 +50,26 @@ struct Buffer {
 enum AllocatorType {
   kNaive = 1,
   kPooled,
+  kArena,
+};
+
+/*! \brief Memory usage statistics of an allocator. */
+struct AllocatorStats {
+  /*! \brief The bytes handed out and not yet freed. */
+  size_t live_bytes{0};
+  /*! \brief The high-water mark of `live_bytes`. */
+  size_t peak_live_bytes{0};
+  /*! \brief The bytes held from the device, live or cached. */
+  size_t reserved_bytes{0};
+  /*! \brief The high-water mark of `reserved_bytes`. */
+  size_t peak_reserved_bytes{0};
+  /*! \brief The largest free block that can be handed out without a new device allocation. */
+  size_t largest_free_block{0};
+  /*!
+   * \brief The external fragmentation of the free memory, i.e.
+   *  `1 - largest_free_block / (reserved_bytes - live_bytes)`, 0 when nothing is free.
+   */
+  double fragmentation{0.0};
 };
 
 class Allocator {
@@ -80,6 +100,15 @@ class Allocator {
    *  \return The amount of memory currently allocated.
    */
   virtual size_t UsedMemory() const = 0;
+  /*! \brief The memory usage statistics.
+   *  \return The statistics. By default all the used memory is considered live.
+   */
+  virtual AllocatorStats GetStats() const {
+    AllocatorStats stats;
+    stats.live_bytes = stats.peak_live_bytes = stats.reserved_bytes = stats.peak_reserved_bytes =
+        UsedMemory();
+    return stats;
+  }
 
  private:
   AllocatorType type_;
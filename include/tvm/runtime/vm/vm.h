@@ -33,6 +33,8 @@
 #include <tvm/runtime/vm/executable.h>
 #include <tvm/runtime/vm/memory_manager.h>
 
+#include <deque>
+#include <list>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -41,6 +43,9 @@
 
 namespace tvm {
 namespace runtime {
+
+class OpLatencyRecorder;
+
 namespace vm {
 
 /*!
@@ -68,6 +73,44 @@ class VMClosure : public Closure {
   TVM_DEFINE_OBJECT_REF_METHODS(VMClosure, Closure, VMClosureObj);
 };
 
+/*!
+ * \brief The result of an asynchronous invocation of the VM.
+ *
+ * The invocation has queued all its work when the future is created, the future tracks the
+ * completion of that work on the devices.
+ */
+class VMFutureObj : public Object {
+ public:
+  /*! \brief The result of the invocation, only valid once the work is done. */
+  ObjectRef result;
+  /*!
+   * \brief The devices the invocation ran on, each with the event marking the completion of
+   * the work, or nullptr when the device does not support events.
+   */
+  std::vector<std::pair<Device, void*>> events;
+
+  /*! \brief Whether the work is done, blocks on the devices without events. */
+  bool IsDone();
+  /*! \brief Wait for the work to be done and return the result. */
+  ObjectRef Wait();
+
+  ~VMFutureObj() { ReleaseEvents(); }
+
+  static constexpr const uint32_t _type_index = TypeIndex::kDynamic;
+  static constexpr const char* _type_key = "vm.Future";
+  TVM_DECLARE_FINAL_OBJECT_INFO(VMFutureObj, Object);
+
+ private:
+  void ReleaseEvents();
+};
+
+/*! \brief reference to a future. */
+class VMFuture : public ObjectRef {
+ public:
+  VMFuture(ObjectRef result, std::vector<std::pair<Device, void*>> events);
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(VMFuture, ObjectRef, VMFutureObj);
+};
+
 /*!
  * \brief A representation of a Relay function in the VM.
  *
@@ -118,6 +161,8 @@ struct VMFrame {
   Index args;
   /*! \brief A pointer into the caller function's instructions. */
   const Instruction* code;
+  /*! \brief A pointer into the caller function's pre-decoded dispatch kinds. */
+  const uint8_t* dispatch = nullptr;
 
   /*! \brief Statically allocated space for objects */
   std::vector<ObjectRef> register_file;
@@ -261,6 +306,42 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
   void Init(const std::vector<Device>& physical_devices,
             const std::vector<AllocatorType>& alloc_types);
 
+  /*!
+   * \brief Create a lightweight execution context for the executable.
+   *
+   * The context shares the executable, the kernels, the memory allocators and the constants
+   * already on the devices with this virtual machine, and has its own frames, registers, inputs
+   * and outputs. Contexts can run concurrently on different threads. The constants are copied to
+   * the devices once per executable, not once per context.
+   *
+   * \return The context, a virtual machine initialized for the same devices.
+   */
+  ObjectPtr<VirtualMachine> CreateContext() const;
+
+  /*!
+   * \brief Bind the virtual machine to a NUMA node.
+   *
+   *  The cached CPU constants are migrated to the node, and the thread pool of the
+   *  thread invoking the VM is pinned to the CPUs of the node.
+   * \param node The id of the node.
+   * \param nthreads The number of threads to use (0 = use all the CPUs of the node).
+   */
+  void BindNumaNode(int node, int nthreads);
+
+  /*!
+   * \brief Run the virtual machine on the workers of a thread pool group.
+   * \param name The name of the group created by threading::CreateThreadPoolGroup,
+   *  an empty name uses the thread pool of the calling thread.
+   */
+  void BindThreadPoolGroup(const std::string& name);
+
+  /*!
+   * \brief Record the latency of every primitive into histograms, cheap enough to stay on.
+   * \param sample_period Time the primitives of one of every sample_period invocations,
+   *  0 disables the recording.
+   */
+  void EnableOpLatencyHistograms(int sample_period);
+
   /*! \brief Run VM dispatch loop. */
   void RunLoop(const std::vector<Index>& output_tensor_reg_indices = {});
 
@@ -329,7 +410,7 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
    *
    * \param instr Instruction that will be executed after this hook fires
    */
-  virtual void OpStartHook(Instruction instr);
+  virtual void OpStartHook(const Instruction& instr);
 
   /*!
    * \brief Internal hook for profiling the end of an op.
@@ -423,6 +504,70 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
 
   bool FindIndex(const std::vector<Index>& indices, Index val) const;
 
+  /*!
+   * \brief Get the pre-decoded dispatch kinds of a function, decoding it first if the
+   * function does not belong to the executable.
+   * \param func The function.
+   * \return The dispatch kinds, one per instruction.
+   */
+  const uint8_t* GetDispatchCode(const VMFunction& func);
+
+  /*! \brief Execute an AllocStorage instruction. */
+  void ExecuteAllocStorage(const Instruction& instr);
+
+  /*! \brief Execute an AllocTensor instruction. */
+  void ExecuteAllocTensor(const Instruction& instr,
+                          const std::vector<Index>& output_tensor_reg_indices);
+
+  /*! \brief Execute an InvokePacked instruction. */
+  void ExecuteInvokePacked(const Instruction& instr);
+
+  /*! \brief The argument buffers of a packed call, reused across invocations. */
+  struct PackedCallBuffer {
+    std::vector<ObjectRef> args;
+    std::vector<TVMValue> values;
+    std::vector<int> type_codes;
+  };
+
+  /*!
+   * \brief Get the packed call buffers of the current nesting depth. A deque keeps the
+   * buffers of the outer calls in place when a packed function re-enters the VM.
+   */
+  PackedCallBuffer& CurrentPackedCallBuffer();
+
+  /*!
+   * \brief The memoized results of a shape function. Shape functions are pure, and their
+   * operands are a few host integers, so that the result of a call with the same input
+   * shapes, or shape data, as a previous one is copied instead of computed.
+   */
+  struct ShapeFuncCache {
+    /*! \brief Whether the packed function is a shape function. */
+    bool enabled = false;
+    /*! \brief The bytes of the inputs and of the outputs, the most recently used first. */
+    std::vector<std::pair<std::vector<uint8_t>, std::vector<uint8_t>>> entries;
+  };
+
+  /*!
+   * \brief Copy the memoized outputs of a shape function call into its output arguments.
+   * \param cache The cache of the shape function.
+   * \param args The flattened arguments, the outputs last.
+   * \param num_outputs The number of outputs.
+   * \param key The key of the call, set if the call can be memoized.
+   * \return Whether the outputs were found.
+   */
+  bool LookupShapeFuncCache(ShapeFuncCache* cache, const std::vector<NDArray>& args,
+                            size_t num_outputs, std::vector<uint8_t>* key);
+
+  /*!
+   * \brief Memoize the outputs of a shape function call.
+   * \param cache The cache of the shape function.
+   * \param args The flattened arguments, the outputs last.
+   * \param num_outputs The number of outputs.
+   * \param key The key set by LookupShapeFuncCache.
+   */
+  void UpdateShapeFuncCache(ShapeFuncCache* cache, const std::vector<NDArray>& args,
+                            size_t num_outputs, std::vector<uint8_t> key);
+
  protected:
   /*! \brief The virtual machine's packed function table. */
   std::vector<PackedFunc> packed_funcs_;
@@ -461,6 +606,37 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
    * object to avoid rellocation of constants during inference.
    */
   std::vector<ObjectRef> const_pool_;
+  /*! \brief The version of the constants of the executable in the constant pool. */
+  uint64_t const_pool_version_ = 0;
+  /*! \brief The NUMA node the VM is bound to, -1 when it is not bound. */
+  int numa_node_ = -1;
+  /*! \brief The number of threads to use on the NUMA node. */
+  int numa_nthreads_ = 0;
+  /*! \brief The thread pool group the VM runs on, empty for the thread local pool. */
+  std::string thread_pool_group_;
+  /*! \brief The pre-decoded dispatch kinds of the current function. */
+  const uint8_t* dispatch_ = nullptr;
+  /*! \brief The pre-decoded dispatch kinds of each function of the executable. */
+  std::shared_ptr<const std::vector<std::vector<uint8_t>>> dispatch_code_;
+  /*!
+   * \brief The dispatch kinds of the invocations of functions from outside the executable, the
+   * ones no frame runs any more are dropped beyond kMaxExternalDispatchCode.
+   */
+  std::list<std::vector<uint8_t>> external_dispatch_code_;
+  /*! \brief The number of external dispatch kinds kept before dropping the unused ones. */
+  static constexpr size_t kMaxExternalDispatchCode = 16;
+  /*! \brief The packed call buffers, one per nesting depth. */
+  std::deque<PackedCallBuffer> packed_call_buffers_;
+  /*! \brief The nesting depth of packed calls in progress. */
+  size_t packed_call_depth_ = 0;
+  /*! \brief The latency recorder of the primitives, null when it is disabled. */
+  std::shared_ptr<OpLatencyRecorder> op_latency_;
+  /*! \brief Whether the device of each primitive was given to the recorder. */
+  std::vector<bool> op_latency_device_set_;
+  /*! \brief Whether the primitives of the current invocation are timed. */
+  bool op_latency_timed_ = false;
+  /*! \brief The memoized results of the shape functions, by packed index. */
+  std::vector<ShapeFuncCache> shape_func_caches_;
 };
 
 }  // namespace vm
@@ -145,8 +145,15 @@ class IRDocsifierNode : public Object {
   std::unordered_map<ObjectRef, VariableInfo, ObjectPtrHash, ObjectPtrEqual> obj2info;
   /*! \brief Metadata printing */
   std::unordered_map<String, Array<ObjectRef>> metadata;
+  /*! \brief The index of each object in `metadata` */
+  std::unordered_map<ObjectRef, int, ObjectPtrHash, ObjectPtrEqual> metadata_index;
   /*! \brief The variable names used already */
   std::unordered_set<String> defined_names;
+  /*!
+   * \brief For each name hint, the smallest suffix that may not be used yet, so that defining
+   * many variables with the same name hint is not quadratic.
+   */
+  std::unordered_map<std::string, int> name_suffix_begin;
   /*! \brief Common prefixes of variable usages */
   std::unordered_map<const Object*, std::vector<const Object*>> common_prefix;
   /*! \brief The IR usages for headers printing */
@@ -157,7 +164,9 @@ class IRDocsifierNode : public Object {
     v->Visit("dispatch_tokens", &dispatch_tokens);
     // `obj2info` is not visited
     // `metadata` is not visited
+    // `metadata_index` is not visited
     // `defined_names` is not visited
+    // `name_suffix_begin` is not visited
     // `common_prefix` is not visited
     // `ir_usage` is not visited
   }
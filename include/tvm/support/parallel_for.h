@@ -83,10 +83,48 @@ TVM_DLL void parallel_for(int begin, int end, const std::function<void(int)>& f,
  * \param num_threads The number of threads to be used.
  * \param f The task function to be executed. Takes the thread index and the task index as
  * input with no output.
- * \note `step` support is left for future work.
+ * \note `step` support is left for future work. The threads are taken from a persistent pool
+ * shared by all calls, so that repeated calls do not pay for thread creation.
  */
 TVM_DLL void parallel_for_dynamic(int begin, int end, int num_threads,
                                   const std::function<void(int thread_id, int task_id)>& f);
+
+/*!
+ * \brief A variant of `parallel_for_dynamic` with guided self-scheduling.
+ * Instead of fetching one task at a time, an idle thread grabs a chunk that shrinks as the loop
+ * proceeds, i.e. a fraction of the remaining tasks but no less than `min_chunk_size`.
+ * This keeps the contention on the shared counter low for many small tasks, while the
+ * small chunks near the end still balance the load. Similar to OpenMP:
+ *
+ *   \#pragma omp parallel for schedule(guided, min_chunk_size) num_threads(num_threads)
+ *
+ * \param begin The start index of this parallel loop (inclusive).
+ * \param end The end index of this parallel loop (exclusive).
+ * \param num_threads The number of threads to be used.
+ * \param f The task function to be executed. Takes the thread index and the task index as
+ * input with no output.
+ * \param min_chunk_size The minimum number of tasks grabbed at a time.
+ */
+TVM_DLL void parallel_for_guided(int begin, int end, int num_threads,
+                                 const std::function<void(int thread_id, int task_id)>& f,
+                                 int min_chunk_size = 1);
+
+/*!
+ * \brief A variant of `parallel_for_guided` with per-task cost hints.
+ * Tasks are visited in decreasing order of cost, and chunks are sized by the sum of the cost
+ * hints rather than the number of tasks, so expensive tasks start early and get their own chunk.
+ * \param begin The start index of this parallel loop (inclusive).
+ * \param end The end index of this parallel loop (exclusive).
+ * \param num_threads The number of threads to be used.
+ * \param costs The relative cost of each task, `costs[i]` for task `begin + i`.
+ * \param f The task function to be executed. Takes the thread index and the task index as
+ * input with no output.
+ * \param min_chunk_size The minimum number of tasks grabbed at a time.
+ */
+TVM_DLL void parallel_for_guided(int begin, int end, int num_threads,
+                                 const std::vector<double>& costs,
+                                 const std::function<void(int thread_id, int task_id)>& f,
+                                 int min_chunk_size = 1);
 }  // namespace support
 }  // namespace tvm
 
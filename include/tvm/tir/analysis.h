@@ -93,6 +93,15 @@ TVM_DLL double EstimateTIRFlops(const Stmt& stmt);
  */
 TVM_DLL double EstimateTIRFlops(const IRModule& mod);
 
+/*!
+ * \brief Estimate the register pressure of the innermost loop bodies of a lowered TIR fragment,
+ *  i.e. the maximal number of vector registers that hold live values at any statement.
+ * \param stmt The TIR fragment to be estimated, after vectorization and unrolling.
+ * \param vector_bits The width of a vector register in bits.
+ * \return The estimated number of live vector registers.
+ */
+TVM_DLL int64_t EstimateRegisterPressure(const Stmt& stmt, int vector_bits);
+
 /*!
  * \brief Find undefined vars in the statement.
  * \param stmt The statement to be checked.
@@ -663,6 +663,61 @@ TVM_DLL const Op& ptx_cp_async();
 TVM_DLL const Op& ptx_commit_group();
 TVM_DLL const Op& ptx_wait_group();
 
+/*!
+ * \brief tvm intrinsic for ptx bulk async copy from global to shared memory, whose
+ *        completion is tracked by the transaction count of an mbarrier.
+ *
+ * void ptx_cp_async_bulk(Var shared_ptr, Expr shared_offset, Var global_ptr, Expr global_offset,
+ *                        Expr bytes, int barrier_id);
+ *
+ */
+TVM_DLL const Op& ptx_cp_async_bulk();
+
+/*!
+ * \brief tvm intrinsic for ptx async copy arrival on an mbarrier, upon the completion of
+ *        the prior cp.async operations of the thread.
+ *
+ * void ptx_cp_async_barrier(int barrier_id);
+ *
+ */
+TVM_DLL const Op& ptx_cp_async_barrier();
+
+/*!
+ * \brief tvm intrinsic to declare the mbarriers of a kernel in shared memory.
+ *
+ * void create_barriers(int barrier_count);
+ *
+ */
+TVM_DLL const Op& create_barriers();
+
+/*!
+ * \brief tvm intrinsic for ptx mbarrier initialization with the number of arriving threads.
+ *
+ * void ptx_init_barrier_thread_count(int barrier_id, Expr thread_count);
+ *
+ */
+TVM_DLL const Op& ptx_init_barrier_thread_count();
+
+/*!
+ * \brief tvm intrinsics for ptx mbarrier arrival, and arrival which also expects the given
+ *        number of bytes to be transferred before the phase completes.
+ *
+ * void ptx_arrive_barrier(int barrier_id);
+ * void ptx_arrive_barrier_expect_tx(int barrier_id, Expr byte_count);
+ *
+ */
+TVM_DLL const Op& ptx_arrive_barrier();
+TVM_DLL const Op& ptx_arrive_barrier_expect_tx();
+
+/*!
+ * \brief tvm intrinsic for ptx mbarrier wait on the completion of the phase with the given
+ *        parity.
+ *
+ * void ptx_wait_barrier(int barrier_id, Expr phase);
+ *
+ */
+TVM_DLL const Op& ptx_wait_barrier();
+
 /*!
  * \brief tvm intrinsic for storing the result of PTX MMA into a destination pointer.
  *        For example, if each thread in a warp of size 32 has 4 elements from the result of
@@ -706,6 +761,30 @@ TVM_DLL const Op& vectorlow();
  */
 TVM_DLL const Op& vectorcombine();
 
+/*!
+ * \brief Reduce the lanes of a vector into a scalar by a sum.
+ *
+ *  The lanes are combined in any order, as a tree.
+ *
+ *  dtype vector_reduce_add(Expr vec);
+ */
+TVM_DLL const Op& vector_reduce_add();
+
+/*!
+ * \brief Reduce the lanes of a vector into a scalar by a product.
+ */
+TVM_DLL const Op& vector_reduce_mul();
+
+/*!
+ * \brief Reduce the lanes of a vector into a scalar by a minimum.
+ */
+TVM_DLL const Op& vector_reduce_min();
+
+/*!
+ * \brief Reduce the lanes of a vector into a scalar by a maximum.
+ */
+TVM_DLL const Op& vector_reduce_max();
+
 /*!
  * \brief atomic add instruction, corresponding e.g. to atomicAdd in CUDA
  */
@@ -725,6 +804,32 @@ TVM_DLL const Op& texture2d_store();
  */
 TVM_DLL const Op& texture2d_load();
 
+/*!
+ * \brief Load the lanes of a vector that are enabled by a mask.
+ *
+ *  Type masked_load(Handle ptr, Bool mask, Type passthru) {
+ *    for (i = 0; i < lanes; ++i) {
+ *      ret[i] = mask[i] ? ptr[i] : passthru[i];
+ *    }
+ *    return ret;
+ *  }
+ *
+ * The pointer is an address_of on the contiguous elements.  Disabled
+ * lanes do not access memory.
+ */
+TVM_DLL const Op& masked_load();
+
+/*!
+ * \brief Store the lanes of a vector that are enabled by a mask.
+ *
+ *  void masked_store(Handle ptr, Type value, Bool mask) {
+ *    for (i = 0; i < lanes; ++i) {
+ *      if (mask[i]) ptr[i] = value[i];
+ *    }
+ *  }
+ */
+TVM_DLL const Op& masked_store();
+
 /*!
  * \brief Initiate a non-blocking DMA copy from source to destination
  *
@@ -738,6 +843,18 @@ TVM_DLL const Op& texture2d_load();
  */
 TVM_DLL const Op& dma_copy();
 
+/*!
+ * \brief Initiate a non-blocking DMA copy of a box of rows from source
+ * to destination
+ *
+ * dma_copy_2d(queue_id, dst, src, width, height, dst_stride, src_stride, bypass_cache)
+ *
+ * Copies `height` rows of `width` bytes, the start of consecutive rows
+ * being `dst_stride` and `src_stride` bytes apart.  It is tracked in the
+ * current group as a single copy, in the same way as `dma_copy()`.
+ */
+TVM_DLL const Op& dma_copy_2d();
+
 /*!
  * \brief Wait until the number of DMA groups in flight is less than
  * or equal to some maximum
@@ -98,6 +98,8 @@ class PrimFuncNode : public BaseFuncNode {
    *  flattened alias of the buffer.
    */
   Map<tir::Var, Buffer> buffer_map;
+  /*! \brief The structural hash of the function, filled when it is first hashed as a root. */
+  SHashCache shash_cache_;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("params", &params);
@@ -167,7 +169,18 @@ class PrimFunc : public BaseFunc {
                    DictAttrs attrs = NullValue<DictAttrs>(), Span span = Span());
 
   TVM_DEFINE_OBJECT_REF_METHODS(PrimFunc, BaseFunc, PrimFuncNode);
-  TVM_DEFINE_OBJECT_REF_COW_METHOD(PrimFuncNode);
+
+  /*! \brief CopyOnWrite, which also drops the cached hash of a node mutated in place. */
+  PrimFuncNode* CopyOnWrite() {
+    ICHECK(data_ != nullptr);
+    if (!data_.unique()) {
+      auto n = make_object<PrimFuncNode>(*(operator->()));
+      ObjectPtr<Object>(std::move(n)).swap(data_);
+    }
+    PrimFuncNode* node = static_cast<PrimFuncNode*>(data_.get());
+    node->shash_cache_.Clear();
+    return node;
+  }
 };
 
 /*!
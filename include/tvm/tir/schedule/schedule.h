@@ -405,6 +405,17 @@ class ScheduleNode : public runtime::Object {
    * \param loop_rv The loop to be unrolled
    */
   virtual void Unroll(const LoopRV& loop_rv) = 0;
+  /*!
+   * \brief Unroll the input loop by a factor and jam the copies into the loops nested below it.
+   * The loop is split into an outer loop and an inner loop of the factor, the inner loop is moved
+   * below the single-branch loop nest under the loop, and unrolled. It requires:
+   * 1) The factor is positive.
+   * 2) The requirements of Split on the loop and of Reorder on the loop nest.
+   * \param loop_rv The loop to be unrolled and jammed
+   * \param factor The number of copies of the loop body jammed together
+   * \return The outer loop after the split
+   */
+  virtual LoopRV UnrollAndJam(const LoopRV& loop_rv, int factor) = 0;
   /******** Schedule: Insert cache stages ********/
   /*!
    * \brief Create a block that reads a buffer region into a read cache. It requires:
@@ -530,7 +541,8 @@ class ScheduleNode : public runtime::Object {
    * 3) The subtree of the scope block, where the given block is in, satisfies the compact dataflow
    * condition. i.e. all the blocks in the scope block's subtree must be either complete block or
    * reduction block
-   * 4) All the producers of the block are under the given loop
+   * 4) The producers of the block are under the given loop, except for those completed before it
+   * in the scope, and at least one of them is under the loop
    *
    * \param block_rv The block to be moved
    * \param loop_rv The loop where the block to be moved under
@@ -1508,6 +1508,12 @@ constexpr const char* software_pipeline_order = "software_pipeline_order";
  */
 constexpr const char* software_pipeline_async_stages = "software_pipeline_async_stages";
 
+/*!
+ * \brief Mark that the strided and gathered loads of the loop are prefetched ahead of their use,
+ * value = the prefetch distance in iterations, or 0 to estimate it from the loop body.
+ */
+constexpr const char* software_prefetch = "software_prefetch";
+
 /*! \brief Mark the buffers which is const access and can be transformed layout. */
 constexpr const char* layout_free_buffers = "layout_free_buffers";
 
@@ -1535,6 +1541,12 @@ constexpr const char* meta_schedule_thread_extent_high_inclusive =
 constexpr const char* meta_schedule_random_compute_producer =
     "meta_schedule.random_compute_producer";
 
+/*!
+ * \brief Mark a loop whose iterations share a rolling buffer, which are hence not parallelized
+ * by meta schedule
+ */
+constexpr const char* meta_schedule_rolling_buffer = "meta_schedule.rolling_buffer";
+
 /*! \brief Mark auto-parallel setting on the block. */
 constexpr const char* meta_schedule_parallel = "meta_schedule.parallel";
 
@@ -51,12 +51,15 @@ using tvm::transform::Sequential;
  * \param opt_level The optimization level of the function pass.
  * \param name The name of the function pass.
  * \param required The list of the passes that the function pass is dependent on.
+ * \param function_local Whether the pass only reads the PrimFunc it transforms, and not the other
+ *  functions of the module. Such a pass is run on the PrimFuncs in parallel when
+ *  `tir.num_parallel_jobs` is greater than one.
  *
  * \return The created function pass.
  */
 TVM_DLL Pass CreatePrimFuncPass(
     const runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required);
+    int opt_level, String name, tvm::Array<String> required, bool function_local = false);
 
 /*!
  * \brief Inject prefetch instructions into stmt.
@@ -535,7 +538,10 @@ TVM_DLL Pass InstallDebugSpans();
 TVM_DLL Pass UnifyThreadBinding();
 
 /*!
- *  A pass to merge multiple TIR-level dynamic shared memory allocations into one
+ *  A pass to merge multiple TIR-level dynamic shared memory allocations into one.
+ *  When the pass config `tir.merge_static_smem` is set, the static shared memory
+ *  allocations are also merged into one, reusing the memory of buffers whose
+ *  lifetimes do not overlap.
  */
 TVM_DLL Pass MergeDynamicSharedMemoryAllocations();
 
@@ -657,6 +663,18 @@ TVM_DLL Pass UnifiedStaticMemoryPlanner();
  */
 TVM_DLL Pass InjectSoftwarePipeline();
 
+/*!
+ * \brief Prefetch the loads of the loops annotated with `software_prefetch` ahead of their use.
+ *
+ * Only the loads of the buffers of the parameters that are strided by a cache line or more along
+ * the loop, or gathered through loaded indices, are prefetched. The hardware prefetcher follows the
+ * others. Unless given by the annotation, the prefetch distance covers the memory latency with an
+ * estimate of the cycles of an iteration.
+ *
+ * \return The IR transform pass.
+ */
+TVM_DLL Pass InjectSoftwarePrefetch();
+
 TVM_DLL Pass BindParams(const Array<runtime::NDArray>& constants);
 
 /*!
@@ -76,6 +76,18 @@ Map<BufferInfo, PoolAllocation> HillClimb(const Array<BufferInfo>& buffer_info_a
 Map<BufferInfo, PoolAllocation> HillClimb(const Array<BufferInfo>& buffer_info_arr,
                                           const Integer& memory_pressure);
 
+/*!
+ * \brief The hybrid algorithm to plan memory
+ *
+ * This plans each connected component of the conflict graph on its own, trying all the
+ * allocation orders of the small components and annealing the order of the large ones, until
+ * the cost reaches a lower bound or the time budget given by tir.usmp.time_budget_ms runs out.
+ *
+ * \return A Map of BufferInfo objects and their associated PoolAllocation
+ */
+Map<BufferInfo, PoolAllocation> Hybrid(const Array<BufferInfo>& buffer_info_arr,
+                                       const Integer& memory_pressure);
+
 }  // namespace algo
 }  // namespace usmp
 }  // namespace tir
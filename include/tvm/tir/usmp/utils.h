@@ -50,6 +50,16 @@ constexpr const char* kUSMPUseWorkspaceIO = "tir.usmp.use_workspace_io";
  * The algorithm should be provided as registered PackedFunc with the name tir.usmp.algorithm.NAME
  */
 constexpr const char* kUSMPCustomAlgorithmOption = "tir.usmp.custom_algorithm";
+/*!
+ * \brief PassContext option to limit the time, in milliseconds, taken by the search of the
+ * memory planning algorithms which improve on a first plan. 0, the default, is no limit.
+ */
+constexpr const char* kUSMPTimeBudgetOption = "tir.usmp.time_budget_ms";
+/*!
+ * \brief PassContext option to keep the bounded pools ahead in the pool candidates for the
+ * buffers accessed most per byte, and to remove them from the candidates of the others.
+ */
+constexpr const char* kUSMPAccessFrequencyOption = "tir.usmp.access_frequency_placement";
 
 namespace tir {
 namespace usmp {
@@ -81,6 +91,11 @@ struct BufferInfoNode : public Object {
   Array<ObjectRef> conflicts;
   /*! \brief Whether BufferInfo object retains info about IO tensors or intermediaries */
   BufferInfoKind kind;
+  /*!
+   * \brief The number of loads and stores of the buffer, counting the iterations of the enclosing
+   * loops of constant extents. 0 when they are not known, such as for external functions.
+   */
+  Integer access_count;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("name_hint", &name_hint);
@@ -89,12 +104,14 @@ struct BufferInfoNode : public Object {
     v->Visit("alignment", &alignment);
     v->Visit("conflicts", &conflicts);
     v->Visit("kind", &kind);
+    v->Visit("access_count", &access_count);
   }
 
   bool SEqualReduce(const BufferInfoNode* other, SEqualReducer equal) const {
     return equal(name_hint, other->name_hint) && equal(size_bytes, other->size_bytes) &&
            equal(pool_candidates, other->pool_candidates) && equal(alignment, other->alignment) &&
-           equal(conflicts, other->conflicts) && equal(kind, other->kind);
+           equal(conflicts, other->conflicts) && equal(kind, other->kind) &&
+           equal(access_count, other->access_count);
   }
 
   void SHashReduce(SHashReducer hash_reduce) const {
@@ -104,6 +121,7 @@ struct BufferInfoNode : public Object {
     hash_reduce(conflicts);
     hash_reduce(pool_candidates);
     hash_reduce(kind);
+    hash_reduce(access_count);
   }
   /*!
    * \brief Set the liveness conflicts of this BufferInfo
@@ -242,6 +260,19 @@ class AllocatedPoolInfo : public ObjectRef {
  */
 Array<BufferInfo> ConvertToArrayOfBufferInfo(const Map<BufferInfo, Stmt>& buffer_info_map);
 
+/*!
+ * \brief Reserve the bounded pools for the buffers with the most accesses per byte
+ *
+ * \param buffer_info_arr the BufferInfo objects, whose pool candidates are updated
+ *
+ * The buffers are visited from the most accessed per byte. A bounded pool that is not the last
+ * candidate of a buffer stays in its candidates when the buffer and its conflicts already kept in
+ * the pool fit in the size hint, which any placement of the lowest offset then meets. Otherwise it
+ * is removed, and the buffer is placed in the next candidates. This keeps the hot buffers in the
+ * fast memories given first, instead of the largest buffers.
+ */
+void PrioritizePoolCandidatesByAccessFrequency(const Array<BufferInfo>& buffer_info_arr);
+
 /*!
  * \brief Calculate workspace required to execute a IRModule with main expressed in TIR
  *
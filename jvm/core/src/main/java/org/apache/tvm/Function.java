@@ -289,6 +289,33 @@ public class Function extends TVMValue {
     public Object invoke(TVMValue... args);
   }
 
+  /**
+   * Set the inputs, run and get the outputs of an executor in a single native call.
+   * setInput(i, inputs[i]) and setOutput(i, outputs[i]) are called before run(),
+   * getOutput(i, outputs[i]) after it. The functions which are null are skipped.
+   * @param setInput The function to set an input, e.g. set_input_zero_copy.
+   * @param setOutput The function to set an output, e.g. set_output_zero_copy.
+   * @param run The function to run the executor.
+   * @param getOutput The function to copy an output, e.g. get_output.
+   * @param inputs The input arrays.
+   * @param outputs The output arrays.
+   */
+  public static void invokeExecutor(Function setInput, Function setOutput, Function run,
+      Function getOutput, NDArrayBase[] inputs, NDArrayBase[] outputs) {
+    Base.checkCall(Base._LIB.tvmExecutorRun(
+        setInput == null ? 0 : setInput.handle, setOutput == null ? 0 : setOutput.handle,
+        run.handle, getOutput == null ? 0 : getOutput.handle,
+        arrayHandles(inputs), arrayHandles(outputs)));
+  }
+
+  private static long[] arrayHandles(NDArrayBase[] arrays) {
+    long[] handles = new long[arrays.length];
+    for (int i = 0; i < arrays.length; ++i) {
+      handles[i] = arrays[i].handle;
+    }
+    return handles;
+  }
+
   /**
    * Register user-defined global function.
    * @param name The function name.
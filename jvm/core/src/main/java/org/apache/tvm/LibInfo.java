@@ -17,6 +17,7 @@
 
 package org.apache.tvm;
 
+import java.nio.ByteBuffer;
 import java.util.List;
 
 class LibInfo {
@@ -71,6 +72,15 @@ class LibInfo {
 
   native int tvmArrayCopyToJArray(long from, byte[] to);
 
+  native int tvmArrayFromDirectBuffer(ByteBuffer buffer, long[] shape, int dtypeCode,
+      int dtypeBits, int dtypeLanes, Base.RefLong refHandle);
+
+  native ByteBuffer tvmArrayToDirectBuffer(long handle);
+
+  // Executor
+  native int tvmExecutorRun(long setInput, long setOutput, long run, long getOutput,
+      long[] inputs, long[] outputs);
+
   // Device
   native int tvmSynchronize(int deviceType, int deviceId);
 }
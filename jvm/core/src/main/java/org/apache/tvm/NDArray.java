@@ -363,6 +363,41 @@ public class NDArray extends NDArrayBase {
     return units;
   }
 
+  /**
+   * Return a ByteBuffer which views the memory of current array, without copying.
+   * The array must be on cpu, and must not be released while the buffer is used.
+   * @return A direct buffer in the native byte order.
+   */
+  public ByteBuffer asDirectBuffer() {
+    if (device.deviceType != Device.cpu().deviceType) {
+      throw new IllegalArgumentException("Cannot view the memory of an array on " + device);
+    }
+    ByteBuffer bb = Base._LIB.tvmArrayToDirectBuffer(handle);
+    bb.order(ByteOrder.nativeOrder());
+    return bb;
+  }
+
+  /**
+   * Create an array on cpu which views the memory of a direct ByteBuffer, without copying.
+   * The buffer is kept alive until the array is released.
+   * An executor reads the array in place with set_input_zero_copy
+   * only if the address of the buffer is aligned to 64 bytes,
+   * arrays allocated by {@link #empty(long[], TVMType)} always are.
+   * @param buffer The direct buffer, whose content is in the native byte order.
+   * @param shape The shape of the array.
+   * @param dtype The data type of the array.
+   * @return The array tvm supported.
+   */
+  public static NDArray fromDirectBuffer(ByteBuffer buffer, long[] shape, TVMType dtype) {
+    if (!buffer.isDirect()) {
+      throw new IllegalArgumentException("The ByteBuffer must be direct");
+    }
+    Base.RefLong refHandle = new Base.RefLong();
+    Base.checkCall(Base._LIB.tvmArrayFromDirectBuffer(
+        buffer, shape, dtype.typeCode, dtype.bits, dtype.lanes, refHandle));
+    return new NDArray(refHandle.value, false, dtype, Device.cpu(0));
+  }
+
   /**
    * Get the device of current array.
    * @return the device.
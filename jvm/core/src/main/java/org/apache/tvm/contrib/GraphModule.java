@@ -35,6 +35,8 @@ public class GraphModule {
   private Device device;
 
   private Function fsetInput;
+  private Function fsetInputZeroCopy;
+  private Function fsetOutputZeroCopy;
   private Function frun;
   private Function fgetOutput;
   private Function fgetInput;
@@ -45,6 +47,8 @@ public class GraphModule {
     this.module = module;
     this.device = dev;
     fsetInput = module.getFunction("set_input");
+    fsetInputZeroCopy = module.getFunction("set_input_zero_copy");
+    fsetOutputZeroCopy = module.getFunction("set_output_zero_copy");
     frun = module.getFunction("run");
     fgetInput = module.getFunction("get_input");
     fgetOutput = module.getFunction("get_output");
@@ -64,6 +68,8 @@ public class GraphModule {
    */
   public void release() {
     fsetInput.release();
+    fsetInputZeroCopy.release();
+    fsetOutputZeroCopy.release();
     frun.release();
     fgetInput.release();
     fgetOutput.release();
@@ -106,6 +112,41 @@ public class GraphModule {
     return this;
   }
 
+  /**
+   * Set inputs to the module without copying.
+   * The executor reads the value in place until the input is set again,
+   * the value must be on the device of the module and aligned to 64 bytes.
+   * @param key The input key.
+   * @param value The input value.
+   * @return self.
+   */
+  public GraphModule setInputZeroCopy(String key, NDArray value) {
+    fsetInputZeroCopy.pushArg(key).pushArg(value).invoke();
+    return this;
+  }
+
+  /**
+   * Set inputs to the module without copying.
+   * @param key The input index.
+   * @param value The input value.
+   * @return self.
+   */
+  public GraphModule setInputZeroCopy(int key, NDArray value) {
+    fsetInputZeroCopy.pushArg(key).pushArg(value).invoke();
+    return this;
+  }
+
+  /**
+   * Set the index-th output of the module to out, which the executor writes in place.
+   * @param index The output index.
+   * @param out The output array.
+   * @return self.
+   */
+  public GraphModule setOutputZeroCopy(int index, NDArray out) {
+    fsetOutputZeroCopy.pushArg(index).pushArg(out).invoke();
+    return this;
+  }
+
   /**
    * Run forward execution of the graph.
    * @return self.
@@ -115,6 +156,30 @@ public class GraphModule {
     return this;
   }
 
+  /**
+   * Set the inputs, run and copy the outputs in a single native call.
+   * @param inputs The inputs, in the order of the input indices.
+   * @param outputs The output array containers, in the order of the output indices.
+   * @return self.
+   */
+  public GraphModule run(NDArray[] inputs, NDArray[] outputs) {
+    Function.invokeExecutor(fsetInput, null, frun, fgetOutput, inputs, outputs);
+    return this;
+  }
+
+  /**
+   * Bind the inputs and the outputs without copying and run, in a single native call.
+   * The arrays must be on the device of the module and aligned to 64 bytes,
+   * they stay bound after the call.
+   * @param inputs The inputs, in the order of the input indices.
+   * @param outputs The outputs, in the order of the output indices.
+   * @return self.
+   */
+  public GraphModule runZeroCopy(NDArray[] inputs, NDArray[] outputs) {
+    Function.invokeExecutor(fsetInputZeroCopy, fsetOutputZeroCopy, frun, null, inputs, outputs);
+    return this;
+  }
+
   /**
    * Get index-th input to out.
    * @param index The input index.
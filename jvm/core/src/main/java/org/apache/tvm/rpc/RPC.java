@@ -34,6 +34,7 @@ public class RPC {
     public static final int PUT = 3;
     public static final int UPDATE_INFO = 5;
     public static final int GET_PENDING_MATCHKEYS = 7;
+    public static final int REPORT_STATS = 8;
     public static final int SUCCESS = 0;
   }
 
@@ -19,6 +19,9 @@ package org.apache.tvm;
 
 import org.junit.Test;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
 import static org.junit.Assert.*;
 
 public class NDArrayTest {
@@ -77,4 +80,25 @@ public class NDArrayTest {
     assertArrayEquals(new char[]{65535, 2, 3, 4}, ndarray.asCharArray());
     ndarray.release();
   }
+
+  @Test
+  public void test_as_direct_buffer() {
+    NDArray ndarray = NDArray.empty(new long[]{2, 2}, new TVMType("float32"));
+    ByteBuffer buffer = ndarray.asDirectBuffer();
+    assertEquals(16, buffer.capacity());
+    buffer.asFloatBuffer().put(new float[]{1, 2, 3, 4});
+    assertArrayEquals(new float[]{1f, 2f, 3f, 4f}, ndarray.asFloatArray(), 1e-3f);
+    ndarray.release();
+  }
+
+  @Test
+  public void test_from_direct_buffer() {
+    ByteBuffer buffer = ByteBuffer.allocateDirect(16).order(ByteOrder.nativeOrder());
+    buffer.asIntBuffer().put(new int[]{1, 2, 3, 4});
+    NDArray ndarray = NDArray.fromDirectBuffer(buffer, new long[]{2, 2}, new TVMType("int32"));
+    assertArrayEquals(new int[]{1, 2, 3, 4}, ndarray.asIntArray());
+    ndarray.copyFrom(new int[]{5, 6, 7, 8});
+    assertEquals(8, buffer.getInt(12));
+    ndarray.release();
+  }
 }
@@ -70,6 +70,41 @@ public class GraphExecutorTest {
     graph.release();
   }
 
+  @Test
+  public void test_add_one_zero_copy() throws IOException {
+    Module libmod = Module.load(loadingDir + File.separator + "graph_addone_lib.so");
+    String graphJson = new Scanner(new File(
+        loadingDir + File.separator + "graph_addone.json"))
+        .useDelimiter("\\Z").next();
+
+    Device dev = Device.cpu();
+    GraphModule graph = GraphExecutor.create(graphJson, libmod, dev);
+
+    long[] shape = new long[]{4};
+    NDArray arr = NDArray.empty(shape, dev);
+    arr.asDirectBuffer().asFloatBuffer().put(new float[]{1f, 2f, 3f, 4f});
+    NDArray out = NDArray.empty(shape, dev);
+
+    graph.runZeroCopy(new NDArray[]{arr}, new NDArray[]{out});
+    float[] result = new float[4];
+    out.asDirectBuffer().asFloatBuffer().get(result);
+    assertArrayEquals(new float[]{2f, 3f, 4f, 5f}, result, 1e-3f);
+
+    // The bound input is read in place by the next run.
+    arr.asDirectBuffer().asFloatBuffer().put(new float[]{5f, 6f, 7f, 8f});
+    graph.run();
+    assertArrayEquals(new float[]{6f, 7f, 8f, 9f}, out.asFloatArray(), 1e-3f);
+
+    NDArray copied = NDArray.empty(shape, dev);
+    graph.run(new NDArray[]{arr}, new NDArray[]{copied});
+    assertArrayEquals(new float[]{6f, 7f, 8f, 9f}, copied.asFloatArray(), 1e-3f);
+
+    arr.release();
+    out.release();
+    copied.release();
+    graph.release();
+  }
+
   @Test
   public void test_add_one_remote() throws IOException {
     if (!Module.enabled("rpc")) {
@@ -29,6 +29,8 @@
 #include <dmlc/thread_local.h>
 #include <tvm/runtime/c_runtime_api.h>
 #endif
+#include <dlpack/dlpack.h>
+
 #include <cstring>
 #include <iostream>
 #include <thread>
@@ -453,6 +455,133 @@ JNIEXPORT jint JNICALL Java_org_apache_tvm_LibInfo_tvmArrayCopyToJArray(JNIEnv*
   return ret;
 }
 
+// The context of an NDArray which views the memory of a direct ByteBuffer.
+struct DirectBufferContext {
+  jobject buffer;
+  std::vector<int64_t> shape;
+  DLManagedTensor tensor;
+};
+
+// Releases the ByteBuffer viewed by an NDArray, once the NDArray is freed.
+extern "C" void directBufferDeleter(DLManagedTensor* tensor) {
+  DirectBufferContext* ctx = static_cast<DirectBufferContext*>(tensor->manager_ctx);
+  JNIEnv* env;
+  int jniStatus = _jvm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6);
+  if (jniStatus == JNI_EDETACHED) {
+#ifdef TVM4J_ANDROID
+    _jvm->AttachCurrentThread(&env, nullptr);
+#else
+    _jvm->AttachCurrentThread(reinterpret_cast<void**>(&env), nullptr);
+#endif
+  } else {
+    CHECK(jniStatus == JNI_OK);
+  }
+  env->DeleteGlobalRef(ctx->buffer);
+  delete ctx;
+}
+
+JNIEXPORT jint JNICALL Java_org_apache_tvm_LibInfo_tvmArrayFromDirectBuffer(
+    JNIEnv* env, jobject obj, jobject jbuffer, jlongArray jshape, jint jdtypeCode, jint jdtypeBits,
+    jint jdtypeLanes, jobject jret) {
+  void* data = env->GetDirectBufferAddress(jbuffer);
+  if (data == nullptr) {
+    TVMAPISetLastError("The ByteBuffer is not direct");
+    return -1;
+  }
+  DirectBufferContext* ctx = new DirectBufferContext();
+  int ndim = static_cast<int>(env->GetArrayLength(jshape));
+  ctx->shape.resize(ndim);
+  env->GetLongArrayRegion(jshape, 0, ndim, reinterpret_cast<jlong*>(ctx->shape.data()));
+
+  int64_t size = 1;
+  for (int64_t dim : ctx->shape) {
+    size *= dim;
+  }
+  int64_t nbytes = size * ((jdtypeBits * jdtypeLanes + 7) / 8);
+  if (env->GetDirectBufferCapacity(jbuffer) < nbytes) {
+    delete ctx;
+    TVMAPISetLastError("The ByteBuffer is smaller than the array");
+    return -1;
+  }
+
+  ctx->buffer = env->NewGlobalRef(jbuffer);
+  DLTensor& tensor = ctx->tensor.dl_tensor;
+  tensor.data = data;
+  tensor.device = DLDevice{kDLCPU, 0};
+  tensor.ndim = ndim;
+  tensor.dtype = DLDataType{static_cast<uint8_t>(jdtypeCode), static_cast<uint8_t>(jdtypeBits),
+                            static_cast<uint16_t>(jdtypeLanes)};
+  tensor.shape = ctx->shape.data();
+  tensor.strides = nullptr;
+  tensor.byte_offset = 0;
+  ctx->tensor.manager_ctx = ctx;
+  ctx->tensor.deleter = directBufferDeleter;
+
+  TVMArrayHandle out;
+  int ret = TVMArrayFromDLPack(&ctx->tensor, &out);
+  if (ret != 0) {
+    directBufferDeleter(&ctx->tensor);
+    return ret;
+  }
+  setLongField(env, jret, reinterpret_cast<jlong>(out));
+  return ret;
+}
+
+JNIEXPORT jobject JNICALL Java_org_apache_tvm_LibInfo_tvmArrayToDirectBuffer(JNIEnv* env,
+                                                                             jobject obj,
+                                                                             jlong jhandle) {
+  DLTensor* array = reinterpret_cast<DLTensor*>(jhandle);
+  int64_t size = 1;
+  for (int i = 0; i < array->ndim; ++i) {
+    size *= array->shape[i];
+  }
+  int64_t nbytes = size * ((array->dtype.bits * array->dtype.lanes + 7) / 8);
+  return env->NewDirectByteBuffer(static_cast<char*>(array->data) + array->byte_offset, nbytes);
+}
+
+// Calls func(index, array) for each of the arrays.
+static int callWithIndexedArrays(JNIEnv* env, jlong jfunc, jlongArray jarrays) {
+  if (jfunc == 0 || jarrays == nullptr) {
+    return 0;
+  }
+  int num = static_cast<int>(env->GetArrayLength(jarrays));
+  std::vector<jlong> arrays(num);
+  env->GetLongArrayRegion(jarrays, 0, num, arrays.data());
+  for (int i = 0; i < num; ++i) {
+    TVMValue argValues[2];
+    int argTypes[2] = {kDLInt, kTVMDLTensorHandle};
+    argValues[0].v_int64 = i;
+    argValues[1].v_handle = reinterpret_cast<void*>(arrays[i]);
+    TVMValue retVal;
+    int retTypeCode;
+    int ret = TVMFuncCall(reinterpret_cast<TVMFunctionHandle>(jfunc), argValues, argTypes, 2,
+                          &retVal, &retTypeCode);
+    if (ret != 0) {
+      return ret;
+    }
+  }
+  return 0;
+}
+
+JNIEXPORT jint JNICALL Java_org_apache_tvm_LibInfo_tvmExecutorRun(
+    JNIEnv* env, jobject obj, jlong jsetInput, jlong jsetOutput, jlong jrun, jlong jgetOutput,
+    jlongArray jinputs, jlongArray joutputs) {
+  int ret = callWithIndexedArrays(env, jsetInput, jinputs);
+  if (ret == 0) {
+    ret = callWithIndexedArrays(env, jsetOutput, joutputs);
+  }
+  if (ret == 0) {
+    TVMValue retVal;
+    int retTypeCode;
+    ret = TVMFuncCall(reinterpret_cast<TVMFunctionHandle>(jrun), nullptr, nullptr, 0, &retVal,
+                      &retTypeCode);
+  }
+  if (ret == 0) {
+    ret = callWithIndexedArrays(env, jgetOutput, joutputs);
+  }
+  return ret;
+}
+
 // Device
 JNIEXPORT jint JNICALL Java_org_apache_tvm_LibInfo_tvmSynchronize(JNIEnv* env, jint deviceType,
                                                                   jint deviceId) {
@@ -23,7 +23,7 @@ from numbers import Number, Integral
 
 from ..base import _LIB, get_last_ffi_error, py2cerror, check_call
 from ..base import c_str, string_types
-from ..runtime_ctypes import DataType, TVMByteArray, Device, ObjectRValueRef
+from ..runtime_ctypes import DataType, TVMByteArray, Device, ObjectRValueRef, TVMArray
 from . import ndarray as _nd
 from .ndarray import NDArrayBase, _make_array
 from .types import TVMValue, ArgTypeCode
@@ -109,6 +109,32 @@ def convert_to_tvm_func(pyfunc):
     return _make_packed_func(handle, False)
 
 
+# The alignment NDArray requires of the tensors it views, kAllocAlignment.
+_DLPACK_ALIGNMENT = 64
+
+
+def _dlpack_arg(arg):
+    """Convert a tensor exported by __dlpack__ to an NDArray, viewing it if possible."""
+    capsule = arg.__dlpack__()
+    ptr = ctypes.pythonapi.PyCapsule_GetPointer(ctypes.py_object(capsule), _nd._c_str_dltensor)
+    tensor = ctypes.cast(ptr, ctypes.POINTER(TVMArray)).contents
+    compact = True
+    if tensor.strides:
+        expected_stride = 1
+        for k in reversed(range(tensor.ndim)):
+            if tensor.shape[k] == 1:
+                continue
+            if tensor.strides[k] != expected_stride:
+                compact = False
+                break
+            expected_stride *= tensor.shape[k]
+    if compact and ((tensor.data or 0) + tensor.byte_offset) % _DLPACK_ALIGNMENT == 0:
+        return _nd._from_dlpack(capsule)
+    from tvm.runtime import ndarray  # pylint: disable=import-outside-toplevel
+
+    return ndarray.array(arg)
+
+
 def _make_tvm_args(args, temp_args):
     """Pack arguments into c args tvm call accept"""
     num_args = len(args)
@@ -179,6 +205,13 @@ def _make_tvm_args(args, temp_args):
         elif isinstance(arg, ObjectRValueRef):
             values[i].v_handle = ctypes.cast(ctypes.byref(arg.obj.handle), ctypes.c_void_p)
             type_codes[i] = ArgTypeCode.OBJECT_RVALUE_REF_ARG
+        elif hasattr(arg, "__dlpack__"):
+            # A tensor of another framework is passed without copying it, unless it is strided or
+            # not aligned as NDArray requires.
+            arg = _dlpack_arg(arg)
+            values[i].v_handle = ctypes.cast(arg.handle, ctypes.c_void_p)
+            type_codes[i] = ArgTypeCode.NDARRAY_HANDLE
+            temp_args.append(arg)
         elif callable(arg):
             arg = convert_to_tvm_func(arg)
             values[i].v_handle = arg.handle
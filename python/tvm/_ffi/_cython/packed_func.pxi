@@ -97,19 +97,79 @@ def convert_to_tvm_func(object pyfunc):
     return make_packed_func(chandle, False)
 
 
+# The kinds of arguments packed directly by the call sites which have seen their types before.
+cdef enum ArgKind:
+    kArgGeneric = 0
+    kArgObject = 1
+    kArgNDArray = 2
+    kArgInt = 3
+    kArgFloat = 4
+    kArgStr = 5
+    kArgNone = 6
+    kArgDLPack = 7
+
+
+# The alignment NDArray requires of the tensors it views, kAllocAlignment.
+cdef int kDLPackAlignment = 64
+
+
+cdef inline bint dlpack_can_view(DLTensor* tensor):
+    """Whether an NDArray can view the tensor, i.e. it is compact and aligned"""
+    cdef int64_t expected_stride = 1
+    cdef int k
+    if (<size_t>tensor.data + tensor.byte_offset) % kDLPackAlignment != 0:
+        return False
+    if tensor.strides == NULL:
+        return True
+    for k in range(tensor.ndim - 1, -1, -1):
+        if tensor.shape[k] == 1:
+            continue
+        if tensor.strides[k] != expected_stride:
+            return False
+        expected_stride *= tensor.shape[k]
+    return True
+
+
+cdef inline int make_dlpack_arg(object arg,
+                                TVMValue* value,
+                                int* tcode,
+                                list temp_args) except -1:
+    """Pack a tensor exported by __dlpack__, e.g. of another framework, without copying it
+
+    A tensor that is strided or not aligned as NDArray requires is copied instead.
+    """
+    cdef DLManagedTensor* ptr
+    capsule = arg.__dlpack__()
+    ptr = <DLManagedTensor*>pycapsule.PyCapsule_GetPointer(capsule, "dltensor")
+    if dlpack_can_view(&ptr.dl_tensor):
+        arr = _from_dlpack(capsule)
+    else:
+        from tvm.runtime import ndarray as _nd  # pylint: disable=import-outside-toplevel
+        arr = _nd.array(arg)
+    value[0].v_handle = (<NDArrayBase>arr).chandle
+    tcode[0] = kTVMNDArrayHandle
+    temp_args.append(arr)
+    return 0
+
+
 cdef inline int make_arg(object arg,
                          TVMValue* value,
                          int* tcode,
                          list temp_args) except -1:
-    """Pack arguments into c args tvm call accept"""
+    """Pack arguments into c args tvm call accept
+
+    Returns the kind of the argument, which is the same for all the arguments of its type.
+    """
     cdef unsigned long long ptr
     if isinstance(arg, ObjectBase):
         value[0].v_handle = (<ObjectBase>arg).chandle
         tcode[0] = kTVMObjectHandle
+        return kArgObject
     elif isinstance(arg, NDArrayBase):
         value[0].v_handle = (<NDArrayBase>arg).chandle
         tcode[0] = (kTVMNDArrayHandle if
                     not (<NDArrayBase>arg).c_is_view else kTVMDLTensorHandle)
+        return kArgNDArray
     elif isinstance(arg, PyNativeObject):
         value[0].v_handle = (<ObjectBase>(arg.__tvm_object__)).chandle
         tcode[0] = kTVMObjectHandle
@@ -120,20 +180,25 @@ cdef inline int make_arg(object arg,
     elif isinstance(arg, Integral):
         value[0].v_int64 = arg
         tcode[0] = kInt
+        return kArgInt
     elif isinstance(arg, float):
         value[0].v_float64 = arg
         tcode[0] = kFloat
+        return kArgFloat
     elif isinstance(arg, str):
         tstr = c_str(arg)
         value[0].v_str = tstr
         tcode[0] = kTVMStr
         temp_args.append(tstr)
+        return kArgStr
     elif arg is None:
         value[0].v_handle = NULL
         tcode[0] = kTVMNullptr
+        return kArgNone
     elif isinstance(arg, Number):
         value[0].v_float64 = arg
         tcode[0] = kFloat
+        return kArgFloat
     elif isinstance(arg, DataType):
         tstr = c_str(str(arg))
         value[0].v_str = tstr
@@ -181,6 +246,9 @@ cdef inline int make_arg(object arg,
     elif isinstance(arg, ObjectRValueRef):
         value[0].v_handle = &((<ObjectBase>(arg.obj)).chandle)
         tcode[0] = kTVMObjectRefArg
+    elif hasattr(arg, "__dlpack__"):
+        make_dlpack_arg(arg, value, tcode, temp_args)
+        return kArgDLPack
     elif callable(arg):
         arg = convert_to_tvm_func(arg)
         value[0].v_handle = (<PackedFuncBase>arg).chandle
@@ -188,6 +256,40 @@ cdef inline int make_arg(object arg,
         temp_args.append(arg)
     else:
         raise TypeError("Don't know how to handle type %s" % type(arg))
+    return kArgGeneric
+
+
+cdef inline int make_arg_of_kind(object arg,
+                                 int kind,
+                                 TVMValue* value,
+                                 int* tcode,
+                                 list temp_args) except -1:
+    """Pack an argument whose kind is known, without the type dispatch of make_arg"""
+    if kind == kArgObject:
+        value[0].v_handle = (<ObjectBase>arg).chandle
+        tcode[0] = kTVMObjectHandle
+    elif kind == kArgNDArray:
+        value[0].v_handle = (<NDArrayBase>arg).chandle
+        tcode[0] = (kTVMNDArrayHandle if
+                    not (<NDArrayBase>arg).c_is_view else kTVMDLTensorHandle)
+    elif kind == kArgInt:
+        value[0].v_int64 = arg
+        tcode[0] = kInt
+    elif kind == kArgFloat:
+        value[0].v_float64 = arg
+        tcode[0] = kFloat
+    elif kind == kArgStr:
+        tstr = c_str(arg)
+        value[0].v_str = tstr
+        tcode[0] = kTVMStr
+        temp_args.append(tstr)
+    elif kind == kArgNone:
+        value[0].v_handle = NULL
+        tcode[0] = kTVMNullptr
+    elif kind == kArgDLPack:
+        make_dlpack_arg(arg, value, tcode, temp_args)
+    else:
+        make_arg(arg, value, tcode, temp_args)
     return 0
 
 
@@ -293,6 +395,55 @@ cdef inline int ConstructorCall(void* constructor_handle,
 cdef class PackedFuncBase:
     cdef TVMPackedFuncHandle chandle
     cdef int is_global
+    # The types of the arguments of the last call and their kinds, so that the next calls with
+    # arguments of the same types skip the type dispatch. They are replaced together, as packing
+    # an argument may call the function again, e.g. to convert a nested list.
+    cdef tuple arg_types
+    cdef tuple arg_kinds
+
+    cdef int c_call(self,
+                    tuple args,
+                    TVMValue* ret_val,
+                    int* ret_tcode) except -1:
+        cdef int nargs = len(args)
+        cdef int c_api_ret_code
+        cdef int i
+        cdef TVMValue[3] small_values
+        cdef int[3] small_tcodes
+        cdef vector[TVMValue] large_values
+        cdef vector[int] large_tcodes
+        cdef TVMValue* values = small_values
+        cdef int* tcodes = small_tcodes
+        cdef tuple types = self.arg_types
+        cdef tuple kinds = self.arg_kinds
+        cdef bint cached = types is not None and len(types) == nargs
+        cdef list new_kinds
+        if nargs > 3:
+            large_values.resize(nargs)
+            large_tcodes.resize(nargs)
+            values = &large_values[0]
+            tcodes = &large_tcodes[0]
+        if cached:
+            for i in range(nargs):
+                if type(args[i]) is not types[i]:
+                    cached = False
+                    break
+        temp_args = []
+        if cached:
+            for i in range(nargs):
+                make_arg_of_kind(args[i], kinds[i], &values[i], &tcodes[i], temp_args)
+        else:
+            new_kinds = []
+            for i in range(nargs):
+                new_kinds.append(make_arg(args[i], &values[i], &tcodes[i], temp_args))
+            self.arg_types = tuple([type(arg) for arg in args])
+            self.arg_kinds = tuple(new_kinds)
+
+        with nogil:
+            c_api_ret_code = TVMFuncCall(self.chandle, values, tcodes,
+                                         nargs, ret_val, ret_tcode)
+        CHECK_CALL(c_api_ret_code)
+        return 0
 
     cdef inline _set_handle(self, handle):
         if handle is None:
@@ -328,7 +479,7 @@ cdef class PackedFuncBase:
         cdef TVMValue ret_val
         cdef int ret_tcode
         ret_tcode = kTVMNullptr
-        FuncCall(self.chandle, args, &ret_val, &ret_tcode)
+        self.c_call(args, &ret_val, &ret_tcode)
         return make_ret(ret_val, ret_tcode)
 
 
@@ -100,6 +100,8 @@ class Analyzer:
         self._enter_constraint_context = _mod("enter_constraint_context")
         self._can_prove_equal = _mod("can_prove_equal")
         self._can_prove = _mod("can_prove")
+        self._enable_cache = _mod("enable_cache")
+        self._clear_cache = _mod("clear_cache")
 
     def const_int_bound(self, expr):
         """Find constant integer bound for expr.
@@ -230,6 +232,23 @@ class Analyzer:
         """
         return self._bind(var, expr)
 
+    def enable_cache(self, max_entries=4096):
+        """Memoize the results of simplify and const_int_bound across calls.
+
+        The results are keyed on the structure of the expression and the
+        active constraint scope, and are dropped by every bind or update.
+
+        Parameters
+        ----------
+        max_entries : int
+            The number of results kept, the cache is emptied when it is full.
+        """
+        self._enable_cache(max_entries)
+
+    def clear_cache(self):
+        """Drop the memoized results."""
+        self._clear_cache()
+
     def constraint_scope(self, constraint):
         """Create a constraint scope.
 
@@ -52,6 +52,8 @@ from .measure import (
 from .measure_record import (
     RecordReader,
     RecordToFile,
+    convert_records_to_binary,
+    load_best_binary_records,
     load_best_record,
     load_records,
     save_records,
@@ -363,18 +363,19 @@ def feature_to_pack_sum_xgbmatrix(xs):
     -------
     dmatrix: xgb.DMatrix
         The DMatrix
-    pack_ids: List[int]
+    pack_ids: np.ndarray
         pack ids information
     """
-    x_flatten = []
-    pack_ids = []
+    n_rows = np.array([len(x) for x in xs], dtype=np.int64)
+    pack_ids = np.repeat(np.arange(len(xs)), n_rows)
+    return xgb.DMatrix(_concat_feature_rows(xs)), pack_ids
 
-    for ct, x in enumerate(xs):
-        for row in x:
-            x_flatten.append(row)
-            pack_ids.append(ct)
 
-    return xgb.DMatrix(np.array(x_flatten)), pack_ids
+def _concat_feature_rows(xs):
+    """Stack the feature rows of all the states into one float32 matrix"""
+    if len(xs) == 0:
+        return np.zeros((0, 0), dtype=np.float32)
+    return np.asarray(np.concatenate(list(xs)), dtype=np.float32)
 
 
 def pack_sum_xgbmatrix(xs, ys, gids=None, weights=None):
@@ -405,29 +406,16 @@ def pack_sum_xgbmatrix(xs, ys, gids=None, weights=None):
         # assume it has only one group
         group_sizes = [len(xs)]
 
-    x_flatten = []
-    y_flatten = []
-    weights_flatten = []
-    pack_ids = []
-
-    if weights is not None:
-        for ct, (x, y, w) in enumerate(zip(xs, ys, weights)):
-            for row in x:
-                x_flatten.append(row)
-                y_flatten.append(y)
-                weights_flatten.append(w)
-                pack_ids.append(ct)
-    else:
-        for ct, (x, y) in enumerate(zip(xs, ys)):
-            for row in x:
-                x_flatten.append(row)
-                y_flatten.append(y)
-                pack_ids.append(ct)
+    # Flatten the stores of all the states at once, repeating the per-state values per store
+    n_rows = np.array([len(x) for x in xs], dtype=np.int64)
+    pack_ids = np.repeat(np.arange(len(xs)), n_rows)
+    x_flatten = _concat_feature_rows(xs)
+    y_flatten = np.repeat(np.asarray(ys), n_rows)
 
-    ret = xgb.DMatrix(np.array(x_flatten), y_flatten)
+    ret = xgb.DMatrix(x_flatten, y_flatten)
     if weights is not None:
-        ret.set_weight(weights_flatten)
-    dmatrix_context.set("pack_ids", ret, np.array(pack_ids))
+        ret.set_weight(np.repeat(np.asarray(weights), n_rows))
+    dmatrix_context.set("pack_ids", ret, pack_ids)
     dmatrix_context.set("group_sizes", ret, group_sizes)
     return ret
 
@@ -33,7 +33,12 @@ from tvm.contrib.utils import tempdir
 from tvm.tir.expr import FloatImm
 from .cost_model import RandomModel, XGBModel
 from .measure import LocalRPCMeasureContext
-from .measure_record import RecordToFile, load_records
+from .measure_record import (
+    RecordToFile,
+    is_binary_record_file,
+    load_best_binary_records,
+    load_records,
+)
 from .search_policy import PreloadMeasuredStates, SketchPolicy
 from .search_task import SearchTask, TuningOptions
 from .utils import calc_workload_dis_factor, decode_workload_key
@@ -196,6 +201,8 @@ class ApplyHistoryBest(DispatchContext):
             Collection of tuning records.
             If is str, then it should be the filename of a records log file.
             Each row of this file is an encoded record pair. Otherwise, it is an iterator.
+            A file converted by :code:`convert_records_to_binary` is also accepted, of which
+            only the best records are loaded.
         n_lines: Optional[int]
             if it is not None, only load the first `n_lines` lines of log
         """
@@ -208,7 +215,11 @@ class ApplyHistoryBest(DispatchContext):
                 rec = str(rec)
 
             if isinstance(rec, str):
-                rec = load_records(rec)
+                if is_binary_record_file(rec):
+                    # Only the best record of each workload and target matters here
+                    rec = load_best_binary_records(rec)
+                else:
+                    rec = load_records(rec)
                 joint_records += rec
             else:
                 if rec is not None:
@@ -68,6 +68,7 @@ def unpack_feature(byte_arr: bytearray) -> Tuple[np.ndarray, np.ndarray, np.ndar
     ----
     For faster data copy between c++ and python, the c++ part returns features in a single
     flatten array using a packed format. The python part then unpacks the flatten array.
+    The returned feature matrices are float32 views into `byte_arr`, not copies.
 
     The packed format for n records is:
     {
@@ -94,14 +95,17 @@ def unpack_feature(byte_arr: bytearray) -> Tuple[np.ndarray, np.ndarray, np.ndar
     n = struct.unpack_from("1i", byte_arr, offset=offset)[0]
     offset += SIZE_OF_INT32
 
-    sizes = struct.unpack_from("%di" % (n + 2), byte_arr, offset=offset)
+    sizes = np.frombuffer(byte_arr, dtype=np.int32, count=n + 2, offset=offset)
     offset += SIZE_OF_INT32 * (n + 2)
 
-    # unpack features
+    # View the features of all records in place, without unpacking them number by number
+    n_floats = int(sizes[:-2].sum())
+    flat = np.frombuffer(byte_arr, dtype=np.float32, count=n_floats, offset=offset)
+    offset += n_floats * SIZE_OF_FLOAT32
+
     features = []
+    pos = 0
     for size in sizes[:-2]:
-        row = []
-
         # Now, we need to unpack the feature for multiple statements.
         # The format is:
         # {
@@ -112,12 +116,9 @@ def unpack_feature(byte_arr: bytearray) -> Tuple[np.ndarray, np.ndarray, np.ndar
 
         if size == 0:
             # failed during lowering
-            features.append(np.zeros((1, vec_len)))
+            features.append(np.zeros((1, vec_len), dtype=np.float32))
         else:
-            n_stmts = struct.unpack_from("f", byte_arr, offset=offset)
-            offset += SIZE_OF_FLOAT32
-
-            n_stmts = int(n_stmts[0] + 0.5)
+            n_stmts = int(flat[pos] + 0.5)
             tmp_vec_len = (size - 1) // n_stmts
             assert (
                 tmp_vec_len == vec_len
@@ -126,25 +127,25 @@ def unpack_feature(byte_arr: bytearray) -> Tuple[np.ndarray, np.ndarray, np.ndar
                 tmp_vec_len,
             )
             assert tmp_vec_len * n_stmts == size - 1
-            for _ in range(n_stmts):
-                x = struct.unpack_from("%df" % vec_len, byte_arr, offset=offset)
-                offset += vec_len * SIZE_OF_FLOAT32
-                row.append(x)
-
-            features.append(np.array(row))
+            features.append(flat[pos + 1 : pos + size].reshape(n_stmts, vec_len))
+        pos += size
 
     # unpack normalized_throughputs
     m = sizes[-2]
-    normalized_throughputs = struct.unpack_from("%df" % m, byte_arr, offset=offset)
+    normalized_throughputs = np.frombuffer(byte_arr, dtype=np.float32, count=m, offset=offset)
     offset += m * SIZE_OF_FLOAT32
 
     # unpack task_ids
     m = sizes[-1]
-    task_ids = struct.unpack_from("%di" % m, byte_arr, offset=offset)
+    task_ids = np.frombuffer(byte_arr, dtype=np.int32, count=m, offset=offset)
     offset += m * SIZE_OF_INT32
 
     assert offset == len(byte_arr), "%d vs %d" % (offset, len(byte_arr))
-    return np.array(features, dtype=object), np.array(normalized_throughputs), np.array(task_ids)
+    # A 1-D object array even if all the records have the same number of stores
+    ret = np.empty(len(features), dtype=object)
+    for i, x in enumerate(features):
+        ret[i] = x
+    return ret, normalized_throughputs.astype(np.float64), task_ids.astype(np.int64)
 
 
 def get_per_store_features_from_file(
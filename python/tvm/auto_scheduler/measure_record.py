@@ -213,6 +213,60 @@ def save_records(filename, inputs, results):
     _ffi_api.SaveRecords(filename, inputs, results)
 
 
+def convert_records_to_binary(in_file, out_file):
+    """
+    Convert a JSON log file to the indexed binary record format.
+    The input is streamed line by line, so the log does not have to fit in memory.
+
+    Parameters
+    ----------
+    in_file: str
+        The filename of the JSON log.
+    out_file: str
+        The filename of the binary file to be written. It is overwritten if it exists.
+    """
+    dirname = os.path.dirname(os.path.abspath(out_file))
+    if not os.path.exists(dirname):
+        os.makedirs(dirname)
+    _ffi_api.ConvertRecordsToBinary(in_file, out_file)
+
+
+def is_binary_record_file(filename):
+    """
+    Check whether a file is in the binary record format.
+
+    Parameters
+    ----------
+    filename: str
+        The filename to be checked.
+
+    Returns
+    -------
+    is_binary : bool
+        Whether the file was written by :code:`convert_records_to_binary`.
+    """
+    return bool(_ffi_api.IsBinaryRecordFile(filename))
+
+
+def load_best_binary_records(filename, top_k=1):
+    """
+    Load the best successful records of each workload key and target from a binary file.
+    Only the selected records are parsed, using the index of the file when it has one.
+
+    Parameters
+    ----------
+    filename : str
+        File name of the binary records.
+    top_k : int = 1
+        The number of records to load for each workload key and target.
+
+    Returns
+    -------
+    logs : List[auto_scheduler.measure.MeasureInput, auto_scheduler.measure.MeasureResult]
+    """
+    return list(zip(*_ffi_api.LoadBestBinaryRecords(filename, top_k)))
+
+
 def load_best_record(filename, workload_key=None, target=None, include_compatible=False):
     """Return the best measurement pair form a log file. This may return none results if
     there is no legal measure pair with the specified workload_key/target found from the log file.
@@ -344,7 +398,7 @@ def distill_record_file(in_file, out_file):
 def main():
     """The main function for CLI."""
     parser = argparse.ArgumentParser()
-    parser.add_argument("--mode", choices=["distill"], default="distill")
+    parser.add_argument("--mode", choices=["distill", "binary"], default="distill")
     parser.add_argument("-i", "--input", type=str, help="input file")
     parser.add_argument("-o", "--output", type=str, default=None, help="output file")
 
@@ -355,12 +409,17 @@ def main():
     if args.mode == "distill":
         args.output = args.output or args.input + ".best.json"
         distill_record_file(args.input, args.output)
+    elif args.mode == "binary":
+        args.output = args.output or args.input + ".bin"
+        convert_records_to_binary(args.input, args.output)
 
 
 """
 Usage:
 * Distill the best entries from a large log file
 e.g. python -m tvm.auto_scheduler.measure_record --mode distill -i input.json
+* Convert a log file to the indexed binary format for faster loading
+e.g. python -m tvm.auto_scheduler.measure_record --mode binary -i input.json
 """
 if __name__ == "__main__":
     main()
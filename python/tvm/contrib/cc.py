@@ -18,7 +18,11 @@
 # pylint: disable=invalid-name
 import sys
 import os
+import functools
+import hashlib
 import subprocess
+import tempfile
+from concurrent.futures import ThreadPoolExecutor
 
 from .._ffi.base import py_str
 
@@ -72,6 +76,13 @@ def create_shared(output, objects, options=None, cc=None):
 
     cc : Optional[str]
         The compiler command.
+
+    Note
+    ----
+    If the TVM_CC_OBJECT_CACHE_DIR environment variable is set, the C/C++ sources are compiled
+    to objects in parallel before they are linked. The objects are kept there under the hash of
+    the compiler version, the compile options and the preprocessed source, and reused by the
+    later builds of the same source.
     """
     cc = cc or get_cc()
 
@@ -219,32 +230,126 @@ def cross_compiler(
     return _fcompile
 
 
+def _run_compile(cmd):
+    proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    (out, _) = proc.communicate()
+    if proc.returncode != 0:
+        msg = "Compilation error:\n"
+        msg += py_str(out)
+        msg += "\nCommand line: " + " ".join(cmd)
+        raise RuntimeError(msg)
+    return out
+
+
+# The options taking their value as the next argument.
+_COMPILE_OPTIONS_WITH_VALUE = ("-I", "-D", "-U", "-include", "-isystem", "-iquote", "-target")
+# The prefixes of the options which are used to compile a source to an object.
+_COMPILE_OPTION_PREFIXES = (
+    "-I",
+    "-D",
+    "-U",
+    "-O",
+    "-f",
+    "-m",
+    "-g",
+    "-W",
+    "-std=",
+    "-i",
+    "-pthread",
+    "--",
+)
+# The prefixes of the options which are only used by the link.
+_LINK_OPTION_PREFIXES = ("-Wl,", "-l", "-L", "-shared", "-static", "-rdynamic", "--shared")
+
+
+def _compile_options(options):
+    """Get the options used to compile a source to an object, without the link ones."""
+    compile_options = []
+    i = 0
+    while i < len(options):
+        opt = options[i]
+        if opt in _COMPILE_OPTIONS_WITH_VALUE and i + 1 < len(options):
+            compile_options += [opt, options[i + 1]]
+            i += 2
+            continue
+        if opt.startswith(_COMPILE_OPTION_PREFIXES) and not opt.startswith(_LINK_OPTION_PREFIXES):
+            compile_options.append(opt)
+        i += 1
+    return compile_options
+
+
+@functools.lru_cache(maxsize=None)
+def _compiler_version(compile_cmd):
+    """Get the version of the compiler, so that its objects are not reused by another one."""
+    return _run_compile([compile_cmd, "--version"])
+
+
+def _compile_sources(sources, options, compile_cmd, shared, cache_dir):
+    """Compile the C/C++ sources to objects in parallel.
+
+    The object of a source is named after the hash of the compiler version, of the compile
+    options and of the preprocessed source, so an object in cache_dir is reused if the
+    translation unit did not change.
+    """
+    compile_options = _compile_options(list(options) if options else [])
+    compile_options += ["-fPIC"] if shared else []
+    version = _compiler_version(compile_cmd)
+
+    def _compile(source):
+        preprocessed = _run_compile([compile_cmd, "-E", "-P", source] + compile_options)
+        digest = hashlib.sha256()
+        digest.update(version)
+        digest.update(" ".join([compile_cmd] + compile_options).encode())
+        digest.update(preprocessed)
+        obj = os.path.join(cache_dir, digest.hexdigest() + ".o")
+        if not os.path.exists(obj):
+            # The same source may be compiled by another thread or process meanwhile.
+            fd, tmp_obj = tempfile.mkstemp(suffix=".o.tmp", dir=cache_dir)
+            os.close(fd)
+            try:
+                _run_compile([compile_cmd, "-c", source, "-o", tmp_obj] + compile_options)
+                os.replace(tmp_obj, obj)
+            finally:
+                if os.path.exists(tmp_obj):
+                    os.remove(tmp_obj)
+        return obj
+
+    with ThreadPoolExecutor(max_workers=os.cpu_count()) as pool:
+        return list(pool.map(_compile, sources))
+
+
 def _linux_compile(output, objects, options, compile_cmd, compile_shared=False):
+    shared = compile_shared or output.endswith(".so") or output.endswith(".dylib")
+    objects = [objects] if isinstance(objects, str) else list(objects)
+    sources = [obj for obj in objects if obj.endswith((".c", ".cc", ".cpp"))]
+    cache_dir = os.environ.get("TVM_CC_OBJECT_CACHE_DIR")
+    # The translation units, e.g. from the tir.c_host.split_translation_units option, are
+    # compiled in parallel before the link, and the objects are reused from the cache.
+    if cache_dir and sources and compile_cmd != "nvcc" and not output.endswith(".obj"):
+        os.makedirs(cache_dir, exist_ok=True)
+        compiled = _compile_sources(sources, options, compile_cmd, shared, cache_dir)
+        compiled = dict(zip(sources, compiled))
+        objects = [compiled.get(obj, obj) for obj in objects]
+    _linux_link(output, objects, options, compile_cmd, shared)
+
+
+def _linux_link(output, objects, options, compile_cmd, shared):
     cmd = [compile_cmd]
     if compile_cmd != "nvcc":
-        if compile_shared or output.endswith(".so") or output.endswith(".dylib"):
+        if shared:
             cmd += ["-shared", "-fPIC"]
             if sys.platform == "darwin":
                 cmd += ["-undefined", "dynamic_lookup"]
         elif output.endswith(".obj"):
             cmd += ["-c"]
     else:
-        if compile_shared or output.endswith(".so") or output.endswith(".dylib"):
+        if shared:
             cmd += ["--shared"]
     cmd += ["-o", output]
-    if isinstance(objects, str):
-        cmd += [objects]
-    else:
-        cmd += objects
+    cmd += objects
     if options:
         cmd += options
-    proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
-    (out, _) = proc.communicate()
-    if proc.returncode != 0:
-        msg = "Compilation error:\n"
-        msg += py_str(out)
-        msg += "\nCommand line: " + " ".join(cmd)
-        raise RuntimeError(msg)
+    _run_compile(cmd)
 
 
 def _windows_compile(output, objects, options):
@@ -0,0 +1,64 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Collective operations between the shards of a tensor on several devices.
+
+The shards are given to one call, one per device. The shards on CUDA devices use NCCL when TVM
+is built with USE_NCCL, the others go through the host memory.
+"""
+import tvm._ffi
+from tvm import nd
+
+
+def allreduce(shards):
+    """Sum the shards, and return the sum on the device of every shard.
+
+    Parameters
+    ----------
+    shards : List[tvm.nd.NDArray]
+        The shards, of the same shape and dtype, one per device.
+
+    Returns
+    -------
+    out : List[tvm.nd.NDArray]
+        The sum, one array per device.
+    """
+    outs = [nd.empty(shard.shape, shard.dtype, shard.device) for shard in shards]
+    tvm._ffi.get_global_func("tvm.contrib.collective.allreduce")(*shards, *outs)
+    return outs
+
+
+def allgather(shards, axis=0):
+    """Concatenate the shards along the axis, and return the result on the device of every shard.
+
+    Parameters
+    ----------
+    shards : List[tvm.nd.NDArray]
+        The shards, of the same shape and dtype, one per device.
+
+    axis : int
+        The axis to concatenate along.
+
+    Returns
+    -------
+    out : List[tvm.nd.NDArray]
+        The concatenation, one array per device.
+    """
+    shape = list(shards[0].shape)
+    shape[axis] *= len(shards)
+    outs = [nd.empty(shape, shard.dtype, shard.device) for shard in shards]
+    tvm._ffi.get_global_func("tvm.contrib.collective.allgather")(axis, *shards, *outs)
+    return outs
@@ -0,0 +1,97 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Relay virtual machine with CUDA Graph"""
+import tvm._ffi
+
+from tvm.rpc import base as rpc_base
+from tvm.runtime import vm
+
+_CREATE_FUNC = "runtime._VirtualMachineCudaGraph"
+
+
+def enabled():
+    """Whether the VM with CUDA Graph is enabled."""
+    return tvm._ffi.get_global_func(_CREATE_FUNC, allow_missing=True) is not None
+
+
+class VirtualMachineCudaGraph(vm.VirtualMachine):
+    """Relay VM replaying CUDA graphs.
+
+    The kernels launched by a function are captured in a CUDA graph per input-shape
+    signature, and the graph is replayed when the same input shapes recur. The first
+    invocation with new input shapes runs eagerly as a warm-up, the second one captures
+    the graph. Functions with inputs off the GPU, copies across devices, or data dependent
+    host control flow run eagerly.
+
+    The outputs of a replay are the tensors captured with the graph, which the next
+    replay with the same input shapes overwrites.
+
+    Parameters
+    ----------
+    exe : Union[Executable, Module]
+        The executable.
+
+    device : Device
+        The CUDA device to run on.
+
+    memory_cfg : Optional[str]
+        The allocator behavior to use for the VM.
+
+    max_graphs : int
+        The maximum number of input-shape signatures to capture. Further signatures
+        run eagerly.
+    """
+
+    def __init__(self, exe, device, memory_cfg=None, max_graphs=16):
+        super(VirtualMachineCudaGraph, self).__init__(exe, device, memory_cfg)
+        if device.device_type >= rpc_base.RPC_SESS_MASK:
+            fcreate = device._rpc_sess.get_function(_CREATE_FUNC)
+        else:
+            fcreate = tvm._ffi.get_global_func(_CREATE_FUNC, allow_missing=True)
+            if fcreate is None:
+                raise ValueError(
+                    "To enable the VM with CUDA graph support, please set "
+                    "'(USE_VM_CUDA_GRAPH ON)' in config.cmake and rebuild TVM"
+                )
+        self.module = fcreate(self._exec.mod)
+
+        self._init = self.module["init"]
+        self._invoke = self.module["invoke"]
+        self._invoke_stateful = self.module["invoke_stateful"]
+        self._get_output = self.module["get_output"]
+        self._get_num_outputs = self.module["get_num_outputs"]
+        self._get_input_index = self.module["get_input_index"]
+        self._set_input = self.module["set_input"]
+        self._set_one_input = self.module["set_one_input"]
+        self._set_outputs = self.module["set_outputs"]
+        self._setup_device(device, memory_cfg)
+        self.module["set_max_cuda_graphs"](max_graphs)
+
+    def clear_cuda_graphs(self):
+        """Release the captured graphs and the memory they hold."""
+        self.module["clear_cuda_graphs"]()
+
+    def cuda_graph_stats(self):
+        """The CUDA graph statistics of the VM.
+
+        Returns
+        -------
+        stats : Dict[str, int]
+            The number of cached graphs, captures, failed captures and graph launches.
+        """
+        stats = self.module["get_cuda_graph_stats"]()
+        return {str(k): int(v.value) for k, v in stats.items()}
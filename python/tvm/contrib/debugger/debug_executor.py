@@ -354,6 +354,7 @@ class GraphModuleDebug(graph_executor.GraphModule):
         limit_zero_time_iterations=100,
         cooldown_interval_ms=0,
         repeats_to_cooldown=1,
+        batched=False,
     ):
         """Run each operation in the graph and get the time per op for all ops.
 
@@ -387,19 +388,29 @@ class GraphModuleDebug(graph_executor.GraphModule):
         repeats_to_cooldown: int, optional
             The number of repeats before the cooldown is activated.
 
+        batched: bool, optional
+            Time all the operations of a run of the graph back to back, synchronizing the devices
+            once per repeat rather than after each operation, in a single call to the executor.
+            `min_repeat_ms` and `limit_zero_time_iterations` are then ignored.
+
         Returns
         -------
         A 2-dimensional array where the dimensions are: the index of the operation and
         the repeat of the measurement.
         """
-        res = self._run_individual(
-            number,
-            repeat,
-            min_repeat_ms,
-            limit_zero_time_iterations,
-            cooldown_interval_ms,
-            repeats_to_cooldown,
-        )
+        if batched:
+            res = self.module["run_individual_batched"](
+                number, repeat, cooldown_interval_ms, repeats_to_cooldown
+            )
+        else:
+            res = self._run_individual(
+                number,
+                repeat,
+                min_repeat_ms,
+                limit_zero_time_iterations,
+                cooldown_interval_ms,
+                repeats_to_cooldown,
+            )
         results = []
         offset = 0
         format_size = "@q"
@@ -479,14 +490,20 @@ class GraphModuleDebug(graph_executor.GraphModule):
         results = struct.unpack(fmt, res)
         return BenchmarkResult(list(results))
 
-    def profile(self, collectors=None, **input_dict):
+    def profile(self, collectors=None, repeat=1, **input_dict):
         """Run forward execution of the graph and collect overall and per-op
         performance metrics.
 
         Parameters
         ----------
-        collectors : Optional[Sequence[MetricCollector]]
-            Extra metrics to collect. If profiling over RPC, collectors must be `None`.
+        collectors : Optional[Sequence[Union[MetricCollector, str]]]
+            Extra metrics to collect. MetricCollectors cannot be sent over RPC, so when profiling
+            over RPC they are given by the name of the global function constructing them on the
+            remote, e.g. "runtime.profiling.HexagonMetricCollector".
+
+        repeat : int, optional
+            The number of runs of the graph recorded in the report, all done by the executor in a
+            single call, also over RPC.
 
         input_dict : dict of str to NDArray
             List of input values to be feed to
@@ -500,10 +517,12 @@ class GraphModuleDebug(graph_executor.GraphModule):
             self.set_input(**input_dict)
 
         if self.module.type_key == "rpc":
-            # We cannot serialize MetricCollectors over RPC
-            assert collectors is None, "Profiling with collectors is not supported over RPC"
-            return Report.from_json(self._profile_rpc())
-        return self._profile(collectors)
+            # We cannot serialize MetricCollectors over RPC, the remote constructs them by name
+            assert all(
+                isinstance(c, str) for c in collectors or []
+            ), "Over RPC, collectors must be given by the names of their global functions"
+            return Report.from_json(self._profile_rpc(repeat, ",".join(collectors or [])))
+        return self._profile(collectors, repeat)
 
     def exit(self):
         """Exits the dump folder and all its contents"""
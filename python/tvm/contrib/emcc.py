@@ -33,18 +33,24 @@ def create_tvmjs_wasm(output, objects, options=None, cc="emcc"):
         List of object files.
 
     options : str
-        The additional options.
+        The additional options, with "-pthread" to link with the runtime built with
+        USE_PTHREADS=1, in which case the objects have to be compiled for
+        tvm.target.wasm(threads=True).
 
     cc : str, optional
         The compile string.
     """
+    pthread = bool(options) and "-pthread" in options
     cmd = [cc]
     cmd += ["-O3"]
     cmd += ["-std=c++17"]
     cmd += ["--no-entry"]
     cmd += ["-s", "WASM_BIGINT=1"]
     cmd += ["-s", "ERROR_ON_UNDEFINED_SYMBOLS=0"]
-    cmd += ["-s", "STANDALONE_WASM=1"]
+    if pthread:
+        cmd += ["-s", "PTHREAD_POOL_SIZE=navigator.hardwareConcurrency"]
+    else:
+        cmd += ["-s", "STANDALONE_WASM=1"]
     cmd += ["-s", "ALLOW_MEMORY_GROWTH=1"]
 
     objects = [objects] if isinstance(objects, str) else objects
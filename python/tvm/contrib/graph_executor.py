@@ -15,6 +15,7 @@
 # specific language governing permissions and limitations
 # under the License.
 """Minimum graph executor that executes graph containing TVM PackedFunc."""
+import json
 import numpy as np
 import tvm._ffi
 
@@ -123,6 +124,10 @@ class GraphModule(object):
     module : tvm.runtime.Module
         The internal tvm module that holds the actual graph functions.
 
+    thread_pool_group : Optional[str]
+        The thread pool group created by tvm.runtime.create_thread_pool_group
+        to run the parallel operators on. Defaults to the pool of the calling thread.
+
     Attributes
     ----------
     module : tvm.runtime.Module
@@ -150,9 +155,11 @@ class GraphModule(object):
         gmod.run()
     """
 
-    def __init__(self, module):
+    def __init__(self, module, thread_pool_group=None):
         self.module = module
         self._set_input = module["set_input"]
+        if thread_pool_group is not None:
+            module["bind_thread_pool_group"](thread_pool_group)
 
         # TODO(shingjan): The graph_executor in C doesn't have
         # set_input/output_zero_copy implemented.
@@ -176,7 +183,12 @@ class GraphModule(object):
         self._get_input_info = module["get_input_info"]
         self._get_num_inputs = module["get_num_inputs"]
         self._load_params = module["load_params"]
+        try:
+            self._get_param_layout_transforms = module["get_param_layout_transforms"]
+        except AttributeError:
+            self._get_param_layout_transforms = dict
         self._share_params = module["share_params"]
+        self._staging = False
 
     def set_input(self, key=None, value=None, **params):
         """Set inputs to the module via kwargs
@@ -196,7 +208,12 @@ class GraphModule(object):
             v = self._get_input(key)
             if v is None:
                 raise RuntimeError("Could not find '%s' in graph's inputs" % key)
-            v.copyfrom(value)
+            if self._staging:
+                if not isinstance(value, tvm.nd.NDArray):
+                    value = tvm.nd.array(value)
+                self._set_input(key, value)
+            else:
+                v.copyfrom(value)
 
         if params:
             # upload big arrays first to avoid memory issue in rpc mode
@@ -315,6 +332,17 @@ class GraphModule(object):
         """
         return self._get_input_index(name)
 
+    def get_param_layout_transforms(self):
+        """Get the weight layout transforms of the inputs, e.g. inserted by RewriteLayout, which
+        run once when the inputs change rather than at every run.
+
+        Returns
+        -------
+        transforms : Dict[str, str]
+            The name of the function transforming each input.
+        """
+        return {str(k): str(v) for k, v in self._get_param_layout_transforms().items()}
+
     def get_input_info(self):
         """Return the 'shape' and 'dtype' dictionaries of the graph.
 
@@ -381,6 +409,20 @@ class GraphModule(object):
         """
         self._load_params(bytearray(params_bytes))
 
+    def load_params_from_file(self, path):
+        """Load parameters from a parameter file.
+
+        Files saved with ``tvm.runtime.save_param_dict_to_file(params, path, mappable=True)``
+        are memory-mapped: the CPU parameters are used in place and shared with the page
+        cache across processes, instead of being copied.
+
+        Parameters
+        ----------
+        path : str
+            The path to the parameter file.
+        """
+        self.module["load_params_from_file"](path)
+
     def share_params(self, other, params_bytes):
         """Share parameters from pre-existing GraphExecutor instance.
 
@@ -394,6 +436,102 @@ class GraphModule(object):
         """
         self._share_params(other.module, bytearray(params_bytes))
 
+    def clone(self, share_workspace=False):
+        """Create another executor of the same graph, for serving requests concurrently.
+
+        The clone shares the compiled module and the parameters with this executor, and has
+        its own inputs, outputs and intermediate tensors. Setting a parameter of one of them
+        updates all of them.
+
+        Parameters
+        ----------
+        share_workspace : bool
+            Whether the clone also shares the intermediate tensors, which requires that the
+            clone and this executor never run concurrently.
+
+        Returns
+        -------
+        clone : GraphModule
+            The clone.
+        """
+        return GraphModule(self.module["clone"](share_workspace))
+
+    def bind_numa_node(self, node, nthreads=0):
+        """Bind the executor to a NUMA node.
+
+        The CPU storage of the executor is migrated to the node, and the thread pool
+        of the thread calling run is pinned to the CPUs of the node.
+
+        Parameters
+        ----------
+        node : int
+            The id of the NUMA node.
+
+        nthreads : int
+            The number of threads to use, 0 uses all the CPUs of the node.
+        """
+        self.module["bind_numa_node"](node, nthreads)
+
+    def set_parallel_execution(self, num_workers):
+        """Run independent nodes of the graph concurrently.
+
+        The nodes whose inputs are ready are dispatched to worker threads, each
+        with its own slice of the CPUs and its own stream on the GPU. Nodes
+        reusing a storage of the memory plan wait for its earlier users.
+
+        Parameters
+        ----------
+        num_workers : int
+            The number of worker threads, 0 or 1 runs the nodes one by one.
+        """
+        self.module["set_parallel_execution"](num_workers)
+
+    def enable_op_latency_histograms(self, sample_period=1):
+        """Record the latency of every node into histograms.
+
+        The recording is cheap enough to stay on in production: only one of every
+        `sample_period` runs is timed, and the device timers are read later without
+        blocking. The histograms are exported with get_op_latency_histograms.
+
+        Parameters
+        ----------
+        sample_period : int
+            Time one of every sample_period runs, 0 disables the recording.
+        """
+        self.module["enable_op_latency_histograms"](sample_period)
+
+    def get_op_latency_histograms(self, reset=False):
+        """Export the latency histograms, to be polled by a metrics agent.
+
+        Parameters
+        ----------
+        reset : bool
+            Whether to clear the histograms after reading them.
+
+        Returns
+        -------
+        histograms : dict
+            The count, sum, max and quantiles in microseconds of each operator,
+            with the non empty buckets as [upper bound, count] pairs.
+        """
+        return json.loads(self.module["get_op_latency_histograms"](reset))
+
+    def set_staging(self, enable=True):
+        """Stage the inputs and outputs on accelerators through pinned host memory.
+
+        set_input uploads the data on a copy stream into a second device buffer
+        while the previous run is still in flight, and run starts downloading
+        the outputs to pinned host buffers, which get_output waits for when
+        given an output array.
+
+        Parameters
+        ----------
+        enable : bool
+            Whether to enable the staging.
+        """
+        self._staging = enable
+        self.module["set_staging"](enable)
+
     def __getitem__(self, key):
         """Get internal module function
 
@@ -420,3 +420,29 @@ class Session:
         assert isinstance(mode, str), f"Invalid mode type, {type(mode)} != str"
         assert isinstance(path, str), f"Invalid path type, {type(path)} != str"
         return self._rpc.get_function("tvm.hexagon.get_profile_output")(mode, path)
+
+    def get_lwp_report(self, reset: bool = True) -> "tvm.runtime.profiling.Report":
+        """Get the lightweight profiling cycles aggregated on device.
+
+        The kernels must be built with the `tir.instrument_lwp` pass config.
+        Unlike `get_profile_output`, no post-processing is needed: the report
+        has one row per LWP function or loop ID with its number of completed
+        invocations and cycles. Durations are estimated from the average clock
+        rate since the last reset.
+
+        Parameters
+        ----------
+        reset : bool
+            Clear the LWP records after reading them.
+
+        Returns
+        -------
+        report : tvm.runtime.profiling.Report
+            The per ID report.
+        """
+        report = tvm.runtime.profiling.Report.from_json(
+            self._rpc.get_function("tvm.hexagon.lwp_report")()
+        )
+        if reset:
+            self._rpc.get_function("tvm.hexagon.lwp_reset")()
+        return report
@@ -183,10 +183,49 @@ def get_cuda_version(cuda_path=None):
     raise RuntimeError("Cannot read cuda version file")
 
 
+def get_fatbin_gencode(archs):
+    """Get the nvcc options packaging a fat binary for several architectures.
+
+    A cubin is generated for each architecture, and the PTX of the newest one is embedded,
+    so that the driver can compile it for a device newer than all of them.
+
+    Parameters
+    ----------
+    archs : list of str
+        The cuda architectures, such as ["sm_70", "sm_80"].
+
+    Returns
+    -------
+    options : list of str
+        The -gencode options of nvcc.
+    """
+    versions = []
+    for arch in archs:
+        if not arch.startswith("sm_"):
+            raise ValueError("fatbin_archs must be in the form sm_xx, but got %s" % arch)
+        versions.append(arch[len("sm_") :])
+    if not versions:
+        raise ValueError("fatbin_archs must not be empty")
+    options = []
+    for version in versions:
+        options += ["-gencode", f"arch=compute_{version},code=sm_{version}"]
+    newest = max(versions, key=int)
+    options += ["-gencode", f"arch=compute_{newest},code=compute_{newest}"]
+    return options
+
+
 @tvm._ffi.register_func
 def tvm_callback_cuda_compile(code):
-    """use nvcc to generate fatbin code for better optimization"""
-    ptx = compile_cuda(code, target_format="fatbin")
+    """use nvcc to generate fatbin code for better optimization
+
+    When the current target has the attribute "fatbin_archs", the fat binary holds a cubin for
+    each of these architectures, so that no driver JIT happens when the module is loaded.
+    """
+    target = Target.current(allow_none=True)
+    arch = None
+    if target is not None and "fatbin_archs" in target.attrs:
+        arch = get_fatbin_gencode([str(x) for x in target.attrs["fatbin_archs"]])
+    ptx = compile_cuda(code, target_format="fatbin", arch=arch)
     return ptx
 
 
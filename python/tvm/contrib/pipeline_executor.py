@@ -59,6 +59,7 @@ class PipelineModule(object):
         self._get_num_inputs = self.module["get_num_inputs"]
         self._get_input_pipeline_map = self.module["get_input_pipeline_map"]
         self._get_pipe_execute_count = self.module["get_execute_count"]
+        self._get_stage_statistics = self.module["get_stage_statistics"]
 
     def run(self):
         """Run the pipeline executor."""
@@ -153,6 +154,20 @@ class PipelineModule(object):
 
         return outputs
 
+    def get_stage_statistics(self):
+        """Get the telemetry of each stage of the pipeline, the slowest stage is the one with the
+        largest mean latency and the one whose parents wait the longest.
+
+        Returns
+        -------
+        statistics : List[Dict[str, Object]]
+            For each module in order, the "Count", total "Duration (us)", "Mean (us)" and
+            "Max (us)" of its runs, the "Backpressure (us)" it spent waiting for the full queues
+            of its children, and the current and largest depth of its input queues, as
+            "Queue Depth" and "Max Queue Depth".
+        """
+        return self._get_stage_statistics()
+
     @property
     def num_executing_pipeline(self):
         """Getting the count of running pipeline.
@@ -101,6 +101,7 @@ def build(pipe_configs):
     string_config["param_connection"] = config["param_connection"]
     string_config["input_connection"] = config["input_connection"]
     string_config["module_connection"] = module_string_config
+    string_config["queue_capacity"] = config.get("queue_capacity", 0)
 
     return PipelineExecutorFactoryModule(libs, string_config)
 
@@ -500,6 +501,9 @@ class PipelineConfig(object):
         self.output_bindings = self.BindingList(self, "output")
         # There is a map of global parameters group and module index.
         self.param_group_bindings = self.BindingList(self, "param")
+        # The number of outputs a module can forward to a slower child before waiting for it,
+        # 0 uses the default capacity.
+        self.queue_capacity = 0
 
     def __str__(self):
         # Get configuration information as a string.
@@ -634,6 +638,7 @@ class PipelineConfig(object):
         mconfig["module_connection"] = module_connection
         mconfig["input_connection"] = input_connection
         mconfig["param_connection"] = param_connection
+        mconfig["queue_capacity"] = self.queue_capacity
         return mconfig
 
     def dag_topology_sort(self):
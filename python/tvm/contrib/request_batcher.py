@@ -0,0 +1,76 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Native batching of concurrent single-sample requests."""
+import tvm._ffi
+from tvm.runtime import ShapeTuple
+
+
+class RequestBatcher(object):
+    """Gathers single-sample requests submitted from concurrent threads into batches.
+
+    Requests are collected until the largest batch size is reached or the oldest request
+    has waited ``max_latency_us``. The batch then runs on the executor with the smallest
+    batch size that fits it, and every sample's results are copied straight into the
+    output tensors given by its caller.
+
+    Parameters
+    ----------
+    executors : list of GraphModule, VirtualMachine or tvm.runtime.Module
+        The executors, each compiled with a leading batch dimension on all of its inputs
+        and outputs. The same VirtualMachine may be passed several times when its
+        function has a dynamic batch dimension.
+
+    batch_sizes : list of int
+        The batch size of each executor.
+
+    max_latency_us : int
+        How long, in microseconds, a request may wait for its batch to fill up.
+
+    vm_function : str
+        The function to invoke when the executors are VirtualMachines.
+    """
+
+    def __init__(self, executors, batch_sizes, max_latency_us=1000, vm_function=""):
+        modules = [getattr(e, "module", e) for e in executors]
+        fcreate = tvm._ffi.get_global_func("tvm.runtime.RequestBatcher")
+        self.module = fcreate(modules, ShapeTuple(batch_sizes), max_latency_us, vm_function)
+        self._submit = self.module["submit"]
+        self._get_statistics = self.module["get_statistics"]
+
+    def submit(self, inputs, outputs):
+        """Run one sample and block until its batch has completed.
+
+        Parameters
+        ----------
+        inputs : list of NDArray
+            The inputs of the sample, without the batch dimension or with a batch
+            dimension of 1.
+
+        outputs : list of NDArray
+            The tensors receiving the outputs of the sample.
+        """
+        self._submit(inputs, outputs)
+
+    def get_statistics(self):
+        """Get the number of batches run, requests served and padding samples.
+
+        Returns
+        -------
+        statistics : Map[str, Object]
+            The "Batches", "Requests" and "Padded Samples" counts.
+        """
+        return self._get_statistics()
@@ -26,7 +26,10 @@ from .base import (
     SourceName,
     Span,
     assert_structural_equal,
+    load_binary,
+    load_binary_file,
     load_json,
+    save_binary,
     save_json,
     structural_equal,
     structural_hash,
@@ -132,6 +132,59 @@ def save_json(node) -> str:
     return _ffi_node_api.SaveJSON(node)
 
 
+def load_binary(blob) -> Object:
+    """Load tvm object from the bytes saved by save_binary.
+
+    Parameters
+    ----------
+    blob : bytes or bytearray
+        The saved bytes.
+
+    Returns
+    -------
+    node : Object
+        The loaded tvm node.
+    """
+    return _ffi_node_api.LoadBinary(bytearray(blob))
+
+
+def load_binary_file(path) -> Object:
+    """Load tvm object from a file written with the bytes of save_binary.
+
+    The file is mapped, and the NDArrays of the object point into it instead of being copied.
+
+    Parameters
+    ----------
+    path : str
+        The path of the file.
+
+    Returns
+    -------
+    node : Object
+        The loaded tvm node.
+    """
+    return _ffi_node_api.LoadBinaryFromFile(path)
+
+
+def save_binary(node) -> bytearray:
+    """Save tvm object in the binary format.
+
+    It holds the same graph as save_json, but is faster to save and load, and keeps the data
+    of the NDArrays as raw bytes.
+
+    Parameters
+    ----------
+    node : Object
+        A TVM object to be saved.
+
+    Returns
+    -------
+    blob : bytearray
+        Saved bytes.
+    """
+    return _ffi_node_api.SaveBinary(node)
+
+
 def structural_equal(lhs, rhs, map_free_vars=False):
     """Check structural equality of lhs and rhs.
 
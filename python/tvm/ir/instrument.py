@@ -255,3 +255,68 @@ class PassTimingInstrument(tvm.runtime.Object):
                 profiles = timing_inst.render()
         """
         return _ffi_instrument_api.RenderTimePassProfiles()
+
+
+@tvm._ffi.register_object("instrument.PassProfilingInstrument")
+class PassProfilingInstrument(tvm.runtime.Object):
+    """A pass instrument implemented in C++ that profiles every pass run in its context
+
+    For each pass it records the wall time, the number of IR nodes of the module before and after
+    the pass, and the growth of the peak resident set size of the process. For TIR function-level
+    passes, the time spent on each PrimFunc is recorded as well. Unlike PassTimingInstrument, the
+    profile is kept after the pass context is exited.
+
+    Parameters
+    ----------
+    count_nodes : bool
+        Whether to count the IR nodes before and after each pass. Counting walks the whole
+        module, so it can be disabled when only the timings are of interest.
+
+    Examples
+    --------
+
+    .. code-block:: python
+
+        profiler = PassProfilingInstrument()
+        with tvm.transform.PassContext(opt_level=3, instruments=[profiler]):
+            lib = relay.build(mod, target="llvm")
+        print(profiler.render())
+        # Open with https://ui.perfetto.dev or chrome://tracing
+        profiler.save_trace("compile_trace.json")
+    """
+
+    def __init__(self, count_nodes=True):
+        self.__init_handle_by_constructor__(
+            _ffi_instrument_api.MakePassProfilingInstrument, count_nodes
+        )
+
+    def render(self):
+        """Render the profile as a table, with the nested passes indented
+
+        Returns
+        -------
+        profile : str
+            The rendered profile.
+        """
+        return _ffi_instrument_api.PassProfilingInstrumentRender(self)
+
+    def as_trace_json(self):
+        """Export the profile in the JSON trace event format
+
+        Returns
+        -------
+        trace : str
+            The trace, that can be loaded by Perfetto or chrome://tracing.
+        """
+        return _ffi_instrument_api.PassProfilingInstrumentAsTraceJSON(self)
+
+    def save_trace(self, path):
+        """Save the profile in the JSON trace event format
+
+        Parameters
+        ----------
+        path : str
+            The path of the trace file.
+        """
+        with open(path, "w") as trace_file:
+            trace_file.write(self.as_trace_json())
@@ -130,7 +130,7 @@ class Builder(Object):
 
     @staticmethod
     def create(  # pylint: disable=keyword-arg-before-vararg
-        kind: Literal["local"] = "local",
+        kind: Literal["local", "in-process"] = "local",
         *args,
         **kwargs,
     ) -> "Builder":
@@ -138,18 +138,23 @@ class Builder(Object):
 
         Parameters
         ----------
-        kind : Literal["local"]
-            The kind of the builder. For now, only "local" is supported.
+        kind : Literal["local", "in-process"]
+            The kind of the builder.
 
         Returns
         -------
         builder : Builder
             The builder created.
         """
-        from . import LocalBuilder  # pylint: disable=import-outside-toplevel
+        from . import (  # pylint: disable=import-outside-toplevel
+            InProcessBuilder,
+            LocalBuilder,
+        )
 
         if kind == "local":
             return LocalBuilder(*args, **kwargs)  # type: ignore
+        if kind == "in-process":
+            return InProcessBuilder(*args, **kwargs)
         raise ValueError(f"Unknown Builder: {kind}")
 
 
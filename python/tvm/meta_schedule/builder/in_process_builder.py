@@ -0,0 +1,70 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A builder that compiles on a thread pool of the tuning process, keeping the results in memory"""
+from typing import Optional
+
+from tvm._ffi import register_object
+from tvm.runtime import Module
+
+from .. import _ffi_api
+from ..logging import get_logger
+from ..utils import cpu_count
+from .builder import Builder
+
+logger = get_logger(__name__)  # pylint: disable=invalid-name
+
+
+@register_object("meta_schedule.InProcessBuilder")
+class InProcessBuilder(Builder):
+    """A builder that builds the given inputs in parallel in the current process.
+
+    The built modules are not exported. Instead, the artifact path of each result refers to a
+    module kept in memory, which only a runner in the same process can load, e.g.
+    `LocalRunner(in_process=True)`. The `RemoveBuildArtifact` measure callback releases them.
+
+    Note
+    ----
+    Only the native build pipeline is used, so there is no customized build function, and the
+    inputs must not carry parameters. A build that hangs can't be interrupted by a timeout.
+    """
+
+    def __init__(self, *, max_workers: Optional[int] = None) -> None:
+        """Constructor.
+
+        Parameters
+        ----------
+        max_workers : Optional[int]
+            The number of threads to build with.
+            Defaults to number of CPUs.
+        """
+        if max_workers is None:
+            max_workers = cpu_count(logical=True)
+        logger.info("InProcessBuilder: max_workers = %d", max_workers)
+        self.__init_handle_by_constructor__(
+            _ffi_api.BuilderInProcessBuilder,  # type: ignore # pylint: disable=no-member
+            max_workers,
+        )
+
+
+def is_in_memory_artifact(artifact_path: str) -> bool:
+    """Check if an artifact path refers to a module kept in memory by the InProcessBuilder."""
+    return _ffi_api.BuilderIsInMemoryArtifact(artifact_path)  # type: ignore # pylint: disable=no-member
+
+
+def get_in_memory_artifact(artifact_path: str) -> Module:
+    """Get a module kept in memory by the InProcessBuilder."""
+    return _ffi_api.BuilderGetInMemoryArtifact(artifact_path)  # type: ignore # pylint: disable=no-member
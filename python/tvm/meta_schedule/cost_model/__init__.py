@@ -17,6 +17,8 @@
 """
 The tvm.meta_schedule.cost_model package.
 """
-from .cost_model import CostModel, PyCostModel
+from .cost_model import CostModel, PyCostModel, pretrain_from_database
+from .gbdt_model import GBDTModel
 from .random_model import RandomModel
+from .segment_sum_mlp_model import SegmentSumMLPModel
 from .xgb_model import XGBModel
@@ -16,7 +16,7 @@
 # under the License.
 """Meta Schedule CostModel."""
 import ctypes
-from typing import Callable, List, Union
+from typing import TYPE_CHECKING, Callable, Dict, List, Union
 
 # isort: off
 from typing_extensions import Literal
@@ -25,7 +25,9 @@ from typing_extensions import Literal
 
 import numpy as np  # type: ignore
 from tvm._ffi import register_object
+from tvm.ir import structural_hash
 from tvm.runtime import Object
+from tvm.target import Target
 
 from .. import _ffi_api
 from ..runner import RunnerResult
@@ -33,12 +35,15 @@ from ..search_strategy import MeasureCandidate
 from ..tune_context import TuneContext
 from ..utils import _get_default_str
 
+if TYPE_CHECKING:
+    from ..database import Database, TuningRecord
+
 
 @register_object("meta_schedule.CostModel")
 class CostModel(Object):
     """Cost model."""
 
-    CostModelType = Union["CostModel", Literal["xgb", "mlp", "random"]]
+    CostModelType = Union["CostModel", Literal["xgb", "gbdt", "mlp", "segment-sum-mlp", "random"]]
 
     def load(self, path: str) -> None:
         """Load the cost model from given file location.
@@ -106,7 +111,7 @@ class CostModel(Object):
 
     @staticmethod
     def create(
-        kind: Literal["xgb", "mlp", "random", "none"],
+        kind: Literal["xgb", "gbdt", "mlp", "segment-sum-mlp", "random", "none"],
         *args,
         **kwargs,
     ) -> "CostModel":
@@ -114,15 +119,21 @@ class CostModel(Object):
 
         Parameters
         ----------
-        kind : Literal["xgb", "mlp", "random", "none"]
-            The kind of the cost model. Can be "xgb", "mlp", "random" or "none".
+        kind : Literal["xgb", "gbdt", "mlp", "segment-sum-mlp", "random", "none"]
+            The kind of the cost model. Can be "xgb", "gbdt", "mlp", "segment-sum-mlp", "random"
+            or "none".
 
         Returns
         -------
         cost_model : CostModel
             The created cost model.
         """
-        from . import RandomModel, XGBModel  # pylint: disable=import-outside-toplevel
+        from . import (  # pylint: disable=import-outside-toplevel
+            GBDTModel,
+            RandomModel,
+            SegmentSumMLPModel,
+            XGBModel,
+        )
 
         if kind == "xgb":
             return XGBModel(*args, **kwargs)  # type: ignore
@@ -131,6 +142,10 @@ class CostModel(Object):
             # num_tuning_cores is only relevant for XGBModel.
             kwargs.pop("num_tuning_cores")
 
+        if kind == "gbdt":
+            return GBDTModel(*args, **kwargs)  # type: ignore
+        if kind == "segment-sum-mlp":
+            return SegmentSumMLPModel(*args, **kwargs)  # type: ignore
         if kind == "random":
             return RandomModel(*args, **kwargs)  # type: ignore
         if kind == "mlp":
@@ -147,6 +162,49 @@ class CostModel(Object):
 create = CostModel.create  # pylint: disable=invalid-name
 
 
+def pretrain_from_database(
+    cost_model: "CostModel",
+    database: "Database",
+    target: Union[str, Target],
+) -> int:
+    """Pre-train a cost model on the tuning records of another target, e.g. a close CPU model,
+    before tuning on a new one. The feature extractor of the cost model should include the
+    features of the target, e.g. `TargetFeature(PerStoreFeature())`, so that it can tell the
+    targets apart.
+
+    Parameters
+    ----------
+    cost_model : CostModel
+        The cost model to be pre-trained.
+    database : Database
+        The database tuned on the other target.
+    target : Union[str, Target]
+        The target the records of the database are measured on.
+
+    Returns
+    -------
+    num_records : int
+        The number of tuning records the cost model is trained on.
+    """
+    if isinstance(target, str):
+        target = Target(target)
+    groups: Dict[int, List["TuningRecord"]] = {}
+    for record in database.get_all_tuning_records():
+        run_secs = record.run_secs
+        # Failed runs are recorded with a huge latency
+        if not run_secs or any(float(x) >= 1e9 for x in run_secs):
+            continue
+        groups.setdefault(structural_hash(record.workload.mod), []).append(record)
+    num_records = 0
+    for records in groups.values():
+        context = TuneContext(mod=records[0].workload.mod, target=target)
+        candidates = [record.as_measure_candidate() for record in records]
+        results = [RunnerResult(run_secs=record.run_secs, error_msg=None) for record in records]
+        cost_model.update(context, candidates, results)
+        num_records += len(records)
+    return num_records
+
+
 @register_object("meta_schedule.PyCostModel")
 class _PyCostModel(CostModel):
     """
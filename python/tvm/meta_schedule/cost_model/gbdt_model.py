@@ -0,0 +1,113 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Gradient-boosted decision tree cost model trained natively"""
+from tvm._ffi import register_object
+
+from .. import _ffi_api
+from ..feature_extractor import FeatureExtractor
+from .cost_model import CostModel
+
+
+@register_object("meta_schedule.GBDTModel")
+class GBDTModel(CostModel):
+    """Gradient-boosted decision tree cost model.
+
+    It scores a candidate the same way as `XGBModel`, by the sum of the tree outputs of its feature
+    rows, but is trained in C++ without going through numpy or XGBoost: the trees are grown with
+    histograms over quantized features using `TuneContext.num_threads` threads, and the model keeps
+    boosting from its current trees as new results arrive instead of retraining from scratch.
+
+    Parameters
+    ----------
+    extractor : FeatureExtractor
+        The feature extractor for the model.
+    max_depth : int
+        The maximum depth of a tree.
+    eta : float
+        The learning rate.
+    gamma : float
+        The minimum loss reduction of a split.
+    min_child_weight : float
+        The minimum sum of the hessians of a child.
+    reg_lambda : float
+        The L2 regularization on the leaf values.
+    num_bins : int
+        The maximum number of bins a feature is quantized into, at most 256.
+    max_num_rounds : int
+        The maximum number of boosting rounds of one training.
+    early_stopping_rounds : int
+        The number of rounds without improvement of the training p-rmse before a training stops.
+    max_num_trees : int
+        The number of trees beyond which the model is retrained from scratch.
+    num_warmup_samples : int
+        The number of samples that are used for warmup, i.e., the first few samples are predicted
+        with random results.
+    adaptive_training : bool
+        Whether to skip the training until the data grows by 20% since the last training.
+    seed : int
+        The random seed of the predictions during the warmup. -1 means a random seed.
+    """
+
+    extractor: FeatureExtractor
+    max_depth: int
+    eta: float
+    gamma: float
+    min_child_weight: float
+    reg_lambda: float
+    num_bins: int
+    max_num_rounds: int
+    early_stopping_rounds: int
+    max_num_trees: int
+    num_warmup_samples: int
+    adaptive_training: bool
+    data_size: int
+
+    def __init__(
+        self,
+        *,
+        extractor: FeatureExtractor.FeatureExtractorType = "per-store-feature",
+        max_depth: int = 10,
+        eta: float = 0.2,
+        gamma: float = 0.001,
+        min_child_weight: float = 0.0,
+        reg_lambda: float = 1.0,
+        num_bins: int = 256,
+        max_num_rounds: int = 10000,
+        early_stopping_rounds: int = 50,
+        max_num_trees: int = 10000,
+        num_warmup_samples: int = 100,
+        adaptive_training: bool = True,
+        seed: int = -1,
+    ) -> None:
+        if not isinstance(extractor, FeatureExtractor):
+            extractor = FeatureExtractor.create(extractor)
+        self.__init_handle_by_constructor__(
+            _ffi_api.CostModelGBDTModel,  # type: ignore # pylint: disable=no-member
+            extractor,
+            max_depth,
+            eta,
+            gamma,
+            min_child_weight,
+            reg_lambda,
+            num_bins,
+            max_num_rounds,
+            early_stopping_rounds,
+            max_num_trees,
+            num_warmup_samples,
+            adaptive_training,
+            seed,
+        )
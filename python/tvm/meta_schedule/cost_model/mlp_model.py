@@ -413,6 +413,26 @@ class SegmentSumMLP(torch.nn.Module):
         return out
 
 
+def export_segment_sum_mlp(model: SegmentSumMLP, path: str) -> None:
+    """Export the weights of a SegmentSumMLP as a TVM parameter dict, which `SegmentSumMLPModel`
+    loads without PyTorch.
+
+    Parameters
+    ----------
+    model : SegmentSumMLP
+        The model, which must not use the normalization.
+    path : str
+        The file path.
+    """
+    if not isinstance(model.norm, torch.nn.Identity):
+        raise ValueError("SegmentSumMLPModel doesn't support the weights of a model with use_norm")
+    params = {
+        name: tensor.detach().cpu().numpy().astype("float32")
+        for name, tensor in model.state_dict().items()
+    }
+    tvm.runtime.save_param_dict_to_file(params, path)
+
+
 def extract_features(
     context: TuneContext,
     candidates: List[MeasureCandidate],
@@ -0,0 +1,107 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Segment sum MLP cost model trained and run natively"""
+from tvm._ffi import register_object
+
+from .. import _ffi_api
+from ..feature_extractor import FeatureExtractor
+from .cost_model import CostModel
+
+
+@register_object("meta_schedule.SegmentSumMLPModel")
+class SegmentSumMLPModel(CostModel):
+    """Segment sum MLP cost model.
+
+    It has the network and the training of `MLPModel`, but runs in C++ without PyTorch, so that
+    the search strategies call its predictions without going back to python. The weights are saved
+    and loaded as a TVM parameter dict named after the state dict of `SegmentSumMLP`, and the
+    weights of a trained `MLPModel` can be exported with `mlp_model.export_segment_sum_mlp`.
+
+    Parameters
+    ----------
+    extractor : FeatureExtractor
+        The feature extractor for the model.
+    hidden_dim : int
+        The hidden dim of the layers. It is overridden by the loaded weights.
+    use_sigmoid : bool
+        Whether to apply a sigmoid on the output.
+    batch_size : int
+        The number of candidates in a training batch.
+    learning_rate : float
+        The learning rate.
+    weight_decay : float
+        The L2 penalty added to the gradients.
+    num_epoch_full : int
+        The number of epochs of a full training.
+    num_epoch_incremental : int
+        The number of epochs of an incremental training.
+    grad_clip_norm : float
+        The maximum norm of the gradients.
+    test_split : float
+        The fraction of the workloads held out to select the best epoch of a full training.
+    frozen : bool
+        Whether to keep the weights as they are, e.g. when they are pre-trained.
+    seed : int
+        The random seed of the initialization and the shuffling. -1 means a random seed.
+    """
+
+    extractor: FeatureExtractor
+    hidden_dim: int
+    use_sigmoid: bool
+    batch_size: int
+    learning_rate: float
+    weight_decay: float
+    num_epoch_full: int
+    num_epoch_incremental: int
+    grad_clip_norm: float
+    test_split: float
+    frozen: bool
+    data_size: int
+
+    def __init__(
+        self,
+        *,
+        extractor: FeatureExtractor.FeatureExtractorType = "per-store-feature",
+        hidden_dim: int = 256,
+        use_sigmoid: bool = False,
+        batch_size: int = 128,
+        learning_rate: float = 7e-4,
+        weight_decay: float = 1e-6,
+        num_epoch_full: int = 50,
+        num_epoch_incremental: int = 5,
+        grad_clip_norm: float = 0.5,
+        test_split: float = 0.2,
+        frozen: bool = False,
+        seed: int = -1,
+    ) -> None:
+        if not isinstance(extractor, FeatureExtractor):
+            extractor = FeatureExtractor.create(extractor)
+        self.__init_handle_by_constructor__(
+            _ffi_api.CostModelSegmentSumMLPModel,  # type: ignore # pylint: disable=no-member
+            extractor,
+            hidden_dim,
+            use_sigmoid,
+            batch_size,
+            learning_rate,
+            weight_decay,
+            num_epoch_full,
+            num_epoch_incremental,
+            grad_clip_norm,
+            test_split,
+            frozen,
+            seed,
+        )
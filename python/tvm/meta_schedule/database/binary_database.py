@@ -0,0 +1,83 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A database that stores tuning records in a compact binary log"""
+import os.path as osp
+from typing import Optional
+
+from tvm._ffi import register_object
+
+from .. import _ffi_api
+from .database import Database
+
+
+@register_object("meta_schedule.BinaryDatabase")
+class BinaryDatabase(Database):
+    """Database class backed by an append-only binary log.
+
+    The instructions, targets and argument info shared by the tuning records are stored once,
+    and the index kept next to the log at `path + ".index"` lets the database open without
+    parsing the tuning records. Only the records returned by a query are decoded, from a
+    memory-mapped view of the log.
+
+    Parameters
+    ----------
+    path : str
+        The path to the binary log.
+    module_equality : Optional[str]
+        A string to specify the module equality testing and hashing method.
+        It must be one of the followings:
+          - "structural": Use StructuralEqual/Hash
+          - "ignore-ndarray": Same as "structural", but ignore ndarray raw data during
+                              equality testing and hashing.
+          - "anchor-block": Apply equality testing and hashing on the anchor block extracted from a
+                            given module. The "ignore-ndarray" varint is used for the extracted
+                            blocks or in case no anchor block is found.
+                            For the definition of the anchor block, see tir/analysis/analysis.py.
+    """
+
+    path: str
+
+    def __init__(
+        self,
+        path: Optional[str] = None,
+        *,
+        work_dir: Optional[str] = None,
+        allow_missing: bool = True,
+        module_equality: str = "structural",
+    ) -> None:
+        """Constructor.
+
+        Parameters
+        ----------
+        path : Optional[str] = None
+            The path to the binary log. If not specified,
+            will be generated from `work_dir` as `$work_dir/database.bin`.
+        work_dir : Optional[str] = None
+            The work directory, if specified, will be used to generate `path`.
+        allow_missing : bool
+            Whether to create new file when the given path is not found.
+        """
+        if path is None and work_dir is not None:
+            path = osp.join(work_dir, "database.bin")
+        if path is None:
+            raise ValueError("`path` is not specified.")
+        self.__init_handle_by_constructor__(
+            _ffi_api.DatabaseBinaryDatabase,  # type: ignore # pylint: disable=no-member
+            path,
+            allow_missing,
+            module_equality,
+        )
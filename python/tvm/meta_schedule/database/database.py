@@ -368,6 +368,8 @@ class Database(Object):
         kind: Union[
             Literal[
                 "json",
+                "binary",
+                "shared",
                 "memory",
                 "union",
                 "ordered_union",
@@ -381,10 +383,11 @@ class Database(Object):
 
         Parameters
         ----------
-        kind : str = "json" | "memory" | "union" | "ordered_union" | Callable[[tvm.tir.Schedule],
-        bool]
+        kind : str = "json" | "binary" | "shared" | "memory" | "union" | "ordered_union" |
+        Callable[[tvm.tir.Schedule], bool]
             The kind of the database to be created. The following kinds are supported:
-            "json", "memory", "union", "ordered_union", and a custom schedule function.
+            "json", "binary", "shared", "memory", "union", "ordered_union", and a custom schedule
+            function.
 
         Returns
         -------
@@ -392,10 +395,12 @@ class Database(Object):
             The created database.
         """
         from . import (  # pylint: disable=import-outside-toplevel
+            BinaryDatabase,
             JSONDatabase,
             MemoryDatabase,
             OrderedUnionDatabase,
             ScheduleFnDatabase,
+            SharedDatabase,
             UnionDatabase,
         )
 
@@ -403,6 +408,10 @@ class Database(Object):
             return ScheduleFnDatabase(kind, *args, **kwargs)  # type: ignore
         if kind == "json":
             return JSONDatabase(*args, **kwargs)
+        if kind == "binary":
+            return BinaryDatabase(*args, **kwargs)  # type: ignore
+        if kind == "shared":
+            return SharedDatabase(*args, **kwargs)  # type: ignore
         if kind == "memory":
             return MemoryDatabase(*args, **kwargs)  # type: ignore
         if kind == "union":
@@ -0,0 +1,96 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A database shared by many tuning processes through a directory of binary logs"""
+from typing import Optional
+
+from tvm._ffi import register_object
+
+from .. import _ffi_api
+from .database import Database
+
+
+@register_object("meta_schedule.SharedDatabase")
+class SharedDatabase(Database):
+    """Database class that many processes, possibly on different hosts sharing a file system,
+    commit tuning records to concurrently.
+
+    Each process appends to a binary log of its own in the directory, locked for the lifetime of
+    the database, and reads the logs of the other processes, which are refreshed incrementally at
+    most once every `refresh_interval_sec` seconds. The log of a process that has exited is taken
+    over by the next process opening the directory.
+
+    Parameters
+    ----------
+    path : str
+        The directory of the binary logs.
+    segment : str
+        The file name of the binary log this process appends to.
+    refresh_interval_sec : float
+        The minimum interval between two refreshes, in seconds.
+    module_equality : Optional[str]
+        A string to specify the module equality testing and hashing method.
+        It must be one of the followings:
+          - "structural": Use StructuralEqual/Hash
+          - "ignore-ndarray": Same as "structural", but ignore ndarray raw data during
+                              equality testing and hashing.
+          - "anchor-block": Apply equality testing and hashing on the anchor block extracted from a
+                            given module. The "ignore-ndarray" varint is used for the extracted
+                            blocks or in case no anchor block is found.
+                            For the definition of the anchor block, see tir/analysis/analysis.py.
+    """
+
+    path: str
+    segment: str
+    refresh_interval_sec: float
+
+    def __init__(
+        self,
+        path: Optional[str] = None,
+        *,
+        work_dir: Optional[str] = None,
+        refresh_interval_sec: float = 1.0,
+        allow_missing: bool = True,
+        module_equality: str = "structural",
+    ) -> None:
+        """Constructor.
+
+        Parameters
+        ----------
+        path : Optional[str] = None
+            The directory of the binary logs. If not specified, `work_dir` is used.
+        work_dir : Optional[str] = None
+            The work directory, if specified, will be used as `path`.
+        refresh_interval_sec : float
+            The minimum interval between two refreshes, in seconds.
+        allow_missing : bool
+            Whether to create the directory when the given path is not found.
+        """
+        if path is None:
+            path = work_dir
+        if path is None:
+            raise ValueError("`path` is not specified.")
+        self.__init_handle_by_constructor__(
+            _ffi_api.DatabaseSharedDatabase,  # type: ignore # pylint: disable=no-member
+            path,
+            refresh_interval_sec,
+            allow_missing,
+            module_equality,
+        )
+
+    def refresh(self) -> None:
+        """Pick up the tuning records committed by the other processes right away."""
+        _ffi_api.DatabaseSharedDatabaseRefresh(self)  # type: ignore # pylint: disable=no-member
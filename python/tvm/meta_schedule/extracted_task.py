@@ -38,7 +38,9 @@ class ExtractedTask(Object):
     target: Target
         Target information
     dispatched : List[IRModule]
-        A list of low-level IRs that the high-level IR could potentially dispatch to
+        A list of low-level IRs that the high-level IR could potentially dispatch to. With the
+        "anchor-block" module equality, the first one is tuned, and the others are the distinct
+        subgraphs deduplicated into this task because they share its anchor block.
     weight : int
         The weight of the task
     """
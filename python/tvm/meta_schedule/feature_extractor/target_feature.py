@@ -0,0 +1,66 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""The feature extractor that appends the features of the target to another extractor's."""
+from typing import List
+
+from tvm._ffi import register_object
+from tvm.target import Target
+from tvm.target import x86  # pylint: disable=unused-import # registers the ISA queries
+
+from .. import _ffi_api
+from .feature_extractor import FeatureExtractor
+
+
+@register_object("meta_schedule.TargetFeature")
+class TargetFeature(FeatureExtractor):
+    """TargetFeature appends the features of the target, e.g. the number of cores and the vector
+    ISA, to every feature vector extracted by another extractor, so that a cost model trained on
+    the records of one target carries over to a close one.
+
+    Parameters
+    ----------
+    extractor : FeatureExtractor
+        The feature extractor whose features are extended.
+    """
+
+    extractor: FeatureExtractor
+    """The feature extractor whose features are extended."""
+
+    def __init__(self, extractor: FeatureExtractor) -> None:
+        self.__init_handle_by_constructor__(
+            _ffi_api.FeatureExtractorTargetFeature,  # type: ignore # pylint: disable=no-member
+            extractor,
+        )
+
+    @staticmethod
+    def extract(target: Target) -> List[float]:
+        """Extract the features of a target.
+
+        Parameters
+        ----------
+        target : Target
+            The target.
+
+        Returns
+        -------
+        features : List[float]
+            The features of the target.
+        """
+        return [
+            float(x)
+            for x in _ffi_api.FeatureExtractorTargetFeatureExtract(target)  # type: ignore # pylint: disable=no-member
+        ]
@@ -0,0 +1,66 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Mutator that mutates the decision of instruction Sample-Perfect-Tile guided by a cache model"""
+from typing import Optional
+
+from tvm._ffi.registry import register_object
+from tvm.tir.schedule import Trace
+
+from .. import _ffi_api
+from .mutator import Mutator
+
+
+@register_object("meta_schedule.MutateTileSizeCacheAware")
+class MutateTileSizeCacheAware(Mutator):
+    """Mutator that mutates the decision of instruction Sample-Perfect-Tile, keeping among several
+    proposals the one whose loop nest makes the best use of the data caches.
+
+    The working set of every level of the loop nest is estimated from the access regions of the
+    heaviest block, and compared against the `l1_cache_bytes` and `l2_cache_bytes` attributes of
+    the target, which default to 32KB and 1MB. The caches are not modeled on GPU targets.
+
+    Parameters
+    ----------
+    num_proposals : int
+        The number of proposals to choose from in each mutation.
+    """
+
+    num_proposals: int
+
+    def __init__(self, num_proposals: int = 4) -> None:
+        self.__init_handle_by_constructor__(
+            _ffi_api.MutatorMutateTileSizeCacheAware,  # type: ignore # pylint: disable=no-member
+            num_proposals,
+        )
+
+    def score(self, trace: Trace) -> Optional[float]:
+        """Score a trace by the data reuse of its loop nest. A higher score means more reuse.
+
+        Parameters
+        ----------
+        trace : Trace
+            The trace to be scored.
+
+        Returns
+        -------
+        score : Optional[float]
+            The score, or None if the trace fails to apply.
+        """
+        result = _ffi_api.MutateTileSizeCacheAwareScore(  # type: ignore # pylint: disable=no-member
+            self, trace
+        )
+        return None if result is None else float(result)
@@ -99,7 +99,9 @@ class Mutator(Object):
             "llvm": _ffi_api.MutatorDefaultLLVM,  # type: ignore
             "cuda": _ffi_api.MutatorDefaultCUDA,  # type: ignore
             "cuda-tensorcore": _ffi_api.MutatorDefaultCUDATensorCore,  # type: ignore
+            "vulkan-cooperative-matrix": _ffi_api.MutatorDefaultCUDATensorCore,  # type: ignore
             "hexagon": _ffi_api.MutatorDefaultHexagon,  # type: ignore
+            "x86-amx": _ffi_api.MutatorDefaultLLVM,  # type: ignore
             # pylint: enable=no-member
         }
         for k, v in funcs.items():
@@ -93,7 +93,9 @@ class Postproc(Object):
             "llvm": _ffi_api.PostprocDefaultLLVM,  # type: ignore
             "cuda": _ffi_api.PostprocDefaultCUDA,  # type: ignore
             "cuda-tensorcore": _ffi_api.PostprocDefaultCUDATensorCore,  # type: ignore
+            "vulkan-cooperative-matrix": _ffi_api.PostprocDefaultCUDATensorCore,  # type: ignore
             "hexagon": _ffi_api.PostprocDefaultHexagon,  # type: ignore
+            "x86-amx": _ffi_api.PostprocDefaultCPUTensorization,  # type: ignore
             # pylint: enable=no-member
         }
         for k, v in funcs.items():
@@ -0,0 +1,43 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A postprocessor that verifies the register pressure of a given schedule."""
+
+from tvm._ffi.registry import register_object
+from .. import _ffi_api
+from .postproc import Postproc
+
+
+@register_object("meta_schedule.VerifyRegisterPressure")
+class VerifyRegisterPressure(Postproc):
+    """Verifies that the estimated register pressure of the innermost loops, after vectorization
+    and unrolling, does not exceed the vector registers of the target. It is not part of the
+    default postprocessors, it has to be added explicitly.
+
+    Parameters
+    ----------
+    max_registers : int
+        The number of vector registers, or -1 to infer it from the target.
+    vector_bits : int
+        The width of a vector register in bits, or -1 to infer it from the target.
+    """
+
+    def __init__(self, max_registers: int = -1, vector_bits: int = -1) -> None:
+        self.__init_handle_by_constructor__(
+            _ffi_api.PostprocVerifyRegisterPressure,  # type: ignore # pylint: disable=no-member
+            max_registers,
+            vector_bits,
+        )
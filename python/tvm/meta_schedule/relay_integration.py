@@ -15,6 +15,7 @@
 # specific language governing permissions and limitations
 # under the License.
 """MetaSchedule-Relay integration"""
+import os
 from contextlib import contextmanager
 from types import MappingProxyType
 from typing import TYPE_CHECKING, Any, Dict, List, Mapping, Optional, Sequence, Set, Tuple, Union
@@ -34,13 +35,13 @@ from tvm.target import Target
 
 from .builder import Builder
 from .cost_model import CostModel
-from .database import Database
+from .database import Database, JSONDatabase, OrderedUnionDatabase
 from .extracted_task import ExtractedTask
 from .logging import get_loggers_from_work_dir
 from .measure_callback import MeasureCallback
 from .profiler import Profiler
 from .runner import Runner
-from .search_strategy import SearchStrategy
+from .search_strategy import EvolutionarySearch, SearchStrategy
 from .space_generator import SpaceGenerator
 from .task_scheduler import TaskScheduler
 from .tune import tune_tasks
@@ -275,6 +276,8 @@ def tune_relay(
     num_tuning_cores: Union[Literal["physical", "logical"], int] = "physical",
     disabled_pass: Optional[Union[List[str], Set[str], Tuple[str]]] = None,
     instruments: Optional[Sequence[PassInstrument]] = None,
+    shape_buckets: Optional[List[int]] = None,
+    anchor_refine_trials: int = 0,
 ) -> Database:
     """Tune a Relay program.
 
@@ -328,28 +331,46 @@ def tune_relay(
         The list of disabled passes during tasks extraction
     instruments : Optional[Sequence[PassInstrument]]
         The list of pass instrument implementations.
+    shape_buckets : Optional[List[int]]
+        The values of the dynamic shape variable to tune the dynamic-shape functions for, when
+        their buffers have a single one. Pass the same buckets to `compile_relay` to dispatch
+        between the tuned kernels at runtime.
+    anchor_refine_trials : int
+        With the "anchor-block" module equality, the number of trials to refine the best trace of
+        each task on every other subgraph deduplicated into it, starting from the trace transferred
+        via `schedule_using_anchor_trace`. The records of those subgraphs are kept in a separate
+        JSON database in `work_dir`, which uses the "structural" module equality. Disabled if 0.
 
     Returns
     -------
     database : Database
-        The database that contains the tuning records
+        The database that contains the tuning records. When subgraphs are refined, it is an
+        `OrderedUnionDatabase` querying their records before the ones of the tasks.
     """
+    pass_config = {
+        "relay.backend.use_meta_schedule": True,
+        "relay.backend.tir_converter": "default",
+    }
+    if shape_buckets:
+        pass_config["relay.backend.meta_schedule_shape_buckets"] = list(shape_buckets)
+    extracted_tasks = extract_tasks(
+        mod,
+        target,
+        params,
+        pass_config=pass_config,
+        module_equality=module_equality,
+        disabled_pass=disabled_pass,
+        instruments=instruments,
+    )
     tasks, task_weights = extracted_tasks_to_tune_contexts(
-        extracted_tasks=extract_tasks(
-            mod,
-            target,
-            params,
-            module_equality=module_equality,
-            disabled_pass=disabled_pass,
-            instruments=instruments,
-        ),
+        extracted_tasks=extracted_tasks,
         work_dir=work_dir,
         space=space,
         strategy=strategy,
         seed=seed,
         num_tuning_cores=num_tuning_cores,
     )
-    return tune_tasks(
+    database = tune_tasks(
         tasks=tasks,
         task_weights=task_weights,
         work_dir=work_dir,
@@ -364,6 +385,46 @@ def tune_relay(
         task_scheduler=task_scheduler,
         module_equality=module_equality,
     )
+    if anchor_refine_trials <= 0 or module_equality != "anchor-block":
+        return database
+    # The subgraphs sharing the anchor block of a task start from its best trace, transferred
+    # by the evolutionary search, and get a small budget of their own
+    variants = [
+        ExtractedTask(f"{task.task_name}_variant_{i}", task.mod, task.target, [variant_mod], 1)
+        for task in extracted_tasks
+        for i, variant_mod in enumerate(list(task.dispatched)[1:])
+    ]
+    if not variants:
+        return database
+    variant_tasks, variant_weights = extracted_tasks_to_tune_contexts(
+        extracted_tasks=variants,
+        work_dir=work_dir,
+        space=space,
+        strategy=EvolutionarySearch(transfer_database=database),
+        seed=seed,
+        num_tuning_cores=num_tuning_cores,
+    )
+    variant_database = JSONDatabase(
+        path_workload=os.path.join(work_dir, "database_anchor_variant_workload.json"),
+        path_tuning_record=os.path.join(work_dir, "database_anchor_variant_tuning_record.json"),
+        module_equality="structural",
+    )
+    tune_tasks(
+        tasks=variant_tasks,
+        task_weights=variant_weights,
+        work_dir=work_dir,
+        max_trials_global=anchor_refine_trials * len(variant_tasks),
+        max_trials_per_task=anchor_refine_trials,
+        num_trials_per_iter=min(num_trials_per_iter, anchor_refine_trials),
+        builder=builder,
+        runner=runner,
+        database=variant_database,
+        cost_model=cost_model,
+        measure_callbacks=measure_callbacks,
+        task_scheduler="round-robin",
+        module_equality="structural",
+    )
+    return OrderedUnionDatabase(variant_database, database)
 
 
 def compile_relay(
@@ -384,6 +445,7 @@ def compile_relay(
     disabled_pass: Optional[Union[List[str], Set[str], Tuple[str]]] = None,
     runtime: Optional["relay.backend.Runtime"] = None,
     instruments: Optional[Sequence[PassInstrument]] = None,
+    shape_buckets: Optional[List[int]] = None,
 ):
     """Compile a relay program with a MetaSchedule database.
 
@@ -413,6 +475,9 @@ def compile_relay(
         The runtime to use in relay.build. It is not supported by RelayVM.
     instruments : Optional[Sequence[PassInstrument]]
         The list of pass instrument implementations.
+    shape_buckets : Optional[List[int]]
+        The values of the dynamic shape variable the dynamic-shape functions were tuned for. The
+        kernel of the bucket matching the runtime shape is run, and the generic kernel otherwise.
 
     Returns
     -------
@@ -427,6 +492,8 @@ def compile_relay(
         mod, target, params, pass_config, executor, runtime
     )
     pass_config.setdefault("relay.backend.use_meta_schedule_dispatch", True)
+    if shape_buckets:
+        pass_config["relay.backend.meta_schedule_shape_buckets"] = list(shape_buckets)
     with Profiler.timeit("PostTuningCompilation"):
         with target, _autotvm_silencer(), database:
             with transform.PassContext(
@@ -17,7 +17,7 @@
 """Configurations for measurements in the runner"""
 import os
 from threading import Thread
-from typing import NamedTuple, Optional, Union
+from typing import NamedTuple, Optional, Tuple, Union
 
 from tvm import rpc
 
@@ -41,6 +41,23 @@ class EvaluatorConfig(NamedTuple):
         increase the number of runs to the given time (in ms) to reduce the measurement error.
     enable_cpu_cache_flush: bool
         Whether to flush the cache on CPU.
+    enable_device_cache_flush: bool
+        Whether to flush the cache of the device before each repeat, e.g. the L2 of the GPUs.
+        The flush is not timed. Together with `number=1`, every run starts with a cold cache.
+    rotate_args: bool
+        Whether to run the repeats in turn on the argument sets allocated by the runner, see
+        `alloc_repeat`, instead of all the repeats of one set after the other, so that the
+        consecutive repeats do not run on the same buffers. Ignored when `max_rel_ci` is set.
+    batched_timing: bool
+        Whether to enqueue all the repeats before synchronizing the device once, see
+        `Module.batched_time_evaluator`, which makes the timing of microsecond GPU kernels
+        reliable. `min_repeat_ms` is then ignored. Ignored when `max_rel_ci` is set.
+    max_rel_ci: Optional[float]
+        When set, repeat the measurement until the 95% confidence interval of the mean is
+        within this fraction of the mean, dropping the outliers, instead of a fixed `repeat`.
+        `repeat` is then the minimum number of repeats.
+    max_repeat: int
+        The maximum number of repeats when `max_rel_ci` is set.
 
     Note
     ----
@@ -52,6 +69,11 @@ class EvaluatorConfig(NamedTuple):
     repeat: int = 1
     min_repeat_ms: int = 100
     enable_cpu_cache_flush: bool = False
+    enable_device_cache_flush: bool = False
+    rotate_args: bool = False
+    batched_timing: bool = False
+    max_rel_ci: Optional[float] = None
+    max_repeat: int = 20
 
     @staticmethod
     def _normalized(config: Optional["EvaluatorConfig"]) -> "EvaluatorConfig":
@@ -62,6 +84,11 @@ class EvaluatorConfig(NamedTuple):
             repeat=config.repeat,
             min_repeat_ms=config.min_repeat_ms,
             enable_cpu_cache_flush=config.enable_cpu_cache_flush,
+            enable_device_cache_flush=config.enable_device_cache_flush,
+            rotate_args=config.rotate_args,
+            batched_timing=config.batched_timing,
+            max_rel_ci=config.max_rel_ci,
+            max_repeat=config.max_repeat,
         )
         return config
 
@@ -81,6 +108,11 @@ class RPCConfig(NamedTuple):
         Timeout of the RPC session
     session_priority: int
         Priority of the RPC session
+    enable_shared_memory: bool
+        Whether to move the payloads through shared memory when the server is on the same host
+    exclude_devices: Tuple[str, ...]
+        The "url:port" of the servers the sessions should avoid unless nothing else is alive.
+        The runner fills it in when it re-runs a measurement on another device.
     """
 
     tracker_host: Optional[str] = None
@@ -88,6 +120,8 @@ class RPCConfig(NamedTuple):
     tracker_key: Optional[str] = None
     session_priority: int = 1
     session_timeout_sec: int = 10
+    enable_shared_memory: bool = False
+    exclude_devices: Tuple[str, ...] = ()
 
     def _sanity_check(self) -> None:
         err_str = (
@@ -111,6 +145,8 @@ class RPCConfig(NamedTuple):
             tracker_key=config.tracker_key or os.environ.get("TVM_TRACKER_KEY", None),
             session_priority=config.session_priority,
             session_timeout_sec=config.session_timeout_sec,
+            enable_shared_memory=config.enable_shared_memory,
+            exclude_devices=tuple(config.exclude_devices),
         )
         config._sanity_check()  # pylint: disable=protected-access
         return config
@@ -157,6 +193,8 @@ class RPCConfig(NamedTuple):
             key=self.tracker_key,
             priority=self.session_priority,
             session_timeout=self.session_timeout_sec,
+            enable_shared_memory=self.enable_shared_memory,
+            exclude=list(self.exclude_devices),
         )
         return session
 
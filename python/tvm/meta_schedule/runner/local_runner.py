@@ -16,13 +16,14 @@
 # under the License.
 """Local Runner"""
 from contextlib import contextmanager
-from typing import Callable, List, Optional, Union
+from typing import Callable, Dict, List, Optional, Tuple, Union
 import subprocess
 
 import tvm
 
 from ...contrib.popen_pool import PopenPoolExecutor
 from ...runtime import Device, Module
+from ..builder.in_process_builder import get_in_memory_artifact, is_in_memory_artifact
 from ..logging import get_logger
 from ..profiler import Profiler
 from ..utils import derived_object, get_global_func_with_default_on_worker
@@ -114,6 +115,18 @@ class LocalRunnerFuture(PyRunnerFuture):
         return RunnerResult(self.res, self.error_message)
 
 
+def _load_module(artifact_path: str) -> Module:
+    if is_in_memory_artifact(artifact_path):
+        return get_in_memory_artifact(artifact_path)
+    return tvm.runtime.load_module(artifact_path)
+
+
+# The argument sets kept resident on the worker across batches, keyed by their signature
+_RESIDENT_ARGS: Dict[tuple, List[T_ARGUMENT_LIST]] = {}
+# The maximum number of argument sets kept resident
+_MAX_RESIDENT_ARGS = 4
+
+
 def _worker_func(
     _f_alloc_argument: Optional[str],
     _f_run_evaluator: Optional[str],
@@ -144,7 +157,7 @@ def _worker_func(
     with resource_handler():
         # Step 1: create the local runtime module
         with Profiler.timeit("LocalRunner/load_module"):
-            rt_mod = tvm.runtime.load_module(artifact_path)
+            rt_mod = _load_module(artifact_path)
         # Step 2: Allocate input arguments
         with Profiler.timeit("LocalRunner/alloc_argument"):
             device = tvm.runtime.device(dev_type=device_type, dev_id=0)
@@ -164,6 +177,84 @@ def _worker_func(
     return costs
 
 
+def _batch_worker_func(
+    _f_alloc_argument: Optional[str],
+    _f_run_evaluator: Optional[str],
+    _f_cleanup: Optional[str],
+    evaluator_config: EvaluatorConfig,
+    alloc_repeat: int,
+    artifact_paths: List[str],
+    device_type: str,
+    args_info: T_ARG_INFO_JSON_OBJ_LIST,
+) -> List[Tuple[Optional[List[float]], Optional[str]]]:
+    """Measure a batch of candidates that share the same argument signature on one argument set,
+    which is allocated once and kept resident across batches. With a fixed number of repeats, the
+    repeats of the candidates are interleaved, so that a drift of the device affects all of them
+    alike. Returns the costs or the error message of each candidate."""
+    f_alloc_argument: T_ALLOC_ARGUMENT = get_global_func_with_default_on_worker(
+        _f_alloc_argument, default_alloc_argument
+    )
+    f_run_evaluator: T_RUN_EVALUATOR = get_global_func_with_default_on_worker(
+        _f_run_evaluator, default_run_evaluator
+    )
+    f_cleanup: T_CLEANUP = get_global_func_with_default_on_worker(_f_cleanup, default_cleanup)
+
+    n = len(artifact_paths)
+    costs: List[Optional[List[float]]] = [None] * n
+    errors: List[Optional[str]] = [None] * n
+
+    def _fail(i: int, exception: Exception) -> None:
+        costs[i] = None
+        errors[i] = "LocalRunner: An exception occurred\n" + str(exception)
+
+    try:
+        # Step 1: create the local runtime modules
+        rt_mods: List[Optional[Module]] = [None] * n
+        with Profiler.timeit("LocalRunner/load_module"):
+            for i, artifact_path in enumerate(artifact_paths):
+                try:
+                    rt_mods[i] = _load_module(artifact_path)
+                    costs[i] = []
+                except Exception as exception:  # pylint: disable=broad-except
+                    _fail(i, exception)
+        # Step 2: Allocate input arguments, unless they are resident already
+        with Profiler.timeit("LocalRunner/alloc_argument"):
+            device = tvm.runtime.device(dev_type=device_type, dev_id=0)
+            key = (_f_alloc_argument, device_type, tuple(map(str, args_info)), alloc_repeat)
+            repeated_args = _RESIDENT_ARGS.pop(key, None)
+            if repeated_args is None:
+                repeated_args = f_alloc_argument(device, args_info, alloc_repeat)
+                while len(_RESIDENT_ARGS) >= _MAX_RESIDENT_ARGS:
+                    _RESIDENT_ARGS.pop(next(iter(_RESIDENT_ARGS)))
+            _RESIDENT_ARGS[key] = repeated_args  # most recently used last
+        # Step 3: Run time_evaluator, one repeat of every candidate at a time
+        with Profiler.timeit("LocalRunner/run_evaluator"):
+            if evaluator_config.max_rel_ci is None:
+                rounds = evaluator_config.repeat
+                round_config = evaluator_config._replace(repeat=1)
+            else:
+                # The number of repeats is adaptive, which leaves nothing to interleave
+                rounds = 1
+                round_config = evaluator_config
+            for round_id in range(rounds):
+                # Alternate the order so that no candidate always runs right after another one
+                order = range(n) if round_id % 2 == 0 else reversed(range(n))
+                for i in order:
+                    if errors[i] is not None:
+                        continue
+                    try:
+                        costs[i].extend(
+                            f_run_evaluator(rt_mods[i], device, round_config, repeated_args)
+                        )
+                    except Exception as exception:  # pylint: disable=broad-except
+                        _fail(i, exception)
+    finally:
+        # Final step. Always clean up
+        with Profiler.timeit("LocalRunner/cleanup"):
+            f_cleanup()
+    return list(zip(costs, errors))
+
+
 @derived_object
 class LocalRunner(PyRunner):
     """Local runner
@@ -182,8 +273,12 @@ class LocalRunner(PyRunner):
         The function name to run the evaluator or the function itself.
     f_cleanup: Optional[str, Callable]
         The function name to cleanup the session or the function itself.
-    pool: PopenPoolExecutor
-        The popen pool executor.
+    in_process: bool
+        Whether to measure in the current process instead of a popen worker.
+    batch_size: int
+        The maximum number of candidates sharing an argument signature measured in one batch.
+    pool: Optional[PopenPoolExecutor]
+        The popen pool executor, or None when measuring in the current process.
 
     Attributes
     ----------
@@ -229,8 +324,10 @@ class LocalRunner(PyRunner):
     f_alloc_argument: Union[T_ALLOC_ARGUMENT, str, None]
     f_run_evaluator: Union[T_RUN_EVALUATOR, str, None]
     f_cleanup: Union[T_CLEANUP, str, None]
+    in_process: bool
+    batch_size: int
 
-    pool: PopenPoolExecutor
+    pool: Optional[PopenPoolExecutor]
 
     def __init__(
         self,
@@ -242,6 +339,8 @@ class LocalRunner(PyRunner):
         f_run_evaluator: Union[T_RUN_EVALUATOR, str, None] = None,
         f_cleanup: Union[T_CLEANUP, str, None] = None,
         initializer: Optional[Callable[[], None]] = None,
+        in_process: bool = False,
+        batch_size: int = 1,
     ) -> None:
         """Constructor
 
@@ -263,6 +362,16 @@ class LocalRunner(PyRunner):
             The function name to cleanup the session or the function itself.
         initializer: Optional[Callable[[], None]]
             The initializer function.
+        in_process: bool
+            Whether to measure in the current process instead of a popen worker, which is required
+            to run the modules kept in memory by the InProcessBuilder. The timeout is not enforced
+            in this mode, and the initializer is called once in the current process.
+        batch_size: int
+            When greater than 1, the candidates sharing the same device and argument signature
+            are measured in batches of up to `batch_size` on one argument set, which is allocated
+            once and kept resident on the worker across batches, with their repeats interleaved.
+            The timeout then applies to a whole batch, scaled by `batch_size`, and the cleanup
+            function runs once per batch.
         """
         super().__init__()
         self.timeout_sec = timeout_sec
@@ -272,21 +381,32 @@ class LocalRunner(PyRunner):
         self.f_alloc_argument = f_alloc_argument
         self.f_run_evaluator = f_run_evaluator
         self.f_cleanup = f_cleanup
-
-        logger.info("LocalRunner: max_workers = 1")
-        self.pool = PopenPoolExecutor(
-            max_workers=1,  # one local worker
-            timeout=timeout_sec,
-            initializer=initializer,
-            stderr=subprocess.DEVNULL,  # suppress the stderr output
-        )
+        self.in_process = in_process
+        if batch_size < 1:
+            raise ValueError(f"batch_size must be positive, but gets: {batch_size}")
+        self.batch_size = batch_size
+
+        if in_process:
+            logger.info("LocalRunner: in process")
+            self.pool = None
+            if initializer is not None:
+                initializer()
+        else:
+            logger.info("LocalRunner: max_workers = 1")
+            self.pool = PopenPoolExecutor(
+                max_workers=1,  # one local worker
+                timeout=timeout_sec * batch_size,
+                initializer=initializer,
+                stderr=subprocess.DEVNULL,  # suppress the stderr output
+            )
         self._sanity_check()
 
     def run(self, runner_inputs: List[RunnerInput]) -> List[RunnerFuture]:
+        if self.batch_size > 1:
+            return self._run_batched(runner_inputs)
         results: List[RunnerFuture] = []
         for runner_input in runner_inputs:
-            future = self.pool.submit(
-                _worker_func,
+            args = (
                 self.f_alloc_argument,
                 self.f_run_evaluator,
                 self.f_cleanup,
@@ -297,7 +417,10 @@ class LocalRunner(PyRunner):
                 tuple(arg_info.as_json() for arg_info in runner_input.args_info),
             )
             try:
-                result: List[float] = future.result()
+                if self.in_process:
+                    result: List[float] = _worker_func(*args)
+                else:
+                    result = self.pool.submit(_worker_func, *args).result()
                 error_message: str = None
             except TimeoutError:
                 result = None
@@ -309,6 +432,43 @@ class LocalRunner(PyRunner):
             results.append(local_future)  # type: ignore
         return results
 
+    def _run_batched(self, runner_inputs: List[RunnerInput]) -> List[RunnerFuture]:
+        groups: Dict[tuple, List[int]] = {}
+        for i, runner_input in enumerate(runner_inputs):
+            device_type = str(runner_input.device_type)
+            args_info = tuple(arg_info.as_json() for arg_info in runner_input.args_info)
+            groups.setdefault((device_type, str(args_info)), []).append(i)
+        results: List[Optional[RunnerFuture]] = [None] * len(runner_inputs)
+        for indices in groups.values():
+            for start in range(0, len(indices), self.batch_size):
+                batch = indices[start : start + self.batch_size]
+                first = runner_inputs[batch[0]]
+                args = (
+                    self.f_alloc_argument,
+                    self.f_run_evaluator,
+                    self.f_cleanup,
+                    self.evaluator_config,
+                    self.alloc_repeat,
+                    [str(runner_inputs[i].artifact_path) for i in batch],
+                    str(first.device_type),
+                    tuple(arg_info.as_json() for arg_info in first.args_info),
+                )
+                try:
+                    if self.in_process:
+                        outcomes = _batch_worker_func(*args)
+                    else:
+                        outcomes = self.pool.submit(_batch_worker_func, *args).result()
+                except TimeoutError:
+                    timeout = self.timeout_sec * self.batch_size
+                    error = f"LocalRunner: Timeout, killed after {timeout} seconds\n"
+                    outcomes = [(None, error)] * len(batch)
+                except Exception as exception:  # pylint: disable=broad-except
+                    error = "LocalRunner: An exception occurred\n" + str(exception)
+                    outcomes = [(None, error)] * len(batch)
+                for i, (result, error_message) in zip(batch, outcomes):
+                    results[i] = LocalRunnerFuture(res=result, error_message=error_message)
+        return results  # type: ignore
+
     def _sanity_check(self) -> None:
         def _check(
             f_alloc_argument,
@@ -319,6 +479,9 @@ class LocalRunner(PyRunner):
             get_global_func_with_default_on_worker(name=f_run_evaluator, default=None)
             get_global_func_with_default_on_worker(name=f_cleanup, default=None)
 
+        if self.in_process:
+            _check(self.f_alloc_argument, self.f_run_evaluator, self.f_cleanup)
+            return
         value = self.pool.submit(
             _check,
             self.f_alloc_argument,
@@ -17,6 +17,7 @@
 """RPC Runner"""
 import concurrent.futures
 import os.path as osp
+import time
 from contextlib import contextmanager
 from typing import Callable, List, Optional, Union
 
@@ -155,6 +156,11 @@ class RPCRunner(PyRunner):
         The function name to run the evaluator or the function itself.
     f_cleanup: Optional[str, Callable]
         The function name to cleanup the session or the function itself.
+    max_device_retry: int
+        The number of times a suspicious measurement is re-run on another device.
+    noisy_rel_std: Optional[float]
+        When set, a measurement whose costs have a relative standard deviation above it
+        is suspicious and re-run on another device, keeping the least noisy result.
     pool: PopenPoolExecutor
         The popen pool executor.
 
@@ -229,6 +235,8 @@ class RPCRunner(PyRunner):
     f_alloc_argument: Union[T_ALLOC_ARGUMENT, str, None]
     f_run_evaluator: Union[T_RUN_EVALUATOR, str, None]
     f_cleanup: Union[T_CLEANUP, str, None]
+    max_device_retry: int
+    noisy_rel_std: Optional[float]
 
     pool: PopenPoolExecutor
 
@@ -245,6 +253,8 @@ class RPCRunner(PyRunner):
         f_cleanup: Union[T_CLEANUP, str, None] = None,
         max_workers: Optional[int] = None,
         initializer: Optional[Callable[[], None]] = None,
+        max_device_retry: int = 0,
+        noisy_rel_std: Optional[float] = None,
     ) -> None:
         """Constructor
 
@@ -272,6 +282,12 @@ class RPCRunner(PyRunner):
             The maximum number of connections. Defaults to 1.
         initializer: Optional[Callable[[], None]]
             The initializer function.
+        max_device_retry: int
+            The number of times a measurement that fails on a device, or is too noisy,
+            is re-run on another device of the tracker.
+        noisy_rel_std: Optional[float]
+            The relative standard deviation of the costs above which a measurement is noisy.
+            None disables the check.
         """
         super().__init__()
         self.rpc_config = RPCConfig._normalized(rpc_config)
@@ -283,6 +299,8 @@ class RPCRunner(PyRunner):
         self.f_alloc_argument = f_alloc_argument
         self.f_run_evaluator = f_run_evaluator
         self.f_cleanup = f_cleanup
+        self.max_device_retry = max_device_retry
+        self.noisy_rel_std = noisy_rel_std
         if max_workers is None:
             max_workers = 1
         logger.info("RPCRunner: max_workers = %d", max_workers)
@@ -309,6 +327,8 @@ class RPCRunner(PyRunner):
                     str(runner_input.artifact_path),
                     str(runner_input.device_type),
                     tuple(arg_info.as_json() for arg_info in runner_input.args_info),
+                    self.max_device_retry,
+                    self.noisy_rel_std,
                 ),
                 timeout_sec=self.rpc_config.session_timeout_sec,
             )
@@ -352,6 +372,8 @@ def _worker_func(
     artifact_path: str,
     device_type: str,
     args_info: T_ARG_INFO_JSON_OBJ_LIST,
+    max_device_retry: int = 0,
+    noisy_rel_std: Optional[float] = None,
 ) -> List[float]:
     # Step 0. Get the registered functions
     f_create_session: T_CREATE_SESSION = get_global_func_with_default_on_worker(
@@ -367,47 +389,101 @@ def _worker_func(
         _f_run_evaluator, default_run_evaluator
     )
     f_cleanup: T_CLEANUP = get_global_func_with_default_on_worker(_f_cleanup, default_cleanup)
-    # Managed resources
-    session: Optional[RPCSession] = None
-    remote_path: Optional[str] = None
 
-    @contextmanager
-    def resource_handler():
+    def _measure(config: RPCConfig, record: dict) -> List[float]:
+        # Managed resources
+        session: Optional[RPCSession] = None
+        remote_path: Optional[str] = None
+
+        @contextmanager
+        def resource_handler():
+            try:
+                yield
+            finally:
+                # Final step. Always clean up
+                with Profiler.timeit("RPCRunner/cleanup"):
+                    f_cleanup(session, remote_path)
+
+        with resource_handler():
+            # Step 1. Create session
+            with Profiler.timeit("RPCRunner/create_session"):
+                session = f_create_session(config)
+                record["device"] = getattr(session, "tracker_device", None)
+                record["start"] = time.time()
+                device = session.device(dev_type=device_type, dev_id=0)
+            # Step 2. Upload the module
+            with Profiler.timeit("RPCRunner/upload_module"):
+                _, remote_path = osp.split(artifact_path)
+                local_path: str = artifact_path
+                rt_mod: Module = f_upload_module(session, local_path, remote_path)
+            # Step 3: Allocate input arguments
+            with Profiler.timeit("RPCRunner/alloc_argument"):
+                repeated_args: List[T_ARGUMENT_LIST] = f_alloc_argument(
+                    session,
+                    device,
+                    args_info,
+                    alloc_repeat,
+                )
+            # Step 4: Run time_evaluator
+            with Profiler.timeit("LocalRunner/run_evaluator"):
+                costs: List[float] = f_run_evaluator(
+                    session,
+                    rt_mod,
+                    device,
+                    evaluator_config,
+                    repeated_args,
+                )
+        return costs
+
+    # Each attempt is (device, seconds, costs or None, error or None). A failure or a
+    # noisy result on a device is re-run on another one; only the devices that failed
+    # while another one succeeded are blamed for the error.
+    attempts: List[tuple] = []
+    for _ in range(max_device_retry + 1):
+        excluded = tuple(a[0] for a in attempts if a[0] is not None)
+        config = rpc_config._replace(exclude_devices=excluded) if excluded else rpc_config
+        record: dict = {"device": None, "start": None}
         try:
-            yield
-        finally:
-            # Final step. Always clean up
-            with Profiler.timeit("RPCRunner/cleanup"):
-                f_cleanup(session, remote_path)
-
-    with resource_handler():
-        # Step 1. Create session
-        with Profiler.timeit("RPCRunner/create_session"):
-            session = f_create_session(rpc_config)
-            device = session.device(dev_type=device_type, dev_id=0)
-        # Step 2. Upload the module
-        with Profiler.timeit("RPCRunner/upload_module"):
-            _, remote_path = osp.split(artifact_path)
-            local_path: str = artifact_path
-            rt_mod: Module = f_upload_module(session, local_path, remote_path)
-        # Step 3: Allocate input arguments
-        with Profiler.timeit("RPCRunner/alloc_argument"):
-            repeated_args: List[T_ARGUMENT_LIST] = f_alloc_argument(
-                session,
-                device,
-                args_info,
-                alloc_repeat,
-            )
-        # Step 4: Run time_evaluator
-        with Profiler.timeit("LocalRunner/run_evaluator"):
-            costs: List[float] = f_run_evaluator(
-                session,
-                rt_mod,
-                device,
-                evaluator_config,
-                repeated_args,
-            )
-    return costs
+            costs = _measure(config, record)
+            error = None
+        except Exception as exception:  # pylint: disable=broad-except
+            costs, error = None, exception
+        elapsed = time.time() - record["start"] if record["start"] is not None else 0.0
+        attempts.append((record["device"], elapsed, costs, error))
+        if record["device"] is None:
+            # the failure can't be pinned to a device, e.g. the tracker is unreachable
+            break
+        if error is None and (noisy_rel_std is None or _rel_std(costs) <= noisy_rel_std):
+            break
+    succeeded = [a for a in attempts if a[3] is None]
+    _report_device_stats(rpc_config, attempts if succeeded else [])
+    if not succeeded:
+        raise attempts[-1][3]
+    return min(succeeded, key=lambda a: _rel_std(a[2]))[2]
+
+
+def _rel_std(costs: List[float]) -> float:
+    if len(costs) <= 1:
+        return 0.0
+    mean = sum(costs) / len(costs)
+    if mean <= 0:
+        return 0.0
+    var = sum((c - mean) ** 2 for c in costs) / (len(costs) - 1)
+    return var**0.5 / mean
+
+
+def _report_device_stats(rpc_config: RPCConfig, attempts: List[tuple]) -> None:
+    """Report the attempts to the tracker so that it can route work to healthy devices."""
+    attempts = [a for a in attempts if a[0] is not None]
+    if not attempts:
+        return
+    try:
+        tracker = rpc_config.connect_tracker()
+        for device, elapsed, _, error in attempts:
+            tracker.report_stats(device, runs=1, errors=int(error is not None), seconds=elapsed)
+        tracker.close()
+    except Exception as exception:  # pylint: disable=broad-except
+        logger.warning("RPCRunner: Failed to report the device stats: %s", exception)
 
 
 def default_create_session(rpc_config: RPCConfig) -> RPCSession:
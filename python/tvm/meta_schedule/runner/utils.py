@@ -101,16 +101,63 @@ def run_evaluator_common(
     costs: List[float]
         The evaluator results
     """
-    evaluator = rt_mod.time_evaluator(
-        func_name=rt_mod.entry_name,
-        dev=device,
-        number=evaluator_config.number,
-        repeat=evaluator_config.repeat,
-        min_repeat_ms=evaluator_config.min_repeat_ms,
-        f_preproc="cache_flush_cpu_non_first_arg"
-        if evaluator_config.enable_cpu_cache_flush
-        else "",
-    )
+    f_preproc = ""
+    if evaluator_config.enable_device_cache_flush:
+        f_preproc = "cache_flush_device"
+    elif evaluator_config.enable_cpu_cache_flush:
+        f_preproc = "cache_flush_cpu_non_first_arg"
+    if evaluator_config.max_rel_ci is not None:
+        evaluator = rt_mod.adaptive_time_evaluator(
+            func_names=rt_mod.entry_name,
+            dev=device,
+            number=evaluator_config.number,
+            min_repeat=max(evaluator_config.repeat, 2),
+            max_repeat=max(evaluator_config.max_repeat, evaluator_config.repeat, 2),
+            min_repeat_ms=evaluator_config.min_repeat_ms,
+            max_rel_ci=evaluator_config.max_rel_ci,
+            f_preproc=f_preproc,
+        )
+    elif evaluator_config.rotate_args and len(repeated_args) > 1:
+        if evaluator_config.batched_timing:
+            evaluator = rt_mod.batched_time_evaluator(
+                func_name=rt_mod.entry_name,
+                dev=device,
+                number=evaluator_config.number,
+                repeat=1,
+                f_preproc=f_preproc,
+            )
+        else:
+            evaluator = rt_mod.time_evaluator(
+                func_name=rt_mod.entry_name,
+                dev=device,
+                number=evaluator_config.number,
+                repeat=1,
+                min_repeat_ms=evaluator_config.min_repeat_ms,
+                f_preproc=f_preproc,
+            )
+        costs: List[float] = []
+        for _ in range(evaluator_config.repeat):
+            for args in repeated_args:
+                device.sync()
+                costs.extend(float(cost) for cost in evaluator(*args).results)
+        return costs
+    elif evaluator_config.batched_timing:
+        evaluator = rt_mod.batched_time_evaluator(
+            func_name=rt_mod.entry_name,
+            dev=device,
+            number=evaluator_config.number,
+            repeat=evaluator_config.repeat,
+            f_preproc=f_preproc,
+        )
+    else:
+        evaluator = rt_mod.time_evaluator(
+            func_name=rt_mod.entry_name,
+            dev=device,
+            number=evaluator_config.number,
+            repeat=evaluator_config.repeat,
+            min_repeat_ms=evaluator_config.min_repeat_ms,
+            f_preproc=f_preproc,
+        )
     repeated_costs: List[List[float]] = []
     for args in repeated_args:
         device.sync()
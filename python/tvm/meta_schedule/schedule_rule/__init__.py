@@ -33,4 +33,5 @@ from .multi_level_tiling import (
 )
 from .parallel_vectorize_unroll import ParallelizeVectorizeUnroll
 from .random_compute_location import RandomComputeLocation
+from .rolling_buffer_fusion import RollingBufferFusion
 from .schedule_rule import PyScheduleRule, ScheduleRule
@@ -153,7 +153,11 @@ class MultiLevelTilingTensorCore(ScheduleRule):
         "load_b", "compute", "store", which represent the tensor intrin for initialization,
         loading operand A, loading operand B, tensor core computation, storing the result.
         The value of the map should be names of tensor intrinsics, must be registerd via
-        TensorIntrin.register(...) beforehand
+        TensorIntrin.register(...) beforehand. The optional key "mapping" is the intrinsic used to
+        map the workload to "compute" when the description of "compute" accesses its operands
+        through a thread layout, see `tvm.tir.tensor_intrin.cuda.get_mma_intrin_group`. With
+        accumulators in the warp scope, the results are stored by the threads holding them, with
+        the epilogues computed in registers, and "store" is not used.
     structure : str
         The tiling structure. Recommended:
         - 'SSSRRSRS' on GPU
@@ -171,6 +175,10 @@ class MultiLevelTilingTensorCore(ScheduleRule):
         Data reuse configuration for writing. None means no reuse.
     use_software_pipeline : bool
         Whether to use the software pipeline.
+    raster_group_sizes : Optional[List[int]]
+        The candidate numbers of rows of tiles that the thread blocks are launched in groups of,
+        so that the blocks running at the same time share their inputs in the L2 cache.
+        None means the thread blocks are launched in row-major order.
     """
 
     def __init__(
@@ -183,6 +191,7 @@ class MultiLevelTilingTensorCore(ScheduleRule):
         reuse_read: Optional[ReuseType] = None,
         reuse_write: Optional[ReuseType] = None,
         use_software_pipeline: bool = False,
+        raster_group_sizes: Optional[List[int]] = None,
     ) -> None:
         self.__init_handle_by_constructor__(
             _ffi_api.ScheduleRuleMultiLevelTilingTensorCore,  # type: ignore # pylint: disable=no-member
@@ -194,6 +203,7 @@ class MultiLevelTilingTensorCore(ScheduleRule):
             reuse_read.as_dict() if reuse_read is not None else None,
             reuse_write.as_dict() if reuse_write is not None else None,
             use_software_pipeline,
+            raster_group_sizes,
         )
 
 
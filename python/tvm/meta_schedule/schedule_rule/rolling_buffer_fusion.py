@@ -0,0 +1,46 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Rule that fuses a producer into its consumer through a rolling buffer"""
+from tvm._ffi import register_object
+
+from .. import _ffi_api
+from .schedule_rule import ScheduleRule
+
+
+@register_object("meta_schedule.RollingBufferFusion")
+class RollingBufferFusion(ScheduleRule):
+    """A rule that fuses a producer into its only consumer, a reduction block such as a
+    convolution, so that the intermediate tensor is not materialized, e.g. in a chain of
+    depthwise and pointwise convolutions on CPU.
+
+    When the windows of the consumer overlap, e.g. the kernel of a convolution is larger than its
+    stride, the producer keeps the (tile - 1) * stride + kernel lines of the windows in a rolling
+    buffer, and computes each line once. The rule keeps the unfused schedule as another candidate.
+    It is recommended to place it after MultiLevelTiling and before ParallelizeVectorizeUnroll and
+    RandomComputeLocation among the rules, e.g.
+
+    .. code-block:: python
+
+        sch_rules = list(ms.schedule_rule.create("llvm"))
+        # Before ParallelizeVectorizeUnroll and RandomComputeLocation
+        sch_rules.insert(-2, ms.schedule_rule.RollingBufferFusion())
+    """
+
+    def __init__(self) -> None:
+        self.__init_handle_by_constructor__(
+            _ffi_api.ScheduleRuleRollingBufferFusion,  # type: ignore # pylint: disable=no-member
+        )
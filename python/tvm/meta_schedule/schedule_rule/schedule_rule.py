@@ -88,7 +88,9 @@ class ScheduleRule(Object):
         Parameters
         ----------
         kind : Literal["llvm", "cuda", "cuda-tensorcore", "hexagon"]
-            The kind of the schedule rules.
+            The kind of the schedule rules. The AMX rules of "x86-amx" are never picked from the
+            target, since the process running the measurements has to request the AMX state
+            first, e.g. with a runner initializer calling `runtime.amx_init`.
 
         Returns
         -------
@@ -100,7 +102,11 @@ class ScheduleRule(Object):
             "llvm": _ffi_api.ScheduleRuleDefaultLLVM,  # type: ignore
             "cuda": _ffi_api.ScheduleRuleDefaultCUDA,  # type: ignore
             "cuda-tensorcore": _ffi_api.ScheduleRuleDefaultCUDATensorCore,  # type: ignore
+            "vulkan-cooperative-matrix": (
+                _ffi_api.ScheduleRuleDefaultVulkanCooperativeMatrix  # type: ignore
+            ),
             "hexagon": _ffi_api.ScheduleRuleDefaultHexagon,  # type: ignore
+            "x86-amx": lambda: _ffi_api.ScheduleRuleDefaultX86("amx"),  # type: ignore
             # pylint: enable=no-member
         }
         for k, v in funcs.items():
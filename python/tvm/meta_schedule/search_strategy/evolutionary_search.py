@@ -15,11 +15,16 @@
 # specific language governing permissions and limitations
 # under the License.
 """Evolutionary Search Strategy"""
+from typing import TYPE_CHECKING, Optional
+
 from tvm._ffi import register_object
 
 from .. import _ffi_api
 from .search_strategy import SearchStrategy
 
+if TYPE_CHECKING:
+    from ..database import Database
+
 
 @register_object("meta_schedule.EvolutionarySearch")
 class EvolutionarySearch(SearchStrategy):
@@ -45,6 +50,13 @@ class EvolutionarySearch(SearchStrategy):
         The maximum number to retry mutation.
     eps_greedy : float
         The ratio of greedy selected samples in the final picks.
+    transfer_database : Optional[Database]
+        The database tuned on another target, e.g. a close CPU model. When the database of this
+        target has fewer than `init_measured_ratio` of the population, its best candidates of the
+        workload are re-applied, validated by the postprocessors, and added to the initial
+        population. With the "anchor-block" module equality, it can also be a database of this
+        target tuned on another subgraph with the same anchor block, whose candidates are then
+        transferred as anchor traces.
     """
 
     population_size: int
@@ -54,6 +66,7 @@ class EvolutionarySearch(SearchStrategy):
     genetic_mutate_prob: float
     genetic_max_fail_count: int
     eps_greedy: float
+    transfer_database: Optional["Database"]
 
     def __init__(
         self,
@@ -66,6 +79,7 @@ class EvolutionarySearch(SearchStrategy):
         genetic_mutate_prob: float = 0.85,
         genetic_max_fail_count: int = 10,
         eps_greedy: float = 0.05,
+        transfer_database: Optional["Database"] = None,
     ) -> None:
         """Constructor"""
         self.__init_handle_by_constructor__(
@@ -78,4 +92,5 @@ class EvolutionarySearch(SearchStrategy):
             genetic_mutate_prob,
             genetic_max_fail_count,
             eps_greedy,
+            transfer_database,
         )
@@ -20,6 +20,7 @@ Meta Schedule task scheduler that manage the task scheduling
 for measure candidates generation and measurement, then save
 records to the database.
 """
+from .convergence_based import ConvergenceBased
 from .gradient_based import GradientBased
 from .round_robin import RoundRobin
 from .task_scheduler import PyTaskScheduler, TaskScheduler, create
@@ -0,0 +1,64 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Convergence Based Task Scheduler"""
+from tvm._ffi import register_object
+
+from .. import _ffi_api
+from ..logging import get_logger, get_logging_func
+from .task_scheduler import TaskScheduler
+
+logger = get_logger(__name__)  # pylint: disable=invalid-name
+
+
+@register_object("meta_schedule.ConvergenceBased")
+class ConvergenceBased(TaskScheduler):
+    """Convergence Based Task Scheduler
+
+    A task is retired once the upper confidence bound of the relative improvement of its best
+    latency per round falls below `tolerance`, and the remaining trials go to the task alive with
+    the highest weighted expected gain.
+    """
+
+    def __init__(
+        self,
+        *,
+        window_size: int = 5,
+        tolerance: float = 0.005,
+        confidence: float = 0.95,
+        seed: int = -1,
+    ) -> None:
+        """Constructor.
+
+        Parameters
+        ----------
+        window_size : int = 5
+            The number of recent rounds the convergence is detected over.
+        tolerance : float = 0.005
+            The relative improvement per round below which a task is considered converged.
+        confidence : float = 0.95
+            The confidence level of the upper bound on the mean improvement.
+        seed : int = -1
+            The random seed.
+        """
+        self.__init_handle_by_constructor__(
+            _ffi_api.TaskSchedulerConvergenceBased,  # type: ignore # pylint: disable=no-member
+            get_logging_func(logger),
+            window_size,
+            tolerance,
+            confidence,
+            seed,
+        )
@@ -32,6 +32,7 @@ from ..contrib import graph_executor
 from ..contrib import utils
 from ..contrib.debugger import debug_executor
 from ..rpc import RPCSession
+from ..runtime import ndarray
 from . import project
 from .transport import IoTimeoutError
 from .transport import TransportLogger
@@ -103,6 +104,26 @@ class Session:
             self.get_system_lib(), self.device, "default"
         )
 
+    def get_memory_stats(self):
+        """Get the statistics of the memory manager of the host CRT runtime.
+
+        Returns
+        -------
+        dict
+            The total, used, peak used and largest free bytes of the memory pool, and the number
+            of allocated blocks.
+        """
+        stats = ndarray.empty((5,), "int64", device=self.device)
+        self._rpc.get_function("tvm.rpc.server.GetMemoryStats")(stats)
+        keys = (
+            "total_bytes",
+            "used_bytes",
+            "peak_used_bytes",
+            "largest_free_bytes",
+            "num_allocations",
+        )
+        return dict(zip(keys, (int(x) for x in stats.numpy())))
+
     def _wrap_transport_read(self, n, timeout_microsec):
         try:
             return self.transport.read(
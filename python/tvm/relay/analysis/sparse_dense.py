@@ -54,7 +54,64 @@ def _search_dense_op_weight(expr):
     return _ffi_api.search_dense_op_weight(expr)
 
 
-def process_params(expr, params, block_size, sparsity_threshold):
+# The cost of a stored block besides its elements, in elements: loading its column index
+# and the bookkeeping of the loop over the blocks of a row.
+_BLOCK_OVERHEAD = 2.0
+
+
+def estimate_bsr_speedup(w_np, block_size):
+    """Estimate the speedup of sparse_dense in BSR format over dense for a weight
+
+    The cost of dense is the number of elements of the weight. The cost of BSR is the number of
+    elements of its non-zero blocks, zeros included, plus a fixed overhead per block.
+
+    Parameters
+    ----------
+    w_np : numpy.ndarray
+        The 2-D dense weight
+    block_size : Tuple(int, int)
+        Blocksize in BSR matrix
+
+    Returns
+    -------
+    ret : float
+        The estimated speedup, or 0 if the shape of the weight is not a multiple of the block
+    """
+    rows, cols = w_np.shape
+    bs_r, bs_c = block_size
+    if rows % bs_r != 0 or cols % bs_c != 0:
+        return 0.0
+    blocks = w_np.reshape(rows // bs_r, bs_r, cols // bs_c, bs_c)
+    num_blocks = np.count_nonzero(np.any(blocks != 0, axis=(1, 3)))
+    sparse_cost = num_blocks * (bs_r * bs_c + _BLOCK_OVERHEAD) + rows // bs_r
+    return w_np.size / max(sparse_cost, 1.0)
+
+
+def select_block_size(w_np, block_sizes):
+    """Select the block size with the best estimated speedup for a weight
+
+    Parameters
+    ----------
+    w_np : numpy.ndarray
+        The 2-D dense weight
+    block_sizes : List[Tuple(int, int)]
+        The candidate blocksizes, ``(1, 1)`` is the CSR format
+
+    Returns
+    -------
+    ret : Tuple[Tuple(int, int), float]
+        The selected blocksize and its estimated speedup, ``(None, 0)`` if no candidate divides
+        the shape of the weight
+    """
+    best, best_speedup = None, 0.0
+    for block_size in block_sizes:
+        speedup = estimate_bsr_speedup(w_np, block_size)
+        if speedup > best_speedup:
+            best, best_speedup = tuple(block_size), speedup
+    return best, best_speedup
+
+
+def process_params(expr, params, block_size, sparsity_threshold, min_speedup=None):
     """[summary]
 
     Parameters
@@ -63,10 +120,14 @@ def process_params(expr, params, block_size, sparsity_threshold):
         Expr of the network
     params : Dict[String, tvm.nd.array]
         parameters of the network
-    block_size : Tuple(int, int)
-        Blocksize in BSR matrix
+    block_size : Union[Tuple(int, int), List[Tuple(int, int)]]
+        Blocksize in BSR matrix. If a list of blocksizes is given, the one with the best
+        estimated speedup is selected for each weight, see ``select_block_size``.
     sparsity_threshold : float
         Minimal sparsity requirement for converting to sparse operation
+    min_speedup : Optional[float]
+        Minimal estimated speedup requirement for converting to sparse operation. By default,
+        it is 1 when a list of blocksizes is given, and not checked otherwise.
 
     Returns
     -------
@@ -79,6 +140,9 @@ def process_params(expr, params, block_size, sparsity_threshold):
         register_task_input_buffer,
     )  # lazily import to avoid recursive dependency
 
+    block_sizes = [block_size] if isinstance(block_size[0], int) else list(block_size)
+    if min_speedup is None and len(block_sizes) > 1:
+        min_speedup = 1.0
     memo = SparseAnalysisResult(weight_name=[], weight_shape=[])
     weight_names = _search_dense_op_weight(expr)
     for name in weight_names:
@@ -86,6 +150,9 @@ def process_params(expr, params, block_size, sparsity_threshold):
         w_np = params[name].numpy()
         sparsity = 1.0 - (np.count_nonzero(w_np) / w_np.size)
         if sparsity >= sparsity_threshold:
+            block_size, speedup = select_block_size(w_np, block_sizes)
+            if block_size is None or (min_speedup is not None and speedup < min_speedup):
+                continue
             sparse_weight = sp.bsr_matrix(w_np, blocksize=block_size)
             # remove dense weight
             del params[name]
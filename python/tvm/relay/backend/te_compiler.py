@@ -414,6 +414,27 @@ def get():
     return _backend._TECompilerGlobal()
 
 
+def incremental_build_stats():
+    """Get the number of primitive functions lowered and reused by the last build
+    with the `relay.backend.incremental_build` pass config.
+
+    Returns
+    -------
+    stats : Dict[str, int]
+        The "lowered" and "reused" counts.
+    """
+    return {k: int(v) for k, v in _backend._IncrementalBuildStats().items()}
+
+
+def clear_incremental_build_cache():
+    """Drop the primitive functions kept for the next incremental build.
+
+    A change of the pass config or of the meta schedule database invalidates them on its own,
+    but the AutoTVM records do not, so call this after changing them.
+    """
+    _backend._IncrementalBuildClear()
+
+
 def lower_to_primfunc(relay_func, target):
     """Lower Relay Function to TIR PrimFunc.
 
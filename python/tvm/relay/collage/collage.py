@@ -27,6 +27,7 @@ import numpy as np
 
 import tvm
 from tvm._ffi.registry import register_func, register_object
+from tvm.contrib.popen_pool import PopenPoolExecutor
 from tvm.runtime import Object
 from . import _ffi_api
 
@@ -86,12 +87,9 @@ def vm_estimate_seconds(device, the_vm, func_name, args):
     )
 
 
-@register_func("tvm.relay.collage.estimate_seconds")
-def estimate_seconds(mod, target):
-    """Returns the mean execution time of "main" in mod on target with params. The module
-    may contain "Primitive" functions, possibly with "Compiler" attributes."""
-    device = tvm.device(target.get_target_device_type())
-
+def build_for_estimate(mod, target):
+    """Compiles mod for target and exports its library to a fresh temporary directory. Returns
+    the VM bytecode and the path of the library, or None if the module is unable to build."""
     try:
         # Build the module.
         logging.info("Compiling module to estimate")
@@ -101,7 +99,7 @@ def estimate_seconds(mod, target):
         # eg trying to build an nn.batch_norm on GPU, which has no schedule since we assume it
         # is only ever used with a tuple projection which is rewritten away.
         logging.info("Assigning module infinite cost since unable to build: %s", err)
-        return math.inf
+        return None
 
     # Finalize compilation
     tmp_dir = tempfile.mkdtemp()
@@ -109,6 +107,13 @@ def estimate_seconds(mod, target):
     lib_path = os.path.join(tmp_dir, "library.so")
     # TODO(mbs): Avoid nvcc dependency?
     lib.export_library(lib_path, workspace_dir=tmp_dir, cc="nvcc")
+    return code, lib_path
+
+
+def benchmark_for_estimate(mod, target, code, lib_path):
+    """Returns the mean execution time of "main" in mod on target, given the VM bytecode and
+    library built by build_for_estimate."""
+    device = tvm.device(target.get_target_device_type())
     lib = tvm.runtime.load_module(lib_path)
     exe = tvm.runtime.vm.Executable.load_exec(code, lib)
 
@@ -122,6 +127,67 @@ def estimate_seconds(mod, target):
     return profile.median  # seconds
 
 
+@register_func("tvm.relay.collage.estimate_seconds")
+def estimate_seconds(mod, target):
+    """Returns the mean execution time of "main" in mod on target with params. The module
+    may contain "Primitive" functions, possibly with "Compiler" attributes."""
+    built = build_for_estimate(mod, target)
+    if built is None:
+        return math.inf
+    return benchmark_for_estimate(mod, target, *built)
+
+
+def _build_for_estimate_worker(mod_json, target_json, opt_level, config_json):
+    """Runs build_for_estimate in a pool worker, under the pass context of the caller."""
+    mod = tvm.ir.load_json(mod_json)
+    target = tvm.ir.load_json(target_json)
+    config = dict(tvm.ir.load_json(config_json).items())
+    with tvm.transform.PassContext(opt_level=opt_level, config=config):
+        return build_for_estimate(mod, target)
+
+
+@register_func("tvm.relay.collage.estimate_seconds_batch")
+def estimate_seconds_batch(mods, targets):
+    """Returns the mean execution times of "main" in each of mods on the corresponding target.
+
+    The modules are compiled in parallel on a pool of "relay.collage.num_estimate_workers"
+    workers, and then measured one at a time so that the measurements do not interfere with each
+    other. The workers are fresh interpreters, in which only the BYOC codegens registered by
+    libtvm exist, not those registered by importing a Python module, e.g.
+    tvm.contrib.cutlass.build. Hence the modules are compiled serially in this process unless more
+    than one worker is configured."""
+    pass_ctx = tvm.transform.PassContext.current()
+    num_workers = int(pass_ctx.config.get("relay.collage.num_estimate_workers", 1))
+    if num_workers <= 1 or len(mods) <= 1:
+        return [
+            tvm.tir.FloatImm("float64", estimate_seconds(mod, target))
+            for mod, target in zip(mods, targets)
+        ]
+
+    config_json = tvm.ir.save_json(pass_ctx.config)
+    pool = PopenPoolExecutor(max_workers=num_workers)
+    futures = [
+        pool.submit(
+            _build_for_estimate_worker,
+            tvm.ir.save_json(mod),
+            tvm.ir.save_json(target),
+            pass_ctx.opt_level,
+            config_json,
+        )
+        for mod, target in zip(mods, targets)
+    ]
+    results = []
+    for mod, target, future in zip(mods, targets, futures):
+        try:
+            built = future.result()
+        except Exception as err:  # pylint: disable=broad-except
+            logging.info("Assigning module infinite cost since worker failed to build: %s", err)
+            built = None
+        seconds = math.inf if built is None else benchmark_for_estimate(mod, target, *built)
+        results.append(tvm.tir.FloatImm("float64", seconds))
+    return results
+
+
 def make_labelled_dfpattern_partition_rule_wrapper(compiler, pattern_tuple):
     """Returns a DFPatternPartitionRule representing one (label, pattern, predicate) entry from
     the pattern table for external codegen compiler"""
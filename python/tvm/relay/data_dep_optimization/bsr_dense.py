@@ -23,7 +23,7 @@ from tvm.relay.analysis.sparse_dense import process_params
 from .utils import _run_opt_pass
 
 
-def convert(func, params, blocksize, sparsity_threshold):
+def convert(func, params, blocksize, sparsity_threshold, min_speedup=None):
     """Convert a dense func and according parameters to block sparse
 
     Parameters
@@ -32,12 +32,17 @@ def convert(func, params, blocksize, sparsity_threshold):
         Expr will be optimized to sparse operation
     params : Dict[Srting, tvm.nd.array]
         Parameters of the Expr
-    blocksize : Tuple(int, int)
-        Blocksize for BSR matrix
+    blocksize : Union[Tuple(int, int), List[Tuple(int, int)]]
+        Blocksize for BSR matrix.
+        If a list of blocksizes is given, the one with the best
+        estimated speedup is selected for each weight.
     sparsity_threshold : float
         Minimal sparsity requirement for converting.
         If weight sparsity is lower than this threshold,
         the dense operation will be kept.
+    min_speedup : Optional[float]
+        Minimal estimated speedup requirement for converting.
+        By default, it is 1 when a list of blocksizes is given.
 
     Returns
     -------
@@ -47,7 +52,7 @@ def convert(func, params, blocksize, sparsity_threshold):
     params: Dict[Srting, tvm.nd.array]
         New params with BSR matrix for mutated Expr
     """
-    weight_info = process_params(func, params, blocksize, sparsity_threshold)
+    weight_info = process_params(func, params, blocksize, sparsity_threshold, min_speedup)
     new_func = _run_opt_pass(
         func, relay.transform.DenseToSparse(weight_info.weight_name, weight_info.weight_shape)
     )
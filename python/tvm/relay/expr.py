@@ -757,6 +757,10 @@ class StorageInfo(Node):
     def storage_sizes(self):
         return _ffi_api.StorageInfoStorageSizes(self)
 
+    @property
+    def storage_offsets(self):
+        return _ffi_api.StorageInfoStorageOffsets(self)
+
     @property
     def virtual_devices(self):
         return _ffi_api.StorageInfoVirtualDevices(self)
@@ -15,8 +15,165 @@
 # specific language governing permissions and limitations
 # under the License.
 """Backend compiler related feature registration"""
+import numpy as np
+
+from tvm import tir
+
+from .. import expr as _expr
 from . import op as _reg
 from . import strategy
+from .nn import batch_matmul
+from .reduce import sum as _sum
+from .tensor import einsum
+from .transform import reshape, transpose
 
 # einsum
 _reg.register_strategy("einsum", strategy.einsum_strategy)
+
+
+def _parse_einsum_equation(equation, num_operands):
+    """Return the subscripts of the operands and of the output, or None if the equation has an
+    ellipsis or a label repeated in an operand."""
+    equation = equation.replace(" ", "")
+    if "." in equation:
+        return None
+    if "->" in equation:
+        inputs, output = equation.split("->")
+    else:
+        inputs, output = equation, None
+    inputs = inputs.split(",")
+    if len(inputs) != num_operands:
+        return None
+    if output is None:
+        labels = "".join(inputs)
+        output = "".join(sorted(label for label in set(labels) if labels.count(label) == 1))
+    if any(len(set(subscript)) != len(subscript) for subscript in inputs + [output]):
+        return None
+    return inputs, output
+
+
+class _EinsumContraction:
+    """Decompose an einsum into pairwise contractions, mapped onto batch_matmul."""
+
+    def __init__(self, extents):
+        self.extents = extents
+
+    def size(self, labels):
+        return int(np.prod([self.extents[label] for label in labels], dtype="int64"))
+
+    def shape(self, labels):
+        return [self.extents[label] for label in labels]
+
+    def reduce(self, expr, labels, keep):
+        """Sum the labels which are not kept."""
+        axes = [i for i, label in enumerate(labels) if label not in keep]
+        if not axes:
+            return expr, labels
+        return _sum(expr, axis=axes), "".join(label for label in labels if label in keep)
+
+    def permute(self, expr, labels, order):
+        if labels == order:
+            return expr
+        return transpose(expr, [labels.index(label) for label in order])
+
+    def matrix(self, expr, labels, batch, rows, cols):
+        """Reshape the operand to (batch, rows, cols), or to (batch, cols, rows) with the returned
+        flag set if that is its layout, so that it is only transposed if needed."""
+        transposed = labels == batch + cols + rows and labels != batch + rows + cols
+        order = batch + cols + rows if transposed else batch + rows + cols
+        expr = self.permute(expr, labels, order)
+        first, second = (cols, rows) if transposed else (rows, cols)
+        shape = [self.size(batch), self.size(first), self.size(second)]
+        if self.shape(order) != shape:
+            expr = reshape(expr, shape)
+        return expr, transposed
+
+    @staticmethod
+    def split(lhs_labels, rhs_labels, keep):
+        """Return the batch, reduced, lhs and rhs row labels of a contraction."""
+        batch = "".join(label for label in lhs_labels if label in rhs_labels and label in keep)
+        reduced = "".join(
+            label for label in lhs_labels if label in rhs_labels and label not in keep
+        )
+        lhs_rows = "".join(label for label in lhs_labels if label not in rhs_labels)
+        rhs_rows = "".join(label for label in rhs_labels if label not in lhs_labels)
+        return batch, reduced, lhs_rows, rhs_rows
+
+    def contract(self, lhs, rhs, keep):
+        """Contract two operands, keeping the labels in keep."""
+        (lhs, lhs_labels), (rhs, rhs_labels) = lhs, rhs
+        lhs, lhs_labels = self.reduce(lhs, lhs_labels, keep + rhs_labels)
+        rhs, rhs_labels = self.reduce(rhs, rhs_labels, keep + lhs_labels)
+        batch, reduced, lhs_rows, rhs_rows = self.split(lhs_labels, rhs_labels, keep)
+        result = batch + lhs_rows + rhs_rows
+        if not reduced and (not lhs_rows or not rhs_rows):
+            # A broadcast multiply, which is not worth a batch_matmul
+            return einsum([lhs, rhs], "{},{}->{}".format(lhs_labels, rhs_labels, result)), result
+        lhs, transpose_a = self.matrix(lhs, lhs_labels, batch, lhs_rows, reduced)
+        rhs, transpose_b = self.matrix(rhs, rhs_labels, batch, rhs_rows, reduced)
+        out = batch_matmul(lhs, rhs, transpose_a=transpose_a, transpose_b=not transpose_b)
+        if len(result) != 3 or self.shape(result) != [
+            self.size(batch),
+            self.size(lhs_rows),
+            self.size(rhs_rows),
+        ]:
+            out = reshape(out, self.shape(result))
+        return out, result
+
+    def run(self, operands, output):
+        """Contract the operands greedily. The pair of operands which share a label and whose
+        result is the smallest compared to them is contracted first, as in opt_einsum."""
+        operands = list(operands)
+        while len(operands) > 1:
+            best = None
+            for i in range(len(operands)):
+                for j in range(i + 1, len(operands)):
+                    lhs, rhs = operands[i][1], operands[j][1]
+                    keep = output + "".join(
+                        labels for k, (_, labels) in enumerate(operands) if k not in (i, j)
+                    )
+                    result = set(label for label in lhs + rhs if label in keep)
+                    cost = self.size(result) - self.size(lhs) - self.size(rhs)
+                    key = (not set(lhs) & set(rhs), cost, i, j)
+                    if best is None or key < best[0]:
+                        best = (key, i, j, keep)
+            _, i, j, keep = best
+            contracted = self.contract(operands[i], operands[j], keep)
+            operands = [op for k, op in enumerate(operands) if k not in (i, j)] + [contracted]
+        expr, labels = self.reduce(*operands[0], output)
+        return self.permute(expr, labels, output)
+
+
+@_reg.register_legalize("einsum")
+def legalize_einsum(attrs, inputs, types):
+    """Decompose an einsum of several operands into pairwise contractions along a greedy
+    contraction path, mapped onto batch_matmul where possible.
+
+    The einsum is kept if it has a single operand, an ellipsis, a label repeated in an operand,
+    broadcasting or dynamic shapes, or if it is a single broadcast multiply.
+    """
+    operand_types = types[0].fields
+    parsed = _parse_einsum_equation(attrs.equation, len(operand_types))
+    if parsed is None or len(operand_types) < 2:
+        return None
+    subscripts, output = parsed
+    extents = {}
+    for subscript, operand_type in zip(subscripts, operand_types):
+        if len(operand_type.shape) != len(subscript):
+            return None
+        for label, extent in zip(subscript, operand_type.shape):
+            if not isinstance(extent, tir.IntImm):
+                return None
+            if extents.setdefault(label, extent.value) != extent.value:
+                return None
+
+    data = inputs[0]
+    if isinstance(data, _expr.Tuple):
+        operands = list(data.fields)
+    else:
+        operands = [_expr.TupleGetItem(data, i) for i in range(len(operand_types))]
+    if len(operands) == 2:
+        _, reduced, lhs_rows, rhs_rows = _EinsumContraction.split(*subscripts, output)
+        if not reduced and (not lhs_rows or not rhs_rows):
+            return None
+    return _EinsumContraction(extents).run(zip(operands, subscripts), output)
@@ -16,6 +16,8 @@
 # under the License.
 # pylint: disable=invalid-name, unused-argument
 """Arm(R) CMSIS-NN supported operators for Cortex-M."""
+import numpy as np
+
 import tvm.ir
 from tvm.target import Target
 from tvm.relay import transform
@@ -330,13 +332,23 @@ def pattern_table():
             is_constant(),
             is_constant(),
         )
+        # A requantize of the output is folded into the output quantization of the kernel.
+        pattern = pattern.optional(
+            lambda x: is_op("qnn.requantize")(
+                x, is_constant(), is_constant(), is_constant(), is_constant()
+            )
+        )
         return pattern.optional(is_op("clip"))
 
     def check_qnn_binary_op(pattern):
         """Check if binary op is supported by CMSIS-NN."""
         binary_op = pattern
-        if str(pattern.op.name) == "clip":
-            binary_op = pattern.args[0]
+        if str(binary_op.op.name) == "clip":
+            binary_op = binary_op.args[0]
+        requantize = None
+        if str(binary_op.op.name) == "qnn.requantize":
+            requantize = binary_op
+            binary_op = requantize.args[0]
 
         arg0 = binary_op.args[0]
         arg1 = binary_op.args[1]
@@ -361,12 +373,44 @@ def pattern_table():
         if arg0_type != arg1_type:
             return False
 
+        output_scale = binary_op.args[6]
+        output_zero_point = binary_op.args[7]
+        if requantize is not None:
+            # The requantize must read the output quantization of the binary op, be per tensor
+            # and keep the data type.
+            if (
+                requantize.checked_type.dtype != arg0_type
+                or not tvm.ir.structural_equal(requantize.args[1], output_scale)
+                or not tvm.ir.structural_equal(requantize.args[2], output_zero_point)
+                or len(requantize.args[3].checked_type.shape) != 0
+                or len(requantize.args[4].checked_type.shape) != 0
+            ):
+                return False
+            # The saturation of the binary op output is only dropped if the requantized range
+            # is within it.
+            dtype_info = np.iinfo(arg0_type)
+
+            def real_range(scale, zero_point):
+                scale = float(scale.data.numpy())
+                zero_point = int(zero_point.data.numpy())
+                return (
+                    (dtype_info.min - zero_point) * scale,
+                    (dtype_info.max - zero_point) * scale,
+                )
+
+            binary_min, binary_max = real_range(output_scale, output_zero_point)
+            output_scale = requantize.args[3]
+            output_zero_point = requantize.args[4]
+            requantize_min, requantize_max = real_range(output_scale, output_zero_point)
+            if requantize_min < binary_min or requantize_max > binary_max:
+                return False
+
         # Check zero points are non-zero (arm_elementwise_(add|mul)_s16 does not
         # handle non-zero zero points).
         if arg0_type == "int16" and str(binary_op.op.name) in ["qnn.add", "qnn.mul"]:
             arg_0_zero_point = binary_op.args[3].data.numpy()
             arg_1_zero_point = binary_op.args[5].data.numpy()
-            output_zero_point = binary_op.args[7].data.numpy()
+            output_zero_point = output_zero_point.data.numpy()
             if any([arg_0_zero_point, arg_1_zero_point, output_zero_point]):
                 return False
 
@@ -142,6 +142,10 @@ def legalize_batch_matmul(attrs, inputs, types):
 reg.register_strategy("nn.batch_matmul", strategy.batch_matmul_strategy)
 
 
+# attention
+reg.register_strategy("nn.attention", strategy.attention_strategy)
+
+
 # batch_norm
 reg.register_strategy("nn.batch_norm", strategy.batch_norm_strategy)
 
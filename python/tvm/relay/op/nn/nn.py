@@ -20,6 +20,8 @@ from tvm.relay import expr
 
 from ...expr import Constant, Expr, const
 from ..dyn.nn import _make as _dyn_make
+from ..tensor import shape_of
+from ..transform import take
 from . import _make
 from .utils import get_pad_tuple1d, get_pad_tuple2d, get_pad_tuple3d
 
@@ -2259,6 +2261,50 @@ def batch_matmul(tensor_a, tensor_b, out_dtype="", transpose_a=False, transpose_
     return _make.batch_matmul(tensor_a, tensor_b, out_dtype, transpose_a, transpose_b)
 
 
+def attention(query, key, value, kv_length=None, scale=0.0, causal=False):
+    r"""
+    Scaled dot product attention, computed with an online softmax.
+
+    .. math::
+
+        \mbox{attention}(Q, K, V)[b, h, :, :] =
+            \mbox{softmax}(scale * Q[b, h, :, :] K[b, h, :kv\_length, :]^T) V[b, h, :kv\_length, :]
+
+    The scores are not materialized. Only the first `kv_length` positions of key and value are
+    read, so that they can be a preallocated KV cache which is filled up to `kv_length`.
+
+    Parameters
+    ----------
+    query : tvm.relay.Expr
+        The queries, of shape `(batch, heads, q_len, head_size)`.
+
+    key : tvm.relay.Expr
+        The keys, of shape `(batch, heads, kv_len, head_size)`.
+
+    value : tvm.relay.Expr
+        The values, of shape `(batch, heads, kv_len, value_size)`.
+
+    kv_length : Optional[tvm.relay.Expr]
+        The number of valid positions of key and value, a scalar or one per batch. All the
+        positions are valid by default.
+
+    scale : Optional[float]
+        The scale of the scores. If zero, `1/sqrt(head_size)` is used.
+
+    causal : Optional[bool]
+        Whether the query i, at position `kv_length - q_len + i`, only attends to the keys up to
+        its position.
+
+    Returns
+    -------
+    result: tvm.relay.Expr
+        The computed result, of shape `(batch, heads, q_len, value_size)`.
+    """
+    if kv_length is None:
+        kv_length = take(shape_of(key, "int32"), const(2))
+    return _make.attention(query, key, value, kv_length, scale, causal)
+
+
 # pylint: disable=no-else-return,inconsistent-return-statements
 def sparse_dense(dense_mat, sparse_mat, sparse_lhs=False):
     r"""
@@ -966,6 +966,18 @@ def dense_strategy_cuda(attrs, inputs, out_type, target):
     return strategy
 
 
+@attention_strategy.register(["cuda", "gpu"])
+def attention_strategy_cuda(attrs, inputs, out_type, target):
+    """attention cuda strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_attention(topi.cuda.attention),
+        wrap_topi_schedule(topi.cuda.schedule_extern),
+        name="attention.cuda",
+    )
+    return strategy
+
+
 @batch_matmul_strategy.register(["cuda", "gpu"])
 def batch_matmul_strategy_cuda(attrs, inputs, out_type, target):
     """batch_matmul cuda strategy"""
@@ -946,6 +946,28 @@ def batch_matmul_strategy(attrs, inputs, out_type, target):
     return strategy
 
 
+# attention
+def wrap_compute_attention(topi_compute):
+    """wrap attention topi compute"""
+
+    def _compute_attention(attrs, inputs, out_type):
+        return [topi_compute(*inputs, attrs.scale, attrs.causal)]
+
+    return _compute_attention
+
+
+@override_native_generic_func("attention_strategy")
+def attention_strategy(attrs, inputs, out_type, target):
+    """attention generic strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_attention(topi.nn.attention),
+        wrap_topi_schedule(topi.generic.schedule_extern),
+        name="attention.generic",
+    )
+    return strategy
+
+
 # batch_norm
 def wrap_compute_batch_norm(topi_compute):
     """wrap batch_norm topi compute"""
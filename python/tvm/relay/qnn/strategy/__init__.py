@@ -22,3 +22,4 @@ from __future__ import absolute_import as _abs
 from .generic import *
 from . import arm_cpu
 from . import hexagon
+from . import x86
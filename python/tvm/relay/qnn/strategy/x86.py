@@ -0,0 +1,41 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Quantized operator strategy for x86.
+
+As quantized op schedules, these are only used if the QnnCanonicalize pass is disabled. qnn.dense
+is converted to qnn.contrib_dense_pack by AlterOpLayout if the target has avx512."""
+
+from tvm import topi
+from ... import op as _op
+from .generic import qnn_dense_pack_strategy, wrap_topi_qnn_dense, wrap_topi_schedule
+
+
+@qnn_dense_pack_strategy.register("cpu")
+def qnn_dense_pack_strategy_cpu(attrs, inputs, out_type, target):
+    """qnn.contrib_dense_pack strategy for x86"""
+    strategy = _op.OpStrategy()
+    if (
+        inputs[0].dtype == "uint8"
+        and inputs[1].dtype == "int8"
+        and attrs["weight_layout"] == "NC16n4c"
+    ):
+        strategy.add_implementation(
+            wrap_topi_qnn_dense(topi.x86.qnn_dense_pack_vnni),
+            wrap_topi_schedule(topi.x86.schedule_qnn_dense_pack_vnni),
+            name="qnn_dense_pack_vnni.x86",
+        )
+    return strategy
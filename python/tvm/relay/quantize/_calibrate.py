@@ -30,12 +30,18 @@ from .. import expr as _expr
 from .. import analysis as _analysis
 from .. import build_module as _build_module
 from ...contrib import graph_executor
-from .kl_divergence import _find_scale_by_kl
+from .kl_divergence import _find_scale_by_kl, _find_scale_by_kl_histogram
 
+# The number of histogram bins of the statistics computed on device.
+_NUM_BINS = 8001
 
-def _get_profile_runtime(mod):
+
+def _get_profile_runtime(mod, stat=None, num_bins=_NUM_BINS):
     func = mod["main"]
-    func = _quantize.CreateStatsCollector(func)
+    if stat is None:
+        func = _quantize.CreateStatsCollector(func)
+    else:
+        func = _quantize.CreateStatsReducer(func, stat, num_bins)
 
     if tvm.target.Target.current():
         target = tvm.target.Target.current()
@@ -90,11 +96,76 @@ def collect_stats(mod, dataset, chunk_by=-1):
         yield [np.concatenate(output).reshape(-1) for output in outputs]
 
 
+def reduce_stats(mod, dataset, stat, num_bins=_NUM_BINS, thresholds=None):
+    """Given an annotated graph, create a profile graph which computes a statistic of every
+    simulated_quantize op input on the device, and accumulate it over the calibration dataset.
+    Only the accumulated statistics are copied back to the host, once.
+
+    Parameters
+    ----------
+    mod: Module
+        The simulation graph after annotation.
+
+    dataset: Iterable[NDArray]
+        The calibration dataset.
+
+    stat: str
+        "max" for the maximum of the absolute values, or "histogram" for the histogram with
+        num_bins bins over [-threshold, threshold].
+
+    num_bins: optional, int
+        The number of bins of the histograms.
+
+    thresholds: optional, list of float
+        The range of the histogram of each layer, required by "histogram".
+
+    Returns
+    -------
+    ret: list of ndarray
+        The statistic of each layer.
+    """
+    logging.info("reducing statistics for calibration on device...")
+    runtime = _get_profile_runtime(mod, stat, num_bins)
+    num_outputs = runtime.get_num_outputs()
+
+    for i in range(num_outputs):
+        if stat == "max":
+            runtime.set_input("calib_acc_%d" % i, np.zeros((), "float32"))
+        else:
+            runtime.set_input("calib_threshold_%d" % i, np.array(thresholds[i], "float32"))
+            runtime.set_input("calib_acc_%d" % i, np.zeros((num_bins,), "int64"))
+
+    for batch in dataset:
+        runtime.set_input(**batch)
+        runtime.run()
+        # feed the statistics of this batch to the next one, without leaving the device
+        for i in range(num_outputs):
+            runtime.set_input("calib_acc_%d" % i, runtime.get_output(i))
+
+    return [runtime.get_input("calib_acc_%d" % i).numpy() for i in range(num_outputs)]
+
+
+def _reduce_histograms(mod, dataset):
+    """Compute the histogram of every layer over its maximal absolute value on device."""
+    # an all zero tensor is binned over [-0.5, 0.5], as numpy does
+    thresholds = [float(t) if t > 0 else 0.5 for t in reduce_stats(mod, dataset, "max")]
+    hists = reduce_stats(mod, dataset, "histogram", _NUM_BINS, thresholds)
+    return list(zip(hists, thresholds))
+
+
 def _kl_scale(mod, dataset):
     cfg = quantize.current_qconfig()
     chunk_by = cfg.calibrate_chunk_by
     scales = []
-    for samples in collect_stats(mod, dataset, chunk_by):
+    if cfg.calibrate_on_device:
+        hists = _reduce_histograms(mod, dataset)
+        logging.info("finding threshold with kl for calibration...")
+        with mp.Pool() as pool:
+            scales = list(pool.starmap(_find_scale_by_kl_histogram, hists))
+        chunks = []
+    else:
+        chunks = collect_stats(mod, dataset, chunk_by)
+    for samples in chunks:
         logging.info("finding threshold with kl for calibration...")
         with mp.Pool() as pool:
             scales += list(pool.map(_find_scale_by_kl, samples))
@@ -116,11 +187,31 @@ def _find_scale_by_percentile(arr, percentile=0.99999):
     return np.partition(x, max_k)[max_k]
 
 
+def _find_scale_by_percentile_histogram(hist, thres, percentile=0.99999):
+    """Approximate _find_scale_by_percentile from the histogram of a tensor over [-thres, thres],
+    up to the width of a bin."""
+    edges = np.linspace(-thres, thres, hist.size + 1)
+    # the upper bound of the absolute values in each bin
+    upper = np.maximum(np.abs(edges[:-1]), np.abs(edges[1:]))
+    order = np.argsort(upper, kind="stable")
+    cumsum = np.cumsum(hist[order])
+    max_k = int(cumsum[-1] * percentile)
+    idx = min(int(np.searchsorted(cumsum, max_k, side="right")), hist.size - 1)
+    return upper[order][idx]
+
+
 def _percentile_scale(mod, dataset):
     cfg = quantize.current_qconfig()
     chunk_by = cfg.calibrate_chunk_by
     scales = []
-    for samples in collect_stats(mod, dataset, chunk_by):
+    if cfg.calibrate_on_device:
+        hists = _reduce_histograms(mod, dataset)
+        logging.info("finding threshold with percentile for calibration...")
+        scales = [_find_scale_by_percentile_histogram(hist, thres) for hist, thres in hists]
+        chunks = []
+    else:
+        chunks = collect_stats(mod, dataset, chunk_by)
+    for samples in chunks:
         logging.info("finding threshold with percentile for calibration...")
         with mp.Pool() as pool:
             scales += list(pool.map(_find_scale_by_percentile, samples))
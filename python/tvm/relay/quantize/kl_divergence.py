@@ -39,12 +39,31 @@ def _find_scale_by_kl(arr, quantized_dtype="int8", num_bins=8001, num_quantized_
         # We need to move negative bins to positive bins to fit uint8 range.
         num_quantized_bins = num_quantized_bins * 2 + 1
 
+    hist, hist_edges = np.histogram(arr, bins=num_bins, range=(-thres, thres))
+    return _minimize_kl(hist, hist_edges, num_bins, num_quantized_bins)
+
+
+def _find_scale_by_kl_histogram(hist, thres, num_quantized_bins=255):
+    """Given the histogram of a tensor over [-thres, thres], find the optimal threshold for
+    quantizing it to int8, as _find_scale_by_kl does from the tensor itself."""
+    num_bins = hist.size
+    # The counts accumulated over a dataset may overflow the int32 histogram of the minimization,
+    # the distributions are normalized anyway.
+    limit = np.iinfo(np.int32).max
+    total = int(np.sum(hist, dtype=np.int64))
+    if total > limit:
+        hist = np.floor(hist * (limit / total))
+    hist_edges = np.linspace(-thres, thres, num_bins + 1, dtype=np.float32)
+    return _minimize_kl(hist, hist_edges, num_bins, num_quantized_bins)
+
+
+def _minimize_kl(hist, hist_edges, num_bins, num_quantized_bins):
     def get_pointer(arr, ctypes_type):
         ptr = arr.ctypes.data_as(ctypes.POINTER(ctypes_type))
         return ctypes.cast(ptr, ctypes.c_void_p)
 
-    hist, hist_edges = np.histogram(arr, bins=num_bins, range=(-thres, thres))
-    hist_ptr = get_pointer(hist.astype(np.int32), ctypes.c_int)
+    hist = hist.astype(np.int32)
+    hist_ptr = get_pointer(hist, ctypes.c_int)
     hist_edges_ptr = get_pointer(hist_edges, ctypes.c_float)
 
     return _quantize.FindScaleByKLMinimization(
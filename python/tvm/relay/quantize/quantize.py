@@ -86,6 +86,7 @@ class QConfig(Object):
         "debug_enabled_ops": None,
         "rounding": "UPWARD",
         "calibrate_chunk_by": -1,
+        "calibrate_on_device": False,
         "partition_conversions": "disabled",
     }
 
@@ -150,6 +151,13 @@ def qconfig(**kwargs):
         global_scale: use global scale
         kl_divergence: find scales by kl divergence on the dataset.
 
+    calibrate_on_device: boolean
+        Whether to compute the calibration statistics of 'kl_divergence' and 'percentile' on the
+        device. Instead of copying every intermediate tensor to the host, the maximal absolute
+        values and then the histograms of the tensors are accumulated over the dataset on the
+        device, so the dataset is run twice. 'percentile' is then approximated up to the width of
+        a histogram bin. The default value is False.
+
     global_scale: float
         The global scale for calibration.
 
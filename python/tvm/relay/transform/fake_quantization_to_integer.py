@@ -624,6 +624,33 @@ register_unary_qnn("abs", relay.qnn.op.abs)
 register_unary_qnn("log", relay.qnn.op.log)
 
 
+def register_float_fallback(op_name):
+    """Rewrite an op without an integer implementation
+
+    The op is computed in float between a dequantize of its first argument and a quantize to the
+    output type, as the QNN unary ops are canonicalized, so that the ops around it stay in the
+    integer subgraph.
+    """
+
+    def float_fallback(expr, type_map):
+        arg = expr.args[0]
+        x_t = type_map[arg]
+        out_t = type_map[expr]
+        data = relay.qnn.op.dequantize(arg, x_t.scale, x_t.zero_point, axis=x_t.axis)
+        out = relay.Call(expr.op, [data] + list(expr.args[1:]), expr.attrs)
+        out = relay.qnn.op.quantize(
+            out, out_t.scale, out_t.zero_point, axis=out_t.axis, out_dtype=out_t.dtype
+        )
+        return [out, out_t]
+
+    return register_fake_quantization_to_integer(op_name, float_fallback)
+
+
+register_float_fallback("nn.softmax")
+register_float_fallback("nn.log_softmax")
+register_float_fallback("nn.layer_norm")
+
+
 @register_fake_quantization_to_integer("take")
 def take(expr, type_map):
     """Rewrite a take op"""
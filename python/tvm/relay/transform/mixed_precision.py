@@ -16,8 +16,9 @@
 # under the License.
 # pylint: disable=line-too-long,unused-argument
 """Default behavior for ops in mixed_precision pass. Import this file to use."""
-from typing import List
+from typing import Dict, List, Sequence
 
+import tvm
 from tvm.relay.op import register_mixed_precision_conversion
 
 # MIXED_PRECISION_ALWAYS ops should always be done in lower precision due to the speed and memory
@@ -198,3 +199,70 @@ def generic_follow_op(call_node: "relay.Call", mixed_precision_type: str) -> Lis
 @register_func_to_op_list(list_ops=DEFAULT_NEVER_LIST)
 def generic_never_op(call_node: "relay.Call", mixed_precision_type: str) -> List:
     return [MIXED_PRECISION_NEVER] + get_generic_out_dtypes(call_node, mixed_precision_type)
+
+
+def to_mixed_precision_within_budget(
+    mod: "tvm.IRModule",
+    calibration_inputs: Sequence[Dict[str, "np.ndarray"]],
+    budget: float,
+    mixed_precision_type: str = "float16",
+    target: str = "llvm",
+    flops_per_byte_candidates: Sequence[float] = (8.0, 32.0, 128.0, 512.0),
+) -> "tvm.IRModule":
+    """Convert a module to mixed precision in cost aware mode, keeping its error on calibration
+    data within a budget.
+
+    The conversion is tried with increasing values of relay.ToMixedPrecision.flops_per_byte,
+    each of which converts fewer convolutions and matmuls, until the relative error of every
+    output on every calibration input is at most the budget.
+
+    Parameters
+    ----------
+    mod: tvm.IRModule
+        The FP32 module.
+    calibration_inputs: Sequence[Dict[str, np.ndarray]]
+        The inputs of the module, including its parameters, to measure the error on.
+    budget: float
+        The largest allowed max(abs(amp - fp32)) / max(abs(fp32)) of each output.
+    mixed_precision_type: str
+        The target datatype to transform operations in the graph to use.
+    target: str
+        The target to run the module on.
+    flops_per_byte_candidates: Sequence[float]
+        The values of relay.ToMixedPrecision.flops_per_byte to try, in increasing order.
+
+    Returns
+    -------
+    ret: tvm.IRModule
+        The first mixed precision module within the budget, or the FP32 module if none is.
+    """
+    # pylint: disable=import-outside-toplevel
+    import numpy as np
+    from tvm import relay
+
+    def run(run_mod, inputs):
+        dev = tvm.device(target, 0)
+        result = relay.create_executor("vm", run_mod, device=dev, target=target).evaluate()(
+            **inputs
+        )
+        if isinstance(result, tvm.runtime.container.ADT):
+            return [r.numpy().astype("float32") for r in result]
+        return [result.numpy().astype("float32")]
+
+    mod = relay.transform.InferType()(mod)
+    references = [run(mod, inputs) for inputs in calibration_inputs]
+    for flops_per_byte in flops_per_byte_candidates:
+        config = {
+            "relay.ToMixedPrecision.cost_aware": True,
+            "relay.ToMixedPrecision.flops_per_byte": flops_per_byte,
+        }
+        with tvm.transform.PassContext(config=config):
+            amp_mod = relay.transform.ToMixedPrecision(mixed_precision_type)(mod)
+        error = 0.0
+        for inputs, reference in zip(calibration_inputs, references):
+            for ref, amp in zip(reference, run(amp_mod, inputs)):
+                scale = max(float(np.max(np.abs(ref))), np.finfo("float32").tiny)
+                error = max(error, float(np.max(np.abs(amp - ref))) / scale)
+        if error <= budget:
+            return amp_mod
+    return mod
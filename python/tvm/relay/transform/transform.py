@@ -426,6 +426,37 @@ def CombineParallelBatchMatmul(min_num_branches=3):
     return _ffi_api.CombineParallelBatchMatmul(min_num_branches)
 
 
+def CombineIndependentDense(min_num_ops=3):
+    """Combine dense operators of the same shapes that do not depend on each other into one
+    batch_matmul, even if they do not share their input. For example:
+
+    .. code-block
+
+        data0 (2, 3)        data1 (2, 3)
+            |                   |
+        dense(data0, w0)    dense(data1, w1)
+
+    Would become:
+
+    .. code-block
+
+        batch_matmul(stack(data0, data1), stack(w0, w1)) (2, 2, 4)
+            |
+        split
+
+    Parameters
+    ----------
+    min_num_ops : int
+        The minimum number of dense operators to combine.
+
+    Returns
+    -------
+    ret: tvm.transform.Pass
+        The registered pass that combines independent dense operators.
+    """
+    return _ffi_api.CombineIndependentDense(min_num_ops)
+
+
 def BatchingOps():
     """Batching parallel operators into one for Conv2D, Dense and BatchMatmul.
 
@@ -1194,6 +1225,47 @@ def SimplifyExpr():
     return _ffi_api.SimplifyExpr()
 
 
+def PlanLayoutTransforms():
+    """
+    Choose the layout of each region of element-wise ops between layout_transform ops, among the
+    layouts of the surrounding transforms, to move the fewest bytes through layout_transform ops,
+    then merge consecutive layout_transform ops. This removes the transforms going back and forth
+    that local layout decisions such as AlterOpLayout leave around element-wise ops.
+
+    The pass runs at opt_level 4, or when it is listed in the required passes.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered PlanLayoutTransforms pass.
+    """
+    return _ffi_api.PlanLayoutTransforms()
+
+
+def Rematerialize(memory_budget=0):
+    """
+    Recompute the outputs of injective ops next to their late consumers, instead of keeping them
+    alive in between, until the estimated peak of live bytes fits in the memory budget. A tensor
+    is only recomputed when its inputs are alive at its late consumers anyway, e.g. forward
+    activations read by the backward pass of a gradient. The pass expects the graph normal form.
+
+    The build runs it after the other optimizations when the
+    ``relay.Rematerialize.memory_budget`` config is set.
+
+    Parameters
+    ----------
+    memory_budget : int
+        The bytes of the tensors alive at once to aim for. 0 recomputes every tensor it can
+        across the peak.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered Rematerialize pass.
+    """
+    return _ffi_api.Rematerialize(memory_budget)
+
+
 def PlanDevices(config):
     """
     Uses existing "on_device" and "device_copy" calls to infer the virtual device on which
@@ -1216,6 +1288,30 @@ def PlanDevices(config):
     return _ffi_api.PlanDevices(config)
 
 
+def ShardDense(devices, mode="column"):
+    """
+    Shard the constant weights of nn.dense across the devices of a mesh, so that every device
+    holds only its slice of the weights. By column, every device computes a slice of the output
+    columns, gathered by a concatenate. By row, every device computes a partial sum on a slice
+    of the reduction axis, reduced by adds. The shards are annotated by "on_device", so the pass
+    must run before PlanDevices, which inserts the "device_copy" calls between the devices.
+
+    Parameters
+    ----------
+    devices : List[tvm.target.VirtualDevice]
+        The devices of the mesh, one shard per device.
+
+    mode : str
+        Split the weights by "column" or by "row".
+
+    Returns
+    -------
+    ret : tvm.transforms.Pass
+        The pass.
+    """
+    return _ffi_api.ShardDense(devices, mode)
+
+
 def ManifestLifetimes():
     """
     Manifest the lifetimes of variables after allocations have been manifested, by inserting kill
@@ -1224,6 +1320,15 @@ def ManifestLifetimes():
     return _ffi_api.ManifestLifetimes()
 
 
+def PlanStaticStorage():
+    """
+    Pack the statically sized storages of each function into a single arena with offsets
+    computed from their lifetimes, so that the VM performs one allocation per invocation for
+    them. This pass should be run after ManifestLifetimes.
+    """
+    return _ffi_api.PlanStaticStorage()
+
+
 def FoldExplicitPadding():
     """
     FoldExplicitPadding finds explict padding before an op that can support
@@ -1273,6 +1378,11 @@ def FakeQuantizationToInteger(hard_fail=False, use_qat=False):
 
     Rules for rewriting indivdual ops are in fake_quantization_to_integer.py
 
+    If the ``relay.FakeQuantizationToInteger.cost_check`` option of the PassContext is set, a
+    region is only rewritten if its integer version is estimated to be faster, i.e. if the
+    integer convolutions and matmuls and the saved dequantizes and quantizes outweigh the
+    requantizes it introduces.
+
     Parameters
     ----------
     hard_fail : boolean
@@ -1356,6 +1466,18 @@ def ToMixedPrecision(mixed_precision_type="float16", missing_op_mode=1):
       This parameter is not part of explicit arguments of the transformation, but should
       be passed through tvm.transform.PassContext.
 
+    relay.ToMixedPrecision.cost_aware: boolean
+      If set, convolutions and matmuls are only converted when the compute time they save is
+      estimated to exceed the time of casting their arguments. The saved time is estimated from
+      their flops and their speedup in mixed_precision_type, 2 unless a function registered as
+      "relay.ToMixedPrecision.op_speedup" returns it for a call and a dtype. Passed through
+      tvm.transform.PassContext, as well as:
+
+    relay.ToMixedPrecision.flops_per_byte: float
+      The ratio of peak flops to memory bandwidth of the target, 8 by default, used to compare
+      compute and cast times in cost aware mode. See also
+      mixed_precision.to_mixed_precision_within_budget to check an accuracy budget.
+
     Returns
     -------
     ret : tvm.transform.Pass
@@ -15,11 +15,13 @@
 # specific language governing permissions and limitations
 # under the License.
 """RPC client tools"""
+import hashlib
 import os
 import socket
 import stat
 import struct
 import time
+import zlib
 
 import tvm._ffi
 from tvm._ffi.base import TVMError
@@ -41,6 +43,8 @@ class RPCSession(object):
         self._sess = sess
         self._tbl_index = _ffi_api.SessTableIndex(sess)
         self._remote_funcs = {}
+        # "url:port" of the server when the session is handed out by a tracker
+        self.tracker_device = None
 
     def system_lib(self):
         """Get system-wide library module.
@@ -91,9 +95,17 @@ class RPCSession(object):
         dev._rpc_sess = self
         return dev
 
-    def upload(self, data, target=None):
+    # Uploads smaller than this are sent as is.
+    _CACHED_UPLOAD_MIN_BYTES = 64 * 1024
+
+    def upload(self, data, target=None, compress=True):
         """Upload file to remote runtime temp folder
 
+        Large blobs are addressed by their sha256 digest when the remote
+        supports it: a blob the remote has seen before is restored from its
+        upload cache instead of being sent again, otherwise it is sent
+        compressed with zlib.
+
         Parameters
         ----------
         data : str or bytearray
@@ -101,6 +113,9 @@ class RPCSession(object):
 
         target : str, optional
             The path in remote
+
+        compress : bool, optional
+            Whether to compress large blobs that miss the remote cache.
         """
         if isinstance(data, bytearray):
             if not target:
@@ -111,10 +126,37 @@ class RPCSession(object):
             if not target:
                 target = os.path.basename(data)
 
+        if len(blob) >= self._CACHED_UPLOAD_MIN_BYTES and self._init_cached_upload():
+            digest = hashlib.sha256(blob).hexdigest()
+            if self._remote_funcs["upload_cached"](target, digest):
+                return
+            if compress:
+                payload = bytearray(zlib.compress(blob, 1))
+                if len(payload) < len(blob):
+                    self._remote_funcs["upload_compressed"](target, payload, digest, "zlib")
+                    return
+            self._remote_funcs["upload_compressed"](target, blob, digest, "")
+            return
+
         if "upload" not in self._remote_funcs:
             self._remote_funcs["upload"] = self.get_function("tvm.rpc.server.upload")
         self._remote_funcs["upload"](target, blob)
 
+    def _init_cached_upload(self):
+        """Look up the cached upload functions, return whether the remote has them."""
+        if "upload_cached" not in self._remote_funcs:
+            try:
+                self._remote_funcs["upload_cached"] = self.get_function(
+                    "tvm.rpc.server.upload_cached"
+                )
+                self._remote_funcs["upload_compressed"] = self.get_function(
+                    "tvm.rpc.server.upload_compressed"
+                )
+            except AttributeError:
+                # servers without an upload cache, e.g. the C++ and Android ones.
+                self._remote_funcs["upload_cached"] = None
+        return self._remote_funcs["upload_cached"] is not None
+
     def download(self, path):
         """Download file from remote temp folder.
 
@@ -317,6 +359,32 @@ class TrackerSession(object):
             raise RuntimeError("Invalid return value %s" % str(value))
         return value[1]
 
+    def report_stats(self, device, runs, errors=0, seconds=0.0):
+        """Report the outcome of jobs ran on a device to the tracker.
+
+        The tracker keeps an error rate and a throughput per device and
+        hands out the healthiest free device first.
+
+        Parameters
+        ----------
+        device : str
+            The "url:port" of the device, see RPCSession.tracker_device.
+
+        runs : int
+            The number of jobs ran.
+
+        errors : int, optional
+            The number of jobs that failed because of the device.
+
+        seconds : float, optional
+            The wall time spent on the jobs.
+        """
+        stats = {"runs": runs, "errors": errors, "seconds": seconds}
+        base.sendjson(self._sock, [base.TrackerCode.REPORT_STATS, device, stats])
+        value = base.recvjson(self._sock)
+        if value != base.TrackerCode.SUCCESS:
+            raise RuntimeError("Invalid return value %s" % str(value))
+
     def text_summary(self):
         """Get a text summary of the tracker."""
         data = self.summary()
@@ -364,10 +432,37 @@ class TrackerSession(object):
                     pending,
                 )
         res += separate_line
+
+        health = data.get("device_health", {})
+        if health:
+            res += "\n"
+            res += "Device Health\n"
+            res += "------------------------------------------------------------\n"
+            res += "server-address          runs  errors  error-rate  jobs/sec\n"
+            res += "------------------------------------------------------------\n"
+            for name in sorted(health):
+                item = health[name]
+                throughput = item["throughput"]
+                res += "%21s  %6d  %6d  %10.2f  %8s%s\n" % (
+                    name,
+                    item["runs"],
+                    item["errors"],
+                    item["error_rate"],
+                    "-" if throughput is None else "%.3f" % throughput,
+                    "" if item["healthy"] else "  (unhealthy)",
+                )
+            res += "------------------------------------------------------------\n"
         return res
 
     def request(
-        self, key, priority=1, session_timeout=0, max_retry=5, session_constructor_args=None
+        self,
+        key,
+        priority=1,
+        session_timeout=0,
+        max_retry=5,
+        session_constructor_args=None,
+        enable_shared_memory=False,
+        exclude=None,
     ):
         """Request a new connection from the tracker.
 
@@ -391,24 +486,37 @@ class TrackerSession(object):
             List of additional arguments to passed as the remote session constructor.
             The first element of the list is always a string specifying the name of
             the session constructor, the following args are the positional args to that function.
+
+        enable_shared_memory : bool, optional
+            Move large payloads through shared memory when the server is on the same host.
+
+        exclude : list of str, optional
+            The "url:port" of the devices to avoid, e.g. to re-run a measurement elsewhere.
+            They are still used when no other device with the key is alive.
         """
         last_err = None
+        msg = [base.TrackerCode.REQUEST, key, "", priority]
+        if exclude:
+            msg.append(list(exclude))
         for _ in range(max_retry):
             try:
                 if self._sock is None:
                     self._connect()
-                base.sendjson(self._sock, [base.TrackerCode.REQUEST, key, "", priority])
+                base.sendjson(self._sock, msg)
                 value = base.recvjson(self._sock)
                 if value[0] != base.TrackerCode.SUCCESS:
                     raise RuntimeError("Invalid return value %s" % str(value))
                 url, port, matchkey = value[1]
-                return connect(
+                sess = connect(
                     url,
                     port,
                     matchkey,
                     session_timeout,
                     session_constructor_args=session_constructor_args,
+                    enable_shared_memory=enable_shared_memory,
                 )
+                sess.tracker_device = "%s:%d" % (url, port)
+                return sess
             except socket.error as err:
                 self.close()
                 last_err = err
@@ -461,7 +569,13 @@ class TrackerSession(object):
 
 
 def connect(
-    url, port, key="", session_timeout=0, session_constructor_args=None, enable_logging=False
+    url,
+    port,
+    key="",
+    session_timeout=0,
+    session_constructor_args=None,
+    enable_logging=False,
+    enable_shared_memory=False,
 ):
     """Connect to RPC Server
 
@@ -489,6 +603,11 @@ def connect(
     enable_logging: boolean
         flag to enable/disable logging. Logging is disabled by default.
 
+    enable_shared_memory: boolean
+        Move large payloads, such as tensor copies, through a shared memory region instead
+        of the socket. It takes effect when the server supports it and runs on the same host,
+        the session falls back to the socket otherwise.
+
     Returns
     -------
     sess : RPCSession
@@ -517,6 +636,8 @@ def connect(
     try:
         if session_timeout:
             key += " -timeout=%s" % str(session_timeout)
+        if enable_shared_memory:
+            key += " -shm"
         session_constructor_args = session_constructor_args if session_constructor_args else []
         if not isinstance(session_constructor_args, (list, tuple)):
             raise TypeError("Expect the session constructor to be a list or tuple")
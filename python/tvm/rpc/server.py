@@ -34,6 +34,10 @@ import threading
 import multiprocessing
 import time
 import errno
+import hashlib
+import os
+import tempfile
+import zlib
 import tvm._ffi
 
 from tvm._ffi.base import py_str
@@ -60,6 +64,57 @@ logger.setLevel(logging.INFO)
 logger.propagate = False
 
 
+# Number of uploaded blobs kept in the content-addressed upload cache.
+UPLOAD_CACHE_MAX_ENTRIES = 256
+
+
+def _upload_cache_dir():
+    """Directory of the content-addressed upload cache.
+
+    The cache outlives a session so that repeated uploads of the same
+    library or parameters from later sessions become a digest lookup.
+    """
+    path = os.environ.get("TVM_RPC_UPLOAD_CACHE")
+    if not path:
+        path = os.path.join(tempfile.gettempdir(), "tvm-rpc-upload-cache-%d" % os.getuid())
+    os.makedirs(path, mode=0o700, exist_ok=True)
+    return path
+
+
+def _upload_cache_lookup(digest):
+    """Return the cached blob with the given sha256 digest, or None."""
+    if len(digest) != 64 or not all(c in "0123456789abcdef" for c in digest):
+        raise ValueError("invalid upload digest %s" % digest)
+    path = os.path.join(_upload_cache_dir(), digest)
+    if not os.path.isfile(path):
+        return None
+    with open(path, "rb") as f:
+        data = f.read()
+    # The cache directory may be shared, never trust its content.
+    if hashlib.sha256(data).hexdigest() != digest:
+        os.remove(path)
+        return None
+    os.utime(path)
+    return data
+
+
+def _upload_cache_insert(digest, data):
+    """Insert a blob into the upload cache and evict the least recently used ones."""
+    cache_dir = _upload_cache_dir()
+    tmp_path = os.path.join(cache_dir, "%s.%d.tmp" % (digest, os.getpid()))
+    with open(tmp_path, "wb") as f:
+        f.write(data)
+    os.replace(tmp_path, os.path.join(cache_dir, digest))
+    entries = [os.path.join(cache_dir, x) for x in os.listdir(cache_dir) if len(x) == 64]
+    if len(entries) > UPLOAD_CACHE_MAX_ENTRIES:
+        entries.sort(key=os.path.getmtime)
+        for path in entries[: len(entries) - UPLOAD_CACHE_MAX_ENTRIES]:
+            try:
+                os.remove(path)
+            except OSError:
+                pass
+
+
 def _server_env(load_library, work_path=None):
     """Server environment function return temp dir"""
     if work_path:
@@ -80,6 +135,32 @@ def _server_env(load_library, work_path=None):
         logger.info("load_module %s", path)
         return m
 
+    @tvm._ffi.register_func("tvm.rpc.server.upload_cached", override=True)
+    def upload_cached(file_name, digest):
+        """Save a previously uploaded blob by its sha256 digest, return whether it was found."""
+        data = _upload_cache_lookup(digest)
+        if data is None:
+            return False
+        with open(temp.relpath(file_name), "wb") as f:
+            f.write(data)
+        logger.info("upload %s from cache nbytes=%d", file_name, len(data))
+        return True
+
+    @tvm._ffi.register_func("tvm.rpc.server.upload_compressed", override=True)
+    def upload_compressed(file_name, blob, digest, codec):
+        """Save an uploaded blob encoded with codec and add it to the upload cache."""
+        if codec == "zlib":
+            data = zlib.decompress(blob)
+        elif codec == "":
+            data = bytes(blob)
+        else:
+            raise ValueError("unsupported upload codec %s" % codec)
+        if hashlib.sha256(data).hexdigest() != digest:
+            raise RuntimeError("digest mismatch while uploading %s" % file_name)
+        with open(temp.relpath(file_name), "wb") as f:
+            f.write(data)
+        _upload_cache_insert(digest, data)
+
     @tvm._ffi.register_func("tvm.rpc.server.download_linked_module", override=True)
     def download_linked_module(file_name):
         """Load module from remote side."""
@@ -118,11 +199,11 @@ def _server_env(load_library, work_path=None):
     return temp
 
 
-def _serve_loop(sock, addr, load_library, work_path=None):
+def _serve_loop(sock, addr, load_library, work_path=None, shared_memory=False):
     """Server loop"""
     sockfd = sock.fileno()
     temp = _server_env(load_library, work_path)
-    _ffi_api.ServerLoop(sockfd)
+    _ffi_api.ServerLoop(sockfd, shared_memory)
     if not work_path:
         temp.remove()
     logger.info("Finish serving %s", addr)
@@ -134,6 +215,8 @@ def _parse_server_opt(opts):
     for kv in opts:
         if kv.startswith("-timeout="):
             ret["timeout"] = float(kv[9:])
+        elif kv == "-shm" and os.name == "posix":
+            ret["shared_memory"] = True
     return ret
 
 
@@ -204,10 +287,14 @@ def _listen_loop(sock, port, rpc_key, tracker_addr, load_library, custom_addr):
                 conn.close()
                 logger.warning("mismatch key from %s", addr)
                 continue
+            opts = _parse_server_opt(arr[1:])
+            # confirm the shared memory transport to the client.
+            if opts.get("shared_memory", False):
+                server_key += " -shm"
             conn.sendall(struct.pack("<i", base.RPC_CODE_SUCCESS))
             conn.sendall(struct.pack("<i", len(server_key)))
             conn.sendall(server_key.encode("utf-8"))
-            return conn, addr, _parse_server_opt(arr[1:])
+            return conn, addr, opts
 
     # Server logic
     tracker_conn = None
@@ -240,7 +327,8 @@ def _listen_loop(sock, port, rpc_key, tracker_addr, load_library, custom_addr):
         work_path = utils.tempdir()
         logger.info("connection from %s", addr)
         server_proc = multiprocessing.Process(
-            target=_serve_loop, args=(conn, addr, load_library, work_path)
+            target=_serve_loop,
+            args=(conn, addr, load_library, work_path, opts.get("shared_memory", False)),
         )
 
         server_proc.start()
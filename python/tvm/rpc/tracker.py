@@ -36,8 +36,14 @@ List of available APIs:
   - return: TrackerCode.SUCCESS
   - note: match-key is a randomly generated identify the resource during connection.
 - REQUEST: request a new resource from tracker
-  - input: [TrackerCode.REQUEST, [key, user, priority]]
+  - input: [TrackerCode.REQUEST, [key, user, priority, (optional) excluded-devices]]
   - return: [TrackerCode.SUCCESS, [url, port, match-key]]
+  - note: excluded-devices is a list of "url:port" the request prefers not to run on.
+- REPORT_STATS: report the outcome of the jobs ran on a resource
+  - input: [TrackerCode.REPORT_STATS, device, {"runs": int, "errors": int, "seconds": float}]
+  - return: TrackerCode.SUCCESS
+  - note: device is the "url:port" of the resource, the tracker uses the statistics
+    to hand out the healthiest free resource first.
 """
 # pylint: disable=invalid-name
 
@@ -90,7 +96,7 @@ class Scheduler(object):
         """
         raise NotImplementedError()
 
-    def request(self, user, priority, callback):
+    def request(self, user, priority, callback, exclude=()):
         """Request a resource.
 
         Parameters
@@ -104,6 +110,10 @@ class Scheduler(object):
         callback : function: value->bool
             Callback function to receive an resource when ready
             returns True if the resource is consumed.
+
+        exclude : tuple of str
+            Names of the devices the request should not run on
+            unless no other device is alive.
         """
         raise NotImplementedError()
 
@@ -121,20 +131,134 @@ class Scheduler(object):
         raise NotImplementedError()
 
 
+def device_name(value):
+    """Get the "url:port" name of a resource value put in the scheduler."""
+    return "%s:%d" % (value[1], value[2])
+
+
+class DeviceHealth(object):
+    """Health statistics of a single device reported by the clients.
+
+    Parameters
+    ----------
+    decay : float
+        The weight of the history in the exponential moving averages.
+    """
+
+    # Minimum number of runs before the error rate is trusted.
+    MIN_RUNS = 4
+    # Error rate above which a device is only used when nothing else is alive.
+    MAX_ERROR_RATE = 0.5
+
+    def __init__(self, decay=0.8):
+        self.decay = decay
+        self.runs = 0
+        self.errors = 0
+        self.error_rate = 0.0
+        self.throughput = None
+
+    def update(self, stats):
+        """Fold a stats report of the form {"runs", "errors", "seconds"} in."""
+        runs = int(stats.get("runs", 0))
+        errors = int(stats.get("errors", 0))
+        seconds = float(stats.get("seconds", 0.0))
+        if runs <= 0:
+            return
+        self.runs += runs
+        self.errors += errors
+        weight = self.decay**runs
+        self.error_rate = weight * self.error_rate + (1 - weight) * min(errors / runs, 1.0)
+        if seconds > 0 and runs > errors:
+            rate = (runs - errors) / seconds
+            if self.throughput is None:
+                self.throughput = rate
+            else:
+                self.throughput = weight * self.throughput + (1 - weight) * rate
+
+    def healthy(self):
+        """Whether the device is trusted to run new jobs."""
+        return self.runs < self.MIN_RUNS or self.error_rate <= self.MAX_ERROR_RATE
+
+    def score(self):
+        """Expected number of successful jobs per second, None when not known yet."""
+        if self.throughput is None:
+            return None
+        return self.throughput * (1.0 - self.error_rate)
+
+    def summary(self):
+        """Get summary information of the device."""
+        return {
+            "runs": self.runs,
+            "errors": self.errors,
+            "error_rate": self.error_rate,
+            "throughput": self.throughput,
+            "healthy": self.healthy(),
+        }
+
+
 class PriorityScheduler(Scheduler):
-    """Priority based scheduler, FIFO based on request order"""
+    """Priority based scheduler, FIFO based on request order.
+
+    Among the free resources, the one with the best reported health is handed out
+    first. Devices that are not known yet are preferred so that they get measured.
+
+    Parameters
+    ----------
+    key : str
+        The key of the resources.
+
+    health : Optional[dict of str to DeviceHealth]
+        The health table shared by the schedulers, keyed by device name.
+    """
 
-    def __init__(self, key):
+    def __init__(self, key, health=None):
         self._key = key
         self._request_cnt = 0
         self._lock = threading.Lock()
         self._values = []
         self._requests = []
+        self._health = health if health is not None else {}
+        # device name -> number of live values put for it, free or in use.
+        self._alive = {}
+
+    def _rank(self, value):
+        health = self._health.get(device_name(value))
+        score = health.score() if health is not None else None
+        return float("inf") if score is None else score
+
+    def _pick(self, exclude):
+        """Pick the index of the value to hand out, None if the request must wait."""
+        alive = set(self._alive)
+
+        def _usable(names):
+            # skip unhealthy devices as long as a healthy one is alive
+            healthy = set(
+                n for n in names if n not in self._health or self._health[n].healthy()
+            )
+            return healthy if healthy else names
+
+        for names in (alive - set(exclude), alive):
+            usable = _usable(names)
+            if not usable:
+                continue
+            candidates = [i for i, v in enumerate(self._values) if device_name(v) in usable]
+            if not candidates:
+                # the preferred devices are busy, wait for them instead of falling back
+                return None
+            return max(candidates, key=lambda i: (self._rank(self._values[i]), -i))
+        return None
 
     def _schedule(self):
         while self._requests and self._values:
-            value = self._values.pop(0)
-            item = heapq.heappop(self._requests)
+            for item in sorted(self._requests):
+                index = self._pick(item[-2])
+                if index is not None:
+                    break
+            else:
+                return
+            self._requests.remove(item)
+            heapq.heapify(self._requests)
+            value = self._values.pop(index)
             callback = item[-1]
             if callback(value[1:]):
                 value[0].pending_matchkeys.remove(value[-1])
@@ -143,18 +267,27 @@ class PriorityScheduler(Scheduler):
 
     def put(self, value):
         self._values.append(value)
+        name = device_name(value)
+        self._alive[name] = self._alive.get(name, 0) + 1
         self._schedule()
 
-    def request(self, user, priority, callback):
+    def request(self, user, priority, callback, exclude=()):
         with self._lock:
-            heapq.heappush(self._requests, (-priority, self._request_cnt, callback))
+            heapq.heappush(
+                self._requests, (-priority, self._request_cnt, tuple(exclude), callback)
+            )
             self._request_cnt += 1
         self._schedule()
 
     def remove(self, value):
+        name = device_name(value)
+        if name in self._alive:
+            self._alive[name] -= 1
+            if self._alive[name] <= 0:
+                del self._alive[name]
         if value in self._values:
             self._values.remove(value)
-            self._schedule()
+        self._schedule()
 
     def summary(self):
         """Get summary information of the scheduler."""
@@ -257,6 +390,7 @@ class TCPEventHandler(tornado_util.TCPHandler):
             key = args[1]
             user = args[2]
             priority = args[3]
+            exclude = args[4] if len(args) >= 5 and args[4] else ()
 
             def _cb(value):
                 # if the connection is already closed
@@ -268,7 +402,7 @@ class TCPEventHandler(tornado_util.TCPHandler):
                     return False
                 return True
 
-            self._tracker.request(key, user, priority, _cb)
+            self._tracker.request(key, user, priority, _cb, exclude)
         elif code == TrackerCode.PING:
             self.ret_value(TrackerCode.SUCCESS)
         elif code == TrackerCode.GET_PENDING_MATCHKEYS:
@@ -290,6 +424,11 @@ class TCPEventHandler(tornado_util.TCPHandler):
         elif code == TrackerCode.SUMMARY:
             status = self._tracker.summary()
             self.ret_value([TrackerCode.SUCCESS, status])
+        elif code == TrackerCode.REPORT_STATS:
+            stats = args[2]
+            assert isinstance(stats, dict)
+            self._tracker.report_stats(args[1], stats)
+            self.ret_value(TrackerCode.SUCCESS)
         else:
             logger.warning("Unknown tracker code %d", code)
             self.close()
@@ -312,6 +451,7 @@ class TrackerServerHandler(object):
         self._ioloop = ioloop.IOLoop.current()
         self._stop_key = stop_key
         self._connections = set()
+        self._device_health = {}
 
         def _event_handler(_, events):
             self._on_event(events)
@@ -329,7 +469,7 @@ class TrackerServerHandler(object):
 
     def create_scheduler(self, key):
         """Create a new scheduler."""
-        return PriorityScheduler(key)
+        return PriorityScheduler(key, self._device_health)
 
     def put(self, key, value):
         """Report a new resource to the tracker."""
@@ -337,11 +477,20 @@ class TrackerServerHandler(object):
             self._scheduler_map[key] = self.create_scheduler(key)
         self._scheduler_map[key].put(value)
 
-    def request(self, key, user, priority, callback):
+    def request(self, key, user, priority, callback, exclude=()):
         """Request a new resource."""
         if key not in self._scheduler_map:
             self._scheduler_map[key] = self.create_scheduler(key)
-        self._scheduler_map[key].request(user, priority, callback)
+        if exclude:
+            self._scheduler_map[key].request(user, priority, callback, exclude)
+        else:
+            self._scheduler_map[key].request(user, priority, callback)
+
+    def report_stats(self, device, stats):
+        """Fold the job statistics reported for a device into its health."""
+        if device not in self._device_health:
+            self._device_health[device] = DeviceHealth()
+        self._device_health[device].update(stats)
 
     def close(self, conn):
         self._connections.remove(conn)
@@ -369,7 +518,8 @@ class TrackerServerHandler(object):
             res = conn.summary()
             if res.get("key", "").startswith("server"):
                 cinfo.append(res)
-        return {"queue_info": qinfo, "server_info": cinfo}
+        hinfo = {k: v.summary() for k, v in self._device_health.items()}
+        return {"queue_info": qinfo, "server_info": cinfo, "device_health": hinfo}
 
     def run(self):
         """Run the tracker server"""
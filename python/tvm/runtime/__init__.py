@@ -24,6 +24,11 @@ from .script_printer import Scriptable
 from .object_generic import ObjectGeneric, ObjectTypes
 from .ndarray import NDArray, DataType, DataTypeCode, Device
 from .module import Module, num_threads
+from .thread_pool import (
+    create_thread_pool_group,
+    remove_thread_pool_group,
+    list_thread_pool_groups,
+)
 from .profiling import Report
 
 # function exposures
@@ -31,6 +31,10 @@ class AotModule(object):
     module : tvm.runtime.Module
         The internal tvm module that holds the implemented model functions.
 
+    thread_pool_group : Optional[str]
+        The thread pool group created by tvm.runtime.create_thread_pool_group
+        to run the parallel operators on. Defaults to the pool of the calling thread.
+
     Attributes
     ----------
     module : tvm.runtime.Module
@@ -58,9 +62,11 @@ class AotModule(object):
         gmod.run()
     """
 
-    def __init__(self, module):
+    def __init__(self, module, thread_pool_group=None):
         self.module = module
         self._set_input = module["set_input"]
+        if thread_pool_group is not None:
+            module["bind_thread_pool_group"](thread_pool_group)
         self._run = module["run"]
         self._get_output = module["get_output"]
         self._get_input = module["get_input"]
@@ -186,6 +192,25 @@ class AotModule(object):
         """Return the name of input with index `index`"""
         return self._get_input_name(index)
 
+    def clone(self, share_workspace=False):
+        """Create another executor of the same module, for serving requests concurrently.
+
+        The clone shares the module, the constants and the parameters with this executor, and
+        has its own inputs, outputs and workspace pools.
+
+        Parameters
+        ----------
+        share_workspace : bool
+            Whether the clone also shares the workspace pools, which requires that the clone
+            and this executor never run concurrently.
+
+        Returns
+        -------
+        clone : AotModule
+            The clone.
+        """
+        return AotModule(self.module["clone"](share_workspace))
+
     def get_input_info(self):
         """Return the 'shape' and 'dtype' dictionaries of the module."""
         self.get_input_name(0)
@@ -96,6 +96,56 @@ class BenchmarkResult:
         )
 
 
+class AdaptiveBenchmarkResult(BenchmarkResult):
+    """Runtimes from benchmarking with the outliers dropped.
+
+    Attributes
+    ----------
+    ci : float
+        Half width in seconds of the 95% confidence interval of the mean.
+    dropped : Sequence[float]
+        The runtimes dropped as outliers, e.g. from frequency throttling.
+    """
+
+    def __init__(self, results: Sequence[float], dropped: Sequence[float], ci: float):
+        super().__init__(results)
+        # The sample standard deviation, as the confidence interval uses it.
+        self.std = np.std(self.results, ddof=1) if len(self.results) > 1 else 0.0
+        self.dropped = dropped
+        self.ci = ci
+
+    def __repr__(self):
+        return "AdaptiveBenchmarkResult(mean={}, std={}, ci={}, kept={}, dropped={})".format(
+            self.mean, self.std, self.ci, len(self.results), len(self.dropped)
+        )
+
+
+class BatchedBenchmarkResult(BenchmarkResult):
+    """Runtimes from benchmarking with all the repeats enqueued before one synchronization.
+
+    Attributes
+    ----------
+    gaps : Sequence[float]
+        The times in seconds between the end of a repeat and the start of the next one on the
+        device, i.e. the launch overhead and the preprocessing not hidden by the device.
+    mean_gap : float
+        The mean of the gaps.
+    max_gap : float
+        The largest gap.
+    """
+
+    def __init__(self, results: Sequence[float], gaps: Sequence[float]):
+        super().__init__(results)
+        self.gaps = tuple(gaps)
+        self.mean_gap = float(np.mean(self.gaps)) if self.gaps else 0.0
+        self.max_gap = float(np.max(self.gaps)) if self.gaps else 0.0
+
+    def __repr__(self):
+        return "BatchedBenchmarkResult(mean={}, std={}, mean_gap={}, max_gap={})".format(
+            self.mean, self.std, self.mean_gap, self.max_gap
+        )
+
+
 class ModulePropertyMask(object):
     """Runtime Module Property Mask."""
 
@@ -365,7 +415,10 @@ class Module(object):
             The number of repeats before the cooldown is activated.
 
         f_preproc: str, optional
-            The preprocess function name we want to execute before executing the time evaluator.
+            The preprocess function name we want to execute before executing the time evaluator,
+            e.g. "cache_flush_cpu_non_first_arg", or "cache_flush_device" to flush the cache of
+            the device of the arguments, such as the L2 of CUDA, ROCm or OpenCL GPUs. It is not
+            timed.
 
         Note
         ----
@@ -405,6 +458,150 @@ class Module(object):
         except NameError:
             raise NameError("time_evaluator is only supported when RPC is enabled")
 
+    def adaptive_time_evaluator(
+        self,
+        func_names,
+        dev,
+        number=1,
+        min_repeat=5,
+        max_repeat=100,
+        min_repeat_ms=0,
+        max_rel_ci=0.02,
+        outlier_threshold=3.5,
+        cooldown_interval_ms=0,
+        f_preproc="",
+    ):
+        """Get an evaluator that repeats the measurement until it is precise enough.
+
+        The functions are measured in interleaved rounds, the order rotated
+        every round, so a slowdown of a shared host affects all of them alike.
+        After `min_repeat` rounds, the measurement stops once the 95%
+        confidence interval of every mean is within `max_rel_ci` of the mean,
+        or after `max_repeat` rounds. Slow outliers, e.g. from frequency
+        throttling, are dropped by their modified z-score.
+
+        Parameters
+        ----------
+        func_names: str or List[str]
+            The candidate functions in the module, which take the same arguments.
+
+        dev: Device
+            The device we should run the functions on.
+
+        number: int
+            The number of runs in one repeat.
+
+        min_repeat: int, optional
+            The minimum number of repeats, at least 2.
+
+        max_repeat: int, optional
+            The maximum number of repeats.
+
+        min_repeat_ms: int, optional
+            The minimum duration of one repeat in milliseconds, `number` is
+            increased in the first round to reach it.
+
+        max_rel_ci: float, optional
+            The target half width of the confidence interval relative to the mean.
+
+        outlier_threshold: float, optional
+            The modified z-score above which a repeat is dropped, 0 keeps all.
+
+        cooldown_interval_ms: int, optional
+            The pause between the rounds in milliseconds.
+
+        f_preproc: str, optional
+            The function run before each repeat, e.g. "cache_flush_cpu_non_first_arg" or
+            "cache_flush_device".
+
+        Returns
+        -------
+        ftimer : function
+            The function that takes the arguments of the candidates and returns an
+            AdaptiveBenchmarkResult, or a list of them when func_names is a list.
+        """
+        names = [func_names] if isinstance(func_names, string_types) else list(func_names)
+        try:
+            feval = _ffi_api.RPCAdaptiveTimeEvaluator(
+                self,
+                ",".join(names),
+                dev.device_type,
+                dev.device_id,
+                number,
+                min_repeat,
+                max_repeat,
+                min_repeat_ms,
+                max_rel_ci,
+                outlier_threshold,
+                cooldown_interval_ms,
+                f_preproc,
+            )
+        except NameError:
+            raise NameError("time_evaluator is only supported when RPC is enabled")
+
+        def evaluator(*args):
+            """Internal wrapped evaluator."""
+            blob = bytes(feval(*args))
+            values = struct.unpack("@" + "d" * (len(blob) // 8), blob)
+            results, pos = [], 0
+            for _ in names:
+                num_kept, num_dropped = int(values[pos]), int(values[pos + 1])
+                ci = values[pos + 4]
+                kept = values[pos + 5 : pos + 5 + num_kept]
+                dropped = values[pos + 5 + num_kept : pos + 5 + num_kept + num_dropped]
+                results.append(AdaptiveBenchmarkResult(kept, dropped, ci))
+                pos += 5 + num_kept + num_dropped
+            return results[0] if isinstance(func_names, string_types) else results
+
+        return evaluator
+
+    def batched_time_evaluator(self, func_name, dev, number=1, repeat=10, f_preproc=""):
+        """Get an evaluator that enqueues all the repeats before synchronizing once.
+
+        Each repeat is timed on the device, e.g. by a pair of CUDA events, and the host only
+        synchronizes after the last one, so the synchronization overhead, which dominates
+        microsecond kernels, is not measured. The gaps between the repeats are reported as
+        well. Unlike time_evaluator, `number` is not adjusted to a minimum duration.
+
+        Parameters
+        ----------
+        func_name: str
+            The name of the function in the module.
+
+        dev: Device
+            The device we should run this function on.
+
+        number: int
+            The number of runs in one repeat.
+
+        repeat: int, optional
+            The number of repeats.
+
+        f_preproc: str, optional
+            The function run before each repeat, e.g. "cache_flush_device". It is timed in
+            the gaps, not in the repeats.
+
+        Returns
+        -------
+        ftimer : function
+            The function that takes the same arguments as func and returns a
+            BatchedBenchmarkResult.
+        """
+        try:
+            feval = _ffi_api.RPCBatchedTimeEvaluator(
+                self, func_name, dev.device_type, dev.device_id, number, repeat, f_preproc
+            )
+        except NameError:
+            raise NameError("time_evaluator is only supported when RPC is enabled")
+
+        def evaluator(*args):
+            """Internal wrapped evaluator."""
+            blob = bytes(feval(*args))
+            values = struct.unpack("@" + "d" * (len(blob) // 8), blob)
+            return BatchedBenchmarkResult(values[:repeat], values[repeat:])
+
+        return evaluator
+
     def _collect_from_import_tree(self, filter_func):
         """Helper function to collect modules from the tree matching a filter_func, then return it.
 
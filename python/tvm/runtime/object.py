@@ -93,15 +93,18 @@ class Object(ObjectBase):
     def __getstate__(self):
         handle = self.handle
         if handle is not None:
-            return {"handle": _ffi_node_api.SaveJSON(self)}
+            return {"handle": _ffi_node_api.SaveBinary(self)}
         return {"handle": None}
 
     def __setstate__(self, state):
         # pylint: disable=assigning-non-slot, assignment-from-no-return
         handle = state["handle"]
         self.handle = None
-        if handle is not None:
+        if isinstance(handle, str):
+            # Pickled as JSON by the earlier versions
             self.__init_handle_by_constructor__(_ffi_node_api.LoadJSON, handle)
+        elif handle is not None:
+            self.__init_handle_by_constructor__(_ffi_node_api.LoadBinary, bytearray(handle))
 
     def _move(self):
         """Create an RValue reference to the object and mark the object as moved.
@@ -62,7 +62,7 @@ def save_param_dict(params):
     return _ffi_api.SaveParams(_to_ndarray(params))
 
 
-def save_param_dict_to_file(params, path):
+def save_param_dict_to_file(params, path, mappable=False):
     """Save parameter dictionary to file.
 
     Parameters
@@ -72,7 +72,13 @@ def save_param_dict_to_file(params, path):
 
     path: str
         The path to the parameter file.
+
+    mappable: bool
+        Whether to store the arrays at page-aligned offsets, so that the file
+        is memory-mapped instead of read when loaded.
     """
+    if mappable:
+        return _ffi_api.SaveParamsToMappableFile(_to_ndarray(params), path)
     return _ffi_api.SaveParamsToFile(_to_ndarray(params), path)
 
 
@@ -49,6 +49,8 @@ class VirtualMachineProfiler(vm.VirtualMachine):
         self._invoke = self.module["invoke"]
         self._profile = self.module["profile"]
         self._profile_rpc = self.module["profile_rpc"]
+        self._set_sampling = self.module["set_sampling"]
+        self._get_sampled_profile = self.module["get_sampled_profile"]
         self._set_input = self.module["set_input"]
         self._setup_device(device, memory_cfg)
 
@@ -68,8 +70,10 @@ class VirtualMachineProfiler(vm.VirtualMachine):
         func_name : str
             The name of the function.
 
-        collectors : Optional[Sequence[MetricCollector]]
-            Extra metrics to collect. If profiling over RPC, collectors must be `None`.
+        collectors : Optional[Sequence[Union[MetricCollector, str]]]
+            Extra metrics to collect. MetricCollectors cannot be sent over RPC, so when profiling
+            over RPC they are given by the name of the global function constructing them on the
+            remote, e.g. "runtime.profiling.HexagonMetricCollector".
 
         args : list[tvm.runtime.NDArray] or list[np.ndarray]
             The arguments to the function.
@@ -85,7 +89,43 @@ class VirtualMachineProfiler(vm.VirtualMachine):
         if args or kwargs:
             self.set_input(func_name, *args, **kwargs)
         if self.module.type_key == "rpc":
-            # We cannot serialize MetricCollectors over RPC
-            assert collectors is None, "Profiling with collectors is not supported over RPC"
-            return Report.from_json(self._profile_rpc(func_name))
+            # We cannot serialize MetricCollectors over RPC, the remote constructs them by name
+            assert all(
+                isinstance(c, str) for c in collectors or []
+            ), "Over RPC, collectors must be given by the names of their global functions"
+            return Report.from_json(self._profile_rpc(func_name, ",".join(collectors or [])))
         return self._profile(func_name, collectors)
+
+    def set_sampling(self, sample_rate, sample_window=0):
+        """Profile one invocation out of `sample_rate` while running normally.
+
+        The sampled operators are timed without waiting for the device, and accumulated into
+        running statistics read with `get_sampled_profile`.
+
+        Parameters
+        ----------
+        sample_rate : int
+            One invocation every `sample_rate` is profiled. Zero disables sampling.
+
+        sample_window : int
+            The number of consecutive operators timed per sampled invocation, moving over the
+            operators from one sample to the next. Zero times every operator.
+        """
+        self._set_sampling(sample_rate, sample_window)
+
+    def get_sampled_profile(self, reset=False):
+        """Get the statistics accumulated by sampling, see `set_sampling`.
+
+        Parameters
+        ----------
+        reset : bool
+            Whether to clear the statistics once read.
+
+        Returns
+        -------
+        profile : Dict[str, Dict[str, Object]]
+            For each operator, its "Count", total "Duration (us)", "Mean (us)", "Min (us)" and
+            "Max (us)", and its latency "Histogram", where bucket i counts the calls taking less
+            than 2^i microseconds and at least the bound of the previous bucket.
+        """
+        return self._get_sampled_profile(reset)
@@ -16,7 +16,7 @@
 # under the License.
 """Registration of profiling objects in python."""
 
-from typing import Dict, Sequence, Optional
+from typing import Dict, List, Sequence, Optional
 from ... import _ffi
 from . import _ffi_api
 from .. import Object, Device
@@ -155,6 +155,44 @@ class Report(Object):
         """
         return _ffi_api.AsJSON(self)
 
+    def roofline_headroom(self, top: Optional[int] = None) -> List[Dict[str, object]]:
+        """Rank operators by how much time they would save at their roofline.
+
+        Requires a report from :py:func:`tvm.utils.roofline_analysis` or
+        :py:func:`tvm.utils.roofline.roofline_from_existing`. Calls to the
+        same operator are aggregated.
+
+        Parameters
+        ----------
+        top : Optional[int]
+            Only return this many operators.
+
+        Returns
+        -------
+        ranking : List[Dict[str, object]]
+            One entry per operator, with the most headroom first. Each entry
+            has the operator "Name", total "Duration (us)" and "Headroom (us)",
+            the "Percent of Theoretical Optimal" over all calls and the "Bound".
+        """
+        ops = {}
+        for call in self.calls:
+            if "Headroom (us)" not in call:
+                continue
+            name = str(call["Name"])
+            entry = ops.setdefault(
+                name,
+                {"Name": name, "Duration (us)": 0.0, "Headroom (us)": 0.0, "Bound": call["Bound"]},
+            )
+            entry["Duration (us)"] += call["Duration (us)"].microseconds
+            entry["Headroom (us)"] += call["Headroom (us)"].microseconds
+        ranking = sorted(ops.values(), key=lambda x: x["Headroom (us)"], reverse=True)
+        for entry in ranking:
+            duration = entry["Duration (us)"]
+            entry["Percent of Theoretical Optimal"] = (
+                100.0 * (1.0 - entry["Headroom (us)"] / duration) if duration > 0 else 100.0
+            )
+        return ranking if top is None else ranking[:top]
+
     @classmethod
     def from_json(cls, s):
         """Deserialize a report from JSON.
@@ -217,6 +255,76 @@ class DeviceWrapper(Object):
         self.__init_handle_by_constructor__(_ffi_api.DeviceWrapper, dev)
 
 
+def start_trace(capacity: int = 1 << 16):
+    """Start recording a Chrome/Perfetto trace.
+
+    While tracing, the runtime records profiled operator calls (host time and,
+    for devices other than the CPU, time on the device stream), thread pool
+    tasks per worker and RPC requests into a ring buffer. The oldest events are
+    overwritten once `capacity` events are pending. Operator calls are only
+    recorded while a profiler runs, e.g. in `VirtualMachineProfiler.profile`.
+
+    Parameters
+    ----------
+    capacity : int
+        Number of events the ring buffer holds.
+    """
+    _ffi_api.TraceStart(capacity)
+
+
+def stop_trace():
+    """Stop recording the trace. Pending events can still be flushed."""
+    _ffi_api.TraceStop()
+
+
+def flush_trace(path: Optional[str] = None, append: bool = False) -> Optional[str]:
+    """Drain the events recorded since the last flush.
+
+    Parameters
+    ----------
+    path : Optional[str]
+        File to write the events to, in Chrome's JSON array format that
+        chrome://tracing and https://ui.perfetto.dev open directly. The
+        file may be flushed repeatedly while the program runs.
+    append : bool
+        Append to `path` instead of starting a new trace file. Use True
+        for the flushes after the first one.
+
+    Returns
+    -------
+    trace : Optional[str]
+        The events as a JSON trace if no `path` is given.
+    """
+    if path is not None:
+        _ffi_api.TraceFlush(path, append)
+        return None
+    events = _ffi_api.TraceDrain()
+    return "[\n" + events.rstrip(",\n") + "\n]\n"
+
+
+def start_loop_profiling():
+    """Start recording the loop regions of CPU kernels.
+
+    Kernels built with the `tir.instrument_lwp` pass config contain profile
+    intrinsics around their loops, which the LLVM CPU backend lowers to calls
+    into the runtime. They only check a flag while the recording is off.
+    """
+    _ffi_api.StartLoopProfiling()
+
+
+def stop_loop_profiling() -> Report:
+    """Stop recording the loop regions.
+
+    Returns
+    -------
+    report : Report
+        One row per region of each PrimFunc, named after the function and the
+        ids of the enclosing regions, with the total duration and the time
+        spent outside of the nested regions ("Self (us)").
+    """
+    return _ffi_api.StopLoopProfiling()
+
+
 def profile_function(mod, dev, collectors, func_name=None, warmup_iters=10):
     """Collect performance information of a function execution. Usually used with
     a compiled PrimFunc.
@@ -269,6 +377,20 @@ def profile_function(mod, dev, collectors, func_name=None, warmup_iters=10):
     )
 
 
+@_ffi.register_object("runtime.profiling.ThreadPoolMetricCollector")
+class ThreadPoolMetricCollector(MetricCollector):
+    """Reports how the CPU thread pool waited for work during each call.
+
+    The metrics are the number of tasks the workers picked up while spinning,
+    the number of times they went to sleep, and the number of times the
+    launching thread went to sleep waiting for them. Nothing is reported when
+    TVM is built with the OpenMP thread pool.
+    """
+
+    def __init__(self):
+        self.__init_handle_by_constructor__(_ffi_api.ThreadPoolMetricCollector)
+
+
 # We only enable this class when TVM is build with PAPI support
 if _ffi.get_global_func("runtime.profiling.PAPIMetricCollector", allow_missing=True) is not None:
 
@@ -291,3 +413,34 @@ if _ffi.get_global_func("runtime.profiling.PAPIMetricCollector", allow_missing=T
             for dev, names in metric_names.items():
                 wrapped[DeviceWrapper(dev)] = names
             self.__init_handle_by_constructor__(_ffi_api.PAPIMetricCollector, wrapped)
+
+
+# We only enable this class when TVM is build with CUPTI support
+if _ffi.get_global_func("runtime.profiling.CUPTIMetricCollector", allow_missing=True) is not None:
+
+    @_ffi.register_object("runtime.profiling.CUPTIMetricCollector")
+    class CUPTIMetricCollector(MetricCollector):
+        """Collects per kernel hardware metrics of NVIDIA GPUs using the CUPTI
+        profiler API.
+
+        Every kernel is replayed until all requested metrics are collected.
+        The metrics of a call are aggregated over the kernels it launched:
+        metrics ending in `.sum` are added up, the others are averaged
+        weighted by kernel duration.
+        """
+
+        def __init__(self, metric_names: Optional[Dict[Device, Sequence[str]]] = None):
+            """
+            Parameters
+            ----------
+            metric_names : Optional[Dict[Device, Sequence[str]]]
+                List of per-device metrics to collect. You can find a list of valid
+                metrics by running `ncu --query-metrics` from the command line. By
+                default achieved occupancy, DRAM throughput, L2 hit rate and tensor
+                core utilization are collected.
+            """
+            metric_names = {} if metric_names is None else metric_names
+            wrapped = dict()
+            for dev, names in metric_names.items():
+                wrapped[DeviceWrapper(dev)] = names
+            self.__init_handle_by_constructor__(_ffi_api.CUPTIMetricCollector, wrapped)
@@ -0,0 +1,61 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Thread pool groups for running several executors in one process."""
+from typing import List, Sequence
+
+from . import _ffi_api
+
+
+def create_thread_pool_group(name: str, cpus: Sequence[int]) -> None:
+    """Create a named group of worker threads, one worker pinned to each CPU.
+
+    Groups must use disjoint CPUs. Executors bound to different groups run their
+    parallel operators on separate workers, which keeps them from competing for cores.
+
+    Parameters
+    ----------
+    name : str
+        The name of the group.
+
+    cpus : Sequence[int]
+        The CPUs of the group.
+    """
+    _ffi_api.ThreadPoolGroupCreate(name, [str(cpu) for cpu in cpus])
+
+
+def remove_thread_pool_group(name: str) -> None:
+    """Remove a thread pool group.
+
+    Executors still bound to the group keep it alive until they are done running.
+
+    Parameters
+    ----------
+    name : str
+        The name of the group.
+    """
+    _ffi_api.ThreadPoolGroupRemove(name)
+
+
+def list_thread_pool_groups() -> List[str]:
+    """List the thread pool groups.
+
+    Returns
+    -------
+    names : List[str]
+        The names of the groups in sorted order.
+    """
+    return [str(name) for name in _ffi_api.ThreadPoolGroupList()]
@@ -20,9 +20,12 @@ The Relay Virtual Machine runtime.
 
 Implements a Python interface to executing the compiled VM object.
 """
+import json
+
 import numpy as np
 
 import tvm
+import tvm._ffi
 from tvm.runtime import Module
 from tvm._ffi.runtime_ctypes import TVMByteArray
 from tvm._ffi import base as _base
@@ -312,9 +315,10 @@ class Executable(object):
         self._function_params[func_name] = params
         return params
 
-    def move_late_bound_consts(self, path, byte_limit):
-        """Move all constants of byte size greater or equal to byte_limit to file at path"""
-        return self._move_late_bound_consts(path, byte_limit)
+    def move_late_bound_consts(self, path, byte_limit, mappable=False):
+        """Move all constants of byte size greater or equal to byte_limit to file at path.
+        With mappable, the file is memory-mapped instead of read when loaded."""
+        return self._move_late_bound_consts(path, byte_limit, mappable)
 
     def get_late_bound_consts(self, byte_limit):
         """Return all constants of byte size greater or equal to byte_limit"""
@@ -329,6 +333,27 @@ class Executable(object):
         return self._load_late_bound_consts_from_map(map)
 
 
+@tvm._ffi.register_object("vm.Future")
+class VMFuture(Object):
+    """The future of an asynchronous invocation of the VM, see
+    :py:func:`VirtualMachine.invoke_async`."""
+
+    def done(self):
+        """Whether the invocation completed on the devices, without blocking on the devices
+        supporting events."""
+        return bool(_ffi_api.VMFutureDone(self))
+
+    def wait(self):
+        """Wait for the invocation to complete.
+
+        Returns
+        -------
+        result : Object
+            The output.
+        """
+        return _ffi_api.VMFutureWait(self)
+
+
 class VirtualMachine(object):
     """Relay VM runtime.
 
@@ -343,7 +368,11 @@ class VirtualMachine(object):
 
     memory_cfg : str or Dict[tvm.runtime.Device, str], optional
         Config the type of memory allocator. The allocator type can be ["naive",
-        "pooled"]. If memory_cfg is None, all devices will use pooled allocator
+        "pooled", "arena"]. The arena allocator carves best-fit blocks out of large
+        device arenas and coalesces them on free, which bounds the memory when the
+        shapes vary, e.g. with dynamic sequence lengths. It falls back to the pooled
+        allocator on devices without a flat address space.
+        If memory_cfg is None, all devices will use pooled allocator
         by default. If memory_cfg is string, all devices will use the specified
         allocator type. If memory_cfg is a dict, each device uses the allocator
         type specified in the dict, or pooled allocator if not specified in the
@@ -352,8 +381,9 @@ class VirtualMachine(object):
 
     NAIVE_ALLOCATOR = 1
     POOLED_ALLOCATOR = 2
+    ARENA_ALLOCATOR = 3
 
-    def __init__(self, exe, device, memory_cfg=None):
+    def __init__(self, exe, device, memory_cfg=None, thread_pool_group=None):
         """
         Construct a VirtualMachine wrapper class which provides a simple
         interface over the raw C++ Module based API.
@@ -377,6 +407,10 @@ class VirtualMachine(object):
         memory_cfg: Optional[str]
             The allocator behavior to use for the VM.
 
+        thread_pool_group: Optional[str]
+            The thread pool group created by tvm.runtime.create_thread_pool_group
+            to run the parallel operators on. Defaults to the pool of the calling thread.
+
         Returns
         -------
         vm: VirtualMachine
@@ -391,8 +425,15 @@ class VirtualMachine(object):
         if not isinstance(exe, Executable):
             exe = Executable(exe)
 
-        self.module = exe.mod["vm_load_executable"]()
         self._exec = exe
+        self._bind_module(exe.mod["vm_load_executable"]())
+        self._setup_device(device, memory_cfg)
+        if thread_pool_group is not None:
+            self.module["bind_thread_pool_group"](thread_pool_group)
+
+    def _bind_module(self, module):
+        """Bind the wrapper to a VM runtime module."""
+        self.module = module
         self._init = self.module["init"]
         self._invoke = self.module["invoke"]
         self._invoke_stateful = self.module["invoke_stateful"]
@@ -402,7 +443,72 @@ class VirtualMachine(object):
         self._set_input = self.module["set_input"]
         self._set_one_input = self.module["set_one_input"]
         self._set_outputs = self.module["set_outputs"]
-        self._setup_device(device, memory_cfg)
+
+    def create_context(self):
+        """Create a lightweight execution context for concurrent requests.
+
+        The context shares the executable, the kernels, the memory allocators and the
+        constants uploaded to the devices with this VM, and has its own registers, inputs
+        and outputs. Each thread serving requests can use its own context without another
+        copy of the device constants.
+
+        Returns
+        -------
+        context : VirtualMachine
+            The context, initialized for the same devices as this VM.
+        """
+        context = VirtualMachine.__new__(VirtualMachine)
+        context._exec = self._exec
+        context._bind_module(self.module["create_context"]())
+        return context
+
+    def clone(self, share_workspace=False):  # pylint: disable=unused-argument
+        """Create another VM for serving requests concurrently, see create_context.
+
+        The storage of the tensors is allocated at each invocation from the memory allocators
+        shared by all the VMs of a device, so the clone always shares the workspace.
+
+        Parameters
+        ----------
+        share_workspace : bool
+            Accepted for the uniformity with the other executors.
+
+        Returns
+        -------
+        clone : VirtualMachine
+            The clone.
+        """
+        return self.create_context()
+
+    def enable_op_latency_histograms(self, sample_period=1):
+        """Record the latency of every primitive into histograms.
+
+        The recording is cheap enough to stay on in production: only one of every
+        `sample_period` invocations is timed, and the device timers are read later without
+        blocking. The histograms are exported with get_op_latency_histograms.
+
+        Parameters
+        ----------
+        sample_period : int
+            Time one of every sample_period invocations, 0 disables the recording.
+        """
+        self.module["enable_op_latency_histograms"](sample_period)
+
+    def get_op_latency_histograms(self, reset=False):
+        """Export the latency histograms, to be polled by a metrics agent.
+
+        Parameters
+        ----------
+        reset : bool
+            Whether to clear the histograms after reading them.
+
+        Returns
+        -------
+        histograms : dict
+            The count, sum, max and quantiles in microseconds of each operator,
+            with the non empty buckets as [upper bound, count] pairs.
+        """
+        return json.loads(self.module["get_op_latency_histograms"](reset))
 
     def _setup_device(self, dev, memory_cfg):
         """Init devices and allocators."""
@@ -420,9 +526,11 @@ class VirtualMachine(object):
         if memory_cfg is None:
             memory_cfg = {}
         elif isinstance(memory_cfg, str):
-            assert memory_cfg in ["naive", "pooled"]
+            assert memory_cfg in ["naive", "pooled", "arena"]
             if memory_cfg == "naive":
                 default_alloc_type = VirtualMachine.NAIVE_ALLOCATOR
+            elif memory_cfg == "arena":
+                default_alloc_type = VirtualMachine.ARENA_ALLOCATOR
             memory_cfg = {}
         elif not isinstance(memory_cfg, dict):
             raise TypeError(
@@ -523,6 +631,32 @@ class VirtualMachine(object):
             self.set_input(func_name, *args, **kwargs)
         return self._invoke(func_name)
 
+    def invoke_async(self, func_name, *args, **kwargs):
+        """Invoke a function without waiting for the devices.
+
+        The call returns once the work of the function is queued on the devices, so the
+        host can prepare the next request while this one runs.
+
+        Parameters
+        ----------
+        func_name : str
+            The name of the function.
+
+        args : list[tvm.runtime.NDArray] or list[np.ndarray]
+            The arguments to the function.
+
+        kwargs: dict of str to tvm.runtime.NDArray or np.ndarray
+            Named arguments to the function.
+
+        Returns
+        -------
+        future : VMFuture
+            The future of the output.
+        """
+        if args or kwargs:
+            self.set_input(func_name, *args, **kwargs)
+        return self.module["invoke_async"](func_name)
+
     def run(self, *args, **kwargs):
         """Run the main function.
 
@@ -607,6 +741,43 @@ class VirtualMachine(object):
         """
         return [self._get_output(i) for i in range(self._get_num_outputs())]
 
+    def bind_numa_node(self, node, nthreads=0):
+        """Bind the VM to a NUMA node.
+
+        The cached CPU constants are migrated to the node, and the thread pool
+        of the thread invoking the VM is pinned to the CPUs of the node.
+
+        Parameters
+        ----------
+        node : int
+            The id of the NUMA node.
+
+        nthreads : int
+            The number of threads to use, 0 uses all the CPUs of the node.
+        """
+        self.module["bind_numa_node"](node, nthreads)
+
+    @staticmethod
+    def memory_stats(device):
+        """Get the memory usage statistics of the VM allocator on a device.
+
+        Parameters
+        ----------
+        device : tvm.runtime.Device
+            The device of the allocator.
+
+        Returns
+        -------
+        stats : Dict[str, int or float]
+            The live, reserved and peak bytes, the largest free block and the
+            fragmentation of the free memory in percent.
+        """
+        stats = _ffi_api.VMAllocatorStats(device.device_type % RPC_SESS_MASK, device.device_id)
+        return {
+            key: value.percent if key == "fragmentation" else value.value
+            for key, value in stats.items()
+        }
+
     def get_input_index(self, input_name, func_name="main"):
         """Get inputs index via input name.
         Parameters
@@ -69,6 +69,7 @@ from .target import (
     vta,
     bifrost,
     riscv_cpu,
+    wasm,
     hexagon,
     stm32,
 )
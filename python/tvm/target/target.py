@@ -625,6 +625,31 @@ def riscv_cpu(model="sifive-u54", options=None):
     return Target(" ".join(["llvm"] + opts))
 
 
+def wasm(simd=True, threads=False, options=None):
+    """Returns a WebAssembly target, to run with the tvmjs runtime.
+
+    Parameters
+    ----------
+    simd : bool
+        Whether to use the 128-bit vectors of the wasm SIMD proposal.
+    threads : bool
+        Whether to use the atomics and the shared memory of the wasm threads proposal,
+        required to link with the runtime built with USE_PTHREADS=1.
+    options : str or list of str
+        Additional options
+    """
+    mattr = []
+    if simd:
+        mattr += ["+simd128"]
+    if threads:
+        mattr += ["+atomics", "+bulk-memory"]
+    opts = ["-mtriple=wasm32-unknown-unknown-wasm"]
+    if mattr:
+        opts += ["-mattr=" + ",".join(mattr)]
+    opts = _merge_opts(opts, options)
+    return Target(" ".join(["llvm"] + opts))
+
+
 def hexagon(cpu_ver="v66", **kwargs):
     """Returns a Hexagon target.
 
@@ -124,6 +124,14 @@ def target_has_vnni(target):
     }
 
 
+@register_func("tvm.target.x86.target_has_avx512_bf16")
+def target_has_avx512_bf16(target):
+    return target in {
+        "cooperlake",
+        "sapphirerapids",
+    }
+
+
 @register_func("tvm.target.x86.target_has_amx")
 def target_has_amx(target):
     return target in {
@@ -252,6 +252,31 @@ def estimate_tir_flops(stmt_or_mod: Union[Stmt, IRModule]) -> float:
     return _ffi_api.EstimateTIRFlops(stmt_or_mod)  # type: ignore # pylint: disable=no-member
 
 
+def estimate_register_pressure(stmt_or_func: Union[Stmt, PrimFunc], vector_bits: int = 128) -> int:
+    """Estimate the register pressure of the innermost loop bodies of a lowered TIR fragment.
+
+    Each distinct buffer access is live from the first statement that touches it to the last one,
+    and an accumulator is live through the whole loop body. The fragment is expected to be
+    vectorized and unrolled already.
+
+    Parameters
+    ----------
+    stmt_or_func: Union[Stmt, PrimFunc]
+        The TIR fragment or PrimFunc to be estimated.
+
+    vector_bits: int
+        The width of a vector register in bits.
+
+    Returns
+    -------
+    pressure: int
+        The estimated maximal number of live vector registers.
+    """
+    return _ffi_api.EstimateRegisterPressure(  # type: ignore # pylint: disable=no-member
+        stmt_or_func, vector_bits
+    )
+
+
 # NOTE: relay_func_type in the following two functions should be relay.FuncType however that would
 # introduce a cycling dependency. We make do with Object.
 
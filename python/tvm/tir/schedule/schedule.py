@@ -1204,6 +1204,74 @@ class Schedule(Object):
         """
         _ffi_api.ScheduleUnroll(self, loop)  # type: ignore # pylint: disable=no-member
 
+    @type_checked
+    def unroll_and_jam(self, loop: LoopRV, factor: int) -> LoopRV:
+        """Unroll the input loop by a factor and jam the copies into the loops nested below it.
+        The loop is split into an outer loop and an inner loop of the factor, the inner loop is
+        moved below the single-branch loop nest under the loop, and unrolled. It requires:
+
+        1) The factor is positive.
+
+        2) The requirements of `split` on the loop and of `reorder` on the loop nest.
+
+        Parameters
+        ----------
+        loop : LoopRV
+            The loop to be unrolled and jammed
+
+        factor : int
+            The number of copies of the loop body jammed together
+
+        Returns
+        -------
+        outer_loop : LoopRV
+            The outer loop after the split
+
+        Examples
+        --------
+
+        Before unroll_and_jam, in TensorIR, the IR is:
+
+        .. code-block:: python
+
+            @T.prim_func
+            def before_unroll_and_jam(a: T.handle, b: T.handle) -> None:
+                A = T.match_buffer(a, (128, 128))
+                B = T.match_buffer(b, (128, 128))
+                for i, j in T.grid(128, 128):
+                    with T.block("B"):
+                        vi, vj = T.axis.remap("SS", [i, j])
+                        B[vi, vj] = A[vi, vj] * 2.0
+
+        Create the schedule and do unroll_and_jam:
+
+        .. code-block:: python
+
+            sch = tir.Schedule(before_unroll_and_jam)
+            i, j = sch.get_loops(sch.get_block("B"))
+            sch.unroll_and_jam(i, factor=4)
+
+        After applying unroll_and_jam, the IR becomes:
+
+        .. code-block:: python
+
+            @T.prim_func
+            def after_unroll_and_jam(a: T.handle, b: T.handle) -> None:
+                A = T.match_buffer(a, (128, 128))
+                B = T.match_buffer(b, (128, 128))
+                for i_0 in T.serial(0, 32):
+                    for j in T.serial(0, 128):
+                        for i_1 in T.unroll(0, 4):
+                            with T.block("B"):
+                                vi = T.axis.spatial(128, i_0 * 4 + i_1)
+                                vj = T.axis.spatial(128, j)
+                                B[vi, vj] = A[vi, vj] * 2.0
+
+        """
+        return _ffi_api.ScheduleUnrollAndJam(  # type: ignore # pylint: disable=no-member
+            self, loop, factor
+        )
+
     ########## Schedule: Insert cache stages ##########
 
     @type_checked
@@ -2005,7 +2073,8 @@ class Schedule(Object):
         dataflow condition. i.e. all the blocks in the scope block's subtree must be either
         complete block or reduction block
 
-        4) All the producers of the block are under the given loop
+        4) The producers of the block are under the given loop, except for those completed before
+        it in the scope, and at least one of them is under the loop
 
         Parameters
         ----------
@@ -492,6 +492,12 @@ TensorIntrin.register(
     LDMATRIX_16x16_B_TRANS_INTRIN, *get_ldmatrix_intrin(16, "float16", True, True)
 )
 
+LDMATRIX_16x16_B_TRANS_DYN_INTRIN = "mma.ldmatrix_16x16_b_trans_dyn"
+TensorIntrin.register(
+    LDMATRIX_16x16_B_TRANS_DYN_INTRIN,
+    *get_ldmatrix_intrin(16, "float16", True, True, "shared.dyn"),
+)
+
 LDMATRIX_16x32_A_INTRIN = "mma.ldmatrix_16x32_a"
 TensorIntrin.register(LDMATRIX_16x32_A_INTRIN, *get_ldmatrix_intrin(32, "int8", False, False))
 
@@ -1182,3 +1188,53 @@ def get_wmma_intrin_group(
         "compute": compute_intrin,
         "store": store_intrin,
     }
+
+
+def get_mma_intrin_group(
+    load_scope: Literal["shared", "shared.dyn"],
+    out_dtype: str,
+    trans_b: bool,
+) -> Dict[str, str]:
+    """Get a group of intrinsics for mma.sync tensor core with float16 inputs
+
+    The accumulator is in the warp scope with the layout of mma.sync, and is stored by the threads
+    holding it, so that the elementwise epilogues are computed in registers. `mapping` is the wmma
+    intrinsic of the same computation, whose description has no thread layout.
+
+    Parameters
+    ----------
+    load_scope : Literal["shared", "shared.dyn"]
+        The memory scope of the input buffer.
+
+    out_dtype : str
+        The output data dtype.
+
+    trans_b : bool
+        Whether the input matrix B is transposed.
+
+    Returns
+    -------
+    ret : Dict[str, str]
+        A group of tensor intrinsics.
+    """
+    assert load_scope in ["shared", "shared.dyn"]
+    assert out_dtype in ["float16", "float32"]
+
+    dyn = "_dyn" if load_scope == "shared.dyn" else ""
+    out_dtype = "f16" if out_dtype == "float16" else "f32"
+    trans_b = "_trans" if trans_b else ""
+
+    return {
+        # e.g. mma_fill_16x16_f32
+        "init": f"mma_fill_16x16_{out_dtype}",
+        # e.g. mma.ldmatrix_16x16_a_dyn
+        "load_a": f"mma.ldmatrix_16x16_a{dyn}",
+        # e.g. mma.ldmatrix_16x16_b_trans_dyn
+        "load_b": f"mma.ldmatrix_16x16_b{trans_b}{dyn}",
+        # e.g. mma_f16f16f32_trans
+        "compute": f"mma_f16f16{out_dtype}{trans_b}",
+        # e.g. mma_store_16x16_f32_global_
+        "store": f"mma_store_16x16_{out_dtype}_global_",
+        # e.g. wmma_sync_16x16x16_f16f16f32_trans
+        "mapping": f"wmma_sync_16x16x16_f16f16{out_dtype}{trans_b}",
+    }
@@ -112,3 +112,246 @@ AVX512_DOT_16x4_INTRIN = "dot_16x4_avx512"
 TensorIntrin.register(
     AVX512_DOT_16x4_INTRIN, dot_product_16x4_u8i8i32_desc, dot_product_16x4_u8i8i32_avx512
 )
+
+
+@T.prim_func
+def dot_product_16x2_bf16bf16f32_desc(
+    A: T.Buffer((2,), "bfloat16", offset_factor=1),
+    B: T.Buffer((16, 2), "bfloat16", offset_factor=1),
+    C: T.Buffer((16,), "float32", offset_factor=1),
+) -> None:
+    with T.block("root"):
+        T.reads(C[0:16], A[0:2], B[0:16, 0:2])
+        T.writes(C[0:16])
+        for i in T.serial(0, 16):
+            for k in T.serial(0, 2):
+                with T.block("update"):
+                    vi, vk = T.axis.remap("SR", [i, k])
+                    C[vi] = C[vi] + T.cast(A[vk], "float32") * T.cast(B[vi, vk], "float32")
+
+
+@T.prim_func
+def dot_product_16x2_bf16bf16f32_avx512bf16(
+    A: T.Buffer((2,), "bfloat16", offset_factor=1),
+    B: T.Buffer((16, 2), "bfloat16", offset_factor=1),
+    C: T.Buffer((16,), "float32", offset_factor=1),
+) -> None:
+    with T.block("root"):
+        T.reads(C[0:16], A[0:2], B[0:16, 0:2])
+        T.writes(C[0:16])
+
+        # The pairs of bf16 are passed as i32, as the intrinsic expects up to LLVM 16.
+        A_bf16x2 = A.vload([0], "bfloat16x2")
+        A_i32 = T.reinterpret(A_bf16x2, dtype="int32")
+
+        B_bf16x32 = B.vload([0, 0], dtype="bfloat16x32")
+        B_i32x16 = T.reinterpret(B_bf16x32, dtype="int32x16")
+        C_f32x16 = C.vload([0], dtype="float32x16")
+
+        C[T.ramp(T.int32(0), 1, 16)] = T.call_llvm_pure_intrin(
+            T.llvm_lookup_intrinsic_id("llvm.x86.avx512bf16.dpbf16ps.512"),
+            T.uint32(3),
+            C_f32x16,
+            T.broadcast(A_i32, 16),
+            B_i32x16,
+            dtype="float32x16",
+        )
+
+
+AVX512_BF16_DOT_16x2_INTRIN = "dot_16x2_avx512bf16"
+
+TensorIntrin.register(
+    AVX512_BF16_DOT_16x2_INTRIN,
+    dot_product_16x2_bf16bf16f32_desc,
+    dot_product_16x2_bf16bf16f32_avx512bf16,
+)
+
+
+# Tile configuration shared by the AMX intrinsics: palette 1, with all 8 tiles of 16 rows by
+# 64 bytes, laid out as expected by `ldtilecfg`.
+AMX_TILE_CONFIG = [1, 0] + [0] * 14 + [64, 0] * 8 + [0] * 16 + [16] * 8 + [0] * 8
+
+
+def get_amx_dot_intrin(in_dtype, k_blocks):
+    """Generate the description and the AMX implementation of a 16x16 dot product, whose
+    reduction covers `k_blocks` tiles of A.
+
+    The B operand is expected in the packed layout [K // lanes, 16, lanes] also used by VNNI,
+    where `lanes` input elements make up 4 bytes, so that each row of the packed B is one row of
+    its tile. The tiles are configured each time the intrinsic runs, since the unit keeps the
+    configuration per thread, and C stays in a tile register across the `k_blocks` blocks.
+    """
+    if in_dtype == "int8":
+        a_dtype, b_dtype, out_dtype = "uint8", "int8", "int32"
+        in_bytes = 1
+        dot_product = "llvm.x86.tdpbusd"
+    elif in_dtype == "bfloat16":
+        a_dtype, b_dtype, out_dtype = "bfloat16", "bfloat16", "float32"
+        in_bytes = 2
+        dot_product = "llvm.x86.tdpbf16ps"
+    else:
+        raise ValueError(f"Unsupported input dtype {in_dtype} for AMX")
+    lanes = 4 // in_bytes
+    k_per_block = 64 // in_bytes
+    k_dim = k_per_block * k_blocks
+
+    @T.prim_func
+    def amx_dot_desc(a: T.handle, b: T.handle, c: T.handle) -> None:
+        A = T.match_buffer(a, (16, k_dim), a_dtype, offset_factor=1)
+        B = T.match_buffer(b, (k_dim // lanes, 16, lanes), b_dtype, offset_factor=1)
+        C = T.match_buffer(c, (16, 16), out_dtype, offset_factor=1)
+
+        with T.block("root"):
+            T.reads(C[0:16, 0:16], A[0:16, 0:k_dim], B[0 : k_dim // lanes, 0:16, 0:lanes])
+            T.writes(C[0:16, 0:16])
+            for i, j, k in T.grid(16, 16, k_dim):
+                with T.block("update"):
+                    vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+                    C[vi, vj] = C[vi, vj] + T.cast(A[vi, vk], out_dtype) * T.cast(
+                        B[vk // lanes, vj, vk % lanes], out_dtype
+                    )
+
+    @T.prim_func
+    def amx_dot_impl(a: T.handle, b: T.handle, c: T.handle) -> None:
+        sa = T.int32()
+        sb0 = T.int32()
+        sb1 = T.int32()
+        sc = T.int32()
+        A = T.match_buffer(a, (16, k_dim), a_dtype, offset_factor=1, strides=[sa, 1])
+        B = T.match_buffer(
+            b, (k_dim // lanes, 16, lanes), b_dtype, offset_factor=1, strides=[sb0, sb1, 1]
+        )
+        C = T.match_buffer(c, (16, 16), out_dtype, offset_factor=1, strides=[sc, 1])
+
+        with T.block("root"):
+            T.reads(C[0:16, 0:16], A[0:16, 0:k_dim], B[0 : k_dim // lanes, 0:16, 0:lanes])
+            T.writes(C[0:16, 0:16])
+            config_data = T.allocate_const(AMX_TILE_CONFIG, "uint8", [64])
+            config = T.Buffer([64], "uint8", data=config_data)
+            T.evaluate(
+                T.call_llvm_intrin(
+                    T.llvm_lookup_intrinsic_id("llvm.x86.ldtilecfg"),
+                    T.uint32(1),
+                    config.access_ptr("r"),
+                    dtype="int32",
+                )
+            )
+            # tmm0 accumulates C, tmm1 and tmm2 hold each block of A and B
+            T.evaluate(
+                T.call_llvm_intrin(
+                    T.llvm_lookup_intrinsic_id("llvm.x86.tileloadd64"),
+                    T.uint32(3),
+                    T.uint8(0),
+                    C.access_ptr("r"),
+                    T.Cast("uint64", sc * 4),
+                    dtype="int32",
+                )
+            )
+            for kb in T.serial(k_blocks):
+                T.evaluate(
+                    T.call_llvm_intrin(
+                        T.llvm_lookup_intrinsic_id("llvm.x86.tileloadd64"),
+                        T.uint32(3),
+                        T.uint8(1),
+                        A.access_ptr("r", offset=kb * k_per_block),
+                        T.Cast("uint64", sa * in_bytes),
+                        dtype="int32",
+                    )
+                )
+                T.evaluate(
+                    T.call_llvm_intrin(
+                        T.llvm_lookup_intrinsic_id("llvm.x86.tileloadd64"),
+                        T.uint32(3),
+                        T.uint8(2),
+                        B.access_ptr("r", offset=kb * 16 * sb0),
+                        T.Cast("uint64", sb0 * in_bytes),
+                        dtype="int32",
+                    )
+                )
+                T.evaluate(
+                    T.call_llvm_intrin(
+                        T.llvm_lookup_intrinsic_id(dot_product),
+                        T.uint32(3),
+                        T.uint8(0),
+                        T.uint8(1),
+                        T.uint8(2),
+                        dtype="int32",
+                    )
+                )
+            T.evaluate(
+                T.call_llvm_intrin(
+                    T.llvm_lookup_intrinsic_id("llvm.x86.tilestored64"),
+                    T.uint32(3),
+                    T.uint8(0),
+                    C.access_ptr("w"),
+                    T.Cast("uint64", sc * 4),
+                    dtype="int32",
+                )
+            )
+
+    return amx_dot_desc, amx_dot_impl
+
+
+AMX_INT8_DOT_16x16x64_INTRIN = "dot_16x16x64_u8i8i32_amx"
+
+TensorIntrin.register(AMX_INT8_DOT_16x16x64_INTRIN, *get_amx_dot_intrin("int8", 1))
+
+AMX_INT8_DOT_16x16x256_INTRIN = "dot_16x16x256_u8i8i32_amx"
+
+TensorIntrin.register(AMX_INT8_DOT_16x16x256_INTRIN, *get_amx_dot_intrin("int8", 4))
+
+AMX_BF16_DOT_16x16x32_INTRIN = "dot_16x16x32_bf16bf16f32_amx"
+
+TensorIntrin.register(AMX_BF16_DOT_16x16x32_INTRIN, *get_amx_dot_intrin("bfloat16", 1))
+
+AMX_BF16_DOT_16x16x128_INTRIN = "dot_16x16x128_bf16bf16f32_amx"
+
+TensorIntrin.register(AMX_BF16_DOT_16x16x128_INTRIN, *get_amx_dot_intrin("bfloat16", 4))
+
+
+@T.prim_func
+def dot_product_32x1_f16f16f16_desc(
+    A: T.Buffer((1,), "float16", offset_factor=1),
+    B: T.Buffer((1, 32), "float16", offset_factor=1),
+    C: T.Buffer((32,), "float16", offset_factor=1),
+) -> None:
+    with T.block("root"):
+        T.reads(C[0:32], A[0:1], B[0:1, 0:32])
+        T.writes(C[0:32])
+        for i in T.serial(0, 32):
+            for k in T.serial(0, 1):
+                with T.block("update"):
+                    vi, vk = T.axis.remap("SR", [i, k])
+                    C[vi] = C[vi] + A[vk] * B[vk, vi]
+
+
+@T.prim_func
+def dot_product_32x1_f16f16f16_avx512fp16(
+    A: T.Buffer((1,), "float16", offset_factor=1),
+    B: T.Buffer((1, 32), "float16", offset_factor=1),
+    C: T.Buffer((32,), "float16", offset_factor=1),
+) -> None:
+    with T.block("root"):
+        T.reads(C[0:32], A[0:1], B[0:1, 0:32])
+        T.writes(C[0:32])
+
+        B_f16x32 = B.vload([0, 0], dtype="float16x32")
+        C_f16x32 = C.vload([0], dtype="float16x32")
+
+        C[T.ramp(T.int32(0), 1, 32)] = T.call_llvm_pure_intrin(
+            T.llvm_lookup_intrinsic_id("llvm.fmuladd.v32f16"),
+            T.uint32(3),
+            T.broadcast(A[0], 32),
+            B_f16x32,
+            C_f16x32,
+            dtype="float16x32",
+        )
+
+
+AVX512_FP16_DOT_32x1_INTRIN = "dot_32x1_avx512fp16"
+
+TensorIntrin.register(
+    AVX512_FP16_DOT_32x1_INTRIN,
+    dot_product_32x1_f16f16f16_desc,
+    dot_product_32x1_f16f16f16_avx512fp16,
+)
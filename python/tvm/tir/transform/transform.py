@@ -850,7 +850,9 @@ def UnifyThreadBinding():
 
 def MergeDynamicSharedMemoryAllocations():
     """This pass merges multiple TIR-level dynamic shared memory allocations
-    into one allocation.
+    into one allocation. When the pass config "tir.merge_static_smem" is set,
+    the static shared memory allocations are also merged into one, reusing the
+    memory of buffers whose lifetimes do not overlap.
 
     Returns
     -------
@@ -882,6 +884,20 @@ def InjectSoftwarePipeline():
     return _ffi_api.InjectSoftwarePipeline()  # type: ignore
 
 
+def InjectSoftwarePrefetch():
+    """Prefetch the strided and gathered loads of the loops annotated with `software_prefetch`
+    ahead of their use.
+
+    The annotation is the prefetch distance in iterations, or 0 to estimate it from the loop body.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.InjectSoftwarePrefetch()  # type: ignore
+
+
 def ExtractPrimFuncConstants():
     """Collects and unificates tir non-scalar constants to module's attr 'Constants' array.
 
@@ -60,6 +60,9 @@ class BufferInfo(Object):
     alignment : Optional[int]
         The byte alignment required in the workspace memory
 
+    access_count : Optional[int]
+        The number of loads and stores of the buffer, 0 when it is not known
+
     """
 
     def __init__(
@@ -68,6 +71,7 @@ class BufferInfo(Object):
         size_bytes: int,
         pool_candidates: List[PoolInfo],
         alignment: Optional[int] = None,
+        access_count: Optional[int] = None,
     ):
         self.__init_handle_by_constructor__(
             _ffi_api.BufferInfo,  # type: ignore # pylint: disable=no-member
@@ -75,6 +79,7 @@ class BufferInfo(Object):
             size_bytes,
             pool_candidates,
             alignment,
+            access_count,
         )
 
     def set_conflicts(self, conflicts: list):
@@ -41,6 +41,7 @@ from .pooling import *
 from .nn import schedule_lrn
 from .batch_matmul import *
 from .batch_matmul_tensorcore import *
+from .attention import attention
 from .vision import *
 from .ssd import *
 from .nms import get_valid_counts, non_max_suppression, all_class_non_max_suppression
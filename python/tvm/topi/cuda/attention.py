@@ -0,0 +1,81 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name, too-many-arguments
+"""Attention operator in CUDA"""
+import tvm
+from tvm import te
+
+from ..nn.attention import attention_row_ir, attention_scale
+from ..utils import ceil_div
+
+
+def attention(query, key, value, kv_length, scale=0.0, causal=False):
+    """Scaled dot product attention, computed with an online softmax.
+
+    A thread computes a query row. The threads of a block compute consecutive rows of the same
+    heads, so that they read the same keys and values at the same time.
+
+    Parameters
+    ----------
+    query : tvm.te.Tensor
+        4-D with shape [batch, heads, q_len, head_size]
+
+    key : tvm.te.Tensor
+        4-D with shape [batch, heads, kv_len, head_size]
+
+    value : tvm.te.Tensor
+        4-D with shape [batch, heads, kv_len, value_size]
+
+    kv_length : tvm.te.Tensor
+        0-D or 1-D with shape [batch], the number of valid positions of key and value.
+
+    scale : float
+        The scale of the scores. If zero, 1/sqrt(head_size) is used.
+
+    causal : bool
+        Whether the query i, at position kv_length - q_len + i, only attends to the keys up to
+        its position.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        4-D with shape [batch, heads, q_len, value_size]
+    """
+    batch, num_heads, q_len, _ = query.shape
+    scale = attention_scale(query, scale)
+    num_rows = batch * num_heads * q_len
+
+    def gen_ir(*bufs):
+        ib = tvm.tir.ir_builder.create()
+        max_threads = int(tvm.target.Target.current(allow_none=False).max_num_threads)
+        tx = te.thread_axis("threadIdx.x")
+        bx = te.thread_axis("blockIdx.x")
+        ib.scope_attr(tx, "thread_extent", max_threads)
+        ib.scope_attr(bx, "thread_extent", ceil_div(num_rows, max_threads))
+        row = bx * max_threads + tx
+        with ib.if_scope(row < num_rows):
+            attention_row_ir(ib, bufs, row, scale, causal)
+        return ib.get()
+
+    return te.extern(
+        [(batch, num_heads, q_len, value.shape[3])],
+        [query, key, value, kv_length],
+        lambda ins, outs: gen_ir(*ins, outs[0]),
+        dtype=query.dtype,
+        name="attention_gpu",
+        tag="attention_gpu",
+    )
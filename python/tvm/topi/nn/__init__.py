@@ -45,6 +45,7 @@ from .local_response_norm import *
 from .bitserial_conv2d import *
 from .bitserial_dense import *
 from .batch_matmul import *
+from .attention import attention
 from .batch_norm import *
 from .sparse import *
 from .pad import *
@@ -0,0 +1,153 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name, too-many-arguments, too-many-locals
+"""Attention operator"""
+import math
+
+from tvm import te, tir
+
+from ..utils import get_const_int
+
+
+def attention_row_ir(ib, bufs, row, scale, causal):
+    """Compute the attention of one query row with an online softmax.
+
+    The running maximum and sum of the exponentials of the scores are kept with the weighted sum
+    of the values, which is rescaled whenever the maximum grows, so that the keys and the values
+    are read once and the scores are never stored.
+
+    Parameters
+    ----------
+    ib : tvm.tir.ir_builder.IRBuilder
+        The IR builder.
+
+    bufs : tuple of tvm.tir.Buffer
+        The query, key, value, kv_length and output buffers.
+
+    row : tvm.tir.PrimExpr
+        The index of the row in the flattened (batch, heads, q_len) dimensions.
+
+    scale : float
+        The scale of the scores.
+
+    causal : bool
+        Whether the query only attends to the keys up to its position.
+    """
+    query, key, value, kv_length, out = bufs
+    _, num_heads, q_len, head_size = query.shape
+    kv_len = key.shape[2]
+    value_size = value.shape[3]
+
+    q = ib.buffer_ptr(query)
+    k = ib.buffer_ptr(key)
+    v = ib.buffer_ptr(value)
+    length_ptr = ib.buffer_ptr(kv_length)
+    o = ib.buffer_ptr(out)
+
+    bh = row // q_len
+    i = row % q_len
+    length = length_ptr[bh // num_heads] if len(kv_length.shape) == 1 else length_ptr[0]
+    length = te.min(length.astype("int32"), kv_len.astype("int32"))
+    end = te.min(length, length - q_len + i + 1) if causal else length
+
+    acc = ib.allocate("float32", (value_size,), name="acc", scope="local")
+    state = ib.allocate("float32", (4,), name="state", scope="local")
+    max_score, sum_exp, score, new_max = 0, 1, 2, 3
+    state[max_score] = tir.min_value("float32")
+    state[sum_exp] = tir.const(0, "float32")
+    with ib.for_range(0, value_size, "d") as d:
+        acc[d] = tir.const(0, "float32")
+
+    q_base = row * head_size
+    with ib.for_range(0, end, "j") as j:
+        k_base = (bh * kv_len + j) * head_size
+        v_base = (bh * kv_len + j) * value_size
+        state[score] = tir.const(0, "float32")
+        with ib.for_range(0, head_size, "d") as d:
+            state[score] += q[q_base + d].astype("float32") * k[k_base + d].astype("float32")
+        state[score] = state[score] * tir.const(scale, "float32")
+        state[new_max] = te.max(state[max_score], state[score])
+        correction = te.exp(state[max_score] - state[new_max])
+        weight = te.exp(state[score] - state[new_max])
+        state[sum_exp] = state[sum_exp] * correction + weight
+        with ib.for_range(0, value_size, "d") as d:
+            acc[d] = acc[d] * correction + weight * v[v_base + d].astype("float32")
+        state[max_score] = state[new_max]
+
+    o_base = row * value_size
+    with ib.for_range(0, value_size, "d") as d:
+        o[o_base + d] = tir.Select(
+            state[sum_exp] > 0, acc[d] / state[sum_exp], tir.const(0, "float32")
+        ).astype(out.dtype)
+
+
+def attention_scale(query, scale):
+    """Return the scale of the scores, 1/sqrt(head size) if scale is zero."""
+    if scale:
+        return float(scale)
+    return 1.0 / math.sqrt(get_const_int(query.shape[3]))
+
+
+def attention(query, key, value, kv_length, scale=0.0, causal=False):
+    """Scaled dot product attention, computed with an online softmax.
+
+    Only the first kv_length positions of key and value are read, so that they can be a
+    preallocated KV cache. The scores are not materialized.
+
+    Parameters
+    ----------
+    query : tvm.te.Tensor
+        4-D with shape [batch, heads, q_len, head_size]
+
+    key : tvm.te.Tensor
+        4-D with shape [batch, heads, kv_len, head_size]
+
+    value : tvm.te.Tensor
+        4-D with shape [batch, heads, kv_len, value_size]
+
+    kv_length : tvm.te.Tensor
+        0-D or 1-D with shape [batch], the number of valid positions of key and value.
+
+    scale : float
+        The scale of the scores. If zero, 1/sqrt(head_size) is used.
+
+    causal : bool
+        Whether the query i, at position kv_length - q_len + i, only attends to the keys up to
+        its position.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        4-D with shape [batch, heads, q_len, value_size]
+    """
+    batch, num_heads, q_len, _ = query.shape
+    scale = attention_scale(query, scale)
+
+    def gen_ir(*bufs):
+        ib = tir.ir_builder.create()
+        with ib.for_range(0, batch * num_heads * q_len, "row", kind="parallel") as row:
+            attention_row_ir(ib, bufs, row, scale, causal)
+        return ib.get()
+
+    return te.extern(
+        [(batch, num_heads, q_len, value.shape[3])],
+        [query, key, value, kv_length],
+        lambda ins, outs: gen_ir(*ins, outs[0]),
+        dtype=query.dtype,
+        name="attention",
+        tag="attention",
+    )
@@ -40,6 +40,7 @@ from .conv3d_transpose import *
 from .sparse import *
 from .conv2d_alter_op import *
 from .dense_alter_op import *
+from .qnn import *
 from .group_conv2d import *
 from .math_alter_op import *
 from .concat import *
@@ -22,7 +22,7 @@ from tvm import autotvm, relay, te
 from tvm.target.x86 import target_has_amx, target_has_avx512
 
 from .. import nn
-from ..nn import dense_alter_layout
+from ..nn import dense_alter_layout, qnn_dense_alter_layout
 from ..utils import get_const_tuple
 from .dense import _default_dense_pack_config
 
@@ -85,6 +85,17 @@ def _alter_dense_layout(attrs, inputs, tinfos, out_type):
     return None
 
 
+@qnn_dense_alter_layout.register("cpu")
+def _alter_qnn_dense_layout(_attrs, inputs, tinfos, out_type):
+    data_tensor, weight_tensor = tinfos[0], tinfos[1]
+
+    if check_int8_applicable(data_tensor, weight_tensor) and data_tensor.dtype == "uint8":
+        weight_layout = "NC16n4c"
+        return relay.qnn.op.contrib_dense_pack(*inputs, weight_layout, None, out_type.dtype)
+
+    return None
+
+
 def int8_int8_legalize(inputs, arg_types, op, attrs, need_expand=False):
     """Legalizes s8, s8 -> s32 GEMM op for VNNI."""
     if (
@@ -0,0 +1,199 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name,too-many-arguments
+"""x86 QNN operators"""
+
+import math
+
+import tvm
+from tvm import autotvm, te
+
+from .. import tag
+from ..utils import get_const_tuple, get_const_int, get_const_float, traverse_inline
+from .dense import dense_int8_compute, dense_int8_schedule
+
+
+def _is_scalar(expr):
+    """Return True if the expression is a constant scalar value."""
+    if isinstance(expr, te.Tensor):
+        return expr.ndim == 0 and isinstance(expr.op, te.ComputeOp) and isinstance(
+            expr.op.body[0], (tvm.tir.FloatImm, tvm.tir.IntImm)
+        )
+    return isinstance(expr, (tvm.tir.FloatImm, tvm.tir.IntImm))
+
+
+def _const_value(expr):
+    if isinstance(expr, te.Tensor):
+        expr = expr.op.body[0]
+    if isinstance(expr, tvm.tir.IntImm):
+        return get_const_int(expr)
+    return get_const_float(expr)
+
+
+def _is_zero(expr):
+    return _is_scalar(expr) and _const_value(expr) == 0
+
+
+def _qnn_param(param, n):
+    """Read a scalar or a per output channel quantization parameter."""
+    if isinstance(param, te.Tensor) and param.ndim == 1:
+        return param[n]
+    if isinstance(param, te.Tensor):
+        return param()
+    return param
+
+
+def _fixed_point_multiplier_shift(scale):
+    """Return the Q31 multiplier and the shift of the scale, as GetFixedPointMultiplierShift."""
+    if scale == 0:
+        return 0, 0
+    significand, exponent = math.frexp(scale)
+    significand = int(round(significand * (1 << 31)))
+    if significand == (1 << 31):
+        significand //= 2
+        exponent += 1
+    return significand, exponent
+
+
+def qnn_dense_pack_vnni(
+    data,
+    weight,
+    # Dense quantization params:
+    input_zero_point,
+    kernel_zero_point,
+    _input_scale,
+    _kernel_scale,
+    # bias
+    bias,
+    # Requantization params:
+    rq_input_scale,
+    rq_input_zero_point,
+    rq_output_scale,
+    rq_output_zero_point,
+    out_dtype,
+):
+    """Compute for qnn.contrib_dense_pack with the NC16n4c weight layout
+
+    The uint8 x int8 product is accumulated in int32 by the VNNI dot product of x86.dense_int8,
+    the zero points are applied to the accumulator afterwards:
+        sum((d - zd) * (w - zw)) = sum(d * w) - zw * sum(d) - zd * sum(w) + K * zd * zw
+
+    The zero point corrections, the bias and the requantization are computed in the epilogue of
+    the accumulator, and are inlined into the output loop by the schedule, so that no int32
+    intermediate tensor is written to memory. If the requantization scales are constant scalars,
+    the requantization uses the same fixed point multiplication as QNN canonicalization.
+    """
+    assert data.dtype == "uint8" and weight.dtype == "int8"
+    M, K = get_const_tuple(data.shape)
+    _, _, n_inner, k_inner = get_const_tuple(weight.shape)
+    assert n_inner == 16 and k_inner == 4
+
+    out = dense_int8_compute(None, data, weight)
+    N = out.shape[1]
+
+    correction = []
+    if not _is_zero(kernel_zero_point):
+        k = te.reduce_axis((0, K), name="k")
+        data_sum = te.compute(
+            (M,), lambda m: te.sum(data[m, k].astype("int32"), axis=k), name="data_sum"
+        )
+        correction.append(lambda m, n: _qnn_param(kernel_zero_point, n) * data_sum[m])
+    if not _is_zero(input_zero_point):
+        k = te.reduce_axis((0, K), name="k")
+        weight_sum = te.compute(
+            (N,),
+            lambda n: te.sum(
+                weight[
+                    tvm.tir.indexdiv(n, 16), tvm.tir.indexdiv(k, 4), n % 16, k % 4
+                ].astype("int32"),
+                axis=k,
+            ),
+            name="weight_sum",
+        )
+        correction.append(lambda m, n: _qnn_param(input_zero_point, n) * weight_sum[n])
+        if not _is_zero(kernel_zero_point):
+            correction.append(
+                lambda m, n: -K
+                * _qnn_param(input_zero_point, n)
+                * _qnn_param(kernel_zero_point, n)
+            )
+
+    def _accumulator(m, n):
+        value = out[m, n]
+        for term in correction:
+            value = value - term(m, n)
+        if bias is not None:
+            value = value + (bias[n] if bias.ndim == 1 else bias[0, n])
+        return value
+
+    out = te.compute(out.shape, _accumulator, name="qnn_dense_pack_acc", tag=tag.BROADCAST)
+
+    # Requantize output of qnn.contrib_dense_pack
+    if rq_input_scale is None or rq_output_scale is None:
+        return out
+
+    fixed_point = _is_scalar(rq_input_scale) and _is_scalar(rq_output_scale)
+    if fixed_point:
+        multiplier, shift = _fixed_point_multiplier_shift(
+            _const_value(rq_input_scale) / _const_value(rq_output_scale)
+        )
+
+    def _requantize(m, n):
+        value = out[m, n] - _qnn_param(rq_input_zero_point, n)
+        if fixed_point:
+            value = tvm.tir.q_multiply_shift(
+                value,
+                tvm.tir.const(multiplier, "int32"),
+                tvm.tir.const(31, "int32"),
+                tvm.tir.const(shift, "int32"),
+            )
+        else:
+            scale = _qnn_param(rq_input_scale, n) / _qnn_param(rq_output_scale, n)
+            value = te.round(scale * value.astype("float32")).astype("int32")
+        value = value + _qnn_param(rq_output_zero_point, n)
+        value = te.max(te.min(value, tvm.tir.max_value(out_dtype)), tvm.tir.min_value(out_dtype))
+        return value.astype(out_dtype)
+
+    return te.compute(out.shape, _requantize, name="requantize", tag=tag.BROADCAST)
+
+
+def schedule_qnn_dense_pack_vnni(outs):
+    """Schedule for qnn.contrib_dense_pack with the NC16n4c weight layout
+
+    The int32 accumulator is tensorized with the VNNI dot product, and its epilogue is computed at
+    the innermost tile of the output loop.
+
+    Parameters
+    ----------
+    outs: Array of Tensor
+          The computation graph description of qnn.contrib_dense_pack
+          in the format of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    outs = [outs] if isinstance(outs, te.tensor.Tensor) else outs
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if "dense_int8" in op.tag:
+            dense_int8_schedule(autotvm.FallbackConfigEntity(), s, op.output(0), outs[0])
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
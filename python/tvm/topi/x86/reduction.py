@@ -18,18 +18,54 @@
 """x86 declaration and schedules."""
 import tvm
 from tvm import te
+from tvm.target.x86 import get_simd_32bit_lanes
 from .injective import schedule_injective_from_existing
 from .. import tag
 from ..utils import get_const_tuple
 
 
+def _rfactor_vector_lanes(sch, out):
+    """Factor the innermost reduce axis of out by the SIMD width when it is contiguous.
+
+    The partial results of the factored stage are accumulated as a vector, and the vector is
+    combined into the output by the reduction intrinsics of the vectorized reduce axis.
+    Returns the factored tensor, or None when the reduction is not factored.
+    """
+    if tvm.target.Target.current(allow_none=True) is None:
+        return None
+    body = sch[out].op.body[0]
+    if not sch[out].op.reduce_axis or len(body.source) != 1:
+        return None
+    combiner = body.combiner.result[0]
+    if not isinstance(combiner, (tvm.tir.Add, tvm.tir.Mul, tvm.tir.Min, tvm.tir.Max)):
+        return None
+    k = sch[out].op.reduce_axis[-1]
+    lanes = get_simd_32bit_lanes()
+    source = body.source[0]
+    if (
+        not isinstance(source, tvm.tir.ProducerLoad)
+        or not source.indices
+        or not source.indices[-1].same_as(k.var)
+        or not isinstance(k.dom.extent, tvm.tir.IntImm)
+        or k.dom.extent.value % lanes != 0
+    ):
+        return None
+    _, ki = sch[out].split(k, factor=lanes)
+    rf = sch.rfactor(out, ki)
+    sch[rf].reorder(*sch[rf].op.axis[1:], *sch[rf].op.reduce_axis, sch[rf].op.axis[0])
+    sch[rf].vectorize(sch[rf].op.axis[0])
+    return rf
+
+
 def _schedule_reduce(sch, op, is_idx_reduce=False):
+    rf = None
     if is_idx_reduce:
         real_out = op.output(0)
         fused = sch[real_out].fuse(*sch[real_out].op.axis)
         out = op.input_tensors[0]
     else:
         out = op.output(0)
+        rf = _rfactor_vector_lanes(sch, out)
 
     const_shape = True
     out_shape = get_const_tuple(out.shape)
@@ -58,6 +94,10 @@ def _schedule_reduce(sch, op, is_idx_reduce=False):
             fused = sch[out].fuse(*sch[out].op.axis)
             sch[out].parallel(fused)
 
+    if rf is not None:
+        sch[rf].compute_at(sch[out], fused)
+        sch[out].vectorize(sch[out].op.reduce_axis[0])
+
 
 def schedule_reduce(outs):
     """X86 schedule for reduction op.
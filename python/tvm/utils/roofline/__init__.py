@@ -178,9 +178,12 @@ def roofline_from_existing(
             call["Bound"] = "compute" if compute_bound else "memory"
             per_mem_bound = (loaded_bytes / runtime) / peak_bandwidth * 100
             per_compute_bound = (flops / runtime) / peak_flops * 100.0
+            percent_optimal = per_compute_bound if compute_bound else per_mem_bound
             # We use ratio here because the percentages should be averaged instead of summed.
-            call["Percent of Theoretical Optimal"] = profiling.Ratio(
-                per_compute_bound if compute_bound else per_mem_bound
+            call["Percent of Theoretical Optimal"] = profiling.Ratio(percent_optimal)
+            # Time that would be saved if the call ran at its roofline.
+            call["Headroom (us)"] = profiling.Duration(
+                max(0.0, 1.0 - percent_optimal / 100.0) * runtime * 1e6
             )
             new_calls.append(call)
         else:
@@ -218,6 +221,14 @@ def roofline_analysis(
       - Arithmetic Intensity: ratio of FLOPs per byte of data.
       - FLOP/s: floating point operations per second.
       - Bandwidth: Number of bytes loaded per second.
+      - Headroom (us): time the operator would save if it ran at the
+        theoretical optimal. :py:meth:`Report.roofline_headroom` ranks
+        operators by it.
+
+    Peak FLOP/s and bandwidth are measured on the device unless the target
+    specifies them with the `peak_gflops` and `peak_bandwidth_gbps`
+    attributes, e.g. `cuda -arch=sm_80 -peak_gflops=19500
+    -peak_bandwidth_gbps=1555`.
 
     Parameters
     ----------
@@ -281,11 +281,14 @@ def estimate_peak_flops(
     has_tensorcore = nvcc.have_tensorcore(dev.compute_version)
     # assume that the first argument dtype is the same as all the others
     dtype = list(func.buffer_map.values())[0].dtype
+    peak_flops = registry.peak_from_target(target, "peak_gflops")
     if dtype == "float16" and has_tensorcore:
-        peak_flops = estimate_peak_flops_tensorcore(target, dev, remote)
+        if peak_flops is None:
+            peak_flops = estimate_peak_flops_tensorcore(target, dev, remote)
         name = "float16 tensorcore"
     else:
-        peak_flops = estimate_peak_flops_fma(target, dev, remote, dtype)
+        if peak_flops is None:
+            peak_flops = estimate_peak_flops_fma(target, dev, remote, dtype)
         name = f"{dtype} fma"
     flops = np.sum(
         features["float_addsub"]
@@ -403,5 +406,7 @@ def estimate_peak_bandwidth(
             if re.match(r"^B[0-9]+\.unique_bytes$", k) is not None
         ]
     )
-    peak_bandwidth = estimate_peak_bandwidth_global_mem(target, dev, remote)
+    peak_bandwidth = registry.peak_from_target(target, "peak_bandwidth_gbps")
+    if peak_bandwidth is None:
+        peak_bandwidth = estimate_peak_bandwidth_global_mem(target, dev, remote)
     return loaded_bytes, peak_bandwidth, "global"
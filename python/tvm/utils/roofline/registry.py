@@ -109,3 +109,25 @@ def estimate_peak_flops(
         Dtype/intrinsic used by `func` to achieve peak flops.
     """
     raise NotImplementedError()
+
+
+def peak_from_target(target: Target, attr: str) -> Optional[float]:
+    """Peak throughput the user specified in a target attribute.
+
+    Parameters
+    ----------
+    target : Target
+        Target to read the attribute from.
+    attr : str
+        Either `peak_gflops` or `peak_bandwidth_gbps`.
+
+    Returns
+    -------
+    peak : Optional[float]
+        The peak in FLOP/s or bytes/second, or None if `target` does not
+        specify it and the peak must be measured.
+    """
+    value = target.attrs.get(attr, None)
+    if value is None or int(value) <= 0:
+        return None
+    return float(int(value)) * 1e9
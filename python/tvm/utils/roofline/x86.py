@@ -207,9 +207,11 @@ def estimate_peak_fma_flops(
             + features["float_mad"] * 2
             + features["float_divmod"]
         )
-    peak_flops = estimate_peak_fma_vector_flops(
-        target, dev, remote, dtype, vec_width, num_vector_registers
-    )
+    peak_flops = registry.peak_from_target(target, "peak_gflops")
+    if peak_flops is None:
+        peak_flops = estimate_peak_fma_vector_flops(
+            target, dev, remote, dtype, vec_width, num_vector_registers
+        )
     return flops, peak_flops, f"{dtype} FMA"
 
 
@@ -324,7 +326,9 @@ def estimate_peak_bandwidth(
     # limited on the cache bandwidth. With the L1 cache we need an operation
     # that has a very low arithmetic intensity and we haven't come up with one
     # yet.
-    peak_bandwidth = estimate_peak_bandwidth_dram(target, dev, remote, vec_width)
+    peak_bandwidth = registry.peak_from_target(target, "peak_bandwidth_gbps")
+    if peak_bandwidth is None:
+        peak_bandwidth = estimate_peak_bandwidth_dram(target, dev, remote, vec_width)
     loaded_bytes = sum(
         [np.sum(x) for (k, x) in features.items() if re.match(r"^B[0-9]+\.bytes$", k) is not None]
     )
@@ -185,7 +185,13 @@ impl<'a> Tensor<'a> {
     pub fn to_vec<T: 'static + std::fmt::Debug + Clone>(&self) -> Vec<T> {
         assert!(self.is_contiguous());
         assert!(self.dtype.is_type::<T>());
-        unsafe { slice::from_raw_parts(self.data.as_ptr() as *const T, self.size).to_vec() }
+        unsafe {
+            slice::from_raw_parts(
+                self.data.as_ptr().offset(self.byte_offset) as *const T,
+                self.size,
+            )
+            .to_vec()
+        }
     }
 
     /// Returns `true` iff this `Tensor` is represented by a contiguous region of memory.
@@ -241,8 +247,20 @@ impl<'a> Tensor<'a> {
 
     /// Returns an owned version of this `Tensor` via cloning.
     pub fn to_owned(&self) -> Tensor<'static> {
+        let data = if self.byte_offset == 0 {
+            self.data.to_owned()
+        } else {
+            // Only copy the bytes of this `Tensor`, e.g. out of a storage shared with others.
+            let nbytes = self.size * self.dtype.itemsize();
+            let s = Storage::new(nbytes, Some(self.data.align())).unwrap();
+            unsafe {
+                s.as_mut_ptr()
+                    .copy_from_nonoverlapping(self.data.as_ptr().offset(self.byte_offset), nbytes);
+            }
+            s
+        };
         let t = Tensor {
-            data: self.data.to_owned(),
+            data,
             device: self.device,
             dtype: self.dtype,
             size: self.size,
@@ -42,6 +42,10 @@ pub enum GraphFormatError {
 #[error("Function {0} not found")]
 pub struct FunctionNotFound(pub String);
 
+#[derive(Debug, Error)]
+#[error("Cannot set input {0} without copying: {1}")]
+pub struct ZeroCopyError(pub String, pub String);
+
 #[derive(Debug, Error)]
 #[error("Pointer {0:?} invalid when freeing")]
 pub struct InvalidPointer(pub *mut u8);
@@ -17,9 +17,7 @@
  * under the License.
  */
 
-use std::{
-    cmp, collections::HashMap, convert::TryFrom, error::Error, iter::FromIterator, mem, str,
-};
+use std::{cmp, collections::HashMap, convert::TryFrom, error::Error, iter::FromIterator, str};
 
 use itertools::izip;
 use nom::{
@@ -33,7 +31,7 @@ use serde_json;
 
 use tvm_sys::ffi::{DLDataTypeCode_kDLFloat, DLDataTypeCode_kDLInt, DLDataTypeCode_kDLUInt};
 
-use tvm_sys::{ffi::DLTensor, ArgValue, DataType, Device, DeviceType};
+use tvm_sys::{ffi::DLTensor, packed_func::PackedFunc, ArgValue, DataType, Device, DeviceType};
 
 use crate::{errors::*, Module, Storage, Tensor};
 
@@ -180,19 +178,36 @@ impl<'a> TryFrom<&'a str> for Graph {
 ///
 /// println!("{:#?}", Array::try_from(output).unwrap());
 /// ```
+///
+/// The operators split their loops over the workers of the thread pool of the calling thread,
+/// see `TVMBackendParallelLaunch`, whose size is set by `TVM_NUM_THREADS`.
 pub struct GraphExecutor<'m, 't> {
     graph: Graph,
-    op_execs: Vec<Box<dyn Fn() + 'm>>,
+    op_execs: Vec<OpExec<'m>>,
+    /// The storage of each `storage_id`, which the entries are views of.
+    #[allow(unused)]
+    storages: Vec<Storage<'static>>,
     tensors: Vec<Tensor<'t>>,
 }
 
 unsafe impl<'m, 't> Send for GraphExecutor<'m, 't> {}
 
+/// An operator of the graph, with the arguments it is called with.
+struct OpExec<'m> {
+    func: &'m dyn PackedFunc,
+    func_name: String,
+    flatten_data: bool,
+    /// The entry of each argument.
+    entries: Vec<usize>,
+    args: Vec<DLTensor>,
+}
+
 impl<'m, 't> GraphExecutor<'m, 't> {
     pub fn new<M: 'm + Module>(graph: Graph, lib: &'m M) -> Result<Self, Box<dyn Error>> {
-        let tensors = Self::setup_storages(&graph)?;
+        let (storages, tensors) = Self::setup_storages(&graph)?;
         Ok(GraphExecutor {
             op_execs: Self::setup_op_execs(&graph, lib, &tensors)?,
+            storages,
             tensors,
             graph,
         })
@@ -200,14 +215,27 @@ impl<'m, 't> GraphExecutor<'m, 't> {
 
     /// Runs the computation graph.
     pub fn run(&mut self) {
-        self.op_execs.iter().for_each(|op_exec| {
-            op_exec();
-        });
+        for op in self.op_execs.iter() {
+            let args: Vec<ArgValue> = op.args.iter().map(|t| t.into()).collect();
+            if (op.func)(&args).is_err() {
+                panic!("Function {} failed to execute", op.func_name);
+            }
+        }
     }
 
     /// Allocates `Storages` for each `storage_id` and returns `Tensor`s to hold each output.
-    fn setup_storages<'a>(graph: &'a Graph) -> Result<Vec<Tensor<'t>>, Box<dyn Error>> {
+    ///
+    /// As in the C++ `GraphExecutor`, the entries with the same `storage_id` share its storage,
+    /// at the byte offsets given by the optional `storage_offset` attribute.
+    fn setup_storages<'a>(
+        graph: &'a Graph,
+    ) -> Result<(Vec<Storage<'static>>, Vec<Tensor<'t>>), Box<dyn Error>> {
         let storage_ids = graph.get_attr::<(String, Vec<usize>)>("storage_id")?.1;
+        let storage_offsets = match graph.get_attr::<(String, Vec<usize>)>("storage_offset") {
+            Ok((_, offsets)) => offsets,
+            Err(GraphFormatError::MissingAttr(..)) => vec![0; storage_ids.len()],
+            Err(err) => return Err(err.into()),
+        };
         let shapes = graph.get_attr::<(String, Vec<Vec<i64>>)>("shape")?.1;
         let dtypes = graph
             .get_attr::<(String, Vec<String>)>("dltype")?
@@ -227,38 +255,36 @@ impl<'m, 't> GraphExecutor<'m, 't> {
         for (i, &storage_id) in storage_ids.iter().enumerate() {
             let dtype_size = (dtypes[i].bits() * dtypes[i].lanes()) >> 3;
             let nbytes = dtype_size * shapes[i].iter().product::<i64>() as usize;
-            storage_num_bytes[storage_id] = cmp::max(nbytes, storage_num_bytes[storage_id]);
+            let end = storage_offsets[i] + nbytes;
+            storage_num_bytes[storage_id] = cmp::max(end, storage_num_bytes[storage_id]);
         }
 
-        let mut storages: Vec<Storage> = storage_num_bytes
+        let storages: Vec<Storage> = storage_num_bytes
             .into_iter()
             .map(|nbytes| Storage::new(nbytes, align))
             .collect::<Result<Vec<Storage>, std::alloc::LayoutError>>()?;
 
-        let tensors = izip!(storage_ids, shapes, dtypes)
-            .map(|(storage_id, shape, dtype)| {
-                let storage = storages[storage_id].view();
-                Tensor {
-                    data: mem::replace(&mut storages[storage_id], storage),
-                    device: Device::default(),
-                    dtype,
-                    size: shape.iter().product::<i64>() as usize,
-                    shape,
-                    strides: None,
-                    byte_offset: 0,
-                }
+        let tensors = izip!(storage_ids, storage_offsets, shapes, dtypes)
+            .map(|(storage_id, offset, shape, dtype)| Tensor {
+                data: storages[storage_id].view(),
+                device: Device::default(),
+                dtype,
+                size: shape.iter().product::<i64>() as usize,
+                shape,
+                strides: None,
+                byte_offset: offset as isize,
             })
             .collect();
 
-        Ok(tensors)
+        Ok((storages, tensors))
     }
 
-    /// Creates closures which represent the computation performed by this graph.
+    /// Looks up the functions of the operators of this graph, and their arguments.
     fn setup_op_execs<M: 'm + Module>(
         graph: &Graph,
         lib: &'m M,
         tensors: &[Tensor<'t>],
-    ) -> Result<Vec<Box<dyn Fn() + 'm>>, Box<dyn Error + 'static>> {
+    ) -> Result<Vec<OpExec<'m>>, Box<dyn Error + 'static>> {
         if !graph.node_row_ptr.is_some() {
             return Err(GraphFormatError::MissingField("node_row_ptr").into());
         }
@@ -285,32 +311,23 @@ impl<'m, 't> GraphExecutor<'m, 't> {
             let func = lib
                 .get_function(&attrs.func_name)
                 .ok_or_else(|| FunctionNotFound(attrs.func_name.clone()))?;
-            let arg_indices = node
+            let entries = node
                 .inputs
                 .iter()
                 .map(|entry| graph.entry_index(entry))
-                .chain((0..attrs.num_outputs).map(|oi| Ok(node_row_ptr[i] + oi)));
-
-            let dl_tensors: Vec<DLTensor> = arg_indices
-                .map(|idx| {
-                    let tensor = &tensors[idx?];
-                    Ok(if attrs.flatten_data {
-                        Tensor::as_dltensor(tensor, true /* flatten */)
-                    } else {
-                        DLTensor::from(tensor)
-                    })
-                })
-                .collect::<Result<Vec<DLTensor>, GraphFormatError>>()?
-                .into();
-            let op: Box<dyn Fn()> = Box::new(move || {
-                let args: Vec<ArgValue> = dl_tensors
-                    .iter()
-                    .map(|t| t.into())
-                    .collect::<Vec<ArgValue>>();
-                let err_str = format!("Function {} failed to execute", attrs.func_name);
-                func(&args).expect(&err_str);
+                .chain((0..attrs.num_outputs).map(|oi| Ok(node_row_ptr[i] + oi)))
+                .collect::<Result<Vec<usize>, GraphFormatError>>()?;
+            let args = entries
+                .iter()
+                .map(|&idx| tensors[idx].as_dltensor(attrs.flatten_data))
+                .collect();
+            op_execs.push(OpExec {
+                func,
+                func_name: attrs.func_name,
+                flatten_data: attrs.flatten_data,
+                entries,
+                args,
             });
-            op_execs.push(op);
         }
         Ok(op_execs)
     }
@@ -321,29 +338,62 @@ impl<'m, 't> GraphExecutor<'m, 't> {
         })
     }
 
-    #[allow(clippy::if_same_then_else)]
+    /// Copies `value` into the graph input with name `name`.
     pub fn set_input<S: AsRef<str>>(&mut self, name: S, value: Tensor) {
         if let Some(idx) = self.get_input_index(name.as_ref()) {
-            // TODO: consider `new_with_params` to avoid ever allocating
-            let ptr = self.tensors[idx].data.as_ptr();
-            let mut to_replace = self.tensors.iter_mut().filter(|t| t.data.as_ptr() == ptr);
-            let owner = to_replace.nth(0).unwrap();
-            if value.data.is_owned() {
-                // FIXME: for no-copy, need setup_op_execs to not capture tensor ptr
-                // mem::replace(&mut (*owner), value);
-                // to_replace.for_each(|t| {
-                //   panic!("replacing");
-                //   t.data = owner.data.view();
-                // });
-                owner.copy(&value);
-            } else {
-                owner.copy(&value);
-            }
+            self.tensors[idx].copy(&value);
         } else {
             println!("Unexpected input `{}`", name.as_ref());
         }
     }
 
+    /// Sets the graph input with name `name` to `value` without copying, the following runs
+    /// read the data borrowed by `value` in place.
+    ///
+    /// `value` must be contiguous, have the shape and the dtype of the input, and its data must
+    /// be aligned to the size of its elements. A later `set_input` of the same input copies
+    /// into the data of `value`.
+    pub fn set_input_zero_copy<S: AsRef<str>>(
+        &mut self,
+        name: S,
+        value: Tensor<'t>,
+    ) -> Result<(), ZeroCopyError> {
+        let name = name.as_ref();
+        let err = |msg: String| ZeroCopyError(name.to_string(), msg);
+        let idx = self
+            .get_input_index(name)
+            .ok_or_else(|| err("no such input".to_string()))?;
+        let input = &self.tensors[idx];
+        if value.dtype != input.dtype || value.shape != input.shape {
+            return Err(err(format!(
+                "expected shape {:?} and dtype {}, got shape {:?} and dtype {}",
+                input.shape, input.dtype, value.shape, value.dtype
+            )));
+        }
+        if !value.is_contiguous() {
+            return Err(err("the tensor is not contiguous".to_string()));
+        }
+        let nbytes = value.size * value.dtype.itemsize();
+        if value.byte_offset < 0 || value.byte_offset as usize + nbytes > value.data.size() {
+            return Err(err("the data is smaller than the tensor".to_string()));
+        }
+        let ptr = unsafe { value.data.as_ptr().offset(value.byte_offset) };
+        if ptr as usize % cmp::max(1, value.dtype.itemsize()) != 0 {
+            return Err(err(format!("the data {:?} is not aligned", ptr)));
+        }
+
+        self.tensors[idx] = value;
+        let tensors = &self.tensors;
+        for op in self.op_execs.iter_mut() {
+            for (arg, &entry) in op.args.iter_mut().zip(op.entries.iter()) {
+                if entry == idx {
+                    *arg = tensors[idx].as_dltensor(op.flatten_data);
+                }
+            }
+        }
+        Ok(())
+    }
+
     /// Returns the graph input with name `name`, if it exists.
     pub fn get_input<S: AsRef<str>>(&mut self, name: S) -> Option<&Tensor> {
         self.get_input_index(name.as_ref())
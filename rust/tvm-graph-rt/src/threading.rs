@@ -30,6 +30,7 @@ use std::{
 use std::env;
 
 use crossbeam_channel::{bounded, Receiver, Sender};
+use lazy_static::lazy_static;
 use tvm_sys::ffi::TVMParallelGroupEnv;
 
 pub(crate) type FTVMParallelLambda =
@@ -59,10 +60,8 @@ impl Job {
             .map(move |i| Task {
                 id: i,
                 flambda: self.cb,
-                penv: TVMParallelGroupEnv {
-                    sync_handle: &Arc::clone(&barrier) as *const _ as *mut c_void,
-                    num_task: num_tasks as i32,
-                },
+                num_tasks,
+                barrier: Arc::clone(&barrier),
                 cdata: self.cdata,
                 pending: Arc::clone(&self.pending),
             })
@@ -81,7 +80,9 @@ impl Job {
 struct Task {
     id: usize,
     flambda: FTVMParallelLambda,
-    penv: TVMParallelGroupEnv,
+    num_tasks: usize,
+    /// The barrier shared by the tasks of a `Job`, which `penv` points to while the task runs.
+    barrier: Arc<Barrier>,
     cdata: *const c_void,
     pending: Arc<AtomicUsize>,
 }
@@ -90,7 +91,11 @@ unsafe impl Sync for Task {}
 
 impl Task {
     fn run(self) -> i32 {
-        let status = (self.flambda)(self.id, &self.penv as *const _, self.cdata);
+        let penv = TVMParallelGroupEnv {
+            sync_handle: &self.barrier as *const Arc<Barrier> as *mut c_void,
+            num_task: self.num_tasks as i32,
+        };
+        let status = (self.flambda)(self.id, &penv as *const _, self.cdata);
         self.pending.fetch_sub(1, Ordering::AcqRel);
         status
     }
@@ -127,9 +132,14 @@ struct ThreadPool {
 
 thread_local!(static THREAD_POOL: ThreadPool = ThreadPool::new());
 
+lazy_static! {
+    /// The number of threads of the pools, read once rather than at every parallel launch.
+    static ref MAX_CONCURRENCY: usize = max_concurrency();
+}
+
 impl ThreadPool {
     fn new() -> Self {
-        let num_workers = max_concurrency();
+        let num_workers = *MAX_CONCURRENCY;
         ThreadPool {
             num_workers,
             threads: Threads::launch(num_workers, ThreadPool::run_worker),
@@ -184,7 +194,7 @@ pub extern "C" fn TVMBackendParallelLaunch(
     cdata: *const c_void,
     num_task: usize,
 ) -> c_int {
-    if max_concurrency() < 2 {
+    if *MAX_CONCURRENCY < 2 {
         let penv = TVMParallelGroupEnv {
             sync_handle: std::ptr::null_mut(),
             num_task: 1,
@@ -209,6 +219,10 @@ pub unsafe extern "C" fn TVMBackendParallelBarrier(
     _task_id: usize,
     penv: *const TVMParallelGroupEnv,
 ) {
+    if (*penv).sync_handle.is_null() {
+        // The job runs in a single task.
+        return;
+    }
     let barrier: &Arc<Barrier> = &*((*penv).sync_handle as *const Arc<Barrier>);
     barrier.wait();
 }
@@ -59,7 +59,6 @@ fn main() {
         &fs::read_to_string(concat!(env!("OUT_DIR"), "/test_nn/graph.json")).unwrap(),
     )
     .unwrap();
-    let mut exec = GraphExecutor::new(graph, &syslib).unwrap();
 
     let x = Array::from_shape_vec(
         (BATCH_SIZE, IN_DIM),
@@ -84,6 +83,11 @@ fn main() {
     let expected_o0 = &left + 1f32;
     let expected_o1 = &right - 1f32;
 
+    // The input of the second run, which the executor reads in place.
+    let x2 = &x * 2f32;
+    let dense2 = x2.dot(&w.t()) + &b;
+
+    let mut exec = GraphExecutor::new(graph, &syslib).unwrap();
     exec.load_params(params);
     exec.set_input("data", (&x).into());
 
@@ -96,4 +100,11 @@ fn main() {
     check_sum!(exec, 0, expected_o0);
     check_sum!(exec, 1, expected_o1);
     check_sum!(exec, 2, dense);
+
+    exec.set_input_zero_copy("data", (&x2).into()).unwrap();
+    check_sum!(exec, data, x2);
+
+    exec.run();
+
+    check_sum!(exec, 2, dense2);
 }
@@ -21,15 +21,72 @@
  * \file tvm/arith/analyzer.cc
  */
 #include <tvm/arith/analyzer.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/tir/analysis.h>
 #include <tvm/tir/expr.h>
 #include <tvm/tir/op.h>
 
+#include <unordered_map>
+
+#include "../support/utils.h"
 #include "product_normal_form.h"
 
 namespace tvm {
 namespace arith {
 
+/*!
+ * \brief The results of Simplify and const_int_bound memoized across calls.
+ *
+ * A result is only valid under the constraints it was computed with, so the
+ * identifier of the constraint scope is part of the key. A Simplify result is
+ * also keyed on the steps and the enabled rewrite extensions.
+ */
+class Analyzer::Cache {
+ public:
+  struct Key {
+    PrimExpr expr;
+    int64_t scope;
+    int64_t tag;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      uint64_t hash = StructuralHash()(key.expr);
+      hash = support::HashCombine(hash, key.scope);
+      return support::HashCombine(hash, key.tag);
+    }
+  };
+
+  struct KeyEqual {
+    bool operator()(const Key& lhs, const Key& rhs) const {
+      return lhs.scope == rhs.scope && lhs.tag == rhs.tag &&
+             tir::ExprDeepEqual()(lhs.expr, rhs.expr);
+    }
+  };
+
+  template <typename T>
+  using Map = std::unordered_map<Key, T, KeyHash, KeyEqual>;
+
+  explicit Cache(size_t max_entries) : max_entries(max_entries) {}
+
+  /*! \brief Insert a result, emptying the map first if it is full. */
+  template <typename T>
+  static void Insert(Map<T>* map, size_t max_entries, Key key, T value) {
+    if (map->size() >= max_entries) {
+      map->clear();
+    }
+    map->emplace(std::move(key), std::move(value));
+  }
+
+  /*! \brief The number of results kept in each map. */
+  size_t max_entries;
+  /*! \brief The results of Simplify. */
+  Map<PrimExpr> simplify;
+  /*! \brief The results of const_int_bound. */
+  Map<ConstIntBound> const_int_bound;
+};
+
 Analyzer::Analyzer()
     : const_int_bound(this),
       modular_set(this),
@@ -37,7 +94,40 @@ Analyzer::Analyzer()
       canonical_simplify(this),
       int_set(this) {}
 
+Analyzer::~Analyzer() = default;
+
+void Analyzer::EnableCache(size_t max_entries) {
+  ICHECK_GT(max_entries, 0U) << "ValueError: The cache must hold at least one result";
+  cache_ = std::make_unique<Cache>(max_entries);
+}
+
+void Analyzer::ClearCache() {
+  if (cache_ != nullptr) {
+    cache_->simplify.clear();
+    cache_->const_int_bound.clear();
+  }
+}
+
+/*! \brief Whether a query on expr is too cheap to be worth a lookup. */
+static bool IsTrivialQuery(const PrimExpr& expr) {
+  return expr->IsInstance<IntImmNode>() || expr->IsInstance<tir::VarNode>();
+}
+
+Optional<ConstIntBound> Analyzer::LookupCachedBound(const PrimExpr& expr) const {
+  if (cache_ == nullptr || IsTrivialQuery(expr)) return NullOpt;
+  auto it = cache_->const_int_bound.find(Cache::Key{expr, constraint_scope_, -1});
+  if (it == cache_->const_int_bound.end()) return NullOpt;
+  return it->second;
+}
+
+void Analyzer::CacheBound(const PrimExpr& expr, const ConstIntBound& bound) {
+  if (cache_ == nullptr || IsTrivialQuery(expr)) return;
+  Cache::Insert(&cache_->const_int_bound, cache_->max_entries,
+                Cache::Key{expr, constraint_scope_, -1}, bound);
+}
+
 void Analyzer::Bind(const Var& var, const PrimExpr& expr, bool allow_override) {
+  this->ClearCache();
   PrimExpr new_expr = expr;
   new_expr = this->canonical_simplify(new_expr);
   new_expr = this->rewrite_simplify(new_expr);
@@ -55,6 +145,7 @@ void Analyzer::Bind(const Var& var, const Range& range, bool allow_override) {
   if (tir::is_one(range->extent)) {
     this->Bind(var, range->min, allow_override);
   } else {
+    this->ClearCache();
     this->const_int_bound.Bind(var, range, allow_override);
     this->int_set.Bind(var, range, allow_override);
     this->transitive_comparisons.Bind(var, range, allow_override);
@@ -71,7 +162,12 @@ void Analyzer::Bind(const Map<Var, Range>& variables, bool allow_override) {
 
 void ConstraintContext::EnterWithScope() {
   ICHECK(recovery_functions_.size() == 0);
-  // entering the scope.
+  // entering the scope, under a fresh identifier for the memoized results.
+  int64_t outer_scope = analyzer_->constraint_scope_;
+  analyzer_->constraint_scope_ = ++analyzer_->num_constraint_scopes_;
+  Analyzer* analyzer = analyzer_;
+  recovery_functions_.push_back(
+      [analyzer, outer_scope]() { analyzer->constraint_scope_ = outer_scope; });
   recovery_functions_.push_back(analyzer_->const_int_bound.EnterConstraint(constraint_));
   recovery_functions_.push_back(analyzer_->modular_set.EnterConstraint(constraint_));
   recovery_functions_.push_back(analyzer_->rewrite_simplify.EnterConstraint(constraint_));
@@ -180,6 +276,22 @@ bool Analyzer::CanProve(const PrimExpr& expr, ProofStrength strength) {
 }
 
 PrimExpr Analyzer::Simplify(const PrimExpr& expr, int steps) {
+  if (cache_ == nullptr || IsTrivialQuery(expr)) {
+    return SimplifyNoCache(expr, steps);
+  }
+  int64_t tag = (static_cast<int64_t>(steps) << 32) |
+                static_cast<int64_t>(this->rewrite_simplify.GetEnabledExtensions());
+  Cache::Key key{expr, constraint_scope_, tag};
+  auto it = cache_->simplify.find(key);
+  if (it != cache_->simplify.end()) {
+    return it->second;
+  }
+  PrimExpr res = SimplifyNoCache(expr, steps);
+  Cache::Insert(&cache_->simplify, cache_->max_entries, std::move(key), res);
+  return res;
+}
+
+PrimExpr Analyzer::SimplifyNoCache(const PrimExpr& expr, int steps) {
   PrimExpr res = expr;
 
   // Always starts with a canonical simplification, as some structural property
@@ -259,6 +371,14 @@ TVM_REGISTER_GLOBAL("arith.CreateAnalyzer").set_body([](TVMArgs args, TVMRetValu
     } else if (name == "can_prove_equal") {
       return PackedFunc(
           [self](TVMArgs args, TVMRetValue* ret) { *ret = self->CanProveEqual(args[0], args[1]); });
+    } else if (name == "enable_cache") {
+      return PackedFunc([self](TVMArgs args, TVMRetValue* ret) {
+        int64_t max_entries = args[0];
+        ICHECK_GT(max_entries, 0) << "ValueError: The cache must hold at least one result";
+        self->EnableCache(static_cast<size_t>(max_entries));
+      });
+    } else if (name == "clear_cache") {
+      return PackedFunc([self](TVMArgs args, TVMRetValue* ret) { self->ClearCache(); });
     }
     return PackedFunc();
   };
@@ -710,8 +710,17 @@ class ConstIntBoundAnalyzer::Impl
 };
 
 ConstIntBound ConstIntBoundAnalyzer::operator()(const PrimExpr& expr) const {
+  if (parent_ != nullptr) {
+    if (Optional<ConstIntBound> cached = parent_->LookupCachedBound(expr)) {
+      return cached.value();
+    }
+  }
   Entry ret = impl_->VisitExpr(expr);
-  return ConstIntBound(ret.min_value, ret.max_value);
+  ConstIntBound bound(ret.min_value, ret.max_value);
+  if (parent_ != nullptr) {
+    parent_->CacheBound(expr, bound);
+  }
+  return bound;
 }
 
 ConstIntBound ConstIntBoundAnalyzer::operator()(const PrimExpr& expr, BoundMapType* bound) {
@@ -722,10 +731,12 @@ ConstIntBound ConstIntBoundAnalyzer::operator()(const PrimExpr& expr, BoundMapTy
 }
 
 void ConstIntBoundAnalyzer::Update(const Var& var, const ConstIntBound& info, bool allow_override) {
+  if (parent_ != nullptr) parent_->ClearCache();
   impl_->Update(var, info, allow_override);
 }
 
 void ConstIntBoundAnalyzer::Bind(const Var& var, const Range& range, bool allow_override) {
+  if (parent_ != nullptr) parent_->ClearCache();
   impl_->Bind(var, range, allow_override);
 }
 
@@ -733,7 +744,8 @@ std::function<void()> ConstIntBoundAnalyzer::EnterConstraint(const PrimExpr& con
   return impl_->EnterConstraint(constraint);
 }
 
-ConstIntBoundAnalyzer::ConstIntBoundAnalyzer(Analyzer* parent) : impl_(new Impl()) {}
+ConstIntBoundAnalyzer::ConstIntBoundAnalyzer(Analyzer* parent)
+    : parent_(parent), impl_(new Impl()) {}
 
 ConstIntBoundAnalyzer::~ConstIntBoundAnalyzer() { delete impl_; }
 
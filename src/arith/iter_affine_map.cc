@@ -400,6 +400,21 @@ class IterMapRewriter : public ExprMutator {
     }
   };
 
+  // hash and equality of pairs of expressions on their structure, for proof memoization.
+  struct ExprPairHash {
+    size_t operator()(const std::pair<PrimExpr, PrimExpr>& value) const {
+      return support::HashCombine(StructuralHash()(value.first), StructuralHash()(value.second));
+    }
+  };
+
+  struct ExprPairEqual {
+    bool operator()(const std::pair<PrimExpr, PrimExpr>& lhs,
+                    const std::pair<PrimExpr, PrimExpr>& rhs) const {
+      tir::ExprDeepEqual equal;
+      return equal(lhs.first, rhs.first) && equal(lhs.second, rhs.second);
+    }
+  };
+
   static bool IterSplitEqual(const IterSplitExpr& lhs, const IterSplitExpr& rhs,
                              bool check_scale = true) {
     tir::ExprDeepEqual equal;
@@ -503,6 +518,11 @@ class IterMapRewriter : public ExprMutator {
   std::unordered_map<IterSumExpr, IterSumExpr, IterSumHash, IterSumEqual> flattened_map_;
   // The flattened forms of constrained iters
   std::vector<IterSumExpr> constrained_iters_flattened_;
+  // The memoized results of CanProveEqual and CanProveDivisible on symbolic operands.
+  std::unordered_map<std::pair<PrimExpr, PrimExpr>, bool, ExprPairHash, ExprPairEqual>
+      equal_proofs_;
+  std::unordered_map<std::pair<PrimExpr, PrimExpr>, bool, ExprPairHash, ExprPairEqual>
+      divisible_proofs_;
 
   /*!
    * \brief Look for a split in splits that is not used such that its lower_factor is smallest.
@@ -552,7 +572,7 @@ class IterMapRewriter : public ExprMutator {
       size_t j = 0;
       for (; j < splits.size(); ++j) {
         if (used[j]) continue;
-        if (!used[j] && analyzer_->CanProveEqual(splits[j]->lower_factor, expected_lower_factor)) {
+        if (!used[j] && CanProveEqual(splits[j]->lower_factor, expected_lower_factor)) {
           break;
         }
       }
@@ -581,7 +601,7 @@ class IterMapRewriter : public ExprMutator {
     auto pad_mark_it = padded_origin_map_.find(mark);
     bool has_padding = pad_mark_it != padded_origin_map_.end();
 
-    bool match_full_iter = analyzer_->CanProveEqual(expected_lower_factor, mark->extent);
+    bool match_full_iter = CanProveEqual(expected_lower_factor, mark->extent);
     bool match_iter_divisor =
         match_full_iter || CanProveDivisible(mark->extent, expected_lower_factor);
 
@@ -621,7 +641,7 @@ class IterMapRewriter : public ExprMutator {
         if (splits.size() != 1) {
           ErrorLogger(this) << "Dependent iterations on padding iter space";
           return Array<IterSplitExpr>();
-        } else if (analyzer_->CanProveEqual(splits[0]->extent, expected_lower_factor) &&
+        } else if (CanProveEqual(splits[0]->extent, expected_lower_factor) &&
                    !analyzer_->CanProve(extent_before_padding >= expected_lower_factor)) {
           ErrorLogger(this) << "Split on padding iteration is not surjective "
                             << "if the split extent equals to the full iter space extent";
@@ -840,7 +860,7 @@ class IterMapRewriter : public ExprMutator {
       if (match_source.defined() && !match_source.same_as(expr->args[j]->source)) continue;
       const PrimExpr& cur_scale = expr->args[j]->scale;
       // for bijective mapping, the matched scale must equal to expected scale
-      if (analyzer_->CanProveEqual(cur_scale, expected_scale)) {
+      if (CanProveEqual(cur_scale, expected_scale)) {
         if (is_one(expr->args[j]->extent)) return j;
         // if extent is not one and there is a possible extent=1 split
         // further out, we need to extent the search
@@ -966,7 +986,7 @@ class IterMapRewriter : public ExprMutator {
         IterSplitExpr lhs_iter = expr->args[matched_index];
         ICHECK(rhs_iter->source.same_as(lhs_iter->source));
         PrimExpr lhs_lower_factor = MulAndNormalize(rhs_iter->lower_factor, rhs_iter->extent);
-        if (!analyzer_->CanProveEqual(lhs_iter->lower_factor, lhs_lower_factor)) break;
+        if (!CanProveEqual(lhs_iter->lower_factor, lhs_lower_factor)) break;
         // all patterns match
         visited[matched_index] = true;
         // Update rhs iter to result, only update of extent is necessary
@@ -1061,7 +1081,7 @@ class IterMapRewriter : public ExprMutator {
           size_t k = 0;
           for (; k < expr->args.size(); ++k) {
             if (!visited[k] && IterSplitEqual(expr->args[k], *it, false)) {
-              if (analyzer_->CanProveEqual((*it)->scale * matched_scale, expr->args[k]->scale))
+              if (CanProveEqual((*it)->scale * matched_scale, expr->args[k]->scale))
                 break;
             }
           }
@@ -1110,7 +1130,7 @@ class IterMapRewriter : public ExprMutator {
     auto it = sum_fuse_map_.find(flattened_form);
     if (it != sum_fuse_map_.end()) {
       // old iter
-      if (!analyzer_->CanProveEqual(expected_extra_base, it->second.offset * base_scale)) {
+      if (!CanProveEqual(expected_extra_base, it->second.offset * base_scale)) {
         // the extra offset is not consistent with old
         return NullOpt;
       }
@@ -1127,6 +1147,26 @@ class IterMapRewriter : public ExprMutator {
 
   bool CanProveDivisible(const PrimExpr& lhs, const PrimExpr& rhs);
 
+  /*!
+   * \brief Whether lhs == rhs can be proved, memoizing the proofs on symbolic operands.
+   *
+   * Deep chains of fused and split iterators compare the same scales, extents and lower
+   * factors many times, and each analyzer proof simplifies the difference from scratch.
+   * The analyzer is not updated while rewriting, so a proof holds for the whole detection.
+   */
+  bool CanProveEqual(const PrimExpr& lhs, const PrimExpr& rhs) {
+    const auto* clhs = lhs.as<IntImmNode>();
+    const auto* crhs = rhs.as<IntImmNode>();
+    if (clhs && crhs) return clhs->value == crhs->value;
+    if (lhs.same_as(rhs)) return true;
+    std::pair<PrimExpr, PrimExpr> key(lhs, rhs);
+    auto it = equal_proofs_.find(key);
+    if (it != equal_proofs_.end()) return it->second;
+    bool result = analyzer_->CanProveEqual(lhs, rhs);
+    equal_proofs_.emplace(std::move(key), result);
+    return result;
+  }
+
   PrimExpr SplitFloorDivConst(IterSplitExpr lhs, PrimExpr base, PrimExpr rhs);
   PrimExpr SplitFloorModConst(IterSplitExpr lhs, PrimExpr base, PrimExpr rhs);
 
@@ -1976,13 +2016,18 @@ bool IterMapRewriter::CanProveDivisible(const PrimExpr& lhs, const PrimExpr& rhs
   } else if (clhs && crhs) {
     return clhs->value % crhs->value == 0;
   }
+  std::pair<PrimExpr, PrimExpr> key(lhs, rhs);
+  auto it = divisible_proofs_.find(key);
+  if (it != divisible_proofs_.end()) return it->second;
 
   IterMapToExprNormalizer normalizer(analyzer_);
   PrimExpr dividend = normalizer.Convert(lhs);
   PrimExpr divisor = normalizer.Convert(rhs);
 
-  return analyzer_->CanProveEqual(dividend, divisor) ||
-         analyzer_->CanProve(floormod(dividend, divisor) == 0);
+  bool result =
+      CanProveEqual(dividend, divisor) || analyzer_->CanProve(floormod(dividend, divisor) == 0);
+  divisible_proofs_.emplace(std::move(key), result);
+  return result;
 }
 
 PrimExpr NormalizeIterMapToExpr(const PrimExpr& expr) {
@@ -35,9 +35,14 @@
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/topi/transform.h>
 
+#include <dmlc/json.h>
+
 #include <algorithm>
 #include <cstdint>
+#include <list>
+#include <mutex>
 #include <queue>
+#include <sstream>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -680,8 +685,73 @@ void CheckComputeValidity(const te::Schedule& sch) {
   }
 }
 
+/*!
+ * \brief A bounded memo of the states returned by ComputeDAG::InferBound. The bounds of a state
+ * only depend on its transform steps, and the same steps come back many times during a search,
+ * e.g. the measured states seeded into every round, or the states the evolutionary search keeps
+ * without mutation. The least recently used states are evicted first.
+ */
+class InferBoundMemo {
+ public:
+  explicit InferBoundMemo(size_t capacity) : capacity_(capacity) {}
+
+  /*! \brief The key of a state, i.e. the record of its transform steps */
+  static std::string Key(const Array<Step>& transform_steps) {
+    std::ostringstream os;
+    dmlc::JSONWriter writer(&os);
+    writer.BeginArray(false);
+    for (const auto& step : transform_steps) {
+      writer.WriteArraySeperator();
+      writer.BeginArray(false);
+      step->WriteToRecord(&writer);
+      writer.EndArray();
+    }
+    writer.EndArray();
+    return os.str();
+  }
+
+  Optional<State> Get(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return NullOpt;
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+  }
+
+  void Put(const std::string& key, const State& state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+    entries_.emplace_front(key, state);
+    index_.emplace(key, entries_.begin());
+    if (entries_.size() > capacity_) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+  }
+
+ private:
+  using Entry = std::pair<std::string, State>;
+  /*! \brief The maximum number of states kept */
+  size_t capacity_;
+  /*! \brief The states, from the most to the least recently used */
+  std::list<Entry> entries_;
+  /*! \brief The position of each key in `entries_` */
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  std::mutex mutex_;
+};
+
+/*! \brief The number of states each ComputeDAG memoizes the bounds of */
+constexpr size_t kInferBoundMemoCapacity = 4096;
+
 ComputeDAG::ComputeDAG(Array<te::Tensor> tensors) {
   auto node = make_object<ComputeDAGNode>();
+  node->infer_bound_memo = std::make_shared<InferBoundMemo>(kInferBoundMemoCapacity);
   node->tensors = std::move(tensors);
   node->access_analyzer = AccessAnalyzer(node->tensors);
 
@@ -706,6 +776,7 @@ ComputeDAG::ComputeDAG(Array<te::Tensor> tensors) {
 
 ComputeDAG::ComputeDAG(const te::Schedule& sch) {
   auto node = make_object<ComputeDAGNode>();
+  node->infer_bound_memo = std::make_shared<InferBoundMemo>(kInferBoundMemoCapacity);
 
   // Make sure it is a valid compute definition
   CheckComputeValidity(sch);
@@ -1309,6 +1380,15 @@ String ComputeDAG::PrintDAG(bool simple_mode) const {
 State ComputeDAG::InferBound(const State& state) const {
   ICHECK(state->concrete) << "Only concrete state can be processed to get bound info.";
 
+  InferBoundMemo* memo = operator->()->infer_bound_memo.get();
+  std::string memo_key;
+  if (memo != nullptr) {
+    memo_key = InferBoundMemo::Key(state->transform_steps);
+    if (Optional<State> memoized = memo->Get(memo_key)) {
+      return memoized.value();
+    }
+  }
+
   State ret_state;
   StateNode* pstate;
 
@@ -1364,6 +1444,9 @@ State ComputeDAG::InferBound(const State& state) const {
         i, Stage(stage->op, stage->op_type, new_iters, stage->compute_at, stage->attrs));
   }
 
+  if (memo != nullptr) {
+    memo->Put(memo_key, ret_state);
+  }
   return ret_state;
 }
 
@@ -37,10 +37,17 @@
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <dmlc/json.h>
+
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstring>
+#include <list>
+#include <mutex>
 #include <numeric>
+#include <sstream>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -1116,6 +1123,11 @@ class PerStoreFeatureExtractor : public StmtExprVisitor {
 // shifted log to incorporate the property that log2p(0) = 0
 inline float log2p(float x) { return x < 0 ? -std::log2(-x + 1) : std::log2(x + 1); }
 
+// The number of features of one store, see the section totals in GetPerStoreFeatureName
+inline size_t GetPerStoreFeatureRowLength(int max_n_bufs) {
+  return 57 + 18 * static_cast<size_t>(max_n_bufs) + ARITH_INTENSITY_CURVE_SAMPLE_N + 4 + 3;
+}
+
 void GetPerStoreFeature(const PrimFunc& func, int cache_line_size, int max_n_bufs,
                         std::vector<float>* ret, bool log_scale) {
   PerStoreFeatureExtractor extractor(cache_line_size, func->buffer_map);
@@ -1123,6 +1135,8 @@ void GetPerStoreFeature(const PrimFunc& func, int cache_line_size, int max_n_buf
 
   auto slog = log_scale ? log2p : [](float x) { return x; };
 
+  ret->reserve(ret->size() + 1 +
+               GetPerStoreFeatureRowLength(max_n_bufs) * extractor.buffer_features.size());
   ret->push_back(extractor.buffer_features.size());
 
   for (const auto& x : extractor.buffer_features) {
@@ -1360,8 +1374,9 @@ void GetPerStoreFeatureName(int max_n_bufs, std::vector<std::string>* ret) {
   // section total : 3
 }
 
-void GetPerStoreFeaturesWorkerFunc(const SearchTask& task, const State& state, int max_n_bufs,
-                                   std::vector<float>* feature, std::atomic<int>* error_ct) {
+// Lower a state and extract its features, `feature` is left empty if the lowering fails
+void ExtractPerStoreFeatures(const SearchTask& task, const State& state, int max_n_bufs,
+                             std::vector<float>* feature, std::atomic<int>* error_ct) {
   auto [sch, tensors] = task->compute_dag.ApplySteps(state->transform_steps);
 
   // When inlining, replace const matrices with const values.
@@ -1421,6 +1436,107 @@ void GetPerStoreFeaturesWorkerFunc(const SearchTask& task, const State& state, i
   }
 }
 
+/*!
+ * \brief A bounded cache of the features of the states, so that a state is lowered once even
+ * though the search predicts it many times, e.g. the states the evolutionary search keeps across
+ * generations. The least recently used states are evicted first.
+ */
+class PerStoreFeatureCache {
+ public:
+  static PerStoreFeatureCache* Global() {
+    static PerStoreFeatureCache* inst = new PerStoreFeatureCache(kCapacity);
+    return inst;
+  }
+
+  /*! \brief The key of a state, i.e. everything its lowering and its features depend on */
+  static std::string Key(const SearchTask& task, const State& state, int max_n_bufs) {
+    auto pass_ctx = tvm::transform::PassContext::Current();
+    bool disable_vectorize =
+        pass_ctx->GetConfig<Bool>("tir.disable_vectorize", Bool(false)).value();
+    bool instrument_bound_checkers =
+        pass_ctx->GetConfig<Bool>("tir.instrument_bound_checkers", Bool(false)).value();
+    std::ostringstream os;
+    // The entry holds the DAG, so that its address is not reused by another DAG meanwhile
+    os << task->compute_dag.get() << ' ' << task->target->str() << ' '
+       << task->hardware_params->cache_line_bytes << ' ' << max_n_bufs << ' ' << disable_vectorize
+       << ' ' << instrument_bound_checkers << ' ';
+    dmlc::JSONWriter writer(&os);
+    writer.BeginArray(false);
+    for (const auto& step : state->transform_steps) {
+      writer.WriteArraySeperator();
+      writer.BeginArray(false);
+      step->WriteToRecord(&writer);
+      writer.EndArray();
+    }
+    writer.EndArray();
+    return os.str();
+  }
+
+  bool Get(const std::string& key, std::vector<float>* feature) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return false;
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    *feature = it->second->feature;
+    return true;
+  }
+
+  void Put(const std::string& key, const ComputeDAG& dag, const std::vector<float>& feature) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+    entries_.push_front(Entry{key, dag, feature});
+    index_.emplace(key, entries_.begin());
+    if (entries_.size() > capacity_) {
+      index_.erase(entries_.back().key);
+      entries_.pop_back();
+    }
+  }
+
+ private:
+  /*! \brief The number of states kept, about 7KB each with the default 5 buffers and 10 stores */
+  static constexpr size_t kCapacity = 4096;
+
+  struct Entry {
+    std::string key;
+    ComputeDAG dag;
+    std::vector<float> feature;
+  };
+
+  explicit PerStoreFeatureCache(size_t capacity) : capacity_(capacity) {}
+
+  /*! \brief The maximum number of states kept */
+  size_t capacity_;
+  /*! \brief The features, from the most to the least recently used */
+  std::list<Entry> entries_;
+  /*! \brief The position of each key in `entries_` */
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  std::mutex mutex_;
+};
+
+void GetPerStoreFeaturesWorkerFunc(const SearchTask& task, const State& state, int max_n_bufs,
+                                   std::vector<float>* feature, std::atomic<int>* error_ct) {
+  PerStoreFeatureCache* cache = PerStoreFeatureCache::Global();
+  std::string key = PerStoreFeatureCache::Key(task, state, max_n_bufs);
+  if (cache->Get(key, feature)) {
+    if (feature->empty()) {
+      (*error_ct)++;
+    }
+    return;
+  }
+  ExtractPerStoreFeatures(task, state, max_n_bufs, feature, error_ct);
+  cache->Put(key, task->compute_dag, *feature);
+}
+
+inline int FeatureExtractionThreads() {
+  return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
 void GetPerStoreFeaturesFromStates(const Array<State>& states, const SearchTask& task,
                                    int skip_first_n_feature_extraction, int max_n_bufs,
                                    std::vector<std::vector<float>>* features) {
@@ -1429,11 +1545,13 @@ void GetPerStoreFeaturesFromStates(const Array<State>& states, const SearchTask&
 
   std::atomic<int> error_ct(0);
 
-  support::parallel_for(skip_first_n_feature_extraction, states.size(),
-                        [&task, &states, &max_n_bufs, &features, &error_ct](int i) {
-                          GetPerStoreFeaturesWorkerFunc(task, states[i], max_n_bufs,
-                                                        &(*features)[i], &error_ct);
-                        });
+  // The pool of parallel_for_dynamic persists across the calls of the search rounds
+  support::parallel_for_dynamic(skip_first_n_feature_extraction, states.size(),
+                                FeatureExtractionThreads(),
+                                [&task, &states, &max_n_bufs, &features, &error_ct](int, int i) {
+                                  GetPerStoreFeaturesWorkerFunc(task, states[i], max_n_bufs,
+                                                                &(*features)[i], &error_ct);
+                                });
 }
 
 void GetPerStoreFeaturesFromStates(const Array<State>& states, const std::vector<SearchTask>& tasks,
@@ -1444,11 +1562,13 @@ void GetPerStoreFeaturesFromStates(const Array<State>& states, const std::vector
 
   std::atomic<int> error_ct(0);
 
-  support::parallel_for(skip_first_n_feature_extraction, states.size(),
-                        [&tasks, &states, &max_n_bufs, &features, &error_ct](int i) {
-                          GetPerStoreFeaturesWorkerFunc(tasks[i], states[i], max_n_bufs,
-                                                        &(*features)[i], &error_ct);
-                        });
+  // The pool of parallel_for_dynamic persists across the calls of the search rounds
+  support::parallel_for_dynamic(skip_first_n_feature_extraction, states.size(),
+                                FeatureExtractionThreads(),
+                                [&tasks, &states, &max_n_bufs, &features, &error_ct](int, int i) {
+                                  GetPerStoreFeaturesWorkerFunc(tasks[i], states[i], max_n_bufs,
+                                                                &(*features)[i], &error_ct);
+                                });
 }
 
 void GetPerStoreFeaturesFromFile(const std::string& filename, int max_lines, int max_n_bufs,
@@ -1645,7 +1765,7 @@ TVMByteArray SerializeFeatures(std::vector<std::vector<float>>&& features,
   ICHECK_EQ(size_vector.size(), size_vector_size);
 
   // allocate memory
-  out_data->reserve(total_bytes);
+  out_data->resize(total_bytes);
   char* ptr = out_data->data();
 
   // serialize size_vector
@@ -1656,7 +1776,7 @@ TVMByteArray SerializeFeatures(std::vector<std::vector<float>>&& features,
   for (auto& x : features) {
     memmove(ptr, x.data(), sizeof(float) * x.size());
     ptr += sizeof(float) * x.size();
-    x.clear();
+    std::vector<float>().swap(x);
   }
 
   // serialize normalized_throughputs
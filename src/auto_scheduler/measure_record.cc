@@ -19,7 +19,8 @@
 
 /*!
  * \file auto_scheduler/measure_record.cc
- * \brief Json serialization format for dumping and loading tuning records.
+ * \brief Json serialization format for dumping and loading tuning records, and an indexed
+ *  binary format for loading the best ones of large logs.
  */
 
 #include <dmlc/json.h>
@@ -28,7 +29,9 @@
 #include <tvm/auto_scheduler/transform_step.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
 #include <fstream>
+#include <map>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -403,6 +406,254 @@ std::pair<Array<MeasureInput>, Array<MeasureResult>> RecordReaderNode::ReadLines
   return std::make_pair(inputs, results);
 }
 
+/*
+ * The binary record format. The file starts with a header of two uint64 (magic, version),
+ * followed by one kRecord entry per record of the form
+ * [BinaryRecordHeader, workload_key(key_size), target(target_size), json(nbytes)],
+ * where `json` is the JSON line of the record as written by WriteMeasureRecords. The header
+ * carries what picking the best records needs, so that a reader only parses the selected records.
+ *
+ * The converter then appends a kIndex entry [BinaryRecordHeader, index(nbytes)] of the successful
+ * records, grouped by workload key and target and sorted by mean cost. The index is
+ * [num_groups(uint64)] and per group
+ * [key_size(uint32), target_size(uint32), count(uint64), workload_key, target, records(count)],
+ * where a record is [mean_cost(double), offset(uint64)]. The file ends with a footer
+ * [index_offset(uint64), kBinaryRecordIndexMagic(uint64)]. A file without a valid footer, e.g. an
+ * interrupted conversion, is loaded by scanning the kRecord entries instead.
+ */
+namespace {
+
+/*! \brief The magic number of the binary record file */
+constexpr uint64_t kBinaryRecordMagic = 0x4345524E49425341;  // "ASBINREC"
+/*! \brief The magic number of the footer of the index */
+constexpr uint64_t kBinaryRecordIndexMagic = 0x58444E49434552;  // "RECINDX"
+/*! \brief The version of the binary record format */
+constexpr uint64_t kBinaryRecordVersion = 1;
+/*! \brief The size of the file header */
+constexpr uint64_t kBinaryRecordFileHeaderSize = 2 * sizeof(uint64_t);
+
+/*! \brief The kind of an entry of the binary record file */
+enum class BinaryRecordKind : uint32_t {
+  kRecord = 1,
+  kIndex = 2,
+};
+
+/*! \brief The header of an entry of the binary record file */
+struct BinaryRecordHeader {
+  uint64_t nbytes;
+  double mean_cost;
+  int32_t error_no;
+  uint32_t key_size;
+  uint32_t target_size;
+  uint32_t kind;
+};
+static_assert(sizeof(BinaryRecordHeader) == 32, "BinaryRecordHeader must be packed");
+
+/*! \brief The successful records of a (workload key, target) pair, as (mean cost, offset) */
+using BinaryRecordGroups =
+    std::map<std::pair<std::string, std::string>, std::vector<std::pair<double, uint64_t>>>;
+
+template <typename T>
+void WriteBinary(std::ostream* os, const T& value) {
+  os->write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadBinary(std::istream* is, T* value) {
+  return static_cast<bool>(is->read(reinterpret_cast<char*>(value), sizeof(T)));
+}
+
+bool ReadBinaryString(std::istream* is, size_t size, std::string* str) {
+  str->resize(size);
+  return size == 0 || static_cast<bool>(is->read(&(*str)[0], size));
+}
+
+double MeanCost(const MeasureResultNode& res) {
+  double sum = 0;
+  for (const auto& x : res.costs) {
+    sum += x.as<FloatImmNode>()->value;
+  }
+  return res.costs.empty() ? 0 : sum / res.costs.size();
+}
+
+/*! \brief Read the index of a binary record file, return false if the file has no valid index */
+bool ReadBinaryRecordIndex(std::ifstream* is, uint64_t file_size, BinaryRecordGroups* groups) {
+  if (file_size < kBinaryRecordFileHeaderSize + 2 * sizeof(uint64_t)) {
+    return false;
+  }
+  uint64_t index_offset, magic, num_groups;
+  BinaryRecordHeader header;
+  is->seekg(file_size - 2 * sizeof(uint64_t));
+  if (!ReadBinary(is, &index_offset) || !ReadBinary(is, &magic) ||
+      magic != kBinaryRecordIndexMagic || index_offset >= file_size) {
+    return false;
+  }
+  is->seekg(index_offset);
+  if (!ReadBinary(is, &header) || header.kind != static_cast<uint32_t>(BinaryRecordKind::kIndex) ||
+      !ReadBinary(is, &num_groups)) {
+    return false;
+  }
+  for (uint64_t i = 0; i < num_groups; ++i) {
+    uint32_t key_size, target_size;
+    uint64_t count;
+    std::string key, target;
+    if (!ReadBinary(is, &key_size) || !ReadBinary(is, &target_size) || !ReadBinary(is, &count) ||
+        !ReadBinaryString(is, key_size, &key) || !ReadBinaryString(is, target_size, &target)) {
+      return false;
+    }
+    std::vector<std::pair<double, uint64_t>>& records = (*groups)[{key, target}];
+    for (uint64_t j = 0; j < count; ++j) {
+      double cost;
+      uint64_t offset;
+      if (!ReadBinary(is, &cost) || !ReadBinary(is, &offset)) {
+        return false;
+      }
+      records.emplace_back(cost, offset);
+    }
+  }
+  return true;
+}
+
+/*! \brief Collect the successful records by scanning the entry headers, skipping the payloads */
+void ScanBinaryRecords(std::ifstream* is, uint64_t file_size, BinaryRecordGroups* groups) {
+  is->clear();
+  is->seekg(kBinaryRecordFileHeaderSize);
+  BinaryRecordHeader header;
+  std::string key, target;
+  for (uint64_t offset = kBinaryRecordFileHeaderSize;; offset = is->tellg()) {
+    // Stop at the index, or at an entry cut off by an interrupted write
+    if (!ReadBinary(is, &header) ||
+        header.kind != static_cast<uint32_t>(BinaryRecordKind::kRecord) ||
+        offset + sizeof(header) + header.key_size + header.target_size + header.nbytes >
+            file_size) {
+      break;
+    }
+    if (!ReadBinaryString(is, header.key_size, &key) ||
+        !ReadBinaryString(is, header.target_size, &target)) {
+      break;
+    }
+    if (header.error_no == static_cast<int>(MeasureErrorNO::kNoError)) {
+      (*groups)[{key, target}].emplace_back(header.mean_cost, offset);
+    }
+    is->seekg(header.nbytes, std::ios::cur);
+  }
+  for (auto& kv : *groups) {
+    std::stable_sort(kv.second.begin(), kv.second.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+  }
+}
+
+}  // namespace
+
+void ConvertRecordsToBinary(const String& json_file, const String& binary_file) {
+  std::ifstream is(json_file, std::ifstream::in);
+  CHECK(is.good()) << "ValueError: Cannot open file: " << json_file;
+  std::ofstream os(binary_file, std::ofstream::out | std::ofstream::binary);
+  CHECK(os.good()) << "ValueError: Cannot create file: " << binary_file;
+  WriteBinary(&os, kBinaryRecordMagic);
+  WriteBinary(&os, kBinaryRecordVersion);
+
+  auto inp = make_object<MeasureInputNode>();
+  auto res = make_object<MeasureResultNode>();
+  std::string line, log_version;
+  BinaryRecordGroups groups;
+  uint64_t offset = kBinaryRecordFileHeaderSize;
+  while (std::getline(is, line)) {
+    if (line.empty() || line[0] == '#' || line[0] == ' ') {
+      continue;
+    }
+    ReadMeasureRecord(line, inp.get(), res.get(), &log_version);
+    std::string key = inp->task->workload_key;
+    std::string target = inp->task->target->str();
+    BinaryRecordHeader header;
+    header.nbytes = line.size();
+    header.mean_cost = MeanCost(*res);
+    header.error_no = res->error_no;
+    header.key_size = key.size();
+    header.target_size = target.size();
+    header.kind = static_cast<uint32_t>(BinaryRecordKind::kRecord);
+    WriteBinary(&os, header);
+    os << key << target << line;
+    if (res->error_no == static_cast<int>(MeasureErrorNO::kNoError)) {
+      groups[{key, target}].emplace_back(header.mean_cost, offset);
+    }
+    offset += sizeof(BinaryRecordHeader) + key.size() + target.size() + line.size();
+  }
+
+  std::ostringstream index;
+  WriteBinary(&index, static_cast<uint64_t>(groups.size()));
+  for (auto& kv : groups) {
+    std::vector<std::pair<double, uint64_t>>& records = kv.second;
+    std::stable_sort(records.begin(), records.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    WriteBinary(&index, static_cast<uint32_t>(kv.first.first.size()));
+    WriteBinary(&index, static_cast<uint32_t>(kv.first.second.size()));
+    WriteBinary(&index, static_cast<uint64_t>(records.size()));
+    index << kv.first.first << kv.first.second;
+    for (const auto& record : records) {
+      WriteBinary(&index, record.first);
+      WriteBinary(&index, record.second);
+    }
+  }
+  std::string index_bytes = index.str();
+  BinaryRecordHeader index_header{index_bytes.size(), 0.0, 0, 0, 0,
+                                  static_cast<uint32_t>(BinaryRecordKind::kIndex)};
+  WriteBinary(&os, index_header);
+  os << index_bytes;
+  WriteBinary(&os, offset);
+  WriteBinary(&os, kBinaryRecordIndexMagic);
+  CHECK(os.good()) << "ValueError: Failed to write file: " << binary_file;
+}
+
+bool IsBinaryRecordFile(const String& filename) {
+  std::ifstream is(filename, std::ifstream::in | std::ifstream::binary);
+  uint64_t magic;
+  return is.good() && ReadBinary(&is, &magic) && magic == kBinaryRecordMagic;
+}
+
+std::pair<Array<MeasureInput>, Array<MeasureResult>> LoadBestBinaryRecords(
+    const String& filename, int top_k) {
+  CHECK_GT(top_k, 0) << "ValueError: top_k must be positive";
+  std::ifstream is(filename, std::ifstream::in | std::ifstream::binary);
+  CHECK(is.good()) << "ValueError: Cannot open file: " << filename;
+  uint64_t magic, version;
+  CHECK(ReadBinary(&is, &magic) && magic == kBinaryRecordMagic)
+      << "ValueError: Not a binary record file: " << filename;
+  CHECK(ReadBinary(&is, &version) && version == kBinaryRecordVersion)
+      << "ValueError: Unsupported binary record version " << version << " in " << filename;
+
+  is.seekg(0, std::ios::end);
+  uint64_t file_size = is.tellg();
+  BinaryRecordGroups groups;
+  if (!ReadBinaryRecordIndex(&is, file_size, &groups)) {
+    groups.clear();
+    ScanBinaryRecords(&is, file_size, &groups);
+  }
+
+  Array<MeasureInput> inputs;
+  Array<MeasureResult> results;
+  BinaryRecordHeader header;
+  std::string skipped, line, log_version;
+  for (const auto& kv : groups) {
+    size_t n = std::min(kv.second.size(), static_cast<size_t>(top_k));
+    for (size_t i = 0; i < n; ++i) {
+      is.clear();
+      is.seekg(kv.second[i].second);
+      CHECK(ReadBinary(&is, &header) &&
+            ReadBinaryString(&is, header.key_size + header.target_size, &skipped) &&
+            ReadBinaryString(&is, header.nbytes, &line))
+          << "ValueError: Truncated record at offset " << kv.second[i].second << " in "
+          << filename;
+      auto inp = make_object<MeasureInputNode>();
+      auto res = make_object<MeasureResultNode>();
+      ReadMeasureRecord(line, inp.get(), res.get(), &log_version);
+      inputs.push_back(MeasureInput(inp));
+      results.push_back(MeasureResult(res));
+    }
+  }
+  return std::make_pair(inputs, results);
+}
+
 TVM_REGISTER_GLOBAL("auto_scheduler.RecordToFile").set_body_typed([](const String& filename) {
   return RecordToFile(filename);
 });
@@ -450,6 +701,17 @@ TVM_REGISTER_GLOBAL("auto_scheduler.SaveRecords")
       WriteMeasureRecords(&ofs, in, res);
     });
 
+TVM_REGISTER_GLOBAL("auto_scheduler.ConvertRecordsToBinary")
+    .set_body_typed(ConvertRecordsToBinary);
+
+TVM_REGISTER_GLOBAL("auto_scheduler.IsBinaryRecordFile").set_body_typed(IsBinaryRecordFile);
+
+TVM_REGISTER_GLOBAL("auto_scheduler.LoadBestBinaryRecords")
+    .set_body_typed([](const String& filename, int top_k) {
+      const auto& res = LoadBestBinaryRecords(filename, top_k);
+      return Array<ObjectRef>{res.first, res.second};
+    });
+
 TVM_REGISTER_GLOBAL("auto_scheduler.SerializeMeasureInput")
     .set_body_typed([](const MeasureInput& input) {
       std::ostringstream os;
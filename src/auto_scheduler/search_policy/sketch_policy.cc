@@ -27,6 +27,7 @@
 #include "sketch_policy.h"
 
 #include <tvm/runtime/registry.h>
+#include <tvm/runtime/threading_backend.h>
 #include <tvm/support/parallel_for.h>
 
 #include <algorithm>
@@ -66,6 +67,25 @@ static InitUnroll init_unroll;
 static InitVectorization init_vectorization;
 static InitThreadBind init_thread_bind;
 
+/*!
+ * \brief The number of threads of the parallel parts of the search. It follows the configured
+ * concurrency of the runtime (TVM_NUM_THREADS), like the other parallel work of the process.
+ */
+static int SearchThreads() { return std::max(1, runtime::threading::MaxConcurrency()); }
+
+/*!
+ * \brief Print the states to strings in parallel, since printing dominates the deduplication of
+ * large populations.
+ */
+static void ToStrParallel(const Array<State>& states, int num_threads,
+                          std::vector<std::string>* state_strs) {
+  state_strs->assign(states.size(), std::string());
+  support::parallel_for_dynamic(0, states.size(), std::max(1, num_threads),
+                                [&states, state_strs](int thread_id, int index) {
+                                  (*state_strs)[index] = states[index].ToStr();
+                                });
+}
+
 /********** Sketch policy **********/
 TVM_REGISTER_NODE_TYPE(SketchPolicyNode);
 
@@ -439,9 +459,11 @@ Array<State> SketchPolicyNode::SampleInitPopulation(const Array<State>& sketches
       cand_states = search_task->compute_dag.InferBound(cand_states);
       PruneInvalidState(search_task, &cand_states);
       program_cost_model->Predict(search_task, cand_states, &pop_scores);
+      std::vector<std::string> state_strs;
+      ToStrParallel(cand_states, SearchThreads(), &state_strs);
 
       for (size_t i = 0; i < cand_states.size(); i++) {
-        const auto state_str = cand_states[i].ToStr();
+        const std::string& state_str = state_strs[i];
         if (pop_scores[i] > -1e10 && explored_state_strs.count(state_str) == 0) {
           explored_state_strs.insert(state_str);
           out_states.push_back(std::move(cand_states[i]));
@@ -522,7 +544,6 @@ Array<State> SketchPolicyNode::EvolutionarySearch(const Array<State>& init_popul
   float max_score = -1e-10f;
   pop_scores.reserve(population);
   pop_selection_probs.reserve(population);
-  std::uniform_real_distribution<> dis(0.0, 1.0);
 
   // mutation rules
   int mutation_success_ct, mutation_fail_ct;
@@ -534,16 +555,27 @@ Array<State> SketchPolicyNode::EvolutionarySearch(const Array<State>& init_popul
   }
   ComputePrefixSumProb(rule_weights, &rule_selection_probs);
 
+  // The mutations run in parallel. Each slot of the next population has its own random
+  // generator, so that the result doesn't depend on the order in which the threads run.
+  int num_threads = SearchThreads();
+  std::vector<std::mt19937> rand_gens;
+  rand_gens.reserve(population);
+  for (size_t i = 0; i < population; i++) {
+    rand_gens.push_back(std::mt19937(rand_gen()));
+  }
+  std::vector<std::string> state_strs;
+
   // Genetic Algorithm
   for (int k = 0; k < num_iters + 1; ++k) {
     // Maintain the heap
     *pnow = search_task->compute_dag.InferBound(*pnow);
     PruneInvalidState(search_task, pnow);
     program_cost_model->Predict(search_task, *pnow, &pop_scores);
+    ToStrParallel(*pnow, num_threads, &state_strs);
 
     for (size_t i = 0; i < pnow->size(); ++i) {
       const State& state = (*pnow)[i];
-      std::string state_str = state.ToStr();
+      const std::string& state_str = state_strs[i];
 
       if (in_heap.count(state_str) == 0) {
         if (static_cast<int>(heap.size()) < out_size) {
@@ -587,20 +619,33 @@ Array<State> SketchPolicyNode::EvolutionarySearch(const Array<State>& init_popul
 
     // TODO(merrymercy, comaniac): add crossover.
 
-    // Do mutation
+    // Do mutation. Each pass fills the missing slots in parallel, and the slots whose mutation
+    // fails are retried by the next pass.
     while (pnext->size() < population) {
-      State tmp_s = (*pnow)[RandomChoose(pop_selection_probs, &rand_gen)];
-
-      if (dis(rand_gen) < mutation_prob) {
-        const auto& rule = mutation_rules[RandomChoose(rule_selection_probs, &rand_gen)];
-        if (rule->Apply(this, &tmp_s, &rand_gen) == PopulationGenerationRule::ResultKind::kValid) {
-          pnext->push_back(std::move(tmp_s));
-          mutation_success_ct++;
+      int n_missing = population - pnext->size();
+      std::vector<State> next_states(n_missing);
+      std::vector<int> mutated(n_missing, 0);
+      support::parallel_for_dynamic(0, n_missing, num_threads, [&](int thread_id, int index) {
+        std::mt19937* gen = &rand_gens[index];
+        std::uniform_real_distribution<> dis(0.0, 1.0);
+        State tmp_s = (*pnow)[RandomChoose(pop_selection_probs, gen)];
+        if (dis(*gen) < mutation_prob) {
+          const auto& rule = mutation_rules[RandomChoose(rule_selection_probs, gen)];
+          mutated[index] = 1;
+          if (rule->Apply(this, &tmp_s, gen) == PopulationGenerationRule::ResultKind::kValid) {
+            next_states[index] = std::move(tmp_s);
+          }
+        } else {
+          next_states[index] = std::move(tmp_s);
+        }
+      });
+      for (int i = 0; i < n_missing; ++i) {
+        if (next_states[i].defined()) {
+          pnext->push_back(std::move(next_states[i]));
+          mutation_success_ct += mutated[i];
         } else {
           mutation_fail_ct++;
         }
-      } else {
-        pnext->push_back(std::move(tmp_s));
       }
     }
 
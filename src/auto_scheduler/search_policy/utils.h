@@ -33,6 +33,7 @@
 
 #include <algorithm>
 #include <condition_variable>
+#include <mutex>
 #include <set>
 #include <string>
 #include <tuple>
@@ -663,7 +664,8 @@ inline void PrintTitle(const std::string& title, int verbose) {
 
 /*!
  * \brief Enumerate all possible factorization schemes for splitting an axes.
- * \note This class will memorize the results for reuse.
+ * \note This class will memorize the results for reuse. It is thread-safe, so that the rules
+ * applied in parallel can share it, and the returned references stay valid as it grows.
  */
 class SplitFactorizationMemo {
  public:
@@ -675,6 +677,10 @@ class SplitFactorizationMemo {
 
  private:
   void DfsEnumerate(int now, int remaining_length, int max_innermost_factor);
+  /*! \brief Same as `GetFactors`, with `mutex_` already held */
+  const std::vector<int>& GetFactorsLocked(int n);
+
+  std::mutex mutex_;
 
   std::unordered_map<QueryKey, Array<Array<Integer>>> memory_;
 
@@ -0,0 +1,149 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file driver/codegen_cache.cc
+ * \brief A persistent cache of the object code of the host functions, shared between builds.
+ */
+#include "./codegen_cache.h"
+
+#include <tvm/ir/transform.h>
+#include <tvm/relay/runtime.h>
+#include <tvm/target/codegen.h>
+#include <tvm/tir/function.h>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../runtime/static_library.h"
+#include "../support/utils.h"
+
+namespace tvm {
+
+// Defined in support/libinfo.cc
+Map<String, String> GetLibInfo();
+
+namespace {
+
+/*! \brief The id of the current process. */
+int64_t ProcessId() {
+#ifdef _WIN32
+  return _getpid();
+#else
+  return getpid();
+#endif
+}
+
+/*!
+ * \brief Everything the object code depends on, besides the function itself.
+ * \param mod The host module.
+ * \param target The host target.
+ * \return The stable hash of the TVM version and commit, the LLVM version, the target, the
+ * attributes of the module, and the pass config except for the cache directory.
+ */
+uint64_t CodegenContextHash(const IRModule& mod, const Target& target) {
+  transform::PassContext pass_ctx = transform::PassContext::Current();
+  // The config is sorted, as the iteration order of a map is not specified
+  std::vector<std::pair<std::string, std::string>> config;
+  for (const auto& kv : pass_ctx->config) {
+    if (kv.first != "tir.codegen_cache_dir") {
+      std::ostringstream value;
+      value << kv.second;
+      config.emplace_back(kv.first, value.str());
+    }
+  }
+  std::sort(config.begin(), config.end());
+  std::ostringstream os;
+  // Builds of the same version from different commits or against another LLVM emit other code
+  static const Map<String, String> lib_info = GetLibInfo();
+  os << TVM_VERSION << ';' << lib_info["GIT_COMMIT_HASH"] << ';' << lib_info["LLVM_VERSION"] << ';'
+     << target->str() << ';' << pass_ctx->opt_level << ';';
+  for (const auto& [key, value] : config) {
+    os << key << '=' << value << ';';
+  }
+  std::string context = os.str();
+  uint64_t hash = String::StableHashBytes(context.data(), context.size());
+  return support::HashCombine(hash, StructuralHash()(mod->attrs));
+}
+
+/*! \brief Whether a file exists and can be read. */
+bool FileExists(const std::string& path) { return std::ifstream(path).good(); }
+
+}  // namespace
+
+runtime::Module BuildWithCodegenCache(const IRModule& mod, const Target& target,
+                                      const String& cache_dir) {
+  relay::Runtime runtime =
+      mod->GetAttr<relay::Runtime>(tvm::attr::kRuntime).value_or(relay::Runtime::Create("cpp"));
+  // The system library registers all the functions of a module in one static constructor
+  if (target->kind->name != "llvm" ||
+      runtime->GetAttr<Bool>("system-lib").value_or(Bool(false))) {
+    return codegen::Build(mod, target);
+  }
+  uint64_t context_hash = CodegenContextHash(mod, target);
+  IRModule uncached(Map<GlobalVar, BaseFunc>(), {}, {}, {}, mod->attrs);
+  std::vector<runtime::Module> libs;
+  for (const auto& [gvar, base_func] : mod->functions) {
+    Optional<String> symbol = base_func->GetAttr<String>(tvm::attr::kGlobalSymbol);
+    // The entry function also defines the symbols of the module, so it stays in the host module
+    if (!base_func->IsInstance<tir::PrimFuncNode>() || !symbol.defined() ||
+        base_func->HasNonzeroAttr(tir::attr::kIsEntryFunc)) {
+      uncached->Add(gvar, base_func);
+      continue;
+    }
+    uint64_t key = support::HashCombine(context_hash, StructuralHash()(base_func));
+    std::ostringstream path;
+    path << std::string(cache_dir) << '/' << std::hex << std::setw(16) << std::setfill('0') << key
+         << ".o";
+    if (!FileExists(path.str())) {
+      IRModule single(Map<GlobalVar, BaseFunc>(), {}, {}, {}, mod->attrs);
+      single->Add(gvar, base_func);
+      runtime::Module built = codegen::Build(single, target);
+      // The object code is written under a name unique to the process and time, then renamed,
+      // which is atomic, so that a concurrent build never links a partially written file
+      auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+      std::string tmp_path =
+          path.str() + "." + std::to_string(ProcessId()) + "-" + std::to_string(stamp) + ".tmp";
+      built->SaveToFile(tmp_path, "o");
+      CHECK_EQ(std::rename(tmp_path.c_str(), path.str().c_str()), 0)
+          << "ValueError: Cannot write to the codegen cache directory: " << cache_dir;
+    }
+    libs.push_back(runtime::LoadStaticLibrary(path.str(), {symbol.value()}));
+  }
+  runtime::Module host = codegen::Build(uncached, target);
+  for (const runtime::Module& lib : libs) {
+    host.Import(lib);
+  }
+  return host;
+}
+
+}  // namespace tvm
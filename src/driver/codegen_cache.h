@@ -0,0 +1,53 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file driver/codegen_cache.h
+ * \brief A persistent cache of the object code of the host functions, shared between builds.
+ *
+ * When `tir.codegen_cache_dir` is set, each lowered host PrimFunc is compiled on its own, and its
+ * object code is stored in the directory, under a key made of the structural hash of the PrimFunc,
+ * the target, the attributes of the module and the pass config. Later builds with the same key
+ * skip the code generation of the function, and only link the cached object code. As the cached
+ * functions are static libraries, the resulting module has to be exported with `export_library`
+ * before it runs.
+ */
+#ifndef TVM_DRIVER_CODEGEN_CACHE_H_
+#define TVM_DRIVER_CODEGEN_CACHE_H_
+
+#include <tvm/ir/module.h>
+#include <tvm/runtime/module.h>
+#include <tvm/target/target.h>
+
+namespace tvm {
+
+/*!
+ * \brief Generate the code of a host module through the codegen cache.
+ * \param mod The lowered host module.
+ * \param target The host target.
+ * \param cache_dir The existing directory of the cache.
+ * \return The host module, importing the cached object code of its functions. It is the module
+ * built without the cache if the target is not LLVM, or the runtime is the system library.
+ */
+runtime::Module BuildWithCodegenCache(const IRModule& mod, const Target& target,
+                                      const String& cache_dir);
+
+}  // namespace tvm
+
+#endif  // TVM_DRIVER_CODEGEN_CACHE_H_
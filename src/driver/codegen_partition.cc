@@ -0,0 +1,156 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file driver/codegen_partition.cc
+ * \brief Parallel code generation of the host functions, split into several partitions.
+ */
+#include "./codegen_partition.h"
+
+#include <tvm/ir/transform.h>
+#include <tvm/relay/runtime.h>
+#include <tvm/support/parallel_for.h>
+#include <tvm/target/codegen.h>
+#include <tvm/tir/function.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+
+namespace {
+
+/*! \brief A function of the host module to be placed in a partition. */
+struct PartitionItem {
+  GlobalVar gvar;
+  BaseFunc func;
+  /*! \brief The number of IR nodes of the function, as an estimate of its codegen cost. */
+  int64_t cost = 0;
+  /*! \brief Whether the function has to stay in the host partition. */
+  bool pinned = false;
+};
+
+/*!
+ * \brief Collect the functions of the host module, and find the ones linked to another function.
+ * \param mod The host module.
+ * \return The functions, with their estimated cost.
+ */
+std::vector<PartitionItem> CollectPartitionItems(const IRModule& mod) {
+  std::unordered_set<std::string> symbols;
+  for (const auto& [gvar, base_func] : mod->functions) {
+    if (Optional<String> symbol = base_func->GetAttr<String>(tvm::attr::kGlobalSymbol)) {
+      symbols.insert(symbol.value());
+    }
+  }
+  std::vector<PartitionItem> items;
+  std::unordered_set<std::string> callees;
+  for (const auto& [gvar, base_func] : mod->functions) {
+    PartitionItem item{gvar, base_func};
+    // The entry function defines the symbols of the module
+    item.pinned = !base_func->IsInstance<tir::PrimFuncNode>() ||
+                  base_func->HasNonzeroAttr(tir::attr::kIsEntryFunc);
+    if (const auto* prim_func = base_func.as<tir::PrimFuncNode>()) {
+      tir::PostOrderVisit(prim_func->body, [&](const ObjectRef& node) {
+        ++item.cost;
+        if (const auto* str = node.as<tir::StringImmNode>()) {
+          if (symbols.count(str->value)) {
+            item.pinned = true;
+            callees.insert(str->value);
+          }
+        } else if (const auto* call = node.as<tir::CallNode>()) {
+          if (const auto* callee = call->op.as<GlobalVarNode>()) {
+            item.pinned = true;
+            callees.insert(callee->name_hint);
+          }
+        }
+      });
+    }
+    items.push_back(std::move(item));
+  }
+  for (PartitionItem& item : items) {
+    Optional<String> symbol = item.func->GetAttr<String>(tvm::attr::kGlobalSymbol);
+    if (callees.count(item.gvar->name_hint) ||
+        (symbol.defined() && callees.count(symbol.value()))) {
+      item.pinned = true;
+    }
+  }
+  return items;
+}
+
+}  // namespace
+
+runtime::Module BuildInPartitions(const IRModule& mod, const Target& target, int num_partitions) {
+  relay::Runtime runtime =
+      mod->GetAttr<relay::Runtime>(tvm::attr::kRuntime).value_or(relay::Runtime::Create("cpp"));
+  // The system library registers all the functions of a module in one static constructor
+  if (num_partitions <= 1 || target->kind->name != "llvm" ||
+      runtime->GetAttr<Bool>("system-lib").value_or(Bool(false))) {
+    return codegen::Build(mod, target);
+  }
+  std::vector<PartitionItem> items = CollectPartitionItems(mod);
+  if (items.size() <= 1) {
+    return codegen::Build(mod, target);
+  }
+  // Longest processing time first: the costliest function goes to the least loaded partition
+  std::stable_sort(items.begin(), items.end(), [](const PartitionItem& a, const PartitionItem& b) {
+    return a.cost > b.cost;
+  });
+  num_partitions = std::min(num_partitions, static_cast<int>(items.size()));
+  std::vector<IRModule> partitions;
+  std::vector<int64_t> loads(num_partitions, 0);
+  for (int i = 0; i < num_partitions; ++i) {
+    partitions.push_back(IRModule(Map<GlobalVar, BaseFunc>(), {}, {}, {}, mod->attrs));
+  }
+  for (const PartitionItem& item : items) {
+    int target_partition = 0;
+    if (!item.pinned) {
+      target_partition = std::min_element(loads.begin(), loads.end()) - loads.begin();
+    }
+    partitions[target_partition]->Add(item.gvar, item.func);
+    loads[target_partition] += item.cost;
+  }
+  std::vector<runtime::Module> built(partitions.size());
+  // The pass context is thread local, and the code generation reads its config. The instruments
+  // are left out, as they are not required to be thread safe.
+  transform::PassContext current = transform::PassContext::Current();
+  transform::PassContext pass_ctx = transform::PassContext::Create();
+  pass_ctx->opt_level = current->opt_level;
+  pass_ctx->required_pass = current->required_pass;
+  pass_ctx->disabled_pass = current->disabled_pass;
+  pass_ctx->config = current->config;
+  support::parallel_for(0, partitions.size(), [&](int i) {
+    if (!partitions[i]->functions.empty()) {
+      With<transform::PassContext> scope(pass_ctx);
+      built[i] = codegen::Build(partitions[i], target);
+    }
+  });
+  runtime::Module host = built[0];
+  for (size_t i = 1; i < built.size(); ++i) {
+    if (built[i].defined()) {
+      host.Import(built[i]);
+    }
+  }
+  return host;
+}
+
+}  // namespace tvm
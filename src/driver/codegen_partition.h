@@ -0,0 +1,53 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file driver/codegen_partition.h
+ * \brief Parallel code generation of the host functions, split into several partitions.
+ *
+ * When `tir.codegen_num_partitions` is greater than one, the lowered host PrimFuncs are spread
+ * over that many modules of about the same size, which are generated, and optimized, on their own
+ * threads. Each partition has its own LLVM context. The partitions are imported into the one with
+ * the entry function, and are linked into a single library by `export_library`.
+ */
+#ifndef TVM_DRIVER_CODEGEN_PARTITION_H_
+#define TVM_DRIVER_CODEGEN_PARTITION_H_
+
+#include <tvm/ir/module.h>
+#include <tvm/runtime/module.h>
+#include <tvm/target/target.h>
+
+namespace tvm {
+
+/*!
+ * \brief Generate the code of a host module in parallel partitions.
+ * \param mod The lowered host module.
+ * \param target The host target.
+ * \param num_partitions The maximum number of partitions.
+ * \return The host module, importing the modules of the other partitions. It is the module built
+ * in one piece if the target is not LLVM, or the runtime is the system library.
+ * \note The functions that call, or are called by, another function of the module by its symbol
+ * stay in the host partition, so that calls are resolved within a module also when it is run
+ * without being exported.
+ */
+runtime::Module BuildInPartitions(const IRModule& mod, const Target& target, int num_partitions);
+
+}  // namespace tvm
+
+#endif  // TVM_DRIVER_CODEGEN_PARTITION_H_
@@ -27,6 +27,7 @@
 #include <tvm/relay/executor.h>
 #include <tvm/relay/runtime.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/support/parallel_for.h>
 #include <tvm/target/codegen.h>
 #include <tvm/te/operation.h>
 #include <tvm/tir/analysis.h>
@@ -36,6 +37,9 @@
 #include <mutex>
 #include <stack>
 
+#include "./codegen_cache.h"
+#include "./codegen_partition.h"
+
 namespace tvm {
 
 // Register build pipeline related options
@@ -55,6 +59,14 @@ TVM_REGISTER_PASS_CONFIG_OPTION("tir.use_async_copy", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.instrument_lwp", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.vtcm_capacity", Integer);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.ptx_ldg32", Bool);
+// The directory of the object code cached across builds, see driver/codegen_cache.h
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.codegen_cache_dir", String);
+// The number of host modules generated in parallel, see driver/codegen_partition.h
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.codegen_num_partitions", Integer);
+// The number of threads running the function-local PrimFunc passes and the device codegen
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.num_parallel_jobs", Integer);
+// Whether the CPU codegen runs adjacent parallel loops in one parallel launch, separated by barriers
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.merge_parallel_launch", Bool);
 
 // WARNING: May cause coherency issues resulting data miscompares
 // Experimental feature that, when enabled by the runtime, bypasses the cache when using DMA. When
@@ -216,6 +228,7 @@ Array<tvm::transform::Pass> CreatePassList(bool disable_loop_partition) {
   pass_list.push_back(tir::transform::LowerMatchBuffer());
   pass_list.push_back(tir::transform::InjectSoftwarePipeline());
   pass_list.push_back(tir::transform::LowerOpaqueBlock());
+  pass_list.push_back(tir::transform::InjectSoftwarePrefetch());
   pass_list.push_back(tir::transform::FlattenBuffer());
   pass_list.push_back(tir::transform::BF16ComputeLegalize());
   pass_list.push_back(tir::transform::NarrowDataType(32));
@@ -434,7 +447,8 @@ std::pair<IRModule, IRModule> SplitMixedModule(IRModule mod_mixed, const Target&
 
 runtime::Module TIRToRuntime(const Map<Target, IRModule>& inputs_arg,
                              const Target& target_host_arg) {
-  std::vector<runtime::Module> device_modules;
+  // The modules built apart from the host module, and their targets
+  std::vector<std::pair<IRModule, Target>> device_inputs;
   Map<Target, IRModule> inputs = inputs_arg;
   Target target_host = target_host_arg;
 
@@ -485,18 +499,52 @@ runtime::Module TIRToRuntime(const Map<Target, IRModule>& inputs_arg,
           target->GetTargetDeviceType() == target_host->GetTargetDeviceType();
       bool non_host_target_kind = target->kind != target_host->kind;
       if (overrides_host_target && non_host_target_kind) {
-        device_modules.push_back(codegen::Build(host_mod, it.first));
+        device_inputs.emplace_back(host_mod, it.first);
       } else {
         mhost_all->Update(host_mod);
       }
 
       if (device_mod->functions.size() != 0) {
-        device_modules.push_back(codegen::Build(device_mod, it.first));
+        device_inputs.emplace_back(device_mod, it.first);
       }
     }
   }
 
-  runtime::Module mhost = codegen::Build(mhost_all, target_host);
+  transform::PassContext pass_ctx = transform::PassContext::Current();
+  std::vector<runtime::Module> device_modules(device_inputs.size());
+  int num_device_inputs = device_inputs.size();
+  int num_jobs = std::min<int>(
+      pass_ctx->GetConfig<Integer>("tir.num_parallel_jobs", Integer(1)).value()->value,
+      num_device_inputs);
+  if (num_jobs > 1) {
+    // The pass context is thread local, and the code generation reads its config. The instruments
+    // are left out, as they are not required to be thread safe.
+    transform::PassContext worker_ctx = transform::PassContext::Create();
+    worker_ctx->opt_level = pass_ctx->opt_level;
+    worker_ctx->required_pass = pass_ctx->required_pass;
+    worker_ctx->disabled_pass = pass_ctx->disabled_pass;
+    worker_ctx->config = pass_ctx->config;
+    support::parallel_for_dynamic(0, num_device_inputs, num_jobs, [&](int thread_id, int i) {
+      With<transform::PassContext> scope(worker_ctx);
+      device_modules[i] = codegen::Build(device_inputs[i].first, device_inputs[i].second);
+    });
+  } else {
+    for (int i = 0; i < num_device_inputs; ++i) {
+      device_modules[i] = codegen::Build(device_inputs[i].first, device_inputs[i].second);
+    }
+  }
+
+  Optional<String> codegen_cache_dir = pass_ctx->GetConfig<String>("tir.codegen_cache_dir");
+  // With device modules, the host functions look up the kernels in the imports of their own module,
+  // so they are only partitioned without them
+  int num_partitions =
+      device_modules.empty()
+          ? pass_ctx->GetConfig<Integer>("tir.codegen_num_partitions", Integer(1)).value()->value
+          : 1;
+  runtime::Module mhost =
+      codegen_cache_dir.defined()
+          ? BuildWithCodegenCache(mhost_all, target_host, codegen_cache_dir.value())
+          : BuildInPartitions(mhost_all, target_host, num_partitions);
   for (const auto& it : device_modules) {
     if (it.operator->()) {
       mhost.Import(it);
@@ -27,7 +27,16 @@
 #include <tvm/node/repr_printer.h>
 #include <tvm/runtime/registry.h>
 
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include <chrono>
+#include <iomanip>
 #include <stack>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 namespace tvm {
 namespace instrument {
@@ -334,5 +343,329 @@ TVM_REGISTER_GLOBAL("instrument.MakePassTimingInstrument").set_body_typed([]() {
                             run_before_pass, run_after_pass);
 });
 
+/*! \brief The time spent by a function-level pass on one function. */
+struct FunctionProfileRecord {
+  /*! \brief The name of the function. */
+  String name;
+  /*! \brief The start time, in microseconds since the pass context was entered. */
+  double start_us;
+  /*! \brief The duration in microseconds. */
+  double duration_us;
+};
+
+/*! \brief The profile of one run of a pass. */
+struct PassProfileRecord {
+  /*! \brief The name of the pass. */
+  String name;
+  /*! \brief The nesting depth of the pass, 0 for the passes run directly in the context. */
+  int depth;
+  /*! \brief The start time, in microseconds since the pass context was entered. */
+  double start_us;
+  /*! \brief The duration in microseconds. */
+  double duration_us = 0;
+  /*! \brief The number of IR nodes of the module before and after the pass, -1 if not counted. */
+  int64_t nodes_before = -1;
+  int64_t nodes_after = -1;
+  /*! \brief The peak resident set size of the process before the pass, and its growth, in KB. */
+  int64_t peak_rss_kb = 0;
+  int64_t peak_rss_delta_kb = 0;
+  /*! \brief The breakdown of a function-level pass over the functions. */
+  std::vector<FunctionProfileRecord> functions;
+};
+
+/*! \brief The peak resident set size of the process in KB, or 0 where it is not available. */
+int64_t PeakResidentSetKB() {
+#if defined(__linux__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#if defined(__APPLE__)
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+#else
+  return 0;
+#endif
+}
+
+/*!
+ * \brief Count the distinct IR nodes reachable from the functions of a module through their
+ * reflected attributes, so that it works for any IR dialect.
+ */
+class IRNodeCounter : public AttrVisitor {
+ public:
+  static int64_t Count(const IRModule& mod) {
+    IRNodeCounter counter;
+    for (const auto& kv : mod->functions) {
+      counter.Push(kv.second);
+    }
+    while (!counter.worklist_.empty()) {
+      Object* node = counter.worklist_.back();
+      counter.worklist_.pop_back();
+      if (node->IsInstance<ArrayNode>()) {
+        const auto* arr = static_cast<const ArrayNode*>(node);
+        for (const ObjectRef& elem : *arr) {
+          counter.Push(elem);
+        }
+      } else if (node->IsInstance<MapNode>()) {
+        const auto* map = static_cast<const MapNode*>(node);
+        for (const auto& kv : *map) {
+          counter.Push(kv.first);
+          counter.Push(kv.second);
+        }
+      } else {
+        ReflectionVTable::Global()->VisitAttrs(node, &counter);
+      }
+    }
+    return counter.visited_.size();
+  }
+
+  void Visit(const char* key, double* value) final {}
+  void Visit(const char* key, int64_t* value) final {}
+  void Visit(const char* key, uint64_t* value) final {}
+  void Visit(const char* key, int* value) final {}
+  void Visit(const char* key, bool* value) final {}
+  void Visit(const char* key, std::string* value) final {}
+  void Visit(const char* key, void** value) final {}
+  void Visit(const char* key, DataType* value) final {}
+  void Visit(const char* key, runtime::NDArray* value) final {}
+  void Visit(const char* key, ObjectRef* value) final { Push(*value); }
+
+ private:
+  void Push(const ObjectRef& obj) {
+    if (obj.defined() && visited_.insert(obj.get()).second) {
+      worklist_.push_back(const_cast<Object*>(obj.get()));
+    }
+  }
+
+  std::unordered_set<const Object*> visited_;
+  std::vector<Object*> worklist_;
+};
+
+/*! \brief Escape a string for a JSON string literal. */
+std::string JSONEscape(const std::string& str) {
+  std::ostringstream os;
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+         << std::dec;
+    } else {
+      os << c;
+    }
+  }
+  return os.str();
+}
+
+/*!
+ * \brief A pass instrument that profiles every pass of a context: its wall time, the number of IR
+ * nodes before and after it, the growth of the peak resident set size, and for function-level
+ * passes the time spent on each function.
+ *
+ * Unlike PassTimingInstrument, the profile is kept in the instrument in the order the passes were
+ * run, and is available after the pass context is exited, until it is entered again.
+ */
+class PassProfilingInstrumentNode : public PassInstrumentNode {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /*! \brief Whether to count the IR nodes before and after each pass. */
+  bool count_nodes = true;
+
+  void VisitAttrs(AttrVisitor* v) {
+    PassInstrumentNode::VisitAttrs(v);
+    v->Visit("count_nodes", &count_nodes);
+  }
+
+  void EnterPassContext() const final {
+    records_.clear();
+    stack_.clear();
+    origin_ = Clock::now();
+  }
+
+  void ExitPassContext() const final {
+    // A pass raised an error, so that it is not exited
+    if (!stack_.empty()) {
+      stack_.clear();
+      Active() = previous_active_;
+    }
+  }
+
+  bool ShouldRun(const IRModule& mod, const transform::PassInfo& info) const final { return true; }
+
+  void RunBeforePass(const IRModule& mod, const transform::PassInfo& info) const final {
+    if (stack_.empty()) {
+      previous_active_ = Active();
+      Active() = this;
+    }
+    PassProfileRecord record;
+    record.name = info->name;
+    record.depth = stack_.size();
+    record.peak_rss_kb = PeakResidentSetKB();
+    if (count_nodes) {
+      record.nodes_before = IRNodeCounter::Count(mod);
+    }
+    // Start the clock last, so that the accounting is not part of the pass
+    record.start_us = ElapsedMicros();
+    stack_.push_back(records_.size());
+    records_.push_back(std::move(record));
+  }
+
+  void RunAfterPass(const IRModule& mod, const transform::PassInfo& info) const final {
+    ICHECK(!stack_.empty()) << "mismatched enter/exit for pass profiling";
+    PassProfileRecord& record = records_[stack_.back()];
+    record.duration_us = ElapsedMicros() - record.start_us;
+    record.peak_rss_delta_kb = PeakResidentSetKB() - record.peak_rss_kb;
+    if (count_nodes) {
+      record.nodes_after = IRNodeCounter::Count(mod);
+    }
+    stack_.pop_back();
+    if (stack_.empty()) {
+      Active() = previous_active_;
+    }
+  }
+
+  /*! \brief Record the time spent by the current pass on a function. */
+  void RecordFunction(const ObjectRef& function, int64_t start_ns, int64_t end_ns) const {
+    if (stack_.empty()) {
+      return;
+    }
+    String name = function.as<GlobalVarNode>() ? Downcast<GlobalVar>(function)->name_hint
+                                                : String("<unnamed>");
+    double start_us = (start_ns - origin_ns()) / 1e3;
+    records_[stack_.back()].functions.push_back({name, start_us, (end_ns - start_ns) / 1e3});
+  }
+
+  /*! \brief Render the profile as a table, with the nested passes indented. */
+  String Render() const {
+    std::ostringstream os;
+    os << std::fixed;
+    for (size_t i = 0; i < records_.size(); ++i) {
+      const PassProfileRecord& record = records_[i];
+      double self_us = record.duration_us;
+      for (size_t j = i + 1; j < records_.size() && records_[j].depth > record.depth; ++j) {
+        if (records_[j].depth == record.depth + 1) {
+          self_us -= records_[j].duration_us;
+        }
+      }
+      os << std::string(record.depth, '\t') << record.name << ": " << std::setprecision(0)
+         << record.duration_us << "us [" << self_us << "us]";
+      if (record.nodes_before >= 0) {
+        os << " nodes: " << record.nodes_before << " -> " << record.nodes_after;
+      }
+      os << " peak RSS: +" << record.peak_rss_delta_kb << "KB\n";
+      for (const FunctionProfileRecord& func : record.functions) {
+        os << std::string(record.depth + 1, '\t') << "@" << func.name << ": " << func.duration_us
+           << "us\n";
+      }
+    }
+    return os.str();
+  }
+
+  /*!
+   * \brief Export the profile in the JSON trace event format, which can be opened with Perfetto or
+   * chrome://tracing. The functions of a function-level pass are nested in the event of the pass.
+   */
+  String AsTraceJSON() const {
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(3);
+    os << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    for (const PassProfileRecord& record : records_) {
+      os << (first ? "" : ",") << "\n  {\"name\": \"" << JSONEscape(record.name)
+         << "\", \"cat\": \"pass\", \"ph\": \"X\", \"pid\": 0, \"tid\": 0, \"ts\": "
+         << record.start_us << ", \"dur\": " << record.duration_us << ", \"args\": {";
+      if (record.nodes_before >= 0) {
+        os << "\"nodes_before\": " << record.nodes_before
+           << ", \"nodes_after\": " << record.nodes_after << ", ";
+      }
+      os << "\"peak_rss_delta_kb\": " << record.peak_rss_delta_kb << "}}";
+      first = false;
+      for (const FunctionProfileRecord& func : record.functions) {
+        os << ",\n  {\"name\": \"" << JSONEscape(func.name)
+           << "\", \"cat\": \"function\", \"ph\": \"X\", \"pid\": 0, \"tid\": 0, \"ts\": "
+           << func.start_us << ", \"dur\": " << func.duration_us << ", \"args\": {\"pass\": \""
+           << JSONEscape(record.name) << "\"}}";
+      }
+    }
+    os << "\n]}\n";
+    return os.str();
+  }
+
+  /*! \brief The instrument profiling the passes run on the current thread, or nullptr. */
+  static const PassProfilingInstrumentNode*& Active() {
+    static thread_local const PassProfilingInstrumentNode* active = nullptr;
+    return active;
+  }
+
+  static constexpr const char* _type_key = "instrument.PassProfilingInstrument";
+  TVM_DECLARE_FINAL_OBJECT_INFO(PassProfilingInstrumentNode, PassInstrumentNode);
+
+ private:
+  double ElapsedMicros() const {
+    return std::chrono::duration<double, std::micro>(Clock::now() - origin_).count();
+  }
+
+  int64_t origin_ns() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(origin_.time_since_epoch())
+        .count();
+  }
+
+  /*! \brief The profiles of the passes, in the order they were entered. */
+  mutable std::vector<PassProfileRecord> records_;
+  /*! \brief The indices of the records of the passes being run. */
+  mutable std::vector<size_t> stack_;
+  /*! \brief The time the pass context was entered. */
+  mutable Clock::time_point origin_ = Clock::now();
+  /*! \brief The instrument that was active before the outermost pass. */
+  mutable const PassProfilingInstrumentNode* previous_active_ = nullptr;
+};
+
+FunctionPassProfileScope::FunctionPassProfileScope(const ObjectRef& function) {
+  if (const PassProfilingInstrumentNode* profiler = PassProfilingInstrumentNode::Active()) {
+    profile_ = const_cast<PassProfilingInstrumentNode*>(profiler);
+    function_ = function;
+    start_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    PassProfilingInstrumentNode::Clock::now().time_since_epoch())
+                    .count();
+  }
+}
+
+FunctionPassProfileScope::~FunctionPassProfileScope() {
+  if (profile_ != nullptr) {
+    int64_t end_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         PassProfilingInstrumentNode::Clock::now().time_since_epoch())
+                         .count();
+    static_cast<PassProfilingInstrumentNode*>(profile_)->RecordFunction(function_, start_ns_,
+                                                                        end_ns);
+  }
+}
+
+TVM_REGISTER_NODE_TYPE(PassProfilingInstrumentNode);
+
+TVM_REGISTER_GLOBAL("instrument.MakePassProfilingInstrument").set_body_typed([](bool count_nodes) {
+  auto n = make_object<PassProfilingInstrumentNode>();
+  n->name = "PassProfilingInstrument";
+  n->count_nodes = count_nodes;
+  return PassInstrument(n);
+});
+
+TVM_REGISTER_GLOBAL("instrument.PassProfilingInstrumentRender")
+    .set_body_typed([](PassInstrument pi) {
+      const auto* node = pi.as<PassProfilingInstrumentNode>();
+      ICHECK(node) << "TypeError: Expect a PassProfilingInstrument, but gets: " << pi->GetTypeKey();
+      return node->Render();
+    });
+
+TVM_REGISTER_GLOBAL("instrument.PassProfilingInstrumentAsTraceJSON")
+    .set_body_typed([](PassInstrument pi) {
+      const auto* node = pi.as<PassProfilingInstrumentNode>();
+      ICHECK(node) << "TypeError: Expect a PassProfilingInstrument, but gets: " << pi->GetTypeKey();
+      return node->AsTraceJSON();
+    });
+
 }  // namespace instrument
 }  // namespace tvm
@@ -0,0 +1,150 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file in_process_builder.cc
+ * \brief A builder that compiles the candidates on a thread pool of the tuning process.
+ *
+ * Unlike the LocalBuilder, which forks worker processes that each initialize LLVM and export the
+ * built artifact to disk, the modules are built in parallel in the current process and kept in
+ * memory. The artifact path of a result is a key into a process-wide table of the built modules,
+ * which the in-process LocalRunner loads from and the RemoveBuildArtifact callback releases.
+ */
+#include "./in_process_builder.h"
+
+#include <tvm/driver/driver_api.h>
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*! \brief The prefix of the artifact paths of the modules kept in memory */
+static constexpr const char* kInMemoryArtifactPrefix = "memory:";
+
+/*! \brief The process-wide table of the modules kept in memory */
+class InMemoryArtifactTable {
+ public:
+  static InMemoryArtifactTable* Global() {
+    static InMemoryArtifactTable table;
+    return &table;
+  }
+
+  String Add(runtime::Module mod) {
+    String path = kInMemoryArtifactPrefix + std::to_string(next_id_++);
+    std::lock_guard<std::mutex> lock(mutex_);
+    table_.emplace(path, std::move(mod));
+    return path;
+  }
+
+  runtime::Module Get(const String& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = table_.find(path);
+    CHECK(it != table_.end()) << "ValueError: The in-memory artifact is not found: " << path;
+    return it->second;
+  }
+
+  void Remove(const String& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    table_.erase(path);
+  }
+
+ private:
+  std::atomic<int64_t> next_id_{0};
+  std::mutex mutex_;
+  std::unordered_map<String, runtime::Module> table_;
+};
+
+bool IsInMemoryArtifact(const String& artifact_path) {
+  return support::StartsWith(artifact_path, kInMemoryArtifactPrefix);
+}
+
+runtime::Module GetInMemoryArtifact(const String& artifact_path) {
+  return InMemoryArtifactTable::Global()->Get(artifact_path);
+}
+
+void RemoveInMemoryArtifact(const String& artifact_path) {
+  InMemoryArtifactTable::Global()->Remove(artifact_path);
+}
+
+/*! \brief The builder that builds the candidates in parallel in the current process. */
+class InProcessBuilderNode : public BuilderNode {
+ public:
+  /*! \brief The number of threads to build with */
+  int max_workers;
+
+  void VisitAttrs(tvm::AttrVisitor* v) { v->Visit("max_workers", &max_workers); }
+
+  Array<BuilderResult> Build(const Array<BuilderInput>& build_inputs) final {
+    auto _ = Profiler::TimedScope("InProcessBuilder/Build");
+    int n = build_inputs.size();
+    std::vector<Optional<String>> artifact_paths(n, NullOpt);
+    std::vector<Optional<String>> error_msgs(n, NullOpt);
+    // The pass context is thread-local, so the workers enter the one of the caller
+    transform::PassContext pass_ctx = transform::PassContext::Current();
+    auto f_build = [&](int thread_id, int task_id) -> void {
+      const BuilderInput& input = build_inputs[task_id];
+      try {
+        CHECK(!input->params.defined())
+            << "ValueError: InProcessBuilder doesn't support building with parameters";
+        With<transform::PassContext> ctx(pass_ctx);
+        IRModule mod = tir::transform::RemoveWeightLayoutRewriteBlock(
+            /*skip_ndarray_rewrite=*/true)(input->mod);
+        runtime::Module rt_mod = tvm::build(mod, input->target, Target());
+        artifact_paths[task_id] = InMemoryArtifactTable::Global()->Add(rt_mod);
+      } catch (const std::exception& e) {
+        error_msgs[task_id] = String("InProcessBuilder: An exception occurred\n") + e.what();
+      }
+    };
+    support::parallel_for_dynamic(0, n, max_workers, f_build);
+    Array<BuilderResult> results;
+    results.reserve(n);
+    for (int i = 0; i < n; ++i) {
+      results.push_back(BuilderResult(artifact_paths[i], error_msgs[i]));
+    }
+    return results;
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.InProcessBuilder";
+  TVM_DECLARE_FINAL_OBJECT_INFO(InProcessBuilderNode, BuilderNode);
+};
+
+Builder Builder::InProcessBuilder(int max_workers) {
+  CHECK_GT(max_workers, 0) << "ValueError: `max_workers` must be positive, but gets: "
+                           << max_workers;
+  ObjectPtr<InProcessBuilderNode> n = make_object<InProcessBuilderNode>();
+  n->max_workers = max_workers;
+  return Builder(std::move(n));
+}
+
+TVM_REGISTER_NODE_TYPE(InProcessBuilderNode);
+TVM_REGISTER_GLOBAL("meta_schedule.BuilderInProcessBuilder")
+    .set_body_typed(Builder::InProcessBuilder);
+TVM_REGISTER_GLOBAL("meta_schedule.BuilderIsInMemoryArtifact").set_body_typed(IsInMemoryArtifact);
+TVM_REGISTER_GLOBAL("meta_schedule.BuilderGetInMemoryArtifact")
+    .set_body_typed(GetInMemoryArtifact);
+TVM_REGISTER_GLOBAL("meta_schedule.BuilderRemoveInMemoryArtifact")
+    .set_body_typed(RemoveInMemoryArtifact);
+
+}  // namespace meta_schedule
+}  // namespace tvm
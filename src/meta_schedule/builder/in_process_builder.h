@@ -0,0 +1,56 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file in_process_builder.h
+ * \brief Internal access to the modules the in-process builder keeps in memory.
+ */
+#ifndef TVM_META_SCHEDULE_BUILDER_IN_PROCESS_BUILDER_H_
+#define TVM_META_SCHEDULE_BUILDER_IN_PROCESS_BUILDER_H_
+
+#include <tvm/runtime/container/string.h>
+#include <tvm/runtime/module.h>
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief Check if an artifact path refers to a module kept in memory by the in-process builder.
+ * \param artifact_path The artifact path of a builder result.
+ * \return Whether the artifact is in memory.
+ */
+bool IsInMemoryArtifact(const String& artifact_path);
+
+/*!
+ * \brief Get a module kept in memory by the in-process builder.
+ * \param artifact_path The artifact path of a builder result.
+ * \return The built module.
+ */
+runtime::Module GetInMemoryArtifact(const String& artifact_path);
+
+/*!
+ * \brief Release a module kept in memory by the in-process builder.
+ * \param artifact_path The artifact path of a builder result. Unknown paths are ignored.
+ */
+void RemoveInMemoryArtifact(const String& artifact_path);
+
+}  // namespace meta_schedule
+}  // namespace tvm
+
+#endif  // TVM_META_SCHEDULE_BUILDER_IN_PROCESS_BUILDER_H_
@@ -0,0 +1,85 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef TVM_META_SCHEDULE_COST_MODEL_FEATURE_ROWS_H_
+#define TVM_META_SCHEDULE_COST_MODEL_FEATURE_ROWS_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief Extract the row-major feature rows of each candidate as float32.
+ * \param extractor The feature extractor.
+ * \param context The tuning context.
+ * \param candidates The measure candidates.
+ * \param num_features The number of features of a row, set by the first extraction if it is -1.
+ * \return The feature rows of each candidate.
+ */
+inline std::vector<std::vector<float>> ExtractFeatureRows(const FeatureExtractor& extractor,
+                                                          const TuneContext& context,
+                                                          const Array<MeasureCandidate>& candidates,
+                                                          int* num_features) {
+  Array<runtime::NDArray> arrays = extractor->ExtractFrom(context, candidates);
+  ICHECK_EQ(arrays.size(), candidates.size());
+  std::vector<std::vector<float>> results;
+  results.reserve(arrays.size());
+  for (const runtime::NDArray& array : arrays) {
+    ICHECK_EQ(array->ndim, 2) << "ValueError: Expect 2-dimensional features";
+    ICHECK(array->dtype.code == kDLFloat && (array->dtype.bits == 32 || array->dtype.bits == 64))
+        << "ValueError: Expect float32 or float64 features, but gets: " << array.DataType();
+    int64_t num_rows = array->shape[0];
+    int n = array->shape[1];
+    if (*num_features == -1) {
+      *num_features = n;
+    }
+    CHECK_EQ(n, *num_features) << "ValueError: Inconsistent number of features";
+    size_t size = num_rows * n;
+    if (array->dtype.bits == 32) {
+      const float* data = static_cast<const float*>(array->data);
+      results.emplace_back(data, data + size);
+    } else {
+      const double* data = static_cast<const double*>(array->data);
+      results.emplace_back(data, data + size);
+    }
+  }
+  return results;
+}
+
+/*! \brief The median running time of a result, or 1e10 if it failed */
+inline double MedianRunSecs(const RunnerResult& result) {
+  if (!result->run_secs.defined() || result->run_secs.value().empty()) {
+    return 1e10;
+  }
+  std::vector<double> secs;
+  for (const FloatImm& sec : result->run_secs.value()) {
+    secs.push_back(sec->value);
+  }
+  std::sort(secs.begin(), secs.end());
+  size_t n = secs.size();
+  return n % 2 == 1 ? secs[n / 2] : (secs[n / 2 - 1] + secs[n / 2]) / 2.0;
+}
+
+}  // namespace meta_schedule
+}  // namespace tvm
+
+#endif  // TVM_META_SCHEDULE_COST_MODEL_FEATURE_ROWS_H_
@@ -0,0 +1,591 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file gbdt_model.cc
+ * \brief A gradient-boosted decision tree cost model trained natively.
+ *
+ * The model follows the XGBoost cost model on the python side: a candidate is scored by the sum
+ * of the tree outputs of its feature rows (the "pack-sum" format), trained with the squared error
+ * weighted by the normalized throughput. The trees are grown with histograms over quantized
+ * features, and the model keeps boosting from its current trees when new results arrive instead
+ * of retraining from scratch.
+ */
+#include <random>
+
+#include "../../runtime/file_utils.h"
+#include "./feature_rows.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*! \brief A node of a regression tree. The children of a split node are adjacent. */
+struct GBDTTreeNode {
+  /*! \brief The feature to split on, or -1 for a leaf */
+  int32_t feature;
+  /*! \brief The index of the left child, whose right sibling follows it */
+  int32_t left;
+  /*! \brief A row goes to the left child if its feature is less than the threshold */
+  float threshold;
+  /*! \brief The output of a leaf */
+  float value;
+};
+
+/*! \brief A regression tree, stored as a flat array with the root at index 0 */
+using GBDTTree = std::vector<GBDTTreeNode>;
+
+/*! \brief The feature rows and costs of the measured candidates of a workload */
+struct GBDTFeatureGroup {
+  /*! \brief The structural hash of the workload */
+  uint64_t shash;
+  /*! \brief The row-major feature rows of each candidate */
+  std::vector<std::vector<float>> features;
+  /*! \brief The measured cost of each candidate */
+  std::vector<double> costs;
+  /*! \brief The minimum cost of the workload */
+  double min_cost;
+};
+
+/*! \brief The sum of the gradients and the hessians of the rows in a histogram bin */
+struct GBDTGradStats {
+  double grad = 0.0;
+  double hess = 0.0;
+  int64_t count = 0;
+
+  void Add(const GBDTGradStats& other) {
+    grad += other.grad;
+    hess += other.hess;
+    count += other.count;
+  }
+
+  GBDTGradStats Sub(const GBDTGradStats& other) const {
+    GBDTGradStats result;
+    result.grad = grad - other.grad;
+    result.hess = hess - other.hess;
+    result.count = count - other.count;
+    return result;
+  }
+};
+
+/*! \brief The training data assembled from all the feature groups */
+struct GBDTTrainData {
+  /*! \brief The number of rows */
+  int num_rows = 0;
+  /*! \brief The number of features of a row */
+  int num_features = 0;
+  /*! \brief The row-major features of all the rows */
+  std::vector<float> features;
+  /*! \brief The candidate each row belongs to */
+  std::vector<int> ids;
+  /*! \brief The label of each candidate, i.e. its normalized throughput */
+  std::vector<double> labels;
+  /*! \brief The ascending cut points of each feature */
+  std::vector<std::vector<float>> cuts;
+  /*! \brief The column-major bin of each feature of each row */
+  std::vector<uint8_t> bins;
+
+  /*!
+   * \brief Quantize each feature into at most `num_bins` bins of about equal number of rows.
+   * A row falls in bin `b` of a feature if `cuts[b - 1] <= x < cuts[b]`.
+   */
+  void Quantize(int num_bins, int num_threads) {
+    cuts.resize(num_features);
+    bins.resize(static_cast<size_t>(num_rows) * num_features);
+    auto f_quantize = [&](int thread_id, int f) -> void {
+      std::vector<float> column(num_rows);
+      for (int r = 0; r < num_rows; ++r) {
+        column[r] = features[static_cast<size_t>(r) * num_features + f];
+      }
+      std::vector<float> sorted = column;
+      std::sort(sorted.begin(), sorted.end());
+      std::vector<float>& cut = cuts[f];
+      cut.clear();
+      for (int i = 1; i < num_bins; ++i) {
+        float v = sorted[static_cast<int64_t>(i) * num_rows / num_bins];
+        if (v > sorted.front() && (cut.empty() || v > cut.back())) {
+          cut.push_back(v);
+        }
+      }
+      uint8_t* col_bins = bins.data() + static_cast<size_t>(f) * num_rows;
+      for (int r = 0; r < num_rows; ++r) {
+        col_bins[r] = std::upper_bound(cut.begin(), cut.end(), column[r]) - cut.begin();
+      }
+    };
+    support::parallel_for_dynamic(0, num_features, num_threads, f_quantize);
+  }
+};
+
+/*! \brief The parameters of the tree construction */
+struct GBDTTreeParam {
+  int max_depth;
+  double eta;
+  double gamma;
+  double min_child_weight;
+  double reg_lambda;
+  int num_bins;
+};
+
+/*!
+ * \brief Grow a regression tree depth-first on the gradients of the rows. A node builds the
+ * histogram of its smaller child only, and gets the other one by subtraction.
+ * \param data The training data.
+ * \param gpairs The gradient and the hessian of each row.
+ * \param param The parameters of the tree construction.
+ * \param num_threads The number of threads to build histograms with.
+ * \param margins The outputs of the trees of each row, to which the new tree's are added.
+ * \return The tree grown.
+ */
+GBDTTree GrowTree(const GBDTTrainData& data, const std::vector<GBDTGradStats>& gpairs,
+                  const GBDTTreeParam& param, int num_threads, std::vector<double>* margins) {
+  struct WorkItem {
+    int node_id;
+    int depth;
+    std::vector<int> rows;
+    std::vector<GBDTGradStats> hist;
+    GBDTGradStats sum;
+  };
+  const int num_features = data.num_features;
+  const int num_bins = param.num_bins;
+  auto f_score = [&param](const GBDTGradStats& g) -> double {
+    return g.grad * g.grad / (g.hess + param.reg_lambda);
+  };
+  auto f_build_hist = [&](const std::vector<int>& rows) -> std::vector<GBDTGradStats> {
+    std::vector<GBDTGradStats> hist(static_cast<size_t>(num_features) * num_bins);
+    auto f_feature = [&](int thread_id, int f) -> void {
+      const uint8_t* col_bins = data.bins.data() + static_cast<size_t>(f) * data.num_rows;
+      GBDTGradStats* f_hist = hist.data() + static_cast<size_t>(f) * num_bins;
+      for (int r : rows) {
+        f_hist[col_bins[r]].Add(gpairs[r]);
+      }
+    };
+    // Small nodes are not worth the dispatch to the threads
+    support::parallel_for_dynamic(0, num_features, rows.size() < 1024 ? 1 : num_threads,
+                                  f_feature);
+    return hist;
+  };
+
+  GBDTTree tree(1);
+  std::vector<WorkItem> stack(1);
+  WorkItem& root = stack.back();
+  root.node_id = 0;
+  root.depth = 0;
+  root.rows.resize(data.num_rows);
+  for (int r = 0; r < data.num_rows; ++r) {
+    root.rows[r] = r;
+    root.sum.Add(gpairs[r]);
+  }
+  root.hist = f_build_hist(root.rows);
+  while (!stack.empty()) {
+    WorkItem item = std::move(stack.back());
+    stack.pop_back();
+    // Step 1. Find the best split of each feature
+    std::vector<double> best_gain(num_features, param.gamma);
+    std::vector<int> best_bin(num_features, -1);
+    if (item.depth < param.max_depth && item.rows.size() >= 2) {
+      double parent_score = f_score(item.sum);
+      auto f_find_split = [&](int thread_id, int f) -> void {
+        const GBDTGradStats* f_hist = item.hist.data() + static_cast<size_t>(f) * num_bins;
+        GBDTGradStats left;
+        for (int b = 0, n = data.cuts[f].size(); b < n; ++b) {
+          left.Add(f_hist[b]);
+          GBDTGradStats right = item.sum.Sub(left);
+          if (left.count == 0 || right.count == 0 || left.hess < param.min_child_weight ||
+              right.hess < param.min_child_weight) {
+            continue;
+          }
+          double gain = f_score(left) + f_score(right) - parent_score;
+          if (gain > best_gain[f]) {
+            best_gain[f] = gain;
+            best_bin[f] = b;
+          }
+        }
+      };
+      support::parallel_for_dynamic(0, num_features, item.rows.size() < 1024 ? 1 : num_threads,
+                                    f_find_split);
+    }
+    int feature = -1;
+    for (int f = 0; f < num_features; ++f) {
+      if (best_bin[f] != -1 && (feature == -1 || best_gain[f] > best_gain[feature])) {
+        feature = f;
+      }
+    }
+    // Step 2. Make a leaf if no split reduces the loss by more than `gamma`
+    if (feature == -1) {
+      double value = -param.eta * item.sum.grad / (item.sum.hess + param.reg_lambda);
+      tree[item.node_id] = GBDTTreeNode{-1, -1, 0.0f, static_cast<float>(value)};
+      for (int r : item.rows) {
+        (*margins)[r] += static_cast<float>(value);
+      }
+      continue;
+    }
+    // Step 3. Split the rows, and derive the histogram of the larger child from the smaller one
+    int bin = best_bin[feature];
+    int left_id = tree.size();
+    tree[item.node_id] = GBDTTreeNode{feature, left_id, data.cuts[feature][bin], 0.0f};
+    tree.resize(tree.size() + 2);
+    WorkItem left, right;
+    left.node_id = left_id;
+    right.node_id = left_id + 1;
+    left.depth = right.depth = item.depth + 1;
+    const uint8_t* col_bins = data.bins.data() + static_cast<size_t>(feature) * data.num_rows;
+    for (int r : item.rows) {
+      WorkItem& child = col_bins[r] <= bin ? left : right;
+      child.rows.push_back(r);
+      child.sum.Add(gpairs[r]);
+    }
+    WorkItem& small = left.rows.size() <= right.rows.size() ? left : right;
+    WorkItem& large = left.rows.size() <= right.rows.size() ? right : left;
+    small.hist = f_build_hist(small.rows);
+    large.hist = std::move(item.hist);
+    for (size_t i = 0; i < large.hist.size(); ++i) {
+      large.hist[i] = large.hist[i].Sub(small.hist[i]);
+    }
+    stack.push_back(std::move(right));
+    stack.push_back(std::move(left));
+  }
+  return tree;
+}
+
+/*! \brief The output of a tree on a feature row */
+inline float PredictTree(const GBDTTree& tree, const float* row) {
+  int i = 0;
+  while (tree[i].feature >= 0) {
+    i = row[tree[i].feature] < tree[i].threshold ? tree[i].left : tree[i].left + 1;
+  }
+  return tree[i].value;
+}
+
+/*!
+ * \brief Sum the outputs of the trees on each feature row.
+ * \param trees The trees.
+ * \param rows The row-major feature rows.
+ * \param num_features The number of features of a row.
+ * \param results The output of each row.
+ */
+inline void PredictRows(const std::vector<GBDTTree>& trees, const float* rows, int num_rows,
+                        int num_features, double* results) {
+  // Keep a tree hot in cache while it goes through the rows
+  for (const GBDTTree& tree : trees) {
+    for (int r = 0; r < num_rows; ++r) {
+      results[r] += PredictTree(tree, rows + static_cast<size_t>(r) * num_features);
+    }
+  }
+}
+
+class GBDTModelNode : public CostModelNode {
+ public:
+  /*! \brief The feature extractor */
+  FeatureExtractor extractor{nullptr};
+  /*! \brief The maximum depth of a tree */
+  int max_depth;
+  /*! \brief The learning rate */
+  double eta;
+  /*! \brief The minimum loss reduction of a split */
+  double gamma;
+  /*! \brief The minimum sum of the hessians of a child */
+  double min_child_weight;
+  /*! \brief The L2 regularization on the leaf values */
+  double reg_lambda;
+  /*! \brief The maximum number of bins a feature is quantized into */
+  int num_bins;
+  /*! \brief The maximum number of boosting rounds of one training */
+  int max_num_rounds;
+  /*! \brief The number of rounds without improvement before a training stops */
+  int early_stopping_rounds;
+  /*! \brief The number of trees beyond which the model is retrained from scratch */
+  int max_num_trees;
+  /*! \brief The number of samples before which the predictions are random */
+  int num_warmup_samples;
+  /*! \brief Whether to skip the training until the data grows by 20% */
+  bool adaptive_training;
+  /*! \brief The random state of the predictions during the warmup */
+  TRandState rand_state;
+
+  /*! \brief The number of features of a row, or -1 before any data is given */
+  int num_features_ = -1;
+  /*! \brief The measured data, grouped by workload */
+  std::vector<GBDTFeatureGroup> groups_;
+  /*! \brief The number of measured samples */
+  int64_t data_size_ = 0;
+  /*! \brief The number of measured samples at the last training */
+  int64_t last_train_size_ = 0;
+  /*! \brief The trees */
+  std::vector<GBDTTree> trees_;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("extractor", &extractor);
+    v->Visit("max_depth", &max_depth);
+    v->Visit("eta", &eta);
+    v->Visit("gamma", &gamma);
+    v->Visit("min_child_weight", &min_child_weight);
+    v->Visit("reg_lambda", &reg_lambda);
+    v->Visit("num_bins", &num_bins);
+    v->Visit("max_num_rounds", &max_num_rounds);
+    v->Visit("early_stopping_rounds", &early_stopping_rounds);
+    v->Visit("max_num_trees", &max_num_trees);
+    v->Visit("num_warmup_samples", &num_warmup_samples);
+    v->Visit("adaptive_training", &adaptive_training);
+    v->Visit("rand_state", &rand_state);
+    v->Visit("data_size", &data_size_);
+    // `num_features_` is not visited
+    // `groups_` is not visited
+    // `last_train_size_` is not visited
+    // `trees_` is not visited
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.GBDTModel";
+  TVM_DECLARE_FINAL_OBJECT_INFO(GBDTModelNode, CostModelNode);
+
+ public:
+  void Load(const String& path) final {
+    std::string blob;
+    runtime::LoadBinaryFromFile(path, &blob);
+    dmlc::MemoryStringStream mstrm(&blob);
+    dmlc::Stream* strm = &mstrm;
+    uint64_t magic = 0;
+    CHECK(strm->Read(&magic) && magic == kMagic) << "ValueError: Not a GBDTModel file: " << path;
+    uint64_t num_groups = 0, num_trees = 0;
+    CHECK(strm->Read(&num_features_) && strm->Read(&data_size_) && strm->Read(&last_train_size_) &&
+          strm->Read(&num_groups))
+        << "ValueError: Corrupted GBDTModel file: " << path;
+    groups_.resize(num_groups);
+    for (GBDTFeatureGroup& group : groups_) {
+      CHECK(strm->Read(&group.shash) && strm->Read(&group.costs) && strm->Read(&group.features))
+          << "ValueError: Corrupted GBDTModel file: " << path;
+      group.min_cost = *std::min_element(group.costs.begin(), group.costs.end());
+    }
+    CHECK(strm->Read(&num_trees)) << "ValueError: Corrupted GBDTModel file: " << path;
+    trees_.resize(num_trees);
+    for (GBDTTree& tree : trees_) {
+      CHECK(strm->Read(&tree)) << "ValueError: Corrupted GBDTModel file: " << path;
+    }
+  }
+
+  void Save(const String& path) final {
+    std::string blob;
+    dmlc::MemoryStringStream mstrm(&blob);
+    dmlc::Stream* strm = &mstrm;
+    strm->Write(kMagic);
+    strm->Write(num_features_);
+    strm->Write(data_size_);
+    strm->Write(last_train_size_);
+    strm->Write(static_cast<uint64_t>(groups_.size()));
+    for (const GBDTFeatureGroup& group : groups_) {
+      strm->Write(group.shash);
+      strm->Write(group.costs);
+      strm->Write(group.features);
+    }
+    strm->Write(static_cast<uint64_t>(trees_.size()));
+    for (const GBDTTree& tree : trees_) {
+      strm->Write(tree);
+    }
+    runtime::SaveBinaryToFile(path, blob);
+  }
+
+  void Update(const TuneContext& context, const Array<MeasureCandidate>& candidates,
+              const Array<RunnerResult>& results) final {
+    auto _ = Profiler::TimedScope("GBDTModel/Update");
+    ICHECK_EQ(candidates.size(), results.size());
+    if (candidates.empty()) {
+      return;
+    }
+    // Step 1. Extract the features, dropping the candidates without any
+    std::vector<std::vector<float>> features =
+        ExtractFeatureRows(extractor, context, candidates, &num_features_);
+    std::vector<std::vector<float>> new_features;
+    std::vector<double> new_costs;
+    for (int i = 0, n = candidates.size(); i < n; ++i) {
+      if (!features[i].empty()) {
+        new_features.push_back(std::move(features[i]));
+        new_costs.push_back(MedianRunSecs(results[i]));
+      }
+    }
+    if (new_features.empty()) {
+      return;
+    }
+    // Step 2. Add them to the group of the workload
+    uint64_t shash = context->mod.defined() ? StructuralHash()(context->mod.value()) : 0;
+    auto it = std::find_if(groups_.begin(), groups_.end(),
+                           [shash](const GBDTFeatureGroup& g) { return g.shash == shash; });
+    if (it == groups_.end()) {
+      groups_.push_back(GBDTFeatureGroup{shash, {}, {}, std::numeric_limits<double>::max()});
+      it = groups_.end() - 1;
+    }
+    for (int i = 0, n = new_features.size(); i < n; ++i) {
+      it->features.push_back(std::move(new_features[i]));
+      it->costs.push_back(new_costs[i]);
+      it->min_cost = std::min(it->min_cost, new_costs[i]);
+    }
+    data_size_ += new_costs.size();
+    if (adaptive_training && data_size_ - last_train_size_ < last_train_size_ / 5) {
+      // Set a training threshold related to `last_train_size_` to reduce the training
+      // overhead when there're too many results
+      return;
+    }
+    last_train_size_ = data_size_;
+    // Step 3. Boost from the current trees, or from scratch when there are too many
+    if (static_cast<int>(trees_.size()) >= max_num_trees) {
+      trees_.clear();
+    }
+    Train(context);
+  }
+
+  std::vector<double> Predict(const TuneContext& context,
+                              const Array<MeasureCandidate>& candidates) final {
+    auto _ = Profiler::TimedScope("GBDTModel/Predict");
+    int n = candidates.size();
+    std::vector<double> results(n, 0.0);
+    if (data_size_ < num_warmup_samples || trees_.empty()) {
+      support::LinearCongruentialEngine rand_engine(&rand_state);
+      std::uniform_real_distribution<double> dist(0.0, 1.0);
+      for (double& result : results) {
+        result = dist(rand_engine);
+      }
+      return results;
+    }
+    std::vector<std::vector<float>> features =
+        ExtractFeatureRows(extractor, context, candidates, &num_features_);
+    auto f_predict = [&](int thread_id, int i) -> void {
+      int num_rows = features[i].size() / num_features_;
+      std::vector<double> row_results(num_rows, 0.0);
+      PredictRows(trees_, features[i].data(), num_rows, num_features_, row_results.data());
+      results[i] = std::accumulate(row_results.begin(), row_results.end(), 0.0);
+    };
+    support::parallel_for_dynamic(0, n, context->num_threads, f_predict);
+    return results;
+  }
+
+ private:
+  static constexpr uint64_t kMagic = 0x4C45444F4D544247;  // "GBTMODEL"
+
+  /*!
+   * \brief Boost trees on all the data, starting from the current trees, until the training
+   * p-rmse stops improving for `early_stopping_rounds` rounds.
+   */
+  void Train(const TuneContext& context) {
+    int num_threads = context->num_threads;
+    // Step 1. Assemble the training data
+    GBDTTrainData data;
+    data.num_features = num_features_;
+    for (const GBDTFeatureGroup& group : groups_) {
+      for (int i = 0, n = group.costs.size(); i < n; ++i) {
+        int num_rows = group.features[i].size() / num_features_;
+        data.features.insert(data.features.end(), group.features[i].begin(),
+                             group.features[i].end());
+        data.ids.insert(data.ids.end(), num_rows, data.labels.size());
+        data.labels.push_back(group.min_cost / group.costs[i]);
+        data.num_rows += num_rows;
+      }
+    }
+    data.Quantize(num_bins, num_threads);
+    int num_samples = data.labels.size();
+    // Step 2. Get the margins of the current trees
+    std::vector<double> margins(data.num_rows, 0.0);
+    if (!trees_.empty()) {
+      constexpr int kChunk = 256;
+      auto f_predict = [&](int thread_id, int chunk) -> void {
+        int begin = chunk * kChunk;
+        int num_rows = std::min(kChunk, data.num_rows - begin);
+        PredictRows(trees_, data.features.data() + static_cast<size_t>(begin) * num_features_,
+                    num_rows, num_features_, margins.data() + begin);
+      };
+      support::parallel_for_dynamic(0, (data.num_rows + kChunk - 1) / kChunk, num_threads,
+                                    f_predict);
+    }
+    // Step 3. Boost with the squared error of the pack-sum predictions weighted by the labels
+    GBDTTreeParam param{max_depth, eta, gamma, min_child_weight, reg_lambda, num_bins};
+    std::vector<GBDTGradStats> gpairs(data.num_rows);
+    std::vector<double> preds(num_samples);
+    auto f_eval = [&]() -> double {
+      std::fill(preds.begin(), preds.end(), 0.0);
+      for (int r = 0; r < data.num_rows; ++r) {
+        preds[data.ids[r]] += margins[r];
+      }
+      double square_error = 0.0;
+      for (int r = 0; r < data.num_rows; ++r) {
+        double diff = preds[data.ids[r]] - data.labels[data.ids[r]];
+        square_error += diff * diff;
+      }
+      return std::sqrt(square_error / data.num_rows);
+    };
+    int num_old_trees = trees_.size();
+    double initial_rmse = f_eval();
+    double best_rmse = trees_.empty() ? std::numeric_limits<double>::infinity() : initial_rmse;
+    int best_num_trees = num_old_trees;
+    for (int round = 0; round < max_num_rounds; ++round) {
+      // `preds` is up to date after the last evaluation
+      for (int r = 0; r < data.num_rows; ++r) {
+        double y = data.labels[data.ids[r]];
+        gpairs[r].grad = (preds[data.ids[r]] - y) * y;
+        gpairs[r].hess = y;
+        gpairs[r].count = 1;
+      }
+      trees_.push_back(GrowTree(data, gpairs, param, num_threads, &margins));
+      double rmse = f_eval();
+      if (rmse < best_rmse) {
+        best_rmse = rmse;
+        best_num_trees = trees_.size();
+      } else if (static_cast<int>(trees_.size()) - best_num_trees >= early_stopping_rounds) {
+        break;
+      }
+    }
+    trees_.resize(best_num_trees);
+    TVM_PY_LOG(DEBUG, context->logger)
+        << "GBDTModel: trained " << (best_num_trees - num_old_trees) << " new tree(s) on "
+        << num_samples << " sample(s), " << trees_.size() << " tree(s) in total, p-rmse "
+        << best_rmse;
+  }
+};
+
+CostModel CostModel::GBDTModel(FeatureExtractor extractor, int max_depth, double eta, double gamma,
+                               double min_child_weight, double reg_lambda, int num_bins,
+                               int max_num_rounds, int early_stopping_rounds, int max_num_trees,
+                               int num_warmup_samples, bool adaptive_training, int64_t seed) {
+  CHECK_GT(max_depth, 0) << "ValueError: max_depth must be positive";
+  CHECK(num_bins >= 2 && num_bins <= 256) << "ValueError: num_bins must be in [2, 256]";
+  ObjectPtr<GBDTModelNode> n = make_object<GBDTModelNode>();
+  n->extractor = std::move(extractor);
+  n->max_depth = max_depth;
+  n->eta = eta;
+  n->gamma = gamma;
+  n->min_child_weight = min_child_weight;
+  n->reg_lambda = reg_lambda;
+  n->num_bins = num_bins;
+  n->max_num_rounds = max_num_rounds;
+  n->early_stopping_rounds = early_stopping_rounds;
+  n->max_num_trees = max_num_trees;
+  n->num_warmup_samples = num_warmup_samples;
+  n->adaptive_training = adaptive_training;
+  n->rand_state = support::LinearCongruentialEngine::NormalizeSeed(seed);
+  return CostModel(n);
+}
+
+TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
+    .set_dispatch<GBDTModelNode>([](const ObjectRef& n, ReprPrinter* p) {
+      const auto* self = n.as<GBDTModelNode>();
+      ICHECK(self);
+      p->stream << "meta_schedule.GBDTModel(num_trees=" << self->trees_.size()
+                << ", data_size=" << self->data_size_ << ")";
+    });
+
+TVM_REGISTER_NODE_TYPE(GBDTModelNode);
+TVM_REGISTER_GLOBAL("meta_schedule.CostModelGBDTModel").set_body_typed(CostModel::GBDTModel);
+
+}  // namespace meta_schedule
+}  // namespace tvm
@@ -0,0 +1,797 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file mlp_model.cc
+ * \brief The segment-sum MLP cost model, trained and run natively.
+ *
+ * The network is the `SegmentSumMLP` of the python MLP cost model: the feature rows of a candidate
+ * are encoded by two layers, summed, and decoded to a score through two residual layers. It is
+ * trained with the same lambda-rank loss and Adam optimizer. The weights are stored as a TVM
+ * parameter dict named after the PyTorch state dict, so that the weights trained in python can be
+ * exported and loaded without PyTorch.
+ */
+#include <array>
+#include <numeric>
+#include <random>
+
+#include "../../runtime/file_utils.h"
+#include "./feature_rows.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*! \brief A fully-connected layer, whose weight is row-major like the one of `torch.nn.Linear` */
+struct MLPLinear {
+  int in_dim = 0;
+  int out_dim = 0;
+  /*! \brief The weight of shape (out_dim, in_dim) */
+  std::vector<float> weight;
+  /*! \brief The bias of shape (out_dim,) */
+  std::vector<float> bias;
+
+  /*! \brief The number of rows processed by a thread at a time */
+  static constexpr int kRowChunk = 32;
+
+  /*! \brief A layer of the same shape with zero weight and bias */
+  MLPLinear ZerosLike() const {
+    MLPLinear result;
+    result.in_dim = in_dim;
+    result.out_dim = out_dim;
+    result.weight.assign(weight.size(), 0.0f);
+    result.bias.assign(bias.size(), 0.0f);
+    return result;
+  }
+
+  /*! \brief Initialize like `torch.nn.Linear`, uniformly in [-1/sqrt(in_dim), 1/sqrt(in_dim)] */
+  void Init(int in, int out, support::LinearCongruentialEngine::TRandState* rand_state) {
+    in_dim = in;
+    out_dim = out;
+    float bound = 1.0f / std::sqrt(static_cast<float>(in));
+    support::LinearCongruentialEngine rand_engine(rand_state);
+    std::uniform_real_distribution<float> dist(-bound, bound);
+    weight.resize(static_cast<size_t>(in) * out);
+    bias.resize(out);
+    for (float& w : weight) {
+      w = dist(rand_engine);
+    }
+    for (float& b : bias) {
+      b = dist(rand_engine);
+    }
+  }
+
+  /*! \brief Compute `y = x * weight^T + bias` on `n` rows, optionally followed by a ReLU */
+  void Forward(const float* x, int n, bool relu, int num_threads, float* y) const {
+    auto f_chunk = [&](int thread_id, int chunk) -> void {
+      int end = std::min(n, (chunk + 1) * kRowChunk);
+      for (int r = chunk * kRowChunk; r < end; ++r) {
+        const float* x_row = x + static_cast<size_t>(r) * in_dim;
+        float* y_row = y + static_cast<size_t>(r) * out_dim;
+        for (int o = 0; o < out_dim; ++o) {
+          const float* w_row = weight.data() + static_cast<size_t>(o) * in_dim;
+          float acc = 0.0f;
+          for (int i = 0; i < in_dim; ++i) {
+            acc += x_row[i] * w_row[i];
+          }
+          acc += bias[o];
+          y_row[o] = relu ? std::max(acc, 0.0f) : acc;
+        }
+      }
+    };
+    support::parallel_for_dynamic(0, (n + kRowChunk - 1) / kRowChunk, num_threads, f_chunk);
+  }
+
+  /*!
+   * \brief Back-propagate the gradient `dy` of the output of `Forward` on `n` rows.
+   * \param x The input of the forward pass.
+   * \param dy The gradient of the output, before the ReLU if any.
+   * \param grad The gradient of the weight and the bias to accumulate to.
+   * \param dx The gradient of the input to write, or nullptr if not needed.
+   */
+  void Backward(const float* x, const float* dy, int n, int num_threads, MLPLinear* grad,
+                float* dx) const {
+    // Each thread owns a row of the gradient of the weight
+    auto f_weight = [&](int thread_id, int o) -> void {
+      float* gw_row = grad->weight.data() + static_cast<size_t>(o) * in_dim;
+      float gb = 0.0f;
+      for (int r = 0; r < n; ++r) {
+        float g = dy[static_cast<size_t>(r) * out_dim + o];
+        if (g == 0.0f) {
+          continue;
+        }
+        const float* x_row = x + static_cast<size_t>(r) * in_dim;
+        for (int i = 0; i < in_dim; ++i) {
+          gw_row[i] += g * x_row[i];
+        }
+        gb += g;
+      }
+      grad->bias[o] += gb;
+    };
+    support::parallel_for_dynamic(0, out_dim, num_threads, f_weight);
+    if (dx == nullptr) {
+      return;
+    }
+    auto f_input = [&](int thread_id, int chunk) -> void {
+      int end = std::min(n, (chunk + 1) * kRowChunk);
+      for (int r = chunk * kRowChunk; r < end; ++r) {
+        const float* dy_row = dy + static_cast<size_t>(r) * out_dim;
+        float* dx_row = dx + static_cast<size_t>(r) * in_dim;
+        std::fill(dx_row, dx_row + in_dim, 0.0f);
+        for (int o = 0; o < out_dim; ++o) {
+          const float* w_row = weight.data() + static_cast<size_t>(o) * in_dim;
+          float g = dy_row[o];
+          for (int i = 0; i < in_dim; ++i) {
+            dx_row[i] += g * w_row[i];
+          }
+        }
+      }
+    };
+    support::parallel_for_dynamic(0, (n + kRowChunk - 1) / kRowChunk, num_threads, f_input);
+  }
+};
+
+/*! \brief The layers of a segment-sum MLP, in the order of `kMLPLayerNames` */
+enum MLPLayer : int {
+  kEncoder0 = 0,
+  kEncoder1 = 1,
+  kResidual0 = 2,
+  kResidual1 = 3,
+  kDecoder = 4,
+  kNumMLPLayers = 5,
+};
+
+/*! \brief The names of the layers in the state dict of the PyTorch `SegmentSumMLP` */
+static const char* kMLPLayerNames[kNumMLPLayers] = {"encoder.0", "encoder.2", "layer0.0",
+                                                    "layer1.0", "decoder"};
+
+using MLPLayers = std::array<MLPLinear, kNumMLPLayers>;
+
+/*! \brief A batch of candidates, whose feature rows are concatenated */
+struct MLPBatch {
+  /*! \brief The row-major feature rows of all the candidates */
+  std::vector<float> features;
+  /*! \brief The first row of each candidate, followed by the total number of rows */
+  std::vector<int> offsets{0};
+  /*! \brief The label of each candidate, i.e. its normalized throughput */
+  std::vector<float> labels;
+
+  int NumRows() const { return offsets.back(); }
+  int NumSegments() const { return static_cast<int>(offsets.size()) - 1; }
+
+  void Add(const std::vector<float>& rows, int num_features) {
+    features.insert(features.end(), rows.begin(), rows.end());
+    offsets.push_back(offsets.back() + static_cast<int>(rows.size()) / num_features);
+  }
+};
+
+/*! \brief The intermediate results of the forward pass, kept for the backward pass */
+struct MLPActivations {
+  std::vector<float> encoded0, encoded1, segment_sum, residual0, hidden0, residual1, hidden1;
+  std::vector<float> outputs;
+};
+
+/*! \brief The feature rows and costs of the measured candidates of a workload */
+struct MLPFeatureGroup {
+  /*! \brief The structural hash of the workload */
+  uint64_t shash;
+  /*! \brief The row-major feature rows of each candidate */
+  std::vector<std::vector<float>> features;
+  /*! \brief The measured cost of each candidate */
+  std::vector<double> costs;
+  /*! \brief The minimum cost of the workload */
+  double min_cost;
+};
+
+/*! \brief The state of the Adam optimizer */
+struct MLPAdamState {
+  MLPLayers exp_avg, exp_avg_sq;
+  int step = 0;
+};
+
+
+/*! \brief Apply the ReLU mask of `activations` to the gradient `grads` in place */
+inline void MaskReLU(const std::vector<float>& activations, std::vector<float>* grads) {
+  for (size_t i = 0; i < grads->size(); ++i) {
+    if (activations[i] <= 0.0f) {
+      (*grads)[i] = 0.0f;
+    }
+  }
+}
+
+/*! \brief The forward pass of the segment-sum MLP on a batch, giving a score per candidate */
+void MLPForward(const MLPLayers& layers, bool use_sigmoid, const MLPBatch& batch, int num_threads,
+                MLPActivations* acts) {
+  int n = batch.NumRows();
+  int num_segments = batch.NumSegments();
+  int hidden_dim = layers[kEncoder0].out_dim;
+  acts->encoded0.resize(static_cast<size_t>(n) * hidden_dim);
+  acts->encoded1.resize(static_cast<size_t>(n) * hidden_dim);
+  layers[kEncoder0].Forward(batch.features.data(), n, true, num_threads, acts->encoded0.data());
+  layers[kEncoder1].Forward(acts->encoded0.data(), n, true, num_threads, acts->encoded1.data());
+  // Sum the encoded rows of each candidate
+  acts->segment_sum.assign(static_cast<size_t>(num_segments) * hidden_dim, 0.0f);
+  for (int c = 0; c < num_segments; ++c) {
+    float* sum = acts->segment_sum.data() + static_cast<size_t>(c) * hidden_dim;
+    for (int r = batch.offsets[c]; r < batch.offsets[c + 1]; ++r) {
+      const float* row = acts->encoded1.data() + static_cast<size_t>(r) * hidden_dim;
+      for (int h = 0; h < hidden_dim; ++h) {
+        sum[h] += row[h];
+      }
+    }
+  }
+  // Two residual layers, followed by the decoder
+  size_t size = static_cast<size_t>(num_segments) * hidden_dim;
+  acts->residual0.resize(size);
+  acts->hidden0.resize(size);
+  acts->residual1.resize(size);
+  acts->hidden1.resize(size);
+  layers[kResidual0].Forward(acts->segment_sum.data(), num_segments, true, num_threads,
+                             acts->residual0.data());
+  for (size_t i = 0; i < size; ++i) {
+    acts->hidden0[i] = acts->residual0[i] + acts->segment_sum[i];
+  }
+  layers[kResidual1].Forward(acts->hidden0.data(), num_segments, true, num_threads,
+                             acts->residual1.data());
+  for (size_t i = 0; i < size; ++i) {
+    acts->hidden1[i] = acts->residual1[i] + acts->hidden0[i];
+  }
+  acts->outputs.resize(num_segments);
+  layers[kDecoder].Forward(acts->hidden1.data(), num_segments, false, num_threads,
+                           acts->outputs.data());
+  if (use_sigmoid) {
+    for (float& y : acts->outputs) {
+      y = 1.0f / (1.0f + std::exp(-y));
+    }
+  }
+}
+
+/*! \brief The backward pass of the segment-sum MLP, from the gradient of the scores */
+void MLPBackward(const MLPLayers& layers, bool use_sigmoid, const MLPBatch& batch,
+                 const MLPActivations& acts, std::vector<float> d_outputs, int num_threads,
+                 MLPLayers* grads) {
+  int n = batch.NumRows();
+  int num_segments = batch.NumSegments();
+  int hidden_dim = layers[kEncoder0].out_dim;
+  size_t size = static_cast<size_t>(num_segments) * hidden_dim;
+  if (use_sigmoid) {
+    for (int c = 0; c < num_segments; ++c) {
+      d_outputs[c] *= acts.outputs[c] * (1.0f - acts.outputs[c]);
+    }
+  }
+  std::vector<float> d_hidden1(size), d_hidden0(size), d_segment_sum(size);
+  layers[kDecoder].Backward(acts.hidden1.data(), d_outputs.data(), num_segments, num_threads,
+                            &(*grads)[kDecoder], d_hidden1.data());
+  // hidden1 = relu(residual1(hidden0)) + hidden0
+  std::vector<float> d_residual = d_hidden1;
+  MaskReLU(acts.residual1, &d_residual);
+  layers[kResidual1].Backward(acts.hidden0.data(), d_residual.data(), num_segments, num_threads,
+                              &(*grads)[kResidual1], d_hidden0.data());
+  for (size_t i = 0; i < size; ++i) {
+    d_hidden0[i] += d_hidden1[i];
+  }
+  // hidden0 = relu(residual0(segment_sum)) + segment_sum
+  d_residual = d_hidden0;
+  MaskReLU(acts.residual0, &d_residual);
+  layers[kResidual0].Backward(acts.segment_sum.data(), d_residual.data(), num_segments,
+                              num_threads, &(*grads)[kResidual0], d_segment_sum.data());
+  for (size_t i = 0; i < size; ++i) {
+    d_segment_sum[i] += d_hidden0[i];
+  }
+  // Every row gets the gradient of the sum of its candidate
+  std::vector<float> d_encoded1(static_cast<size_t>(n) * hidden_dim);
+  for (int c = 0; c < num_segments; ++c) {
+    const float* d_sum = d_segment_sum.data() + static_cast<size_t>(c) * hidden_dim;
+    for (int r = batch.offsets[c]; r < batch.offsets[c + 1]; ++r) {
+      std::copy(d_sum, d_sum + hidden_dim, d_encoded1.data() + static_cast<size_t>(r) * hidden_dim);
+    }
+  }
+  MaskReLU(acts.encoded1, &d_encoded1);
+  std::vector<float> d_encoded0(static_cast<size_t>(n) * hidden_dim);
+  layers[kEncoder1].Backward(acts.encoded0.data(), d_encoded1.data(), n, num_threads,
+                             &(*grads)[kEncoder1], d_encoded0.data());
+  MaskReLU(acts.encoded0, &d_encoded0);
+  layers[kEncoder0].Backward(batch.features.data(), d_encoded0.data(), n, num_threads,
+                             &(*grads)[kEncoder0], nullptr);
+}
+
+/*!
+ * \brief The lambda-rank loss of `lambda_rank_loss` in the python MLP cost model, weighting the
+ * pairwise logistic loss of the candidates by their change of NDCG.
+ * \param preds The predicted scores.
+ * \param labels The labels, i.e. the normalized throughputs.
+ * \param grads The gradient of the loss with respect to the scores, as output.
+ * \return The loss.
+ */
+double LambdaRankLoss(const std::vector<float>& preds, const std::vector<float>& labels,
+                      std::vector<float>* grads) {
+  constexpr double kEps = 1e-10;
+  int n = preds.size();
+  grads->assign(n, 0.0f);
+  // Rank the candidates by their predicted score
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&preds](int a, int b) { return preds[a] > preds[b]; });
+  std::vector<double> sorted_labels(labels.begin(), labels.end());
+  std::sort(sorted_labels.begin(), sorted_labels.end(), std::greater<double>());
+  std::vector<double> inv_discounts(n);
+  double max_dcg = 0.0;
+  for (int i = 0; i < n; ++i) {
+    inv_discounts[i] = 1.0 / std::log2(2.0 + i);
+    max_dcg += (std::pow(2.0, sorted_labels[i]) - 1.0) * inv_discounts[i];
+  }
+  if (max_dcg <= 0.0) {
+    return 0.0;
+  }
+  std::vector<double> gains(n);
+  for (int i = 0; i < n; ++i) {
+    gains[i] = (std::pow(2.0, labels[order[i]]) - 1.0) / max_dcg;
+  }
+  double loss = 0.0;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      int a = order[i], b = order[j];
+      if (!(labels[a] > labels[b])) {
+        continue;
+      }
+      double weight =
+          std::abs(inv_discounts[i] - inv_discounts[j]) * std::abs(gains[i] - gains[j]);
+      double prob = std::max(1.0 / (1.0 + std::exp(-(preds[a] - preds[b]))), kEps);
+      loss -= weight * std::log2(prob);
+      // d(-weight * log2(sigmoid(s_a - s_b))) / d(s_a)
+      double lambda = -weight * (1.0 - prob) / std::log(2.0);
+      (*grads)[a] += lambda;
+      (*grads)[b] -= lambda;
+    }
+  }
+  return loss;
+}
+
+class SegmentSumMLPModelNode : public CostModelNode {
+ public:
+  /*! \brief The feature extractor */
+  FeatureExtractor extractor{nullptr};
+  /*! \brief The hidden dim of the layers */
+  int hidden_dim;
+  /*! \brief Whether to apply a sigmoid on the output */
+  bool use_sigmoid;
+  /*! \brief The number of candidates in a training batch */
+  int batch_size;
+  /*! \brief The learning rate */
+  double learning_rate;
+  /*! \brief The L2 penalty added to the gradients, as in `torch.optim.Adam` */
+  double weight_decay;
+  /*! \brief The number of epochs of a full training */
+  int num_epoch_full;
+  /*! \brief The number of epochs of an incremental training */
+  int num_epoch_incremental;
+  /*! \brief The maximum norm of the gradients */
+  double grad_clip_norm;
+  /*! \brief The fraction of the workloads held out to select the best epoch of a full training */
+  double test_split;
+  /*! \brief Whether to keep the weights as they are, e.g. when they are pre-trained */
+  bool frozen;
+  /*! \brief The random state */
+  support::LinearCongruentialEngine::TRandState rand_state;
+
+  /*! \brief The number of features of a row, or -1 if not known yet */
+  int num_features_ = -1;
+  /*! \brief The feature groups of the workloads */
+  std::vector<MLPFeatureGroup> groups_;
+  /*! \brief The number of samples */
+  int64_t data_size_ = 0;
+  /*! \brief The number of samples added since the last full training */
+  int64_t untrained_size_ = 0;
+  /*! \brief The layers, empty until the number of features is known */
+  MLPLayers layers_;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("extractor", &extractor);
+    v->Visit("hidden_dim", &hidden_dim);
+    v->Visit("use_sigmoid", &use_sigmoid);
+    v->Visit("batch_size", &batch_size);
+    v->Visit("learning_rate", &learning_rate);
+    v->Visit("weight_decay", &weight_decay);
+    v->Visit("num_epoch_full", &num_epoch_full);
+    v->Visit("num_epoch_incremental", &num_epoch_incremental);
+    v->Visit("grad_clip_norm", &grad_clip_norm);
+    v->Visit("test_split", &test_split);
+    v->Visit("frozen", &frozen);
+    v->Visit("rand_state", &rand_state);
+    v->Visit("data_size", &data_size_);
+    // `num_features_` is not visited
+    // `groups_` is not visited
+    // `untrained_size_` is not visited
+    // `layers_` is not visited
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.SegmentSumMLPModel";
+  TVM_DECLARE_FINAL_OBJECT_INFO(SegmentSumMLPModelNode, CostModelNode);
+
+ public:
+  void Load(const String& path) final {
+    Map<String, runtime::NDArray> params;
+    if (runtime::IsMappableParamsFile(path)) {
+      params = runtime::LoadMappedParams(path);
+    } else {
+      runtime::SimpleBinaryFileStream strm(path, "rb");
+      params = runtime::LoadParams(&strm);
+    }
+    CHECK(!params.count("norm.weight") && !params.count("norm.running_mean"))
+        << "ValueError: SegmentSumMLPModel doesn't support the weights of a model with use_norm";
+    for (int l = 0; l < kNumMLPLayers; ++l) {
+      std::string name = kMLPLayerNames[l];
+      CHECK(params.count(name + ".weight") && params.count(name + ".bias"))
+          << "ValueError: Missing the weights of layer " << name << " in: " << path;
+      runtime::NDArray weight = params.at(name + ".weight");
+      runtime::NDArray bias = params.at(name + ".bias");
+      CHECK(weight->ndim == 2 && bias->ndim == 1 && bias->shape[0] == weight->shape[0] &&
+            weight.DataType() == DataType::Float(32) && bias.DataType() == DataType::Float(32))
+          << "ValueError: Expect a float32 weight of shape (out_dim, in_dim) and a bias of shape "
+             "(out_dim,) for layer "
+          << name;
+      MLPLinear& layer = layers_[l];
+      layer.out_dim = weight->shape[0];
+      layer.in_dim = weight->shape[1];
+      layer.weight.resize(static_cast<size_t>(layer.out_dim) * layer.in_dim);
+      layer.bias.resize(layer.out_dim);
+      weight.CopyToBytes(layer.weight.data(), layer.weight.size() * sizeof(float));
+      bias.CopyToBytes(layer.bias.data(), layer.bias.size() * sizeof(float));
+    }
+    hidden_dim = layers_[kEncoder0].out_dim;
+    for (int l = kEncoder1; l < kDecoder; ++l) {
+      CHECK(layers_[l].in_dim == hidden_dim && layers_[l].out_dim == hidden_dim)
+          << "ValueError: Inconsistent hidden dim of layer " << kMLPLayerNames[l];
+    }
+    CHECK(layers_[kDecoder].in_dim == hidden_dim && layers_[kDecoder].out_dim == 1)
+        << "ValueError: Expect the decoder to output a single score";
+    if (num_features_ == -1) {
+      num_features_ = layers_[kEncoder0].in_dim;
+    }
+    CHECK_EQ(num_features_, layers_[kEncoder0].in_dim)
+        << "ValueError: The weights expect " << layers_[kEncoder0].in_dim
+        << " features, but the model has " << num_features_;
+  }
+
+  void Save(const String& path) final {
+    CHECK(Initialized()) << "ValueError: Cannot save a SegmentSumMLPModel with no weights";
+    Map<String, runtime::NDArray> params;
+    for (int l = 0; l < kNumMLPLayers; ++l) {
+      const MLPLinear& layer = layers_[l];
+      runtime::NDArray weight = runtime::NDArray::Empty({layer.out_dim, layer.in_dim},
+                                                        DataType::Float(32), {kDLCPU, 0});
+      runtime::NDArray bias =
+          runtime::NDArray::Empty({layer.out_dim}, DataType::Float(32), {kDLCPU, 0});
+      weight.CopyFromBytes(layer.weight.data(), layer.weight.size() * sizeof(float));
+      bias.CopyFromBytes(layer.bias.data(), layer.bias.size() * sizeof(float));
+      params.Set(std::string(kMLPLayerNames[l]) + ".weight", weight);
+      params.Set(std::string(kMLPLayerNames[l]) + ".bias", bias);
+    }
+    runtime::SimpleBinaryFileStream strm(path, "wb");
+    runtime::SaveParams(&strm, params);
+  }
+
+  void Update(const TuneContext& context, const Array<MeasureCandidate>& candidates,
+              const Array<RunnerResult>& results) final {
+    auto _ = Profiler::TimedScope("SegmentSumMLPModel/Update");
+    ICHECK_EQ(candidates.size(), results.size());
+    if (candidates.empty()) {
+      return;
+    }
+    // Step 1. Extract the features, dropping the candidates without any
+    std::vector<std::vector<float>> features =
+        ExtractFeatureRows(extractor, context, candidates, &num_features_);
+    std::vector<std::vector<float>> new_features;
+    std::vector<double> new_costs;
+    for (int i = 0, n = candidates.size(); i < n; ++i) {
+      if (!features[i].empty()) {
+        new_features.push_back(std::move(features[i]));
+        new_costs.push_back(MedianRunSecs(results[i]));
+      }
+    }
+    if (new_features.empty()) {
+      return;
+    }
+    // Step 2. Add them to the group of the workload
+    uint64_t shash = context->mod.defined() ? StructuralHash()(context->mod.value()) : 0;
+    auto it = std::find_if(groups_.begin(), groups_.end(),
+                           [shash](const MLPFeatureGroup& g) { return g.shash == shash; });
+    if (it == groups_.end()) {
+      groups_.push_back(MLPFeatureGroup{shash, {}, {}, std::numeric_limits<double>::max()});
+      it = groups_.end() - 1;
+    }
+    for (int i = 0, n = new_features.size(); i < n; ++i) {
+      it->features.push_back(new_features[i]);
+      it->costs.push_back(new_costs[i]);
+      it->min_cost = std::min(it->min_cost, new_costs[i]);
+    }
+    data_size_ += new_costs.size();
+    untrained_size_ += new_costs.size();
+    if (frozen) {
+      return;
+    }
+    EnsureInitialized();
+    // Step 3. Retrain on all the data once enough of it is new, or else fine-tune on the new data
+    if (untrained_size_ * 5 > data_size_) {
+      TrainFull(context);
+      untrained_size_ = 0;
+    } else {
+      double min_cost = *std::min_element(new_costs.begin(), new_costs.end());
+      std::vector<float> labels;
+      for (double cost : new_costs) {
+        labels.push_back(min_cost / cost);
+      }
+      MLPAdamState adam = NewAdamState();
+      for (int epoch = 0; epoch < num_epoch_incremental; ++epoch) {
+        TrainEpoch(new_features, labels, learning_rate, context->num_threads, &adam);
+      }
+      untrained_size_ = std::max<int64_t>(0, untrained_size_ - new_costs.size());
+    }
+  }
+
+  std::vector<double> Predict(const TuneContext& context,
+                              const Array<MeasureCandidate>& candidates) final {
+    auto _ = Profiler::TimedScope("SegmentSumMLPModel/Predict");
+    int n = candidates.size();
+    std::vector<double> results(n, 0.0);
+    if (n == 0) {
+      return results;
+    }
+    std::vector<std::vector<float>> features =
+        ExtractFeatureRows(extractor, context, candidates, &num_features_);
+    EnsureInitialized();
+    std::vector<float> scores = PredictAll(features, context->num_threads);
+    std::copy(scores.begin(), scores.end(), results.begin());
+    return results;
+  }
+
+ private:
+  bool Initialized() const { return !layers_[kEncoder0].weight.empty(); }
+
+  /*! \brief Initialize the layers at random once the number of features is known */
+  void EnsureInitialized() {
+    if (Initialized()) {
+      return;
+    }
+    CHECK_GT(num_features_, 0) << "ValueError: The number of features is unknown";
+    layers_[kEncoder0].Init(num_features_, hidden_dim, &rand_state);
+    for (int l = kEncoder1; l < kDecoder; ++l) {
+      layers_[l].Init(hidden_dim, hidden_dim, &rand_state);
+    }
+    layers_[kDecoder].Init(hidden_dim, 1, &rand_state);
+  }
+
+  MLPAdamState NewAdamState() const {
+    MLPAdamState adam;
+    for (int l = 0; l < kNumMLPLayers; ++l) {
+      adam.exp_avg[l] = layers_[l].ZerosLike();
+      adam.exp_avg_sq[l] = layers_[l].ZerosLike();
+    }
+    return adam;
+  }
+
+  /*! \brief Assemble the batch of the given samples */
+  MLPBatch MakeBatch(const std::vector<std::vector<float>>& features,
+                     const std::vector<float>& labels, const int* indices, int n) const {
+    MLPBatch batch;
+    for (int i = 0; i < n; ++i) {
+      batch.Add(features[indices[i]], num_features_);
+      if (!labels.empty()) {
+        batch.labels.push_back(labels[indices[i]]);
+      }
+    }
+    return batch;
+  }
+
+  /*! \brief Predict the scores of candidates in batches of `batch_size` */
+  std::vector<float> PredictAll(const std::vector<std::vector<float>>& features,
+                                int num_threads) const {
+    int n = features.size();
+    std::vector<int> indices(n);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::vector<float> scores;
+    scores.reserve(n);
+    MLPActivations acts;
+    for (int begin = 0; begin < n; begin += batch_size) {
+      int size = std::min(batch_size, n - begin);
+      MLPBatch batch = MakeBatch(features, {}, indices.data() + begin, size);
+      MLPForward(layers_, use_sigmoid, batch, num_threads, &acts);
+      scores.insert(scores.end(), acts.outputs.begin(), acts.outputs.end());
+    }
+    return scores;
+  }
+
+  /*!
+   * \brief Train one epoch on shuffled batches of the given samples.
+   * \return The mean loss of the batches.
+   */
+  double TrainEpoch(const std::vector<std::vector<float>>& features,
+                    const std::vector<float>& labels, double lr, int num_threads,
+                    MLPAdamState* adam) {
+    int n = features.size();
+    std::vector<int> indices(n);
+    std::iota(indices.begin(), indices.end(), 0);
+    support::LinearCongruentialEngine rand_engine(&rand_state);
+    std::shuffle(indices.begin(), indices.end(), rand_engine);
+    MLPActivations acts;
+    std::vector<float> d_outputs;
+    double total_loss = 0.0;
+    int num_batches = 0;
+    for (int begin = 0; begin < n; begin += batch_size) {
+      int size = std::min(batch_size, n - begin);
+      MLPBatch batch = MakeBatch(features, labels, indices.data() + begin, size);
+      MLPForward(layers_, use_sigmoid, batch, num_threads, &acts);
+      total_loss += LambdaRankLoss(acts.outputs, batch.labels, &d_outputs);
+      ++num_batches;
+      MLPLayers grads;
+      for (int l = 0; l < kNumMLPLayers; ++l) {
+        grads[l] = layers_[l].ZerosLike();
+      }
+      MLPBackward(layers_, use_sigmoid, batch, acts, d_outputs, num_threads, &grads);
+      AdamStep(&grads, lr, adam);
+    }
+    return num_batches > 0 ? total_loss / num_batches : 0.0;
+  }
+
+  /*! \brief Clip the gradients by their global norm, then take a step of `torch.optim.Adam` */
+  void AdamStep(MLPLayers* grads, double lr, MLPAdamState* adam) {
+    constexpr double kBeta1 = 0.9, kBeta2 = 0.999, kEps = 1e-8;
+    double square_norm = 0.0;
+    for (const MLPLinear& grad : *grads) {
+      for (float g : grad.weight) {
+        square_norm += static_cast<double>(g) * g;
+      }
+      for (float g : grad.bias) {
+        square_norm += static_cast<double>(g) * g;
+      }
+    }
+    double clip_coef = grad_clip_norm / (std::sqrt(square_norm) + 1e-6);
+    float scale = clip_coef < 1.0 ? clip_coef : 1.0;
+    int step = ++adam->step;
+    double bias_correction1 = 1.0 - std::pow(kBeta1, step);
+    double bias_correction2 = 1.0 - std::pow(kBeta2, step);
+    auto f_update = [&](std::vector<float>* params, const std::vector<float>& grad,
+                        std::vector<float>* exp_avg, std::vector<float>* exp_avg_sq) {
+      for (size_t i = 0; i < params->size(); ++i) {
+        double g = grad[i] * scale + weight_decay * (*params)[i];
+        (*exp_avg)[i] = kBeta1 * (*exp_avg)[i] + (1.0 - kBeta1) * g;
+        (*exp_avg_sq)[i] = kBeta2 * (*exp_avg_sq)[i] + (1.0 - kBeta2) * g * g;
+        double denom = std::sqrt((*exp_avg_sq)[i] / bias_correction2) + kEps;
+        (*params)[i] -= lr * (*exp_avg)[i] / bias_correction1 / denom;
+      }
+    };
+    for (int l = 0; l < kNumMLPLayers; ++l) {
+      f_update(&layers_[l].weight, (*grads)[l].weight, &adam->exp_avg[l].weight,
+               &adam->exp_avg_sq[l].weight);
+      f_update(&layers_[l].bias, (*grads)[l].bias, &adam->exp_avg[l].bias,
+               &adam->exp_avg_sq[l].bias);
+    }
+  }
+
+  /*!
+   * \brief Train on all the data for `num_epoch_full` epochs, decaying the learning rate by 0.8
+   * every tenth of them. A fraction of the workloads is held out, and the weights of the epoch with
+   * the lowest loss on them are kept.
+   */
+  void TrainFull(const TuneContext& context) {
+    int num_threads = context->num_threads;
+    // Step 1. Split the workloads into training and testing ones
+    std::vector<int> group_indices(groups_.size());
+    std::iota(group_indices.begin(), group_indices.end(), 0);
+    support::LinearCongruentialEngine rand_engine(&rand_state);
+    std::shuffle(group_indices.begin(), group_indices.end(), rand_engine);
+    int num_test = static_cast<int>(std::floor(groups_.size() * test_split));
+    std::vector<std::vector<float>> train_features, test_features;
+    std::vector<float> train_labels, test_labels;
+    for (int k = 0, n = group_indices.size(); k < n; ++k) {
+      const MLPFeatureGroup& group = groups_[group_indices[k]];
+      bool is_test = k < num_test;
+      for (int i = 0, m = group.costs.size(); i < m; ++i) {
+        (is_test ? test_features : train_features).push_back(group.features[i]);
+        (is_test ? test_labels : train_labels).push_back(group.min_cost / group.costs[i]);
+      }
+    }
+    // Step 2. Train, keeping the best weights on the testing workloads
+    MLPAdamState adam = NewAdamState();
+    int step_size = std::max(1, num_epoch_full / 10);
+    double lr = learning_rate;
+    double min_test_loss = std::numeric_limits<double>::infinity();
+    MLPLayers best_layers = layers_;
+    double train_loss = 0.0;
+    for (int epoch = 0; epoch < num_epoch_full; ++epoch) {
+      train_loss = TrainEpoch(train_features, train_labels, lr, num_threads, &adam);
+      if ((epoch + 1) % step_size == 0) {
+        lr *= 0.8;
+      }
+      if (!test_features.empty()) {
+        double test_loss = TestLoss(test_features, test_labels, num_threads);
+        if (test_loss < min_test_loss) {
+          min_test_loss = test_loss;
+          best_layers = layers_;
+        }
+      }
+    }
+    if (!test_features.empty()) {
+      layers_ = std::move(best_layers);
+    }
+    TVM_PY_LOG(DEBUG, context->logger)
+        << "SegmentSumMLPModel: trained " << num_epoch_full << " epoch(s) on "
+        << train_features.size() << " sample(s), train loss " << train_loss << ", test loss "
+        << min_test_loss;
+  }
+
+  /*! \brief The mean lambda-rank loss of the batches of the given samples */
+  double TestLoss(const std::vector<std::vector<float>>& features,
+                  const std::vector<float>& labels, int num_threads) const {
+    int n = features.size();
+    std::vector<int> indices(n);
+    std::iota(indices.begin(), indices.end(), 0);
+    MLPActivations acts;
+    std::vector<float> unused_grads;
+    double total_loss = 0.0;
+    int num_batches = 0;
+    for (int begin = 0; begin < n; begin += batch_size) {
+      int size = std::min(batch_size, n - begin);
+      MLPBatch batch = MakeBatch(features, labels, indices.data() + begin, size);
+      MLPForward(layers_, use_sigmoid, batch, num_threads, &acts);
+      total_loss += LambdaRankLoss(acts.outputs, batch.labels, &unused_grads);
+      ++num_batches;
+    }
+    return num_batches > 0 ? total_loss / num_batches : 0.0;
+  }
+};
+
+CostModel CostModel::SegmentSumMLPModel(FeatureExtractor extractor, int hidden_dim,
+                                        bool use_sigmoid, int batch_size, double learning_rate,
+                                        double weight_decay, int num_epoch_full,
+                                        int num_epoch_incremental, double grad_clip_norm,
+                                        double test_split, bool frozen, int64_t seed) {
+  CHECK_GT(hidden_dim, 0) << "ValueError: hidden_dim must be positive";
+  CHECK_GT(batch_size, 0) << "ValueError: batch_size must be positive";
+  CHECK(test_split >= 0.0 && test_split < 1.0) << "ValueError: test_split must be in [0, 1)";
+  ObjectPtr<SegmentSumMLPModelNode> n = make_object<SegmentSumMLPModelNode>();
+  n->extractor = std::move(extractor);
+  n->hidden_dim = hidden_dim;
+  n->use_sigmoid = use_sigmoid;
+  n->batch_size = batch_size;
+  n->learning_rate = learning_rate;
+  n->weight_decay = weight_decay;
+  n->num_epoch_full = num_epoch_full;
+  n->num_epoch_incremental = num_epoch_incremental;
+  n->grad_clip_norm = grad_clip_norm;
+  n->test_split = test_split;
+  n->frozen = frozen;
+  n->rand_state = support::LinearCongruentialEngine::NormalizeSeed(seed);
+  return CostModel(n);
+}
+
+TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
+    .set_dispatch<SegmentSumMLPModelNode>([](const ObjectRef& n, ReprPrinter* p) {
+      const auto* self = n.as<SegmentSumMLPModelNode>();
+      ICHECK(self);
+      p->stream << "meta_schedule.SegmentSumMLPModel(hidden_dim=" << self->hidden_dim
+                << ", data_size=" << self->data_size_ << ")";
+    });
+
+TVM_REGISTER_NODE_TYPE(SegmentSumMLPModelNode);
+TVM_REGISTER_GLOBAL("meta_schedule.CostModelSegmentSumMLPModel")
+    .set_body_typed(CostModel::SegmentSumMLPModel);
+
+}  // namespace meta_schedule
+}  // namespace tvm
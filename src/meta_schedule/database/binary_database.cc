@@ -0,0 +1,760 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file binary_database.cc
+ * \brief A database stored as an append-only binary log and an on-disk index.
+ *
+ * The log starts with a header of two uint64 (magic, version), followed by entries of the form
+ * [kind(uint32), workload(uint32), nbytes(uint64), payload(nbytes)]:
+ *  - kWorkload: [shash(uint64), SaveJSON(mod)(string)]
+ *  - kString: the bytes of an interned string. Strings are numbered in the order of the log. They
+ *    hold the instructions of the traces, the targets and the argument info, which are shared by
+ *    many records.
+ *  - kTuningRecord: [has_run_secs(uint32), run_secs(vector<double>), target(uint32),
+ *    args_info(uint32), insts(vector<uint32>), decisions(string)], where `workload` in the entry
+ *    header is the index of its workload entry and the other uint32 refer to strings.
+ * A string is [size(uint64), bytes], a vector is [size(uint64), elements].
+ *
+ * The index at `path + ".index"` has the same header, followed by one BinaryIndexEntry per
+ * entry of the log, so that opening the database neither reads nor parses the tuning records. Only
+ * the records returned by a query are decoded, from a memory-mapped view of the log. The index is
+ * rebuilt from the log when it lags behind, e.g. after a crash between the two appends.
+ */
+#include "./binary_database.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+#include "../module_equality.h"
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+namespace {
+
+/*! \brief The magic number of the binary log */
+constexpr uint64_t kBinaryDatabaseLogMagic = 0x474F4C4244534D54;  // "TMSDBLOG"
+/*! \brief The magic number of the index of the binary log */
+constexpr uint64_t kBinaryDatabaseIndexMagic = 0x584449424453534D;  // "MSSDBIDX"
+/*! \brief The version of the format */
+constexpr uint64_t kBinaryDatabaseVersion = 1;
+/*! \brief The size of the file headers */
+constexpr uint64_t kBinaryDatabaseHeaderSize = 2 * sizeof(uint64_t);
+/*! \brief The string index that stands for a missing value */
+constexpr uint32_t kNoString = UINT32_MAX;
+
+/*! \brief The kind of an entry of the binary log */
+enum class BinaryEntryKind : uint32_t {
+  kWorkload = 1,
+  kString = 2,
+  kTuningRecord = 3,
+};
+
+/*! \brief The header of an entry of the binary log */
+struct BinaryEntryHeader {
+  uint32_t kind;
+  uint32_t workload;
+  uint64_t nbytes;
+};
+static_assert(sizeof(BinaryEntryHeader) == 16, "BinaryEntryHeader must be packed");
+
+/*! \brief An entry of the index, one per entry of the log */
+struct BinaryIndexEntry {
+  uint32_t kind;
+  uint32_t workload;
+  uint64_t offset;
+  double mean_run_secs;
+};
+static_assert(sizeof(BinaryIndexEntry) == 24, "BinaryIndexEntry must be packed");
+
+/*! \brief A read-only view of a file, memory-mapped when the platform supports it */
+class ReadOnlyFile {
+ public:
+  /*! \brief Map the file at `path`, the view is empty if the file does not exist */
+  explicit ReadOnlyFile(const std::string& path) {
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+    struct stat st;
+    ICHECK_EQ(fstat(fd, &st), 0) << "Cannot stat " << path;
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ != 0) {
+      void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      ICHECK(addr != MAP_FAILED) << "Cannot mmap " << path;
+      data_ = static_cast<const char*>(addr);
+    }
+    close(fd);
+#else
+    std::ifstream is(path, std::ios::in | std::ios::binary);
+    if (!is.good()) {
+      return;
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#endif
+  }
+
+  ~ReadOnlyFile() {
+#ifndef _WIN32
+    if (data_ != nullptr) {
+      munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+  }
+
+  ReadOnlyFile(const ReadOnlyFile&) = delete;
+  ReadOnlyFile& operator=(const ReadOnlyFile&) = delete;
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  const char* data_{nullptr};
+  size_t size_{0};
+#ifdef _WIN32
+  std::string buffer_;
+#endif
+};
+
+/*! \brief A bounds-checked reader over a byte range */
+class BinaryReader {
+ public:
+  BinaryReader(const char* begin, uint64_t size) : cur_(begin), end_(begin + size) {}
+
+  template <typename T>
+  T Read() {
+    T value;
+    CHECK_LE(sizeof(T), Remaining()) << "ValueError: Truncated entry in the binary database";
+    std::memcpy(&value, cur_, sizeof(T));
+    cur_ += sizeof(T);
+    return value;
+  }
+
+  template <typename T>
+  std::vector<T> ReadVector() {
+    uint64_t n = Read<uint64_t>();
+    CHECK_LE(n, Remaining() / sizeof(T)) << "ValueError: Truncated entry in the binary database";
+    std::vector<T> values(n);
+    if (n != 0) {
+      std::memcpy(values.data(), cur_, n * sizeof(T));
+    }
+    cur_ += n * sizeof(T);
+    return values;
+  }
+
+  std::string ReadString() {
+    uint64_t n = Read<uint64_t>();
+    CHECK_LE(n, Remaining()) << "ValueError: Truncated entry in the binary database";
+    std::string value(cur_, n);
+    cur_ += n;
+    return value;
+  }
+
+  uint64_t Remaining() const { return end_ - cur_; }
+
+ private:
+  const char* cur_;
+  const char* end_;
+};
+
+/*! \brief Helpers to encode the payloads */
+template <typename T>
+void BinaryWrite(std::string* os, const T& value) {
+  os->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void BinaryWriteVector(std::string* os, const std::vector<T>& values) {
+  BinaryWrite<uint64_t>(os, values.size());
+  os->append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+void BinaryWriteString(std::string* os, const std::string& value) {
+  BinaryWrite<uint64_t>(os, value.size());
+  os->append(value);
+}
+
+/*! \brief The mean running time of a record used to order it, see SortTuningRecordByMeanRunSecs */
+double MeanRunSecs(bool has_run_secs, const std::vector<double>& run_secs) {
+  if (!has_run_secs || run_secs.empty()) {
+    return SortTuningRecordByMeanRunSecs::kMaxMeanTime;
+  }
+  double sum = 0.0;
+  for (double x : run_secs) {
+    sum += x;
+  }
+  return sum / run_secs.size();
+}
+
+}  // namespace
+
+/*! \brief A database stored as an append-only binary log with memory-mapped reads. */
+class BinaryDatabaseNode : public DatabaseNode {
+ public:
+  explicit BinaryDatabaseNode(String mod_eq_name = "structural")
+      : DatabaseNode(mod_eq_name),
+        workloads2idx_(/*bucket_count*/ 0, WorkloadHash(), WorkloadEqual(GetModuleEquality())) {}
+
+  /*! \brief A tuning record in the index of its workload */
+  struct RecordRef {
+    double mean_run_secs;
+    uint64_t offset;
+  };
+
+  /*! \brief The path to the binary log */
+  String path;
+  /*! \brief Whether the log belongs to another process, see `OpenReadOnly` */
+  bool read_only_ = false;
+  /*! \brief The view of the log that existed when the database was opened or refreshed */
+  std::unique_ptr<ReadOnlyFile> file_;
+  /*! \brief The stream appending to the log */
+  std::ofstream log_os_;
+  /*! \brief The stream appending to the index */
+  std::ofstream index_os_;
+  /*! \brief The size of the log, i.e. the offset of the next entry */
+  uint64_t log_size_ = 0;
+  /*! \brief All the workloads in the database, mapped to the index of their first entry */
+  std::unordered_map<Workload, int, WorkloadHash, WorkloadEqual> workloads2idx_;
+  /*! \brief The workloads in the order of their entries in the log */
+  std::vector<Workload> workloads_;
+  /*! \brief The interned strings, pointing into `file_` or `owned_strings_` */
+  std::vector<std::string_view> strings_;
+  /*! \brief The offset of each interned string in the log, 0 for those in `owned_strings_` */
+  std::vector<uint64_t> string_offsets_;
+  /*! \brief The string index of each interned string */
+  std::unordered_map<std::string_view, uint32_t> string_ids_;
+  /*! \brief The storage of the strings committed after the database was opened */
+  std::deque<std::string> owned_strings_;
+  /*! \brief The parsed JSON of the interned strings, filled on first use */
+  std::vector<ObjectRef> parsed_strings_;
+  /*! \brief The records of each workload, indexed by `workloads2idx_`, sorted by running time */
+  std::vector<std::vector<RecordRef>> records_;
+  /*! \brief The decoded tuning records, keyed by their offset in the log */
+  std::unordered_map<uint64_t, TuningRecord> decoded_records_;
+  /*! \brief The number of tuning records */
+  int64_t num_records_ = 0;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("path", &path);
+    // `workloads2idx_` is not visited
+    // `records_` is not visited
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.BinaryDatabase";
+  TVM_DECLARE_FINAL_OBJECT_INFO(BinaryDatabaseNode, DatabaseNode);
+
+ public:
+  bool HasWorkload(const IRModule& mod) {
+    return workloads2idx_.find(Workload(mod, GetModuleEquality().Hash(mod))) !=
+           workloads2idx_.end();
+  }
+
+  Workload CommitWorkload(const IRModule& mod) {
+    if (read_only_) {
+      auto it = workloads2idx_.find(Workload(mod, GetModuleEquality().Hash(mod)));
+      CHECK(it != workloads2idx_.end())
+          << "ValueError: Cannot commit a new workload to the read-only database " << path;
+      return it->first;
+    }
+    int index = static_cast<int>(workloads_.size());
+    auto [it, inserted] =
+        workloads2idx_.emplace(Workload(mod, GetModuleEquality().Hash(mod)), index);
+    if (inserted) {
+      const Workload& workload = it->first;
+      std::string payload;
+      BinaryWrite<uint64_t>(&payload, workload->shash);
+      BinaryWriteString(&payload, SaveJSON(workload->mod));
+      Append(BinaryEntryKind::kWorkload, 0, payload, 0.0);
+      workloads_.push_back(workload);
+      log_os_.flush();
+      index_os_.flush();
+    }
+    return it->first;
+  }
+
+  void CommitTuningRecord(const TuningRecord& record) {
+    CHECK(!read_only_) << "ValueError: Cannot commit to the read-only database " << path;
+    int index = workloads2idx_.at(record->workload);
+    ObjectRef json_trace = record->trace->AsJSON(/*remove_postproc=*/false);
+    const ArrayNode* trace_arr = json_trace.as<ArrayNode>();
+    ICHECK(trace_arr != nullptr && trace_arr->size() == 2);
+    std::vector<uint32_t> insts;
+    for (const ObjectRef& inst : Downcast<Array<ObjectRef>>(trace_arr->at(0))) {
+      insts.push_back(Intern(JSONDumps(inst)));
+    }
+    uint32_t target = kNoString;
+    if (record->target.defined()) {
+      target = Intern(JSONDumps(record->target.value()->Export()));
+    }
+    uint32_t args_info = kNoString;
+    if (record->args_info.defined()) {
+      Array<ObjectRef> info;
+      for (const ArgInfo& arg_info : record->args_info.value()) {
+        info.push_back(arg_info->AsJSON());
+      }
+      args_info = Intern(JSONDumps(info));
+    }
+    std::vector<double> run_secs;
+    if (record->run_secs.defined()) {
+      for (const FloatImm& run_sec : record->run_secs.value()) {
+        run_secs.push_back(run_sec->value);
+      }
+    }
+    bool has_run_secs = record->run_secs.defined();
+    std::string payload;
+    BinaryWrite<uint32_t>(&payload, has_run_secs);
+    BinaryWriteVector(&payload, run_secs);
+    BinaryWrite<uint32_t>(&payload, target);
+    BinaryWrite<uint32_t>(&payload, args_info);
+    BinaryWriteVector(&payload, insts);
+    BinaryWriteString(&payload, JSONDumps(trace_arr->at(1)));
+    double mean = MeanRunSecs(has_run_secs, run_secs);
+    uint64_t offset = Append(BinaryEntryKind::kTuningRecord, index, payload, mean);
+    AddRecord(index, {mean, offset});
+    decoded_records_.emplace(offset, record);
+    // One flush per record, covering the strings it introduced
+    log_os_.flush();
+    index_os_.flush();
+  }
+
+  Array<TuningRecord> GetTopK(const Workload& workload, int top_k) {
+    CHECK_GE(top_k, 0) << "ValueError: top_k must be non-negative";
+    if (top_k == 0) {
+      return {};
+    }
+    Array<TuningRecord> results = TopK(workload, top_k);
+    if (results.size() < static_cast<size_t>(top_k)) {
+      LOG(WARNING) << "Returned tuning records less than requested(" << results.size() << " of "
+                   << top_k << " asked).";
+    }
+    return results;
+  }
+
+  Array<TuningRecord> GetAllTuningRecords() {
+    std::vector<RecordRef> refs;
+    refs.reserve(num_records_);
+    for (const std::vector<RecordRef>& bucket : records_) {
+      refs.insert(refs.end(), bucket.begin(), bucket.end());
+    }
+    // Order by running time, then by the order of commit
+    std::sort(refs.begin(), refs.end(), [](const RecordRef& a, const RecordRef& b) {
+      return a.mean_run_secs != b.mean_run_secs ? a.mean_run_secs < b.mean_run_secs
+                                                : a.offset < b.offset;
+    });
+    Array<TuningRecord> results;
+    results.reserve(refs.size());
+    for (const RecordRef& ref : refs) {
+      results.push_back(GetRecord(ref.offset));
+    }
+    return results;
+  }
+
+  int64_t Size() { return num_records_; }
+
+  /*! \brief The best `top_k` valid records of the workload, without warning about fewer */
+  Array<TuningRecord> TopK(const Workload& workload, int top_k) {
+    Array<TuningRecord> results;
+    auto it = workloads2idx_.find(workload);
+    if (it == workloads2idx_.end() || it->second >= static_cast<int>(records_.size())) {
+      return results;
+    }
+    for (const RecordRef& ref : records_[it->second]) {
+      if (results.size() >= static_cast<size_t>(top_k)) {
+        break;
+      }
+      TuningRecord record = GetRecord(ref.offset);
+      if (record->IsValid()) {
+        results.push_back(record);
+      }
+    }
+    return results;
+  }
+
+  /*!
+   * \brief Open the log and its index, rebuilding the index if it lags behind the log.
+   * \param allow_missing Whether to create new file when the given path is not found.
+   */
+  void Open(bool allow_missing) {
+    std::string log_path = path;
+    std::string index_path = log_path + ".index";
+    file_ = std::make_unique<ReadOnlyFile>(log_path);
+    if (file_->size() == 0) {
+      std::ifstream exists(log_path);
+      CHECK(exists.good() || allow_missing) << "ValueError: File doesn't exist: " << log_path;
+      std::ofstream os(log_path, std::ios::out | std::ios::binary | std::ios::trunc);
+      CHECK(os.good()) << "ValueError: Cannot create new file: " << log_path;
+      WriteHeader(&os, kBinaryDatabaseLogMagic);
+      file_ = std::make_unique<ReadOnlyFile>(log_path);
+    }
+    CHECK(CheckHeader()) << "ValueError: Not a binary tuning database: " << log_path;
+    bool index_valid = LoadIndex(index_path);
+    std::vector<BinaryIndexEntry> new_entries = LoadNewEntries();
+    if (log_size_ != file_->size()) {
+      // The last append was interrupted: drop the partial entry so that new ones follow the
+      // last complete entry.
+      LOG(WARNING) << "Dropping " << (file_->size() - log_size_)
+                   << " trailing bytes of a partially written entry in " << log_path;
+#ifndef _WIN32
+      CHECK_EQ(truncate(log_path.c_str(), log_size_), 0) << "Cannot truncate " << log_path;
+#else
+      LOG(FATAL) << "ValueError: Cannot recover the partially written file " << log_path;
+#endif
+    }
+    // Bring the index up to date
+    if (!index_valid) {
+      std::vector<BinaryIndexEntry> entries = RebuildIndexEntries();
+      std::ofstream os(index_path, std::ios::out | std::ios::binary | std::ios::trunc);
+      CHECK(os.good()) << "ValueError: Cannot create new file: " << index_path;
+      WriteHeader(&os, kBinaryDatabaseIndexMagic);
+      os.write(reinterpret_cast<const char*>(entries.data()),
+               entries.size() * sizeof(BinaryIndexEntry));
+    } else if (!new_entries.empty()) {
+      std::ofstream os(index_path, std::ios::out | std::ios::binary | std::ios::app);
+      os.write(reinterpret_cast<const char*>(new_entries.data()),
+               new_entries.size() * sizeof(BinaryIndexEntry));
+    }
+    log_os_.open(log_path, std::ios::out | std::ios::binary | std::ios::app);
+    CHECK(log_os_.good()) << "ValueError: Cannot open the file to write: " << log_path;
+    index_os_.open(index_path, std::ios::out | std::ios::binary | std::ios::app);
+    CHECK(index_os_.good()) << "ValueError: Cannot open the file to write: " << index_path;
+  }
+
+  /*!
+   * \brief Open the log of another process without writing to it or to its index. The entries
+   * the other process appends later are loaded by `Refresh`.
+   */
+  void OpenReadOnly() {
+    read_only_ = true;
+    file_ = std::make_unique<ReadOnlyFile>(path);
+    if (CheckHeader()) {
+      LoadIndex(std::string(path) + ".index");
+      LoadNewEntries();
+    }
+  }
+
+  /*!
+   * \brief Load the entries appended to a log opened by `OpenReadOnly` since the last refresh.
+   * A partially written entry at the end is left for the next refresh.
+   * \return Whether new entries were loaded.
+   */
+  bool Refresh() {
+    ICHECK(read_only_) << "Only a read-only database can be refreshed";
+    auto file = std::make_unique<ReadOnlyFile>(path);
+    if (file->size() <= log_size_) {
+      return false;
+    }
+    file_ = std::move(file);
+    // The interned strings point into the previous mapping
+    for (size_t i = 0; i < strings_.size(); ++i) {
+      strings_[i] = std::string_view(file_->data() + string_offsets_[i], strings_[i].size());
+    }
+    if (log_size_ == 0 && !CheckHeader()) {
+      return false;
+    }
+    return !LoadNewEntries().empty();
+  }
+
+ private:
+  static void WriteHeader(std::ofstream* os, uint64_t magic) {
+    os->write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    os->write(reinterpret_cast<const char*>(&kBinaryDatabaseVersion),
+              sizeof(kBinaryDatabaseVersion));
+  }
+
+  /*!
+   * \brief Read the header of the entry of the mapped log at `offset`.
+   * \return Whether a complete entry is there.
+   */
+  bool PeekEntry(uint64_t offset, BinaryEntryHeader* header) const {
+    if (file_->size() < offset + sizeof(BinaryEntryHeader)) {
+      return false;
+    }
+    // Entries are not aligned
+    std::memcpy(header, file_->data() + offset, sizeof(BinaryEntryHeader));
+    return file_->size() - offset - sizeof(BinaryEntryHeader) >= header->nbytes;
+  }
+
+  /*!
+   * \brief Check the header of the mapped log and start reading the entries after it.
+   * \return False if the header is not completely written yet.
+   */
+  bool CheckHeader() {
+    if (file_->size() < kBinaryDatabaseHeaderSize) {
+      return false;
+    }
+    BinaryReader header(file_->data(), kBinaryDatabaseHeaderSize);
+    CHECK_EQ(header.Read<uint64_t>(), kBinaryDatabaseLogMagic)
+        << "ValueError: Not a binary tuning database: " << path;
+    CHECK_EQ(header.Read<uint64_t>(), kBinaryDatabaseVersion)
+        << "ValueError: Unsupported version of the binary tuning database: " << path;
+    log_size_ = kBinaryDatabaseHeaderSize;
+    return true;
+  }
+
+  /*!
+   * \brief Load the entries of the mapped log listed in the index, as long as the index agrees
+   * with the log.
+   * \return Whether the whole index is consistent with the log.
+   */
+  bool LoadIndex(const std::string& index_path) {
+    ReadOnlyFile index(index_path);
+    if (index.size() < kBinaryDatabaseHeaderSize) {
+      return false;
+    }
+    BinaryReader reader(index.data(), index.size());
+    bool index_valid = reader.Read<uint64_t>() == kBinaryDatabaseIndexMagic &&
+                       reader.Read<uint64_t>() == kBinaryDatabaseVersion;
+    while (index_valid && reader.Remaining() >= sizeof(BinaryIndexEntry)) {
+      BinaryIndexEntry entry = reader.Read<BinaryIndexEntry>();
+      BinaryEntryHeader header;
+      if (entry.offset != log_size_ || !PeekEntry(log_size_, &header) ||
+          header.kind != entry.kind || header.workload != entry.workload) {
+        return false;
+      }
+      Load(header, entry.offset, entry.mean_run_secs);
+      log_size_ += sizeof(BinaryEntryHeader) + header.nbytes;
+    }
+    // A trailing partial entry means that the index is stale too
+    return index_valid && reader.Remaining() == 0;
+  }
+
+  /*!
+   * \brief Load the complete entries of the mapped log after `log_size_`.
+   * \return The index entries of the loaded entries.
+   */
+  std::vector<BinaryIndexEntry> LoadNewEntries() {
+    std::vector<BinaryIndexEntry> new_entries;
+    for (BinaryEntryHeader header; PeekEntry(log_size_, &header);) {
+      double mean = 0.0;
+      if (header.kind == static_cast<uint32_t>(BinaryEntryKind::kTuningRecord)) {
+        BinaryReader reader(file_->data() + log_size_ + sizeof(BinaryEntryHeader), header.nbytes);
+        bool has_run_secs = reader.Read<uint32_t>();
+        mean = MeanRunSecs(has_run_secs, reader.ReadVector<double>());
+      }
+      Load(header, log_size_, mean);
+      new_entries.push_back({header.kind, header.workload, log_size_, mean});
+      log_size_ += sizeof(BinaryEntryHeader) + header.nbytes;
+    }
+    return new_entries;
+  }
+
+  /*! \brief Register an entry of the mapped log, without decoding tuning records */
+  void Load(const BinaryEntryHeader& header, uint64_t offset, double mean_run_secs) {
+    const char* payload = file_->data() + offset + sizeof(BinaryEntryHeader);
+    switch (static_cast<BinaryEntryKind>(header.kind)) {
+      case BinaryEntryKind::kWorkload: {
+        BinaryReader reader(payload, header.nbytes);
+        reader.Read<uint64_t>();  // The hash is recomputed, as in the JSON database
+        IRModule mod = Downcast<IRModule>(LoadJSON(reader.ReadString()));
+        Workload workload(mod, GetModuleEquality().Hash(mod));
+        int index = static_cast<int>(workloads_.size());
+        workloads_.push_back(workloads2idx_.emplace(workload, index).first->first);
+        break;
+      }
+      case BinaryEntryKind::kString: {
+        std::string_view str(payload, header.nbytes);
+        if (!read_only_) {
+          // A read-only database never interns strings, and its mapping moves on refresh
+          string_ids_.emplace(str, static_cast<uint32_t>(strings_.size()));
+        }
+        strings_.push_back(str);
+        string_offsets_.push_back(offset + sizeof(BinaryEntryHeader));
+        parsed_strings_.push_back(ObjectRef{nullptr});
+        break;
+      }
+      case BinaryEntryKind::kTuningRecord: {
+        CHECK_LT(header.workload, workloads_.size())
+            << "ValueError: Tuning record at offset " << offset << " of " << path
+            << " refers to an unknown workload";
+        AddRecord(workloads2idx_.at(workloads_[header.workload]), {mean_run_secs, offset});
+        break;
+      }
+      default:
+        LOG(FATAL) << "ValueError: Unknown entry kind " << header.kind << " at offset " << offset
+                   << " of " << path;
+    }
+  }
+
+  /*! \brief The index entries of all the entries in the log, used when the index is stale */
+  std::vector<BinaryIndexEntry> RebuildIndexEntries() const {
+    std::vector<BinaryIndexEntry> entries;
+    std::unordered_map<uint64_t, double> means;
+    for (const std::vector<RecordRef>& bucket : records_) {
+      for (const RecordRef& ref : bucket) {
+        means.emplace(ref.offset, ref.mean_run_secs);
+      }
+    }
+    for (uint64_t offset = kBinaryDatabaseHeaderSize; offset < log_size_;) {
+      BinaryEntryHeader header;
+      ICHECK(PeekEntry(offset, &header));
+      auto it = means.find(offset);
+      entries.push_back(
+          {header.kind, header.workload, offset, it == means.end() ? 0.0 : it->second});
+      offset += sizeof(BinaryEntryHeader) + header.nbytes;
+    }
+    return entries;
+  }
+
+  /*! \brief Insert a record into its workload's list, after the records that are not slower */
+  void AddRecord(int index, const RecordRef& ref) {
+    if (index >= static_cast<int>(records_.size())) {
+      records_.resize(index + 1);
+    }
+    std::vector<RecordRef>& bucket = records_[index];
+    auto it = std::upper_bound(
+        bucket.begin(), bucket.end(), ref.mean_run_secs,
+        [](double mean, const RecordRef& r) { return mean < r.mean_run_secs; });
+    bucket.insert(it, ref);
+    ++num_records_;
+  }
+
+  /*! \brief Append an entry to the log and the index, and return its offset in the log */
+  uint64_t Append(BinaryEntryKind kind, uint32_t workload, const std::string& payload,
+                  double mean_run_secs) {
+    BinaryEntryHeader header{static_cast<uint32_t>(kind), workload, payload.size()};
+    uint64_t offset = log_size_;
+    log_os_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    log_os_.write(payload.data(), payload.size());
+    CHECK(log_os_.good()) << "ValueError: Cannot write to " << path;
+    BinaryIndexEntry entry{header.kind, workload, offset, mean_run_secs};
+    index_os_.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    log_size_ += sizeof(header) + payload.size();
+    return offset;
+  }
+
+  /*! \brief Get the index of an interned string, appending it to the log if it is new */
+  uint32_t Intern(std::string str) {
+    auto it = string_ids_.find(str);
+    if (it != string_ids_.end()) {
+      return it->second;
+    }
+    Append(BinaryEntryKind::kString, 0, str, 0.0);
+    std::string_view view = owned_strings_.emplace_back(std::move(str));
+    uint32_t id = static_cast<uint32_t>(strings_.size());
+    string_ids_.emplace(view, id);
+    strings_.push_back(view);
+    string_offsets_.push_back(0);
+    parsed_strings_.push_back(ObjectRef{nullptr});
+    return id;
+  }
+
+  /*! \brief Get the parsed JSON of an interned string */
+  ObjectRef ParsedString(uint32_t id) {
+    if (id == kNoString) {
+      return ObjectRef{nullptr};
+    }
+    CHECK_LT(id, strings_.size()) << "ValueError: Unknown string " << id << " in " << path;
+    if (!parsed_strings_[id].defined()) {
+      parsed_strings_[id] = JSONLoads(std::string(strings_[id]));
+    }
+    return parsed_strings_[id];
+  }
+
+  /*! \brief Get the tuning record at `offset` in the log, decoding it on first use */
+  TuningRecord GetRecord(uint64_t offset) {
+    auto it = decoded_records_.find(offset);
+    if (it != decoded_records_.end()) {
+      return it->second;
+    }
+    BinaryEntryHeader header;
+    ICHECK(PeekEntry(offset, &header));
+    BinaryReader reader(file_->data() + offset + sizeof(BinaryEntryHeader), header.nbytes);
+    bool has_run_secs = reader.Read<uint32_t>();
+    std::vector<double> run_secs = reader.ReadVector<double>();
+    uint32_t target = reader.Read<uint32_t>();
+    uint32_t args_info = reader.Read<uint32_t>();
+    std::vector<uint32_t> inst_ids = reader.ReadVector<uint32_t>();
+    ObjectRef decisions = JSONLoads(reader.ReadString());
+    Array<ObjectRef> insts;
+    insts.reserve(inst_ids.size());
+    for (uint32_t id : inst_ids) {
+      insts.push_back(ParsedString(id));
+    }
+    Optional<Array<FloatImm>> json_run_secs{nullptr};
+    if (has_run_secs) {
+      Array<FloatImm> secs;
+      secs.reserve(run_secs.size());
+      for (double x : run_secs) {
+        secs.push_back(FloatImm(DataType::Float(32), x));
+      }
+      json_run_secs = secs;
+    }
+    TuningRecord record = TuningRecord::FromJSON(
+        Array<ObjectRef>{Array<ObjectRef>{insts, decisions}, json_run_secs, ParsedString(target),
+                         ParsedString(args_info)},
+        workloads_.at(header.workload));
+    decoded_records_.emplace(offset, record);
+    return record;
+  }
+};
+
+Database Database::BinaryDatabase(String path, bool allow_missing, String mod_eq_name) {
+  ObjectPtr<BinaryDatabaseNode> n = make_object<BinaryDatabaseNode>(mod_eq_name);
+  n->path = path;
+  n->Open(allow_missing);
+  return Database(n);
+}
+
+Database OpenBinaryDatabaseReadOnly(const String& path, const String& mod_eq_name) {
+  ObjectPtr<BinaryDatabaseNode> n = make_object<BinaryDatabaseNode>(mod_eq_name);
+  n->path = path;
+  n->OpenReadOnly();
+  return Database(n);
+}
+
+/*! \brief Get the node of a database created by this file */
+BinaryDatabaseNode* GetBinaryDatabaseNode(const Database& database) {
+  auto* node = const_cast<BinaryDatabaseNode*>(database.as<BinaryDatabaseNode>());
+  ICHECK(node != nullptr) << "TypeError: Expect a BinaryDatabase, but gets: "
+                          << database->GetTypeKey();
+  return node;
+}
+
+bool RefreshBinaryDatabase(const Database& database) {
+  return GetBinaryDatabaseNode(database)->Refresh();
+}
+
+Array<TuningRecord> BinaryDatabaseTopK(const Database& database, const Workload& workload,
+                                       int top_k) {
+  return GetBinaryDatabaseNode(database)->TopK(workload, top_k);
+}
+
+TVM_REGISTER_NODE_TYPE(BinaryDatabaseNode);
+TVM_REGISTER_GLOBAL("meta_schedule.DatabaseBinaryDatabase")
+    .set_body_typed(Database::BinaryDatabase);
+
+}  // namespace meta_schedule
+}  // namespace tvm
@@ -0,0 +1,61 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file binary_database.h
+ * \brief Internal access to the binary database for the databases built on top of it.
+ */
+#ifndef TVM_META_SCHEDULE_DATABASE_BINARY_DATABASE_H_
+#define TVM_META_SCHEDULE_DATABASE_BINARY_DATABASE_H_
+
+#include <tvm/meta_schedule/database.h>
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief Open the binary log written by another process, without writing to it or to its index.
+ * \param path The path to the binary log. It may not contain a complete header yet.
+ * \param mod_eq_name A string to specify the module equality testing and hashing method.
+ * \return The read-only database, which rejects new workloads and tuning records.
+ */
+Database OpenBinaryDatabaseReadOnly(const String& path, const String& mod_eq_name);
+
+/*!
+ * \brief Load the entries appended to a read-only binary database since it was last refreshed.
+ * \param database The database returned by `OpenBinaryDatabaseReadOnly`.
+ * \return Whether new entries were loaded.
+ */
+bool RefreshBinaryDatabase(const Database& database);
+
+/*!
+ * \brief Get the best valid tuning records of a workload in a binary database. Unlike `GetTopK`,
+ * it does not warn when there are fewer than `top_k` records.
+ * \param database The binary database.
+ * \param workload The workload to be searched for.
+ * \param top_k The number of top records to be returned.
+ * \return The records sorted by mean running time.
+ */
+Array<TuningRecord> BinaryDatabaseTopK(const Database& database, const Workload& workload,
+                                       int top_k);
+
+}  // namespace meta_schedule
+}  // namespace tvm
+
+#endif  // TVM_META_SCHEDULE_DATABASE_BINARY_DATABASE_H_
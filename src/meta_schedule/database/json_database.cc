@@ -16,6 +16,8 @@
  * specific language governing permissions and limitations
  * under the License.
  */
+#include <algorithm>
+#include <cctype>
 #include <set>
 #include <thread>
 #include <unordered_map>
@@ -43,7 +45,13 @@ std::vector<ObjectRef> JSONFileReadLines(const String& path, int num_threads, bo
     int n = json_strs.size();
     std::vector<ObjectRef> json_objs;
     json_objs.resize(n);
-    support::parallel_for_dynamic(0, n, num_threads, [&](int thread_id, int task_id) {
+    // The parsing cost grows with the length of the line
+    std::vector<double> costs;
+    costs.reserve(n);
+    for (const String& str : json_strs) {
+      costs.push_back(str.size());
+    }
+    support::parallel_for_guided(0, n, num_threads, costs, [&](int thread_id, int task_id) {
       json_objs[task_id] = JSONLoads(json_strs[task_id]);
     });
     return json_objs;
@@ -65,6 +73,31 @@ void JSONFileAppendLine(const String& path, const std::string& line) {
   os << line << std::endl;
 }
 
+/*!
+ * \brief Read the workload index at the head of a line of the tuning record file without parsing
+ * the rest, i.e. the `0` of `[0, [...]]`.
+ * \param line The line of the tuning record file.
+ * \return The workload index, or -1 if the line is not of that form.
+ */
+int PeekWorkloadIndex(const std::string& line) {
+  size_t i = 0, n = line.size();
+  auto skip_spaces = [&]() {
+    while (i < n && std::isspace(static_cast<unsigned char>(line[i]))) ++i;
+  };
+  skip_spaces();
+  if (i == n || line[i++] != '[') return -1;
+  skip_spaces();
+  int64_t index = 0;
+  size_t digits_begin = i;
+  while (i < n && std::isdigit(static_cast<unsigned char>(line[i])) && index <= INT32_MAX) {
+    index = index * 10 + (line[i++] - '0');
+  }
+  if (i == digits_begin || index > INT32_MAX) return -1;
+  skip_spaces();
+  if (i == n || line[i] != ',') return -1;
+  return static_cast<int>(index);
+}
+
 /*! \brief The default database implementation, which mimics two database tables with two files. */
 class JSONDatabaseNode : public DatabaseNode {
  public:
@@ -72,20 +105,45 @@ class JSONDatabaseNode : public DatabaseNode {
       : DatabaseNode(mod_eq_name),
         workloads2idx_(/*bucket_count*/ 0, WorkloadHash(), WorkloadEqual(GetModuleEquality())) {}
 
+  /*! \brief The tuning records of a workload, sorted by mean running time */
+  using RecordBucket = std::multiset<TuningRecord, SortTuningRecordByMeanRunSecs>;
+  /*! \brief A line of the tuning record file that has not been parsed yet */
+  struct UnparsedRecord {
+    /*! \brief The 1-based line number in the tuning record file, for error messages */
+    int line_no;
+    /*! \brief The json string on that line */
+    std::string json_str;
+  };
+
   /*! \brief The path to the workload table */
   String path_workload;
   /*! \brief The path to the tuning record table */
   String path_tuning_record;
   /*! \brief All the workloads in the database */
   std::unordered_map<Workload, int, WorkloadHash, WorkloadEqual> workloads2idx_;
-  /*! \brief All the tuning records in the database */
-  std::multiset<TuningRecord, SortTuningRecordByMeanRunSecs> tuning_records_;
+  /*! \brief The workloads indexed by the position of their line in the workload file */
+  std::vector<Workload> workloads_;
+  /*! \brief The tuning records of each workload, indexed by its value in `workloads2idx_` */
+  std::vector<RecordBucket> tuning_records_;
+  /*!
+   * \brief The lines of the tuning record file of each workload that are not parsed yet. A
+   * workload's lines are only parsed the first time its records are needed.
+   */
+  std::vector<std::vector<UnparsedRecord>> unparsed_records_;
+  /*! \brief The number of parsed tuning records */
+  int64_t num_parsed_ = 0;
+  /*! \brief The number of tuning records not parsed yet */
+  int64_t num_unparsed_ = 0;
+  /*! \brief The number of threads used to parse the tuning records */
+  int num_threads_ = 1;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("path_workload", &path_workload);
     v->Visit("path_tuning_record", &path_tuning_record);
     // `workloads2idx_` is not visited
+    // `workloads_` is not visited
     // `tuning_records_` is not visited
+    // `unparsed_records_` is not visited
   }
 
   static constexpr const char* _type_key = "meta_schedule.JSONDatabase";
@@ -111,10 +169,12 @@ class JSONDatabaseNode : public DatabaseNode {
   }
 
   void CommitTuningRecord(const TuningRecord& record) {
-    this->tuning_records_.insert(record);
+    int index = this->workloads2idx_.at(record->workload);
+    this->Bucket(index).insert(record);
+    ++this->num_parsed_;
     JSONFileAppendLine(this->path_tuning_record,
                        JSONDumps(Array<ObjectRef>{
-                           /*workload_index=*/Integer(this->workloads2idx_.at(record->workload)),
+                           /*workload_index=*/Integer(index),
                            /*tuning_record=*/record->AsJSON()  //
                        }));
   }
@@ -126,13 +186,12 @@ class JSONDatabaseNode : public DatabaseNode {
     }
     Array<TuningRecord> results;
     results.reserve(top_k);
-    for (const TuningRecord& record : this->tuning_records_) {
-      auto run_secs = record->run_secs;
-      if (!record->IsValid()) {
-        continue;
-      }
-      if (record->workload.same_as(workload) ||
-          WorkloadEqual(GetModuleEquality())(record->workload, workload)) {
+    auto it = this->workloads2idx_.find(workload);
+    if (it != this->workloads2idx_.end()) {
+      for (const TuningRecord& record : this->Bucket(it->second)) {
+        if (!record->IsValid()) {
+          continue;
+        }
         results.push_back(record);
         if (results.size() == static_cast<size_t>(top_k)) {
           break;
@@ -147,28 +206,100 @@ class JSONDatabaseNode : public DatabaseNode {
   }
 
   Array<TuningRecord> GetAllTuningRecords() {
-    Array<TuningRecord> results;
-    results.reserve(Size());
-    for (const TuningRecord& record : this->tuning_records_) {
-      results.push_back(record);
+    std::vector<TuningRecord> records;
+    records.reserve(Size());
+    for (int i = 0, n = this->tuning_records_.size(); i < n; ++i) {
+      const RecordBucket& bucket = this->Bucket(i);
+      records.insert(records.end(), bucket.begin(), bucket.end());
     }
-    return results;
+    std::stable_sort(records.begin(), records.end(), SortTuningRecordByMeanRunSecs());
+    return Array<TuningRecord>(records.begin(), records.end());
   }
 
-  int64_t Size() { return tuning_records_.size(); }
+  int64_t Size() { return num_parsed_ + num_unparsed_; }
+
+  /*!
+   * \brief Get the tuning records of a workload, parsing the pending lines of the tuning record
+   * file for that workload first.
+   * \param index The index of the workload in `workloads2idx_`.
+   * \return The bucket of tuning records of the workload.
+   */
+  RecordBucket& Bucket(int index) {
+    ICHECK_GE(index, 0);
+    if (index >= static_cast<int>(this->tuning_records_.size())) {
+      this->tuning_records_.resize(index + 1);
+      this->unparsed_records_.resize(index + 1);
+    }
+    RecordBucket& bucket = this->tuning_records_[index];
+    std::vector<UnparsedRecord> lines = std::move(this->unparsed_records_[index]);
+    this->unparsed_records_[index].clear();
+    if (lines.empty()) {
+      return bucket;
+    }
+    int n = lines.size();
+    std::vector<TuningRecord> records(n, TuningRecord{nullptr});
+    // The parsing cost grows with the length of the line
+    std::vector<double> costs;
+    costs.reserve(n);
+    for (const UnparsedRecord& line : lines) {
+      costs.push_back(line.json_str.size());
+    }
+    support::parallel_for_guided(0, n, num_threads_, costs, [&](int thread_id, int task_id) {
+      records[task_id] = this->ParseTuningRecord(lines[task_id]);
+    });
+    bucket.insert(records.begin(), records.end());
+    this->num_unparsed_ -= n;
+    this->num_parsed_ += n;
+    return bucket;
+  }
+
+  /*!
+   * \brief Parse a line of the tuning record file.
+   * \param line The line to parse.
+   * \return The tuning record on the line.
+   */
+  TuningRecord ParseTuningRecord(const UnparsedRecord& line) const {
+    ObjectRef json_obj{nullptr};
+    Workload workload{nullptr};
+    TuningRecord record{nullptr};
+    try {
+      json_obj = JSONLoads(line.json_str);
+      const ArrayNode* arr = json_obj.as<ArrayNode>();
+      ICHECK(arr != nullptr);
+      ICHECK_EQ(arr->size(), 2);
+      int64_t index = Downcast<Integer>(arr->at(0)).IntValue();
+      ICHECK(0 <= index && index < static_cast<int64_t>(workloads_.size()));
+      workload = workloads_[index];
+      record = TuningRecord::FromJSON(arr->at(1), workload);
+    } catch (std::runtime_error& e) {
+      LOG(FATAL) << "ValueError: Unable to parse TuningRecord, on line " << line.line_no
+                 << " of file " << path_tuning_record << ". The workload is:\n"
+                 << (workload.defined() ? workload->mod->Script() : "(null)")
+                 << "\nThe JSONObject of TuningRecord is:\n"
+                 << json_obj << "\nThe error message is:\n"
+                 << e.what();
+    }
+    return record;
+  }
 };
 
 Database Database::JSONDatabase(String path_workload, String path_tuning_record, bool allow_missing,
                                 String mod_eq_name) {
   int num_threads = std::thread::hardware_concurrency();
   ObjectPtr<JSONDatabaseNode> n = make_object<JSONDatabaseNode>(mod_eq_name);
+  n->num_threads_ = std::max(num_threads, 1);
+  n->path_workload = path_workload;
+  n->path_tuning_record = path_tuning_record;
   // Load `n->workloads2idx_` from `path_workload`
-  std::vector<Workload> workloads;
+  // The index of each line of the workload file in `n->workloads2idx_`, which differs from the
+  // line number when the file contains the same workload twice
+  std::vector<int> workload_indices;
   {
     std::vector<ObjectRef> json_objs = JSONFileReadLines(path_workload, num_threads, allow_missing);
     int n_objs = json_objs.size();
     n->workloads2idx_.reserve(n_objs);
-    workloads.reserve(n_objs);
+    n->workloads_.reserve(n_objs);
+    workload_indices.reserve(n_objs);
     for (int i = 0; i < n_objs; ++i) {
       Workload workload = Workload::FromJSON(json_objs[i]);
       auto recalc_hash = n->GetModuleEquality().Hash(workload->mod);
@@ -179,40 +310,41 @@ Database Database::JSONDatabase(String path_workload, String path_tuning_record,
         wkl->shash = recalc_hash;
         workload = Workload(wkl);
       }
-      n->workloads2idx_.emplace(workload, i);
-      workloads.push_back(workload);
+      auto it = n->workloads2idx_.emplace(workload, i).first;
+      n->workloads_.push_back(workload);
+      workload_indices.push_back(it->second);
     }
   }
-  // Load `n->tuning_records_` from `path_tuning_record`
+  // Index the lines of `path_tuning_record` by workload. They are parsed on first use.
   {
-    std::vector<ObjectRef> json_objs =
-        JSONFileReadLines(path_tuning_record, num_threads, allow_missing);
-    std::vector<TuningRecord> records;
-    records.resize(json_objs.size(), TuningRecord{nullptr});
-    support::parallel_for_dynamic(
-        0, json_objs.size(), num_threads, [&](int thread_id, int task_id) {
-          const ObjectRef& json_obj = json_objs[task_id];
-          Workload workload{nullptr};
-          try {
-            const ArrayNode* arr = json_obj.as<ArrayNode>();
-            ICHECK_EQ(arr->size(), 2);
-            workload = workloads[Downcast<Integer>(arr->at(0)).IntValue()];
-            records[task_id] = TuningRecord::FromJSON(arr->at(1), workload);
-          } catch (std::runtime_error& e) {
-            LOG(FATAL) << "ValueError: Unable to parse TuningRecord, on line " << (task_id + 1)
-                       << " of file " << path_tuning_record << ". The workload is:\n"
-                       << (workload.defined() ? workload->mod->Script() : "(null)")
-                       << "\nThe JSONObject of TuningRecord is:\n"
-                       << json_obj << "\nThe error message is:\n"
-                       << e.what();
-          }
-        });
-    for (const TuningRecord& record : records) {
-      n->tuning_records_.insert(record);
+    std::ifstream is(path_tuning_record);
+    if (is.good()) {
+      n->tuning_records_.resize(n->workloads_.size());
+      n->unparsed_records_.resize(n->workloads_.size());
+      int line_no = 0;
+      std::vector<JSONDatabaseNode::UnparsedRecord> malformed;
+      for (std::string str; std::getline(is, str);) {
+        ++line_no;
+        int index = PeekWorkloadIndex(str);
+        if (index < 0 || index >= static_cast<int>(workload_indices.size())) {
+          malformed.push_back({line_no, std::move(str)});
+          continue;
+        }
+        n->unparsed_records_[workload_indices[index]].push_back({line_no, std::move(str)});
+        ++n->num_unparsed_;
+      }
+      // Report the lines that can't be attributed to a workload right away
+      for (const JSONDatabaseNode::UnparsedRecord& line : malformed) {
+        TuningRecord record = n->ParseTuningRecord(line);
+        n->Bucket(n->workloads2idx_.at(record->workload)).insert(record);
+        ++n->num_parsed_;
+      }
+    } else {
+      CHECK(allow_missing) << "ValueError: File doesn't exist: " << path_tuning_record;
+      std::ofstream os(path_tuning_record);
+      CHECK(os.good()) << "ValueError: Cannot create new file: " << path_tuning_record;
     }
   }
-  n->path_workload = path_workload;
-  n->path_tuning_record = path_tuning_record;
   return Database(n);
 }
 
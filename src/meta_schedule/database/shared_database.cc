@@ -0,0 +1,305 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file shared_database.cc
+ * \brief A database shared by many processes through a directory of binary segments.
+ *
+ * Every process appends to a segment of its own, a binary database (see binary_database.cc) that
+ * it holds an exclusive `flock` on, so that writers never share a file. The segments of the other
+ * processes are opened read-only and refreshed incrementally. A segment whose writer has exited is
+ * unlocked, and is taken over by the next process that opens the directory.
+ */
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <map>
+
+#include "../module_equality.h"
+#include "../utils.h"
+#include "./binary_database.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+class SharedDatabaseNode : public DatabaseNode {
+ public:
+  explicit SharedDatabaseNode(String mod_eq_name = "structural")
+      : DatabaseNode(mod_eq_name), mod_eq_name_(mod_eq_name) {}
+
+  ~SharedDatabaseNode() {
+#ifndef _WIN32
+    if (lock_fd_ >= 0) {
+      close(lock_fd_);
+    }
+#endif
+  }
+
+  /*! \brief The directory of the segments */
+  String path;
+  /*! \brief The file name of the segment this process appends to */
+  String segment;
+  /*! \brief The minimum interval between two refreshes of the other segments, in seconds */
+  double refresh_interval_sec;
+  /*! \brief The segment this process appends to */
+  Database own_{nullptr};
+  /*! \brief The read-only segments of the other processes, keyed by file name */
+  std::map<std::string, Database> peers_;
+  /*! \brief The module equality used by the segments */
+  String mod_eq_name_;
+  /*! \brief The time of the last refresh */
+  std::chrono::steady_clock::time_point last_refresh_;
+  /*! \brief The file descriptor holding the lock on the own segment */
+  int lock_fd_ = -1;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("path", &path);
+    v->Visit("segment", &segment);
+    v->Visit("refresh_interval_sec", &refresh_interval_sec);
+    // `own_` is not visited
+    // `peers_` is not visited
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.SharedDatabase";
+  TVM_DECLARE_FINAL_OBJECT_INFO(SharedDatabaseNode, DatabaseNode);
+
+ public:
+  Optional<TuningRecord> QueryTuningRecord(const IRModule& mod, const Target& target,
+                                           const String& workload_name) final {
+    // Unlike the default implementation, a query doesn't commit the workload to the own segment
+    Array<TuningRecord> records = TopK(Workload(mod, GetModuleEquality().Hash(mod)), 1);
+    if (records.empty()) {
+      return NullOpt;
+    }
+    return records[0];
+  }
+
+  bool HasWorkload(const IRModule& mod) final {
+    MaybeRefresh();
+    if (own_->HasWorkload(mod)) {
+      return true;
+    }
+    for (const auto& kv : peers_) {
+      if (kv.second->HasWorkload(mod)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  Workload CommitWorkload(const IRModule& mod) final { return own_->CommitWorkload(mod); }
+
+  void CommitTuningRecord(const TuningRecord& record) final {
+    // The record may refer to a workload that only the other segments have
+    own_->CommitWorkload(record->workload->mod);
+    own_->CommitTuningRecord(record);
+  }
+
+  Array<TuningRecord> GetTopK(const Workload& workload, int top_k) final {
+    CHECK_GE(top_k, 0) << "ValueError: top_k must be non-negative";
+    if (top_k == 0) {
+      return {};
+    }
+    Array<TuningRecord> results = TopK(workload, top_k);
+    if (results.size() < static_cast<size_t>(top_k)) {
+      LOG(WARNING) << "Returned tuning records less than requested(" << results.size() << " of "
+                   << top_k << " asked).";
+    }
+    return results;
+  }
+
+  Array<TuningRecord> GetAllTuningRecords() final {
+    MaybeRefresh();
+    std::vector<TuningRecord> results;
+    for (const Database& db : Segments()) {
+      for (const TuningRecord& record : db->GetAllTuningRecords()) {
+        results.push_back(record);
+      }
+    }
+    std::stable_sort(results.begin(), results.end(), SortTuningRecordByMeanRunSecs());
+    return Array<TuningRecord>(results.begin(), results.end());
+  }
+
+  int64_t Size() final {
+    MaybeRefresh();
+    int64_t size = 0;
+    for (const Database& db : Segments()) {
+      size += db->Size();
+    }
+    return size;
+  }
+
+  /*!
+   * \brief Open the directory, claiming an unlocked segment or creating a new one.
+   * \param allow_missing Whether to create the directory when the given path is not found.
+   */
+  void Open(bool allow_missing) {
+#ifndef _WIN32
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+      CHECK(allow_missing) << "ValueError: Directory doesn't exist: " << path;
+      CHECK(mkdir(path.c_str(), 0777) == 0 || errno == EEXIST)
+          << "ValueError: Cannot create directory: " << path;
+    } else {
+      CHECK(S_ISDIR(st.st_mode)) << "ValueError: Not a directory: " << path;
+    }
+    // Take over the segment of a process that has exited, to keep the number of segments bounded
+    for (const std::string& name : ListSegments()) {
+      if (TryLock(name)) {
+        segment = name;
+        break;
+      }
+    }
+    if (segment.empty()) {
+      char host[256] = {0};
+      gethostname(host, sizeof(host) - 1);
+      std::string prefix = std::string(host) + "-" + std::to_string(getpid());
+      for (int i = 0; segment.empty(); ++i) {
+        std::string name = prefix + "-" + std::to_string(i) + ".bin";
+        // A file of the same name may be locked by a process on another host
+        if (TryLock(name)) {
+          segment = name;
+        }
+      }
+    }
+    own_ = Database::BinaryDatabase(SegmentPath(segment), /*allow_missing=*/true, mod_eq_name_);
+    Refresh();
+#else
+    LOG(FATAL) << "NotImplementedError: SharedDatabase requires POSIX file locks";
+#endif
+  }
+
+  /*! \brief Pick up the new segments and the records appended to the known ones */
+  void Refresh() {
+    for (const std::string& name : ListSegments()) {
+      if (name == std::string(segment)) {
+        continue;
+      }
+      auto it = peers_.find(name);
+      if (it == peers_.end()) {
+        peers_.emplace(name, OpenBinaryDatabaseReadOnly(SegmentPath(name), mod_eq_name_));
+      } else {
+        RefreshBinaryDatabase(it->second);
+      }
+    }
+    last_refresh_ = std::chrono::steady_clock::now();
+  }
+
+ private:
+  /*! \brief Refresh if the last refresh happened more than `refresh_interval_sec` ago */
+  void MaybeRefresh() {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - last_refresh_;
+    if (elapsed.count() >= refresh_interval_sec) {
+      Refresh();
+    }
+  }
+
+  /*! \brief The best records of the workload across the segments */
+  Array<TuningRecord> TopK(const Workload& workload, int top_k) {
+    MaybeRefresh();
+    std::vector<TuningRecord> results;
+    for (const Database& db : Segments()) {
+      for (const TuningRecord& record : BinaryDatabaseTopK(db, workload, top_k)) {
+        results.push_back(record);
+      }
+    }
+    std::stable_sort(results.begin(), results.end(), SortTuningRecordByMeanRunSecs());
+    if (results.size() > static_cast<size_t>(top_k)) {
+      results.erase(results.begin() + top_k, results.end());
+    }
+    return Array<TuningRecord>(results.begin(), results.end());
+  }
+
+  /*! \brief The own segment, followed by the ones of the other processes */
+  std::vector<Database> Segments() const {
+    std::vector<Database> segments{own_};
+    for (const auto& kv : peers_) {
+      segments.push_back(kv.second);
+    }
+    return segments;
+  }
+
+  std::string SegmentPath(const std::string& name) const { return std::string(path) + "/" + name; }
+
+  /*! \brief The file names of the segments in the directory, in sorted order */
+  std::vector<std::string> ListSegments() const {
+    std::vector<std::string> names;
+#ifndef _WIN32
+    DIR* dir = opendir(path.c_str());
+    CHECK(dir != nullptr) << "ValueError: Cannot open directory: " << path;
+    while (struct dirent* entry = readdir(dir)) {
+      std::string name = entry->d_name;
+      if (name.size() > 4 && name.compare(name.size() - 4, 4, ".bin") == 0) {
+        names.push_back(name);
+      }
+    }
+    closedir(dir);
+#endif
+    std::sort(names.begin(), names.end());
+    return names;
+  }
+
+  /*!
+   * \brief Try to hold the exclusive lock of a segment, creating its file if needed.
+   * \return Whether the lock is held, in which case `lock_fd_` keeps it until destruction.
+   */
+  bool TryLock(const std::string& name) {
+#ifndef _WIN32
+    int fd = open(SegmentPath(name).c_str(), O_RDWR | O_CREAT, 0666);
+    CHECK_GE(fd, 0) << "ValueError: Cannot create new file: " << SegmentPath(name);
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+      close(fd);
+      return false;
+    }
+    lock_fd_ = fd;
+    return true;
+#else
+    return false;
+#endif
+  }
+};
+
+Database Database::SharedDatabase(String path, double refresh_interval_sec, bool allow_missing,
+                                  String mod_eq_name) {
+  ObjectPtr<SharedDatabaseNode> n = make_object<SharedDatabaseNode>(mod_eq_name);
+  n->path = path;
+  n->refresh_interval_sec = refresh_interval_sec;
+  n->Open(allow_missing);
+  return Database(n);
+}
+
+TVM_REGISTER_NODE_TYPE(SharedDatabaseNode);
+TVM_REGISTER_GLOBAL("meta_schedule.DatabaseSharedDatabase")
+    .set_body_typed(Database::SharedDatabase);
+TVM_REGISTER_GLOBAL("meta_schedule.DatabaseSharedDatabaseRefresh")
+    .set_body_typed([](Database db) {
+      auto* node = const_cast<SharedDatabaseNode*>(db.as<SharedDatabaseNode>());
+      ICHECK(node != nullptr) << "TypeError: Expect a SharedDatabase, but gets: "
+                              << db->GetTypeKey();
+      node->Refresh();
+    });
+
+}  // namespace meta_schedule
+}  // namespace tvm
@@ -20,6 +20,7 @@
 
 #include <cmath>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
 #include <unordered_map>
@@ -1262,18 +1263,16 @@ struct Feature {
 /*! \brief The main feature extractor */
 class PerStoreFeatureCollector : private StmtVisitor {
  public:
-  static std::vector<Feature> Collect(bool is_gpu, int64_t cache_line_bytes,
-                                      int64_t arith_intensity_curve_num_samples,
-                                      const IRModule& mod) {
+  /*!
+   * \brief Collect the features of the buffers stored in a top-level statement of a function,
+   * which do not depend on the other top-level statements. The buffers allocated outside the
+   * statement are left without group 4 features.
+   */
+  static std::vector<Feature> CollectStmt(bool is_gpu, int64_t cache_line_bytes,
+                                          int64_t arith_intensity_curve_num_samples,
+                                          const Stmt& stmt) {
     PerStoreFeatureCollector collector(is_gpu, cache_line_bytes, arith_intensity_curve_num_samples);
-    for (const auto& kv : mod->functions) {
-      if (const PrimFuncNode* func = kv.second.as<PrimFuncNode>()) {
-        collector(func->body);
-        for (const auto& it : func->buffer_map) {
-          collector.HandleBufferAlloc(it.second);
-        }
-      }
-    }
+    collector(stmt);
     std::vector<Feature> result;
     result.reserve(collector.buffer_features_.size());
     for (auto& it : collector.buffer_features_) {
@@ -1283,9 +1282,6 @@ class PerStoreFeatureCollector : private StmtVisitor {
         ICHECK(feature.group2);
         ICHECK(feature.group3);
         ICHECK(feature.group5);
-        if (feature.group4 == nullptr) {
-          feature.group4 = std::make_unique<group4::Feature>();
-        }
         result.push_back(std::move(feature));
       }
     }
@@ -1349,12 +1345,105 @@ class PerStoreFeatureCollector : private StmtVisitor {
   std::unordered_map<const BufferNode*, Feature> buffer_features_ = {};
 };
 
+/*! \brief Collect the buffers that features are extracted for, in the order they are stored */
+class StoredBufferCollector : private StmtVisitor {
+ public:
+  static std::vector<const BufferNode*> Collect(const Stmt& stmt) {
+    StoredBufferCollector collector;
+    collector(stmt);
+    return std::move(collector.buffers_);
+  }
+
+ private:
+  void VisitStmt_(const BufferStoreNode* store) final {
+    // Consistent with `PerStoreFeatureCollector`, which skips the stores of constants
+    if (store->value->IsInstance<IntImmNode>() || store->value->IsInstance<FloatImmNode>()) {
+      return;
+    }
+    if (visited_.insert(store->buffer.get()).second) {
+      buffers_.push_back(store->buffer.get());
+    }
+  }
+
+  std::vector<const BufferNode*> buffers_;
+  std::unordered_set<const BufferNode*> visited_;
+};
+
+/*!
+ * \brief Split the body of a lowered function into its top-level statements.
+ * \param body The body of the function.
+ * \param root_alloc_buffers The buffers allocated by the root block, if any.
+ * \return The top-level statements, in order.
+ */
+std::vector<Stmt> SplitTopLevelStmts(Stmt body, Array<Buffer>* root_alloc_buffers) {
+  if (const auto* realize = body.as<BlockRealizeNode>()) {
+    const BlockNode* block = realize->block.get();
+    if (!block->init.defined()) {
+      *root_alloc_buffers = block->alloc_buffers;
+      body = block->body;
+    }
+  }
+  if (const auto* seq = body.as<SeqStmtNode>()) {
+    return std::vector<Stmt>(seq->seq.begin(), seq->seq.end());
+  }
+  return {body};
+}
+
 }  // namespace tir
 }  // namespace tvm
 
 namespace tvm {
 namespace meta_schedule {
 
+/*!
+ * \brief A thread-safe cache keyed by structural hash. It is cleared when full, which is cheaper
+ * than keeping an LRU order and good enough for the locality of the search.
+ */
+template <typename TValue>
+class StructuralHashCache {
+ public:
+  explicit StructuralHashCache(size_t capacity) : capacity_(capacity) {}
+
+  std::shared_ptr<const TValue> Get(uint64_t key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = map_.find(key);
+    return it == map_.end() ? nullptr : it->second;
+  }
+
+  void Put(uint64_t key, std::shared_ptr<const TValue> value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (map_.size() >= capacity_) {
+      map_.clear();
+    }
+    map_[key] = std::move(value);
+  }
+
+ private:
+  size_t capacity_;
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, std::shared_ptr<const TValue>> map_;
+};
+
+/*! \brief The exported features of the buffers stored in a top-level statement of a function */
+struct PerStoreStmtFeatures {
+  struct Store {
+    /*! \brief The index of the buffer in `StoredBufferCollector::Collect` of the statement */
+    int buffer_index;
+    /*! \brief The exported group 1, 2 and 3 features */
+    std::vector<double> group123;
+    /*! \brief The exported group 4 features, empty if the buffer is allocated outside */
+    std::vector<double> group4;
+    /*! \brief The product of the extents of the loops around the store */
+    int64_t outer_prod;
+    /*! \brief The exported group 5 features */
+    std::vector<double> group5;
+  };
+  /*! \brief The number of buffers stored in the statement */
+  int num_buffers;
+  /*! \brief The stores, in the order of the buffers' first stores */
+  std::vector<Store> stores;
+};
+
 class PerStoreFeatureNode : public FeatureExtractorNode {
  public:
   int buffers_per_store;
@@ -1370,25 +1459,123 @@ class PerStoreFeatureNode : public FeatureExtractorNode {
     v->Visit("feature_vector_length", &feature_vector_length);
   }
 
+  /*! \brief The features of the candidates extracted before, keyed by module */
+  StructuralHashCache<std::vector<std::vector<double>>> module_cache_{kModuleCacheSize};
+  /*! \brief The features of the top-level statements of the lowered functions */
+  StructuralHashCache<PerStoreStmtFeatures> stmt_cache_{kStmtCacheSize};
+
+  /*!
+   * \brief Extract the features of a module. The features of each top-level statement of the
+   * lowered functions are cached, so that only the statements a mutation changed are analyzed.
+   */
   void ExtractSingle(IRModule mod, bool is_gpu, std::vector<std::vector<double>>* results) {
     static transform::Sequential passes = tir::transform::PassListForPerStoreFeature();
     mod = passes(std::move(mod));
-    std::vector<tir::Feature> features = tir::PerStoreFeatureCollector::Collect(
-        is_gpu, this->cache_line_bytes, this->arith_intensity_curve_num_samples, mod);
-    int n_features = features.size();
-    results->resize(n_features);
-    for (int i = 0; i < n_features; ++i) {
-      const tir::Feature& feature = features[i];
-      std::vector<double>& result = (*results)[i];
+    // As in a single `PerStoreFeatureCollector` over the whole function, the last store to a
+    // buffer wins, and the root allocations and the parameters get the group 4 features
+    struct MergedStore {
+      std::shared_ptr<const PerStoreStmtFeatures> stmt_features;  // keeps `store` alive
+      const PerStoreStmtFeatures::Store* store = nullptr;
+      std::unique_ptr<tir::group4::Feature> root_group4 = nullptr;
+    };
+    std::unordered_map<const tir::BufferNode*, MergedStore> merged;
+    std::vector<const tir::BufferNode*> buffer_order;
+    arith::Analyzer analyzer;
+    auto f_root_alloc = [&merged, &analyzer](const tir::Buffer& buffer) -> void {
+      auto it = merged.find(buffer.get());
+      if (it != merged.end()) {
+        it->second.root_group4 =
+            std::make_unique<tir::group4::Feature>(tir::LoopNest(), buffer, &analyzer);
+      }
+    };
+    for (const auto& kv : mod->functions) {
+      const auto* func = kv.second.as<tir::PrimFuncNode>();
+      if (func == nullptr) {
+        continue;
+      }
+      Array<tir::Buffer> root_alloc_buffers;
+      for (const tir::Stmt& stmt : tir::SplitTopLevelStmts(func->body, &root_alloc_buffers)) {
+        std::vector<const tir::BufferNode*> buffers = tir::StoredBufferCollector::Collect(stmt);
+        std::shared_ptr<const PerStoreStmtFeatures> stmt_features =
+            GetStmtFeatures(stmt, is_gpu, buffers);
+        for (const PerStoreStmtFeatures::Store& store : stmt_features->stores) {
+          const tir::BufferNode* buffer = buffers[store.buffer_index];
+          auto it = merged.find(buffer);
+          if (it == merged.end()) {
+            it = merged.emplace(buffer, MergedStore()).first;
+            buffer_order.push_back(buffer);
+          }
+          it->second.stmt_features = stmt_features;
+          it->second.store = &store;
+        }
+      }
+      for (const tir::Buffer& buffer : root_alloc_buffers) {
+        f_root_alloc(buffer);
+      }
+      for (const auto& it : func->buffer_map) {
+        f_root_alloc(it.second);
+      }
+    }
+    results->clear();
+    results->reserve(buffer_order.size());
+    for (const tir::BufferNode* buffer : buffer_order) {
+      const MergedStore& item = merged.at(buffer);
+      const PerStoreStmtFeatures::Store& store = *item.store;
+      std::vector<double> result;
       result.reserve(feature_vector_length);
-      feature.group1->Export(&result);
-      feature.group2->Export(&result, this->buffers_per_store);
-      feature.group3->Export(&result);
-      feature.group4->Export(&result, feature.group5->outer_prod);
-      feature.group5->Export(&result);
+      result.insert(result.end(), store.group123.begin(), store.group123.end());
+      if (item.root_group4 != nullptr) {
+        item.root_group4->Export(&result, store.outer_prod);
+      } else if (!store.group4.empty()) {
+        result.insert(result.end(), store.group4.begin(), store.group4.end());
+      } else {
+        tir::group4::Feature().Export(&result, store.outer_prod);
+      }
+      result.insert(result.end(), store.group5.begin(), store.group5.end());
+      results->push_back(std::move(result));
     }
   }
 
+  /*!
+   * \brief Get the features of a top-level statement of a lowered function from the cache, or
+   * extract them. Statements equal up to the renaming of free variables share the features.
+   * \param stmt The statement.
+   * \param is_gpu Whether the statement is for GPU.
+   * \param buffers The buffers stored in the statement.
+   * \return The features of the statement.
+   */
+  std::shared_ptr<const PerStoreStmtFeatures> GetStmtFeatures(
+      const tir::Stmt& stmt, bool is_gpu, const std::vector<const tir::BufferNode*>& buffers) {
+    uint64_t key = support::HashCombine(SHashHandlerDefault().Hash(stmt, /*map_free_vars=*/true),
+                                        is_gpu);
+    std::shared_ptr<const PerStoreStmtFeatures> cached = stmt_cache_.Get(key);
+    if (cached != nullptr && cached->num_buffers == static_cast<int>(buffers.size())) {
+      return cached;
+    }
+    std::unordered_map<const tir::BufferNode*, int> buffer_index;
+    for (int i = 0, n = buffers.size(); i < n; ++i) {
+      buffer_index[buffers[i]] = i;
+    }
+    auto result = std::make_shared<PerStoreStmtFeatures>();
+    result->num_buffers = buffers.size();
+    for (const tir::Feature& feature : tir::PerStoreFeatureCollector::CollectStmt(
+             is_gpu, this->cache_line_bytes, this->arith_intensity_curve_num_samples, stmt)) {
+      PerStoreStmtFeatures::Store store;
+      store.buffer_index = buffer_index.at(feature.buffer);
+      feature.group1->Export(&store.group123);
+      feature.group2->Export(&store.group123, this->buffers_per_store);
+      feature.group3->Export(&store.group123);
+      if (feature.group4 != nullptr) {
+        feature.group4->Export(&store.group4, feature.group5->outer_prod);
+      }
+      store.outer_prod = feature.group5->outer_prod;
+      feature.group5->Export(&store.group5);
+      result->stores.push_back(std::move(store));
+    }
+    stmt_cache_.Put(key, result);
+    return result;
+  }
+
   Array<runtime::NDArray> ExtractFrom(const TuneContext& tune_context,
                                       const Array<MeasureCandidate>& candidates) {
     bool is_gpu = tune_context->target.value()->kind->name == "cuda";
@@ -1399,9 +1586,17 @@ class PerStoreFeatureNode : public FeatureExtractorNode {
       feature_group6 = std::make_unique<tir::group6::Feature>(tune_context->mod.value());
     }
     auto f = [this, is_gpu, &feature_group6, &candidates, &results](int, int task_id) -> void {
-      const auto& candidate = candidates[task_id];
+      const IRModule& mod = candidates[task_id]->sch->mod();
+      // Evolutionary search revisits the same candidates across its iterations
+      uint64_t key = support::HashCombine(StructuralHash()(mod), is_gpu);
       std::vector<std::vector<double>> features;
-      ExtractSingle(DeepCopyIRModule(candidate->sch->mod()), is_gpu, &features);
+      if (std::shared_ptr<const std::vector<std::vector<double>>> cached =
+              module_cache_.Get(key)) {
+        features = *cached;
+      } else {
+        ExtractSingle(DeepCopyIRModule(mod), is_gpu, &features);
+        module_cache_.Put(key, std::make_shared<std::vector<std::vector<double>>>(features));
+      }
       if (extract_workload) {
         for (auto& feature : features) {
           feature_group6->Export(&feature);
@@ -1413,6 +1608,11 @@ class PerStoreFeatureNode : public FeatureExtractorNode {
     return results;
   }
 
+  /*! \brief The maximum number of modules whose features are cached */
+  static constexpr size_t kModuleCacheSize = 4096;
+  /*! \brief The maximum number of top-level statements whose features are cached */
+  static constexpr size_t kStmtCacheSize = 16384;
+
   static constexpr const char* _type_key = "meta_schedule.PerStoreFeature";
   TVM_DECLARE_FINAL_OBJECT_INFO(PerStoreFeatureNode, FeatureExtractorNode);
 };
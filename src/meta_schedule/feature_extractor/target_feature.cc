@@ -0,0 +1,118 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <cmath>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief The feature extractor that appends the features of the target to every feature vector of
+ * another extractor, so that a cost model trained on the records of one target carries over to a
+ * close one, e.g. another CPU model of the same family.
+ */
+class TargetFeatureNode : public FeatureExtractorNode {
+ public:
+  /*! \brief The feature extractor whose features are extended */
+  FeatureExtractor extractor{nullptr};
+
+  void VisitAttrs(tvm::AttrVisitor* v) { v->Visit("extractor", &extractor); }
+
+  /*! \brief The number of the target features */
+  static constexpr int kCount = 10;
+
+  /*! \brief Extract the features of a target */
+  static std::vector<double> Extract(const Target& target) {
+    auto slog = [](int64_t x) { return std::log2(1.0 + std::max<int64_t>(x, 0)); };
+    auto f_int = [&target, &slog](const char* key) -> double {
+      return slog(target->GetAttr<Integer>(key).value_or(Integer(0))->value);
+    };
+    auto f_has_isa = [&target](const char* func_name) -> double {
+      Optional<String> mcpu = target->GetAttr<String>("mcpu");
+      const runtime::PackedFunc* f = runtime::Registry::Get(func_name);
+      if (!mcpu.defined() || f == nullptr) {
+        return 0.0;
+      }
+      bool has_isa = (*f)(mcpu.value());
+      return has_isa ? 1.0 : 0.0;
+    };
+    std::vector<double> result{
+        static_cast<double>(IsGPUTarget(target->kind->name)),
+        f_int("num-cores"),
+        f_has_isa("tvm.target.x86.target_has_sse42"),
+        f_has_isa("tvm.target.x86.target_has_avx2"),
+        f_has_isa("tvm.target.x86.target_has_avx512"),
+        f_has_isa("tvm.target.x86.target_has_vnni"),
+        f_has_isa("tvm.target.x86.target_has_amx"),
+        f_int("max_threads_per_block"),
+        f_int("thread_warp_size"),
+        f_int("max_shared_memory_per_block"),
+    };
+    ICHECK_EQ(result.size(), kCount);
+    return result;
+  }
+
+  Array<runtime::NDArray> ExtractFrom(const TuneContext& context,
+                                      const Array<MeasureCandidate>& candidates) final {
+    std::vector<double> target_features = Extract(context->target.value());
+    Array<runtime::NDArray> results;
+    results.reserve(candidates.size());
+    for (const runtime::NDArray& features : extractor->ExtractFrom(context, candidates)) {
+      ICHECK_EQ(features->ndim, 2);
+      ICHECK(features.DataType() == DataType::Float(64));
+      int64_t n = features->shape[0];
+      int64_t m = features->shape[1];
+      runtime::NDArray result = runtime::NDArray::Empty({n, m + kCount}, features->dtype,
+                                                        DLDevice{kDLCPU, 0});
+      const double* src = static_cast<const double*>(features->data);
+      double* dst = static_cast<double*>(result->data);
+      for (int64_t i = 0; i < n; ++i) {
+        std::copy(src + i * m, src + (i + 1) * m, dst + i * (m + kCount));
+        std::copy(target_features.begin(), target_features.end(), dst + i * (m + kCount) + m);
+      }
+      results.push_back(result);
+    }
+    return results;
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.TargetFeature";
+  TVM_DECLARE_FINAL_OBJECT_INFO(TargetFeatureNode, FeatureExtractorNode);
+};
+
+FeatureExtractor FeatureExtractor::TargetFeature(FeatureExtractor extractor) {
+  ObjectPtr<TargetFeatureNode> n = make_object<TargetFeatureNode>();
+  n->extractor = std::move(extractor);
+  return FeatureExtractor(n);
+}
+
+TVM_REGISTER_NODE_TYPE(TargetFeatureNode);
+TVM_REGISTER_GLOBAL("meta_schedule.FeatureExtractorTargetFeature")
+    .set_body_typed(FeatureExtractor::TargetFeature);
+TVM_REGISTER_GLOBAL("meta_schedule.FeatureExtractorTargetFeatureExtract")
+    .set_body_typed([](Target target) -> Array<FloatImm> {
+      Array<FloatImm> result;
+      for (double x : TargetFeatureNode::Extract(target)) {
+        result.push_back(FloatImm(DataType::Float(64), x));
+      }
+      return result;
+    });
+
+}  // namespace meta_schedule
+}  // namespace tvm
@@ -0,0 +1,110 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "./invalid_decision_cache.h"
+
+#include <tvm/node/structural_hash.h>
+#include <tvm/tir/index_map.h>
+
+#include <functional>
+#include <string>
+
+#include "../support/utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+bool InvalidDecisionCache::DecisionKeys(const tir::Trace& trace, std::vector<uint64_t>* keys) {
+  // Random variables are identified by the order they are defined in, so that the traces replayed
+  // from the same design space hash the same
+  std::unordered_map<const Object*, int64_t> rv_index;
+  bool hashable = true;
+  std::function<uint64_t(const ObjectRef&)> f_hash = [&](const ObjectRef& obj) -> uint64_t {
+    if (!obj.defined()) {
+      return 0;
+    }
+    auto it = rv_index.find(obj.get());
+    if (it != rv_index.end()) {
+      return support::HashCombine(1, it->second);
+    }
+    if (const auto* arr = obj.as<ArrayNode>()) {
+      uint64_t result = 2;
+      for (const ObjectRef& elem : *arr) {
+        result = support::HashCombine(result, f_hash(elem));
+      }
+      return result;
+    }
+    if (obj->IsInstance<PrimExprNode>() || obj->IsInstance<StringObj>() ||
+        obj->IsInstance<tir::IndexMapNode>()) {
+      return StructuralHash()(obj);
+    }
+    // Hashing by address may collide with a freed object whose address is reused
+    hashable = false;
+    return 0;
+  };
+  keys->clear();
+  uint64_t prefix = 0;
+  for (const tir::Instruction& inst : trace->insts) {
+    if (inst->kind->IsPostproc()) {
+      break;
+    }
+    prefix = support::HashCombine(prefix, std::hash<std::string>()(inst->kind->name));
+    prefix = support::HashCombine(prefix, f_hash(inst->inputs));
+    prefix = support::HashCombine(prefix, f_hash(inst->attrs));
+    if (Optional<ObjectRef> decision = trace->GetDecision(inst)) {
+      keys->push_back(support::HashCombine(prefix, f_hash(decision.value())));
+    }
+    for (const ObjectRef& output : inst->outputs) {
+      rv_index.emplace(output.get(), rv_index.size());
+    }
+  }
+  if (!hashable) {
+    keys->clear();
+  }
+  return hashable;
+}
+
+bool InvalidDecisionCache::IsInvalid(const std::vector<uint64_t>& keys) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (uint64_t key : keys) {
+    auto it = stats_.find(key);
+    if (it != stats_.end() && it->second.num_valid == 0 &&
+        it->second.num_invalid >= kMinInvalid) {
+      return num_found_invalid_++ % kVerifyOneIn != 0;
+    }
+  }
+  return false;
+}
+
+void InvalidDecisionCache::Record(const std::vector<uint64_t>& keys, bool valid) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (stats_.size() + keys.size() > kMaxEntries) {
+    stats_.clear();
+  }
+  for (uint64_t key : keys) {
+    Stats& stats = stats_[key];
+    if (valid) {
+      ++stats.num_valid;
+    } else {
+      ++stats.num_invalid;
+    }
+  }
+}
+
+}  // namespace meta_schedule
+}  // namespace tvm
@@ -0,0 +1,91 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef TVM_META_SCHEDULE_INVALID_DECISION_CACHE_H_
+#define TVM_META_SCHEDULE_INVALID_DECISION_CACHE_H_
+
+#include <tvm/tir/schedule/trace.h>
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief The statistics of the sampling decisions taken by the traces that turned out valid or
+ * invalid, i.e. that passed or failed the postprocessors, in one search.
+ *
+ * The cache is owned by the state of the search, whose workload, target and postprocessors do not
+ * change. A decision is identified by its value and the instructions of the trace up to the one
+ * taking it, without their decisions. A decision that made enough traces invalid, and was never
+ * taken by a valid one, is considered invalid, and the traces taking it are rejected before they
+ * are lowered and verified, except for a few that keep the statistics honest.
+ */
+class InvalidDecisionCache {
+ public:
+  /*!
+   * \brief Compute the keys of the decisions of a trace.
+   * \param trace The trace, of which the postprocessing instructions are ignored.
+   * \param keys The keys, one per instruction with a decision.
+   * \return Whether the keys are computed, which fails if the trace refers to an object that
+   * cannot be hashed structurally.
+   */
+  static bool DecisionKeys(const tir::Trace& trace, std::vector<uint64_t>* keys);
+
+  /*!
+   * \brief Whether any of the decisions is known to make a trace invalid. One in kVerifyOneIn of
+   * the traces taking such a decision is let through anyway, so that a decision wrongly believed
+   * invalid can recover. It does not draw from the random state of the search, which thus samples
+   * the same traces as without the cache.
+   */
+  bool IsInvalid(const std::vector<uint64_t>& keys);
+
+  /*!
+   * \brief Record the decisions of a trace.
+   * \param keys The keys of the decisions.
+   * \param valid Whether the trace passed the postprocessors.
+   */
+  void Record(const std::vector<uint64_t>& keys, bool valid);
+
+  /*! \brief One in this number of the traces taking invalid decisions is verified anyway */
+  static constexpr int kVerifyOneIn = 16;
+
+ private:
+  struct Stats {
+    int32_t num_invalid = 0;
+    int32_t num_valid = 0;
+  };
+
+  /*! \brief The number of invalid traces a decision must appear in before it is trusted */
+  static constexpr int32_t kMinInvalid = 8;
+  /*! \brief The number of decisions above which the statistics are restarted */
+  static constexpr size_t kMaxEntries = 1 << 18;
+
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, Stats> stats_;
+  /*! \brief The number of traces found taking invalid decisions */
+  int64_t num_found_invalid_ = 0;
+};
+
+}  // namespace meta_schedule
+}  // namespace tvm
+
+#endif  // TVM_META_SCHEDULE_INVALID_DECISION_CACHE_H_
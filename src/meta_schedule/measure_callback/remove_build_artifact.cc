@@ -16,6 +16,7 @@
  * specific language governing permissions and limitations
  * under the License.
  */
+#include "../builder/in_process_builder.h"
 #include "../utils.h"
 
 namespace tvm {
@@ -32,7 +33,11 @@ class RemoveBuildArtifactNode : public MeasureCallbackNode {
     auto _ = Profiler::TimedScope("MeasureCallback/RemoveBuildArtifact");
     for (const BuilderResult& build_result : builder_results) {
       if (Optional<String> path = build_result->artifact_path) {
-        (*f_rm)(path.value());
+        if (IsInMemoryArtifact(path.value())) {
+          RemoveInMemoryArtifact(path.value());
+        } else {
+          (*f_rm)(path.value());
+        }
       }
     }
   }
@@ -16,6 +16,10 @@
  * specific language governing permissions and limitations
  * under the License.
  */
+#include <tvm/tir/stmt_functor.h>
+
+#include <cmath>
+#include <limits>
 #include <mutex>
 #include <unordered_map>
 
@@ -266,10 +270,288 @@ Optional<Trace> MutateTileSizeNode::Apply(const Trace& trace, TRandState* rand_s
   }
 }
 
+/*!
+ * \brief The working set of the loop nest around the leaf block with the most instances. The
+ * level `k` of the nest is the body of its `k`-th loop, i.e. `levels[0]` is the whole nest and
+ * `levels.back()` is a single instance of the block.
+ */
+class WorkingSetCollector : public tir::StmtVisitor {
+ public:
+  /*! \brief The work and the footprint of a level of the loop nest */
+  struct Level {
+    /*! \brief The number of block instances inside the level */
+    int64_t work;
+    /*! \brief The number of bytes the level touches */
+    int64_t bytes;
+  };
+
+  static std::vector<Level> Collect(const IRModule& mod) {
+    WorkingSetCollector collector;
+    for (const auto& kv : mod->functions) {
+      if (const auto* prim_func = kv.second.as<tir::PrimFuncNode>()) {
+        collector(prim_func->body);
+      }
+    }
+    return collector.levels_;
+  }
+
+ private:
+  void VisitStmt_(const tir::ForNode* loop) final {
+    loops_.push_back(loop);
+    tir::StmtVisitor::VisitStmt_(loop);
+    loops_.pop_back();
+  }
+
+  void VisitStmt_(const tir::BlockRealizeNode* realize) final {
+    int64_t n_blocks = ++n_blocks_;
+    tir::StmtVisitor::VisitStmt_(realize);
+    if (n_blocks == n_blocks_) {
+      VisitLeafBlock(realize);
+    }
+  }
+
+  void VisitLeafBlock(const tir::BlockRealizeNode* realize) {
+    int n = loops_.size();
+    std::vector<int64_t> work(n + 1, 1);
+    for (int i = n - 1; i >= 0; --i) {
+      const auto* extent = loops_[i]->extent.as<IntImmNode>();
+      if (extent == nullptr) {
+        return;
+      }
+      work[i] = work[i + 1] * extent->value;
+    }
+    if (work[0] <= max_work_) {
+      return;
+    }
+    const tir::BlockNode* block = realize->block.get();
+    Map<tir::Var, PrimExpr> binding;
+    for (int i = 0, m = block->iter_vars.size(); i < m; ++i) {
+      binding.Set(block->iter_vars[i]->var, realize->iter_values[i]);
+    }
+    std::vector<Level> levels;
+    levels.reserve(n + 1);
+    for (int k = 0; k <= n; ++k) {
+      // The loops outside the level are fixed at their first iteration
+      Map<tir::Var, arith::IntSet> dom;
+      for (int i = 0; i < n; ++i) {
+        const tir::ForNode* loop = loops_[i];
+        dom.Set(loop->loop_var, i < k ? arith::IntSet::SinglePoint(loop->min)
+                                      : arith::IntSet::FromMinExtent(loop->min, loop->extent));
+      }
+      // A buffer both read and written, e.g. the output of a reduction, is counted once
+      std::unordered_map<const tir::BufferNode*, int64_t> footprint;
+      for (const Array<tir::BufferRegion>& regions : {block->reads, block->writes}) {
+        for (const tir::BufferRegion& region : regions) {
+          int64_t& bytes = footprint[region->buffer.get()];
+          bytes = std::max(bytes, Footprint(region, binding, dom));
+        }
+      }
+      int64_t bytes = 0;
+      for (const auto& kv : footprint) {
+        bytes += kv.second;
+      }
+      levels.push_back(Level{work[k], bytes});
+    }
+    max_work_ = work[0];
+    levels_ = std::move(levels);
+  }
+
+  /*! \brief The number of bytes a region touches, bounded by the size of its buffer */
+  int64_t Footprint(const tir::BufferRegion& region, const Map<tir::Var, PrimExpr>& binding,
+                    const Map<tir::Var, arith::IntSet>& dom) {
+    const tir::Buffer& buffer = region->buffer;
+    Array<Range> ranges;
+    ranges.reserve(region->region.size());
+    for (const Range& range : region->region) {
+      ranges.push_back(Range::FromMinExtent(tir::Substitute(range->min, binding),
+                                            tir::Substitute(range->extent, binding)));
+    }
+    Array<arith::IntSet> sets = arith::EvalSet(ranges, dom);
+    int64_t elems = 1;
+    for (int i = 0, n = sets.size(); i < n; ++i) {
+      const auto* shape = buffer->shape[i].as<IntImmNode>();
+      int64_t extent = shape != nullptr ? shape->value : std::numeric_limits<int32_t>::max();
+      if (sets[i].HasLowerBound() && sets[i].HasUpperBound()) {
+        PrimExpr size = analyzer_.Simplify(sets[i].max() - sets[i].min() + 1);
+        if (const auto* imm = size.as<IntImmNode>()) {
+          extent = std::min(extent, imm->value);
+        }
+      }
+      elems *= extent;
+    }
+    return elems * buffer->dtype.bytes() * buffer->dtype.lanes();
+  }
+
+  /*! \brief The loops surrounding the statement being visited, from outer to inner */
+  std::vector<const tir::ForNode*> loops_;
+  /*! \brief The number of blocks visited */
+  int64_t n_blocks_ = 0;
+  /*! \brief The number of instances of the heaviest leaf block so far */
+  int64_t max_work_ = 0;
+  /*! \brief The working set of the heaviest leaf block so far */
+  std::vector<Level> levels_;
+  /*! \brief The analyzer */
+  arith::Analyzer analyzer_;
+};
+
+/*!
+ * \brief A mutator that mutates the tile size the way `MutateTileSize` does, but proposes several
+ * candidates and keeps the one whose loop nest makes the best use of the data caches on CPU.
+ */
+class MutateTileSizeCacheAwareNode : public MutatorNode {
+ public:
+  /*! \brief The number of candidates proposed per mutation */
+  int num_proposals;
+  /*! \brief The module to be tuned */
+  IRModule mod_{nullptr};
+  /*! \brief The L1 data cache size in bytes, or -1 if the caches are not modeled */
+  int64_t l1_cache_bytes_ = -1;
+  /*! \brief The L2 cache size in bytes, or -1 if the caches are not modeled */
+  int64_t l2_cache_bytes_ = -1;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("num_proposals", &num_proposals);
+    // `mod_` is not visited
+    // `l1_cache_bytes_` is not visited
+    // `l2_cache_bytes_` is not visited
+  }
+  static constexpr const char* _type_key = "meta_schedule.MutateTileSizeCacheAware";
+  TVM_DECLARE_FINAL_OBJECT_INFO(MutateTileSizeCacheAwareNode, MutatorNode);
+
+ public:
+  // Inherit from `MutatorNode`
+  void InitializeWithTuneContext(const TuneContext& context) final {
+    mod_ = context->mod.value();
+    Target target = context->target.value();
+    if (IsGPUTarget(target->kind->name)) {
+      // The caches of GPUs are not modeled, so the first proposal is always kept
+      l1_cache_bytes_ = l2_cache_bytes_ = -1;
+    } else {
+      l1_cache_bytes_ = target->GetAttr<Integer>("l1_cache_bytes").value_or(32 * 1024).IntValue();
+      l2_cache_bytes_ = target->GetAttr<Integer>("l2_cache_bytes").value_or(1024 * 1024).IntValue();
+    }
+  }
+  // Inherit from `MutatorNode`
+  Optional<Trace> Apply(const Trace& trace, TRandState* rand_state) final;
+  // Inherit from `MutatorNode`
+  Mutator Clone() const final {
+    ObjectPtr<MutateTileSizeCacheAwareNode> n = make_object<MutateTileSizeCacheAwareNode>(*this);
+    return Mutator(n);
+  }
+
+  /*!
+   * \brief Score a trace by the data reuse of the largest level of its loop nest that fits in
+   * each of the caches. A higher score means more reuse.
+   * \return The score, or NullOpt if the trace fails to apply
+   */
+  Optional<FloatImm> Score(const Trace& trace, TRandState* rand_state) const {
+    tir::Schedule sch =
+        tir::Schedule::Traced(mod_,
+                              /*rand_state=*/ForkSeed(rand_state),
+                              /*debug_mode=*/0,
+                              /*error_render_level=*/tir::ScheduleErrorRenderLevel::kNone);
+    try {
+      trace->ApplyToSchedule(sch, /*remove_postproc=*/true);
+    } catch (const std::exception& e) {
+      return NullOpt;
+    }
+    double score = 0.0;
+    std::vector<WorkingSetCollector::Level> levels = WorkingSetCollector::Collect(sch->mod());
+    for (int64_t cache_bytes : {l1_cache_bytes_, l2_cache_bytes_}) {
+      double reuse = 0.0;
+      for (const WorkingSetCollector::Level& level : levels) {
+        if (level.bytes > 0 && level.bytes <= cache_bytes) {
+          reuse = std::max(reuse, static_cast<double>(level.work) / level.bytes);
+        }
+      }
+      score += std::log2(1.0 + reuse);
+    }
+    return FloatImm(DataType::Float(64), score);
+  }
+
+ private:
+  /*!
+   * \brief Propose a new decision of a Sample-Perfect-Tile, either by moving a factor between
+   * two of its tiles, or by sampling all of its tiles afresh
+   */
+  Optional<Trace> Propose(const Trace& trace, const Instruction& inst,
+                          const std::vector<int64_t>& tiles, TRandState* rand_state) const {
+    if (tir::SampleInt(rand_state, 0, 2) == 0) {
+      return MutateSampleTileSize(trace, inst, tiles, rand_state);
+    }
+    int64_t max_innermost_factor = Downcast<Integer>(inst->attrs[1])->value;
+    std::vector<int64_t> result =
+        tir::SamplePerfectTile(rand_state, Product(tiles), tiles.size(), max_innermost_factor);
+    if (result == tiles) {
+      return NullOpt;
+    }
+    return trace->WithDecision(inst, support::AsArray<int64_t, ObjectRef>(result),
+                               /*remove_postproc=*/true);
+  }
+};
+
+Optional<Trace> MutateTileSizeCacheAwareNode::Apply(const Trace& trace, TRandState* rand_state) {
+  std::vector<Instruction> sample_perfect_tile_insts;
+  std::vector<Instruction> sample_vectorize_insts;
+  std::vector<std::vector<int64_t>> sample_perfect_tile_tiles;
+  std::vector<int64_t> sample_vectorize_decisions;
+  FindSamplePerfectTile(trace, &sample_perfect_tile_insts, &sample_perfect_tile_tiles);
+  FindSampleVectorize(trace, &sample_vectorize_insts, &sample_vectorize_decisions);
+  int size_a = sample_perfect_tile_insts.size();
+  int size_b = sample_vectorize_insts.size();
+  if (size_a == 0 && size_b == 0) {
+    return NullOpt;
+  }
+  int n = tir::SampleInt(rand_state, 0, size_a + size_b);
+  if (n >= size_a) {
+    n -= size_a;
+    return MutateSampleVectorize(trace, sample_vectorize_insts[n], sample_vectorize_decisions[n],
+                                 rand_state);
+  }
+  Optional<Trace> best_trace = NullOpt;
+  double best_score = -1.0;
+  for (int i = 0; i < num_proposals; ++i) {
+    Optional<Trace> proposal = Propose(trace, sample_perfect_tile_insts[n],
+                                       sample_perfect_tile_tiles[n], rand_state);
+    if (!proposal.defined()) {
+      continue;
+    }
+    if (l1_cache_bytes_ < 0) {
+      return proposal;
+    }
+    if (Optional<FloatImm> score = Score(proposal.value(), rand_state)) {
+      if (score.value()->value > best_score) {
+        best_score = score.value()->value;
+        best_trace = proposal;
+      }
+    }
+  }
+  return best_trace;
+}
+
 Mutator Mutator::MutateTileSize() { return Mutator(make_object<MutateTileSizeNode>()); }
 
+Mutator Mutator::MutateTileSizeCacheAware(int num_proposals) {
+  CHECK_GE(num_proposals, 1) << "ValueError: num_proposals must be positive";
+  ObjectPtr<MutateTileSizeCacheAwareNode> n = make_object<MutateTileSizeCacheAwareNode>();
+  n->num_proposals = num_proposals;
+  return Mutator(n);
+}
+
 TVM_REGISTER_NODE_TYPE(MutateTileSizeNode);
+TVM_REGISTER_NODE_TYPE(MutateTileSizeCacheAwareNode);
 TVM_REGISTER_GLOBAL("meta_schedule.MutatorMutateTileSize").set_body_typed(Mutator::MutateTileSize);
+TVM_REGISTER_GLOBAL("meta_schedule.MutatorMutateTileSizeCacheAware")
+    .set_body_typed(Mutator::MutateTileSizeCacheAware);
+TVM_REGISTER_GLOBAL("meta_schedule.MutateTileSizeCacheAwareScore")
+    .set_body_typed([](Mutator self, Trace trace) -> Optional<FloatImm> {
+      const auto* node = self.as<MutateTileSizeCacheAwareNode>();
+      ICHECK(node != nullptr) << "TypeError: Expect MutateTileSizeCacheAware, but gets "
+                              << self->GetTypeKey();
+      // The trace replays its decisions, the seed does not matter
+      TRandState rand_state = 0;
+      return node->Score(trace, &rand_state);
+    });
 
 }  // namespace meta_schedule
 }  // namespace tvm
@@ -51,23 +51,28 @@ struct AsyncStridedMemCopyFinder : private StmtExprVisitor {
         auto async_scope = attrStmt->body.as<AttrStmtNode>();
         if (!async_scope) {
           StmtExprVisitor::VisitStmt_(attrStmt);
+          return;
         }
 
         auto for_loop = async_scope->body.as<ForNode>();
         if (!for_loop) {
           StmtExprVisitor::VisitStmt_(attrStmt);
+          return;
         }
 
         input_iters.Set(for_loop->loop_var, Range(for_loop->min, for_loop->extent));
 
+        // a nest of copy loops is lowered to a 2D DMA when its rows are contiguous
         auto bufferstorenode = for_loop->body.as<BufferStoreNode>();
         if (!bufferstorenode) {
           StmtExprVisitor::VisitStmt_(attrStmt);
+          return;
         }
 
         auto bufferloadnode = bufferstorenode->value.as<BufferLoadNode>();
         if (!bufferloadnode) {
           StmtExprVisitor::VisitStmt_(attrStmt);
+          return;
         }
 
         // get store buffer; assert it exists and is contiguous given it uses a single index
@@ -78,6 +83,7 @@ struct AsyncStridedMemCopyFinder : private StmtExprVisitor {
 
         if (!bufferstore || !bufferload) {
           StmtExprVisitor::VisitStmt_(attrStmt);
+          return;
         }
 
         // map loop variable to zero for the store index & simplify
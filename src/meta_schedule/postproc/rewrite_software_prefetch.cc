@@ -0,0 +1,131 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "../../tir/transforms/ir_utils.h"
+#include "../utils.h"
+
+namespace tvm {
+namespace tir {
+
+/*!
+ * \brief Find the innermost serial loop of a block along which the block reads a buffer of the
+ * parameters with a stride or a gather, and annotate it with `software_prefetch`.
+ * \param sch The schedule.
+ * \param block_rv The block.
+ * \param param_buffer_vars The data variables of the buffers of the parameters.
+ */
+void AnnotateSoftwarePrefetch(const Schedule& sch, const BlockRV& block_rv,
+                              const std::unordered_set<const VarNode*>& param_buffer_vars) {
+  const BlockRealize& realize = GetBlockRealize(sch->state(), sch->GetSRef(block_rv));
+  Map<Var, PrimExpr> iter_values;
+  for (size_t i = 0; i < realize->iter_values.size(); ++i) {
+    iter_values.Set(realize->block->iter_vars[i]->var, realize->iter_values[i]);
+  }
+  std::vector<std::pair<Buffer, Array<PrimExpr>>> reads;
+  PostOrderVisit(realize->block->body, [&](const ObjectRef& obj) {
+    if (const auto* load = obj.as<BufferLoadNode>()) {
+      if (param_buffer_vars.count(load->buffer->data.get())) {
+        reads.emplace_back(load->buffer, Substitute(load->indices, iter_values));
+      }
+    }
+  });
+  if (reads.empty()) {
+    return;
+  }
+  arith::Analyzer analyzer;
+  Array<LoopRV> loop_rvs = sch->GetLoops(block_rv);
+  for (auto it = loop_rvs.rbegin(); it != loop_rvs.rend(); ++it) {
+    For loop = sch->Get(*it);
+    if (loop->kind != ForKind::kSerial || loop->annotations.count(attr::software_prefetch)) {
+      continue;
+    }
+    for (const auto& read : reads) {
+      if (IsIrregularAccess(read.first, read.second, loop->loop_var, &analyzer)) {
+        sch->Annotate(*it, attr::software_prefetch, Integer(0));
+        return;
+      }
+    }
+  }
+}
+
+}  // namespace tir
+
+namespace meta_schedule {
+
+/*!
+ * \brief Annotate the loops of the blocks that read main memory with a stride or a gather, so that
+ * their loads are prefetched by software ahead of their use.
+ */
+class RewriteSoftwarePrefetchNode : public PostprocNode {
+ public:
+  // Inherited from PostprocNode
+  void InitializeWithTuneContext(const TuneContext& context) final {}
+  // Inherited from PostprocNode
+  bool Apply(const tir::Schedule& sch) final {
+    for (const auto& kv : sch->mod()->functions) {
+      const GlobalVar& g_var = kv.first;
+      const auto* prim_func = kv.second.as<tir::PrimFuncNode>();
+      if (prim_func == nullptr) {
+        continue;
+      }
+      std::unordered_set<const tir::VarNode*> param_buffer_vars;
+      for (const auto& buffer_kv : prim_func->buffer_map) {
+        param_buffer_vars.insert(buffer_kv.second->data.get());
+      }
+      // Collect the names of the leaf blocks first, as annotating loops changes the IR visited.
+      std::vector<String> block_names;
+      tir::PostOrderVisit(prim_func->body, [&](const ObjectRef& obj) {
+        if (const auto* block = obj.as<tir::BlockNode>()) {
+          bool is_leaf = true;
+          tir::PreOrderVisit(block->body, [&is_leaf](const ObjectRef& child) {
+            is_leaf = is_leaf && !child->IsInstance<tir::BlockNode>();
+            return is_leaf;
+          });
+          if (is_leaf) {
+            block_names.push_back(block->name_hint);
+          }
+        }
+      });
+      for (const String& block_name : block_names) {
+        tir::AnnotateSoftwarePrefetch(sch, sch->GetBlock(block_name, g_var->name_hint),
+                                      param_buffer_vars);
+      }
+    }
+    return true;
+  }
+  // Inherited from PostprocNode
+  Postproc Clone() const {
+    ObjectPtr<RewriteSoftwarePrefetchNode> n = make_object<RewriteSoftwarePrefetchNode>(*this);
+    return Postproc(n);
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.RewriteSoftwarePrefetch";
+  TVM_DECLARE_FINAL_OBJECT_INFO(RewriteSoftwarePrefetchNode, PostprocNode);
+};
+
+Postproc Postproc::RewriteSoftwarePrefetch() {
+  ObjectPtr<RewriteSoftwarePrefetchNode> n = make_object<RewriteSoftwarePrefetchNode>();
+  return Postproc(n);
+}
+
+TVM_REGISTER_NODE_TYPE(RewriteSoftwarePrefetchNode);
+TVM_REGISTER_GLOBAL("meta_schedule.PostprocRewriteSoftwarePrefetch")
+    .set_body_typed(Postproc::RewriteSoftwarePrefetch);
+
+}  // namespace meta_schedule
+}  // namespace tvm
@@ -0,0 +1,136 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <tvm/tir/transform.h>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*! \brief Postprocessor that rejects the candidates whose innermost loops spill vector registers */
+class VerifyRegisterPressureNode : public PostprocNode {
+ public:
+  /*! \brief The number of vector registers, or -1 to infer it from the target. */
+  int max_registers = -1;
+  /*! \brief The width of a vector register in bits, or -1 to infer it from the target. */
+  int vector_bits = -1;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("max_registers", &max_registers);
+    v->Visit("vector_bits", &vector_bits);
+  }
+
+  void InitializeWithTuneContext(const TuneContext& context) final {
+    ICHECK(context->target.defined());
+    Target target = context->target.value();
+    if (target->kind->name != "llvm") {
+      // The value of 0 will disable the verification.
+      this->max_registers_ = 0;
+      return;
+    }
+    auto f_has_isa = [&target](const char* func_name) -> bool {
+      Optional<String> mcpu = target->GetAttr<String>("mcpu");
+      const runtime::PackedFunc* f = runtime::Registry::Get(func_name);
+      return mcpu.defined() && f != nullptr && static_cast<bool>((*f)(mcpu.value()));
+    };
+    String mtriple = target->GetAttr<String>("mtriple").value_or("");
+    int num_registers = 16;
+    int num_bits = 128;
+    if (f_has_isa("tvm.target.x86.target_has_avx512")) {
+      num_registers = 32;
+      num_bits = 512;
+    } else if (f_has_isa("tvm.target.x86.target_has_avx2")) {
+      num_bits = 256;
+    } else if (std::string(mtriple).find("aarch64") != std::string::npos) {
+      num_registers = 32;
+    }
+    this->max_registers_ = max_registers > 0 ? max_registers : num_registers;
+    this->vector_bits_ = vector_bits > 0 ? vector_bits : num_bits;
+  }
+
+  bool Apply(const tir::Schedule& sch) final {
+    if (max_registers_ <= 0) {
+      return true;
+    }
+    for (const auto& kv : sch->mod()->functions) {
+      const GlobalVar& g_var = kv.first;
+      const BaseFunc& base_func = kv.second;
+      if (const auto* prim_func = base_func.as<tir::PrimFuncNode>()) {
+        IRModule lowered{nullptr};
+        try {
+          auto pass_list = Array<tvm::transform::Pass>();
+          pass_list.push_back(tir::transform::LowerInitBlock());
+          pass_list.push_back(tir::transform::PlanAndUpdateBufferAllocationLocation());
+          pass_list.push_back(tir::transform::ConvertBlocksToOpaque());
+          pass_list.push_back(tir::transform::CompactBufferAllocation());
+          pass_list.push_back(tir::transform::LowerMatchBuffer());
+          pass_list.push_back(tir::transform::LowerOpaqueBlock());
+          pass_list.push_back(tir::transform::FlattenBuffer());
+          pass_list.push_back(tir::transform::Simplify());
+          pass_list.push_back(tir::transform::VectorizeLoop(true));
+          pass_list.push_back(tir::transform::UnrollLoop());
+          // Fold the indices of the unrolled copies, so that the same location is one value.
+          pass_list.push_back(tir::transform::Simplify());
+          tir::PrimFunc f = WithAttr(GetRef<tir::PrimFunc>(prim_func), "global_symbol",
+                                     runtime::String(g_var->name_hint));
+          IRModule mod = IRModule(Map<GlobalVar, BaseFunc>({{GlobalVar(g_var->name_hint), f}}));
+          lowered = tvm::transform::Sequential(pass_list)(std::move(mod));
+        } catch (const dmlc::Error& e) {
+          return false;
+        }
+        for (const auto& lowered_kv : lowered->functions) {
+          if (const auto* lowered_func = lowered_kv.second.as<tir::PrimFuncNode>()) {
+            if (tir::EstimateRegisterPressure(lowered_func->body, vector_bits_) > max_registers_) {
+              return false;
+            }
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+  Postproc Clone() const {
+    ObjectPtr<VerifyRegisterPressureNode> n = make_object<VerifyRegisterPressureNode>(*this);
+    return Postproc(n);
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.VerifyRegisterPressure";
+  TVM_DECLARE_FINAL_OBJECT_INFO(VerifyRegisterPressureNode, PostprocNode);
+
+ private:
+  /*! \brief The number of vector registers of the target. */
+  int max_registers_ = 0;
+  /*! \brief The width of a vector register of the target in bits. */
+  int vector_bits_ = 128;
+};
+
+Postproc Postproc::VerifyRegisterPressure(int max_registers, int vector_bits) {
+  ObjectPtr<VerifyRegisterPressureNode> n = make_object<VerifyRegisterPressureNode>();
+  n->max_registers = max_registers;
+  n->vector_bits = vector_bits;
+  return Postproc(n);
+}
+
+TVM_REGISTER_NODE_TYPE(VerifyRegisterPressureNode);
+TVM_REGISTER_GLOBAL("meta_schedule.PostprocVerifyRegisterPressure")
+    .set_body_typed(Postproc::VerifyRegisterPressure);
+
+}  // namespace meta_schedule
+}  // namespace tvm
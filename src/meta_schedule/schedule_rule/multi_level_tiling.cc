@@ -197,6 +197,23 @@ std::pair<Array<tir::ExprRV>, Array<tir::LoopRV>> MultiLevelTilingNode::SplitLoo
   return {factors, splits};
 }
 
+Array<tir::LoopRV> MultiLevelTilingNode::RasterizeBlockTiles(
+    const Schedule& sch, const Array<tir::LoopRV>& loops) const {
+  // Blocks running at the same time then share the tiles of the rows and of the columns they
+  // read, instead of sweeping a whole row of the output and thrashing the L2 cache.
+  int n = loops.size();
+  Array<FloatImm> probs(raster_group_sizes.size(),
+                        FloatImm(DataType::Float(64), 1.0 / raster_group_sizes.size()));
+  tir::ExprRV group_size = sch->SampleCategorical(raster_group_sizes, probs);
+  Array<LoopRV> rows = sch->Split(loops[n - 2], {NullOpt, group_size});
+  Array<LoopRV> ordered{loops.begin(), loops.end() - 2};
+  ordered.push_back(rows[0]);
+  ordered.push_back(loops[n - 1]);
+  ordered.push_back(rows[1]);
+  sch->Reorder({rows[0], loops[n - 1], rows[1]});
+  return ordered;
+}
+
 std::vector<State> MultiLevelTilingNode::TileLoopNest(State state) const {
   Schedule& sch = state->sch;
   const BlockRV& block_rv = state->block_rv;
@@ -249,6 +266,10 @@ std::vector<State> MultiLevelTilingNode::TileLoopNest(State state) const {
   // Step 4. Bind the tiles to threads
   int n_binds = std::min(tile_binds.size(), tiles.size());
   for (int i = 0; i < n_binds; ++i) {
+    if (i == 0 && !raster_group_sizes.empty() && tiles[i].size() >= 2 &&
+        support::StartsWith(tile_binds[i], "blockIdx")) {
+      tiles[i] = RasterizeBlockTiles(sch, tiles[i]);
+    }
     LoopRV fused = sch->Fuse(tiles[i]);
     sch->Bind(fused, tile_binds[i]);
     tiles[i] = {fused};
@@ -173,6 +173,16 @@ class MultiLevelTilingNode : public ScheduleRuleNode {
   // Annotate a block to use cooperative fetching
   void AnnotateCooperativeFetching(tir::Schedule* sch, const tir::BlockRV& block) const;
 
+  /*!
+   * \brief Reorder the outermost tiles, which are fused and bound to the thread blocks, so that
+   * the blocks are launched in groups of rows, going down a column within each group.
+   * \param sch The schedule.
+   * \param loops The outermost spatial tiles, at least two.
+   * \return The tiles to be fused, in order.
+   */
+  Array<tir::LoopRV> RasterizeBlockTiles(const tir::Schedule& sch,
+                                         const Array<tir::LoopRV>& loops) const;
+
  public:
   /*!
    * \brief The tiling structure. Recommended:
@@ -200,6 +210,11 @@ class MultiLevelTilingNode : public ScheduleRuleNode {
   int max_threads_per_block_;
   /*! \brief All available async pipeline stages. */
   std::vector<int> stages;
+  /*!
+   * \brief The candidate numbers of rows of tiles in a group of the thread block raster order,
+   * empty to launch the thread blocks in row-major order.
+   */
+  Array<Integer> raster_group_sizes;
   /*! \brief The logging function */
   PackedFunc logger;
   /*! \brief The function to overwrite the default condition for applying MultiLevelTiling. */
@@ -209,6 +224,7 @@ class MultiLevelTilingNode : public ScheduleRuleNode {
     v->Visit("structure", &structure);
     v->Visit("tile_binds", &tile_binds);
     v->Visit("max_innermost_factor", &max_innermost_factor);
+    v->Visit("raster_group_sizes", &raster_group_sizes);
     // `vector_load_lens` is not visited
     // `reuse_read_` is not visited
     // `reuse_write_` is not visited
@@ -39,6 +39,13 @@ struct TensorCoreIntrinGroup {
   String load_b_intrin;
   String compute_intrin;
   String store_intrin;
+  String mapping_intrin;
+  /*!
+   * \brief Whether the accumulator is in the warp scope (mma.sync), where the layout of the
+   * elements among the threads of the warp is known, so that the results are stored by the threads
+   * holding them, and the epilogues are computed on the accumulator in registers.
+   */
+  bool is_mma = false;
 
   /*! \brief Create TensorCoreIntrinGroup from config in a map. The map should contains the
    * following keys:
@@ -48,7 +55,10 @@ struct TensorCoreIntrinGroup {
    *  - compute
    *  - store
    * The values of the keys should be the names of the corresponding intrinsics and should be
-   * registered via TensorIntrin.Register beforehand.
+   * registered via TensorIntrin.Register beforehand. The optional key `mapping` names the intrinsic
+   * whose description is used to map the workload to `compute`, when the description of `compute`
+   * accesses its operands through a thread layout. The store intrinsic is not used for
+   * accumulators in the warp scope.
    */
   static TensorCoreIntrinGroup FromConfig(const Map<String, String>& config);
 };
@@ -66,9 +76,39 @@ TensorCoreIntrinGroup TensorCoreIntrinGroup::FromConfig(const Map<String, String
   f_initialize_intrin("load_b", &intrin_group.load_b_intrin);
   f_initialize_intrin("compute", &intrin_group.compute_intrin);
   f_initialize_intrin("store", &intrin_group.store_intrin);
+  if (config.count("mapping")) {
+    f_initialize_intrin("mapping", &intrin_group.mapping_intrin);
+  } else {
+    intrin_group.mapping_intrin = intrin_group.compute_intrin;
+  }
+  const tir::PrimFunc& init_desc = tir::TensorIntrin::Get(intrin_group.init_intrin).value()->desc;
+  for (const auto& kv : init_desc->buffer_map) {
+    intrin_group.is_mma |= kv.second.scope() == "warp";
+  }
   return intrin_group;
 }
 
+/*!
+ * \brief The layout of the 16x16 tiles of an operand of mma.sync in the warp scope, i.e. of the
+ * last two dimensions of a buffer of `ndim` dimensions, as loaded by ldmatrix. The element (i, j)
+ * of a tile is held by the thread 4 * (i % 8) + (j % 8) / 2, at the local index
+ * 4 * (j / 8) + 2 * (i / 8) + j % 2. See shared_16x16_to_ldmatrix_32x8_layout in Python.
+ */
+tir::IndexMap WarpLayout16x16(int ndim) {
+  ICHECK_GE(ndim, 2);
+  return tir::IndexMap::FromFunc(ndim, [ndim](const Array<tir::Var>& indices) {
+    Array<PrimExpr> result{indices.begin(), indices.end() - 2};
+    PrimExpr i = indices[ndim - 2];
+    PrimExpr j = indices[ndim - 1];
+    result.push_back(floordiv(i, 16));
+    result.push_back(floordiv(j, 16));
+    result.push_back(4 * floormod(i, 8) + floordiv(floormod(j, 8), 2));
+    result.push_back(4 * floordiv(floormod(j, 16), 8) + 2 * floordiv(floormod(i, 16), 8) +
+                     floormod(j, 2));
+    return result;
+  });
+}
+
 class TensorCoreStateNode : public StateNode {
  public:
   /*! \brief The tensor core intrinsic group. */
@@ -132,6 +172,8 @@ class MultiLevelTilingTensorCoreNode : public MultiLevelTilingNode {
   inline std::vector<State> AddReadReuseTensorCore(TensorCoreState state) const;
   // Subrule: Add tensorized store
   inline std::vector<State> AddWriteReuseTensorCore(TensorCoreState state) const;
+  // Subrule: Store the accumulator in the warp scope by the threads holding it
+  inline std::vector<State> AddWriteBackFromWarp(TensorCoreState state) const;
   // Subrule: Add software pipeline
   inline std::vector<State> AddSoftwarePipeline(TensorCoreState state) const;
 
@@ -188,7 +230,7 @@ Array<Schedule> MultiLevelTilingTensorCoreNode::Apply(const Schedule& sch,
     TensorCoreIntrinGroup intrin_group = intrin_groups[i];
     Optional<tir::AutoTensorizeMappingInfo> mapping_info = tir::GetAutoTensorizeMappingInfo(
         sch->state(), sch->GetSRef(block_rv),
-        tir::TensorIntrin::Get(intrin_groups[i].compute_intrin).value()->desc);
+        tir::TensorIntrin::Get(intrin_groups[i].mapping_intrin).value()->desc);
     if (mapping_info.defined()) {
       intrin_group_to_mapping_info.emplace(i, mapping_info.value());
     }
@@ -232,7 +274,13 @@ std::vector<State> MultiLevelTilingTensorCoreNode::ApplySubRules(std::vector<Sta
   states = SubRule(std::move(states), [&](State state) {
     return TransformIntermediateOutputLayout(Downcast<TensorCoreState>(state));
   });
-  states = SubRule(std::move(states), [&](State state) { return AddWriteReuse(state); });
+  states = SubRule(std::move(states), [&](State state) {
+    if (Downcast<TensorCoreState>(state)->intrin_group.is_mma) {
+      // The accumulator in the warp scope is stored to the output without a shared memory stage.
+      return std::vector<State>{state};
+    }
+    return AddWriteReuse(state);
+  });
   states = SubRule(std::move(states), [&](State state) {
     return AddWriteReuseTensorCore(Downcast<TensorCoreState>(state));
   });
@@ -263,6 +311,10 @@ std::vector<State> MultiLevelTilingTensorCoreNode::TransformIntermediateOutputLa
   // the index of the fragments in each warp, accum_elem_m, accum_elem_n are the index of the
   // elements in each accumulator fragment.
 
+  if (state->intrin_group.is_mma) {
+    // The accumulator in the warp scope has the layout of mma.sync, see AddWriteBackFromWarp.
+    return {state};
+  }
   // Get the shape of the wmma accumulator
   auto [frag_shape_m, frag_shape_n] = [&]() {
     tir::Block intrin_block =
@@ -348,6 +400,9 @@ std::vector<State> MultiLevelTilingTensorCoreNode::TransformIntermediateOutputLa
 
 std::vector<State> MultiLevelTilingTensorCoreNode::AddWriteReuseTensorCore(
     TensorCoreState state) const {
+  if (state->intrin_group.is_mma) {
+    return AddWriteBackFromWarp(std::move(state));
+  }
   // Add the cache write stage for Tensor Core
   Schedule& sch = state->sch;
   auto cache_write = sch->CacheWrite(state->block_rv, 0, "wmma.accumulator");
@@ -414,6 +469,45 @@ std::vector<State> MultiLevelTilingTensorCoreNode::AddWriteReuseTensorCore(
   return {state};
 }
 
+std::vector<State> MultiLevelTilingTensorCoreNode::AddWriteBackFromWarp(
+    TensorCoreState state) const {
+  // The accumulator of mma.sync is distributed among the threads of the warp with a known layout,
+  // so instead of storing it to the shared memory and then to the output, every thread writes the
+  // elements it holds to the output directly:
+  //
+  //   for warp (bound to threadIdx.y):
+  //     for frag_m, frag_n, lane (bound to threadIdx.x), local_n, local_m, elem_n:
+  //       C[m, n] = accum[frag_m, frag_n, lane, 4 * local_n + 2 * local_m + elem_n]
+  //
+  // The write back is not tensorized, so that the elementwise epilogues of the output, e.g. bias,
+  // activation or residual add, are inlined into it by AutoInline later. They are then computed
+  // on the accumulator in registers, and the result is stored to the global memory once.
+  Schedule& sch = state->sch;
+  BlockRV cache_write = sch->CacheWrite(state->block_rv, 0, "warp");
+  int buffer_ndim = static_cast<int>(sch->Get(state->block_rv)->writes[0]->buffer->shape.size());
+  sch->TransformLayout(state->block_rv, 0, tir::BufferIndexType::kWrite,
+                       WarpLayout16x16(buffer_ndim),
+                       /*pad_value=*/NullOpt, /*assume_injective_transform=*/true);
+
+  auto it = std::find(tile_binds.begin(), tile_binds.end(), "threadIdx.y");
+  ICHECK(it != tile_binds.end());
+  int tile_index_warp_id = std::distance(tile_binds.begin(), it);
+  sch->ReverseComputeAt(cache_write, state->tiles[tile_index_warp_id].back(), true);
+  sch->ReverseComputeInline(state->tensor_core_reindex_store);
+
+  // Split the rows and the columns of the fragments following WarpLayout16x16, so that the lane
+  // is the fusion of (i % 8, (j % 8) / 2), and the elements of a thread are visited in order.
+  Array<LoopRV> loops = sch->GetLoops(cache_write);
+  ICHECK_GE(loops.size(), 2);
+  Array<LoopRV> m = sch->Split(loops[loops.size() - 2], {NullOpt, Integer(2), Integer(8)});
+  Array<LoopRV> n = sch->Split(loops.back(), {NullOpt, Integer(2), Integer(4), Integer(2)});
+  sch->Reorder({m[0], n[0], m[2], n[2], n[1], m[1], n[3]});
+  LoopRV lane = sch->Fuse({m[2], n[2]});
+  sch->Bind(lane, "threadIdx.x");
+  sch->Vectorize(n[3]);
+  return {state};
+}
+
 std::vector<State> MultiLevelTilingTensorCoreNode::AddReadReuseTensorCore(
     TensorCoreState state) const {
   const Array<LoopRV>& r_tiles = state->tiles[r_indices_[1]];
@@ -423,11 +517,19 @@ std::vector<State> MultiLevelTilingTensorCoreNode::AddReadReuseTensorCore(
   auto f_tensorize_load = [&](int read_index, String scope, String intrin_name) {
     auto cache_read = sch->CacheRead(state->block_rv, read_index, scope);
     state->sch->ComputeAt(cache_read, r_tiles.back(), true);
+    if (state->intrin_group.is_mma) {
+      int buffer_ndim =
+          static_cast<int>(sch->Get(cache_read)->writes[0]->buffer->shape.size());
+      sch->TransformLayout(cache_read, 0, tir::BufferIndexType::kWrite,
+                           WarpLayout16x16(buffer_ndim),
+                           /*pad_value=*/NullOpt, /*assume_injective_transform=*/true);
+    }
     TileAndAnnotateTensorize(&sch, cache_read, intrin_name);
   };
 
-  f_tensorize_load(0, "wmma.matrix_a", state->intrin_group.load_a_intrin);
-  f_tensorize_load(1, "wmma.matrix_b", state->intrin_group.load_b_intrin);
+  bool is_mma = state->intrin_group.is_mma;
+  f_tensorize_load(0, is_mma ? "warp" : "wmma.matrix_a", state->intrin_group.load_a_intrin);
+  f_tensorize_load(1, is_mma ? "warp" : "wmma.matrix_b", state->intrin_group.load_b_intrin);
   sch->ComputeInline(state->tensor_core_reindex_A);
   sch->ComputeInline(state->tensor_core_reindex_B);
 
@@ -683,7 +785,7 @@ inline std::vector<State> MultiLevelTilingTensorCoreNode::TransformForTensorizat
     TensorCoreState state) const {
   // Do reindex and layout transformations.
   Optional<LoopRV> transformed_loop_rv =
-      TransformWithTensorIntrin(state.operator->(), state->intrin_group.compute_intrin);
+      TransformWithTensorIntrin(state.operator->(), state->intrin_group.mapping_intrin);
   if (!transformed_loop_rv.defined()) {
     // The workload can't be tensorized.
     return {};
@@ -705,7 +807,7 @@ ScheduleRule ScheduleRule::MultiLevelTilingTensorCore(
     Array<Map<String, String>> intrin_groups, String structure, Optional<Array<String>> tile_binds,
     Optional<Integer> max_innermost_factor, Optional<Array<Integer>> vector_load_lens,
     Optional<Map<String, ObjectRef>> reuse_read, Optional<Map<String, ObjectRef>> reuse_write,
-    bool use_software_pipeline) {
+    bool use_software_pipeline, Optional<Array<Integer>> raster_group_sizes) {
   if (tile_binds.defined()) {
     for (const String& tile_bind : tile_binds.value()) {
       CHECK_NE(tile_bind, "threadIdx.x") << "Cannot bind to threadIdx.x when using tensor core.";
@@ -714,16 +816,24 @@ ScheduleRule ScheduleRule::MultiLevelTilingTensorCore(
   auto node = MultiLevelTilingInitCommon<MultiLevelTilingTensorCoreNode>(
       structure, tile_binds, max_innermost_factor, vector_load_lens, reuse_read, reuse_write);
 
-  CHECK(node->reuse_write_.req == ReuseType::kMustReuse &&
-        runtime::StorageScope::Create(node->reuse_write_.scope).rank ==
-            runtime::StorageRank::kShared)
-      << "ValueError: Shared memory write reuse must be enabled for MultiLevelTilingTensorCore.";
-
   node->intrin_groups.reserve(intrin_groups.size());
   for (const auto& intrin_group_config : intrin_groups) {
     node->intrin_groups.emplace_back(TensorCoreIntrinGroup::FromConfig(intrin_group_config));
   }
+  bool all_mma = std::all_of(node->intrin_groups.begin(), node->intrin_groups.end(),
+                             [](const TensorCoreIntrinGroup& group) { return group.is_mma; });
+  CHECK(all_mma || (node->reuse_write_.req == ReuseType::kMustReuse &&
+                    runtime::StorageScope::Create(node->reuse_write_.scope).rank ==
+                        runtime::StorageRank::kShared))
+      << "ValueError: Shared memory write reuse must be enabled for MultiLevelTilingTensorCore.";
   node->use_software_pipeline = use_software_pipeline;
+  if (raster_group_sizes.defined()) {
+    for (const Integer& group_size : raster_group_sizes.value()) {
+      CHECK_GT(group_size->value, 0)
+          << "ValueError: The raster group sizes must be positive, but got: " << group_size;
+    }
+    node->raster_group_sizes = raster_group_sizes.value();
+  }
   return ScheduleRule(node);
 }
 
@@ -0,0 +1,217 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief The location in the consumer where a producer is fused by the rule Rolling-Buffer-Fusion
+ */
+struct FusionLocation {
+  /*! \brief The index of the loop of the consumer to compute the producer at */
+  int loop_index = -1;
+  /*! \brief Whether the windows of the consumer overlap along the loop, i.e. it needs rolling */
+  bool rolling = false;
+};
+
+class RollingBufferFusionNode : public ScheduleRuleNode {
+ public:
+  // Inherited from ScheduleRuleNode
+  void InitializeWithTuneContext(const TuneContext& context) final {}
+
+  // Inherited from ScheduleRuleNode
+  Array<tir::Schedule> Apply(const tir::Schedule& sch, const tir::BlockRV& block_rv) final {
+    Optional<tir::BlockRV> consumer_rv = GetFusibleConsumer(sch, block_rv);
+    if (!consumer_rv.defined()) {
+      return {sch};
+    }
+    FusionLocation location = FindFusionLocation(sch, block_rv, consumer_rv.value());
+    if (location.loop_index < 0) {
+      return {sch};
+    }
+    // The unfused schedule is kept as a candidate, because the fusion does not pay off when the
+    // intermediate tensor fits in the cache anyway.
+    tir::Schedule fused = sch->Copy();
+    fused->Seed(sch->ForkSeed());
+    try {
+      tir::LoopRV loop_rv = fused->GetLoops(consumer_rv.value())[location.loop_index];
+      fused->ComputeAt(block_rv, loop_rv, /*preserve_unit_loops=*/true);
+      if (location.rolling) {
+        fused->RollingBuffer(block_rv, /*write_buffer_index=*/0);
+        fused->Annotate(loop_rv, tir::attr::meta_schedule_rolling_buffer, Integer(1));
+      }
+    } catch (const tvm::runtime::Error& e) {
+      return {sch};
+    }
+    return {sch, fused};
+  }
+
+  // Inherited from ScheduleRuleNode
+  ScheduleRule Clone() const final {
+    ObjectPtr<RollingBufferFusionNode> n = make_object<RollingBufferFusionNode>(*this);
+    return ScheduleRule(n);
+  }
+
+ private:
+  /*!
+   * \brief Get the consumer the block can be fused into
+   * \param sch The TIR schedule
+   * \param block_rv The producer block
+   * \return The only consumer of the block if it is a reduction block, e.g. a convolution, and
+   * both blocks are the direct children of the root block, NullOpt otherwise
+   */
+  Optional<tir::BlockRV> GetFusibleConsumer(const tir::Schedule& sch,
+                                            const tir::BlockRV& block_rv) const {
+    tir::StmtSRef block_sref = sch->GetSRef(block_rv);
+    const tir::BlockNode* block = TVM_SREF_TO_BLOCK(block_sref);
+    // Cond 1. The block is not the root block, and is the direct child of the root block.
+    if (block_sref->parent == nullptr) {
+      return NullOpt;
+    }
+    tir::StmtSRef scope_sref = tir::GetScopeRoot(sch->state(), block_sref,
+                                                 /*require_stage_pipeline=*/false);
+    if (scope_sref->parent != nullptr) {
+      return NullOpt;
+    }
+    // Cond 2. The block writes one intermediate buffer, and its outermost loop has only one child
+    // block.
+    if (block->writes.size() != 1 || tir::IsOutputBlock(sch->state(), block_sref, scope_sref)) {
+      return NullOpt;
+    }
+    Array<tir::StmtSRef> loop_srefs = tir::GetLoops(block_sref);
+    if (loop_srefs.empty() ||
+        tir::GetChildBlockSRefOnSRefTree(sch->state(), loop_srefs[0]).size() > 1) {
+      return NullOpt;
+    }
+    // Cond 3. The block has only one consumer, which is a reduction block under the root block.
+    Array<tir::BlockRV> consumers = sch->GetConsumers(block_rv);
+    if (consumers.size() != 1) {
+      return NullOpt;
+    }
+    tir::StmtSRef consumer_sref = sch->GetSRef(consumers[0]);
+    if (tir::IsSpatial(consumer_sref) ||
+        !tir::GetScopeRoot(sch->state(), consumer_sref, /*require_stage_pipeline=*/false)
+             .same_as(scope_sref)) {
+      return NullOpt;
+    }
+    return consumers[0];
+  }
+
+  /*!
+   * \brief Find the loop of the consumer to compute the producer at. The loops above it must all
+   * move the region of the intermediate buffer the consumer reads, so that the producer is not
+   * recomputed. If the consumer reads the buffer through sliding windows, e.g. a convolution
+   * with a kernel larger than its stride, it is the outermost loop that slides the windows, and
+   * the producer keeps only the lines of the intermediate buffer the window of one iteration
+   * covers, i.e. (tile - 1) * stride + kernel of them, in a rolling buffer. Otherwise it is the
+   * innermost of such loops, and the producer keeps one tile.
+   */
+  FusionLocation FindFusionLocation(const tir::Schedule& sch, const tir::BlockRV& block_rv,
+                                    const tir::BlockRV& consumer_rv) const {
+    FusionLocation location;
+    const tir::Buffer& buffer = sch->Get(block_rv)->writes[0]->buffer;
+    tir::StmtSRef consumer_sref = sch->GetSRef(consumer_rv);
+    const tir::BlockRealize& realize = tir::GetBlockRealize(sch->state(), consumer_sref);
+    const tir::BlockNode* consumer = realize->block.get();
+    // Step 1. Find the region of the buffer read by the consumer.
+    Optional<tir::BufferRegion> read_region = NullOpt;
+    for (const tir::BufferRegion& region : consumer->reads) {
+      if (region->buffer.same_as(buffer)) {
+        if (read_region.defined()) {
+          return location;
+        }
+        read_region = region;
+      }
+    }
+    if (!read_region.defined()) {
+      return location;
+    }
+    // Step 2. Find the dimensions indexed by sliding windows, i.e. by both a spatial and a
+    // reduction iter var of the consumer, e.g. `h * stride + rh`.
+    std::unordered_set<const tir::VarNode*> spatial_vars;
+    std::unordered_set<const tir::VarNode*> reduction_vars;
+    for (const tir::IterVar& iter_var : consumer->iter_vars) {
+      if (iter_var->iter_type == tir::IterVarType::kDataPar) {
+        spatial_vars.insert(iter_var->var.get());
+      } else if (iter_var->iter_type == tir::IterVarType::kCommReduce) {
+        reduction_vars.insert(iter_var->var.get());
+      }
+    }
+    Map<tir::Var, PrimExpr> bindings = tir::GetBindings(realize);
+    std::vector<PrimExpr> indices;
+    std::vector<bool> is_window;
+    for (const Range& range : read_region.value()->region) {
+      auto f_uses = [&range](const std::unordered_set<const tir::VarNode*>& vars) {
+        return tir::UsesVar(range->min, [&vars](const tir::VarNode* var) {
+          return vars.count(var) != 0;
+        });
+      };
+      indices.push_back(tir::Substitute(range->min, bindings));
+      is_window.push_back(f_uses(spatial_vars) && f_uses(reduction_vars));
+    }
+    // Step 3. Walk the spatial loops of the consumer from outside in.
+    Array<tir::StmtSRef> loop_srefs = tir::GetLoops(consumer_sref);
+    for (int i = 0, n = loop_srefs.size(); i < n; ++i) {
+      const tir::ForNode* loop = TVM_SREF_TO_FOR(loop_srefs[i]);
+      if (tir::GetLoopIterType(loop_srefs[i]) != tir::IterVarType::kDataPar) {
+        break;
+      }
+      if (tir::is_one(loop->extent)) {
+        // A unit loop runs once, so the producer computed below it is not recomputed.
+        continue;
+      }
+      bool moves_region = false;
+      bool slides_window = false;
+      for (int j = 0, ndim = indices.size(); j < ndim; ++j) {
+        if (tir::UsesVar(indices[j],
+                         [loop](const tir::VarNode* var) { return var == loop->loop_var.get(); })) {
+          moves_region = true;
+          slides_window |= is_window[j];
+        }
+      }
+      if (slides_window) {
+        location.loop_index = i;
+        location.rolling = true;
+        break;
+      }
+      if (!moves_region) {
+        break;
+      }
+      location.loop_index = i;
+    }
+    return location;
+  }
+
+ public:
+  void VisitAttrs(tvm::AttrVisitor* v) {}
+
+  static constexpr const char* _type_key = "meta_schedule.RollingBufferFusion";
+  TVM_DECLARE_FINAL_OBJECT_INFO(RollingBufferFusionNode, ScheduleRuleNode);
+};
+
+ScheduleRule ScheduleRule::RollingBufferFusion() {
+  return ScheduleRule(make_object<RollingBufferFusionNode>());
+}
+
+TVM_REGISTER_NODE_TYPE(RollingBufferFusionNode);
+TVM_REGISTER_GLOBAL("meta_schedule.ScheduleRuleRollingBufferFusion")
+    .set_body_typed(ScheduleRule::RollingBufferFusion);
+}  // namespace meta_schedule
+}  // namespace tvm
@@ -85,12 +85,35 @@ Array<ScheduleRule> ScheduleRule::DefaultLLVM() {
   };
 }
 
+Array<ScheduleRule> GetX86AMXSpecificRules() {
+  // The K-blocked intrinsics come first, so that the smaller ones only tile the workloads whose
+  // reduction is too short for them
+  Array<ScheduleRule> rules;
+  for (const char* intrin_name :
+       {"dot_16x16x256_u8i8i32_amx", "dot_16x16x64_u8i8i32_amx", "dot_16x16x128_bf16bf16f32_amx",
+        "dot_16x16x32_bf16bf16f32_amx", "dot_32x1_avx512fp16"}) {
+    rules.push_back(ScheduleRule::MultiLevelTilingWithIntrin(
+        /*intrin_name=*/String(intrin_name),
+        /*structure=*/"SSRSRS",
+        /*tile_binds=*/NullOpt,
+        /*max_innermost_factor=*/Integer(64),
+        /*vector_load_lens=*/NullOpt,
+        /*reuse_read=*/NullOpt,
+        /*reuse_write=*/
+        Map<String, ObjectRef>{{"req", String("may")},
+                               {"levels", Array<Integer>{1, 2}},
+                               {"scope", String("global")}}));
+  }
+  return rules;
+}
+
 Array<ScheduleRule> ScheduleRule::DefaultX86(const String& type) {
+  // Besides the AMX intrinsics, AMX targets use VNNI for the workloads AMX cannot tile
   static const Map<String, String> intrins = {{"vnni", "dot_16x4_vnni"},
-                                              {"avx512", "dot_16x4_avx512"}};
-  return {
-      ScheduleRule::ApplyCustomRule(),
-      ScheduleRule::InlineConstantScalars(),
+                                              {"avx512", "dot_16x4_avx512"},
+                                              {"amx", "dot_16x4_vnni"}};
+  return Array<ScheduleRule>::Agregate(
+      ScheduleRule::ApplyCustomRule(), ScheduleRule::InlineConstantScalars(),
       ScheduleRule::AutoInline(
           /*into_producer=*/false,
           /*into_consumer=*/true,
@@ -102,6 +125,7 @@ Array<ScheduleRule> ScheduleRule::DefaultX86(const String& type) {
       ScheduleRule::AddRFactor(
           /*max_jobs_per_core=*/16,
           /*max_innermost_factor=*/Integer(64)),
+      "amx" == type ? GetX86AMXSpecificRules() : Array<ScheduleRule>{},
       ScheduleRule::MultiLevelTilingWithIntrin(
           /*intrin_name=*/intrins[type],
           /*structure=*/"SSRSRS",
@@ -128,8 +152,7 @@ Array<ScheduleRule> ScheduleRule::DefaultX86(const String& type) {
           /*max_vectorize_extent=*/64,
           /*unroll_max_steps=*/Array<Integer>{0, 16, 64, 512},
           /*unroll_explicit=*/true),
-      ScheduleRule::RandomComputeLocation(),
-  };
+      ScheduleRule::RandomComputeLocation());
 }
 
 Array<ScheduleRule> ScheduleRule::DefaultCUDA() {
@@ -234,7 +257,67 @@ Array<ScheduleRule> ScheduleRule::DefaultCUDATensorCore() {
           Map<String, ObjectRef>{{"req", String("must")},
                                  {"levels", Array<Integer>{2}},  //
                                  {"scope", String("shared.dyn")}},
-          /*use_software_pipeline=*/false)  //
+          /*use_software_pipeline=*/false,
+          /*raster_group_sizes=*/NullOpt)  //
+  };
+  Array<ScheduleRule> append = ScheduleRule::DefaultCUDA();
+  results.insert(results.end(), append.begin() + 1, append.end());
+  return results;
+}
+
+Array<ScheduleRule> ScheduleRule::DefaultVulkanCooperativeMatrix() {
+  // The wmma intrinsics are lowered to SPV_NV_cooperative_matrix by the SPIR-V codegen, which
+  // has no dynamic shared memory.
+  Array<Map<String, String>> intrin_groups = {
+      // Cooperative matrices f32 += f16 * f16
+      {
+          {"init", "wmma_fill_16x16x16_f32"},
+          {"load_a", "wmma_load_16x16x16_f16_a_shared"},
+          {"load_b", "wmma_load_16x16x16_f16_b_shared"},
+          {"compute", "wmma_sync_16x16x16_f16f16f32"},
+          {"store", "wmma_store_16x16x16_f32_shared"},
+      },
+      {
+          {"init", "wmma_fill_16x16x16_f32"},
+          {"load_a", "wmma_load_16x16x16_f16_a_shared"},
+          {"load_b", "wmma_load_16x16x16_f16_b_trans_shared"},
+          {"compute", "wmma_sync_16x16x16_f16f16f32_trans"},
+          {"store", "wmma_store_16x16x16_f32_shared"},
+      },
+      // Cooperative matrices f16 += f16 * f16
+      {
+          {"init", "wmma_fill_16x16x16_f16"},
+          {"load_a", "wmma_load_16x16x16_f16_a_shared"},
+          {"load_b", "wmma_load_16x16x16_f16_b_shared"},
+          {"compute", "wmma_sync_16x16x16_f16f16f16"},
+          {"store", "wmma_store_16x16x16_f16_shared"},
+      },
+      {
+          {"init", "wmma_fill_16x16x16_f16"},
+          {"load_a", "wmma_load_16x16x16_f16_a_shared"},
+          {"load_b", "wmma_load_16x16x16_f16_b_trans_shared"},
+          {"compute", "wmma_sync_16x16x16_f16f16f16_trans"},
+          {"store", "wmma_store_16x16x16_f16_shared"},
+      },
+  };
+  Array<ScheduleRule> results{
+      ScheduleRule::ApplyCustomRule(),
+      ScheduleRule::MultiLevelTilingTensorCore(
+          /*intrin_groups=*/intrin_groups,
+          /*structure=*/"SSSRRSRS",
+          /*tile_binds=*/Array<String>{"blockIdx.y", "blockIdx.x", "threadIdx.y"},
+          /*max_innermost_factor=*/Integer(4),
+          /*vector_load_lens=*/Array<Integer>{1, 2, 3, 4, 8, 16},
+          /*reuse_read=*/
+          Map<String, ObjectRef>{{"req", String("must")},
+                                 {"levels", Array<Integer>{4}},  //
+                                 {"scope", String("shared")}},
+          /*reuse_write=*/
+          Map<String, ObjectRef>{{"req", String("must")},
+                                 {"levels", Array<Integer>{2}},  //
+                                 {"scope", String("shared")}},
+          /*use_software_pipeline=*/false,
+          /*raster_group_sizes=*/NullOpt)  //
   };
   Array<ScheduleRule> append = ScheduleRule::DefaultCUDA();
   results.insert(results.end(), append.begin() + 1, append.end());
@@ -409,6 +492,10 @@ TVM_REGISTER_GLOBAL("meta_schedule.ScheduleRuleDefaultCUDA")
     .set_body_typed(ScheduleRule::DefaultCUDA);
 TVM_REGISTER_GLOBAL("meta_schedule.ScheduleRuleDefaultCUDATensorCore")
     .set_body_typed(ScheduleRule::DefaultCUDATensorCore);
+TVM_REGISTER_GLOBAL("meta_schedule.ScheduleRuleDefaultVulkanCooperativeMatrix")
+    .set_body_typed(ScheduleRule::DefaultVulkanCooperativeMatrix);
+TVM_REGISTER_GLOBAL("meta_schedule.ScheduleRuleDefaultX86")
+    .set_body_typed(ScheduleRule::DefaultX86);
 TVM_REGISTER_GLOBAL("meta_schedule.ScheduleRuleDefaultHexagon")
     .set_body_typed(ScheduleRule::DefaultHexagon);
 TVM_REGISTER_GLOBAL("meta_schedule.ScheduleRuleDefaultMicro")
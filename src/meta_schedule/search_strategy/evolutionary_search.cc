@@ -18,6 +18,7 @@
  */
 
 #include "../module_equality.h"
+#include "../trace_apply.h"
 #include "../utils.h"
 
 #define TVM_META_SCHEDULE_CHECK_PROB_RANGE(p, name)                               \
@@ -203,8 +204,116 @@ struct ConcurrentBitmask {
   }
 };
 
+/*!
+ * \brief The post-processed schedules of the traces replayed by a search, keyed by the fingerprint
+ * of the trace. It is owned by the state of the search, whose workload, target and postprocessors
+ * do not change, and a trace that failed post-processing is cached as NullOpt. The entries are kept
+ * in two generations, and the older one is dropped when the newer one is full.
+ */
+class TraceApplyCache {
+ public:
+  /*!
+   * \brief Look up a trace.
+   * \param key The key of the trace.
+   * \param result The post-processed schedule, or NullOpt if the post-processing failed.
+   * \return Whether the trace is found.
+   */
+  bool Get(uint64_t key, Optional<Schedule>* result) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = current_.find(key);
+    if (it != current_.end()) {
+      *result = it->second;
+      return true;
+    }
+    it = previous_.find(key);
+    if (it == previous_.end()) {
+      return false;
+    }
+    *result = it->second;
+    PutLocked(key, it->second);
+    return true;
+  }
+
+  /*! \brief Add the result of replaying a trace */
+  void Put(uint64_t key, const Optional<Schedule>& result) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    PutLocked(key, result);
+  }
+
+ private:
+  void PutLocked(uint64_t key, const Optional<Schedule>& result) {
+    if (current_.size() >= kGenerationSize) {
+      previous_ = std::move(current_);
+      current_.clear();
+    }
+    current_[key] = result;
+  }
+
+  /*! \brief The number of entries in a generation */
+  static constexpr size_t kGenerationSize = 8192;
+  /*! \brief The mutex guarding the generations */
+  std::mutex mutex_;
+  /*! \brief The generation entries are added to */
+  std::unordered_map<uint64_t, Optional<Schedule>> current_;
+  /*! \brief The generation before `current_` */
+  std::unordered_map<uint64_t, Optional<Schedule>> previous_;
+};
+
 /**************** Util Functions ****************/
 
+/*!
+ * \brief Compute a fingerprint of the instructions and decisions of a trace, which is cheap
+ * compared to replaying it. The random variables are identified by the order they are defined
+ * in, so that the traces with the same fingerprint replay to the same schedule.
+ * \param trace The trace.
+ * \param fingerprint The fingerprint.
+ * \return Whether the fingerprint is computed, which fails if the trace refers to an object that
+ * cannot be hashed structurally.
+ */
+bool TraceFingerprint(const tir::Trace& trace, uint64_t* fingerprint) {
+  std::unordered_map<const Object*, int64_t> rv_index;
+  bool hashable = true;
+  std::function<uint64_t(const ObjectRef&)> f_hash = [&](const ObjectRef& obj) -> uint64_t {
+    if (!obj.defined()) {
+      return 0;
+    }
+    auto it = rv_index.find(obj.get());
+    if (it != rv_index.end()) {
+      return support::HashCombine(1, it->second);
+    }
+    if (const auto* arr = obj.as<ArrayNode>()) {
+      uint64_t result = 2;
+      for (const ObjectRef& elem : *arr) {
+        result = support::HashCombine(result, f_hash(elem));
+      }
+      return result;
+    }
+    if (obj->IsInstance<PrimExprNode>() || obj->IsInstance<StringObj>() ||
+        obj->IsInstance<tir::IndexMapNode>()) {
+      return StructuralHash()(obj);
+    }
+    // Hashing by address may collide with a freed object whose address is reused
+    hashable = false;
+    return 0;
+  };
+  uint64_t result = 0;
+  for (const tir::Instruction& inst : trace->insts) {
+    if (inst->kind->IsPostproc()) {
+      // Consistent with `ThreadedTraceApply`, which replays the trace without post-processing
+      break;
+    }
+    result = support::HashCombine(result, std::hash<std::string>()(inst->kind->name));
+    result = support::HashCombine(result, f_hash(inst->inputs));
+    result = support::HashCombine(result, f_hash(inst->attrs));
+    result = support::HashCombine(result, f_hash(trace->GetDecision(inst)));
+    for (const ObjectRef& output : inst->outputs) {
+      rv_index.emplace(output.get(), rv_index.size());
+    }
+  }
+  *fingerprint = result;
+  return hashable;
+}
+
 /*!
  * \brief Assemble measure candidates from the given candidate traces.
  * \param traces The picked candidate traces.
@@ -263,8 +372,8 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     /*! \brief Pre thread data including module to be tuned and random state. */
     std::vector<PerThreadData> per_thread_data_;
     /*!
-     * \brief The workloads that are already measured.
-     * TODO(junrushao1994): add records from the database to avoid re-measuring.
+     * \brief The workloads that are already measured, including the ones picked from the
+     * database, which may have been measured by other tuning processes sharing it.
      * */
     IRModuleSet measured_workloads_;
     /*! \brief A Database for selecting useful candidates. */
@@ -273,6 +382,10 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     CostModel cost_model_{nullptr};
     /*! \brief The token registered for the given workload in database. */
     Workload token_{nullptr};
+    /*! \brief The post-processed schedules of the mutated traces replayed by this search. */
+    TraceApplyCache trace_cache_;
+    /*! \brief The decisions of the traces sampled by this search that failed post-processing. */
+    InvalidDecisionCache invalid_decisions_;
 
     explicit State(EvolutionarySearchNode* self, int max_trials, int num_trials_per_iter,
                    Array<Schedule> design_space_schedules, Database database, CostModel cost_model)
@@ -305,6 +418,13 @@ class EvolutionarySearchNode : public SearchStrategyNode {
      * \return The picked best candidates.
      */
     inline std::vector<Schedule> PickBestFromDatabase(int num);
+    /*!
+     * \brief Pick up the best candidates of the workload measured on another target, re-applied to
+     * the workload and validated by the postprocessors of this target.
+     * \param num The number of traces to produce.
+     * \return The picked candidates that are not measured yet.
+     */
+    inline std::vector<Schedule> PickBestFromTransferDatabase(int num);
     /*!
      * \brief Sample the initial population from previous measured results and randomly generated
      *  traces via trace replaying.
@@ -367,6 +487,13 @@ class EvolutionarySearchNode : public SearchStrategyNode {
   int init_min_unmeasured;
   /*! \brief The maximum number of failure during initial sampling. */
   int max_fail_count;
+  /*!
+   * \brief The database tuned on another target, whose best candidates of the workload warm-start
+   * the initial population when the database of this target doesn't have enough. With the
+   * anchor-block module equality, it can also be a database this target tuned for another subgraph
+   * with the same anchor block, whose candidates are transferred via ScheduleUsingAnchorTrace.
+   */
+  Optional<Database> transfer_database;
   /*** Configuration: evolution ***/
   /*! \brief The number of iterations performed by generic algorithm. */
   int genetic_num_iters;
@@ -390,6 +517,7 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     v->Visit("init_measured_ratio", &init_measured_ratio);
     v->Visit("init_min_unmeasured", &init_min_unmeasured);
     v->Visit("max_fail_count", &max_fail_count);
+    v->Visit("transfer_database", &transfer_database);
     /*** Configuration: evolution ***/
     v->Visit("genetic_num_iters", &genetic_num_iters);
     v->Visit("genetic_mutate_prob", &genetic_mutate_prob);
@@ -460,6 +588,7 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     n->init_measured_ratio = this->init_measured_ratio;
     n->init_min_unmeasured = this->init_min_unmeasured;
     n->max_fail_count = this->max_fail_count;
+    n->transfer_database = this->transfer_database;
     n->genetic_num_iters = this->genetic_num_iters;
     n->genetic_mutate_prob = this->genetic_mutate_prob;
     n->genetic_max_fail_count = this->genetic_max_fail_count;
@@ -501,9 +630,67 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickBestFromDatabase(int nu
   return results;
 }
 
+std::vector<Schedule> EvolutionarySearchNode::State::PickBestFromTransferDatabase(int num) {
+  auto _ = Profiler::TimedScope("EvoSearch/PickBestFromTransferDatabase");
+  if (num <= 0 || !self->transfer_database.defined()) {
+    return {};
+  }
+  Database transfer_database = self->transfer_database.value();
+  const IRModule& mod = self->ctx_->mod.value();
+  if (!transfer_database->HasWorkload(mod)) {
+    return {};
+  }
+  // The workload exists, so committing it only looks it up
+  Workload workload = transfer_database->CommitWorkload(mod);
+  // With the anchor-block equality, the workload may be another subgraph sharing the anchor block
+  // of this one, e.g. a conv2d fused with other elementwise ops, whose traces are transferred as
+  // anchor traces
+  bool is_anchor_trace = !StructuralEqual()(workload->mod, mod);
+  std::vector<tir::Trace> traces;
+  for (TuningRecord record : transfer_database->GetTopK(workload, num)) {
+    traces.push_back(record->trace);
+  }
+  int actual_num = traces.size();
+  ThreadedTraceApply pp(self->postprocs_);
+  std::vector<Schedule> results(actual_num, Schedule{nullptr});
+  auto f_proc_transferred = [this, &traces, &results, &pp, is_anchor_trace](int thread_id,
+                                                                            int trace_id) -> void {
+    PerThreadData& data = this->per_thread_data_.at(thread_id);
+    tir::Trace trace = traces.at(trace_id);
+    if (is_anchor_trace) {
+      Schedule sch = Schedule::Traced(data.mod, /*seed=*/ForkSeed(&data.rand_state),
+                                      /*debug_mode=*/0,
+                                      /*error_render_level=*/tir::ScheduleErrorRenderLevel::kNone);
+      try {
+        ScheduleUsingAnchorTrace(sch, trace, self->ctx_->target.value());
+      } catch (const std::runtime_error& e) {  // includes tvm::Error and dmlc::Error
+        return;
+      }
+      trace = sch->trace().value();
+    }
+    // Unlike the records of this target, the ones of another target may not pass the
+    // postprocessors here, e.g. when they exceed a hardware limit, and are dropped
+    if (Optional<Schedule> sch = pp.Apply(data.mod, trace, &data.rand_state)) {
+      results.at(trace_id) = sch.value();
+    }
+  };
+  support::parallel_for_dynamic(0, actual_num, self->ctx_->num_threads, f_proc_transferred);
+  std::vector<Schedule> picked;
+  for (const Schedule& sch : results) {
+    if (sch.defined() && !measured_workloads_.Has(sch->mod(), ModuleHash(sch->mod()))) {
+      picked.push_back(sch);
+    }
+  }
+  TVM_PY_LOG(INFO, self->ctx_->logger)
+      << "Transferred " << picked.size() << " of " << actual_num
+      << " candidate(s) from the transfer database:\n"
+      << pp.SummarizeFailures();
+  return picked;
+}
+
 std::vector<Schedule> EvolutionarySearchNode::State::SampleInitPopulation(int num) {
   auto _ = Profiler::TimedScope("EvoSearch/SampleInitPopulation");
-  ThreadedTraceApply pp(self->postprocs_);
+  ThreadedTraceApply pp(self->postprocs_, &this->invalid_decisions_);
   std::vector<Schedule> out_schs;
   int fail_count = 0;
   while (static_cast<int>(out_schs.size()) < self->init_min_unmeasured &&
@@ -575,12 +762,14 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
     }
     {
       auto _ = Profiler::TimedScope("EvoSearch/Evolve/Mutation");
-      ThreadedTraceApply pp(self->postprocs_);
+      ThreadedTraceApply pp(self->postprocs_, &this->invalid_decisions_);
       ConcurrentBitmask cbmask(self->population_size);
+      TraceApplyCache* trace_cache = &this->trace_cache_;
+      std::atomic<int> num_cache_hits{0};
       std::vector<Schedule> next_population(self->population_size, Schedule{nullptr});
       // The worker function
-      auto f_find_candidate = [&cbmask, &population, &next_population, &pp, this](int thread_id,
-                                                                                  int trace_id) {
+      auto f_find_candidate = [&cbmask, &population, &next_population, &pp, trace_cache,
+                               &num_cache_hits, this](int thread_id, int trace_id) {
         // Prepare samplers
         PerThreadData& data = this->per_thread_data_.at(thread_id);
         TRandState* rand_state = &data.rand_state;
@@ -597,7 +786,20 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
             // Decision: mutate
             Mutator mutator = opt_mutator.value();
             if (Optional<tir::Trace> new_trace = mutator->Apply(trace, rand_state)) {
-              if (Optional<Schedule> sch = pp.Apply(mod, new_trace.value(), rand_state)) {
+              // Mutations often reproduce traces replayed before, in this generation or an
+              // earlier one
+              uint64_t key = 0;
+              bool cacheable = TraceFingerprint(new_trace.value(), &key);
+              Optional<Schedule> sch{nullptr};
+              if (cacheable && trace_cache->Get(key, &sch)) {
+                ++num_cache_hits;
+              } else {
+                sch = pp.Apply(mod, new_trace.value(), rand_state);
+                if (cacheable) {
+                  trace_cache->Put(key, sch);
+                }
+              }
+              if (sch.defined()) {
                 // note that sch's trace is different from new_trace
                 // because it contains post-processing information
                 result = sch.value();
@@ -618,8 +820,10 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
                                     f_find_candidate);
 
       population.swap(next_population);
-      TVM_PY_LOG(INFO, self->ctx_->logger) << "Evolve iter #" << iter << " done. Summary:\n"
-                                           << pp.SummarizeFailures();
+      TVM_PY_LOG(INFO, self->ctx_->logger)
+          << "Evolve iter #" << iter << " done. Summary:\n"
+          << pp.SummarizeFailures() << "\nReused " << num_cache_hits.load()
+          << " replayed trace(s)";
     }
   }
   // Return the best states from the heap, sorting from higher score to lower ones
@@ -714,7 +918,17 @@ Optional<Array<MeasureCandidate>> EvolutionarySearchNode::State::GenerateMeasure
   std::vector<Schedule> measured = PickBestFromDatabase(pop * self->init_measured_ratio);
   TVM_PY_LOG(INFO, self->ctx_->logger)
       << "Picked top " << measured.size() << " candidate(s) from database";
-  std::vector<Schedule> unmeasured = SampleInitPopulation(pop - measured.size());
+  for (const Schedule& sch : measured) {
+    IRModule mod = sch->mod();
+    size_t shash = ModuleHash(mod);
+    if (!measured_workloads_.Has(mod, shash)) {
+      measured_workloads_.Add(mod, shash);
+    }
+  }
+  std::vector<Schedule> unmeasured = PickBestFromTransferDatabase(
+      static_cast<int>(pop * self->init_measured_ratio) - static_cast<int>(measured.size()));
+  std::vector<Schedule> sampled = SampleInitPopulation(pop - measured.size() - unmeasured.size());
+  unmeasured.insert(unmeasured.end(), sampled.begin(), sampled.end());
   if (static_cast<int>(unmeasured.size()) < self->init_min_unmeasured) {
     TVM_PY_LOG(WARNING, self->ctx_->logger)
         << "Cannot sample enough initial population, evolutionary search failed.";
@@ -755,7 +969,8 @@ SearchStrategy SearchStrategy::EvolutionarySearch(int population_size,         /
                                                   int genetic_num_iters,       //
                                                   double genetic_mutate_prob,  //
                                                   int genetic_max_fail_count,  //
-                                                  double eps_greedy) {
+                                                  double eps_greedy,           //
+                                                  Optional<Database> transfer_database) {
   TVM_META_SCHEDULE_CHECK_PROB_RANGE(init_measured_ratio, "Initial measured ratio");
   TVM_META_SCHEDULE_CHECK_PROB_RANGE(genetic_mutate_prob, "Mutation probability");
   TVM_META_SCHEDULE_CHECK_PROB_RANGE(eps_greedy, "Greedy pick probability");
@@ -765,6 +980,7 @@ SearchStrategy SearchStrategy::EvolutionarySearch(int population_size,         /
   n->init_measured_ratio = init_measured_ratio;
   n->init_min_unmeasured = init_min_unmeasured;
   n->max_fail_count = max_fail_count;
+  n->transfer_database = transfer_database;
   n->genetic_num_iters = genetic_num_iters;
   n->genetic_max_fail_count = genetic_max_fail_count;
   n->genetic_mutate_prob = genetic_mutate_prob;
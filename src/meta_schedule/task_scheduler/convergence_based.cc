@@ -0,0 +1,231 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief The task scheduler that retires the tasks whose best latency has converged.
+ *
+ * After every round of a task, the relative improvement of its best latency is recorded. A task
+ * is considered converged when the one-sided upper confidence bound of the mean improvement over
+ * the last `window_size` rounds falls below `tolerance`, in which case it's terminated and no
+ * longer consumes the global trial budget. Among the tasks alive, the one with the highest weighted
+ * expected gain, i.e. the latency it is expected to save in the next round, is picked.
+ */
+class ConvergenceBasedNode final : public TaskSchedulerNode {
+ public:
+  /*! \brief The number of recent rounds the convergence is detected over */
+  int window_size;
+  /*! \brief The relative improvement per round below which a task is considered converged */
+  double tolerance;
+  /*! \brief The confidence level of the upper bound on the mean improvement */
+  double confidence;
+  support::LinearCongruentialEngine::TRandState rand_state;
+
+  /*! \brief The z-score of `confidence` under the standard normal distribution */
+  double z_score_;
+  int round_robin_rounds_;
+  std::vector<std::vector<double>> best_latency_history_;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    TaskSchedulerNode::VisitAttrs(v);
+    v->Visit("window_size", &window_size);
+    v->Visit("tolerance", &tolerance);
+    v->Visit("confidence", &confidence);
+    // `rand_state` is not visited.
+    // `z_score_` is not visited.
+    // `round_robin_rounds_` is not visited.
+    // `best_latency_history_` is not visited.
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.ConvergenceBased";
+  TVM_DECLARE_FINAL_OBJECT_INFO(ConvergenceBasedNode, TaskSchedulerNode);
+
+ public:
+  void Tune(Array<TuneContext> tasks, Array<FloatImm> task_weights, int max_trials_global,
+            int max_trials_per_task, int num_trials_per_iter, Builder builder, Runner runner,
+            Array<MeasureCallback> measure_callbacks, Optional<Database> database,
+            Optional<CostModel> cost_model) final {
+    int n_tasks = tasks.size();
+    round_robin_rounds_ = 0;
+    best_latency_history_.assign(n_tasks, std::vector<double>());
+    TaskSchedulerNode::Tune(tasks, task_weights, max_trials_global, max_trials_per_task,
+                            num_trials_per_iter, builder, runner, measure_callbacks, database,
+                            cost_model);
+  }
+
+  int NextTaskId() final {
+    int n_tasks = this->tasks_.size();
+    // Step 1. Check if it's in round robin mode.
+    if (round_robin_rounds_ == 0) {
+      TVM_PY_LOG_CLEAR_SCREEN(this->logger);
+      this->PrintTuningStatistics();
+    }
+    if (round_robin_rounds_ < n_tasks) {
+      return round_robin_rounds_++;
+    }
+    if (round_robin_rounds_ == n_tasks) {
+      for (int i = 0; i < n_tasks; ++i) {
+        if (this->tasks_[i]->runner_futures.defined()) {
+          this->JoinRunningTask(i);
+        }
+      }
+      ++round_robin_rounds_;
+    }
+    // Step 2. Retire the converged tasks, and collect the ones alive
+    std::vector<int> tasks_alive;
+    std::vector<double> gain;
+    tasks_alive.reserve(n_tasks);
+    gain.reserve(n_tasks);
+    for (int i = 0; i < n_tasks; ++i) {
+      this->TouchTask(i);
+      if (this->tasks_[i]->is_terminated) {
+        continue;
+      }
+      double mean = 0.0, upper = 0.0;
+      if (!ImprovementBound(i, &mean, &upper)) {
+        // The best latency is unavailable, which means the task is not valid so far
+        tasks_alive.push_back(i);
+        gain.push_back(-1e9);
+        continue;
+      }
+      int n_rounds = best_latency_history_[i].size();
+      // A task still being measured is not retired, or its pending results would be dropped
+      if (n_rounds > window_size && upper < tolerance &&
+          !this->tasks_[i]->runner_futures.defined()) {
+        TVM_PY_LOG(INFO, this->logger)
+            << "Task #" << i << " has converged after " << n_rounds
+            << " round(s): mean improvement " << mean << ", upper bound " << upper;
+        this->TerminateTask(i);
+        continue;
+      }
+      // Step 3. The expected weighted latency saved in the next round, which is optimistic about
+      // the tasks with few rounds, as the bound is loose for them
+      double best = best_latency_history_[i].back();
+      tasks_alive.push_back(i);
+      gain.push_back(this->tasks_[i]->task_weight * best * upper);
+    }
+    if (tasks_alive.empty()) {
+      return -1;
+    }
+    // Step 4. Select the task with the largest gain
+    auto max_gain = std::max_element(gain.begin(), gain.end());
+    auto min_gain = std::min_element(gain.begin(), gain.end());
+    int task_id = -1;
+    if (*max_gain == *min_gain) {
+      task_id = tasks_alive[tir::SampleInt(&this->rand_state, 0, tasks_alive.size())];
+    } else {
+      task_id = tasks_alive[std::distance(gain.begin(), max_gain)];
+    }
+    if (this->tasks_[task_id]->runner_futures.defined()) {
+      JoinRunningTask(task_id);
+    }
+    return task_id;
+  }
+
+  Array<RunnerResult> JoinRunningTask(int task_id) final {
+    Array<RunnerResult> results = TaskSchedulerNode::JoinRunningTask(task_id);
+    TaskRecordNode* task = this->tasks_[task_id].get();
+    if (task->latency_ms.size() > 0) {
+      this->best_latency_history_.at(task_id).push_back(
+          *std::min_element(task->latency_ms.begin(),  //
+                            task->latency_ms.end()));
+    }
+    return results;
+  }
+
+ private:
+  /*!
+   * \brief Estimate the relative improvement per round of the best latency of a task.
+   * \param task_id The task id.
+   * \param mean The mean improvement over the recent rounds.
+   * \param upper The upper confidence bound of the mean improvement.
+   * \return Whether the best latency of the task is available.
+   */
+  bool ImprovementBound(int task_id, double* mean, double* upper) const {
+    const std::vector<double>& best_latency = best_latency_history_.at(task_id);
+    int n = best_latency.size();
+    if (n == 0 || best_latency[n - 1] >= 1e9) {
+      return false;
+    }
+    int w = std::min(window_size, n - 1);
+    if (w == 0) {
+      // A single round tells nothing about the trend, so assume the task is far from converged
+      *mean = *upper = 1.0;
+      return true;
+    }
+    std::vector<double> improvements;
+    improvements.reserve(w);
+    for (int i = n - w; i < n; ++i) {
+      double prev = best_latency[i - 1];
+      improvements.push_back(prev < 1e9 ? (prev - best_latency[i]) / prev : 1.0);
+    }
+    double sum = 0.0, sq_sum = 0.0;
+    for (double x : improvements) {
+      sum += x;
+    }
+    *mean = sum / w;
+    for (double x : improvements) {
+      sq_sum += (x - *mean) * (x - *mean);
+    }
+    double stddev = w > 1 ? std::sqrt(sq_sum / (w - 1)) : *mean;
+    *upper = *mean + z_score_ * stddev / std::sqrt(static_cast<double>(w));
+    return true;
+  }
+};
+
+/*! \brief The z-score `z` so that P(Z < z) = p for the standard normal distribution */
+static double NormalQuantile(double p) {
+  double lo = -10.0, hi = 10.0;
+  for (int i = 0; i < 100; ++i) {
+    double mid = (lo + hi) / 2;
+    if (0.5 * std::erfc(-mid / std::sqrt(2.0)) < p) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return (lo + hi) / 2;
+}
+
+TaskScheduler TaskScheduler::ConvergenceBased(PackedFunc logger, int window_size, double tolerance,
+                                              double confidence,
+                                              support::LinearCongruentialEngine::TRandState seed) {
+  CHECK_GT(window_size, 0) << "ValueError: `window_size` must be positive, but gets: "
+                           << window_size;
+  CHECK(0.0 < confidence && confidence < 1.0)
+      << "ValueError: `confidence` must be in (0, 1), but gets: " << confidence;
+  ObjectPtr<ConvergenceBasedNode> n = make_object<ConvergenceBasedNode>();
+  n->logger = logger;
+  n->window_size = window_size;
+  n->tolerance = tolerance;
+  n->confidence = confidence;
+  n->rand_state = support::LinearCongruentialEngine::NormalizeSeed(seed);
+  n->z_score_ = NormalQuantile(confidence);
+  return TaskScheduler(n);
+}
+
+TVM_REGISTER_NODE_TYPE(ConvergenceBasedNode);
+TVM_REGISTER_GLOBAL("meta_schedule.TaskSchedulerConvergenceBased")
+    .set_body_typed(TaskScheduler::ConvergenceBased);
+
+}  // namespace meta_schedule
+}  // namespace tvm
@@ -55,6 +55,7 @@
 #include "../support/utils.h"
 #include "../tir/schedule/primitive.h"
 #include "../tir/schedule/utils.h"
+#include "./invalid_decision_cache.h"
 
 #define TVM_PY_LOG(logging_level, logger)                                \
   ::tvm::meta_schedule::PyLogMessage(__FILE__, __LINE__, logger,         \
@@ -299,9 +300,16 @@ inline tir::BlockRV GetRVFromSRef(const tir::Schedule& sch, const tir::StmtSRef&
  * for each postprocessor
  */
 struct ThreadedTraceApply {
-  /*! \brief Constructor */
-  explicit ThreadedTraceApply(const Array<Postproc>& postprocs)
-      : n_(postprocs.size()), items_(new Item[n_]) {
+  /*!
+   * \brief Constructor
+   * \param postprocs The postprocessors
+   * \param invalid_decisions If given, the traces taking decisions known to fail the
+   * postprocessors are rejected without running them, and the outcomes of the others are recorded
+   * into it.
+   */
+  explicit ThreadedTraceApply(const Array<Postproc>& postprocs,
+                              InvalidDecisionCache* invalid_decisions = nullptr)
+      : n_(postprocs.size()), items_(new Item[n_]), invalid_decisions_(invalid_decisions) {
     for (int i = 0; i < n_; ++i) {
       items_[i].postproc = postprocs[i];
       items_[i].fail_counter = 0;
@@ -327,15 +335,28 @@ struct ThreadedTraceApply {
                               /*error_render_level=*/tir::ScheduleErrorRenderLevel::kNone);
 
     trace->ApplyToSchedule(sch, /*remove_postproc=*/true);
+    std::vector<uint64_t> decision_keys;
+    if (invalid_decisions_ != nullptr &&
+        InvalidDecisionCache::DecisionKeys(sch->trace().value(), &decision_keys) &&
+        invalid_decisions_->IsInvalid(decision_keys)) {
+      num_rejected_++;
+      return NullOpt;
+    }
     sch->EnterPostproc();
 
     for (int i = 0; i < n_; ++i) {
       Item& item = items_[i];
       if (!item.postproc->Apply(sch)) {
         item.fail_counter++;
+        if (invalid_decisions_ != nullptr && !decision_keys.empty()) {
+          invalid_decisions_->Record(decision_keys, /*valid=*/false);
+        }
         return NullOpt;
       }
     }
+    if (invalid_decisions_ != nullptr && !decision_keys.empty()) {
+      invalid_decisions_->Record(decision_keys, /*valid=*/true);
+    }
     return sch;
   }
 
@@ -350,6 +371,9 @@ struct ThreadedTraceApply {
         os << "\n";
       }
     }
+    if (invalid_decisions_ != nullptr) {
+      os << "\nRejected for known invalid decisions: " << num_rejected_.load() << " trace(s)";
+    }
     return os.str();
   }
 
@@ -366,6 +390,10 @@ struct ThreadedTraceApply {
   int n_;
   /*! \brief The pointer to the list of postprocessor items. */
   Item* items_;
+  /*! \brief The statistics of the decisions, or nullptr if the traces are not pruned. */
+  InvalidDecisionCache* invalid_decisions_;
+  /*! \brief The number of traces rejected for known invalid decisions. */
+  std::atomic<int> num_rejected_{0};
 };
 
 /*!
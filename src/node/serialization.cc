@@ -33,9 +33,14 @@
 #include <tvm/runtime/registry.h>
 
 #include <cctype>
+#include <cstring>
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "../runtime/file_utils.h"
 #include "../runtime/object_internal.h"
 #include "../support/base64.h"
 
@@ -468,6 +473,36 @@ class JSONAttrSetter : public AttrVisitor {
   }
 };
 
+/*!
+ * \brief Order the nodes so that each node comes after the nodes it refers to.
+ * \param n_nodes The number of nodes.
+ * \param for_each_child Calls its second argument with each node referred to by its first one.
+ * \return The order of the nodes.
+ */
+template <typename FChildren>
+std::vector<size_t> TopoSortNodes(size_t n_nodes, FChildren for_each_child) {
+  std::vector<size_t> topo_order;
+  std::vector<size_t> in_degree(n_nodes, 0);
+  for (size_t node = 0; node < n_nodes; ++node) {
+    for_each_child(node, [&](size_t i) { ++in_degree[i]; });
+  }
+  for (size_t i = 0; i < n_nodes; ++i) {
+    if (in_degree[i] == 0) {
+      topo_order.push_back(i);
+    }
+  }
+  for (size_t p = 0; p < topo_order.size(); ++p) {
+    for_each_child(topo_order[p], [&](size_t i) {
+      if (--in_degree[i] == 0) {
+        topo_order.push_back(i);
+      }
+    });
+  }
+  ICHECK_EQ(topo_order.size(), n_nodes) << "Cyclic reference detected in the serialized graph";
+  std::reverse(std::begin(topo_order), std::end(topo_order));
+  return topo_order;
+}
+
 // json graph structure to store node
 struct JSONGraph {
   // the root of the graph
@@ -528,38 +563,10 @@ struct JSONGraph {
   }
 
   std::vector<size_t> TopoSort() const {
-    size_t n_nodes = nodes.size();
-    std::vector<size_t> topo_order;
-    std::vector<size_t> in_degree(n_nodes, 0);
-    for (const JSONNode& jnode : nodes) {
-      for (size_t i : jnode.data) {
-        ++in_degree[i];
-      }
-      for (size_t i : jnode.fields) {
-        ++in_degree[i];
-      }
-    }
-    for (size_t i = 0; i < n_nodes; ++i) {
-      if (in_degree[i] == 0) {
-        topo_order.push_back(i);
-      }
-    }
-    for (size_t p = 0; p < topo_order.size(); ++p) {
-      const JSONNode& jnode = nodes[topo_order[p]];
-      for (size_t i : jnode.data) {
-        if (--in_degree[i] == 0) {
-          topo_order.push_back(i);
-        }
-      }
-      for (size_t i : jnode.fields) {
-        if (--in_degree[i] == 0) {
-          topo_order.push_back(i);
-        }
-      }
-    }
-    ICHECK_EQ(topo_order.size(), n_nodes) << "Cyclic reference detected in JSON file";
-    std::reverse(std::begin(topo_order), std::end(topo_order));
-    return topo_order;
+    return TopoSortNodes(nodes.size(), [this](size_t node, auto visit) {
+      for (size_t i : nodes[node].data) visit(i);
+      for (size_t i : nodes[node].fields) visit(i);
+    });
   }
 };
 
@@ -622,7 +629,500 @@ ObjectRef LoadJSON(std::string json_str) {
   return ObjectRef(nodes.at(jgraph.root));
 }
 
+
+/*
+ * The binary format, an alternative to the JSON graph of the same nodes:
+ *
+ *  - uint64 kTVMNodeBinaryMagic, uint64 kTVMNodeBinaryVersion, uint64 size of the index;
+ *  - the index: the interned strings, the nodes, the root, and the types, shapes and offsets of
+ *    the tensors;
+ *  - the raw data of the tensors, each at an offset aligned to kNodeBinaryAlignment.
+ *
+ * The strings include the type keys and the field names, so that a field is checked against the
+ * one visited when loading, and the tensors can be used in place in a mapped file.
+ */
+constexpr uint64_t kTVMNodeBinaryMagic = 0xB7E0C8D9A6F15E21;
+constexpr uint64_t kTVMNodeBinaryVersion = 1;
+constexpr uint64_t kNodeBinaryAlignment = 64;
+
+inline uint64_t AlignNodeBinaryOffset(uint64_t offset) {
+  return (offset + kNodeBinaryAlignment - 1) / kNodeBinaryAlignment * kNodeBinaryAlignment;
+}
+
+enum class BinaryNodeKind : uint8_t { kNull, kRepr, kArray, kStrMap, kMap, kObject };
+
+enum class BinaryFieldKind : uint8_t {
+  kDouble,
+  kInt64,
+  kUInt64,
+  kInt,
+  kBool,
+  kString,
+  kDataType,
+  kNDArray,
+  kObject
+};
+
+/*! \brief A field of an object, the value holds the bits of a number or an index. */
+struct BinaryField {
+  uint32_t key;
+  BinaryFieldKind kind;
+  uint64_t value;
+};
+
+/*! \brief A node of the binary format. */
+struct BinaryNode {
+  BinaryNodeKind kind{BinaryNodeKind::kNull};
+  /*! \brief The index of the type key in the strings. */
+  uint32_t type_key{0};
+  /*! \brief The index of the repr bytes in the strings. */
+  uint32_t repr{0};
+  /*! \brief The indices of the keys of a map of strings in the strings. */
+  std::vector<uint32_t> keys;
+  /*! \brief The nodes of an array or of a map. */
+  std::vector<uint64_t> data;
+  /*! \brief The fields of an object, in the order of VisitAttrs. */
+  std::vector<BinaryField> fields;
+};
+
+/*! \brief The strings of a binary graph, each stored once. */
+class BinaryStringTable {
+ public:
+  uint32_t Intern(const std::string& str) {
+    auto it = index_.find(str);
+    if (it != index_.end()) return it->second;
+    uint32_t id = static_cast<uint32_t>(strings.size());
+    index_.emplace(str, id);
+    strings.push_back(str);
+    return id;
+  }
+
+  std::vector<std::string> strings;
+
+ private:
+  std::unordered_map<std::string, uint32_t> index_;
+};
+
+// Helper class to populate the binary node using the existing index.
+class BinaryAttrGetter : public AttrVisitor {
+ public:
+  const std::unordered_map<Object*, size_t>* node_index_;
+  const std::unordered_map<DLTensor*, size_t>* tensor_index_;
+  BinaryStringTable* strings_;
+  BinaryNode* node_;
+  ReflectionVTable* reflection_ = ReflectionVTable::Global();
+
+  void Visit(const char* key, double* value) final {
+    uint64_t bits;
+    std::memcpy(&bits, value, sizeof(bits));
+    Push(key, BinaryFieldKind::kDouble, bits);
+  }
+  void Visit(const char* key, int64_t* value) final {
+    Push(key, BinaryFieldKind::kInt64, static_cast<uint64_t>(*value));
+  }
+  void Visit(const char* key, uint64_t* value) final {
+    Push(key, BinaryFieldKind::kUInt64, *value);
+  }
+  void Visit(const char* key, int* value) final {
+    Push(key, BinaryFieldKind::kInt, static_cast<uint64_t>(static_cast<int64_t>(*value)));
+  }
+  void Visit(const char* key, bool* value) final { Push(key, BinaryFieldKind::kBool, *value); }
+  void Visit(const char* key, std::string* value) final {
+    Push(key, BinaryFieldKind::kString, strings_->Intern(*value));
+  }
+  void Visit(const char* key, void** value) final {
+    LOG(FATAL) << "not allowed to serialize a pointer";
+  }
+  void Visit(const char* key, DataType* value) final {
+    uint64_t bits = static_cast<uint64_t>(value->code()) |
+                    (static_cast<uint64_t>(value->bits()) << 8) |
+                    (static_cast<uint64_t>(static_cast<uint16_t>(value->lanes())) << 16);
+    Push(key, BinaryFieldKind::kDataType, bits);
+  }
+  void Visit(const char* key, runtime::NDArray* value) final {
+    Push(key, BinaryFieldKind::kNDArray,
+         tensor_index_->at(const_cast<DLTensor*>((*value).operator->())));
+  }
+  void Visit(const char* key, ObjectRef* value) final {
+    Push(key, BinaryFieldKind::kObject, node_index_->at(const_cast<Object*>(value->get())));
+  }
+
+  // Get the node
+  void Get(Object* node) {
+    if (node == nullptr) return;
+    node_->type_key = strings_->Intern(node->GetTypeKey());
+    std::string repr_bytes;
+    if (reflection_->GetReprBytes(node, &repr_bytes)) {
+      node_->kind = BinaryNodeKind::kRepr;
+      node_->repr = strings_->Intern(repr_bytes);
+    } else if (node->IsInstance<ArrayNode>()) {
+      node_->kind = BinaryNodeKind::kArray;
+      for (const ObjectRef& elem : *static_cast<ArrayNode*>(node)) {
+        node_->data.push_back(node_index_->at(const_cast<Object*>(elem.get())));
+      }
+    } else if (node->IsInstance<MapNode>()) {
+      MapNode* n = static_cast<MapNode*>(node);
+      bool is_str_map = std::all_of(n->begin(), n->end(), [](const auto& v) {
+        return v.first->template IsInstance<StringObj>();
+      });
+      node_->kind = is_str_map ? BinaryNodeKind::kStrMap : BinaryNodeKind::kMap;
+      for (const auto& kv : *n) {
+        if (is_str_map) {
+          node_->keys.push_back(strings_->Intern(Downcast<String>(kv.first)));
+        } else {
+          node_->data.push_back(node_index_->at(const_cast<Object*>(kv.first.get())));
+        }
+        node_->data.push_back(node_index_->at(const_cast<Object*>(kv.second.get())));
+      }
+    } else {
+      node_->kind = BinaryNodeKind::kObject;
+      reflection_->VisitAttrs(node, this);
+    }
+  }
+
+ private:
+  void Push(const char* key, BinaryFieldKind kind, uint64_t value) {
+    node_->fields.push_back(BinaryField{strings_->Intern(key), kind, value});
+  }
+};
+
+// Helper class to set the attributes of a node from the binary node.
+class BinaryAttrSetter : public AttrVisitor {
+ public:
+  const std::vector<ObjectPtr<Object>>* node_list_;
+  const std::vector<runtime::NDArray>* tensor_list_;
+  const std::vector<std::string>* strings_;
+  const BinaryNode* bnode_;
+  size_t field_{0};
+  ReflectionVTable* reflection_ = ReflectionVTable::Global();
+
+  void Visit(const char* key, double* value) final {
+    uint64_t bits = Next(key, BinaryFieldKind::kDouble);
+    std::memcpy(value, &bits, sizeof(bits));
+  }
+  void Visit(const char* key, int64_t* value) final {
+    *value = static_cast<int64_t>(Next(key, BinaryFieldKind::kInt64));
+  }
+  void Visit(const char* key, uint64_t* value) final {
+    *value = Next(key, BinaryFieldKind::kUInt64);
+  }
+  void Visit(const char* key, int* value) final {
+    *value = static_cast<int>(static_cast<int64_t>(Next(key, BinaryFieldKind::kInt)));
+  }
+  void Visit(const char* key, bool* value) final {
+    *value = Next(key, BinaryFieldKind::kBool) != 0;
+  }
+  void Visit(const char* key, std::string* value) final {
+    *value = strings_->at(Next(key, BinaryFieldKind::kString));
+  }
+  void Visit(const char* key, void** value) final {
+    LOG(FATAL) << "not allowed to deserialize a pointer";
+  }
+  void Visit(const char* key, DataType* value) final {
+    uint64_t bits = Next(key, BinaryFieldKind::kDataType);
+    *value = DataType(static_cast<int>(bits & 0xFF), static_cast<int>((bits >> 8) & 0xFF),
+                      static_cast<int>(static_cast<uint16_t>(bits >> 16)));
+  }
+  void Visit(const char* key, runtime::NDArray* value) final {
+    *value = tensor_list_->at(Next(key, BinaryFieldKind::kNDArray));
+  }
+  void Visit(const char* key, ObjectRef* value) final {
+    *value = ObjectRef(node_list_->at(Next(key, BinaryFieldKind::kObject)));
+  }
+
+  // set node to be current binary node
+  void Set(ObjectPtr<Object>* node, const BinaryNode* bnode) {
+    if (node->get() == nullptr || bnode->kind == BinaryNodeKind::kRepr) {
+      return;
+    }
+    if (bnode->kind == BinaryNodeKind::kArray) {
+      std::vector<ObjectRef> container;
+      for (uint64_t index : bnode->data) {
+        container.push_back(ObjectRef(node_list_->at(index)));
+      }
+      Array<ObjectRef> array(container);
+      *node = runtime::ObjectInternal::MoveObjectPtr(&array);
+      return;
+    }
+    if (bnode->kind == BinaryNodeKind::kStrMap || bnode->kind == BinaryNodeKind::kMap) {
+      std::unordered_map<ObjectRef, ObjectRef, ObjectHash, ObjectEqual> container;
+      if (bnode->kind == BinaryNodeKind::kMap) {
+        ICHECK_EQ(bnode->data.size() % 2, 0U);
+        for (size_t i = 0; i < bnode->data.size(); i += 2) {
+          container[ObjectRef(node_list_->at(bnode->data[i]))] =
+              ObjectRef(node_list_->at(bnode->data[i + 1]));
+        }
+      } else {
+        ICHECK_EQ(bnode->data.size(), bnode->keys.size());
+        for (size_t i = 0; i < bnode->data.size(); ++i) {
+          container[String(strings_->at(bnode->keys[i]))] =
+              ObjectRef(node_list_->at(bnode->data[i]));
+        }
+      }
+      Map<ObjectRef, ObjectRef> map(container);
+      *node = runtime::ObjectInternal::MoveObjectPtr(&map);
+      return;
+    }
+    bnode_ = bnode;
+    field_ = 0;
+    reflection_->VisitAttrs(node->get(), this);
+    ICHECK_EQ(field_, bnode->fields.size())
+        << "LoadBinary: " << (*node)->GetTypeKey() << " has fewer fields than were saved";
+  }
+
+ private:
+  uint64_t Next(const char* key, BinaryFieldKind kind) {
+    ICHECK_LT(field_, bnode_->fields.size())
+        << "LoadBinary: cannot find field " << key << " of " << strings_->at(bnode_->type_key);
+    const BinaryField& field = bnode_->fields[field_++];
+    ICHECK(strings_->at(field.key) == key && field.kind == kind)
+        << "LoadBinary: expected field " << key << " of " << strings_->at(bnode_->type_key)
+        << ", found " << strings_->at(field.key);
+    return field.value;
+  }
+};
+
+std::string SaveBinary(const ObjectRef& n) {
+  NodeIndexer indexer;
+  indexer.MakeIndex(const_cast<Object*>(n.get()));
+  BinaryStringTable strings;
+  std::vector<BinaryNode> nodes(indexer.node_list_.size());
+  BinaryAttrGetter getter;
+  getter.node_index_ = &indexer.node_index_;
+  getter.tensor_index_ = &indexer.tensor_index_;
+  getter.strings_ = &strings;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    getter.node_ = &nodes[i];
+    getter.Get(indexer.node_list_[i]);
+  }
+
+  std::string index;
+  dmlc::MemoryStringStream index_strm(&index);
+  dmlc::Stream* strm = &index_strm;
+  strm->Write(strings.strings);
+  strm->Write(static_cast<uint64_t>(nodes.size()));
+  for (const BinaryNode& node : nodes) {
+    strm->Write(static_cast<uint8_t>(node.kind));
+    switch (node.kind) {
+      case BinaryNodeKind::kNull:
+        break;
+      case BinaryNodeKind::kRepr:
+        strm->Write(node.type_key);
+        strm->Write(node.repr);
+        break;
+      case BinaryNodeKind::kArray:
+      case BinaryNodeKind::kMap:
+        strm->Write(node.type_key);
+        strm->Write(node.data);
+        break;
+      case BinaryNodeKind::kStrMap:
+        strm->Write(node.type_key);
+        strm->Write(node.keys);
+        strm->Write(node.data);
+        break;
+      case BinaryNodeKind::kObject:
+        strm->Write(node.type_key);
+        strm->Write(static_cast<uint32_t>(node.fields.size()));
+        for (const BinaryField& field : node.fields) {
+          strm->Write(field.key);
+          strm->Write(static_cast<uint8_t>(field.kind));
+          strm->Write(field.value);
+        }
+        break;
+    }
+  }
+  strm->Write(static_cast<uint64_t>(indexer.node_index_.at(const_cast<Object*>(n.get()))));
+
+  // The data of the tensors follows the index, on the CPU and in the order of their offsets
+  std::vector<runtime::NDArray> tensors;
+  uint64_t offset = 0;
+  strm->Write(static_cast<uint64_t>(indexer.tensor_list_.size()));
+  for (DLTensor* tensor : indexer.tensor_list_) {
+    runtime::NDArray host = runtime::NDArray::Empty(
+        std::vector<int64_t>(tensor->shape, tensor->shape + tensor->ndim), tensor->dtype,
+        {kDLCPU, 0});
+    host.CopyFrom(tensor);
+    uint64_t nbytes = runtime::GetDataSize(*host.operator->());
+    strm->Write(tensor->dtype);
+    strm->Write(std::vector<int64_t>(tensor->shape, tensor->shape + tensor->ndim));
+    strm->Write(offset);
+    strm->Write(nbytes);
+    offset = AlignNodeBinaryOffset(offset + nbytes);
+    tensors.push_back(host);
+  }
+
+  const uint64_t header_size = 3 * sizeof(uint64_t);
+  uint64_t data_offset = AlignNodeBinaryOffset(header_size + index.size());
+  std::string blob(data_offset + offset, '\0');
+  uint64_t header[3] = {kTVMNodeBinaryMagic, kTVMNodeBinaryVersion, index.size()};
+  std::memcpy(&blob[0], header, header_size);
+  std::memcpy(&blob[header_size], index.data(), index.size());
+  offset = data_offset;
+  for (const runtime::NDArray& tensor : tensors) {
+    size_t nbytes = runtime::GetDataSize(*tensor.operator->());
+    std::memcpy(&blob[offset], tensor->data, nbytes);
+    offset = AlignNodeBinaryOffset(offset + nbytes);
+  }
+  return blob;
+}
+
+/*!
+ * \brief Load the nodes of the binary format.
+ * \param data The data.
+ * \param size The size of the data.
+ * \param file The mapping of the data, into which the tensors point, or nullptr to copy them.
+ * \return The root node.
+ */
+ObjectRef LoadBinary(const char* data, size_t size,
+                     const std::shared_ptr<runtime::MappedFile>& file) {
+  const uint64_t header_size = 3 * sizeof(uint64_t);
+  ICHECK_GE(size, header_size) << "LoadBinary: invalid format";
+  uint64_t header[3];
+  std::memcpy(header, data, header_size);
+  ICHECK_EQ(header[0], kTVMNodeBinaryMagic) << "LoadBinary: invalid format";
+  ICHECK_EQ(header[1], kTVMNodeBinaryVersion) << "LoadBinary: unsupported version " << header[1];
+  ICHECK_LE(header[2], size - header_size) << "LoadBinary: invalid format";
+  uint64_t data_offset = AlignNodeBinaryOffset(header_size + header[2]);
+  dmlc::MemoryFixedSizeStream index_strm(const_cast<char*>(data) + header_size, header[2]);
+  dmlc::Stream* strm = &index_strm;
+  auto read = [strm](auto* value) { ICHECK(strm->Read(value)) << "LoadBinary: invalid format"; };
+
+  std::vector<std::string> strings;
+  read(&strings);
+  auto check_string = [&strings](uint32_t index) {
+    ICHECK_LT(index, strings.size()) << "LoadBinary: invalid format";
+  };
+  uint64_t n_nodes;
+  read(&n_nodes);
+  std::vector<BinaryNode> bnodes(n_nodes);
+  for (BinaryNode& node : bnodes) {
+    uint8_t kind;
+    read(&kind);
+    ICHECK_LE(kind, static_cast<uint8_t>(BinaryNodeKind::kObject)) << "LoadBinary: invalid format";
+    node.kind = static_cast<BinaryNodeKind>(kind);
+    if (node.kind == BinaryNodeKind::kNull) continue;
+    read(&node.type_key);
+    check_string(node.type_key);
+    if (node.kind == BinaryNodeKind::kRepr) {
+      read(&node.repr);
+      check_string(node.repr);
+    } else if (node.kind == BinaryNodeKind::kObject) {
+      uint32_t n_fields;
+      read(&n_fields);
+      node.fields.resize(n_fields);
+      for (BinaryField& field : node.fields) {
+        uint8_t field_kind;
+        read(&field.key);
+        read(&field_kind);
+        read(&field.value);
+        check_string(field.key);
+        field.kind = static_cast<BinaryFieldKind>(field_kind);
+        if (field.kind == BinaryFieldKind::kObject) {
+          ICHECK_LT(field.value, n_nodes) << "LoadBinary: invalid format";
+        } else if (field.kind == BinaryFieldKind::kString) {
+          check_string(field.value);
+        }
+      }
+    } else {
+      if (node.kind == BinaryNodeKind::kStrMap) {
+        read(&node.keys);
+        for (uint32_t key : node.keys) check_string(key);
+      }
+      read(&node.data);
+      for (uint64_t index : node.data) {
+        ICHECK_LT(index, n_nodes) << "LoadBinary: invalid format";
+      }
+    }
+  }
+  uint64_t root;
+  read(&root);
+  ICHECK_LT(root, n_nodes) << "LoadBinary: invalid format";
+
+  uint64_t n_tensors;
+  read(&n_tensors);
+  std::vector<runtime::NDArray> tensors;
+  for (uint64_t i = 0; i < n_tensors; ++i) {
+    DLDataType dtype;
+    std::vector<int64_t> shape;
+    uint64_t offset, nbytes;
+    read(&dtype);
+    read(&shape);
+    read(&offset);
+    read(&nbytes);
+    // Written so that none of the sums can overflow
+    ICHECK(data_offset <= size && offset <= size - data_offset &&
+           nbytes <= size - data_offset - offset)
+        << "LoadBinary: tensor " << i << " is out of the data";
+    for (int64_t dim : shape) {
+      ICHECK_GE(dim, 0) << "LoadBinary: invalid format";
+    }
+    DLTensor expected;
+    expected.ndim = static_cast<int>(shape.size());
+    expected.shape = shape.data();
+    expected.dtype = dtype;
+    ICHECK_EQ(runtime::GetDataSize(expected), nbytes) << "LoadBinary: invalid format";
+    runtime::NDArray tensor;
+    if (file != nullptr) {
+      tensor = runtime::MappedNDArray(file, data_offset + offset, shape, dtype);
+    } else {
+      tensor = runtime::NDArray::Empty(shape, dtype, {kDLCPU, 0});
+      std::memcpy(tensor->data, data + data_offset + offset, nbytes);
+    }
+    tensors.push_back(tensor);
+  }
+
+  // Create all the objects, and set their fields after the nodes they refer to
+  ReflectionVTable* reflection = ReflectionVTable::Global();
+  std::vector<ObjectPtr<Object>> nodes(n_nodes, nullptr);
+  for (size_t i = 0; i < n_nodes; ++i) {
+    const BinaryNode& node = bnodes[i];
+    if (node.kind == BinaryNodeKind::kNull) continue;
+    nodes[i] = reflection->CreateInitObject(
+        strings[node.type_key], node.kind == BinaryNodeKind::kRepr ? strings[node.repr] : "");
+  }
+  std::vector<size_t> topo_order = TopoSortNodes(n_nodes, [&bnodes](size_t node, auto visit) {
+    for (uint64_t i : bnodes[node].data) visit(i);
+    for (const BinaryField& field : bnodes[node].fields) {
+      if (field.kind == BinaryFieldKind::kObject) visit(field.value);
+    }
+  });
+  BinaryAttrSetter setter;
+  setter.node_list_ = &nodes;
+  setter.tensor_list_ = &tensors;
+  setter.strings_ = &strings;
+  for (size_t i : topo_order) {
+    setter.Set(&nodes[i], &bnodes[i]);
+  }
+  return ObjectRef(nodes.at(root));
+}
+
+ObjectRef LoadBinary(const std::string& blob) {
+  return LoadBinary(blob.data(), blob.size(), nullptr);
+}
+
+ObjectRef LoadBinaryFromFile(const std::string& path) {
+  std::shared_ptr<runtime::MappedFile> file = runtime::MapFile(path);
+  return LoadBinary(static_cast<const char*>(file->data), file->size, file);
+}
+
 TVM_REGISTER_GLOBAL("node.SaveJSON").set_body_typed(SaveJSON);
 
 TVM_REGISTER_GLOBAL("node.LoadJSON").set_body_typed(LoadJSON);
+
+TVM_REGISTER_GLOBAL("node.SaveBinary").set_body_typed([](const ObjectRef& node) {
+  std::string blob = SaveBinary(node);
+  // copy return array so it is owned by the ret value
+  TVMRetValue rv;
+  rv = TVMByteArray{blob.data(), blob.size()};
+  return rv;
+});
+
+TVM_REGISTER_GLOBAL("node.LoadBinary").set_body([](TVMArgs args, TVMRetValue* rv) {
+  std::string blob = args[0];
+  *rv = LoadBinary(blob);
+});
+
+TVM_REGISTER_GLOBAL("node.LoadBinaryFromFile").set_body_typed([](const String& path) {
+  return LoadBinaryFromFile(path);
+});
 }  // namespace tvm
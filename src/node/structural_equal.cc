@@ -25,8 +25,10 @@
 #include <tvm/node/object_path.h>
 #include <tvm/node/reflection.h>
 #include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/runtime/registry.h>
 
+#include <typeinfo>
 #include <unordered_map>
 
 #include "ndarray_hash_equal.h"
@@ -287,6 +289,7 @@ class SEqualHandlerDefault::Impl {
   // Function that implements actual equality check.
   bool Equal(const ObjectRef& lhs, const ObjectRef& rhs, bool map_free_vars) {
     if (!lhs.defined() && !rhs.defined()) return true;
+    if (CachedHashesDiffer(lhs, rhs, map_free_vars)) return false;
     task_stack_.clear();
     pending_tasks_.clear();
     equal_map_lhs_.clear();
@@ -466,6 +469,25 @@ class SEqualHandlerDefault::Impl {
 
   bool IsPathTracingEnabled() const { return first_mismatch_ != nullptr; }
 
+  /*!
+   * \brief Check whether the cached structural hashes of two roots differ, in which case they are
+   * not equal. Only the hashes covering no floating point value are consistent with the
+   * comparison. The assertion and the path tracing need the full comparison.
+   */
+  bool CachedHashesDiffer(const ObjectRef& lhs, const ObjectRef& rhs, bool map_free_vars) const {
+    if (!lhs.defined() || !rhs.defined() || assert_mode_ || IsPathTracingEnabled() ||
+        typeid(*parent_) != typeid(SEqualHandlerDefault)) {
+      return false;
+    }
+    const SHashCache* lhs_cache = SHashCache::Find(lhs.get());
+    const SHashCache* rhs_cache = SHashCache::Find(rhs.get());
+    uint64_t lhs_hash, rhs_hash;
+    return lhs_cache != nullptr && rhs_cache != nullptr &&
+           lhs_cache->GetExact(map_free_vars, &lhs_hash) &&
+           rhs_cache->GetExact(map_free_vars, &rhs_hash) &&
+           lhs_hash != rhs_hash;
+  }
+
   // The owner of this impl
   SEqualHandlerDefault* parent_;
   // list of pending tasks to be pushed to the stack.
@@ -30,7 +30,9 @@
 #include <tvm/runtime/registry.h>
 
 #include <algorithm>
+#include <typeinfo>
 #include <unordered_map>
+#include <vector>
 
 #include "../support/base64.h"
 #include "../support/str_escape.h"
@@ -90,6 +92,8 @@ class SHashHandlerDefault::Impl {
     task_stack_.back().graph_node_hash = true;
   }
 
+  void MarkInexactValue() { hashed_inexact_value_ = true; }
+
   bool LookupHashedValue(const ObjectRef& key, uint64_t* hash_value) {
     auto it = hash_memo_.find(key);
     if (it != hash_memo_.end()) {
@@ -138,6 +142,20 @@ class SHashHandlerDefault::Impl {
     ICHECK_EQ(pending_tasks_.size(), 0U);
     ICHECK_EQ(result_stack_.size(), 0U);
 
+    // The handlers overriding the dispatch compute other hashes
+    const SHashCache* cache = nullptr;
+    if (object.defined() && typeid(*parent_) == typeid(SHashHandlerDefault)) {
+      cache = SHashCache::Find(object.get());
+    }
+    uint64_t cached_hash;
+    if (cache != nullptr && cache->Get(map_free_vars, &cached_hash)) {
+      return cached_hash;
+    }
+    // The memoized nodes of a previous call are not visited again, and could hide floating point
+    // values from this one
+    bool exact = hash_memo_.empty();
+    hashed_inexact_value_ = false;
+
     this->SHashReduce(object, map_free_vars);
     ICHECK_EQ(pending_tasks_.size(), 1U);
     ICHECK(allow_push_to_stack_);
@@ -149,6 +167,7 @@ class SHashHandlerDefault::Impl {
     ICHECK_EQ(result_stack_.size(), 1U);
     uint64_t ret = result_stack_.back();
     result_stack_.pop_back();
+    if (cache != nullptr) cache->Set(map_free_vars, ret, exact && !hashed_inexact_value_);
     return ret;
   }
 
@@ -246,6 +265,8 @@ class SHashHandlerDefault::Impl {
   uint32_t graph_node_counter_{0};
   // record current stack top
   bool allow_push_to_stack_{true};
+  // whether a floating point value was hashed since the start of Hash
+  bool hashed_inexact_value_{false};
   // list of pending tasks to be pushed to the stack.
   std::vector<Task> pending_tasks_;
   // Internal task stack to executed the task
@@ -258,6 +279,26 @@ class SHashHandlerDefault::Impl {
   std::unordered_map<ObjectRef, uint64_t, ObjectPtrHash, ObjectPtrEqual> hash_memo_;
 };
 
+/*! \brief The functions getting the SHashCache of the nodes, by type index. */
+static std::vector<SHashCache::FGetCache>* SHashCacheTypes() {
+  static std::vector<SHashCache::FGetCache> types;
+  return &types;
+}
+
+bool SHashCache::RegisterType(uint32_t type_index, FGetCache fget) {
+  std::vector<FGetCache>* types = SHashCacheTypes();
+  if (type_index >= types->size()) types->resize(type_index + 1, nullptr);
+  (*types)[type_index] = fget;
+  return true;
+}
+
+const SHashCache* SHashCache::Find(const runtime::Object* node) {
+  const std::vector<FGetCache>& types = *SHashCacheTypes();
+  uint32_t type_index = node->type_index();
+  if (type_index >= types.size() || types[type_index] == nullptr) return nullptr;
+  return types[type_index](node);
+}
+
 SHashHandlerDefault::SHashHandlerDefault() { impl = new Impl(this); }
 SHashHandlerDefault::~SHashHandlerDefault() { delete impl; }
 
@@ -279,6 +320,8 @@ bool SHashHandlerDefault::LookupHashedValue(const ObjectRef& key, uint64_t* hash
 
 void SHashHandlerDefault::MarkGraphNode() { impl->MarkGraphNode(); }
 
+void SHashHandlerDefault::MarkInexactValue() { impl->MarkInexactValue(); }
+
 uint64_t SHashHandlerDefault::Hash(const ObjectRef& object, bool map_free_vars) {
   return impl->Hash(object, map_free_vars);
 }
@@ -19,11 +19,39 @@
 
 #include "./graph_partitioner.h"
 
+#include <tvm/relay/expr.h>
+
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 namespace tvm {
 namespace relay {
 
+namespace {
+
+/*!
+ * \brief The size of the tensor an expression of the graph evaluates to.
+ * \param ref The expression.
+ * \return The number of elements and bytes, or -1 for both if the type is not a tensor of a
+ * static shape.
+ */
+std::pair<int64_t, int64_t> TensorSize(const tvm::Object* ref) {
+  if (!ref->IsInstance<RelayExprNode>()) return {-1, -1};
+  const Type& type = static_cast<const RelayExprNode*>(ref)->checked_type_;
+  const auto* tensor_type = type.as<TensorTypeNode>();
+  if (tensor_type == nullptr) return {-1, -1};
+  int64_t num_elems = 1;
+  for (const PrimExpr& dim : tensor_type->shape) {
+    const auto* int_dim = dim.as<IntImmNode>();
+    if (int_dim == nullptr) return {-1, -1};
+    num_elems *= int_dim->value;
+  }
+  return {num_elems, num_elems * tensor_type->dtype.bytes() * tensor_type->dtype.lanes()};
+}
+
+}  // namespace
+
 DominatorTree DominatorTree::PostDom(support::Arena* arena, const IndexedForwardGraph& graph) {
   DominatorTree tree;
   tree.nodes.resize(graph.post_dfs_order.size(), nullptr);
@@ -220,6 +248,27 @@ size_t GraphPartitioner::CountFusedNodesWithNewChild(IndexedForwardGraph::Node*
   return target->FindRoot()->num_nodes + CountNodesUptoSink_(child, dom_parent);
 }
 
+bool GraphPartitioner::IsFusionProfitable(IndexedForwardGraph::Node* src) {
+  auto [num_elems, num_bytes] = TensorSize(src->ref);
+  if (num_elems < 0) return true;
+  // A fused producer is inlined into each consumer, hence computed once for every element read
+  int64_t num_consumers = 0;
+  int64_t num_computed = 0;
+  for (auto* link = src->outputs.head; link != nullptr; link = link->next) {
+    int64_t consumer_elems = TensorSize(link->value.node->ref).first;
+    if (consumer_elems < 0) return true;
+    ++num_consumers;
+    num_computed += std::max(consumer_elems, num_elems);
+  }
+  // Unfused, the output is written once and read back by each consumer
+  double traffic_saved = static_cast<double>(num_bytes) * (1 + num_consumers);
+  // MACs are only counted for the anchor ops, which are never inlined, so each op of the producer
+  // group costs one FLOP per element
+  double recompute_flops =
+      static_cast<double>(num_computed - num_elems) * groups_[src->index]->FindRoot()->num_nodes;
+  return traffic_saved * flops_per_byte_ >= recompute_flops;
+}
+
 void GraphPartitioner::InitGroups(const IndexedForwardGraph& graph) {
   groups_.resize(graph.post_dfs_order.size());
   for (size_t nid = 0; nid < groups_.size(); ++nid) {
@@ -256,6 +305,8 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
       continue;
 
     if (phase == 2) {
+      // The groups anchored on a reduction by cost are never fused into tuples
+      if (flops_per_byte_ > 0 && group_node->FindRoot()->pattern == kCommReduce) continue;
       // Fuse injective ops into intermediate tuples, if any
       if (group_node->pattern > relay::kInjective) continue;
       Group* dom_parent_group = groups_[dom_parent_gindex];
@@ -281,6 +332,21 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
     }
     // Do not fuse into tuple for now
     if (groups_[dom_parent_gindex]->pattern == kTuple) continue;
+    if (flops_per_byte_ > 0 && group_node->FindRoot()->pattern == kCommReduce) {
+      // Path for CommReduce: sum, max, when fusing by cost
+      // Unlike the producers below, the output of a reduction is materialized in the fused
+      // function rather than recomputed, so the group grows into the broadcast consumers of it.
+      if (phase != 0) continue;
+      if (dom_node->pattern <= kBroadcast) {
+        auto fcond = [](OpPatternKind kind, bool is_sink) { return kind <= kBroadcast; };
+        if (CheckPath(graph_node, dom_node->parent->gnode, fcond)) {
+          CommitFuse(graph_node, dom_node->parent->gnode);
+          // The reduction stays the anchor of the group, which keeps other reductions out
+          group_node->FindRoot()->pattern = kCommReduce;
+        }
+      }
+      continue;
+    }
     // Try to fuse current node to its post-dominator.
     if (group_node->pattern == kOutEWiseFusable) {
       if (phase != 0) continue;
@@ -310,7 +376,8 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
                     kind == kOutEWiseFusable);
           }
         };
-        if (CheckPath(graph_node, dom_node->parent->gnode, fcond)) {
+        if (CheckPath(graph_node, dom_node->parent->gnode, fcond) &&
+            (flops_per_byte_ <= 0 || IsFusionProfitable(graph_node))) {
           CommitFuse(graph_node, dom_node->parent->gnode);
         }
       }
@@ -320,7 +387,9 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
       if (phase != 1) continue;
       // Check if all path are injective.
       auto fcond = [](OpPatternKind kind, bool is_sink) { return kind <= kInjective; };
-      if (CheckPath(graph_node, dom_node->parent->gnode, fcond)) {
+      if (CheckPath(graph_node, dom_node->parent->gnode, fcond) &&
+          (flops_per_byte_ <= 0 || group_node->pattern == kTuple ||
+           IsFusionProfitable(graph_node))) {
         CommitFuse(graph_node, dom_node->parent->gnode);
       }
     } else {
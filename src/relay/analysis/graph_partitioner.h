@@ -162,8 +162,21 @@ class DominatorTree {
  */
 class GraphPartitioner {
  public:
-  explicit GraphPartitioner(support::Arena* arena, int opt_level, size_t max_fuse_depth)
-      : arena_(arena), opt_level_(opt_level), max_fuse_depth_(max_fuse_depth) {}
+  /*!
+   * \brief Constructor.
+   * \param arena The arena used for allocation.
+   * \param opt_level The optimization level for fuse operation.
+   * \param max_fuse_depth The maximum number of operations in one fused function.
+   * \param flops_per_byte If positive, the estimated FLOPs worth one byte of memory traffic. A
+   * producer is then only fused when the traffic its fusion saves outweighs the cost of recomputing
+   * it in its consumers, and the reductions are also fused into their broadcast consumers.
+   */
+  explicit GraphPartitioner(support::Arena* arena, int opt_level, size_t max_fuse_depth,
+                            double flops_per_byte = 0.0)
+      : arena_(arena),
+        opt_level_(opt_level),
+        max_fuse_depth_(max_fuse_depth),
+        flops_per_byte_(flops_per_byte) {}
   /*!
    * \brief Group as a union find data structure.
    */
@@ -205,6 +218,8 @@ class GraphPartitioner {
   int opt_level_;
   /*! \brief The maximum number of operations in one fused function */
   size_t max_fuse_depth_;
+  /*! \brief The FLOPs worth one byte of memory traffic, or 0 to fuse by the patterns only */
+  double flops_per_byte_;
   /*! \brief The internal groups. */
   std::vector<Group*> groups_;
   /*! \brief internal field used for deduplication */
@@ -257,6 +272,15 @@ class GraphPartitioner {
   size_t CountFusedNodesWithNewChild(IndexedForwardGraph::Node* child,
                                      IndexedForwardGraph::Node* dom_parent);
 
+  /*!
+   * \brief Estimate whether fusing a producer into its consumers pays off.
+   * \param src The producer.
+   * \return Whether the memory traffic saved by not materializing the output of the producer
+   * outweighs the FLOPs of recomputing it for each element its consumers read, or true if its
+   * shapes are unknown.
+   */
+  bool IsFusionProfitable(IndexedForwardGraph::Node* src);
+
   // Initialize the groups.
   void InitGroups(const IndexedForwardGraph& graph);
 
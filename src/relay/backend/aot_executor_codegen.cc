@@ -42,6 +42,7 @@
 #include <algorithm>
 #include <list>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "../../target/source/codegen_source_base.h"
@@ -439,9 +440,20 @@ class AOTExecutorCodegen : public MixedModeVisitor {
       }
     }
 
+    // Record the buffers touched by the call, parameters are read-only so they are left out.
+    StmtAccesses accesses;
+    for (const PrimExpr& arg : args) {
+      if (const auto* var_node = arg.as<tir::VarNode>()) {
+        accesses.reads.push_back(var_node);
+      }
+    }
+
     // Pack the return(s) value. A call node can produce multiple outputs
     auto result_expr_sid = PackSid(result_expr);
     PushArgs(result_expr, result_expr_sid, &args);
+    for (const tir::Var& var : result_expr_sid) {
+      accesses.writes.push_back(var.get());
+    }
 
     GlobalVar global_var = call_lowered_props.lowered_func;
     bool has_c_device_api_context = device_contexts_.count(global_var) != 0;
@@ -496,6 +508,7 @@ class AOTExecutorCodegen : public MixedModeVisitor {
 
     tir::Stmt body = tir::SeqStmt({func_call});
     stmts_.push_back(body);
+    stmt_accesses_.push_back(std::move(accesses));
   }
 
   /*!
@@ -517,6 +530,69 @@ class AOTExecutorCodegen : public MixedModeVisitor {
         loop_idx, 0, tir::make_const(DataType::Int(32, 1), size, Span()), tir::ForKind::kSerial,
         tir::BufferStore(tmp_write, tir::Let(tmp_read->data, in, retval_i), {loop_idx}));
     stmts_.push_back(tir::LetStmt(tmp_write->data, out, copy));
+    StmtAccesses accesses;
+    accesses.barrier = true;
+    stmt_accesses_.push_back(std::move(accesses));
+  }
+
+  /*!
+   * \brief Schedule the statements of the program in wavefronts: a statement runs in the first
+   * wavefront following all the statements it depends on through a buffer (read after write, write
+   * after read or write after write). The statements of a wavefront are called from a parallel loop,
+   * which runs them on the TVM thread pool.
+   */
+  tir::Stmt CreateParallelDispatch() {
+    ICHECK_EQ(stmts_.size(), stmt_accesses_.size());
+    std::unordered_map<const tir::VarNode*, int> last_write_level;
+    std::unordered_map<const tir::VarNode*, int> last_read_level;
+    std::vector<std::vector<size_t>> levels;
+    int min_level = 0;
+    for (size_t i = 0; i < stmts_.size(); ++i) {
+      const StmtAccesses& accesses = stmt_accesses_[i];
+      int level = min_level;
+      if (accesses.barrier) {
+        level = static_cast<int>(levels.size());
+      }
+      for (const tir::VarNode* var : accesses.reads) {
+        auto it = last_write_level.find(var);
+        if (it != last_write_level.end()) level = std::max(level, it->second + 1);
+      }
+      for (const tir::VarNode* var : accesses.writes) {
+        auto it = last_write_level.find(var);
+        if (it != last_write_level.end()) level = std::max(level, it->second + 1);
+        it = last_read_level.find(var);
+        if (it != last_read_level.end()) level = std::max(level, it->second + 1);
+      }
+      if (level >= static_cast<int>(levels.size())) {
+        levels.resize(level + 1);
+      }
+      levels[level].push_back(i);
+      for (const tir::VarNode* var : accesses.reads) {
+        last_read_level[var] = std::max(last_read_level[var], level);
+      }
+      for (const tir::VarNode* var : accesses.writes) {
+        last_write_level[var] = level;
+      }
+      if (accesses.barrier) {
+        min_level = level + 1;
+      }
+    }
+
+    std::vector<tir::Stmt> waves;
+    for (const std::vector<size_t>& level : levels) {
+      if (level.size() == 1) {
+        waves.push_back(stmts_[level[0]]);
+        continue;
+      }
+      te::Var task("task", DataType::Int(32));
+      tir::Stmt dispatch = stmts_[level.back()];
+      for (int j = static_cast<int>(level.size()) - 2; j >= 0; --j) {
+        dispatch = tir::IfThenElse(task == j, stmts_[level[j]], dispatch);
+      }
+      waves.push_back(tir::For(task, 0, static_cast<int>(level.size()), tir::ForKind::kParallel,
+                               dispatch));
+    }
+    return tir::SeqStmt(waves);
   }
 
   /*
@@ -736,7 +812,7 @@ class AOTExecutorCodegen : public MixedModeVisitor {
   // the packed function calls don't pack their arguments. The AOT
   // runner function needs to be legalized by the LegalizePackedCalls pass.
   tir::PrimFunc CreateMainFunc(String mod_name, unsigned int relay_params) {
-    tir::Stmt body = tir::SeqStmt(stmts_);
+    tir::Stmt body = parallel_dispatch_ ? CreateParallelDispatch() : tir::SeqStmt(stmts_);
     // Allocate the sids
     std::unordered_map<int, bool> allocated;
 
@@ -1026,6 +1102,17 @@ class AOTExecutorCodegen : public MixedModeVisitor {
   Map<String, FunctionInfo> function_metadata_;
   /*! \brief the set of statements that make the program */
   std::vector<tir::Stmt> stmts_;
+  /*! \brief The buffers read and written by a statement of stmts_, for dependency analysis. */
+  struct StmtAccesses {
+    std::vector<const tir::VarNode*> reads;
+    std::vector<const tir::VarNode*> writes;
+    /*! \brief Whether the statement must run alone, after all the previous ones. */
+    bool barrier{false};
+  };
+  /*! \brief The accesses of each statement of stmts_. */
+  std::vector<StmtAccesses> stmt_accesses_;
+  /*! \brief Whether independent operator calls of main are dispatched in parallel. */
+  bool parallel_dispatch_{false};
   /*! \brief the list of return sids (note that the function might return more then one output */
   std::vector<int> return_sid_;
   /*! \brief This is per IO var name counter to aid the generating unique names */
@@ -1077,6 +1164,25 @@ class AOTExecutorCodegen : public MixedModeVisitor {
                     << ") is not one of the expected values";
     }
 
+    transform::PassContext pass_ctx = transform::PassContext::Current();
+
+    // Check USMP option
+    bool enable_usmp = false;
+    if (runtime_config->name == kTvmRuntimeCrt) {
+      enable_usmp = true;
+    }
+    if (pass_ctx->GetConfig<Bool>(kUSMPEnableOption) != nullptr) {
+      enable_usmp = pass_ctx->GetConfig<Bool>(kUSMPEnableOption, Bool(false)).value();
+    }
+
+    // USMP plans the workspace assuming the operators run one after the other.
+    parallel_dispatch_ = executor_config->GetAttr<Bool>("parallel-dispatch").value_or(Bool(false));
+    if (parallel_dispatch_ && (runtime_config->name != kTvmRuntimeCpp || enable_usmp)) {
+      LOG(WARNING) << "parallel-dispatch requires the c++ runtime without USMP, the operators "
+                      "will be called sequentially";
+      parallel_dispatch_ = false;
+    }
+
     mod = transform::ToANormalForm()(mod);
     mod = transform::InferType()(mod);
     mod = transform::AnnotateUsedMemory()(mod);
@@ -1096,7 +1202,6 @@ class AOTExecutorCodegen : public MixedModeVisitor {
           tec::UpdateFunctionMetadata(func, this->function_metadata_, workspace_byte_alignment);
         })(mod);
 
-    transform::PassContext pass_ctx = transform::PassContext::Current();
     bool enable_remove_reshapes =
         pass_ctx->GetConfig<Bool>("relay.remove_standalone_reshapes.enable", Bool(true)).value();
     if (enable_remove_reshapes) {
@@ -1205,18 +1310,10 @@ class AOTExecutorCodegen : public MixedModeVisitor {
     Array<tir::Var> outputs =
         Array<tir::Var>(outputs_begin_iterator, main_func_params_end_iterator - devices.size());
 
-    lowered_mod->Update(GlobalVar(::tvm::runtime::symbol::tvm_module_main), tir_main_func);
-    // Parallel for loops are not supported in AoT codegen.
+    // Parallel for loops are not supported in the operators of AoT codegen. The loops of the
+    // main function only come from parallel-dispatch, so it is added afterwards.
     lowered_mod = tir::transform::ConvertForLoopsToSerial()(lowered_mod);
-
-    // Check USMP option
-    bool enable_usmp = false;
-    if (runtime_config->name == kTvmRuntimeCrt) {
-      enable_usmp = true;
-    }
-    if (pass_ctx->GetConfig<Bool>(kUSMPEnableOption) != nullptr) {
-      enable_usmp = pass_ctx->GetConfig<Bool>(kUSMPEnableOption, Bool(false)).value();
-    }
+    lowered_mod->Update(GlobalVar(::tvm::runtime::symbol::tvm_module_main), tir_main_func);
 
     if (enable_usmp) {
       lowered_mod = PlanMemoryWithUSMP(lowered_mod);
@@ -103,7 +103,9 @@ class RelayToTIRVisitor : public MixedModeMutator {
         tvm::tir::Call(DataType::Int(num_bits), tir::builtin::call_extern(), call_extern_args));
 
     if (context_buffer_size) {
-      body = tir::Allocate(Downcast<tir::Var>(context_buffer_var), DataType::Int(num_bits),
+      // The buffer sizes of CMSIS-NN are in bytes whatever the data type of the kernel. The
+      // allocation is in the global workspace, so that USMP shares it between the calls.
+      body = tir::Allocate(Downcast<tir::Var>(context_buffer_var), DataType::Int(8),
                            {context_buffer_size}, tir::const_true(), body);
     }
 
@@ -279,9 +281,8 @@ class RelayToTIRVisitor : public MixedModeMutator {
 
     if (context_buffer_size) {
       String context_buffer_name = "context_buffer_" + std::to_string(context_buffer_id_++);
-      context_buffer_var =
-          tir::Var(context_buffer_name,
-                   PointerType(PrimType(DataType::Int(context_buffer_bits)), "global.workspace"));
+      context_buffer_var = tir::Var(context_buffer_name,
+                                    PointerType(PrimType(DataType::Int(8)), "global.workspace"));
     }
     tvm::Array<PrimExpr> context_buffer_args = {context_buffer_var, ToArg(context_buffer_size)};
 
@@ -552,6 +553,9 @@ class RelayToTIRVisitor : public MixedModeMutator {
   struct BinaryElementwiseClipPattern {
     Call binary_op;
     Optional<Call> clip_op;
+    /*! \brief The output quantization parameters, of the requantize if one is fused. */
+    Expr output_scale;
+    Expr output_zero_point;
   };
 
   BinaryElementwiseClipPattern ParseBinaryElementwiseOpClipPattern(const Expr& expr) {
@@ -560,10 +564,19 @@ class RelayToTIRVisitor : public MixedModeMutator {
     const OpNode* final_op = final_call->op.as<OpNode>();
     if (final_op->name == "clip") {
       pattern.clip_op = final_call;
+      final_call = Downcast<Call>(final_call->args[0]);
+    } else {
+      pattern.clip_op = Optional<Call>{nullptr};
+    }
+    if (final_call->op.as<OpNode>()->name == "qnn.requantize") {
+      // %2 = qnn.requantize(%1, %output_scale, %output_zero_point, %new_scale, %new_zero_point)
+      pattern.output_scale = final_call->args[3];
+      pattern.output_zero_point = final_call->args[4];
       pattern.binary_op = Downcast<Call>(final_call->args[0]);
     } else {
       pattern.binary_op = final_call;
-      pattern.clip_op = Optional<Call>{nullptr};
+      pattern.output_scale = final_call->args[6];
+      pattern.output_zero_point = final_call->args[7];
     }
     return pattern;
   }
@@ -579,8 +592,8 @@ class RelayToTIRVisitor : public MixedModeMutator {
     const int32_t input_0_zero_point = GetScalarFromConstant<int32_t>(mul_call->args[3]);
     const float input_1_scale = GetScalarFromConstant<float>(mul_call->args[4]);
     const int32_t input_1_zero_point = GetScalarFromConstant<int32_t>(mul_call->args[5]);
-    const float output_scale = GetScalarFromConstant<float>(mul_call->args[6]);
-    const int32_t output_zero_point = GetScalarFromConstant<int32_t>(mul_call->args[7]);
+    const float output_scale = GetScalarFromConstant<float>(pattern.output_scale);
+    const int32_t output_zero_point = GetScalarFromConstant<int32_t>(pattern.output_zero_point);
 
     double quantized_multiplier = static_cast<double>(input_0_scale) *
                                   static_cast<double>(input_1_scale) /
@@ -632,8 +645,8 @@ class RelayToTIRVisitor : public MixedModeMutator {
     const int32_t input_0_zero_point = GetScalarFromConstant<int32_t>(add_call->args[3]);
     const float input_1_scale = GetScalarFromConstant<float>(add_call->args[4]);
     const int32_t input_1_zero_point = GetScalarFromConstant<int32_t>(add_call->args[5]);
-    const float output_scale = GetScalarFromConstant<float>(add_call->args[6]);
-    const int32_t output_zero_point = GetScalarFromConstant<int32_t>(add_call->args[7]);
+    const float output_scale = GetScalarFromConstant<float>(pattern.output_scale);
+    const int32_t output_zero_point = GetScalarFromConstant<int32_t>(pattern.output_zero_point);
 
     const int32_t left_shift = (bit_width == 16) ? 15 : 20;
     const int32_t input_0_offset = -input_0_zero_point;
@@ -305,6 +305,21 @@ class TensorRTJSONSerializer : public JSONSerializer {
       SetAttr(node, "max_workspace_size", {std::to_string(target_attr->value)});
     }
 
+    {
+      Array<Integer> target_attr = target_->GetAttr<Array<Integer>>("batch_profile").value();
+      if (!target_attr.empty()) {
+        ICHECK_EQ(target_attr.size(), 3)
+            << "The TensorRT batch_profile must have the min, opt and max batch sizes";
+        ICHECK(0 < target_attr[0]->value && target_attr[0]->value <= target_attr[1]->value &&
+               target_attr[1]->value <= target_attr[2]->value)
+            << "The TensorRT batch_profile must satisfy 0 < min <= opt <= max, but got "
+            << target_attr;
+        SetAttr(node, "batch_profile",
+                {std::to_string(target_attr[0]->value), std::to_string(target_attr[1]->value),
+                 std::to_string(target_attr[2]->value)});
+      }
+    }
+
     {
       Bool target_attr = target_->GetAttr<Bool>("use_fp16").value();
       SetAttr(node, "use_fp16", {std::to_string(target_attr->value)});
@@ -54,6 +54,10 @@ TVM_REGISTER_TARGET_KIND("tensorrt", kDLCUDA)
     // How many bytes of workspace size to allow each subgraph to use for TensorRT engine creation.
     // Default 1G.
     .add_attr_option<Integer>("max_workspace_size", Integer(1 << 30))
+    // The min, opt and max batch sizes of the TensorRT optimization profile. If given, a single
+    // engine is built for all the batch sizes in this range, tuned for the opt batch size, instead
+    // of building an engine for each new batch size seen at inference time. Default empty.
+    .add_attr_option<Array<Integer>>("batch_profile", Array<Integer>())
     // If true, allows TensorRT to automatically convert float32 operations to float16. Must also be
     // enabled if any float16 operations are in the model. Note that TensorRT may still choose a
     // higher-precision kernel if it results in overall lower runtime, or if no low-precision
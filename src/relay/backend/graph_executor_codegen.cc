@@ -33,8 +33,10 @@
 #include <tvm/tir/analysis.h>
 #include <tvm/tir/function.h>
 
+#include <algorithm>
 #include <list>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "../op/annotation/annotation.h"
@@ -250,6 +252,7 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
     for (auto param : lowered_main_func->params) {
       auto node_ptr = GraphInputNode::make_node_ptr(param->name_hint(), GraphAttrs());
       var_map_[param.get()] = AddNode(node_ptr, param);
+      main_params_.insert(param.get());
     }
 
     heads_ = VisitExpr(lowered_main_func->body);
@@ -310,6 +313,9 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
       storage_ids.push_back(v);
     }
     node->attrs_["storage_id"] = std::move(storage_ids);
+    if (!storage_info->storage_offsets.empty()) {
+      node->attrs_["storage_offset"] = storage_info->storage_offsets;
+    }
     // type
     std::vector<int64_t> device_types;
     for (const auto& virtual_device : storage_info->virtual_devices) {
@@ -397,12 +403,15 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
     return fields;
   }
 
-  bool ShareSameStorage(const Expr& lhs, const Expr& rhs) {
+  /*! \return Whether \p lhs is stored \p view_offset bytes after the start of \p rhs. */
+  bool ShareSameStorage(const Expr& lhs, const Expr& rhs, int64_t view_offset = 0) {
     StorageInfo lit = GetStorageInfo(lhs);
     StorageInfo rit = GetStorageInfo(rhs);
     int64_t lhs_storage_id = lit->storage_ids[0];
     int64_t rhs_storage_id = rit->storage_ids[0];
-    return lhs_storage_id == rhs_storage_id;
+    int64_t lhs_offset = lit->storage_offsets.empty() ? 0 : lit->storage_offsets[0];
+    int64_t rhs_offset = rit->storage_offsets.empty() ? 0 : rit->storage_offsets[0];
+    return lhs_storage_id == rhs_storage_id && lhs_offset == rhs_offset + view_offset;
   }
 
   std::vector<GraphNodeRef> GraphAddCallNode(const CallNode* call_node, GraphAttrs attrs) {
@@ -447,6 +456,36 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
         auto node = GraphOpNode::make_node_ptr("reshape_nop", GraphAttrs(), "__nop", inputs, attrs);
         return AddNode(node, call);
       }
+      // A contiguous slice planned as a view of its input needs no kernel either.
+      int64_t view_offset = GetViewByteOffset(call_lowered_props);
+      if (view_offset >= 0 &&
+          ShareSameStorage(GetRef<Expr>(call_node), call_lowered_props.arguments[0], view_offset)) {
+        auto node = GraphOpNode::make_node_ptr("view_nop", GraphAttrs(), "__nop", inputs, attrs);
+        return AddNode(node, call);
+      }
+      // Nor does a concatenate whose arguments were computed in their slices of its result.
+      Array<Integer> concat_offsets = GetConcatByteOffsets(call_lowered_props);
+      if (!concat_offsets.empty()) {
+        bool in_place = true;
+        for (size_t i = 0; i < concat_offsets.size(); ++i) {
+          in_place &= ShareSameStorage(call_lowered_props.arguments[i], GetRef<Expr>(call_node),
+                                       concat_offsets[i]->value);
+        }
+        if (in_place) {
+          auto node =
+              GraphOpNode::make_node_ptr("concat_nop", GraphAttrs(), "__nop", inputs, attrs);
+          return AddNode(node, call);
+        }
+      }
+      // A weight layout transform of the inputs and constants only may be computed once when the
+      // parameters are loaded, as its result was planned in a storage of its own.
+      if (IsLayoutTransformOnly(call_lowered_props) &&
+          std::all_of(call_lowered_props.arguments.begin(), call_lowered_props.arguments.end(),
+                      [this](const Expr& arg) {
+                        return arg->IsInstance<ConstantNode>() || main_params_.count(arg.get());
+                      })) {
+        attrs["layout_transform_only"] = std::string("1");
+      }
     } else if (!call_node->attrs.defined()) {  // Call is an extern function
       const auto* func = call_node->op.as<GlobalVarNode>();
       ICHECK(func) << "Expected the operator to be a global var, but got "
@@ -536,6 +575,8 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
     size_t num_entry = 0;
     ShapeVector shapes;
     std::vector<size_t> storage_ids;
+    std::vector<size_t> storage_offsets;
+    bool has_storage_offset = false;
     std::vector<std::string> storage_scopes;
     std::vector<size_t> device_types;
     std::vector<std::string> dltypes;
@@ -553,6 +594,13 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
       shapes.insert(shapes.end(), shape_vec.begin(), shape_vec.end());
       dltypes.insert(dltypes.end(), dtype_vec.begin(), dtype_vec.end());
       storage_ids.insert(storage_ids.end(), storage_id.begin(), storage_id.end());
+      if (node->attrs_.count("storage_offset")) {
+        const auto& offsets = dmlc::get<std::vector<int64_t>>(node->attrs_["storage_offset"]);
+        storage_offsets.insert(storage_offsets.end(), offsets.begin(), offsets.end());
+        has_storage_offset = true;
+      } else {
+        storage_offsets.insert(storage_offsets.end(), storage_id.size(), 0);
+      }
       storage_scopes.insert(storage_scopes.end(), storage_scope.begin(), storage_scope.end());
       if (node->attrs_.count("device_index")) {
         const auto& dev_types = dmlc::get<std::vector<int64_t>>(node->attrs_["device_index"]);
@@ -581,6 +629,10 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
     attrs["shape"].emplace_back(shapes);
     attrs["storage_id"].emplace_back(std::string("list_int"));
     attrs["storage_id"].emplace_back(storage_ids);
+    if (has_storage_offset) {
+      attrs["storage_offset"].emplace_back(std::string("list_int"));
+      attrs["storage_offset"].emplace_back(storage_offsets);
+    }
     if (device_types.size()) {
       attrs["device_index"].emplace_back(std::string("list_int"));
       attrs["device_index"].emplace_back(device_types);
@@ -605,6 +657,8 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
   runtime::Module* mod_;
   /*! \brief variable map */
   std::unordered_map<const Object*, std::vector<GraphNodeRef>> var_map_;
+  /*! \brief The parameters of the main function. */
+  std::unordered_set<const Object*> main_params_;
   /*! \brief Available targets */
   CompilationConfig config_;
   /*!
@@ -29,7 +29,15 @@
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/transform.h>
 #include <tvm/runtime/container/array.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/tir/op.h>
+#include <tvm/tir/usmp/utils.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "../../runtime/texture.h"
 #include "../../support/arena.h"
@@ -51,6 +59,11 @@ using backend::StaticMemoryPlan;
 using backend::StorageInfo;
 using IntegerArray = Array<Integer>;
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.graph_memory_planning_algorithm", String);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.graph_static_workspace", Bool);
+// Whether the result of an elementwise primitive can be written over its input at its last use
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.inplace_elemwise", Bool);
+
 class StorageAllocaBaseVisitor : public transform::DeviceAwareExprVisitor {
  public:
   StorageAllocaBaseVisitor() : transform::DeviceAwareExprVisitor(Optional<IRModule>()) {}
@@ -94,32 +107,44 @@ class StorageAllocaBaseVisitor : public transform::DeviceAwareExprVisitor {
 
   void VisitExpr_(const TupleNode* op) final {
     std::vector<StorageToken*> fields;
+    std::vector<int64_t> offsets;
     for (Expr field : op->fields) {
       auto tokens = GetToken(field);
       fields.insert(fields.end(), tokens.begin(), tokens.end());
+      auto field_offsets = GetViewOffsets(field);
+      offsets.insert(offsets.end(), field_offsets.begin(), field_offsets.end());
     }
     token_map_[op] = fields;
+    SetViewOffsets(op, std::move(offsets));
   }
 
   void VisitExpr_(const TupleGetItemNode* op) final {
     const auto& tok = GetToken(op->tuple);
     ICHECK_LT(static_cast<size_t>(op->index), tok.size());
     token_map_[op] = {tok[op->index]};
+    SetViewOffsets(op, {GetViewOffsets(op->tuple)[op->index]});
   }
 
   void VisitExpr_(const IfNode* op) final { LOG(FATAL) << "if is not supported."; }
 
   void PreVisitLetBinding_(const Var& var, const Expr& value) final {
     token_map_[var.get()] = GetToken(value);
+    SetViewOffsets(var.get(), GetViewOffsets(value));
   }
 
   void PostVisitLet_(const LetNode* let_node) final {
     token_map_[let_node] = GetToken(let_node->body);
+    SetViewOffsets(let_node, GetViewOffsets(let_node->body));
   }
 
  protected:
   /*! \brief internal token map */
   std::unordered_map<const ExprNode*, std::vector<StorageToken*>> token_map_;
+  /*!
+   * \brief The byte offsets, from the start of their tokens, of the results of the expressions
+   * which are views into the storage of another expression. Absent when all are zero.
+   */
+  std::unordered_map<const ExprNode*, std::vector<int64_t>> view_offsets_;
   /*! \brief empty token map */
   const std::vector<StorageToken*> no_tokens_;
 
@@ -144,6 +169,26 @@ class StorageAllocaBaseVisitor : public transform::DeviceAwareExprVisitor {
     return it->second;
   }
 
+  /*!
+   * \brief Get the view offsets of the tokens of an expression.
+   * \param expr The expression.
+   * \return The byte offset of each token of \p expr from the start of the token.
+   */
+  std::vector<int64_t> GetViewOffsets(const Expr& expr) {
+    size_t num_tokens = GetToken(expr).size();
+    auto it = view_offsets_.find(IgnoreOnDevice(expr).get());
+    return it == view_offsets_.end() ? std::vector<int64_t>(num_tokens, 0) : it->second;
+  }
+
+  /*! \brief Set the view offsets of the tokens of \p op, forgetting them when all are zero. */
+  void SetViewOffsets(const ExprNode* op, std::vector<int64_t> offsets) {
+    if (std::any_of(offsets.begin(), offsets.end(), [](int64_t offset) { return offset != 0; })) {
+      view_offsets_[op] = std::move(offsets);
+    } else {
+      view_offsets_.erase(op);
+    }
+  }
+
   /*!
    * \brief Allocates (or reuses if \p can_realloc is true) a storage token for holding
    * the result of evaluating \p op.
@@ -229,7 +274,15 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     VLOG_CONTEXT << "StorageAllocator";
     VLOG(1) << "planning:" << std::endl << PrettyPrint(func);
     prototype_ = StorageAllocaInit(&arena_).GetInitTokenMap(func);
+    transform::PassContext pass_ctx = transform::PassContext::Current();
+    allocator_.SetPackingAlgorithm(
+        pass_ctx->GetConfig<String>("relay.backend.graph_memory_planning_algorithm", String(""))
+            .value(),
+        pass_ctx->GetConfig<Bool>("relay.backend.graph_static_workspace", Bool(false)).value());
+    inplace_ = pass_ctx->GetConfig<Bool>("relay.backend.inplace_elemwise", Bool(false)).value();
+    PlanConcatSlices(func);
     this->Run(func);
+    allocator_.Pack();
 
     // The value of smap contains two integer arrays where the first array
     // contains the planned storage ids and the second holds the device types.
@@ -238,14 +291,23 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     int num_nodes = 0;
 
     for (const auto& kv : token_map_) {
+      auto view_it = view_offsets_.find(kv.first);
       std::vector<int64_t> storage_ids;
       storage_ids.reserve(kv.second.size());
       std::vector<VirtualDevice> virtual_devices;
       virtual_devices.reserve(kv.second.size());
       std::vector<int64_t> sid_sizes_byte;
       sid_sizes_byte.reserve(kv.second.size());
-
-      for (StorageToken* tok : kv.second) {
+      std::vector<int64_t> storage_offsets;
+      storage_offsets.reserve(kv.second.size());
+      bool has_offset = false;
+
+      for (size_t i = 0; i < kv.second.size(); ++i) {
+        StorageToken* tok = kv.second[i];
+        int64_t offset = tok->byte_offset;
+        if (view_it != view_offsets_.end()) {
+          offset += view_it->second[i];
+        }
         VLOG(1) << "token: " << tok->ToString();
         if (tok->is_valid()) {
           num_annotated_nodes++;
@@ -254,9 +316,15 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
         storage_ids.push_back(tok->storage_id);
         virtual_devices.push_back(tok->virtual_device);
         sid_sizes_byte.push_back(allocator_.GetMemorySize(tok));
+        storage_offsets.push_back(offset);
+        has_offset |= offset != 0;
+      }
+      if (!has_offset) {
+        storage_offsets.clear();
       }
-      auto storage_info = backend::StorageInfo(std::move(storage_ids), std::move(virtual_devices),
-                                               std::move(sid_sizes_byte));
+      auto storage_info =
+          backend::StorageInfo(std::move(storage_ids), std::move(virtual_devices),
+                               std::move(sid_sizes_byte), std::move(storage_offsets));
       smap.Set(GetRef<Expr>(kv.first), storage_info);
     }
     // Either all or none of the nodes should be annotated.
@@ -287,8 +355,12 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
         // Allocate a new token,
         StorageToken* allocated_tok = allocator_.Alloc(tok);
         allocated_tok->virtual_device = tok->virtual_device;
+        if (op->IsInstance<ConstantNode>()) {
+          allocator_.MarkConstant(allocated_tok);
+        }
         // ensure it never get de-allocated.
         allocated_tok->ref_counter += 1;
+        fixed_tokens_.insert(allocated_tok);
         tokens.push_back(allocated_tok);
       }
     }
@@ -336,9 +408,36 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     // opaque-nd memory planning to skip this path.
     // TODO(mbs): "reshape" cleanup.
     CallLoweredProps call_lowered_props = GetCallLoweredProps(call_node);
-    if (call_lowered_props.lowered_func.defined() && IsReshapeOnly(call_lowered_props)) {
+    auto slice_it = concat_slices_.find(call_node);
+    if (slice_it != concat_slices_.end()) {
+      // The result is written directly into its slice of the concatenate which is its only use.
+      ReuseInputToken(call_node, GetConcatToken(slice_it->second.first));
+      SetViewOffsets(call_node, {slice_it->second.second});
+    } else if (auto concat_it = concat_tokens_.find(call_node); concat_it != concat_tokens_.end()) {
+      // All the arguments of the concatenate are already in place in its result.
+      token_map_[call_node] = {concat_it->second};
+    } else if (call_lowered_props.lowered_func.defined() && IsReshapeOnly(call_lowered_props)) {
       ICHECK_EQ(call_lowered_props.arguments.size(), 1U);
       ReuseInputToken(call_node, args[0]);
+      SetViewOffsets(call_node, GetViewOffsets(call_lowered_props.arguments[0]));
+    } else if (int64_t offset = GetViewByteOffset(call_lowered_props);
+               call_lowered_props.lowered_func.defined() && offset >= 0 &&
+               call_lowered_props.arguments.size() == 1 && args.size() == 1 &&
+               !fixed_tokens_.count(args[0]) && TokenAllocator::CanPack(args[0])) {
+      // Likewise a contiguous slice is a view of its input at an offset, on the devices whose
+      // memory can be offset. The inputs of the function and the constants are not aliased, as
+      // they can be replaced at runtime.
+      ReuseInputToken(call_node, args[0]);
+      SetViewOffsets(call_node, {GetViewOffsets(call_lowered_props.arguments[0])[0] + offset});
+    } else if (StorageToken* tok = FindInplaceToken(call_node, call_lowered_props)) {
+      ReuseInputToken(call_node, tok);
+    } else if (call_lowered_props.lowered_func.defined() &&
+               IsLayoutTransformOnly(call_lowered_props) && !args.empty() &&
+               std::all_of(args.begin(), args.end(),
+                           [this](StorageToken* tok) { return fixed_tokens_.count(tok) > 0; })) {
+      // The weight layout transform of a parameter is computed once when the parameters are
+      // loaded, so its result must survive across runs like the parameter itself.
+      CreateToken(call_node, false);
     } else {
       // create token for the call node.
       CreateToken(call_node, true);
@@ -354,18 +453,116 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     }
   }
 
+  /*!
+   * \brief Finds the concatenates whose arguments can all be computed directly into their slices
+   * of the result, so that the concatenate needs no copy. Each argument must be the result of a
+   * call which is only used by the concatenate, which is not itself a view of another token, and
+   * which is on the same device, whose memory can be offset.
+   */
+  void PlanConcatSlices(const Function& func) {
+    PostOrderVisit(func->body, [this](const Expr& expr) {
+      const auto* call_node = expr.as<CallNode>();
+      if (call_node == nullptr) {
+        return;
+      }
+      CallLoweredProps props = GetCallLoweredProps(call_node);
+      Array<Integer> offsets = GetConcatByteOffsets(props);
+      auto proto_it = prototype_.find(call_node);
+      if (!props.lowered_func.defined() || offsets.size() != props.arguments.size() ||
+          offsets.empty() || proto_it == prototype_.end() || proto_it->second.size() != 1 ||
+          !TokenAllocator::CanPack(proto_it->second[0])) {
+        return;
+      }
+      std::vector<const CallNode*> producers;
+      for (const Expr& arg : props.arguments) {
+        const auto* producer = IgnoreOnDevice(arg).as<CallNode>();
+        if (producer == nullptr) {
+          return;
+        }
+        CallLoweredProps producer_props = GetCallLoweredProps(producer);
+        auto it = prototype_.find(producer);
+        if (!producer_props.lowered_func.defined() || IsReshapeOnly(producer_props) ||
+            GetViewByteOffset(producer_props) >= 0 ||
+            !GetConcatByteOffsets(producer_props).empty() || it == prototype_.end() ||
+            it->second.size() != 1 || it->second[0]->ref_counter != 1 ||
+            it->second[0]->virtual_device != proto_it->second[0]->virtual_device) {
+          return;
+        }
+        producers.push_back(producer);
+      }
+      for (size_t i = 0; i < producers.size(); ++i) {
+        concat_slices_[producers[i]] = {call_node, offsets[i]->value};
+      }
+    });
+  }
+
+  /*! \brief Returns the token of the result of \p concat, requesting it at its first use. */
+  StorageToken* GetConcatToken(const CallNode* concat) {
+    auto it = concat_tokens_.find(concat);
+    if (it == concat_tokens_.end()) {
+      it = concat_tokens_.emplace(concat, allocator_.Request(prototype_.at(concat)[0])).first;
+    }
+    return it->second;
+  }
+
+  /*!
+   * \brief Returns the token of an argument of \p call_node which can receive its result, as the
+   * call is the last use of the token, or nullptr if there is none.
+   */
+  StorageToken* FindInplaceToken(const CallNode* call_node,
+                                 const CallLoweredProps& call_lowered_props) {
+    if (!inplace_ || !call_lowered_props.lowered_func.defined()) {
+      return nullptr;
+    }
+    const std::vector<StorageToken*>& protos = prototype_.at(call_node);
+    if (protos.size() != 1) {
+      return nullptr;
+    }
+    for (const Integer& index : GetInplaceParams(call_lowered_props)) {
+      const Expr& arg = call_lowered_props.arguments[index.IntValue()];
+      const std::vector<StorageToken*>& toks = GetToken(arg);
+      if (toks.size() != 1) {
+        continue;
+      }
+      StorageToken* tok = toks[0];
+      // The graph inputs, the constants and the aliased tokens still used elsewhere are kept.
+      if (tok->ref_counter == 1 && !fixed_tokens_.count(tok) && GetViewOffsets(arg)[0] == 0 &&
+          tok->is_compatible(*protos[0]) && !TokenAllocator::Is2DStorage(tok)) {
+        return tok;
+      }
+    }
+    return nullptr;
+  }
+
   class TokenAllocator {
    public:
     StorageToken* Alloc(StorageToken* proto) {
-      return Is2DStorage(proto) ? token_2d_.Alloc(proto, storage_ids_++)
-                                : token_1d_.Alloc(proto, storage_ids_++);
+      StorageToken* token = Is2DStorage(proto) ? token_2d_.Alloc(proto, storage_ids_++)
+                                               : token_1d_.Alloc(proto, storage_ids_++);
+      tokens_.push_back(token);
+      if (!packing_algorithm_.empty() && !Is2DStorage(token)) {
+        lifetimes_[token] = {clock_++, -1};
+      }
+      return token;
     }
     StorageToken* Request(StorageToken* proto) {
+      if (!packing_algorithm_.empty() && !Is2DStorage(proto)) {
+        // Tokens are packed by their lifetimes once all are known, rather than reused.
+        return this->Alloc(proto);
+      }
       StorageToken* token =
           Is2DStorage(proto) ? token_2d_.Request(proto) : token_1d_.Request(proto);
       return token ? token : this->Alloc(proto);
     }
     void CheckForRelease(StorageToken* tok) {
+      if (!packing_algorithm_.empty() && !Is2DStorage(tok)) {
+        ICHECK_GE(tok->ref_counter, 0);
+        auto it = lifetimes_.find(tok);
+        if (tok->ref_counter == 0 && it != lifetimes_.end() && it->second.second < 0) {
+          it->second.second = clock_++;
+        }
+        return;
+      }
       return Is2DStorage(tok) ? token_2d_.CheckForRelease(tok) : token_1d_.CheckForRelease(tok);
     }
 
@@ -380,10 +577,169 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
       return relay::Is2DStorage(tok->virtual_device->memory_scope);
     }
 
+    /*!
+     * \brief Sets the tir.usmp.algo algorithm used to pack the 1D tokens into one storage per
+     * device at byte offsets, or the empty string to reuse whole tokens of matching size instead.
+     * \param static_workspace Whether the inputs and outputs are packed with the intermediates,
+     * so that all the tensors but the constants are in one workspace per device. It packs with
+     * greedy_by_size when no algorithm is given.
+     */
+    void SetPackingAlgorithm(String algorithm, bool static_workspace) {
+      static_workspace_ = static_workspace;
+      if (static_workspace_ && algorithm.empty()) {
+        algorithm = "greedy_by_size";
+      }
+      if (!algorithm.empty()) {
+        CHECK(runtime::Registry::Get("tir.usmp.algo." + algorithm))
+            << "ValueError: unknown memory planning algorithm " << algorithm
+            << ", expected one of greedy_by_size, greedy_by_conflicts, hill_climb or hybrid";
+      }
+      packing_algorithm_ = std::move(algorithm);
+    }
+
+    /*! \brief Marks \p tok as holding a constant, which is looked up by its storage id. */
+    void MarkConstant(StorageToken* tok) { constants_.insert(tok); }
+
+    /*!
+     * \brief Packs the tokens which are released before the end of the function, and so have
+     * a known lifetime, into one storage per device. The offsets are chosen by the packing
+     * algorithm such that tokens with overlapping lifetimes don't overlap in memory. In a static
+     * workspace, the tokens never released but the constants live until the end of the function.
+     */
+    void Pack() {
+      if (packing_algorithm_.empty()) {
+        return;
+      }
+      const runtime::PackedFunc* algorithm =
+          runtime::Registry::Get("tir.usmp.algo." + packing_algorithm_);
+      std::unordered_map<VirtualDevice, std::vector<StorageToken*>, ObjectPtrHash, ObjectPtrEqual>
+          device_tokens;
+      std::vector<VirtualDevice> devices;
+      for (StorageToken* tok : tokens_) {
+        auto it = lifetimes_.find(tok);
+        if (it == lifetimes_.end() || !CanPack(tok)) {
+          continue;
+        }
+        if (it->second.second < 0) {
+          if (!static_workspace_ || constants_.count(tok)) {
+            continue;
+          }
+          it->second.second = clock_;
+        }
+        std::vector<StorageToken*>& toks = device_tokens[tok->virtual_device];
+        if (toks.empty()) {
+          devices.push_back(tok->virtual_device);
+        }
+        toks.push_back(tok);
+      }
+      for (const VirtualDevice& virtual_device : devices) {
+        const std::vector<StorageToken*>& toks = device_tokens[virtual_device];
+        if (toks.size() < 2) {
+          continue;
+        }
+        PackTokens(*algorithm, toks);
+      }
+      // Renumber the storage ids densely, in the order they were first allocated.
+      std::unordered_map<int64_t, int64_t> new_storage_ids;
+      for (StorageToken* tok : tokens_) {
+        auto it = new_storage_ids.emplace(tok->storage_id, new_storage_ids.size()).first;
+        tok->storage_id = it->second;
+      }
+    }
+
+    /*!
+     * \brief Returns true if tensors can be placed at byte offsets into the storage of \p tok.
+     * This needs a known device whose memory can be addressed with plain pointer arithmetic.
+     */
+    static bool CanPack(StorageToken* tok) {
+      if (!tok->virtual_device->memory_scope.empty() &&
+          tok->virtual_device->memory_scope != "global") {
+        return false;
+      }
+      switch (tok->virtual_device->device_type()) {
+        case kDLCPU:
+        case kDLCUDA:
+        case kDLCUDAHost:
+        case kDLCUDAManaged:
+        case kDLROCM:
+        case kDLROCMHost:
+          return true;
+        default:
+          return false;
+      }
+    }
+
    private:
+    /*! \brief Packs \p toks, which are all on the same device, into a fresh storage id. */
+    void PackTokens(const runtime::PackedFunc& algorithm, const std::vector<StorageToken*>& toks) {
+      std::vector<StorageToken*> sorted = toks;
+      std::sort(sorted.begin(), sorted.end(), [this](StorageToken* lhs, StorageToken* rhs) {
+        return lifetimes_.at(lhs).first < lifetimes_.at(rhs).first;
+      });
+      PoolInfo pool = WorkspacePoolInfo("graph_plan_memory", {});
+      std::vector<tir::usmp::BufferInfo> buffer_infos;
+      std::vector<Array<ObjectRef>> conflicts(sorted.size());
+      // Sweep over the lifetimes, which are closed intervals, to find the conflicts and the
+      // maximum number of bytes live at once.
+      std::vector<size_t> live;
+      int64_t live_bytes = 0;
+      int64_t memory_pressure = 0;
+      for (size_t i = 0; i < sorted.size(); ++i) {
+        int64_t start = lifetimes_.at(sorted[i]).first;
+        auto last = std::remove_if(live.begin(), live.end(), [&](size_t j) {
+          if (lifetimes_.at(sorted[j]).second < start) {
+            live_bytes -= buffer_infos[j]->size_bytes->value;
+            return true;
+          }
+          return false;
+        });
+        live.erase(last, live.end());
+        int64_t size = static_cast<int64_t>(GetMemorySize(sorted[i]));
+        buffer_infos.emplace_back("sid_" + std::to_string(sorted[i]->storage_id),
+                                  IntImm(DataType::Int(64), size), Array<PoolInfo>{pool},
+                                  Integer(runtime::kAllocAlignment));
+        for (size_t j : live) {
+          conflicts[i].push_back(buffer_infos[j]);
+          conflicts[j].push_back(buffer_infos[i]);
+        }
+        live.push_back(i);
+        live_bytes += size;
+        memory_pressure = std::max(memory_pressure, live_bytes);
+      }
+      for (size_t i = 0; i < sorted.size(); ++i) {
+        buffer_infos[i]->SetConflicts(conflicts[i]);
+      }
+      Map<tir::usmp::BufferInfo, tir::usmp::PoolAllocation> allocations =
+          algorithm(Array<tir::usmp::BufferInfo>(buffer_infos),
+                    IntImm(DataType::Int(64), memory_pressure));
+      int64_t storage_id = storage_ids_++;
+      int64_t total_bytes = 0;
+      for (size_t i = 0; i < sorted.size(); ++i) {
+        sorted[i]->storage_id = storage_id;
+        sorted[i]->byte_offset = allocations.at(buffer_infos[i])->byte_offset->value;
+        total_bytes = std::max<int64_t>(
+            total_bytes, sorted[i]->byte_offset + buffer_infos[i]->size_bytes->value);
+      }
+      VLOG(1) << "packed " << sorted.size() << " tokens on " << sorted[0]->virtual_device
+              << " into " << total_bytes << " bytes, for " << memory_pressure
+              << " bytes live at most";
+    }
+
     int64_t storage_ids_{0};
     TokenAllocator1D token_1d_;
     TokenAllocator2D token_2d_;
+    /*! \brief All the allocated tokens, in allocation order. */
+    std::vector<StorageToken*> tokens_;
+    /*! \brief The tir.usmp.algo packing algorithm, or empty if tokens are reused instead. */
+    String packing_algorithm_;
+    /*! \brief Whether the inputs and outputs are packed too. */
+    bool static_workspace_{false};
+    /*! \brief The tokens of the constants, which keep their own storage ids. */
+    std::unordered_set<StorageToken*> constants_;
+    /*! \brief The allocation and release times of the 1D tokens, -1 if never released. */
+    std::unordered_map<StorageToken*, std::pair<int64_t, int64_t>> lifetimes_;
+    /*! \brief The time of the next allocation or release. */
+    int64_t clock_{0};
   };
 
  private:
@@ -393,6 +749,14 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
   // size_t match_range_{16};
   // free list of storage entry
   std::multimap<size_t, StorageToken*> free_;
+  /*! \brief The tokens of the parameters and constants, which are never reused. */
+  std::unordered_set<StorageToken*> fixed_tokens_;
+  /*! \brief Whether elementwise primitives write their result over an input at its last use. */
+  bool inplace_{false};
+  /*! \brief The concatenate and the byte offset in its result of the calls computed in place. */
+  std::unordered_map<const CallNode*, std::pair<const CallNode*, int64_t>> concat_slices_;
+  /*! \brief The tokens of the results of the concatenates whose arguments are computed in place. */
+  std::unordered_map<const CallNode*, StorageToken*> concat_tokens_;
   // all the storage resources available
   std::vector<StorageToken*> data_;
   /*! \brief internal prototype token map */
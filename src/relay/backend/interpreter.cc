@@ -23,6 +23,8 @@
  */
 
 #include <tvm/driver/driver_api.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/attrs/annotation.h>
 #include <tvm/relay/attrs/call.h>
@@ -38,11 +40,16 @@
 #include <tvm/runtime/object.h>
 #include <tvm/target/compilation_config.h>
 
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 #include "../op/annotation/annotation.h"
 #include "../op/call/call.h"
 #include "../op/memory/device_copy.h"
 #include "../transforms/pass_utils.h"
 #include "te_compiler.h"
+#include "utils.h"
 
 namespace tvm {
 namespace relay {
@@ -123,6 +130,87 @@ ObjectRef ToADTOrNDArray(const Type& type, const std::vector<NDArray>& nd_arrays
   }
 }
 
+/*!
+ * \brief The runtime modules built by the interpreters, shared by all the evaluations.
+ *
+ * Constant folding, partial evaluation and shape evaluation run every expression in a fresh
+ * interpreter, which would otherwise build the same primitives again and again. The modules are
+ * keyed by the target, the lowered TIR module and the pass context they are built under, compared
+ * structurally. The modules built under a pass context with instruments, or with configs that
+ * cannot be compared structurally, e.g. "tir.add_lower_pass", are not cached.
+ */
+class CompiledModuleCache {
+ public:
+  /*! \brief The cache is cleared when it reaches this number of modules. */
+  static constexpr size_t kMaxEntries = 128;
+
+  static CompiledModuleCache* Global() {
+    static CompiledModuleCache* inst = new CompiledModuleCache();
+    return inst;
+  }
+
+  runtime::Module GetOrBuild(const IRModule& mod, const Target& target,
+                             const std::function<runtime::Module()>& f_build) {
+    Optional<Array<ObjectRef>> context =
+        backend::PassContextFingerprint(tvm::transform::PassContext::Current());
+    if (!context.defined()) {
+      return f_build();
+    }
+    Key key{target->str(), mod, context.value()};
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = modules_.find(key);
+      if (it != modules_.end()) {
+        return it->second;
+      }
+    }
+    // Build without the lock, a concurrent build of the same module is merely redundant.
+    runtime::Module module = f_build();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (modules_.size() >= kMaxEntries) {
+      modules_.clear();
+    }
+    modules_.emplace(std::move(key), module);
+    return module;
+  }
+
+  size_t Size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return modules_.size();
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    modules_.clear();
+  }
+
+ private:
+  struct Key {
+    std::string target;
+    IRModule mod;
+    /*! \brief The opt level, required and disabled passes and config of the pass context. */
+    Array<ObjectRef> context;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      size_t hash =
+          dmlc::HashCombine(std::hash<std::string>()(key.target), StructuralHash()(key.mod));
+      return dmlc::HashCombine(hash, StructuralHash()(key.context));
+    }
+  };
+
+  struct KeyEqual {
+    bool operator()(const Key& lhs, const Key& rhs) const {
+      return lhs.target == rhs.target && StructuralEqual()(lhs.mod, rhs.mod) &&
+             StructuralEqual()(lhs.context, rhs.context);
+    }
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<Key, runtime::Module, KeyHash, KeyEqual> modules_;
+};
+
 }  // namespace
 
 InterpreterClosure::InterpreterClosure(Map<Var, ObjectRef> env, Function func) {
@@ -403,14 +491,16 @@ class Interpreter : public ExprFunctor<ObjectRef(const Expr& n)>,
       lowered_projected_mod->Add(var, target_module->Lookup(var->name_hint));
     }
 
-    // Compile (aka 'build') the projected module into a runtime module of packed functions.
-    runtime::Module runtime_module;
-    if (const auto* f = runtime::Registry::Get("relay.backend.build")) {
-      // TODO(mbs): Cleanup hooks.
-      runtime_module = (*f)(lowered_projected_mod, target);
-    } else {
-      runtime_module = build(lowered_projected_mod, target, /*target_host=*/Target(nullptr));
-    }
+    // Compile (aka 'build') the projected module into a runtime module of packed functions,
+    // unless an earlier evaluation has already built the same module.
+    runtime::Module runtime_module = CompiledModuleCache::Global()->GetOrBuild(
+        lowered_projected_mod, target, [&]() -> runtime::Module {
+          if (const auto* f = runtime::Registry::Get("relay.backend.build")) {
+            // TODO(mbs): Cleanup hooks.
+            return (*f)(lowered_projected_mod, target);
+          }
+          return build(lowered_projected_mod, target, /*target_host=*/Target(nullptr));
+        });
 
     // Extract all the packed functions.
     for (const auto& var : all_tir_fn_vars) {
@@ -1120,5 +1210,13 @@ ObjectRef Eval(Expr expr, Map<GlobalTypeVar, TypeData> type_definitions,
 
 TVM_REGISTER_GLOBAL("relay.backend.EvalFunction").set_body_typed(EvalFunction);
 
+TVM_REGISTER_GLOBAL("relay.backend.InterpreterCompiledCacheSize").set_body_typed([]() {
+  return static_cast<int64_t>(CompiledModuleCache::Global()->Size());
+});
+
+TVM_REGISTER_GLOBAL("relay.backend.InterpreterClearCompiledCache").set_body_typed([]() {
+  CompiledModuleCache::Global()->Clear();
+});
+
 }  // namespace relay
 }  // namespace tvm
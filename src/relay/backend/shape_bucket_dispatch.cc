@@ -0,0 +1,277 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file relay/backend/shape_bucket_dispatch.cc
+ * \brief Specialization of dynamic-shape PrimFuncs over shape buckets, and their dispatch.
+ */
+#include "./shape_bucket_dispatch.h"
+
+#include <tvm/ir/transform.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/schedule/schedule.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <unordered_set>
+
+#include "../../meta_schedule/trace_apply.h"
+#include "./utils.h"
+
+namespace tvm {
+namespace relay {
+namespace backend {
+
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.meta_schedule_shape_buckets", Array<Integer>);
+
+/*!
+ * \brief Replace the buffers of a specialized kernel with the ones of the dispatching PrimFunc.
+ * Inside the branch of a bucket the two agree on their shape, and they share their data.
+ */
+class ShapeBucketBufferReplacer : public tir::StmtExprMutator {
+ public:
+  static tir::Stmt Rewrite(const tir::PrimFunc& kernel, const tir::PrimFunc& generic) {
+    ShapeBucketBufferReplacer replacer;
+    for (size_t i = 0; i < generic->params.size(); ++i) {
+      Optional<tir::Buffer> from = kernel->buffer_map.Get(kernel->params[i]);
+      Optional<tir::Buffer> to = generic->buffer_map.Get(generic->params[i]);
+      if (from.defined() && to.defined()) {
+        replacer.buffer_map_.Set(from.value(), to.value());
+      }
+    }
+    return replacer(kernel->body);
+  }
+
+ private:
+  tir::Buffer Replace(const tir::Buffer& buffer) const {
+    if (Optional<tir::Buffer> result = buffer_map_.Get(buffer)) {
+      return result.value();
+    }
+    return buffer;
+  }
+
+  Array<tir::BufferRegion> Replace(const Array<tir::BufferRegion>& regions) const {
+    return regions.Map([this](const tir::BufferRegion& region) {
+      return tir::BufferRegion(Replace(region->buffer), region->region);
+    });
+  }
+
+  tir::Stmt VisitStmt_(const tir::BufferStoreNode* op) final {
+    tir::BufferStore store = Downcast<tir::BufferStore>(StmtExprMutator::VisitStmt_(op));
+    store.CopyOnWrite()->buffer = Replace(store->buffer);
+    return std::move(store);
+  }
+
+  PrimExpr VisitExpr_(const tir::BufferLoadNode* op) final {
+    tir::BufferLoad load = Downcast<tir::BufferLoad>(StmtExprMutator::VisitExpr_(op));
+    load.CopyOnWrite()->buffer = Replace(load->buffer);
+    return std::move(load);
+  }
+
+  tir::Stmt VisitStmt_(const tir::BlockNode* op) final {
+    tir::Block block = Downcast<tir::Block>(StmtExprMutator::VisitStmt_(op));
+    tir::BlockNode* n = block.CopyOnWrite();
+    n->reads = Replace(n->reads);
+    n->writes = Replace(n->writes);
+    n->match_buffers = n->match_buffers.Map([this](const tir::MatchBufferRegion& match) {
+      return tir::MatchBufferRegion(
+          match->buffer, tir::BufferRegion(Replace(match->source->buffer), match->source->region));
+    });
+    return std::move(block);
+  }
+
+  /*! \brief The buffers of the kernel, mapped to the ones of the dispatching PrimFunc */
+  Map<tir::Buffer, tir::Buffer> buffer_map_;
+};
+
+/*!
+ * \brief Schedule a PrimFunc with its tuning record in the database.
+ * \note The blocks rewriting the layout of the weights (see the RewriteLayout postproc) are kept
+ * in the kernel, instead of being removed in favor of weights pre-transformed by Relay as for the
+ * static-shape kernels. The records of the buckets may each pick a different layout, while all the
+ * kernels of the dispatch share the signature of the generic one, so the weights are passed in
+ * their original layout and each kernel rewrites them on every call.
+ * \return The scheduled PrimFunc, or NullOpt if the database has no applicable record.
+ */
+Optional<tir::PrimFunc> ApplyShapeBucketRecord(const tir::PrimFunc& f, const Target& target,
+                                               const meta_schedule::Database& database,
+                                               const meta_schedule::ModuleEquality& mod_eq,
+                                               const String& workload_name) {
+  IRModule query_mod = PrimFuncToIRModule(f);
+  Optional<meta_schedule::TuningRecord> opt_record =
+      database->QueryTuningRecord(query_mod, target, workload_name);
+  if (!opt_record.defined()) {
+    return NullOpt;
+  }
+  meta_schedule::TuningRecord record = opt_record.value();
+  tir::Schedule sch = tir::Schedule::Traced(query_mod, /*seed=*/-1, /*debug_mask=*/0,
+                                            tir::ScheduleErrorRenderLevel::kDetail);
+  if (!mod_eq.Equal(query_mod, record->workload->mod)) {
+    meta_schedule::ScheduleUsingAnchorTrace(sch, record->trace, target);
+  } else {
+    record->trace->ApplyToSchedule(sch, /*remove_postproc=*/false);
+  }
+  IRModule mod = sch->mod();
+  ICHECK_EQ(mod->functions.size(), 1);
+  return Downcast<tir::PrimFunc>(mod->Lookup("main"));
+}
+
+Array<Integer> GetShapeBuckets() {
+  return transform::PassContext::Current()
+      ->GetConfig<Array<Integer>>("relay.backend.meta_schedule_shape_buckets", Array<Integer>())
+      .value();
+}
+
+Optional<tir::Var> GetDynamicShapeVar(const tir::PrimFunc& f) {
+  std::unordered_set<const tir::VarNode*> params;
+  for (const tir::Var& param : f->params) {
+    params.insert(param.get());
+  }
+  Optional<tir::Var> result = NullOpt;
+  for (const tir::Var& param : f->params) {
+    Optional<tir::Buffer> buffer = f->buffer_map.Get(param);
+    if (!buffer.defined()) {
+      continue;
+    }
+    for (const PrimExpr& dim : buffer.value()->shape) {
+      if (dim->IsInstance<IntImmNode>()) {
+        continue;
+      }
+      const auto* var = dim.as<tir::VarNode>();
+      if (var == nullptr || params.count(var)) {
+        return NullOpt;
+      }
+      if (result.defined() && result.value().get() != var) {
+        return NullOpt;
+      }
+      result = GetRef<tir::Var>(var);
+    }
+  }
+  return result;
+}
+
+tir::PrimFunc SpecializeShapeBucket(const tir::PrimFunc& f, const tir::Var& var, int64_t value) {
+  CHECK_GT(value, 0) << "ValueError: The shape buckets must be positive, but gets: " << value;
+  for (const tir::Var& param : f->params) {
+    Optional<tir::Buffer> buffer = f->buffer_map.Get(param);
+    if (!buffer.defined()) {
+      continue;
+    }
+    bool has_var = false;
+    Array<PrimExpr> shape = buffer.value()->shape.Map([&](const PrimExpr& dim) -> PrimExpr {
+      if (dim.same_as(var)) {
+        has_var = true;
+        return IntImm(var.dtype(), value);
+      }
+      return dim;
+    });
+    if (has_var) {
+      // Copying the buffer keeps its data var, so that the kernels of all the buckets read and
+      // write the buffers of the dispatching PrimFunc
+      ObjectPtr<tir::BufferNode> n = make_object<tir::BufferNode>(*buffer.value().get());
+      n->shape = std::move(shape);
+      // Specializing one buffer binds the variable in all the others
+      return tir::Specialize(f, {{param, tir::Buffer(n)}});
+    }
+  }
+  LOG(FATAL) << "ValueError: The shape variable " << var << " is not a dimension of any buffer";
+  throw;
+}
+
+tir::PrimFunc MakeShapeBucketDispatch(const tir::PrimFunc& generic, const tir::Var& var,
+                                      const Array<Integer>& buckets,
+                                      const Array<tir::PrimFunc>& kernels) {
+  CHECK_EQ(buckets.size(), kernels.size())
+      << "ValueError: Expect one kernel per shape bucket, but gets " << kernels.size()
+      << " kernels for " << buckets.size() << " buckets";
+  tir::Stmt body = ShapeBucketBufferReplacer::Rewrite(generic, generic);
+  for (int i = static_cast<int>(kernels.size()) - 1; i >= 0; --i) {
+    CHECK_EQ(kernels[i]->params.size(), generic->params.size())
+        << "ValueError: The kernel of shape bucket " << buckets[i]
+        << " doesn't have the signature of the generic kernel";
+    body = tir::IfThenElse(var == IntImm(var.dtype(), buckets[i]->value),
+                           ShapeBucketBufferReplacer::Rewrite(kernels[i], generic), body);
+  }
+  tir::PrimFunc result = generic;
+  result.CopyOnWrite()->body =
+      tir::BlockRealize(/*iter_values=*/{}, /*predicate=*/Bool(true),
+                        tir::Block(/*iter_vars=*/{}, /*reads=*/{}, /*writes=*/{},
+                                   /*name_hint=*/"root", /*body=*/body));
+  return result;
+}
+
+Optional<tir::PrimFunc> ScheduleShapeBuckets(const tir::PrimFunc& f, const Target& target,
+                                             const meta_schedule::Database& database,
+                                             const meta_schedule::ModuleEquality& mod_eq,
+                                             const String& workload_name) {
+  Array<Integer> all_buckets = GetShapeBuckets();
+  if (all_buckets.empty()) {
+    return NullOpt;
+  }
+  Optional<tir::Var> opt_var = GetDynamicShapeVar(f);
+  if (!opt_var.defined()) {
+    return NullOpt;
+  }
+  tir::Var var = opt_var.value();
+  Array<Integer> buckets;
+  Array<tir::PrimFunc> kernels;
+  for (const Integer& bucket : all_buckets) {
+    tir::PrimFunc specialized = SpecializeShapeBucket(f, var, bucket->value);
+    if (Optional<tir::PrimFunc> kernel =
+            ApplyShapeBucketRecord(specialized, target, database, mod_eq, workload_name)) {
+      buckets.push_back(bucket);
+      kernels.push_back(kernel.value());
+    } else {
+      LOG(WARNING) << "Cannot find workload: " << workload_name << " for shape bucket " << var
+                   << " = " << bucket;
+    }
+  }
+  if (kernels.empty()) {
+    return NullOpt;
+  }
+  Optional<tir::PrimFunc> generic =
+      ApplyShapeBucketRecord(f, target, database, mod_eq, workload_name);
+  if (!generic.defined()) {
+    // Unscheduled TIR is only valid on CPU, GPU kernels have to bind their threads
+    if (target->GetTargetDeviceType() != kDLCPU) {
+      LOG(WARNING) << "Shape bucket dispatch of " << workload_name
+                   << " needs a tuning record of the generic kernel on " << target->kind->name;
+      return NullOpt;
+    }
+    generic = f;
+  }
+  return MakeShapeBucketDispatch(generic.value(), var, buckets, kernels);
+}
+
+TVM_REGISTER_GLOBAL("relay.backend.SpecializeShapeBucket")
+    .set_body_typed([](tir::PrimFunc f, int64_t value) {
+      Optional<tir::Var> var = GetDynamicShapeVar(f);
+      CHECK(var.defined()) << "ValueError: Expect a PrimFunc with a single dynamic shape variable";
+      return SpecializeShapeBucket(f, var.value(), value);
+    });
+TVM_REGISTER_GLOBAL("relay.backend.MakeShapeBucketDispatch")
+    .set_body_typed([](tir::PrimFunc generic, Array<Integer> buckets,
+                       Array<tir::PrimFunc> kernels) {
+      Optional<tir::Var> var = GetDynamicShapeVar(generic);
+      CHECK(var.defined()) << "ValueError: Expect a PrimFunc with a single dynamic shape variable";
+      return MakeShapeBucketDispatch(generic, var.value(), buckets, kernels);
+    });
+
+}  // namespace backend
+}  // namespace relay
+}  // namespace tvm
@@ -0,0 +1,98 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file relay/backend/shape_bucket_dispatch.h
+ * \brief Specialization of dynamic-shape PrimFuncs over a set of shape buckets, and the dispatch
+ * between the kernels tuned for each bucket.
+ *
+ * When `relay.backend.meta_schedule_shape_buckets` is set, task extraction emits one task per
+ * bucket for every PrimFunc whose buffers have a single dynamic shape variable. At compile time,
+ * the tuned kernels of the buckets are gathered into one PrimFunc that branches on the runtime
+ * value of the shape variable, and runs the generic kernel for every other value.
+ */
+#ifndef TVM_RELAY_BACKEND_SHAPE_BUCKET_DISPATCH_H_
+#define TVM_RELAY_BACKEND_SHAPE_BUCKET_DISPATCH_H_
+
+#include <tvm/meta_schedule/database.h>
+#include <tvm/target/target.h>
+#include <tvm/tir/function.h>
+
+#include "../../meta_schedule/module_equality.h"
+
+namespace tvm {
+namespace relay {
+namespace backend {
+
+/*!
+ * \brief The shape buckets configured by `relay.backend.meta_schedule_shape_buckets`.
+ * \return The values of the dynamic shape variable to specialize on, empty if not configured.
+ */
+Array<Integer> GetShapeBuckets();
+
+/*!
+ * \brief Find the dynamic shape variable of a PrimFunc.
+ * \param f The PrimFunc.
+ * \return The only variable that appears as a dimension of the buffers of the PrimFunc, or NullOpt
+ * if there is none, several, or a dimension is an expression other than a variable.
+ */
+Optional<tir::Var> GetDynamicShapeVar(const tir::PrimFunc& f);
+
+/*!
+ * \brief Specialize a PrimFunc for a value of its dynamic shape variable.
+ * \param f The PrimFunc.
+ * \param var The dynamic shape variable, as returned by GetDynamicShapeVar.
+ * \param value The value of the variable.
+ * \return The specialized PrimFunc, whose buffers share their data with the ones of `f`.
+ */
+tir::PrimFunc SpecializeShapeBucket(const tir::PrimFunc& f, const tir::Var& var, int64_t value);
+
+/*!
+ * \brief Gather the kernels of the shape buckets into a dispatching PrimFunc.
+ * \param generic The kernel for any value of the dynamic shape variable, whose signature is kept.
+ * \param var The dynamic shape variable.
+ * \param buckets The values of the variable the kernels are specialized for.
+ * \param kernels The specialized kernels, in the order of `buckets`.
+ * \return The PrimFunc running the kernel of the bucket matching the runtime value of `var`, or
+ * the generic kernel if there is none.
+ */
+tir::PrimFunc MakeShapeBucketDispatch(const tir::PrimFunc& generic, const tir::Var& var,
+                                      const Array<Integer>& buckets,
+                                      const Array<tir::PrimFunc>& kernels);
+
+/*!
+ * \brief Schedule a dynamic-shape PrimFunc with the tuning records of its shape buckets.
+ * \param f The PrimFunc.
+ * \param target The compilation target.
+ * \param database The database to query the records of the buckets from.
+ * \param mod_eq The module equality to check whether a record applies as is.
+ * \param workload_name The name of the workload.
+ * \return The dispatching PrimFunc, or NullOpt if the buckets are not configured, `f` is not
+ * dynamic, or no record of its buckets is found.
+ */
+Optional<tir::PrimFunc> ScheduleShapeBuckets(const tir::PrimFunc& f, const Target& target,
+                                             const meta_schedule::Database& database,
+                                             const meta_schedule::ModuleEquality& mod_eq,
+                                             const String& workload_name);
+
+}  // namespace backend
+}  // namespace relay
+}  // namespace tvm
+
+#endif  // TVM_RELAY_BACKEND_SHAPE_BUCKET_DISPATCH_H_
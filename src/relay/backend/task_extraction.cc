@@ -18,15 +18,20 @@
  */
 #include <tvm/ir/name_supply.h>
 #include <tvm/meta_schedule/extracted_task.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/relay/expr.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/function.h>
 #include <tvm/target/target.h>
 
+#include <algorithm>
 #include <numeric>
+#include <unordered_map>
 
 #include "../../meta_schedule/module_equality.h"
 #include "../../te/operation/create_primfunc.h"
+#include "./shape_bucket_dispatch.h"
 #include "./te_compiler_cache.h"
 #include "./utils.h"
 
@@ -76,6 +81,11 @@ Array<meta_schedule::ExtractedTask> ExtractTask(IRModule mod, Target target,
   std::vector<std::tuple<std::string, Function, IRModule>> lower_results;
 
   NameSupply constant_name_supply("");
+  // Repeated layers fuse into structurally equal primitive functions, which are lowered to TIR
+  // only once. Each of them is still counted in the weight of its task below.
+  std::unordered_map<Function, std::pair<Optional<tir::PrimFunc>, std::string>, StructuralHash,
+                     StructuralEqual>
+      lowered;
 
   PostOrderVisit(mod->Lookup("main"), [&](const Expr& exp) {
     if (exp->IsInstance<FunctionNode>()) {
@@ -84,7 +94,13 @@ Array<meta_schedule::ExtractedTask> ExtractTask(IRModule mod, Target target,
         return;
       }
 
-      auto [f, fused_name] = tec::LowerToPrimFunc(relay_func, target, constant_name_supply);
+      auto it = lowered.find(relay_func);
+      if (it == lowered.end()) {
+        it = lowered.emplace(relay_func, tec::LowerToPrimFunc(relay_func, target,
+                                                              constant_name_supply))
+                 .first;
+      }
+      const auto& [f, fused_name] = it->second;
       if (f) {
         IRModule tir_mod = PrimFuncToIRModule(f.value());
         lower_results.push_back(std::make_tuple(fused_name, relay_func, tir_mod));
@@ -113,18 +129,41 @@ Array<meta_schedule::ExtractedTask> ExtractTask(IRModule mod, Target target,
               [&op_counts](int i1, int i2) { return op_counts[i1] < op_counts[i2]; });
   }
 
+  Array<Integer> shape_buckets = GetShapeBuckets();
+
   for (auto i : indices) {
     const auto& [fused_name, relay_func, tir_mod] = lower_results[i];
-    auto it = cache.find(tir_mod);
-    if (it != cache.end()) {
-      it->second->weight += 1;
-      continue;
+    std::vector<std::pair<std::string, IRModule>> candidates{{fused_name, tir_mod}};
+    // A dynamic-shape function is also tuned for each of the shape buckets it dispatches on
+    tir::PrimFunc prim_func = Downcast<tir::PrimFunc>(tir_mod->Lookup("main"));
+    if (Optional<tir::Var> var = shape_buckets.empty() ? NullOpt : GetDynamicShapeVar(prim_func)) {
+      for (const Integer& bucket : shape_buckets) {
+        tir::PrimFunc specialized = SpecializeShapeBucket(prim_func, var.value(), bucket->value);
+        candidates.emplace_back(fused_name + "_" + std::string(var.value()->name_hint) +
+                                    std::to_string(bucket->value),
+                                PrimFuncToIRModule(specialized));
+      }
+    }
+    for (const auto& [task_name, task_mod] : candidates) {
+      auto it = cache.find(task_mod);
+      if (it != cache.end()) {
+        ExtractedTask task = it->second;
+        task->weight += 1;
+        // The subgraphs only sharing the anchor block are kept, so the trace tuned on the first
+        // one can later be transferred to and refined on each of them
+        if (mod_eq_name == "anchor-block" &&
+            std::none_of(task->dispatched.begin(), task->dispatched.end(),
+                         [&](const IRModule& m) { return StructuralEqual()(m, task_mod); })) {
+          task->dispatched.push_back(task_mod);
+        }
+        continue;
+      }
+      // Note that the cache is key-ed on the tir mod, rather than the relay mod
+      IRModule relay_mod({{GlobalVar(fused_name), relay_func}});
+      ExtractedTask task(task_name, relay_mod, target, {task_mod}, 1);
+      tasks.push_back(task);
+      cache.emplace(task_mod, task);
     }
-    // Note that the cache is key-ed on the tir mod, rather than the relay mod
-    IRModule relay_mod({{GlobalVar(fused_name), relay_func}});
-    ExtractedTask task(fused_name, relay_mod, target, {tir_mod}, 1);
-    tasks.push_back(task);
-    cache.emplace(tir_mod, task);
   }
 
   // Tasks are extracted via post order visit, return the reversed list.
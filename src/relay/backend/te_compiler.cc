@@ -93,6 +93,7 @@
 #include <tvm/ir/attrs.h>
 #include <tvm/ir/function.h>
 #include <tvm/ir/name_supply.h>
+#include <tvm/meta_schedule/database.h>
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/attrs/annotation.h>
 #include <tvm/relay/attrs/call.h>
@@ -133,19 +134,115 @@ using namespace tvm::relay::transform;
 
 TVM_REGISTER_OBJECT_TYPE(TECompilerNode);
 
+/*!
+ * \brief What the schedules of a build depend on besides the primitive functions themselves: the
+ * pass context and the meta schedule database, with its number of records so that re-tuning into
+ * the same database is noticed.
+ */
+struct BuildFingerprint {
+  Array<ObjectRef> pass_ctx;
+  Optional<meta_schedule::Database> database;
+  int64_t database_size = 0;
+
+  bool Matches(const BuildFingerprint& other) const {
+    return database.same_as(other.database) && database_size == other.database_size &&
+           StructuralEqual()(pass_ctx, other.pass_ctx);
+  }
+};
+
+/*!
+ * \brief The primitive functions lowered by the last incremental build of each module name.
+ *
+ * With the "relay.backend.incremental_build" pass config, a build reuses the \p CachedFunc of
+ * every primitive function whose \p CCacheKey (the structural hash of the function and its
+ * target) is unchanged since the previous build of the same module name, provided the build has
+ * the same \p BuildFingerprint. This skips the scheduling, tuning database lookup and lowering of
+ * the function. Its object code is reused by "tir.codegen_cache_dir" (see driver/codegen_cache.cc).
+ *
+ * The AutoTVM dispatch context lives in Python and is not part of the fingerprint, so the cache
+ * has to be cleared when the AutoTVM records change.
+ *
+ * Only the functions of the last successful build are kept, so the cache does not grow with the
+ * number of edits of a model.
+ */
+class IncrementalBuildCache {
+ public:
+  static IncrementalBuildCache* Global() {
+    static IncrementalBuildCache* inst = new IncrementalBuildCache();
+    return inst;
+  }
+
+  Optional<CachedFunc> Lookup(const std::string& mod_name, const BuildFingerprint& fingerprint,
+                              const CCacheKey& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = builds_.find(mod_name);
+    if (it == builds_.end() || !it->second.fingerprint.Matches(fingerprint)) return NullOpt;
+    auto func_it = it->second.funcs.find(key);
+    if (func_it == it->second.funcs.end()) return NullOpt;
+    return func_it->second;
+  }
+
+  /*! \brief Replace the functions of \p mod_name by the ones of the build that just finished. */
+  void Commit(const std::string& mod_name, BuildFingerprint fingerprint,
+              std::unordered_map<CCacheKey, CachedFunc> funcs, int64_t num_reused) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_stats_ = {{"lowered", Integer(static_cast<int>(funcs.size() - num_reused))},
+                   {"reused", Integer(static_cast<int>(num_reused))}};
+    builds_[mod_name] = Build{std::move(fingerprint), std::move(funcs)};
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    builds_.clear();
+    last_stats_ = {};
+  }
+
+  /*! \brief The number of primitive functions lowered and reused by the last build. */
+  Map<String, Integer> LastStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_stats_;
+  }
+
+ private:
+  struct Build {
+    BuildFingerprint fingerprint;
+    std::unordered_map<CCacheKey, CachedFunc> funcs;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, Build> builds_;
+  Map<String, Integer> last_stats_;
+};
+
 class TECompilerImpl : public TECompilerNode {
  public:
   explicit TECompilerImpl(Optional<IRModule> opt_mod, Optional<String> opt_mod_name)
       : global_var_supply_(GlobalVarSupply(NameSupply(opt_mod_name.value_or("")))),
-        constant_name_supply_(NameSupply("")) {
+        constant_name_supply_(NameSupply("")),
+        mod_name_(opt_mod_name.value_or("")) {
     // Make sure we don't collide with any existing globals in the module.
     if (opt_mod) {
+      InitIncremental();
       for (const auto& kv : opt_mod.value()->functions) {
         global_var_supply_->name_supply_->ReserveName(kv.first->name_hint, false);
       }
     }
   }
 
+  void CommitIncrementalBuild() final {
+    if (!incremental_) return;
+    std::unordered_map<CCacheKey, CachedFunc> lowered;
+    for (const auto& kv : cache_) {
+      // Functions of external codegen are compiled later from their Relay definition.
+      if (kv.second->cached_func.defined() &&
+          !kv.first->source_func->GetAttr<String>(attr::kCompiler).defined()) {
+        lowered.emplace(kv.first, kv.second->cached_func);
+      }
+    }
+    IncrementalBuildCache::Global()->Commit(mod_name_, fingerprint_, std::move(lowered),
+                                            num_reused_);
+  }
+
   // Lower the function.
   CachedFunc Lower(const CCacheKey& key) {
     return LowerInternal(key, global_var_supply_)->cached_func;
@@ -387,6 +484,12 @@ class TECompilerImpl : public TECompilerNode {
       return value;
     }
 
+    if (incremental_ && ReuseIncremental(key, value, global_var_supply)) {
+      VLOG(1) << "reused from the previous build:" << std::endl
+              << PrettyPrint(value->cached_func->prim_fn_var);
+      return value;
+    }
+
     // Enforce use the target.
     With<Target> target_scope(key->target);
 
@@ -469,6 +572,59 @@ class TECompilerImpl : public TECompilerNode {
     return value;
   }
 
+  /*!
+   * \brief Take the lowered functions of \p key from the previous incremental build.
+   * \return Whether \p value was filled. The previous GlobalVars are kept, so they are not
+   * reused if their names are already taken in this build.
+   */
+  bool ReuseIncremental(const CCacheKey& key, const CCacheValue& value,
+                        const GlobalVarSupply& global_var_supply) {
+    Optional<CachedFunc> opt_prev =
+        IncrementalBuildCache::Global()->Lookup(mod_name_, fingerprint_, key);
+    if (!opt_prev) return false;
+    CachedFunc prev = opt_prev.value();
+    for (const auto& kv : prev->funcs->functions) {
+      if (global_var_supply->name_supply_->ContainsName(kv.first->name_hint, false)) return false;
+    }
+    for (const auto& kv : prev->funcs->functions) {
+      global_var_supply->ReserveGlobalVar(kv.first);
+    }
+    // The IRModule is copied as later passes may add to it.
+    auto n = make_object<CachedFuncNode>(*prev.operator->());
+    n->funcs = IRModule(prev->funcs->functions);
+    n->constant_tensors.clear();
+    value->cached_func = CachedFunc(n);
+    num_reused_++;
+    return true;
+  }
+
+  /*! \brief Read "relay.backend.incremental_build" and the fingerprint of this build. */
+  void InitIncremental() {
+    tvm::transform::PassContext pass_ctx = tvm::transform::PassContext::Current();
+    if (!pass_ctx->GetConfig<Bool>("relay.backend.incremental_build", Bool(false)).value()) {
+      return;
+    }
+    if (backend::IsAutoSchedulerEnabled()) {
+      LOG(WARNING) << "relay.backend.incremental_build is ignored with the auto scheduler, whose "
+                      "dispatch context cannot be compared across builds";
+      return;
+    }
+    Optional<Array<ObjectRef>> opt_pass_ctx = backend::PassContextFingerprint(pass_ctx);
+    if (!opt_pass_ctx) {
+      LOG(WARNING) << "relay.backend.incremental_build is ignored under a pass context with "
+                      "instruments or configs that cannot be compared across builds";
+      return;
+    }
+    fingerprint_.pass_ctx = opt_pass_ctx.value();
+    if (backend::IsMetaScheduleEnabled()) {
+      fingerprint_.database = meta_schedule::Database::Current();
+      if (fingerprint_.database) {
+        fingerprint_.database_size = fingerprint_.database.value()->Size();
+      }
+    }
+    incremental_ = true;
+  }
+
   // implement lowered shape func
   CCacheValue LowerShapeFuncInternal(const CCacheKey& key) {
     VLOG(1) << "lowering dynamic shape function for:" << std::endl
@@ -534,6 +690,14 @@ class TECompilerImpl : public TECompilerNode {
   CCacheKey cur_ccache_key_;
   /*! \brief Map of GlobalVar to C Device API context names */
   Map<GlobalVar, String> device_contexts_;
+  /*! \brief The name of the module being built, which keys the incremental build cache. */
+  std::string mod_name_;
+  /*! \brief Whether "relay.backend.incremental_build" is set and can be honored. */
+  bool incremental_ = false;
+  /*! \brief What the schedules of this build depend on besides the primitive functions. */
+  BuildFingerprint fingerprint_;
+  /*! \brief Number of primitive functions taken from the previous build. */
+  int64_t num_reused_ = 0;
 };
 
 TECompiler::TECompiler(Optional<IRModule> opt_mod, Optional<String> mod_name) {
@@ -552,6 +716,15 @@ TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.use_auto_scheduler", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.use_meta_schedule", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.use_meta_schedule_dispatch", Integer);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.tir_converter", String);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.incremental_build", Bool);
+
+TVM_REGISTER_GLOBAL("relay.backend._IncrementalBuildStats").set_body_typed([]() {
+  return IncrementalBuildCache::Global()->LastStats();
+});
+
+TVM_REGISTER_GLOBAL("relay.backend._IncrementalBuildClear").set_body_typed([]() {
+  IncrementalBuildCache::Global()->Clear();
+});
 
 TVM_REGISTER_GLOBAL("relay.backend._TECompilerGlobal").set_body_typed([]() {
   return TECompiler::Global();
@@ -1266,6 +1439,9 @@ IRModule LowerTE(const IRModule& module, const String& module_name, ProcessFn pr
     updated_module = WithAttr(updated_module, "op_weights", std::move(op_weights));
   }
 
+  // Only a build that lowered all its functions replaces the previous one.
+  compiler->CommitIncrementalBuild();
+
   return updated_module;
 }
 
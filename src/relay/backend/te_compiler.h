@@ -125,6 +125,12 @@ class TECompilerNode : public Object {
 
   virtual Map<String, Integer> GetOpWeights() const = 0;
 
+  /*!
+   * \brief Keep the primitive functions lowered by this compiler for the next build of the same
+   * module under "relay.backend.incremental_build". Called once the build has succeeded.
+   */
+  virtual void CommitIncrementalBuild() = 0;
+
   /*! \brief clear the cache. */
   virtual void Clear() = 0;
 
@@ -56,6 +56,7 @@
 #include "../src/meta_schedule/module_equality.h"
 #include "../src/meta_schedule/trace_apply.h"
 #include "../transforms/meta_schedule_layout_rewrite.h"
+#include "./shape_bucket_dispatch.h"
 #include "utils.h"
 
 namespace tvm {
@@ -535,7 +536,13 @@ class ScheduleBuilder : public ExprVisitor {
         }
         if (Optional<PrimFunc> f = tir_converter(te_args, constants)) {
           IRModule query_mod = backend::PrimFuncToIRModule(f.value());
-          if (Optional<TuningRecord> opt_record = database_.value()->QueryTuningRecord(
+          if (Optional<PrimFunc> dispatch = backend::ScheduleShapeBuckets(
+                  f.value(), target_, database_.value(), *mod_eq_structural_,
+                  prim_fn_var->name_hint)) {
+            // The kernels tuned for `relay.backend.meta_schedule_shape_buckets`, dispatched on
+            // the runtime value of the dynamic shape variable
+            prim_func = WithAttrs(dispatch.value(), relay_func->attrs->dict);
+          } else if (Optional<TuningRecord> opt_record = database_.value()->QueryTuningRecord(
                   /*mod=*/query_mod,
                   /*target=*/target_,
                   /*workload_name=*/prim_fn_var->name_hint)) {
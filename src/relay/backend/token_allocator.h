@@ -50,6 +50,9 @@ struct StorageToken {
   VirtualDevice virtual_device = VirtualDevice::FullyUnconstrained();
   /*! \brief The storage id */
   int64_t storage_id{-1};
+  /*! \brief The byte offset within the storage id, non-zero only when several tokens are packed
+   * into the storage of one storage id */
+  int64_t byte_offset{0};
 
   bool is_valid() const { return !virtual_device->IsFullyUnconstrained(); }
 
@@ -59,7 +62,8 @@ struct StorageToken {
 
   std::string ToString() const {
     std::ostringstream os;
-    os << "{storage_id: " << storage_id << ", max_bytes: " << max_bytes
+    os << "{storage_id: " << storage_id << ", byte_offset: " << byte_offset
+       << ", max_bytes: " << max_bytes
        << ", ttype: " << PrettyPrint(ttype) << ", virtual_device: " << virtual_device << "}";
     return os.str();
   }
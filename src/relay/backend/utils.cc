@@ -30,6 +30,8 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <algorithm>
+
 #include "../../te/operation/create_primfunc.h"
 
 namespace tvm {
@@ -54,18 +56,27 @@ TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
       for (auto bytes : node->storage_sizes_in_bytes) {
         p->stream << bytes << ",";
       }
+      if (!node->storage_offsets.empty()) {
+        p->stream << "], storage_offsets=[";
+        for (auto offset : node->storage_offsets) {
+          p->stream << offset << ",";
+        }
+      }
       p->stream << "])";
     });
 
 StorageInfo::StorageInfo(std::vector<int64_t> storage_ids,
                          std::vector<VirtualDevice> virtual_devices,
-                         std::vector<int64_t> storage_sizes_in_bytes) {
+                         std::vector<int64_t> storage_sizes_in_bytes,
+                         std::vector<int64_t> storage_offsets) {
   ICHECK_EQ(storage_ids.size(), virtual_devices.size());
   ICHECK_EQ(storage_ids.size(), storage_sizes_in_bytes.size());
+  ICHECK(storage_offsets.empty() || storage_ids.size() == storage_offsets.size());
   auto node = make_object<StorageInfoNode>();
   node->storage_ids = std::move(storage_ids);
   node->virtual_devices = std::move(virtual_devices);
   node->storage_sizes_in_bytes = std::move(storage_sizes_in_bytes);
+  node->storage_offsets = std::move(storage_offsets);
   data_ = std::move(node);
 }
 
@@ -117,6 +128,14 @@ TVM_REGISTER_GLOBAL("relay.ir.StorageInfoStorageSizes").set_body_typed([](Storag
   return storage_sizes_in_bytes;
 });
 
+TVM_REGISTER_GLOBAL("relay.ir.StorageInfoStorageOffsets").set_body_typed([](StorageInfo si) {
+  Array<tvm::Integer> storage_offsets;
+  for (auto offset : si->storage_offsets) {
+    storage_offsets.push_back(offset);
+  }
+  return storage_offsets;
+});
+
 TVM_REGISTER_GLOBAL("relay.ir.StorageInfoVirtualDevices").set_body_typed([](StorageInfo si) {
   Array<VirtualDevice> virtual_devices;
   for (auto id : si->virtual_devices) {
@@ -261,6 +280,7 @@ Array<Pass> GetPassPrefix(bool is_homogeneous, bool is_vm) {
   pass_seqs.push_back(transform::CombineParallelConv2D(3));
   pass_seqs.push_back(transform::CombineParallelDense(3));
   pass_seqs.push_back(transform::CombineParallelBatchMatmul(3));
+  pass_seqs.push_back(transform::CombineIndependentDense(3));
   pass_seqs.push_back(transform::FoldConstant());
   pass_seqs.push_back(transform::FoldScaleAxis());
   pass_seqs.push_back(transform::SimplifyExpr());
@@ -275,12 +295,20 @@ Array<Pass> GetPassPrefix(bool is_homogeneous, bool is_vm) {
     }
     pass_seqs.push_back(transform::AlterOpLayout());
     pass_seqs.push_back(transform::SimplifyExprPostAlterOp());
+    pass_seqs.push_back(transform::PlanLayoutTransforms());
   }
 
   // Fast math optimizations.
   pass_seqs.push_back(transform::FastMath());
   pass_seqs.push_back(transform::FoldConstant());
 
+  // Trade recomputation of cheap ops for activation memory, once no pass merges them back.
+  Optional<Integer> memory_budget = transform::PassContext::Current()->GetConfig<Integer>(
+      "relay.Rematerialize.memory_budget");
+  if (memory_budget.defined()) {
+    pass_seqs.push_back(transform::Rematerialize(memory_budget.value()));
+  }
+
   return pass_seqs;
 }
 
@@ -432,6 +460,36 @@ Optional<tir::PrimFunc> DefaultTIRConverterImpl(const Array<te::Tensor>& args,
   return func;
 }
 
+/*! \brief Whether a config value is compared by its value rather than by its identity. */
+static bool IsPlainConfigValue(const ObjectRef& value) {
+  if (value->IsInstance<IntImmNode>() || value->IsInstance<FloatImmNode>() ||
+      value->IsInstance<runtime::StringObj>()) {
+    return true;
+  }
+  if (const auto* arr = value.as<ArrayNode>()) {
+    return std::all_of(arr->begin(), arr->end(), IsPlainConfigValue);
+  }
+  if (const auto* map = value.as<MapNode>()) {
+    return std::all_of(map->begin(), map->end(), [](const auto& kv) {
+      return IsPlainConfigValue(kv.first) && IsPlainConfigValue(kv.second);
+    });
+  }
+  return false;
+}
+
+Optional<Array<ObjectRef>> PassContextFingerprint(const transform::PassContext& pass_ctx) {
+  if (!pass_ctx->instruments.empty()) {
+    return NullOpt;
+  }
+  for (const auto& kv : pass_ctx->config) {
+    if (!IsPlainConfigValue(kv.second)) {
+      return NullOpt;
+    }
+  }
+  return Array<ObjectRef>{Integer(pass_ctx->opt_level), pass_ctx->required_pass,
+                          pass_ctx->disabled_pass, pass_ctx->config};
+}
+
 TVM_REGISTER_GLOBAL("relay.backend.tir_converter.default")
     .set_body_typed([](const Array<te::Tensor>& args,
                        const Array<runtime::NDArray>& constants) -> Optional<tir::PrimFunc> {
@@ -212,6 +212,11 @@ class StorageInfoNode : public Object {
   std::vector<VirtualDevice> virtual_devices;
   /* \brief The sizes of each storage element, in bytes. */
   std::vector<int64_t> storage_sizes_in_bytes;
+  /*!
+   * \brief The byte offsets of each storage element within its storage id. Empty if all are zero,
+   * which is the case unless the memory planner packs several live tensors into one storage id.
+   */
+  std::vector<int64_t> storage_offsets;
 
   // TODO(@jroesch): expose the fields
   void VisitAttrs(AttrVisitor* v) {}
@@ -224,7 +229,8 @@ class StorageInfoNode : public Object {
 class StorageInfo : public ObjectRef {
  public:
   StorageInfo(std::vector<int64_t> storage_ids, std::vector<VirtualDevice> virtual_devices,
-              std::vector<int64_t> storage_sizes_in_bytes);
+              std::vector<int64_t> storage_sizes_in_bytes,
+              std::vector<int64_t> storage_offsets = {});
   TVM_DEFINE_OBJECT_REF_METHODS(StorageInfo, ObjectRef, StorageInfoNode);
 };
 
@@ -641,6 +647,15 @@ inline int UseMetaScheduleDispatch() {
       .value()
       ->value;
 }
+
+/*!
+ * \brief The part of a pass context a build depends on, i.e. its opt level, required and disabled
+ * passes and config, to be compared structurally with the one of another build.
+ * \param pass_ctx The pass context.
+ * \return The fingerprint, or NullOpt if the pass context has instruments or config values that
+ * cannot be compared by value, e.g. the passes in "tir.add_lower_pass".
+ */
+Optional<Array<ObjectRef>> PassContextFingerprint(const transform::PassContext& pass_ctx);
 /*!
  * \brief Method in TECompiler to convert TE compute to scheduleable TIR
  * \param args The arguments of the TE compute
@@ -37,8 +37,10 @@
 #include <tvm/relay/transform.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/vm/vm.h>
+#include <tvm/support/parallel_for.h>
 #include <tvm/te/operation.h>
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -234,13 +236,66 @@ std::vector<int64_t> ToAllocTensorShape(NDArray shape) {
   return raw_shape;
 }
 
+/*!
+ * \brief Returns the "device index" of \p virtual_device in \p virtual_devices, adding it if
+ * required. Note that the host device is always at index 0.
+ */
+Index GetOrAddVirtualDevice(std::vector<VirtualDevice>* virtual_devices,
+                            const VirtualDevice& virtual_device,
+                            const VirtualDevice& host_virtual_device) {
+  ICHECK(!virtual_device->IsFullyUnconstrained());
+  auto itr = std::find(virtual_devices->begin(), virtual_devices->end(), virtual_device);
+  if (itr != virtual_devices->end()) {
+    return std::distance(virtual_devices->begin(), itr);
+  }
+
+  ICHECK_GT(virtual_devices->size(), 0);
+  ICHECK_NE(virtual_device, host_virtual_device);  // the host scope is always at index 0
+
+  if (virtual_device->device_type() == virtual_devices->front()->device_type()) {
+    // It's ok if we see distinct scopes which share the host device type. This is because
+    // we allow the VirtualDevice for the host to be different from the VirtualDevice for
+    // primitive operations which both happen to be on the same device (typically CPU).
+    return 0;
+  }
+
+  // However, otherwise we allow at most one VirtualDevice per device type.
+  // TODO(mbs): This will eventually need to account for memory scopes somehow so device_copy
+  // instructions can do the right thing.
+  itr = std::find_if(virtual_devices->begin() + 1, virtual_devices->end(),
+                     [&virtual_device](const VirtualDevice& existing_virtual_device) {
+                       return existing_virtual_device->device_type() ==
+                              virtual_device->device_type();
+                     });
+  CHECK(itr == virtual_devices->end())
+      << "The VM does not currently support using more than one device with the same device type "
+         "for primitives, however the program is using the distinct scopes "
+      << virtual_device << " and " << *itr << " of device type " << virtual_device->device_type();
+
+  ICHECK(virtual_device != host_virtual_device);
+  Index index = virtual_devices->size();
+  VLOG(2) << "virtual_device[" << index << "] = " << virtual_device;
+  virtual_devices->push_back(virtual_device);
+
+  return index;
+}
+
 class VMFunctionCompiler : DeviceAwareExprFunctor<void(const Expr& n)> {
  public:
-  VMFunctionCompiler(VMCompilerContext* context, VirtualDevice host_virtual_device)
+  /*!
+   * \brief Create a compiler of one function.
+   * \param context The shared meta data.
+   * \param host_virtual_device The VirtualDevice of the host.
+   * \param tables The context the constants, primitives and devices used by the function are
+   * added to, or nullptr to add them to \p context. The rest of it is unused.
+   */
+  VMFunctionCompiler(VMCompilerContext* context, VirtualDevice host_virtual_device,
+                     VMCompilerContext* tables = nullptr)
       : DeviceAwareExprFunctor(context->module),
         last_register_(0),
         registers_num_(0),
         context_(context),
+        tables_(tables != nullptr ? tables : context),
         host_virtual_device_(std::move(host_virtual_device)) {}
 
   VMFunction Compile(const GlobalVar& var, const Function& func) {
@@ -335,42 +390,7 @@ class VMFunctionCompiler : DeviceAwareExprFunctor<void(const Expr& n)> {
    * in emitted code. Note that the host device is always at index 0.
    */
   Index GetDeviceIndex(const VirtualDevice& virtual_device) {
-    ICHECK(!virtual_device->IsFullyUnconstrained());
-    auto itr = std::find(context_->virtual_devices_.begin(), context_->virtual_devices_.end(),
-                         virtual_device);
-    if (itr != context_->virtual_devices_.end()) {
-      return std::distance(context_->virtual_devices_.begin(), itr);
-    }
-
-    ICHECK_GT(context_->virtual_devices_.size(), 0);
-    ICHECK_NE(virtual_device, host_virtual_device_);  // the host scope is always at index 0
-
-    if (virtual_device->device_type() == context_->virtual_devices_.front()->device_type()) {
-      // It's ok if we see distinct scopes which share the host device type. This is because
-      // we allow the VirtualDevice for the host to be different from the VirtualDevice for
-      // primitive operations which both happen to be on the same device (typically CPU).
-      return 0;
-    }
-
-    // However, otherwise we allow at most one VirtualDevice per device type.
-    // TODO(mbs): This will eventually need to account for memory scopes somehow so device_copy
-    // instructions can do the right thing.
-    itr = std::find_if(context_->virtual_devices_.begin() + 1, context_->virtual_devices_.end(),
-                       [&virtual_device](const VirtualDevice& existing_virtual_device) {
-                         return existing_virtual_device->device_type() ==
-                                virtual_device->device_type();
-                       });
-    CHECK(itr == context_->virtual_devices_.end())
-        << "The VM does not currently support using more than one device with the same device type "
-           "for primitives, however the program is using the distinct scopes "
-        << virtual_device << " and " << *itr << " of device type " << virtual_device->device_type();
-
-    ICHECK(virtual_device != host_virtual_device_);
-    Index index = context_->virtual_devices_.size();
-    VLOG(2) << "virtual_device[" << index << "] = " << virtual_device;
-    context_->virtual_devices_.push_back(virtual_device);
-
-    return index;
+    return GetOrAddVirtualDevice(&tables_->virtual_devices_, virtual_device, host_virtual_device_);
   }
 
   using DeviceAwareExprFunctor<void(const Expr&)>::VisitExpr_;
@@ -378,12 +398,12 @@ class VMFunctionCompiler : DeviceAwareExprFunctor<void(const Expr& n)> {
   void VisitExpr_(const ConstantNode* const_node) final {
     // Check the shape is valid
     NDArray data = const_node->data;
-    size_t const_index = context_->constants.size();
+    size_t const_index = tables_->constants.size();
     auto con = GetRef<Constant>(const_node);
     Index device_index = GetDeviceIndex(GetVirtualDevice(con));
     VLOG(2) << "constant[" << const_index << "] on device[" << device_index << "]";
-    context_->const_device_indexes.push_back(device_index);
-    context_->constants.push_back(const_node->data);
+    tables_->const_device_indexes.push_back(device_index);
+    tables_->constants.push_back(const_node->data);
     Emit(Instruction::LoadConst(const_index, NewRegister()));
   }
 
@@ -516,10 +536,10 @@ class VMFunctionCompiler : DeviceAwareExprFunctor<void(const Expr& n)> {
     }
 
     Index op_index;
-    auto itr = context_->primitive_map.find(global_var_node->name_hint);
-    if (itr == context_->primitive_map.end()) {
-      op_index = context_->primitive_map.size();
-      context_->primitive_map.emplace(global_var_node->name_hint, op_index);
+    auto itr = tables_->primitive_map.find(global_var_node->name_hint);
+    if (itr == tables_->primitive_map.end()) {
+      op_index = tables_->primitive_map.size();
+      tables_->primitive_map.emplace(global_var_node->name_hint, op_index);
     } else {
       op_index = itr->second;
     }
@@ -823,6 +843,8 @@ class VMFunctionCompiler : DeviceAwareExprFunctor<void(const Expr& n)> {
   size_t registers_num_;
   /*! \brief Global shared meta data */
   VMCompilerContext* context_;
+  /*! \brief The constants, primitives and devices used by the function are added to. */
+  VMCompilerContext* tables_;
   /*! \brief VirtualDevice for data and computation which must reside on a CPU. */
   VirtualDevice host_virtual_device_;
 };
@@ -919,15 +941,24 @@ void VMCompiler::LowerImpl(IRModule mod) {
   // the global state.
   exec_->functions.resize(num_functions);
 
+  std::vector<std::pair<GlobalVar, Function>> funcs;
   for (const auto& pair : context_.module->functions) {
-    auto gvar = pair.first;
     if (auto opt = pair.second.as<Function>()) {
-      auto func = opt.value();
-      if (func->HasNonzeroAttr(attr::kExtern)) {
-        // Already compiled during lowering.
-        continue;
+      // Extern functions are already compiled during lowering.
+      if (!opt.value()->HasNonzeroAttr(attr::kExtern)) {
+        funcs.emplace_back(pair.first, opt.value());
       }
+    }
+  }
 
+  int num_jobs = transform::PassContext::Current()
+                     ->GetConfig<Integer>("relay.vm.num_parallel_jobs", Integer(1))
+                     .value()
+                     ->value;
+  if (num_jobs > 1 && funcs.size() > 1) {
+    CompileFunctionsInParallel(funcs, num_jobs);
+  } else {
+    for (const auto& [gvar, func] : funcs) {
       VMFunctionCompiler func_compiler(&context_, config_->host_virtual_device);
       auto vm_func = func_compiler.Compile(gvar, func);
 
@@ -984,6 +1015,87 @@ void VMCompiler::LowerImpl(IRModule mod) {
   }
 }
 
+void VMCompiler::CompileFunctionsInParallel(
+    const std::vector<std::pair<GlobalVar, Function>>& funcs, int num_jobs) {
+  struct CompiledFunction {
+    VMFunction vm_func;
+    std::map<Index, Map<String, ObjectRef>> op_attrs;
+    // The constants, primitives and devices used by the function, indexed as in vm_func.
+    VMCompilerContext tables;
+  };
+  int num_funcs = funcs.size();
+  std::vector<CompiledFunction> compiled(num_funcs);
+  support::parallel_for_dynamic(0, num_funcs, std::min(num_jobs, num_funcs), [&](int, int i) {
+    CompiledFunction& result = compiled[i];
+    result.tables.virtual_devices_.push_back(config_->host_virtual_device);
+    VMFunctionCompiler func_compiler(&context_, config_->host_virtual_device, &result.tables);
+    result.vm_func = func_compiler.Compile(funcs[i].first, funcs[i].second);
+    result.op_attrs = std::move(func_compiler.op_attrs);
+  });
+
+  // Merge the tables in the order of the functions, which gives the same indices as the serial
+  // compilation, and renumber the instructions accordingly.
+  for (int i = 0; i < num_funcs; ++i) {
+    CompiledFunction& result = compiled[i];
+    const VMCompilerContext& tables = result.tables;
+    std::vector<Index> device_map;
+    device_map.reserve(tables.virtual_devices_.size());
+    device_map.push_back(0);
+    for (size_t j = 1; j < tables.virtual_devices_.size(); ++j) {
+      device_map.push_back(GetOrAddVirtualDevice(&context_.virtual_devices_,
+                                                 tables.virtual_devices_[j],
+                                                 config_->host_virtual_device));
+    }
+    std::vector<Index> const_map;
+    const_map.reserve(tables.constants.size());
+    for (size_t j = 0; j < tables.constants.size(); ++j) {
+      const_map.push_back(context_.constants.size());
+      context_.constants.push_back(tables.constants[j]);
+      context_.const_device_indexes.push_back(device_map[tables.const_device_indexes[j]]);
+    }
+    std::vector<const std::string*> primitive_names(tables.primitive_map.size());
+    for (const auto& kv : tables.primitive_map) {
+      primitive_names[kv.second] = &kv.first;
+    }
+    std::vector<Index> packed_map;
+    packed_map.reserve(primitive_names.size());
+    for (const std::string* name : primitive_names) {
+      auto it = context_.primitive_map.emplace(*name, context_.primitive_map.size()).first;
+      packed_map.push_back(it->second);
+    }
+
+    VMFunction& vm_func = result.vm_func;
+    for (Index& device_index : vm_func.param_device_indexes) {
+      device_index = device_map[device_index];
+    }
+    for (Instruction& instr : vm_func.instructions) {
+      switch (instr.op) {
+        case Opcode::LoadConst:
+          instr.const_index = const_map[instr.const_index];
+          break;
+        case Opcode::InvokePacked:
+          instr.packed_index = packed_map[instr.packed_index];
+          break;
+        case Opcode::AllocStorage:
+          instr.alloc_storage.device_index = device_map[instr.alloc_storage.device_index];
+          break;
+        case Opcode::DeviceCopy:
+          instr.device_copy.src_device_index = device_map[instr.device_copy.src_device_index];
+          instr.device_copy.dst_device_index = device_map[instr.device_copy.dst_device_index];
+          break;
+        default:
+          break;
+      }
+    }
+    size_t func_index = context_.global_map.at(funcs[i].first);
+    ICHECK(func_index < exec_->functions.size());
+    exec_->functions[func_index] = std::move(vm_func);
+    for (const auto& p : result.op_attrs) {
+      exec_->op_attrs.insert({packed_map[p.first], p.second});
+    }
+  }
+}
+
 transform::Sequential VMCompiler::MemoryOpt(const CompilationConfig& config) {
   Array<Pass> pass_seqs;
   // Remove unused functions
@@ -1025,6 +1137,12 @@ transform::Sequential VMCompiler::MemoryOpt(const CompilationConfig& config) {
   // Insert kills to free memory.
   pass_seqs.push_back(transform::ManifestLifetimes());
 
+  // Pack the statically sized storages into one arena per function and device.
+  transform::PassContext pass_ctx = transform::PassContext::Current();
+  if (pass_ctx->GetConfig<Bool>("relay.vm.plan_static_storage", Bool(false)).value()) {
+    pass_seqs.push_back(transform::PlanStaticStorage());
+  }
+
   // Lift constants to the top-level of the block to simplify VM code generation.
   // TODO(@icemelon9, @jroesch): Remove this pass for now because some
   //  instructions need to access to constant
@@ -1212,6 +1330,9 @@ runtime::Module CreateVMCompiler() {
 
 TVM_REGISTER_GLOBAL("relay._vm._VMCompiler").set_body_typed(CreateVMCompiler);
 
+// The number of threads compiling the Relay functions to VMFunctions.
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.vm.num_parallel_jobs", Integer);
+
 }  // namespace vm
 }  // namespace relay
 }  // namespace tvm
@@ -160,6 +160,13 @@ class VMCompiler : public runtime::ModuleNode {
    */
   size_t PopulateGlobalMap();
 
+  /*!
+   * \brief Compile \p funcs to VMFunctions on \p num_jobs threads. The executable is the same as
+   * when they are compiled one after the other.
+   */
+  void CompileFunctionsInParallel(const std::vector<std::pair<GlobalVar, Function>>& funcs,
+                                  int num_jobs);
+
  protected:
   /*! \brief Targets and scopes needed for compilation. */
   CompilationConfig config_;
@@ -0,0 +1,397 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/backend/vm/plan_static_storage.cc
+ * \brief Packs the statically sized storages of a function into a single arena with offsets
+ * assigned at compile time. NOTE: the input IR should be in ANF and post-memory-lowering, and
+ * this pass is intended to run after ManifestLifetimes.
+ */
+
+#include <tvm/relay/analysis.h>
+#include <tvm/relay/attrs/memory.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/transform.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../../op/memory/memory.h"
+#include "../../op/memory/on_device.h"
+#include "../../transforms/let_list.h"
+#include "../../transforms/pattern_utils.h"
+
+namespace tvm {
+namespace relay {
+namespace transform {
+
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.vm.plan_static_storage", Bool);
+
+namespace {
+
+/*! \brief Returns the scalar held by \p expr, looking through any "on_device". */
+int64_t ConstantScalarValue(const Expr& expr) {
+  const auto* constant_node = AsIgnoringOnDevice<ConstantNode>(expr);
+  ICHECK(constant_node);
+  return static_cast<int64_t>(ToScalar(constant_node->data));
+}
+
+bool IsOp(const Expr& expr, const Op& op) {
+  const auto* call_node = AsIgnoringOnDevice<CallNode>(expr);
+  return call_node != nullptr && call_node->op.same_as(op);
+}
+
+/*! \brief A "memory.alloc_storage" binding of the top-level let chain of size known statically. */
+struct StorageCandidate {
+  Var var;
+  /*! \brief The size expression, kept to reuse its "on_device" annotation for the arena. */
+  Expr size_expr;
+  int64_t size;
+  int64_t alignment;
+  VirtualDevice virtual_device;
+  DataType dtype_hint;
+  /*! \brief Index of the binding allocating the storage in the let chain. */
+  size_t first_use;
+  /*! \brief Index of the last binding which may touch the storage or a tensor on it. */
+  size_t last_use;
+  bool eligible = true;
+  /*! \brief Assigned offset within the arena of its group. */
+  int64_t offset = 0;
+  int group = -1;
+};
+
+/*! \brief The storages sharing a single arena. */
+struct ArenaGroup {
+  VirtualDevice virtual_device;
+  DataType dtype_hint;
+  std::vector<size_t> members;
+  Var arena_var;
+  int64_t size = 0;
+  int64_t alignment = 1;
+};
+
+/*!
+ * \brief Marks as ineligible the candidates used other than as the storage of a
+ * "memory.alloc_tensor" with a constant offset, or as the argument of a "memory.kill".
+ */
+class StorageUseChecker : public ExprVisitor {
+ public:
+  StorageUseChecker(const std::unordered_map<Var, size_t, ObjectPtrHash, ObjectPtrEqual>& index,
+                    std::vector<StorageCandidate>* candidates)
+      : index_(index), candidates_(candidates) {}
+
+  void VisitExpr_(const VarNode* var_node) final {
+    auto it = index_.find(GetRef<Var>(var_node));
+    if (it != index_.end()) {
+      (*candidates_)[it->second].eligible = false;
+    }
+  }
+
+  void VisitExpr_(const CallNode* call_node) final {
+    static const Op& alloc_tensor_op = MemoryAllocTensorOp();
+    static const Op& kill_op = Op::Get("memory.kill");
+    if (call_node->op.same_as(alloc_tensor_op) && call_node->args[0].as<VarNode>() &&
+        index_.count(Downcast<Var>(call_node->args[0]))) {
+      if (!AsIgnoringOnDevice<ConstantNode>(call_node->args[1])) {
+        (*candidates_)[index_.at(Downcast<Var>(call_node->args[0]))].eligible = false;
+      }
+      VisitExpr(call_node->args[1]);
+      VisitExpr(call_node->args[2]);
+      return;
+    }
+    if (call_node->op.same_as(kill_op) && call_node->args.size() == 1 &&
+        call_node->args[0].as<VarNode>()) {
+      return;
+    }
+    ExprVisitor::VisitExpr_(call_node);
+  }
+
+ private:
+  const std::unordered_map<Var, size_t, ObjectPtrHash, ObjectPtrEqual>& index_;
+  std::vector<StorageCandidate>* candidates_;
+};
+
+/*!
+ * \brief Redirects the tensors of the planned storages to their arena, and drops the kills of
+ * the planned storages.
+ */
+class ArenaRewriter : public ExprMutator {
+ public:
+  ArenaRewriter(const std::unordered_map<Var, size_t, ObjectPtrHash, ObjectPtrEqual>& planned,
+                const std::vector<StorageCandidate>& candidates,
+                const std::vector<ArenaGroup>& groups)
+      : planned_(planned), candidates_(candidates), groups_(groups) {}
+
+  /*! \brief Returns true if \p value is the allocation or the kill of a planned storage. */
+  bool IsPlannedBinding(const Var& var, const Expr& value) const {
+    static const Op& kill_op = Op::Get("memory.kill");
+    if (planned_.count(var)) {
+      return true;
+    }
+    if (IsOp(value, kill_op)) {
+      const Expr& arg = AsIgnoringOnDevice<CallNode>(value)->args[0];
+      return arg.as<VarNode>() && planned_.count(Downcast<Var>(arg));
+    }
+    return false;
+  }
+
+  Expr VisitExpr_(const LetNode* let_node) final {
+    Expr expr = GetRef<Expr>(let_node);
+    LetList ll;
+    while (const LetNode* inner_let_node = expr.as<LetNode>()) {
+      if (!IsPlannedBinding(inner_let_node->var, inner_let_node->value)) {
+        ll.Push(inner_let_node->var, VisitExpr(inner_let_node->value));
+      }
+      expr = inner_let_node->body;
+    }
+    return ll.Get(VisitExpr(expr));
+  }
+
+  Expr VisitExpr_(const CallNode* call_node) final {
+    static const Op& alloc_tensor_op = MemoryAllocTensorOp();
+    if (call_node->op.same_as(alloc_tensor_op) && call_node->args[0].as<VarNode>()) {
+      auto it = planned_.find(Downcast<Var>(call_node->args[0]));
+      if (it != planned_.end()) {
+        const StorageCandidate& candidate = candidates_[it->second];
+        const Expr& offset_expr = call_node->args[1];
+        Expr offset = MakeConstantScalar(DataType::Int(64),
+                                         ConstantScalarValue(offset_expr) + candidate.offset);
+        OnDeviceProps props = GetOnDeviceProps(offset_expr);
+        if (props.body.defined()) {
+          offset = MaybeOnDeviceWithProps(offset, props);
+        }
+        return Call(call_node->op,
+                    {groups_[candidate.group].arena_var, offset, VisitExpr(call_node->args[2])},
+                    call_node->attrs, call_node->type_args, call_node->span);
+      }
+    }
+    return ExprMutator::VisitExpr_(call_node);
+  }
+
+ private:
+  const std::unordered_map<Var, size_t, ObjectPtrHash, ObjectPtrEqual>& planned_;
+  const std::vector<StorageCandidate>& candidates_;
+  const std::vector<ArenaGroup>& groups_;
+};
+
+int64_t AlignUp(int64_t value, int64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+/*!
+ * \brief Assigns offsets to the members of \p group greedily by decreasing size: each storage
+ * takes the lowest aligned offset not overlapping a storage already placed whose lifetime
+ * intersects its own. This is the "greedy by size" strategy of USMP.
+ */
+void AssignOffsets(ArenaGroup* group, std::vector<StorageCandidate>* candidates) {
+  std::vector<size_t> order = group->members;
+  std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    return (*candidates)[lhs].size > (*candidates)[rhs].size;
+  });
+  std::vector<size_t> placed;
+  for (size_t index : order) {
+    StorageCandidate& candidate = (*candidates)[index];
+    std::vector<size_t> conflicts;
+    for (size_t other_index : placed) {
+      const StorageCandidate& other = (*candidates)[other_index];
+      if (other.first_use <= candidate.last_use && candidate.first_use <= other.last_use) {
+        conflicts.push_back(other_index);
+      }
+    }
+    std::sort(conflicts.begin(), conflicts.end(), [&](size_t lhs, size_t rhs) {
+      return (*candidates)[lhs].offset < (*candidates)[rhs].offset;
+    });
+    int64_t offset = 0;
+    for (size_t other_index : conflicts) {
+      const StorageCandidate& other = (*candidates)[other_index];
+      if (offset + candidate.size <= other.offset) {
+        break;
+      }
+      offset = std::max(offset, AlignUp(other.offset + other.size, candidate.alignment));
+    }
+    candidate.offset = offset;
+    group->size = std::max(group->size, offset + candidate.size);
+    group->alignment = std::max(group->alignment, candidate.alignment);
+    placed.push_back(index);
+  }
+}
+
+Function PlanStaticStorageInFunction(const Function& func) {
+  static const Op& alloc_storage_op = Op::Get("memory.alloc_storage");
+  static const Op& shape_of_op = Op::Get("vm.shape_of");
+
+  // Flatten the top-level let chain. Storages allocated in nested scopes are left alone.
+  std::vector<std::pair<Var, Expr>> bindings;
+  Expr body = func->body;
+  while (const LetNode* let_node = body.as<LetNode>()) {
+    bindings.emplace_back(let_node->var, let_node->value);
+    body = let_node->body;
+  }
+
+  std::vector<StorageCandidate> candidates;
+  std::unordered_map<Var, size_t, ObjectPtrHash, ObjectPtrEqual> index;
+  for (size_t i = 0; i < bindings.size(); ++i) {
+    const auto* call_node = AsIgnoringOnDevice<CallNode>(bindings[i].second);
+    if (call_node == nullptr || !call_node->op.same_as(alloc_storage_op) ||
+        !AsIgnoringOnDevice<ConstantNode>(call_node->args[0])) {
+      continue;
+    }
+    const auto* attrs = call_node->attrs.as<AllocStorageAttrs>();
+    ICHECK(attrs != nullptr) << "must be the AllocStorage attrs";
+    StorageCandidate candidate;
+    candidate.var = bindings[i].first;
+    candidate.size_expr = call_node->args[0];
+    candidate.size = ConstantScalarValue(call_node->args[0]);
+    candidate.alignment = ConstantScalarValue(call_node->args[1]);
+    candidate.virtual_device = attrs->virtual_device;
+    candidate.dtype_hint = attrs->dtype;
+    candidate.first_use = i;
+    candidate.last_use = i;
+    index.emplace(candidate.var, candidates.size());
+    candidates.push_back(std::move(candidate));
+  }
+  if (candidates.size() < 2) {
+    return func;
+  }
+
+  // A storage may only be used through the tensors allocated on it.
+  StorageUseChecker checker(index, &candidates);
+  for (const auto& binding : bindings) {
+    checker(binding.second);
+  }
+  checker(body);
+
+  // Compute the lifetime of each storage. Any value computed from a tensor on a storage is
+  // conservatively assumed to alias the storage, except for shapes.
+  std::unordered_map<Var, std::vector<size_t>, ObjectPtrHash, ObjectPtrEqual> aliases;
+  for (const auto& kv : index) {
+    aliases[kv.first].push_back(kv.second);
+  }
+  for (size_t i = 0; i < bindings.size(); ++i) {
+    const Expr& value = bindings[i].second;
+    std::vector<size_t> value_aliases;
+    for (const Var& free_var : FreeVars(value)) {
+      auto it = aliases.find(free_var);
+      if (it == aliases.end()) {
+        continue;
+      }
+      for (size_t c : it->second) {
+        candidates[c].last_use = std::max(candidates[c].last_use, i);
+        value_aliases.push_back(c);
+      }
+    }
+    if (value_aliases.empty() || IsOp(value, shape_of_op)) {
+      continue;
+    }
+    if (IgnoreOnDevice(value).as<FunctionNode>()) {
+      // A closure may run after the end of the function.
+      for (size_t c : value_aliases) {
+        candidates[c].eligible = false;
+      }
+      continue;
+    }
+    std::vector<size_t>& var_aliases = aliases[bindings[i].first];
+    var_aliases.insert(var_aliases.end(), value_aliases.begin(), value_aliases.end());
+  }
+  // Storages reachable from the result outlive the function.
+  for (const Var& free_var : FreeVars(body)) {
+    auto it = aliases.find(free_var);
+    if (it != aliases.end()) {
+      for (size_t c : it->second) {
+        candidates[c].eligible = false;
+      }
+    }
+  }
+
+  std::vector<ArenaGroup> groups;
+  for (size_t c = 0; c < candidates.size(); ++c) {
+    if (!candidates[c].eligible) {
+      continue;
+    }
+    auto it = std::find_if(groups.begin(), groups.end(), [&](const ArenaGroup& group) {
+      return group.dtype_hint == candidates[c].dtype_hint &&
+             StructuralEqual()(group.virtual_device, candidates[c].virtual_device);
+    });
+    if (it == groups.end()) {
+      ArenaGroup group;
+      group.virtual_device = candidates[c].virtual_device;
+      group.dtype_hint = candidates[c].dtype_hint;
+      groups.push_back(std::move(group));
+      it = groups.end() - 1;
+    }
+    it->members.push_back(c);
+  }
+
+  std::unordered_map<Var, size_t, ObjectPtrHash, ObjectPtrEqual> planned;
+  LetList ll;
+  for (size_t g = 0; g < groups.size(); ++g) {
+    ArenaGroup& group = groups[g];
+    if (group.members.size() < 2) {
+      continue;
+    }
+    AssignOffsets(&group, &candidates);
+    for (size_t c : group.members) {
+      candidates[c].group = static_cast<int>(g);
+      planned.emplace(candidates[c].var, c);
+    }
+    const StorageCandidate& first = candidates[group.members.front()];
+    Expr size = MakeConstantScalar(DataType::Int(64), group.size);
+    OnDeviceProps props = GetOnDeviceProps(first.size_expr);
+    if (props.body.defined()) {
+      size = MaybeOnDeviceWithProps(size, props);
+    }
+    // Alignment is directly captured in the instruction so don't wrap in "on_device".
+    Expr alignment = MakeConstantScalar(DataType::Int(64), group.alignment);
+    Expr value = AllocStorage(size, alignment, group.virtual_device, group.dtype_hint);
+    group.arena_var = Var("storage_arena_" + std::to_string(g), Type(nullptr));
+    ll.Push(group.arena_var, MaybeOnDeviceFixed(value, group.virtual_device));
+  }
+  if (planned.empty()) {
+    return func;
+  }
+
+  ArenaRewriter rewriter(planned, candidates, groups);
+  for (const auto& binding : bindings) {
+    if (!rewriter.IsPlannedBinding(binding.first, binding.second)) {
+      ll.Push(binding.first, rewriter.Mutate(binding.second));
+    }
+  }
+  Expr new_body = ll.Get(rewriter.Mutate(body));
+  return WithFields(func, /*opt_params=*/NullOpt, /*opt_body=*/new_body);
+}
+
+}  // namespace
+
+Pass PlanStaticStorage() {
+  auto pass_func = [](Function f, IRModule m, PassContext pc) -> Function {
+    if (f->HasNonzeroAttr(attr::kPrimitive)) {
+      return f;
+    }
+    return PlanStaticStorageInFunction(f);
+  };
+  return CreateFunctionPass(pass_func, 0, "PlanStaticStorage", {});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.PlanStaticStorage").set_body_typed(PlanStaticStorage);
+
+}  // namespace transform
+}  // namespace relay
+}  // namespace tvm
@@ -24,10 +24,46 @@
 
 #include "./candidate_function_cache.h"
 
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
 namespace tvm {
 namespace relay {
 namespace collage {
 
+CandidateFunctionCache::CandidateFunctionCache(std::shared_ptr<NameSupply> name_supply,
+                                               std::string cost_cache_path)
+    : name_supply_(std::move(name_supply)), cost_cache_path_(std::move(cost_cache_path)) {
+  if (cost_cache_path_.empty()) {
+    return;
+  }
+  std::ifstream is(cost_cache_path_);
+  std::string line;
+  while (std::getline(is, line)) {
+    std::istringstream line_is(line);
+    uint64_t hash;
+    std::string value;
+    std::string target_str;
+    char* end = nullptr;
+    double seconds = 0.0;
+    if (line_is >> hash >> value && std::getline(line_is >> std::ws, target_str)) {
+      seconds = std::strtod(value.c_str(), &end);
+    }
+    if (end == nullptr || *end != '\0' || !std::isfinite(seconds) || seconds < 0.0) {
+      LOG(WARNING) << "Ignoring malformed line in Collage cost cache " << cost_cache_path_ << ": "
+                   << line;
+      continue;
+    }
+    // Later lines win, so a file appended to by several runs keeps the latest estimates.
+    recorded_costs_[RecordKey(hash, target_str)] = seconds;
+  }
+  VLOG(1) << "Loaded " << recorded_costs_.size() << " costs from Collage cost cache "
+          << cost_cache_path_;
+}
+
 CandidateFunctionCache::Entry& CandidateFunctionCache::GetEntry(const std::string& label,
                                                                 const Function& function) {
   auto itr = cache_.find(function);
@@ -44,6 +80,42 @@ GlobalVar CandidateFunctionCache::GetGlobalSymbol(const Function& function) {
   return GetEntry(/*label=*/"", function).global_symbol;
 }
 
+Cost CandidateFunctionCache::GetRecordedCost(const Function& function,
+                                             const Target& target) const {
+  if (recorded_costs_.empty()) {
+    return Cost::Unknown();
+  }
+  auto itr = recorded_costs_.find(RecordKey(StructuralHash()(function), target->str()));
+  if (itr == recorded_costs_.end()) {
+    return Cost::Unknown();
+  }
+  return Cost::Value(itr->second);
+}
+
+void CandidateFunctionCache::SetCost(Entry* entry, const Function& function, const Target& target,
+                                     Cost cost) {
+  entry->cost = cost;
+  // An invalid cost comes from a failure to build or run the candidate, which may be specific to
+  // this run, e.g. a BYOC codegen that is not registered, so it is not remembered.
+  if (cost_cache_path_.empty() || cost.is_unknown() || cost.is_invalid()) {
+    return;
+  }
+  uint64_t hash = StructuralHash()(function);
+  std::string target_str = target->str();
+  double seconds = cost.value();
+  recorded_costs_[RecordKey(hash, target_str)] = seconds;
+  std::ofstream os(cost_cache_path_, std::ios::app);
+  os.precision(std::numeric_limits<double>::max_digits10);
+  os << hash << " " << seconds << " " << target_str << std::endl;
+  if (!os) {
+    LOG(WARNING) << "Unable to append to Collage cost cache " << cost_cache_path_;
+  }
+}
+
+std::string CandidateFunctionCache::RecordKey(uint64_t hash, const std::string& target_str) {
+  return std::to_string(hash) + " " + target_str;
+}
+
 }  // namespace collage
 }  // namespace relay
 }  // namespace tvm
@@ -26,6 +26,7 @@
 #define TVM_RELAY_COLLAGE_CANDIDATE_FUNCTION_CACHE_H_
 
 #include <tvm/relay/function.h>
+#include <tvm/target/target.h>
 
 #include <memory>
 #include <string>
@@ -46,11 +47,15 @@ namespace collage {
  * attributes) then they will share the same global symbol and estimated cost. We rely on the
  * function's attributes to distinguish partitions which are structurally the same graph but
  * intended for different targets.
+ *
+ * If a cost cache file is given then the estimated costs are also remembered across runs. Each
+ * line of the file records the structural hash of a function, its cost in seconds, and the
+ * target it was estimated on.
  */
 class CandidateFunctionCache : public transform::GlobalSymbolCache {
  public:
-  explicit CandidateFunctionCache(std::shared_ptr<NameSupply> name_supply)
-      : name_supply_(std::move(name_supply)) {}
+  explicit CandidateFunctionCache(std::shared_ptr<NameSupply> name_supply,
+                                  std::string cost_cache_path = "");
 
   struct Entry {
     GlobalVar global_symbol;
@@ -67,9 +72,29 @@ class CandidateFunctionCache : public transform::GlobalSymbolCache {
 
   GlobalVar GetGlobalSymbol(const Function& function) final;
 
+  /*!
+   * \brief Returns the cost of \p function on \p target recorded in the cost cache file by an
+   * earlier run, or Cost::Unknown() if there is none.
+   */
+  Cost GetRecordedCost(const Function& function, const Target& target) const;
+
+  /*!
+   * \brief Sets the cost of \p entry, which must be the entry for \p function, to \p cost as
+   * estimated on \p target, and appends it to the cost cache file if any. Invalid costs, i.e. of
+   * candidates which failed to build, are not appended.
+   */
+  void SetCost(Entry* entry, const Function& function, const Target& target, Cost cost);
+
  private:
+  /*! \brief Returns the key in \p recorded_costs_ of a function with structural hash \p hash. */
+  static std::string RecordKey(uint64_t hash, const std::string& target_str);
+
   std::shared_ptr<NameSupply> name_supply_;
   std::unordered_map<Function, Entry, StructuralHash, StructuralEqual> cache_;
+  /*! \brief The cost cache file, or empty if costs are not remembered across runs. */
+  std::string cost_cache_path_;
+  /*! \brief The costs in seconds loaded from and appended to the cost cache file. */
+  std::unordered_map<std::string, double> recorded_costs_;
 };
 
 }  // namespace collage
@@ -167,37 +167,13 @@ Cost CandidatePartitionNode::EstimatedCost(
     const DataflowGraph& dataflow_graph, const CostEstimator& cost_estimator,
     const std::shared_ptr<CandidateFunctionCache>& cache) const {
   if (cost_.is_unknown()) {
-    VLOG_CONTEXT << "spec " << partition_spec_name();
-    Function extracted_function = sub_graph_->ExtractAsFunction(dataflow_graph);
-    VLOG(2) << "Extracted function:" << std::endl << PrettyPrint(extracted_function);
-    extracted_function = EtaExpandTuples(extracted_function);
-    VLOG(2) << "Validating function:" << std::endl << PrettyPrint(extracted_function);
-    String error = partition_spec()->validate_sub_graph_func_(extracted_function);
-    if (!error.empty()) {
-      cost_ = Cost::Invalid();
-      VLOG(1) << "Unable to rewrite function: " << error;
-    } else {
-      // The extracted function may be the eta-expansion of a "Primitive" function.
-      // If so we want the cached external name and cost to be w.r.t. that function
-      // rather than the outer so that we'll get a cache hit when we outline functions
-      // in the final program.
-      Function primitive_function = GetPrimitiveFunction(extracted_function);
-      CandidateFunctionCache::Entry& entry =
-          cache->GetEntry(sub_graph_->label_, primitive_function);
-      if (entry.cost.is_unknown()) {
-        IRModule mod = IRModule::FromExpr(extracted_function);
-        VLOG(1) << "Outlining:" << std::endl << PrettyPrint(mod);
-        mod = OutlineCompilerFunctions(cache)(mod);
-        VLOG(1) << "Estimating cost of:" << std::endl
-                << PrettyPrint(mod) << std::endl
-                << "using target " << target()->ToDebugString();
-        entry.cost = cost_estimator->Estimate(mod, target());
-        VLOG(1) << "Measured cost as " << entry.cost.ToString();
-      } else {
-        VLOG(1) << "Reusing cost " << entry.cost.ToString()
-                << " cached in candidate function cache";
-      }
-      cost_ = entry.cost;
+    IRModule mod;
+    Function function;
+    CandidateFunctionCache::Entry* entry = nullptr;
+    if (PrepareEstimate(dataflow_graph, cache, &mod, &function, &entry)) {
+      cache->SetCost(entry, function, target(), cost_estimator->Estimate(mod, target()));
+      VLOG(1) << "Measured cost as " << entry->cost.ToString();
+      cost_ = entry->cost;
     }
   } else {
     VLOG(1) << "Reusing cost " << cost_.ToString() << " cached in candidate";
@@ -205,6 +181,52 @@ Cost CandidatePartitionNode::EstimatedCost(
   return cost_;
 }
 
+bool CandidatePartitionNode::PrepareEstimate(const DataflowGraph& dataflow_graph,
+                                             const std::shared_ptr<CandidateFunctionCache>& cache,
+                                             IRModule* mod, Function* function,
+                                             CandidateFunctionCache::Entry** entry) const {
+  if (!cost_.is_unknown()) {
+    return false;
+  }
+  VLOG_CONTEXT << "spec " << partition_spec_name();
+  Function extracted_function = sub_graph_->ExtractAsFunction(dataflow_graph);
+  VLOG(2) << "Extracted function:" << std::endl << PrettyPrint(extracted_function);
+  extracted_function = EtaExpandTuples(extracted_function);
+  VLOG(2) << "Validating function:" << std::endl << PrettyPrint(extracted_function);
+  String error = partition_spec()->validate_sub_graph_func_(extracted_function);
+  if (!error.empty()) {
+    cost_ = Cost::Invalid();
+    VLOG(1) << "Unable to rewrite function: " << error;
+    return false;
+  }
+  // The extracted function may be the eta-expansion of a "Primitive" function.
+  // If so we want the cached external name and cost to be w.r.t. that function
+  // rather than the outer so that we'll get a cache hit when we outline functions
+  // in the final program.
+  *function = GetPrimitiveFunction(extracted_function);
+  *entry = &cache->GetEntry(sub_graph_->label_, *function);
+  if ((*entry)->cost.is_unknown()) {
+    (*entry)->cost = cache->GetRecordedCost(*function, target());
+    if (!(*entry)->cost.is_unknown()) {
+      VLOG(1) << "Reusing cost " << (*entry)->cost.ToString() << " recorded in cost cache file";
+    }
+  } else {
+    VLOG(1) << "Reusing cost " << (*entry)->cost.ToString()
+            << " cached in candidate function cache";
+  }
+  if (!(*entry)->cost.is_unknown()) {
+    cost_ = (*entry)->cost;
+    return false;
+  }
+  *mod = IRModule::FromExpr(extracted_function);
+  VLOG(1) << "Outlining:" << std::endl << PrettyPrint(*mod);
+  *mod = OutlineCompilerFunctions(cache)(*mod);
+  VLOG(1) << "Estimating cost of:" << std::endl
+          << PrettyPrint(*mod) << std::endl
+          << "using target " << target()->ToDebugString();
+  return true;
+}
+
 CandidatePartition::CandidatePartition(String rule_name, SubGraph sub_graph,
                                        ObjectRef /* actually PartitionSpec */ spec, Cost cost) {
   auto node = runtime::make_object<CandidatePartitionNode>();
@@ -103,6 +103,16 @@ class CandidatePartitionNode : public Object {
   Cost EstimatedCost(const DataflowGraph& dataflow_graph, const CostEstimator& cost_estimator,
                      const std::shared_ptr<CandidateFunctionCache>& cache) const;
 
+  /*!
+   * \brief Prepares to estimate the cost of the candidate partition. If the cost can be found
+   * without estimation, caches it in the candidate and returns false. Otherwise returns true,
+   * setting \p mod to the module to estimate using \p target(), \p function to the function
+   * keying its cost, and \p entry to the entry for \p function in \p cache.
+   */
+  bool PrepareEstimate(const DataflowGraph& dataflow_graph,
+                       const std::shared_ptr<CandidateFunctionCache>& cache, IRModule* mod,
+                       Function* function, CandidateFunctionCache::Entry** entry) const;
+
   /*!
    * \brief Returns a brief description of candidate suitable for debugging output.
    */
@@ -52,16 +52,46 @@ void CandidatePartitionIndex::Index(const Array<PartitionSpec>& partition_specs)
 
 void CandidatePartitionIndex::EstimateAllCosts(
     const CostEstimator cost_estimator, const std::shared_ptr<CandidateFunctionCache>& cache) {
-  size_t n = 0;
+  // Gather the distinct modules to estimate. Candidates sharing a cache entry share an estimate.
+  Array<IRModule> mods;
+  Array<Target> targets;
+  std::vector<Function> functions;
+  std::vector<CandidateFunctionCache::Entry*> entries;
+  std::unordered_map<CandidateFunctionCache::Entry*, size_t> entry_to_estimate;
+  std::vector<std::pair<CandidatePartition, size_t>> pending;
   for (PostDfsIndex index = 0; index < dataflow_graph_->size(); ++index) {
     for (const auto& candidate : first_inside_index_to_candidates_[index]) {
-      LOG(INFO) << "Estimating cost of candidate " << candidate->ToSummary(*dataflow_graph_) << " ["
-                << n++ << "/" << size_ << "]";
-      // Cost will be cached in candidate as a side effect.
-      Cost cost = candidate->EstimatedCost(*dataflow_graph_, cost_estimator, cache);
-      LOG(INFO) << "Candidate has cost " << cost.ToString();
+      IRModule mod;
+      Function function;
+      CandidateFunctionCache::Entry* entry = nullptr;
+      if (!candidate->PrepareEstimate(*dataflow_graph_, cache, &mod, &function, &entry)) {
+        VLOG(1) << "Candidate " << candidate->ToSummary(*dataflow_graph_) << " has cost "
+                << candidate->cost_.ToString() << " without estimation";
+        continue;
+      }
+      auto itr = entry_to_estimate.emplace(entry, mods.size());
+      if (itr.second) {
+        mods.push_back(mod);
+        targets.push_back(candidate->target());
+        functions.push_back(function);
+        entries.push_back(entry);
+      }
+      pending.emplace_back(candidate, itr.first->second);
     }
   }
+
+  LOG(INFO) << "Estimating the cost of " << mods.size() << " distinct modules for "
+            << pending.size() << " of " << size_ << " candidates";
+  std::vector<Cost> costs = cost_estimator->EstimateBatch(mods, targets);
+  ICHECK_EQ(costs.size(), mods.size());
+  for (size_t i = 0; i < costs.size(); ++i) {
+    cache->SetCost(entries[i], functions[i], targets[i], costs[i]);
+  }
+  for (const auto& kv : pending) {
+    kv.first->cost_ = entries[kv.second]->cost;
+    LOG(INFO) << "Candidate " << kv.first->ToSummary(*dataflow_graph_) << " has cost "
+              << kv.first->cost_.ToString();
+  }
 }
 
 std::string CandidatePartitionIndex::ToSummary() const {
@@ -57,7 +57,11 @@ class CandidatePartitionIndex {
     return first_inside_index_to_candidates_[index];
   }
 
-  /*! \brief Estimates the casts of all candidates in the index. Each candidate caches its cost. */
+  /*!
+   * \brief Estimates the costs of all candidates in the index. Each candidate caches its cost.
+   * The distinct modules to estimate are gathered first and handed to \p cost_estimator as one
+   * batch, so that the estimator may process them in parallel.
+   */
   void EstimateAllCosts(const CostEstimator cost_estimator,
                         const std::shared_ptr<CandidateFunctionCache>& cache);
 
@@ -56,6 +56,8 @@ namespace {
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.collage.tvm_max_depth", Integer);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.collage.byoc_max_depth", Integer);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.collage.byoc_fusion_style", Array<String>);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.collage.cost_cache_path", String);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.collage.num_estimate_workers", Integer);
 /*!
  * \brief Represents the overall expression after some number of non-overlapping candidate
  * partitions have been applied.
@@ -150,8 +152,8 @@ class Partitioner {
     //  - There are no paths in which the candidate does not intersect candidates already
     //    applied on the path.
     //  - The Dijkstra search terminates early with a least cost path.
-    // So eager may result in more estimation overhead. However, eager could be made
-    // embarrassingly parallel.
+    // So eager may result in more estimation overhead. However, eager hands all the candidates to
+    // the cost estimator as a single batch, which it may estimate in parallel.
     VLOG(1) << "Beginning eager cost estimation";
     index_->EstimateAllCosts(cost_estimator_, cache_);
     VLOG(1) << "Finished eager cost estimation";
@@ -322,8 +324,10 @@ transform::Pass CollagePartition(CompilationConfig config, CostEstimator cost_es
         Array<PartitionSpec> partition_specs = GatherPartitionSpecs(config);
         VLOG(1) << "Gathered " << partition_specs.size() << " partition specs";
 
-        auto cache =
-            std::make_shared<CandidateFunctionCache>(std::make_shared<NameSupply>("collage"));
+        String cost_cache_path =
+            ctxt->GetConfig<String>("relay.collage.cost_cache_path", String("")).value();
+        auto cache = std::make_shared<CandidateFunctionCache>(
+            std::make_shared<NameSupply>("collage"), cost_cache_path);
 
         IRModule out_mod = mod->ShallowCopy();
         for (const auto& kv : mod->functions) {
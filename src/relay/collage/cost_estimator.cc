@@ -37,12 +37,9 @@ CostEstimator::CostEstimator() {
   data_ = std::move(node);
 }
 
-Cost CostEstimatorNode::Estimate(const IRModule& mod, const Target& target) const {
-  // TODO(mbs): Eventually should be abstract. For now bounce to the Python local impl.
-  static const runtime::PackedFunc* estimate_seconds =
-      runtime::Registry::Get("tvm.relay.collage.estimate_seconds");
-  ICHECK(estimate_seconds);
-  const double value = (*estimate_seconds)(mod, target);
+namespace {
+
+Cost SecondsToCost(double value) {
   if (std::isinf(value)) {
     return Cost::Invalid();
   } else if (std::isnan(value)) {
@@ -52,6 +49,46 @@ Cost CostEstimatorNode::Estimate(const IRModule& mod, const Target& target) cons
   }
 }
 
+}  // namespace
+
+Cost CostEstimatorNode::Estimate(const IRModule& mod, const Target& target) const {
+  // TODO(mbs): Eventually should be abstract. For now bounce to the Python local impl.
+  static const runtime::PackedFunc* estimate_seconds =
+      runtime::Registry::Get("tvm.relay.collage.estimate_seconds");
+  ICHECK(estimate_seconds);
+  const double value = (*estimate_seconds)(mod, target);
+  return SecondsToCost(value);
+}
+
+std::vector<Cost> CostEstimatorNode::EstimateBatch(const Array<IRModule>& mods,
+                                                   const Array<Target>& targets) const {
+  ICHECK_EQ(mods.size(), targets.size());
+  static const runtime::PackedFunc* estimate_seconds_batch =
+      runtime::Registry::Get("tvm.relay.collage.estimate_seconds_batch");
+  if (estimate_seconds_batch == nullptr) {
+    return EstimateEach(mods, targets);
+  }
+  Array<FloatImm> values = (*estimate_seconds_batch)(mods, targets);
+  ICHECK_EQ(values.size(), mods.size());
+  std::vector<Cost> costs;
+  costs.reserve(values.size());
+  for (const FloatImm& value : values) {
+    costs.push_back(SecondsToCost(value->value));
+  }
+  return costs;
+}
+
+std::vector<Cost> CostEstimatorNode::EstimateEach(const Array<IRModule>& mods,
+                                                  const Array<Target>& targets) const {
+  ICHECK_EQ(mods.size(), targets.size());
+  std::vector<Cost> costs;
+  costs.reserve(mods.size());
+  for (size_t i = 0; i < mods.size(); ++i) {
+    costs.push_back(Estimate(mods[i], targets[i]));
+  }
+  return costs;
+}
+
 TVM_REGISTER_GLOBAL("relay.collage.CostEstimator").set_body_typed([]() { return CostEstimator(); });
 
 }  // namespace collage
@@ -27,6 +27,8 @@
 
 #include <tvm/relay/function.h>
 
+#include <vector>
+
 #include "./cost.h"
 
 namespace tvm {
@@ -54,8 +56,22 @@ class CostEstimatorNode : public Object {
    */
   virtual Cost Estimate(const IRModule& mod, const Target& target) const;
 
+  /*!
+   * \brief Returns the estimated costs of running "main" in each of \p mods using the corresponding
+   * entry of \p targets. The default implementation bounces to the Python local impl, which
+   * compiles the modules, in parallel on a pool of workers if the
+   * "relay.collage.num_estimate_workers" pass config is above 1, and then measures them one at a
+   * time.
+   */
+  virtual std::vector<Cost> EstimateBatch(const Array<IRModule>& mods,
+                                          const Array<Target>& targets) const;
+
   static constexpr const char* _type_key = "relay.collage.CostEstimator";
   TVM_DECLARE_BASE_OBJECT_INFO(CostEstimatorNode, Object);
+
+ protected:
+  /*! \brief Returns the estimated costs of \p mods by calling \p Estimate on each in turn. */
+  std::vector<Cost> EstimateEach(const Array<IRModule>& mods, const Array<Target>& targets) const;
 };
 
 class CostEstimator : public ObjectRef {
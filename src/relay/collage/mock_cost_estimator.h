@@ -56,6 +56,11 @@ class MockCostEstimatorNode : public CostEstimatorNode {
  public:
   Cost Estimate(const IRModule& mod, const Target& target) const override;
 
+  std::vector<Cost> EstimateBatch(const Array<IRModule>& mods,
+                                  const Array<Target>& targets) const override {
+    return EstimateEach(mods, targets);
+  }
+
   static constexpr const char* _type_key = "relay.collage.MockCostEstimator";
   TVM_DECLARE_FINAL_OBJECT_INFO(MockCostEstimatorNode, CostEstimatorNode);
 
@@ -557,6 +557,68 @@ class MatchExtractor : public ExprMutator {
   const std::unordered_map<Expr, Var, ObjectPtrHash, ObjectPtrEqual> inputs_;
 };
 
+namespace {
+
+/*! \brief Adds the operators \p op_pattern may match to \p ops, returns false if unknown. */
+bool CollectOpPatternOps(const DFPattern& op_pattern, std::vector<String>* ops) {
+  if (const auto* expr_pattern = op_pattern.as<ExprPatternNode>()) {
+    if (const auto* op_node = expr_pattern->expr.as<OpNode>()) {
+      ops->push_back(op_node->name);
+      return true;
+    }
+    return false;
+  } else if (const auto* alt_pattern = op_pattern.as<AltPatternNode>()) {
+    return CollectOpPatternOps(alt_pattern->left, ops) &&
+           CollectOpPatternOps(alt_pattern->right, ops);
+  } else if (const auto* attr_pattern = op_pattern.as<AttrPatternNode>()) {
+    return CollectOpPatternOps(attr_pattern->pattern, ops);
+  }
+  return false;
+}
+
+/*! \brief Adds the operators the root of \p pattern may call to \p ops, false if unknown. */
+bool CollectPatternRootOps(const DFPattern& pattern, std::vector<String>* ops) {
+  if (const auto* call_pattern = pattern.as<CallPatternNode>()) {
+    size_t num_ops = ops->size();
+    if (!CollectOpPatternOps(call_pattern->op, ops)) {
+      return false;
+    }
+    // The matcher also associates divide and multiply, so either may match the other.
+    for (size_t i = num_ops, n = ops->size(); i < n; ++i) {
+      if ((*ops)[i] == "divide") {
+        ops->push_back("multiply");
+      } else if ((*ops)[i] == "multiply") {
+        ops->push_back("divide");
+      }
+    }
+    return true;
+  } else if (const auto* alt_pattern = pattern.as<AltPatternNode>()) {
+    return CollectPatternRootOps(alt_pattern->left, ops) &&
+           CollectPatternRootOps(alt_pattern->right, ops);
+  } else if (const auto* attr_pattern = pattern.as<AttrPatternNode>()) {
+    return CollectPatternRootOps(attr_pattern->pattern, ops);
+  } else if (const auto* type_pattern = pattern.as<TypePatternNode>()) {
+    return CollectPatternRootOps(type_pattern->pattern, ops);
+  } else if (const auto* shape_pattern = pattern.as<ShapePatternNode>()) {
+    return CollectPatternRootOps(shape_pattern->pattern, ops);
+  } else if (const auto* dtype_pattern = pattern.as<DataTypePatternNode>()) {
+    return CollectPatternRootOps(dtype_pattern->pattern, ops);
+  } else if (const auto* dominator_pattern = pattern.as<DominatorPatternNode>()) {
+    return CollectPatternRootOps(dominator_pattern->child, ops);
+  }
+  return false;
+}
+
+}  // namespace
+
+Optional<Array<String>> GetPatternRootOps(const DFPattern& pattern) {
+  std::vector<String> ops;
+  if (!CollectPatternRootOps(pattern, &ops)) {
+    return NullOpt;
+  }
+  return Array<String>(ops);
+}
+
 /*! \brief Group expressions that match the pattern */
 const std::unordered_map<int, PatternGrouper::Group>& PatternGrouper::GroupMatches(
     const DFPattern& pattern, const Expr& pre) {
@@ -564,6 +626,12 @@ const std::unordered_map<int, PatternGrouper::Group>& PatternGrouper::GroupMatch
   gid_assignments_.clear();
 
   pattern_ = pattern;
+  root_ops_.clear();
+  Optional<Array<String>> root_ops = GetPatternRootOps(pattern);
+  root_ops_known_ = root_ops.defined();
+  for (const String& op_name : root_ops.value_or({})) {
+    root_ops_.insert(op_name);
+  }
   pattern_graph_ = CreateIndexedGraph(pattern_);
   std::unique_ptr<IndexedGraph<Expr>> expr_graph = CreateIndexedGraph(pre);
   DFPatternMatcher matcher(expr_graph.get());
@@ -585,13 +653,26 @@ void PatternGrouper::VisitExprs() {
                          [&pre_partitioned](const Expr& expr) { pre_partitioned.insert(expr); });
         }
       }
-      if (pre_partitioned.count(current) == 0 && matcher_->Match(pattern_, current)) {
+      if (pre_partitioned.count(current) == 0 && MayMatchAt(current) &&
+          matcher_->Match(pattern_, current)) {
         CreateGroup(current);
       }
     }
   }
 }
 
+bool PatternGrouper::MayMatchAt(const Expr& expr) const {
+  if (!root_ops_known_) {
+    return true;
+  }
+  if (const auto* call_node = expr.as<CallNode>()) {
+    if (const auto* op_node = call_node->op.as<OpNode>()) {
+      return root_ops_.count(op_node->name) != 0;
+    }
+  }
+  return false;
+}
+
 void PatternGrouper::CreateGroup(const Expr& expr) {
   VLOG(1) << "Creating group for:" << std::endl << PrettyPrint(expr);
 
@@ -32,6 +32,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "indexed_graph.h"
@@ -86,6 +87,14 @@ class DFPatternMatcher : public DFPatternFunctor<bool(const DFPattern&, const Ex
   bool memoize_ = true;
 };
 
+/*!
+ * \brief Returns the names of the operators which an expression must call for \p pattern to
+ * match it, or NullOpt if \p pattern may also match expressions which are not operator calls or
+ * whose operator is not known from the pattern. Used to skip matching the pattern at expressions
+ * which cannot match, which is what dominates the matching cost once there are many patterns.
+ */
+Optional<Array<String>> GetPatternRootOps(const DFPattern& pattern);
+
 /*!
  * \brief PatternGrouper does pre-rewriting pattern matching and analysis
  *
@@ -140,8 +149,14 @@ class PatternGrouper {
    * lift the constant into the arguments of the partitioned function.
    */
   bool EmbedConst(const Expr& expr, const DFPattern pattern);
+  /*! \brief Returns false if \p expr cannot match the pattern since it calls another operator. */
+  bool MayMatchAt(const Expr& expr) const;
+
   // Internal State
   DFPattern pattern_;
+  /*! \brief Whether all the operators the matching expressions may call are in root_ops_. */
+  bool root_ops_known_ = false;
+  std::unordered_set<std::string> root_ops_;
   std::unordered_map<int, Group> groups_;
   std::unordered_map<Expr, int, ObjectPtrHash, ObjectPtrEqual> gid_assignments_;
   DFPatternMatcher* matcher_ = nullptr;
@@ -135,5 +135,39 @@ bool IsReshapeOnly(const CallLoweredProps& props) {
   return false;
 }
 
+int64_t GetViewByteOffset(const CallLoweredProps& props) {
+  if (props.attrs.metadata.count("relay_attrs")) {
+    auto dict_attrs = Downcast<DictAttrs>(props.attrs.metadata["relay_attrs"]);
+    if (auto offset = dict_attrs.GetAttr<Integer>(attr::kViewByteOffset)) {
+      return offset.value()->value;
+    }
+  }
+  return -1;
+}
+
+Array<Integer> GetInplaceParams(const CallLoweredProps& props) {
+  if (props.attrs.metadata.count("relay_attrs")) {
+    auto dict_attrs = Downcast<DictAttrs>(props.attrs.metadata["relay_attrs"]);
+    return dict_attrs.GetAttr<Array<Integer>>(attr::kInplaceParams).value_or({});
+  }
+  return {};
+}
+
+Array<Integer> GetConcatByteOffsets(const CallLoweredProps& props) {
+  if (props.attrs.metadata.count("relay_attrs")) {
+    auto dict_attrs = Downcast<DictAttrs>(props.attrs.metadata["relay_attrs"]);
+    return dict_attrs.GetAttr<Array<Integer>>(attr::kConcatByteOffsets).value_or({});
+  }
+  return {};
+}
+
+bool IsLayoutTransformOnly(const CallLoweredProps& props) {
+  if (props.attrs.metadata.count("relay_attrs")) {
+    auto dict_attrs = Downcast<DictAttrs>(props.attrs.metadata["relay_attrs"]);
+    return dict_attrs.HasNonzeroAttr(attr::kLayoutTransformOnly);
+  }
+  return false;
+}
+
 }  // namespace relay
 }  // namespace tvm
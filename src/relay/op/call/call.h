@@ -90,6 +90,31 @@ Call GetAnyCall(const CallNode* call_node);
  */
 bool IsReshapeOnly(const CallLoweredProps& props);
 
+/*!
+ * \brief Returns the byte offset in its input of the result of the lowered call described by
+ * \p props when it is a contiguous slice of the input, or -1 otherwise.
+ */
+int64_t GetViewByteOffset(const CallLoweredProps& props);
+
+/*!
+ * \brief Returns the indices of the arguments of the lowered call described by \p props whose
+ * buffer can receive its result.
+ */
+Array<Integer> GetInplaceParams(const CallLoweredProps& props);
+
+/*!
+ * \brief Returns the byte offset in the result of the lowered call described by \p props of each
+ * of its arguments, when the call concatenates them into contiguous slices of its result, or an
+ * empty array otherwise.
+ */
+Array<Integer> GetConcatByteOffsets(const CallLoweredProps& props);
+
+/*!
+ * \brief Returns true if lowered call described by \p props is to a single weight layout
+ * transform of its argument.
+ */
+bool IsLayoutTransformOnly(const CallLoweredProps& props);
+
 }  // namespace relay
 }  // namespace tvm
 
@@ -79,6 +79,8 @@ Expr MakeReshape(Expr data, Array<Integer> newshape, bool allowzero = false);
 Expr MakeReshapeLike(Expr lhs, Expr rhs, int lhs_begin, Integer lhs_end, int rhs_begin,
                      Integer rhs_end);
 
+Expr MakeScatterElements(Expr data, Expr indices, Expr updates, int axis, String reduction);
+
 Expr MakeSplit(Expr data, ObjectRef indices_or_sections, int axis);
 
 Expr MakeSqueeze(Expr data, Array<Integer> axis);
@@ -1135,6 +1135,98 @@ Both `tensor_a` and `tensor_b` can be transposed. For legacy reason, we use NT f
 
 // ------------------- relay.nn.batch_matmul
 
+// relay.nn.attention
+TVM_REGISTER_NODE_TYPE(AttentionAttrs);
+
+bool AttentionRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
+                  const TypeReporter& reporter) {
+  ICHECK_EQ(types.size(), 5);
+  const auto* query = types[0].as<TensorTypeNode>();
+  const auto* key = types[1].as<TensorTypeNode>();
+  const auto* value = types[2].as<TensorTypeNode>();
+  const auto* kv_length = types[3].as<TensorTypeNode>();
+  if (query == nullptr || key == nullptr || value == nullptr || kv_length == nullptr) return false;
+  if (query->shape.size() != 4 || key->shape.size() != 4 || value->shape.size() != 4) {
+    reporter->GetDiagCtx().EmitFatal(Diagnostic::Error(reporter->GetSpan())
+                                     << "attention: expects 4-D query, key and value of layout "
+                                        "(batch, heads, sequence, head size), but got "
+                                     << query->shape << ", " << key->shape << " and "
+                                     << value->shape);
+    return false;
+  }
+  for (int i = 0; i < 2; ++i) {
+    if (!reporter->AssertEQ(query->shape[i], key->shape[i]) ||
+        !reporter->AssertEQ(query->shape[i], value->shape[i])) {
+      reporter->GetDiagCtx().EmitFatal(Diagnostic::Error(reporter->GetSpan())
+                                       << "attention: the batch and heads of query " << query->shape
+                                       << ", key " << key->shape << " and value " << value->shape
+                                       << " must match");
+      return false;
+    }
+  }
+  if (!reporter->AssertEQ(query->shape[3], key->shape[3]) ||
+      !reporter->AssertEQ(key->shape[2], value->shape[2])) {
+    reporter->GetDiagCtx().EmitFatal(Diagnostic::Error(reporter->GetSpan())
+                                     << "attention: the head size of query " << query->shape
+                                     << " and key " << key->shape
+                                     << " must match, and the sequence of key and value "
+                                     << value->shape << " must match");
+    return false;
+  }
+  if (!kv_length->dtype.is_int() || kv_length->shape.size() > 1 ||
+      (kv_length->shape.size() == 1 && !reporter->AssertEQ(kv_length->shape[0], query->shape[0]))) {
+    reporter->GetDiagCtx().EmitFatal(Diagnostic::Error(reporter->GetSpan())
+                                     << "attention: kv_length must be an integer scalar or have a "
+                                        "length per batch, but got "
+                                     << kv_length->shape << " of " << kv_length->dtype);
+    return false;
+  }
+  Array<IndexExpr> oshape = {query->shape[0], query->shape[1], query->shape[2], value->shape[3]};
+  reporter->Assign(types[4], TensorType(oshape, query->dtype));
+  return true;
+}
+
+// Positional relay function to create attention operator used by frontend FFI.
+Expr MakeAttention(Expr query, Expr key, Expr value, Expr kv_length, double scale, bool causal) {
+  auto attrs = make_object<AttentionAttrs>();
+  attrs->scale = scale;
+  attrs->causal = causal;
+  static const Op& op = Op::Get("nn.attention");
+  return Call(op, {query, key, value, kv_length}, Attrs(attrs), {});
+}
+
+TVM_REGISTER_GLOBAL("relay.op.nn._make.attention").set_body_typed(MakeAttention);
+
+RELAY_REGISTER_OP("nn.attention")
+    .describe(R"code(Scaled dot product attention, computed with an online softmax.
+
+.. math::
+
+  out[b, h, i, :] = softmax(scale * query[b, h, i, :] \cdot key[b, h, :kv\_length, :]^T)
+                    \cdot value[b, h, :kv\_length, :]
+
+The scores are never materialized, so the memory traffic is linear in the sequence length.
+Only the first `kv_length` positions of key and value are read, which lets them be a
+preallocated KV cache. With `causal`, the query i is at position kv_length - q_len + i and only
+attends to the keys up to it.
+
+- **query**: `(batch, heads, q_len, head_size)`
+- **key**: `(batch, heads, kv_len, head_size)`
+- **value**: `(batch, heads, kv_len, value_size)`
+- **kv_length**: `()` or `(batch,)`
+- **out**: `(batch, heads, q_len, value_size)`.
+
+)code" TVM_ADD_FILELINE)
+    .set_attrs_type<AttentionAttrs>()
+    .set_num_inputs(4)
+    .add_argument("query", "4D Tensor", "The queries.")
+    .add_argument("key", "4D Tensor", "The keys.")
+    .add_argument("value", "4D Tensor", "The values.")
+    .add_argument("kv_length", "Tensor", "The number of valid positions of key and value.")
+    .set_support_level(10)
+    .add_type_rel("Attention", AttentionRel)
+    .set_attr<TOpPattern>("TOpPattern", kOpaque);
+
 // relay.nn.cross_entropy
 bool CrossEntropyRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
                      const TypeReporter& reporter) {
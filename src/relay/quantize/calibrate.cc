@@ -28,7 +28,9 @@
 #include <tvm/relay/op.h>
 
 #include <numeric>
+#include <string>
 
+#include "../op/make_op.h"
 #include "./quantize.h"
 
 namespace tvm {
@@ -208,6 +210,60 @@ Expr CreateStatsCollector(const Expr& expr) { return StatsCollector().Collect(ex
 
 TVM_REGISTER_GLOBAL("relay._quantize.CreateStatsCollector").set_body_typed(CreateStatsCollector);
 
+/*
+ * \brief Given an annotated graph, create a profile graph that reduces the profile data to
+ * calibration statistics on the device.
+ *
+ * Instead of the profiled tensors, the profile graph returns one statistic per profiled tensor,
+ * which is accumulated into an extra parameter of the graph, so that the statistics of a dataset
+ * can be kept on the device by feeding the outputs of a batch back as the parameters of the next
+ * one. The supported statistics are
+ *  - "max": the maximum of the absolute values, accumulated into the scalar "calib_acc_<i>".
+ *  - "histogram": the int64 histogram of the values with num_bins bins over
+ *    [-threshold, threshold], accumulated into "calib_acc_<i>" of shape (num_bins,). The scalar
+ *    threshold is the parameter "calib_threshold_<i>", values out of the range are clipped into
+ *    the first or the last bin.
+ *
+ * \param expr The simulation graph after annotation.
+ * \param stat The statistic to compute, "max" or "histogram".
+ * \param num_bins The number of bins of the histograms.
+ * \return The profile graph.
+ */
+Expr CreateStatsReducer(const Expr& expr, String stat, int num_bins) {
+  ICHECK(stat == "max" || stat == "histogram") << "Unknown calibration statistic " << stat;
+  ICHECK_GT(num_bins, 0) << "The number of bins must be positive";
+  Function func = Downcast<Function>(StatsCollector().Collect(expr));
+  const auto* profile_data = func->body.as<TupleNode>();
+  ICHECK(profile_data);
+  Array<Var> params = func->params;
+  Array<Expr> stats;
+  for (size_t i = 0; i < profile_data->fields.size(); ++i) {
+    Expr data = Reshape(profile_data->fields[i], {-1});
+    std::string suffix = std::to_string(i);
+    if (stat == "max") {
+      Var acc("calib_acc_" + suffix, TensorType({}, DataType::Float(32)));
+      params.push_back(acc);
+      stats.push_back(Maximum(acc, MakeReduce(Abs(data), {}, false, false, "max")));
+    } else {
+      Var threshold("calib_threshold_" + suffix, TensorType({}, DataType::Float(32)));
+      Var acc("calib_acc_" + suffix, TensorType({num_bins}, DataType::Int(64)));
+      params.push_back(threshold);
+      params.push_back(acc);
+      Expr bin_scale = Divide(MakeConstantScalar(DataType::Float(32), num_bins / 2.0), threshold);
+      Expr bin = Floor(Multiply(Add(data, threshold), bin_scale));
+      Expr index = Cast(Clip(bin, 0, num_bins - 1), DataType::Int(32));
+      Expr ones = OnesLike(Cast(index, DataType::Int(64)));
+      stats.push_back(MakeScatterElements(acc, index, ones, 0, "add"));
+    }
+  }
+  Expr body = Tuple(stats);
+  Function ret_func = WithFields(func, params, body);
+  ret_func.CopyOnWrite()->ret_type = NullValue<Type>();
+  return std::move(ret_func);
+}
+
+TVM_REGISTER_GLOBAL("relay._quantize.CreateStatsReducer").set_body_typed(CreateStatsReducer);
+
 TVM_REGISTER_GLOBAL("relay._quantize.FindScaleByKLMinimization")
     .set_body([](TVMArgs args, TVMRetValue* ret) {
       int* hist_ptr = static_cast<int*>(static_cast<void*>(args[0]));
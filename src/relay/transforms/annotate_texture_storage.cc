@@ -34,6 +34,7 @@
  */
 
 #include <tvm/relay/attrs/nn.h>
+#include <tvm/relay/attrs/transform.h>
 #include <tvm/relay/expr.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/transform.h>
@@ -372,7 +373,14 @@ class StorageInfo : private transform::DeviceAwareExprVisitor {
     bool supports_texture_storage = false;
     // we need to verify only entry functions since one of entry op defines main schedule
     for (const auto& arg : call->args) {
-      if (!arg.as<VarNode>()) {
+      // ops such as concatenate take their inputs as a tuple of the function parameters
+      if (const auto* tuple = arg.as<TupleNode>()) {
+        for (const auto& field : tuple->fields) {
+          if (!field.as<VarNode>()) {
+            return false;
+          }
+        }
+      } else if (!arg.as<VarNode>()) {
         return false;
       }
     }
@@ -401,6 +409,13 @@ class StorageInfo : private transform::DeviceAwareExprVisitor {
       if (attrs->layout == "NCHW4c") {
         supports_texture_storage = true;
       }
+    } else if (auto attrs = call->attrs.as<ConcatenateAttrs>()) {
+      // the rgba axis of the texture cannot be concatenated
+      if (const auto* ttype = call->checked_type().as<TensorTypeNode>()) {
+        int ndim = static_cast<int>(ttype->shape.size());
+        int axis = attrs->axis < 0 ? attrs->axis + ndim : attrs->axis;
+        supports_texture_storage = ndim == 5 && axis != 4;
+      }
     } else if (const OpNode* opnode = call->op.as<OpNode>()) {
       auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
       auto pattern = fpattern[GetRef<Op>(opnode)];
@@ -0,0 +1,167 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file combine_independent_dense.cc
+ * \brief Combine independent dense ops of the same shapes into a single batch_matmul.
+ *
+ * Unlike CombineParallelDense, the dense ops do not need to share their input. For example:
+ *
+ *    data0 (2,3)    data1 (2,3)    data2 (2,3)
+ *         |              |              |
+ *    dense (2,4)    dense (2,4)    dense (2,4)
+ *
+ * Would become:
+ *
+ *         stack(data0, data1, data2) (3,2,3)
+ *                       |
+ *       batch_matmul(stack(weights)) (3,2,4)
+ *                       |
+ *                 split (3,[2,4])
+ *
+ * Dense ops are combined only with the ops at the same depth, counted in dense ops along the
+ * longest path from the inputs, so that none of them depends on another one and the combined
+ * ops do not depend on each other in a cycle. They are also combined only within the same basic
+ * block, i.e. not across the branches of an if, the arms of a match or nested function bodies,
+ * which are not all evaluated, or not as many times. Stacking constant weights is folded by
+ * FoldConstant.
+ */
+#include <tvm/relay/attrs/nn.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/transform.h>
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "../ir/indexed_graph.h"
+#include "../op/make_op.h"
+#include "./expr_subst.h"
+
+namespace tvm {
+namespace relay {
+
+namespace {
+
+/*! \brief Whether a call is a dense op of 2-D data this pass can combine. */
+bool IsSupportedDense(const CallNode* call) {
+  static const Op& dense_op = Op::Get("nn.dense");
+  if (!call->op.same_as(dense_op) || call->args.size() != 2) {
+    return false;
+  }
+  for (const Expr& arg : call->args) {
+    const auto* tensor_type = arg->checked_type().as<TensorTypeNode>();
+    if (tensor_type == nullptr || tensor_type->shape.size() != 2) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*! \brief Whether two dense ops have the same shapes, dtypes and attributes. */
+bool CanDenseBeCombined(const CallNode* a, const CallNode* b) {
+  StructuralEqual eq;
+  for (size_t i = 0; i < a->args.size(); ++i) {
+    if (!eq(a->args[i]->checked_type(), b->args[i]->checked_type())) {
+      return false;
+    }
+  }
+  return eq(a->checked_type(), b->checked_type()) && eq(a->attrs, b->attrs);
+}
+
+}  // namespace
+
+/*! \brief Combine independent dense ops into batch_matmul if there are at least min_num_ops. */
+Expr CombineIndependentDense(const Expr& expr, uint64_t min_num_ops) {
+  std::unique_ptr<IndexedGraph<Expr>> graph = CreateIndexedGraph(expr);
+  // The number of dense ops along the longest path from the inputs to each node, included.
+  std::vector<size_t> depth(graph->size(), 0);
+  // The groups of combinable dense ops at each depth, each within a single basic block.
+  std::vector<std::vector<std::vector<const IndexedGraph<Expr>::Node*>>> groups;
+  for (PostDfsIndex index = 0; index < graph->size(); ++index) {
+    const IndexedGraph<Expr>::Node* node = graph->index_to_node(index);
+    for (const IndexedGraph<Expr>::Node* input : node->inputs_) {
+      depth[index] = std::max(depth[index], depth[input->index_]);
+    }
+    const auto* call = node->ref().as<CallNode>();
+    if (call == nullptr || !IsSupportedDense(call)) {
+      continue;
+    }
+    size_t level = depth[index]++;
+    if (groups.size() <= level) {
+      groups.resize(level + 1);
+    }
+    auto it = std::find_if(
+        groups[level].begin(), groups[level].end(),
+        [node, call](const std::vector<const IndexedGraph<Expr>::Node*>& group) {
+          return group[0]->basic_block_ == node->basic_block_ &&
+                 CanDenseBeCombined(group[0]->ref().as<CallNode>(), call);
+        });
+    if (it == groups[level].end()) {
+      groups[level].push_back({node});
+    } else {
+      it->push_back(node);
+    }
+  }
+
+  std::unordered_map<Expr, Expr, ObjectPtrHash, ObjectPtrEqual> subst_map;
+  for (const auto& level : groups) {
+    for (const auto& group : level) {
+      if (group.size() < min_num_ops) {
+        continue;
+      }
+      Array<Expr> data;
+      Array<Expr> weights;
+      for (const IndexedGraph<Expr>::Node* node : group) {
+        const auto* dense = node->ref().as<CallNode>();
+        data.push_back(dense->args[0]);
+        weights.push_back(dense->args[1]);
+      }
+      const auto* attrs = group[0]->ref().as<CallNode>()->attrs.as<DenseAttrs>();
+      Expr batched =
+          MakeBatchMatmul(MakeStack(Tuple(data), 0), MakeStack(Tuple(weights), 0),
+                          attrs->out_dtype, /*transpose_a=*/false, /*transpose_b=*/true);
+      Expr split = MakeSplit(batched, Integer(group.size()), 0);
+      for (size_t i = 0; i < group.size(); ++i) {
+        subst_map.emplace(group[i]->ref(),
+                          MakeSqueeze(TupleGetItem(split, i), {Integer(0)}));
+      }
+    }
+  }
+  return ExprSubst(expr, std::move(subst_map));
+}
+
+namespace transform {
+
+Pass CombineIndependentDense(uint64_t min_num_ops) {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        return Downcast<Function>(CombineIndependentDense(f, min_num_ops));
+      };
+  return CreateFunctionPass(pass_func, 4, "CombineIndependentDense", {"InferType"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.CombineIndependentDense")
+    .set_body_typed(CombineIndependentDense);
+
+}  // namespace transform
+
+}  // namespace relay
+}  // namespace tvm
@@ -32,6 +32,7 @@
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/qnn/attrs.h>
 #include <tvm/relay/transform.h>
+#include <tvm/tir/data_layout.h>
 
 #include <unordered_map>
 
@@ -40,6 +41,8 @@
 namespace tvm {
 namespace relay {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.FakeQuantizationToInteger.cost_check", Bool);
+
 /* Description of FakeQuantizationToInteger
  *
  * The purpose of this pass is to find regions of the graph that follow
@@ -96,6 +99,12 @@ namespace relay {
  *      q
  *
  * This pass works in the same multi-pass approach.
+ *
+ * If the relay.FakeQuantizationToInteger.cost_check option is set, the first pass only keeps the
+ * rewritten subgraph if it is estimated to be faster than the fake quantized one, see
+ * IntegerCostEstimator. The integer subgraph saves the dequantizes and the quantize at its
+ * boundary and computes its convolutions and matmuls at the integer rate, but pays a requantize
+ * whenever the scales of the values it combines differ.
  */
 
 using ExprSet = std::unordered_set<Expr, ObjectPtrHash, ObjectPtrEqual>;
@@ -260,9 +269,155 @@ class SubgraphMutator : public ExprMutator {
   const Op dequantize_op_ = Op::Get("qnn.dequantize");
 };
 
+/*!
+ * \brief Estimate the costs of a fake quantized subgraph and of its integer rewrite, in units of
+ * one elementwise operation on one output element.
+ *
+ * Convolutions and matmuls cost their multiply-adds, kIntegerMacSpeedup times fewer in integer.
+ * The other ops cost their output elements in both. Dequantizes and quantizes cost
+ * kQuantizeCost per element, and requantizes, explicit or implicit in the binary QNN ops,
+ * kRequantizeCost per element of the subgraph output.
+ */
+class IntegerCostEstimator : public ExprVisitor {
+ public:
+  /*!
+   * \brief Whether the integer rewrite is estimated to be faster.
+   * \param subgraph The fake quantized subgraph, without its quantize.
+   * \param quantize The quantize at the output of the subgraph.
+   * \param rewritten The integer rewrite of the subgraph.
+   * \param inputs The inputs of the dequantizes of the rewritten subgraph.
+   */
+  static bool IsFaster(const ExprSet& subgraph, const Expr& quantize, const Expr& rewritten,
+                       const ExprSet& inputs) {
+    static const Op dequantize_op = Op::Get("qnn.dequantize");
+    double out_elems = NumElements(quantize->checked_type());
+    double float_cost = kQuantizeCost * out_elems;
+    double integer_cost = 0;
+    for (const Expr& expr : subgraph) {
+      const CallNode* call = expr.as<CallNode>();
+      double elems = NumElements(call->checked_type());
+      if (call->op == dequantize_op) {
+        float_cost += kQuantizeCost * elems;
+      } else if (double macs = NumMultiplyAdds(call)) {
+        float_cost += macs;
+        integer_cost += macs / kIntegerMacSpeedup;
+      } else {
+        float_cost += elems;
+        integer_cost += elems;
+      }
+    }
+    IntegerCostEstimator estimator(inputs, out_elems);
+    estimator(rewritten);
+    integer_cost += estimator.boundary_cost_;
+    return integer_cost < float_cost;
+  }
+
+ private:
+  IntegerCostEstimator(const ExprSet& inputs, double out_elems)
+      : inputs_(inputs), out_elems_(out_elems) {}
+
+  void VisitExpr(const Expr& expr) final {
+    if (!inputs_.count(expr)) {
+      ExprVisitor::VisitExpr(expr);
+    }
+  }
+
+  void VisitExpr_(const CallNode* call) final {
+    static const std::unordered_map<std::string, int> num_requantizes = {
+        {"qnn.requantize", 1}, {"qnn.add", 2}, {"qnn.subtract", 2}, {"qnn.mul", 2}};
+    if (const auto* op = call->op.as<OpNode>()) {
+      auto it = num_requantizes.find(op->name);
+      if (it != num_requantizes.end()) {
+        boundary_cost_ += it->second * kRequantizeCost * out_elems_;
+      } else if (op->name == "qnn.concatenate") {
+        boundary_cost_ += kRequantizeCost * NumElements(call->checked_type());
+      } else if (op->name == "qnn.quantize" || op->name == "qnn.dequantize") {
+        // Introduced by the rules of the ops without an integer implementation.
+        boundary_cost_ += kQuantizeCost * out_elems_;
+      }
+    }
+    ExprVisitor::VisitExpr_(call);
+  }
+
+  /*! \brief The number of elements of a static tensor type, or 1 if unknown. */
+  static double NumElements(const Type& type) {
+    const auto* tensor_type = type.as<TensorTypeNode>();
+    if (tensor_type == nullptr) {
+      return 1;
+    }
+    double elems = 1;
+    for (const PrimExpr& dim : tensor_type->shape) {
+      if (const auto* extent = dim.as<IntImmNode>()) {
+        elems *= extent->value;
+      }
+    }
+    return elems;
+  }
+
+  /*! \brief The number of multiply-adds of a convolution or matmul, or 0 for other ops. */
+  static double NumMultiplyAdds(const CallNode* call) {
+    const auto* out_type = call->checked_type().as<TensorTypeNode>();
+    if (out_type == nullptr || call->args.size() < 2) {
+      return 0;
+    }
+    auto last_dim = [](const Expr& arg, bool transpose) -> double {
+      const auto* type = arg->checked_type().as<TensorTypeNode>();
+      if (type == nullptr || type->shape.size() < 2) {
+        return 0;
+      }
+      const auto* extent = type->shape[type->shape.size() - (transpose ? 2 : 1)].as<IntImmNode>();
+      return extent == nullptr ? 0 : extent->value;
+    };
+    auto output_channels = [out_type](const std::string& layout_name) -> double {
+      tir::Layout layout(layout_name);
+      if (!layout.defined() || layout.ndim() != out_type->shape.size()) {
+        return 0;
+      }
+      double channels = 1;
+      for (size_t i = 0; i < layout.ndim(); ++i) {
+        if (tir::LayoutAxis::Get(layout->axes[i]).ToPrimal().name() == "C") {
+          const auto* extent = out_type->shape[i].as<IntImmNode>();
+          channels *= extent == nullptr ? 1 : extent->value;
+        }
+      }
+      return channels;
+    };
+    double reduction = 0;
+    if (call->attrs.as<DenseAttrs>()) {
+      reduction = last_dim(call->args[0], false);
+    } else if (const auto* attrs = call->attrs.as<BatchMatmulAttrs>()) {
+      reduction = last_dim(call->args[0], attrs->transpose_a);
+    } else if (const auto* attrs = call->attrs.as<Conv2DAttrs>()) {
+      double channels =
+          output_channels(attrs->out_layout.empty() ? attrs->data_layout : attrs->out_layout);
+      reduction = channels > 0 ? NumElements(call->args[1]->checked_type()) / channels : 0;
+    } else if (const auto* attrs = call->attrs.as<Conv2DTransposeAttrs>()) {
+      double channels =
+          output_channels(attrs->out_layout.empty() ? attrs->data_layout : attrs->out_layout);
+      reduction = channels > 0 ? NumElements(call->args[1]->checked_type()) / channels : 0;
+    }
+    return NumElements(call->checked_type()) * reduction;
+  }
+
+  /*! \brief The speedup of an integer multiply-add, e.g. of the int8 dot product instructions. */
+  static constexpr double kIntegerMacSpeedup = 4.0;
+  /*! \brief The cost of a dequantize or a quantize, i.e. its scale, shift, round and cast. */
+  static constexpr double kQuantizeCost = 3.0;
+  /*! \brief The cost of a requantize, i.e. its fixed point multiply, shift, clip and cast. */
+  static constexpr double kRequantizeCost = 4.0;
+
+  /*! \brief The inputs of the rewritten subgraph, where the visit stops. */
+  const ExprSet& inputs_;
+  /*! \brief The number of elements of the subgraph output. */
+  double out_elems_;
+  /*! \brief The cost of the requantizes and quantizes of the rewritten subgraph. */
+  double boundary_cost_{0};
+};
+
 class FakeQuantizationRewriter : public MixedModeMutator {
  public:
-  explicit FakeQuantizationRewriter(bool hard_fail) : hard_fail_(hard_fail) {}
+  FakeQuantizationRewriter(bool hard_fail, bool cost_check)
+      : hard_fail_(hard_fail), cost_check_(cost_check) {}
 
  protected:
   Expr Rewrite_(const CallNode* pre, const Expr& post) override {
@@ -288,13 +443,27 @@ class FakeQuantizationRewriter : public MixedModeMutator {
         }
         Expr out =
             SubgraphMutator(post_subgraph, post_affine_types, hard_fail_).MutateSubgraph(post);
+        if (cost_check_ && !out.same_as(post)) {
+          ExprSet inputs;
+          for (const Expr& expr : post_subgraph) {
+            const CallNode* node = expr.as<CallNode>();
+            if (node->op == dequantize_op_) {
+              inputs.insert(node->args[0]);
+            }
+          }
+          if (!IntegerCostEstimator::IsFaster(subgraph, GetRef<Expr>(pre), out, inputs)) {
+            return post;
+          }
+        }
         return out;
       }
     }
     return post;
   }
   const Op quantize_op_ = Op::Get("qnn.quantize");
+  const Op dequantize_op_ = Op::Get("qnn.dequantize");
   const bool hard_fail_;
+  const bool cost_check_;
 };
 
 /* Checks if the operation to convert QAT pass is enabled.
@@ -527,7 +696,10 @@ class QATRewriter : public MixedModeMutator {
 
 Expr FakeQuantizationToInteger(const Expr& expr, const IRModule& mod, bool hard_fail,
                                bool use_qat) {
-  auto fq_expr = FakeQuantizationRewriter(hard_fail).Mutate(expr);
+  bool cost_check = transform::PassContext::Current()
+                        ->GetConfig<Bool>("relay.FakeQuantizationToInteger.cost_check", Bool(false))
+                        .value();
+  auto fq_expr = FakeQuantizationRewriter(hard_fail, cost_check).Mutate(expr);
   if (use_qat) {
     fq_expr = tvm::relay::InferType(fq_expr);
     fq_expr = QATRewriter(hard_fail).Mutate(fq_expr);
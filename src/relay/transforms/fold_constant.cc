@@ -32,13 +32,19 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/object.h>
 
+#include <memory>
+#include <unordered_map>
+
 #include "../op/memory/on_device.h"
+#include "./pass_utils.h"
 #include "./pattern_utils.h"
 
 namespace tvm {
 namespace relay {
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.FoldConstant.share_cache", Bool);
+
 namespace {
 /*!
  * \brief Returns whether \p expr is a literal \p Constant, optionally wrapped by an "on_device"
@@ -63,6 +69,82 @@ bool IsComplexConstant(const Expr& expr) {
   }
 }
 
+/*!
+ * \brief The constants folded, and the functions compiled to fold them.
+ *
+ * Weight transforms are mostly the same few ops over constants of the same types, so a function
+ * compiled for one call of an op, with its constant arguments as parameters, is applied to all of
+ * them. The cache lives for one FoldConstant invocation, unless "relay.FoldConstant.share_cache"
+ * is set, in which case the results are also reused by the later FoldConstant passes run under
+ * the same pass context on this thread.
+ */
+class ConstantFoldingCache {
+ public:
+  using Kernel = TypedPackedFunc<ObjectRef(Array<Expr>)>;
+
+  /*! \brief The cache for a FoldConstant invocation under the current pass context. */
+  static std::shared_ptr<ConstantFoldingCache> Create() {
+    transform::PassContext pass_ctx = transform::PassContext::Current();
+    if (!pass_ctx->GetConfig<Bool>("relay.FoldConstant.share_cache", Bool(false)).value()) {
+      return std::make_shared<ConstantFoldingCache>();
+    }
+    // Only one is kept per thread, and it is released when the thread folds under another context
+    static thread_local std::shared_ptr<ConstantFoldingCache> shared;
+    if (shared == nullptr || !shared->pass_ctx_.same_as(pass_ctx)) {
+      shared = std::make_shared<ConstantFoldingCache>();
+      shared->pass_ctx_ = pass_ctx;
+    }
+    return shared;
+  }
+
+  /*! \brief The folded constant of a call, keyed by the call over constants. */
+  Optional<Expr> GetResult(const Expr& expr) const {
+    auto it = results_.find(expr);
+    return it != results_.end() ? Optional<Expr>(it->second) : NullOpt;
+  }
+
+  /*! \brief Record the folded constant of a call over constants. */
+  void AddResult(const Expr& expr, const Expr& result) {
+    // The results may be kept for the whole build, so the ones of a huge model are not
+    if (cached_bytes_ > kMaxCachedBytes) return;
+    PostOrderVisit(result, [this](const Expr& e) {
+      if (const auto* constant = e.as<ConstantNode>()) {
+        cached_bytes_ += runtime::GetDataSize(*constant->data.operator->());
+      }
+    });
+    results_.emplace(expr, result);
+  }
+
+  /*! \brief The function compiled for the calls of an op, keyed by the function over constants. */
+  bool GetKernel(const Function& func, Kernel* kernel) const {
+    auto it = kernels_.find(func);
+    if (it == kernels_.end()) return false;
+    *kernel = it->second;
+    return true;
+  }
+
+  /*! \brief Record the function compiled for the calls of an op. */
+  void AddKernel(const Function& func, const Kernel& kernel) {
+    if (kernels_.size() >= kMaxKernels) return;
+    kernels_.emplace(func, kernel);
+  }
+
+ private:
+  /*! \brief The maximum size of the cached results. */
+  static constexpr size_t kMaxCachedBytes = size_t(1) << 30;
+  /*! \brief The maximum number of the compiled functions. */
+  static constexpr size_t kMaxKernels = 256;
+
+  /*! \brief The pass context the cache belongs to. */
+  transform::PassContext pass_ctx_{nullptr};
+  /*! \brief The folded constants. */
+  std::unordered_map<Expr, Expr, StructuralHash, StructuralEqual> results_;
+  /*! \brief The size of the constants in `results_`. */
+  size_t cached_bytes_ = 0;
+  /*! \brief The functions compiled for the calls of an op. */
+  std::unordered_map<Function, Kernel, StructuralHash, StructuralEqual> kernels_;
+};
+
 // TODO(tvm-team) consider combine dead-code with constant folder.
 // or make a more powerful partial evaluator.
 class ConstantFolder : public MixedModeMutator {
@@ -70,6 +152,7 @@ class ConstantFolder : public MixedModeMutator {
   explicit ConstantFolder(IRModule module, bool fold_qnn)
       : module_(std::move(module)),
         fold_qnn_(fold_qnn),
+        cache_(ConstantFoldingCache::Create()),
         device_copy_op_(Op::Get("device_copy")),
         shape_of_op_(Op::Get("shape_of")),
         vm_shape_of_op_(Op::Get("vm.shape_of")),
@@ -247,11 +330,37 @@ class ConstantFolder : public MixedModeMutator {
     }
   }
 
+  /*!
+   * \brief Abstract the constant arguments of a call into the parameters of a function.
+   * \return The function, which is the same for the calls of the same op with the same attributes
+   * over constants of the same types, or NullOpt if some argument is not a tensor constant, or
+   * the type of the result depends on the value of the arguments.
+   */
+  Optional<Function> AbstractConstantArgs(const Call& call) {
+    if (!call->op->IsInstance<OpNode>()) return NullOpt;
+    Array<Var> params;
+    for (const Expr& arg : call->args) {
+      const auto* constant = arg.as<ConstantNode>();
+      if (constant == nullptr) return NullOpt;
+      params.push_back(Var("p" + std::to_string(params.size()), constant->tensor_type()));
+    }
+    Function func(params, Call(call->op, {params.begin(), params.end()}, call->attrs),
+                  /*ret_type=*/Type(), /*ty_params=*/{});
+    Expr typed = InferType(func);
+    if (IsDynamic(Downcast<Function>(typed)->body->checked_type())) return NullOpt;
+    return func;
+  }
+
   // Constant evaluate an expression.
   Expr ConstEvaluate(const Expr& expr) {
     VLOG_CONTEXT << "ConstEvaluate";
     VLOG(1) << "Evaluating :" << std::endl << PrettyPrint(expr);
 
+    if (Optional<Expr> result = cache_->GetResult(expr)) {
+      VLOG(1) << "Folded before to constant:" << std::endl << PrettyPrint(result.value());
+      return result.value();
+    }
+
     // We'll invoke the interpreter using the generic CPU device and target. Technically there's
     // no guarantee the results will be bitwise equal what we'd get on the true device, however to
     // support cross-compilation we don't want to assume the true device is available.
@@ -267,8 +376,22 @@ class ConstantFolder : public MixedModeMutator {
     // always use graph executor with no link-params
     dict.Set(tvm::attr::kExecutor,
              relay::Executor::Create("graph", {{"link-params", Bool(false)}}));
-    Expr result = ObjectToExpr(Eval(expr, module_->type_definitions, module_->Imports(),
-                                    eval_cpu_dev_, eval_cpu_target_, dict));
+    Expr result;
+    const auto* call = expr.as<CallNode>();
+    if (Optional<Function> func = call ? AbstractConstantArgs(GetRef<Call>(call)) : NullOpt) {
+      ConstantFoldingCache::Kernel kernel;
+      if (!cache_->GetKernel(func.value(), &kernel)) {
+        IRModule mod(/*functions=*/{}, module_->type_definitions, module_->Imports(),
+                     /*map=*/{}, DictAttrs(dict));
+        kernel = EvalFunction(mod, func.value(), eval_cpu_dev_, eval_cpu_target_);
+        cache_->AddKernel(func.value(), kernel);
+      }
+      result = ObjectToExpr(kernel(call->args));
+    } else {
+      result = ObjectToExpr(Eval(expr, module_->type_definitions, module_->Imports(),
+                                 eval_cpu_dev_, eval_cpu_target_, dict));
+    }
+    cache_->AddResult(expr, result);
     VLOG(1) << "Evaluated to constant:" << std::endl << PrettyPrint(result);
     return result;
   }
@@ -395,6 +518,9 @@ class ConstantFolder : public MixedModeMutator {
   // Whether to fold constants for QNN operations.
   bool fold_qnn_;
 
+  // The constants folded and the functions compiled to fold them.
+  std::shared_ptr<ConstantFoldingCache> cache_;
+
   // The kDLCPU device assumed to be available to the compiler. Used only when evaluating
   // sub-expressions.
   Device eval_cpu_dev_{kDLCPU, /*device_id=*/0};
@@ -25,11 +25,14 @@
  *   Fuse necessary ops into a single one.
  */
 #include <tvm/relay/analysis.h>
+#include <tvm/relay/attrs/transform.h>
 #include <tvm/relay/executor.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/op_attr_types.h>
 #include <tvm/relay/transform.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/tir/op.h>
+#include <tvm/topi/detail/strided_slice.h>
 
 #include "../../support/arena.h"
 #include "../analysis/graph_partitioner.h"
@@ -84,10 +87,16 @@ using support::LinkNode;
 
 constexpr uint32_t kMaxFusedOps = 256;
 
+constexpr double kDefaultFlopsPerByte = 8.0;
+
 static const Op& stop_fusion_op = Op::Get("annotation.stop_fusion");
 
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.FuseOps.max_depth", Integer);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.FuseOps.link_params", Bool);
+// Whether to fuse by the memory traffic saved against the cost of recompute, see GraphPartitioner
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.FuseOps.cost_driven", Bool);
+// The FLOPs worth one byte of memory traffic when fusing by cost
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.FuseOps.flops_per_byte", FloatImm);
 
 // Creator of post dominator tree of the dataflow
 class IndexedForwardGraphCreator : private ExprVisitor {
@@ -317,12 +326,235 @@ class IndexedForwardGraphCreator : private ExprVisitor {
   }
 };
 
+/*!
+ * \brief Returns the byte offset of the result of \p body in its input when \p body is a static
+ * strided_slice of a parameter whose result is contiguous in the input, and starts at an offset
+ * which keeps the alignment of the allocations. Otherwise returns -1.
+ */
+int64_t StridedSliceViewByteOffset(const Expr& body, const Type& ret_type) {
+  static const Op& strided_slice_op = Op::Get("strided_slice");
+  const auto* call = body.as<CallNode>();
+  if (call == nullptr || !call->op.same_as(strided_slice_op) || call->args.size() != 1 ||
+      !call->args[0]->IsInstance<VarNode>()) {
+    return -1;
+  }
+  const auto* param = call->attrs.as<StridedSliceAttrs>();
+  const auto* in_type = call->args[0].as<VarNode>()->type_annotation.as<TensorTypeNode>();
+  const auto* out_type = ret_type.as<TensorTypeNode>();
+  if (param == nullptr || !param->begin || !param->end || !param->strides || in_type == nullptr ||
+      out_type == nullptr || in_type->shape.size() != out_type->shape.size() ||
+      in_type->dtype.bits() % 8 != 0) {
+    return -1;
+  }
+  size_t ndim = in_type->shape.size();
+  std::vector<int64_t> in_shape(ndim), out_shape(ndim);
+  for (size_t i = 0; i < ndim; ++i) {
+    const auto* in_dim = in_type->shape[i].as<IntImmNode>();
+    const auto* out_dim = out_type->shape[i].as<IntImmNode>();
+    if (in_dim == nullptr || out_dim == nullptr) {
+      return -1;
+    }
+    in_shape[i] = in_dim->value;
+    out_shape[i] = out_dim->value;
+  }
+  Array<Integer> begin = param->begin.value();
+  Array<Integer> strides = param->strides.value();
+  std::vector<int64_t> begin_vec(ndim, 0);
+  for (size_t i = 0; i < begin.size(); ++i) {
+    int64_t axis = param->axes ? param->axes.value()[i]->value : static_cast<int64_t>(i);
+    if (param->slice_mode == "end" && i < strides.size() && strides[i]->value != 1) {
+      return -1;
+    }
+    if (axis < 0 || axis >= static_cast<int64_t>(ndim)) {
+      return -1;
+    }
+    int64_t index = begin[i].defined() ? begin[i]->value : 0;
+    begin_vec[axis] = topi::detail::CanonicalizeIndex(index, in_shape[axis], 1);
+  }
+  if (param->slice_mode == "end") {
+    for (size_t i = begin.size(); i < strides.size(); ++i) {
+      if (strides[i]->value != 1) return -1;
+    }
+  }
+  // The result is contiguous when all the axes before the innermost sliced one have extent 1.
+  int64_t offset = 0;
+  int64_t stride = 1;
+  bool inner_sliced = false;
+  for (size_t i = ndim; i-- > 0;) {
+    if (inner_sliced && out_shape[i] != 1) {
+      return -1;
+    }
+    inner_sliced |= out_shape[i] != in_shape[i];
+    offset += begin_vec[i] * stride;
+    stride *= in_shape[i];
+  }
+  offset *= in_type->dtype.bytes() * in_type->dtype.lanes();
+  return offset % runtime::kAllocAlignment == 0 ? offset : -1;
+}
+
+/*!
+ * \brief Returns the indices of the parameters of a fused function whose buffer can receive its
+ * result. Such a parameter has the type of the result, and only reaches the result through
+ * elementwise and broadcast operators, so each element of the result only reads the element of the
+ * parameter at the same index.
+ */
+Array<Integer> InplaceParams(const Array<Var>& params, const Expr& body, const Type& ret_type) {
+  class DependsOnParam : public ExprVisitor {
+   public:
+    explicit DependsOnParam(const VarNode* param) : param_(param) {}
+
+    /*! \return Whether the only paths from the parameter to \p body are through elementwise and
+     * broadcast calls. */
+    bool Check(const Expr& body) {
+      VisitExpr(body);
+      return aligned_ && depends_.count(body.get());
+    }
+
+   private:
+    void VisitExpr_(const VarNode* op) final {
+      if (op == param_) depends_.insert(op);
+    }
+
+    void VisitExpr_(const CallNode* op) final {
+      static auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
+      ExprVisitor::VisitExpr_(op);
+      bool depends = std::any_of(op->args.begin(), op->args.end(),
+                                 [this](const Expr& arg) { return depends_.count(arg.get()); });
+      if (!depends) return;
+      depends_.insert(op);
+      const auto* op_node = op->op.as<OpNode>();
+      if (op_node == nullptr || fpattern.get(GetRef<Op>(op_node), kOpaque) > kBroadcast) {
+        aligned_ = false;
+      }
+    }
+
+    void VisitExpr_(const TupleNode* op) final {
+      ExprVisitor::VisitExpr_(op);
+      for (const Expr& field : op->fields) {
+        if (depends_.count(field.get())) aligned_ = false;
+      }
+    }
+
+    void VisitExpr_(const TupleGetItemNode* op) final {
+      ExprVisitor::VisitExpr_(op);
+      if (depends_.count(op->tuple.get())) aligned_ = false;
+    }
+
+    void VisitExpr_(const LetNode* op) final {
+      ExprVisitor::VisitExpr_(op);
+      if (depends_.count(op->value.get())) aligned_ = false;
+    }
+
+    const VarNode* param_;
+    std::unordered_set<const Object*> depends_;
+    bool aligned_ = true;
+  };
+
+  Array<Integer> inplace_params;
+  if (!ret_type->IsInstance<TensorTypeNode>()) {
+    return inplace_params;
+  }
+  for (size_t i = 0; i < params.size(); ++i) {
+    if (params[i]->type_annotation.defined() &&
+        StructuralEqual()(params[i]->type_annotation, ret_type) &&
+        DependsOnParam(params[i].get()).Check(body)) {
+      inplace_params.push_back(static_cast<int>(i));
+    }
+  }
+  return inplace_params;
+}
+
+/*!
+ * \brief Returns true if the body of a fused function is a single weight layout transform, as
+ * inserted by RewriteLayout, of one of its parameters.
+ */
+bool IsLayoutTransformOnly(const Array<Var>& params, const Expr& body) {
+  static const Op& meta_schedule_layout_transform_op = Op::Get("meta_schedule_layout_transform");
+  static const Op& auto_scheduler_layout_transform_op = Op::Get("auto_scheduler_layout_transform");
+  const auto* call = body.as<CallNode>();
+  if (call == nullptr || (call->op != meta_schedule_layout_transform_op &&
+                          call->op != auto_scheduler_layout_transform_op)) {
+    return false;
+  }
+  const auto* var = call->args[0].as<VarNode>();
+  return var != nullptr && std::any_of(params.begin(), params.end(),
+                                       [var](const Var& param) { return param.get() == var; });
+}
+
+/*!
+ * \brief Returns the byte offset in the result of each parameter of a fused function which is a
+ * single static concatenate of its distinct parameters, when each parameter is a contiguous slice
+ * of the result starting at an offset which keeps the alignment of the allocations. Otherwise
+ * returns an empty array.
+ */
+Array<Integer> ConcatByteOffsets(const Array<Var>& params, const Expr& body, const Type& ret_type) {
+  static const Op& concatenate_op = Op::Get("concatenate");
+  const auto* call = body.as<CallNode>();
+  if (call == nullptr || !call->op.same_as(concatenate_op) || call->args.size() != 1) {
+    return {};
+  }
+  const auto* tuple = call->args[0].as<TupleNode>();
+  const auto* param = call->attrs.as<ConcatenateAttrs>();
+  const auto* out_type = ret_type.as<TensorTypeNode>();
+  if (tuple == nullptr || param == nullptr || out_type == nullptr ||
+      tuple->fields.size() != params.size() || out_type->dtype.bits() % 8 != 0) {
+    return {};
+  }
+  int ndim = static_cast<int>(out_type->shape.size());
+  int axis = param->axis < 0 ? param->axis + ndim : param->axis;
+  if (axis < 0 || axis >= ndim) {
+    return {};
+  }
+  // The slices are contiguous when all the axes before the concatenated one have extent 1.
+  for (int i = 0; i < axis; ++i) {
+    const auto* dim = out_type->shape[i].as<IntImmNode>();
+    if (dim == nullptr || dim->value != 1) {
+      return {};
+    }
+  }
+  std::vector<int64_t> param_offsets(params.size(), -1);
+  int64_t offset = 0;
+  for (const Expr& field : tuple->fields) {
+    auto it = std::find_if(params.begin(), params.end(),
+                           [&field](const Var& var) { return var.same_as(field); });
+    if (it == params.end()) {
+      return {};
+    }
+    const auto* field_type = (*it)->type_annotation.as<TensorTypeNode>();
+    if (field_type == nullptr || field_type->dtype != out_type->dtype ||
+        offset % runtime::kAllocAlignment != 0) {
+      return {};
+    }
+    size_t index = std::distance(params.begin(), it);
+    if (param_offsets[index] >= 0) {
+      return {};
+    }
+    param_offsets[index] = offset;
+    int64_t size = field_type->dtype.bytes() * field_type->dtype.lanes();
+    for (const PrimExpr& dim : field_type->shape) {
+      const auto* imm = dim.as<IntImmNode>();
+      if (imm == nullptr) {
+        return {};
+      }
+      size *= imm->value;
+    }
+    offset += size;
+  }
+  Array<Integer> offsets;
+  for (int64_t param_offset : param_offsets) {
+    offsets.push_back(Integer(IntImm(DataType::Int(64), param_offset)));
+  }
+  return offsets;
+}
+
 class FuseMutator : private MixedModeMutator {
  public:
-  FuseMutator(int fuse_opt_level, size_t max_fuse_depth, bool link_params)
+  FuseMutator(int fuse_opt_level, size_t max_fuse_depth, bool link_params,
+              double flops_per_byte = 0.0)
       : fuse_opt_level_(fuse_opt_level),
         max_fuse_depth_(max_fuse_depth),
-        link_params_(link_params) {}
+        link_params_(link_params),
+        flops_per_byte_(flops_per_byte) {}
 
   // Run the transform
   Expr Transform(const Expr& body) {
@@ -334,7 +566,8 @@ class FuseMutator : private MixedModeMutator {
   Expr Transform(const Expr& body, int fuse_opt_level, size_t max_fuse_depth, bool link_params) {
     // setup the group map.
     auto graph = IndexedForwardGraphCreator::Create(&arena_, body);
-    auto groups = GraphPartitioner(&arena_, fuse_opt_level, max_fuse_depth).Partition(graph);
+    auto groups = GraphPartitioner(&arena_, fuse_opt_level, max_fuse_depth, flops_per_byte_)
+                      .Partition(graph);
     for (size_t nid = 0; nid < graph.post_dfs_order.size(); ++nid) {
       ICHECK(graph.post_dfs_order[nid]->ref != nullptr);
       gmap_[graph.post_dfs_order[nid]->ref] = groups[nid];
@@ -348,6 +581,7 @@ class FuseMutator : private MixedModeMutator {
   int fuse_opt_level_;
   size_t max_fuse_depth_;
   bool link_params_;
+  double flops_per_byte_;
 
   using MixedModeMutator::VisitExpr_;
 
@@ -509,6 +743,19 @@ class FuseMutator : private MixedModeMutator {
     // TODO(mbs): "reshape" cleanup.
     if (visitor.has_call && visitor.reshape_only) {
       func = WithAttr(std::move(func), attr::kReshapeOnly, tvm::Integer(visitor.reshape_only));
+    } else if (int64_t offset = StridedSliceViewByteOffset(body, ret_type); offset >= 0) {
+      func = WithAttr(std::move(func), attr::kViewByteOffset,
+                      Integer(IntImm(DataType::Int(64), offset)));
+    } else if (Array<Integer> offsets = ConcatByteOffsets(ginfo.params, body, ret_type);
+               !offsets.empty()) {
+      func = WithAttr(std::move(func), attr::kConcatByteOffsets, offsets);
+    } else if (IsLayoutTransformOnly(ginfo.params, body)) {
+      func = WithAttr(std::move(func), attr::kLayoutTransformOnly, tvm::Integer(1));
+    } else if (visitor.has_call) {
+      Array<Integer> inplace_params = InplaceParams(ginfo.params, body, ret_type);
+      if (!inplace_params.empty()) {
+        func = WithAttr(std::move(func), attr::kInplaceParams, inplace_params);
+      }
     }
     return Call(func, ginfo.arguments, Attrs());
   }
@@ -549,8 +796,8 @@ class FuseMutator : private MixedModeMutator {
 };
 
 Expr FuseOps(const Expr& expr, int fuse_opt_level, size_t max_fuse_depth, bool link_params,
-             const IRModule& module) {
-  return FuseMutator(fuse_opt_level, max_fuse_depth, link_params).Transform(expr);
+             const IRModule& module, double flops_per_byte = 0.0) {
+  return FuseMutator(fuse_opt_level, max_fuse_depth, link_params, flops_per_byte).Transform(expr);
 }
 
 namespace transform {
@@ -567,8 +814,18 @@ Pass FuseOps(int fuse_opt_level) {
         link_params = pc->GetConfig("relay.FuseOps.link_params", Bool(link_params)).value();
         int opt_level = fuse_opt_level == -1 ? pc->opt_level : fuse_opt_level;
         auto max_fuse_depth = pc->GetConfig("relay.FuseOps.max_depth", Integer(kMaxFusedOps));
-        return Downcast<Function>(
-            FuseOps(f, opt_level, max_fuse_depth.value().IntValue(), link_params, m));
+        double flops_per_byte = 0.0;
+        if (pc->GetConfig("relay.FuseOps.cost_driven", Bool(false)).value()) {
+          flops_per_byte = pc->GetConfig("relay.FuseOps.flops_per_byte",
+                                         FloatImm(DataType::Float(64), kDefaultFlopsPerByte))
+                               .value()
+                               ->value;
+          CHECK_GT(flops_per_byte, 0)
+              << "ValueError: relay.FuseOps.flops_per_byte should be positive, but gets "
+              << flops_per_byte;
+        }
+        return Downcast<Function>(FuseOps(f, opt_level, max_fuse_depth.value().IntValue(),
+                                          link_params, m, flops_per_byte));
       };
   return CreateFunctionPass(pass_func, 0, "FuseOps", {"InferType"});
 }
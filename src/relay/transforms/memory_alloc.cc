@@ -39,6 +39,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -59,6 +60,93 @@ using namespace tvm::runtime;
 namespace tvm {
 namespace relay {
 
+/*! \brief Counts the uses of the variables, the bindings of the let variables not being uses. */
+class VarUseCounter : public ExprVisitor {
+ public:
+  std::unordered_map<const Object*, size_t> Count(const Expr& expr) {
+    VisitExpr(expr);
+    return std::move(visit_counter_);
+  }
+
+ private:
+  void VisitExpr_(const LetNode* op) final {
+    Expr expr = GetRef<Let>(op);
+    while (const auto* let_node = expr.as<LetNode>()) {
+      VisitExpr(let_node->value);
+      expr = let_node->body;
+    }
+    VisitExpr(expr);
+  }
+};
+
+/*!
+ * \brief Finds the concatenates whose arguments are all bound, in the let chain of the
+ * concatenate, to the results of static primitive calls only used by the concatenate. The results
+ * of these calls can be allocated in their slices of the result of the concatenate.
+ */
+class ConcatSliceFinder : public ExprVisitor {
+ public:
+  /*! \brief The concatenate, and the byte offset in its result, of a call computed in place. */
+  using Slice = std::pair<const CallNode*, int64_t>;
+
+  explicit ConcatSliceFinder(const std::unordered_map<const Object*, size_t>& use_counts)
+      : use_counts_(use_counts) {}
+
+  std::unordered_map<const CallNode*, Slice> Find(const Expr& expr) {
+    VisitExpr(expr);
+    return std::move(slices_);
+  }
+
+ private:
+  void VisitExpr_(const LetNode* op) final {
+    std::unordered_map<const VarNode*, const CallNode*> bound_calls;
+    Expr expr = GetRef<Let>(op);
+    while (const auto* let_node = expr.as<LetNode>()) {
+      VisitExpr(let_node->value);
+      if (const auto* call_node = IgnoreOnDevice(let_node->value).as<CallNode>()) {
+        CallLoweredProps props = GetCallLoweredProps(call_node);
+        if (props.lowered_func.defined()) {
+          FindSlices(call_node, props, bound_calls);
+          bound_calls.emplace(let_node->var.get(), call_node);
+        }
+      }
+      expr = let_node->body;
+    }
+    VisitExpr(expr);
+  }
+
+  void FindSlices(const CallNode* call_node, const CallLoweredProps& props,
+                  const std::unordered_map<const VarNode*, const CallNode*>& bound_calls) {
+    Array<Integer> offsets = GetConcatByteOffsets(props);
+    if (offsets.empty() || offsets.size() != props.arguments.size() ||
+        IsDynamic(call_node->checked_type())) {
+      return;
+    }
+    std::vector<const CallNode*> producers;
+    for (const Expr& arg : props.arguments) {
+      const auto* var = IgnoreOnDevice(arg).as<VarNode>();
+      if (var == nullptr || !bound_calls.count(var) || !use_counts_.count(var) ||
+          use_counts_.at(var) != 1) {
+        return;
+      }
+      const CallNode* producer = bound_calls.at(var);
+      CallLoweredProps producer_props = GetCallLoweredProps(producer);
+      if (IsReshapeOnly(producer_props) || !GetConcatByteOffsets(producer_props).empty() ||
+          !producer->checked_type()->IsInstance<TensorTypeNode>() ||
+          IsDynamic(producer->checked_type())) {
+        return;
+      }
+      producers.push_back(producer);
+    }
+    for (size_t i = 0; i < producers.size(); ++i) {
+      slices_.emplace(producers[i], Slice{call_node, offsets[i]->value});
+    }
+  }
+
+  const std::unordered_map<const Object*, size_t>& use_counts_;
+  std::unordered_map<const CallNode*, Slice> slices_;
+};
+
 class DialectRewriter : public transform::DeviceAwareExprMutator {
  public:
   DialectRewriter(IRModule mod, VirtualDevice host_virtual_device)
@@ -66,7 +154,14 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
         mod_(std::move(mod)),
         host_virtual_device_(std::move(host_virtual_device)) {}
 
-  Function Rewrite(const Function& expr) { return Downcast<Function>(Mutate(expr)); }
+  Function Rewrite(const Function& expr) {
+    inplace_ = transform::PassContext::Current()
+                   ->GetConfig<Bool>("relay.backend.inplace_elemwise", Bool(false))
+                   .value();
+    use_counts_ = VarUseCounter().Count(expr);
+    concat_slices_ = ConcatSliceFinder(use_counts_).Find(expr);
+    return Downcast<Function>(Mutate(expr));
+  }
 
  private:
   using ExprMutator::VisitExpr_;
@@ -101,6 +196,13 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
     Expr new_value = Mutate(value);
     VirtualDevice virtual_device = GetVirtualDevice(value);
     ICHECK(!virtual_device->IsFullyUnconstrained());
+    // The variable bound to a result owns its tensor, unless it aliases a variable used elsewhere.
+    const Object* bound = IgnoreOnDevice(new_value).get();
+    auto it = owned_tensors_.find(bound);
+    auto count_it = use_counts_.find(bound);
+    if (it != owned_tensors_.end() && (count_it == use_counts_.end() || count_it->second == 1)) {
+      owned_tensors_.emplace(var.get(), it->second);
+    }
     scopes_.back().Push(var, MaybeOnDeviceFixed(new_value, virtual_device));
     // Since we always need a let block on which to bind sub-expressions the rewritten bindings
     // are tracked in the current scopes. But return the rewritten binding anyway.
@@ -183,11 +285,35 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
                            out_types, ret_type, virtual_device);
     }
 
+    // Handle the concatenates whose arguments were computed in their slices of the result.
+    auto concat_it = concat_storages_.find(call_node);
+    if (concat_it != concat_storages_.end() &&
+        concat_it->second.num_slices == call_lowered_props.arguments.size() &&
+        concat_it->second.virtual_device == virtual_device) {
+      ICHECK_EQ(out_types.size(), 1U);
+      Expr tensor = AllocTensor(concat_it->second.storage, MakeStaticShape(out_types[0]),
+                                out_types[0]->dtype, out_types[0]->shape);
+      Var tensor_var = scope.Push(Var("tensor_concat", Type(nullptr)),
+                                  MaybeOnDeviceFixed(tensor, virtual_device));
+      owned_tensors_.emplace(tensor_var.get(), OwnedTensor{virtual_device, function_nesting()});
+      return std::move(tensor_var);
+    }
+
     // Handle ordinary primitive calls.
     Array<Expr> outputs;
-    for (size_t i = 0; i < out_types.size(); ++i) {
-      outputs.push_back(
-          MakeStaticAllocation(&scope, out_types[i], virtual_device, std::to_string(i)));
+    if (Optional<Var> slice = AllocConcatSlice(&scope, call_node, out_types, virtual_device)) {
+      outputs.push_back(slice.value());
+    } else if (Optional<Var> inplace =
+                   FindInplaceArgument(call_lowered_props, new_args, virtual_device)) {
+      outputs.push_back(inplace.value());
+    } else {
+      for (size_t i = 0; i < out_types.size(); ++i) {
+        outputs.push_back(
+            MakeStaticAllocation(&scope, out_types[i], virtual_device, std::to_string(i)));
+      }
+    }
+    for (const Expr& output : outputs) {
+      owned_tensors_.emplace(output.get(), OwnedTensor{virtual_device, function_nesting()});
     }
     Tuple outs(outputs);
     Expr invoke =
@@ -197,6 +323,66 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
     return ToTupleType(ret_type, std::vector<Expr>(outputs.begin(), outputs.end()));
   }
 
+  /*!
+   * \brief Returns the tensor allocated for the result of \p call_node in its slice of the result
+   * of the concatenate which is its only use, allocating the storage of the concatenate at its
+   * first slice, or NullOpt if the result is allocated on its own.
+   */
+  Optional<Var> AllocConcatSlice(LetList* scope, const CallNode* call_node,
+                                 const std::vector<TensorType>& out_types,
+                                 const VirtualDevice& virtual_device) {
+    auto slice_it = concat_slices_.find(call_node);
+    if (slice_it == concat_slices_.end() || out_types.size() != 1) {
+      return NullOpt;
+    }
+    const CallNode* concat = slice_it->second.first;
+    auto it = concat_storages_.find(concat);
+    if (it == concat_storages_.end()) {
+      TensorType concat_type = Downcast<TensorType>(concat->checked_type());
+      Expr size = MaybeOnDeviceFixed(ComputeStorage(concat_type), host_virtual_device_);
+      Expr storage = AllocStorage(size, ComputeAlignment(concat_type->dtype), virtual_device,
+                                  concat_type->dtype);
+      Var storage_var = scope->Push(Var("storage_concat", Type(nullptr)),
+                                    MaybeOnDeviceFixed(storage, virtual_device));
+      it = concat_storages_.emplace(concat, ConcatStorage{storage_var, virtual_device, 0}).first;
+    }
+    if (it->second.virtual_device != virtual_device) {
+      return NullOpt;
+    }
+    it->second.num_slices += 1;
+    Expr tensor = AllocTensor(it->second.storage, MakeStaticShape(out_types[0]),
+                              out_types[0]->dtype, out_types[0]->shape, slice_it->second.second);
+    return scope->Push(Var("tensor_concat_slice", Type(nullptr)),
+                       MaybeOnDeviceFixed(tensor, virtual_device));
+  }
+
+  /*!
+   * \brief Returns the argument of the lowered call described by \p props whose tensor can
+   * receive the result of the call, as the call is its only use.
+   */
+  Optional<Var> FindInplaceArgument(const CallLoweredProps& props, const std::vector<Expr>& args,
+                                    const VirtualDevice& virtual_device) {
+    if (!inplace_) {
+      return NullOpt;
+    }
+    for (const Integer& index : GetInplaceParams(props)) {
+      const auto* var = IgnoreOnDevice(args[index.IntValue()]).as<VarNode>();
+      if (var == nullptr) {
+        continue;
+      }
+      // Only the tensors allocated for the results of the calls of this function are reused,
+      // not those of the inputs or of views. A use in a closure may also be repeated.
+      auto it = owned_tensors_.find(var);
+      auto count_it = use_counts_.find(var);
+      if (it != owned_tensors_.end() && count_it != use_counts_.end() && count_it->second == 1 &&
+          it->second.virtual_device == virtual_device &&
+          it->second.function_nesting == function_nesting()) {
+        return GetRef<Var>(var);
+      }
+    }
+    return NullOpt;
+  }
+
   /*!
    * \brief Returns the Relay Constant representing the 1d tensor with \p value.
    *
@@ -206,11 +392,14 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
     return MakeConstantTensor(DataType::Int(64), {static_cast<int64_t>(value.size())}, value);
   }
 
-  /*! Returns an \p alloc_tensor call for a tensor of \p shape and \p dtype over \p storage. */
+  /*!
+   * Returns an \p alloc_tensor call for a tensor of \p shape and \p dtype over \p storage, at
+   * the byte \p offset.
+   */
   inline Expr AllocTensor(const Expr& storage, tvm::relay::Expr shape, DataType dtype,
-                          Array<IndexExpr> assert_shape) {
-    Expr offset =
-        MaybeOnDeviceFixed(MakeConstantScalar(DataType::Int(64), 0), host_virtual_device_);
+                          Array<IndexExpr> assert_shape, int64_t offset_bytes = 0) {
+    Expr offset = MaybeOnDeviceFixed(MakeConstantScalar(DataType::Int(64), offset_bytes),
+                                     host_virtual_device_);
     return tvm::relay::AllocTensor(storage, std::move(offset), std::move(shape), dtype,
                                    assert_shape);
   }
@@ -244,16 +433,21 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
     return std::move(MakeConstantScalar(DataType::Int(64), size));
   }
 
-  // Allocate a tensor with a statically known shape.
-  Var MakeStaticAllocation(LetList* scope, const TensorType& type,
-                           const VirtualDevice& virtual_device, String name_hint) {
+  /*! \brief Returns the host constant holding the static shape of \p type. */
+  Expr MakeStaticShape(const TensorType& type) {
     std::vector<int64_t> int_shape;
     for (auto it : type->shape) {
       const auto* imm = it.as<IntImmNode>();
       CHECK(imm) << "expect static int shape";
       int_shape.push_back(imm->value);
     }
-    Expr shape = MaybeOnDeviceFixed(MakeConstant(int_shape), host_virtual_device_);
+    return MaybeOnDeviceFixed(MakeConstant(int_shape), host_virtual_device_);
+  }
+
+  // Allocate a tensor with a statically known shape.
+  Var MakeStaticAllocation(LetList* scope, const TensorType& type,
+                           const VirtualDevice& virtual_device, String name_hint) {
+    Expr shape = MakeStaticShape(type);
     Expr size = MaybeOnDeviceFixed(ComputeStorage(type), host_virtual_device_);
     // Alignment is directly captured in the instruction rather than calculated, so we
     // don't want to wrap it with an "on_device".
@@ -419,6 +613,31 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
   VirtualDevice host_virtual_device_;
 
   std::vector<LetList> scopes_;
+
+  /*! \brief A tensor allocated for the result of a call of the function being rewritten. */
+  struct OwnedTensor {
+    VirtualDevice virtual_device;
+    /*! \brief The depth of the function whose call allocated the tensor. */
+    int function_nesting;
+  };
+  /*! \brief Whether elementwise calls write their result over an input at its only use. */
+  bool inplace_ = false;
+  /*! \brief The number of uses of the variables of the function. */
+  std::unordered_map<const Object*, size_t> use_counts_;
+  /*! \brief The variables and allocations holding the tensors allocated for results. */
+  std::unordered_map<const Object*, OwnedTensor> owned_tensors_;
+
+  /*! \brief The storage of the result of a concatenate whose arguments are computed in place. */
+  struct ConcatStorage {
+    Var storage;
+    VirtualDevice virtual_device;
+    /*! \brief The number of arguments allocated in their slices so far. */
+    size_t num_slices;
+  };
+  /*! \brief The concatenate and the byte offset in its result of the calls computed in place. */
+  std::unordered_map<const CallNode*, ConcatSliceFinder::Slice> concat_slices_;
+  /*! \brief The storages of the concatenates, allocated at the first of their slices. */
+  std::unordered_map<const CallNode*, ConcatStorage> concat_storages_;
 };
 
 namespace transform {
@@ -32,6 +32,12 @@
 #include <tvm/relay/transform.h>
 #include <tvm/te/operation.h>
 
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+
+#include "../ir/dataflow_matcher_impl.h"
+
 namespace tvm {
 namespace relay {
 namespace merge_composite {
@@ -47,13 +53,34 @@ Expr MergeComposite(const Function& func, const Array<runtime::String>& pattern_
                     const Array<DFPattern>& patterns, const std::vector<PackedFunc>& checks,
                     const IRModule& m) {
   ICHECK_EQ(pattern_names.size(), patterns.size());
+  // Merging only ever moves calls into composite functions, so a pattern which must be rooted at
+  // an operator the function does not call cannot match.
+  std::unordered_set<std::string> called_ops;
+  PostOrderVisit(func, [&called_ops](const Expr& expr) {
+    if (const auto* op_node = expr.as<OpNode>()) {
+      called_ops.insert(op_node->name);
+    }
+  });
   Function merged_func = func;
+  bool typed = false;
   // merge the patterns one-by-one in order
   for (size_t i = 0; i < patterns.size(); i++) {
+    Optional<Array<String>> root_ops = GetPatternRootOps(patterns[i]);
+    if (root_ops.defined() &&
+        std::none_of(root_ops.value().begin(), root_ops.value().end(),
+                     [&called_ops](const String& op_name) { return called_ops.count(op_name); })) {
+      VLOG(1) << "Skipping pattern " << pattern_names[i] << " whose root operators are not called";
+      continue;
+    }
     Map<String, ObjectRef> attrs;
     attrs.Set("Composite", pattern_names[i]);
-    merged_func = Downcast<Function>(PartitionPattern(patterns[i], merged_func, attrs, checks[i]));
-    merged_func = InferType(merged_func, m);
+    Function partitioned_func =
+        Downcast<Function>(PartitionPattern(patterns[i], merged_func, attrs, checks[i]));
+    // Later checks may look at types, but only a merge changes them.
+    if (!typed || !partitioned_func.same_as(merged_func)) {
+      merged_func = InferType(partitioned_func, m);
+      typed = true;
+    }
   }
   return std::move(merged_func);
 }
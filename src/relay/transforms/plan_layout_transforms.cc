@@ -0,0 +1,402 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/transforms/plan_layout_transforms.cc
+ * \brief Choose the layouts of the layout agnostic regions of a graph to minimize the cost of the
+ * layout_transform ops around them.
+ *
+ * AlterOpLayout and ConvertLayout decide the layout of each op locally, which leaves regions of
+ * element-wise ops between layout_transforms going back and forth, e.g.
+ *
+ *   conv2d(NCHW16c) -> layout_transform(NCHW16c, NCHW) -> relu -> add
+ *                   -> layout_transform(NCHW, NCHW16c) -> conv2d(NCHW16c)
+ *
+ * The ops of such a region compute the same thing in any layout, so this pass picks, for each
+ * region, the layout among the ones of its surrounding layout_transforms that moves the fewest
+ * bytes through layout_transforms, and moves the transforms to the boundary of the region
+ * accordingly. Transforms of constants are counted as free, since FoldConstant folds them.
+ * Consecutive layout_transforms are then merged, and removed when they cancel out.
+ */
+#include <tvm/relay/attrs/transform.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/op_attr_types.h>
+#include <tvm/relay/transform.h>
+#include <tvm/tir/data_layout.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../ir/indexed_graph.h"
+#include "../op/make_op.h"
+
+namespace tvm {
+namespace relay {
+namespace transform {
+
+namespace {
+
+/*! \brief Return the attributes of a call to layout_transform, or nullptr for other exprs. */
+const LayoutTransformAttrs* AsLayoutTransform(const Expr& expr) {
+  static const Op& layout_transform_op = Op::Get("layout_transform");
+  const auto* call = expr.as<CallNode>();
+  if (call == nullptr || !call->op.same_as(layout_transform_op)) {
+    return nullptr;
+  }
+  return call->attrs.as<LayoutTransformAttrs>();
+}
+
+/*! \brief Return the canonical name of a layout, so that equal layouts compare equal. */
+std::string CanonicalLayout(const std::string& layout) { return tir::Layout(layout).name(); }
+
+/*! \brief Return the number of bytes of a tensor of static shape, or -1. */
+int64_t TensorBytes(const Type& type) {
+  const auto* tensor_type = type.as<TensorTypeNode>();
+  if (tensor_type == nullptr) {
+    return -1;
+  }
+  int64_t bytes = (tensor_type->dtype.bits() * tensor_type->dtype.lanes() + 7) / 8;
+  for (const PrimExpr& dim : tensor_type->shape) {
+    const auto* extent = dim.as<IntImmNode>();
+    if (extent == nullptr) {
+      return -1;
+    }
+    bytes *= extent->value;
+  }
+  return bytes;
+}
+
+/*! \brief Whether an expression is a rank-0 tensor, which broadcasts the same in any layout. */
+bool IsScalar(const Expr& expr) {
+  const auto* tensor_type = expr->checked_type().as<TensorTypeNode>();
+  return tensor_type != nullptr && tensor_type->shape.empty();
+}
+
+/*!
+ * \brief Whether a call computes each element of its output from the same element of its inputs,
+ * so that it can run in any layout.
+ */
+bool IsLayoutAgnostic(const CallNode* call) {
+  static const auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
+  const auto* op = call->op.as<OpNode>();
+  if (op == nullptr || AsLayoutTransform(GetRef<Call>(call)) != nullptr ||
+      fpattern.get(GetRef<Op>(op), kOpaque) > kBroadcast) {
+    return false;
+  }
+  const auto* out_type = call->checked_type().as<TensorTypeNode>();
+  if (out_type == nullptr || out_type->shape.empty() || TensorBytes(call->checked_type()) < 0) {
+    return false;
+  }
+  bool has_tensor_arg = false;
+  for (const Expr& arg : call->args) {
+    if (IsScalar(arg)) {
+      continue;
+    }
+    const auto* arg_type = arg->checked_type().as<TensorTypeNode>();
+    if (arg_type == nullptr || !StructuralEqual()(arg_type->shape, out_type->shape)) {
+      return false;
+    }
+    has_tensor_arg = true;
+  }
+  return has_tensor_arg;
+}
+
+/*! \brief A connected set of layout agnostic calls, which all have the same shape. */
+struct Region {
+  /*! \brief The calls of the region. */
+  std::vector<const CallNode*> members;
+  /*! \brief The layout the region currently computes in, deduced from its layout_transforms. */
+  std::string layout;
+  /*! \brief Whether the layout_transforms around the region agree on its layout. */
+  bool consistent = true;
+  /*! \brief The layouts the region may compute in, with the bytes they move through transforms. */
+  std::vector<std::pair<std::string, int64_t>> candidates;
+};
+
+/*! \brief Find the regions of a function worth computing in another layout. */
+class RegionPlanner {
+ public:
+  explicit RegionPlanner(const Expr& expr) : graph_(CreateIndexedGraph(expr)) {}
+
+  /*!
+   * \brief Plan the layout of every region.
+   * \return The map from the calls of the regions to change to their current and new layouts.
+   */
+  std::unordered_map<const Object*, std::pair<std::string, std::string>> Plan() {
+    std::vector<Region> regions = FindRegions();
+    std::unordered_map<const Object*, std::pair<std::string, std::string>> plan;
+    for (Region& region : regions) {
+      MakeCandidates(&region);
+      if (!region.consistent || region.layout.empty()) {
+        continue;
+      }
+      int64_t current_cost = std::numeric_limits<int64_t>::max();
+      for (const auto& candidate : region.candidates) {
+        if (candidate.first == region.layout) {
+          current_cost = candidate.second;
+        }
+      }
+      const std::pair<std::string, int64_t>* best = nullptr;
+      for (const auto& candidate : region.candidates) {
+        if (candidate.second < (best == nullptr ? current_cost : best->second)) {
+          best = &candidate;
+        }
+      }
+      if (best == nullptr) {
+        continue;
+      }
+      VLOG(1) << "computing region of " << region.members.size() << " calls in " << best->first
+              << " instead of " << region.layout << ", moving " << best->second
+              << " bytes through layout_transform instead of " << current_cost;
+      for (const CallNode* member : region.members) {
+        plan[member] = {region.layout, best->first};
+      }
+    }
+    return plan;
+  }
+
+ private:
+  using Node = IndexedGraph<Expr>::Node;
+
+  int64_t Find(int64_t index) {
+    while (parent_[index] != index) {
+      parent_[index] = parent_[parent_[index]];
+      index = parent_[index];
+    }
+    return index;
+  }
+
+  std::vector<Region> FindRegions() {
+    size_t size = graph_->size();
+    parent_.resize(size);
+    agnostic_.assign(size, false);
+    for (size_t i = 0; i < size; ++i) {
+      parent_[i] = i;
+      if (const auto* call = graph_->index_to_node(i)->ref().as<CallNode>()) {
+        agnostic_[i] = IsLayoutAgnostic(call);
+      }
+    }
+    for (size_t i = 0; i < size; ++i) {
+      if (!agnostic_[i]) {
+        continue;
+      }
+      for (const Node* input : graph_->index_to_node(i)->inputs_) {
+        if (agnostic_[input->index_]) {
+          parent_[Find(input->index_)] = Find(i);
+        }
+      }
+    }
+    std::unordered_map<int64_t, size_t> region_index;
+    std::vector<Region> regions;
+    for (size_t i = 0; i < size; ++i) {
+      if (!agnostic_[i]) {
+        continue;
+      }
+      auto it = region_index.emplace(Find(i), regions.size()).first;
+      if (it->second == regions.size()) {
+        regions.emplace_back();
+      }
+      regions[it->second].members.push_back(graph_->index_to_node(i)->ref().as<CallNode>());
+    }
+    return regions;
+  }
+
+  // Record that the region computes in `layout`, as seen from one of its layout_transforms.
+  void SetLayout(Region* region, const std::string& layout) {
+    std::string canonical = CanonicalLayout(layout);
+    if (region->layout.empty()) {
+      region->layout = canonical;
+    } else if (region->layout != canonical) {
+      region->consistent = false;
+    }
+  }
+
+  void MakeCandidates(Region* region) {
+    // The layout_transforms at the boundary of the region, as the layout on their other side and
+    // the bytes they move, and the bytes of the other tensors crossing the boundary.
+    std::vector<std::pair<std::string, int64_t>> boundaries;
+    std::vector<int64_t> other_bytes;
+    std::unordered_set<const Object*> seen;
+    int64_t root = Find(graph_->item_to_node(GetRef<Expr>(region->members[0]))->index_);
+    auto in_region = [&](const Node* node) {
+      return agnostic_[node->index_] && Find(node->index_) == root;
+    };
+    for (const CallNode* member : region->members) {
+      const Node* node = graph_->item_to_node(GetRef<Expr>(member));
+      for (const Expr& arg : member->args) {
+        const Node* input = graph_->item_to_node(arg);
+        if (in_region(input) || IsScalar(arg) || !seen.insert(arg.get()).second) {
+          continue;
+        }
+        if (const auto* attrs = AsLayoutTransform(arg)) {
+          SetLayout(region, attrs->dst_layout);
+          boundaries.emplace_back(CanonicalLayout(attrs->src_layout),
+                                  TensorBytes(arg->checked_type()));
+        } else if (!arg.as<ConstantNode>()) {
+          other_bytes.push_back(TensorBytes(arg->checked_type()));
+        }
+      }
+      bool transformed_back = false;
+      for (const Node* output : node->outputs_) {
+        if (in_region(output)) {
+          continue;
+        }
+        if (const auto* attrs = AsLayoutTransform(output->ref())) {
+          SetLayout(region, attrs->src_layout);
+          boundaries.emplace_back(CanonicalLayout(attrs->dst_layout),
+                                  TensorBytes(output->ref()->checked_type()));
+        } else if (!transformed_back) {
+          // One transform back to the current layout serves all the other consumers.
+          other_bytes.push_back(TensorBytes(member->checked_type()));
+          transformed_back = true;
+        }
+      }
+    }
+    auto unknown_size = [](const std::pair<std::string, int64_t>& boundary) {
+      return boundary.second < 0;
+    };
+    if (std::any_of(boundaries.begin(), boundaries.end(), unknown_size) ||
+        std::any_of(other_bytes.begin(), other_bytes.end(), [](int64_t b) { return b < 0; })) {
+      region->consistent = false;
+    }
+    if (!region->consistent || region->layout.empty()) {
+      return;
+    }
+    size_t ndim = region->members[0]->checked_type().as<TensorTypeNode>()->shape.size();
+    if (tir::Layout(region->layout).ndim() != ndim) {
+      region->consistent = false;
+      return;
+    }
+    // Every boundary moves its tensor once, unless it is already in the layout of the region.
+    std::vector<std::string> layouts = {region->layout};
+    for (const auto& boundary : boundaries) {
+      layouts.push_back(boundary.first);
+    }
+    for (const std::string& layout : layouts) {
+      bool duplicate = false;
+      for (const auto& candidate : region->candidates) {
+        duplicate = duplicate || candidate.first == layout;
+      }
+      if (duplicate) {
+        continue;
+      }
+      int64_t cost = 0;
+      for (const auto& boundary : boundaries) {
+        cost += boundary.first == layout ? 0 : boundary.second;
+      }
+      if (layout != region->layout) {
+        for (int64_t bytes : other_bytes) {
+          cost += bytes;
+        }
+      }
+      region->candidates.emplace_back(layout, cost);
+    }
+  }
+
+  std::unique_ptr<IndexedGraph<Expr>> graph_;
+  std::vector<int64_t> parent_;
+  std::vector<bool> agnostic_;
+};
+
+/*! \brief Move the layout_transforms to the boundaries of the regions as planned. */
+class LayoutTransformPlanner : public MixedModeMutator {
+ public:
+  explicit LayoutTransformPlanner(
+      std::unordered_map<const Object*, std::pair<std::string, std::string>> plan)
+      : plan_(std::move(plan)) {}
+
+  using MixedModeMutator::Rewrite_;
+
+  Expr Rewrite_(const CallNode* pre, const Expr& post) final {
+    auto it = plan_.find(pre);
+    if (it != plan_.end()) {
+      const std::string& layout = it->second.first;
+      const std::string& new_layout = it->second.second;
+      const auto* post_call = post.as<CallNode>();
+      Array<Expr> args;
+      for (size_t i = 0; i < pre->args.size(); ++i) {
+        auto member = in_new_layout_.find(pre->args[i].get());
+        if (member != in_new_layout_.end()) {
+          args.push_back(member->second);
+        } else if (IsScalar(pre->args[i])) {
+          args.push_back(post_call->args[i]);
+        } else {
+          args.push_back(Transform(post_call->args[i], layout, new_layout));
+        }
+      }
+      Call call(pre->op, args, pre->attrs, {}, pre->span);
+      in_new_layout_[pre] = call;
+      // The consumers outside of the region merge this transform with theirs, if any.
+      return Transform(call, new_layout, layout);
+    }
+    if (const auto* attrs = AsLayoutTransform(post)) {
+      const Expr& data = post.as<CallNode>()->args[0];
+      const auto* producer = AsLayoutTransform(data);
+      if (producer != nullptr &&
+          CanonicalLayout(producer->dst_layout) == CanonicalLayout(attrs->src_layout)) {
+        return Transform(data, attrs->src_layout, attrs->dst_layout);
+      }
+    }
+    return post;
+  }
+
+ private:
+  // Transform `data` from `src` to `dst`, merging with the layout_transform producing it, if any.
+  Expr Transform(const Expr& data, const std::string& src, const std::string& dst) {
+    Expr input = data;
+    std::string input_layout = CanonicalLayout(src);
+    if (const auto* attrs = AsLayoutTransform(data)) {
+      if (CanonicalLayout(attrs->dst_layout) == input_layout) {
+        input = data.as<CallNode>()->args[0];
+        input_layout = CanonicalLayout(attrs->src_layout);
+      }
+    }
+    std::string output_layout = CanonicalLayout(dst);
+    if (input_layout == output_layout) {
+      return input;
+    }
+    return MakeLayoutTransform(input, input_layout, output_layout);
+  }
+
+  std::unordered_map<const Object*, std::pair<std::string, std::string>> plan_;
+  std::unordered_map<const Object*, Expr> in_new_layout_;
+};
+
+}  // namespace
+
+Pass PlanLayoutTransforms() {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        auto plan = RegionPlanner(f).Plan();
+        return Downcast<Function>(LayoutTransformPlanner(std::move(plan)).Mutate(f));
+      };
+  return CreateFunctionPass(pass_func, 4, "PlanLayoutTransforms", {"InferType"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.PlanLayoutTransforms").set_body_typed(PlanLayoutTransforms);
+
+}  // namespace transform
+}  // namespace relay
+}  // namespace tvm
@@ -0,0 +1,305 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/transforms/rematerialize.cc
+ * \brief Recompute cheap tensors next to their late consumers instead of keeping them alive.
+ *
+ * A tensor consumed early and again much later, e.g. a forward activation read by the backward
+ * pass of a gradient, occupies its storage all along. When it is computed by an injective op
+ * from tensors which are alive at its late consumers anyway, computing it a second time there
+ * frees its storage in between. The pass estimates the live bytes at each point of the post-dfs
+ * order of the graph, which is the order the executors run it in, and rematerializes the
+ * largest tensors live across the peak, until the peak fits in the memory budget or no tensor
+ * can be rematerialized. The recomputed ops are injective, so that they fuse into the consumers.
+ */
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/op_attr_types.h>
+#include <tvm/relay/transform.h>
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../ir/indexed_graph.h"
+
+namespace tvm {
+namespace relay {
+namespace transform {
+
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.Rematerialize.memory_budget", Integer);
+
+namespace {
+
+/*! \brief Return the number of bytes of a tensor, or a tuple of tensors, of static shape, or -1. */
+int64_t StaticBytes(const Type& type) {
+  if (const auto* tuple_type = type.as<TupleTypeNode>()) {
+    int64_t bytes = 0;
+    for (const Type& field : tuple_type->fields) {
+      int64_t field_bytes = StaticBytes(field);
+      if (field_bytes < 0) return -1;
+      bytes += field_bytes;
+    }
+    return bytes;
+  }
+  const auto* tensor_type = type.as<TensorTypeNode>();
+  if (tensor_type == nullptr) return -1;
+  int64_t bytes = (tensor_type->dtype.bits() * tensor_type->dtype.lanes() + 7) / 8;
+  for (const PrimExpr& dim : tensor_type->shape) {
+    const auto* imm = dim.as<IntImmNode>();
+    if (imm == nullptr) return -1;
+    bytes *= imm->value;
+  }
+  return bytes;
+}
+
+/*! \brief A tensor to recompute, and the consumers reading the recomputed copy. */
+struct Candidate {
+  /*! \brief The index of the call computing the tensor. */
+  PostDfsIndex index;
+  /*! \brief The bytes of the tensor. */
+  int64_t bytes;
+  /*! \brief The last consumer of the original tensor, which is freed after it. */
+  PostDfsIndex last_early_use;
+  /*! \brief The first consumer of the recomputed tensor, which is computed before it. */
+  PostDfsIndex first_late_use;
+};
+
+/*! \brief Choose the tensors to rematerialize under a memory budget. */
+class RematerializationPlanner {
+ public:
+  explicit RematerializationPlanner(const Expr& expr) : graph_(CreateIndexedGraph(expr)) {}
+
+  /*!
+   * \brief Plan the rematerializations.
+   * \param memory_budget The bytes the live tensors should fit in.
+   * \return The map from the calls to recompute to the index of their first late consumer.
+   */
+  std::unordered_map<const CallNode*, PostDfsIndex> Plan(int64_t memory_budget) {
+    Init();
+    std::unordered_map<const CallNode*, PostDfsIndex> plan;
+    std::unordered_set<PostDfsIndex> blocked;
+    while (true) {
+      std::vector<int64_t> live = LiveBytes();
+      auto peak_it = std::max_element(live.begin(), live.end());
+      if (peak_it == live.end() || *peak_it <= memory_budget) break;
+      PostDfsIndex peak = peak_it - live.begin();
+      const Candidate* best = nullptr;
+      for (const Candidate& candidate : MakeCandidates(blocked)) {
+        if (candidate.last_early_use < peak && peak < candidate.first_late_use &&
+            (best == nullptr || candidate.bytes > best->bytes)) {
+          best = &candidate;
+        }
+      }
+      if (best == nullptr) break;
+      const Node* node = graph_->index_to_node(best->index);
+      VLOG(1) << "rematerializing " << best->bytes << " bytes at " << best->first_late_use
+              << " instead of keeping them alive from " << best->last_early_use
+              << ", the peak at " << peak << " is " << *peak_it << " bytes";
+      plan[node->ref().as<CallNode>()] = best->first_late_use;
+      // The original is freed after its early consumers, and the copy lives until the last one.
+      intervals_.emplace_back(best->first_late_use, last_use_[best->index], best->bytes);
+      last_use_[best->index] = best->last_early_use;
+      // The inputs and consumers of a rematerialized tensor keep their lifetimes.
+      blocked.insert(best->index);
+      for (const Node* input : node->inputs_) blocked.insert(input->index_);
+      for (const Node* output : node->outputs_) blocked.insert(output->index_);
+      candidates_valid_ = false;
+    }
+    return plan;
+  }
+
+ private:
+  using Node = IndexedGraph<Expr>::Node;
+
+  /*! \brief Compute the bytes and the last use of every node. */
+  void Init() {
+    PostDfsIndex size = graph_->size();
+    bytes_.assign(size, 0);
+    last_use_.assign(size, 0);
+    for (PostDfsIndex i = size; i > 0; --i) {
+      const Node* node = graph_->index_to_node(i - 1);
+      last_use_[i - 1] = i - 1;
+      for (const Node* output : node->outputs_) {
+        // The fields of a tuple are alive as long as the tuple is.
+        PostDfsIndex use = output->ref()->IsInstance<TupleNode>() ? last_use_[output->index_]
+                                                                  : output->index_;
+        last_use_[i - 1] = std::max(last_use_[i - 1], use);
+      }
+      if (node->outputs_.empty()) {
+        last_use_[i - 1] = size - 1;
+      }
+      const auto* call = node->ref().as<CallNode>();
+      if (call != nullptr && call->checked_type_.defined()) {
+        bytes_[i - 1] = std::max<int64_t>(StaticBytes(call->checked_type()), 0);
+      }
+    }
+  }
+
+  /*! \brief Return the bytes of the tensors alive at every node. */
+  std::vector<int64_t> LiveBytes() const {
+    std::vector<int64_t> delta(bytes_.size() + 1, 0);
+    for (size_t i = 0; i < bytes_.size(); ++i) {
+      delta[i] += bytes_[i];
+      delta[last_use_[i] + 1] -= bytes_[i];
+    }
+    for (const auto& interval : intervals_) {
+      delta[std::get<0>(interval)] += std::get<2>(interval);
+      delta[std::get<1>(interval) + 1] -= std::get<2>(interval);
+    }
+    std::vector<int64_t> live(bytes_.size(), 0);
+    int64_t current = 0;
+    for (size_t i = 0; i < bytes_.size(); ++i) {
+      current += delta[i];
+      live[i] = current;
+    }
+    return live;
+  }
+
+  /*! \brief Whether a call is cheap to compute a second time. */
+  static bool IsRecomputable(const CallNode* call) {
+    static const auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
+    const auto* op = call->op.as<OpNode>();
+    return op != nullptr && call->checked_type_.defined() &&
+           call->checked_type()->IsInstance<TensorTypeNode>() &&
+           fpattern.get(GetRef<Op>(op), kOpaque) <= kInjective;
+  }
+
+  /*! \brief Find the tensors which can be rematerialized, split at their largest gap of uses. */
+  const std::vector<Candidate>& MakeCandidates(const std::unordered_set<PostDfsIndex>& blocked) {
+    if (candidates_valid_) return candidates_;
+    candidates_.clear();
+    candidates_valid_ = true;
+    for (PostDfsIndex i = 0; i < graph_->size(); ++i) {
+      const Node* node = graph_->index_to_node(i);
+      const auto* call = node->ref().as<CallNode>();
+      if (call == nullptr || blocked.count(i) || bytes_[i] <= 0 || !IsRecomputable(call)) {
+        continue;
+      }
+      std::vector<PostDfsIndex> uses;
+      bool rewritable = true;
+      for (const Node* output : node->outputs_) {
+        // The pass rewrites the calls and tuples reading the tensor directly.
+        rewritable &= output->ref()->IsInstance<CallNode>() ||
+                      output->ref()->IsInstance<TupleNode>();
+        uses.push_back(output->index_);
+      }
+      if (!rewritable || uses.size() < 2) continue;
+      std::sort(uses.begin(), uses.end());
+      size_t split = 0;
+      for (size_t k = 1; k + 1 < uses.size(); ++k) {
+        if (uses[k + 1] - uses[k] > uses[split + 1] - uses[split]) split = k;
+      }
+      Candidate candidate{i, bytes_[i], uses[split], uses[split + 1]};
+      // Recomputing must not extend the lifetime of the inputs, except the always alive ones.
+      for (const Node* input : node->inputs_) {
+        const Expr& ref = input->ref();
+        if (!ref->IsInstance<VarNode>() && !ref->IsInstance<ConstantNode>() &&
+            !ref->IsInstance<OpNode>() && last_use_[input->index_] < candidate.first_late_use) {
+          rewritable = false;
+        }
+      }
+      if (rewritable) candidates_.push_back(candidate);
+    }
+    return candidates_;
+  }
+
+  std::unique_ptr<IndexedGraph<Expr>> graph_;
+  /*! \brief The bytes computed by each node. */
+  std::vector<int64_t> bytes_;
+  /*! \brief The index of the last consumer of each node. */
+  std::vector<PostDfsIndex> last_use_;
+  /*! \brief The lifetimes of the recomputed tensors: first index, last index and bytes. */
+  std::vector<std::tuple<PostDfsIndex, PostDfsIndex, int64_t>> intervals_;
+  /*! \brief The candidates, valid until a plan changes the lifetimes. */
+  std::vector<Candidate> candidates_;
+  bool candidates_valid_ = false;
+};
+
+/*! \brief Replace the tensors read by the late consumers by recomputed copies. */
+class Rematerializer : public MixedModeMutator {
+ public:
+  Rematerializer(const Expr& expr, std::unordered_map<const CallNode*, PostDfsIndex> plan)
+      : graph_(CreateIndexedGraph(expr)), plan_(std::move(plan)) {}
+
+  using MixedModeMutator::VisitExpr_;
+
+  Expr Rewrite_(const CallNode* pre, const Expr& post) final {
+    const auto* post_call = post.as<CallNode>();
+    Array<Expr> args = RewriteFields(pre, pre->args, post_call->args);
+    if (args.same_as(post_call->args)) return post;
+    return WithFields(GetRef<Call>(post_call), post_call->op, args);
+  }
+
+  Expr Rewrite_(const TupleNode* pre, const Expr& post) final {
+    const auto* post_tuple = post.as<TupleNode>();
+    Array<Expr> fields = RewriteFields(pre, pre->fields, post_tuple->fields);
+    if (fields.same_as(post_tuple->fields)) return post;
+    return WithFields(GetRef<Tuple>(post_tuple), fields);
+  }
+
+ private:
+  Array<Expr> RewriteFields(const ExprNode* pre, const Array<Expr>& pre_fields,
+                            const Array<Expr>& post_fields) {
+    PostDfsIndex index = graph_->item_to_node(pre)->index_;
+    Array<Expr> fields = post_fields;
+    for (size_t i = 0; i < pre_fields.size(); ++i) {
+      const auto* call = pre_fields[i].as<CallNode>();
+      auto it = call == nullptr ? plan_.end() : plan_.find(call);
+      if (it == plan_.end() || index < it->second) continue;
+      auto copy_it = copies_.find(call);
+      if (copy_it == copies_.end()) {
+        const auto* post_call = post_fields[i].as<CallNode>();
+        ICHECK(post_call != nullptr);
+        Call copy(post_call->op, post_call->args, post_call->attrs, post_call->type_args,
+                  post_call->span);
+        copy_it = copies_.emplace(call, copy).first;
+      }
+      fields.Set(i, copy_it->second);
+    }
+    return fields;
+  }
+
+  std::unique_ptr<IndexedGraph<Expr>> graph_;
+  std::unordered_map<const CallNode*, PostDfsIndex> plan_;
+  /*! \brief The recomputed copy of each planned call, shared by its late consumers. */
+  std::unordered_map<const CallNode*, Call> copies_;
+};
+
+}  // namespace
+
+Pass Rematerialize(Integer memory_budget) {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        auto plan = RematerializationPlanner(f).Plan(memory_budget->value);
+        if (plan.empty()) return f;
+        return Downcast<Function>(Rematerializer(f, std::move(plan)).Mutate(f));
+      };
+  return CreateFunctionPass(pass_func, 0, "Rematerialize", {"InferType"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.Rematerialize").set_body_typed(Rematerialize);
+
+}  // namespace transform
+}  // namespace relay
+}  // namespace tvm
@@ -0,0 +1,148 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/transforms/shard_dense.cc
+ * \brief Shard the constant weights of nn.dense across the devices of a mesh.
+ *
+ * A dense layer with a [units, depth] weight becomes one dense per device, on a slice of the
+ * weight, so that every device holds only its slice:
+ *  - By column, the weight is split along units. Every device computes its slice of the output
+ *    columns, which are gathered by a concatenate along the last axis.
+ *  - By row, the weight and the data are split along depth. Every device computes a partial sum
+ *    of the whole output, which are reduced by adds.
+ * The shards are put on their devices by on_device annotations, and PlanDevices inserts the
+ * device_copy calls moving the data to the shards and their results back.
+ */
+#include <tvm/relay/attrs/nn.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/transform.h>
+
+#include <cstring>
+#include <vector>
+
+#include "../op/make_op.h"
+#include "../op/memory/on_device.h"
+#include "pattern_utils.h"
+
+namespace tvm {
+namespace relay {
+
+/*!
+ * \brief Copy a slice of a 2-d constant.
+ * \param data The constant, on the host.
+ * \param axis The axis to slice.
+ * \param begin The first index of the slice along the axis.
+ * \param size The size of the slice along the axis.
+ * \return The slice.
+ */
+runtime::NDArray SliceConstant(const runtime::NDArray& data, int axis, int64_t begin,
+                               int64_t size) {
+  ICHECK_EQ(data->device.device_type, kDLCPU);
+  int64_t rows = data->shape[0];
+  int64_t cols = data->shape[1];
+  size_t elem_bytes = (data->dtype.bits * data->dtype.lanes + 7) / 8;
+  std::vector<int64_t> shape = axis == 0 ? std::vector<int64_t>{size, cols}
+                                         : std::vector<int64_t>{rows, size};
+  runtime::NDArray slice = runtime::NDArray::Empty(shape, data->dtype, data->device);
+  const char* src = static_cast<const char*>(data->data);
+  char* dst = static_cast<char*>(slice->data);
+  if (axis == 0) {
+    std::memcpy(dst, src + begin * cols * elem_bytes, size * cols * elem_bytes);
+  } else {
+    for (int64_t r = 0; r < rows; ++r) {
+      std::memcpy(dst + r * size * elem_bytes, src + (r * cols + begin) * elem_bytes,
+                  size * elem_bytes);
+    }
+  }
+  return slice;
+}
+
+class DenseSharder : public MixedModeMutator {
+ public:
+  DenseSharder(Array<VirtualDevice> devices, bool by_column)
+      : devices_(std::move(devices)), by_column_(by_column) {}
+
+ private:
+  using MixedModeMutator::VisitExpr_;
+
+  Expr Rewrite_(const CallNode* pre, const Expr& post) final {
+    static const Op& dense_op = Op::Get("nn.dense");
+    Call call = Downcast<Call>(post);
+    if (call->op != dense_op) {
+      return post;
+    }
+    const auto* weight = call->args[1].as<ConstantNode>();
+    const auto* data_type = pre->args[0]->checked_type().as<TensorTypeNode>();
+    if (weight == nullptr || weight->data->ndim != 2 || data_type == nullptr) {
+      return post;
+    }
+    int num_shards = devices_.size();
+    int axis = by_column_ ? 0 : 1;
+    int64_t extent = weight->data->shape[axis];
+    if (extent % num_shards != 0) {
+      return post;
+    }
+    int64_t size = extent / num_shards;
+    const auto* attrs = call->attrs.as<DenseAttrs>();
+    Array<Expr> shards;
+    for (int i = 0; i < num_shards; ++i) {
+      Expr data = call->args[0];
+      if (!by_column_) {
+        data = MakeStridedSlice(data, {Integer(i * size)}, {Integer((i + 1) * size)}, {1}, "end",
+                                Array<Integer>{Integer(data_type->shape.size() - 1)});
+      }
+      Constant shard_weight(SliceConstant(weight->data, axis, i * size, size));
+      IndexExpr units = by_column_ ? IndexExpr(Integer(size)) : attrs->units;
+      shards.push_back(OnDevice(Dense(data, shard_weight, units, attrs->out_dtype), devices_[i]));
+    }
+    if (by_column_) {
+      return MakeConcatenate(Tuple(shards), -1);
+    }
+    Expr sum = shards[0];
+    for (int i = 1; i < num_shards; ++i) {
+      sum = Add(sum, shards[i]);
+    }
+    return sum;
+  }
+
+  /*! \brief The devices of the mesh, one shard per device. */
+  Array<VirtualDevice> devices_;
+  /*! \brief Whether to split the weights by column, else by row. */
+  bool by_column_;
+};
+
+namespace transform {
+
+Pass ShardDense(Array<VirtualDevice> devices, String mode) {
+  CHECK_GT(devices.size(), 0) << "ValueError: ShardDense expects at least one device";
+  CHECK(mode == "column" || mode == "row")
+      << "ValueError: ShardDense expects mode to be column or row, but gets " << mode;
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        return Downcast<Function>(DenseSharder(devices, mode == "column").Mutate(f));
+      };
+  return CreateFunctionPass(pass_func, 0, "ShardDense", {"InferType"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.ShardDense").set_body_typed(ShardDense);
+
+}  // namespace transform
+}  // namespace relay
+}  // namespace tvm
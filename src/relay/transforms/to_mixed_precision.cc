@@ -28,6 +28,8 @@
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/transform.h>
 #include <tvm/runtime/object.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/data_layout.h>
 
 #include <utility>
 
@@ -37,6 +39,13 @@ namespace tvm {
 namespace relay {
 
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.ToMixedPrecision.keep_orig_output_dtype", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.ToMixedPrecision.cost_aware", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.ToMixedPrecision.flops_per_byte", FloatImm);
+
+/*! \brief The default ratio of the peak flops to the memory bandwidth of the target. */
+constexpr double kDefaultFlopsPerByte = 8.0;
+/*! \brief The default speedup of the compute of an op in the mixed precision type. */
+constexpr double kDefaultMixedPrecisionSpeedup = 2.0;
 // A callable which hashes std::pair
 struct pair_hash {
   template <class T1, class T2>
@@ -93,6 +102,13 @@ using FTVMMixedPrecisionConversionType = runtime::TypedPackedFunc<Array<ObjectRe
  *         describe whether a larger dtype is used to accumulate the results
  *         of the operation. The output_dtype meanwhile describes the dtype
  *         most Ops should use from this accumulator.
+ *      4) In cost aware mode, an ALWAYS convolution or matmul is done in FP32
+ *         instead when the compute time it saves is estimated to be less than
+ *         the time of casting its arguments which are not yet in the target
+ *         dtype. The compute time is estimated from the flops of the op, and
+ *         its speedup in the target dtype, which "relay.ToMixedPrecision.op_speedup"
+ *         provides when registered. Since the arguments produced in the target
+ *         dtype are free, ops are kept in chains that need few casts.
  */
 class MixedPrecisionPass : public MixedModeMutator {
  private:
@@ -109,6 +125,138 @@ class MixedPrecisionPass : public MixedModeMutator {
   const RelayExprNode* root_;
   std::vector<DataType> original_dtype_;
   bool keep_orig_output_dtype_;
+  /*! \brief Whether ALWAYS ops are only converted when estimated to be faster. */
+  bool cost_aware_;
+  /*! \brief The ratio of the peak flops to the memory bandwidth of the target. */
+  double flops_per_byte_;
+  /*! \brief The measured speedup of ops in the mixed precision type, if registered. */
+  const runtime::PackedFunc* op_speedup_;
+
+  /*! \brief Return the number of output channels of a convolution, or 0 if unknown. */
+  template <typename T>
+  static int64_t OutputChannels(const T* attrs, const TensorTypeNode* out_type) {
+    tir::Layout layout(attrs->out_layout.empty() ? attrs->data_layout : attrs->out_layout);
+    if (!layout.defined() || layout.ndim() != out_type->shape.size()) {
+      return 0;
+    }
+    int64_t channels = 1;
+    for (size_t i = 0; i < layout.ndim(); ++i) {
+      if (tir::LayoutAxis::Get(layout->axes[i]).ToPrimal().name() == "C") {
+        const auto* extent = out_type->shape[i].as<IntImmNode>();
+        if (extent == nullptr) {
+          return 0;
+        }
+        channels *= extent->value;
+      }
+    }
+    return channels;
+  }
+
+  /*! \brief Estimate the flops of a convolution or matmul, or return 0 for other ops. */
+  static double EstimateFlops(const CallNode* call) {
+    const auto* out_type = call->checked_type().as<TensorTypeNode>();
+    if (out_type == nullptr) {
+      return 0;
+    }
+    double out_elems = 1;
+    for (const PrimExpr& dim : out_type->shape) {
+      const auto* extent = dim.as<IntImmNode>();
+      if (extent == nullptr) {
+        return 0;
+      }
+      out_elems *= extent->value;
+    }
+    auto static_dim = [](const Expr& arg, int index) -> double {
+      const auto* type = arg->checked_type().as<TensorTypeNode>();
+      if (type == nullptr || type->shape.empty()) {
+        return 0;
+      }
+      int rank = type->shape.size();
+      const auto* extent = type->shape[(index + rank) % rank].as<IntImmNode>();
+      return extent == nullptr ? 0 : extent->value;
+    };
+    auto static_size = [](const Expr& arg) -> double {
+      const auto* type = arg->checked_type().as<TensorTypeNode>();
+      if (type == nullptr) {
+        return 0;
+      }
+      double size = 1;
+      for (const PrimExpr& dim : type->shape) {
+        const auto* extent = dim.as<IntImmNode>();
+        if (extent == nullptr) {
+          return 0;
+        }
+        size *= extent->value;
+      }
+      return size;
+    };
+    // The number of multiply-adds for each output element.
+    double reduction = 0;
+    int64_t channels = 0;
+    if (call->attrs.as<DenseAttrs>()) {
+      reduction = static_dim(call->args[0], -1);
+    } else if (const auto* attrs = call->attrs.as<BatchMatmulAttrs>()) {
+      reduction = static_dim(call->args[0], attrs->transpose_a ? -2 : -1);
+    } else if (const auto* attrs = call->attrs.as<MatmulAttrs>()) {
+      reduction = static_dim(call->args[0], attrs->transpose_a ? -2 : -1);
+    } else if (const auto* attrs = call->attrs.as<Conv1DAttrs>()) {
+      channels = OutputChannels(attrs, out_type);
+    } else if (const auto* attrs = call->attrs.as<Conv2DAttrs>()) {
+      channels = OutputChannels(attrs, out_type);
+    } else if (const auto* attrs = call->attrs.as<Conv3DAttrs>()) {
+      channels = OutputChannels(attrs, out_type);
+    } else if (const auto* attrs = call->attrs.as<Conv1DTransposeAttrs>()) {
+      channels = OutputChannels(attrs, out_type);
+    } else if (const auto* attrs = call->attrs.as<Conv2DTransposeAttrs>()) {
+      channels = OutputChannels(attrs, out_type);
+    } else if (const auto* attrs = call->attrs.as<Conv3DTransposeAttrs>()) {
+      channels = OutputChannels(attrs, out_type);
+    }
+    if (channels > 0 && call->args.size() >= 2) {
+      // Each output channel reduces over its slice of the weight.
+      reduction = static_size(call->args[1]) / channels;
+    }
+    return 2 * out_elems * reduction;
+  }
+
+  /*!
+   * \brief Whether a call is estimated to be faster in the mixed precision type, once the casts
+   * of its arguments are counted.
+   */
+  bool IsProfitable(const CallNode* pre_call_node, const Array<Expr>& args,
+                    const Array<Type>& arg_types) const {
+    double flops = EstimateFlops(pre_call_node);
+    if (flops <= 0) {
+      return true;
+    }
+    double cast_bytes = 0;
+    for (size_t i = 0; i < args.size(); ++i) {
+      const auto* tensor_type = arg_types[i].as<TensorTypeNode>();
+      // Constants are cast at compile time by FoldConstant.
+      if (tensor_type == nullptr || args[i]->IsInstance<ConstantNode>() ||
+          !(tensor_type->dtype.is_float() || tensor_type->dtype.is_bfloat16()) ||
+          tensor_type->dtype == mixed_precision_type_) {
+        continue;
+      }
+      double elems = 1;
+      for (const PrimExpr& dim : tensor_type->shape) {
+        const auto* extent = dim.as<IntImmNode>();
+        elems *= extent == nullptr ? 1 : extent->value;
+      }
+      cast_bytes += elems * (tensor_type->dtype.bytes() + mixed_precision_type_.bytes());
+    }
+    double speedup = kDefaultMixedPrecisionSpeedup;
+    if (op_speedup_ != nullptr) {
+      speedup = (*op_speedup_)(GetRef<Call>(pre_call_node),
+                               DLDataType2String(mixed_precision_type_));
+    }
+    // Compare the compute time saved with the time of the casts, both in units of a byte moved.
+    bool profitable = flops * (1 - 1 / speedup) > flops_per_byte_ * cast_bytes;
+    VLOG(1) << AsText(pre_call_node->op, false) << " with " << flops << " flops and "
+            << cast_bytes << " bytes of casts is " << (profitable ? "" : "not ")
+            << "converted, with speedup " << speedup;
+    return profitable;
+  }
 
   Attrs GetNewAttrs(const CallNode* call, const DataType& accumulation_dtype) const {
     /* If the accumulation dtype is in the attributes make a copy and mutate the field. */
@@ -286,11 +434,16 @@ class MixedPrecisionPass : public MixedModeMutator {
   using MixedModeMutator::VisitExpr_;
 
   explicit MixedPrecisionPass(Expr base, bool keep_orig_output_dtype,
-                              DataType mixed_precision_type = DataType::Float(16))
+                              DataType mixed_precision_type = DataType::Float(16),
+                              bool cost_aware = false,
+                              double flops_per_byte = kDefaultFlopsPerByte)
       : MixedModeMutator(),
         mixed_precision_type_(mixed_precision_type),
         root_(Downcast<Function>(base)->body.get()),
-        keep_orig_output_dtype_(keep_orig_output_dtype) {
+        keep_orig_output_dtype_(keep_orig_output_dtype),
+        cost_aware_(cost_aware),
+        flops_per_byte_(flops_per_byte),
+        op_speedup_(runtime::Registry::Get("relay.ToMixedPrecision.op_speedup")) {
     if (keep_orig_output_dtype_) {
       if (root_->IsInstance<tvm::relay::TupleNode>()) {
         const TupleTypeNode* tuple_type = (root_->checked_type_).as<TupleTypeNode>();
@@ -375,6 +528,11 @@ class MixedPrecisionPass : public MixedModeMutator {
       }
     }
 
+    if (initial_category == MIXED_PRECISION_ALWAYS && cost_aware_ &&
+        !IsProfitable(pre_call_node, post_call_node->args, cur_arg_types)) {
+      initial_category = MIXED_PRECISION_NEVER;
+    }
+
     // Determine the final category we want for conversion
     MixedTypeConversionCategory final_category = initial_category;
     if (initial_category == MIXED_PRECISION_FOLLOW) {
@@ -464,11 +622,13 @@ class MixedPrecisionPass : public MixedModeMutator {
 
   // To access map of ops not registered for error reporting
   friend Expr ToMixedPrecision(const Expr& expr, bool keep_orig_output_dtype,
-                               const DataType& mixed_precision_type, int missing_op_mode);
+                               const DataType& mixed_precision_type, int missing_op_mode,
+                               bool cost_aware, double flops_per_byte);
 };
 
 Expr ToMixedPrecision(const Expr& expr, bool keep_orig_output_dtype,
-                      const DataType& mixed_precision_type, int missing_op_mode) {
+                      const DataType& mixed_precision_type, int missing_op_mode,
+                      bool cost_aware, double flops_per_byte) {
   /*
   missing_op_mode:
 
@@ -479,8 +639,12 @@ Expr ToMixedPrecision(const Expr& expr, bool keep_orig_output_dtype,
   ICHECK(missing_op_mode >= 0 && missing_op_mode <= 2)
       << " missing_op_mode must be either 0, 1, or 2 got " << missing_op_mode;
 
-  MixedPrecisionPass converter =
-      MixedPrecisionPass(expr, keep_orig_output_dtype, mixed_precision_type);
+  CHECK_GT(flops_per_byte, 0)
+      << "ValueError: relay.ToMixedPrecision.flops_per_byte must be positive, but got "
+      << flops_per_byte;
+
+  MixedPrecisionPass converter = MixedPrecisionPass(
+      expr, keep_orig_output_dtype, mixed_precision_type, cost_aware, flops_per_byte);
   auto result = converter.Mutate(expr);
 
   for (auto it = converter.missing_ops_.begin();
@@ -508,8 +672,14 @@ Pass ToMixedPrecision(DataType mixed_precision_type, int missing_op_mode) {
         keep_orig_output_dtype = pc->GetConfig("relay.ToMixedPrecision.keep_orig_output_dtype",
                                                Bool(keep_orig_output_dtype))
                                      .value();
-        return Downcast<Function>(
-            ToMixedPrecision(f, keep_orig_output_dtype, mixed_precision_type, missing_op_mode));
+        bool cost_aware =
+            pc->GetConfig("relay.ToMixedPrecision.cost_aware", Bool(false)).value();
+        double flops_per_byte = pc->GetConfig("relay.ToMixedPrecision.flops_per_byte",
+                                              FloatImm(DataType::Float(64), kDefaultFlopsPerByte))
+                                    .value()
+                                    ->value;
+        return Downcast<Function>(ToMixedPrecision(f, keep_orig_output_dtype, mixed_precision_type,
+                                                   missing_op_mode, cost_aware, flops_per_byte));
       };
   return CreateFunctionPass(pass_func, 0, "ToMixedPrecision", {});
 }
@@ -46,12 +46,16 @@
 #include <tvm/relay/pattern_functor.h>
 #include <tvm/relay/transform.h>
 
+#include <unordered_set>
+
 #include "../analysis/type_solver.h"
 #include "pass_utils.h"
 
 namespace tvm {
 namespace relay {
 
+using ExprSet = std::unordered_set<Expr, ObjectPtrHash, ObjectPtrEqual>;
+
 // Necessary deferred relation for TupleGetItem
 struct TupleGetItemAttrs : public tvm::AttrsNode<TupleGetItemAttrs> {
   int index;
@@ -108,6 +112,17 @@ class TypeInferencer : private ExprFunctor<Type(const Expr&)>,
   // Infer the types inside of a function.
   Expr Infer(GlobalVar var, Function expr);
 
+  /*!
+   * \brief Reuse the checked types of some expressions instead of inferring them again.
+   * \param reused The expressions, whose sub-expressions are not visited.
+   */
+  void ReuseCheckedTypes(const ExprSet& reused) {
+    reused_ = reused;
+    for (const Expr& expr : reused_) {
+      memo_[expr] = expr->checked_type();
+    }
+  }
+
  private:
   // type resolver that maps back to type
   class Resolver;
@@ -126,6 +141,8 @@ class TypeInferencer : private ExprFunctor<Type(const Expr&)>,
 
   // The solver used by the inferencer.
   TypeSolver solver_;
+  // The expressions whose checked types are reused.
+  ExprSet reused_;
   // relation function
   TypeRelationFn tuple_getitem_rel_;
   TypeRelationFn make_tuple_rel_;
@@ -626,8 +643,12 @@ class TypeInferencer : private ExprFunctor<Type(const Expr&)>,
 class TypeInferencer::Resolver : public MixedModeMutator, PatternMutator {
  public:
   Resolver(const std::unordered_map<Expr, ResolvedTypeInfo, ObjectPtrHash, ObjectPtrEqual>& tmap,
-           TypeSolver* solver)
-      : tmap_(tmap), solver_(solver) {}
+           TypeSolver* solver, const ExprSet& reused)
+      : tmap_(tmap), solver_(solver) {
+    for (const Expr& expr : reused) {
+      memo_[expr] = expr;
+    }
+  }
 
   using MixedModeMutator::VisitExpr_;
 
@@ -787,7 +808,7 @@ Expr TypeInferencer::Infer(GlobalVar var, Function function) {
   Solve();
 
   // Step 3: Attach resolved types to checked_type field.
-  auto resolved_expr = Resolver(type_map_, &solver_).VisitExpr(function);
+  auto resolved_expr = Resolver(type_map_, &solver_, reused_).VisitExpr(function);
 
   if (!WellFormed(resolved_expr, this->diag_ctx)) {
     this->diag_ctx.Emit(Diagnostic::Bug(function->span)
@@ -827,6 +848,226 @@ struct AllCheckTypePopulated : MixedModeVisitor {
 
 void EnsureCheckedType(const Expr& e) { AllCheckTypePopulated().VisitExpr(e); }
 
+/*!
+ * \brief The expressions typed by the last InferType of a pass context on this thread, which lets
+ * the next one re-check only the other expressions when `relay.InferType.incremental` is set.
+ *
+ * Rewrites rebuild nodes with WithFields, which keeps the checked type of the node it copies, so a
+ * checked type does not tell whether an expression changed, and not every mutator goes through
+ * ExprMutator::VisitExpr to report its rewrites. An expression missing from the record, though, was
+ * certainly produced since, by whichever pass. The record holds the expressions, so their addresses
+ * are not reused and copy-on-write never modifies them in place. It only holds the expressions of
+ * the last module typed, at most kMaxExprs of them, and is dropped by the first InferType run in
+ * another pass context.
+ */
+class TypedExprs {
+ public:
+  /*!
+   * \brief Get the record of a pass context.
+   * \param pass_ctx The pass context.
+   * \return The record, or nullptr if incremental type inference is not enabled.
+   */
+  static TypedExprs* Current(const transform::PassContext& pass_ctx) {
+    thread_local TypedExprs record;
+    if (!record.pass_ctx_.same_as(pass_ctx)) {
+      record.pass_ctx_ = transform::PassContext();
+      record.exprs_.clear();
+      if (pass_ctx->GetConfig<Bool>("relay.InferType.incremental", Bool(false)).value()) {
+        record.pass_ctx_ = pass_ctx;
+      }
+    }
+    return record.pass_ctx_.defined() ? &record : nullptr;
+  }
+
+  /*! \brief Whether an expression was typed by the last InferType. */
+  bool Contains(const Expr& expr) const { return exprs_.count(expr); }
+
+  /*! \brief Whether no expression is recorded, e.g. before the first InferType. */
+  bool empty() const { return exprs_.empty(); }
+
+  /*! \brief Record the expressions of the functions of a module, whose types were just inferred. */
+  void Reset(const IRModule& mod) {
+    exprs_.clear();
+    for (const auto& it : mod->functions) {
+      if (const auto* func = it.second.as<FunctionNode>()) {
+        PostOrderVisit(GetRef<Function>(func), [this](const Expr& expr) { exprs_.insert(expr); });
+      }
+    }
+    if (exprs_.size() > kMaxExprs) {
+      // The next run re-checks everything
+      exprs_.clear();
+    }
+  }
+
+ private:
+  /*! \brief The number of expressions above which the record is dropped */
+  static constexpr size_t kMaxExprs = 1 << 20;
+  /*! \brief The pass context the record belongs to, undefined if it is not incremental. */
+  transform::PassContext pass_ctx_;
+  /*! \brief The typed expressions. */
+  ExprSet exprs_;
+};
+
+/*!
+ * \brief Find the expressions of a function whose types must be inferred again.
+ *
+ * An expression is dirty if it has no checked type, was not typed by the previous InferType, i.e. it
+ * was produced by a rewrite since, refers to a global var or a
+ * constructor, or has a dirty sub-expression. A var without type annotation is dirty if the
+ * expression binding it is. The clean children of dirty expressions form the frontier, whose
+ * checked types are reused by the type inferencer.
+ */
+class DirtyExprFinder : public MixedModeVisitor {
+ public:
+  explicit DirtyExprFinder(const TypedExprs* typed) : typed_(typed) {}
+
+  /*! \brief Whether an expression is dirty. */
+  bool IsDirty(const Expr& expr) const { return dirty_.count(expr.get()); }
+
+  /*! \brief The clean expressions whose parent is dirty. */
+  ExprSet frontier;
+
+  using MixedModeVisitor::VisitExpr_;
+
+  void VisitExpr_(const VarNode* op) final {
+    if (dirty_vars_.count(op)) {
+      dirty_.insert(op);
+    } else {
+      Update(op, {});
+    }
+  }
+
+  void VisitExpr_(const GlobalVarNode* op) final { dirty_.insert(op); }
+
+  void VisitExpr_(const ConstructorNode* op) final { dirty_.insert(op); }
+
+  void VisitExpr_(const OpNode* op) final {}
+
+  void VisitExpr_(const ConstantNode* op) final { Update(op, {}); }
+
+  void VisitExpr_(const TupleNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    Update(op, op->fields);
+  }
+
+  void VisitExpr_(const TupleGetItemNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    Update(op, {op->tuple});
+  }
+
+  void VisitExpr_(const CallNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    Array<Expr> children = op->args;
+    if (!op->op.as<OpNode>()) {
+      children.push_back(op->op);
+    }
+    Update(op, children);
+  }
+
+  void VisitExpr_(const FunctionNode* op) final {
+    MarkRebound(op, op->params);
+    ExprVisitor::VisitExpr_(op);
+    Array<Expr> children(op->params.begin(), op->params.end());
+    children.push_back(op->body);
+    Update(op, children);
+  }
+
+  void VisitExpr_(const LetNode* op) final {
+    auto pre_visit = [this](const LetNode* op) {
+      // The var of a recursive function is used before its value is known to be clean.
+      if (op->value.as<FunctionNode>()) {
+        MarkRebound(nullptr, {op->var});
+      }
+      this->VisitExpr(op->value);
+      if (IsDirty(op->value)) {
+        MarkRebound(nullptr, {op->var});
+      } else {
+        MarkRebound(op, {op->var});
+      }
+      this->VisitExpr(op->var);
+    };
+    auto post_visit = [this](const LetNode* op) {
+      this->VisitExpr(op->body);
+      this->visit_counter_[op] += 1;
+      Update(op, {op->var, op->value, op->body});
+    };
+    ExpandANormalForm(op, pre_visit, post_visit);
+  }
+
+  void VisitExpr_(const IfNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    Update(op, {op->cond, op->true_branch, op->false_branch});
+  }
+
+  void VisitExpr_(const MatchNode* op) final {
+    Array<Var> pattern_vars;
+    for (const Clause& clause : op->clauses) {
+      for (const Var& var : BoundVars(clause->lhs)) {
+        pattern_vars.push_back(var);
+      }
+    }
+    MarkRebound(op, pattern_vars);
+    ExprVisitor::VisitExpr_(op);
+    Array<Expr> children = {op->data};
+    for (const Clause& clause : op->clauses) {
+      children.push_back(clause->rhs);
+    }
+    Update(op, children);
+  }
+
+  void VisitExpr_(const RefCreateNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    Update(op, {op->value});
+  }
+
+  void VisitExpr_(const RefReadNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    Update(op, {op->ref});
+  }
+
+  void VisitExpr_(const RefWriteNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    Update(op, {op->ref, op->value});
+  }
+
+ private:
+  bool IsStale(const ExprNode* op) const {
+    return !op->checked_type_.defined() || !typed_->Contains(GetRef<Expr>(op));
+  }
+
+  // Mark the vars without type annotation bound by a stale or unknown (nullptr) binder as dirty.
+  void MarkRebound(const ExprNode* binder, const Array<Var>& vars) {
+    if (binder != nullptr && !IsStale(binder)) {
+      return;
+    }
+    for (const Var& var : vars) {
+      if (!var->type_annotation.defined()) {
+        dirty_vars_.insert(var.get());
+      }
+    }
+  }
+
+  void Update(const ExprNode* op, const Array<Expr>& children) {
+    bool dirty = IsStale(op);
+    for (const Expr& child : children) {
+      dirty = dirty || IsDirty(child);
+    }
+    if (!dirty) {
+      return;
+    }
+    dirty_.insert(op);
+    for (const Expr& child : children) {
+      if (!IsDirty(child)) {
+        frontier.insert(child);
+      }
+    }
+  }
+
+  const TypedExprs* typed_;
+  std::unordered_set<const Object*> dirty_;
+  std::unordered_set<const VarNode*> dirty_vars_;
+};
+
 // TODO(@jroesch): Can we optimize this?
 void AddGlobalTypes(IRModule mod) {
   std::vector<std::pair<GlobalVar, Function>> updates;
@@ -949,6 +1190,8 @@ TVM_REGISTER_GLOBAL("relay._transform.InferTypeLocal").set_body_typed([](const E
   return InferTypeLocal(expr);
 });
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.InferType.incremental", Bool);
+
 Pass InferType() {
   auto pass_info = PassInfo(0, "InferType", {});
   return tvm::transform::CreateModulePass(
@@ -958,6 +1201,10 @@ Pass InferType() {
 
         pass_ctx->diag_ctx = DiagnosticContext::Default(updated_mod);
 
+        // In incremental mode, only the expressions produced since the last run are re-checked.
+        TypedExprs* typed = TypedExprs::Current(pass_ctx);
+        bool incremental = typed != nullptr && !typed->empty();
+
         // Add all the type annotations to the functions in the model.
         AddGlobalTypes(mod);
 
@@ -978,6 +1225,15 @@ Pass InferType() {
             // TODO(@jroesch): we should be able to move the type inferencer outside
             // of this function but it seems to be more stateful then I expect.
             auto inferencer = TypeInferencer(mod, pass_ctx->diag_ctx.value());
+            if (incremental) {
+              DirtyExprFinder finder(typed);
+              finder.VisitExpr(func.value());
+              if (!finder.IsDirty(func.value())) {
+                it.first->checked_type_ = func.value()->checked_type();
+                continue;
+              }
+              inferencer.ReuseCheckedTypes(finder.frontier);
+            }
             auto updated_func = inferencer.Infer(it.first, func.value());
 
             pass_ctx->diag_ctx.value().Render();
@@ -1002,6 +1258,9 @@ Pass InferType() {
           updated_mod->Add(pair.first, pair.second, true);
         }
 
+        if (typed != nullptr) {
+          typed->Reset(updated_mod);
+        }
         return updated_mod;
       },
       0, "InferType", {});
@@ -28,6 +28,7 @@
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/name_transforms.h>
+#include <tvm/runtime/threading_backend.h>
 
 #include <limits>
 #include <memory>
@@ -93,6 +94,24 @@ AotExecutor::AotExecutor(tvm::runtime::Module module, const std::vector<Device>&
   }
 }
 
+AotExecutor::AotExecutor(const AotExecutor& other, bool share_workspace)
+    : metadata_{other.metadata_},
+      module_{other.module_},
+      devices_{other.devices_},
+      param_inputs_{other.param_inputs_} {
+  int num_io = metadata_->num_inputs() + metadata_->num_outputs();
+  for (int i = 0; i < static_cast<int>(other.args_.size()); ++i) {
+    const NDArray& arg = other.args_[i];
+    // After the inputs and the outputs come the constant pool and the workspace pools.
+    bool shared = param_inputs_.count(i) || i == num_io || (i > num_io && share_workspace);
+    args_.push_back(shared ? arg : NDArray::Empty(arg.Shape(), arg.DataType(), arg->device));
+  }
+}
+
+Module AotExecutor::Clone(bool share_workspace) const {
+  return Module(make_object<AotExecutor>(*this, share_workspace));
+}
+
 PackedFunc AotExecutor::GetFunction(const std::string& name,
                                     const ObjectPtr<Object>& sptr_to_self) {
   // Return member functions during query.
@@ -159,6 +178,15 @@ PackedFunc AotExecutor::GetFunction(const std::string& name,
   } else if (name == "get_input_name") {
     return PackedFunc(
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->GetInputName(args[0]); });
+  } else if (name == "bind_thread_pool_group") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->BindThreadPoolGroup(args[0].operator std::string());
+    });
+  } else if (name == "clone") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      bool share_workspace = args.num_args > 0 ? args[0].operator bool() : false;
+      *rv = this->Clone(share_workspace);
+    });
   } else {
     return PackedFunc();
   }
@@ -181,9 +209,18 @@ void AotExecutor::Run() {
 
   TVMArgs args{call_values.get(), call_type_codes.get(), num_args};
   TVMRetValue rv;
+  threading::ThreadPoolGroupScope thread_pool_scope(thread_pool_group_);
   pf.CallPacked(args, &rv);
 }
 
+void AotExecutor::BindThreadPoolGroup(const std::string& name) {
+  if (!name.empty()) {
+    // fail early if the group does not exist.
+    threading::ThreadPoolGroupScope scope(name);
+  }
+  thread_pool_group_ = name;
+}
+
 int AotExecutor::GetInputIndex(const std::string& name) {
   auto inputs = metadata_->inputs();
   for (unsigned int i = 0; i < inputs.size(); i++) {
@@ -211,6 +248,11 @@ int AotExecutor::GetOutputIndex(const std::string& name) {
 
 void AotExecutor::SetInput(int index, DLTensor* data_ref) { args_[index].CopyFrom(data_ref); }
 
+void AotExecutor::SetParam(int index, DLTensor* data_ref) {
+  args_[index].CopyFrom(data_ref);
+  param_inputs_.insert(index);
+}
+
 void AotExecutor::SetInputZeroCopy(int index, DLTensor* data_ref) {
   ICHECK(false) << "not implemented";
 }
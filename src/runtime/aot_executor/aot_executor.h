@@ -31,6 +31,7 @@
 #include <tvm/runtime/packed_func.h>
 
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace tvm {
@@ -65,6 +66,13 @@ class TVM_DLL AotExecutor : public ModuleNode {
    */
   AotExecutor(tvm::runtime::Module module, const std::vector<Device>& devs);
 
+  /*!
+   * \brief Create a clone of an executor, see Clone.
+   * \param other The executor to clone.
+   * \param share_workspace Whether to share the workspace pools of other.
+   */
+  AotExecutor(const AotExecutor& other, bool share_workspace);
+
   /*!
    * \brief Get the input index given the name of input.
    * \param name The name of the input.
@@ -92,6 +100,12 @@ class TVM_DLL AotExecutor : public ModuleNode {
    * \param data_in The input data.
    */
   void SetInput(int index, DLTensor* data_in);
+  /*!
+   * \brief set index-th input to a parameter, which the clones of the executor share.
+   * \param index The input index.
+   * \param data_in The parameter data.
+   */
+  void SetParam(int index, DLTensor* data_in);
   /*!
    * \brief set index-th input to the graph without copying the data
    * \param index The input index.
@@ -137,6 +151,24 @@ class TVM_DLL AotExecutor : public ModuleNode {
    */
   void CopyOutputTo(int index, DLTensor* data_out);
 
+  /*!
+   * \brief Run the executor on the workers of a thread pool group.
+   * \param name The name of the group created by threading::CreateThreadPoolGroup,
+   *  an empty name uses the thread pool of the calling thread.
+   */
+  void BindThreadPoolGroup(const std::string& name);
+
+  /*!
+   * \brief Create another executor of the same module, for serving requests concurrently.
+   *
+   *  The clone shares the module, the constant pool and the parameters set by the executor
+   *  factory, and allocates its own inputs, outputs and workspace pools.
+   * \param share_workspace Whether the clone also shares the workspace pools, which requires
+   *  that the clone and this executor never run concurrently.
+   * \return The clone.
+   */
+  Module Clone(bool share_workspace) const;
+
  private:
   /*! \brief Metadata provided to the runtime from the compiler. */
   metadata::Metadata metadata_;
@@ -149,6 +181,12 @@ class TVM_DLL AotExecutor : public ModuleNode {
 
   /*! \brief Holds one NDArray per function argument in the same order. */
   std::vector<NDArray> args_;
+
+  /*! \brief The inputs holding the parameters, which the clones share. */
+  std::unordered_set<int> param_inputs_;
+
+  /*! \brief The thread pool group the executor runs on, empty for the thread local pool. */
+  std::string thread_pool_group_;
 };
 
 }  // namespace runtime
@@ -104,7 +104,7 @@ class TVM_DLL AotExecutorFactory : public runtime::ModuleNode {
     for (const auto& key : keys) {
       int in_idx = aot_executor->GetInputIndex(key);
       if (in_idx >= 0) {
-        aot_executor->SetInput(in_idx, const_cast<DLTensor*>(value[key].operator->()));
+        aot_executor->SetParam(in_idx, const_cast<DLTensor*>(value[key].operator->()));
       }
     }
   }
@@ -31,8 +31,10 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <cstdlib>
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -98,11 +100,14 @@ class DeviceAPIManager {
   }
 
  private:
-  std::array<DeviceAPI*, kMaxDeviceAPI> api_;
-  DeviceAPI* rpc_api_{nullptr};
+  // The APIs are read without the mutex, once set up
+  std::array<std::atomic<DeviceAPI*>, kMaxDeviceAPI> api_;
+  std::atomic<DeviceAPI*> rpc_api_{nullptr};
   std::mutex mutex_;
   // constructor
-  DeviceAPIManager() { std::fill(api_.begin(), api_.end(), nullptr); }
+  DeviceAPIManager() {
+    for (auto& api : api_) api.store(nullptr, std::memory_order_relaxed);
+  }
   // Global static variable.
   static DeviceAPIManager* Global() {
     static DeviceAPIManager* inst = new DeviceAPIManager();
@@ -110,19 +115,15 @@ class DeviceAPIManager {
   }
   // Get or initialize API.
   DeviceAPI* GetAPI(int type, bool allow_missing) {
-    if (type < kRPCSessMask) {
-      if (api_[type] != nullptr) return api_[type];
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (api_[type] != nullptr) return api_[type];
-      api_[type] = GetAPI(DeviceName(type), allow_missing);
-      return api_[type];
-    } else {
-      if (rpc_api_ != nullptr) return rpc_api_;
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (rpc_api_ != nullptr) return rpc_api_;
-      rpc_api_ = GetAPI("rpc", allow_missing);
-      return rpc_api_;
-    }
+    std::atomic<DeviceAPI*>& api = type < kRPCSessMask ? api_[type] : rpc_api_;
+    DeviceAPI* ptr = api.load(std::memory_order_acquire);
+    if (ptr != nullptr) return ptr;
+    std::lock_guard<std::mutex> lock(mutex_);
+    ptr = api.load(std::memory_order_relaxed);
+    if (ptr != nullptr) return ptr;
+    ptr = GetAPI(type < kRPCSessMask ? DeviceName(type) : "rpc", allow_missing);
+    api.store(ptr, std::memory_order_release);
+    return ptr;
   }
   DeviceAPI* GetAPI(const std::string name, bool allow_missing) {
     std::string factory = "device_api." + name;
@@ -33,8 +33,11 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/registry.h>
 
+#include <atomic>
 #include <cstdint>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 #include "meta_data.h"
 
@@ -67,14 +70,27 @@ class ConstLoaderModuleNode : public ModuleNode {
     }
   }
 
+  ~ConstLoaderModuleNode() {
+    if (warmup_thread_.joinable()) {
+      stop_warmup_ = true;
+      warmup_thread_.join();
+    }
+  }
+
   PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
     VLOG(1) << "ConstLoaderModuleNode::GetFunction(" << name << ")";
     // Initialize and memoize the module.
     // Usually, we have some warmup runs. The module initialization should be
     // done at this stage. Therefore, runtime overhead is not a concern.
-    if (initialized_.count(name) && !initialized_.at(name)) {
-      this->InitSubModule(name);
-      initialized_[name] = true;
+    if (initialized_.count(name)) {
+      this->InitSubModuleOnce(name);
+    }
+
+    if (name == "warmup") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        bool background = args.size() > 0 && static_cast<bool>(args[0]);
+        this->Warmup(background);
+      });
     }
 
     if (name == "get_const_var_ndarray") {
@@ -151,6 +167,48 @@ class ConstLoaderModuleNode : public ModuleNode {
     }
   }
 
+  /*!
+   * \brief Initialize the module of a symbol if it is not initialized yet.
+   * \param symbol The symbol of the module.
+   */
+  void InitSubModuleOnce(const std::string& symbol) {
+    std::lock_guard<std::mutex> lock(init_mutex_);
+    bool& initialized = initialized_.at(symbol);
+    if (!initialized) {
+      this->InitSubModule(symbol);
+      initialized = true;
+    }
+  }
+
+  /*!
+   * \brief Initialize the modules of all the symbols ahead of their first call.
+   * \param background Whether to initialize them in a background thread and return at once.
+   *  A symbol called meanwhile is initialized by its caller, or waits for the warmup thread.
+   *
+   * \note The modules are initialized lazily, per symbol, and share the constant arrays
+   *  of this module. The warmup only moves the initialization off the first inference.
+   */
+  void Warmup(bool background) {
+    std::vector<std::string> symbols;
+    for (const auto& kv : initialized_) {
+      symbols.push_back(kv.first);
+    }
+    auto f_warmup = [this, symbols]() {
+      for (const std::string& symbol : symbols) {
+        if (stop_warmup_) break;
+        this->InitSubModuleOnce(symbol);
+      }
+    };
+    if (!background) {
+      f_warmup();
+      return;
+    }
+    std::lock_guard<std::mutex> lock(warmup_mutex_);
+    if (!warmup_thread_.joinable()) {
+      warmup_thread_ = std::thread(f_warmup);
+    }
+  }
+
   void SaveToBinary(dmlc::Stream* stream) final {
     std::vector<std::string> variables;
     std::vector<NDArray> const_var_ndarray;
@@ -236,6 +294,14 @@ class ConstLoaderModuleNode : public ModuleNode {
    * modules using execution engine.
    */
   std::unordered_map<std::string, bool> initialized_;
+  /*! \brief Guards the initialization of the imported modules. */
+  std::mutex init_mutex_;
+  /*! \brief The thread initializing the modules in background, see Warmup. */
+  std::thread warmup_thread_;
+  /*! \brief Guards the creation of the warmup thread. */
+  std::mutex warmup_mutex_;
+  /*! \brief Whether the warmup thread should stop, set at the destruction of the module. */
+  std::atomic<bool> stop_warmup_{false};
   /*! \brief Variable name to NDArray mapping. */
   std::unordered_map<std::string, NDArray> const_var_ndarray_;
   /*! \brief Symbol name to required constant variables mapping. */
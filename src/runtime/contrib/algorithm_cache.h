@@ -0,0 +1,129 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file algorithm_cache.h
+ * \brief A process wide cache of the algorithms selected by the search of a vendor library.
+ *
+ * The keys describe the operator, its shapes, dtypes and layout, the library version and the
+ * GPU, and the values are the selected algorithm, both written as a single line of text. When
+ * `TVM_CONTRIB_ALGO_CACHE_FILE` is set, the cache is loaded from that file on first use, and
+ * each new entry is appended to it, so that the search is not repeated by the next processes.
+ */
+#ifndef TVM_RUNTIME_CONTRIB_ALGORITHM_CACHE_H_
+#define TVM_RUNTIME_CONTRIB_ALGORITHM_CACHE_H_
+
+#include <tvm/runtime/logging.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace tvm {
+namespace contrib {
+
+class AlgorithmCache {
+ public:
+  /*! \return The cache shared by the process. */
+  static AlgorithmCache* Global() {
+    static AlgorithmCache* inst = new AlgorithmCache();
+    return inst;
+  }
+
+  /*!
+   * \brief Look up the algorithm selected for a key.
+   * \param key The key, without tab or newline.
+   * \param value The selected algorithm, set on a hit.
+   * \return Whether the key is in the cache.
+   */
+  bool Get(const std::string& key, std::string* value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    LoadFile();
+    auto it = table_.find(key);
+    if (it == table_.end()) return false;
+    *value = it->second;
+    return true;
+  }
+
+  /*!
+   * \brief Record the algorithm selected for a key, and append it to the cache file.
+   * \param key The key, without tab or newline.
+   * \param value The selected algorithm, without newline.
+   */
+  void Put(const std::string& key, const std::string& value) {
+    ICHECK(key.find_first_of("\t\n") == std::string::npos) << "Invalid algorithm cache key";
+    ICHECK(value.find('\n') == std::string::npos) << "Invalid algorithm cache value";
+    std::lock_guard<std::mutex> lock(mutex_);
+    LoadFile();
+    table_[key] = value;
+    if (loaded_path_.empty()) return;
+    std::ofstream fs(loaded_path_, std::ios::app);
+    fs << key << '\t' << value << '\n';
+    if (!fs) {
+      LOG(WARNING) << "Cannot write the algorithm cache file " << loaded_path_;
+    }
+  }
+
+ private:
+  /*! \brief Load the entries of the cache file, when it has changed since the last load. */
+  void LoadFile() {
+    const char* path = std::getenv("TVM_CONTRIB_ALGO_CACHE_FILE");
+    std::string file = path != nullptr ? path : "";
+    if (file == loaded_path_) return;
+    loaded_path_ = file;
+    if (file.empty()) return;
+    std::ifstream fs(file);
+    std::string line;
+    while (std::getline(fs, line)) {
+      // The last line has no newline yet when another process is appending to the file
+      if (fs.eof()) break;
+      size_t pos = line.find('\t');
+      if (pos == std::string::npos) continue;
+      table_[line.substr(0, pos)] = line.substr(pos + 1);
+    }
+  }
+
+  std::mutex mutex_;
+  /*! \brief The path of the loaded cache file, empty when there is none. */
+  std::string loaded_path_;
+  std::unordered_map<std::string, std::string> table_;
+};
+
+/*!
+ * \brief Join the values of an array into one field of an algorithm cache key.
+ * \param n The number of values.
+ * \param values The values.
+ * \return The values separated by 'x'.
+ */
+template <typename T>
+inline std::string AlgorithmCacheField(int n, const T* values) {
+  std::ostringstream os;
+  for (int i = 0; i < n; ++i) {
+    os << (i == 0 ? "" : "x") << values[i];
+  }
+  return os.str();
+}
+
+}  // namespace contrib
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_CONTRIB_ALGORITHM_CACHE_H_
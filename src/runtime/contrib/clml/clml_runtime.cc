@@ -73,7 +73,15 @@ class CLMLRuntime : public JSONRuntimeBase {
   ~CLMLRuntime() {
 #ifdef TVM_GRAPH_EXECUTOR_CLML
     cl_int result = 0;
-    if (this->is_tuning_run) {
+#ifdef CL_QUEUE_RECORDABLE_QCOM
+    if (this->layer_.recording != nullptr) {
+      result = clReleaseRecordingQCOM(this->layer_.recording);
+      ICHECK(result == CL_SUCCESS) << "clReleaseRecordingQCOM:" << result;
+      result = clReleaseCommandQueue(this->layer_.recordable_queue);
+      ICHECK(result == CL_SUCCESS) << "clReleaseCommandQueue:" << result;
+    }
+#endif
+    if (this->tuning_cache != nullptr) {
       result = h_ClmlIntf->clReleaseMLTuningCacheQCOM(this->tuning_cache);
       ICHECK(result == CL_SUCCESS) << "clReleaseMLTuningCacheQCOM:" << result;
     }
@@ -182,29 +190,38 @@ class CLMLRuntime : public JSONRuntimeBase {
       this->is_tuning_run = 0;
 
     if (!(tuning_file = getenv("CLML_TUNING_CACHE"))) this->is_tuning_run = 0;
+    // The tuning depends on the GPU and its driver, as well as on the sub graph
+    tuning_key = clml_symbol + "|" + cl::GetDeviceInfo(device_id, CL_DEVICE_NAME) + "|" +
+                 cl::GetDeviceInfo(device_id, CL_DRIVER_VERSION);
     // A Tuning run, so create the cache from scratch
     result = h_ClmlIntf->clCreateMLTuningCacheQCOM(&tuning_cache);
     ICHECK(result == CL_SUCCESS) << "clCreateMLTuningCacheQCOM:" << result;
     if (!this->is_tuning_run && this->tuning_file) {
       std::vector<unsigned char> tune_buffer;
       std::string tune_blob;
-      LoadBinaryFromFile(this->tuning_file, &tune_blob);
+      if (std::ifstream(this->tuning_file).good()) {
+        LoadBinaryFromFile(this->tuning_file, &tune_blob);
+      }
       dmlc::MemoryStringStream mstrm(const_cast<std::string*>(&tune_blob));
       dmlc::Stream* strm = &mstrm;
 
+      // An entry of the device is preferred to one keyed by the symbol only, which older
+      // versions wrote. The last entry of a key wins, as the file is appended to.
       uint64_t header, reserve;
       std::string tune_symbol;
+      bool key_found = false;
       while (strm->Read(&header)) {
         if (header != kTVMCLMLTuningCacheMagic) break;
         if (!strm->Read(&reserve)) break;
         if (!strm->Read(&tune_symbol)) break;
         LOG(INFO) << "Tuning Cache Symbol:" << tune_symbol;
-        if (tune_symbol == clml_symbol) {
-          strm->Read(&tune_buffer);
-          break;
-        } else {
-          std::vector<unsigned char> tmp_buf;
-          if (!strm->Read(&tmp_buf)) break;
+        std::vector<unsigned char> tmp_buf;
+        if (!strm->Read(&tmp_buf)) break;
+        if (tune_symbol == tuning_key) {
+          tune_buffer = std::move(tmp_buf);
+          key_found = true;
+        } else if (tune_symbol == clml_symbol && !key_found) {
+          tune_buffer = std::move(tmp_buf);
         }
       }
 
@@ -215,8 +232,10 @@ class CLMLRuntime : public JSONRuntimeBase {
                                                      tune_buffer.data());
         ICHECK(result == CL_SUCCESS) << "clLoadMLTuningCacheQCOM:" << result;
       } else {
-        LOG(WARNING) << "Tuning cache not cound for symbol :" << clml_symbol << " in file "
-                     << this->tuning_file;
+        // Tune once, and append the result to the cache for the next processes
+        LOG(WARNING) << "Tuning cache not found for symbol :" << clml_symbol << " in file "
+                     << this->tuning_file << ", tuning it";
+        this->is_tuning_run = 1;
       }
     }
   }
@@ -313,7 +332,18 @@ class CLMLRuntime : public JSONRuntimeBase {
     }
 
     int64_t duration = 0;
-    for (size_t i = 0; i < this->layer_.function.size(); ++i) {
+#ifdef CL_QUEUE_RECORDABLE_QCOM
+    // The recording replays all the ops of the sub graph with a single enqueue
+    bool replay = this->layer_.recording != nullptr && !getenv("CLML_PROFILING");
+    if (replay) {
+      result = clEnqueueRecordingQCOM(queue, this->layer_.recording, 0, NULL, 0, NULL, 0, NULL, 0,
+                                      NULL, 0, NULL, NULL);
+      ICHECK(result == CL_SUCCESS) << "clEnqueueRecordingQCOM:" << result;
+    }
+#else
+    bool replay = false;
+#endif
+    for (size_t i = 0; i < this->layer_.function.size() && !replay; ++i) {
       // Make CLML subgraphs accounted by OpenCLTimerNode.
 
       if (getenv("CLML_PROFILING")) {
@@ -544,7 +574,7 @@ class CLMLRuntime : public JSONRuntimeBase {
       uint64_t reserved = 0x0;
       strm->Write(header);
       strm->Write(reserved);
-      strm->Write(clml_symbol);
+      strm->Write(tuning_key);
       strm->Write(saved_cache);
 
       std::ofstream fs(tuning_file, std::ios::app | std::ios::binary);
@@ -553,6 +583,38 @@ class CLMLRuntime : public JSONRuntimeBase {
       LOG(WARNING) << "CLML: Tuning cache dumped to:" << tuning_file << " size" << tune_str.length()
                    << " with tuning blob len " << saved_cache.size();
     }
+    RecordLayer();
+  }
+
+  /*!
+   * \brief Record the ops of the layer on a recordable queue, when the device supports
+   * `cl_qcom_recordable_queues`, so that `Run` replays them with a single enqueue.
+   *
+   * The memories of the ops are bound by the descriptor set when they are recorded. They do not
+   * change between runs, as the inputs and outputs are copied from and to the placeholders.
+   * Setting `CLML_DISABLE_RECORDABLE_QUEUE` enqueues the ops one by one.
+   */
+  void RecordLayer() {
+#ifdef CL_QUEUE_RECORDABLE_QCOM
+    if (getenv("CLML_DISABLE_RECORDABLE_QUEUE") ||
+        !ExtensionStringPresent("cl_qcom_recordable_queues")) {
+      return;
+    }
+    cl_int result = 0;
+    this->layer_.recordable_queue = clCreateCommandQueue(
+        workspace->contexts[platform_id], device_id, CL_QUEUE_RECORDABLE_QCOM, &result);
+    ICHECK(result == CL_SUCCESS) << "clCreateCommandQueue:" << result;
+    this->layer_.recording = clNewRecordingQCOM(this->layer_.recordable_queue, &result);
+    ICHECK(result == CL_SUCCESS) << "clNewRecordingQCOM:" << result;
+    for (size_t i = 0; i < this->layer_.function.size(); ++i) {
+      result = h_ClmlIntf->clEnqueueMLOpQCOM(this->layer_.recordable_queue,
+                                             this->layer_.function[i], this->layer_.descriptorSet,
+                                             0, NULL, NULL);
+      ICHECK(result == CL_SUCCESS) << "clEnqueueMLOpQCOM:" << result;
+    }
+    result = clEndRecordingQCOM(this->layer_.recording);
+    ICHECK(result == CL_SUCCESS) << "clEndRecordingQCOM:" << result;
+#endif
   }
 
   /*!
@@ -575,13 +637,17 @@ class CLMLRuntime : public JSONRuntimeBase {
     cl_ml_tensor_mem_desc_set_qcom descriptorSet;
     std::vector<std::string> layer_names;
     cl_ml_tensor_qcom unusedTensor = NULL;
+#ifdef CL_QUEUE_RECORDABLE_QCOM
+    cl_command_queue recordable_queue = nullptr;
+    cl_recording_qcom recording = nullptr;
+#endif
   };
 
   struct tensor_dims_t {
     uint32_t n, c, h, w;
   };
 
-  bool ExtensionStringPresent(void) {
+  bool ExtensionStringPresent(const std::string& extension = "cl_qcom_ml_ops") {
     cl_int result = 0;
     size_t reqd_size = 0;
     cl_device_id device_id =
@@ -595,7 +661,7 @@ class CLMLRuntime : public JSONRuntimeBase {
 
     std::string extensions(buf.data());
     LOG(WARNING) << "OpenCL Extensions:" << extensions;
-    return (extensions.find("cl_qcom_ml_ops") != std::string::npos);
+    return (extensions.find(extension) != std::string::npos);
   }
 
   cl_ml_tensor_qcom DeviceMakeCLMLTensor(
@@ -1430,6 +1496,8 @@ class CLMLRuntime : public JSONRuntimeBase {
   cl_ml_tuningcache_qcom tuning_cache = NULL;
   bool is_tuning_run;
   char* tuning_file;
+  /*! \brief The key of the tuning cache entry, made of the symbol, the GPU and its driver. */
+  std::string tuning_key;
 #else
   void Run() override {
     LOG(FATAL) << "Cannot call run on CLML module without runtime enabled. "
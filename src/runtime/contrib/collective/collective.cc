@@ -0,0 +1,190 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file collective.cc
+ * \brief Collective operations between the shards of a tensor on several devices.
+ *
+ * The shards are all given to one call, as the devices of the mesh are driven by one process.
+ * The shards on CUDA devices are forwarded to NCCL when TVM is built with USE_NCCL, the others
+ * are reduced or gathered through the host memory.
+ */
+#include <tvm/runtime/data_type.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/registry.h>
+
+#include <cstring>
+#include <vector>
+
+namespace tvm {
+namespace contrib {
+
+using namespace runtime;
+
+/*!
+ * \brief Split the arguments into the inputs and the outputs of a collective.
+ * \param args The arguments, n inputs followed by n outputs.
+ * \param begin The index of the first input.
+ * \param inputs The input shards, one per device.
+ * \param outputs The output shards, one per device.
+ */
+void GetShards(const TVMArgs& args, int begin, std::vector<DLTensor*>* inputs,
+               std::vector<DLTensor*>* outputs) {
+  int num_args = args.num_args - begin;
+  CHECK(num_args > 0 && num_args % 2 == 0)
+      << "ValueError: A collective expects as many outputs as inputs, but gets " << num_args
+      << " arguments";
+  for (int i = 0; i < num_args / 2; ++i) {
+    inputs->push_back(args[begin + i]);
+    outputs->push_back(args[begin + num_args / 2 + i]);
+  }
+  for (size_t i = 0; i < inputs->size(); ++i) {
+    CHECK((*inputs)[i]->strides == nullptr && (*outputs)[i]->strides == nullptr)
+        << "ValueError: The shards of a collective must be compact";
+    CHECK(DataType((*inputs)[i]->dtype) == DataType((*inputs)[0]->dtype) &&
+          DataType((*outputs)[i]->dtype) == DataType((*inputs)[0]->dtype))
+        << "TypeError: The shards of a collective must have the same dtype";
+    CHECK_EQ(GetDataSize(*(*inputs)[i]), GetDataSize(*(*inputs)[0]))
+        << "ValueError: The shards of a collective must have the same shape";
+  }
+}
+
+/*! \brief Get the NCCL implementation of the collective if it applies to the shards, else null. */
+const PackedFunc* GetNCCLCollective(const std::string& name,
+                                    const std::vector<DLTensor*>& inputs,
+                                    const std::vector<DLTensor*>& outputs) {
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (inputs[i]->device.device_type != kDLCUDA ||
+        outputs[i]->device.device_type != kDLCUDA ||
+        inputs[i]->device.device_id != outputs[i]->device.device_id) {
+      return nullptr;
+    }
+  }
+  return Registry::Get("tvm.contrib.collective.nccl." + name);
+}
+
+/*! \brief Copy a shard into a new array on the host. */
+NDArray CopyToHost(const DLTensor* shard) {
+  std::vector<int64_t> shape(shard->shape, shard->shape + shard->ndim);
+  NDArray host = NDArray::Empty(shape, shard->dtype, {kDLCPU, 0});
+  NDArray::CopyFromTo(shard, const_cast<DLTensor*>(host.operator->()));
+  return host;
+}
+
+/*! \brief Add the elements of src to dst. */
+template <typename T>
+void AddTo(const NDArray& src, NDArray* dst) {
+  const T* src_data = static_cast<const T*>(src->data);
+  T* dst_data = static_cast<T*>((*dst)->data);
+  int64_t n = GetDataSize(*src.operator->()) / sizeof(T);
+  for (int64_t i = 0; i < n; ++i) {
+    dst_data[i] += src_data[i];
+  }
+}
+
+/*!
+ * \brief Sum the input shards, and write the sum to every output shard.
+ * \param inputs The input shards, one per device.
+ * \param outputs The output shards, one per device.
+ */
+void AllReduceOnHost(const std::vector<DLTensor*>& inputs, const std::vector<DLTensor*>& outputs) {
+  NDArray sum = CopyToHost(inputs[0]);
+  DataType dtype(inputs[0]->dtype);
+  for (size_t i = 1; i < inputs.size(); ++i) {
+    NDArray shard = CopyToHost(inputs[i]);
+    if (dtype == DataType::Float(32)) {
+      AddTo<float>(shard, &sum);
+    } else if (dtype == DataType::Float(64)) {
+      AddTo<double>(shard, &sum);
+    } else if (dtype == DataType::Int(32)) {
+      AddTo<int32_t>(shard, &sum);
+    } else if (dtype == DataType::Int(64)) {
+      AddTo<int64_t>(shard, &sum);
+    } else {
+      LOG(FATAL) << "TypeError: The host allreduce doesn't support dtype " << dtype;
+    }
+  }
+  for (DLTensor* output : outputs) {
+    NDArray::CopyFromTo(sum.operator->(), output);
+  }
+}
+
+/*!
+ * \brief Concatenate the input shards along the axis, and write the result to every output.
+ * \param axis The axis to concatenate along.
+ * \param inputs The input shards, one per device.
+ * \param outputs The output shards, one per device.
+ */
+void AllGatherOnHost(int axis, const std::vector<DLTensor*>& inputs,
+                     const std::vector<DLTensor*>& outputs) {
+  int64_t outer = 1;
+  for (int i = 0; i < axis; ++i) {
+    outer *= inputs[0]->shape[i];
+  }
+  size_t chunk = GetDataSize(*inputs[0]) / outer;
+  size_t num_shards = inputs.size();
+  std::vector<int64_t> shape(outputs[0]->shape, outputs[0]->shape + outputs[0]->ndim);
+  NDArray gathered = NDArray::Empty(shape, inputs[0]->dtype, {kDLCPU, 0});
+  char* dst = static_cast<char*>(gathered->data);
+  for (size_t s = 0; s < num_shards; ++s) {
+    NDArray shard = CopyToHost(inputs[s]);
+    const char* src = static_cast<const char*>(shard->data);
+    for (int64_t o = 0; o < outer; ++o) {
+      std::memcpy(dst + (o * num_shards + s) * chunk, src + o * chunk, chunk);
+    }
+  }
+  for (DLTensor* output : outputs) {
+    NDArray::CopyFromTo(gathered.operator->(), output);
+  }
+}
+
+TVM_REGISTER_GLOBAL("tvm.contrib.collective.allreduce")
+    .set_body([](TVMArgs args, TVMRetValue* ret) {
+      std::vector<DLTensor*> inputs, outputs;
+      GetShards(args, 0, &inputs, &outputs);
+      if (const PackedFunc* f = GetNCCLCollective("allreduce", inputs, outputs)) {
+        f->CallPacked(args, ret);
+      } else {
+        AllReduceOnHost(inputs, outputs);
+      }
+    });
+
+TVM_REGISTER_GLOBAL("tvm.contrib.collective.allgather")
+    .set_body([](TVMArgs args, TVMRetValue* ret) {
+      int axis = args[0];
+      std::vector<DLTensor*> inputs, outputs;
+      GetShards(args, 1, &inputs, &outputs);
+      int ndim = inputs[0]->ndim;
+      CHECK(axis >= -ndim && axis < ndim)
+          << "ValueError: The axis " << axis << " is out of range for " << ndim << "-d shards";
+      axis = axis < 0 ? axis + ndim : axis;
+      for (DLTensor* output : outputs) {
+        CHECK_EQ(GetDataSize(*output), GetDataSize(*inputs[0]) * inputs.size())
+            << "ValueError: The output of allgather must hold all the input shards";
+      }
+      if (const PackedFunc* f = GetNCCLCollective("allgather", inputs, outputs)) {
+        f->CallPacked(args, ret);
+      } else {
+        AllGatherOnHost(axis, inputs, outputs);
+      }
+    });
+
+}  // namespace contrib
+}  // namespace tvm
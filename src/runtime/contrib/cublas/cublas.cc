@@ -24,6 +24,12 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/registry.h>
 
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include "../../cuda/cuda_common.h"
+#include "../algorithm_cache.h"
 #include "../cblas/gemm_common.h"
 #include "cublas_utils.h"
 
@@ -133,6 +139,91 @@ bool CheckMixPrecisionType(DLDataType in_dtype, DLDataType out_dtype, bool int_s
 int roundoff(int v, int d) { return (v + d - 1) / d * d; }
 
 #if CUDART_VERSION >= 10010
+/*!
+ * \brief Select the cuBLASLt algorithm of a matmul without workspace, looking it up in the
+ *  algorithm cache first. On a miss, the candidates returned by the cuBLASLt heuristic are timed
+ *  on the operands, which is only done when the output is not accumulated into.
+ * \param key The key of the matmul in the algorithm cache.
+ * \param beta_is_zero Whether the matmul overwrites its output, so that it can be run repeatedly.
+ * \param algo The selected algorithm.
+ * \return Whether an algorithm is selected, otherwise the default heuristic is to be used.
+ */
+inline bool SelectLtMatmulAlgo(cublasLtHandle_t hdl, cublasLtMatmulDesc_t op_desc,
+                               const void* alpha, const void* a, cublasLtMatrixLayout_t a_desc,
+                               const void* b, cublasLtMatrixLayout_t b_desc, const void* beta,
+                               void* c, cublasLtMatrixLayout_t c_desc, const std::string& key,
+                               bool beta_is_zero, cublasLtMatmulAlgo_t* algo) {
+  std::string cached_algo;
+  if (AlgorithmCache::Global()->Get(key, &cached_algo)) {
+    std::istringstream is(cached_algo);
+    for (uint64_t& word : algo->data) {
+      is >> std::hex >> word;
+    }
+    cublasLtMatmulHeuristicResult_t check;
+    if (is && cublasLtMatmulAlgoCheck(hdl, op_desc, a_desc, b_desc, c_desc, c_desc, algo,
+                                      &check) == CUBLAS_STATUS_SUCCESS &&
+        check.workspaceSize == 0) {
+      return true;
+    }
+    LOG(WARNING) << "Ignoring the invalid cached cuBLASLt algorithm of " << key;
+  }
+  if (!beta_is_zero) return false;
+
+  constexpr int kMaxCandidates = 8;
+  constexpr int kTimingRepeats = 5;
+  cublasLtMatmulPreference_t preference;
+  CHECK_CUBLAS_ERROR(cublasLtMatmulPreferenceCreate(&preference));
+  size_t workspace_size = 0;
+  CHECK_CUBLAS_ERROR(cublasLtMatmulPreferenceSetAttribute(
+      preference, CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES, &workspace_size,
+      sizeof(workspace_size)));
+  cublasLtMatmulHeuristicResult_t results[kMaxCandidates];
+  int num_results = 0;
+  cublasStatus_t status =
+      cublasLtMatmulAlgoGetHeuristic(hdl, op_desc, a_desc, b_desc, c_desc, c_desc, preference,
+                                     kMaxCandidates, results, &num_results);
+  CHECK_CUBLAS_ERROR(cublasLtMatmulPreferenceDestroy(preference));
+  if (status != CUBLAS_STATUS_SUCCESS || num_results == 0) return false;
+
+  int best = -1;
+  float best_time = std::numeric_limits<float>::infinity();
+  cudaEvent_t start, stop;
+  CUDA_CALL(cudaEventCreate(&start));
+  CUDA_CALL(cudaEventCreate(&stop));
+  for (int i = 0; i < num_results; ++i) {
+    if (results[i].state != CUBLAS_STATUS_SUCCESS) continue;
+    // The first run is a warm up, and rejects the algorithms failing on these operands
+    if (cublasLtMatmul(hdl, op_desc, alpha, a, a_desc, b, b_desc, beta, c, c_desc, c, c_desc,
+                       &results[i].algo, nullptr, 0, nullptr) != CUBLAS_STATUS_SUCCESS) {
+      continue;
+    }
+    CUDA_CALL(cudaEventRecord(start, nullptr));
+    for (int r = 0; r < kTimingRepeats; ++r) {
+      CHECK_CUBLAS_ERROR(cublasLtMatmul(hdl, op_desc, alpha, a, a_desc, b, b_desc, beta, c, c_desc,
+                                        c, c_desc, &results[i].algo, nullptr, 0, nullptr));
+    }
+    CUDA_CALL(cudaEventRecord(stop, nullptr));
+    CUDA_CALL(cudaEventSynchronize(stop));
+    float time_ms = 0;
+    CUDA_CALL(cudaEventElapsedTime(&time_ms, start, stop));
+    if (time_ms < best_time) {
+      best_time = time_ms;
+      best = i;
+    }
+  }
+  CUDA_CALL(cudaEventDestroy(start));
+  CUDA_CALL(cudaEventDestroy(stop));
+  if (best < 0) return false;
+
+  *algo = results[best].algo;
+  std::ostringstream os;
+  for (uint64_t word : algo->data) {
+    os << std::hex << word << ' ';
+  }
+  AlgorithmCache::Global()->Put(key, os.str());
+  return true;
+}
+
 inline void CallLtIgemm(TVMArgs args, TVMRetValue* ret, cublasLtHandle_t hdl) {
   DLTensor* A = args[0];
   DLTensor* B = args[1];
@@ -203,8 +294,16 @@ inline void CallLtIgemm(TVMArgs args, TVMRetValue* ret, cublasLtHandle_t hdl) {
   CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutSetAttribute(Cdesc, CUBLASLT_MATRIX_LAYOUT_ORDER,
                                                       &order_COL32, sizeof(order_COL32)));
 
+  std::ostringstream key;
+  key << "cublaslt.igemm|shape=" << M << "x" << N << "x" << K << "x" << N_out
+      << "|trans=" << transa << transb << "|cublasLt" << cublasLtGetVersion() << "|"
+      << GetCUDADeviceKey();
+  cublasLtMatmulAlgo_t algo;
+  bool has_algo = SelectLtMatmulAlgo(hdl, operationDesc, &alpha, B_data, Adesc, A_data, Bdesc,
+                                     &beta, C_data, Cdesc, key.str(), beta == 0, &algo);
   CHECK_CUBLAS_ERROR(cublasLtMatmul(hdl, operationDesc, &alpha, B_data, Adesc, A_data, Bdesc, &beta,
-                                    C_data, Cdesc, C_data, Cdesc, nullptr, nullptr, 0, nullptr));
+                                    C_data, Cdesc, C_data, Cdesc, has_algo ? &algo : nullptr,
+                                    nullptr, 0, nullptr));
 }
 #endif
 
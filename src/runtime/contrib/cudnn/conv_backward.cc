@@ -24,6 +24,7 @@
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/registry.h>
 
+#include "../algorithm_cache.h"
 #include "cudnn_utils.h"
 
 namespace tvm {
@@ -64,6 +65,13 @@ void BackwardDataFindAlgo(int format, int dims, int groups, const int pad[], con
                           const int dilation[], const int dy_dim[], const int w_dim[],
                           const int dx_dim[], const std::string& data_dtype,
                           const std::string& conv_dtype, TVMRetValue* ret) {
+  std::string key = ConvAlgoCacheKey("bwd_data", format, dims, groups, pad, stride, dilation,
+                                     dx_dim, w_dim, dy_dim, data_dtype, conv_dtype);
+  std::string cached_algo;
+  if (AlgorithmCache::Global()->Get(key, &cached_algo)) {
+    ret[0] = std::stoi(cached_algo);
+    return;
+  }
   CuDNNThreadEntry* entry_ptr = CuDNNThreadEntry::ThreadLocal();
   const int full_dims = dims + 2;
   std::vector<int64_t> dy_dim_int64(full_dims);
@@ -103,6 +111,7 @@ void BackwardDataFindAlgo(int format, int dims, int groups, const int pad[], con
               << ", Memory: " << perf_results[i].memory;
   }
 
+  AlgorithmCache::Global()->Put(key, std::to_string(best_algo));
   ret[0] = best_algo;
 }
 
@@ -140,6 +149,13 @@ void BackwardFilterFindAlgo(int format, int dims, int groups, const int pad[], c
                             const int dilation[], const int dy_dim[], const int x_dim[],
                             const int dw_dim[], const std::string& data_dtype,
                             const std::string& conv_dtype, TVMRetValue* ret) {
+  std::string key = ConvAlgoCacheKey("bwd_filter", format, dims, groups, pad, stride, dilation,
+                                     x_dim, dw_dim, dy_dim, data_dtype, conv_dtype);
+  std::string cached_algo;
+  if (AlgorithmCache::Global()->Get(key, &cached_algo)) {
+    ret[0] = std::stoi(cached_algo);
+    return;
+  }
   CuDNNThreadEntry* entry_ptr = CuDNNThreadEntry::ThreadLocal();
   const int full_dims = dims + 2;
   std::vector<int64_t> x_dim_int64(full_dims);
@@ -180,6 +196,7 @@ void BackwardFilterFindAlgo(int format, int dims, int groups, const int pad[], c
               << ", Memory: " << perf_results[i].memory;
   }
 
+  AlgorithmCache::Global()->Put(key, std::to_string(best_algo));
   ret[0] = best_algo;
 }
 
@@ -27,9 +27,12 @@
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/registry.h>
 
+#include <sstream>
 #include <string>
 #include <vector>
 
+#include "../algorithm_cache.h"
+
 namespace tvm {
 namespace contrib {
 
@@ -259,6 +262,21 @@ void SetConvDescriptors(CuDNNThreadEntry* entry_ptr, int format, int dims, int g
   }
 }
 
+std::string ConvAlgoCacheKey(const std::string& op, int format, int dims, int groups,
+                             const int pad[], const int stride[], const int dilation[],
+                             const int x_dim[], const int w_dim[], const int y_dim[],
+                             const std::string& data_dtype, const std::string& conv_dtype) {
+  std::ostringstream os;
+  os << "cudnn.conv." << op << "|format=" << format << "|groups=" << groups
+     << "|pad=" << AlgorithmCacheField(dims, pad) << "|stride=" << AlgorithmCacheField(dims, stride)
+     << "|dilation=" << AlgorithmCacheField(dims, dilation)
+     << "|x=" << AlgorithmCacheField(dims + 2, x_dim)
+     << "|w=" << AlgorithmCacheField(dims + 2, w_dim)
+     << "|y=" << AlgorithmCacheField(dims + 2, y_dim) << "|" << data_dtype << "|" << conv_dtype
+     << "|cudnn" << cudnnGetVersion() << "|" << runtime::GetCUDADeviceKey();
+  return os.str();
+}
+
 // SoftmaxEntry
 
 SoftmaxEntry::SoftmaxEntry() { CUDNN_CALL(cudnnCreateTensorDescriptor(&shape_desc)); }
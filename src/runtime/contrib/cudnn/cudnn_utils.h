@@ -114,6 +114,19 @@ void SetConvDescriptors(CuDNNThreadEntry* entry_ptr, int format, int dims, int g
                         int64_t w_dim[], int64_t y_dim[], DLDataType data_dtype,
                         const std::string& conv_dtype);
 
+/*!
+ * \brief Get the key of a convolution in the algorithm cache.
+ * \param op The searched convolution, one of "fwd", "bwd_data" and "bwd_filter".
+ * \param x_dim The shape of the input, or of the gradient of the input.
+ * \param w_dim The shape of the filter, or of the gradient of the filter.
+ * \param y_dim The shape of the output, or of the gradient of the output.
+ * \return The key, which includes the cuDNN version and the current device.
+ */
+std::string ConvAlgoCacheKey(const std::string& op, int format, int dims, int groups,
+                             const int pad[], const int stride[], const int dilation[],
+                             const int x_dim[], const int w_dim[], const int y_dim[],
+                             const std::string& data_dtype, const std::string& conv_dtype);
+
 }  // namespace contrib
 }  // namespace tvm
 
@@ -0,0 +1,575 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file cupti.cc
+ * \brief Per kernel hardware metrics on NVIDIA GPUs through the CUPTI range profiler.
+ */
+#include <cupti_profiler_target.h>
+#include <cupti_target.h>
+#include <nvperf_cuda_host.h>
+#include <nvperf_host.h>
+#include <tvm/runtime/contrib/cupti.h>
+#include <tvm/runtime/registry.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../cuda/cuda_common.h"
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+#define CUPTI_CALL(func)                                                                  \
+  {                                                                                       \
+    CUptiResult e = (func);                                                               \
+    if (e != CUPTI_SUCCESS) {                                                             \
+      const char* msg;                                                                    \
+      cuptiGetResultString(e, &msg);                                                      \
+      LOG(FATAL) << "CUPTIError: in function " #func " " << e << " " << std::string(msg); \
+    }                                                                                     \
+  }
+
+#define NVPW_CALL(func)                                                            \
+  {                                                                                \
+    NVPA_Status e = (func);                                                        \
+    if (e != NVPA_STATUS_SUCCESS) {                                                \
+      LOG(FATAL) << "NVPerfError: in function " #func " failed with status " << e; \
+    }                                                                              \
+  }
+
+/*! \brief Metrics collected when the user does not name any: achieved
+ * occupancy, DRAM throughput, L2 hit rate and tensor core utilization. */
+static const std::vector<std::string> default_metric_names = {
+    "sm__warps_active.avg.pct_of_peak_sustained_active",
+    "dram__throughput.avg.pct_of_peak_sustained_elapsed", "lts__t_sector_hit_rate.pct",
+    "sm__pipe_tensor_cycles_active.avg.pct_of_peak_sustained_active"};
+
+/*! \brief Metric used to weight the per kernel values of the other metrics. */
+static const char* kDurationMetric = "gpu__time_duration.sum";
+
+/*! \brief Maximum number of kernels recorded in one profiling run. */
+static constexpr int kMaxRanges = 4096;
+
+/*! \brief Object that holds the index of the first kernel of a function call. */
+struct CUPTIRangeNode : public Object {
+  /*! \brief Index of the first range (kernel) recorded for the call. */
+  size_t first_range;
+  /*! \brief The device the call runs on. */
+  Device dev;
+
+  explicit CUPTIRangeNode(size_t first_range, Device dev) : first_range(first_range), dev(dev) {}
+
+  static constexpr const char* _type_key = "CUPTIRangeNode";
+  TVM_DECLARE_FINAL_OBJECT_INFO(CUPTIRangeNode, Object);
+};
+
+/*! \brief Profiler state of a single device. */
+struct CUPTIDeviceState {
+  /*! \brief The context kernels of this device are launched in. */
+  CUcontext ctx{nullptr};
+  /*! \brief Names of the reported metrics, the duration metric is last. */
+  std::vector<std::string> metric_names;
+  /*! \brief Evaluation requests, in the order of `metric_names`. */
+  std::vector<NVPW_MetricEvalRequest> requests;
+  /*! \brief Scratch buffer backing `evaluator`. */
+  std::vector<uint8_t> evaluator_scratch;
+  NVPW_MetricsEvaluator* evaluator{nullptr};
+  /*! \brief Counter configuration programmed into the device. */
+  std::vector<uint8_t> config_image;
+  /*! \brief Prefix used to initialize `counter_data`. */
+  std::vector<uint8_t> counter_data_prefix;
+  /*! \brief Counter values of every range in the current session. */
+  std::vector<uint8_t> counter_data;
+  std::vector<uint8_t> counter_data_scratch;
+  /*! \brief Number of calls in flight, the session is open while it is non zero. */
+  int depth{0};
+  /*! \brief Whether the range limit was hit in the current session. */
+  bool overflowed{false};
+};
+
+/*! \brief MetricCollectorNode for NVIDIA GPU metrics.
+ *
+ * The collector opens a CUPTI profiler session in kernel replay and auto range
+ * mode, so every kernel launch is recorded as its own range and replayed as
+ * many times as the requested metrics need. The values of a function call are
+ * aggregated over the kernels it launched: metrics that end in `.sum` are
+ * added up, all other metrics are averaged weighted by kernel duration.
+ */
+struct CUPTIMetricCollectorNode final : public MetricCollectorNode {
+  /*! \brief Construct a metric collector that collects a specific set of metrics.
+   *
+   * \param metrics A mapping from a device to the metrics that should be
+   * collected on that device. Metric names are those of Nsight Compute, for
+   * example `dram__throughput.avg.pct_of_peak_sustained_elapsed`.
+   */
+  explicit CUPTIMetricCollectorNode(Map<DeviceWrapper, Array<String>> metrics) {
+    for (auto& p : metrics) {
+      user_metric_names[p.first->device] = {};
+      for (auto& metric : p.second) {
+        user_metric_names[p.first->device].push_back(metric);
+      }
+    }
+  }
+
+  /*! \brief Initialization call.
+   * \param devices The devices this collector will be running on
+   */
+  void Init(Array<DeviceWrapper> devices) final {
+    for (auto wrapped_device : devices) {
+      Device device = wrapped_device->device;
+      if (device.device_type != kDLCUDA) {
+        continue;
+      }
+      bool use_defaults = user_metric_names.size() == 0;
+      auto it = user_metric_names.find(device);
+      if (!use_defaults && (it == user_metric_names.end() || it->second.size() == 0)) {
+        continue;
+      }
+      InitDevice(device, use_defaults ? default_metric_names : it->second, use_defaults);
+    }
+  }
+
+  /*! \brief Called right before a function call. Remembers which range the
+   * first kernel of the call will be recorded in.
+   *
+   * \param dev The device the function will be run on.
+   * \returns A `CUPTIRangeNode` passed to the corresponding `Stop` call.
+   */
+  ObjectRef Start(Device dev) final {
+    auto it = states.find(dev);
+    if (it == states.end()) {
+      return ObjectRef(nullptr);
+    }
+    CUPTIDeviceState& state = it->second;
+    size_t first_range = 0;
+    if (state.depth == 0) {
+      BeginSession(&state);
+    } else {
+      first_range = FlushRanges(dev, &state);
+      SetProfilingEnabled(&state, true);
+    }
+    state.depth++;
+    return ObjectRef(make_object<CUPTIRangeNode>(first_range, dev));
+  }
+
+  /*! \brief Called right after a function call. Evaluates the metrics of all
+   * kernels launched since the corresponding `Start` call.
+   *
+   * \param obj `CUPTIRangeNode` created by a call to `Start`.
+   * \returns A mapping from metric name to value.
+   */
+  Map<String, ObjectRef> Stop(ObjectRef obj) final {
+    const CUPTIRangeNode* range = obj.as<CUPTIRangeNode>();
+    CUPTIDeviceState& state = states.at(range->dev);
+    size_t end_range = FlushRanges(range->dev, &state);
+    std::unordered_map<String, ObjectRef> reported_metrics = Evaluate(state, range->first_range,
+                                                                      end_range);
+    state.depth--;
+    if (state.depth == 0) {
+      EndSession(&state);
+    } else {
+      SetProfilingEnabled(&state, true);
+    }
+    return reported_metrics;
+  }
+
+  ~CUPTIMetricCollectorNode() final {
+    for (auto& p : states) {
+      if (p.second.depth > 0) {
+        EndSession(&p.second);
+      }
+      if (p.second.evaluator != nullptr) {
+        NVPW_MetricsEvaluator_Destroy_Params params = {
+            NVPW_MetricsEvaluator_Destroy_Params_STRUCT_SIZE};
+        params.pMetricsEvaluator = p.second.evaluator;
+        NVPW_MetricsEvaluator_Destroy(&params);
+      }
+    }
+  }
+
+  /*! \brief Metric names requested by the user for each device. */
+  std::unordered_map<Device, std::vector<std::string>> user_metric_names;
+  /*! \brief Profiler state of each device that has metrics to collect. */
+  std::unordered_map<Device, CUPTIDeviceState> states;
+
+  static constexpr const char* _type_key = "runtime.profiling.CUPTIMetricCollector";
+  TVM_DECLARE_FINAL_OBJECT_INFO(CUPTIMetricCollectorNode, MetricCollectorNode);
+
+ private:
+  /*! \brief Build the counter configuration for `metric_names` on `dev`.
+   * \param skip_unsupported Drop metrics the chip does not support instead of failing.
+   */
+  void InitDevice(Device dev, const std::vector<std::string>& metric_names,
+                  bool skip_unsupported) {
+    static bool initialized = [] {
+      CUpti_Profiler_Initialize_Params profiler_params = {
+          CUpti_Profiler_Initialize_Params_STRUCT_SIZE};
+      CUPTI_CALL(cuptiProfilerInitialize(&profiler_params));
+      NVPW_InitializeHost_Params host_params = {NVPW_InitializeHost_Params_STRUCT_SIZE};
+      NVPW_CALL(NVPW_InitializeHost(&host_params));
+      return true;
+    }();
+    (void)initialized;
+
+    CUPTIDeviceState& state = states[dev];
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    // make sure the primary context TVM launches kernels in exists.
+    CUDA_CALL(cudaFree(nullptr));
+    CUDA_DRIVER_CALL(cuCtxGetCurrent(&state.ctx));
+
+    CUpti_Device_GetChipName_Params chip_params = {CUpti_Device_GetChipName_Params_STRUCT_SIZE};
+    chip_params.deviceIndex = dev.device_id;
+    CUPTI_CALL(cuptiDeviceGetChipName(&chip_params));
+    std::string chip_name = chip_params.pChipName;
+
+    CUpti_Profiler_GetCounterAvailability_Params avail_params = {
+        CUpti_Profiler_GetCounterAvailability_Params_STRUCT_SIZE};
+    avail_params.ctx = state.ctx;
+    CUPTI_CALL(cuptiProfilerGetCounterAvailability(&avail_params));
+    std::vector<uint8_t> availability(avail_params.counterAvailabilityImageSize);
+    avail_params.pCounterAvailabilityImage = availability.data();
+    CUPTI_CALL(cuptiProfilerGetCounterAvailability(&avail_params));
+
+    NVPW_CUDA_MetricsEvaluator_CalculateScratchBufferSize_Params scratch_params = {
+        NVPW_CUDA_MetricsEvaluator_CalculateScratchBufferSize_Params_STRUCT_SIZE};
+    scratch_params.pChipName = chip_name.c_str();
+    scratch_params.pCounterAvailabilityImage = availability.data();
+    NVPW_CALL(NVPW_CUDA_MetricsEvaluator_CalculateScratchBufferSize(&scratch_params));
+    state.evaluator_scratch.resize(scratch_params.scratchBufferSize);
+    NVPW_CUDA_MetricsEvaluator_Initialize_Params evaluator_params = {
+        NVPW_CUDA_MetricsEvaluator_Initialize_Params_STRUCT_SIZE};
+    evaluator_params.scratchBufferSize = state.evaluator_scratch.size();
+    evaluator_params.pScratchBuffer = state.evaluator_scratch.data();
+    evaluator_params.pChipName = chip_name.c_str();
+    evaluator_params.pCounterAvailabilityImage = availability.data();
+    NVPW_CALL(NVPW_CUDA_MetricsEvaluator_Initialize(&evaluator_params));
+    state.evaluator = evaluator_params.pMetricsEvaluator;
+
+    // Convert the metric names to evaluation requests and collect the raw
+    // counters they depend on.
+    std::vector<std::string> names = metric_names;
+    names.push_back(kDurationMetric);
+    std::vector<std::string> raw_names;
+    for (const std::string& name : names) {
+      NVPW_MetricEvalRequest request;
+      NVPW_MetricsEvaluator_ConvertMetricNameToMetricEvalRequest_Params convert_params = {
+          NVPW_MetricsEvaluator_ConvertMetricNameToMetricEvalRequest_Params_STRUCT_SIZE};
+      convert_params.pMetricsEvaluator = state.evaluator;
+      convert_params.pMetricName = name.c_str();
+      convert_params.pMetricEvalRequest = &request;
+      convert_params.metricEvalRequestStructSize = NVPW_MetricEvalRequest_STRUCT_SIZE;
+      if (NVPW_MetricsEvaluator_ConvertMetricNameToMetricEvalRequest(&convert_params) !=
+          NVPA_STATUS_SUCCESS) {
+        if (skip_unsupported) {
+          LOG(WARNING) << "CUPTI metric " << name << " is not supported on " << chip_name
+                       << ", skipping it.";
+          continue;
+        }
+        LOG(FATAL) << "CUPTI metric " << name << " is not supported on " << chip_name
+                   << ". You can list the available metrics with `ncu --query-metrics`.";
+      }
+
+      NVPW_MetricsEvaluator_GetMetricRawDependencies_Params deps_params = {
+          NVPW_MetricsEvaluator_GetMetricRawDependencies_Params_STRUCT_SIZE};
+      deps_params.pMetricsEvaluator = state.evaluator;
+      deps_params.pMetricEvalRequests = &request;
+      deps_params.numMetricEvalRequests = 1;
+      deps_params.metricEvalRequestStructSize = NVPW_MetricEvalRequest_STRUCT_SIZE;
+      deps_params.metricEvalRequestStrideSize = sizeof(NVPW_MetricEvalRequest);
+      NVPW_CALL(NVPW_MetricsEvaluator_GetMetricRawDependencies(&deps_params));
+      std::vector<const char*> deps(deps_params.numRawDependencies);
+      deps_params.ppRawDependencies = deps.data();
+      NVPW_CALL(NVPW_MetricsEvaluator_GetMetricRawDependencies(&deps_params));
+      raw_names.insert(raw_names.end(), deps.begin(), deps.end());
+
+      state.metric_names.push_back(name);
+      state.requests.push_back(request);
+    }
+    ICHECK_EQ(state.metric_names.back(), kDurationMetric)
+        << "CUPTI cannot measure kernel durations on " << chip_name;
+
+    std::vector<NVPA_RawMetricRequest> raw_requests;
+    for (const std::string& raw_name : raw_names) {
+      NVPA_RawMetricRequest raw_request = {NVPA_RAW_METRIC_REQUEST_STRUCT_SIZE};
+      raw_request.pMetricName = raw_name.c_str();
+      raw_request.isolated = true;
+      raw_request.keepInstances = true;
+      raw_requests.push_back(raw_request);
+    }
+
+    // Configuration image, programmed into the device when a session begins.
+    NVPW_CUDA_RawMetricsConfig_Create_V2_Params config_params = {
+        NVPW_CUDA_RawMetricsConfig_Create_V2_Params_STRUCT_SIZE};
+    config_params.activityKind = NVPA_ACTIVITY_KIND_PROFILER;
+    config_params.pChipName = chip_name.c_str();
+    config_params.pCounterAvailabilityImage = availability.data();
+    NVPW_CALL(NVPW_CUDA_RawMetricsConfig_Create_V2(&config_params));
+    NVPA_RawMetricsConfig* config = config_params.pRawMetricsConfig;
+    NVPW_RawMetricsConfig_BeginPassGroup_Params begin_params = {
+        NVPW_RawMetricsConfig_BeginPassGroup_Params_STRUCT_SIZE};
+    begin_params.pRawMetricsConfig = config;
+    NVPW_CALL(NVPW_RawMetricsConfig_BeginPassGroup(&begin_params));
+    NVPW_RawMetricsConfig_AddMetrics_Params add_params = {
+        NVPW_RawMetricsConfig_AddMetrics_Params_STRUCT_SIZE};
+    add_params.pRawMetricsConfig = config;
+    add_params.pRawMetricRequests = raw_requests.data();
+    add_params.numMetricRequests = raw_requests.size();
+    NVPW_CALL(NVPW_RawMetricsConfig_AddMetrics(&add_params));
+    NVPW_RawMetricsConfig_EndPassGroup_Params end_params = {
+        NVPW_RawMetricsConfig_EndPassGroup_Params_STRUCT_SIZE};
+    end_params.pRawMetricsConfig = config;
+    NVPW_CALL(NVPW_RawMetricsConfig_EndPassGroup(&end_params));
+    NVPW_RawMetricsConfig_GenerateConfigImage_Params generate_params = {
+        NVPW_RawMetricsConfig_GenerateConfigImage_Params_STRUCT_SIZE};
+    generate_params.pRawMetricsConfig = config;
+    NVPW_CALL(NVPW_RawMetricsConfig_GenerateConfigImage(&generate_params));
+    NVPW_RawMetricsConfig_GetConfigImage_Params image_params = {
+        NVPW_RawMetricsConfig_GetConfigImage_Params_STRUCT_SIZE};
+    image_params.pRawMetricsConfig = config;
+    NVPW_CALL(NVPW_RawMetricsConfig_GetConfigImage(&image_params));
+    state.config_image.resize(image_params.bytesCopied);
+    image_params.bytesAllocated = state.config_image.size();
+    image_params.pBuffer = state.config_image.data();
+    NVPW_CALL(NVPW_RawMetricsConfig_GetConfigImage(&image_params));
+    NVPW_RawMetricsConfig_Destroy_Params config_destroy_params = {
+        NVPW_RawMetricsConfig_Destroy_Params_STRUCT_SIZE};
+    config_destroy_params.pRawMetricsConfig = config;
+    NVPW_CALL(NVPW_RawMetricsConfig_Destroy(&config_destroy_params));
+
+    // Counter data prefix, describes the layout of the recorded counters.
+    NVPW_CUDA_CounterDataBuilder_Create_Params builder_params = {
+        NVPW_CUDA_CounterDataBuilder_Create_Params_STRUCT_SIZE};
+    builder_params.pChipName = chip_name.c_str();
+    builder_params.pCounterAvailabilityImage = availability.data();
+    NVPW_CALL(NVPW_CUDA_CounterDataBuilder_Create(&builder_params));
+    NVPW_CounterDataBuilder_AddMetrics_Params builder_add_params = {
+        NVPW_CounterDataBuilder_AddMetrics_Params_STRUCT_SIZE};
+    builder_add_params.pCounterDataBuilder = builder_params.pCounterDataBuilder;
+    builder_add_params.pRawMetricRequests = raw_requests.data();
+    builder_add_params.numMetricRequests = raw_requests.size();
+    NVPW_CALL(NVPW_CounterDataBuilder_AddMetrics(&builder_add_params));
+    NVPW_CounterDataBuilder_GetCounterDataPrefix_Params prefix_params = {
+        NVPW_CounterDataBuilder_GetCounterDataPrefix_Params_STRUCT_SIZE};
+    prefix_params.pCounterDataBuilder = builder_params.pCounterDataBuilder;
+    NVPW_CALL(NVPW_CounterDataBuilder_GetCounterDataPrefix(&prefix_params));
+    state.counter_data_prefix.resize(prefix_params.bytesCopied);
+    prefix_params.bytesAllocated = state.counter_data_prefix.size();
+    prefix_params.pBuffer = state.counter_data_prefix.data();
+    NVPW_CALL(NVPW_CounterDataBuilder_GetCounterDataPrefix(&prefix_params));
+    NVPW_CounterDataBuilder_Destroy_Params builder_destroy_params = {
+        NVPW_CounterDataBuilder_Destroy_Params_STRUCT_SIZE};
+    builder_destroy_params.pCounterDataBuilder = builder_params.pCounterDataBuilder;
+    NVPW_CALL(NVPW_CounterDataBuilder_Destroy(&builder_destroy_params));
+  }
+
+  /*! \brief Reset the counter data and start recording kernels. */
+  void BeginSession(CUPTIDeviceState* state) {
+    CUpti_Profiler_CounterDataImageOptions options;
+    options.pCounterDataPrefix = state->counter_data_prefix.data();
+    options.counterDataPrefixSize = state->counter_data_prefix.size();
+    options.maxNumRanges = kMaxRanges;
+    options.maxNumRangeTreeNodes = kMaxRanges;
+    options.maxRangeNameLength = 64;
+    CUpti_Profiler_CounterDataImage_CalculateSize_Params size_params = {
+        CUpti_Profiler_CounterDataImage_CalculateSize_Params_STRUCT_SIZE};
+    size_params.pOptions = &options;
+    size_params.sizeofCounterDataImageOptions = CUpti_Profiler_CounterDataImageOptions_STRUCT_SIZE;
+    CUPTI_CALL(cuptiProfilerCounterDataImageCalculateSize(&size_params));
+    state->counter_data.resize(size_params.counterDataImageSize);
+    CUpti_Profiler_CounterDataImage_Initialize_Params init_params = {
+        CUpti_Profiler_CounterDataImage_Initialize_Params_STRUCT_SIZE};
+    init_params.sizeofCounterDataImageOptions = CUpti_Profiler_CounterDataImageOptions_STRUCT_SIZE;
+    init_params.pOptions = &options;
+    init_params.counterDataImageSize = state->counter_data.size();
+    init_params.pCounterDataImage = state->counter_data.data();
+    CUPTI_CALL(cuptiProfilerCounterDataImageInitialize(&init_params));
+
+    CUpti_Profiler_CounterDataImage_CalculateScratchBufferSize_Params scratch_size_params = {
+        CUpti_Profiler_CounterDataImage_CalculateScratchBufferSize_Params_STRUCT_SIZE};
+    scratch_size_params.counterDataImageSize = state->counter_data.size();
+    scratch_size_params.pCounterDataImage = state->counter_data.data();
+    CUPTI_CALL(cuptiProfilerCounterDataImageCalculateScratchBufferSize(&scratch_size_params));
+    state->counter_data_scratch.resize(scratch_size_params.counterDataScratchBufferSize);
+    CUpti_Profiler_CounterDataImage_InitializeScratchBuffer_Params scratch_params = {
+        CUpti_Profiler_CounterDataImage_InitializeScratchBuffer_Params_STRUCT_SIZE};
+    scratch_params.counterDataImageSize = state->counter_data.size();
+    scratch_params.pCounterDataImage = state->counter_data.data();
+    scratch_params.counterDataScratchBufferSize = state->counter_data_scratch.size();
+    scratch_params.pCounterDataScratchBuffer = state->counter_data_scratch.data();
+    CUPTI_CALL(cuptiProfilerCounterDataImageInitializeScratchBuffer(&scratch_params));
+
+    // Every kernel launch becomes one range and is replayed until all of its
+    // counters have been collected.
+    CUpti_Profiler_BeginSession_Params session_params = {
+        CUpti_Profiler_BeginSession_Params_STRUCT_SIZE};
+    session_params.ctx = state->ctx;
+    session_params.counterDataImageSize = state->counter_data.size();
+    session_params.pCounterDataImage = state->counter_data.data();
+    session_params.counterDataScratchBufferSize = state->counter_data_scratch.size();
+    session_params.pCounterDataScratchBuffer = state->counter_data_scratch.data();
+    session_params.range = CUPTI_AutoRange;
+    session_params.replayMode = CUPTI_KernelReplay;
+    session_params.maxRangesPerPass = kMaxRanges;
+    session_params.maxLaunchesPerPass = kMaxRanges;
+    CUPTI_CALL(cuptiProfilerBeginSession(&session_params));
+
+    CUpti_Profiler_SetConfig_Params config_params = {CUpti_Profiler_SetConfig_Params_STRUCT_SIZE};
+    config_params.ctx = state->ctx;
+    config_params.pConfig = state->config_image.data();
+    config_params.configSize = state->config_image.size();
+    config_params.passIndex = 0;
+    CUPTI_CALL(cuptiProfilerSetConfig(&config_params));
+    state->overflowed = false;
+    SetProfilingEnabled(state, true);
+  }
+
+  /*! \brief Stop recording kernels and close the session. Profiling must be disabled. */
+  void EndSession(CUPTIDeviceState* state) {
+    CUpti_Profiler_UnsetConfig_Params unset_params = {
+        CUpti_Profiler_UnsetConfig_Params_STRUCT_SIZE};
+    unset_params.ctx = state->ctx;
+    CUPTI_CALL(cuptiProfilerUnsetConfig(&unset_params));
+    CUpti_Profiler_EndSession_Params end_params = {CUpti_Profiler_EndSession_Params_STRUCT_SIZE};
+    end_params.ctx = state->ctx;
+    CUPTI_CALL(cuptiProfilerEndSession(&end_params));
+    state->depth = 0;
+  }
+
+  void SetProfilingEnabled(CUPTIDeviceState* state, bool enabled) {
+    if (enabled) {
+      CUpti_Profiler_EnableProfiling_Params params = {
+          CUpti_Profiler_EnableProfiling_Params_STRUCT_SIZE};
+      params.ctx = state->ctx;
+      CUPTI_CALL(cuptiProfilerEnableProfiling(&params));
+    } else {
+      CUpti_Profiler_DisableProfiling_Params params = {
+          CUpti_Profiler_DisableProfiling_Params_STRUCT_SIZE};
+      params.ctx = state->ctx;
+      CUPTI_CALL(cuptiProfilerDisableProfiling(&params));
+    }
+  }
+
+  /*! \brief Wait for all launched kernels, disable profiling and decode the
+   * recorded ranges into the counter data.
+   * \returns The number of ranges recorded so far in the session.
+   */
+  size_t FlushRanges(Device dev, CUPTIDeviceState* state) {
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    CUDA_CALL(cudaDeviceSynchronize());
+    SetProfilingEnabled(state, false);
+    CUpti_Profiler_FlushCounterData_Params flush_params = {
+        CUpti_Profiler_FlushCounterData_Params_STRUCT_SIZE};
+    flush_params.ctx = state->ctx;
+    CUPTI_CALL(cuptiProfilerFlushCounterData(&flush_params));
+    NVPW_CounterData_GetNumRanges_Params ranges_params = {
+        NVPW_CounterData_GetNumRanges_Params_STRUCT_SIZE};
+    ranges_params.pCounterDataImage = state->counter_data.data();
+    NVPW_CALL(NVPW_CounterData_GetNumRanges(&ranges_params));
+    if (ranges_params.numRanges >= static_cast<size_t>(kMaxRanges) && !state->overflowed) {
+      LOG(WARNING) << "CUPTI recorded the maximum of " << kMaxRanges
+                   << " kernels, metrics of later kernels are dropped.";
+      state->overflowed = true;
+    }
+    return ranges_params.numRanges;
+  }
+
+  /*! \brief Aggregate the metrics of ranges [begin, end). */
+  std::unordered_map<String, ObjectRef> Evaluate(const CUPTIDeviceState& state, size_t begin,
+                                                 size_t end) {
+    size_t num_metrics = state.metric_names.size();
+    std::vector<double> sums(num_metrics, 0.0);
+    NVPW_MetricsEvaluator_SetDeviceAttributes_Params attr_params = {
+        NVPW_MetricsEvaluator_SetDeviceAttributes_Params_STRUCT_SIZE};
+    attr_params.pMetricsEvaluator = state.evaluator;
+    attr_params.pCounterDataImage = state.counter_data.data();
+    attr_params.counterDataImageSize = state.counter_data.size();
+    NVPW_CALL(NVPW_MetricsEvaluator_SetDeviceAttributes(&attr_params));
+    std::vector<double> values(num_metrics);
+    for (size_t range = begin; range < end; ++range) {
+      NVPW_MetricsEvaluator_EvaluateToGpuValues_Params eval_params = {
+          NVPW_MetricsEvaluator_EvaluateToGpuValues_Params_STRUCT_SIZE};
+      eval_params.pMetricsEvaluator = state.evaluator;
+      eval_params.pMetricEvalRequests = state.requests.data();
+      eval_params.numMetricEvalRequests = state.requests.size();
+      eval_params.metricEvalRequestStructSize = NVPW_MetricEvalRequest_STRUCT_SIZE;
+      eval_params.metricEvalRequestStrideSize = sizeof(NVPW_MetricEvalRequest);
+      eval_params.pCounterDataImage = state.counter_data.data();
+      eval_params.counterDataImageSize = state.counter_data.size();
+      eval_params.rangeIndex = range;
+      eval_params.isolated = true;
+      eval_params.pMetricValues = values.data();
+      NVPW_CALL(NVPW_MetricsEvaluator_EvaluateToGpuValues(&eval_params));
+      double duration = values[num_metrics - 1];
+      for (size_t i = 0; i < num_metrics; ++i) {
+        sums[i] += IsSum(state.metric_names[i]) ? values[i] : values[i] * duration;
+      }
+    }
+
+    std::unordered_map<String, ObjectRef> reported_metrics;
+    double total_duration = sums[num_metrics - 1];
+    // the duration metric only weights the others, the call is already timed.
+    for (size_t i = 0; i + 1 < num_metrics; ++i) {
+      const std::string& name = state.metric_names[i];
+      if (IsSum(name)) {
+        reported_metrics[name] = ObjectRef(make_object<CountNode>(static_cast<int64_t>(sums[i])));
+        continue;
+      }
+      double average = total_duration > 0 ? sums[i] / total_duration : 0;
+      if (name.find("pct") != std::string::npos) {
+        reported_metrics[name] = ObjectRef(make_object<PercentNode>(average));
+      } else {
+        reported_metrics[name] = ObjectRef(make_object<RatioNode>(average));
+      }
+    }
+    return reported_metrics;
+  }
+
+  static bool IsSum(const std::string& name) {
+    return name.size() >= 4 && name.compare(name.size() - 4, 4, ".sum") == 0;
+  }
+};
+
+/*! \brief Wrapper for `CUPTIMetricCollectorNode`. */
+class CUPTIMetricCollector : public MetricCollector {
+ public:
+  explicit CUPTIMetricCollector(Map<DeviceWrapper, Array<String>> metrics) {
+    data_ = make_object<CUPTIMetricCollectorNode>(metrics);
+  }
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(CUPTIMetricCollector, MetricCollector,
+                                        CUPTIMetricCollectorNode);
+};
+
+MetricCollector CreateCUPTIMetricCollector(Map<DeviceWrapper, Array<String>> metrics) {
+  return CUPTIMetricCollector(metrics);
+}
+
+TVM_REGISTER_OBJECT_TYPE(CUPTIRangeNode);
+TVM_REGISTER_OBJECT_TYPE(CUPTIMetricCollectorNode);
+
+TVM_REGISTER_GLOBAL("runtime.profiling.CUPTIMetricCollector")
+    .set_body_typed([](Map<DeviceWrapper, Array<String>> metrics) {
+      return CUPTIMetricCollector(metrics);
+    });
+
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
@@ -26,6 +26,7 @@
 #include <tvm/runtime/registry.h>
 
 #include <cstddef>
+#include <mutex>
 #include <regex>
 #include <string>
 #include <vector>
@@ -74,7 +75,16 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
   /* Thread safe implementation of Run. Keep runtime instance immutable */
   void Run(const TVMArgs& args) const {
     auto arg_data_provider = makeIODataProvider(args);
-    auto mem_solver = tensor_registry_.MakeSolver(arg_data_provider);
+    // Reuse the intermediate buffers of a previous run, which is not running concurrently
+    std::vector<dnnl::memory> tmp_mems;
+    {
+      std::lock_guard<std::mutex> lock(tmp_mem_pool_mutex_);
+      if (!tmp_mem_pool_.empty()) {
+        tmp_mems = std::move(tmp_mem_pool_.back());
+        tmp_mem_pool_.pop_back();
+      }
+    }
+    auto mem_solver = tensor_registry_.MakeSolver(arg_data_provider, &tmp_mems);
     // Execute primitives one by one
     for (const auto& act : net_) {
       auto prim = std::get<0>(act);
@@ -96,6 +106,8 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
 
       prim.execute(stream_, mem_args);
     }
+    std::lock_guard<std::mutex> lock(tmp_mem_pool_mutex_);
+    tmp_mem_pool_.push_back(std::move(tmp_mems));
   }
 
   /* Override GetFunction to reimplement Run method */
@@ -921,6 +933,10 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
   TensorRegistry::ActionQue net_;
   /* Storage for all memory objects */
   TensorRegistry tensor_registry_;
+  /* Intermediate buffers and scratchpad of the previous runs, one set per concurrent run */
+  mutable std::vector<std::vector<dnnl::memory>> tmp_mem_pool_;
+  /* Mutex of tmp_mem_pool_ */
+  mutable std::mutex tmp_mem_pool_mutex_;
   /* Generator of new unique eid which doesn't match with existing data entry */
   uint32_t next_unique_eid_offset_;
   /* Map of Run arg idx to corresponding eid */
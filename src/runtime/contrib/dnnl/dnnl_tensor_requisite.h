@@ -540,7 +540,7 @@ class TensorRegistry {
    */
   ArgId Register(const TensorRequisite& tr, ActionQue* action) {
     // 1) Constant tensor. Direct reference
-    if (auto const_data = tr.GetConstData()) {
+    if (auto const_data = GetPackedConstData(tr)) {
       auto idx = const_mem_collection_.size();
       const_mem_collection_.push_back(const_data);
       return MakeArgReq(ArgReqFlag::CONST, static_cast<uint32_t>(idx));
@@ -596,11 +596,14 @@ class TensorRegistry {
   /*!
    * \brief Construct memory solver for all registered TRs.
    * \param ext_provider callback to resolve external IO buffers
+   * \param tmp_mems intermediate buffers and scratchpad to use. Allocated if empty, and can be
+   *                 passed to the next solvers to reuse them, when not used concurrently.
    * \return memory solver object to match ArgId to dnnl::memory objects
    */
-  MemSolver MakeSolver(const DLTensorProvider& ext_provider) const {
+  MemSolver MakeSolver(const DLTensorProvider& ext_provider,
+                       std::vector<dnnl::memory>* tmp_mems) const {
     return MemSolverImpl(eng_, ext_provider, const_mem_collection_, ext_mem_collection_,
-                         tmp_mem_collection_, tmp_mem_mapping_);
+                         tmp_mem_collection_, tmp_mem_mapping_, tmp_mems);
   }
 
   void MarkInplace(const TensorRequisite& tr, const TensorRequisite& shared) {
@@ -612,6 +615,32 @@ class TensorRegistry {
   }
 
  private:
+  /*!
+   * \brief Get the data of a constant TR, packed into its layout when it is registered.
+   *
+   * Same as tr.GetConstData(), but a constant requested in the same layout by several primitives
+   * is reordered only once, and shares the packed buffer.
+   */
+  dnnl::memory GetPackedConstData(const TensorRequisite& tr) {
+    if (tr.mem_) return tr.mem_;
+    if (!tr.orig_) return {};
+
+    auto orig_const_data = GetPackedConstData(*tr.orig_);
+    if (!orig_const_data) return {};
+    if (tr.reinterpret_) {
+      return {tr.t_desc_, eng_, orig_const_data.get_data_handle()};
+    }
+    auto key = std::make_pair(orig_const_data.get_data_handle(), orig_const_data.get_desc());
+    for (const auto& kvp : packed_const_mems_) {
+      if (kvp.first == key && kvp.second.get_desc() == tr.t_desc_) return kvp.second;
+    }
+    auto res = dnnl::memory{tr.t_desc_, eng_};
+    dnnl::reorder(orig_const_data, res).execute(stream_, orig_const_data, res);
+    stream_.wait();
+    packed_const_mems_.push_back({key, res});
+    return res;
+  }
+
   ArgId RegisterReinterpret(ArgId src_ar, const dnnl::memory::desc& desc) {
     switch (src_ar.flag_) {
       case TMP_STORAGE: {
@@ -661,24 +690,29 @@ class TensorRegistry {
                   const std::vector<dnnl::memory>& const_mems,
                   const std::vector<std::pair<uint32_t, dnnl::memory::desc>>& ext_mems,
                   const std::vector<dnnl::memory::desc>& tmp_mem_descs,
-                  const std::map<size_t, size_t>& tmp_mem_mapping)
+                  const std::map<size_t, size_t>& tmp_mem_mapping,
+                  std::vector<dnnl::memory>* tmp_mems)
         : eng_(eng),
           ext_data_provider_(ext_data_provider),
           const_mems_(const_mems),
           ext_mems_(ext_mems) {
-      // Construct temp memory objects on the fly. While we have no scratchpads
+      // Construct temp memory objects on the first use. While we have no scratchpads
       // support on VM/GraphExecutor level.
-      tmp_mems_.resize(tmp_mem_descs.size());
-      for (size_t i = 0; i < tmp_mem_descs.size(); i++) {
-        auto found = tmp_mem_mapping.find(i);
-
-        if (found != tmp_mem_mapping.end()) {
-          auto reuse_hdl = tmp_mems_[found->second].get_data_handle();
-          tmp_mems_[i] = dnnl::memory(tmp_mem_descs[i], eng_, reuse_hdl);
-        } else {
-          tmp_mems_[i] = dnnl::memory(tmp_mem_descs[i], eng_);
+      if (tmp_mems->empty()) {
+        tmp_mems->resize(tmp_mem_descs.size());
+        for (size_t i = 0; i < tmp_mem_descs.size(); i++) {
+          auto found = tmp_mem_mapping.find(i);
+
+          if (found != tmp_mem_mapping.end()) {
+            auto reuse_hdl = (*tmp_mems)[found->second].get_data_handle();
+            (*tmp_mems)[i] = dnnl::memory(tmp_mem_descs[i], eng_, reuse_hdl);
+          } else {
+            (*tmp_mems)[i] = dnnl::memory(tmp_mem_descs[i], eng_);
+          }
         }
       }
+      ICHECK_EQ(tmp_mems->size(), tmp_mem_descs.size());
+      tmp_mems_ = *tmp_mems;
     }
 
     /*! \brief Find memory object associated with provided ArgId */
@@ -714,6 +748,11 @@ class TensorRegistry {
   /* Collection of const memory objects. */
   std::vector<dnnl::memory> const_mem_collection_;
 
+  /* Constants packed into another layout.
+   *  first  - data handle and desc of the original constant
+   *  second - packed memory object */
+  std::vector<std::pair<std::pair<void*, dnnl::memory::desc>, dnnl::memory>> packed_const_mems_;
+
   /* Collection of intermediate memory descriptors. Zero position is reserved for scratchpads. */
   std::vector<dnnl::memory::desc> tmp_mem_collection_;
 
@@ -104,10 +104,19 @@ void CreateBuffers(dl::ProcMemAllocator* proc_mem_alloc,
   }
 }
 
-bool Inference(tvm::runtime::TVMArgs args, dl::ProcMemAllocator* proc_mem_alloc, dl::Network* npu,
-               const std::vector<uint32_t>& input_order, const std::vector<uint32_t>& output_order,
-               const std::vector<uint32_t>& input_sizes,
-               const std::vector<uint32_t>& output_sizes) {
+/*! \brief An inference scheduled on the NPU, with the buffers it uses. */
+struct ScheduledInference {
+  std::vector<std::shared_ptr<dl::Buffer>> ifm;
+  std::vector<std::shared_ptr<dl::Buffer>> ofm;
+  std::vector<DLTensor*> outputs;
+  std::unique_ptr<dl::Inference> inference;
+};
+
+PackedFunc ScheduleInference(tvm::runtime::TVMArgs args, dl::ProcMemAllocator* proc_mem_alloc,
+                             dl::Network* npu, const std::vector<uint32_t>& input_order,
+                             const std::vector<uint32_t>& output_order,
+                             const std::vector<uint32_t>& input_sizes,
+                             const std::vector<uint32_t>& output_sizes) {
   // Unpack parameters
   size_t n_inputs = input_order.size();
   size_t n_outputs = output_order.size();
@@ -115,50 +124,61 @@ bool Inference(tvm::runtime::TVMArgs args, dl::ProcMemAllocator* proc_mem_alloc,
   for (size_t i = 0; i < n_inputs; i++) {
     inputs[i] = args[input_order[i]];
   }
-  std::vector<DLTensor*> outputs(n_outputs);
+  auto scheduled = std::make_shared<ScheduledInference>();
+  scheduled->outputs.resize(n_outputs);
   size_t output_offset = n_inputs;
   for (size_t i = 0; i < n_outputs; i++) {
-    outputs[i] = args[output_order[i] + output_offset];
+    scheduled->outputs[i] = args[output_order[i] + output_offset];
   }
 
-  // Set up input buffers
-  std::vector<std::shared_ptr<dl::Buffer>> ifm(n_inputs);
-  CreateBuffers(proc_mem_alloc, &ifm, inputs, input_sizes, true);
+  // Set up input buffers, the inputs are copied to them
+  scheduled->ifm.resize(n_inputs);
+  CreateBuffers(proc_mem_alloc, &scheduled->ifm, inputs, input_sizes, true);
 
   // Set up output buffers
-  std::vector<std::shared_ptr<dl::Buffer>> ofm(n_outputs);
-  CreateBuffers(proc_mem_alloc, &ofm, outputs, output_sizes, false);
+  scheduled->ofm.resize(n_outputs);
+  CreateBuffers(proc_mem_alloc, &scheduled->ofm, scheduled->outputs, output_sizes, false);
 
   // Raw pointers for the inference
-  dl::Buffer* ifm_raw[n_inputs];
+  std::vector<dl::Buffer*> ifm_raw(n_inputs);
   for (size_t i = 0; i < n_inputs; i++) {
-    ifm_raw[i] = ifm[i].get();
+    ifm_raw[i] = scheduled->ifm[i].get();
   }
-  dl::Buffer* ofm_raw[n_outputs];
+  std::vector<dl::Buffer*> ofm_raw(n_outputs);
   for (size_t i = 0; i < n_outputs; i++) {
-    ofm_raw[i] = ofm[i].get();
+    ofm_raw[i] = scheduled->ofm[i].get();
   }
 
-  // Execute the inference.
-  std::unique_ptr<dl::Inference> inference(
-      npu->ScheduleInference(ifm_raw, n_inputs, ofm_raw, n_outputs));
-  InferenceWaitStatus result = WaitForInference(inference.get(), 60);
+  // Schedule the inference, it runs while the host does other work.
+  scheduled->inference.reset(
+      npu->ScheduleInference(ifm_raw.data(), n_inputs, ofm_raw.data(), n_outputs));
 
-  if (result.GetErrorCode() != InferenceWaitErrorCode::kSuccess) {
-    LOG(FATAL) << "An error has occured waiting for the inference of a sub-graph on the NPU: "
-               << result.GetErrorDescription();
-  }
+  return PackedFunc([scheduled](TVMArgs, TVMRetValue*) {
+    InferenceWaitStatus result = WaitForInference(scheduled->inference.get(), 60);
 
-  for (size_t i = 0; i < n_outputs; i++) {
-    DLTensor* tensor = outputs[i];
-    dl::Buffer* source_buffer = ofm_raw[i];
-    uint8_t* dest_buffer = static_cast<uint8_t*>(tensor->data);
-    size_t size = source_buffer->GetSize();
-    uint8_t* source_buffer_data = source_buffer->Map();
-    std::copy(source_buffer_data, source_buffer_data + size, dest_buffer);
-    source_buffer->Unmap();
-  }
+    if (result.GetErrorCode() != InferenceWaitErrorCode::kSuccess) {
+      LOG(FATAL) << "An error has occured waiting for the inference of a sub-graph on the NPU: "
+                 << result.GetErrorDescription();
+    }
 
+    for (size_t i = 0; i < scheduled->outputs.size(); i++) {
+      DLTensor* tensor = scheduled->outputs[i];
+      dl::Buffer* source_buffer = scheduled->ofm[i].get();
+      uint8_t* dest_buffer = static_cast<uint8_t*>(tensor->data);
+      size_t size = source_buffer->GetSize();
+      uint8_t* source_buffer_data = source_buffer->Map();
+      std::copy(source_buffer_data, source_buffer_data + size, dest_buffer);
+      source_buffer->Unmap();
+    }
+  });
+}
+
+bool Inference(tvm::runtime::TVMArgs args, dl::ProcMemAllocator* proc_mem_alloc, dl::Network* npu,
+               const std::vector<uint32_t>& input_order, const std::vector<uint32_t>& output_order,
+               const std::vector<uint32_t>& input_sizes,
+               const std::vector<uint32_t>& output_sizes) {
+  ScheduleInference(args, proc_mem_alloc, npu, input_order, output_order, input_sizes,
+                    output_sizes)();
   return true;
 }
 }  // namespace ethosn
@@ -215,6 +235,21 @@ bool Inference(tvm::runtime::TVMArgs args, dl::ProcMemAllocator* /*proc_mem_allo
   return rc;
 }
 
+// The mocked inference is done when the outputs are waited for
+PackedFunc ScheduleInference(tvm::runtime::TVMArgs args, dl::ProcMemAllocator* proc_mem_alloc,
+                             dl::Network* npu, const std::vector<uint32_t>& input_order,
+                             const std::vector<uint32_t>& output_order,
+                             const std::vector<uint32_t>& input_sizes,
+                             const std::vector<uint32_t>& output_sizes) {
+  std::vector<TVMValue> values(args.values, args.values + args.size());
+  std::vector<int> type_codes(args.type_codes, args.type_codes + args.size());
+  return PackedFunc([=](TVMArgs, TVMRetValue*) {
+    TVMArgs scheduled_args(values.data(), type_codes.data(), static_cast<int>(values.size()));
+    Inference(scheduled_args, proc_mem_alloc, npu, input_order, output_order, input_sizes,
+              output_sizes);
+  });
+}
+
 }  // namespace ethosn
 }  // namespace runtime
 }  // namespace tvm
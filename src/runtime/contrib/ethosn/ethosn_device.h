@@ -41,6 +41,17 @@ using tvm::runtime::TVMArgs;
 bool Inference(tvm::runtime::TVMArgs args, dl::ProcMemAllocator* proc_mem_alloc, dl::Network* npu,
                const std::vector<uint32_t>& input_order, const std::vector<uint32_t>& output_order,
                const std::vector<uint32_t>& input_sizes, const std::vector<uint32_t>& output_sizes);
+
+/*!
+ * \brief Schedule an inference on the NPU, without waiting for it.
+ * \return The function waiting for the inference, and copying its outputs to the output tensors
+ * of the arguments. The tensors must stay valid until it is called.
+ */
+PackedFunc ScheduleInference(tvm::runtime::TVMArgs args, dl::ProcMemAllocator* proc_mem_alloc,
+                             dl::Network* npu, const std::vector<uint32_t>& input_order,
+                             const std::vector<uint32_t>& output_order,
+                             const std::vector<uint32_t>& input_sizes,
+                             const std::vector<uint32_t>& output_sizes);
 }  // namespace ethosn
 }  // namespace runtime
 }  // namespace tvm
@@ -75,6 +75,15 @@ PackedFunc EthosnModule::GetFunction(const std::string& name,
                       network_map_[name].outputs, network_map_[name].input_sizes,
                       network_map_[name].output_sizes);
     });
+  } else if (name.rfind("__async_", 0) == 0 && network_map_.count(name.substr(8))) {
+    // Used by the graph executor to run the host nodes while the NPU runs
+    std::string network = name.substr(8);
+    return PackedFunc([sptr_to_self, this, network](TVMArgs args, TVMRetValue* rv) {
+      const OrderedCompiledNetwork& compiled = network_map_[network];
+      *rv = ScheduleInference(args, compiled.proc_mem_alloc.get(), compiled.runtime_cmm.get(),
+                              compiled.inputs, compiled.outputs, compiled.input_sizes,
+                              compiled.output_sizes);
+    });
   } else {
     return PackedFunc();
   }
@@ -25,10 +25,12 @@
 #ifndef TVM_RUNTIME_CONTRIB_JSON_JSON_RUNTIME_H_
 #define TVM_RUNTIME_CONTRIB_JSON_JSON_RUNTIME_H_
 
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/module.h>
 #include <tvm/runtime/ndarray.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -54,7 +56,13 @@ class JSONRuntimeBase : public ModuleNode {
     LoadGraph(graph_json_);
   }
 
-  ~JSONRuntimeBase() override = default;
+  ~JSONRuntimeBase() override {
+    for (const auto& buffer : staging_buffers_) {
+      if (buffer.data != nullptr) {
+        DeviceAPI::Get(buffer.device)->FreeDataSpace(buffer.device, buffer.data);
+      }
+    }
+  }
 
   const char* type_key() const override { return "json"; }  // May be overridden
 
@@ -69,6 +77,17 @@ class JSONRuntimeBase : public ModuleNode {
   /*! \brief Invoke the execution engine to inteprete a specific json runtime. */
   virtual void Run() = 0;
 
+  /*!
+   * \brief Get the alignment the external library requires of the input and output buffers, to
+   * read and write them in place.
+   *
+   * The graph executor allocates the storage of the arguments of the subgraph with this alignment.
+   * Arguments that are not aligned anyway are staged through aligned copies.
+   *
+   * \return The alignment in bytes, or 0 when any buffer can be used in place.
+   */
+  virtual size_t GetIOAlignment() const { return 0; }
+
   /*!
    * \brief Get a packed function.
    * \param name The name/symbol of the function.
@@ -90,6 +109,12 @@ class JSONRuntimeBase : public ModuleNode {
         this->SetInputOutputBuffers(args);
         // Execute the subgraph.
         this->Run();
+        this->CopyStagedOutputs();
+      });
+    } else if ("__io_alignment_" + this->symbol_name_ == name) {
+      // The alignment of the arguments, queried by the graph executor before allocating them.
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        *rv = static_cast<int64_t>(this->GetIOAlignment());
       });
     } else if ("__init_" + this->symbol_name_ == name) {
       // The function to initialize constant tensors.
@@ -152,12 +177,19 @@ class JSONRuntimeBase : public ModuleNode {
    * \brief Set up the input and output buffers by binding their DLTensor pointers to the
    * corresponding data entry.
    *
+   * The byte offset of the arguments is folded into their data pointer. The arguments that are not
+   * aligned as required by GetIOAlignment() are bound to aligned staging buffers instead, which
+   * are copied from the inputs here, and to the outputs by CopyStagedOutputs().
+   *
    * \param args The packed args.
    */
   void SetInputOutputBuffers(const TVMArgs& args) {
     ICHECK_EQ(args.size(), input_var_eid_.size() + outputs_.size())
         << "Found mismatch in the number of provided data entryies and required.";
 
+    const size_t alignment = GetIOAlignment();
+    io_tensors_.resize(args.size());
+    staged_outputs_.clear();
     for (size_t i = 0; i < static_cast<size_t>(args.size()); i++) {
       auto eid = i < input_var_eid_.size() ? input_var_eid_[i]
                                            : EntryID(outputs_[i - input_var_eid_.size()]);
@@ -172,9 +204,32 @@ class JSONRuntimeBase : public ModuleNode {
         arg = args[i].operator DLTensor*();
       }
 
-      // Assign input/output the NDArray pointers to data entry so that we can directly
-      // read/write host buffers.
-      data_entry_[eid] = arg;
+      if (arg->byte_offset == 0 && (alignment == 0 || IsAligned(arg->data, alignment))) {
+        // Assign input/output the NDArray pointers to data entry so that we can directly
+        // read/write host buffers.
+        data_entry_[eid] = arg;
+        continue;
+      }
+      DLTensor& tensor = io_tensors_[i];
+      tensor = *arg;
+      tensor.data = static_cast<char*>(arg->data) + arg->byte_offset;
+      tensor.byte_offset = 0;
+      if (alignment != 0 && !IsAligned(tensor.data, alignment)) {
+        tensor.data = GetStagingBuffer(i, tensor, alignment);
+        if (i < input_var_eid_.size()) {
+          NDArray::CopyFromTo(arg, &tensor);
+        } else {
+          staged_outputs_.emplace_back(&tensor, arg);
+        }
+      }
+      data_entry_[eid] = &tensor;
+    }
+  }
+
+  /*! \brief Copy the outputs bound to staging buffers to the output arguments. */
+  void CopyStagedOutputs() {
+    for (const auto& kv : staged_outputs_) {
+      NDArray::CopyFromTo(kv.first, const_cast<DLTensor*>(kv.second));
     }
   }
 
@@ -285,6 +340,46 @@ class JSONRuntimeBase : public ModuleNode {
   bool initialized_{false};
   /*! \brief Initializer mutex*/
   std::mutex initialize_mutex_;
+
+ private:
+  /*! \brief A buffer standing in an argument which is not aligned as required. */
+  struct StagingBuffer {
+    Device device;
+    void* data{nullptr};
+    size_t nbytes{0};
+  };
+
+  static bool IsAligned(const void* data, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(data) % alignment == 0;
+  }
+
+  /*! \brief Get the staging buffer of an argument, reusing the one of the previous calls. */
+  void* GetStagingBuffer(size_t arg_index, const DLTensor& tensor, size_t alignment) {
+    ICHECK(IsContiguous(tensor)) << "Cannot stage a non-contiguous argument of " << symbol_name_;
+    staging_buffers_.resize(io_tensors_.size());
+    StagingBuffer& buffer = staging_buffers_[arg_index];
+    size_t nbytes = GetDataSize(tensor);
+    if (buffer.data == nullptr || buffer.nbytes < nbytes ||
+        buffer.device.device_type != tensor.device.device_type ||
+        buffer.device.device_id != tensor.device.device_id) {
+      if (buffer.data != nullptr) {
+        DeviceAPI::Get(buffer.device)->FreeDataSpace(buffer.device, buffer.data);
+      }
+      buffer.device = tensor.device;
+      buffer.nbytes = nbytes;
+      buffer.data =
+          DeviceAPI::Get(tensor.device)->AllocDataSpace(tensor.device, nbytes, alignment,
+                                                        tensor.dtype);
+    }
+    return buffer.data;
+  }
+
+  /*! \brief The arguments bound to data entries with another data pointer. */
+  std::vector<DLTensor> io_tensors_;
+  /*! \brief The staging buffers, by argument index. */
+  std::vector<StagingBuffer> staging_buffers_;
+  /*! \brief The output staging tensors and output arguments of the current call. */
+  std::vector<std::pair<DLTensor*, const DLTensor*>> staged_outputs_;
 };
 
 }  // namespace json
@@ -0,0 +1,188 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file nccl.cc
+ * \brief NCCL implementation of the collectives between CUDA devices.
+ */
+#include <nccl.h>
+#include <tvm/runtime/data_type.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/registry.h>
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "../../cuda/cuda_common.h"
+
+namespace tvm {
+namespace contrib {
+
+using namespace runtime;
+
+#define NCCL_CALL(func)                                             \
+  {                                                                 \
+    ncclResult_t e = (func);                                        \
+    ICHECK(e == ncclSuccess) << "NCCL: " #func " failed with error: " \
+                             << ncclGetErrorString(e);              \
+  }
+
+/*! \brief Get the NCCL data type of the dtype. */
+ncclDataType_t GetNCCLDataType(DataType dtype) {
+  if (dtype == DataType::Float(32)) {
+    return ncclFloat32;
+  } else if (dtype == DataType::Float(16)) {
+    return ncclFloat16;
+  } else if (dtype == DataType::Float(64)) {
+    return ncclFloat64;
+  } else if (dtype == DataType::Int(32)) {
+    return ncclInt32;
+  } else if (dtype == DataType::Int(64)) {
+    return ncclInt64;
+  } else if (dtype == DataType::Int(8)) {
+    return ncclInt8;
+  } else if (dtype == DataType::UInt(8)) {
+    return ncclUint8;
+  }
+  LOG(FATAL) << "TypeError: NCCL doesn't support dtype " << dtype;
+}
+
+/*!
+ * \brief The communicators of the device meshes, created on their first collective.
+ *
+ * The lock is held during the collectives, as the communicators of a mesh must not be used by
+ * several threads at once.
+ */
+class NCCLCommunicatorPool {
+ public:
+  static NCCLCommunicatorPool* Global() {
+    static NCCLCommunicatorPool* inst = new NCCLCommunicatorPool();
+    return inst;
+  }
+
+  /*! \brief Get the communicators of the devices, one per device. */
+  const std::vector<ncclComm_t>& Get(const std::vector<int>& device_ids) {
+    auto it = comms_.find(device_ids);
+    if (it == comms_.end()) {
+      std::vector<ncclComm_t> comms(device_ids.size());
+      NCCL_CALL(ncclCommInitAll(comms.data(), comms.size(), device_ids.data()));
+      it = comms_.emplace(device_ids, std::move(comms)).first;
+    }
+    return it->second;
+  }
+
+  std::mutex mutex;
+
+ private:
+  std::map<std::vector<int>, std::vector<ncclComm_t>> comms_;
+};
+
+/*! \brief Get the device ids of the shards. */
+std::vector<int> GetDeviceIds(const TVMArgs& args, int begin, int num_shards) {
+  std::vector<int> device_ids;
+  for (int i = 0; i < num_shards; ++i) {
+    const DLTensor* shard = args[begin + i];
+    device_ids.push_back(shard->device.device_id);
+  }
+  return device_ids;
+}
+
+/*! \brief Get the address of the data of a shard. */
+inline char* GetData(const DLTensor* shard) {
+  return static_cast<char*>(shard->data) + shard->byte_offset;
+}
+
+TVM_REGISTER_GLOBAL("tvm.contrib.collective.nccl.allreduce")
+    .set_body([](TVMArgs args, TVMRetValue* ret) {
+      int num_shards = args.num_args / 2;
+      std::vector<int> device_ids = GetDeviceIds(args, 0, num_shards);
+      NCCLCommunicatorPool* pool = NCCLCommunicatorPool::Global();
+      std::lock_guard<std::mutex> lock(pool->mutex);
+      const std::vector<ncclComm_t>& comms = pool->Get(device_ids);
+      int current_device;
+      CUDA_CALL(cudaGetDevice(&current_device));
+      NCCL_CALL(ncclGroupStart());
+      for (int i = 0; i < num_shards; ++i) {
+        const DLTensor* input = args[i];
+        const DLTensor* output = args[num_shards + i];
+        size_t count = GetDataSize(*input) / DataType(input->dtype).bytes();
+        CUDA_CALL(cudaSetDevice(device_ids[i]));
+        NCCL_CALL(ncclAllReduce(GetData(input), GetData(output), count,
+                                GetNCCLDataType(DataType(input->dtype)), ncclSum, comms[i],
+                                nullptr));
+      }
+      NCCL_CALL(ncclGroupEnd());
+      CUDA_CALL(cudaSetDevice(current_device));
+    });
+
+TVM_REGISTER_GLOBAL("tvm.contrib.collective.nccl.allgather")
+    .set_body([](TVMArgs args, TVMRetValue* ret) {
+      int num_shards = (args.num_args - 1) / 2;
+      int axis = args[0];
+      std::vector<int> device_ids = GetDeviceIds(args, 1, num_shards);
+      const DLTensor* first = args[1];
+      axis = axis < 0 ? axis + first->ndim : axis;
+      int64_t outer = 1;
+      for (int i = 0; i < axis; ++i) {
+        outer *= first->shape[i];
+      }
+      size_t chunk = GetDataSize(*first) / outer;
+      size_t shard_bytes = GetDataSize(*first);
+
+      NCCLCommunicatorPool* pool = NCCLCommunicatorPool::Global();
+      std::lock_guard<std::mutex> lock(pool->mutex);
+      const std::vector<ncclComm_t>& comms = pool->Get(device_ids);
+      int current_device;
+      CUDA_CALL(cudaGetDevice(&current_device));
+      // NCCL concatenates the shards along the outermost axis, so the shards are gathered into
+      // a workspace first unless the axis is effectively the outermost one
+      std::vector<void*> workspaces(num_shards, nullptr);
+      NCCL_CALL(ncclGroupStart());
+      for (int i = 0; i < num_shards; ++i) {
+        const DLTensor* input = args[1 + i];
+        const DLTensor* output = args[1 + num_shards + i];
+        void* dst = GetData(output);
+        if (outer != 1) {
+          workspaces[i] = DeviceAPI::Get(output->device)
+                              ->AllocWorkspace(output->device, shard_bytes * num_shards);
+          dst = workspaces[i];
+        }
+        CUDA_CALL(cudaSetDevice(device_ids[i]));
+        NCCL_CALL(ncclAllGather(GetData(input), dst, shard_bytes, ncclUint8, comms[i], nullptr));
+      }
+      NCCL_CALL(ncclGroupEnd());
+      if (outer != 1) {
+        for (int i = 0; i < num_shards; ++i) {
+          const DLTensor* output = args[1 + num_shards + i];
+          CUDA_CALL(cudaSetDevice(device_ids[i]));
+          for (int s = 0; s < num_shards; ++s) {
+            // Rows of `chunk` bytes, from the gathered shard s to its columns in the output
+            CUDA_CALL(cudaMemcpy2DAsync(GetData(output) + s * chunk, chunk * num_shards,
+                                        static_cast<char*>(workspaces[i]) + s * shard_bytes,
+                                        chunk, chunk, outer, cudaMemcpyDeviceToDevice, nullptr));
+          }
+          DeviceAPI::Get(output->device)->FreeWorkspace(output->device, workspaces[i]);
+        }
+      }
+      CUDA_CALL(cudaSetDevice(current_device));
+    });
+
+}  // namespace contrib
+}  // namespace tvm
@@ -39,7 +39,11 @@ static const std::unordered_map<DLDeviceType, std::vector<std::string>> default_
     {kDLCPU,
      {"perf::CYCLES", "perf::STALLED-CYCLES-FRONTEND", "perf::STALLED-CYCLES-BACKEND",
       "perf::INSTRUCTIONS", "perf::CACHE-MISSES"}},
-    {kDLCUDA, {"cuda:::event:elapsed_cycles_sm:device=0"}}};
+    {kDLCUDA, {"cuda:::event:elapsed_cycles_sm:device=0"}},
+    {kDLROCM,
+     {"rocm:::GRBM_GUI_ACTIVE:device=0", "rocm:::SQ_WAVES:device=0",
+      "rocm:::SQ_INSTS_VALU:device=0", "rocm:::TCC_HIT_sum:device=0",
+      "rocm:::TCC_MISS_sum:device=0"}}};
 
 /*! \brief Object that holds the values of counters at the start of a function call. */
 struct PAPIEventSetNode : public Object {
@@ -19,7 +19,7 @@
 
 /*!
  * \file random/mt_random_engine.cc
- * \brief mt19937 random engine
+ * \brief mt19937 random engine, and the Philox counter-based generator of the fills
  */
 #include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/device_api.h>
@@ -37,6 +37,39 @@
 namespace tvm {
 namespace contrib {
 
+/*!
+ * \brief The Philox4x32-10 counter-based generator.
+ *
+ * Each counter gives four independent 32-bit values for a key, so that any part of a sequence is
+ * generated without the values before it.
+ * Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC 2011.
+ */
+struct Philox4x32 {
+  /*!
+   * \brief Generate the values of a counter.
+   * \param counter The counter.
+   * \param key The key.
+   * \param out The four values.
+   */
+  static void Generate(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]) {
+    uint32_t c[4] = {counter[0], counter[1], counter[2], counter[3]};
+    uint32_t k[2] = {key[0], key[1]};
+    for (int round = 0; round < 10; ++round) {
+      uint64_t p0 = static_cast<uint64_t>(0xD2511F53) * c[0];
+      uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57) * c[2];
+      uint32_t hi0 = static_cast<uint32_t>(p0 >> 32), lo0 = static_cast<uint32_t>(p0);
+      uint32_t hi1 = static_cast<uint32_t>(p1 >> 32), lo1 = static_cast<uint32_t>(p1);
+      c[0] = hi1 ^ c[1] ^ k[0];
+      c[1] = lo1;
+      c[2] = hi0 ^ c[3] ^ k[1];
+      c[3] = lo0;
+      k[0] += 0x9E3779B9;
+      k[1] += 0xBB67AE85;
+    }
+    std::copy(c, c + 4, out);
+  }
+};
+
 /*!
  * \brief An interface for generating [tensors of] random numbers.
  */
@@ -58,6 +91,7 @@ class RandomEngine {
   inline void Seed(unsigned seed) {
     rnd_engine_.seed(seed);
     this->rseed_ = static_cast<unsigned>(seed);
+    this->num_fills_ = 0;
   }
 
   /*!
@@ -143,51 +177,69 @@ class RandomEngine {
   }
 
  private:
-  void FillDataImpl(void* data, int64_t st, int64_t ed, DLDataType dtype) {
+  /*! \brief The number of elements filled by a Philox counter. */
+  static constexpr int64_t kFillBlock = 4;
+  /*! \brief The minimum number of elements filled by a task. */
+  static constexpr int64_t kFillGrain = 1 << 14;
+
+  /*!
+   * \brief Fill the elements [st, ed) of a fill with values of Unif(low, high).
+   *
+   * The element i is generated from the counter (i / kFillBlock, fill), whatever the split of the
+   * elements between the tasks.
+   */
+  template <typename T, typename F>
+  void FillRange(T* data, int64_t st, int64_t ed, uint64_t fill, double low, double high,
+                 F convert) const {
+    const uint32_t key[2] = {rseed_, 0x5EED};
+    uint32_t values[kFillBlock];
+    for (int64_t i = st; i < ed; ++i) {
+      if (i == st || i % kFillBlock == 0) {
+        uint64_t block = i / kFillBlock;
+        const uint32_t counter[4] = {
+            static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32),
+            static_cast<uint32_t>(fill), static_cast<uint32_t>(fill >> 32)};
+        Philox4x32::Generate(counter, key, values);
+      }
+      // The upper bound is excluded, as in std::uniform_real_distribution
+      double unit = values[i % kFillBlock] * (1.0 / 4294967296.0);
+      data[i] = convert(low + unit * (high - low));
+    }
+  }
+
+  void FillDataImpl(void* data, int64_t st, int64_t ed, DLDataType dtype, uint64_t fill) const {
     // Make the value be 1.0 - 10.0, not (0.0 - 1.0) so that we could satisfy
     // quantized dtype (uint8 / int8) data non-empty requirement
-    std::uniform_real_distribution<> dist(1.0, 10.0);
+    auto identity = [](double value) { return value; };
     // Use float representation could make us work well on float / int type too.
     if (dtype.bits == 1) {
-      std::generate_n(static_cast<bool*>(data) + st, ed - st, [&]() { return dist(rnd_engine_); });
+      FillRange(static_cast<bool*>(data), st, ed, fill, 1.0, 10.0, identity);
     } else if (dtype.bits == 4) {
       // For uint4/int4 we pack two values into a single byte.
       // Thus, to ensure both values are non-zero, we use a distribution of 17 - 30.
-      std::uniform_real_distribution<> packed_dist(17.0, 30.0);
-      std::generate_n(reinterpret_cast<uint8_t*>(data) + st, ed - st,
-                      [&]() { return packed_dist(rnd_engine_); });
+      FillRange(static_cast<uint8_t*>(data), st, ed, fill, 17.0, 30.0, identity);
     } else if (dtype.bits == 8) {
-      std::generate_n(static_cast<uint8_t*>(data) + st, ed - st,
-                      [&]() { return dist(rnd_engine_); });
+      FillRange(static_cast<uint8_t*>(data), st, ed, fill, 1.0, 10.0, identity);
     } else if (dtype.bits == 16) {
-      std::generate_n(static_cast<uint16_t*>(data) + st, ed - st, [&]() {
+      FillRange(static_cast<uint16_t*>(data), st, ed, fill, 1.0, 10.0, [](double value) {
         return __truncXfYf2__<float, uint32_t, 23, uint16_t, uint16_t, 10>(
-            static_cast<float>(dist(rnd_engine_)));
+            static_cast<float>(value));
       });
     } else if (dtype.bits == 32) {
-      std::generate_n(static_cast<float*>(data) + st, ed - st, [&]() { return dist(rnd_engine_); });
+      FillRange(static_cast<float*>(data), st, ed, fill, 1.0, 10.0, identity);
     } else if (dtype.bits == 64) {
-      std::generate_n(static_cast<double*>(data) + st, ed - st,
-                      [&]() { return dist(rnd_engine_); });
+      FillRange(static_cast<double*>(data), st, ed, fill, 1.0, 10.0, identity);
     } else {
       LOG(FATAL) << "Doesn't support dtype code " << dtype.code << " dtype bits " << dtype.bits;
     }
   }
 
-  void FillData(DLTensor* tensor) {
-    int64_t size = 1;
-    for (int i = 0; i < tensor->ndim; ++i) {
-      size *= tensor->shape[i];
-    }
-    DLDataType dtype = tensor->dtype;
-    if (dtype.bits == 1 || dtype.bits == 4 || dtype.bits == 8 || dtype.bits == 16 ||
-        dtype.bits == 32 || dtype.bits == 64) {
-      FillDataImpl(tensor->data, 0, size, dtype);
-    } else {
-      LOG(FATAL) << "Doesn't support dtype code " << dtype.code << " dtype bits " << dtype.bits;
-    }
-  }
+  void FillData(DLTensor* tensor) { FillDataForMeasure(tensor); }
 
+  /*!
+   * \brief Fill a tensor in parallel on the thread pool. The values only depend on the seed and
+   * on the number of fills done since the seeding, not on the number of threads.
+   */
   void FillDataForMeasure(DLTensor* tensor) {
     struct ParallelTask {
       static int RunTask(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
@@ -197,21 +249,25 @@ class RandomEngine {
       }
 
       void Run(int i, int num_tasks) {
-        int64_t chunk_size = size / num_tasks;
-        int64_t st = i * chunk_size;
-        int64_t ed = std::min(st + chunk_size, size);
-        self->FillDataImpl(data, st, ed, dtype);
+        // The chunks are whole blocks, and the last one ends the tensor
+        int64_t num_blocks = (size + kFillBlock - 1) / kFillBlock;
+        int64_t chunk_blocks = (num_blocks + num_tasks - 1) / num_tasks;
+        int64_t st = std::min(i * chunk_blocks * kFillBlock, size);
+        int64_t ed = std::min(st + chunk_blocks * kFillBlock, size);
+        self->FillDataImpl(data, st, ed, dtype, fill);
       }
 
-      RandomEngine* self;
+      const RandomEngine* self;
       void* data;
       int64_t size;
       DLDataType dtype;
+      uint64_t fill;
     };
 
     ParallelTask task;
     task.self = this;
     task.data = tensor->data;
+    task.fill = num_fills_++;
     DLDataType dtype = task.dtype = tensor->dtype;
     int64_t& size = task.size = 1;
     for (int i = 0; i < tensor->ndim; ++i) {
@@ -219,7 +275,14 @@ class RandomEngine {
     }
     if (dtype.bits == 1 || dtype.bits == 4 || dtype.bits == 8 || dtype.bits == 16 ||
         dtype.bits == 32 || dtype.bits == 64) {
-      int res = TVMBackendParallelLaunch(ParallelTask::RunTask, &task, 0);
+      int64_t num_tasks = std::min<int64_t>((size + kFillGrain - 1) / kFillGrain,
+                                            runtime::threading::MaxConcurrency());
+      if (num_tasks <= 1) {
+        FillDataImpl(task.data, 0, size, dtype, task.fill);
+        return;
+      }
+      int res =
+          TVMBackendParallelLaunch(ParallelTask::RunTask, &task, static_cast<int>(num_tasks));
       ICHECK_EQ(res, 0) << "RandomFillForMeasure: TVMBackendParallelLaunch failed";
     } else {
       LOG(FATAL) << "Doesn't support dtype code " << dtype.code << " dtype bits " << dtype.bits;
@@ -229,6 +292,8 @@ class RandomEngine {
  private:
   std::mt19937 rnd_engine_;
   unsigned rseed_;
+  /*! \brief The number of fills since the seeding, the stream of the Philox counters. */
+  uint64_t num_fills_{0};
 };
 
 }  // namespace contrib
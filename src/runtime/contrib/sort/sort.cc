@@ -22,9 +22,13 @@
  */
 
 #include <dlpack/dlpack.h>
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/registry.h>
 
 #include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "../../../../3rdparty/compiler-rt/builtin_fp16.h"
@@ -70,6 +74,123 @@ struct float16 {
   inline bool operator>=(const float16& rhs) const { return to_float() >= rhs.to_float(); }
 };
 
+/*! \brief The order preserving unsigned keys of the types sorted with a radix sort. */
+template <typename DType, typename = void>
+struct RadixKey {
+  static constexpr bool kSupported = false;
+};
+
+template <typename DType>
+struct RadixKey<DType, std::enable_if_t<std::is_integral_v<DType> && std::is_signed_v<DType>>> {
+  static constexpr bool kSupported = true;
+  using KeyType = std::make_unsigned_t<DType>;
+  static KeyType Encode(DType value) {
+    return static_cast<KeyType>(value) ^ (KeyType(1) << (sizeof(KeyType) * 8 - 1));
+  }
+};
+
+template <typename DType>
+struct RadixKey<DType, std::enable_if_t<std::is_floating_point_v<DType>>> {
+  static constexpr bool kSupported = sizeof(DType) == 4 || sizeof(DType) == 8;
+  using KeyType = std::conditional_t<sizeof(DType) == 4, uint32_t, uint64_t>;
+  static KeyType Encode(DType value) {
+    constexpr KeyType kSignBit = KeyType(1) << (sizeof(KeyType) * 8 - 1);
+    // -0.0 and 0.0 compare equal, so they must keep their order
+    if (value == 0) return kSignBit;
+    KeyType bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & kSignBit) ? ~bits : (bits | kSignBit);
+  }
+};
+
+/*!
+ * \brief Stable LSD radix sort of the (index, value) pairs of a row by value.
+ *
+ * The passes over a byte which is the same for all the keys are skipped. Descending order sorts
+ * the complemented keys, so that equal values keep their order as with std::stable_sort.
+ */
+template <typename DType>
+void RadixSortRow(std::vector<std::pair<int64_t, DType>>* sorter, bool is_ascend) {
+  using KeyType = typename RadixKey<DType>::KeyType;
+  const size_t n = sorter->size();
+  std::vector<KeyType> keys(n);
+  for (size_t i = 0; i < n; ++i) {
+    KeyType key = RadixKey<DType>::Encode((*sorter)[i].second);
+    keys[i] = is_ascend ? key : ~key;
+  }
+  std::vector<KeyType> sorted_keys(n);
+  std::vector<std::pair<int64_t, DType>> sorted(n);
+  for (size_t shift = 0; shift < sizeof(KeyType) * 8; shift += 8) {
+    size_t offsets[256] = {0};
+    for (size_t i = 0; i < n; ++i) {
+      ++offsets[(keys[i] >> shift) & 0xFF];
+    }
+    if (offsets[(keys[0] >> shift) & 0xFF] == n) continue;
+    size_t sum = 0;
+    for (size_t& offset : offsets) {
+      size_t count = offset;
+      offset = sum;
+      sum += count;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      size_t pos = offsets[(keys[i] >> shift) & 0xFF]++;
+      sorted_keys[pos] = keys[i];
+      sorted[pos] = (*sorter)[i];
+    }
+    keys.swap(sorted_keys);
+    sorter->swap(sorted);
+  }
+}
+
+/*! \brief Stable sort of the (index, value) pairs of a row by value. */
+template <typename DType>
+void SortRow(std::vector<std::pair<int64_t, DType>>* sorter, bool is_ascend) {
+  // Below this size, the passes of the radix sort cost more than the comparisons
+  constexpr size_t kMinRadixSortSize = 256;
+  if constexpr (RadixKey<DType>::kSupported) {
+    if (sorter->size() >= kMinRadixSortSize) {
+      RadixSortRow(sorter, is_ascend);
+      return;
+    }
+  }
+  if (is_ascend) {
+    std::stable_sort(sorter->begin(), sorter->end(), CompareAscend<DType>);
+  } else {
+    std::stable_sort(sorter->begin(), sorter->end(), CompareDescend<DType>);
+  }
+}
+
+/*!
+ * \brief Run a function over rows on the TVM thread pool, each task on a contiguous chunk.
+ * \param num_rows The number of rows.
+ * \param row_size The number of elements of a row. The small problems are run serially.
+ * \param fn The function, called with the begin and the end of each chunk of rows.
+ */
+template <typename F>
+void ParallelForRows(int64_t num_rows, int64_t row_size, const F& fn) {
+  constexpr int64_t kMinParallelElements = 1 << 14;
+  if (num_rows <= 1 || num_rows * row_size < kMinParallelElements) {
+    fn(0, num_rows);
+    return;
+  }
+  struct ParallelTask {
+    static int RunTask(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+      ParallelTask* task = static_cast<ParallelTask*>(cdata);
+      int64_t chunk_size = (task->num_rows + penv->num_task - 1) / penv->num_task;
+      int64_t begin = std::min(task_id * chunk_size, task->num_rows);
+      int64_t end = std::min(begin + chunk_size, task->num_rows);
+      if (begin < end) (*task->fn)(begin, end);
+      return 0;
+    }
+
+    const F* fn;
+    int64_t num_rows;
+  };
+  ParallelTask task{&fn, num_rows};
+  int res = TVMBackendParallelLaunch(ParallelTask::RunTask, &task, 0);
+  ICHECK_EQ(res, 0) << "Sort: TVMBackendParallelLaunch failed";
+}
+
 // Argsort implemented C library sort for nms.
 // Return indices of sorted tensor.
 // By default, the last axis will be used to sort.
@@ -87,7 +208,6 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.argsort_nms").set_body([](TVMArgs args, TV
   auto dtype = input->dtype;
   auto data_ptr = static_cast<float*>(input->data);
   auto sort_num_ptr = static_cast<int32_t*>(sort_num->data);
-  std::vector<std::pair<int32_t, float>> sorter;
   int64_t axis_mul_before = 1;
   int64_t axis_mul_after = 1;
 
@@ -114,8 +234,12 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.argsort_nms").set_body([](TVMArgs args, TV
     }
   }
 
-  for (int64_t i = 0; i < axis_mul_before; ++i) {
-    for (int64_t j = 0; j < axis_mul_after; ++j) {
+  ParallelForRows(axis_mul_before * axis_mul_after, input->shape[axis], [&](int64_t begin,
+                                                                           int64_t end) {
+    std::vector<std::pair<int64_t, float>> sorter;
+    for (int64_t row = begin; row < end; ++row) {
+      int64_t i = row / axis_mul_after;
+      int64_t j = row % axis_mul_after;
       sorter.clear();
       int32_t current_sort_num = *(sort_num_ptr + i * axis_mul_after + j);
       int64_t base_idx = i * input->shape[axis] * axis_mul_after + j;
@@ -123,33 +247,25 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.argsort_nms").set_body([](TVMArgs args, TV
         int64_t full_idx = base_idx + k * axis_mul_after;
         sorter.emplace_back(std::make_pair(k, *(data_ptr + full_idx)));
       }
-      if (is_ascend) {
 #if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-        if (dtype.bits == 16) {
+      if (dtype.bits == 16) {
+        if (is_ascend) {
           std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<__fp16>);
         } else {
-#endif
-          std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<float>);
-#if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
+          std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<__fp16>);
         }
-#endif
       } else {
-#if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-        if (dtype.bits == 16) {
-          std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<__fp16>);
-        } else {
 #endif
-          std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<float>);
+        SortRow(&sorter, is_ascend);
 #if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-        }
-#endif
       }
+#endif
       for (int32_t k = 0; k < input->shape[axis]; ++k) {
         *(static_cast<int32_t*>(output->data) + base_idx + k * axis_mul_after) =
-            k < static_cast<int32_t>(sorter.size()) ? sorter[k].first : k;
+            k < static_cast<int32_t>(sorter.size()) ? static_cast<int32_t>(sorter[k].first) : k;
       }
     }
-  }
+  });
 });
 
 template <typename DataType, typename OutType>
@@ -158,10 +274,9 @@ void sort_impl(
     std::function<void(OutType*, size_t, const std::pair<int64_t, DataType>&)> epilogue) {
   auto data_ptr = static_cast<DataType*>(input->data);
   auto out_ptr = static_cast<OutType*>(output->data);
-  std::vector<std::pair<int64_t, DataType>> sorter;
 
-  int axis_mul_before = 1;
-  int axis_mul_after = 1;
+  int64_t axis_mul_before = 1;
+  int64_t axis_mul_after = 1;
   for (int i = 0; i < input->ndim; ++i) {
     if (i < axis) {
       axis_mul_before *= input->shape[i];
@@ -170,24 +285,24 @@ void sort_impl(
     }
   }
 
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
+  ParallelForRows(axis_mul_before * axis_mul_after, input->shape[axis], [&](int64_t begin,
+                                                                           int64_t end) {
+    std::vector<std::pair<int64_t, DataType>> sorter;
+    for (int64_t row = begin; row < end; ++row) {
+      int64_t i = row / axis_mul_after;
+      int64_t j = row % axis_mul_after;
       sorter.clear();
       int64_t base_idx = i * input->shape[axis] * axis_mul_after + j;
       for (int64_t k = 0; k < input->shape[axis]; ++k) {
         int64_t full_idx = base_idx + k * axis_mul_after;
         sorter.emplace_back(std::make_pair(k, data_ptr[full_idx]));
       }
-      if (is_ascend) {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<DataType>);
-      } else {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<DataType>);
-      }
+      SortRow(&sorter, is_ascend);
       for (int64_t k = 0; k < input->shape[axis]; ++k) {
         epilogue(out_ptr, base_idx + k * axis_mul_after, sorter[k]);
       }
     }
-  }
+  });
 }
 
 template <typename DataType, typename OutType>
@@ -355,14 +470,8 @@ void topk(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, int k, i
   IndicesType* indices_ptr =
       (out_indices == nullptr) ? nullptr : static_cast<IndicesType*>(out_indices->data);
 
-  // Maintain a min/max containing the top-k elements
-  std::vector<std::pair<int64_t, DataType>> running_heap;
-
-  // Need +1 when inserting new element before maintaining heap invariant
-  running_heap.reserve(k + 1);
-
-  int axis_mul_before = 1;
-  int axis_mul_after = 1;
+  int64_t axis_mul_before = 1;
+  int64_t axis_mul_after = 1;
   for (int i = 0; i < input->ndim; ++i) {
     if (i < axis) {
       axis_mul_before *= input->shape[i];
@@ -370,66 +479,50 @@ void topk(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, int k, i
       axis_mul_after *= input->shape[i];
     }
   }
+  const int64_t axis_size = input->shape[axis];
   if (k < 1) {
-    k = input->shape[axis];
+    k = axis_size;
   }
 
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
-      running_heap.clear();
-      int64_t src_base_idx = i * input->shape[axis] * axis_mul_after + j;
+  // Select the top-k elements of each row, then only sort them. The comparisons break the ties by
+  // index, so that the order is total and the same as with a stable sort.
+  auto select_topk = [&](std::vector<std::pair<int64_t, DataType>>* sorter, auto compare) {
+    if (k < axis_size) {
+      std::nth_element(sorter->begin(), sorter->begin() + k, sorter->end(), compare);
+      sorter->resize(k);
+    }
+    std::sort(sorter->begin(), sorter->end(), compare);
+  };
+
+  ParallelForRows(axis_mul_before * axis_mul_after, axis_size, [&](int64_t begin, int64_t end) {
+    std::vector<std::pair<int64_t, DataType>> sorter;
+    for (int64_t row = begin; row < end; ++row) {
+      int64_t i = row / axis_mul_after;
+      int64_t j = row % axis_mul_after;
+      sorter.clear();
+      int64_t src_base_idx = i * axis_size * axis_mul_after + j;
       int64_t dst_base_idx = i * k * axis_mul_after + j;
-
-      // Start by creating min/max heap with fixed-k elements
-      int cur_axis_index = 0;
-      for (; cur_axis_index < k && cur_axis_index < input->shape[axis]; cur_axis_index++) {
+      for (int64_t cur_axis_index = 0; cur_axis_index < axis_size; cur_axis_index++) {
         int64_t full_idx = src_base_idx + cur_axis_index * axis_mul_after;
-        running_heap.emplace_back(std::make_pair(cur_axis_index, data_ptr[full_idx]));
+        sorter.emplace_back(std::make_pair(cur_axis_index, data_ptr[full_idx]));
       }
-      if (!is_ascend) {
-        std::make_heap(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
-      } else {
-        std::make_heap(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
-      }
-
-      // Iterate through all elements, adding to heap along the way
-      for (; cur_axis_index < input->shape[axis]; cur_axis_index++) {
-        int64_t full_idx = src_base_idx + cur_axis_index * axis_mul_after;
-        std::pair<int64_t, DataType> cur_val = {cur_axis_index, data_ptr[full_idx]};
-
-        // Eq. to cur_val.second > running_heap.second
-        if (!is_ascend && CompareDescend<DataType, true>(cur_val, running_heap[0])) {
-          running_heap.push_back(cur_val);
-          std::push_heap(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
-          std::pop_heap(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
-          running_heap.pop_back();
-        } else if (is_ascend && CompareAscend<DataType, true>(cur_val, running_heap[0])) {
-          running_heap.push_back(cur_val);
-          std::push_heap(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
-          std::pop_heap(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
-          running_heap.pop_back();
-        }
-      }
-
-      // finally sort heap and deliver results
       if (is_ascend) {
-        std::stable_sort(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
+        select_topk(&sorter, CompareAscend<DataType, true>);
       } else {
-        std::stable_sort(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
+        select_topk(&sorter, CompareDescend<DataType, true>);
       }
 
-      for (uint32_t kk = 0; kk < running_heap.size(); ++kk) {
+      for (uint32_t kk = 0; kk < sorter.size(); ++kk) {
         if (indices_ptr != nullptr) {
           indices_ptr[dst_base_idx + kk * axis_mul_after] =
-              static_cast<IndicesType>(running_heap[kk].first);
+              static_cast<IndicesType>(sorter[kk].first);
         }
         if (values_ptr != nullptr) {
-          values_ptr[dst_base_idx + kk * axis_mul_after] =
-              static_cast<DataType>(running_heap[kk].second);
+          values_ptr[dst_base_idx + kk * axis_mul_after] = static_cast<DataType>(sorter[kk].second);
         }
       }
     }
-  }
+  });
 }
 
 // Argsort implemented C library sort.
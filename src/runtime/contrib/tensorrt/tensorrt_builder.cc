@@ -86,6 +86,7 @@ void TensorRTBuilder::AddInput(int nid, uint32_t entry_id, const JSONGraphNode&
   for (size_t i = 0; i < shapes.size(); ++i) {
     const std::string name = node_name + "_" + std::to_string(i);
     auto shape = shapes[i];
+    input_shapes_[name] = std::vector<int>(shape.begin(), shape.end());
     // Remove batch dim when not in explicit batch mode.
     if (use_implicit_batch_ && shape.size() > 1) {
       shape.erase(shape.begin());
@@ -98,6 +99,20 @@ void TensorRTBuilder::AddInput(int nid, uint32_t entry_id, const JSONGraphNode&
   }
 }
 
+void TensorRTBuilder::SetBatchProfile(int min_batch_size, int opt_batch_size,
+                                      int max_batch_size) {
+  ICHECK(0 < min_batch_size && min_batch_size <= opt_batch_size &&
+         opt_batch_size <= max_batch_size)
+      << "Invalid TensorRT batch profile (" << min_batch_size << ", " << opt_batch_size << ", "
+      << max_batch_size << ")";
+  ICHECK(network_input_names_.empty()) << "The batch profile must be set before the inputs";
+  batch_profile_ = {min_batch_size, opt_batch_size, max_batch_size};
+  batch_size_ = max_batch_size;
+  if (use_implicit_batch_) {
+    builder_->setMaxBatchSize(batch_size_);
+  }
+}
+
 void TensorRTBuilder::AddConstant(int nid, const DLTensor* data) {
   nvinfer1::Weights weight = GetDLTensorAsWeights(data, kDLCPU);
   std::vector<int> shape(data->shape, data->shape + data->ndim);
@@ -187,6 +202,23 @@ TensorRTEngineAndContext TensorRTBuilder::BuildEngine() {
     auto profile = builder_->createOptimizationProfile();
     for (int i = 0; i < network_->getNbInputs(); ++i) {
       auto name = network_->getInput(i)->getName();
+      if (!batch_profile_.empty()) {
+        // The inputs may not be bound yet, so the shapes come from the graph.
+        const std::vector<int>& shape = input_shapes_.at(name);
+        const nvinfer1::OptProfileSelector selectors[] = {nvinfer1::OptProfileSelector::kMIN,
+                                                          nvinfer1::OptProfileSelector::kOPT,
+                                                          nvinfer1::OptProfileSelector::kMAX};
+        for (int j = 0; j < 3; ++j) {
+          std::vector<int> dims(shape);
+          if (!dims.empty() && dims[0] == -1) dims[0] = batch_profile_[j];
+          for (int dim : dims) {
+            ICHECK_GE(dim, 0) << "Only the batch dimension of TensorRT input " << name
+                              << " can be dynamic with a batch profile";
+          }
+          profile->setDimensions(name, selectors[j], VectorToTrtDims(dims));
+        }
+        continue;
+      }
       const uint32_t entry_id = entry_id_map_[name];
       std::vector<int64_t> shape(data_entry_[entry_id]->shape,
                                  data_entry_[entry_id]->shape + data_entry_[entry_id]->ndim);
@@ -27,6 +27,7 @@
 
 #include <tvm/runtime/ndarray.h>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -52,6 +53,9 @@ struct TensorRTEngineAndContext {
   nvinfer1::IExecutionContext* context = nullptr;
   std::vector<std::string> inputs;
   std::vector<std::string> outputs;
+  /*! \brief Holds the engine when it is shared with other modules, which destroys it after the
+   * last module using it. Null when the engine is owned by this context. */
+  std::shared_ptr<nvinfer1::ICudaEngine> shared_engine;
 };
 
 /*!
@@ -104,6 +108,15 @@ class TensorRTBuilder {
    */
   void AddOutput(const JSONGraphNodeEntry& entry, uint32_t entry_id);
 
+  /*!
+   * \brief Build the engine for a range of batch sizes, in a single optimization profile, instead
+   * of for the batch size of the current inputs. Must be called before the inputs are added.
+   * \param min_batch_size The smallest batch size the engine can run.
+   * \param opt_batch_size The batch size the engine is tuned for.
+   * \param max_batch_size The largest batch size the engine can run.
+   */
+  void SetBatchProfile(int min_batch_size, int opt_batch_size, int max_batch_size);
+
   /*!
    * \brief Takes network definition and "compiles" a TensorRT engine which can be used for
    * inference. This step is time confusing.
@@ -159,6 +172,13 @@ class TensorRTBuilder {
   /*! \brief Batch size to optimize for. */
   int batch_size_;
 
+  /*! \brief The min, opt and max batch sizes of the optimization profile, or empty to use the
+   * shapes of the current inputs. */
+  std::vector<int> batch_profile_;
+
+  /*! \brief Map TensorRT input name to its shape in the graph, with -1 for the dynamic batch. */
+  std::unordered_map<std::string, std::vector<int>> input_shapes_;
+
   /*! \brief Input names. */
   std::vector<std::string> network_input_names_;
 
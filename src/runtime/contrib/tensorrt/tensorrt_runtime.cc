@@ -27,8 +27,12 @@
 #include <tvm/runtime/registry.h>
 
 #include <fstream>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -56,6 +60,58 @@ struct PairHash {
 
 using namespace tvm::runtime::json;
 
+#ifdef TVM_GRAPH_EXECUTOR_TENSORRT
+/*!
+ * \brief The engines shared by the TensorRT modules of the process, keyed by their subgraph, its
+ * weights and build options. An engine is destroyed by the last module using it.
+ */
+class SharedEngineTable {
+ public:
+  struct Entry {
+    std::weak_ptr<nvinfer1::ICudaEngine> engine;
+    std::vector<std::string> inputs;
+    std::vector<std::string> outputs;
+  };
+
+  static SharedEngineTable* Global() {
+    static SharedEngineTable* inst = new SharedEngineTable();
+    return inst;
+  }
+
+  /*! \brief Get an engine built by another module, and create its context for this module. */
+  bool Get(const std::string& key, TensorRTEngineAndContext* engine_and_context) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = table_.find(key);
+    if (it == table_.end()) return false;
+    std::shared_ptr<nvinfer1::ICudaEngine> engine = it->second.engine.lock();
+    if (engine == nullptr) {
+      table_.erase(it);
+      return false;
+    }
+    engine_and_context->shared_engine = engine;
+    engine_and_context->engine = engine.get();
+    engine_and_context->context = engine->createExecutionContext();
+    engine_and_context->inputs = it->second.inputs;
+    engine_and_context->outputs = it->second.outputs;
+    return true;
+  }
+
+  /*! \brief Share an engine built by this module. */
+  void Put(const std::string& key, TensorRTEngineAndContext* engine_and_context) {
+    ICHECK(engine_and_context->shared_engine == nullptr);
+    engine_and_context->shared_engine = std::shared_ptr<nvinfer1::ICudaEngine>(
+        engine_and_context->engine, [](nvinfer1::ICudaEngine* engine) { engine->destroy(); });
+    std::lock_guard<std::mutex> lock(mutex_);
+    table_[key] = {engine_and_context->shared_engine, engine_and_context->inputs,
+                   engine_and_context->outputs};
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, Entry> table_;
+};
+#endif  // TVM_GRAPH_EXECUTOR_TENSORRT
+
 class TensorRTRuntime : public JSONRuntimeBase {
  public:
   /*!
@@ -76,6 +132,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
         use_fp16_(false) {
     const bool use_int8 = dmlc::GetEnv("TVM_TENSORRT_USE_INT8", false);
     multi_engine_mode_ = dmlc::GetEnv("TVM_TENSORRT_MULTI_ENGINE", false);
+    share_engines_ = dmlc::GetEnv("TVM_TENSORRT_SHARE_ENGINES", false);
     num_calibration_batches_remaining_ = dmlc::GetEnv("TENSORRT_NUM_CALI_INT8", 0);
     if (use_int8) {
       ICHECK(num_calibration_batches_remaining_ != 0)
@@ -113,7 +170,8 @@ class TensorRTRuntime : public JSONRuntimeBase {
         << "The number of input constants must match the number of required.";
     LoadGlobalAttributes();
     SetupConstants(consts);
-    GetCachedEnginesFromDisk();
+    if (share_engines_) ComputeShareKey();
+    if (!GetCachedEnginesFromDisk()) BuildEngineInBackground();
   }
 
   void LoadGlobalAttributes() {
@@ -136,34 +194,59 @@ class TensorRTRuntime : public JSONRuntimeBase {
       if (nodes_[i].HasAttr("use_fp16")) {
         use_fp16_ = std::stoi(nodes_[i].GetAttr<std::vector<std::string>>("use_fp16")[0]);
       }
+      if (nodes_[i].HasAttr("batch_profile") && batch_profile_.empty()) {
+        auto sizes = nodes_[i].GetAttr<std::vector<std::string>>("batch_profile");
+        for (const std::string& size : sizes) {
+          batch_profile_.push_back(std::stoi(size));
+        }
+        ICHECK_EQ(batch_profile_.size(), 3) << "The batch profile must have min, opt and max sizes";
+      }
     }
   }
 
 #ifdef TVM_GRAPH_EXECUTOR_TENSORRT
+  /*! \brief Compute the key under which the engines are shared with the other modules. Besides
+   * the graph, it covers the weights, since they are embedded in the engines. */
+  void ComputeShareKey() {
+    size_t hash = std::hash<std::string>()(graph_json_);
+    for (uint32_t nid : const_idx_) {
+      const DLTensor* data = data_entry_[EntryID(nid, 0)];
+      std::string_view bytes(static_cast<const char*>(data->data) + data->byte_offset,
+                             GetDataSize(*data));
+      hash ^= std::hash<std::string_view>()(bytes) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    std::ostringstream os;
+    os << GetSubgraphKey() << "_" << std::hex << hash;
+    share_key_ = os.str();
+  }
+
   /*! \brief Destroy engines and contexts. */
   void DestroyEngines() {
     for (auto& it : trt_engine_cache_) {
       VLOG(1) << "Destroying TensorRT context for function '" << it.first.first << "' (batch size "
               << it.first.second << ")";
       it.second.context->destroy();
-      VLOG(1) << "Destroying TensorRT engine for function '" << it.first.first << "' (batch size "
-              << it.first.second << ")";
-      it.second.engine->destroy();
+      if (it.second.shared_engine == nullptr) {
+        VLOG(1) << "Destroying TensorRT engine for function '" << it.first.first
+                << "' (batch size " << it.first.second << ")";
+        it.second.engine->destroy();
+      }
     }
     trt_engine_cache_.clear();
   }
 
   ~TensorRTRuntime() override {
     VLOG(1) << "Destroying TensorRT runtime";
+    WaitForBackgroundBuild();
     DestroyEngines();
     VLOG(1) << "Destroyed TensorRT runtime";
   }
 
   /*! \brief Run inference using built engine. */
   void Run() override {
-    auto& engine_and_context = GetOrBuildEngine();
     int batch_size = GetBatchSize();
     if (batch_size == 0) return;
+    auto& engine_and_context = GetOrBuildEngine();
     auto engine = engine_and_context.engine;
     auto context = engine_and_context.context;
     const int num_bindings = engine->getNbBindings();
@@ -259,6 +342,14 @@ class TensorRTRuntime : public JSONRuntimeBase {
   /*! \brief Find an engine in the cache which we can reuse depending on the mode. If no compatible
    * engine exists, return false to indicate that a new one should be built. */
   bool FindCompatibleEngine(int batch_size, int* compatible_engine_batch_size) {
+    if (!batch_profile_.empty()) {
+      // A single engine, keyed by the max batch size, covers the whole batch profile.
+      ICHECK(batch_profile_[0] <= batch_size && batch_size <= batch_profile_[2])
+          << "Batch size " << batch_size << " is out of the TensorRT batch profile ["
+          << batch_profile_[0] << ", " << batch_profile_[2] << "] of subgraph " << symbol_name_;
+      *compatible_engine_batch_size = batch_profile_[2];
+      return trt_engine_cache_.count(std::make_pair(symbol_name_, batch_profile_[2]));
+    }
     if (multi_engine_mode_) {
       // Exact match is required for multi engine mode.
       if (trt_engine_cache_.count(std::make_pair(symbol_name_, batch_size))) {
@@ -280,6 +371,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
    * already built, do nothing.
    */
   TensorRTEngineAndContext& GetOrBuildEngine() {
+    WaitForBackgroundBuild();
     int batch_size = GetBatchSize();
     int compatible_engine_batch_size = -1;
     bool find_engine_flag = FindCompatibleEngine(batch_size, &compatible_engine_batch_size);
@@ -292,6 +384,9 @@ class TensorRTRuntime : public JSONRuntimeBase {
       return trt_engine_cache_.at(std::make_pair(symbol_name_, compatible_engine_batch_size));
     }
 
+    if (!batch_profile_.empty()) {
+      batch_size = batch_profile_[2];
+    }
     // For single engine mode, remove previous engine and update max_batch_size.
     if (!multi_engine_mode_) {
       DestroyEngines();
@@ -317,14 +412,53 @@ class TensorRTRuntime : public JSONRuntimeBase {
 
     VLOG(1) << "Finished building TensorRT engine for subgraph " << symbol_name_
             << " with batch size " << batch_size;
-    CacheEngineToDisk();
+    CacheEngineToDisk(batch_size);
     return trt_engine_cache_.at(std::make_pair(symbol_name_, batch_size));
   }
 
+  /*!
+   * \brief If TVM_TENSORRT_BUILD_ASYNC is set, start building the engine of the batch profile on
+   * a background thread when the module is initialized, instead of at the first inference. The
+   * first inference waits for the build to complete.
+   */
+  void BuildEngineInBackground() {
+    if (batch_profile_.empty() || !dmlc::GetEnv("TVM_TENSORRT_BUILD_ASYNC", false) ||
+        dmlc::GetEnv("TVM_TENSORRT_USE_INT8", false)) {
+      return;
+    }
+    build_future_ = std::async(std::launch::async, [this]() {
+      int batch_size = batch_profile_[2];
+      VLOG(1) << "Building TensorRT engine for subgraph " << symbol_name_ << " in the background";
+      BuildEngineFromJson(batch_size);
+      max_batch_size_ = batch_size;
+      CacheEngineToDisk(batch_size);
+    });
+  }
+
+  /*! \brief Wait for the engine built in the background, and rethrow its error if any. */
+  void WaitForBackgroundBuild() {
+    if (build_future_.valid()) build_future_.get();
+  }
+
   void BuildEngineFromJson(int batch_size) {
+    TensorRTEngineAndContext engine_and_context;
+    std::ostringstream share_key;
+    // Engines calibrated on the data of a module are not shared.
+    const bool share_engine = share_engines_ && calibrator_ == nullptr;
+    if (share_engine) {
+      share_key << share_key_ << "_" << batch_size;
+      if (SharedEngineTable::Global()->Get(share_key.str(), &engine_and_context)) {
+        VLOG(1) << "Using shared TensorRT engine for subgraph " << symbol_name_;
+        trt_engine_cache_[std::make_pair(symbol_name_, batch_size)] = engine_and_context;
+        return;
+      }
+    }
     const bool use_fp16 = dmlc::GetEnv("TVM_TENSORRT_USE_FP16", false) || use_fp16_;
     TensorRTBuilder builder(&logger_, data_entry_, max_workspace_size_, use_implicit_batch_,
                             use_fp16, batch_size, calibrator_.get());
+    if (!batch_profile_.empty()) {
+      builder.SetBatchProfile(batch_profile_[0], batch_profile_[1], batch_profile_[2]);
+    }
     for (size_t i = 0; i < input_nodes_.size(); ++i) {
       auto nid = input_nodes_[i];
       const auto& node = nodes_[nid];
@@ -350,7 +484,10 @@ class TensorRTRuntime : public JSONRuntimeBase {
       builder.AddOutput(outputs_[i], EntryID(outputs_[i]));
     }
 
-    TensorRTEngineAndContext engine_and_context = builder.BuildEngine();
+    engine_and_context = builder.BuildEngine();
+    if (share_engine) {
+      SharedEngineTable::Global()->Put(share_key.str(), &engine_and_context);
+    }
     trt_engine_cache_[std::make_pair(symbol_name_, batch_size)] = engine_and_context;
   }
 
@@ -397,8 +534,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
   /*! \brief If TVM_TENSORRT_CACHE_DIR is set, will save the engine to that
    * directory so it can be loaded later.
    */
-  void CacheEngineToDisk() {
-    int batch_size = GetBatchSize();
+  void CacheEngineToDisk(int batch_size) {
     std::string cache_dir = dmlc::GetEnv("TVM_TENSORRT_CACHE_DIR", std::string(""));
     if (cache_dir.empty()) return;
     std::string key = GetSubgraphKey();
@@ -480,6 +616,9 @@ class TensorRTRuntime : public JSONRuntimeBase {
   /*! \brief TensorRT logger. */
   TensorRTLogger logger_;
 
+  /*! \brief The engine built in the background, if any. */
+  std::future<void> build_future_;
+
 #else   // TVM_GRAPH_EXECUTOR_TENSORRT
   void Run() override {
     LOG(FATAL) << "TensorRT runtime is not enabled. "
@@ -491,9 +630,13 @@ class TensorRTRuntime : public JSONRuntimeBase {
                  << "Please build with USE_TENSORRT_RUNTIME.";
   }
 
+  void ComputeShareKey() {}
+
   bool GetCachedEnginesFromDisk() { return false; }
 
-  void CacheEngineToDisk() {}
+  void BuildEngineInBackground() {}
+
+  void CacheEngineToDisk(int batch_size) {}
 #endif  // TVM_GRAPH_EXECUTOR_TENSORRT
 
   bool use_implicit_batch_;
@@ -516,6 +659,17 @@ class TensorRTRuntime : public JSONRuntimeBase {
 
   /*! \brief Use auto-conversion to fp16 */
   bool use_fp16_;
+
+  /*! \brief The min, opt and max batch sizes declared at partition time, or empty. With a batch
+   * profile, a single engine is built for all the batch sizes from min to max. */
+  std::vector<int> batch_profile_;
+
+  /*! \brief Whether to share the engines with the other modules of the process which have the
+   * same subgraph and weights. Each module still has its own execution context. */
+  bool share_engines_;
+
+  /*! \brief The key of the shared engines of this module. */
+  std::string share_key_;
 };
 
 runtime::Module TensorRTRuntimeCreate(const String& symbol_name, const String& graph_json,
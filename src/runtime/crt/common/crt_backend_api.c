@@ -59,6 +59,11 @@ int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_ta
   return 0;
 }
 
+// The loop regions are not recorded on microcontrollers.
+int TVMBackendProfileRegionBegin(const char* func_name, int32_t region_id) { return 0; }
+
+int TVMBackendProfileRegionEnd(int32_t region_id) { return 0; }
+
 int TVMBackendRegisterSystemLibSymbol(const char* name, void* ptr) {
   return TVMFuncRegisterGlobal(name, ptr, 0);
 }
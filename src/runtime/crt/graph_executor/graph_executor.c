@@ -235,6 +235,7 @@ int TVMGraphExecutorGraphAttr_Load(TVMGraphExecutorGraphAttr* attr, JSONReader*
   uint32_t dltype_count = 0;
   uint32_t shape_count = 0;
   uint32_t device_index_count = 0;
+  uint32_t storage_offset_count = 0;
   reader->BeginObject(reader);
   while (reader->NextObjectItem(reader, key, sizeof(key))) {
     if (!strcmp(key, "dltype")) {
@@ -475,6 +476,58 @@ int TVMGraphExecutorGraphAttr_Load(TVMGraphExecutorGraphAttr* attr, JSONReader*
         status = -1;
         break;
       }
+    } else if (!strcmp(key, "storage_offset")) {
+      reader->BeginArray(reader);
+      if (!(reader->NextArrayItem(reader))) {
+        fprintf(stderr, "Invalid json format\n");
+        status = -1;
+        break;
+      }
+      status = reader->ReadString(reader, type, sizeof(type));
+      if (status != 0) {
+        fprintf(stderr, "error reading storage_offset array item");
+        break;
+      }
+      if (strcmp(type, "list_int")) {
+        fprintf(stderr, "Invalid json format\n");
+        status = -1;
+        break;
+      }
+      if (!(reader->NextArrayItem(reader))) {
+        fprintf(stderr, "Invalid json format\n");
+        status = -1;
+        break;
+      }
+      reader->BeginArray(reader);
+      size_t num_items = 0;
+      if (reader->ArrayLength(reader, &num_items) != 0) {
+        fprintf(stderr, "error determing list_int length\n");
+        status = -1;
+        break;
+      }
+      DLDevice dev = {kDLCPU, 0};
+      tvm_crt_error_t err = TVMPlatformMemoryAllocate(sizeof(uint32_t) * num_items, dev,
+                                                      (void**)&attr->storage_offset);
+      if (err != kTvmErrorNoError) {
+        fprintf(stderr, "memory allocate error: %08x", err);
+        status = -1;
+        break;
+      }
+      storage_offset_count = 0;
+      while (reader->NextArrayItem(reader)) {
+        if (storage_offset_count == num_items) {
+          fprintf(stderr, "array too big\n");
+          status = -1;
+          return status;
+        }
+        reader->ReadUnsignedInteger(reader, &(attr->storage_offset[storage_offset_count]));
+        storage_offset_count++;
+      }
+      if (reader->NextArrayItem(reader)) {
+        fprintf(stderr, "Invalid json format\n");
+        status = -1;
+        break;
+      }
     } else {
       reader->BeginArray(reader);
       if (!(reader->NextArrayItem(reader))) {
@@ -520,6 +573,10 @@ int TVMGraphExecutorGraphAttr_Load(TVMGraphExecutorGraphAttr* attr, JSONReader*
     fprintf(stderr, "invalid format\n");
     status = -1;
   }
+  if (attr->storage_offset != NULL && storage_offset_count != shape_count) {
+    fprintf(stderr, "storage_offset and shape differ in length\n");
+    status = -1;
+  }
   return status;
 }
 
@@ -543,6 +600,14 @@ int TVMGraphExecutorGraphAttr_Release(TVMGraphExecutorGraphAttr* attr) {
       return -1;
     }
   }
+  if (attr->storage_offset) {
+    DLDevice dev = {kDLCPU, 0};
+    tvm_crt_error_t err = TVMPlatformMemoryFree(attr->storage_offset, dev);
+    attr->storage_offset = 0;
+    if (err != kTvmErrorNoError) {
+      return -1;
+    }
+  }
   if (attr->dltype) {
     DLDevice dev = {kDLCPU, 0};
     tvm_crt_error_t err = TVMPlatformMemoryFree(attr->dltype, dev);
@@ -963,6 +1028,10 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
     DLDataType t = vtype[idx];
     uint32_t bits = t.bits * t.lanes;
     size_t bytes = ((bits + 7U) / 8U) * size;
+    // Entries packed by the memory planner into one storage live at distinct offsets.
+    if (attrs->storage_offset != NULL) {
+      bytes += attrs->storage_offset[idx];
+    }
 
     uint32_t sid = storage_id;
     if (sid >= pool_entry_count) {
@@ -1031,6 +1100,10 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
                                        attrs->shape + idx * TVM_CRT_MAX_NDIM, attrs->ndim[idx],
                                        vtype[idx], &executor->data_entry[idx]);
     CHECK_EQ(status, 0, "fail to create for node with idx=%d, storage_id=%u\n", idx, storage_id);
+    if (attrs->storage_offset != NULL) {
+      executor->data_entry[idx].dl_tensor.data =
+          (uint8_t*)executor->data_entry[idx].dl_tensor.data + attrs->storage_offset[idx];
+    }
 
     TVMNDArray_IncrementReference(&executor->data_entry[idx]);
   }
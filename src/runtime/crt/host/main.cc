@@ -26,6 +26,7 @@
 #include <tvm/runtime/crt/aot_executor_module.h>
 #include <tvm/runtime/crt/logging.h>
 #include <tvm/runtime/crt/microtvm_rpc_server.h>
+#include <tvm/runtime/crt/page_allocator.h>
 #include <unistd.h>
 
 #include <iostream>
@@ -48,6 +49,9 @@ ssize_t MicroTVMWriteFunc(void* context, const uint8_t* data, size_t num_bytes)
 
 static char** g_argv = NULL;
 
+// The memory manager of the platform, in platform.cc.
+extern MemoryManagerInterface* memory_manager;
+
 int testonly_reset_server(TVMValue* args, int* type_codes, int num_args, TVMValue* out_ret_value,
                           int* out_ret_tcode, void* resource_handle) {
   execvp(g_argv[0], g_argv);
@@ -55,6 +59,33 @@ int testonly_reset_server(TVMValue* args, int* type_codes, int num_args, TVMValu
   return -1;
 }
 
+// Fill an int64 tensor of 5 elements with the statistics of the memory manager: the total, used,
+// peak used and largest free bytes, and the number of allocations.
+int get_memory_stats(TVMValue* args, int* type_codes, int num_args, TVMValue* out_ret_value,
+                     int* out_ret_tcode, void* resource_handle) {
+  if (num_args != 1 || type_codes[0] != kTVMDLTensorHandle) {
+    TVMAPISetLastError("GetMemoryStats expects a tensor");
+    return kTvmErrorFunctionCallWrongArgType;
+  }
+  DLTensor* out = static_cast<DLTensor*>(args[0].v_handle);
+  if (out->ndim != 1 || out->shape[0] != 5 || out->dtype.code != kDLInt || out->dtype.bits != 64) {
+    TVMAPISetLastError("GetMemoryStats expects an int64 tensor of 5 elements");
+    return kTvmErrorFunctionCallWrongArgType;
+  }
+  MemoryManagerStats stats;
+  tvm_crt_error_t err = memory_manager->GetStats(memory_manager, &stats);
+  if (err != kTvmErrorNoError) {
+    return err;
+  }
+  int64_t* data = reinterpret_cast<int64_t*>(static_cast<uint8_t*>(out->data) + out->byte_offset);
+  data[0] = stats.total_bytes;
+  data[1] = stats.used_bytes;
+  data[2] = stats.peak_used_bytes;
+  data[3] = stats.largest_free_bytes;
+  data[4] = stats.num_allocations;
+  return 0;
+}
+
 int main(int argc, char** argv) {
   g_argv = argv;
   TVMPlatformInitialize();
@@ -75,6 +106,16 @@ int main(int argc, char** argv) {
     return 2;
   }
 
+  error = TVMFuncRegisterGlobal("tvm.rpc.server.GetMemoryStats",
+                                (TVMFunctionHandle)&get_memory_stats, 0);
+  if (error) {
+    fprintf(
+        stderr,
+        "microTVM runtime: internal error (error#: %x) registering global packedfunc; exiting\n",
+        error);
+    return 2;
+  }
+
   setbuf(stdin, NULL);
   setbuf(stdout, NULL);
 
@@ -30,6 +30,7 @@
 #include <time.h>
 #include <tvm/runtime/crt/error_codes.h>
 #include <tvm/runtime/crt/page_allocator.h>
+#include <tvm/runtime/crt/tlsf_allocator.h>
 #include <unistd.h>
 
 #include <chrono>
@@ -114,8 +115,12 @@ tvm_crt_error_t TVMPlatformGenerateRandom(uint8_t* buffer, size_t num_bytes) {
 
 // Initialize TVM inference.
 tvm_crt_error_t TVMPlatformInitialize() {
+#ifdef TVM_CRT_MEMORY_MANAGER_TLSF
+  int status = TLSFMemoryManagerCreate(&memory_manager, memory, sizeof(memory));
+#else
   int status =
       PageMemoryManagerCreate(&memory_manager, memory, sizeof(memory), 8 /* page_size_log2 */);
+#endif
   if (status != 0) {
     fprintf(stderr, "error initiailizing memory manager\n");
     return kTvmErrorPlatformMemoryManagerInitialized;
@@ -277,6 +277,29 @@ tvm_crt_error_t PageMemoryManager_Free(MemoryManagerInterface* interface, void*
   return kTvmErrorNoError;
 }
 
+tvm_crt_error_t PageMemoryManager_GetStats(MemoryManagerInterface* interface,
+                                           MemoryManagerStats* stats) {
+  MemoryManager* mgr = (MemoryManager*)interface;
+  PageTable* ptable = &(mgr->ptable);
+  MultiMap* free_map = &(mgr->free_map);
+  // The pages after the last allocated one are free, as are the runs of the free map
+  size_t free_pages = 0;
+  size_t largest_free_pages = ptable->max_pages - ptable->num_pages;
+  for (uint32_t idx = 0; idx < free_map->num_entries; idx++) {
+    size_t npage = free_map->entries[idx].page.num_pages;
+    free_pages += npage;
+    if (npage > largest_free_pages) {
+      largest_free_pages = npage;
+    }
+  }
+  stats->total_bytes = ptable->max_pages * ptable->page_size_bytes;
+  stats->used_bytes = (ptable->num_pages - free_pages) * ptable->page_size_bytes;
+  stats->peak_used_bytes = ptable->num_pages * ptable->page_size_bytes;
+  stats->largest_free_bytes = largest_free_pages * ptable->page_size_bytes;
+  stats->num_allocations = (size_t)mgr->interface.vleak_size;
+  return kTvmErrorNoError;
+}
+
 tvm_crt_error_t PageMemoryManagerCreate(MemoryManagerInterface** interface, uint8_t* memory_pool,
                                         size_t memory_pool_size_bytes,
                                         size_t page_size_bytes_log2) {
@@ -300,6 +323,7 @@ tvm_crt_error_t PageMemoryManagerCreate(MemoryManagerInterface** interface, uint
 
   manager->interface.Allocate = PageMemoryManager_Allocate;
   manager->interface.Free = PageMemoryManager_Free;
+  manager->interface.GetStats = PageMemoryManager_GetStats;
   manager->ptable.memory_pool = memory_pool;
 
   /* handle PageTable member functions */
@@ -0,0 +1,371 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+// LINT_C_FILE
+
+/*!
+ * \file tlsf_allocator.c
+ * \brief Two-level segregated fit memory manager, with constant time allocation and free.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <tvm/runtime/crt/error_codes.h>
+#include <tvm/runtime/crt/tlsf_allocator.h>
+
+#include "crt_config.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifndef TVM_RUNTIME_ALLOC_ALIGNMENT_BYTES
+#define TVM_RUNTIME_ALLOC_ALIGNMENT_BYTES 16
+#endif
+
+#if TVM_RUNTIME_ALLOC_ALIGNMENT_BYTES == 4
+#define TLSF_ALIGN_LOG2 2
+#elif TVM_RUNTIME_ALLOC_ALIGNMENT_BYTES == 8
+#define TLSF_ALIGN_LOG2 3
+#elif TVM_RUNTIME_ALLOC_ALIGNMENT_BYTES == 16
+#define TLSF_ALIGN_LOG2 4
+#elif TVM_RUNTIME_ALLOC_ALIGNMENT_BYTES == 32
+#define TLSF_ALIGN_LOG2 5
+#elif TVM_RUNTIME_ALLOC_ALIGNMENT_BYTES == 64
+#define TLSF_ALIGN_LOG2 6
+#else
+#error "TVM_RUNTIME_ALLOC_ALIGNMENT_BYTES must be a power of two between 4 and 64"
+#endif
+
+/*! \brief log2 of the number of second level lists for each power of two. */
+#ifndef TVM_CRT_TLSF_SL_LOG2
+#define TVM_CRT_TLSF_SL_LOG2 4
+#endif
+
+/*! \brief log2 of the bound of the sizes of the blocks, and so of the pool that is used. */
+#ifndef TVM_CRT_TLSF_MAX_SIZE_LOG2
+#define TVM_CRT_TLSF_MAX_SIZE_LOG2 30
+#endif
+
+#define TLSF_ALIGN ((size_t)TVM_RUNTIME_ALLOC_ALIGNMENT_BYTES)
+#define TLSF_SL_COUNT (1 << TVM_CRT_TLSF_SL_LOG2)
+// The sizes smaller than 1 << TLSF_FL_SHIFT are all on the first level, by multiple of TLSF_ALIGN.
+#define TLSF_FL_SHIFT (TVM_CRT_TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_FL_COUNT (TVM_CRT_TLSF_MAX_SIZE_LOG2 - TLSF_FL_SHIFT + 1)
+#define TLSF_MAX_SIZE (((size_t)1 << TVM_CRT_TLSF_MAX_SIZE_LOG2) - TLSF_ALIGN)
+
+#if TLSF_SL_COUNT > 32 || TLSF_FL_COUNT > 31
+#error "the bitmaps of the TLSF allocator are 32 bits"
+#endif
+
+#define TLSF_ROUND_UP(x) (((x) + TLSF_ALIGN - 1) / TLSF_ALIGN * TLSF_ALIGN)
+
+/*! \brief The flags in the low bits of the size of a block. */
+#define TLSF_BLOCK_FREE ((size_t)1)
+#define TLSF_BLOCK_PREV_FREE ((size_t)2)
+
+/*! \brief A block of the pool, its data follows the header. */
+typedef struct TLSFBlock {
+  /*! \brief The previous block in the pool, only set when that block is free. */
+  struct TLSFBlock* prev_phys;
+  /*! \brief The size of the data, a multiple of TLSF_ALIGN, and the flags. */
+  size_t size;
+  /*! \brief The neighbors of a free block in its list, which are stored in its data. */
+  struct TLSFBlock* next_free;
+  struct TLSFBlock* prev_free;
+} TLSFBlock;
+
+#define TLSF_HEADER_BYTES TLSF_ROUND_UP(offsetof(TLSFBlock, next_free))
+#define TLSF_MIN_DATA_BYTES                                         \
+  (TLSF_ROUND_UP(sizeof(TLSFBlock)) - TLSF_HEADER_BYTES > TLSF_ALIGN \
+       ? TLSF_ROUND_UP(sizeof(TLSFBlock)) - TLSF_HEADER_BYTES        \
+       : TLSF_ALIGN)
+
+typedef struct TLSFMemoryManager {
+  MemoryManagerInterface interface;
+  /*! \brief The first levels that have a list which is not empty. */
+  uint32_t fl_bitmap;
+  /*! \brief The second levels that have a list which is not empty, for each first level. */
+  uint32_t sl_bitmap[TLSF_FL_COUNT];
+  TLSFBlock* free_lists[TLSF_FL_COUNT][TLSF_SL_COUNT];
+  /*! \brief The first block. */
+  uint8_t* blocks_begin;
+  /*! \brief The header of size 0 after the last block. */
+  uint8_t* blocks_end;
+  size_t total_bytes;
+  size_t used_bytes;
+  size_t peak_used_bytes;
+} TLSFMemoryManager;
+
+/*! \brief The index of the highest bit set in x, which is not 0. */
+static inline int TLSF_Fls(size_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (int)(sizeof(unsigned long long) * 8 - 1) - __builtin_clzll((unsigned long long)x);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long index;
+  _BitScanReverse64(&index, (unsigned __int64)x);
+  return (int)index;
+#else
+  int index = -1;
+  while (x != 0) {
+    x >>= 1;
+    ++index;
+  }
+  return index;
+#endif
+}
+
+/*! \brief The index of the lowest bit set in x, which is not 0. */
+static inline int TLSF_Ffs(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctz(x);
+#elif defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, x);
+  return (int)index;
+#else
+  int index = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    ++index;
+  }
+  return index;
+#endif
+}
+
+static inline size_t TLSF_BlockSize(const TLSFBlock* block) {
+  return block->size & ~(TLSF_BLOCK_FREE | TLSF_BLOCK_PREV_FREE);
+}
+
+static inline uint8_t* TLSF_BlockData(TLSFBlock* block) {
+  return (uint8_t*)block + TLSF_HEADER_BYTES;
+}
+
+static inline TLSFBlock* TLSF_BlockNext(TLSFBlock* block) {
+  return (TLSFBlock*)(TLSF_BlockData(block) + TLSF_BlockSize(block));
+}
+
+/*! \brief Get the lists holding the blocks of a size. */
+static inline void TLSF_Mapping(size_t size, int* fl, int* sl) {
+  if (size < ((size_t)1 << TLSF_FL_SHIFT)) {
+    *fl = 0;
+    *sl = (int)(size >> TLSF_ALIGN_LOG2);
+  } else {
+    int bit = TLSF_Fls(size);
+    *fl = bit - TLSF_FL_SHIFT + 1;
+    *sl = (int)((size >> (bit - TVM_CRT_TLSF_SL_LOG2)) ^ TLSF_SL_COUNT);
+  }
+}
+
+static void TLSF_InsertFree(TLSFMemoryManager* mgr, TLSFBlock* block) {
+  int fl, sl;
+  TLSF_Mapping(TLSF_BlockSize(block), &fl, &sl);
+  TLSFBlock* head = mgr->free_lists[fl][sl];
+  block->next_free = head;
+  block->prev_free = NULL;
+  if (head != NULL) {
+    head->prev_free = block;
+  }
+  mgr->free_lists[fl][sl] = block;
+  mgr->fl_bitmap |= (uint32_t)1 << fl;
+  mgr->sl_bitmap[fl] |= (uint32_t)1 << sl;
+}
+
+static void TLSF_RemoveFree(TLSFMemoryManager* mgr, TLSFBlock* block) {
+  int fl, sl;
+  TLSF_Mapping(TLSF_BlockSize(block), &fl, &sl);
+  if (block->next_free != NULL) {
+    block->next_free->prev_free = block->prev_free;
+  }
+  if (block->prev_free != NULL) {
+    block->prev_free->next_free = block->next_free;
+  } else {
+    mgr->free_lists[fl][sl] = block->next_free;
+    if (block->next_free == NULL) {
+      mgr->sl_bitmap[fl] &= ~((uint32_t)1 << sl);
+      if (mgr->sl_bitmap[fl] == 0) {
+        mgr->fl_bitmap &= ~((uint32_t)1 << fl);
+      }
+    }
+  }
+}
+
+/*! \brief Find a free block of at least size bytes, in a list of which all blocks are. */
+static TLSFBlock* TLSF_FindFree(TLSFMemoryManager* mgr, size_t size) {
+  int fl, sl;
+  if (size >= ((size_t)1 << TLSF_FL_SHIFT)) {
+    size += ((size_t)1 << (TLSF_Fls(size) - TVM_CRT_TLSF_SL_LOG2)) - 1;
+  }
+  TLSF_Mapping(size, &fl, &sl);
+  if (fl >= TLSF_FL_COUNT) {
+    return NULL;
+  }
+  uint32_t sl_map = mgr->sl_bitmap[fl] & (~(uint32_t)0 << sl);
+  if (sl_map == 0) {
+    uint32_t fl_map = mgr->fl_bitmap & (~(uint32_t)0 << (fl + 1));
+    if (fl_map == 0) {
+      return NULL;
+    }
+    fl = TLSF_Ffs(fl_map);
+    sl_map = mgr->sl_bitmap[fl];
+  }
+  sl = TLSF_Ffs(sl_map);
+  return mgr->free_lists[fl][sl];
+}
+
+tvm_crt_error_t TLSFMemoryManager_Allocate(MemoryManagerInterface* interface, size_t num_bytes,
+                                           DLDevice dev, void** out_ptr) {
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)interface;
+  *out_ptr = NULL;
+  if (num_bytes > TLSF_MAX_SIZE) {
+    return kTvmErrorPlatformNoMemory;
+  }
+  size_t size = TLSF_ROUND_UP(num_bytes);
+  if (size < TLSF_MIN_DATA_BYTES) {
+    size = TLSF_MIN_DATA_BYTES;
+  }
+  TLSFBlock* block = TLSF_FindFree(mgr, size);
+  if (block == NULL) {
+    // The blocks large enough can still be in the list of the size, before the rounding up
+    int fl, sl;
+    TLSF_Mapping(size, &fl, &sl);
+    block = fl < TLSF_FL_COUNT ? mgr->free_lists[fl][sl] : NULL;
+    while (block != NULL && TLSF_BlockSize(block) < size) {
+      block = block->next_free;
+    }
+    if (block == NULL) {
+      return kTvmErrorPlatformNoMemory;
+    }
+  }
+  TLSF_RemoveFree(mgr, block);
+
+  // Return the end of the block to the pool, when it can hold a block
+  size_t block_size = TLSF_BlockSize(block);
+  if (block_size - size >= TLSF_HEADER_BYTES + TLSF_MIN_DATA_BYTES) {
+    TLSFBlock* rest = (TLSFBlock*)(TLSF_BlockData(block) + size);
+    rest->size = (block_size - size - TLSF_HEADER_BYTES) | TLSF_BLOCK_FREE;
+    block->size = size | (block->size & TLSF_BLOCK_PREV_FREE);
+    TLSF_BlockNext(rest)->prev_phys = rest;
+    TLSF_InsertFree(mgr, rest);
+  }
+  block->size &= ~TLSF_BLOCK_FREE;
+  TLSF_BlockNext(block)->size &= ~TLSF_BLOCK_PREV_FREE;
+
+  mgr->used_bytes += TLSF_BlockSize(block);
+  if (mgr->used_bytes > mgr->peak_used_bytes) {
+    mgr->peak_used_bytes = mgr->used_bytes;
+  }
+  mgr->interface.vleak_size++;
+  *out_ptr = TLSF_BlockData(block);
+  return kTvmErrorNoError;
+}
+
+tvm_crt_error_t TLSFMemoryManager_Free(MemoryManagerInterface* interface, void* ptr,
+                                       DLDevice dev) {
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)interface;
+  uint8_t* data = (uint8_t*)ptr;
+  if (data < mgr->blocks_begin + TLSF_HEADER_BYTES || data >= mgr->blocks_end ||
+      (size_t)(data - mgr->blocks_begin) % TLSF_ALIGN != 0) {
+    return kTvmErrorPlatformMemoryBadFree;
+  }
+  TLSFBlock* block = (TLSFBlock*)(data - TLSF_HEADER_BYTES);
+  if ((block->size & TLSF_BLOCK_FREE) != 0) {
+    return kTvmErrorPlatformMemoryBadFree;
+  }
+  mgr->used_bytes -= TLSF_BlockSize(block);
+  mgr->interface.vleak_size--;
+  // Marks the header, which is in the data of the merged block, to reject a second free
+  block->size |= TLSF_BLOCK_FREE;
+
+  if ((block->size & TLSF_BLOCK_PREV_FREE) != 0) {
+    TLSFBlock* prev = block->prev_phys;
+    TLSF_RemoveFree(mgr, prev);
+    prev->size += TLSF_HEADER_BYTES + TLSF_BlockSize(block);
+    block = prev;
+  }
+  TLSFBlock* next = TLSF_BlockNext(block);
+  if ((next->size & TLSF_BLOCK_FREE) != 0) {
+    TLSF_RemoveFree(mgr, next);
+    block->size += TLSF_HEADER_BYTES + TLSF_BlockSize(next);
+    next = TLSF_BlockNext(block);
+  }
+  next->size |= TLSF_BLOCK_PREV_FREE;
+  next->prev_phys = block;
+  TLSF_InsertFree(mgr, block);
+  return kTvmErrorNoError;
+}
+
+tvm_crt_error_t TLSFMemoryManager_GetStats(MemoryManagerInterface* interface,
+                                           MemoryManagerStats* stats) {
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)interface;
+  stats->total_bytes = mgr->total_bytes;
+  stats->used_bytes = mgr->used_bytes;
+  stats->peak_used_bytes = mgr->peak_used_bytes;
+  stats->num_allocations = (size_t)mgr->interface.vleak_size;
+  stats->largest_free_bytes = 0;
+  if (mgr->fl_bitmap != 0) {
+    // The largest block is in the last list that is not empty
+    int fl = TLSF_Fls(mgr->fl_bitmap);
+    int sl = TLSF_Fls(mgr->sl_bitmap[fl]);
+    for (TLSFBlock* block = mgr->free_lists[fl][sl]; block != NULL; block = block->next_free) {
+      if (TLSF_BlockSize(block) > stats->largest_free_bytes) {
+        stats->largest_free_bytes = TLSF_BlockSize(block);
+      }
+    }
+  }
+  return kTvmErrorNoError;
+}
+
+tvm_crt_error_t TLSFMemoryManagerCreate(MemoryManagerInterface** interface, uint8_t* memory_pool,
+                                        size_t memory_pool_size_bytes) {
+  uint8_t* pool_end = memory_pool + memory_pool_size_bytes;
+  uint8_t* begin = (uint8_t*)TLSF_ROUND_UP((uintptr_t)memory_pool);
+  size_t manager_bytes = TLSF_ROUND_UP(sizeof(TLSFMemoryManager));
+  size_t overhead_bytes = manager_bytes + 2 * TLSF_HEADER_BYTES + TLSF_MIN_DATA_BYTES;
+  if (begin > pool_end || (size_t)(pool_end - begin) < overhead_bytes) {
+    return kTvmErrorPlatformNoMemory;
+  }
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)begin;
+  memset(mgr, 0, sizeof(TLSFMemoryManager));
+  mgr->interface.Allocate = TLSFMemoryManager_Allocate;
+  mgr->interface.Free = TLSFMemoryManager_Free;
+  mgr->interface.GetStats = TLSFMemoryManager_GetStats;
+
+  // One free block spans the pool, and is followed by a used header of size 0
+  uint8_t* blocks = begin + manager_bytes;
+  size_t data_bytes = (size_t)(pool_end - blocks) / TLSF_ALIGN * TLSF_ALIGN - 2 * TLSF_HEADER_BYTES;
+  if (data_bytes > TLSF_MAX_SIZE) {
+    data_bytes = TLSF_MAX_SIZE;
+  }
+  TLSFBlock* first = (TLSFBlock*)blocks;
+  first->prev_phys = NULL;
+  first->size = data_bytes | TLSF_BLOCK_FREE;
+  TLSFBlock* sentinel = TLSF_BlockNext(first);
+  sentinel->prev_phys = first;
+  sentinel->size = TLSF_BLOCK_PREV_FREE;
+  TLSF_InsertFree(mgr, first);
+
+  mgr->blocks_begin = blocks;
+  mgr->blocks_end = (uint8_t*)sentinel;
+  mgr->total_bytes = data_bytes;
+  *interface = &mgr->interface;
+  return kTvmErrorNoError;
+}
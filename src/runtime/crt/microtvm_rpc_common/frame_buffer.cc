@@ -54,6 +54,17 @@ size_t FrameBuffer::Read(uint8_t* data, size_t data_size_bytes) {
   return num_bytes_to_copy;
 }
 
+size_t FrameBuffer::Peek(uint8_t* data, size_t data_size_bytes) {
+  size_t num_bytes_to_copy = data_size_bytes;
+  size_t num_bytes_available = num_valid_bytes_ - read_cursor_;
+  if (num_bytes_available < num_bytes_to_copy) {
+    num_bytes_to_copy = num_bytes_available;
+  }
+
+  memcpy(data, &data_[read_cursor_], num_bytes_to_copy);
+  return num_bytes_to_copy;
+}
+
 void FrameBuffer::Clear() {
   num_valid_bytes_ = 0;
   read_cursor_ = 0;
@@ -25,6 +25,8 @@
 #include <tvm/runtime/crt/logging.h>
 #include <tvm/runtime/crt/rpc_common/session.h>
 
+#include <string.h>
+
 #include "crt_config.h"
 
 namespace tvm {
@@ -115,20 +117,77 @@ tvm_crt_error_t Session::SendMessage(MessageType message_type, const uint8_t* me
   return SendInternal(message_type, message_data, message_size_bytes);
 }
 
+void Session::StreamMessageBody(uint8_t* data, size_t size_bytes) {
+  stream_data_ = data;
+  stream_size_bytes_ = size_bytes;
+  stream_written_bytes_ = 0;
+  stream_read_bytes_ = 0;
+}
+
+size_t Session::ReadStreamedMessageBody(uint8_t* data, size_t size_bytes) {
+  if (stream_data_ == nullptr || data != stream_data_ + stream_read_bytes_) {
+    return 0;
+  }
+  size_t num_bytes = stream_written_bytes_ - stream_read_bytes_;
+  if (num_bytes > size_bytes) {
+    num_bytes = size_bytes;
+  }
+  stream_read_bytes_ += num_bytes;
+  return num_bytes;
+}
+
+bool Session::SessionReceiver::IsNormalMessage() {
+  SessionHeader header;
+  if (session_->receive_buffer_->Peek(reinterpret_cast<uint8_t*>(&header), sizeof(header)) !=
+      sizeof(header)) {
+    return false;
+  }
+  return header.message_type == MessageType::kNormal &&
+         session_->state_ == State::kSessionEstablished &&
+         header.session_id == session_->session_id_;
+}
+
 ssize_t Session::SessionReceiver::Write(const uint8_t* data, size_t data_size_bytes) {
   if (session_->receive_buffer_has_complete_message_) {
     return kTvmErrorSessionReceiveBufferBusy;
   }
 
-  size_t bytes_written = session_->receive_buffer_->Write(data, data_size_bytes);
-  if (bytes_written != data_size_bytes) {
-    return kTvmErrorSessionReceiveBufferShortWrite;
+  size_t bytes_written = 0;
+  while (bytes_written < data_size_bytes) {
+    size_t num_bytes = data_size_bytes - bytes_written;
+    if (session_->stream_written_bytes_ < session_->stream_size_bytes_) {
+      size_t stream_available_bytes = session_->stream_size_bytes_ - session_->stream_written_bytes_;
+      if (num_bytes > stream_available_bytes) {
+        num_bytes = stream_available_bytes;
+      }
+      memcpy(session_->stream_data_ + session_->stream_written_bytes_, data + bytes_written,
+             num_bytes);
+      session_->stream_written_bytes_ += num_bytes;
+      bytes_written += num_bytes;
+      continue;
+    }
+
+    num_bytes = session_->receive_buffer_->Write(data + bytes_written, num_bytes);
+    bytes_written += num_bytes;
+    if (session_->message_chunk_received_func_ != nullptr && session_->stream_data_ == nullptr &&
+        IsNormalMessage()) {
+      session_->message_chunk_received_func_(session_->message_chunk_received_func_context_,
+                                             session_->receive_buffer_);
+    }
+    if (num_bytes == 0 && session_->stream_written_bytes_ == session_->stream_size_bytes_) {
+      return kTvmErrorSessionReceiveBufferShortWrite;
+    }
   }
 
   return bytes_written;
 }
 
 void Session::SessionReceiver::PacketDone(bool is_valid) {
+  HandlePacket(is_valid);
+  session_->StreamMessageBody(nullptr, 0);
+}
+
+void Session::SessionReceiver::HandlePacket(bool is_valid) {
   if (!is_valid) {
     return;
   }
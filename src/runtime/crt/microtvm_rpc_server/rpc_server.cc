@@ -26,6 +26,7 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/types.h>
 
 // NOTE: dmlc/base.h contains some declarations that are incompatible with some C embedded
@@ -71,7 +72,12 @@ class MicroIOHandler {
   void MessageDone() { CHECK_EQ(session_->FinishMessage(), kTvmErrorNoError, "FinishMessage"); }
 
   ssize_t PosixRead(uint8_t* buf, size_t buf_size_bytes) {
-    return receive_buffer_->Read(buf, buf_size_bytes);
+    size_t bytes_read = receive_buffer_->Read(buf, buf_size_bytes);
+    if (bytes_read == 0) {
+      // The rest of a copy to the CPU is already in place
+      bytes_read = session_->ReadStreamedMessageBody(buf, buf_size_bytes);
+    }
+    return bytes_read;
   }
 
   void Close() {}
@@ -117,7 +123,9 @@ class MicroRPCServer {
         io_{&session_, &receive_buffer_},
         unframer_{session_.Receiver()},
         rpc_server_{&io_},
-        is_running_{true} {}
+        is_running_{true} {
+    session_.SetMessageChunkReceivedFunc(&HandleMessageChunkCb, this);
+  }
 
   void Initialize() {
     uint8_t initial_session_nonce = Session::kInvalidNonce;
@@ -186,6 +194,61 @@ class MicroRPCServer {
   static void HandleCompleteMessageCb(void* context, MessageType message_type, FrameBuffer* buf) {
     static_cast<MicroRPCServer*>(context)->HandleCompleteMessage(message_type, buf);
   }
+
+  /*! \brief The largest ndim of the tensors whose copies are streamed. */
+  static constexpr const int kMaxStreamedCopyNdim = 8;
+
+  /*!
+   * \brief Stream the data of a copy to the CPU memory to its destination, once the packet header
+   * written by RPCEndpoint::CopyToRemote is received, so that the copy can exceed the receive buffer.
+   */
+  void HandleMessageChunk(FrameBuffer* buf) {
+    // session header, packet length, code, data, device, ndim, dtype, shape, byte_offset, num_bytes
+    constexpr size_t kNdimOffset = sizeof(SessionHeader) + sizeof(uint64_t) + sizeof(RPCCode) +
+                                   sizeof(uint64_t) + sizeof(DLDevice);
+    uint8_t header[kNdimOffset + sizeof(int32_t) + sizeof(DLDataType) +
+                   kMaxStreamedCopyNdim * sizeof(int64_t) + 2 * sizeof(uint64_t)];
+    size_t size_bytes = buf->Peek(header, sizeof(header));
+    if (size_bytes < kNdimOffset + sizeof(int32_t)) {
+      return;
+    }
+    uint64_t packet_len;
+    RPCCode code;
+    uint64_t data_handle;
+    DLDevice device;
+    int32_t ndim;
+    memcpy(&packet_len, header + sizeof(SessionHeader), sizeof(packet_len));
+    memcpy(&code, header + sizeof(SessionHeader) + sizeof(packet_len), sizeof(code));
+    memcpy(&data_handle, header + kNdimOffset - sizeof(DLDevice) - sizeof(data_handle),
+           sizeof(data_handle));
+    memcpy(&device, header + kNdimOffset - sizeof(DLDevice), sizeof(device));
+    memcpy(&ndim, header + kNdimOffset, sizeof(ndim));
+    if (code != RPCCode::kCopyToRemote || device.device_type != kDLCPU || ndim < 0 ||
+        ndim > kMaxStreamedCopyNdim) {
+      return;
+    }
+    size_t header_size_bytes = kNdimOffset + sizeof(int32_t) + sizeof(DLDataType) +
+                               ndim * sizeof(int64_t) + 2 * sizeof(uint64_t);
+    if (size_bytes < header_size_bytes) {
+      return;
+    }
+    uint64_t byte_offset;
+    uint64_t num_bytes;
+    memcpy(&byte_offset, header + header_size_bytes - 2 * sizeof(uint64_t), sizeof(byte_offset));
+    memcpy(&num_bytes, header + header_size_bytes - sizeof(uint64_t), sizeof(num_bytes));
+    size_t body_size_bytes = buf->Size() - header_size_bytes;
+    if (packet_len != header_size_bytes - sizeof(SessionHeader) - sizeof(packet_len) + num_bytes ||
+        body_size_bytes > num_bytes) {
+      return;
+    }
+    // The start of the data, received with the header, is read from the receive buffer
+    uint8_t* data = reinterpret_cast<uint8_t*>(data_handle) + byte_offset + body_size_bytes;
+    session_.StreamMessageBody(data, num_bytes - body_size_bytes);
+  }
+
+  static void HandleMessageChunkCb(void* context, FrameBuffer* buf) {
+    static_cast<MicroRPCServer*>(context)->HandleMessageChunk(buf);
+  }
 };
 
 }  // namespace micro_rpc
@@ -196,6 +259,14 @@ extern "C" {
 
 static microtvm_rpc_server_t g_rpc_server = nullptr;
 
+// Tells the host that the copies to the CPU memory can be larger than the packets.
+static int RPCCanStreamCopyToRemote(TVMValue* args, int* type_codes, int num_args,
+                                    TVMValue* ret_value, int* ret_type_codes) {
+  ret_value[0].v_int64 = 1;
+  ret_type_codes[0] = kTVMArgInt;
+  return 0;
+}
+
 microtvm_rpc_server_t MicroTVMRpcServerInit(microtvm_rpc_channel_write_t write_func,
                                             void* write_func_ctx) {
   tvm::runtime::micro_rpc::g_write_func = write_func;
@@ -211,6 +282,13 @@ microtvm_rpc_server_t MicroTVMRpcServerInit(microtvm_rpc_channel_write_t write_f
     TVMPlatformAbort(err);
   }
 
+  err = static_cast<tvm_crt_error_t>(
+      TVMFuncRegisterGlobal("tvm.rpc.server.CanStreamCopyToRemote",
+                            (TVMFunctionHandle)&RPCCanStreamCopyToRemote, 0));
+  if (err != kTvmErrorNoError) {
+    TVMPlatformAbort(err);
+  }
+
   DLDevice dev = {kDLCPU, 0};
   void* receive_buffer_memory;
   err = TVMPlatformMemoryAllocate(TVM_CRT_MAX_PACKET_SIZE_BYTES, dev, &receive_buffer_memory);
@@ -63,6 +63,18 @@ class CUDAThreadEntry {
   // get the threadlocal workspace
   static CUDAThreadEntry* ThreadLocal();
 };
+
+/*!
+ * \brief Describe the current device, in the keys of the caches of the tuned library algorithms.
+ * \return The name and the compute capability of the device.
+ */
+inline std::string GetCUDADeviceKey() {
+  int device_id;
+  CUDA_CALL(cudaGetDevice(&device_id));
+  cudaDeviceProp prop;
+  CUDA_CALL(cudaGetDeviceProperties(&prop, device_id));
+  return std::string(prop.name) + "-sm_" + std::to_string(prop.major) + std::to_string(prop.minor);
+}
 }  // namespace runtime
 }  // namespace tvm
 #endif  // TVM_RUNTIME_CUDA_CUDA_COMMON_H_
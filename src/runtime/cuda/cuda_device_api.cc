@@ -28,10 +28,25 @@
 #include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "cuda_common.h"
 
+// Stream-ordered memory pools are available since CUDA 11.2
+#if CUDART_VERSION >= 11020
+#define TVM_CUDA_HAS_MEMPOOL 1
+#else
+#define TVM_CUDA_HAS_MEMPOOL 0
+#endif
+
 namespace tvm {
 namespace runtime {
 
@@ -116,6 +131,13 @@ class CUDADeviceAPI final : public DeviceAPI {
       CUDA_CALL(cudaMallocHost(&ret, nbytes));
     } else {
       CUDA_CALL(cudaSetDevice(dev.device_id));
+#if TVM_CUDA_HAS_MEMPOOL
+      if (UseMemPool(dev.device_id)) {
+        VLOG(1) << "allocating " << nbytes << " bytes on device from the memory pool";
+        CUDA_CALL(cudaMallocAsync(&ret, nbytes, CUDAThreadEntry::ThreadLocal()->stream));
+        return ret;
+      }
+#endif
       size_t free_mem, total_mem;
       CUDA_CALL(cudaMemGetInfo(&free_mem, &total_mem));
       VLOG(1) << "allocating " << nbytes << " bytes on device, with " << free_mem
@@ -132,6 +154,14 @@ class CUDADeviceAPI final : public DeviceAPI {
     } else {
       CUDA_CALL(cudaSetDevice(dev.device_id));
       VLOG(1) << "freeing device memory";
+#if TVM_CUDA_HAS_MEMPOOL
+      if (UseMemPool(dev.device_id)) {
+        cudaStream_t stream = CUDAThreadEntry::ThreadLocal()->stream;
+        WaitForOtherStreams(dev.device_id, stream);
+        CUDA_CALL(cudaFreeAsync(ptr, stream));
+        return;
+      }
+#endif
       CUDA_CALL(cudaFree(ptr));
     }
   }
@@ -163,7 +193,7 @@ class CUDADeviceAPI final : public DeviceAPI {
       if (dev_from.device_id == dev_to.device_id) {
         GPUCopy(from, to, size, cudaMemcpyDeviceToDevice, cu_stream);
       } else {
-        cudaMemcpyPeerAsync(to, dev_to.device_id, from, dev_from.device_id, size, cu_stream);
+        PeerCopy(from, dev_from.device_id, to, dev_to.device_id, size, cu_stream);
       }
     } else if (dev_from.device_type == kDLCUDA && dev_to.device_type == kDLCPU) {
       CUDA_CALL(cudaSetDevice(dev_from.device_id));
@@ -187,6 +217,13 @@ class CUDADeviceAPI final : public DeviceAPI {
   void FreeStream(Device dev, TVMStreamHandle stream) {
     CUDA_CALL(cudaSetDevice(dev.device_id));
     cudaStream_t cu_stream = static_cast<cudaStream_t>(stream);
+#if TVM_CUDA_HAS_MEMPOOL
+    {
+      std::lock_guard<std::mutex> lock(mempool_mutex_);
+      std::vector<cudaStream_t>& streams = pool_streams_[dev.device_id];
+      streams.erase(std::remove(streams.begin(), streams.end(), cu_stream), streams.end());
+    }
+#endif
     CUDA_CALL(cudaStreamDestroy(cu_stream));
   }
 
@@ -206,8 +243,56 @@ class CUDADeviceAPI final : public DeviceAPI {
     CUDA_CALL(cudaStreamSynchronize(static_cast<cudaStream_t>(stream)));
   }
 
+  void* RecordEvent(Device dev, TVMStreamHandle stream) final {
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    cudaStream_t cu_stream = stream != nullptr ? static_cast<cudaStream_t>(stream)
+                                               : CUDAThreadEntry::ThreadLocal()->stream;
+    cudaEvent_t evt;
+    CUDA_CALL(cudaEventCreateWithFlags(&evt, cudaEventDisableTiming));
+    CUDA_CALL(cudaEventRecord(evt, cu_stream));
+    return static_cast<void*>(evt);
+  }
+
+  bool EventDone(Device dev, void* event) final {
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    cudaError_t status = cudaEventQuery(static_cast<cudaEvent_t>(event));
+    if (status == cudaErrorNotReady) return false;
+    CUDA_CALL(status);
+    return true;
+  }
+
+  void EventSync(Device dev, void* event) final {
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    CUDA_CALL(cudaEventSynchronize(static_cast<cudaEvent_t>(event)));
+  }
+
+  void StreamWaitEvent(Device dev, TVMStreamHandle stream, void* event) final {
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    cudaStream_t cu_stream = stream != nullptr ? static_cast<cudaStream_t>(stream)
+                                               : CUDAThreadEntry::ThreadLocal()->stream;
+    CUDA_CALL(cudaStreamWaitEvent(cu_stream, static_cast<cudaEvent_t>(event), 0));
+  }
+
+  void FreeEvent(Device dev, void* event) final {
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    CUDA_CALL(cudaEventDestroy(static_cast<cudaEvent_t>(event)));
+  }
+
   void SetStream(Device dev, TVMStreamHandle stream) final {
     CUDAThreadEntry::ThreadLocal()->stream = static_cast<cudaStream_t>(stream);
+#if TVM_CUDA_HAS_MEMPOOL
+    if (stream != nullptr) {
+      std::lock_guard<std::mutex> lock(mempool_mutex_);
+      std::vector<cudaStream_t>& streams = pool_streams_[dev.device_id];
+      if (std::find(streams.begin(), streams.end(), stream) == streams.end()) {
+        streams.push_back(static_cast<cudaStream_t>(stream));
+      }
+    }
+#endif
+  }
+
+  TVMStreamHandle GetCurrentStream(Device dev) final {
+    return static_cast<TVMStreamHandle>(CUDAThreadEntry::ThreadLocal()->stream);
   }
 
   void* AllocWorkspace(Device dev, size_t size, DLDataType type_hint) final {
@@ -225,7 +310,170 @@ class CUDADeviceAPI final : public DeviceAPI {
     return inst;
   }
 
+#if TVM_CUDA_HAS_MEMPOOL
+  /*!
+   * \brief Whether the device memory is allocated from the stream-ordered memory pool of the
+   *  device, i.e. with cudaMallocAsync/cudaFreeAsync on the current stream of the thread.
+   *  Opt-in with TVM_CUDA_STREAM_ORDERED_ALLOC=1, and only on devices supporting memory pools.
+   *  The choice is made once per device, so that a pointer is always freed the way it was
+   *  allocated.
+   * \note Freeing does not synchronize the host. The memory is returned to the pool on the
+   *  current stream, after the work submitted so far to the other streams set on the device, see
+   *  WaitForOtherStreams.
+   */
+  bool UseMemPool(int device_id) {
+    static const bool enabled = []() {
+      const char* val = getenv("TVM_CUDA_STREAM_ORDERED_ALLOC");
+      return val != nullptr && atoi(val) != 0;
+    }();
+    if (!enabled) return false;
+    std::lock_guard<std::mutex> lock(mempool_mutex_);
+    if (static_cast<size_t>(device_id) >= use_mempool_.size()) {
+      use_mempool_.resize(device_id + 1, -1);
+    }
+    if (use_mempool_[device_id] < 0) {
+      int supported = 0;
+      CUDA_CALL(cudaDeviceGetAttribute(&supported, cudaDevAttrMemoryPoolsSupported, device_id));
+      if (supported) {
+        const char* val = getenv("TVM_CUDA_MEMPOOL_RELEASE_THRESHOLD_MB");
+        if (val != nullptr) {
+          SetMemPoolReleaseThreshold(device_id, static_cast<uint64_t>(atoll(val)) << 20);
+        } else {
+          // Keep the freed memory in the pool rather than returning it at each synchronization.
+          SetMemPoolReleaseThreshold(device_id, std::numeric_limits<uint64_t>::max());
+        }
+      } else {
+        LOG(WARNING) << "CUDA device " << device_id
+                     << " does not support memory pools, fall back to cudaMalloc";
+      }
+      use_mempool_[device_id] = supported ? 1 : 0;
+    }
+    return use_mempool_[device_id] == 1;
+  }
+
+  /*!
+   * \brief Make a stream wait for the work submitted so far to the other streams of a device, on
+   *  which a buffer about to be freed on the stream may still be in use, so that the pool does not
+   *  hand out its memory before that work completed.
+   *
+   *  The other streams are the legacy default stream and the streams set on the threads with
+   *  SetStream. The legacy default stream and the blocking streams are already ordered with each
+   *  other by CUDA, so only the other pairs wait on an event, and a device on which a single
+   *  stream is used pays nothing.
+   */
+  void WaitForOtherStreams(int device_id, cudaStream_t stream) {
+    auto is_blocking = [](cudaStream_t s) {
+      unsigned int flags = 0;
+      CUDA_CALL(cudaStreamGetFlags(s, &flags));
+      return (flags & cudaStreamNonBlocking) == 0;
+    };
+    std::vector<cudaStream_t> others{nullptr};
+    {
+      std::lock_guard<std::mutex> lock(mempool_mutex_);
+      const std::vector<cudaStream_t>& streams = pool_streams_[device_id];
+      others.insert(others.end(), streams.begin(), streams.end());
+    }
+    bool blocking = stream != nullptr && is_blocking(stream);
+    for (cudaStream_t other : others) {
+      if (other == stream) continue;
+      bool implicit = stream == nullptr ? is_blocking(other) : other == nullptr && blocking;
+      if (implicit) continue;
+      cudaEvent_t evt;
+      CUDA_CALL(cudaEventCreateWithFlags(&evt, cudaEventDisableTiming));
+      CUDA_CALL(cudaEventRecord(evt, other));
+      CUDA_CALL(cudaStreamWaitEvent(stream, evt, 0));
+      CUDA_CALL(cudaEventDestroy(evt));
+    }
+  }
+
+  /*!
+   * \brief Set the bytes the memory pool of a device holds on to when synchronizing,
+   *  the memory beyond that is returned to the OS.
+   */
+  static void SetMemPoolReleaseThreshold(int device_id, uint64_t threshold) {
+    cudaMemPool_t pool;
+    CUDA_CALL(cudaDeviceGetDefaultMemPool(&pool, device_id));
+    CUDA_CALL(cudaMemPoolSetAttribute(pool, cudaMemPoolAttrReleaseThreshold, &threshold));
+  }
+#endif
+
  private:
+  /*!
+   * \brief Copy between two CUDA devices, over the peer link when the devices support it.
+   *
+   *  Without a stream, from the caller or set on the thread, the copy is issued on the copy
+   *  stream of the destination device instead of the legacy default stream, on which it would be
+   *  serialized with the work of every blocking stream of both devices. Events order it after
+   *  the pending work of the default streams of both devices, and make both default streams wait
+   *  for its completion, so it is observed as if it ran on them.
+   */
+  void PeerCopy(const void* from, int from_id, void* to, int to_id, size_t size,
+                cudaStream_t stream) {
+    EnablePeerAccess(to_id, from_id);
+    EnablePeerAccess(from_id, to_id);
+    if (stream != nullptr || CUDAThreadEntry::ThreadLocal()->stream != nullptr) {
+      CUDA_CALL(cudaSetDevice(from_id));
+      CUDA_CALL(cudaMemcpyPeerAsync(to, to_id, from, from_id, size, stream));
+      return;
+    }
+    cudaStream_t copy_stream = GetCopyStream(to_id);
+    cudaEvent_t src_ready, dst_ready, done;
+    CUDA_CALL(cudaSetDevice(from_id));
+    CUDA_CALL(cudaEventCreateWithFlags(&src_ready, cudaEventDisableTiming));
+    CUDA_CALL(cudaEventRecord(src_ready, nullptr));
+    CUDA_CALL(cudaSetDevice(to_id));
+    CUDA_CALL(cudaEventCreateWithFlags(&dst_ready, cudaEventDisableTiming));
+    CUDA_CALL(cudaEventCreateWithFlags(&done, cudaEventDisableTiming));
+    CUDA_CALL(cudaEventRecord(dst_ready, nullptr));
+    CUDA_CALL(cudaStreamWaitEvent(copy_stream, src_ready, 0));
+    CUDA_CALL(cudaStreamWaitEvent(copy_stream, dst_ready, 0));
+    CUDA_CALL(cudaMemcpyPeerAsync(to, to_id, from, from_id, size, copy_stream));
+    CUDA_CALL(cudaEventRecord(done, copy_stream));
+    // The destination is read, and the source may be overwritten, once the copy completes
+    CUDA_CALL(cudaStreamWaitEvent(nullptr, done, 0));
+    CUDA_CALL(cudaSetDevice(from_id));
+    CUDA_CALL(cudaStreamWaitEvent(nullptr, done, 0));
+    CUDA_CALL(cudaEventDestroy(src_ready));
+    CUDA_CALL(cudaEventDestroy(dst_ready));
+    CUDA_CALL(cudaEventDestroy(done));
+  }
+
+  /*! \brief Let the device access the memory of the peer, once, if the hardware supports it. */
+  void EnablePeerAccess(int device_id, int peer_id) {
+    std::lock_guard<std::mutex> lock(peer_mutex_);
+    if (!peer_checked_.insert({device_id, peer_id}).second) {
+      return;
+    }
+    int can_access = 0;
+    CUDA_CALL(cudaDeviceCanAccessPeer(&can_access, device_id, peer_id));
+    if (!can_access) {
+      VLOG(1) << "CUDA device " << device_id << " cannot access peer " << peer_id
+              << ", the copies are staged through the host";
+      return;
+    }
+    CUDA_CALL(cudaSetDevice(device_id));
+    cudaError_t e = cudaDeviceEnablePeerAccess(peer_id, 0);
+    if (e == cudaErrorPeerAccessAlreadyEnabled) {
+      // Enabled by the application, clear the error
+      cudaGetLastError();
+    } else {
+      CUDA_CALL(e);
+    }
+  }
+
+  /*! \brief Get the non-blocking stream of the device for the copies between devices. */
+  cudaStream_t GetCopyStream(int device_id) {
+    std::lock_guard<std::mutex> lock(peer_mutex_);
+    if (static_cast<size_t>(device_id) >= copy_streams_.size()) {
+      copy_streams_.resize(device_id + 1, nullptr);
+    }
+    if (copy_streams_[device_id] == nullptr) {
+      CUDA_CALL(cudaSetDevice(device_id));
+      CUDA_CALL(cudaStreamCreateWithFlags(&copy_streams_[device_id], cudaStreamNonBlocking));
+    }
+    return copy_streams_[device_id];
+  }
+
   static void GPUCopy(const void* from, void* to, size_t size, cudaMemcpyKind kind,
                       cudaStream_t stream) {
     if (stream != nullptr) {
@@ -234,6 +482,21 @@ class CUDADeviceAPI final : public DeviceAPI {
       CUDA_CALL(cudaMemcpy(to, from, size, kind));
     }
   }
+
+  /*! \brief Guards the peer access and the copy streams. */
+  std::mutex peer_mutex_;
+  /*! \brief The (device, peer) pairs whose peer access was checked. */
+  std::set<std::pair<int, int>> peer_checked_;
+  /*! \brief Per device, the stream of the copies between devices, created on first use. */
+  std::vector<cudaStream_t> copy_streams_;
+
+#if TVM_CUDA_HAS_MEMPOOL
+  std::mutex mempool_mutex_;
+  /*! \brief Per device, -1 if not decided yet, 1 if allocating from the memory pool. */
+  std::vector<int> use_mempool_;
+  /*! \brief Per device, the streams set on the threads, which the pooled buffers may be used on. */
+  std::unordered_map<int, std::vector<cudaStream_t>> pool_streams_;
+#endif
 };
 
 typedef dmlc::ThreadLocalStore<CUDAThreadEntry> CUDAThreadStore;
@@ -300,5 +563,32 @@ TVM_DLL String GetCudaFreeMemory() {
 
 TVM_REGISTER_GLOBAL("runtime.GetCudaFreeMemory").set_body_typed(GetCudaFreeMemory);
 
+#if TVM_CUDA_HAS_MEMPOOL
+TVM_REGISTER_GLOBAL("runtime.CUDAMemPoolSetReleaseThreshold")
+    .set_body_typed([](int device_id, int64_t threshold) {
+      CUDADeviceAPI::SetMemPoolReleaseThreshold(device_id, static_cast<uint64_t>(threshold));
+    });
+
+TVM_REGISTER_GLOBAL("runtime.CUDAMemPoolTrim").set_body_typed([](int device_id, int64_t keep) {
+  cudaMemPool_t pool;
+  CUDA_CALL(cudaDeviceGetDefaultMemPool(&pool, device_id));
+  CUDA_CALL(cudaMemPoolTrimTo(pool, static_cast<size_t>(keep)));
+});
+
+TVM_REGISTER_GLOBAL("runtime.CUDAMemPoolUsage").set_body_typed([](int device_id) {
+  cudaMemPool_t pool;
+  CUDA_CALL(cudaDeviceGetDefaultMemPool(&pool, device_id));
+  auto count = [pool](cudaMemPoolAttr attr) {
+    uint64_t value = 0;
+    CUDA_CALL(cudaMemPoolGetAttribute(pool, attr, &value));
+    return ObjectRef(make_object<profiling::CountNode>(static_cast<int64_t>(value)));
+  };
+  return Map<String, ObjectRef>{{"reserved_bytes", count(cudaMemPoolAttrReservedMemCurrent)},
+                                {"peak_reserved_bytes", count(cudaMemPoolAttrReservedMemHigh)},
+                                {"used_bytes", count(cudaMemPoolAttrUsedMemCurrent)},
+                                {"peak_used_bytes", count(cudaMemPoolAttrUsedMemHigh)}};
+});
+#endif
+
 }  // namespace runtime
 }  // namespace tvm
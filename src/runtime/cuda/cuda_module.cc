@@ -26,12 +26,21 @@
 #include <cuda_runtime.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
 #include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iterator>
 #include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include "../../support/utils.h"
 #include "../file_utils.h"
 #include "../meta_data.h"
 #include "../pack_args.h"
@@ -41,10 +50,77 @@
 namespace tvm {
 namespace runtime {
 
+namespace {
+
+/*!
+ * \brief Get the file caching the cubin linked from a PTX module.
+ * \param device_id The device the PTX is compiled for.
+ * \param ptx The PTX of the module.
+ * \return The path of the cached cubin, or an empty string if the cache is disabled.
+ */
+std::string GetJITCacheFile(int device_id, const std::string& ptx) {
+  const char* cache_dir = std::getenv("TVM_CUDA_JIT_CACHE_DIR");
+  if (cache_dir == nullptr || *cache_dir == '\0') {
+    return "";
+  }
+  CUdevice dev;
+  int major, minor, driver_version;
+  CUDA_DRIVER_CALL(cuDeviceGet(&dev, device_id));
+  CUDA_DRIVER_CALL(
+      cuDeviceGetAttribute(&major, CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MAJOR, dev));
+  CUDA_DRIVER_CALL(
+      cuDeviceGetAttribute(&minor, CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MINOR, dev));
+  CUDA_DRIVER_CALL(cuDriverGetVersion(&driver_version));
+  std::ostringstream key;
+  key << ptx << '\0' << driver_version;
+  std::ostringstream os;
+  os << cache_dir << "/" << std::hex << std::hash<std::string>()(key.str()) << std::dec << "-sm_"
+     << major << minor << ".cubin";
+  return os.str();
+}
+
+/*! \brief Compile PTX to a cubin for the device of the current context. */
+std::string LinkPTX(const std::string& ptx) {
+  CUlinkState state;
+  CUDA_DRIVER_CALL(cuLinkCreate(0, nullptr, nullptr, &state));
+  CUDA_DRIVER_CALL(cuLinkAddData(state, CU_JIT_INPUT_PTX, const_cast<char*>(ptx.c_str()),
+                                 ptx.length() + 1, "tvm_kernels", 0, nullptr, nullptr));
+  void* cubin;
+  size_t size;
+  CUDA_DRIVER_CALL(cuLinkComplete(state, &cubin, &size));
+  // The cubin is owned by the link state
+  std::string data(static_cast<const char*>(cubin), size);
+  CUDA_DRIVER_CALL(cuLinkDestroy(state));
+  return data;
+}
+
+/*! \brief Save a cubin to the JIT cache. */
+void SaveCachedCubin(const std::string& cubin, const std::string& file_name) {
+  // Write to a temporary file first, so that another process never reads a partial binary.
+  std::ostringstream os;
+  os << file_name << ".tmp" << std::hash<std::thread::id>()(std::this_thread::get_id());
+  std::string tmp_file = os.str();
+  {
+    std::ofstream fs(tmp_file, std::ios::out | std::ios::binary);
+    fs.write(cubin.data(), cubin.size());
+    if (fs.fail()) {
+      LOG(WARNING) << "Cannot write the CUDA JIT cache file " << tmp_file;
+      fs.close();
+      std::remove(tmp_file.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_file.c_str(), file_name.c_str()) != 0) {
+    std::remove(tmp_file.c_str());
+  }
+}
+
+}  // namespace
+
 // Module to support thread-safe multi-GPU execution.
 // cuModule is a per-GPU module
 // The runtime will contain a per-device module table
-// The modules will be lazily loaded
+// The modules will be lazily loaded, unless TVM_CUDA_EAGER_MODULE_LOAD is set
 class CUDAModuleNode : public runtime::ModuleNode {
  public:
   explicit CUDAModuleNode(std::string data, std::string fmt,
@@ -107,7 +183,7 @@ class CUDAModuleNode : public runtime::ModuleNode {
     std::lock_guard<std::mutex> lock(mutex_);
     // must recheck under the lock scope
     if (module_[device_id] == nullptr) {
-      CUDA_DRIVER_CALL(cuModuleLoadData(&(module_[device_id]), data_.c_str()));
+      LoadModule(device_id);
     }
     CUfunction func;
     CUresult result = cuModuleGetFunction(&func, module_[device_id], func_name.c_str());
@@ -123,7 +199,7 @@ class CUDAModuleNode : public runtime::ModuleNode {
     std::lock_guard<std::mutex> lock(mutex_);
     // must recheck under the lock scope
     if (module_[device_id] == nullptr) {
-      CUDA_DRIVER_CALL(cuModuleLoadData(&(module_[device_id]), data_.c_str()));
+      LoadModule(device_id);
     }
     CUdeviceptr global;
     size_t nbytes;
@@ -138,7 +214,72 @@ class CUDAModuleNode : public runtime::ModuleNode {
     return global;
   }
 
+  /*!
+   * \brief Load the module on all the devices at once, each on its own thread.
+   * \note It is safe only before the module is shared, as the lock is not held.
+   */
+  void LoadAllDevices() {
+    int num_devices = 0;
+    if (cudaGetDeviceCount(&num_devices) != cudaSuccess) {
+      // No device is visible, e.g. when building on a machine without GPUs.
+      cudaGetLastError();
+      return;
+    }
+    num_devices = std::min(num_devices, static_cast<int>(kMaxNumGPUs));
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> errors(num_devices);
+    for (int i = 0; i < num_devices; ++i) {
+      threads.emplace_back([this, i, &errors]() {
+        try {
+          CUDA_CALL(cudaSetDevice(i));
+          // Create the primary context of the device
+          CUDA_CALL(cudaFree(nullptr));
+          LoadModule(i);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+      if (error) std::rethrow_exception(error);
+    }
+  }
+
  private:
+  /*!
+   * \brief Load the module in the current context, which is the one of device_id.
+   *
+   * A PTX module is compiled by the driver. When TVM_CUDA_JIT_CACHE_DIR is set, the cubin is
+   * cached in that directory, keyed by the PTX, the compute capability and the driver version.
+   */
+  void LoadModule(int device_id) {
+    if (fmt_ == "ptx") {
+      std::string cache_file = GetJITCacheFile(device_id, data_);
+      if (!cache_file.empty()) {
+        std::string cubin;
+        std::ifstream fs(cache_file, std::ios::in | std::ios::binary);
+        if (!fs.fail()) {
+          cubin.assign(std::istreambuf_iterator<char>(fs), std::istreambuf_iterator<char>());
+        }
+        // A stale, or corrupted, binary fails to load, and is compiled again
+        if (!cubin.empty() &&
+            cuModuleLoadData(&(module_[device_id]), cubin.data()) == CUDA_SUCCESS) {
+          return;
+        }
+        module_[device_id] = nullptr;
+        cubin = LinkPTX(data_);
+        CUDA_DRIVER_CALL(cuModuleLoadData(&(module_[device_id]), cubin.data()));
+        SaveCachedCubin(cubin, cache_file);
+        return;
+      }
+    }
+    CUDA_DRIVER_CALL(cuModuleLoadData(&(module_[device_id]), data_.c_str()));
+  }
+
+
   // the binary data
   std::string data_;
   // The format
@@ -265,6 +406,9 @@ Module CUDAModuleCreate(std::string data, std::string fmt,
                         std::unordered_map<std::string, FunctionInfo> fmap,
                         std::string cuda_source) {
   auto n = make_object<CUDAModuleNode>(data, fmt, fmap, cuda_source);
+  if (support::BoolEnvironmentVar("TVM_CUDA_EAGER_MODULE_LOAD")) {
+    n->LoadAllDevices();
+  }
   return Module(n);
 }
 
@@ -28,7 +28,16 @@
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/serializer.h>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <fstream>
+#include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -236,6 +245,168 @@ std::string SaveParams(const Map<String, NDArray>& params) {
   return bytes;
 }
 
+// The alignment of the arrays in a mappable parameter file.
+constexpr uint64_t kMappedParamsAlignment = 4096;
+
+namespace {
+
+/*! \brief An entry of the index of a mappable parameter file. */
+struct MappedParamEntry {
+  DLDataType dtype;
+  std::vector<int64_t> shape;
+  uint64_t offset;
+  uint64_t nbytes;
+};
+
+void WriteMappedParamsIndex(dmlc::Stream* strm, const std::vector<std::string>& names,
+                            const std::vector<MappedParamEntry>& entries, uint64_t data_offset) {
+  uint64_t header = kTVMMappedNDArrayListMagic, reserved = 0;
+  strm->Write(header);
+  strm->Write(reserved);
+  strm->Write(data_offset);
+  strm->Write(names);
+  for (const MappedParamEntry& entry : entries) {
+    strm->Write(entry.dtype);
+    strm->Write(entry.shape);
+    strm->Write(entry.offset);
+    strm->Write(entry.nbytes);
+  }
+}
+
+inline uint64_t AlignMappedOffset(uint64_t offset) {
+  return (offset + kMappedParamsAlignment - 1) / kMappedParamsAlignment * kMappedParamsAlignment;
+}
+
+void MappedNDArrayDeleter(Object* obj) {
+  auto* ptr = static_cast<NDArray::Container*>(obj);
+  delete static_cast<std::shared_ptr<MappedFile>*>(ptr->manager_ctx);
+  delete ptr;
+}
+
+}  // namespace
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+  if (data != nullptr) munmap(data, size);
+#endif
+}
+
+std::shared_ptr<MappedFile> MapFile(const std::string& path) {
+  auto file = std::make_shared<MappedFile>();
+#ifndef _WIN32
+  int fd = open(path.c_str(), O_RDONLY);
+  ICHECK_GE(fd, 0) << "Cannot open " << path;
+  struct stat st;
+  ICHECK_EQ(fstat(fd, &st), 0) << "Cannot stat " << path;
+  file->size = static_cast<size_t>(st.st_size);
+  if (file->size == 0) {
+    close(fd);
+    return file;
+  }
+  // A private mapping stays shared with the page cache until a page is written to.
+  void* addr = mmap(nullptr, file->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  ICHECK(addr != MAP_FAILED) << "Cannot mmap " << path;
+  file->data = addr;
+#else
+  LoadBinaryFromFile(path, &file->buffer);
+  file->data = &file->buffer[0];
+  file->size = file->buffer.size();
+#endif
+  return file;
+}
+
+NDArray MappedNDArray(const std::shared_ptr<MappedFile>& file, size_t offset,
+                      std::vector<int64_t> shape, DLDataType dtype) {
+  auto* container = new NDArray::Container(static_cast<char*>(file->data) + offset,
+                                           std::move(shape), dtype, Device{kDLCPU, 0});
+  container->SetDeleter(MappedNDArrayDeleter);
+  container->manager_ctx = new std::shared_ptr<MappedFile>(file);
+  return NDArray(GetObjectPtr<Object>(container));
+}
+
+void SaveParamsToMappableFile(const std::string& path, const Map<String, NDArray>& params) {
+  ICHECK(DMLC_IO_NO_ENDIAN_SWAP) << "Mappable parameter files require a little-endian host";
+  std::vector<std::string> names;
+  std::vector<NDArray> arrays;
+  std::vector<MappedParamEntry> entries;
+  for (auto& p : params) {
+    names.push_back(p.first);
+    NDArray arr = p.second;
+    if (arr->device.device_type != kDLCPU) {
+      arr = arr.CopyTo(Device{kDLCPU, 0});
+    }
+    ICHECK(arr.IsContiguous()) << "Can only save contiguous arrays, but " << p.first << " is not";
+    MappedParamEntry entry;
+    entry.dtype = arr->dtype;
+    entry.shape = std::vector<int64_t>(arr->shape, arr->shape + arr->ndim);
+    entry.offset = 0;
+    entry.nbytes = GetDataSize(*arr.operator->());
+    arrays.push_back(arr);
+    entries.push_back(entry);
+  }
+  // The size of the index does not depend on the offsets, measure it first.
+  std::string index;
+  {
+    dmlc::MemoryStringStream strm(&index);
+    WriteMappedParamsIndex(&strm, names, entries, 0);
+  }
+  uint64_t data_offset = AlignMappedOffset(index.size());
+  uint64_t offset = data_offset;
+  for (MappedParamEntry& entry : entries) {
+    entry.offset = offset;
+    offset = AlignMappedOffset(offset + entry.nbytes);
+  }
+  index.clear();
+  {
+    dmlc::MemoryStringStream strm(&index);
+    WriteMappedParamsIndex(&strm, names, entries, data_offset);
+  }
+  std::ofstream fs(path, std::ios::out | std::ios::binary);
+  ICHECK(!fs.fail()) << "Cannot open " << path;
+  fs.write(index.data(), index.size());
+  for (size_t i = 0; i < arrays.size(); ++i) {
+    std::string padding(entries[i].offset - fs.tellp(), '\0');
+    fs.write(padding.data(), padding.size());
+    fs.write(static_cast<const char*>(arrays[i]->data) + arrays[i]->byte_offset, entries[i].nbytes);
+  }
+  ICHECK(!fs.fail()) << "Cannot write " << path;
+}
+
+bool IsMappableParamsFile(const std::string& path) {
+  std::ifstream fs(path, std::ios::in | std::ios::binary);
+  uint64_t header = 0;
+  fs.read(reinterpret_cast<char*>(&header), sizeof(header));
+  return !fs.fail() && header == kTVMMappedNDArrayListMagic;
+}
+
+Map<String, NDArray> LoadMappedParams(const std::string& path) {
+  std::shared_ptr<MappedFile> file = MapFile(path);
+  dmlc::MemoryFixedSizeStream mstrm(file->data, file->size);
+  dmlc::Stream* strm = &mstrm;
+  uint64_t header, reserved, data_offset;
+  ICHECK(strm->Read(&header)) << "Invalid parameters file format";
+  ICHECK(header == kTVMMappedNDArrayListMagic) << "Invalid parameters file format";
+  ICHECK(strm->Read(&reserved)) << "Invalid parameters file format";
+  ICHECK(strm->Read(&data_offset)) << "Invalid parameters file format";
+  std::vector<std::string> names;
+  ICHECK(strm->Read(&names)) << "Invalid parameters file format";
+  Map<String, NDArray> params;
+  for (const std::string& name : names) {
+    MappedParamEntry entry;
+    ICHECK(strm->Read(&entry.dtype)) << "Invalid parameters file format";
+    ICHECK(strm->Read(&entry.shape)) << "Invalid parameters file format";
+    ICHECK(strm->Read(&entry.offset)) << "Invalid parameters file format";
+    ICHECK(strm->Read(&entry.nbytes)) << "Invalid parameters file format";
+    ICHECK(entry.offset >= data_offset && entry.offset + entry.nbytes <= file->size)
+        << "Invalid parameters file format, " << name << " is out of the file";
+    NDArray arr = MappedNDArray(file, entry.offset, entry.shape, entry.dtype);
+    ICHECK_EQ(GetDataSize(*arr.operator->()), entry.nbytes) << "Invalid parameters file format";
+    params.Set(name, arr);
+  }
+  return params;
+}
+
 TVM_REGISTER_GLOBAL("runtime.SaveParams").set_body_typed([](const Map<String, NDArray>& params) {
   std::string s = ::tvm::runtime::SaveParams(params);
   // copy return array so it is owned by the ret value
@@ -254,7 +425,15 @@ TVM_REGISTER_GLOBAL("runtime.LoadParams").set_body_typed([](const String& s) {
   return ::tvm::runtime::LoadParams(s);
 });
 
+TVM_REGISTER_GLOBAL("runtime.SaveParamsToMappableFile")
+    .set_body_typed([](const Map<String, NDArray>& params, const String& path) {
+      SaveParamsToMappableFile(path, params);
+    });
+
 TVM_REGISTER_GLOBAL("runtime.LoadParamsFromFile").set_body_typed([](const String& path) {
+  if (IsMappableParamsFile(path)) {
+    return LoadMappedParams(path);
+  }
   tvm::runtime::SimpleBinaryFileStream strm(path, "rb");
   return LoadParams(&strm);
 });
@@ -27,8 +27,10 @@
 #include <tvm/runtime/container/map.h>
 #include <tvm/runtime/container/string.h>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "meta_data.h"
 
@@ -130,6 +132,60 @@ std::string SaveParams(const Map<String, NDArray>& params);
  */
 void SaveParams(dmlc::Stream* strm, const Map<String, NDArray>& params);
 
+constexpr uint64_t kTVMMappedNDArrayListMagic = 0xF7E58D4F05049CB8;
+/*!
+ * \brief Save parameters to a file that can be memory-mapped by LoadMappedParams.
+ *
+ *  Unlike SaveParams, the data of each array is stored at a page-aligned offset after an
+ *  index of names, types and shapes, so that the arrays can be used in place.
+ * \param path The path of the file.
+ * \param params Parameters to save.
+ */
+void SaveParamsToMappableFile(const std::string& path, const Map<String, NDArray>& params);
+/*!
+ * \brief Check whether a file was written by SaveParamsToMappableFile.
+ * \param path The path of the file.
+ */
+bool IsMappableParamsFile(const std::string& path);
+/*!
+ * \brief Memory-map a file written by SaveParamsToMappableFile.
+ *
+ *  The returned CPU arrays point into a private, copy-on-write mapping of the file, so the
+ *  pages are read lazily and shared with the page cache until written to. The mapping is
+ *  kept alive as long as any of the arrays.
+ * \param path The path of the file.
+ * \return Map of parameter name to parameter value.
+ */
+Map<String, NDArray> LoadMappedParams(const std::string& path);
+
+/*! \brief A private, copy-on-write memory mapping of a file, shared by the arrays into it. */
+struct MappedFile {
+  void* data{nullptr};
+  size_t size{0};
+#ifdef _WIN32
+  std::string buffer;
+#endif
+  ~MappedFile();
+};
+
+/*!
+ * \brief Memory-map a whole file, which is read into memory where there is no mmap.
+ * \param path The path of the file.
+ * \return The mapping.
+ */
+std::shared_ptr<MappedFile> MapFile(const std::string& path);
+
+/*!
+ * \brief Create a CPU array pointing into a mapped file, which keeps the mapping alive.
+ * \param file The mapping.
+ * \param offset The offset of the data of the array in the file.
+ * \param shape The shape of the array.
+ * \param dtype The data type of the array.
+ * \return The array.
+ */
+NDArray MappedNDArray(const std::shared_ptr<MappedFile>& file, size_t offset,
+                      std::vector<int64_t> shape, DLDataType dtype);
+
 /*!
  * \brief A dmlc stream which wraps standard file operations.
  */
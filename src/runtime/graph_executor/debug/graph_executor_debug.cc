@@ -32,11 +32,31 @@
 #include <cmath>
 #include <numeric>
 #include <sstream>
+#include <thread>
 
 #include "../../rpc/rpc_session.h"
 
 namespace tvm {
 namespace runtime {
+
+/*!
+ * \brief Encode the times of the ops, as returned by run_individual.
+ * \param time_sec_per_op The time of each repeat of each op, in seconds.
+ */
+static std::string EncodeOpTimes(const std::vector<std::vector<double>>& time_sec_per_op) {
+  std::ostringstream os;
+  int64_t size = time_sec_per_op.size();
+  os.write(reinterpret_cast<char*>(&size), sizeof(int64_t));
+  for (size_t index = 0; index < time_sec_per_op.size(); ++index) {
+    for (auto& repeat_data : time_sec_per_op[index]) {
+      // To have good behavior when calculating total time, etc.
+      double data = std::isnan(repeat_data) ? 0 : repeat_data;
+      os.write(reinterpret_cast<char*>(&data), sizeof(double));
+    }
+  }
+  return os.str();
+}
+
 std::string GraphExecutorDebug::RunIndividual(int number, int repeat, int min_repeat_ms,
                                               int limit_zero_time_iterations,
                                               int cooldown_interval_ms, int repeats_to_cooldown) {
@@ -71,18 +91,41 @@ std::string GraphExecutorDebug::RunIndividual(int number, int repeat, int min_re
       }
     }
   }
+  return EncodeOpTimes(time_sec_per_op);
+}
 
-  std::ostringstream os;
-  int64_t size = time_sec_per_op.size();
-  os.write(reinterpret_cast<char*>(&size), sizeof(int64_t));
-  for (size_t index = 0; index < time_sec_per_op.size(); ++index) {
-    for (auto& repeat_data : time_sec_per_op[index]) {
-      // To have good behavior when calculating total time, etc.
-      double data = std::isnan(repeat_data) ? 0 : repeat_data;
-      os.write(reinterpret_cast<char*>(&data), sizeof(double));
+std::string GraphExecutorDebug::RunIndividualBatched(int number, int repeat,
+                                                     int cooldown_interval_ms,
+                                                     int repeats_to_cooldown) {
+  if (module_->type_key() == std::string("rpc")) {
+    // The ops of a remote module are timed remotely one by one.
+    return RunIndividual(number, repeat, 0, 100, cooldown_interval_ms, repeats_to_cooldown);
+  }
+  // warmup run
+  GraphExecutor::Run();
+  std::vector<std::vector<double>> time_sec_per_op(op_execs_.size(),
+                                                   std::vector<double>(repeat, 0));
+  std::vector<Timer> timers;
+  for (int i = 0; i < repeat; ++i) {
+    if (cooldown_interval_ms > 0 && i > 0 && i % repeats_to_cooldown == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(cooldown_interval_ms));
+    }
+    // The ops run back to back, their timers are only read once the whole repeat is done.
+    timers.clear();
+    for (int j = 0; j < number; ++j) {
+      for (size_t index = 0; index < op_execs_.size(); ++index) {
+        if (op_execs_[index]) timers.push_back(RunOpHost(index));
+      }
+    }
+    auto timer = timers.begin();
+    for (int j = 0; j < number; ++j) {
+      for (size_t index = 0; index < op_execs_.size(); ++index) {
+        if (!op_execs_[index]) continue;
+        time_sec_per_op[index][i] += (*timer++)->SyncAndGetElapsedNanos() / 1e9 / number;
+      }
     }
   }
-  return os.str();
+  return EncodeOpTimes(time_sec_per_op);
 }
 
 std::string GraphExecutorDebug::RunIndividualNode(int node_index, int number, int repeat,
@@ -232,6 +275,23 @@ PackedFunc GraphExecutorDebug::GetFunction(const std::string& name,
       arr.data = blob.data();
       *rv = arr;
     });
+  } else if (name == "run_individual_batched") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      int number = args[0];
+      int repeat = args[1];
+      int cooldown_interval_ms = args[2];
+      int repeats_to_cooldown = args[3];
+      ICHECK_GT(number, 0);
+      ICHECK_GT(repeat, 0);
+      ICHECK_GE(cooldown_interval_ms, 0);
+      ICHECK_GT(repeats_to_cooldown, 0);
+      std::string blob =
+          this->RunIndividualBatched(number, repeat, cooldown_interval_ms, repeats_to_cooldown);
+      TVMByteArray arr;
+      arr.size = blob.length();
+      arr.data = blob.data();
+      *rv = arr;
+    });
   } else if (name == "run_individual_node") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       int node_index = args[0];
@@ -258,24 +318,25 @@ PackedFunc GraphExecutorDebug::GetFunction(const std::string& name,
       *rv = arr;
     });
   } else if (name == "profile") {
-    return TypedPackedFunc<profiling::Report(Array<profiling::MetricCollector>)>(
-        [sptr_to_self, this](Array<profiling::MetricCollector> collectors) {
-          // We cannot send Arrays over rpc, so in order to support profiling
-          // on remotes, we accept a nullptr for collectors.
-          if (collectors.defined()) {
-            return this->Profile(collectors);
-          } else {
-            return this->Profile({});
-          }
-        });
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      // We cannot send Arrays over rpc, so in order to support profiling
+      // on remotes, we accept a nullptr for collectors.
+      Array<profiling::MetricCollector> collectors = args[0];
+      int repeat = args.num_args > 1 ? args[1].operator int() : 1;
+      ICHECK_GT(repeat, 0);
+      *rv = this->Profile(collectors.defined() ? collectors : Array<profiling::MetricCollector>(),
+                          repeat);
+    });
   } else if (name == "profile_rpc") {
     // We cannot return a Report over RPC because TMV RPC mechanism only
     // supports a subset of Object classes. Instead we serialize it on the
-    // remote (here) and deserialize it on the other end.
-    return TypedPackedFunc<std::string()>([sptr_to_self, this]() {
-      PackedFunc profile = GetFunction("profile", sptr_to_self);
-      profiling::Report report = profile(Array<profiling::MetricCollector>());
-      return report->AsJSON();
+    // remote (here) and deserialize it on the other end. MetricCollectors cannot be sent either,
+    // they are constructed here from the names of their global functions.
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      int repeat = args.num_args > 0 ? args[0].operator int() : 1;
+      ICHECK_GT(repeat, 0);
+      String collectors = args.num_args > 1 ? args[1].operator String() : String("");
+      *rv = this->Profile(profiling::MetricCollectorsFromNames(collectors), repeat)->AsJSON();
     });
   } else {
     return GraphExecutor::GetFunction(name, sptr_to_self);
@@ -331,7 +392,8 @@ NDArray GraphExecutorDebug::GetNodeOutput(int node, int out_ind) {
   return data_entry_[entry_id(node, out_ind)].CopyTo({kDLCPU, 0});
 }
 
-profiling::Report GraphExecutorDebug::Profile(Array<profiling::MetricCollector> collectors) {
+profiling::Report GraphExecutorDebug::Profile(Array<profiling::MetricCollector> collectors,
+                                              int repeat) {
   std::vector<profiling::MetricCollector> cs(collectors.begin(), collectors.end());
   profiling::Profiler prof(devices_, cs, {{String("Executor"), String("Graph")}});
 
@@ -341,8 +403,9 @@ profiling::Report GraphExecutorDebug::Profile(Array<profiling::MetricCollector>
   }
 
   prof.Start();
-  for (size_t i = 0; i < op_execs_.size(); ++i) {
-    if (op_execs_[i]) {
+  for (int r = 0; r < repeat; ++r) {
+    for (size_t i = 0; i < op_execs_.size(); ++i) {
+      if (!op_execs_[i]) continue;
       // get argument shapes
       std::vector<NDArray> shapes;
       for (const auto& e : nodes_[i].inputs) {
@@ -64,6 +64,22 @@ class GraphExecutorDebug : public GraphExecutor {
                             int limit_zero_time_iterations, int cooldown_interval_ms,
                             int repeats_to_cooldown);
 
+  /*!
+   * \brief Run each operation in the graph and get the time per op for all ops, timing all the
+   *  ops of a run of the graph back to back with the timers of their devices.
+   *
+   *  Unlike RunIndividual, the device is not synchronized after each op, but once per repeat,
+   *  and the ops run in the order of the graph, with the inputs the previous ops produced.
+   * \param number The number of runs of the graph averaged by each repeat.
+   * \param repeat The number of times to repeat the measurement.
+   * \param cooldown_interval_ms The cooldown interval in milliseconds between the number of repeats
+   *        defined by `repeats_to_cooldown`.
+   * \param repeats_to_cooldown The number of repeats before the cooldown is activated.
+   * \return The times of the ops, encoded as the result of RunIndividual.
+   */
+  std::string RunIndividualBatched(int number, int repeat, int cooldown_interval_ms,
+                                   int repeats_to_cooldown);
+
   std::string RunIndividualNode(int node_index, int number, int repeat, int min_repeat_ms,
                                 int limit_zero_time_iterations, int cooldown_interval_ms,
                                 int repeats_to_cooldown);
@@ -132,10 +148,11 @@ class GraphExecutorDebug : public GraphExecutor {
    * entire graph in order.
    *
    * \param collectors Optional user defined `MetricCollector`s to use with this profiling run.
+   * \param repeat The number of runs of the graph recorded in the report.
    *
    * \returns A table of per-op runtimes and total times.
    */
-  profiling::Report Profile(Array<profiling::MetricCollector> collectors);
+  profiling::Report Profile(Array<profiling::MetricCollector> collectors, int repeat = 1);
 
  private:
   int last_executed_node_ = -1;
@@ -31,17 +31,23 @@
 #include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/serializer.h>
+#include <tvm/runtime/threading_backend.h>
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "../file_utils.h"
+#include "../library_module.h"
 #include "../texture.h"
 
 namespace tvm {
@@ -53,18 +59,570 @@ inline size_t GetDataAlignment(const DLTensor& arr) {
   return align;
 }
 constexpr auto Is2DStorage = IsTextureStorage;
+/*! \brief Whether the views of a storage on the device can start at any byte offset. */
+inline bool IsAddressable(const Device& dev) {
+  switch (dev.device_type) {
+    case kDLCPU:
+    case kDLCUDA:
+    case kDLCUDAHost:
+    case kDLCUDAManaged:
+    case kDLROCM:
+    case kDLROCMHost:
+      return true;
+    default:
+      return false;
+  }
+}
 }  // namespace details
 
+/*!
+ * \brief Dispatches the nodes whose dependencies are done to a set of worker threads.
+ *
+ *  A worker continues with one of the nodes it made ready, and hands the others to the idle
+ *  workers. Each worker owns a stream per accelerator device; before running a node, the
+ *  stream of the worker waits for the streams of the workers that ran its dependencies.
+ */
+class GraphExecutor::WavefrontRunner {
+ public:
+  /*!
+   * \param num_workers The number of worker threads.
+   * \param preds The dependencies of each node.
+   * \param stream_devices The accelerator devices the nodes launch kernels on.
+   * \param worker_cpus The CPUs of the thread pool of each worker, empty to keep the defaults.
+   * \param thread_pool_group The thread pool group to run on instead, if not empty.
+   */
+  WavefrontRunner(int num_workers, std::vector<std::vector<uint32_t>> preds,
+                  std::vector<Device> stream_devices,
+                  std::vector<std::vector<unsigned int>> worker_cpus,
+                  std::string thread_pool_group)
+      : preds_(std::move(preds)),
+        stream_devices_(std::move(stream_devices)),
+        worker_cpus_(std::move(worker_cpus)),
+        thread_pool_group_(std::move(thread_pool_group)) {
+    succs_.resize(preds_.size());
+    for (uint32_t nid = 0; nid < preds_.size(); ++nid) {
+      for (uint32_t pred : preds_[nid]) {
+        succs_[pred].push_back(nid);
+      }
+    }
+    pending_.resize(preds_.size());
+    node_worker_.resize(preds_.size(), 0);
+    streams_.resize(num_workers);
+    for (int w = 0; w < num_workers; ++w) {
+      for (const Device& dev : stream_devices_) {
+        streams_[w].push_back(DeviceAPI::Get(dev)->CreateStream(dev));
+      }
+    }
+    for (int w = 0; w < num_workers; ++w) {
+      workers_.emplace_back([this, w]() { this->WorkerLoop(w); });
+    }
+  }
+
+  ~WavefrontRunner() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    ready_cv_.notify_all();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+    for (size_t w = 0; w < streams_.size(); ++w) {
+      for (size_t d = 0; d < stream_devices_.size(); ++d) {
+        DeviceAPI::Get(stream_devices_[d])->FreeStream(stream_devices_[d], streams_[w][d]);
+      }
+    }
+  }
+
+  /*! \brief The number of worker threads. */
+  int num_workers() const { return static_cast<int>(workers_.size()); }
+
+  /*! \brief Run the nodes with an operator and wait for all of them. */
+  void Run(const std::vector<std::function<void()>>* op_execs) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      op_execs_ = op_execs;
+      num_remaining_ = 0;
+      error_.clear();
+      for (uint32_t nid = 0; nid < preds_.size(); ++nid) {
+        if (!(*op_execs)[nid]) continue;
+        ++num_remaining_;
+        pending_[nid] = preds_[nid].size();
+        if (pending_[nid] == 0) ready_.push_back(nid);
+      }
+      ready_cv_.notify_all();
+      done_cv_.wait(lock, [this]() {
+        return num_remaining_ == 0 || (!error_.empty() && num_running_ == 0);
+      });
+      ready_.clear();
+      op_execs_ = nullptr;
+    }
+    // The outputs are ready when Run returns, as in the sequential execution.
+    for (size_t w = 0; w < streams_.size(); ++w) {
+      for (size_t d = 0; d < stream_devices_.size(); ++d) {
+        DeviceAPI::Get(stream_devices_[d])->StreamSync(stream_devices_[d], streams_[w][d]);
+      }
+    }
+    if (!error_.empty()) {
+      LOG(FATAL) << "RuntimeError: graph executor node failed with " << error_;
+    }
+  }
+
+ private:
+  void WorkerLoop(int worker_id) {
+    for (size_t d = 0; d < stream_devices_.size(); ++d) {
+      DeviceAPI::Get(stream_devices_[d])->SetStream(stream_devices_[d], streams_[worker_id][d]);
+    }
+    if (thread_pool_group_.empty() && !worker_cpus_.empty()) {
+      const std::vector<unsigned int>& cpus = worker_cpus_[worker_id];
+      threading::Configure(threading::ThreadGroup::kSpecifyThreadShareAllCore,
+                           static_cast<int>(cpus.size()), cpus);
+    }
+    threading::ThreadPoolGroupScope thread_pool_scope(thread_pool_group_);
+    std::vector<char> synced(streams_.size());
+    std::unique_lock<std::mutex> lock(mutex_);
+    int64_t nid = -1;
+    for (;;) {
+      if (nid < 0) {
+        ready_cv_.wait(lock, [this]() { return stop_ || !ready_.empty(); });
+        if (stop_) return;
+        nid = ready_.front();
+        ready_.pop_front();
+      }
+      ++num_running_;
+      const std::function<void()>& op = (*op_execs_)[nid];
+      lock.unlock();
+      std::string error;
+      try {
+        if (!stream_devices_.empty()) {
+          std::fill(synced.begin(), synced.end(), 0);
+          synced[worker_id] = 1;
+          for (uint32_t pred : preds_[nid]) {
+            int from = node_worker_[pred];
+            if (synced[from]) continue;
+            synced[from] = 1;
+            for (size_t d = 0; d < stream_devices_.size(); ++d) {
+              DeviceAPI::Get(stream_devices_[d])
+                  ->SyncStreamFromTo(stream_devices_[d], streams_[from][d], streams_[worker_id][d]);
+            }
+          }
+        }
+        op();
+      } catch (const std::exception& e) {
+        error = e.what();
+      }
+      node_worker_[nid] = worker_id;
+      lock.lock();
+      --num_running_;
+      --num_remaining_;
+      int64_t next = -1;
+      if (!error.empty() && error_.empty()) {
+        error_ = error;
+      }
+      if (error_.empty()) {
+        for (uint32_t succ : succs_[nid]) {
+          if (--pending_[succ] != 0) continue;
+          if (next < 0) {
+            next = succ;
+          } else {
+            ready_.push_back(succ);
+            ready_cv_.notify_one();
+          }
+        }
+      } else {
+        ready_.clear();
+      }
+      if (num_remaining_ == 0 || (!error_.empty() && num_running_ == 0)) {
+        done_cv_.notify_all();
+      }
+      nid = next;
+    }
+  }
+
+  /*! \brief The dependencies and the dependents of each node. */
+  std::vector<std::vector<uint32_t>> preds_;
+  std::vector<std::vector<uint32_t>> succs_;
+  std::vector<Device> stream_devices_;
+  std::vector<std::vector<unsigned int>> worker_cpus_;
+  std::string thread_pool_group_;
+  /*! \brief The stream of each worker on each of stream_devices_. */
+  std::vector<std::vector<TVMStreamHandle>> streams_;
+  std::vector<std::thread> workers_;
+  /*! \brief The worker which ran each node in the current run. */
+  std::vector<int> node_worker_;
+  /*! \brief Protects the scheduling state below. */
+  std::mutex mutex_;
+  std::condition_variable ready_cv_;
+  std::condition_variable done_cv_;
+  const std::vector<std::function<void()>>* op_execs_{nullptr};
+  std::deque<uint32_t> ready_;
+  /*! \brief The number of dependencies not done yet of each node. */
+  std::vector<size_t> pending_;
+  size_t num_remaining_{0};
+  size_t num_running_{0};
+  std::string error_;
+  bool stop_{false};
+};
+
 /*!
  * \brief Run all the operations one by one.
  */
 void GraphExecutor::Run() {
-  // setup the array and requirements.
-  for (size_t i = 0; i < op_execs_.size(); ++i) {
-    if (op_execs_[i]) op_execs_[i]();
+  // the thread pool is thread local, pin the one of the calling thread.
+  if (numa_node_ >= 0 && threading::CurrentNumaNode() != numa_node_) {
+    threading::ConfigureNumaNode(numa_node_, numa_nthreads_);
+  }
+  threading::ThreadPoolGroupScope thread_pool_scope(thread_pool_group_);
+  if (!staging_streams_.empty()) BeginStagedRun();
+  for (uint32_t eid : zero_copy_param_inputs_) {
+    this->MarkParamTransformsDirty(eid);
+  }
+  if (param_transforms_dirty_) RunParamTransforms();
+  const std::vector<std::function<void()>>& execs =
+      op_latency_ != nullptr && op_latency_->BeginRun() ? instrumented_execs_ : op_execs_;
+  if (wavefront_runner_ != nullptr) {
+    wavefront_runner_->Run(&execs);
+  } else if (!op_submits_.empty() && &execs == &op_execs_) {
+    RunOverlapped();
+  } else {
+    // setup the array and requirements.
+    for (size_t i = 0; i < execs.size(); ++i) {
+      if (execs[i]) execs[i]();
+    }
+  }
+  if (!staging_streams_.empty()) EndStagedRun();
+}
+
+void GraphExecutor::RunOverlapped() {
+  for (size_t nid = 0; nid < op_execs_.size(); ++nid) {
+    if (!op_execs_[nid]) continue;
+    for (uint32_t dep : completion_deps_[nid]) op_completions_[dep]();
+    if (op_submits_[nid]) {
+      op_submits_[nid]();
+    } else {
+      op_execs_[nid]();
+    }
+  }
+  for (size_t nid = 0; nid < op_completions_.size(); ++nid) {
+    if (op_completions_[nid]) op_completions_[nid]();
+  }
+}
+
+void GraphExecutor::EnableOpLatencyHistograms(int sample_period) {
+  ICHECK_GE(sample_period, 0) << "ValueError: sample_period should be non-negative";
+  op_latency_ = nullptr;
+  instrumented_execs_.clear();
+  if (sample_period == 0) return;
+  std::vector<std::string> names, functions;
+  std::vector<Device> devices;
+  for (uint32_t nid = 0; nid < nodes_.size(); ++nid) {
+    if (!op_execs_[nid]) continue;
+    names.push_back(nodes_[nid].name);
+    functions.push_back(nodes_[nid].param.func_name);
+    devices.push_back(data_entry_[entry_id(nid, 0)]->device);
+  }
+  op_latency_ = std::make_unique<OpLatencyRecorder>(names, functions, devices, sample_period);
+  InstrumentOpExecs();
+}
+
+void GraphExecutor::InstrumentOpExecs() {
+  instrumented_execs_.assign(op_execs_.size(), nullptr);
+  OpLatencyRecorder* recorder = op_latency_.get();
+  // The recorder numbers the nodes with an operator in order.
+  size_t op = 0;
+  for (uint32_t nid = 0; nid < op_execs_.size(); ++nid) {
+    if (!op_execs_[nid]) continue;
+    std::function<void()> exec = op_execs_[nid];
+    instrumented_execs_[nid] = [recorder, exec, op]() {
+      int64_t start = recorder->StartOp(op);
+      exec();
+      recorder->StopOp(op, start);
+    };
+    ++op;
+  }
+}
+
+std::string GraphExecutor::GetOpLatencyHistograms(bool reset) {
+  CHECK(op_latency_ != nullptr)
+      << "The latency histograms are disabled, call enable_op_latency_histograms first";
+  return op_latency_->ToJSON(reset);
+}
+
+std::vector<std::vector<uint32_t>> GraphExecutor::GetExecutionDependencies() const {
+  std::vector<std::vector<uint32_t>> preds(nodes_.size());
+  // The last node writing to each storage, and the nodes reading it since.
+  std::vector<int64_t> last_writer(storage_pool_.size(), -1);
+  std::vector<std::vector<uint32_t>> readers(storage_pool_.size());
+  for (uint32_t nid = 0; nid < nodes_.size(); ++nid) {
+    if (!op_execs_[nid]) continue;
+    std::vector<uint32_t>& deps = preds[nid];
+    for (const NodeEntry& e : nodes_[nid].inputs) {
+      if (op_execs_[e.node_id]) deps.push_back(e.node_id);
+      int sid = attrs_.storage_id[entry_id(e)];
+      if (last_writer[sid] >= 0) deps.push_back(last_writer[sid]);
+      readers[sid].push_back(nid);
+    }
+    for (uint32_t index = 0; index < nodes_[nid].param.num_outputs; ++index) {
+      int sid = attrs_.storage_id[entry_id(nid, index)];
+      if (last_writer[sid] >= 0) deps.push_back(last_writer[sid]);
+      deps.insert(deps.end(), readers[sid].begin(), readers[sid].end());
+      readers[sid].clear();
+      last_writer[sid] = nid;
+    }
+    std::sort(deps.begin(), deps.end());
+    deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+    deps.erase(std::remove(deps.begin(), deps.end(), nid), deps.end());
+  }
+  return preds;
+}
+
+void GraphExecutor::SetParallelExecution(int num_workers) {
+  ICHECK_GE(num_workers, 0) << "ValueError: num_workers should be non-negative";
+  wavefront_runner_ = nullptr;
+  if (num_workers <= 1) return;
+  std::vector<Device> stream_devices;
+  for (const Device& dev : devices_) {
+    if (dev.device_type == kDLCPU || dev.device_type == kDLCUDAHost) continue;
+    TVMStreamHandle stream = DeviceAPI::Get(dev)->CreateStream(dev);
+    if (stream == nullptr) {
+      LOG(WARNING) << "Device " << DeviceName(dev.device_type)
+                   << " does not support streams, the nodes run one by one";
+      return;
+    }
+    DeviceAPI::Get(dev)->FreeStream(dev, stream);
+    stream_devices.push_back(dev);
+  }
+  // Split the CPUs between the thread pools of the workers.
+  std::vector<std::vector<unsigned int>> worker_cpus;
+  if (thread_pool_group_.empty()) {
+    std::vector<unsigned int> cpus;
+    if (numa_node_ >= 0) {
+      cpus = threading::NumaNodeCpus(numa_node_);
+    } else {
+      cpus.resize(std::max(std::thread::hardware_concurrency(), 1U));
+      std::iota(cpus.begin(), cpus.end(), 0);
+    }
+    worker_cpus.resize(num_workers);
+    for (int w = 0; w < num_workers; ++w) {
+      size_t begin = cpus.size() * w / num_workers;
+      size_t end = std::max(cpus.size() * (w + 1) / num_workers, begin + 1);
+      for (size_t i = begin; i < end; ++i) {
+        worker_cpus[w].push_back(cpus[i % cpus.size()]);
+      }
+    }
+  }
+  wavefront_runner_ =
+      std::make_shared<WavefrontRunner>(num_workers, GetExecutionDependencies(), stream_devices,
+                                        std::move(worker_cpus), thread_pool_group_);
+}
+
+void GraphExecutor::BindNumaNode(int node, int nthreads) {
+  ICHECK(node >= 0 && node < threading::NumaNodeCount()) << "Invalid NUMA node " << node;
+  numa_node_ = node;
+  numa_nthreads_ = nthreads;
+  for (const NDArray& storage : storage_pool_) {
+    const DLTensor* tensor = storage.operator->();
+    if (tensor->device.device_type == kDLCPU) {
+      threading::BindMemoryToNumaNode(tensor->data, GetDataSize(*tensor), node);
+    }
+  }
+  threading::ConfigureNumaNode(node, nthreads);
+  // the workers need their CPUs re-assigned.
+  if (wavefront_runner_ != nullptr) SetParallelExecution(wavefront_runner_->num_workers());
+}
+
+void GraphExecutor::BindThreadPoolGroup(const std::string& name) {
+  if (!name.empty()) {
+    // fail early if the group does not exist.
+    threading::ThreadPoolGroupScope scope(name);
+  }
+  thread_pool_group_ = name;
+  if (wavefront_runner_ != nullptr) SetParallelExecution(wavefront_runner_->num_workers());
+}
+
+GraphExecutor::~GraphExecutor() { ReleaseStaging(); }
+
+namespace {
+/*! \brief Replace an event of the staging with one recorded on a stream. */
+void RecordStagingEvent(Device dev, TVMStreamHandle stream, void** event) {
+  DeviceAPI* api = DeviceAPI::Get(dev);
+  if (*event != nullptr) api->FreeEvent(dev, *event);
+  *event = api->RecordEvent(dev, stream);
+}
+}  // namespace
+
+void GraphExecutor::SetStaging(bool enable) {
+  ReleaseStaging();
+  staging_enabled_ = enable;
+  if (!enable) return;
+  input_staging_.resize(input_nodes_.size());
+  // The inputs are set up on their first SetInput, which skips the parameters loaded directly.
+  output_staging_.resize(outputs_.size());
+  for (size_t i = 0; i < outputs_.size(); ++i) {
+    InitStaging(entry_id(outputs_[i]), false, &output_staging_[i]);
+  }
+}
+
+bool GraphExecutor::InitStaging(uint32_t eid, bool is_input, Staging* staging) {
+  if (staging->streams != -1) return staging->streams >= 0;
+  staging->streams = -2;
+  const NDArray& entry = data_entry_[eid];
+  Device dev = entry->device;
+  if (dev.device_type == kDLCPU || dev.device_type == kDLCUDAHost) return false;
+  auto it = std::find_if(
+      staging_streams_.begin(), staging_streams_.end(), [dev](const StagingStreams& streams) {
+        return streams.dev.device_type == dev.device_type && streams.dev.device_id == dev.device_id;
+      });
+  if (it == staging_streams_.end()) {
+    DeviceAPI* api = DeviceAPI::Get(dev);
+    TVMStreamHandle compute = api->CreateStream(dev);
+    TVMStreamHandle copy = compute != nullptr ? api->CreateStream(dev) : nullptr;
+    void* event = copy != nullptr ? api->RecordEvent(dev, copy) : nullptr;
+    if (event == nullptr) {
+      LOG(WARNING) << "Device " << DeviceName(dev.device_type)
+                   << " does not support streams and events, its data is not staged";
+      if (copy != nullptr) api->FreeStream(dev, copy);
+      if (compute != nullptr) api->FreeStream(dev, compute);
+      return false;
+    }
+    api->FreeEvent(dev, event);
+    it = staging_streams_.insert(staging_streams_.end(), StagingStreams{dev, compute, copy});
+  }
+  Device host{dev.device_type == kDLCUDA ? kDLCUDAHost : kDLCPU, 0};
+  if (DeviceAPI::Get(host, /*allow_missing=*/true) == nullptr) host = Device{kDLCPU, 0};
+  std::vector<int64_t> shape(entry->shape, entry->shape + entry->ndim);
+  for (int slot = 0; slot < 2; ++slot) {
+    staging->host[slot] = NDArray::Empty(shape, entry->dtype, host);
+  }
+  if (is_input) {
+    staging->device[0] = entry;
+    staging->device[1] = NDArray::Empty(shape, entry->dtype, dev);
+  }
+  staging->streams = static_cast<int>(it - staging_streams_.begin());
+  return true;
+}
+
+bool GraphExecutor::StageInput(int index, DLTensor* data_in) {
+  Staging& staging = input_staging_[index];
+  if (!InitStaging(entry_id(input_nodes_[index], 0), true, &staging)) return false;
+  const StagingStreams& streams = staging_streams_[staging.streams];
+  DeviceAPI* api = DeviceAPI::Get(streams.dev);
+  int slot = 1 - staging.slot;
+  // The host buffer is free once its last upload is done.
+  if (staging.copied[slot] != nullptr) api->EventSync(streams.dev, staging.copied[slot]);
+  staging.host[slot].CopyFrom(data_in);
+  // The device slot is free once the run before the one in flight is done.
+  if (staging.consumed[slot] != nullptr) {
+    api->StreamWaitEvent(streams.dev, streams.copy, staging.consumed[slot]);
+  }
+  NDArray::CopyFromTo(staging.host[slot].operator->(),
+                      const_cast<DLTensor*>(staging.device[slot].operator->()), streams.copy);
+  RecordStagingEvent(streams.dev, streams.copy, &staging.copied[slot]);
+  staging.pending = true;
+  return true;
+}
+
+void GraphExecutor::BeginStagedRun() {
+  // The workers of the wavefront runner use their own streams, they wait on the host instead.
+  bool on_streams = wavefront_runner_ == nullptr;
+  auto wait = [this, on_streams](int index, void* event) {
+    const StagingStreams& streams = staging_streams_[index];
+    DeviceAPI* api = DeviceAPI::Get(streams.dev);
+    if (on_streams) {
+      api->StreamWaitEvent(streams.dev, streams.compute, event);
+    } else {
+      api->EventSync(streams.dev, event);
+    }
+  };
+  if (on_streams) {
+    for (StagingStreams& streams : staging_streams_) {
+      DeviceAPI* api = DeviceAPI::Get(streams.dev);
+      streams.saved = api->GetCurrentStream(streams.dev);
+      api->SetStream(streams.dev, streams.compute);
+    }
+  }
+  for (size_t i = 0; i < input_staging_.size(); ++i) {
+    Staging& staging = input_staging_[i];
+    if (!staging.pending) continue;
+    int slot = 1 - staging.slot;
+    wait(staging.streams, staging.copied[slot]);
+    void* data = staging.device[slot]->data;
+    for (DLTensor* t : input_dltensors_[entry_id(input_nodes_[i], 0)]) {
+      t->data = data;
+    }
+    staging.slot = slot;
+    staging.pending = false;
+  }
+  // The outputs are not overwritten before their last download is done.
+  for (const Staging& staging : output_staging_) {
+    if (staging.streams < 0 || staging.copied[staging.slot] == nullptr) continue;
+    wait(staging.streams, staging.copied[staging.slot]);
   }
 }
 
+void GraphExecutor::EndStagedRun() {
+  for (Staging& staging : input_staging_) {
+    if (staging.streams < 0) continue;
+    const StagingStreams& streams = staging_streams_[staging.streams];
+    RecordStagingEvent(streams.dev, streams.compute, &staging.consumed[staging.slot]);
+  }
+  for (size_t i = 0; i < output_staging_.size(); ++i) {
+    Staging& staging = output_staging_[i];
+    if (staging.streams < 0) continue;
+    const StagingStreams& streams = staging_streams_[staging.streams];
+    DeviceAPI* api = DeviceAPI::Get(streams.dev);
+    int slot = 1 - staging.slot;
+    api->SyncStreamFromTo(streams.dev, streams.compute, streams.copy);
+    NDArray::CopyFromTo(data_entry_[entry_id(outputs_[i])].operator->(),
+                        const_cast<DLTensor*>(staging.host[slot].operator->()), streams.copy);
+    RecordStagingEvent(streams.dev, streams.copy, &staging.copied[slot]);
+    staging.slot = slot;
+  }
+  if (wavefront_runner_ == nullptr) {
+    for (const StagingStreams& streams : staging_streams_) {
+      DeviceAPI::Get(streams.dev)->SetStream(streams.dev, streams.saved);
+    }
+  }
+}
+
+void GraphExecutor::ReleaseStaging() {
+  for (const StagingStreams& streams : staging_streams_) {
+    DeviceAPI* api = DeviceAPI::Get(streams.dev);
+    api->StreamSync(streams.dev, streams.copy);
+    api->StreamSync(streams.dev, streams.compute);
+  }
+  auto release = [this](Staging* staging) {
+    if (staging->streams < 0) return;
+    Device dev = staging_streams_[staging->streams].dev;
+    for (int slot = 0; slot < 2; ++slot) {
+      for (void* event : {staging->copied[slot], staging->consumed[slot]}) {
+        if (event != nullptr) DeviceAPI::Get(dev)->FreeEvent(dev, event);
+      }
+    }
+  };
+  for (size_t i = 0; i < input_staging_.size(); ++i) {
+    Staging& staging = input_staging_[i];
+    release(&staging);
+    if (staging.streams < 0) continue;
+    // Keep the latest input in the storage of the entry.
+    int latest = staging.pending ? 1 - staging.slot : staging.slot;
+    if (latest != 0) staging.device[0].CopyFrom(staging.device[latest]);
+    void* data = staging.device[0]->data;
+    for (DLTensor* t : input_dltensors_[entry_id(input_nodes_[i], 0)]) {
+      t->data = data;
+    }
+  }
+  for (Staging& staging : output_staging_) release(&staging);
+  input_staging_.clear();
+  output_staging_.clear();
+  for (const StagingStreams& streams : staging_streams_) {
+    DeviceAPI* api = DeviceAPI::Get(streams.dev);
+    api->FreeStream(streams.dev, streams.copy);
+    api->FreeStream(streams.dev, streams.compute);
+  }
+  staging_streams_.clear();
+}
+
 /*!
  * \brief Initialize the graph executor with graph and device.
  * \param graph_json The execution graph.
@@ -178,9 +736,23 @@ int GraphExecutor::GetOutputIndex(const std::string& name) {
  * \param data_in The input data.
  */
 void GraphExecutor::SetInput(int index, DLTensor* data_in) {
+  ICHECK_LT(static_cast<size_t>(index), input_nodes_.size());
+  uint32_t eid = this->entry_id(input_nodes_[index], 0);
+  this->MarkParamTransformsDirty(eid);
+  if (staging_enabled_ && StageInput(index, data_in)) return;
+  data_entry_[eid].CopyFrom(data_in);
+}
+/*!
+ * \brief set index-th input to a parameter, which the clones of the executor share.
+ * \param index The input index.
+ * \param data_in The parameter data.
+ */
+void GraphExecutor::SetParam(int index, DLTensor* data_in) {
   ICHECK_LT(static_cast<size_t>(index), input_nodes_.size());
   uint32_t eid = this->entry_id(input_nodes_[index], 0);
   data_entry_[eid].CopyFrom(data_in);
+  param_entries_.insert(eid);
+  this->MarkParamTransformsDirty(eid);
 }
 /*!
  * \brief Check the legality of external DLTensor*.
@@ -215,6 +787,10 @@ void GraphExecutor::SetInputZeroCopy(int index, DLTensor* data_ref) {
   for (DLTensor* t : input_dltensors_[eid]) {
     t->data = static_cast<char*>(data_ref->data) + data_ref->byte_offset;
   }
+  if (param_transform_inputs_.count(eid)) {
+    zero_copy_param_inputs_.insert(eid);
+  }
+  this->MarkParamTransformsDirty(eid);
 }
 /*!
  * \brief set index-th output to the graph without copying the data.
@@ -258,8 +834,15 @@ int GraphExecutor::NumInputs() const { return input_nodes_.size(); }
  *
  * \return NDArray corresponding to given input node index.
  */
-NDArray GraphExecutor::GetInput(int index) const {
+NDArray GraphExecutor::GetInput(int index) {
   ICHECK_LT(static_cast<size_t>(index), input_nodes_.size());
+  this->MarkParamTransformsDirty(this->entry_id(input_nodes_[index], 0));
+  if (static_cast<size_t>(index) < input_staging_.size()) {
+    const Staging& staging = input_staging_[index];
+    if (staging.streams >= 0) {
+      return staging.device[staging.pending ? 1 - staging.slot : staging.slot];
+    }
+  }
   uint32_t eid = this->entry_id(input_nodes_[index], 0);
   return data_entry_[eid];
 }
@@ -290,6 +873,16 @@ void GraphExecutor::CopyOutputTo(int index, DLTensor* data_out) {
     ICHECK_EQ(data->shape[j], data_out->shape[j]);
   }
 
+  if (static_cast<size_t>(index) < output_staging_.size()) {
+    const Staging& staging = output_staging_[index];
+    void* copied = staging.streams >= 0 ? staging.copied[staging.slot] : nullptr;
+    if (copied != nullptr && data_out->device.device_type == kDLCPU) {
+      Device dev = staging_streams_[staging.streams].dev;
+      DeviceAPI::Get(dev)->EventSync(dev, copied);
+      NDArray::CopyFromTo(staging.host[staging.slot].operator->(), data_out);
+      return;
+    }
+  }
   data_entry_[eid].CopyTo(data_out);
 }
 
@@ -310,6 +903,57 @@ void GraphExecutor::LoadParams(dmlc::Stream* strm) {
     if (in_idx < 0) continue;
     uint32_t eid = this->entry_id(input_nodes_[in_idx], 0);
     data_entry_[eid].CopyFrom(p.second);
+    param_entries_.insert(eid);
+    this->MarkParamTransformsDirty(eid);
+  }
+  // The parameters are transformed now rather than in the next run, unless the run is staged on
+  // streams of its own.
+  if (param_transforms_dirty_ && staging_streams_.empty()) {
+    threading::ThreadPoolGroupScope thread_pool_scope(thread_pool_group_);
+    this->RunParamTransforms();
+  }
+}
+
+void GraphExecutor::LoadParamsFromFile(const std::string& path) {
+  if (!IsMappableParamsFile(path)) {
+    SimpleBinaryFileStream strm(path, "rb");
+    this->LoadParams(&strm);
+    return;
+  }
+  Map<String, NDArray> params = LoadMappedParams(path);
+  std::vector<int> sid_users(storage_pool_.size(), 0);
+  for (int sid : attrs_.storage_id) {
+    ++sid_users[sid];
+  }
+  bool in_place = false;
+  for (auto& p : params) {
+    param_names_.insert(p.first);
+    int in_idx = GetInputIndex(p.first);
+    if (in_idx < 0) continue;
+    uint32_t eid = this->entry_id(input_nodes_[in_idx], 0);
+    param_entries_.insert(eid);
+    this->MarkParamTransformsDirty(eid);
+    int sid = attrs_.storage_id[eid];
+    const DLTensor* dst = data_entry_[eid].operator->();
+    const DLTensor* src = p.second.operator->();
+    if (dst->device.device_type == kDLCPU && sid_users[sid] == 1 &&
+        (attrs_.storage_scope.empty() || attrs_.storage_scope[eid].empty()) &&
+        TypeEqual(dst->dtype, src->dtype) &&
+        dst->ndim == src->ndim && std::equal(dst->shape, dst->shape + dst->ndim, src->shape) &&
+        reinterpret_cast<uintptr_t>(src->data) % kAllocAlignment == 0) {
+      // Drop the storage of the entry, the mapping is the only copy of the parameter.
+      data_entry_[eid] = p.second;
+      storage_pool_[sid] = p.second;
+      data_alignment_[eid] = details::GetDataAlignment(*src);
+      in_place = true;
+    } else {
+      data_entry_[eid].CopyFrom(p.second);
+    }
+  }
+  if (in_place) this->SetupOpExecs();
+  if (param_transforms_dirty_ && staging_streams_.empty()) {
+    threading::ThreadPoolGroupScope thread_pool_scope(thread_pool_group_);
+    this->RunParamTransforms();
   }
 }
 
@@ -334,10 +978,33 @@ void GraphExecutor::ShareParams(const GraphExecutor& other, dmlc::Stream* strm)
     ICHECK_GT(data_entry_[eid].use_count(), 1);
     const DLTensor* tmp = data_entry_[eid].operator->();
     data_alignment_[eid] = details::GetDataAlignment(*tmp);
+    param_entries_.insert(eid);
   }
   this->SetupOpExecs();
 }
 
+Module GraphExecutor::Clone(bool share_workspace) const {
+  auto exec = make_object<GraphExecutor>();
+  exec->nodes_ = nodes_;
+  exec->input_nodes_ = input_nodes_;
+  exec->node_row_ptr_ = node_row_ptr_;
+  exec->outputs_ = outputs_;
+  exec->attrs_ = attrs_;
+  exec->module_ = module_;
+  exec->devices_ = devices_;
+  exec->input_map_ = input_map_;
+  exec->output_map_ = output_map_;
+  exec->param_names_ = param_names_;
+  exec->param_entries_ = param_entries_;
+  // The linked parameters are static data of the module, the clone looks them up again.
+  GraphExecutor* self = exec.get();
+  exec->lookup_linked_param_ = PackedFunc(
+      [self](TVMArgs args, TVMRetValue* rv) { self->DefaultLookupLinkedParam(args, rv); });
+  exec->SetupStorage(this, share_workspace);
+  exec->SetupOpExecs();
+  return Module(exec);
+}
+
 void GraphExecutor::LinkedNDArrayDeleter(Object* container) {
   // container is the NDArray::Container which needs to get deleted.
   // The data member points to global const memory, so it does not need deleting.
@@ -375,13 +1042,31 @@ void GraphExecutor::DefaultLookupLinkedParam(TVMArgs args, TVMRetValue* rv) {
   *rv = NDArray(GetObjectPtr<Object>(container));
 }
 
-void GraphExecutor::SetupStorage() {
+void GraphExecutor::SetupStorage(const GraphExecutor* share_from, bool share_workspace) {
   // Grab saved optimization plan from graph.
   std::vector<DLDataType> vtype;
   for (const std::string& s_type : attrs_.dltype) {
     vtype.push_back(tvm::runtime::String2DLDataType(s_type));
   }
 
+  // The pool entries taken from share_from: those only holding parameters, and with
+  // share_workspace, those not holding an input or an output of the graph either.
+  std::vector<char> shared;
+  if (share_from != nullptr) {
+    std::unordered_set<uint32_t> io_entries;
+    for (uint32_t nid : input_nodes_) io_entries.insert(this->entry_id(nid, 0));
+    for (const NodeEntry& e : outputs_) io_entries.insert(this->entry_id(e));
+    shared.resize(share_from->storage_pool_.size(), 1);
+    for (size_t i = 0; i < attrs_.storage_id.size(); ++i) {
+      uint32_t eid = static_cast<uint32_t>(i);
+      bool is_param = share_from->param_entries_.count(eid) != 0;
+      if (!is_param && (!share_workspace || io_entries.count(eid) != 0)) {
+        shared[attrs_.storage_id[i]] = 0;
+      }
+    }
+  }
+  auto is_shared = [&shared](size_t sid) { return sid < shared.size() && shared[sid]; };
+
   // Size and device type of each storage pool entry.
   std::vector<PoolEntry> pool_entry;
   // Find the maximum space size.
@@ -402,7 +1087,7 @@ void GraphExecutor::SetupStorage() {
           << "The same pool entry cannot be assigned to multiple devices";
     }
     TVMRetValue lookup_rv;
-    {
+    if (!is_shared(sid)) {
       std::vector<int64_t> shape_vec{attrs_.shape[i].begin(), attrs_.shape[i].end()};
       DLTensor template_tensor{nullptr,  Device{kDLCPU, 0}, static_cast<int>(shape_vec.size()),
                                vtype[i], shape_vec.data(),  nullptr,
@@ -425,7 +1110,9 @@ void GraphExecutor::SetupStorage() {
       size_t bits = t.bits * t.lanes;
       ICHECK(bits % 8U == 0U || bits == 1U || bits == 4U);
       int64_t bytes = ((bits + 7U) / 8U) * size;
-      pool_entry[sid].shape[0] = std::max(pool_entry[sid].shape[0], bytes);
+      // Entries packed by the memory planner into one pool entry live at distinct offsets.
+      int64_t offset = attrs_.storage_offset.empty() ? 0 : attrs_.storage_offset[i];
+      pool_entry[sid].shape[0] = std::max(pool_entry[sid].shape[0], offset + bytes);
       pool_entry[sid].dtype = DLDataType{kDLFloat, 32, 1};
     } else {
       if (pool_entry[sid].shape.size() == 1) {
@@ -447,19 +1134,32 @@ void GraphExecutor::SetupStorage() {
     }
   }
 
+  for (const auto& [eid, alignment] : GetExternalIOAlignment()) {
+    PoolEntry& pit = pool_entry[attrs_.storage_id[eid]];
+    pit.alignment = std::max(pit.alignment, alignment);
+  }
+
   // Allocate the space.
-  for (const auto& pit : pool_entry) {
+  // The offset of the views of each pool entry, to align those requiring a larger alignment.
+  std::vector<uint64_t> base_offset(pool_entry.size(), 0);
+  for (size_t sid = 0; sid < pool_entry.size(); ++sid) {
+    const PoolEntry& pit = pool_entry[sid];
     // This for loop is very fast since there are usually only a couple of
     // devices available on the same hardware.
     const auto& cit = std::find_if(devices_.begin(), devices_.end(), [&pit](const Device& d) {
       return pit.device_type == static_cast<int>(d.device_type);
     });
     Device dev = cit == devices_.end() ? devices_[0] : *cit;
-    if (pit.linked_param.defined()) {
+    if (is_shared(sid)) {
+      storage_pool_.push_back(share_from->storage_pool_[sid]);
+    } else if (pit.linked_param.defined()) {
       storage_pool_.push_back(pit.linked_param);
     } else {
       std::vector<int64_t> shape = pit.shape;
+      bool over_aligned = shape.size() == 1 && pit.alignment > kAllocAlignment &&
+                          pit.scope.empty() && details::IsAddressable(dev);
       if (shape.size() == 1) {
+        if (over_aligned) shape[0] += pit.alignment;
         shape[0] = (shape[0] + 3) / 4;
       }
       Optional<String> mem_scope;
@@ -467,6 +1167,10 @@ void GraphExecutor::SetupStorage() {
         mem_scope = String(pit.scope);
       }
       storage_pool_.push_back(NDArray::Empty(shape, pit.dtype, dev, mem_scope));
+      if (over_aligned) {
+        auto addr = reinterpret_cast<uintptr_t>(storage_pool_.back()->data);
+        base_offset[sid] = (pit.alignment - addr % pit.alignment) % pit.alignment;
+      }
     }
   }
 
@@ -478,15 +1182,51 @@ void GraphExecutor::SetupStorage() {
   for (size_t i = 0; i < data_entry_.size(); ++i) {
     int storage_id = attrs_.storage_id[i];
     ICHECK_LT(static_cast<size_t>(storage_id), storage_pool_.size());
-    data_entry_[i] = storage_pool_[storage_id].CreateView(attrs_.shape[i], vtype[i]);
+    uint64_t offset = base_offset[storage_id];
+    offset += attrs_.storage_offset.empty() ? 0 : attrs_.storage_offset[i];
+    if (is_shared(storage_id)) {
+      // Also covers the entries of share_from which refer to memory outside its storage pool.
+      data_entry_[i] = share_from->data_entry_[i];
+    } else {
+      data_entry_[i] = storage_pool_[storage_id].CreateView(attrs_.shape[i], vtype[i], offset);
+    }
 
     const DLTensor* tmp = data_entry_[i].operator->();
     data_alignment_[i] = details::GetDataAlignment(*tmp);
   }
 }
 
+std::unordered_map<uint32_t, size_t> GraphExecutor::GetExternalIOAlignment() {
+  std::unordered_map<uint32_t, size_t> eid_alignment;
+  if (!module_.defined()) return eid_alignment;
+  for (uint32_t nid = 0; nid < this->GetNumOfNodes(); ++nid) {
+    const auto& inode = nodes_[nid];
+    if (inode.op_type != "tvm_op") continue;
+    // Implemented by the JSON runtimes of BYOC subgraphs
+    PackedFunc get_alignment = module_.GetFunction("__io_alignment_" + inode.param.func_name, true);
+    if (get_alignment == nullptr) continue;
+    int64_t alignment = get_alignment();
+    if (alignment <= 0) continue;
+    auto require = [&](uint32_t eid) {
+      eid_alignment[eid] = std::max(eid_alignment[eid], static_cast<size_t>(alignment));
+    };
+    for (const auto& e : inode.inputs) require(this->entry_id(e));
+    for (uint32_t index = 0; index < inode.param.num_outputs; ++index) {
+      require(this->entry_id(nid, index));
+    }
+  }
+  return eid_alignment;
+}
+
 void GraphExecutor::SetupOpExecs() {
   op_execs_.resize(this->GetNumOfNodes());
+  param_transforms_.clear();
+  param_transform_nids_.clear();
+  param_transform_inputs_.clear();
+  zero_copy_param_inputs_.clear();
+  op_submits_.clear();
+  op_completions_.clear();
+  completion_deps_.clear();
   input_dltensors_.resize(num_node_entries());
   output_dltensors_.resize(num_node_entries());
   both_output_opinput_dltensors_.resize(num_node_entries());
@@ -505,18 +1245,40 @@ void GraphExecutor::SetupOpExecs() {
     const auto& inode = nodes_[nid];
     if (inode.op_type == "null") continue;
     std::vector<DLTensor> args;
+    // Kernels expect their arguments to start at the data pointer, so fold the offset of the
+    // entries packed into a pool entry into it.
+    auto push_arg = [this, &args](uint32_t eid) {
+      DLTensor arg = *(data_entry_[eid].operator->());
+      arg.data = static_cast<char*>(arg.data) + arg.byte_offset;
+      arg.byte_offset = 0;
+      args.push_back(arg);
+    };
     for (const auto& e : inode.inputs) {
-      uint32_t eid = this->entry_id(e);
-      args.push_back(*(data_entry_[eid].operator->()));
+      push_arg(this->entry_id(e));
     }
     for (uint32_t index = 0; index < inode.param.num_outputs; ++index) {
-      uint32_t eid = this->entry_id(nid, index);
-      args.push_back(*(data_entry_[eid].operator->()));
+      push_arg(this->entry_id(nid, index));
     }
     ICHECK(inode.op_type == "tvm_op") << "Can only take tvm_op as op";
 
     std::shared_ptr<OpArgs> op_args = nullptr;
     std::tie(op_execs_[nid], op_args) = CreateTVMOp(inode.param, args);
+    // Implemented by the runtimes of NPU subgraphs, to overlap them with the host nodes
+    PackedFunc submit = module_.GetFunction("__async_" + inode.param.func_name, true);
+    if (submit != nullptr) SetupAsyncOp(nid, submit, op_args);
+    // The weight layout transforms of the inputs run when the inputs change, rather than every run
+    bool is_param_transform =
+        submit == nullptr && inode.param.attrs.count("layout_transform_only") &&
+        std::all_of(inode.inputs.begin(), inode.inputs.end(),
+                    [this](const NodeEntry& e) { return nodes_[e.node_id].op_type == "null"; });
+    if (is_param_transform) {
+      for (const auto& e : inode.inputs) {
+        param_transform_inputs_[this->entry_id(e)].push_back(param_transforms_.size());
+      }
+      param_transforms_.push_back(std::move(op_execs_[nid]));
+      param_transform_nids_.push_back(nid);
+      op_execs_[nid] = nullptr;
+    }
 
     for (size_t i = 0; i < inode.inputs.size(); i++) {
       uint32_t input_eid = this->entry_id(inode.inputs[i]);
@@ -541,6 +1303,71 @@ void GraphExecutor::SetupOpExecs() {
       }
     }
   }
+  if (!op_submits_.empty()) {
+    std::vector<std::vector<uint32_t>> preds = GetExecutionDependencies();
+    completion_deps_.resize(preds.size());
+    for (uint32_t nid = 0; nid < preds.size(); ++nid) {
+      for (uint32_t pred : preds[nid]) {
+        if (op_submits_[pred]) completion_deps_[nid].push_back(pred);
+      }
+    }
+  }
+  // The storage of the transforms may have been replaced, run them all again.
+  param_transform_dirty_.assign(param_transforms_.size(), true);
+  param_transforms_dirty_ = !param_transforms_.empty();
+  if (op_latency_ != nullptr) InstrumentOpExecs();
+}
+
+void GraphExecutor::RunParamTransforms() {
+  for (size_t i = 0; i < param_transforms_.size(); ++i) {
+    if (!param_transform_dirty_[i]) continue;
+    param_transforms_[i]();
+    param_transform_dirty_[i] = false;
+  }
+  param_transforms_dirty_ = false;
+}
+
+void GraphExecutor::MarkParamTransformsDirty(uint32_t eid) {
+  auto it = param_transform_inputs_.find(eid);
+  if (it == param_transform_inputs_.end()) return;
+  for (size_t index : it->second) {
+    param_transform_dirty_[index] = true;
+  }
+  param_transforms_dirty_ = true;
+}
+
+Map<String, String> GraphExecutor::GetParamLayoutTransforms() const {
+  Map<String, String> transforms;
+  for (uint32_t nid : param_transform_nids_) {
+    const Node& inode = nodes_[nid];
+    for (const auto& e : inode.inputs) {
+      transforms.Set(nodes_[e.node_id].name, inode.param.func_name);
+    }
+  }
+  return transforms;
+}
+
+void GraphExecutor::SetupAsyncOp(uint32_t nid, PackedFunc submit,
+                                 std::shared_ptr<OpArgs> op_args) {
+  if (op_submits_.empty()) {
+    op_submits_.resize(this->GetNumOfNodes());
+    op_completions_.resize(this->GetNumOfNodes());
+  }
+  auto completion = std::make_shared<PackedFunc>();
+  op_submits_[nid] = [op_args, submit, completion]() {
+    TVMRetValue rv;
+    TVMArgs targs(op_args->arg_values.data(), op_args->arg_tcodes.data(),
+                  static_cast<int>(op_args->arg_values.size()));
+    submit.CallPacked(targs, &rv);
+    // A null completion means the work was done before returning
+    *completion = rv;
+  };
+  op_completions_[nid] = [completion]() {
+    if (*completion == nullptr) return;
+    PackedFunc wait = std::move(*completion);
+    *completion = nullptr;
+    wait();
+  };
 }
 
 std::pair<std::function<void()>, std::shared_ptr<GraphExecutor::OpArgs>> GraphExecutor::CreateTVMOp(
@@ -584,6 +1411,22 @@ std::pair<std::function<void()>, std::shared_ptr<GraphExecutor::OpArgs>> GraphEx
   tvm::runtime::PackedFunc pf = module_.GetFunction(param.func_name, true);
   ICHECK(pf != nullptr) << "no such function in module: " << param.func_name;
 
+  // The kernels compiled into a library are called directly with the arguments packed here
+  if (TVMBackendPackedCFunc faddr = GetBackendPackedCFunc(module_, param.func_name)) {
+    auto fexec = [arg_ptr, faddr]() {
+      TVMValue ret_value;
+      int ret_type_code = kTVMNullptr;
+      int ret = (*faddr)(arg_ptr->arg_values.data(), arg_ptr->arg_tcodes.data(),
+                         static_cast<int>(arg_ptr->arg_values.size()), &ret_value,
+                         &ret_type_code, nullptr);
+      ICHECK_EQ(ret, 0) << TVMGetLastError();
+      if (ret_type_code != kTVMNullptr) {
+        TVMRetValue::MoveFromCHost(ret_value, ret_type_code);
+      }
+    };
+    return {fexec, arg_ptr};
+  }
+
   auto fexec = [arg_ptr, pf]() {
     TVMRetValue rv;
     TVMArgs targs(arg_ptr->arg_values.data(), arg_ptr->arg_tcodes.data(),
@@ -695,6 +1538,10 @@ PackedFunc GraphExecutor::GetFunction(const std::string& name,
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       this->LoadParams(args[0].operator std::string());
     });
+  } else if (name == "load_params_from_file") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->LoadParamsFromFile(args[0].operator std::string());
+    });
   } else if (name == "share_params") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       const auto& module = args[0].operator Module();
@@ -703,6 +1550,41 @@ PackedFunc GraphExecutor::GetFunction(const std::string& name,
       dmlc::MemoryStringStream strm(const_cast<std::string*>(&param_blob));
       this->ShareParams(dynamic_cast<const GraphExecutor&>(*module.operator->()), &strm);
     });
+  } else if (name == "clone") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      bool share_workspace = args.num_args > 0 ? args[0].operator bool() : false;
+      *rv = this->Clone(share_workspace);
+    });
+  } else if (name == "bind_numa_node") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      int nthreads = args.num_args > 1 ? args[1].operator int() : 0;
+      this->BindNumaNode(args[0], nthreads);
+    });
+  } else if (name == "set_parallel_execution") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->SetParallelExecution(args[0]);
+    });
+  } else if (name == "set_staging") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->SetStaging(args[0]);
+    });
+  } else if (name == "enable_op_latency_histograms") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->EnableOpLatencyHistograms(args[0]);
+    });
+  } else if (name == "get_op_latency_histograms") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      bool reset = args.num_args > 0 ? args[0].operator bool() : false;
+      *rv = this->GetOpLatencyHistograms(reset);
+    });
+  } else if (name == "bind_thread_pool_group") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->BindThreadPoolGroup(args[0].operator std::string());
+    });
+  } else if (name == "get_param_layout_transforms") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      *rv = this->GetParamLayoutTransforms();
+    });
   } else if (name == "get_input_index") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       CHECK(String::CanConvertFrom(args[0])) << "Input key is not a string";
@@ -39,6 +39,8 @@
 #include <utility>
 #include <vector>
 
+#include "../op_latency_recorder.h"
+
 namespace tvm {
 namespace runtime {
 
@@ -139,6 +141,12 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * \param data_in The input data.
    */
   void SetInput(int index, DLTensor* data_in);
+  /*!
+   * \brief set index-th input to a parameter, which the clones of the executor share.
+   * \param index The input index.
+   * \param data_in The parameter data.
+   */
+  void SetParam(int index, DLTensor* data_in);
   /*!
    * \brief set index-th input to the graph without copying the data
    * \param index The input index.
@@ -167,9 +175,10 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * \brief Return NDArray for given input index.
    * \param index The input index.
    *
-   * \return NDArray corresponding to given input node index.
+   * \return NDArray corresponding to given input node index. As the caller may write into it,
+   *  the weight layout transforms reading the input run again.
    */
-  NDArray GetInput(int index) const;
+  NDArray GetInput(int index);
   /*!
    * \brief Return NDArray for given output index.
    * \param index The output index.
@@ -193,6 +202,15 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * \param param_blob A binary blob of parameter.
    */
   void LoadParams(const std::string& param_blob);
+  /*!
+   * \brief Load parameters from a file.
+   *
+   *  A file written by SaveParamsToMappableFile is memory-mapped. The CPU parameters whose
+   *  storage is not shared with other entries then use the mapping in place, instead of a
+   *  private copy, and the other parameters are copied from it.
+   * \param path The path of the parameter file.
+   */
+  void LoadParamsFromFile(const std::string& path);
 
   /*!
    * \brief Share parameters from pre-existing GraphExecutor instance.
@@ -202,6 +220,79 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    */
   void ShareParams(const GraphExecutor& other, dmlc::Stream* strm);
 
+  /*!
+   * \brief Create another executor of the same graph, for serving requests concurrently.
+   *
+   *  The clone shares the compiled module and the storage of the parameters set by
+   *  load_params, share_params or the executor factory, and allocates its own storage for
+   *  the inputs, the outputs and the intermediate tensors. Setting a parameter of one of them
+   *  updates all of them. The settings of this executor, e.g. the bound thread pool group,
+   *  are not copied.
+   * \param share_workspace Whether the clone also shares the storage of the intermediate
+   *  tensors, which requires that the clone and this executor never run concurrently.
+   * \return The clone.
+   */
+  Module Clone(bool share_workspace) const;
+
+  /*!
+   * \brief Bind the executor to a NUMA node.
+   *
+   *  The CPU storage of the executor is migrated to the node, and the thread pool of
+   *  the thread calling Run is pinned to the CPUs of the node.
+   * \param node The id of the node.
+   * \param nthreads The number of threads to use (0 = use all the CPUs of the node).
+   */
+  void BindNumaNode(int node, int nthreads);
+
+  /*!
+   * \brief Run the executor on the workers of a thread pool group.
+   * \param name The name of the group created by threading::CreateThreadPoolGroup,
+   *  an empty name uses the thread pool of the calling thread.
+   */
+  void BindThreadPoolGroup(const std::string& name);
+
+  /*!
+   * \brief Run independent nodes of the graph concurrently.
+   *
+   *  The nodes whose dependencies are done are dispatched to `num_workers` worker threads.
+   *  Each worker runs the parallel operators on its own slice of the CPUs, and launches the
+   *  kernels on its own stream of each accelerator device. Besides the data dependencies, a node
+   *  writing to a storage shared by the memory plan waits for the earlier users of the storage.
+   * \param num_workers The number of workers, 0 or 1 runs the nodes one by one on the calling
+   *  thread.
+   */
+  void SetParallelExecution(int num_workers);
+
+  /*!
+   * \brief Stage the inputs and outputs on accelerators through double-buffered pinned memory.
+   *
+   *  SetInput copies the data to a pinned host buffer and uploads it on a copy stream into the
+   *  device slot which the run in flight does not read, so the upload for the next request
+   *  overlaps with the current Run. Run then executes on a stream of the executor and starts
+   *  downloading the outputs to pinned host buffers on the copy stream, which CopyOutputTo waits
+   *  for. Inputs and outputs on the CPU are not staged.
+   * \param enable Whether to enable the staging.
+   */
+  void SetStaging(bool enable);
+
+  /*!
+   * \brief Record the latency of every node into histograms, cheap enough to stay on.
+   *
+   *  One of every `sample_period` runs is timed. Nodes on the CPU are timed with the steady
+   *  clock, nodes on accelerators with device timers that are read later without blocking.
+   * \param sample_period Time one of every sample_period runs, 0 disables the recording.
+   */
+  void EnableOpLatencyHistograms(int sample_period);
+
+  /*!
+   * \brief Export the latency histograms of the nodes.
+   * \param reset Whether to clear the histograms.
+   * \return The histograms as JSON, see OpLatencyRecorder::ToJSON.
+   */
+  std::string GetOpLatencyHistograms(bool reset);
+
+  ~GraphExecutor();
+
   /*!
    * \brief Get total number of nodes.
    * \return Total number of nodes.
@@ -219,6 +310,8 @@ class TVM_DLL GraphExecutor : public ModuleNode {
     int param_data_entry;
     NDArray linked_param;
     std::string scope;
+    /*! \brief The alignment required by the external functions using the entry in place. */
+    size_t alignment = 0;
     //    PoolEntry(int s, int dev_type, void* pre_linked_param) :
     //        size(s), device_type(dev_type), pre_linked_param(std::move(pre_linked_param)) {}
   };
@@ -312,6 +405,7 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   struct GraphAttr {
     size_t storage_num_not_alloctaed{0};
     std::vector<int> storage_id;
+    std::vector<int64_t> storage_offset;
     std::vector<int> device_index;
     std::vector<std::string> dltype;
     std::vector<std::string> storage_scope;
@@ -366,6 +460,14 @@ class TVM_DLL GraphExecutor : public ModuleNode {
           ICHECK(reader->NextArrayItem());
           reader->Read(&device_index);
           ICHECK(!reader->NextArrayItem());
+        } else if (key == "storage_offset") {
+          reader->BeginArray();
+          ICHECK(reader->NextArrayItem());
+          reader->Read(&type);
+          ICHECK_EQ(type, "list_int");
+          ICHECK(reader->NextArrayItem());
+          reader->Read(&storage_offset);
+          ICHECK(!reader->NextArrayItem());
         } else {
           reader->BeginArray();
           ICHECK(reader->NextArrayItem());
@@ -420,10 +522,43 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   void DefaultLookupLinkedParam(TVMArgs args, TVMRetValue* rv);
   /*! \brief Delete NDArray::Container with linked (i.e. static) data. */
   static void LinkedNDArrayDeleter(Object* container);
-  /*! \brief Setup the temporal storage */
-  void SetupStorage();
+  /*!
+   * \brief Setup the temporal storage
+   * \param share_from The executor whose parameters the storage shares, if any.
+   * \param share_workspace Whether to also share the storage of the intermediate tensors.
+   */
+  void SetupStorage(const GraphExecutor* share_from = nullptr, bool share_workspace = false);
+  /*!
+   * \brief Get the alignment required of their arguments by the functions of external runtimes,
+   *  which read and write them in place.
+   * \return The alignment by entry id, for the entries of the functions requiring one.
+   */
+  std::unordered_map<uint32_t, size_t> GetExternalIOAlignment();
   /*! \brief Setup the executors. */
   void SetupOpExecs();
+  /*! \brief Run the weight layout transforms of the parameters which changed since the last run. */
+  void RunParamTransforms();
+  /*!
+   * \brief Mark the weight layout transforms reading an input as needing to run again.
+   * \param eid The entry of the input.
+   */
+  void MarkParamTransformsDirty(uint32_t eid);
+  /*!
+   * \brief Get the weight layout transforms which run when the parameters change, not every run.
+   * \return The name of the function transforming each input.
+   */
+  Map<String, String> GetParamLayoutTransforms() const;
+  /*!
+   * \brief Setup the asynchronous submission of a node, implemented by its function.
+   * \param nid The node.
+   * \param submit The function scheduling the node, and returning the function waiting for it.
+   * \param op_args The arguments of the node.
+   */
+  void SetupAsyncOp(uint32_t nid, PackedFunc submit, std::shared_ptr<OpArgs> op_args);
+  /*! \brief Run the nodes one by one, waiting for the asynchronous ones only when needed. */
+  void RunOverlapped();
+  /*! \brief Wrap the operators with the latency recording. */
+  void InstrumentOpExecs();
   /*!
    * \brief Check the legality of external DLTensor*.
    * \param external The external DLTensor*.
@@ -438,6 +573,12 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    */
   std::pair<std::function<void()>, std::shared_ptr<OpArgs>> CreateTVMOp(
       const TVMOpParam& attrs, const std::vector<DLTensor>& args);
+  /*!
+   * \brief Get the nodes each node has to wait for when nodes run concurrently,
+   *  i.e. the producers of its inputs and the earlier users of the storage it writes to.
+   * \return The dependencies of each node, empty for the nodes without an operator.
+   */
+  std::vector<std::vector<uint32_t>> GetExecutionDependencies() const;
   // Get node entry index.
   uint32_t entry_id(uint32_t nid, uint32_t index) const { return node_row_ptr_[nid] + index; }
   // Get node entry index.
@@ -450,6 +591,8 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   std::vector<uint32_t> input_nodes_;
   /*! \brief The parameter names. */
   std::unordered_set<std::string> param_names_;
+  /*! \brief The entries holding the parameters, which the clones share. */
+  std::unordered_set<uint32_t> param_entries_;
   /*! \brief Map of input names to input indices. */
   std::unordered_map<std::string, uint32_t> input_map_;
   /*! \brief Map of output names to output indices. */
@@ -478,6 +621,41 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   std::vector<size_t> data_alignment_;
   /*! \brief Operator on each node. */
   std::vector<std::function<void()>> op_execs_;
+  /*!
+   * \brief The weight layout transforms of the parameters, which run when the parameters change
+   *  rather than at every run. Their nodes have no operator in op_execs_.
+   */
+  std::vector<std::function<void()>> param_transforms_;
+  /*! \brief The node of each weight layout transform of the parameters. */
+  std::vector<uint32_t> param_transform_nids_;
+  /*! \brief Whether each weight layout transform of the parameters must run again. */
+  std::vector<bool> param_transform_dirty_;
+  /*! \brief The weight layout transforms of the parameters reading each input entry. */
+  std::unordered_map<uint32_t, std::vector<size_t>> param_transform_inputs_;
+  /*! \brief Whether any weight layout transform of the parameters must run again. */
+  bool param_transforms_dirty_{false};
+  /*!
+   * \brief The input entries read by weight layout transforms that were set without copy, whose
+   *  data may change between runs without notice, so their transforms run every time.
+   */
+  std::unordered_set<uint32_t> zero_copy_param_inputs_;
+  /*! \brief The latency recorder, null when the histograms are disabled. */
+  std::unique_ptr<OpLatencyRecorder> op_latency_;
+  /*! \brief Operator on each node wrapped with the latency recording. */
+  std::vector<std::function<void()>> instrumented_execs_;
+  /*!
+   * \brief The asynchronous submission of each node, empty when no node has one.
+   *
+   * A function of the module may have a `__async_<name>` counterpart, which schedules the work,
+   * e.g. on an NPU, and returns a function waiting for its outputs. The sequential execution then
+   * runs the next nodes on the host, and only waits before a node depending on the outputs or the
+   * storage of the asynchronous one.
+   */
+  std::vector<std::function<void()>> op_submits_;
+  /*! \brief The wait for the asynchronous submission of each node, a no-op once it is done. */
+  std::vector<std::function<void()>> op_completions_;
+  /*! \brief The asynchronous nodes each node depends on. */
+  std::vector<std::vector<uint32_t>> completion_deps_;
   /*! \brief Linked parameter lookup function. */
   PackedFunc lookup_linked_param_;
   /*! \brief Module's _lookup_linked_param function, used by DefaultLookupLinkedParam. */
@@ -487,6 +665,58 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * When the module does not include linked parmeters, module_lookup_linked_param_ will be nullptr.
    */
   bool module_lookup_linked_param_valid_;
+  /*! \brief The NUMA node the executor is bound to, -1 when it is not bound. */
+  int numa_node_{-1};
+  /*! \brief The number of threads to use on the NUMA node. */
+  int numa_nthreads_{0};
+  /*! \brief The thread pool group the executor runs on, empty for the thread local pool. */
+  std::string thread_pool_group_;
+  /*! \brief Runs the nodes concurrently, null when they run one by one. */
+  class WavefrontRunner;
+  std::shared_ptr<WavefrontRunner> wavefront_runner_;
+
+  /*! \brief The streams of an accelerator used by the staging. */
+  struct StagingStreams {
+    Device dev;
+    /*! \brief The stream Run executes on. */
+    TVMStreamHandle compute;
+    /*! \brief The stream of the uploads and downloads. */
+    TVMStreamHandle copy;
+    /*! \brief The current stream of the caller, restored at the end of Run. */
+    TVMStreamHandle saved{nullptr};
+  };
+  /*! \brief The double-buffered staging of an input or an output. */
+  struct Staging {
+    /*! \brief The index in staging_streams_, -1 when not set up, -2 when not stageable. */
+    int streams{-1};
+    /*! \brief The pinned host buffer of each slot. */
+    NDArray host[2];
+    /*! \brief The device buffers alternately bound to an input, unused for outputs. */
+    NDArray device[2];
+    /*! \brief The end of the last copy through each slot. */
+    void* copied[2]{nullptr, nullptr};
+    /*! \brief The end of the last run reading each device slot of an input. */
+    void* consumed[2]{nullptr, nullptr};
+    /*! \brief The slot bound to an input, or the slot of the last download of an output. */
+    int slot{0};
+    /*! \brief Whether an upload to the other slot waits to be bound by the next Run. */
+    bool pending{false};
+  };
+  /*! \brief Set up the staging of a data entry, return false when it cannot be staged. */
+  bool InitStaging(uint32_t eid, bool is_input, Staging* staging);
+  /*! \brief Upload an input through its staging, return false when it is not staged. */
+  bool StageInput(int index, DLTensor* data_in);
+  /*! \brief Bind the uploaded inputs and switch to the compute streams before a run. */
+  void BeginStagedRun();
+  /*! \brief Start downloading the outputs after a run, and restore the streams of the caller. */
+  void EndStagedRun();
+  /*! \brief Wait for the pending copies, restore the inputs and free the staging. */
+  void ReleaseStaging();
+  /*! \brief Whether the staging is enabled. */
+  bool staging_enabled_{false};
+  std::vector<StagingStreams> staging_streams_;
+  std::vector<Staging> input_staging_;
+  std::vector<Staging> output_staging_;
 };
 
 std::vector<Device> GetAllDevice(const TVMArgs& args, int dev_start_arg);
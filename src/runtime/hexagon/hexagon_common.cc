@@ -35,6 +35,7 @@
 #include "HAP_debug.h"
 #include "HAP_perf.h"
 #include "hexagon_buffer.h"
+#include "hexagon_device_api.h"
 
 namespace tvm {
 namespace runtime {
@@ -89,9 +90,31 @@ void LogMessageImpl(const std::string& file, int lineno, int level, const std::s
 }
 }  // namespace detail
 
+namespace {
+int HexagonBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task) {
+  hexagon::HexagonThreadManager* thread_manager =
+      hexagon::HexagonDeviceAPI::Global()->ThreadManagerIfAcquired();
+  if (thread_manager == nullptr) {
+    return TVMBackendParallelLaunch(flambda, cdata, num_task);
+  }
+  return thread_manager->ParallelLaunch(flambda, cdata, num_task);
+}
+}  // namespace
+
+Module CreateHexagonModuleFromLibrary(ObjectPtr<Library> lib) {
+  Module mod = CreateModuleFromLibrary(lib);
+  // Replace the thread pool of the CPU runtime set by `InitContextFunctions`, whose threads do
+  // not hold an HVX instance
+  using FParallelLaunch = decltype(&TVMBackendParallelLaunch);
+  if (auto* fp = reinterpret_cast<FParallelLaunch*>(lib->GetSymbol("__TVMBackendParallelLaunch"))) {
+    *fp = HexagonBackendParallelLaunch;
+  }
+  return mod;
+}
+
 TVM_REGISTER_GLOBAL("runtime.module.loadfile_hexagon").set_body([](TVMArgs args, TVMRetValue* rv) {
   ObjectPtr<Library> n = CreateDSOLibraryObject(args[0]);
-  *rv = CreateModuleFromLibrary(n);
+  *rv = CreateHexagonModuleFromLibrary(n);
 });
 
 }  // namespace runtime
@@ -49,4 +49,21 @@ inline bool IsHexagonDevice(DLDevice dev) { return dev.device_type == kDLHexagon
 
 constexpr int kHexagonAllocAlignment = 2048;
 
+namespace tvm {
+namespace runtime {
+
+class Library;
+
+/*!
+ * \brief Create a module from a library loaded on Hexagon. The parallel loops of the library run
+ * on the HVX threads of the runtime `HexagonThreadManager`, when the runtime resources are
+ * acquired.
+ * \param lib The library.
+ * \returns The module.
+ */
+Module CreateHexagonModuleFromLibrary(ObjectPtr<Library> lib);
+
+}  // namespace runtime
+}  // namespace tvm
+
 #endif  // TVM_RUNTIME_HEXAGON_HEXAGON_COMMON_H_
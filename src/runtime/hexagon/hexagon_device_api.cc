@@ -225,6 +225,28 @@ TVM_REGISTER_GLOBAL("device_api.hexagon.dma_copy").set_body([](TVMArgs args, TVM
   *rv = static_cast<int32_t>(ret);
 });
 
+TVM_REGISTER_GLOBAL("device_api.hexagon.dma_copy_2d")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      uint32_t queue_id = static_cast<int>(args[0]);
+      void* dst = args[1];
+      void* src = args[2];
+      uint32_t width = static_cast<int>(args[3]);
+      uint32_t height = static_cast<int>(args[4]);
+      uint32_t dst_stride = static_cast<int>(args[5]);
+      uint32_t src_stride = static_cast<int>(args[6]);
+      ICHECK(width > 0 && height > 0);
+      bool bypass_cache = args[7];
+
+      int ret = DMA_RETRY;
+      do {
+        ret = HexagonDeviceAPI::Global()->UserDMA()->Copy2D(queue_id, dst, src, width, height,
+                                                            dst_stride, src_stride, bypass_cache);
+      } while (ret == DMA_RETRY);
+      CHECK(ret == DMA_SUCCESS) << "Unsupported 2D DMA of " << height << " rows of " << width
+                                << " bytes, with strides " << dst_stride << " and " << src_stride;
+      *rv = static_cast<int32_t>(ret);
+    });
+
 TVM_REGISTER_GLOBAL("device_api.hexagon.dma_wait").set_body([](TVMArgs args, TVMRetValue* rv) {
   uint32_t queue_id = static_cast<int>(args[0]);
   int inflight = args[1];
@@ -153,11 +153,17 @@ class HexagonDeviceAPI final : public DeviceAPI {
     return runtime_threads.get();
   }
 
+  //! \brief The thread manager, or nullptr outside of `AcquireResources`.
+  HexagonThreadManager* ThreadManagerIfAcquired() { return runtime_threads.get(); }
+
   HexagonUserDMA* UserDMA() {
     CHECK(runtime_dma) << "runtime_dma has not been created";
     return runtime_dma.get();
   }
 
+  //! \brief The user DMA manager, or nullptr outside of `AcquireResources`.
+  HexagonUserDMA* UserDMAIfAcquired() { return runtime_dma.get(); }
+
   HexagonVtcmPool* VtcmPool() {
     CHECK(runtime_vtcm) << "runtime_vtcm has not been created";
     return runtime_vtcm.get();
@@ -188,7 +194,9 @@ class HexagonDeviceAPI final : public DeviceAPI {
   std::unique_ptr<HexagonThreadManager> runtime_threads;
   const unsigned threads{6};
   const unsigned pipe_size{1000};
-  const unsigned stack_size{0x4000};  // 16KB
+  // The HVX threads run the parallel loops of the generated code, as the 64KB threads of the
+  // CPU thread pool do
+  const unsigned stack_size{0x10000};  // 64KB
   const std::vector<HardwareResourceType> hw_resources{DMA_0, HTP_0, HVX_0, HVX_1, HVX_2, HVX_3};
 
   //! \brief User DMA manager
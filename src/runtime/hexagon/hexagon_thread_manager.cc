@@ -19,10 +19,34 @@
 
 #include "hexagon_thread_manager.h"
 
+#include <algorithm>
+
+#include "HAP_perf.h"
+
 namespace tvm {
 namespace runtime {
 namespace hexagon {
 
+namespace {
+
+//! \brief Distance between the barrier counters of two tasks, as in the CPU thread pool.
+constexpr int kSyncStride = 64 / sizeof(std::atomic<int>);
+
+//! \brief Whether the calling thread runs the tasks of a `ParallelLaunch`.
+thread_local bool in_parallel_task = false;
+
+//! \brief The tasks of a `ParallelJob` run by one HVX thread.
+struct ParallelShare {
+  void* job;
+  int first_task;
+};
+
+bool IsHvx(HardwareResourceType type) {
+  return (type == HVX_0) || (type == HVX_1) || (type == HVX_2) || (type == HVX_3);
+}
+
+}  // namespace
+
 HexagonThreadManager::HexagonThreadManager(unsigned num_threads, unsigned thread_stack_size_bytes,
                                            unsigned thread_pipe_size_words,
                                            const std::vector<HardwareResourceType> hw_resources) {
@@ -264,6 +288,84 @@ void HexagonThreadManager::WaitOnThreads() {
   }
 }
 
+int HexagonThreadManager::ParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task) {
+  std::vector<unsigned> hvx_threads;
+  for (unsigned i = 0; i < hw_resources_.size(); i++) {
+    if (IsHvx(hw_resources_[i])) {
+      hvx_threads.push_back(i);
+    }
+  }
+  if (num_task == 0) {
+    num_task = hvx_threads.size();
+  }
+  if (hvx_threads.empty() || num_task <= 1 || in_parallel_task) {
+    std::atomic<int> sync_counter{0};
+    TVMParallelGroupEnv env;
+    env.num_task = 1;
+    env.sync_handle = &sync_counter;
+    return flambda(0, &env, cdata);
+  }
+
+  std::lock_guard<std::mutex> lock(parallel_mutex_);
+  // In case Start() was never explicitly called, call it now to prevent deadlock
+  if (qurt_sem_get_val(&start_semaphore_) == 0) {
+    Start();
+  }
+
+  int nthreads = std::min<int>(hvx_threads.size(), num_task);
+  // The barrier requires all the tasks to run at the same time
+  std::unique_ptr<std::atomic<int>[]> sync_counter;
+  ParallelJob job;
+  job.flambda = flambda;
+  job.cdata = cdata;
+  job.env.num_task = num_task;
+  job.env.sync_handle = nullptr;
+  job.stride = nthreads;
+  job.busy_cycles = &hvx_busy_cycles_;
+  if (num_task <= nthreads) {
+    sync_counter.reset(new std::atomic<int>[num_task * kSyncStride]);
+    for (int i = 0; i < num_task; i++) {
+      sync_counter[i * kSyncStride].store(0, std::memory_order_relaxed);
+    }
+    job.env.sync_handle = sync_counter.get();
+  }
+  qurt_sem_init_val(&job.done, 0);
+
+  std::vector<ParallelShare> shares(nthreads);
+  for (int i = 0; i < nthreads; i++) {
+    shares[i] = ParallelShare{&job, i};
+    TVMStreamHandle thread = reinterpret_cast<TVMStreamHandle>(hvx_threads[i]);
+    while (!Dispatch(thread, thread_parallel_tasks, &shares[i])) {
+    }
+  }
+  for (int i = 0; i < nthreads; i++) {
+    qurt_sem_down(&job.done);
+  }
+  qurt_sem_destroy(&job.done);
+  return job.result.load();
+}
+
+unsigned HexagonThreadManager::NumHvxThreads() const {
+  return std::count_if(hw_resources_.begin(), hw_resources_.end(), IsHvx);
+}
+
+void HexagonThreadManager::thread_parallel_tasks(void* share) {
+  ParallelShare* tasks = static_cast<ParallelShare*>(share);
+  ParallelJob* job = static_cast<ParallelJob*>(tasks->job);
+  in_parallel_task = true;
+  uint64_t start = HAP_perf_get_pcycles();
+  for (int task_id = tasks->first_task; task_id < job->env.num_task; task_id += job->stride) {
+    int ret = job->flambda(task_id, &job->env, job->cdata);
+    int expected = 0;
+    if (ret != 0) {
+      job->result.compare_exchange_strong(expected, ret);
+    }
+  }
+  job->busy_cycles->fetch_add(HAP_perf_get_pcycles() - start, std::memory_order_relaxed);
+  in_parallel_task = false;
+  qurt_sem_up(&job->done);
+}
+
 void HexagonThreadManager::CheckSemaphore(unsigned syncID) {
   // We want the success case to be fast, so do not lock the mutex
   if (semaphores_.find(syncID) == semaphores_.end()) {
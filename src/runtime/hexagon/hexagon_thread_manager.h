@@ -20,11 +20,14 @@
 #ifndef TVM_RUNTIME_HEXAGON_HEXAGON_THREAD_MANAGER_H_
 #define TVM_RUNTIME_HEXAGON_HEXAGON_THREAD_MANAGER_H_
 
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/packed_func.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -145,6 +148,26 @@ class HexagonThreadManager {
   //! call to wait until all threads have empty pipes.
   void WaitOnThreads();
 
+  /*!
+   * \brief Run the tasks of a parallel loop on the threads holding an HVX instance, and wait for
+   * them to complete. This is the `TVMBackendParallelLaunch` of the modules loaded on Hexagon.
+   * \param flambda The function of the tasks.
+   * \param cdata The closure data passed to each task.
+   * \param num_task The number of tasks, or 0 for one task per HVX thread.
+   * \returns 0 on success, otherwise the nonzero value returned by a task.
+   * \note The tasks run in order on the calling thread when there is no HVX thread, and when the
+   * calling thread runs a task of another launch. `TVMBackendParallelBarrier` is supported when
+   * there are no more tasks than HVX threads.
+   */
+  int ParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task);
+
+  //! \brief Processor cycles the HVX threads spent running `ParallelLaunch` tasks, summed over
+  //! the threads.
+  uint64_t HvxBusyCycles() const { return hvx_busy_cycles_.load(std::memory_order_relaxed); }
+
+  //! \brief Number of threads holding an HVX instance.
+  unsigned NumHvxThreads() const;
+
  private:
   struct ThreadContext {
     qurt_pipe_t* pipe;
@@ -187,6 +210,30 @@ class HexagonThreadManager {
   //! \brief Void function executed by each thread as `main`.
   static void thread_main(void* context);
 
+  //! \brief State of a `ParallelLaunch`, shared by its tasks.
+  struct ParallelJob {
+    FTVMParallelLambda flambda;
+    void* cdata;
+    TVMParallelGroupEnv env;
+    //! \brief Number of HVX threads running the tasks; thread i runs the tasks i + k * stride.
+    int stride;
+    //! \brief First nonzero value returned by a task.
+    std::atomic<int> result{0};
+    //! \brief Signaled by each HVX thread when its tasks are complete.
+    qurt_sem_t done;
+    //! \brief Accumulates the cycles each HVX thread spends on its tasks.
+    std::atomic<uint64_t>* busy_cycles;
+  };
+
+  //! \brief Void function executed by an HVX thread to run its tasks of a `ParallelJob`.
+  static void thread_parallel_tasks(void* share);
+
+  //! \brief Protects the HVX threads between two `ParallelLaunch`.
+  std::mutex parallel_mutex_;
+
+  //! \brief See `HvxBusyCycles`.
+  std::atomic<uint64_t> hvx_busy_cycles_{0};
+
   //! \brief Manages underlying HexagonBuffer allocations.
   HexagonBufferManager hexbuffs_;
 
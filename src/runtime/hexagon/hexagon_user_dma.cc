@@ -21,6 +21,7 @@
 
 #include <algorithm>
 
+#include "HAP_perf.h"
 #include "hexagon_device_api.h"
 
 namespace tvm {
@@ -38,7 +39,33 @@ int HexagonUserDMA::Copy(uint32_t queue_id, void* dst, void* src, uint32_t lengt
   if (length > DESC_LENGTH_MASK) {
     return DMA_FAILURE;
   }
+  return Launch(queue_id, dst, src, length, 1, 0, 0, bypass_cache, DESC_DESCTYPE_1D);
+}
 
+int HexagonUserDMA::Copy2D(uint32_t queue_id, void* dst, void* src, uint32_t width,
+                           uint32_t height, uint32_t dst_stride, uint32_t src_stride,
+                           bool bypass_cache) {
+  // width, height and strides limited to 16 bits
+  if (!width || width > DESC_ROIWIDTH_MASK || !height ||
+      height > (DESC_ROIHEIGHT_MASK >> DESC_ROIHEIGHT_SHIFT)) {
+    return DMA_FAILURE;
+  }
+  if (src_stride > DESC_SRCSTRIDE_MASK ||
+      dst_stride > (DESC_DSTSTRIDE_MASK >> DESC_DSTSTRIDE_SHIFT)) {
+    return DMA_FAILURE;
+  }
+
+  // rows must not overlap
+  if (height > 1 && (width > src_stride || width > dst_stride)) {
+    return DMA_FAILURE;
+  }
+  return Launch(queue_id, dst, src, width, height, dst_stride, src_stride, bypass_cache,
+                DESC_DESCTYPE_2D);
+}
+
+int HexagonUserDMA::Launch(uint32_t queue_id, void* dst, void* src, uint32_t width,
+                           uint32_t height, uint32_t dst_stride, uint32_t src_stride,
+                           bool bypass_cache, unsigned int desctype) {
   // source address limited to 32 bits
   uint64_t src64 = reinterpret_cast<uint64_t>(src);
   if (!src64 || src64 > DESC_SRC_MASK) {
@@ -63,13 +90,17 @@ int HexagonUserDMA::Copy(uint32_t queue_id, void* dst, void* src, uint32_t lengt
   // populate descriptor fields
   dma_desc_set_state(dma_desc, DESC_STATE_READY);
   dma_desc_set_next(dma_desc, DMA_NULL_PTR);
-  dma_desc_set_length(dma_desc, length);
-  dma_desc_set_desctype(dma_desc, DESC_DESCTYPE_1D);
+  dma_desc_set_length(dma_desc, desctype == DESC_DESCTYPE_1D ? width : 0);
+  dma_desc_set_desctype(dma_desc, desctype);
   dma_desc_set_dstcomp(dma_desc, DESC_COMP_NONE);
   dma_desc_set_srccomp(dma_desc, DESC_COMP_NONE);
 
-  bool dst_is_ddr = !HexagonDeviceAPI::Global()->VtcmPool()->IsVtcm(dst, length);
-  bool src_is_ddr = !HexagonDeviceAPI::Global()->VtcmPool()->IsVtcm(src, length);
+  // the extent of the memory touched, from the first byte of the first row to the last byte of
+  // the last row
+  size_t src_extent = static_cast<size_t>(height - 1) * src_stride + width;
+  size_t dst_extent = static_cast<size_t>(height - 1) * dst_stride + width;
+  bool dst_is_ddr = !HexagonDeviceAPI::Global()->VtcmPool()->IsVtcm(dst, dst_extent);
+  bool src_is_ddr = !HexagonDeviceAPI::Global()->VtcmPool()->IsVtcm(src, src_extent);
 
   // VTCM -> DDR with bypass enabled
   if (dst_is_ddr && !src_is_ddr && bypass_cache) {
@@ -90,6 +121,18 @@ int HexagonUserDMA::Copy(uint32_t queue_id, void* dst, void* src, uint32_t lengt
   dma_desc_set_src(dma_desc, src32);
   dma_desc_set_dst(dma_desc, dst32);
 
+  if (desctype == DESC_DESCTYPE_2D) {
+    // the descriptors of the ring buffer are reused, so that all the box fields are written
+    dma_desc_set_cachealloc(dma_desc, DESC_CACHEALLOC_NONE);
+    dma_desc_set_padding(dma_desc, 0);
+    dma_desc_set_roiwidth(dma_desc, width);
+    dma_desc_set_roiheight(dma_desc, height);
+    dma_desc_set_srcstride(dma_desc, src_stride);
+    dma_desc_set_dststride(dma_desc, dst_stride);
+    dma_desc_set_srcwidthoffset(dma_desc, 0);
+    dma_desc_set_dstwidthoffset(dma_desc, 0);
+  }
+
   if (first_dma_) {
     // `dmstart` first descriptor
     dmstart(dma_desc);
@@ -105,9 +148,14 @@ int HexagonUserDMA::Copy(uint32_t queue_id, void* dst, void* src, uint32_t lengt
 }
 
 void HexagonUserDMA::Wait(uint32_t queue_id, uint32_t max_dmas_in_flight) {
+  if (DMAGroupsInFlight(queue_id) <= max_dmas_in_flight) {
+    return;
+  }
   // wait (forever) until max DMAs in flight <= actual DMAs in flight
+  uint64_t start = HAP_perf_get_pcycles();
   while (DMAGroupsInFlight(queue_id) > max_dmas_in_flight) {
   }
+  wait_cycles_.fetch_add(HAP_perf_get_pcycles() - start, std::memory_order_relaxed);
 }
 
 uint32_t HexagonUserDMA::Poll(uint32_t queue_id) { return DMAGroupsInFlight(queue_id); }
@@ -20,6 +20,8 @@
 #ifndef TVM_RUNTIME_HEXAGON_HEXAGON_USER_DMA_H_
 #define TVM_RUNTIME_HEXAGON_HEXAGON_USER_DMA_H_
 
+#include <atomic>
+
 #include "hexagon_common.h"
 #include "hexagon_user_dma_descriptors.h"
 #include "hexagon_user_dma_instructions.h"
@@ -56,6 +58,20 @@ class HexagonUserDMA {
    */
   int Copy(uint32_t queue_id, void* dst, void* src, uint32_t length, bool bypass_cache);
 
+  /*!
+   * \brief Initiate DMA to copy a box of rows from source to destination address
+   * \param queue_id The virtual DMA queue
+   * \param dst Destination address
+   * \param src Source address
+   * \param width Length in bytes of each row
+   * \param height Number of rows
+   * \param dst_stride Distance in bytes between the start of two rows of the destination
+   * \param src_stride Distance in bytes between the start of two rows of the source
+   * \returns Status: DMA_SUCCESS or DMA_FAILURE
+   */
+  int Copy2D(uint32_t queue_id, void* dst, void* src, uint32_t width, uint32_t height,
+             uint32_t dst_stride, uint32_t src_stride, bool bypass_cache);
+
   /*!
    * \brief Wait until the number of DMAs in flight is less than or equal to some maximum
    * \param queue_id The virtual DMA queue
@@ -71,6 +87,12 @@ class HexagonUserDMA {
    */
   uint32_t Poll(uint32_t queue_id);
 
+  /*!
+   * \brief Processor cycles spent in `Wait` on DMAs still in flight, over all queues
+   * \returns Number of cycles since the DMA engine was created
+   */
+  uint64_t WaitCycles() const { return wait_cycles_.load(std::memory_order_relaxed); }
+
   /*!
    * \brief Start a group of DMA copies
    * \param queue_id The virtual DMA queue
@@ -87,6 +109,13 @@ class HexagonUserDMA {
   //! \brief Initializes the Hexagon User DMA engine
   unsigned int Init();
 
+  /*!
+   * \brief Populate the next descriptor of a queue, and link it to the DMA chain
+   * \param desctype DESC_DESCTYPE_1D, to copy `width` bytes, or DESC_DESCTYPE_2D
+   */
+  int Launch(uint32_t queue_id, void* dst, void* src, uint32_t width, uint32_t height,
+             uint32_t dst_stride, uint32_t src_stride, bool bypass_cache, unsigned int desctype);
+
   /*!
    * \brief Calculates and returns the number of DMAs in flight
    * \param queue_id The virtual DMA queue
@@ -99,6 +128,9 @@ class HexagonUserDMA {
   //! \brief Tracks the tail DMA descriptor
   void* tail_dma_desc_ = nullptr;
 
+  //! \brief See `WaitCycles`
+  std::atomic<uint64_t> wait_cycles_{0};
+
   //! \brief Storage for all DMA descriptors
   QueuedRingBuffer<dma_desc_2d_t>* descriptors_ = nullptr;
 };
@@ -0,0 +1,207 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file hexagon_metric_collector.cc
+ * \brief Hexagon cycle counters exposed through profiling::MetricCollector and
+ * profiling::Report, aggregated on device.
+ */
+#include <HAP_perf.h>
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../hexagon_device_api.h"
+#include "prof_utils.h"
+
+namespace tvm {
+namespace runtime {
+namespace hexagon {
+
+using profiling::CountNode;
+using profiling::DurationNode;
+using profiling::MetricCollector;
+using profiling::MetricCollectorNode;
+using profiling::PercentNode;
+
+namespace {
+
+//! \brief Number of LWP regions named in the "LWP Top Regions" metric.
+constexpr size_t kNumTopRegions = 3;
+
+//! \brief Processor cycles and wall clock time at the last reset of the LWP buffer, used to
+//! convert cycles into microseconds at the average clock rate since then.
+struct ClockBase {
+  uint64_t pcycles = HAP_perf_get_pcycles();
+  uint64_t time_us = HAP_perf_get_time_us();
+};
+ClockBase clock_base;
+
+double CyclesPerUs() {
+  uint64_t us = HAP_perf_get_time_us() - clock_base.time_us;
+  if (us == 0) return 1.0;
+  return static_cast<double>(HAP_perf_get_pcycles() - clock_base.pcycles) / us;
+}
+
+uint64_t DMAWaitCycles() {
+  HexagonUserDMA* dma = HexagonDeviceAPI::Global()->UserDMAIfAcquired();
+  return dma ? dma->WaitCycles() : 0;
+}
+
+uint64_t HvxBusyCycles() {
+  HexagonThreadManager* threads = HexagonDeviceAPI::Global()->ThreadManagerIfAcquired();
+  return threads ? threads->HvxBusyCycles() : 0;
+}
+
+unsigned NumHvxThreads() {
+  HexagonThreadManager* threads = HexagonDeviceAPI::Global()->ThreadManagerIfAcquired();
+  return threads ? threads->NumHvxThreads() : 0;
+}
+
+}  // namespace
+
+/*! \brief Counter values at the start of a call, see HexagonMetricCollectorNode. */
+class HexagonCountersNode : public Object {
+ public:
+  uint64_t pcycles;
+  uint32_t lwp_offset;
+  uint64_t dma_wait_cycles;
+  uint64_t hvx_busy_cycles;
+
+  static constexpr const char* _type_key = "runtime.hexagon.HexagonCounters";
+  TVM_DECLARE_FINAL_OBJECT_INFO(HexagonCountersNode, Object);
+};
+
+/*! \brief MetricCollectorNode for the cycle counters of the Hexagon runtime.
+ *
+ * Every call reports its processor cycles, the share of them spent waiting on user DMA, and
+ * how busy the HVX threads were running parallel tasks. When the kernels are built with
+ * `tir.instrument_lwp`, the LWP records of the call are aggregated on device and the regions
+ * with the most cycles are named by their LWP ID.
+ */
+class HexagonMetricCollectorNode final : public MetricCollectorNode {
+ public:
+  void Init(Array<DeviceWrapper> devs) final {}
+
+  ObjectRef Start(Device dev) final {
+    if (dev.device_type != kDLHexagon && dev.device_type != kDLCPU) return ObjectRef(nullptr);
+    // The outermost call starts from an empty LWP buffer, so the 100 records per ID are not
+    // used up by earlier runs.
+    if (depth_++ == 0) {
+      ResetLWP();
+      clock_base = ClockBase();
+    }
+    auto node = make_object<HexagonCountersNode>();
+    node->lwp_offset = LWPBufferCount();
+    node->dma_wait_cycles = DMAWaitCycles();
+    node->hvx_busy_cycles = HvxBusyCycles();
+    node->pcycles = HAP_perf_get_pcycles();
+    return ObjectRef(node);
+  }
+
+  Map<String, ObjectRef> Stop(ObjectRef obj) final {
+    uint64_t pcycles = HAP_perf_get_pcycles();
+    const HexagonCountersNode* start = obj.as<HexagonCountersNode>();
+    ICHECK(start != nullptr);
+    depth_--;
+
+    uint64_t cycles = std::max<uint64_t>(pcycles - start->pcycles, 1);
+    uint64_t dma_wait = DMAWaitCycles() - start->dma_wait_cycles;
+    Map<String, ObjectRef> metrics;
+    metrics.Set("Cycles", ObjectRef(make_object<CountNode>(static_cast<int64_t>(cycles))));
+    metrics.Set("DMA Wait Cycles",
+                ObjectRef(make_object<CountNode>(static_cast<int64_t>(dma_wait))));
+    metrics.Set("DMA Wait", ObjectRef(make_object<PercentNode>(100.0 * dma_wait / cycles)));
+    if (unsigned num_hvx = NumHvxThreads()) {
+      uint64_t busy = HvxBusyCycles() - start->hvx_busy_cycles;
+      metrics.Set("HVX Busy",
+                  ObjectRef(make_object<PercentNode>(100.0 * busy / (cycles * num_hvx))));
+    }
+
+    std::map<uint32_t, LWPStats> regions = AggregateLWP(start->lwp_offset);
+    if (!regions.empty()) {
+      std::vector<std::pair<uint32_t, LWPStats>> top(regions.begin(), regions.end());
+      std::sort(top.begin(), top.end(), [](const auto& a, const auto& b) {
+        return a.second.cycles > b.second.cycles;
+      });
+      std::ostringstream os;
+      for (size_t i = 0; i < std::min(top.size(), kNumTopRegions); ++i) {
+        os << (i ? ", " : "") << top[i].first << ":" << (100 * top[i].second.cycles / cycles)
+           << "%";
+      }
+      metrics.Set("LWP Top Regions", String(os.str()));
+    }
+    return metrics;
+  }
+
+  static constexpr const char* _type_key = "runtime.profiling.HexagonMetricCollector";
+  TVM_DECLARE_FINAL_OBJECT_INFO(HexagonMetricCollectorNode, MetricCollectorNode);
+
+ private:
+  //! \brief Number of calls started and not stopped yet, the "Total" frame included.
+  int depth_ = 0;
+};
+
+/*!
+ * \brief Build a Report with one row per LWP ID from the records since the last reset.
+ *
+ * The durations are converted from cycles at the average clock rate since the reset.
+ */
+profiling::Report LWPReport() {
+  double cycles_per_us = CyclesPerUs();
+  Array<Map<String, ObjectRef>> calls;
+  for (const auto& p : AggregateLWP()) {
+    Map<String, ObjectRef> row;
+    row.Set("Name", String("lwp " + std::to_string(p.first)));
+    row.Set("Device", String("hexagon0"));
+    row.Set("Count", ObjectRef(make_object<CountNode>(static_cast<int64_t>(p.second.count))));
+    row.Set("Cycles", ObjectRef(make_object<CountNode>(static_cast<int64_t>(p.second.cycles))));
+    row.Set("Duration (us)", ObjectRef(make_object<DurationNode>(p.second.cycles / cycles_per_us)));
+    calls.push_back(row);
+  }
+  Map<String, ObjectRef> config;
+  config.Set("Cycles per us", ObjectRef(make_object<profiling::RatioNode>(cycles_per_us)));
+  return profiling::Report(calls, {}, config);
+}
+
+TVM_REGISTER_OBJECT_TYPE(HexagonCountersNode);
+TVM_REGISTER_OBJECT_TYPE(HexagonMetricCollectorNode);
+
+TVM_REGISTER_GLOBAL("runtime.profiling.HexagonMetricCollector").set_body_typed([]() {
+  return MetricCollector(make_object<HexagonMetricCollectorNode>());
+});
+
+// A Report cannot be returned over RPC, so it is serialized here, as in "profile_rpc".
+TVM_REGISTER_GLOBAL("tvm.hexagon.lwp_report").set_body_typed([]() {
+  return LWPReport()->AsJSON();
+});
+
+TVM_REGISTER_GLOBAL("tvm.hexagon.lwp_reset").set_body_typed([]() {
+  ResetLWP();
+  clock_base = ClockBase();
+});
+
+}  // namespace hexagon
+}  // namespace runtime
+}  // namespace tvm
@@ -17,9 +17,13 @@
  * under the License.
  */
 
+#include "prof_utils.h"
+
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
 
 // The max loop/function id used among all lwp_handler calls. Since
 // the id is used to index into the lwp_counter buffer, the size of the
@@ -76,3 +80,32 @@ bool WriteLWPOutput(const std::string& out_json) {
   ofc.close();
   return true;
 }
+
+uint32_t LWPBufferCount() { return __lwp_buffer_count; }
+
+void ResetLWP() {
+  memset(lwp_counter, 0, sizeof(lwp_counter));
+  __lwp_buffer_count = 0;
+}
+
+std::map<uint32_t, LWPStats> AggregateLWP(uint32_t begin) {
+  std::map<uint32_t, LWPStats> stats;
+  // The handler is called with the same ID when entering and leaving a function or loop, and
+  // generated code does not recurse, so the records of an ID alternate between start and end.
+  // Records are dropped after 100 invocations of an ID, an even number, so no pair is split.
+  std::unordered_map<uint32_t, uint64_t> open;
+  for (uint32_t i = begin; i + 4 <= __lwp_buffer_count; i += 4) {
+    uint32_t id = lwp_buffer[i + 1];
+    uint64_t pcycles = (static_cast<uint64_t>(lwp_buffer[i + 3]) << 32) + lwp_buffer[i + 2];
+    auto it = open.find(id);
+    if (it == open.end()) {
+      open[id] = pcycles;
+      continue;
+    }
+    LWPStats& s = stats[id];
+    s.count++;
+    s.cycles += pcycles - it->second;
+    open.erase(it);
+  }
+  return stats;
+}
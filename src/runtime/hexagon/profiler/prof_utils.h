@@ -23,8 +23,33 @@
 #ifndef TVM_RUNTIME_HEXAGON_PROFILER_PROF_UTILS_H_
 #define TVM_RUNTIME_HEXAGON_PROFILER_PROF_UTILS_H_
 
+#include <cstdint>
+#include <map>
 #include <string>
 
 bool WriteLWPOutput(const std::string&);
 
+/*! \brief Cycles of one instrumented function or loop, aggregated on device. */
+struct LWPStats {
+  /*! \brief Number of completed start/end pairs. */
+  uint64_t count = 0;
+  /*! \brief Processor cycles summed over the pairs. */
+  uint64_t cycles = 0;
+};
+
+/*! \brief Current number of uint32 words recorded in the LWP buffer. */
+uint32_t LWPBufferCount();
+
+/*! \brief Clear the LWP buffer and the per ID invocation counts, so that every ID records
+ * up to 100 invocations again. */
+void ResetLWP();
+
+/*!
+ * \brief Pair the start and end records of each ID and sum their cycles.
+ * \param begin The offset into the LWP buffer of the first record to consider, as returned
+ * by LWPBufferCount. A start recorded before `begin` is not matched.
+ * \return The stats of each ID that completed at least one pair.
+ */
+std::map<uint32_t, LWPStats> AggregateLWP(uint32_t begin = 0);
+
 #endif  // TVM_RUNTIME_HEXAGON_PROFILER_PROF_UTILS_H_
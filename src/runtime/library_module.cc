@@ -26,8 +26,17 @@
 #include <dmlc/memory_io.h>
 #include <tvm/runtime/module.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/runtime/threading_backend.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -38,7 +47,11 @@ namespace runtime {
 class LibraryModuleNode final : public ModuleNode {
  public:
   explicit LibraryModuleNode(ObjectPtr<Library> lib, PackedFuncWrapper wrapper)
-      : lib_(lib), packed_func_wrapper_(wrapper) {}
+      : lib_(lib), packed_func_wrapper_(wrapper) {
+    // The functions can be called by their address only when they are wrapped as is
+    auto* fwrap = wrapper.target<decltype(&WrapPackedFunc)>();
+    direct_call_ = fwrap != nullptr && *fwrap == WrapPackedFunc;
+  }
 
   const char* type_key() const final { return "library"; }
 
@@ -48,23 +61,47 @@ class LibraryModuleNode final : public ModuleNode {
   };
 
   PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
-    TVMBackendPackedCFunc faddr;
+    if (name == runtime::symbol::tvm_get_backend_func) {
+      if (!direct_call_) return PackedFunc();
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        *rv = reinterpret_cast<void*>(GetBackendFunc(args[0]));
+      });
+    }
+    TVMBackendPackedCFunc faddr = GetBackendFunc(name);
+    if (faddr == nullptr) return PackedFunc();
+    return packed_func_wrapper_(faddr, sptr_to_self);
+  }
+
+ private:
+  TVMBackendPackedCFunc GetBackendFunc(const std::string& name) {
+    // The executors look up the same functions once per operator node, and once per instance.
+    std::lock_guard<std::mutex> lock(func_cache_mutex_);
+    auto it = func_cache_.find(name);
+    if (it == func_cache_.end()) {
+      it = func_cache_.emplace(name, LookupBackendFunc(name)).first;
+    }
+    return it->second;
+  }
+
+  TVMBackendPackedCFunc LookupBackendFunc(const std::string& name) {
     if (name == runtime::symbol::tvm_module_main) {
       const char* entry_name =
           reinterpret_cast<const char*>(lib_->GetSymbol(runtime::symbol::tvm_module_main));
       ICHECK(entry_name != nullptr)
           << "Symbol " << runtime::symbol::tvm_module_main << " is not presented";
-      faddr = reinterpret_cast<TVMBackendPackedCFunc>(lib_->GetSymbol(entry_name));
-    } else {
-      faddr = reinterpret_cast<TVMBackendPackedCFunc>(lib_->GetSymbol(name.c_str()));
+      return reinterpret_cast<TVMBackendPackedCFunc>(lib_->GetSymbol(entry_name));
     }
-    if (faddr == nullptr) return PackedFunc();
-    return packed_func_wrapper_(faddr, sptr_to_self);
+    return reinterpret_cast<TVMBackendPackedCFunc>(lib_->GetSymbol(name.c_str()));
   }
 
- private:
   ObjectPtr<Library> lib_;
   PackedFuncWrapper packed_func_wrapper_;
+  /*! \brief Whether the functions are wrapped by WrapPackedFunc. */
+  bool direct_call_;
+  /*! \brief The symbols resolved so far, including the missing ones. */
+  std::unordered_map<std::string, TVMBackendPackedCFunc> func_cache_;
+  /*! \brief Guards func_cache_. */
+  std::mutex func_cache_mutex_;
 };
 
 /*!
@@ -89,6 +126,37 @@ PackedFunc WrapPackedFunc(TVMBackendPackedCFunc faddr, const ObjectPtr<Object>&
   });
 }
 
+namespace {
+
+/*!
+ * \brief Find the module serving a function, and get the address of the function from it.
+ * \param mod The module, searched before its imports.
+ * \param name The name of the function.
+ * \param faddr The address of the function, or nullptr if the module can only call it packed.
+ * \return Whether the function is in the module or its imports.
+ */
+bool FindBackendPackedCFunc(Module mod, const std::string& name, TVMBackendPackedCFunc* faddr) {
+  if (mod->GetFunction(name, false) != nullptr) {
+    PackedFunc fget = mod->GetFunction(symbol::tvm_get_backend_func, false);
+    *faddr = fget != nullptr ? reinterpret_cast<TVMBackendPackedCFunc>(
+                                   static_cast<void*>(fget(name)))
+                             : nullptr;
+    return true;
+  }
+  for (const Module& m : mod->imports()) {
+    if (FindBackendPackedCFunc(m, name, faddr)) return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+TVMBackendPackedCFunc GetBackendPackedCFunc(const Module& mod, const std::string& name) {
+  TVMBackendPackedCFunc faddr = nullptr;
+  FindBackendPackedCFunc(mod, name, &faddr);
+  return faddr;
+}
+
 void InitContextFunctions(std::function<void*(const char*)> fgetsymbol) {
 #define TVM_INIT_CONTEXT_FUNC(FuncName)                                                \
   if (auto* fp = reinterpret_cast<decltype(&FuncName)*>(fgetsymbol("__" #FuncName))) { \
@@ -102,6 +170,8 @@ void InitContextFunctions(std::function<void*(const char*)> fgetsymbol) {
   TVM_INIT_CONTEXT_FUNC(TVMBackendFreeWorkspace);
   TVM_INIT_CONTEXT_FUNC(TVMBackendParallelLaunch);
   TVM_INIT_CONTEXT_FUNC(TVMBackendParallelBarrier);
+  TVM_INIT_CONTEXT_FUNC(TVMBackendProfileRegionBegin);
+  TVM_INIT_CONTEXT_FUNC(TVMBackendProfileRegionEnd);
 
 #undef TVM_INIT_CONTEXT_FUNC
 }
@@ -128,6 +198,119 @@ Module LoadModuleFromBinary(const std::string& type_key, dmlc::Stream* stream) {
   return (*f)(static_cast<void*>(stream));
 }
 
+namespace {
+
+/*!
+ * \brief Get the number of threads deserializing the imported modules of a blob.
+ *  It can be set by the environment variable TVM_MODULE_LOAD_THREADS, 1 loads them serially.
+ */
+int GetModuleLoadThreads() {
+  const char* val = getenv("TVM_MODULE_LOAD_THREADS");
+  if (val != nullptr) {
+    return std::max(atoi(val), 1);
+  }
+  return std::max(threading::MaxConcurrency(), 1);
+}
+
+/*!
+ * \brief Read the entry table at the end of a module blob.
+ * \param data The blob stream.
+ * \param nbytes The size of the blob stream.
+ * \param num_entries The number of entries in the blob.
+ * \return The offsets of the entries, or an empty vector if the blob has no valid table.
+ * \sa kModuleBlobEntryTableMagic
+ */
+std::vector<uint64_t> ReadEntryTable(const char* data, uint64_t nbytes, uint64_t num_entries) {
+  auto f_read = [data](uint64_t pos) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(value); ++i) {
+      uint64_t c = data[pos + i];
+      value |= (c & 0xffUL) << (i * 8);
+    }
+    return value;
+  };
+  uint64_t table_bytes = (num_entries + 2) * sizeof(uint64_t);
+  if (num_entries == 0 || nbytes < table_bytes + sizeof(uint64_t)) return {};
+  uint64_t table_begin = nbytes - table_bytes;
+  if (f_read(nbytes - sizeof(uint64_t)) != kModuleBlobEntryTableMagic ||
+      f_read(nbytes - 2 * sizeof(uint64_t)) != num_entries) {
+    return {};
+  }
+  std::vector<uint64_t> offsets(num_entries);
+  uint64_t prev = 0;
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    offsets[i] = f_read(table_begin + i * sizeof(uint64_t));
+    // The entries follow the entry count, in order, and end before the table.
+    if (offsets[i] < std::max<uint64_t>(prev, sizeof(uint64_t)) || offsets[i] >= table_begin) {
+      return {};
+    }
+    prev = offsets[i] + 1;
+  }
+  return offsets;
+}
+
+/*!
+ * \brief Deserialize the imported modules of a blob in parallel.
+ * \param data The blob stream.
+ * \param nbytes The size of the blob stream.
+ * \param offsets The offsets of the entries.
+ * \return The module of each entry, undefined for the "_lib" and "_import_tree" entries.
+ */
+std::vector<Module> LoadEntriesInParallel(const char* data, uint64_t nbytes,
+                                          const std::vector<uint64_t>& offsets) {
+  std::vector<Module> modules(offsets.size());
+  std::vector<std::pair<size_t, std::string>> entries;
+  for (size_t i = 0; i < offsets.size(); ++i) {
+    dmlc::MemoryFixedSizeStream fs(const_cast<char*>(data), static_cast<size_t>(nbytes));
+    fs.Seek(offsets[i]);
+    dmlc::Stream* stream = &fs;
+    std::string tkey;
+    ICHECK(stream->Read(&tkey));
+    if (tkey != "_lib" && tkey != "_import_tree") {
+      entries.emplace_back(i, std::move(tkey));
+    }
+  }
+  int num_threads = std::min<int>(GetModuleLoadThreads(), entries.size());
+  if (num_threads <= 1) return modules;
+
+  std::atomic<size_t> next{0};
+  std::exception_ptr error = nullptr;
+  std::mutex error_mutex;
+  auto f_worker = [&]() {
+    for (size_t k = next++; k < entries.size(); k = next++) {
+      try {
+        size_t i = entries[k].first;
+        dmlc::MemoryFixedSizeStream fs(const_cast<char*>(data), static_cast<size_t>(nbytes));
+        fs.Seek(offsets[i]);
+        dmlc::Stream* stream = &fs;
+        std::string tkey;
+        ICHECK(stream->Read(&tkey));
+        modules[i] = LoadModuleFromBinary(tkey, stream);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (error == nullptr) error = std::current_exception();
+        next = entries.size();
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  try {
+    for (int i = 1; i < num_threads; ++i) {
+      threads.emplace_back(f_worker);
+    }
+  } catch (const std::system_error&) {
+    // The threads cannot be created, e.g. in wasm without pthreads, load the rest here.
+  }
+  f_worker();
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  if (error != nullptr) std::rethrow_exception(error);
+  return modules;
+}
+
+}  // namespace
+
 /*!
  * \brief Load and append module blob to module list
  * \param mblob The module blob.
@@ -149,12 +332,21 @@ void ProcessModuleBlob(const char* mblob, ObjectPtr<Library> lib,
   dmlc::Stream* stream = &fs;
   uint64_t size;
   ICHECK(stream->Read(&size));
+  // The blobs exported by older versions have no entry table, and are loaded serially.
+  std::vector<uint64_t> offsets = ReadEntryTable(mblob + sizeof(nbytes), nbytes, size);
+  std::vector<Module> loaded;
+  if (!offsets.empty()) {
+    loaded = LoadEntriesInParallel(mblob + sizeof(nbytes), nbytes, offsets);
+  }
   std::vector<Module> modules;
   std::vector<uint64_t> import_tree_row_ptr;
   std::vector<uint64_t> import_tree_child_indices;
   int num_dso_module = 0;
 
   for (uint64_t i = 0; i < size; ++i) {
+    if (!offsets.empty()) {
+      fs.Seek(offsets[i]);
+    }
     std::string tkey;
     ICHECK(stream->Read(&tkey));
     // "_lib" serves as a placeholder in the module import tree to indicate where
@@ -169,6 +361,8 @@ void ProcessModuleBlob(const char* mblob, ObjectPtr<Library> lib,
     } else if (tkey == "_import_tree") {
       ICHECK(stream->Read(&import_tree_row_ptr));
       ICHECK(stream->Read(&import_tree_child_indices));
+    } else if (!loaded.empty() && loaded[i].defined()) {
+      modules.emplace_back(loaded[i]);
     } else {
       auto m = LoadModuleFromBinary(tkey, stream);
       modules.emplace_back(m);
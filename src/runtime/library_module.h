@@ -44,6 +44,17 @@ namespace runtime {
  */
 Module LoadModuleFromBinary(const std::string& type_key, dmlc::Stream* stream);
 
+/*!
+ * \brief The magic number that ends the entry table of a module blob.
+ *
+ *  The serializer appends the table after the last entry of the blob, so that the
+ *  entries can be located, and deserialized, independently of each other:
+ *  uint64 offset[num_entries], uint64 num_entries, uint64 magic.
+ *  The offsets are relative to the start of the blob stream. Older runtimes stop
+ *  reading after the last entry, and ignore the table.
+ */
+constexpr uint64_t kModuleBlobEntryTableMagic = 0x454C42414D564DF1ULL;
+
 /*!
  * \brief Library is the common interface
  *  for storing data in the form of shared libaries.
@@ -72,6 +83,17 @@ class Library : public Object {
  */
 PackedFunc WrapPackedFunc(TVMBackendPackedCFunc faddr, const ObjectPtr<Object>& mptr);
 
+/*!
+ * \brief Get the address of a function of a module, or of its imports, to call it directly, with
+ *  the arguments packed once for all the calls, instead of through its PackedFunc.
+ * \param mod The module, which keeps the function alive.
+ * \param name The name of the function.
+ * \return The address of the function, or nullptr if it is not compiled into a library by TVM,
+ *  or is not wrapped by WrapPackedFunc, and has to be called as a PackedFunc.
+ * \note The caller checks the return code, and frees the returned value if there is one.
+ */
+TVMBackendPackedCFunc GetBackendPackedCFunc(const Module& mod, const std::string& name);
+
 /*!
  * \brief Utility to initialize conext function symbols during startup
  * \param fgetsymbol A symbol lookup function.
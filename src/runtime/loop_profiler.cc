@@ -0,0 +1,224 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file loop_profiler.cc
+ * \brief Runtime sink of the loop regions inserted by the InstrumentProfileIntrinsics pass.
+ */
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+namespace {
+
+int64_t NowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/*! \brief The regions recorded by one thread, as a tree of the nested regions. */
+struct ThreadRegions {
+  struct Node {
+    std::string func_name;
+    int32_t region_id;
+    int parent;
+    int64_t count;
+    int64_t total_ns;
+  };
+  struct Frame {
+    int node;
+    int32_t region_id;
+    int64_t begin_ns;
+  };
+  /*! \brief Only contended while the regions are collected. */
+  std::mutex mutex;
+  std::vector<Node> nodes;
+  /*! \brief (parent node, function, region id) to node. */
+  std::map<std::tuple<int, const char*, int32_t>, int> index;
+  std::vector<Frame> stack;
+
+  void Begin(const char* func_name, int32_t region_id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    int parent = stack.empty() ? -1 : stack.back().node;
+    auto key = std::make_tuple(parent, func_name, region_id);
+    auto it = index.find(key);
+    int node;
+    if (it == index.end()) {
+      node = static_cast<int>(nodes.size());
+      nodes.push_back(Node{func_name, region_id, parent, 0, 0});
+      index.emplace(key, node);
+    } else {
+      node = it->second;
+    }
+    stack.push_back(Frame{node, region_id, NowNanos()});
+  }
+
+  /*! \brief Drop the regions, the caller holds the mutex. */
+  void Clear() {
+    nodes.clear();
+    index.clear();
+    stack.clear();
+  }
+
+  void End(int32_t region_id) {
+    int64_t end_ns = NowNanos();
+    std::lock_guard<std::mutex> lock(mutex);
+    // Regions begun before the recording started have no frame.
+    for (size_t i = stack.size(); i-- > 0;) {
+      if (stack[i].region_id != region_id) continue;
+      Node& node = nodes[stack[i].node];
+      node.count += 1;
+      node.total_ns += end_ns - stack[i].begin_ns;
+      stack.resize(i);
+      return;
+    }
+  }
+};
+
+class LoopProfiler {
+ public:
+  static LoopProfiler* Global() {
+    static LoopProfiler* inst = new LoopProfiler();
+    return inst;
+  }
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  ThreadRegions* Local() {
+    thread_local std::shared_ptr<ThreadRegions> local;
+    if (local == nullptr) {
+      local = std::make_shared<ThreadRegions>();
+      std::lock_guard<std::mutex> lock(mutex_);
+      threads_.push_back(local);
+    }
+    return local.get();
+  }
+
+  void Start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& thread : threads_) {
+      std::lock_guard<std::mutex> thread_lock(thread->mutex);
+      thread->Clear();
+    }
+    enabled_.store(true);
+  }
+
+  Report Stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    enabled_.store(false);
+    std::vector<Map<String, ObjectRef>> calls;
+    double total_us = 0;
+    for (auto& thread : threads_) {
+      std::lock_guard<std::mutex> thread_lock(thread->mutex);
+      const std::vector<ThreadRegions::Node>& nodes = thread->nodes;
+      std::vector<int64_t> self_ns(nodes.size());
+      for (size_t i = 0; i < nodes.size(); ++i) {
+        self_ns[i] += nodes[i].total_ns;
+        if (nodes[i].parent >= 0) {
+          self_ns[nodes[i].parent] -= nodes[i].total_ns;
+        } else {
+          total_us += nodes[i].total_ns / 1e3;
+        }
+      }
+      for (size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].count == 0) continue;
+        // name the region after its function and the regions enclosing it.
+        std::string nest;
+        for (int n = static_cast<int>(i); n >= 0; n = nodes[n].parent) {
+          nest = "/" + std::to_string(nodes[n].region_id) + nest;
+          if (nodes[n].parent >= 0 && nodes[nodes[n].parent].func_name != nodes[n].func_name) {
+            break;
+          }
+        }
+        Map<String, ObjectRef> call;
+        call.Set("Name", String(nodes[i].func_name + nest));
+        call.Set("Function", String(nodes[i].func_name));
+        call.Set("Region", String(nest.substr(1)));
+        call.Set("Device", String("cpu0"));
+        call.Set("Count", ObjectRef(make_object<CountNode>(nodes[i].count)));
+        call.Set("Duration (us)", ObjectRef(make_object<DurationNode>(nodes[i].total_ns / 1e3)));
+        call.Set("Self (us)", ObjectRef(make_object<DurationNode>(self_ns[i] / 1e3)));
+        calls.push_back(call);
+      }
+      thread->Clear();
+    }
+    for (auto& call : calls) {
+      double us = call["Duration (us)"].as<DurationNode>()->microseconds;
+      call.Set("Percent",
+               ObjectRef(make_object<PercentNode>(total_us > 0 ? us / total_us * 100 : 0)));
+    }
+    Map<String, ObjectRef> total;
+    total.Set("Duration (us)", ObjectRef(make_object<DurationNode>(total_us)));
+    Map<String, Map<String, ObjectRef>> device_metrics;
+    device_metrics.Set("cpu0", total);
+    Map<String, ObjectRef> configuration;
+    configuration.Set("Profiler", String("loop regions"));
+    return Report(calls, device_metrics, configuration);
+  }
+
+ private:
+  std::atomic<bool> enabled_{false};
+  /*! \brief Guards the list of threads. */
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<ThreadRegions>> threads_;
+};
+
+}  // namespace
+
+void StartLoopProfiling() { LoopProfiler::Global()->Start(); }
+
+Report StopLoopProfiling() { return LoopProfiler::Global()->Stop(); }
+
+TVM_REGISTER_GLOBAL("runtime.profiling.StartLoopProfiling").set_body_typed(StartLoopProfiling);
+
+TVM_REGISTER_GLOBAL("runtime.profiling.StopLoopProfiling").set_body_typed(StopLoopProfiling);
+
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
+
+int TVMBackendProfileRegionBegin(const char* func_name, int32_t region_id) {
+  using tvm::runtime::profiling::LoopProfiler;
+  LoopProfiler* profiler = LoopProfiler::Global();
+  if (!profiler->enabled()) return 0;
+  profiler->Local()->Begin(func_name, region_id);
+  return 0;
+}
+
+int TVMBackendProfileRegionEnd(int32_t region_id) {
+  using tvm::runtime::profiling::LoopProfiler;
+  LoopProfiler* profiler = LoopProfiler::Global();
+  if (!profiler->enabled()) return 0;
+  profiler->Local()->End(region_id);
+  return 0;
+}
@@ -28,6 +28,8 @@
 #import <Metal/MTLBuffer.h>
 #import <Metal/MTLCommandBuffer.h>
 #import <Metal/MTLCommandQueue.h>
+#import <Metal/MTLComputeCommandEncoder.h>
+#import <Metal/MTLComputePipeline.h>
 #import <Metal/MTLDevice.h>
 #import <Metal/MTLLibrary.h>
 #include <tvm/runtime/c_runtime_api.h>
@@ -103,28 +105,85 @@ class AutoReleasePoolWrapper {
 
 /*!
  * \brief Structure for error handling in queues
+ *
+ * The kernel launches are recorded in a single compute command encoder, and committed together
+ * when other work is submitted to the queue, when the stream is synchronized, or when the number
+ * of pending launches reaches kMaxPendingDispatches. Like with a CUDA stream, the recording is
+ * not thread safe, and a stream must not be used by several threads at once.
  */
 class Stream {
  public:
+  /*! \brief The maximum number of kernel launches recorded before they are committed. */
+  static constexpr int kMaxPendingDispatches = 64;
+
   explicit Stream(id<MTLDevice> device) : error_happened_(false) {
     queue_ = [device newCommandQueue];
   }
-  ~Stream() { [queue_ release]; }
+  ~Stream() {
+    FlushCommandBuffer();
+    [queue_ release];
+  }
+  // Get a new command buffer, ordered after the pending kernel launches.
   id<MTLCommandBuffer> GetCommandBuffer() {
+    FlushCommandBuffer();
+    return NewCommandBuffer();
+  }
+  /*!
+   * \brief Get the compute encoder recording the pending kernel launches.
+   * \param state The pipeline state of the kernel to be launched.
+   */
+  id<MTLComputeCommandEncoder> GetComputeEncoder(id<MTLComputePipelineState> state) {
+    if (pending_encoder_ == nil) {
+      pending_buffer_ = [NewCommandBuffer() retain];
+      pending_encoder_ = [[pending_buffer_ computeCommandEncoder] retain];
+    }
+    if (pipeline_state_ != state) {
+      [pending_encoder_ setComputePipelineState:state];
+      [pipeline_state_ release];
+      pipeline_state_ = [state retain];
+    }
+    return pending_encoder_;
+  }
+  // Record that a kernel was dispatched in the pending encoder
+  void FinishDispatch() {
+    if (++num_pending_dispatches_ >= kMaxPendingDispatches) FlushCommandBuffer();
+  }
+  // Commit the pending kernel launches.
+  void FlushCommandBuffer() {
+    if (pending_encoder_ == nil) return;
+    [pending_encoder_ endEncoding];
+    [pending_encoder_ release];
+    pending_encoder_ = nil;
+    [pending_buffer_ commit];
+    [pending_buffer_ release];
+    pending_buffer_ = nil;
+    [pipeline_state_ release];
+    pipeline_state_ = nil;
+    num_pending_dispatches_ = 0;
+  }
+  bool HasErrorHappened() { return error_happened_; }
+
+ private:
+  id<MTLCommandBuffer> NewCommandBuffer() {
     id<MTLCommandBuffer> cb = [queue_ commandBuffer];
     [cb addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
       if (buffer.status == MTLCommandBufferStatusError) SetErrorStatus();
     }];
     return cb;
   }
-  bool HasErrorHappened() { return error_happened_; }
-
- private:
   void SetErrorStatus() { error_happened_ = true; }
   // Queue
   id<MTLCommandQueue> queue_;
   // Check if error happened in one previous run
   bool error_happened_;
+  // The command buffer of the pending kernel launches
+  id<MTLCommandBuffer> pending_buffer_{nil};
+  // The encoder of the pending kernel launches
+  id<MTLComputeCommandEncoder> pending_encoder_{nil};
+  // The pipeline state bound to the pending encoder
+  id<MTLComputePipelineState> pipeline_state_{nil};
+  // The number of pending kernel launches
+  int num_pending_dispatches_{0};
 };
 
 /*!
@@ -136,6 +195,9 @@ class MetalWorkspace final : public DeviceAPI {
   std::vector<id<MTLDevice>> devices;
   // Warp size constant
   std::vector<int> warp_size;
+  // Whether the data space of a device is allocated in shared storage, which the CPU accesses
+  // without a staging copy. It is the case for devices with unified memory.
+  std::vector<bool> shared_storage;
   // Whether it is initialized.
   bool initialized_{false};
   // the mutex for initialization
@@ -22,6 +22,7 @@
  */
 #include <dmlc/thread_local.h>
 #include <tvm/runtime/registry.h>
+#include "../../support/utils.h"
 #include "metal_common.h"
 
 namespace tvm {
@@ -121,6 +122,16 @@ int GetWarpSize(id<MTLDevice> dev) {
   return size;
 }
 
+// On a device with unified memory, the shared storage is as fast for the GPU as the private
+// storage, and the copies from and to the CPU become a memcpy.
+bool UseSharedStorage(id<MTLDevice> dev) {
+  if (support::BoolEnvironmentVar("TVM_METAL_DISABLE_SHARED_STORAGE")) return false;
+  if (@available(macOS 10.15, iOS 13.0, *)) {
+    return dev.hasUnifiedMemory;
+  }
+  return false;
+}
+
 MetalWorkspace::~MetalWorkspace() {
   for (auto x : devices) {
     [x release];
@@ -157,6 +168,7 @@ void MetalWorkspace::Init() {
   // on iPhone
   id<MTLDevice> d = MTLCreateSystemDefaultDevice();
   devices.push_back(d);
+  shared_storage.push_back(UseSharedStorage(d));
 #else
   NSArray<id<MTLDevice> >* devs = MTLCopyAllDevices();
   for (size_t i = 0; i < devs.count; ++i) {
@@ -164,6 +176,7 @@ void MetalWorkspace::Init() {
     devices.push_back(d);
     LOG(INFO) << "Intializing Metal device " << i << ", name=" << [d.name UTF8String];
     warp_size.push_back(GetWarpSize(d));
+    shared_storage.push_back(UseSharedStorage(d));
   }
 #endif
   ReinitializeStreams();
@@ -179,15 +192,10 @@ void* MetalWorkspace::AllocDataSpace(Device device, size_t nbytes, size_t alignm
   AUTORELEASEPOOL {
     this->Init();
     id<MTLDevice> dev = GetDevice(device);
-    // GPU memory only
-    MTLResourceOptions storage_mode = MTLResourceStorageModePrivate;
-    /*
-    #if TARGET_OS_IPHONE
-    storage_mode = MTLResourceStorageModeShared;
-    #else
-    storage_mode = MTLResourceStorageModeManaged;
-    #endif
-    */
+    // GPU memory only, unless the memory is unified
+    MTLResourceOptions storage_mode = shared_storage[device.device_id]
+                                          ? MTLResourceStorageModeShared
+                                          : MTLResourceStorageModePrivate;
     buf = [dev newBufferWithLength:nbytes options:storage_mode];
     ICHECK(buf != nil);
   };
@@ -254,6 +262,9 @@ void MetalWorkspace::CopyDataFromTo(const void* from, size_t from_offset, void*
         [cb waitUntilCompleted];
         memcpy(static_cast<char*>(to) + to_offset, static_cast<char*>([temp contents]), size);
       } else {
+        // wait for the pending kernels writing the buffer.
+        [cb commit];
+        [cb waitUntilCompleted];
         memcpy(static_cast<char*>(to) + to_offset,
                static_cast<char*>([from_buf contents]) + from_offset, size);
       }
@@ -272,6 +283,9 @@ void MetalWorkspace::CopyDataFromTo(const void* from, size_t from_offset, void*
         [cb commit];
         [cb waitUntilCompleted];
       } else {
+        // wait for the pending kernels reading the buffer.
+        [cb commit];
+        [cb waitUntilCompleted];
         memcpy(static_cast<char*>([to_buf contents]) + to_offset,
                static_cast<const char*>(from) + from_offset, size);
       }
@@ -74,7 +74,8 @@ class MinRPCExecInterface {
   virtual void CopyFromRemote(DLTensor* arr, uint64_t num_bytes, uint8_t* data_ptr) = 0;
 
   /*! * \brief Execute a copy to remote command by receiving the data described in arr from the
-   * client */
+   * client. data_ptr is the destination on the CPU, and a staging buffer of
+   * MINRPC_COPY_CHUNK_BYTES, or num_bytes when smaller, on the other devices. */
   virtual int CopyToRemote(DLTensor* arr, uint64_t num_bytes, uint8_t* data_ptr) = 0;
 
   /*! * \brief calls a system function specified by the code. */
@@ -47,6 +47,14 @@
   if (!(cond)) this->ThrowError(RPCServerStatus::kCheckError);
 #endif
 
+/*!
+ * \brief The size of the staging buffer of the copies to a device other than the CPU. The data is
+ *  copied to the device as each chunk is received, instead of being received in full first.
+ */
+#ifndef MINRPC_COPY_CHUNK_BYTES
+#define MINRPC_COPY_CHUNK_BYTES (64 << 10)
+#endif
+
 namespace tvm {
 namespace runtime {
 
@@ -239,19 +247,33 @@ class MinRPCExecute : public MinRPCExecInterface {
   int CopyToRemote(DLTensor* arr, uint64_t num_bytes, uint8_t* data_ptr) {
     int call_ecode = 0;
 
-    int ret = ReadArray(data_ptr, num_bytes);
-    if (ret <= 0) return ret;
-
-    if (arr->device.device_type != kDLCPU) {
-      DLTensor temp;
-      temp.data = data_ptr;
-      temp.device = DLDevice{kDLCPU, 0};
-      temp.ndim = arr->ndim;
-      temp.dtype = arr->dtype;
-      temp.shape = arr->shape;
-      temp.strides = nullptr;
-      temp.byte_offset = 0;
-      call_ecode = TVMDeviceCopyDataFromTo(&temp, arr, nullptr);
+    if (arr->device.device_type == kDLCPU) {
+      int ret = ReadArray(data_ptr, num_bytes);
+      if (ret <= 0) return ret;
+    } else {
+      // data_ptr is a staging buffer of MINRPC_COPY_CHUNK_BYTES, the chunks are viewed as bytes
+      for (uint64_t offset = 0; offset < num_bytes; offset += MINRPC_COPY_CHUNK_BYTES) {
+        int64_t chunk_bytes = num_bytes - offset < MINRPC_COPY_CHUNK_BYTES
+                                  ? static_cast<int64_t>(num_bytes - offset)
+                                  : MINRPC_COPY_CHUNK_BYTES;
+        int ret = ReadArray(data_ptr, chunk_bytes);
+        if (ret <= 0) return ret;
+        // The remaining chunks are still read after an error, to keep the stream in sync
+        if (call_ecode != 0) continue;
+        DLTensor temp;
+        temp.data = data_ptr;
+        temp.device = DLDevice{kDLCPU, 0};
+        temp.ndim = 1;
+        temp.dtype = DLDataType{kDLUInt, 8, 1};
+        temp.shape = &chunk_bytes;
+        temp.strides = nullptr;
+        temp.byte_offset = 0;
+        DLTensor chunk = temp;
+        chunk.data = arr->data;
+        chunk.device = arr->device;
+        chunk.byte_offset = arr->byte_offset + offset;
+        call_ecode = TVMDeviceCopyDataFromTo(&temp, &chunk, nullptr);
+      }
       // need sync to make sure that the copy is completed.
       if (call_ecode == 0) {
         call_ecode = TVMSynchronize(arr->device.device_type, arr->device.device_id, nullptr);
@@ -698,7 +720,8 @@ class MinRPCServer {
       uint8_t* dptr = reinterpret_cast<uint8_t*>(data_handle) + arr->byte_offset;
       ret = exec_handler_->CopyToRemote(arr, num_bytes, dptr);
     } else {
-      uint8_t* temp_data = ArenaAlloc<uint8_t>(num_bytes);
+      uint8_t* temp_data = ArenaAlloc<uint8_t>(
+          num_bytes < MINRPC_COPY_CHUNK_BYTES ? num_bytes : MINRPC_COPY_CHUNK_BYTES);
       ret = exec_handler_->CopyToRemote(arr, num_bytes, temp_data);
     }
     if (ret == 0) {
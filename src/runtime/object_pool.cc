@@ -0,0 +1,119 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file object_pool.cc
+ * \brief The thread-local pools of the memory of small objects, used by PooledObjAllocator.
+ */
+#include <tvm/runtime/memory.h>
+
+#include <array>
+#include <cstdint>
+#include <new>
+
+namespace tvm {
+namespace runtime {
+namespace detail {
+
+namespace {
+
+/*! \brief The size classes are the multiples of the granularity, up to the largest one. */
+constexpr size_t kObjectPoolGranularity = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+constexpr size_t kObjectPoolNumClasses = 256 / kObjectPoolGranularity;
+/*! \brief The number of free blocks of a size class a thread keeps, the others are deleted. */
+constexpr uint32_t kObjectPoolMaxFree = 1024;
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+enum class ObjectPoolState : uint8_t { kUnused, kActive, kExited };
+
+/*!
+ * \brief The pool of a thread.
+ * \note It is trivially destructible, so that it can still be used by the objects freed after the
+ *  destructors of the thread local variables have run, which then use new/delete.
+ */
+struct ObjectPool {
+  std::array<FreeBlock*, kObjectPoolNumClasses> free;
+  std::array<uint32_t, kObjectPoolNumClasses> num_free;
+  ObjectPoolState state;
+};
+
+thread_local ObjectPool object_pool = {};
+
+/*! \brief Deletes the free blocks of the pool when its thread exits. */
+struct ObjectPoolReleaser {
+  ~ObjectPoolReleaser() {
+    object_pool.state = ObjectPoolState::kExited;
+    for (size_t i = 0; i < kObjectPoolNumClasses; ++i) {
+      while (FreeBlock* block = object_pool.free[i]) {
+        object_pool.free[i] = block->next;
+        ::operator delete(block);
+      }
+      object_pool.num_free[i] = 0;
+    }
+  }
+};
+
+/*! \return The pool of the thread, or nullptr after it is released. */
+inline ObjectPool* GetObjectPool() {
+  if (object_pool.state == ObjectPoolState::kActive) return &object_pool;
+  if (object_pool.state == ObjectPoolState::kExited) return nullptr;
+  static thread_local ObjectPoolReleaser releaser;
+  object_pool.state = ObjectPoolState::kActive;
+  return &object_pool;
+}
+
+}  // namespace
+
+void* ObjectPoolAlloc(size_t size) {
+  size_t size_class = (size + kObjectPoolGranularity - 1) / kObjectPoolGranularity;
+  if (size_class == 0 || size_class > kObjectPoolNumClasses) {
+    return ::operator new(size);
+  }
+  if (ObjectPool* pool = GetObjectPool()) {
+    if (FreeBlock* block = pool->free[size_class - 1]) {
+      pool->free[size_class - 1] = block->next;
+      --pool->num_free[size_class - 1];
+      return block;
+    }
+  }
+  // The block can be reused by any object of its size class
+  return ::operator new(size_class * kObjectPoolGranularity);
+}
+
+void ObjectPoolFree(void* ptr, size_t size) {
+  size_t size_class = (size + kObjectPoolGranularity - 1) / kObjectPoolGranularity;
+  if (size_class != 0 && size_class <= kObjectPoolNumClasses) {
+    ObjectPool* pool = GetObjectPool();
+    if (pool != nullptr && pool->num_free[size_class - 1] < kObjectPoolMaxFree) {
+      FreeBlock* block = static_cast<FreeBlock*>(ptr);
+      block->next = pool->free[size_class - 1];
+      pool->free[size_class - 1] = block;
+      ++pool->num_free[size_class - 1];
+      return;
+    }
+  }
+  ::operator delete(ptr);
+}
+
+}  // namespace detail
+}  // namespace runtime
+}  // namespace tvm
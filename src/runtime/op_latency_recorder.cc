@@ -0,0 +1,185 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file op_latency_recorder.cc
+ * \brief Always-on per operator latency histograms of the executors.
+ */
+#include "op_latency_recorder.h"
+
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/registry.h>
+
+#include <iomanip>
+#include <sstream>
+
+#include "../support/str_escape.h"
+
+namespace tvm {
+namespace runtime {
+
+static bool SameDevice(Device a, Device b) {
+  return a.device_type == b.device_type && a.device_id == b.device_id;
+}
+
+uint64_t LatencyHistogram::Snapshot::Quantile(double q) const {
+  if (count == 0) return 0;
+  uint64_t rank = static_cast<uint64_t>(q * (count - 1)) + 1;
+  uint64_t seen = 0;
+  for (int i = 0; i < kNumBuckets; ++i) {
+    seen += buckets[i];
+    if (seen >= rank) return std::min(BucketUpperBound(i), max);
+  }
+  return max;
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::Read(bool reset) {
+  Snapshot snapshot;
+  for (int i = 0; i < kNumBuckets; ++i) {
+    snapshot.buckets[i] = reset ? buckets_[i].exchange(0, std::memory_order_relaxed)
+                                : buckets_[i].load(std::memory_order_relaxed);
+  }
+  snapshot.count = reset ? count_.exchange(0) : count_.load();
+  snapshot.sum = reset ? sum_.exchange(0) : sum_.load();
+  snapshot.max = reset ? max_.exchange(0) : max_.load();
+  return snapshot;
+}
+
+OpLatencyRecorder::OpLatencyRecorder(std::vector<std::string> names,
+                                     std::vector<std::string> functions,
+                                     std::vector<Device> devices, int sample_period)
+    : names_(std::move(names)),
+      functions_(std::move(functions)),
+      devices_(std::move(devices)),
+      histograms_(new LatencyHistogram[names_.size()]),
+      sample_period_(sample_period) {
+  ICHECK_GT(sample_period, 0) << "the sample period must be positive";
+  ICHECK_EQ(names_.size(), devices_.size());
+  ICHECK_EQ(names_.size(), functions_.size());
+  use_host_clock_.resize(devices_.size());
+  for (size_t i = 0; i < devices_.size(); ++i) SetDevice(i, devices_[i]);
+}
+
+void OpLatencyRecorder::SetDevice(size_t op, Device dev) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  devices_[op] = dev;
+  // The default timer synchronizes the device, time with the host clock instead.
+  use_host_clock_[op] =
+      dev.device_type == kDLCPU ||
+      Registry::Get(std::string("profiling.timer.") + DeviceName(dev.device_type)) == nullptr;
+}
+
+OpLatencyRecorder::~OpLatencyRecorder() {
+  // The timers hold device events, wait for the ones still recorded.
+  for (auto& pending : pending_) {
+    for (auto& p : pending) p.second->SyncAndGetElapsedNanos();
+  }
+}
+
+bool OpLatencyRecorder::BeginRun() {
+  if (num_runs_++ % sample_period_ != 0) return false;
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The slot of this run still holds the timers of the sampled run before the last one.
+  Harvest(&pending_[num_sampled_runs_++ % 2]);
+  return true;
+}
+
+void OpLatencyRecorder::Harvest(std::vector<std::pair<size_t, Timer>>* pending) {
+  for (auto& p : *pending) {
+    size_t op = p.first;
+    histograms_[op].Record(p.second->SyncAndGetElapsedNanos());
+    for (auto& pool : timer_pool_) {
+      if (SameDevice(pool.first, devices_[op])) {
+        pool.second.push_back(p.second);
+        break;
+      }
+    }
+  }
+  pending->clear();
+}
+
+int64_t OpLatencyRecorder::StartOp(size_t op) {
+  if (use_host_clock_[op]) return NowNanos();
+  std::lock_guard<std::mutex> lock(mutex_);
+  Device dev = devices_[op];
+  std::vector<Timer>* pool = nullptr;
+  for (auto& p : timer_pool_) {
+    if (SameDevice(p.first, dev)) pool = &p.second;
+  }
+  if (pool == nullptr) {
+    timer_pool_.emplace_back(dev, std::vector<Timer>());
+    pool = &timer_pool_.back().second;
+  }
+  Timer timer;
+  if (pool->empty()) {
+    timer = Timer::Start(dev);
+  } else {
+    timer = pool->back();
+    pool->pop_back();
+    timer->Start();
+  }
+  std::vector<std::pair<size_t, Timer>>& pending = pending_[(num_sampled_runs_ - 1) % 2];
+  pending.emplace_back(op, timer);
+  return static_cast<int64_t>(pending.size() - 1);
+}
+
+void OpLatencyRecorder::StopOp(size_t op, int64_t start) {
+  if (use_host_clock_[op]) {
+    histograms_[op].Record(NowNanos() - start);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  pending_[(num_sampled_runs_ - 1) % 2][start].second->Stop();
+}
+
+std::string OpLatencyRecorder::ToJSON(bool reset) {
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(3);
+  os << "{\"sample_period\":" << sample_period_ << ",\"ops\":[";
+  for (size_t i = 0; i < names_.size(); ++i) {
+    LatencyHistogram::Snapshot s = histograms_[i].Read(reset);
+    Device dev;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      dev = devices_[i];
+    }
+    if (i != 0) os << ",";
+    os << "{\"name\":\"" << support::StrEscape(names_[i]) << "\",\"function\":\""
+       << support::StrEscape(functions_[i]) << "\",\"device\":\""
+       << DeviceName(dev.device_type) << "(" << dev.device_id
+       << ")\",\"count\":" << s.count << ",\"sum_us\":" << s.sum / 1e3
+       << ",\"max_us\":" << s.max / 1e3 << ",\"p50_us\":" << s.Quantile(0.5) / 1e3
+       << ",\"p90_us\":" << s.Quantile(0.9) / 1e3 << ",\"p99_us\":" << s.Quantile(0.99) / 1e3
+       << ",\"buckets\":[";
+    // sparse [upper bound, count] pairs of the non empty buckets.
+    bool first = true;
+    for (int b = 0; b < LatencyHistogram::kNumBuckets; ++b) {
+      if (s.buckets[b] == 0) continue;
+      if (!first) os << ",";
+      first = false;
+      os << "[" << LatencyHistogram::BucketUpperBound(b) / 1e3 << "," << s.buckets[b] << "]";
+    }
+    os << "]}";
+  }
+  os << "]}";
+  return os.str();
+}
+
+}  // namespace runtime
+}  // namespace tvm
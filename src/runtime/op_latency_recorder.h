@@ -0,0 +1,207 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file op_latency_recorder.h
+ * \brief Always-on per operator latency histograms of the executors.
+ */
+#ifndef TVM_RUNTIME_OP_LATENCY_RECORDER_H_
+#define TVM_RUNTIME_OP_LATENCY_RECORDER_H_
+
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/profiling.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Lock-free histogram of latencies in nanoseconds.
+ *
+ *  Buckets are log-linear: every power of two is split into kSubBuckets buckets, so the
+ *  relative error of a bucket bound is at most 1 / kSubBuckets.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 2;
+  static constexpr int kSubBuckets = 1 << kSubBucketBits;
+  /*! \brief Latencies of 2^kMaxExponent ns (about 18 minutes) and more share the last bucket. */
+  static constexpr int kMaxExponent = 40;
+  static constexpr int kNumBuckets = kSubBuckets * (kMaxExponent - kSubBucketBits + 2);
+
+  /*! \brief Add a latency, can be called concurrently. */
+  void Record(int64_t nanos) {
+    uint64_t value = nanos > 0 ? static_cast<uint64_t>(nanos) : 0;
+    buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    uint64_t max = max_.load(std::memory_order_relaxed);
+    while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  /*! \brief The bucket a latency falls into. */
+  static int BucketIndex(uint64_t nanos) {
+    if (nanos < static_cast<uint64_t>(kSubBuckets)) return static_cast<int>(nanos);
+    int exponent = HighestBit(nanos);
+    if (exponent > kMaxExponent) return kNumBuckets - 1;
+    int sub = static_cast<int>(nanos >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+    return kSubBuckets * (exponent - kSubBucketBits + 1) + sub;
+  }
+
+  /*! \brief The index of the highest set bit of a non-zero value. */
+  static int HighestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;  // NOLINT(runtime/int)
+    _BitScanReverse64(&index, value);
+    return static_cast<int>(index);
+#else
+    int index = 0;
+    while (value >>= 1) ++index;
+    return index;
+#endif
+  }
+
+  /*! \brief The largest latency of a bucket. */
+  static uint64_t BucketUpperBound(int index) {
+    if (index < kSubBuckets) return index;
+    int exponent = index / kSubBuckets - 1 + kSubBucketBits;
+    uint64_t sub = index % kSubBuckets;
+    return ((kSubBuckets + sub + 1) << (exponent - kSubBucketBits)) - 1;
+  }
+
+  /*! \brief A consistent enough copy of the histogram for export. */
+  struct Snapshot {
+    std::array<uint64_t, kNumBuckets> buckets;
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+    /*! \brief Upper bound of the bucket holding the q-quantile, q in [0, 1]. */
+    uint64_t Quantile(double q) const;
+  };
+
+  /*!
+   * \brief Read the histogram.
+   * \param reset Whether to clear it, samples recorded concurrently may be lost.
+   */
+  Snapshot Read(bool reset);
+
+ private:
+  std::array<std::atomic<uint64_t>, kNumBuckets> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> max_{0};
+};
+
+/*!
+ * \brief Records the latency of every operator of an executor into histograms.
+ *
+ *  Operators on the CPU are timed with the steady clock around the call. Operators on other
+ *  devices are timed with the device timers (events on GPUs) from a pool; their durations are
+ *  read two sampled runs later, when the work is done, so timing never blocks the host. Runs
+ *  are sampled to bound the overhead: only every `sample_period`-th run is timed.
+ */
+class OpLatencyRecorder {
+ public:
+  /*!
+   * \param names The name of each operator.
+   * \param functions The function each operator calls.
+   * \param devices The device each operator runs on.
+   * \param sample_period Time one of every sample_period runs.
+   */
+  OpLatencyRecorder(std::vector<std::string> names, std::vector<std::string> functions,
+                    std::vector<Device> devices, int sample_period);
+  ~OpLatencyRecorder();
+
+  /*!
+   * \brief Called at the beginning of each run, reads the device timers that are due.
+   * \return Whether to time the operators of this run.
+   */
+  bool BeginRun();
+
+  /*!
+   * \brief Called right before an operator of a timed run.
+   * \return The start of the operator, passed to StopOp.
+   */
+  int64_t StartOp(size_t op);
+
+  /*! \brief Called right after an operator of a timed run, can be called concurrently. */
+  void StopOp(size_t op, int64_t start);
+
+  /*!
+   * \brief Set the device of an operator only known when it runs.
+   *
+   *  Must not be called concurrently with StartOp or StopOp of the same operator.
+   */
+  void SetDevice(size_t op, Device dev);
+
+  /*!
+   * \brief Export the histograms as JSON.
+   * \param reset Whether to clear the histograms.
+   */
+  std::string ToJSON(bool reset);
+
+  /*! \return The sampling period. */
+  int sample_period() const { return sample_period_; }
+
+ private:
+  static int64_t NowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+  /*! \brief Read the timers of a pending list and return them to the pool. */
+  void Harvest(std::vector<std::pair<size_t, Timer>>* pending);
+
+  std::vector<std::string> names_;
+  std::vector<std::string> functions_;
+  std::vector<Device> devices_;
+  /*! \brief Whether the operator runs without a device timer. */
+  std::vector<bool> use_host_clock_;
+  std::unique_ptr<LatencyHistogram[]> histograms_;
+  int sample_period_;
+  uint64_t num_runs_{0};
+  uint64_t num_sampled_runs_{0};
+  /*! \brief Guards the devices, the timer pool and the pending lists. */
+  std::mutex mutex_;
+  /*! \brief Device timers waiting to be read, for the last two sampled runs. */
+  std::vector<std::pair<size_t, Timer>> pending_[2];
+  /*! \brief Idle device timers of each operator's device. */
+  std::vector<std::pair<Device, std::vector<Timer>>> timer_pool_;
+};
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_OP_LATENCY_RECORDER_H_
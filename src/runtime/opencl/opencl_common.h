@@ -211,9 +211,30 @@ inline cl_channel_type DTypeToOpenCLChannelType(DLDataType data_type) {
     OPENCL_CHECK_ERROR(e); \
   }
 
+/*!
+ * \brief Get the string value of a device info.
+ * \param pid The device.
+ * \param param_name The info to be queried.
+ */
+std::string GetDeviceInfo(cl_device_id pid, cl_device_info param_name);
+
 class OpenCLThreadEntry;
 struct BufferDescriptor;
 
+/*!
+ * \brief A pinned host buffer, the source of the non-blocking copies from the host.
+ */
+struct StagingBuffer {
+  /*! \brief The buffer, allocated with CL_MEM_ALLOC_HOST_PTR */
+  cl_mem buffer{nullptr};
+  /*! \brief The host pointer, the buffer stays mapped */
+  void* host_ptr{nullptr};
+  /*! \brief The size of the buffer in bytes */
+  size_t size{0};
+  /*! \brief The event of the last copy from the buffer, nullptr if there is none */
+  cl_event event{nullptr};
+};
+
 /*!
  * \brief Process global OpenCL workspace.
  */
@@ -235,6 +256,10 @@ class OpenCLWorkspace : public DeviceAPI {
   std::vector<cl_command_queue> queues;
   // the events
   std::vector<std::vector<cl_event>> events;
+  // the pinned staging buffers of each device
+  std::vector<std::vector<StagingBuffer>> staging_buffers;
+  // the mutex of the staging buffers
+  std::mutex staging_mu;
   // Number of registered kernels
   // Used to register kernel into the workspace.
   size_t num_registered_kernels{0};
@@ -321,6 +346,7 @@ class OpenCLWorkspace : public DeviceAPI {
   cl_mem AllocTexture(Device dev, size_t width, size_t height, DLDataType type_hint);
   void* AllocTextureWorkspace(Device dev, size_t width, size_t height, DLDataType type_hint);
   void FreeTextureWorkspace(Device dev, void* data);
+  Pool2D::Stats GetTextureWorkspaceStats(Device dev);
 
   /*!
    * \brief Get the thread local ThreadEntry
@@ -335,6 +361,15 @@ class OpenCLWorkspace : public DeviceAPI {
   void* CreateHostPtrIfEnabled(BufferDescriptor* desc, Device dev, size_t size);
 
  private:
+  /*!
+   * \brief Get an idle staging buffer, to copy nbytes from the host without blocking.
+   * \param dev The device.
+   * \param nbytes The number of bytes of the copy.
+   * \return The staging buffer, or nullptr if the copy is too large to be staged.
+   * \note staging_mu must be held until the event of the copy is recorded.
+   */
+  StagingBuffer* GetStagingBuffer(Device dev, size_t nbytes);
+
   std::string GetError() {
     if (this->devices.size() == 0) return noDevicesErrorMsg;
     return "";
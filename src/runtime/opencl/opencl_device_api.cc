@@ -25,6 +25,7 @@
 #include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
 
+#include <cstring>
 #include <sstream>
 
 #include "opencl_common.h"
@@ -40,7 +41,6 @@ namespace runtime {
 namespace cl {
 
 std::string GetPlatformInfo(cl_platform_id pid, cl_platform_info param_name);
-std::string GetDeviceInfo(cl_device_id pid, cl_device_info param_name);
 std::string GetOpenCLVersion(cl_device_id pid);
 
 struct ImageInfo {
@@ -292,6 +292,10 @@ void OpenCLWorkspace::FreeTextureWorkspace(Device dev, void* ptr) {
   GetThreadEntry()->texture_pool.FreeTexture(dev, ptr);
 }
 
+Pool2D::Stats OpenCLWorkspace::GetTextureWorkspaceStats(Device dev) {
+  return GetThreadEntry()->texture_pool.GetStats(dev);
+}
+
 void OpenCLWorkspace::CopyDataFromTo(DLTensor* from, DLTensor* to, TVMStreamHandle stream) {
   size_t nbytes = GetDataSize(*from);
   ICHECK_EQ(nbytes, GetDataSize(*to));
@@ -330,7 +334,7 @@ void OpenCLWorkspace::CopyDataFromTo(DLTensor* from, DLTensor* to, TVMStreamHand
     switch (from_desc->layout) {
       case cl::BufferDescriptor::MemoryLayout::kBuffer1D:
         OPENCL_CALL(clEnqueueReadBuffer(
-            this->GetQueue(from->device), from_desc->buffer, CL_FALSE, from->byte_offset, nbytes,
+            this->GetQueue(from->device), from_desc->buffer, CL_TRUE, from->byte_offset, nbytes,
             static_cast<char*>(to->data) + to->byte_offset, 0, nullptr, nullptr));
         break;
       case cl::BufferDescriptor::MemoryLayout::kImage2DActivation:
@@ -341,36 +345,128 @@ void OpenCLWorkspace::CopyDataFromTo(DLTensor* from, DLTensor* to, TVMStreamHand
         // Note that when utilizing texture pools for memory reuse, the allocated image
         // size can be larger than the size to be read.
         OPENCL_CALL(clEnqueueReadImage(
-            this->GetQueue(from->device), from_desc->buffer, CL_FALSE, image_info.origin,
+            this->GetQueue(from->device), from_desc->buffer, CL_TRUE, image_info.origin,
             image_info.region, image_info.row_pitch, image_info.slice_pitch,
             static_cast<char*>(to->data) + to->byte_offset, 0, nullptr, nullptr));
         break;
     }
-    OPENCL_CALL(clFinish(this->GetQueue(from->device)));
   } else if (from->device.device_type == kDLCPU && IsOpenCLDevice(to->device)) {
     auto* to_desc = static_cast<cl::BufferDescriptor*>(to->data);
+    const char* src = static_cast<const char*>(from->data) + from->byte_offset;
+    // The data is copied to a pinned staging buffer, which is the source of a non-blocking
+    // write. The write is then pipelined with the following copies and kernels.
+    std::lock_guard<std::mutex> lock(staging_mu);
+    cl::StagingBuffer* staging = GetStagingBuffer(to->device, nbytes);
+    cl_event* event = nullptr;
+    if (staging != nullptr) {
+      memcpy(staging->host_ptr, src, nbytes);
+      src = static_cast<const char*>(staging->host_ptr);
+      event = &staging->event;
+    }
     switch (to_desc->layout) {
       case cl::BufferDescriptor::MemoryLayout::kBuffer1D:
-        OPENCL_CALL(clEnqueueWriteBuffer(
-            this->GetQueue(to->device), to_desc->buffer, CL_FALSE, to->byte_offset, nbytes,
-            static_cast<const char*>(from->data) + from->byte_offset, 0, nullptr, nullptr));
+        OPENCL_CALL(clEnqueueWriteBuffer(this->GetQueue(to->device), to_desc->buffer, CL_FALSE,
+                                         to->byte_offset, nbytes, src, 0, nullptr, event));
         break;
       case cl::BufferDescriptor::MemoryLayout::kImage2DActivation:
       case cl::BufferDescriptor::MemoryLayout::kImage2DWeight:
       case cl::BufferDescriptor::MemoryLayout::kImage2DNHWC:
         auto image_info = GetImageInfo(to_desc, to);
-        OPENCL_CALL(clEnqueueWriteImage(
-            this->GetQueue(to->device), to_desc->buffer, CL_FALSE, image_info.origin,
-            image_info.region, image_info.row_pitch, image_info.slice_pitch,
-            static_cast<const char*>(from->data) + from->byte_offset, 0, nullptr, nullptr));
+        OPENCL_CALL(clEnqueueWriteImage(this->GetQueue(to->device), to_desc->buffer, CL_FALSE,
+                                        image_info.origin, image_info.region,
+                                        image_info.row_pitch, image_info.slice_pitch, src, 0,
+                                        nullptr, event));
         break;
     }
-    OPENCL_CALL(clFinish(this->GetQueue(to->device)));
+    if (staging == nullptr) {
+      OPENCL_CALL(clFinish(this->GetQueue(to->device)));
+    } else {
+      OPENCL_CALL(clFlush(this->GetQueue(to->device)));
+    }
   } else {
     LOG(FATAL) << "Expect copy from/to OpenCL or between OpenCL";
   }
 }
 
+namespace {
+
+/*! \brief The maximum size of the staging buffers of a device, larger copies block. */
+constexpr size_t kMaxStagingBytes = 64 << 20;
+/*! \brief The minimum size of a staging buffer */
+constexpr size_t kMinStagingBytes = 64 << 10;
+
+bool IsStagingBufferIdle(const cl::StagingBuffer& staging) {
+  if (staging.event == nullptr) {
+    return true;
+  }
+  cl_int status;
+  OPENCL_CALL(clGetEventInfo(staging.event, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(cl_int),
+                             &status, nullptr));
+  // Negative values are errors, the command is terminated
+  return status <= CL_COMPLETE;
+}
+
+void ReleaseStagingBuffer(cl_command_queue queue, cl::StagingBuffer* staging) {
+  if (staging->event != nullptr) {
+    OPENCL_CALL(clReleaseEvent(staging->event));
+  }
+  OPENCL_CALL(clEnqueueUnmapMemObject(queue, staging->buffer, staging->host_ptr, 0, nullptr,
+                                      nullptr));
+  OPENCL_CALL(clReleaseMemObject(staging->buffer));
+}
+
+}  // namespace
+
+cl::StagingBuffer* OpenCLWorkspace::GetStagingBuffer(Device dev, size_t nbytes) {
+  if (nbytes > kMaxStagingBytes) {
+    return nullptr;
+  }
+  cl_command_queue queue = this->GetQueue(dev);
+  std::vector<cl::StagingBuffer>& pool = staging_buffers[dev.device_id];
+  // Best fit among the buffers whose last copy is complete
+  cl::StagingBuffer* best = nullptr;
+  size_t total_bytes = 0;
+  for (cl::StagingBuffer& staging : pool) {
+    total_bytes += staging.size;
+    if (staging.size >= nbytes && (best == nullptr || staging.size < best->size) &&
+        IsStagingBufferIdle(staging)) {
+      best = &staging;
+    }
+  }
+  if (best == nullptr) {
+    size_t size = kMinStagingBytes;
+    while (size < nbytes) {
+      size *= 2;
+    }
+    if (total_bytes + size > kMaxStagingBytes) {
+      // Wait for the pending copies, and start again with a new buffer
+      OPENCL_CALL(clFinish(queue));
+      for (cl::StagingBuffer& staging : pool) {
+        ReleaseStagingBuffer(queue, &staging);
+      }
+      pool.clear();
+    }
+    cl_device_id device_id = GetCLDeviceID(dev.device_id);
+    cl_int err_code;
+    cl::StagingBuffer staging;
+    staging.size = size;
+    staging.buffer = clCreateBuffer(this->contexts[device_to_platform[device_id]],
+                                    CL_MEM_READ_ONLY | CL_MEM_ALLOC_HOST_PTR, size, nullptr,
+                                    &err_code);
+    OPENCL_CHECK_ERROR(err_code);
+    staging.host_ptr = clEnqueueMapBuffer(queue, staging.buffer, CL_TRUE, CL_MAP_WRITE, 0, size, 0,
+                                          nullptr, nullptr, &err_code);
+    OPENCL_CHECK_ERROR(err_code);
+    pool.push_back(staging);
+    best = &pool.back();
+  }
+  if (best->event != nullptr) {
+    OPENCL_CALL(clReleaseEvent(best->event));
+    best->event = nullptr;
+  }
+  return best;
+}
+
 void OpenCLWorkspace::StreamSync(Device dev, TVMStreamHandle stream) {
   ICHECK(stream == nullptr);
   OPENCL_CALL(clFinish(this->GetQueue(dev)));
@@ -525,6 +621,7 @@ void OpenCLWorkspace::Init(const std::string& type_key, const std::string& devic
     OPENCL_CHECK_ERROR(err_code);
   }
   this->events.resize(this->devices.size());
+  this->staging_buffers.resize(this->devices.size());
   initialized_ = true;
 }
 
@@ -569,6 +666,21 @@ TVM_REGISTER_GLOBAL("device_api.opencl.free_nd").set_body([](TVMArgs args, TVMRe
   *rv = static_cast<int32_t>(0);
 });
 
+TVM_REGISTER_GLOBAL("device_api.opencl.texture_pool_stats").set_body_typed([](int device_id) {
+  Device dev;
+  dev.device_type = static_cast<DLDeviceType>(kDLOpenCL);
+  dev.device_id = device_id;
+  Pool2D::Stats stats = OpenCLWorkspace::Global()->GetTextureWorkspaceStats(dev);
+  Map<String, ObjectRef> ret;
+  ret.Set("num_allocs", ObjectRef(make_object<profiling::CountNode>(stats.num_allocs)));
+  ret.Set("num_reused", ObjectRef(make_object<profiling::CountNode>(stats.num_reused)));
+  ret.Set("num_grown", ObjectRef(make_object<profiling::CountNode>(stats.num_grown)));
+  ret.Set("num_created", ObjectRef(make_object<profiling::CountNode>(stats.num_created)));
+  ret.Set("pool_bytes", ObjectRef(make_object<profiling::CountNode>(stats.pool_bytes)));
+  ret.Set("peak_pool_bytes", ObjectRef(make_object<profiling::CountNode>(stats.peak_pool_bytes)));
+  return ret;
+});
+
 TVM_REGISTER_GLOBAL("device_api.opencl").set_body([](TVMArgs args, TVMRetValue* rv) {
   DeviceAPI* ptr = OpenCLWorkspace::Global();
   *rv = static_cast<void*>(ptr);
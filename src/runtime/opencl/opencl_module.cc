@@ -25,7 +25,13 @@
 #include <dmlc/memory_io.h>
 #include <tvm/runtime/registry.h>
 
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -35,6 +41,97 @@
 namespace tvm {
 namespace runtime {
 
+namespace {
+
+/*!
+ * \brief Get the file caching the binary of a program built from source.
+ * \param dev The device the program is built for.
+ * \param func_name The name of the kernel.
+ * \param source The source of the program.
+ * \return The file name, or an empty string if TVM_OPENCL_PROGRAM_CACHE_DIR is not set.
+ * \note The file name depends on the source, and on the device and driver versions, so that
+ * a driver update invalidates the cache.
+ */
+std::string GetProgramCacheFile(cl_device_id dev, const std::string& func_name,
+                                const std::string& source) {
+  const char* cache_dir = std::getenv("TVM_OPENCL_PROGRAM_CACHE_DIR");
+  if (cache_dir == nullptr || *cache_dir == '\0') {
+    return "";
+  }
+  std::string key = source;
+  for (cl_device_info info : {CL_DEVICE_NAME, CL_DEVICE_VERSION, CL_DRIVER_VERSION}) {
+    key += '\0';
+    key += cl::GetDeviceInfo(dev, info);
+  }
+  std::ostringstream os;
+  os << cache_dir << "/" << func_name << "-" << std::hex << std::hash<std::string>()(key)
+     << ".clbin";
+  return os.str();
+}
+
+/*!
+ * \brief Create and build a program from a cached binary.
+ * \return The program, or nullptr if there is no valid binary in the cache.
+ */
+cl_program LoadCachedProgram(cl_context context, cl_device_id dev, const std::string& file_name) {
+  std::ifstream fs(file_name, std::ios::in | std::ios::binary);
+  if (fs.fail()) {
+    return nullptr;
+  }
+  std::string binary((std::istreambuf_iterator<char>(fs)), std::istreambuf_iterator<char>());
+  if (binary.empty()) {
+    return nullptr;
+  }
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(binary.data());
+  size_t len = binary.size();
+  cl_int status, err;
+  cl_program program = clCreateProgramWithBinary(context, 1, &dev, &len, &data, &status, &err);
+  if (err != CL_SUCCESS) {
+    return nullptr;
+  }
+  if (status != CL_SUCCESS ||
+      clBuildProgram(program, 1, &dev, nullptr, nullptr, nullptr) != CL_SUCCESS) {
+    clReleaseProgram(program);
+    return nullptr;
+  }
+  return program;
+}
+
+/*! \brief Save the binary of a built program to the cache. */
+void SaveCachedProgram(cl_program program, const std::string& file_name) {
+  size_t size = 0;
+  if (clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &size, nullptr) !=
+          CL_SUCCESS ||
+      size == 0) {
+    return;
+  }
+  std::string binary(size, '\0');
+  unsigned char* data = reinterpret_cast<unsigned char*>(&binary[0]);
+  if (clGetProgramInfo(program, CL_PROGRAM_BINARIES, sizeof(unsigned char*), &data, nullptr) !=
+      CL_SUCCESS) {
+    return;
+  }
+  // Write to a temporary file first, so that another process never reads a partial binary.
+  std::ostringstream os;
+  os << file_name << ".tmp" << std::hash<std::thread::id>()(std::this_thread::get_id());
+  std::string tmp_file = os.str();
+  {
+    std::ofstream fs(tmp_file, std::ios::out | std::ios::binary);
+    fs.write(binary.data(), binary.size());
+    if (fs.fail()) {
+      LOG(WARNING) << "Cannot write the OpenCL program cache file " << tmp_file;
+      fs.close();
+      std::remove(tmp_file.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_file.c_str(), file_name.c_str()) != 0) {
+    std::remove(tmp_file.c_str());
+  }
+}
+
+}  // namespace
+
 class OpenCLWrappedFunc {
  public:
   // initialize the OpenCL function.
@@ -229,6 +326,14 @@ cl_kernel OpenCLModuleNode::InstallKernel(cl::OpenCLWorkspace* w, cl::OpenCLThre
   int device_id = t->device.device_id;
   auto did = w->GetCLDeviceID(device_id);
   auto platform = w->device_to_platform[did];
+  // The binary of a program built from source, cached across processes
+  std::string cache_file;
+  if (programs_[func_name][device_id] == nullptr && fmt_ == "cl") {
+    cache_file = GetProgramCacheFile(did, func_name, parsed_kernels_[func_name]);
+    if (!cache_file.empty()) {
+      programs_[func_name][device_id] = LoadCachedProgram(w->contexts[platform], did, cache_file);
+    }
+  }
   if (programs_[func_name][device_id] == nullptr) {
     // create program
     if (fmt_ == "cl") {
@@ -263,6 +368,9 @@ cl_kernel OpenCLModuleNode::InstallKernel(cl::OpenCLWorkspace* w, cl::OpenCLThre
                             &log[0], nullptr);
       LOG(FATAL) << "OpenCL build error for device=" << dev << "\n" << log;
     }
+    if (!cache_file.empty()) {
+      SaveCachedProgram(programs_[func_name][device_id], cache_file);
+    }
   }
   // build kernel
   cl_int err;
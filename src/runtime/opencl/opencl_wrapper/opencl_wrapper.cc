@@ -146,6 +146,8 @@ using f_clSetKernelArg = cl_int (*)(cl_kernel, cl_uint, size_t, const void*);
 using f_clWaitForEvents = cl_int (*)(cl_uint, const cl_event*);
 using f_clCreateUserEvent = cl_event (*)(cl_context, cl_int*);
 using f_clGetEventProfilingInfo = cl_int (*)(cl_event, cl_profiling_info, size_t, void*, size_t*);
+using f_clGetEventInfo = cl_int (*)(cl_event, cl_event_info, size_t, void*, size_t*);
+using f_clReleaseEvent = cl_int (*)(cl_event);
 using f_clFlush = cl_int (*)(cl_command_queue);
 using f_clFinish = cl_int (*)(cl_command_queue);
 using f_clEnqueueReadBuffer = cl_int (*)(cl_command_queue, cl_mem, cl_bool, size_t, size_t, void*,
@@ -433,6 +435,27 @@ cl_int clGetEventProfilingInfo(cl_event event, cl_profiling_info param_name,
   }
 }
 
+cl_int clGetEventInfo(cl_event event, cl_event_info param_name, size_t param_value_size,
+                      void* param_value, size_t* param_value_size_ret) {
+  auto& lib = LibOpenCLWrapper::getInstance();
+  auto func = (f_clGetEventInfo)lib.getOpenCLFunction("clGetEventInfo");
+  if (func) {
+    return func(event, param_name, param_value_size, param_value, param_value_size_ret);
+  } else {
+    return CL_INVALID_PLATFORM;
+  }
+}
+
+cl_int clReleaseEvent(cl_event event) {
+  auto& lib = LibOpenCLWrapper::getInstance();
+  auto func = (f_clReleaseEvent)lib.getOpenCLFunction("clReleaseEvent");
+  if (func) {
+    return func(event);
+  } else {
+    return CL_INVALID_PLATFORM;
+  }
+}
+
 cl_int clFlush(cl_command_queue command_queue) {
   auto& lib = LibOpenCLWrapper::getInstance();
   auto func = (f_clFlush)lib.getOpenCLFunction("clFlush");
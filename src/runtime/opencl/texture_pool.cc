@@ -21,6 +21,7 @@
  * \file texture_pool.h
  * \brief Texture pool utility.
  */
+#include <algorithm>
 #include <limits>
 #include <memory>
 
@@ -39,6 +40,7 @@ void* Pool2D::Alloc(Device dev, DeviceAPI* device, size_t width, size_t height,
   // Coefficient at 5 looks like robust variant for reusing textures.
   const int64_t max_ratio = 5;
   e.data = nullptr;
+  ++stats_.num_allocs;
   std::vector<Entry>::iterator best_mem;
   if (free_list_.size() != 0) {
     int64_t min_added_size_x = std::numeric_limits<int64_t>::max();
@@ -79,17 +81,21 @@ void* Pool2D::Alloc(Device dev, DeviceAPI* device, size_t width, size_t height,
       // use existing block
       e = *best_mem;
       free_list_.erase(best_mem);
+      ++stats_.num_reused;
     } else if (static_cast<size_t>(min_added_size_x) <= width ||
                static_cast<size_t>(min_added_size_y) <= height) {
       // if added size is less or equal to
       // what is needed by alloc, then grow entry
       device->FreeDataSpace(dev, best_mem->data);
+      stats_.pool_bytes -= EntryBytes(*best_mem);
       free_list_.erase(best_mem);
       new_mem.type = type_hint;
       std::vector<int64_t> shape{int64_t(new_mem.y), int64_t(new_mem.x), 4};
       new_mem.data = device->AllocDataSpace(dev, shape.size(), shape.data(), new_mem.type,
                                             Optional<String>("global.texture"));
       e = new_mem;
+      ++stats_.num_grown;
+      stats_.pool_bytes += EntryBytes(e);
     }
   }
 
@@ -101,7 +107,10 @@ void* Pool2D::Alloc(Device dev, DeviceAPI* device, size_t width, size_t height,
     e.x = width;
     e.y = height;
     e.type = type_hint;
+    ++stats_.num_created;
+    stats_.pool_bytes += EntryBytes(e);
   }
+  stats_.peak_pool_bytes = std::max(stats_.peak_pool_bytes, stats_.pool_bytes);
 
   allocated_.push_back(e);
   return e.data;
@@ -134,6 +143,7 @@ void Pool2D::Release(Device dev, DeviceAPI* device) {
   }
   allocated_.clear();
   free_list_.clear();
+  stats_.pool_bytes = 0;
 }
 
 TexturePool::TexturePool(DLDeviceType device_type, DeviceAPI* device)
@@ -167,5 +177,12 @@ void TexturePool::FreeTexture(Device dev, void* ptr) {
   array_[dev.device_id]->Free(ptr);
 }
 
+Pool2D::Stats TexturePool::GetStats(Device dev) const {
+  if (static_cast<size_t>(dev.device_id) >= array_.size() || array_[dev.device_id] == nullptr) {
+    return Pool2D::Stats();
+  }
+  return array_[dev.device_id]->GetStats();
+}
+
 }  // namespace runtime
 }  // namespace tvm
@@ -85,6 +85,9 @@ PackedFunc PipelineExecutor::GetFunction(const std::string& name,
   } else if (name == "get_execute_count") {
     return PackedFunc(
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->GetExecutionCount(); });
+  } else if (name == "get_stage_statistics") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->GetStageStatistics(); });
   } else {
     LOG(FATAL) << "Unknown packed function: " << name;
   }
@@ -235,6 +238,16 @@ std::pair<int, int> PipelineExecutor::GetInputIndex(const std::string& name) {
  * \brief Getting the count of running pipeline.
  */
 int PipelineExecutor::GetExecutionCount() { return runtimes_.back()->GetExecutionCount(); }
+/*!
+ * \brief Getting the telemetry of each backend runtime.
+ */
+Array<Map<String, ObjectRef>> PipelineExecutor::GetStageStatistics() {
+  Array<Map<String, ObjectRef>> ret;
+  for (auto runtime : runtimes_) {
+    ret.push_back(runtime->GetStatistics());
+  }
+  return ret;
+}
 /*!
  * \brief Initialize the pipeline executor with a list of modules to be pipelined
  *  and config in JSON format.
@@ -251,8 +264,8 @@ void PipelineExecutor::Init(const std::vector<Module>& modules, const std::strin
   num_outputs_ = pipeline_config_.GetGlobalOutputNum();
   // Initialize the pipeline function class used for pipeline thread pool management
   // and schedule etc. This function returns a list of runtime.
-  global_runtime_ =
-      pipeline_scheduler_.PipelineInit(modules, pipeline_config_, input_connection_config_);
+  global_runtime_ = pipeline_scheduler_.PipelineInit(modules, pipeline_config_,
+                                                     input_connection_config_, queue_capacity_);
   runtimes_ = global_runtime_->GetRuntimeList();
   return;
 }
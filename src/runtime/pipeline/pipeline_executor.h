@@ -113,6 +113,11 @@ class TVM_DLL PipelineExecutor : public ModuleNode {
    * \return The number of outputs.
    */
   int NumOutputs() const { return num_outputs_; }
+  /*!
+   * \brief Getting the telemetry of each backend runtime, in the order of the runtimes.
+   * \return For each runtime, the statistics of its runs and of its input queues.
+   */
+  Array<Map<String, ObjectRef>> GetStageStatistics();
   /*!\brief Run the pipeline executor.*/
   void Run();
   int NumInputs();
@@ -184,6 +189,8 @@ class TVM_DLL PipelineExecutor : public ModuleNode {
   ModuleConfig mod_config_;
   /*!\brief How many outputs are in this pipeline executor.*/
   size_t num_outputs_ = 0;
+  /*!\brief The capacity of the forwarding queues, 0 uses the default one.*/
+  int queue_capacity_ = 0;
   /*!The list of backend runtime module.*/
   std::vector<std::shared_ptr<BackendRuntime>> runtimes_;
   std::shared_ptr<GlobalRuntime> global_runtime_;
@@ -198,6 +205,9 @@ class TVM_DLL PipelineExecutor : public ModuleNode {
         reader->Read(&input_connection_config_);
       } else if (key == "param_connection") {
         reader->Read(&param_connection_config_);
+      } else if (key == "queue_capacity") {
+        reader->Read(&queue_capacity_);
+        ICHECK_GE(queue_capacity_, 0) << "Invalid queue_capacity value " << queue_capacity_;
       } else {
         LOG(FATAL) << "do not support key " << key;
       }
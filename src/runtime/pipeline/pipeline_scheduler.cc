@@ -27,19 +27,27 @@ namespace runtime {
  * \brief Initialize the pipeline.
  * \param modules The list of graph executor modules.
  * \param pipeline_conf The dependency information of each graph executor module.
+ * \param input_connection_config The map of global inputs and subgraph inputs.
+ * \param queue_capacity The capacity of the forwarding queues, 0 uses the default one.
  */
 std::shared_ptr<GlobalRuntime> PipelineScheduler::PipelineInit(
     const std::vector<Module>& modules, const ConfigPipelineExecution& pipeline_config,
-    const InputConnectionConfig& input_connection_config) {
+    const InputConnectionConfig& input_connection_config, size_t queue_capacity) {
   std::vector<std::shared_ptr<BackendRuntime>> runtimes;
   graph_modules_ = modules;
   // Creating a list of runtimes.
   for (size_t i = 0; i < graph_modules_.size(); i++) {
     auto run_item = std::make_shared<BackendRuntime>(graph_modules_[i], i);
+    if (queue_capacity > 0) {
+      run_item->SetQueueCapacity(queue_capacity);
+    }
     runtimes.push_back(run_item);
   }
   // Creating the global runtime to represent the pipeline executor.
   global_runtime_ = std::make_shared<GlobalRuntime>(GLOBAL_MODULE_INDEX);
+  if (queue_capacity > 0) {
+    global_runtime_->SetQueueCapacity(queue_capacity);
+  }
   // Initializing the data structures used by pipeline logic.
   global_runtime_->InitializePipeline(input_connection_config, runtimes);
   // Creating a list of NDArray in order to storage the outputs data.
@@ -40,10 +40,13 @@ class PipelineScheduler {
    * \brief Initialize the pipeline.
    * \param modules The list of graph executor module.
    * \param pipeline_config The dependency information of each graph executor module.
+   * \param input_connection_config The map of global inputs and subgraph inputs.
+   * \param queue_capacity The capacity of the forwarding queues, 0 uses the default one.
    */
   std::shared_ptr<GlobalRuntime> PipelineInit(const std::vector<Module>& modules,
                                               const ConfigPipelineExecution& pipeline_config,
-                                              const InputConnectionConfig& input_connection_config);
+                                              const InputConnectionConfig& input_connection_config,
+                                              size_t queue_capacity = 0);
   /*!
    * \brief Running the pipeline logic.
    * \param runtimes A list of backend runtime modules.
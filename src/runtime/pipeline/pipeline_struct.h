@@ -22,14 +22,20 @@
 #include <dlpack/dlpack.h>
 #include <dmlc/json.h>
 #include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/container/map.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/profiling.h>
 #include <tvm/runtime/threading_backend.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -176,7 +182,65 @@ class DataNotify {
    */
   bool GetExitState(void) { return exit_state_.load(std::memory_order_acquire); }
 };
-/*!\brief The container used to store the forwarding data of the pipeline.*/
+/*!
+ * \brief A ring of buffers in which a runtime writes one of its outputs. The readers of the output
+ *  use a buffer in place, and recycle it when they do not need it anymore.
+ */
+class OutputBufferRing {
+ public:
+  /*!
+   * \brief Creating the ring.
+   * \param like The output whose shape, data type and device are used for the buffers.
+   * \param size The number of buffers.
+   */
+  OutputBufferRing(const NDArray& like, size_t size) : pending_(new std::atomic<int>[size]) {
+    for (size_t i = 0; i < size; i++) {
+      buffers_.push_back(NDArray::Empty(like.Shape(), like.DataType(), like->device));
+      pending_[i].store(0, std::memory_order_relaxed);
+    }
+  }
+  /*!\brief Whether the next buffer is recycled by all the readers of its previous content.*/
+  bool NextIsFree() const { return pending_[next_].load(std::memory_order_acquire) == 0; }
+  /*!
+   * \brief Taking the next buffer, which should be free.
+   * \param num_readers The number of readers which will recycle the new content of the buffer.
+   * \return The index of the buffer.
+   */
+  int Acquire(int num_readers) {
+    ICHECK(NextIsFree());
+    int slot = next_;
+    pending_[slot].store(num_readers, std::memory_order_release);
+    next_ = (next_ + 1) % buffers_.size();
+    return slot;
+  }
+  /*!\brief Recycling a buffer by one of its readers.*/
+  void Release(int slot) { pending_[slot].fetch_sub(1, std::memory_order_acq_rel); }
+  /*!\brief Getting a buffer via its index.*/
+  const NDArray& Get(int slot) const { return buffers_[slot]; }
+
+ private:
+  /*!\brief The buffers of the ring.*/
+  std::vector<NDArray> buffers_;
+  /*!\brief The number of readers which did not recycle each buffer yet.*/
+  std::unique_ptr<std::atomic<int>[]> pending_;
+  /*!\brief The index of the buffer which is taken next, only used by the writer.*/
+  size_t next_ = 0;
+};
+/*!\brief A reference to a buffer of an 'OutputBufferRing'.*/
+struct BufferRef {
+  std::shared_ptr<OutputBufferRing> ring;
+  int slot = -1;
+  /*!\brief Whether this reference points to a buffer.*/
+  bool defined() const { return ring != nullptr; }
+  /*!\brief Getting the referenced buffer.*/
+  const NDArray& Get() const { return ring->Get(slot); }
+  /*!\brief Recycling the referenced buffer.*/
+  void Release() const { ring->Release(slot); }
+};
+/*!
+ * \brief The container used to store the forwarding data of the pipeline. The data is either a
+ *  copy or a reference to a buffer of the producer.
+ */
 class QueueData {
  public:
   explicit QueueData(DLTensor* data) {
@@ -187,11 +251,26 @@ class QueueData {
     SetAsDataOwner(false);
   }
   QueueData() { SetAsDataOwner(true); }
-  /*!\brief Doing a deep copy for the 'QueueData' structure.*/
+  /*!
+   * \brief Doing a deep copy for the 'QueueData' structure. The reference to a buffer is kept as
+   *  it is, except that the referenced data is copied into a container not owning its data.
+   */
   QueueData& operator=(const QueueData& data) {
+    if (data.IsReference()) {
+      if (!IsDataOwner()) {
+        CreateCopyFrom(data.ref_.Get().operator->());
+      }
+      ref_ = data.ref_;
+      return *this;
+    }
     CreateCopyFrom(data.GetDLData());
     return *this;
   }
+  /*!\brief Forwarding a buffer by reference.*/
+  QueueData& operator=(const BufferRef& ref) {
+    ref_ = ref;
+    return *this;
+  }
   QueueData& operator=(const NDArray& from) {
     CreateCopyFrom(const_cast<DLTensor*>(from.operator->()));
     return *this;
@@ -205,6 +284,7 @@ class QueueData {
     if (!from) {
       LOG(FATAL) << "the 'from' pointer is a null pointer!";
     }
+    ref_ = BufferRef();
     size_t fromLen = tvm::runtime::GetDataSize(*from);
     size_t toLen = data_ ? tvm::runtime::GetDataSize(*data_) : 0;
     if (fromLen != toLen) {
@@ -225,6 +305,10 @@ class QueueData {
   }
   /*!\brief Return a pointer to the 'DLTensor' data.*/
   DLTensor* GetDLData() const { return data_; }
+  /*!\brief Whether the forwarding data is a reference to a buffer.*/
+  bool IsReference() const { return ref_.defined(); }
+  /*!\brief Return the reference to the forwarded buffer.*/
+  const BufferRef& GetReference() const { return ref_; }
   ~QueueData() {
     if (IsDataOwner() && data_) {
       TVMArrayFree(data_);
@@ -235,6 +319,8 @@ class QueueData {
  private:
   /*!\brief Pointer to the forwarding data.*/
   DLTensor* data_ = nullptr;
+  /*!\brief The reference to the forwarding buffer, when the data is forwarded by reference.*/
+  BufferRef ref_;
   /*!\brief Whether this container is the owner of the 'data_'.*/
   bool is_data_owner_ = false;
   /*!\brief Set the current container as the owner of the 'data_'.*/
@@ -669,6 +755,17 @@ struct ParamConnectionConfig {
 using ForwardQueue = SPSCLockFreeQueue<QueueData, ModuleInterfaceID>;
 using ForwardQueueMap =
     std::unordered_map<ModuleInterfaceID, std::shared_ptr<ForwardQueue>, ModuleIDHash>;
+/*!\brief The telemetry of a runtime in the pipeline.*/
+struct RuntimeStatistics {
+  /*!\brief The number of runs.*/
+  int64_t run_count = 0;
+  /*!\brief The total latency of the runs in microseconds.*/
+  double total_run_us = 0;
+  /*!\brief The largest latency of a run in microseconds.*/
+  double max_run_us = 0;
+  /*!\brief The time spent waiting for the full queues of the children in microseconds.*/
+  double backpressure_us = 0;
+};
 /*!\brief The basic class for runtime.*/
 class BasicRuntime {
   using ModuleInputPairList = std::vector<std::pair<std::shared_ptr<BasicRuntime>, int>>;
@@ -677,6 +774,11 @@ class BasicRuntime {
   explicit BasicRuntime(int runtime_idx) : runtime_idx_(runtime_idx) {}
   /*!\brief Return the index of the current module.*/
   int GetModuleIndex() { return runtime_idx_; }
+  /*!
+   * \brief Setting the capacity of the forwarding queues created afterwards. A producer waits
+   *  when the queue of its child is full, so this bounds the data in flight between two runtimes.
+   */
+  void SetQueueCapacity(size_t capacity) { queue_capacity_ = capacity; }
   /*!\brief Setting the data into this runtime via the input index.*/
   virtual void SetInput(const int index, DLTensor* data_in) {}
   /*!
@@ -721,6 +823,11 @@ class BasicRuntime {
   std::unordered_map<int, ForwardQueueMap> forward_queue_;
   /*!\brief The state of the pipeline.*/
   std::atomic<PipelineState> pipeline_state_{STOPPED};
+  /*!\brief The capacity of the forwarding queues, the largest one supported by default.*/
+  size_t queue_capacity_ = std::numeric_limits<size_t>::max();
+  /*!\brief The telemetry of this runtime, guarded by 'statistics_mutex_'.*/
+  RuntimeStatistics statistics_;
+  std::mutex statistics_mutex_;
   /*!
    * \brief Generate the ID of an input queue.
    * \param runtime_index The index of backend runtime.
@@ -735,11 +842,13 @@ class BasicRuntime {
    * \param forward_queue_map The map includes the id and the queue.
    * \param child_runtime The child runtime.
    * \param child_input_index The child runtime index.
-   * \param data The data is used for forwarding.
+   * \param data The data is used for forwarding, either a tensor which is copied or a reference to
+   *  a buffer.
    */
+  template <typename DataType>
   bool ForwardData(const ForwardQueueMap* forward_queue_map,
                    std::shared_ptr<BasicRuntime> child_runtime, int child_input_index,
-                   const DLTensor* data) {
+                   const DataType& data) {
     auto child_runtime_index = child_runtime->GetModuleIndex();
     auto queue_id = GenerateQueueID(child_runtime_index, child_input_index, INPUT);
     if (forward_queue_map->find(queue_id) == forward_queue_map->end()) {
@@ -750,12 +859,20 @@ class BasicRuntime {
     auto forward_queue = forward_queue_map->at(queue_id);
     // If the queue is full, keep try until the push get success or the pipeline run into
     // a STOP state.
-    while (!forward_queue->Push<const DLTensor*>(data)) {
-      if (PipelineIsStop()) {
-        LOG(INFO) << "The forwarding process is stopped after the pipeline status is changed"
-                  << " into stop.";
-        return false;
+    if (!forward_queue->Push<DataType>(data)) {
+      auto start = std::chrono::high_resolution_clock::now();
+      while (!forward_queue->Push<DataType>(data)) {
+        if (PipelineIsStop()) {
+          LOG(INFO) << "The forwarding process is stopped after the pipeline status is changed"
+                    << " into stop.";
+          return false;
+        }
+        std::this_thread::yield();
       }
+      std::chrono::duration<double, std::micro> waited =
+          std::chrono::high_resolution_clock::now() - start;
+      std::lock_guard<std::mutex> lock(statistics_mutex_);
+      statistics_.backpressure_us += waited.count();
     }
     child_runtime->ParentNotify(child_input_index);
     return true;
@@ -777,7 +894,7 @@ class BasicRuntime {
                  << " is already created!";
       return;
     }
-    auto queue = std::make_shared<ForwardQueue>(queue_id);
+    auto queue = std::make_shared<ForwardQueue>(queue_id, queue_capacity_);
     queue_map[queue_id] = queue;
     // Use the created queue as the consumer queue for the input interface of this forwarding
     // pair.
@@ -824,6 +941,21 @@ class BackendRuntime : public BasicRuntime {
   tvm::runtime::PackedFunc get_num_inputs_;
   tvm::runtime::PackedFunc get_input_index_;
   tvm::runtime::PackedFunc run_;
+  tvm::runtime::PackedFunc set_input_zero_copy_;
+  tvm::runtime::PackedFunc set_output_zero_copy_;
+  /*!\brief The largest number of queued buffers in a ring of forwarded outputs.*/
+  static constexpr size_t kMaxForwardingBuffers = 4;
+  /*!\brief The rings of buffers in which the outputs forwarded to the children are written.*/
+  std::unordered_map<int, std::shared_ptr<OutputBufferRing>> output_rings_;
+  /*!\brief The buffers the outputs are written into by the current run.*/
+  std::unordered_map<int, BufferRef> output_buffers_;
+  /*!\brief The forwarded buffers used by the inputs of the current run.*/
+  std::vector<BufferRef> input_buffers_;
+  /*!\brief The stream and its device on which the forwarded buffers are copied to the inputs.*/
+  Device copy_device_{kDLCPU, 0};
+  TVMStreamHandle copy_stream_ = nullptr;
+  /*!\brief Whether some copies on 'copy_stream_' are not synchronized yet.*/
+  bool copy_pending_ = false;
   /*!\brief The worker thread is used to execute the runtimes in pipeline.*/
   void StartWorkThread() {
     SetPipelineState(RUNNING);
@@ -881,6 +1013,12 @@ class BackendRuntime : public BasicRuntime {
       }
       notifys.erase(notify);
     }
+    // The copies of the inputs overlap with the wait for the other inputs, and are synchronized
+    // once all the inputs are loaded.
+    if (copy_pending_) {
+      DeviceAPI::Get(copy_device_)->StreamSync(copy_device_, copy_stream_);
+      copy_pending_ = false;
+    }
     return exit_notify;
   }
   /*!
@@ -894,11 +1032,107 @@ class BackendRuntime : public BasicRuntime {
     }
     auto queue = input_queue_[input_index];
     QueueData data;
-    // TODO(huajsj): Doing the 'SetInput' inside the poll function to avoid one time data copy.
     if (!queue->Poll<QueueData>(&data)) {
       return false;
     }
-    SetInput(input_index, data.GetDLData());
+    if (data.IsReference()) {
+      SetInputReference(input_index, data.GetReference());
+    } else {
+      SetInput(input_index, data.GetDLData());
+    }
+    return true;
+  }
+  /*!
+   * \brief Setting a buffer forwarded by reference as an input. The buffer is used in place when it
+   *  is on the device of the input, otherwise it is copied on 'copy_stream_'. The buffer is
+   *  recycled after the next run.
+   */
+  void SetInputReference(int input_index, const BufferRef& ref) {
+    const NDArray& buffer = ref.Get();
+    NDArray input = get_input_(input_index);
+    Device from = buffer->device;
+    Device to = input->device;
+    if (set_input_zero_copy_ != nullptr && from.device_type == to.device_type &&
+        from.device_id == to.device_id) {
+      set_input_zero_copy_(input_index, buffer);
+    } else if (from.device_type == kDLCPU || to.device_type == kDLCPU) {
+      Device dev = from.device_type == kDLCPU ? to : from;
+      if (copy_stream_ == nullptr) {
+        copy_device_ = dev;
+        copy_stream_ = DeviceAPI::Get(dev)->CreateStream(dev);
+      }
+      if (dev.device_type == copy_device_.device_type && dev.device_id == copy_device_.device_id) {
+        NDArray::CopyFromTo(buffer.operator->(), const_cast<DLTensor*>(input.operator->()),
+                            copy_stream_);
+        copy_pending_ = true;
+      } else {
+        CopyFromTo(const_cast<DLTensor*>(buffer.operator->()),
+                   const_cast<DLTensor*>(input.operator->()));
+      }
+    } else {
+      CopyFromTo(const_cast<DLTensor*>(buffer.operator->()),
+                 const_cast<DLTensor*>(input.operator->()));
+    }
+    input_buffers_.push_back(ref);
+  }
+  /*!
+   * \brief Waiting for the run to finish with the forwarded buffers, before the children read the
+   *  output buffers on other streams and the parents overwrite the recycled input buffers.
+   */
+  void SyncForwardedBuffers() {
+    std::vector<Device> synced;
+    auto f_sync = [&synced](const BufferRef& ref) {
+      Device dev = ref.Get()->device;
+      bool is_synced = std::any_of(synced.begin(), synced.end(), [&dev](const Device& d) {
+        return d.device_type == dev.device_type && d.device_id == dev.device_id;
+      });
+      if (dev.device_type != kDLCPU && !is_synced) {
+        DeviceAPI::Get(dev)->StreamSync(dev, nullptr);
+        synced.push_back(dev);
+      }
+    };
+    for (const auto& buffer_pair : output_buffers_) {
+      f_sync(buffer_pair.second);
+    }
+    for (const auto& ref : input_buffers_) {
+      f_sync(ref);
+    }
+  }
+  /*!\brief Recycling the forwarded buffers used by the inputs of the last run.*/
+  void ReleaseInputBuffers() {
+    for (const auto& ref : input_buffers_) {
+      ref.Release();
+    }
+    input_buffers_.clear();
+  }
+  /*!
+   * \brief Taking the buffers in which the run writes the outputs forwarded to the children. The
+   *  producer waits when a ring has no buffer recycled by the children yet.
+   * \return Returning false when the pipeline is stopped while waiting, otherwise returning true.
+   */
+  bool AcquireOutputBuffers() {
+    for (auto& ring_pair : output_rings_) {
+      auto output_idx = ring_pair.first;
+      auto& ring = ring_pair.second;
+      if (!ring->NextIsFree()) {
+        auto start = std::chrono::high_resolution_clock::now();
+        while (!ring->NextIsFree()) {
+          if (PipelineIsStop()) {
+            return false;
+          }
+          std::this_thread::yield();
+        }
+        std::chrono::duration<double, std::micro> waited =
+            std::chrono::high_resolution_clock::now() - start;
+        std::lock_guard<std::mutex> lock(statistics_mutex_);
+        statistics_.backpressure_us += waited.count();
+      }
+      BufferRef ref;
+      ref.ring = ring;
+      ref.slot = ring->Acquire(children_[output_idx].size());
+      set_output_zero_copy_(output_idx, ref.Get());
+      output_buffers_[output_idx] = ref;
+    }
     return true;
   }
   /*!
@@ -912,14 +1146,23 @@ class BackendRuntime : public BasicRuntime {
       if (forward_queue_.find(output_idx) == forward_queue_.end()) {
         LOG(FATAL) << "Not find the forwarding queue map for output(" << output_idx << ")!";
       }
-      NDArray output = GetOutput(output_idx);
       auto forward_queue_map = forward_queue_[output_idx];
+      auto buffer = output_buffers_.find(output_idx);
       // Notifying the 'children runtime' that the forwarding data are ready.
       for (auto module_pair : child.second) {
         auto child_runtime = module_pair.first;
         auto child_input_index = module_pair.second;
-        auto output_data = const_cast<DLTensor*>(output.operator->());
-        if (!ForwardData(&forward_queue_map, child_runtime, child_input_index, output_data)) {
+        bool forwarded = false;
+        if (buffer != output_buffers_.end()) {
+          forwarded =
+              ForwardData(&forward_queue_map, child_runtime, child_input_index, buffer->second);
+        } else {
+          NDArray output = GetOutput(output_idx);
+          auto output_data = const_cast<DLTensor*>(output.operator->());
+          forwarded =
+              ForwardData(&forward_queue_map, child_runtime, child_input_index, output_data);
+        }
+        if (!forwarded) {
           return false;
         }
       }
@@ -990,12 +1233,17 @@ class BackendRuntime : public BasicRuntime {
     get_input_ = module_.GetFunction("get_input");
     get_output_ = module_.GetFunction("get_output");
     run_ = module_.GetFunction("run");
+    set_input_zero_copy_ = module_.GetFunction("set_input_zero_copy");
+    set_output_zero_copy_ = module_.GetFunction("set_output_zero_copy");
   }
   ~BackendRuntime() {
+    StopPipeline();
     for (auto data : input_tensor_local_copy_) {
       TVMArrayFree(data.second);
     }
-    StopPipeline();
+    if (copy_stream_ != nullptr) {
+      DeviceAPI::Get(copy_device_)->FreeStream(copy_device_, copy_stream_);
+    }
   }
   /*!
    * \brief Getting the times of using pipeline function.
@@ -1043,6 +1291,17 @@ class BackendRuntime : public BasicRuntime {
           this->CreateForwardingQueue(output_idx, child_runtime, input_index);
         },
         runtime_idx_);
+    // The outputs forwarded to the children are written into rings of buffers, which are handed
+    // to the children by reference instead of being copied. A buffer is busy while it is in a
+    // forwarding queue or used by a child, so the ring holds as many buffers as the queue, plus
+    // the ones being written and read.
+    if (set_output_zero_copy_ != nullptr) {
+      size_t ring_size = std::min<size_t>(queue_capacity_, kMaxForwardingBuffers) + 2;
+      for (const auto& child : children_) {
+        NDArray output = get_output_(child.first);
+        output_rings_[child.first] = std::make_shared<OutputBufferRing>(output, ring_size);
+      }
+    }
 
     StartWorkThread();
   }
@@ -1092,11 +1351,55 @@ class BackendRuntime : public BasicRuntime {
    * \return Returning false if the forwarding function failed. Otherwise, returning true.;
    */
   bool RunPipeline() {
+    if (!AcquireOutputBuffers()) {
+      return false;
+    }
+    auto start = std::chrono::high_resolution_clock::now();
     Run();
+    std::chrono::duration<double, std::micro> latency =
+        std::chrono::high_resolution_clock::now() - start;
+    SyncForwardedBuffers();
+    ReleaseInputBuffers();
+    {
+      std::lock_guard<std::mutex> lock(statistics_mutex_);
+      statistics_.run_count++;
+      statistics_.total_run_us += latency.count();
+      statistics_.max_run_us = std::max(statistics_.max_run_us, latency.count());
+    }
     bool ret = ForwardingOutputDataToChildren();
     pipeline_execution_count_++;
     return ret;
   }
+  /*!
+   * \brief Getting the telemetry of this runtime: the latency of its runs, the time it waited on
+   *  the full queues of its children, and the depth of its input queues.
+   */
+  Map<String, ObjectRef> GetStatistics() {
+    RuntimeStatistics statistics;
+    {
+      std::lock_guard<std::mutex> lock(statistics_mutex_);
+      statistics = statistics_;
+    }
+    int64_t queue_depth = 0;
+    int64_t max_queue_depth = 0;
+    for (const auto& queue_pair : input_queue_) {
+      queue_depth += queue_pair.second->Size();
+      max_queue_depth =
+          std::max(max_queue_depth, static_cast<int64_t>(queue_pair.second->MaxSize()));
+    }
+    double mean_run_us =
+        statistics.run_count > 0 ? statistics.total_run_us / statistics.run_count : 0;
+    return {
+        {"Count", ObjectRef(make_object<profiling::CountNode>(statistics.run_count))},
+        {"Duration (us)", ObjectRef(make_object<profiling::DurationNode>(statistics.total_run_us))},
+        {"Mean (us)", ObjectRef(make_object<profiling::DurationNode>(mean_run_us))},
+        {"Max (us)", ObjectRef(make_object<profiling::DurationNode>(statistics.max_run_us))},
+        {"Backpressure (us)",
+         ObjectRef(make_object<profiling::DurationNode>(statistics.backpressure_us))},
+        {"Queue Depth", ObjectRef(make_object<profiling::CountNode>(queue_depth))},
+        {"Max Queue Depth", ObjectRef(make_object<profiling::CountNode>(max_queue_depth))},
+    };
+  }
 };
 /*!
  * \brief This global runtime represents the pipeline executor and exposes the input and output
@@ -1157,6 +1460,9 @@ class GlobalRuntime : public BasicRuntime {
       if (!queue->Poll<QueueData>(&data)) {
         LOG(FATAL) << "There is no data in the data queue, it should not happen!";
       }
+      if (data.IsReference()) {
+        data.GetReference().Release();
+      }
     }
     return true;
   }
@@ -18,6 +18,8 @@
  */
 #ifndef TVM_RUNTIME_PIPELINE_SPSC_QUEUE_H_
 #define TVM_RUNTIME_PIPELINE_SPSC_QUEUE_H_
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <thread>
 /*!\brief A single producer and single consumer lock free queue.
@@ -25,7 +27,14 @@
 template <typename SlotType, typename IDType = int, int QueueLength = 1024>
 class SPSCLockFreeQueue {
  public:
-  explicit SPSCLockFreeQueue(IDType id) : id_(id) {}
+  /*!
+   * \brief Constructing the queue.
+   * \param id The ID of the queue.
+   * \param capacity The number of elements the queue can hold before being full, it is clamped
+   *  to the range [1, QueueLength - 1].
+   */
+  explicit SPSCLockFreeQueue(IDType id, size_t capacity = QueueLength - 1)
+      : len_(std::min(std::max(capacity, size_t(1)), size_t(QueueLength - 1)) + 1), id_(id) {}
   /*A read barrier enforcing the CPU to performe the reads before this barrier.*/
   inline void read_barrier() { std::atomic_thread_fence(std::memory_order_acquire); }
   /*A write barrier enforcing the CPU to performe the writes before this barrier.*/
@@ -40,6 +49,15 @@ class SPSCLockFreeQueue {
     read_barrier();
     return head_ == tail_;
   }
+  /*!\brief Getting the number of elements in the queue.*/
+  size_t Size() {
+    read_barrier();
+    return (tail_ + len_ - head_) % len_;
+  }
+  /*!\brief Getting the number of elements the queue can hold.*/
+  size_t Capacity() const { return len_ - 1; }
+  /*!\brief Getting the largest number of elements the queue held so far.*/
+  size_t MaxSize() const { return max_size_.load(std::memory_order_relaxed); }
   /*!
    * \brief Pushing the data into the queue. Only a single producer will call this function.
    * \param data The data which is pushed into the queue.
@@ -48,9 +66,14 @@ class SPSCLockFreeQueue {
   template <typename data_type>
   bool Push(const data_type& data) {
     if (Full()) return false;
+    // Counting the new element before publishing it, the consumer may poll it right away.
+    size_t size = Size() + 1;
     queue_[tail_] = data;
     write_barrier();
     tail_ = (tail_ + 1) % len_;
+    if (size > max_size_.load(std::memory_order_relaxed)) {
+      max_size_.store(size, std::memory_order_relaxed);
+    }
     return true;
   }
   /*!
@@ -73,11 +96,13 @@ class SPSCLockFreeQueue {
   size_t head_ = 0;
   /*!\brief The end of the queue at which elements are added.*/
   size_t tail_ = 0;
-  /*!\brief The length of the queue.*/
+  /*!\brief The length of the queue, one more than its capacity.*/
   size_t len_ = QueueLength;
   /*!\brief The queue used to store the data.*/
   SlotType queue_[QueueLength];
   /*!\brief The ID of the queue.*/
   IDType id_;
+  /*!\brief The largest number of elements the queue held so far.*/
+  std::atomic<size_t> max_size_{0};
 };
 #endif  // TVM_RUNTIME_PIPELINE_SPSC_QUEUE_H_
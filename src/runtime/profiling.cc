@@ -31,12 +31,16 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <map>
 #include <numeric>
+#include <sstream>
 #include <thread>
 
+#include "trace_recorder.h"
+
 namespace tvm {
 namespace runtime {
 
@@ -152,12 +156,17 @@ void Profiler::StartCall(String name, Device dev,
       objs.emplace_back(collector, obj);
     }
   }
-  in_flight_.push(CallFrame{dev, name, Timer::Start(dev), extra_metrics, objs});
+  int64_t trace_begin_ns = TraceRecorder::Enabled() ? TraceRecorder::NowNanos() : 0;
+  in_flight_.push(CallFrame{dev, name, Timer::Start(dev), extra_metrics, objs, trace_begin_ns});
 }
 
 void Profiler::StopCall(std::unordered_map<std::string, ObjectRef> extra_metrics) {
   CallFrame cf = in_flight_.top();
   cf.timer->Stop();
+  if (cf.trace_begin_ns != 0 && TraceRecorder::Enabled()) {
+    TraceRecorder::Global()->Record("op", cf.name.c_str(), cf.trace_begin_ns,
+                                    TraceRecorder::NowNanos());
+  }
   for (auto& p : extra_metrics) {
     cf.extra_metrics[p.first] = p.second;
   }
@@ -177,6 +186,22 @@ void Profiler::Stop() {
   for (size_t i = 0; i < devs_.size(); i++) {
     StopCall();
   }
+  if (TraceRecorder::Enabled()) TraceDeviceStreams();
+}
+
+void Profiler::TraceDeviceStreams() {
+  // Device timers only give durations. Calls on a stream run in launch order,
+  // so each call starts when it was launched or when the previous call on the
+  // stream finished, whichever is later.
+  std::unordered_map<Device, int64_t> stream_end;
+  TraceRecorder* recorder = TraceRecorder::Global();
+  for (const CallFrame& cf : calls_) {
+    if (cf.trace_begin_ns == 0 || cf.dev.device_type == kDLCPU || cf.name == "Total") continue;
+    int64_t begin = std::max(cf.trace_begin_ns, stream_end[cf.dev]);
+    int64_t end = begin + cf.timer->SyncAndGetElapsedNanos();
+    recorder->Record("device", cf.name.c_str(), begin, end, recorder->DeviceProcess(cf.dev), 0);
+    stream_end[cf.dev] = end;
+  }
 }
 
 std::vector<int64_t> ToShape(NDArray shape_tensor) {
@@ -843,6 +868,19 @@ PackedFunc ProfileFunction(Module mod, std::string func_name, int device_type, i
   });
 }
 
+Array<MetricCollector> MetricCollectorsFromNames(const String& names) {
+  Array<MetricCollector> collectors;
+  std::istringstream is(names);
+  std::string name;
+  while (std::getline(is, name, ',')) {
+    if (name.empty()) continue;
+    const PackedFunc* f = Registry::Get(name);
+    ICHECK(f != nullptr) << "Cannot find the metric collector constructor " << name;
+    collectors.push_back((*f)());
+  }
+  return collectors;
+}
+
 TVM_REGISTER_GLOBAL("runtime.profiling.ProfileFunction")
     .set_body_typed<PackedFunc(Module, String, int, int, int,
                                Array<MetricCollector>)>([](Module mod, String func_name,
@@ -922,6 +960,169 @@ PackedFunc WrapTimeEvaluator(PackedFunc pf, Device dev, int number, int repeat,
   return PackedFunc(ftimer);
 }
 
+TimingSummary SummarizeTimings(const std::vector<double>& samples, double outlier_threshold) {
+  TimingSummary summary;
+  if (samples.empty()) return summary;
+  auto median_of = [](std::vector<double> v) {
+    size_t mid = v.size() / 2;
+    std::nth_element(v.begin(), v.begin() + mid, v.end());
+    double median = v[mid];
+    if (v.size() % 2 == 0) median = (median + *std::max_element(v.begin(), v.begin() + mid)) / 2;
+    return median;
+  };
+  double median = median_of(samples);
+  std::vector<double> deviations;
+  for (double x : samples) deviations.push_back(std::abs(x - median));
+  double mad = median_of(deviations);
+  for (double x : samples) {
+    bool outlier =
+        outlier_threshold > 0 && mad > 0 && 0.6745 * (x - median) / mad > outlier_threshold;
+    (outlier ? summary.dropped : summary.kept).push_back(x);
+  }
+  size_t n = summary.kept.size();
+  summary.mean = std::accumulate(summary.kept.begin(), summary.kept.end(), 0.0) / n;
+  if (n > 1) {
+    double sq = 0;
+    for (double x : summary.kept) sq += (x - summary.mean) * (x - summary.mean);
+    summary.std = std::sqrt(sq / (n - 1));
+    // two sided 95% quantiles of the Student t distribution.
+    static const double t95[] = {12.706, 4.303, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+                                 2.228,  2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110,
+                                 2.101,  2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060,
+                                 2.056,  2.052, 2.048, 2.045, 2.042, 2.040};
+    double t = n - 1 <= 30 ? t95[n - 2] : 1.96;
+    summary.ci = t * summary.std / std::sqrt(static_cast<double>(n));
+  }
+  return summary;
+}
+
+PackedFunc WrapAdaptiveTimeEvaluator(std::vector<PackedFunc> fs, Device dev, int number,
+                                     int min_repeat, int max_repeat, int min_repeat_ms,
+                                     double max_rel_ci, double outlier_threshold,
+                                     int cooldown_interval_ms, PackedFunc f_preproc) {
+  ICHECK(!fs.empty());
+  ICHECK_GT(number, 0) << "ValueError: number should be positive";
+  ICHECK_GE(min_repeat, 2) << "ValueError: min_repeat should be at least 2";
+  ICHECK_GE(max_repeat, min_repeat) << "ValueError: max_repeat should be at least min_repeat";
+
+  auto ftimer = [fs, dev, number, min_repeat, max_repeat, min_repeat_ms, max_rel_ci,
+                 outlier_threshold, cooldown_interval_ms,
+                 f_preproc](TVMArgs args, TVMRetValue* rv) {
+    TVMRetValue temp;
+    size_t num_candidates = fs.size();
+    // skip first time call, to activate lazy compilation components.
+    for (const PackedFunc& f : fs) f.CallPacked(args, &temp);
+    DeviceAPI::Get(dev)->StreamSync(dev, nullptr);
+
+    std::vector<int> numbers(num_candidates, number);
+    std::vector<std::vector<double>> samples(num_candidates);
+    std::vector<TimingSummary> summaries(num_candidates);
+    auto time_once = [&](size_t c) {
+      if (f_preproc != nullptr) f_preproc.CallPacked(args, &temp);
+      Timer t = Timer::Start(dev);
+      for (int j = 0; j < numbers[c]; ++j) fs[c].CallPacked(args, &temp);
+      t->Stop();
+      return t->SyncAndGetElapsedNanos() / 1e6;
+    };
+    for (int round = 0; round < max_repeat; ++round) {
+      for (size_t k = 0; k < num_candidates; ++k) {
+        size_t c = (round + k) % num_candidates;
+        double duration_ms = time_once(c);
+        // the number of runs is only adjusted in the first round, to keep the repeats alike.
+        int zero_times = 0;
+        while (round == 0 && duration_ms < min_repeat_ms && zero_times < 100) {
+          if (duration_ms > 0) {
+            const double golden_ratio = 1.618;
+            numbers[c] = static_cast<int>(std::max(
+                (min_repeat_ms / (duration_ms / numbers[c]) + 1), numbers[c] * golden_ratio));
+          } else {
+            ++zero_times;
+          }
+          duration_ms = time_once(c);
+        }
+        samples[c].push_back(duration_ms / 1e3 / numbers[c]);
+      }
+      if (round + 1 < min_repeat) continue;
+      bool converged = true;
+      for (size_t c = 0; c < num_candidates; ++c) {
+        summaries[c] = SummarizeTimings(samples[c], outlier_threshold);
+        converged = converged && summaries[c].ci <= max_rel_ci * summaries[c].mean;
+      }
+      if (converged) break;
+      if (cooldown_interval_ms > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(cooldown_interval_ms));
+      }
+    }
+
+    std::ostringstream os;
+    auto write = [&os](double value) {
+      os.write(reinterpret_cast<char*>(&value), sizeof(value));
+    };
+    for (const TimingSummary& summary : summaries) {
+      write(summary.kept.size());
+      write(summary.dropped.size());
+      write(summary.mean);
+      write(summary.std);
+      write(summary.ci);
+      for (double x : summary.kept) write(x);
+      for (double x : summary.dropped) write(x);
+    }
+    std::string blob = os.str();
+    TVMByteArray arr;
+    arr.size = blob.length();
+    arr.data = blob.data();
+    *rv = arr;
+  };
+  return PackedFunc(ftimer);
+}
+
+PackedFunc WrapBatchedTimeEvaluator(PackedFunc pf, Device dev, int number, int repeat,
+                                    PackedFunc f_preproc) {
+  ICHECK(pf != nullptr);
+  ICHECK_GT(number, 0) << "ValueError: number should be positive";
+  ICHECK_GT(repeat, 0) << "ValueError: repeat should be positive";
+
+  auto ftimer = [pf, dev, number, repeat, f_preproc](TVMArgs args, TVMRetValue* rv) {
+    TVMRetValue temp;
+    // skip first time call, to activate lazy compilation components.
+    pf.CallPacked(args, &temp);
+    DeviceAPI::Get(dev)->StreamSync(dev, nullptr);
+
+    std::vector<Timer> repeats;
+    std::vector<Timer> gaps;
+    for (int i = 0; i < repeat; ++i) {
+      if (i > 0) {
+        gaps.push_back(Timer::Start(dev));
+      }
+      if (f_preproc != nullptr) {
+        f_preproc.CallPacked(args, &temp);
+      }
+      if (i > 0) {
+        gaps.back()->Stop();
+      }
+      repeats.push_back(Timer::Start(dev));
+      for (int j = 0; j < number; ++j) {
+        pf.CallPacked(args, &temp);
+      }
+      repeats.back()->Stop();
+    }
+
+    std::ostringstream os;
+    auto write = [&os](double value) {
+      os.write(reinterpret_cast<char*>(&value), sizeof(value));
+    };
+    // the first synchronization waits for all the repeats, the later ones return at once.
+    for (const Timer& t : repeats) write(t->SyncAndGetElapsedNanos() / 1e9 / number);
+    for (const Timer& t : gaps) write(t->SyncAndGetElapsedNanos() / 1e9);
+    std::string blob = os.str();
+    TVMByteArray arr;
+    arr.size = blob.length();
+    arr.data = blob.data();
+    *rv = arr;
+  };
+  return PackedFunc(ftimer);
+}
+
 TVM_REGISTER_GLOBAL("runtime.profiling.Report")
     .set_body_typed([](Array<Map<String, ObjectRef>> calls,
                        Map<String, Map<String, ObjectRef>> device_metrics,
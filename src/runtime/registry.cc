@@ -27,78 +27,160 @@
 #include <tvm/runtime/registry.h>
 
 #include <array>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 
 #include "runtime_base.h"
 
 namespace tvm {
 namespace runtime {
 
+/*!
+ * \brief The functions, in a table that is read without a lock.
+ *
+ * The lookups run on every thread, often on the hot paths of the executors, while functions are
+ * mostly registered at startup. The table is open addressed with atomic slots: the writers hold
+ * the mutex, and publish an entry once its body is set, and the readers probe with acquire loads.
+ * A table that is full is replaced by one twice as large, which is published in the same way.
+ */
 struct Registry::Manager {
-  // map storing the functions.
-  // We deliberately used raw pointer.
+  /*! \brief A table of the entries, the capacity of which is a power of two. */
+  struct Table {
+    explicit Table(size_t capacity)
+        : capacity(capacity), slots(new std::atomic<Registry*>[capacity]) {
+      for (size_t i = 0; i < capacity; ++i) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+    size_t capacity;
+    std::unique_ptr<std::atomic<Registry*>[]> slots;
+  };
+
+  // The current table.
+  // We deliberately leak the tables and the entries, which can still be read by other threads,
+  // and hold raw pointers.
   // This is because PackedFunc can contain callbacks into the host language (Python) and the
   // resource can become invalid because of indeterministic order of destruction and forking.
   // The resources will only be recycled during program exit.
-  std::unordered_map<std::string, Registry*> fmap;
-  // mutex
+  std::atomic<Table*> table;
+  /*! \brief The number of slots that are not empty, including the removed entries. */
+  size_t num_used{0};
+  // mutex of the writers
   std::mutex mutex;
 
-  Manager() {}
+  Manager() : table(new Table(1024)) {}
 
   static Manager* Global() {
     // We deliberately leak the Manager instance, to avoid leak sanitizers
-    // complaining about the entries in Manager::fmap being leaked at program
+    // complaining about the entries in the table being leaked at program
     // exit.
     static Manager* inst = new Manager();
     return inst;
   }
+
+  /*! \brief The entry in the slot of a removed function. */
+  static Registry* Removed() {
+    static Registry* inst = new Registry();
+    return inst;
+  }
+
+  /*!
+   * \brief Find the slot of a function.
+   * \param table The table.
+   * \param name The name of the function.
+   * \return The slot holding the function, or the empty slot ending its probe sequence.
+   */
+  static std::atomic<Registry*>* Find(const Table* table, const std::string& name) {
+    size_t mask = table->capacity - 1;
+    for (size_t i = std::hash<std::string>()(name) & mask;; i = (i + 1) & mask) {
+      std::atomic<Registry*>* slot = &table->slots[i];
+      Registry* entry = slot->load(std::memory_order_acquire);
+      if (entry == nullptr || (entry != Removed() && entry->name_ == name)) return slot;
+    }
+  }
+
+  /*! \brief Get the slot of a function, or of a new entry, with the mutex held. */
+  std::atomic<Registry*>* FindOrInsert(const std::string& name) {
+    Table* current = table.load(std::memory_order_relaxed);
+    std::atomic<Registry*>* slot = Find(current, name);
+    if (slot->load(std::memory_order_relaxed) != nullptr) return slot;
+    // Keep at least half of the slots empty, so that the probe sequences are short
+    if ((num_used + 1) * 2 > current->capacity) {
+      Table* grown = new Table(current->capacity * 2);
+      num_used = 0;
+      for (size_t i = 0; i < current->capacity; ++i) {
+        Registry* entry = current->slots[i].load(std::memory_order_relaxed);
+        if (entry == nullptr || entry == Removed()) continue;
+        Find(grown, entry->name_)->store(entry, std::memory_order_relaxed);
+        ++num_used;
+      }
+      table.store(grown, std::memory_order_release);
+      slot = Find(grown, name);
+    }
+    ++num_used;
+    return slot;
+  }
 };
 
 Registry& Registry::set_body(PackedFunc f) {  // NOLINT(*)
-  func_ = f;
-  return *this;
+  Manager* m = Manager::Global();
+  std::lock_guard<std::mutex> lock(m->mutex);
+  std::atomic<Registry*>* slot = m->FindOrInsert(name_);
+  Registry* r = this;
+  // The readers of a published entry may be calling its body, which is thus never changed
+  if (slot->load(std::memory_order_relaxed) == this) {
+    r = new Registry();
+    r->name_ = name_;
+  }
+  r->func_ = f;
+  slot->store(r, std::memory_order_release);
+  return *r;
 }
 
 Registry& Registry::Register(const std::string& name, bool can_override) {  // NOLINT(*)
   Manager* m = Manager::Global();
   std::lock_guard<std::mutex> lock(m->mutex);
-  if (m->fmap.count(name)) {
+  Registry* entry =
+      Manager::Find(m->table.load(std::memory_order_relaxed), name)->load(std::memory_order_relaxed);
+  if (entry != nullptr && entry != Manager::Removed()) {
     ICHECK(can_override) << "Global PackedFunc " << name << " is already registered";
   }
-
+  // The entry is published by set_body, so that the readers never see it without a body
   Registry* r = new Registry();
   r->name_ = name;
-  m->fmap[name] = r;
   return *r;
 }
 
 bool Registry::Remove(const std::string& name) {
   Manager* m = Manager::Global();
   std::lock_guard<std::mutex> lock(m->mutex);
-  auto it = m->fmap.find(name);
-  if (it == m->fmap.end()) return false;
-  m->fmap.erase(it);
+  std::atomic<Registry*>* slot = Manager::Find(m->table.load(std::memory_order_relaxed), name);
+  if (slot->load(std::memory_order_relaxed) == nullptr) return false;
+  // The slot stays used, so that the probe sequences going through it are unchanged
+  slot->store(Manager::Removed(), std::memory_order_release);
   return true;
 }
 
 const PackedFunc* Registry::Get(const std::string& name) {
   Manager* m = Manager::Global();
-  std::lock_guard<std::mutex> lock(m->mutex);
-  auto it = m->fmap.find(name);
-  if (it == m->fmap.end()) return nullptr;
-  return &(it->second->func_);
+  Manager::Table* table = m->table.load(std::memory_order_acquire);
+  Registry* entry = Manager::Find(table, name)->load(std::memory_order_acquire);
+  if (entry == nullptr) return nullptr;
+  return &(entry->func_);
 }
 
 std::vector<std::string> Registry::ListNames() {
   Manager* m = Manager::Global();
   std::lock_guard<std::mutex> lock(m->mutex);
+  Manager::Table* table = m->table.load(std::memory_order_relaxed);
   std::vector<std::string> keys;
-  keys.reserve(m->fmap.size());
-  for (const auto& kv : m->fmap) {
-    keys.push_back(kv.first);
+  for (size_t i = 0; i < table->capacity; ++i) {
+    Registry* entry = table->slots[i].load(std::memory_order_relaxed);
+    if (entry != nullptr && entry != Manager::Removed()) {
+      keys.push_back(entry->name_);
+    }
   }
   return keys;
 }
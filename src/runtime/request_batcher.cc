@@ -0,0 +1,455 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file request_batcher.cc
+ * \brief A runtime module that gathers concurrent single-sample requests into
+ *  batches and runs them on executors compiled with a batch dimension.
+ */
+#include <tvm/runtime/container/adt.h>
+#include <tvm/runtime/container/map.h>
+#include <tvm/runtime/container/shape_tuple.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Collects single-sample requests submitted from any number of threads,
+ *  runs them as one batch on the smallest executor bucket that fits, and writes
+ *  each sample's results directly into the caller-provided output tensors.
+ *
+ *  Every bucket is an executor whose inputs and outputs carry a leading batch
+ *  dimension equal to the bucket's batch size. A bucket is either a graph
+ *  executor module, or a VM module whose function \p vm_function is invoked.
+ *  The same VM module may back several buckets when its function has a dynamic
+ *  batch dimension.
+ */
+class RequestBatcher : public ModuleNode {
+ public:
+  RequestBatcher(Array<Module> executors, ShapeTuple batch_sizes, int64_t max_latency_us,
+                 std::string vm_function)
+      : vm_function_(std::move(vm_function)), max_latency_(max_latency_us) {
+    ICHECK_EQ(executors.size(), batch_sizes.size())
+        << "Every executor needs a matching batch size.";
+    ICHECK(!executors.empty()) << "The request batcher needs at least one executor.";
+    ICHECK_GE(max_latency_us, 0);
+    for (size_t i = 0; i < executors.size(); ++i) {
+      Bucket bucket;
+      bucket.batch_size = batch_sizes[i];
+      ICHECK_GT(bucket.batch_size, 0);
+      bucket.executor = executors[i];
+      InitBucket(&bucket);
+      buckets_.push_back(std::move(bucket));
+    }
+    std::sort(buckets_.begin(), buckets_.end(),
+              [](const Bucket& a, const Bucket& b) { return a.batch_size < b.batch_size; });
+    max_batch_size_ = buckets_.back().batch_size;
+    worker_ = std::thread([this]() { this->WorkerLoop(); });
+  }
+
+  ~RequestBatcher() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+  }
+
+  const char* type_key() const final { return "RequestBatcher"; }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name == "submit") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        ICHECK_EQ(args.size(), 2) << "submit expects (inputs, outputs).";
+        this->Submit(args[0].operator Array<NDArray>(), args[1].operator Array<NDArray>());
+      });
+    } else if (name == "get_statistics") {
+      return PackedFunc(
+          [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->GetStatistics(); });
+    }
+    return PackedFunc();
+  }
+
+  /*!
+   * \brief Queue one request and block until its batch has run.
+   * \param inputs The inputs of a single sample, either without the batch dimension or
+   *  with a batch dimension of 1.
+   * \param outputs The tensors that receive the sample's outputs.
+   *
+   *  The request is checked against the executors before it is queued, so that an invalid
+   *  request fails alone instead of failing the batch it would join.
+   */
+  void Submit(Array<NDArray> inputs, Array<NDArray> outputs) {
+    Request request;
+    if (IsVM()) {
+      // The VM does not expose its signature; only requests of the same shapes are batched.
+      for (const NDArray& input : inputs) {
+        request.input_specs.push_back(SampleSpec::OfSample(input.operator->(), nullptr));
+      }
+    } else {
+      CheckSamples(inputs, input_specs_, "input");
+      CheckSamples(outputs, output_specs_, "output");
+    }
+    request.inputs = std::move(inputs);
+    request.outputs = std::move(outputs);
+    request.arrival = std::chrono::steady_clock::now();
+    std::future<void> done = request.done.get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ICHECK(!stop_) << "The request batcher has been shut down.";
+      pending_.push_back(&request);
+    }
+    cv_.notify_all();
+    // Rethrows any error raised while running the batch.
+    done.get();
+  }
+
+  Map<String, ObjectRef> GetStatistics() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Map<String, ObjectRef> stats;
+    stats.Set("Batches", ObjectRef(make_object<profiling::CountNode>(num_batches_)));
+    stats.Set("Requests", ObjectRef(make_object<profiling::CountNode>(num_requests_)));
+    stats.Set("Padded Samples", ObjectRef(make_object<profiling::CountNode>(num_padded_)));
+    return stats;
+  }
+
+ private:
+  /*! \brief The shape without the batch dimension and the dtype of one sample of a tensor. */
+  struct SampleSpec {
+    std::vector<int64_t> shape;
+    DLDataType dtype;
+
+    bool operator==(const SampleSpec& other) const {
+      return shape == other.shape && dtype.code == other.dtype.code &&
+             dtype.bits == other.dtype.bits && dtype.lanes == other.dtype.lanes;
+    }
+    bool operator!=(const SampleSpec& other) const { return !(*this == other); }
+
+    /*! \brief The spec of one sample of a batched tensor. */
+    static SampleSpec OfBatched(const DLTensor* batched) {
+      return {std::vector<int64_t>(batched->shape + 1, batched->shape + batched->ndim),
+              batched->dtype};
+    }
+
+    /*!
+     * \brief The spec of a single-sample tensor, without the batch dimension or with a batch
+     *  dimension of 1.
+     * \param expected The spec of the executor, or nullptr when it is not known, in which case
+     *  a leading dimension of 1 is taken as the batch dimension.
+     */
+    static SampleSpec OfSample(const DLTensor* sample, const SampleSpec* expected) {
+      bool has_batch = sample->ndim > 0 && sample->shape[0] == 1 &&
+                       (expected == nullptr ||
+                        static_cast<size_t>(sample->ndim) == expected->shape.size() + 1);
+      int offset = has_batch ? 1 : 0;
+      return {std::vector<int64_t>(sample->shape + offset, sample->shape + sample->ndim),
+              sample->dtype};
+    }
+  };
+
+  struct Request {
+    Array<NDArray> inputs;
+    Array<NDArray> outputs;
+    /*! \brief The specs of the inputs for VMs, whose requests are batched by shape. */
+    std::vector<SampleSpec> input_specs;
+    std::chrono::steady_clock::time_point arrival;
+    std::promise<void> done;
+  };
+
+  struct Bucket {
+    int64_t batch_size;
+    Module executor;
+    /*! \brief The device holding the executor's inputs, known up front for graph executors. */
+    Device device{kDLCPU, 0};
+    /*! \brief The batched input tensors the requests are gathered into. */
+    std::vector<NDArray> staging;
+    /*! \brief The input specs \p staging was created for, for VMs. */
+    std::vector<SampleSpec> staging_specs;
+    /*! \brief Whether \p staging can be bound to the executor without a copy. */
+    bool zero_copy = false;
+  };
+
+  bool IsVM() const { return !vm_function_.empty(); }
+
+  /*! \brief Host memory used for staging, pinned when the executor lives on a CUDA device. */
+  static Device StagingDevice(Device device) {
+    if (device.device_type == kDLCUDA) {
+      Device host{kDLCUDAHost, 0};
+      if (DeviceAPI::Get(host, /*allow_missing=*/true) != nullptr) return host;
+    }
+    return Device{kDLCPU, 0};
+  }
+
+  void InitBucket(Bucket* bucket) {
+    if (IsVM()) {
+      ICHECK(bucket->executor->GetFunction("invoke", false) != nullptr)
+          << "Executors must be VirtualMachine modules when vm_function is set.";
+      // The VM does not expose its input shapes; the staging buffers are created from the
+      // shape of the first batch and copied to the VM's device by set_input.
+      return;
+    }
+    PackedFunc get_num_inputs = bucket->executor.GetFunction("get_num_inputs");
+    ICHECK(get_num_inputs != nullptr) << "Executors must be graph executor modules.";
+    PackedFunc get_input = bucket->executor.GetFunction("get_input");
+    int num_inputs = get_num_inputs();
+    std::vector<SampleSpec> input_specs;
+    for (int i = 0; i < num_inputs; ++i) {
+      NDArray input = get_input(i);
+      ICHECK_GE(input->ndim, 1) << "Input " << i << " has no batch dimension.";
+      ICHECK_EQ(input->shape[0], bucket->batch_size)
+          << "Input " << i << " does not match the batch size of its bucket.";
+      bucket->device = input->device;
+      std::vector<int64_t> shape(input->shape, input->shape + input->ndim);
+      bucket->staging.push_back(NDArray::Empty(shape, input->dtype, StagingDevice(input->device)));
+      input_specs.push_back(SampleSpec::OfBatched(input.operator->()));
+    }
+    bucket->zero_copy = bucket->device.device_type == kDLCPU;
+    PackedFunc get_output = bucket->executor.GetFunction("get_output");
+    int num_outputs = bucket->executor.GetFunction("get_num_outputs")();
+    std::vector<SampleSpec> output_specs;
+    for (int i = 0; i < num_outputs; ++i) {
+      NDArray output = get_output(i);
+      ICHECK(output->ndim >= 1 && output->shape[0] == bucket->batch_size)
+          << "Output " << i << " does not carry the batch dimension.";
+      output_specs.push_back(SampleSpec::OfBatched(output.operator->()));
+    }
+    if (buckets_.empty()) {
+      input_specs_ = std::move(input_specs);
+      output_specs_ = std::move(output_specs);
+    } else {
+      ICHECK(input_specs == input_specs_ && output_specs == output_specs_)
+          << "The executors differ in more than their batch size.";
+    }
+  }
+
+  void WorkerLoop() {
+    while (true) {
+      std::vector<Request*> batch;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return stop_ || !pending_.empty(); });
+        if (pending_.empty()) return;
+        // Wait for the batch to fill up, but no longer than the latency budget of the
+        // oldest request.
+        auto deadline = pending_.front()->arrival + max_latency_;
+        cv_.wait_until(lock, deadline, [this]() {
+          return stop_ || static_cast<int64_t>(pending_.size()) >= max_batch_size_;
+        });
+        // Only the requests of the same input shapes as the oldest one join its batch, the
+        // others wait for a later one.
+        const Request* oldest = pending_.front();
+        for (auto it = pending_.begin();
+             it != pending_.end() && static_cast<int64_t>(batch.size()) < max_batch_size_;) {
+          if ((*it)->input_specs == oldest->input_specs) {
+            batch.push_back(*it);
+            it = pending_.erase(it);
+          } else {
+            ++it;
+          }
+        }
+      }
+      // The requests whose outputs do not fit the results fail alone.
+      std::vector<std::exception_ptr> errors(batch.size());
+      try {
+        int64_t padded = RunBatch(batch, &errors);
+        std::lock_guard<std::mutex> lock(mutex_);
+        num_batches_ += 1;
+        num_requests_ += batch.size();
+        num_padded_ += padded;
+      } catch (...) {
+        for (Request* request : batch) request->done.set_exception(std::current_exception());
+        continue;
+      }
+      for (size_t i = 0; i < batch.size(); ++i) {
+        if (errors[i]) {
+          batch[i]->done.set_exception(errors[i]);
+        } else {
+          batch[i]->done.set_value();
+        }
+      }
+    }
+  }
+
+  /*! \brief Number of bytes of one sample of a batched tensor. */
+  static size_t SampleBytes(const DLTensor* batched) {
+    return GetDataSize(*batched) / static_cast<size_t>(batched->shape[0]);
+  }
+
+  /*! \brief A view of one sample of a batched tensor, shaped like \p like. */
+  static DLTensor SampleView(const DLTensor* batched, int64_t index, const DLTensor* like) {
+    DLTensor view = *batched;
+    view.ndim = like->ndim;
+    view.shape = like->shape;
+    view.strides = nullptr;
+    view.byte_offset = batched->byte_offset + index * SampleBytes(batched);
+    return view;
+  }
+
+  /*! \brief Check that single-sample tensors match the samples of the executor. */
+  static void CheckSamples(const Array<NDArray>& samples, const std::vector<SampleSpec>& specs,
+                           const char* kind) {
+    ICHECK_EQ(samples.size(), specs.size()) << "Wrong number of " << kind << "s.";
+    for (size_t i = 0; i < specs.size(); ++i) {
+      ICHECK(SampleSpec::OfSample(samples[i].operator->(), &specs[i]) == specs[i])
+          << "The shape and dtype of " << kind << " " << i << " must be the executor's, without "
+          << "the batch dimension or with a batch dimension of 1.";
+    }
+  }
+
+  /*!
+   * \brief Gather \p batch into the inputs of the smallest fitting bucket, run it, and
+   *  scatter the outputs back to the requests.
+   * \param batch The requests, whose inputs were checked when they were submitted.
+   * \param errors The error of each request whose outputs do not fit the results.
+   * \return The number of padding samples in the batch.
+   */
+  int64_t RunBatch(const std::vector<Request*>& batch, std::vector<std::exception_ptr>* errors) {
+    int64_t count = static_cast<int64_t>(batch.size());
+    Bucket& bucket = *std::find_if(buckets_.begin(), buckets_.end(),
+                                   [count](const Bucket& b) { return b.batch_size >= count; });
+    const std::vector<SampleSpec>& specs = batch[0]->input_specs;
+    if (IsVM() && bucket.staging_specs != specs) {
+      bucket.staging.clear();
+      for (const SampleSpec& spec : specs) {
+        std::vector<int64_t> shape{bucket.batch_size};
+        shape.insert(shape.end(), spec.shape.begin(), spec.shape.end());
+        bucket.staging.push_back(NDArray::Empty(shape, spec.dtype, Device{kDLCPU, 0}));
+      }
+      bucket.staging_specs = specs;
+    }
+
+    // Gather the samples into the staging buffers; the padding rows are left as they are.
+    for (size_t i = 0; i < bucket.staging.size(); ++i) {
+      const DLTensor* batched = bucket.staging[i].operator->();
+      for (int64_t row = 0; row < count; ++row) {
+        const DLTensor* sample = batch[row]->inputs[i].operator->();
+        DLTensor view = SampleView(batched, row, sample);
+        NDArray::CopyFromTo(sample, &view);
+      }
+    }
+
+    std::vector<NDArray> outputs;
+    if (IsVM()) {
+      std::vector<TVMValue> values(bucket.staging.size() + 1);
+      std::vector<int> codes(bucket.staging.size() + 1);
+      TVMArgsSetter setter(values.data(), codes.data());
+      setter(0, vm_function_);
+      for (size_t i = 0; i < bucket.staging.size(); ++i) setter(i + 1, bucket.staging[i]);
+      TVMRetValue rv;
+      bucket.executor.GetFunction("set_input").CallPacked(
+          TVMArgs(values.data(), codes.data(), values.size()), &rv);
+      ObjectRef result = bucket.executor.GetFunction("invoke")(vm_function_);
+      if (const auto* adt = result.as<ADTObj>()) {
+        for (size_t i = 0; i < adt->size; ++i) outputs.push_back(Downcast<NDArray>((*adt)[i]));
+      } else {
+        outputs.push_back(Downcast<NDArray>(result));
+      }
+    } else {
+      const char* set_input = bucket.zero_copy ? "set_input_zero_copy" : "set_input";
+      PackedFunc fset_input = bucket.executor.GetFunction(set_input);
+      for (size_t i = 0; i < bucket.staging.size(); ++i) {
+        fset_input(static_cast<int>(i), bucket.staging[i]);
+      }
+      bucket.executor.GetFunction("run")();
+      PackedFunc get_output = bucket.executor.GetFunction("get_output");
+      int num_outputs = bucket.executor.GetFunction("get_num_outputs")();
+      for (int i = 0; i < num_outputs; ++i) outputs.push_back(get_output(i));
+    }
+
+    std::vector<SampleSpec> output_specs;
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      const DLTensor* batched = outputs[i].operator->();
+      ICHECK(batched->ndim >= 1 && batched->shape[0] == bucket.batch_size)
+          << "Output " << i << " does not carry the batch dimension.";
+      output_specs.push_back(SampleSpec::OfBatched(batched));
+    }
+    // Scatter each sample's rows straight from the batched outputs to the caller's tensors.
+    for (int64_t row = 0; row < count; ++row) {
+      const Array<NDArray>& dsts = batch[row]->outputs;
+      if (IsVM()) {
+        // The outputs of a VM are only known once it ran
+        try {
+          CheckSamples(dsts, output_specs, "output");
+        } catch (...) {
+          (*errors)[row] = std::current_exception();
+          continue;
+        }
+      }
+      for (size_t i = 0; i < outputs.size(); ++i) {
+        const DLTensor* batched = outputs[i].operator->();
+        DLTensor* dst = const_cast<DLTensor*>(dsts[i].operator->());
+        DLTensor view = SampleView(batched, row, dst);
+        NDArray::CopyFromTo(&view, dst);
+      }
+    }
+    if (bucket.device.device_type != kDLCPU) {
+      DeviceAPI::Get(bucket.device)->StreamSync(bucket.device, nullptr);
+    }
+    return bucket.batch_size - count;
+  }
+
+  /*! \brief The VM function to invoke, or empty for graph executors. */
+  std::string vm_function_;
+  /*! \brief How long the oldest request may wait for the batch to fill up. */
+  std::chrono::microseconds max_latency_;
+  /*! \brief The executor buckets, sorted by increasing batch size. */
+  std::vector<Bucket> buckets_;
+  /*! \brief The specs of the inputs and outputs of the graph executors. */
+  std::vector<SampleSpec> input_specs_;
+  std::vector<SampleSpec> output_specs_;
+  int64_t max_batch_size_;
+  /*! \brief Requests waiting to be batched; owned by the blocked submitters. */
+  std::deque<Request*> pending_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_{false};
+  std::thread worker_;
+  int64_t num_batches_{0};
+  int64_t num_requests_{0};
+  int64_t num_padded_{0};
+};
+
+TVM_REGISTER_GLOBAL("tvm.runtime.RequestBatcher").set_body_typed([](Array<Module> executors,
+                                                                    ShapeTuple batch_sizes,
+                                                                    int64_t max_latency_us,
+                                                                    String vm_function) {
+  auto n = make_object<RequestBatcher>(executors, batch_sizes, max_latency_us, vm_function);
+  return Module(n);
+});
+
+}  // namespace runtime
+}  // namespace tvm
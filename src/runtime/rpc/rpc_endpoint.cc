@@ -41,6 +41,7 @@
 #include "../../support/arena.h"
 #include "../../support/ring_buffer.h"
 #include "../object_internal.h"
+#include "../trace_recorder.h"
 #include "rpc_local_session.h"
 
 namespace tvm {
@@ -649,23 +650,55 @@ RPCCode RPCEndpoint::HandleUntilReturnEvent(bool client_mode, RPCSession::FEncod
   return code;
 }
 
+/*!
+ * \brief The maximum number of requests sent without waiting whose reply is not received.
+ *  The replies queue up in the channel, bounding them keeps the remote from blocking on them.
+ */
+constexpr uint64_t kMaxPendingReplies = 64;
+
+void RPCEndpoint::FlushWriter() {
+  while (writer_.bytes_available() != 0) {
+    size_t n = writer_.ReadWithCallback(
+        [this](const void* data, size_t size) { return channel_->Send(data, size); },
+        writer_.bytes_available());
+    if (n == 0) break;
+  }
+}
+
+void RPCEndpoint::AddPendingReply() {
+  CHECK(channel_) << "Expected connection to server " << name_
+                  << " to be active, but the connection was previously closed";
+  FlushWriter();
+  ++num_pending_replies_;
+  while (num_pending_replies_ > kMaxPendingReplies) {
+    --num_pending_replies_;
+    RPCCode code = HandleUntilReturnEvent(true, [](TVMArgs) {});
+    ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
+  }
+}
+
+void RPCEndpoint::WaitPendingRepliesLocked() {
+  while (num_pending_replies_ != 0) {
+    // Count the reply first, so that an error raised by it leaves the session consistent.
+    --num_pending_replies_;
+    RPCCode code = HandleUntilReturnEvent(true, [](TVMArgs) {});
+    ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
+  }
+}
+
+void RPCEndpoint::WaitPendingReplies() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  WaitPendingRepliesLocked();
+}
+
 void RPCEndpoint::Init() {
   // callback to flush the writer.
-  auto flush_writer = [this]() {
-    while (writer_.bytes_available() != 0) {
-      size_t n = writer_.ReadWithCallback(
-          [this](const void* data, size_t size) { return channel_->Send(data, size); },
-          writer_.bytes_available());
-      if (n == 0) break;
-    }
-  };
+  auto flush_writer = [this]() { this->FlushWriter(); };
 
   // Event handler
   handler_ = std::make_shared<EventHandler>(&reader_, &writer_, name_, &remote_key_, flush_writer);
 
-  // Quick function to for syscall remote.
-  syscall_remote_ = PackedFunc([this](TVMArgs all_args, TVMRetValue* rv) {
-    std::lock_guard<std::mutex> lock(mutex_);
+  auto write_syscall = [this](TVMArgs all_args) {
     RPCCode code = static_cast<RPCCode>(all_args[0].operator int());
     TVMArgs args(all_args.values + 1, all_args.type_codes + 1, all_args.num_args - 1);
 
@@ -676,13 +709,28 @@ void RPCEndpoint::Init() {
     handler_->Write(packet_nbytes);
     handler_->Write(code);
     handler_->SendPackedSeq(args.values, args.type_codes, args.num_args, true);
+  };
+
+  // Quick function to for syscall remote.
+  syscall_remote_ = PackedFunc([this, write_syscall](TVMArgs all_args, TVMRetValue* rv) {
+    profiling::TraceScope trace(
+        "rpc", RPCCodeToString(static_cast<RPCCode>(all_args[0].operator int())));
+    std::lock_guard<std::mutex> lock(mutex_);
+    WaitPendingRepliesLocked();
+    write_syscall(all_args);
 
-    code = HandleUntilReturnEvent(true, [rv](TVMArgs args) {
+    RPCCode code = HandleUntilReturnEvent(true, [rv](TVMArgs args) {
       ICHECK_EQ(args.size(), 1);
       *rv = args[0];
     });
     ICHECK(code == RPCCode::kReturn) << "code=" << static_cast<int>(code);
   });
+
+  syscall_remote_no_wait_ = PackedFunc([this, write_syscall](TVMArgs all_args, TVMRetValue* rv) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    write_syscall(all_args);
+    AddPendingReply();
+  });
 }
 
 /*!
@@ -762,6 +810,7 @@ int RPCEndpoint::ServerAsyncIOEventHandler(const std::string& in_bytes, int even
 
 void RPCEndpoint::InitRemoteSession(TVMArgs args) {
   std::lock_guard<std::mutex> lock(mutex_);
+  WaitPendingRepliesLocked();
   RPCCode code = RPCCode::kInitServer;
   std::string protocol_ver = kRPCProtocolVer;
   uint64_t length = protocol_ver.length();
@@ -785,7 +834,9 @@ void RPCEndpoint::InitRemoteSession(TVMArgs args) {
 void RPCEndpoint::CallFunc(RPCSession::PackedFuncHandle h, const TVMValue* arg_values,
                            const int* arg_type_codes, int num_args,
                            RPCSession::FEncodeReturn encode_return) {
+  profiling::TraceScope trace("rpc", "CallFunc");
   std::lock_guard<std::mutex> lock(mutex_);
+  WaitPendingRepliesLocked();
 
   handler_->ValidateArguments(arg_values, arg_type_codes, num_args);
   RPCCode code = RPCCode::kCallFunc;
@@ -804,8 +855,7 @@ void RPCEndpoint::CallFunc(RPCSession::PackedFuncHandle h, const TVMValue* arg_v
   ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
 }
 
-void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes) {
-  std::lock_guard<std::mutex> lock(mutex_);
+void RPCEndpoint::WriteCopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes) {
   RPCCode code = RPCCode::kCopyToRemote;
 
   uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*to));
@@ -821,11 +871,26 @@ void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes)
   RPCReference::SendDLTensor(handler_, to);
   handler_->Write(nbytes);
   handler_->WriteArray(reinterpret_cast<char*>(from_bytes), nbytes);
+}
+
+void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes) {
+  profiling::TraceScope trace("rpc", "CopyToRemote");
+  std::lock_guard<std::mutex> lock(mutex_);
+  WaitPendingRepliesLocked();
+  WriteCopyToRemote(from_bytes, to, nbytes);
   ICHECK(HandleUntilReturnEvent(true, [](TVMArgs) {}) == RPCCode::kReturn);
 }
 
+void RPCEndpoint::CopyToRemoteNoWait(void* from_bytes, DLTensor* to, uint64_t nbytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  WriteCopyToRemote(from_bytes, to, nbytes);
+  AddPendingReply();
+}
+
 void RPCEndpoint::CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes) {
+  profiling::TraceScope trace("rpc", "CopyFromRemote");
   std::lock_guard<std::mutex> lock(mutex_);
+  WaitPendingRepliesLocked();
   RPCCode code = RPCCode::kCopyFromRemote;
 
   uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*from));
@@ -1017,16 +1082,31 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
     uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(remote_to, code, nbytes);
     uint64_t rpc_max_size = GetRPCMaxTransferSize();
     ICHECK_GT(rpc_max_size, overhead) << "CopyToRemote: Invalid block size!";
+    // A microTVM device that streams the body of a copy to its CPU memory takes it in one packet
+    if (!CanPipeline() && nbytes > rpc_max_size - overhead && CanStreamCopyToRemote(remote_to)) {
+      endpoint_->CopyToRemote(local_from_bytes, remote_to, nbytes);
+      return;
+    }
     const uint64_t block_size = rpc_max_size - overhead;
     uint64_t block_count = 0;
     const uint64_t num_blocks = nbytes / block_size;
     void* from_bytes;
 
+    // Without a packet size limit, the remote is not a microTVM device with a small receive
+    // buffer: the copies are pipelined, and their completion is awaited by the next request.
+    auto copy = [this](void* from_bytes, DLTensor* remote_to, uint64_t nbytes) {
+      if (CanPipeline()) {
+        endpoint_->CopyToRemoteNoWait(from_bytes, remote_to, nbytes);
+      } else {
+        endpoint_->CopyToRemote(from_bytes, remote_to, nbytes);
+      }
+    };
+
     for (block_count = 0; block_count < num_blocks; block_count++) {
       remote_to->byte_offset = block_count * block_size;
       from_bytes = reinterpret_cast<void*>(
           (reinterpret_cast<uint8_t*>(local_from_bytes) + block_count * block_size));
-      endpoint_->CopyToRemote(from_bytes, remote_to, block_size);
+      copy(from_bytes, remote_to, block_size);
     }
 
     const uint64_t remainder_bytes = nbytes % block_size;
@@ -1034,7 +1114,7 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
       remote_to->byte_offset = block_count * block_size;
       from_bytes = reinterpret_cast<void*>(
           (reinterpret_cast<uint8_t*>(local_from_bytes) + block_count * block_size));
-      endpoint_->CopyToRemote(from_bytes, remote_to, remainder_bytes);
+      copy(from_bytes, remote_to, remainder_bytes);
     }
   }
 
@@ -1065,7 +1145,11 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
   }
 
   void FreeHandle(void* handle, int type_code) final {
-    endpoint_->SysCallRemote(RPCCode::kFreeHandle, handle, type_code);
+    if (CanPipeline()) {
+      endpoint_->SysCallRemoteNoWait(RPCCode::kFreeHandle, handle, type_code);
+    } else {
+      endpoint_->SysCallRemote(RPCCode::kFreeHandle, handle, type_code);
+    }
   }
 
   void SetDevice(Device dev) final { endpoint_->SysCallRemote(RPCCode::kDevSetDevice, dev); }
@@ -1102,7 +1186,11 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
   }
 
   void FreeDataSpace(Device dev, void* ptr) final {
-    endpoint_->SysCallRemote(RPCCode::kDevFreeData, dev, ptr);
+    if (CanPipeline()) {
+      endpoint_->SysCallRemoteNoWait(RPCCode::kDevFreeData, dev, ptr);
+    } else {
+      endpoint_->SysCallRemote(RPCCode::kDevFreeData, dev, ptr);
+    }
   }
 
   void CopyDataFromTo(DLTensor* from, DLTensor* to, TVMStreamHandle stream) final {
@@ -1133,28 +1221,60 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
 
  private:
   uint64_t GetRPCMaxTransferSize() {
-    if (rpc_chunk_max_size_bytes_ > 0) {
-      return (uint64_t)rpc_chunk_max_size_bytes_;
+    if (rpc_chunk_max_size_bytes_ != 0) {
+      return rpc_chunk_max_size_bytes_;
     }
 
     PackedFuncHandle rpc_func = GetFunction("tvm.rpc.server.GetCRTMaxPacketSize");
     if (rpc_func == nullptr) {
-      rpc_chunk_max_size_bytes_ = (int64_t)kRPCMaxTransferSizeBytesDefault;
+      rpc_chunk_max_size_bytes_ = kRPCMaxTransferSizeBytesDefault;
     } else {
       CallFunc(rpc_func, nullptr, nullptr, 0, [this](TVMArgs args) {
         // Use args[1] as return value, args[0] is tcode
         // Look at RPCWrappedFunc in src/runtime/rpc/rpc_module.cc
-        rpc_chunk_max_size_bytes_ = (int64_t)args[1];
-        ICHECK_GT(rpc_chunk_max_size_bytes_, 0)
-            << "RPC max transfer size is <= 0! (remote value = " << rpc_chunk_max_size_bytes_
-            << ")";
+        int64_t max_size = args[1];
+        ICHECK_GT(max_size, 0) << "RPC max transfer size is <= 0! (remote value = " << max_size
+                               << ")";
+        rpc_chunk_max_size_bytes_ = static_cast<uint64_t>(max_size);
       });
     }
-    return (uint64_t)rpc_chunk_max_size_bytes_;
+    return rpc_chunk_max_size_bytes_;
   }
 
+  /*!
+   * \brief Whether the remote can receive a copy to a tensor larger than its packet size limit.
+   * \param remote_to The destination tensor.
+   */
+  bool CanStreamCopyToRemote(const DLTensor* remote_to) {
+    // The kMaxStreamedCopyNdim of the microTVM RPC server
+    constexpr int kMaxStreamedCopyNdim = 8;
+    if (remote_to->device.device_type != kDLCPU || remote_to->ndim > kMaxStreamedCopyNdim) {
+      return false;
+    }
+    if (can_stream_copy_to_remote_ < 0) {
+      PackedFuncHandle rpc_func = GetFunction("tvm.rpc.server.CanStreamCopyToRemote");
+      can_stream_copy_to_remote_ = 0;
+      if (rpc_func != nullptr) {
+        CallFunc(rpc_func, nullptr, nullptr, 0, [this](TVMArgs args) {
+          int64_t can_stream = args[1];
+          can_stream_copy_to_remote_ = can_stream != 0;
+        });
+      }
+    }
+    return can_stream_copy_to_remote_ == 1;
+  }
+
+  /*!
+   * \brief Whether requests whose result is not needed can be sent without waiting.
+   *  Only known after the first copy asked the remote for its packet size limit.
+   */
+  bool CanPipeline() const { return rpc_chunk_max_size_bytes_ == kRPCMaxTransferSizeBytesDefault; }
+
   std::shared_ptr<RPCEndpoint> endpoint_;
-  int64_t rpc_chunk_max_size_bytes_ = -1;
+  /*! \brief The packet size limit of the remote, 0 until it is known. */
+  uint64_t rpc_chunk_max_size_bytes_ = 0;
+  /*! \brief Whether the remote streams the copies to its CPU memory, -1 until it is known. */
+  int can_stream_copy_to_remote_ = -1;
 };
 
 std::shared_ptr<RPCSession> CreateClientSession(std::shared_ptr<RPCEndpoint> endpoint) {
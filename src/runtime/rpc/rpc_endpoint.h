@@ -59,7 +59,8 @@ enum class TrackerCode : int {
   kRequest = 4,
   kUpdateInfo = 5,
   kSummary = 6,
-  kGetPendingMatchKeys = 7
+  kGetPendingMatchKeys = 7,
+  kReportStats = 8
 };
 
 /*!
@@ -162,6 +163,18 @@ class RPCEndpoint {
    * \param type_hint Hint of content data type.
    */
   void CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes);
+  /*!
+   * \brief Send a copy into a remote array without waiting for its completion.
+   *
+   *  The remote handles the requests of the session in order. The reply to the copy is awaited
+   *  by the next request which needs a reply, or by WaitPendingReplies, where its error is raised.
+   * \param from_bytes The source host data, which can be reused when the function returns.
+   * \param to The target array.
+   * \param nbytes The size of the memory in bytes.
+   */
+  void CopyToRemoteNoWait(void* from_bytes, DLTensor* to, uint64_t nbytes);
+  /*! \brief Wait for the replies to the requests sent without waiting. */
+  void WaitPendingReplies();
 
   /*!
    * \brief Call a remote defined system function with arguments.
@@ -171,6 +184,14 @@ class RPCEndpoint {
    */
   template <typename... Args>
   inline TVMRetValue SysCallRemote(RPCCode fcode, Args&&... args);
+  /*!
+   * \brief Call a remote system function whose result is not needed, without waiting for it.
+   * \param fcode The function code.
+   * \param args The arguments
+   * \sa CopyToRemoteNoWait
+   */
+  template <typename... Args>
+  inline void SysCallRemoteNoWait(RPCCode fcode, Args&&... args);
   /*!
    * \brief Create a RPC session with given channel.
    * \param channel The communication channel.
@@ -191,6 +212,14 @@ class RPCEndpoint {
   RPCCode HandleUntilReturnEvent(bool client_mode, RPCSession::FEncodeReturn setreturn);
   // Initalization
   void Init();
+  // Write a CopyToRemote request.
+  void WriteCopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes);
+  // Push the buffered requests to the channel.
+  void FlushWriter();
+  // Count a request sent without waiting, and bound the number of them in flight.
+  void AddPendingReply();
+  // Wait for the replies to the requests sent without waiting, with mutex_ held.
+  void WaitPendingRepliesLocked();
   // Internal channel.
   std::unique_ptr<RPCChannel> channel_;
 
@@ -202,6 +231,10 @@ class RPCEndpoint {
   std::shared_ptr<EventHandler> handler_;
   // syscall remote with specified function code.
   PackedFunc syscall_remote_;
+  // syscall remote which does not wait for the reply.
+  PackedFunc syscall_remote_no_wait_;
+  // The number of requests whose reply has not been received.
+  uint64_t num_pending_replies_{0};
   // The name of the session.
   std::string name_;
   // The remote key
@@ -223,6 +256,11 @@ inline TVMRetValue RPCEndpoint::SysCallRemote(RPCCode code, Args&&... args) {
   return syscall_remote_(static_cast<int>(code), std::forward<Args>(args)...);
 }
 
+template <typename... Args>
+inline void RPCEndpoint::SysCallRemoteNoWait(RPCCode code, Args&&... args) {
+  syscall_remote_no_wait_(static_cast<int>(code), std::forward<Args>(args)...);
+}
+
 /*!
  * \brief Calculates overhead size of a CopyToRemote packet.
  * \param to DLTensor to copy.
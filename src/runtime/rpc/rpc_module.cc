@@ -29,7 +29,9 @@
 #include <chrono>
 #include <cstring>
 #include <memory>
+#include <sstream>
 #include <thread>
+#include <unordered_map>
 #if defined(_M_X64) || defined(__x86_64__)
 #include <immintrin.h>
 #endif
@@ -218,6 +220,35 @@ class RPCModuleNode final : public ModuleNode {
     }
   }
 
+  PackedFunc GetAdaptiveTimeEvaluator(const std::string& names, Device dev, int number,
+                                      int min_repeat, int max_repeat, int min_repeat_ms,
+                                      double max_rel_ci, double outlier_threshold,
+                                      int cooldown_interval_ms,
+                                      const std::string& f_preproc_name) {
+    InitRemoteFunc(&remote_get_adaptive_time_evaluator_, "runtime.RPCAdaptiveTimeEvaluator");
+    ICHECK_EQ(GetRPCSessionIndex(dev), sess_->table_index())
+        << "ValueError: Need to pass the matched remote device to RPCModule.GetTimeEvaluator";
+    dev = RemoveRPCSessionMask(dev);
+    Optional<Module> mod = module_handle_ != nullptr ? Optional<Module>(GetRef<Module>(this))
+                                                     : Optional<Module>(nullptr);
+    return remote_get_adaptive_time_evaluator_(
+        mod, names, static_cast<int>(dev.device_type), dev.device_id, number, min_repeat,
+        max_repeat, min_repeat_ms, max_rel_ci, outlier_threshold, cooldown_interval_ms,
+        f_preproc_name);
+  }
+
+  PackedFunc GetBatchedTimeEvaluator(const std::string& name, Device dev, int number, int repeat,
+                                     const std::string& f_preproc_name) {
+    InitRemoteFunc(&remote_get_batched_time_evaluator_, "runtime.RPCBatchedTimeEvaluator");
+    ICHECK_EQ(GetRPCSessionIndex(dev), sess_->table_index())
+        << "ValueError: Need to pass the matched remote device to RPCModule.GetTimeEvaluator";
+    dev = RemoveRPCSessionMask(dev);
+    Optional<Module> mod = module_handle_ != nullptr ? Optional<Module>(GetRef<Module>(this))
+                                                     : Optional<Module>(nullptr);
+    return remote_get_batched_time_evaluator_(mod, name, static_cast<int>(dev.device_type),
+                                              dev.device_id, number, repeat, f_preproc_name);
+  }
+
   Module LoadModule(std::string name) {
     InitRemoteFunc(&remote_load_module_, "tvm.rpc.server.load_module");
     return remote_load_module_(name);
@@ -255,6 +286,13 @@ class RPCModuleNode final : public ModuleNode {
   TypedPackedFunc<PackedFunc(Optional<Module>, std::string, int, int, int, int, int, int, int, int,
                              std::string)>
       remote_get_time_evaluator_;
+  // remote function to get adaptive time evaluator
+  TypedPackedFunc<PackedFunc(Optional<Module>, std::string, int, int, int, int, int, int, double,
+                             double, int, std::string)>
+      remote_get_adaptive_time_evaluator_;
+  // remote function to get batched time evaluator
+  TypedPackedFunc<PackedFunc(Optional<Module>, std::string, int, int, int, int, std::string)>
+      remote_get_batched_time_evaluator_;
   // remote function getter for modules.
   TypedPackedFunc<PackedFunc(Module, std::string, bool)> remote_mod_get_function_;
   // remote function getter for load module
@@ -415,10 +453,124 @@ TVM_REGISTER_GLOBAL("runtime.RPCTimeEvaluator")
       }
     });
 
+TVM_REGISTER_GLOBAL("runtime.RPCAdaptiveTimeEvaluator")
+    .set_body_typed([](Optional<Module> opt_mod, std::string names, int device_type,
+                       int device_id, int number, int min_repeat, int max_repeat,
+                       int min_repeat_ms, double max_rel_ci, double outlier_threshold,
+                       int cooldown_interval_ms, std::string f_preproc_name) {
+      Device dev;
+      dev.device_type = static_cast<DLDeviceType>(device_type);
+      dev.device_id = device_id;
+      if (opt_mod.defined() && std::string(opt_mod.value()->type_key()) == "rpc") {
+        return static_cast<RPCModuleNode*>(opt_mod.value().operator->())
+            ->GetAdaptiveTimeEvaluator(names, dev, number, min_repeat, max_repeat, min_repeat_ms,
+                                       max_rel_ci, outlier_threshold, cooldown_interval_ms,
+                                       f_preproc_name);
+      }
+      PackedFunc f_preproc;
+      if (!f_preproc_name.empty()) {
+        auto* pf_preproc = runtime::Registry::Get(f_preproc_name);
+        ICHECK(pf_preproc != nullptr)
+            << "Cannot find " << f_preproc_name << " in the global function";
+        f_preproc = *pf_preproc;
+      }
+      // the candidates are passed as a comma separated list to go through RPC.
+      std::vector<PackedFunc> fs;
+      std::istringstream is(names);
+      for (std::string name; std::getline(is, name, ',');) {
+        if (opt_mod.defined()) {
+          PackedFunc pf = opt_mod.value().GetFunction(name, true);
+          CHECK(pf != nullptr) << "Cannot find " << name << " in the module";
+          fs.push_back(pf);
+        } else {
+          auto* pf = runtime::Registry::Get(name);
+          ICHECK(pf != nullptr) << "Cannot find " << name << " in the global function";
+          fs.push_back(*pf);
+        }
+      }
+      return profiling::WrapAdaptiveTimeEvaluator(fs, dev, number, min_repeat, max_repeat,
+                                                  min_repeat_ms, max_rel_ci, outlier_threshold,
+                                                  cooldown_interval_ms, f_preproc);
+    });
+
+TVM_REGISTER_GLOBAL("runtime.RPCBatchedTimeEvaluator")
+    .set_body_typed([](Optional<Module> opt_mod, std::string name, int device_type,
+                       int device_id, int number, int repeat, std::string f_preproc_name) {
+      Device dev;
+      dev.device_type = static_cast<DLDeviceType>(device_type);
+      dev.device_id = device_id;
+      if (opt_mod.defined() && std::string(opt_mod.value()->type_key()) == "rpc") {
+        return static_cast<RPCModuleNode*>(opt_mod.value().operator->())
+            ->GetBatchedTimeEvaluator(name, dev, number, repeat, f_preproc_name);
+      }
+      PackedFunc f_preproc;
+      if (!f_preproc_name.empty()) {
+        auto* pf_preproc = runtime::Registry::Get(f_preproc_name);
+        ICHECK(pf_preproc != nullptr)
+            << "Cannot find " << f_preproc_name << " in the global function";
+        f_preproc = *pf_preproc;
+      }
+      PackedFunc pf;
+      if (opt_mod.defined()) {
+        pf = opt_mod.value().GetFunction(name, true);
+        CHECK(pf != nullptr) << "Cannot find " << name << " in the module";
+      } else {
+        auto* f = runtime::Registry::Get(name);
+        ICHECK(f != nullptr) << "Cannot find " << name << " in the global function";
+        pf = *f;
+      }
+      return profiling::WrapBatchedTimeEvaluator(pf, dev, number, repeat, f_preproc);
+    });
+
 TVM_REGISTER_GLOBAL("cache_flush_cpu_non_first_arg").set_body([](TVMArgs args, TVMRetValue* rv) {
   CPUCacheFlush(1, args);
 });
 
+/*! \brief The bytes copied to flush a device cache, larger than the L2 of the current GPUs. */
+constexpr int64_t kDeviceCacheFlushBytes = 64 << 20;
+
+/*!
+ * \brief Flush the cache of the device of the tensor arguments.
+ *
+ * The CPU arguments but the first are flushed as in cache_flush_cpu_non_first_arg. On CUDA the
+ * L2 is overwritten with l2_cache_flush_cuda, on the other devices by a device to device copy of
+ * kDeviceCacheFlushBytes. The flush is synchronized, so that it is not timed with the next repeat.
+ */
+inline void DeviceCacheFlush(const TVMArgs& args) {
+  const DLTensor* tensor = nullptr;
+  for (int i = 0; i < args.size() && tensor == nullptr; ++i) {
+    if (args.type_codes[i] == kTVMDLTensorHandle || args.type_codes[i] == kTVMNDArrayHandle) {
+      tensor = args[i].operator DLTensor*();
+    }
+  }
+  if (tensor == nullptr) {
+    return;
+  }
+  Device dev = tensor->device;
+  if (dev.device_type == kDLCPU) {
+    CPUCacheFlush(1, args);
+    return;
+  }
+  const PackedFunc* l2_flush_cuda = Registry::Get("l2_cache_flush_cuda");
+  if (dev.device_type == kDLCUDA && l2_flush_cuda != nullptr) {
+    (*l2_flush_cuda)();
+  } else {
+    // The scratch buffers live as long as the thread, it runs all the repeats on the device.
+    static thread_local std::unordered_map<int64_t, std::pair<NDArray, NDArray>> scratch;
+    auto& buffers = scratch[(static_cast<int64_t>(dev.device_type) << 32) | dev.device_id];
+    if (!buffers.first.defined()) {
+      buffers.first = NDArray::Empty({kDeviceCacheFlushBytes}, DataType::UInt(8), dev);
+      buffers.second = NDArray::Empty({kDeviceCacheFlushBytes}, DataType::UInt(8), dev);
+    }
+    buffers.second.CopyFrom(buffers.first);
+  }
+  DeviceAPI::Get(dev)->StreamSync(dev, nullptr);
+}
+
+TVM_REGISTER_GLOBAL("cache_flush_device").set_body([](TVMArgs args, TVMRetValue* rv) {
+  DeviceCacheFlush(args);
+});
+
 // server function registration.
 TVM_REGISTER_GLOBAL("tvm.rpc.server.ImportModule").set_body_typed([](Module parent, Module child) {
   parent->Import(child);
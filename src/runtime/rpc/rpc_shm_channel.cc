@@ -0,0 +1,256 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file rpc_shm_channel.cc
+ * \brief Shared-memory transport for RPC peers on the same host.
+ */
+#include "rpc_shm_channel.h"
+
+#include <tvm/runtime/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <random>
+#include <utility>
+
+// posix_fallocate, which keeps a full tmpfs from raising SIGBUS in the peers, is not on macOS
+#if defined(__linux__) && !defined(__ANDROID__)
+#define TVM_RPC_USE_SHM 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tvm {
+namespace runtime {
+
+/*! \brief A single-producer single-consumer byte ring; head and tail only grow. */
+struct SharedMemoryChannel::Ring {
+  alignas(64) std::atomic<uint64_t> head;
+  alignas(64) std::atomic<uint64_t> tail;
+};
+
+/*! \brief The header of the region, followed by the data of the two rings. */
+struct SharedMemoryChannel::RegionHeader {
+  /*! \brief A random value the responder checks to make sure it mapped the right region. */
+  uint64_t nonce;
+  uint64_t ring_bytes;
+  /*! \brief The ring from the initiator to the responder, then the other way. */
+  Ring rings[2];
+};
+
+namespace {
+/*! \brief The frame header: the payload size, and whether the payload is in the region. */
+uint64_t EncodeFrame(uint64_t size, bool in_region) { return (size << 1) | (in_region ? 1 : 0); }
+}  // namespace
+
+SharedMemoryChannel::SharedMemoryChannel(std::unique_ptr<RPCChannel> base, bool initiator,
+                                         size_t ring_bytes)
+    : base_(std::move(base)) {
+  if (initiator) {
+    Initiate(ring_bytes);
+  } else {
+    Respond();
+  }
+}
+
+SharedMemoryChannel::~SharedMemoryChannel() {
+#ifdef TVM_RPC_USE_SHM
+  if (region_ != nullptr) munmap(region_, region_bytes_);
+#endif
+}
+
+bool SharedMemoryChannel::SendAll(const void* data, size_t size) {
+  const char* ptr = static_cast<const char*>(data);
+  while (size != 0) {
+    size_t n = base_->Send(ptr, size);
+    if (n == 0) return false;
+    ptr += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool SharedMemoryChannel::RecvAll(void* data, size_t size) {
+  char* ptr = static_cast<char*>(data);
+  while (size != 0) {
+    size_t n = base_->Recv(ptr, size);
+    if (n == 0) return false;
+    ptr += n;
+    size -= n;
+  }
+  return true;
+}
+
+void SharedMemoryChannel::MapRegion(int fd, size_t region_bytes) {
+#ifdef TVM_RPC_USE_SHM
+  void* region = mmap(nullptr, region_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (region == MAP_FAILED) return;
+  region_ = region;
+  region_bytes_ = region_bytes;
+#endif
+}
+
+void SharedMemoryChannel::Initiate(size_t ring_bytes) {
+  std::random_device device;
+  uint64_t nonce = (static_cast<uint64_t>(device()) << 32) | device();
+  std::string name;
+  size_t region_bytes = sizeof(RegionHeader) + 2 * ring_bytes;
+#ifdef TVM_RPC_USE_SHM
+  name = "/tvm-rpc-" + std::to_string(getpid()) + "-" + std::to_string(nonce);
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd >= 0) {
+    // Reserve the pages up front, the peers would get SIGBUS writing past a full tmpfs.
+    if (ftruncate(fd, region_bytes) == 0 && posix_fallocate(fd, 0, region_bytes) == 0) {
+      MapRegion(fd, region_bytes);
+    }
+    close(fd);
+  }
+  if (region_ == nullptr) {
+    if (fd >= 0) shm_unlink(name.c_str());
+    LOG(WARNING) << "Cannot create a shared memory region of " << region_bytes
+                 << " bytes, the RPC payloads are sent inline";
+    name.clear();
+  } else {
+    RegionHeader* header = new (region_) RegionHeader();
+    header->nonce = nonce;
+    header->ring_bytes = ring_bytes;
+    for (Ring& ring : header->rings) {
+      ring.head.store(0);
+      ring.tail.store(0);
+    }
+  }
+#endif
+  // An empty name tells the responder there is no region.
+  uint64_t name_bytes = name.size();
+  ICHECK(SendAll(&name_bytes, sizeof(name_bytes)) && SendAll(name.data(), name.size()) &&
+         SendAll(&nonce, sizeof(nonce)))
+      << "SharedMemoryChannel: connection closed during negotiation";
+  uint8_t mapped = 0;
+  ICHECK(RecvAll(&mapped, sizeof(mapped)))
+      << "SharedMemoryChannel: connection closed during negotiation";
+#ifdef TVM_RPC_USE_SHM
+  // The region stays mapped on both sides, no other process needs to open it.
+  if (!name.empty()) shm_unlink(name.c_str());
+  if (region_ != nullptr && !mapped) {
+    munmap(region_, region_bytes_);
+    region_ = nullptr;
+  }
+#endif
+  if (region_ == nullptr) return;
+  RegionHeader* header = static_cast<RegionHeader*>(region_);
+  ring_bytes_ = ring_bytes;
+  out_ring_ = &header->rings[0];
+  in_ring_ = &header->rings[1];
+  out_data_ = static_cast<char*>(region_) + sizeof(RegionHeader);
+  in_data_ = out_data_ + ring_bytes;
+}
+
+void SharedMemoryChannel::Respond() {
+  uint64_t name_bytes = 0;
+  uint64_t nonce = 0;
+  std::string name;
+  ICHECK(RecvAll(&name_bytes, sizeof(name_bytes)))
+      << "SharedMemoryChannel: connection closed during negotiation";
+  name.resize(name_bytes);
+  ICHECK(RecvAll(&name[0], name.size()) && RecvAll(&nonce, sizeof(nonce)))
+      << "SharedMemoryChannel: connection closed during negotiation";
+#ifdef TVM_RPC_USE_SHM
+  if (!name.empty()) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    struct stat st;
+    if (fd >= 0) {
+      if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(RegionHeader)) {
+        MapRegion(fd, st.st_size);
+      }
+      close(fd);
+    }
+    // A region of the same name on another host is not the one of the initiator.
+    if (region_ != nullptr) {
+      RegionHeader* header = static_cast<RegionHeader*>(region_);
+      if (header->nonce != nonce ||
+          sizeof(RegionHeader) + 2 * header->ring_bytes != region_bytes_) {
+        munmap(region_, region_bytes_);
+        region_ = nullptr;
+      }
+    }
+  }
+#endif
+  uint8_t mapped = region_ != nullptr;
+  ICHECK(SendAll(&mapped, sizeof(mapped)))
+      << "SharedMemoryChannel: connection closed during negotiation";
+  if (region_ == nullptr) return;
+  RegionHeader* header = static_cast<RegionHeader*>(region_);
+  ring_bytes_ = header->ring_bytes;
+  out_ring_ = &header->rings[1];
+  in_ring_ = &header->rings[0];
+  in_data_ = static_cast<char*>(region_) + sizeof(RegionHeader);
+  out_data_ = in_data_ + ring_bytes_;
+}
+
+size_t SharedMemoryChannel::Send(const void* data, size_t size) {
+  if (region_ != nullptr && size >= kMinRegionBytes) {
+    uint64_t head = out_ring_->head.load(std::memory_order_relaxed);
+    uint64_t tail = out_ring_->tail.load(std::memory_order_acquire);
+    uint64_t offset = head % ring_bytes_;
+    // A frame never wraps around the end of the ring.
+    uint64_t n = std::min<uint64_t>({size, ring_bytes_ - (head - tail), ring_bytes_ - offset});
+    if (n >= kMinRegionBytes) {
+      std::memcpy(out_data_ + offset, data, n);
+      out_ring_->head.store(head + n, std::memory_order_release);
+      uint64_t frame = EncodeFrame(n, true);
+      if (!SendAll(&frame, sizeof(frame))) return 0;
+      return n;
+    }
+  }
+  uint64_t frame = EncodeFrame(size, false);
+  if (!SendAll(&frame, sizeof(frame)) || !SendAll(data, size)) return 0;
+  return size;
+}
+
+size_t SharedMemoryChannel::Recv(void* data, size_t size) {
+  if (frame_remaining_ == 0) {
+    uint64_t frame;
+    if (!RecvAll(&frame, sizeof(frame))) return 0;
+    frame_remaining_ = frame >> 1;
+    frame_in_region_ = frame & 1;
+  }
+  size_t n = std::min<uint64_t>(size, frame_remaining_);
+  if (frame_in_region_) {
+    ICHECK(region_ != nullptr) << "SharedMemoryChannel: peer sent a frame without a region";
+    // Pairs with the release of the head by the sender.
+    uint64_t head = in_ring_->head.load(std::memory_order_acquire);
+    uint64_t tail = in_ring_->tail.load(std::memory_order_relaxed);
+    ICHECK_LE(tail + n, head) << "SharedMemoryChannel: the ring is corrupted";
+    std::memcpy(data, in_data_ + tail % ring_bytes_, n);
+    in_ring_->tail.store(tail + n, std::memory_order_release);
+  } else {
+    n = base_->Recv(data, n);
+    if (n == 0) return 0;
+  }
+  frame_remaining_ -= n;
+  return n;
+}
+
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,94 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file rpc_shm_channel.h
+ * \brief An RPCChannel moving large payloads through shared memory between same-host peers.
+ */
+#ifndef TVM_RUNTIME_RPC_RPC_SHM_CHANNEL_H_
+#define TVM_RUNTIME_RPC_RPC_SHM_CHANNEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "rpc_channel.h"
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief A channel wrapping another channel, which negotiates a shared-memory region with the
+ *  peer and moves the large payloads through it.
+ *
+ *  Every send is framed on the wrapped channel. Payloads of at least kMinRegionBytes are copied
+ *  into a ring in the region and only their frame header travels on the wrapped channel, so they
+ *  do not go through the socket or pipe. Smaller payloads, and those that do not fit the free
+ *  space of the ring, are sent inline. When the peer cannot map the region, e.g. because it runs
+ *  on another host, every payload is sent inline. Both peers must wrap their channel.
+ */
+class SharedMemoryChannel final : public RPCChannel {
+ public:
+  /*! \brief The default capacity of the ring of each direction. */
+  static constexpr size_t kDefaultRingBytes = 16 << 20;
+  /*! \brief The smallest payload moved through the region. */
+  static constexpr size_t kMinRegionBytes = 16 << 10;
+  /*!
+   * \brief Wrap a channel and negotiate the region with the peer.
+   * \param base The wrapped channel.
+   * \param initiator Whether this peer creates the region, exactly one of the peers does.
+   * \param ring_bytes The capacity of the ring of each direction, used by the initiator.
+   */
+  SharedMemoryChannel(std::unique_ptr<RPCChannel> base, bool initiator,
+                      size_t ring_bytes = kDefaultRingBytes);
+  ~SharedMemoryChannel();
+  size_t Send(const void* data, size_t size) final;
+  size_t Recv(void* data, size_t size) final;
+  /*! \return Whether the region was negotiated with the peer. */
+  bool HasRegion() const { return region_ != nullptr; }
+
+ private:
+  struct Ring;
+  struct RegionHeader;
+  /*! \brief Send or receive exactly size bytes on the wrapped channel. */
+  bool SendAll(const void* data, size_t size);
+  bool RecvAll(void* data, size_t size);
+  void Initiate(size_t ring_bytes);
+  void Respond();
+  void MapRegion(int fd, size_t region_bytes);
+
+  std::unique_ptr<RPCChannel> base_;
+  /*! \brief The mapped region, null when payloads are sent inline. */
+  void* region_{nullptr};
+  size_t region_bytes_{0};
+  /*! \brief The rings written and read by this peer, and their data. */
+  Ring* out_ring_{nullptr};
+  Ring* in_ring_{nullptr};
+  char* out_data_{nullptr};
+  char* in_data_{nullptr};
+  uint64_t ring_bytes_{0};
+  /*! \brief The bytes left in the frame being received, and whether they are in the region. */
+  uint64_t frame_remaining_{0};
+  bool frame_in_region_{false};
+};
+
+}  // namespace runtime
+}  // namespace tvm
+#endif  // TVM_RUNTIME_RPC_RPC_SHM_CHANNEL_H_
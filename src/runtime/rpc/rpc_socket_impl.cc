@@ -24,11 +24,15 @@
 #include <tvm/runtime/registry.h>
 
 #include <memory>
+#include <sstream>
+#include <string>
 
 #include "../../support/socket.h"
 #include "rpc_endpoint.h"
 #include "rpc_local_session.h"
 #include "rpc_session.h"
+#include "rpc_shm_channel.h"
+#include "rpc_socket_impl.h"
 
 namespace tvm {
 namespace runtime {
@@ -64,6 +68,16 @@ class SockChannel final : public RPCChannel {
   support::TCPSocket sock_;
 };
 
+/*! \brief Whether a handshake key carries the -shm option of the shared memory transport. */
+bool HasSharedMemoryOption(const std::string& key) {
+  std::istringstream is(key);
+  std::string token;
+  while (is >> token) {
+    if (token == "-shm") return true;
+  }
+  return false;
+}
+
 std::shared_ptr<RPCEndpoint> RPCConnect(std::string url, int port, std::string key,
                                         bool enable_logging, TVMArgs init_seq) {
   support::TCPSocket sock;
@@ -98,6 +112,10 @@ std::shared_ptr<RPCEndpoint> RPCConnect(std::string url, int port, std::string k
   }
 
   std::unique_ptr<RPCChannel> channel = std::make_unique<SockChannel>(sock);
+  // The server confirms the shared memory transport requested by the client in its key.
+  if (HasSharedMemoryOption(key) && HasSharedMemoryOption(remote_key)) {
+    channel = std::make_unique<SharedMemoryChannel>(std::move(channel), true);
+  }
   if (enable_logging) {
     channel.reset(new RPCChannelLogging(std::move(channel)));
   }
@@ -114,9 +132,13 @@ Module RPCClientConnect(std::string url, int port, std::string key, bool enable_
 }
 
 // TVM_DLL needed for MSVC
-TVM_DLL void RPCServerLoop(int sockfd) {
+TVM_DLL void RPCServerLoop(int sockfd, bool shared_memory) {
   support::TCPSocket sock(static_cast<support::TCPSocket::SockType>(sockfd));
-  RPCEndpoint::Create(std::make_unique<SockChannel>(sock), "SockServerLoop", "")->ServerLoop();
+  std::unique_ptr<RPCChannel> channel = std::make_unique<SockChannel>(sock);
+  if (shared_memory) {
+    channel = std::make_unique<SharedMemoryChannel>(std::move(channel), false);
+  }
+  RPCEndpoint::Create(std::move(channel), "SockServerLoop", "")->ServerLoop();
 }
 
 void RPCServerLoop(PackedFunc fsend, PackedFunc frecv) {
@@ -135,7 +157,7 @@ TVM_REGISTER_GLOBAL("rpc.Connect").set_body([](TVMArgs args, TVMRetValue* rv) {
 
 TVM_REGISTER_GLOBAL("rpc.ServerLoop").set_body([](TVMArgs args, TVMRetValue* rv) {
   if (args[0].type_code() == kDLInt) {
-    RPCServerLoop(args[0]);
+    RPCServerLoop(args[0], args.size() > 1 && args[1].operator bool());
   } else {
     RPCServerLoop(args[0].operator tvm::runtime::PackedFunc(),
                   args[1].operator tvm::runtime::PackedFunc());
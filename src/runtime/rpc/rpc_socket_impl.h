@@ -30,8 +30,9 @@ namespace runtime {
 /*!
  * \brief RPCServerLoop Start the rpc server loop.
  * \param sockfd Socket file descriptor
+ * \param shared_memory Whether the client negotiates the shared memory transport.
  */
-void RPCServerLoop(int sockfd);
+void RPCServerLoop(int sockfd, bool shared_memory = false);
 
 }  // namespace runtime
 }  // namespace tvm
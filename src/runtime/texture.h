@@ -96,11 +96,29 @@ inline bool IsTextureStorage(std::string scope) {
 
 class TVM_DLL Pool2D {
  public:
+  /*! \brief Statistics of the texture reuse of a pool. */
+  struct Stats {
+    /*! \brief The number of allocation requests. */
+    int64_t num_allocs{0};
+    /*! \brief The number of requests served by a free texture as is. */
+    int64_t num_reused{0};
+    /*! \brief The number of requests served by growing a free texture. */
+    int64_t num_grown{0};
+    /*! \brief The number of requests served by a new texture. */
+    int64_t num_created{0};
+    /*! \brief The bytes of the textures held by the pool. */
+    int64_t pool_bytes{0};
+    /*! \brief The peak of pool_bytes. */
+    int64_t peak_pool_bytes{0};
+  };
+
   Pool2D() = default;
   void* Alloc(Device dev, DeviceAPI* device, size_t width, size_t height, DLDataType type_hint);
   void Free(void* data);
   // Release all resources immediately
   void Release(Device dev, DeviceAPI* device);
+  // The statistics of the pool
+  const Stats& GetStats() const { return stats_; }
 
  protected:
   struct Entry {
@@ -109,8 +127,13 @@ class TVM_DLL Pool2D {
     size_t y;
     DLDataType type;
   };
+  // The bytes of a texture of the entry, of four channels per texel.
+  static int64_t EntryBytes(const Entry& e) {
+    return static_cast<int64_t>(e.x * e.y * 4) * ((e.type.bits * e.type.lanes + 7) / 8);
+  }
   std::vector<Entry> free_list_;
   std::vector<Entry> allocated_;
+  Stats stats_;
 };
 
 /*!
@@ -153,6 +176,13 @@ class TVM_DLL TexturePool {
    * \param ptr The pointer to be freed.
    */
   void FreeTexture(Device dev, void* ptr);
+  /*!
+   * \brief Get the reuse statistics of the texture pool of a device.
+   *
+   * \param dev The context of allocation.
+   * \return The statistics, all zero if no texture was allocated on the device.
+   */
+  Pool2D::Stats GetStats(Device dev) const;
 
  private:
   /*! \brief pool of device local array */
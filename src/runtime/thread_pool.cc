@@ -27,23 +27,37 @@
 #include <tvm/runtime/container/array.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/threading_backend.h>
 #if TVM_THREADPOOL_USE_OPENMP
 #include <omp.h>
 #endif
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define TVM_THREAD_POOL_USE_FUTEX 1
+#else
+#define TVM_THREAD_POOL_USE_FUTEX 0
+#endif
 #include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <climits>
 #include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "../support/utils.h"
+#include "trace_recorder.h"
 const constexpr int kL1CacheBytes = 64;
 
 namespace tvm {
@@ -60,11 +74,83 @@ uint32_t GetSpinCount() {
   return atoi(val);
 }
 
+bool GetWorkStealingEnabled() {
+  const char* val = getenv("TVM_THREAD_POOL_WORK_STEALING");
+  return val != nullptr && atoi(val) != 0;
+}
+
+constexpr int kDefaultChunkFactor = 4;
+
+int GetChunkFactor() {
+  const char* val = getenv("TVM_THREAD_POOL_CHUNK_FACTOR");
+  if (!val) {
+    return kDefaultChunkFactor;
+  }
+  return std::max(atoi(val), 1);
+}
+
+bool GetAdaptiveSpinEnabled() {
+  const char* val = getenv("TVM_THREAD_POOL_ADAPTIVE_SPIN");
+  return val != nullptr && atoi(val) != 0;
+}
+
+constexpr int64_t kDefaultMaxSpinNs = 2000000;
+// The workers still spin this long when launches are far apart.
+constexpr int64_t kMinSpinNs = 10000;
+
+int64_t GetMaxSpinNs() {
+  const char* val = getenv("TVM_THREAD_POOL_MAX_SPIN_US");
+  if (!val) {
+    return kDefaultMaxSpinNs;
+  }
+  return std::max<int64_t>(atoll(val), 0) * 1000;
+}
+
+/*!
+ * \brief Spin until the predicate holds, or the iteration or time budget runs out.
+ * \param spin_count The maximum number of iterations.
+ * \param spin_ns The maximum time to spin, a negative value only limits the iterations.
+ * \param pred The predicate to wait for.
+ */
+template <typename FPred>
+void SpinWait(uint32_t spin_count, int64_t spin_ns, FPred pred) {
+  if (spin_ns < 0) {
+    for (uint32_t i = 0; i < spin_count && !pred(); ++i) {
+      tvm::runtime::threading::Yield();
+    }
+    return;
+  }
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(spin_ns);
+  for (uint32_t i = 0; i < spin_count && !pred(); ++i) {
+    tvm::runtime::threading::Yield();
+    // reading the clock is cheap compared to a yield, but no need to do it every time.
+    if ((i & 15) == 15 && std::chrono::steady_clock::now() >= deadline) break;
+  }
+}
+
+#if TVM_THREAD_POOL_USE_FUTEX
+static_assert(sizeof(std::atomic<int32_t>) == sizeof(int32_t), "futex needs a plain 32-bit word");
+
+// Sleep while *addr == expected, may return spuriously.
+void FutexWait(std::atomic<int32_t>* addr, int32_t expected) {
+  syscall(SYS_futex, reinterpret_cast<int32_t*>(addr), FUTEX_WAIT_PRIVATE, expected, nullptr,
+          nullptr, 0);
+}
+
+// Wake up all the threads sleeping on addr.
+void FutexWakeAll(std::atomic<int32_t>* addr) {
+  syscall(SYS_futex, reinterpret_cast<int32_t*>(addr), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr,
+          nullptr, 0);
+}
+#endif
+
 }  // namespace
 
 // stride in the page, fit to cache line.
 constexpr int kSyncStride = 64 / sizeof(std::atomic<int>);
 
+class ThreadPool;
+
 /*!
  * \brief Thread local main environment.
  */
@@ -95,8 +181,29 @@ class ParallelLauncher {
     }
   }
   ~ParallelLauncher() { delete[] sync_counter_; }
-  // Wait n jobs to finish
-  int WaitForJobs() {
+  /*!
+   * \brief Wait n jobs to finish.
+   * \param spin_count The number of iterations to spin before sleep.
+   * \param spin_ns The time to spin before sleep, a negative value never sleeps.
+   * \param num_sleeps Counter incremented when the launcher goes to sleep.
+   */
+  int WaitForJobs(uint32_t spin_count = 0, int64_t spin_ns = -1,
+                  std::atomic<uint64_t>* num_sleeps = nullptr) {
+#if TVM_THREAD_POOL_USE_FUTEX
+    if (allow_sleep && spin_ns >= 0) {
+      SpinWait(spin_count, spin_ns, [this] { return num_pending_.load() == 0; });
+      int32_t pending = num_pending_.load();
+      if (pending != 0) {
+        // the last finishing job wakes us up, see ReleaseJob.
+        sleeping_.store(1);
+        if (num_sleeps != nullptr) num_sleeps->fetch_add(1, std::memory_order_relaxed);
+        while ((pending = num_pending_.load()) != 0) {
+          FutexWait(&num_pending_, pending);
+        }
+        sleeping_.store(0);
+      }
+    }
+#endif
     while (num_pending_.load() != 0) {
       tvm::runtime::threading::Yield();
     }
@@ -112,13 +219,17 @@ class ParallelLauncher {
     return -1;
   }
   // Signal that one job has finished.
+  // The error must be recorded before the pending counter is released, the launcher
+  // may go out of scope as soon as it observes that all jobs have finished.
   void SignalJobError(int task_id) {
-    num_pending_.fetch_sub(1);
     par_errors_[task_id] = TVMGetLastError();
     has_error_.store(true);
+    ReleaseJob();
   }
+  // Whether all the jobs have finished.
+  bool Finished() const { return num_pending_.load() == 0; }
   // Signal that one job has finished.
-  void SignalJobFinish() { num_pending_.fetch_sub(1); }
+  void SignalJobFinish() { ReleaseJob(); }
   // Get thread local version of the store.
   static ParallelLauncher* ThreadLocal() { return dmlc::ThreadLocalStore<ParallelLauncher>::Get(); }
   // The parallel lambda
@@ -130,12 +241,35 @@ class ParallelLauncher {
   // Whether this thread is worker of the pool.
   // used to prevent recursive launch.
   bool is_worker{false};
+  // The id of the worker, only used by the work-stealing scheduler.
+  int worker_id{0};
+  // The pool this worker belongs to, only set by the work-stealing scheduler.
+  ThreadPool* owner_pool{nullptr};
+  // Whether the launcher may sleep in WaitForJobs, only for launchers that outlive their jobs.
+  bool allow_sleep{false};
+  // Whether the launching thread is running task 0 of its own job.
+  bool in_main_task{false};
 
  private:
+  // Release one pending job, and wake up the launcher if it sleeps on the last one.
+  void ReleaseJob() {
+    // read before releasing, the launcher may go out of scope once all the jobs are released.
+    const bool may_sleep = allow_sleep;
+    if (num_pending_.fetch_sub(1) == 1 && may_sleep) {
+#if TVM_THREAD_POOL_USE_FUTEX
+      if (sleeping_.load() != 0) {
+        FutexWakeAll(&num_pending_);
+      }
+#endif
+    }
+  }
+
   // The pending jobs.
   std::atomic<int32_t> num_pending_;
   // Whether error has been countered.
   std::atomic<bool> has_error_;
+  // Whether the launcher sleeps in WaitForJobs.
+  std::atomic<int32_t> sleeping_{0};
   // The counter page.
   std::atomic<int32_t>* sync_counter_{nullptr};
   // The error message
@@ -164,27 +298,37 @@ class SpscTaskQueue {
       tvm::runtime::threading::Yield();
     }
     if (pending_.fetch_add(1) == -1) {
-      std::unique_lock<std::mutex> lock(mutex_);
-      cv_.notify_one();
+      Wake();
     }
   }
 
   /*!
-   * \brief Pop a task out of the queue and condition wait if no tasks.
+   * \brief Pop a task out of the queue and wait if no tasks.
    * \param output The pointer to the task to be dequeued.
    * \param spin_count The number of iterations to spin before sleep.
+   * \param spin_ns The time to spin before sleep, a negative value only limits the iterations.
    * \return Whether pop is successful (true) or we need to exit now (false).
    */
-  bool Pop(Task* output, uint32_t spin_count) {
+  bool Pop(Task* output, uint32_t spin_count, int64_t spin_ns = -1) {
     // Busy wait a bit when the queue is empty.
     // If a new task comes to the queue quickly, this wait avoid the worker from sleeping.
     // The default spin count is set by following the typical omp convention
-    for (uint32_t i = 0; i < spin_count && pending_.load() == 0; ++i) {
-      tvm::runtime::threading::Yield();
-    }
+    SpinWait(spin_count, spin_ns, [this] { return pending_.load() != 0; });
     if (pending_.fetch_sub(1) == 0) {
+      num_sleeps_.store(num_sleeps_.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+#if TVM_THREAD_POOL_USE_FUTEX
+      // pending_ stays at -1 until the producer pushes or we are killed.
+      while (pending_.load() < 0) {
+        FutexWait(&pending_, -1);
+      }
+#else
       std::unique_lock<std::mutex> lock(mutex_);
       cv_.wait(lock, [this] { return pending_.load() >= 0 || exit_now_.load(); });
+#endif
+    } else {
+      num_spin_hits_.store(num_spin_hits_.load(std::memory_order_relaxed) + 1,
+                           std::memory_order_relaxed);
     }
     if (exit_now_.load(std::memory_order_relaxed)) {
       return false;
@@ -201,12 +345,34 @@ class SpscTaskQueue {
    * \brief Signal to terminate the worker.
    */
   void SignalForKill() {
+#if TVM_THREAD_POOL_USE_FUTEX
+    exit_now_.store(true);
+    // bump the counter so that a consumer about to sleep sees the change.
+    pending_.fetch_add(1);
+    FutexWakeAll(&pending_);
+#else
     std::lock_guard<std::mutex> lock(mutex_);
     exit_now_.store(true);
     cv_.notify_all();
+#endif
   }
 
+  /*! \brief The number of tasks popped without sleeping. */
+  uint64_t NumSpinHits() const { return num_spin_hits_.load(std::memory_order_relaxed); }
+  /*! \brief The number of times the consumer went to sleep. */
+  uint64_t NumSleeps() const { return num_sleeps_.load(std::memory_order_relaxed); }
+
  protected:
+  // Wake up the consumer.
+  void Wake() {
+#if TVM_THREAD_POOL_USE_FUTEX
+    FutexWakeAll(&pending_);
+#else
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.notify_one();
+#endif
+  }
+
   /*!
    * \brief Lock-free enqueue.
    * \param input The task to be enqueued.
@@ -243,12 +409,15 @@ class SpscTaskQueue {
   std::atomic<uint32_t> tail_;
 
   cache_line_pad_t pad3_;
-  // pending tasks in the queue
-  std::atomic<int8_t> pending_{0};
+  // pending tasks in the queue, -1 when the consumer waits for a task
+  std::atomic<int32_t> pending_{0};
 
   cache_line_pad_t pad4_;
   // signal for exit now
   std::atomic<bool> exit_now_{false};
+  // wait statistics, only written by the consumer
+  std::atomic<uint64_t> num_spin_hits_{0};
+  std::atomic<uint64_t> num_sleeps_{0};
 
   // internal mutex
   std::mutex mutex_;
@@ -256,6 +425,67 @@ class SpscTaskQueue {
   std::condition_variable cv_;
 };
 
+/*!
+ * \brief Per-worker task deque used by the work-stealing scheduler.
+ *
+ *  The owner pops at the back (LIFO, which keeps nested launches cache-hot), while idle
+ *  workers steal from the front (FIFO, the oldest and usually largest chunk). Neither waits
+ *  for a task, they return false on an empty deque.
+ */
+class StealingTaskDeque {
+ public:
+  /*! \brief The task entry */
+  struct Task {
+    ParallelLauncher* launcher;
+    int32_t task_id;
+  };
+
+  /*!
+   * \brief Push a task to the back of the deque. It never waits for room, the deque is unbounded,
+   *  but it takes the lock of the deque, so it blocks while another thread pops or steals.
+   *  The owner pushes its nested launches, the launching thread distributes its job.
+   * \param input The task to be enqueued.
+   */
+  void Push(const Task& input) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(input);
+  }
+
+  /*!
+   * \brief Pop a task from the back of the deque, only called by the owner.
+   * \param output The pointer to the task to be dequeued.
+   * \return Whether a task was dequeued.
+   */
+  bool Pop(Task* output) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_.empty()) return false;
+    *output = tasks_.back();
+    tasks_.pop_back();
+    return true;
+  }
+
+  /*!
+   * \brief Steal a task from the front of the deque, called by other workers.
+   * \param output The pointer to the task to be dequeued.
+   * \return Whether a task was dequeued.
+   */
+  bool Steal(Task* output) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_.empty()) return false;
+    *output = tasks_.front();
+    tasks_.pop_front();
+    return true;
+  }
+
+ private:
+  // the cache line paddings are used for avoid false sharing between neighbouring deques
+  typedef char cache_line_pad_t[kL1CacheBytes];
+  cache_line_pad_t pad0_;
+  std::mutex mutex_;
+  std::deque<Task> tasks_;
+  cache_line_pad_t pad1_;
+};
+
 // The thread pool
 class ThreadPool {
  public:
@@ -264,30 +494,61 @@ class ThreadPool {
     if (exclude_worker0 && atoi(exclude_worker0) == 0) {
       exclude_worker0_ = false;
     }
+    work_stealing_ = GetWorkStealingEnabled();
+    chunk_factor_ = GetChunkFactor();
+    InitSpinPolicy();
+    Init();
+  }
+
+  /*!
+   * \brief Create a pool shared by several launching threads, with one worker pinned
+   *  to each of the given CPUs.
+   *
+   *  The launching threads do not take part in the work, so their affinity is untouched.
+   * \param cpus The CPUs of the pool.
+   */
+  explicit ThreadPool(const std::vector<unsigned int>& cpus)
+      : num_workers_(static_cast<int>(cpus.size())), exclude_worker0_(false), shared_(true) {
+    work_stealing_ = GetWorkStealingEnabled();
+    chunk_factor_ = GetChunkFactor();
+    InitSpinPolicy();
     Init();
+    UpdateWorkerConfiguration(threading::ThreadGroup::kSpecifyOneCorePerThread, 0, cpus);
   }
 
   ~ThreadPool() {
-    for (std::unique_ptr<SpscTaskQueue>& q : queues_) {
-      q->SignalForKill();
-    }
+    SignalForKill();
     threads_.reset();
   }
 
   void Reset() {
-    for (std::unique_ptr<SpscTaskQueue>& q : queues_) {
-      q->SignalForKill();
-    }
+    SignalForKill();
     // Destroy threads before we destory the shared queue, otherwise we segfault on MacOS
     threads_.reset();
     queues_.clear();
+    steal_queues_.clear();
     Init();
   }
 
   int Launch(FTVMParallelLambda flambda, void* cdata, int num_task, int need_sync) {
+    if (work_stealing_) {
+      return LaunchStealing(flambda, cdata, num_task);
+    }
     ParallelLauncher* launcher = ParallelLauncher::ThreadLocal();
-    ICHECK(!launcher->is_worker)
-        << "Cannot launch parallel job inside worker, consider fuse then parallel";
+    if (launcher->is_worker || launcher->in_main_task) {
+      // A job launched from a task, e.g. by a packed function that a parallel kernel calls,
+      // cannot queue behind the tasks of the running one. It runs inline as a single task.
+      std::atomic<int32_t> sync_counter{0};
+      TVMParallelGroupEnv env;
+      env.num_task = 1;
+      env.sync_handle = &sync_counter;
+      return (*flambda)(0, &env, cdata) == 0 ? 0 : -1;
+    }
+    // the task queues only have a single producer, serialize the launching threads.
+    std::unique_lock<std::mutex> shared_lock;
+    if (shared_) {
+      shared_lock = std::unique_lock<std::mutex>(launch_mutex_);
+    }
     if (num_task == 0) {
       num_task = num_workers_used_;
     }
@@ -297,6 +558,9 @@ class ThreadPool {
           << " workers=" << num_workers_used_ << " request=" << num_task;
     }
     launcher->Init(flambda, cdata, num_task, need_sync != 0);
+    // the thread local launcher outlives its jobs, so it is safe to sleep on it.
+    launcher->allow_sleep = true;
+    RecordLaunchStart();
     SpscTaskQueue::Task tsk;
     tsk.launcher = launcher;
     // if worker0 is taken by the main, queues_[0] is abandoned
@@ -307,18 +571,40 @@ class ThreadPool {
     // use the main thread to run task 0
     if (exclude_worker0_) {
       TVMParallelGroupEnv* penv = &(tsk.launcher->env);
-      if ((*tsk.launcher->flambda)(0, penv, cdata) == 0) {
+      profiling::TraceScope trace("thread_pool", "parallel task");
+      launcher->in_main_task = true;
+      int ret = (*tsk.launcher->flambda)(0, penv, cdata);
+      launcher->in_main_task = false;
+      if (ret == 0) {
         tsk.launcher->SignalJobFinish();
       } else {
         tsk.launcher->SignalJobError(tsk.task_id);
       }
     }
-    int res = launcher->WaitForJobs();
+    int res = launcher->WaitForJobs(spin_count_, adaptive_spin_ ? max_spin_ns_ : -1,
+                                    &num_launcher_sleeps_);
+    RecordLaunchEnd();
     return res;
   }
 
   static ThreadPool* ThreadLocal() { return dmlc::ThreadLocalStore<ThreadPool>::Get(); }
 
+  // The pool to launch jobs into, workers of the work-stealing scheduler launch
+  // nested jobs into the pool they belong to, threads inside a ThreadPoolGroupScope
+  // launch into the group.
+  static ThreadPool* Current() {
+    ThreadPool* owner = ParallelLauncher::ThreadLocal()->owner_pool;
+    if (owner != nullptr) return owner;
+    ThreadPool* group = CurrentGroup();
+    return group != nullptr ? group : ThreadLocal();
+  }
+
+  // The group pool selected by the innermost ThreadPoolGroupScope of the calling thread.
+  static ThreadPool*& CurrentGroup() {
+    static thread_local ThreadPool* group = nullptr;
+    return group;
+  }
+
   void UpdateWorkerConfiguration(threading::ThreadGroup::AffinityMode mode, int nthreads,
                                  const std::vector<unsigned int>& cpus) {
     // this will also reset the affinity of the ThreadGroup
@@ -327,21 +613,224 @@ class ThreadPool {
     // if MaxConcurrency restricted the number of workers (e.g., due to
     // hyperthreading), respect the restriction
     num_workers_used_ = std::min(num_workers_, num_workers_used_);
+    if (work_stealing_) {
+      std::lock_guard<std::mutex> lock(steal_mutex_);
+      num_stealers_.store(num_workers_used_);
+      steal_cv_.notify_all();
+    }
   }
 
   int32_t NumThreads() const { return num_workers_used_; }
 
+  /*! \brief Counters of how the threads of the pool waited for work. */
+  struct WaitStats {
+    /*! \brief Tasks picked up by the workers without sleeping. */
+    uint64_t spin_hits{0};
+    /*! \brief Times a worker went to sleep waiting for a task. */
+    uint64_t sleeps{0};
+    /*! \brief Times the launching thread went to sleep waiting for the workers. */
+    uint64_t launcher_sleeps{0};
+  };
+
+  WaitStats GetWaitStats() const {
+    WaitStats stats;
+    for (const std::unique_ptr<SpscTaskQueue>& q : queues_) {
+      stats.spin_hits += q->NumSpinHits();
+      stats.sleeps += q->NumSleeps();
+    }
+    stats.spin_hits += steal_spin_hits_.load(std::memory_order_relaxed);
+    stats.sleeps += steal_sleeps_.load(std::memory_order_relaxed);
+    stats.launcher_sleeps = num_launcher_sleeps_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  /*! \brief The current spin budget of the workers in nanoseconds, negative when unbounded. */
+  int64_t SpinBudgetNs() const { return spin_ns_.load(std::memory_order_relaxed); }
+
  private:
   // Shared initialization code
   void Init() {
-    for (int i = 0; i < num_workers_; ++i) {
-      // The SpscTaskQueue only hosts ONE item at a time
-      queues_.emplace_back(std::make_unique<SpscTaskQueue>());
+    if (work_stealing_) {
+      // One deque per worker plus one for the launching thread when it is not worker 0.
+      for (int i = 0; i <= num_workers_; ++i) {
+        steal_queues_.emplace_back(std::make_unique<StealingTaskDeque>());
+      }
+      num_queued_.store(0);
+      steal_exit_.store(false);
+    } else {
+      for (int i = 0; i < num_workers_; ++i) {
+        // The SpscTaskQueue only hosts ONE item at a time
+        queues_.emplace_back(std::make_unique<SpscTaskQueue>());
+      }
     }
     threads_ = std::make_unique<tvm::runtime::threading::ThreadGroup>(
-        num_workers_, [this](int worker_id) { this->RunWorker(worker_id); },
+        num_workers_,
+        [this](int worker_id) {
+          if (work_stealing_) {
+            this->RunStealingWorker(worker_id);
+          } else {
+            this->RunWorker(worker_id);
+          }
+        },
         exclude_worker0_ /* include_main_thread */);
     num_workers_used_ = threads_->Configure(threading::ThreadGroup::kBig, 0, exclude_worker0_);
+    num_stealers_.store(num_workers_used_);
+  }
+
+  // Read the spin configuration from the environment.
+  void InitSpinPolicy() {
+    // Initialize the spin count (from envvar TVM_THREAD_POOL_SPIN_COUNT) on
+    // the global first use of the ThreadPool.
+    static uint32_t spin_count = GetSpinCount();
+    spin_count_ = spin_count;
+    adaptive_spin_ = GetAdaptiveSpinEnabled();
+    max_spin_ns_ = GetMaxSpinNs();
+    spin_ns_.store(adaptive_spin_ ? max_spin_ns_ : -1);
+  }
+
+  void RecordLaunchStart() {
+    if (!adaptive_spin_) return;
+    auto now = std::chrono::steady_clock::now();
+    if (last_launch_end_ != std::chrono::steady_clock::time_point()) {
+      // Learn the idle gap between launches, the workers spin for about twice the usual gap
+      // so that back to back launches find them awake. If the pool is mostly idle the
+      // gaps are long and spinning only wastes CPU, so they go to sleep almost right away.
+      double gap = std::chrono::duration<double, std::nano>(now - last_launch_end_).count();
+      gap_ewma_ns_ = gap_ewma_ns_ < 0 ? gap : gap_ewma_ns_ + (gap - gap_ewma_ns_) / 8;
+      int64_t budget = gap_ewma_ns_ <= max_spin_ns_
+                           ? std::min(static_cast<int64_t>(2 * gap_ewma_ns_), max_spin_ns_)
+                           : std::min(kMinSpinNs, max_spin_ns_);
+      spin_ns_.store(budget, std::memory_order_relaxed);
+    }
+  }
+
+  void RecordLaunchEnd() {
+    if (adaptive_spin_) last_launch_end_ = std::chrono::steady_clock::now();
+  }
+
+  // Wake up and terminate all the workers.
+  void SignalForKill() {
+    for (std::unique_ptr<SpscTaskQueue>& q : queues_) {
+      q->SignalForKill();
+    }
+    if (work_stealing_) {
+      std::lock_guard<std::mutex> lock(steal_mutex_);
+      steal_exit_.store(true);
+      steal_cv_.notify_all();
+    }
+  }
+
+  /*!
+   * \brief Launch a parallel job through the work-stealing scheduler.
+   *
+   *  When num_task is 0 the job is split into chunk_factor_ tasks per worker so that idle
+   *  workers can balance irregular work. Launches from inside a worker are not serialized,
+   *  their tasks are pushed to the worker's own deque and can be stolen by the others.
+   *  Since the tasks of a job are not guaranteed to run concurrently, TVMBackendParallelBarrier
+   *  is not supported in this mode.
+   */
+  int LaunchStealing(FTVMParallelLambda flambda, void* cdata, int num_task) {
+    const bool is_nested = ParallelLauncher::ThreadLocal()->is_worker;
+    const int self = SelfQueueIndex();
+    if (num_task == 0) {
+      num_task = num_workers_used_ * chunk_factor_;
+    }
+    // The launcher lives on the stack as a worker may launch again while it helps other jobs.
+    ParallelLauncher launcher;
+    launcher.Init(flambda, cdata, num_task, false);
+    // the launch gap is only learned when one thread launches into the pool.
+    const bool record_gap = !is_nested && !shared_;
+    if (record_gap) RecordLaunchStart();
+    StealingTaskDeque::Task tsk;
+    tsk.launcher = &launcher;
+    // Push in reverse order so that the owners pick up the lowest task ids first.
+    for (int i = num_task - 1; i >= 0; --i) {
+      tsk.task_id = i;
+      steal_queues_[is_nested ? self : i % num_workers_used_]->Push(tsk);
+    }
+    num_queued_.fetch_add(num_task);
+    if (num_sleeping_.load() != 0) {
+      std::lock_guard<std::mutex> lock(steal_mutex_);
+      steal_cv_.notify_all();
+    }
+    // Help executing the tasks until the job completes.
+    while (!launcher.Finished()) {
+      if (TryGetStealingTask(self, &tsk)) {
+        RunTask(tsk.launcher, tsk.task_id);
+      } else {
+        tvm::runtime::threading::Yield();
+      }
+    }
+    if (record_gap) RecordLaunchEnd();
+    return launcher.WaitForJobs();
+  }
+
+  // The deque index owned by the calling thread.
+  int SelfQueueIndex() const {
+    ParallelLauncher* local = ParallelLauncher::ThreadLocal();
+    if (local->is_worker) return local->worker_id;
+    // The launching thread runs as worker 0 unless worker 0 has its own thread.
+    return exclude_worker0_ ? 0 : num_workers_;
+  }
+
+  // Try to get a task from the own deque first, then steal from the others.
+  bool TryGetStealingTask(int self, StealingTaskDeque::Task* output) {
+    if (num_queued_.load() == 0) return false;
+    if (steal_queues_[self]->Pop(output)) {
+      num_queued_.fetch_sub(1);
+      return true;
+    }
+    const int num_queues = static_cast<int>(steal_queues_.size());
+    for (int i = 1; i < num_queues; ++i) {
+      if (steal_queues_[(self + i) % num_queues]->Steal(output)) {
+        num_queued_.fetch_sub(1);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Run a single task and report the result to its launcher.
+  static void RunTask(ParallelLauncher* launcher, int32_t task_id) {
+    ICHECK(launcher != nullptr);
+    TVMParallelGroupEnv* penv = &(launcher->env);
+    profiling::TraceScope trace("thread_pool", "parallel task");
+    if ((*launcher->flambda)(task_id, penv, launcher->cdata) == 0) {
+      launcher->SignalJobFinish();
+    } else {
+      launcher->SignalJobError(task_id);
+    }
+  }
+
+  // Internal worker function of the work-stealing scheduler.
+  void RunStealingWorker(int worker_id) {
+    ParallelLauncher* local = ParallelLauncher::ThreadLocal();
+    local->is_worker = true;
+    local->worker_id = worker_id;
+    local->owner_pool = this;
+    profiling::TraceRecorder::Global()->SetThreadName("thread pool worker " +
+                                                      std::to_string(worker_id));
+    StealingTaskDeque::Task task;
+    while (!steal_exit_.load()) {
+      if (worker_id < num_stealers_.load() && TryGetStealingTask(worker_id, &task)) {
+        RunTask(task.launcher, task.task_id);
+        continue;
+      }
+      // Busy wait a bit for new tasks before going to sleep.
+      SpinWait(spin_count_, spin_ns_.load(std::memory_order_relaxed),
+               [this] { return num_queued_.load() != 0 || steal_exit_.load(); });
+      if (num_queued_.load() != 0 && worker_id < num_stealers_.load()) {
+        steal_spin_hits_.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+      steal_sleeps_.fetch_add(1, std::memory_order_relaxed);
+      std::unique_lock<std::mutex> lock(steal_mutex_);
+      num_sleeping_.fetch_add(1);
+      steal_cv_.wait(lock, [this, worker_id] {
+        return steal_exit_.load() || (num_queued_.load() != 0 && worker_id < num_stealers_.load());
+      });
+      num_sleeping_.fetch_sub(1);
+    }
   }
 
   // Internal worker function.
@@ -349,14 +838,13 @@ class ThreadPool {
     SpscTaskQueue* queue = queues_[worker_id].get();
     SpscTaskQueue::Task task;
     ParallelLauncher::ThreadLocal()->is_worker = true;
-    // Initialize the spin count (from envvar TVM_THREAD_POOL_SPIN_COUNT) on
-    // the global first use of the ThreadPool.
-    // TODO(tulloch): should we make this configurable via standard APIs?
-    static size_t spin_count = GetSpinCount();
-    while (queue->Pop(&task, spin_count)) {
+    profiling::TraceRecorder::Global()->SetThreadName("thread pool worker " +
+                                                      std::to_string(worker_id));
+    while (queue->Pop(&task, spin_count_, spin_ns_.load(std::memory_order_relaxed))) {
       ICHECK(task.launcher != nullptr);
       TVMParallelGroupEnv* penv = &(task.launcher->env);
       void* cdata = task.launcher->cdata;
+      profiling::TraceScope trace("thread_pool", "parallel task");
       if ((*task.launcher->flambda)(task.task_id, penv, cdata) == 0) {
         task.launcher->SignalJobFinish();
       } else {
@@ -369,7 +857,43 @@ class ThreadPool {
   int num_workers_used_;
   // if or not to exclude worker 0 and use main to run task 0
   bool exclude_worker0_{true};
+  // whether the pool is a group shared by several launching threads
+  bool shared_{false};
+  // the maximum number of spin iterations (envvar TVM_THREAD_POOL_SPIN_COUNT)
+  uint32_t spin_count_{kDefaultSpinCount};
+  // whether the spin time adapts to the gap between launches (envvar TVM_THREAD_POOL_ADAPTIVE_SPIN)
+  bool adaptive_spin_{false};
+  // the upper bound of the spin time (envvar TVM_THREAD_POOL_MAX_SPIN_US)
+  int64_t max_spin_ns_{kDefaultMaxSpinNs};
+  // the current spin time of the workers, negative when only the iterations are limited
+  std::atomic<int64_t> spin_ns_{-1};
+  // moving average of the gap between launches, negative before the first gap is seen
+  double gap_ewma_ns_{-1};
+  // when the last launch finished, only touched by the launching thread
+  std::chrono::steady_clock::time_point last_launch_end_;
+  // wait statistics not kept by the task queues
+  std::atomic<uint64_t> num_launcher_sleeps_{0};
+  std::atomic<uint64_t> steal_spin_hits_{0};
+  std::atomic<uint64_t> steal_sleeps_{0};
+  // serializes the launching threads of a shared pool
+  std::mutex launch_mutex_;
   std::vector<std::unique_ptr<SpscTaskQueue>> queues_;
+  // whether to use the work-stealing scheduler (envvar TVM_THREAD_POOL_WORK_STEALING)
+  bool work_stealing_{false};
+  // number of tasks per worker when the launch does not specify num_task
+  int chunk_factor_{kDefaultChunkFactor};
+  // the per-worker deques of the work-stealing scheduler
+  std::vector<std::unique_ptr<StealingTaskDeque>> steal_queues_;
+  // number of tasks queued in all the deques
+  std::atomic<int> num_queued_{0};
+  // number of workers sleeping on steal_cv_
+  std::atomic<int> num_sleeping_{0};
+  // workers with id below this value take part in stealing
+  std::atomic<int> num_stealers_{0};
+  // signal for the stealing workers to exit
+  std::atomic<bool> steal_exit_{false};
+  std::mutex steal_mutex_;
+  std::condition_variable steal_cv_;
   std::unique_ptr<tvm::runtime::threading::ThreadGroup> threads_;
 };
 
@@ -396,6 +920,176 @@ TVM_REGISTER_GLOBAL("runtime.NumThreads").set_body_typed([]() -> int32_t {
   return threading::NumThreads();
 });
 
+/*!
+ * \brief args[0] is the NUMA node, args[1] is the number of threads.
+ */
+TVM_REGISTER_GLOBAL("runtime.config_threadpool_numa").set_body_typed([](int node, int nthreads) {
+  threading::ConfigureNumaNode(node, nthreads);
+});
+
+TVM_REGISTER_GLOBAL("runtime.NumaNodeCount").set_body_typed([]() -> int32_t {
+  return threading::NumaNodeCount();
+});
+
+/*! \brief Registry of the named thread pool groups. */
+class ThreadPoolGroupRegistry {
+ public:
+  static ThreadPoolGroupRegistry* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    static auto* inst = new ThreadPoolGroupRegistry();
+    return inst;
+  }
+
+  void Create(const std::string& name, const std::vector<unsigned int>& cpus) {
+    ICHECK(!cpus.empty()) << "Thread pool group '" << name << "' needs at least one CPU";
+    std::lock_guard<std::mutex> lock(mutex_);
+    ICHECK(!groups_.count(name)) << "Thread pool group '" << name << "' already exists";
+    for (unsigned int cpu : cpus) {
+      auto it = cpu_owner_.find(cpu);
+      ICHECK(it == cpu_owner_.end()) << "CPU " << cpu << " is already used by thread pool group '"
+                                     << it->second << "', groups must be disjoint";
+    }
+    for (unsigned int cpu : cpus) {
+      cpu_owner_[cpu] = name;
+    }
+    groups_[name] = std::make_shared<ThreadPool>(cpus);
+  }
+
+  void Remove(const std::string& name) {
+    std::shared_ptr<ThreadPool> pool;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = groups_.find(name);
+      ICHECK(it != groups_.end()) << "Thread pool group '" << name << "' does not exist";
+      pool = std::move(it->second);
+      groups_.erase(it);
+      for (auto cit = cpu_owner_.begin(); cit != cpu_owner_.end();) {
+        cit = cit->second == name ? cpu_owner_.erase(cit) : std::next(cit);
+      }
+    }
+    // The workers are joined here, or by the last scope still using the group.
+    pool.reset();
+  }
+
+  std::shared_ptr<ThreadPool> Get(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = groups_.find(name);
+    ICHECK(it != groups_.end()) << "Thread pool group '" << name << "' does not exist";
+    return it->second;
+  }
+
+  std::vector<std::string> List() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> names;
+    for (const auto& kv : groups_) {
+      names.push_back(kv.first);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<ThreadPool>> groups_;
+  std::unordered_map<unsigned int, std::string> cpu_owner_;
+};
+
+/*!
+ * \brief args[0] is the name of the group, args[1] is the list of CPUs of the group.
+ */
+TVM_REGISTER_GLOBAL("runtime.ThreadPoolGroupCreate")
+    .set_body_typed([](String name, Array<String> cpu_array) {
+      std::vector<unsigned int> cpus;
+      for (auto cpu : cpu_array) {
+        ICHECK(IsNumber(cpu)) << "The CPU core information '" << cpu << "' is not a number.";
+        cpus.push_back(std::stoi(cpu));
+      }
+      threading::CreateThreadPoolGroup(name, cpus);
+    });
+
+TVM_REGISTER_GLOBAL("runtime.ThreadPoolGroupRemove").set_body_typed([](String name) {
+  threading::RemoveThreadPoolGroup(name);
+});
+
+TVM_REGISTER_GLOBAL("runtime.ThreadPoolGroupList").set_body_typed([]() {
+  Array<String> names;
+  for (const std::string& name : threading::ListThreadPoolGroups()) {
+    names.push_back(name);
+  }
+  return names;
+});
+
+namespace profiling {
+
+/*! \brief Wait statistics of the thread pool at the start of a call. */
+class ThreadPoolWaitStatsNode : public Object {
+ public:
+  explicit ThreadPoolWaitStatsNode(ThreadPool::WaitStats start) : start(start) {}
+
+  ThreadPool::WaitStats start;
+
+  static constexpr const char* _type_key = "runtime.profiling.ThreadPoolWaitStats";
+  TVM_DECLARE_FINAL_OBJECT_INFO(ThreadPoolWaitStatsNode, Object);
+};
+
+/*! \brief MetricCollectorNode reporting how the thread pool waited for work.
+ *
+ * For each call this counts the tasks the workers picked up while spinning, the
+ * times they went to sleep, and the times the launching thread went to sleep.
+ * A high number of sleeps means the spin budget is too short for the launch pattern.
+ */
+class ThreadPoolMetricCollectorNode final : public MetricCollectorNode {
+ public:
+  void Init(Array<DeviceWrapper> devs) final {}
+
+  ObjectRef Start(Device dev) final {
+#if TVM_THREADPOOL_USE_OPENMP
+    return ObjectRef(nullptr);
+#else
+    if (dev.device_type != kDLCPU) return ObjectRef(nullptr);
+    return ObjectRef(make_object<ThreadPoolWaitStatsNode>(ThreadPool::Current()->GetWaitStats()));
+#endif
+  }
+
+  Map<String, ObjectRef> Stop(ObjectRef obj) final {
+    const ThreadPoolWaitStatsNode* node = obj.as<ThreadPoolWaitStatsNode>();
+    ICHECK(node != nullptr);
+    ThreadPool::WaitStats end = ThreadPool::Current()->GetWaitStats();
+    auto count = [](uint64_t begin, uint64_t end) {
+      return ObjectRef(make_object<CountNode>(static_cast<int64_t>(end - begin)));
+    };
+    return {{"Thread Pool Spin Hits", count(node->start.spin_hits, end.spin_hits)},
+            {"Thread Pool Sleeps", count(node->start.sleeps, end.sleeps)},
+            {"Thread Pool Launcher Sleeps",
+             count(node->start.launcher_sleeps, end.launcher_sleeps)}};
+  }
+
+  static constexpr const char* _type_key = "runtime.profiling.ThreadPoolMetricCollector";
+  TVM_DECLARE_FINAL_OBJECT_INFO(ThreadPoolMetricCollectorNode, MetricCollectorNode);
+};
+
+TVM_REGISTER_OBJECT_TYPE(ThreadPoolWaitStatsNode);
+TVM_REGISTER_OBJECT_TYPE(ThreadPoolMetricCollectorNode);
+
+TVM_REGISTER_GLOBAL("runtime.profiling.ThreadPoolMetricCollector").set_body_typed([]() {
+  return MetricCollector(make_object<ThreadPoolMetricCollectorNode>());
+});
+
+}  // namespace profiling
+
+TVM_REGISTER_GLOBAL("runtime.ThreadPoolWaitStats").set_body_typed([]() {
+  using profiling::CountNode;
+  ThreadPool* pool = ThreadPool::Current();
+  ThreadPool::WaitStats stats = pool->GetWaitStats();
+  auto count = [](int64_t value) { return ObjectRef(make_object<CountNode>(value)); };
+  Map<String, ObjectRef> result;
+  result.Set("spin_hits", count(static_cast<int64_t>(stats.spin_hits)));
+  result.Set("sleeps", count(static_cast<int64_t>(stats.sleeps)));
+  result.Set("launcher_sleeps", count(static_cast<int64_t>(stats.launcher_sleeps)));
+  result.Set("spin_budget_ns", count(pool->SpinBudgetNs()));
+  return result;
+});
+
 namespace threading {
 
 #if TVM_THREADPOOL_USE_OPENMP
@@ -466,14 +1160,41 @@ TVM_DLL void Configure(tvm::runtime::threading::ThreadGroup::AffinityMode mode,
   ConfigureOMP(mode, nthreads, cpus);
 #endif
 }
-int32_t NumThreads() { return tvm::runtime::ThreadPool::ThreadLocal()->NumThreads(); }
+int32_t NumThreads() { return tvm::runtime::ThreadPool::Current()->NumThreads(); }
+
+void CreateThreadPoolGroup(const std::string& name, const std::vector<unsigned int>& cpus) {
+#if TVM_THREADPOOL_USE_OPENMP
+  LOG(FATAL) << "Thread pool groups are not supported with the OpenMP thread pool";
+#endif
+  ThreadPoolGroupRegistry::Global()->Create(name, cpus);
+}
+
+void RemoveThreadPoolGroup(const std::string& name) {
+  ThreadPoolGroupRegistry::Global()->Remove(name);
+}
+
+std::vector<std::string> ListThreadPoolGroups() { return ThreadPoolGroupRegistry::Global()->List(); }
+
+ThreadPoolGroupScope::ThreadPoolGroupScope(const std::string& name) {
+  if (name.empty()) return;
+  std::shared_ptr<ThreadPool> pool = ThreadPoolGroupRegistry::Global()->Get(name);
+  prev_ = ThreadPool::CurrentGroup();
+  ThreadPool::CurrentGroup() = pool.get();
+  group_ = std::move(pool);
+}
+
+ThreadPoolGroupScope::~ThreadPoolGroupScope() {
+  if (group_ != nullptr) {
+    ThreadPool::CurrentGroup() = static_cast<ThreadPool*>(prev_);
+  }
+}
 }  // namespace threading
 }  // namespace runtime
 }  // namespace tvm
 
 int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task) {
   int num_workers = tvm::runtime::threading::MaxConcurrency();
-  if (num_workers == 1) {
+  if (num_workers == 1 && tvm::runtime::ThreadPool::CurrentGroup() == nullptr) {
     std::atomic<int32_t> sync_counter{0};
     TVMParallelGroupEnv env;
     env.num_task = 1;
@@ -482,7 +1203,7 @@ int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_ta
     return 0;
   } else {
 #if !TVM_THREADPOOL_USE_OPENMP
-    int res = tvm::runtime::ThreadPool::ThreadLocal()->Launch(flambda, cdata, num_task, 1);
+    int res = tvm::runtime::ThreadPool::Current()->Launch(flambda, cdata, num_task, 1);
     return res;
 #else
     if (num_task == 0) num_task = num_workers;
@@ -503,6 +1224,9 @@ int TVMBackendParallelBarrier(int task_id, TVMParallelGroupEnv* penv) {
 #pragma omp barrier
 #else
   using tvm::runtime::kSyncStride;
+  ICHECK(penv->sync_handle != nullptr)
+      << "TVMBackendParallelBarrier is not supported by the work-stealing thread pool, "
+      << "unset TVM_THREAD_POOL_WORK_STEALING to run kernels that synchronize between tasks";
   int num_task = penv->num_task;
   std::atomic<int>* sync_counter = reinterpret_cast<std::atomic<int>*>(penv->sync_handle);
   int old_counter = sync_counter[task_id * kSyncStride].fetch_add(1, std::memory_order_release);
@@ -34,6 +34,8 @@
 #endif
 #if defined(__linux__)
 #include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #endif
 #if defined(__hexagon__)
 extern "C" {
@@ -46,6 +48,7 @@ extern "C" {
 #define HEXAGON_STACK_ALIGNMENT 32
 #endif
 #include <algorithm>
+#include <string>
 #include <thread>
 #define CURRENT_THREAD_HANDLE (static_cast<std::thread::native_handle_type>(0))
 namespace tvm {
@@ -431,6 +434,111 @@ int MaxConcurrency() {
   return std::max(max_concurrency, 1);
 }
 
+namespace {
+/*! \brief The NUMA node the current thread is bound to, -1 if it is not bound. */
+thread_local int numa_node = -1;
+
+#if defined(__linux__)
+/*!
+ * \brief Parse a sysfs list such as "0-3,8-11".
+ * \param str The list to parse.
+ * \return The ids in the list.
+ */
+std::vector<unsigned int> ParseSysfsList(const std::string& str) {
+  std::vector<unsigned int> ids;
+  std::istringstream is(str);
+  std::string range;
+  while (std::getline(is, range, ',')) {
+    if (range.empty() || range == "\n") continue;
+    size_t dash = range.find('-');
+    unsigned int begin = std::stoul(range.substr(0, dash));
+    unsigned int end = dash == std::string::npos ? begin : std::stoul(range.substr(dash + 1));
+    for (unsigned int id = begin; id <= end; ++id) {
+      ids.push_back(id);
+    }
+  }
+  return ids;
+}
+
+/*!
+ * \brief Read the first line of a sysfs file.
+ * \param path The path of the file.
+ * \param out The content of the line.
+ * \return Whether the file exists.
+ */
+bool ReadSysfsLine(const std::string& path, std::string* out) {
+  std::ifstream ifs(path);
+  if (ifs.fail()) return false;
+  std::getline(ifs, *out);
+  return true;
+}
+#endif
+}  // namespace
+
+int NumaNodeCount() {
+#if defined(__linux__)
+  std::string online;
+  if (ReadSysfsLine("/sys/devices/system/node/online", &online)) {
+    std::vector<unsigned int> nodes = ParseSysfsList(online);
+    if (!nodes.empty()) {
+      return static_cast<int>(*std::max_element(nodes.begin(), nodes.end())) + 1;
+    }
+  }
+#endif
+  return 1;
+}
+
+std::vector<unsigned int> NumaNodeCpus(int node) {
+  ICHECK_GE(node, 0) << "Invalid NUMA node " << node;
+#if defined(__linux__)
+  std::string cpulist;
+  std::ostringstream path;
+  path << "/sys/devices/system/node/node" << node << "/cpulist";
+  if (ReadSysfsLine(path.str(), &cpulist)) {
+    return ParseSysfsList(cpulist);
+  }
+#endif
+  ICHECK_EQ(node, 0) << "NUMA node " << node << " does not exist";
+  std::vector<unsigned int> cpus;
+  for (unsigned int i = 0; i < std::thread::hardware_concurrency(); ++i) {
+    cpus.push_back(i);
+  }
+  return cpus;
+}
+
+void ConfigureNumaNode(int node, int nthreads) {
+  std::vector<unsigned int> cpus = NumaNodeCpus(node);
+  ICHECK(!cpus.empty()) << "NUMA node " << node << " has no CPUs";
+  if (nthreads > 0 && static_cast<size_t>(nthreads) < cpus.size()) {
+    cpus.resize(nthreads);
+  }
+  Configure(ThreadGroup::kSpecifyOneCorePerThread, 0, cpus);
+  numa_node = node;
+}
+
+int CurrentNumaNode() { return numa_node; }
+
+bool BindMemoryToNumaNode(void* ptr, size_t nbytes, int node) {
+#if defined(__linux__) && defined(SYS_mbind)
+  // Values from <numaif.h>, spelled out to avoid depending on libnuma.
+  constexpr int kMPolPreferred = 1;
+  constexpr unsigned kMPolMFMove = 1 << 1;
+  constexpr size_t kBitsPerMask = 8 * sizeof(unsigned long);  // NOLINT(*)
+  if (ptr == nullptr || nbytes == 0 || node < 0) return false;
+  std::vector<unsigned long> nodemask(node / kBitsPerMask + 1, 0);  // NOLINT(*)
+  nodemask[node / kBitsPerMask] |= 1UL << (node % kBitsPerMask);
+  // mbind works on whole pages.
+  const uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  uintptr_t begin = reinterpret_cast<uintptr_t>(ptr) & ~(page_size - 1);
+  uintptr_t end = reinterpret_cast<uintptr_t>(ptr) + nbytes;
+  long ret = syscall(SYS_mbind, begin, end - begin, kMPolPreferred, nodemask.data(),  // NOLINT(*)
+                     nodemask.size() * kBitsPerMask + 1, kMPolMFMove);
+  return ret == 0;
+#else
+  return false;
+#endif
+}
+
 }  // namespace threading
 }  // namespace runtime
 }  // namespace tvm
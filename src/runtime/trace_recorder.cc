@@ -0,0 +1,201 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file trace_recorder.cc
+ * \brief Low overhead recorder of Chrome/Perfetto trace events.
+ */
+#include "trace_recorder.h"
+
+#include <tvm/runtime/container/string.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "../support/str_escape.h"
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+std::atomic<bool> TraceRecorder::enabled_{false};
+
+TraceRecorder* TraceRecorder::Global() {
+  // never destroyed, threads may still record while the process exits.
+  static TraceRecorder* inst = new TraceRecorder();
+  return inst;
+}
+
+void TraceRecorder::Start(size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ICHECK_GT(capacity, 0U) << "trace buffer capacity must be positive";
+  size_t size = 1;
+  while (size < capacity) size <<= 1;
+  enabled_.store(false);
+  // A thread that saw the recorder enabled may still be writing into the
+  // current buffer, so it is only grown, never freed.
+  if (size > allocated_) {
+    static std::vector<std::unique_ptr<Event[]>> retired;
+    if (events_ != nullptr) retired.push_back(std::move(events_));
+    events_.reset(new Event[size]);
+    allocated_ = size;
+  }
+  mask_ = size - 1;
+  for (size_t i = 0; i < allocated_; ++i) {
+    events_[i].seq.store(0, std::memory_order_relaxed);
+  }
+  head_.store(0);
+  drained_ = 0;
+  drained_lanes_ = 0;
+  drained_devices_ = 0;
+  origin_ns_ = NowNanos();
+  enabled_.store(true);
+}
+
+void TraceRecorder::Stop() { enabled_.store(false); }
+
+int TraceRecorder::ThreadLane() {
+  thread_local int lane = -1;
+  if (lane < 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lane = static_cast<int>(lane_names_.size());
+    lane_names_.push_back("thread " + std::to_string(lane));
+  }
+  return lane;
+}
+
+void TraceRecorder::SetThreadName(const std::string& name) {
+  int lane = ThreadLane();
+  std::lock_guard<std::mutex> lock(mutex_);
+  lane_names_[lane] = name;
+  // emit the new name with the next drain.
+  drained_lanes_ = std::min(drained_lanes_, static_cast<size_t>(lane));
+}
+
+int TraceRecorder::DeviceProcess(Device dev) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    if (devices_[i].device_type == dev.device_type && devices_[i].device_id == dev.device_id) {
+      return static_cast<int>(i) + 1;
+    }
+  }
+  devices_.push_back(dev);
+  return static_cast<int>(devices_.size());
+}
+
+void TraceRecorder::Record(const char* category, const char* name, int64_t begin_ns,
+                           int64_t end_ns, int process, int lane) {
+  if (lane < 0) lane = ThreadLane();
+  uint64_t index = head_.fetch_add(1, std::memory_order_relaxed);
+  Event& event = events_[index & mask_];
+  event.seq.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  event.category = category;
+  std::strncpy(event.name, name, kMaxNameLength);
+  event.name[kMaxNameLength] = '\0';
+  event.begin_ns = begin_ns;
+  event.duration_ns = std::max<int64_t>(end_ns - begin_ns, 0);
+  event.process = process;
+  event.lane = lane;
+  event.seq.store(2 * index + 2, std::memory_order_release);
+}
+
+std::string TraceRecorder::Drain() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(3);
+  auto metadata = [&os](const char* kind, int process, int lane, const std::string& name) {
+    os << "{\"name\":\"" << kind << "\",\"ph\":\"M\",\"pid\":" << process << ",\"tid\":" << lane
+       << ",\"args\":{\"name\":\"" << support::StrEscape(name) << "\"}},\n";
+  };
+  if (drained_lanes_ == 0 && drained_devices_ == 0) {
+    metadata("process_name", kHostProcess, 0, "host");
+  }
+  for (; drained_lanes_ < lane_names_.size(); ++drained_lanes_) {
+    metadata("thread_name", kHostProcess, drained_lanes_, lane_names_[drained_lanes_]);
+  }
+  for (; drained_devices_ < devices_.size(); ++drained_devices_) {
+    Device dev = devices_[drained_devices_];
+    int process = static_cast<int>(drained_devices_) + 1;
+    metadata("process_name", process, 0,
+             std::string(DeviceName(dev.device_type)) + "(" + std::to_string(dev.device_id) + ")");
+    metadata("thread_name", process, 0, "stream");
+  }
+  if (events_ == nullptr) return os.str();
+
+  uint64_t head = head_.load(std::memory_order_acquire);
+  uint64_t begin = std::max(drained_, head > mask_ + 1 ? head - mask_ - 1 : 0);
+  if (begin > drained_) {
+    LOG(WARNING) << "Trace buffer overflowed, " << begin - drained_ << " events were dropped";
+  }
+  uint64_t index = begin;
+  for (; index < head; ++index) {
+    Event& slot = events_[index & mask_];
+    uint64_t seq = slot.seq.load(std::memory_order_acquire);
+    // not written yet, pick it up with the next drain.
+    if (seq < 2 * index + 2) break;
+    Event event;
+    event.category = slot.category;
+    std::memcpy(event.name, slot.name, sizeof(event.name));
+    event.begin_ns = slot.begin_ns;
+    event.duration_ns = slot.duration_ns;
+    event.process = slot.process;
+    event.lane = slot.lane;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // skip events overwritten by a later lap of the ring.
+    if (seq != 2 * index + 2 || slot.seq.load(std::memory_order_relaxed) != seq) continue;
+    os << "{\"name\":\"" << support::StrEscape(event.name) << "\",\"cat\":\"" << event.category
+       << "\",\"ph\":\"X\",\"ts\":" << (event.begin_ns - origin_ns_) / 1000.0
+       << ",\"dur\":" << event.duration_ns / 1000.0 << ",\"pid\":" << event.process
+       << ",\"tid\":" << event.lane << "},\n";
+  }
+  drained_ = index;
+  return os.str();
+}
+
+TVM_REGISTER_GLOBAL("runtime.profiling.TraceStart").set_body_typed([](int64_t capacity) {
+  TraceRecorder::Global()->Start(capacity);
+});
+
+TVM_REGISTER_GLOBAL("runtime.profiling.TraceStop").set_body_typed([]() {
+  TraceRecorder::Global()->Stop();
+});
+
+TVM_REGISTER_GLOBAL("runtime.profiling.TraceDrain").set_body_typed([]() {
+  return String(TraceRecorder::Global()->Drain());
+});
+
+TVM_REGISTER_GLOBAL("runtime.profiling.TraceFlush").set_body_typed([](String path, bool append) {
+  std::ofstream fs(path, append ? std::ios::app : std::ios::trunc);
+  ICHECK(fs) << "Cannot open trace file " << path;
+  // Chrome and Perfetto accept a JSON array without the closing bracket, so
+  // the file can grow by appending drains.
+  if (!append) fs << "[\n";
+  fs << TraceRecorder::Global()->Drain();
+});
+
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
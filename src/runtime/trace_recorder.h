@@ -0,0 +1,174 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file trace_recorder.h
+ * \brief Low overhead recorder of Chrome/Perfetto trace events.
+ *
+ * Events are written into a fixed size ring buffer as they happen and
+ * drained into Chrome's JSON trace format on demand, so a trace can be
+ * streamed to a file while the program runs. When the buffer is full the
+ * oldest events are overwritten.
+ */
+#ifndef TVM_RUNTIME_TRACE_RECORDER_H_
+#define TVM_RUNTIME_TRACE_RECORDER_H_
+
+#include <tvm/runtime/ndarray.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+class TraceRecorder {
+ public:
+  /*! \brief Trace process of the host threads. */
+  static constexpr int kHostProcess = 0;
+
+  /*! \return The process wide recorder. */
+  static TraceRecorder* Global();
+
+  /*! \return Whether events are being recorded. Cheap enough to check on hot paths. */
+  static bool Enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /*! \return The current time on the trace clock in nanoseconds. */
+  static int64_t NowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  /*!
+   * \brief Start recording and drop all events recorded so far.
+   * \param capacity Number of events the ring buffer holds, rounded up to a power of two.
+   */
+  void Start(size_t capacity);
+
+  /*! \brief Stop recording. Recorded events can still be drained. */
+  void Stop();
+
+  /*!
+   * \brief Record a complete event.
+   * \param category Category of the event, must be a string literal.
+   * \param name Name of the event, truncated to kMaxNameLength characters.
+   * \param begin_ns Start of the event on the trace clock.
+   * \param end_ns End of the event on the trace clock.
+   * \param process Trace process of the event, kHostProcess or one from DeviceProcess.
+   * \param lane Trace thread of the event, -1 for the lane of the calling thread.
+   */
+  void Record(const char* category, const char* name, int64_t begin_ns, int64_t end_ns,
+              int process = kHostProcess, int lane = -1);
+
+  /*!
+   * \brief Get the trace process of a device, the process shows one lane per stream.
+   * \param dev The device.
+   * \return The process id.
+   */
+  int DeviceProcess(Device dev);
+
+  /*!
+   * \brief Name the lane of the calling thread, e.g. "thread pool worker 1".
+   * \param name The name shown for the lane.
+   */
+  void SetThreadName(const std::string& name);
+
+  /*!
+   * \brief Drain the events recorded since the last drain.
+   * \return The events along with the process and lane names in Chrome's JSON
+   *  array format, each element followed by ",\n". Concatenating the results
+   *  of successive calls after a leading "[" gives a valid trace.
+   */
+  std::string Drain();
+
+  /*! \brief Maximum length of a recorded event name. */
+  static constexpr size_t kMaxNameLength = 63;
+
+ private:
+  struct Event {
+    /*! \brief 2 * index + 2 once the event at index was written, odd while writing. */
+    std::atomic<uint64_t> seq{0};
+    const char* category;
+    char name[kMaxNameLength + 1];
+    int64_t begin_ns;
+    int64_t duration_ns;
+    int32_t process;
+    int32_t lane;
+  };
+
+  /*! \return The lane of the calling thread. */
+  int ThreadLane();
+
+  static std::atomic<bool> enabled_;
+  std::unique_ptr<Event[]> events_;
+  /*! \brief Number of allocated events, at least mask_ + 1. */
+  size_t allocated_{0};
+  uint64_t mask_{0};
+  /*! \brief Index of the next event to write. */
+  std::atomic<uint64_t> head_{0};
+  /*! \brief Index of the next event to drain. */
+  uint64_t drained_{0};
+  /*! \brief Guards the fields below and drains. */
+  std::mutex mutex_;
+  std::vector<std::string> lane_names_;
+  std::vector<Device> devices_;
+  /*! \brief Number of lane and process names already drained. */
+  size_t drained_lanes_{0};
+  size_t drained_devices_{0};
+  /*! \brief Start of the trace, timestamps are relative to it. */
+  int64_t origin_ns_{0};
+};
+
+/*! \brief Record the lifetime of a scope as a trace event of the calling thread. */
+class TraceScope {
+ public:
+  /*!
+   * \param category Category of the event, must be a string literal.
+   * \param name Name of the event.
+   */
+  TraceScope(const char* category, const char* name) {
+    if (TraceRecorder::Enabled()) {
+      category_ = category;
+      name_ = name;
+      begin_ns_ = TraceRecorder::NowNanos();
+    }
+  }
+  ~TraceScope() {
+    if (category_ != nullptr && TraceRecorder::Enabled()) {
+      TraceRecorder::Global()->Record(category_, name_, begin_ns_, TraceRecorder::NowNanos());
+    }
+  }
+
+ private:
+  const char* category_{nullptr};
+  const char* name_{nullptr};
+  int64_t begin_ns_{0};
+};
+
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_TRACE_RECORDER_H_
@@ -0,0 +1,297 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file runtime/arena_allocator.h
+ */
+#ifndef TVM_RUNTIME_VM_ARENA_ALLOCATOR_H_
+#define TVM_RUNTIME_VM_ARENA_ALLOCATOR_H_
+
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/threading_backend.h>
+#include <tvm/runtime/vm/memory_manager.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+/*!
+ * \brief An allocator carving best-fit sub-allocations out of large device arenas.
+ *
+ *  Unlike PooledAllocator, which only reuses a buffer for a request of exactly the
+ *  same size, freed blocks are coalesced with their free neighbours and can serve any
+ *  smaller request. This keeps the memory bounded when the shapes vary from run to run.
+ *
+ *  The sub-allocations are addressed with pointer arithmetic on the arena, so this only
+ *  works on devices with a flat address space, see `SupportsDevice`.
+ */
+class ArenaAllocator final : public Allocator {
+ public:
+  static constexpr size_t kDefaultArenaSize = 64 << 20;
+  static constexpr size_t kBlockAlignment = 256;
+
+  explicit ArenaAllocator(Device dev, size_t arena_size = DefaultArenaSize())
+      : Allocator(kArena), arena_size_(arena_size), device_(dev) {}
+
+  ~ArenaAllocator() {
+    for (auto const& arena : arenas_) {
+      DeviceAPI::Get(device_)->FreeDataSpace(device_, arena->data);
+    }
+  }
+
+  /*! \brief Whether the data pointers of the device support pointer arithmetic. */
+  static bool SupportsDevice(Device dev) {
+    switch (static_cast<int>(dev.device_type)) {
+      case kDLCPU:
+      case kDLCUDA:
+      case kDLCUDAHost:
+      case kDLCUDAManaged:
+      case kDLROCM:
+      case kDLROCMHost:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  /*! \brief The arena size, from TVM_VM_ARENA_SIZE_MB or kDefaultArenaSize. */
+  static size_t DefaultArenaSize() {
+    const char* val = getenv("TVM_VM_ARENA_SIZE_MB");
+    if (val == nullptr || atoll(val) <= 0) return kDefaultArenaSize;
+    return static_cast<size_t>(atoll(val)) << 20;
+  }
+
+  Buffer Alloc(size_t nbytes, size_t alignment, DLDataType type_hint) override {
+    std::lock_guard<std::mutex> lock(mu_);
+    size_t size = RoundUp(std::max<size_t>(nbytes, 1));
+    Buffer buf;
+    buf.device = device_;
+    buf.size = size;
+    // Step 1. Best fit among the free blocks
+    auto it = alignment <= kBlockAlignment ? free_index_.lower_bound(FreeKey(size, nullptr, 0))
+                                           : free_index_.end();
+    if (it == free_index_.end()) {
+      // Step 2. No free block is large enough, get a new arena
+      Arena* arena = NewArena(size, alignment, type_hint);
+      it = free_index_.find(FreeKey(arena->size, arena, 0));
+      ICHECK(it != free_index_.end());
+    }
+    size_t block_size;
+    Arena* arena;
+    size_t offset;
+    std::tie(block_size, arena, offset) = *it;
+    free_index_.erase(it);
+    arena->free_blocks.erase(offset);
+    if (arena->live_bytes == 0) --num_empty_arenas_;
+    if (block_size > size) {
+      AddFreeBlock(arena, offset + size, block_size - size);
+    }
+    arena->live_bytes += size;
+    buf.data = static_cast<char*>(arena->data) + offset;
+    allocated_[buf.data] = Block{arena, offset, size};
+    live_bytes_ += size;
+    peak_live_bytes_ = std::max(peak_live_bytes_, live_bytes_);
+    VLOG(1) << "allocate " << size << " B at offset " << offset << ", live " << live_bytes_
+            << " B, reserved " << reserved_bytes_ << " B";
+    return buf;
+  }
+
+  void Free(const Buffer& buffer) override {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = allocated_.find(buffer.data);
+    ICHECK(it != allocated_.end()) << "trying to free a buffer not allocated by this allocator";
+    Block block = it->second;
+    allocated_.erase(it);
+    Arena* arena = block.arena;
+    size_t offset = block.offset;
+    size_t size = block.size;
+    arena->live_bytes -= size;
+    live_bytes_ -= size;
+    // Coalesce with the following and the preceding free blocks
+    auto next = arena->free_blocks.lower_bound(offset);
+    if (next != arena->free_blocks.end() && next->first == offset + size) {
+      size += next->second;
+      RemoveFreeBlock(arena, next);
+    }
+    auto prev = arena->free_blocks.lower_bound(offset);
+    if (prev != arena->free_blocks.begin()) {
+      --prev;
+      if (prev->first + prev->second == offset) {
+        offset = prev->first;
+        size += prev->second;
+        RemoveFreeBlock(arena, prev);
+      }
+    }
+    AddFreeBlock(arena, offset, size);
+    VLOG(1) << "reclaim buffer " << block.size << ", live " << live_bytes_ << " B";
+    if (arena->live_bytes == 0) {
+      // Keep a single empty arena around to avoid thrashing, release the others.
+      if (num_empty_arenas_ == 0) {
+        ++num_empty_arenas_;
+      } else {
+        ReleaseArena(arena);
+      }
+    }
+  }
+
+  size_t UsedMemory() const override {
+    std::lock_guard<std::mutex> lock(mu_);
+    return reserved_bytes_;
+  }
+
+  AllocatorStats GetStats() const override {
+    std::lock_guard<std::mutex> lock(mu_);
+    AllocatorStats stats;
+    stats.live_bytes = live_bytes_;
+    stats.peak_live_bytes = peak_live_bytes_;
+    stats.reserved_bytes = reserved_bytes_;
+    stats.peak_reserved_bytes = peak_reserved_bytes_;
+    if (!free_index_.empty()) {
+      stats.largest_free_block = std::get<0>(*free_index_.rbegin());
+    }
+    size_t free_bytes = reserved_bytes_ - live_bytes_;
+    if (free_bytes != 0) {
+      stats.fragmentation = 1.0 - static_cast<double>(stats.largest_free_block) / free_bytes;
+    }
+    return stats;
+  }
+
+ private:
+  /*! \brief A device allocation sub-allocations are carved from. */
+  struct Arena {
+    void* data;
+    size_t size;
+    size_t live_bytes;
+    /*! \brief The free blocks, offset to size. */
+    std::map<size_t, size_t> free_blocks;
+  };
+  /*! \brief A live sub-allocation. */
+  struct Block {
+    Arena* arena;
+    size_t offset;
+    size_t size;
+  };
+  /*! \brief The key of a free block in the best-fit index: size, arena and offset. */
+  using FreeKey = std::tuple<size_t, Arena*, size_t>;
+
+  static size_t RoundUp(size_t nbytes) {
+    return (nbytes + kBlockAlignment - 1) / kBlockAlignment * kBlockAlignment;
+  }
+
+  void AddFreeBlock(Arena* arena, size_t offset, size_t size) {
+    arena->free_blocks.emplace(offset, size);
+    free_index_.emplace(size, arena, offset);
+  }
+
+  void RemoveFreeBlock(Arena* arena, std::map<size_t, size_t>::iterator it) {
+    free_index_.erase(FreeKey(it->second, arena, it->first));
+    arena->free_blocks.erase(it);
+  }
+
+  Arena* NewArena(size_t size, size_t alignment, DLDataType type_hint) {
+    // A stricter alignment than the blocks get a dedicated arena.
+    size_t arena_size = alignment <= kBlockAlignment ? std::max(arena_size_, size) : size;
+    alignment = std::max(alignment, kBlockAlignment);
+    DeviceAPI* api = DeviceAPI::Get(device_);
+    void* data;
+    try {
+      data = api->AllocDataSpace(device_, arena_size, alignment, type_hint);
+    } catch (InternalError& err) {
+      LOG(WARNING) << "ArenaAllocator got InternalError during allocation: " << err.message();
+      LOG(WARNING) << "Trying to release all empty arenas and reallocate...";
+      ReleaseEmptyArenas();
+      try {
+        data = api->AllocDataSpace(device_, arena_size, alignment, type_hint);
+      } catch (InternalError&) {
+        if (arena_size == size) throw;
+        // A whole arena does not fit any more, fall back to the requested size.
+        arena_size = size;
+        data = api->AllocDataSpace(device_, arena_size, alignment, type_hint);
+      }
+    }
+    // An arena allocated by a thread bound to a NUMA node stays on that node, binding it once
+    // instead of every sub-allocation.
+    int numa_node = threading::CurrentNumaNode();
+    if (device_.device_type == kDLCPU && numa_node >= 0) {
+      threading::BindMemoryToNumaNode(data, arena_size, numa_node);
+    }
+    arenas_.emplace_back(new Arena{data, arena_size, 0, {}});
+    Arena* arena = arenas_.back().get();
+    AddFreeBlock(arena, 0, arena_size);
+    ++num_empty_arenas_;
+    reserved_bytes_ += arena_size;
+    peak_reserved_bytes_ = std::max(peak_reserved_bytes_, reserved_bytes_);
+    VLOG(1) << "new arena of " << arena_size << " B, reserved " << reserved_bytes_ << " B";
+    return arena;
+  }
+
+  void ReleaseArena(Arena* arena) {
+    ICHECK_EQ(arena->live_bytes, 0);
+    for (auto const& kv : arena->free_blocks) {
+      free_index_.erase(FreeKey(kv.second, arena, kv.first));
+    }
+    DeviceAPI::Get(device_)->FreeDataSpace(device_, arena->data);
+    reserved_bytes_ -= arena->size;
+    auto it = std::find_if(arenas_.begin(), arenas_.end(),
+                           [arena](const std::unique_ptr<Arena>& a) { return a.get() == arena; });
+    arenas_.erase(it);
+  }
+
+  void ReleaseEmptyArenas() {
+    std::vector<Arena*> empty;
+    for (auto const& arena : arenas_) {
+      if (arena->live_bytes == 0) empty.push_back(arena.get());
+    }
+    for (Arena* arena : empty) {
+      ReleaseArena(arena);
+    }
+    num_empty_arenas_ = 0;
+    VLOG(1) << "release all empty arenas";
+  }
+
+ private:
+  size_t arena_size_;
+  std::vector<std::unique_ptr<Arena>> arenas_;
+  /*! \brief All free blocks, ordered by size for best-fit lookup. */
+  std::set<FreeKey> free_index_;
+  std::unordered_map<void*, Block> allocated_;
+  size_t num_empty_arenas_{0};
+  size_t live_bytes_{0};
+  size_t peak_live_bytes_{0};
+  size_t reserved_bytes_{0};
+  size_t peak_reserved_bytes_{0};
+  mutable std::mutex mu_;
+  Device device_;
+};
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_VM_ARENA_ALLOCATOR_H_
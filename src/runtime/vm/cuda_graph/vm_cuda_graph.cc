@@ -0,0 +1,382 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/vm/cuda_graph/vm_cuda_graph.cc
+ * \brief The Relay virtual machine replaying CUDA graphs.
+ */
+
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/runtime/vm/vm.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../cuda/cuda_common.h"
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+/*!
+ * \brief Virtual machine with CUDA Graph support.
+ *
+ *  Most dynamic models only see a handful of input shapes, and for a given shape the sequence
+ *  of kernels a function launches does not change. This VM captures the kernels launched by an
+ *  invocation of a function in a CUDA graph, keyed by the shapes of the inputs, and replays the
+ *  instantiated graph when the same shapes recur, skipping both the interpreter and the kernel
+ *  launch overhead.
+ *
+ *  The first invocation with a new input signature runs eagerly, so that the constants are
+ *  uploaded, the kernels loaded and the allocator warmed up. The second one captures the
+ *  graph on a private stream. The storage allocated from the VM allocators during the capture,
+ *  as well as a copy of the inputs, is kept with the graph so that its addresses stay valid for
+ *  the replays; the inputs of each replay are copied into these buffers.
+ *
+ *  A function is only captured when all its inputs are tensors on the CUDA device and it never
+ *  copies tensors across devices. A capture also fails, and the signature then always runs
+ *  eagerly, when the host needs device results during the invocation, e.g. for data dependent
+ *  control flow or output shapes.
+ *
+ * \note The outputs of a replay are the tensors captured with the graph, i.e. each replay
+ *  overwrites the outputs of the previous one of the same signature.
+ */
+class VirtualMachineCudaGraph : public VirtualMachine {
+ public:
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final;
+
+  ~VirtualMachineCudaGraph() {
+    graphs_.clear();
+    if (stream_ != nullptr) {
+      CUDA_CALL(cudaStreamDestroy(stream_));
+    }
+  }
+
+ private:
+  /*! \brief A captured invocation. */
+  struct CudaGraphEntry {
+    /*! \brief The number of eager invocations with the signature. */
+    int num_eager_runs = 0;
+    /*! \brief Whether capturing the invocation failed. */
+    bool failed = false;
+    /*! \brief The instantiated graph, null until captured. */
+    cudaGraphExec_t exec = nullptr;
+    /*! \brief The input buffers read by the graph. */
+    std::vector<NDArray> inputs;
+    /*! \brief The storage allocated during the capture, kept alive for the replays. */
+    std::vector<ObjectRef> storages;
+    /*! \brief The result of the invocation, written by the graph. */
+    ObjectRef result;
+
+    ~CudaGraphEntry() {
+      if (exec != nullptr) {
+        CUDA_CALL(cudaGraphExecDestroy(exec));
+      }
+    }
+  };
+
+  void OpStartHook(const Instruction& instr) final {
+    if (recording_ != nullptr && instr.op == Opcode::AllocStorage) {
+      recording_reg_ = instr.dst;
+    }
+  }
+
+  void OpStopHook() final {
+    if (recording_reg_ >= 0) {
+      recording_->push_back(ReadRegister(recording_reg_));
+      recording_reg_ = -1;
+    }
+  }
+
+  /*! \brief Invoke a function, replaying or capturing its CUDA graph when possible. */
+  ObjectRef InvokeWithCudaGraph(const VMFunction& func, const std::vector<ObjectRef>& args);
+
+  /*!
+   * \brief Capture an invocation in a CUDA graph and launch it.
+   * \return Whether the capture succeeded, when it did the result is in the return register.
+   */
+  bool CaptureAndLaunch(const VMFunction& func, const std::vector<ObjectRef>& args,
+                        CudaGraphEntry* entry);
+
+  /*! \brief Launch a captured graph on the given inputs. */
+  void Launch(CudaGraphEntry* entry, const std::vector<ObjectRef>& args);
+
+  /*!
+   * \brief Get the key of the input signature of an invocation.
+   * \return Whether the invocation can be captured.
+   */
+  bool GetSignature(const VMFunction& func, const std::vector<ObjectRef>& args,
+                    std::string* key) const;
+
+  /*! \brief Whether the function and all the functions it calls stay on their devices. */
+  bool IsCapturable(Index func_index);
+
+  /*! \brief The CUDA device, when it is the only device besides the host. */
+  bool GetCudaDevice(Device* dev) const;
+
+  /*! \brief The captured graphs by input signature. */
+  std::unordered_map<std::string, std::unique_ptr<CudaGraphEntry>> graphs_;
+  /*! \brief Whether each function can be captured, -1 when not computed yet. */
+  std::vector<int> capturable_;
+  /*! \brief The maximum number of signatures to capture. */
+  size_t max_graphs_ = 16;
+  /*! \brief The stream the graphs are captured and launched on. */
+  cudaStream_t stream_ = nullptr;
+  /*! \brief The storage allocated during the capture in progress. */
+  std::vector<ObjectRef>* recording_ = nullptr;
+  /*! \brief The register of the storage being allocated during a capture. */
+  Index recording_reg_ = -1;
+  /*! \brief The number of captures, failed captures and graph launches. */
+  int64_t num_captures_ = 0;
+  int64_t num_failed_captures_ = 0;
+  int64_t num_launches_ = 0;
+};
+
+bool VirtualMachineCudaGraph::GetCudaDevice(Device* dev) const {
+  int num_cuda = 0;
+  for (const Device& d : devices_) {
+    if (d.device_type == kDLCUDA) {
+      *dev = d;
+      ++num_cuda;
+    } else if (d.device_type != kDLCPU) {
+      return false;
+    }
+  }
+  return num_cuda == 1;
+}
+
+bool VirtualMachineCudaGraph::IsCapturable(Index func_index) {
+  if (capturable_.size() != exec_->functions.size()) {
+    capturable_.assign(exec_->functions.size(), -1);
+  }
+  if (capturable_[func_index] >= 0) return capturable_[func_index];
+  // Assume capturable while visiting, so that recursive calls terminate.
+  capturable_[func_index] = 1;
+  bool capturable = true;
+  for (const Instruction& instr : exec_->functions[func_index].instructions) {
+    if (instr.op == Opcode::DeviceCopy) {
+      capturable = false;
+    } else if (instr.op == Opcode::Invoke || instr.op == Opcode::AllocClosure) {
+      capturable = IsCapturable(instr.func_index);
+    }
+    if (!capturable) break;
+  }
+  capturable_[func_index] = capturable;
+  return capturable;
+}
+
+bool VirtualMachineCudaGraph::GetSignature(const VMFunction& func,
+                                           const std::vector<ObjectRef>& args,
+                                           std::string* key) const {
+  auto append = [key](int64_t value) {
+    key->append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  *key = func.name;
+  key->push_back('\0');
+  for (const ObjectRef& arg : args) {
+    const auto* tensor = arg.as<NDArray::ContainerType>();
+    if (tensor == nullptr || tensor->dl_tensor.device.device_type != kDLCUDA) {
+      return false;
+    }
+    const DLTensor& dl_tensor = tensor->dl_tensor;
+    append(dl_tensor.device.device_id);
+    append((dl_tensor.dtype.code << 24) | (dl_tensor.dtype.bits << 16) | dl_tensor.dtype.lanes);
+    append(dl_tensor.ndim);
+    for (int i = 0; i < dl_tensor.ndim; ++i) {
+      append(dl_tensor.shape[i]);
+    }
+  }
+  return true;
+}
+
+ObjectRef VirtualMachineCudaGraph::InvokeWithCudaGraph(const VMFunction& func,
+                                                       const std::vector<ObjectRef>& args) {
+  static const bool stream_ordered_alloc = []() {
+    const char* val = getenv("TVM_CUDA_STREAM_ORDERED_ALLOC");
+    return val != nullptr && atoi(val) != 0;
+  }();
+  Device dev;
+  std::string key;
+  if (stream_ordered_alloc || !GetCudaDevice(&dev) || !GetSignature(func, args, &key) ||
+      !IsCapturable(exec_->global_map.at(func.name))) {
+    return Invoke(func, args);
+  }
+  auto it = graphs_.find(key);
+  if (it == graphs_.end()) {
+    if (graphs_.size() >= max_graphs_) {
+      return Invoke(func, args);
+    }
+    it = graphs_.emplace(key, std::make_unique<CudaGraphEntry>()).first;
+  }
+  CudaGraphEntry* entry = it->second.get();
+  if (entry->exec != nullptr) {
+    Launch(entry, args);
+    return return_register_;
+  }
+  // Warm up with an eager run before capturing.
+  if (entry->failed || entry->num_eager_runs++ == 0) {
+    return Invoke(func, args);
+  }
+  if (stream_ == nullptr) {
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    CUDA_CALL(cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking));
+  }
+  if (CaptureAndLaunch(func, args, entry)) {
+    return return_register_;
+  }
+  return Invoke(func, args);
+}
+
+bool VirtualMachineCudaGraph::CaptureAndLaunch(const VMFunction& func,
+                                               const std::vector<ObjectRef>& args,
+                                               CudaGraphEntry* entry) {
+  std::vector<ObjectRef> inputs;
+  for (size_t i = 0; i < args.size(); ++i) {
+    NDArray arg = Downcast<NDArray>(args[i]);
+    Allocator* allocator = GetAllocator(func.param_device_indexes[i]);
+    std::vector<int64_t> shape(arg->shape, arg->shape + arg->ndim);
+    entry->inputs.push_back(allocator->Empty(shape, arg->dtype, arg->device));
+    inputs.push_back(entry->inputs.back());
+  }
+
+  CUDAThreadEntry* thread_entry = CUDAThreadEntry::ThreadLocal();
+  cudaStream_t prev_stream = thread_entry->stream;
+  thread_entry->stream = stream_;
+  size_t num_frames = frames_.size();
+  recording_ = &entry->storages;
+  std::string error;
+  cudaError_t status = cudaStreamBeginCapture(stream_, cudaStreamCaptureModeRelaxed);
+  if (status == cudaSuccess) {
+    try {
+      Invoke(func, inputs);
+    } catch (const std::exception& e) {
+      error = e.what();
+      frames_.erase(frames_.begin() + num_frames, frames_.end());
+    }
+    cudaGraph_t graph = nullptr;
+    status = cudaStreamEndCapture(stream_, &graph);
+    if (error.empty() && status == cudaSuccess) {
+      status = cudaGraphInstantiate(&entry->exec, graph, nullptr, nullptr, 0);
+    }
+    if (graph != nullptr) {
+      CUDA_CALL(cudaGraphDestroy(graph));
+    }
+  }
+  recording_ = nullptr;
+  recording_reg_ = -1;
+  thread_entry->stream = prev_stream;
+
+  if (!error.empty() || status != cudaSuccess) {
+    // Clear the sticky error of the failed capture.
+    cudaGetLastError();
+    LOG(WARNING) << "Failed to capture a CUDA graph of " << func.name
+                 << ", the function runs without CUDA graph for these input shapes: "
+                 << (error.empty() ? cudaGetErrorString(status) : error);
+    entry->exec = nullptr;
+    entry->failed = true;
+    entry->inputs.clear();
+    entry->storages.clear();
+    ++num_failed_captures_;
+    return false;
+  }
+  entry->result = return_register_;
+  ++num_captures_;
+  Launch(entry, args);
+  return true;
+}
+
+void VirtualMachineCudaGraph::Launch(CudaGraphEntry* entry, const std::vector<ObjectRef>& args) {
+  for (size_t i = 0; i < args.size(); ++i) {
+    const NDArray& input = entry->inputs[i];
+    const DLTensor* arg = Downcast<NDArray>(args[i]).operator->();
+    if (arg->data != input->data) {
+      NDArray::CopyFromTo(arg, const_cast<DLTensor*>(input.operator->()), stream_);
+    }
+  }
+  CUDA_CALL(cudaGraphLaunch(entry->exec, stream_));
+  CUDA_CALL(cudaStreamSynchronize(stream_));
+  return_register_ = entry->result;
+  ++num_launches_;
+}
+
+PackedFunc VirtualMachineCudaGraph::GetFunction(const std::string& name,
+                                                const ObjectPtr<Object>& sptr_to_self) {
+  if (name == "invoke") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      ICHECK(exec_) << "The executable is not created yet.";
+      std::string func_name = args[0];
+      auto git = exec_->global_map.find(func_name);
+      ICHECK(git != exec_->global_map.end())
+          << "Cannot find function " << func_name << " in the executable";
+      const VMFunction& func = exec_->functions[git->second];
+      auto it = inputs_.find(func_name);
+      bool set_outputs = set_outputs_enabled_.count(func_name) && set_outputs_enabled_[func_name];
+      if (set_outputs || (!func.params.empty() && it == inputs_.end())) {
+        // Pre-allocated outputs are written in place, which a replay cannot do.
+        VirtualMachine::GetFunction("invoke", sptr_to_self).CallPacked(args, rv);
+        return;
+      }
+      *rv = InvokeWithCudaGraph(func, func.params.empty() ? std::vector<ObjectRef>() : it->second);
+    });
+  } else if (name == "set_max_cuda_graphs") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      int64_t max_graphs = args[0];
+      ICHECK_GE(max_graphs, 0);
+      max_graphs_ = max_graphs;
+    });
+  } else if (name == "clear_cuda_graphs") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { graphs_.clear(); });
+  } else if (name == "get_cuda_graph_stats") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      auto count = [](int64_t value) {
+        return ObjectRef(make_object<profiling::CountNode>(value));
+      };
+      int64_t num_graphs = 0;
+      for (const auto& kv : graphs_) {
+        num_graphs += kv.second->exec != nullptr;
+      }
+      *rv = Map<String, ObjectRef>{{"num_graphs", count(num_graphs)},
+                                   {"num_captures", count(num_captures_)},
+                                   {"num_failed_captures", count(num_failed_captures_)},
+                                   {"num_launches", count(num_launches_)}};
+    });
+  } else {
+    return VirtualMachine::GetFunction(name, sptr_to_self);
+  }
+}
+
+runtime::Module CreateVirtualMachineCudaGraph(Executable* exec) {
+  auto vm = make_object<VirtualMachineCudaGraph>();
+  vm->LoadExecutable(GetObjectPtr<Executable>(exec));
+  return runtime::Module(vm);
+}
+
+TVM_REGISTER_GLOBAL("runtime._VirtualMachineCudaGraph")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      runtime::Module mod = args[0];
+      auto* exec = dynamic_cast<Executable*>(mod.operator->());
+      *rv = CreateVirtualMachineCudaGraph(exec);
+    });
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
@@ -92,10 +92,15 @@ PackedFunc Executable::GetFunction(const std::string& name, const ObjectPtr<Obje
     });
   } else if (name == "move_late_bound_consts") {
     return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
-      CHECK_EQ(args.size(), 2);
+      CHECK(args.size() == 2 || args.size() == 3);
       std::string path = args[0];
       uint64_t byte_limit = args[1];
-      MoveLateBoundConstantsToFile(path, static_cast<size_t>(byte_limit));
+      bool mappable = args.size() == 3 && args[2].operator bool();
+      if (mappable) {
+        MoveLateBoundConstantsToMappableFile(path, static_cast<size_t>(byte_limit));
+      } else {
+        MoveLateBoundConstantsToFile(path, static_cast<size_t>(byte_limit));
+      }
     });
   } else if (name == "get_late_bound_consts") {
     return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
@@ -138,6 +143,23 @@ std::string Executable::GetFunctionParameterName(std::string func_name, uint32_t
   return func.params[index];
 }
 
+ObjectRef Executable::GetConstantOnDevice(Index const_index, Device dev) {
+  ICHECK_LT(const_index, constants.size()) << "Invalid constant index " << const_index;
+  std::lock_guard<std::mutex> lock(device_constants_mutex_);
+  std::vector<ObjectRef>& pool = device_constants_[dev];
+  if (pool.size() < constants.size()) {
+    pool.resize(constants.size());
+  }
+  if (!pool[const_index].defined()) {
+    NDArray constant = Downcast<NDArray>(constants[const_index]);
+    // Constants already on a device of the same type are used in place, like the VM does for
+    // its inputs.
+    pool[const_index] =
+        constant->device.device_type == dev.device_type ? constant : constant.CopyTo(dev);
+  }
+  return pool[const_index];
+}
+
 std::string Executable::GetBytecode() const {
   std::ostringstream oss;
 
@@ -360,6 +382,12 @@ void Executable::LoadLateBoundConstantsFromStream(dmlc::Stream* stream) {
 }
 
 void Executable::LoadLateBoundConstantsFromMap(Map<String, NDArray> map) {
+  {
+    // The copies of the previous constants on the devices are stale
+    std::lock_guard<std::mutex> lock(device_constants_mutex_);
+    device_constants_.clear();
+  }
+  ++constants_version_;
   for (size_t const_index = 0; const_index < constants.size(); ++const_index) {
     if (!late_bound_constant_names[const_index].defined()) {
       ICHECK(constants[const_index].defined())
@@ -379,10 +407,24 @@ void Executable::LoadLateBoundConstantsFromMap(Map<String, NDArray> map) {
 }
 
 void Executable::LoadLateBoundConstantsFromFile(const std::string& path) {
+  if (IsMappableParamsFile(path)) {
+    if (late_bound_constant_names.empty()) {
+      VLOG(1) << "Found no late-bound constants to load";
+      return;
+    }
+    // The CPU constants are used in place, the others are uploaded on first use by LoadConst.
+    LoadLateBoundConstantsFromMap(LoadMappedParams(path));
+    return;
+  }
   tvm::runtime::SimpleBinaryFileStream stream(path, "rb");
   LoadLateBoundConstantsFromStream(&stream);
 }
 
+void Executable::MoveLateBoundConstantsToMappableFile(const std::string& path,
+                                                       size_t byte_limit) {
+  SaveParamsToMappableFile(path, GetLateBoundConstants(byte_limit));
+}
+
 void Executable::SaveGlobalSection(dmlc::Stream* strm) {
   std::vector<std::pair<std::string, Index>> globals(this->global_map.begin(),
                                                      this->global_map.end());
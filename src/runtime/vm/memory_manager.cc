@@ -21,11 +21,14 @@
  * \file tvm/runtime/vm/memory_manager.cc
  * \brief Allocate and manage memory for the runtime.
  */
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
 #include <tvm/runtime/vm/memory_manager.h>
 
 #include <memory>
 #include <utility>
 
+#include "arena_allocator.h"
 #include "naive_allocator.h"
 #include "pooled_allocator.h"
 
@@ -130,6 +133,18 @@ Allocator* MemoryManager::GetOrCreateAllocator(Device dev, AllocatorType type) {
         alloc.reset(new PooledAllocator(dev));
         break;
       }
+      case kArena: {
+        if (!ArenaAllocator::SupportsDevice(dev)) {
+          LOG(WARNING) << "Arena allocator is not supported on " << DeviceName(dev.device_type)
+                       << ", use pooled allocator instead";
+          alloc.reset(new PooledAllocator(dev));
+          break;
+        }
+        VLOG(1) << "New arena allocator for " << DeviceName(dev.device_type) << "("
+                << dev.device_id << ")";
+        alloc.reset(new ArenaAllocator(dev));
+        break;
+      }
       default:
         LOG(FATAL) << "Unknown allocator type: " << type;
     }
@@ -170,6 +185,21 @@ NDArray Allocator::Empty(std::vector<int64_t> shape, DLDataType dtype, DLDevice
   return NDArray(GetObjectPtr<Object>(container));
 }
 
+TVM_REGISTER_GLOBAL("runtime.VMAllocatorStats").set_body_typed([](int device_type, int device_id) {
+  Device dev{static_cast<DLDeviceType>(device_type), device_id};
+  AllocatorStats stats = MemoryManager::GetAllocator(dev)->GetStats();
+  auto count = [](size_t value) {
+    return ObjectRef(make_object<profiling::CountNode>(static_cast<int64_t>(value)));
+  };
+  return Map<String, ObjectRef>{
+      {"live_bytes", count(stats.live_bytes)},
+      {"peak_live_bytes", count(stats.peak_live_bytes)},
+      {"reserved_bytes", count(stats.reserved_bytes)},
+      {"peak_reserved_bytes", count(stats.peak_reserved_bytes)},
+      {"largest_free_block", count(stats.largest_free_block)},
+      {"fragmentation", ObjectRef(make_object<profiling::PercentNode>(stats.fragmentation * 100))}};
+});
+
 }  // namespace vm
 }  // namespace runtime
 }  // namespace tvm
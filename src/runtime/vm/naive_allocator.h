@@ -41,7 +41,10 @@ class NaiveAllocator final : public Allocator {
     buf.device = device_;
     buf.size = nbytes;
     buf.data = DeviceAPI::Get(device_)->AllocDataSpace(device_, nbytes, alignment, type_hint);
-    used_memory_.fetch_add(nbytes, std::memory_order_relaxed);
+    size_t used = used_memory_.fetch_add(nbytes, std::memory_order_relaxed) + nbytes;
+    for (size_t peak = peak_memory_.load(std::memory_order_relaxed);
+         used > peak && !peak_memory_.compare_exchange_weak(peak, used);) {
+    }
     DLOG(INFO) << "allocate " << nbytes << " B, used memory " << used_memory_ << " B";
     return buf;
   }
@@ -54,8 +57,16 @@ class NaiveAllocator final : public Allocator {
 
   size_t UsedMemory() const override { return used_memory_.load(std::memory_order_relaxed); }
 
+  AllocatorStats GetStats() const override {
+    AllocatorStats stats;
+    stats.live_bytes = stats.reserved_bytes = UsedMemory();
+    stats.peak_live_bytes = stats.peak_reserved_bytes = peak_memory_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
  private:
   std::atomic<size_t> used_memory_;
+  std::atomic<size_t> peak_memory_{0};
   Device device_;
 };
 
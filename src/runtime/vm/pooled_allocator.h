@@ -26,6 +26,7 @@
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/vm/memory_manager.h>
 
+#include <algorithm>
 #include <atomic>
 #include <mutex>
 #include <unordered_map>
@@ -52,6 +53,7 @@ class PooledAllocator final : public Allocator {
       auto&& pool = it->second;
       auto ret = pool.back();
       pool.pop_back();
+      AddLiveBytes(size);
       return ret;
     }
     Buffer buf;
@@ -67,6 +69,8 @@ class PooledAllocator final : public Allocator {
     }
 
     used_memory_.fetch_add(size, std::memory_order_relaxed);
+    peak_reserved_bytes_ = std::max(peak_reserved_bytes_, used_memory_.load());
+    AddLiveBytes(size);
     VLOG(1) << "allocate " << size << " B, used memory " << used_memory_ << " B";
     return buf;
   }
@@ -77,12 +81,37 @@ class PooledAllocator final : public Allocator {
       memory_pool_.emplace(buffer.size, std::vector<Buffer>{});
     }
     memory_pool_.at(buffer.size).push_back(buffer);
+    live_bytes_ -= buffer.size;
     VLOG(1) << "reclaim buffer " << buffer.size;
   }
 
   size_t UsedMemory() const override { return used_memory_.load(std::memory_order_relaxed); }
 
+  AllocatorStats GetStats() const override {
+    std::lock_guard<std::recursive_mutex> lock(mu_);
+    AllocatorStats stats;
+    stats.live_bytes = live_bytes_;
+    stats.peak_live_bytes = peak_live_bytes_;
+    stats.reserved_bytes = UsedMemory();
+    stats.peak_reserved_bytes = peak_reserved_bytes_;
+    for (auto const& it : memory_pool_) {
+      if (!it.second.empty()) {
+        stats.largest_free_block = std::max(stats.largest_free_block, it.first);
+      }
+    }
+    size_t free_bytes = stats.reserved_bytes - stats.live_bytes;
+    if (free_bytes != 0) {
+      stats.fragmentation = 1.0 - static_cast<double>(stats.largest_free_block) / free_bytes;
+    }
+    return stats;
+  }
+
  private:
+  void AddLiveBytes(size_t size) {
+    live_bytes_ += size;
+    peak_live_bytes_ = std::max(peak_live_bytes_, live_bytes_);
+  }
+
   void ReleaseAll() {
     std::lock_guard<std::recursive_mutex> lock(mu_);
     for (auto const& it : memory_pool_) {
@@ -99,8 +128,11 @@ class PooledAllocator final : public Allocator {
  private:
   size_t page_size_;
   std::atomic<size_t> used_memory_;
+  size_t live_bytes_{0};
+  size_t peak_live_bytes_{0};
+  size_t peak_reserved_bytes_{0};
   std::unordered_map<size_t, std::vector<Buffer>> memory_pool_;
-  std::recursive_mutex mu_;
+  mutable std::recursive_mutex mu_;
   Device device_;
 };
 
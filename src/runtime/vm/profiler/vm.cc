@@ -25,6 +25,7 @@
 #include "vm.h"
 
 #include <tvm/runtime/container/adt.h>
+#include <tvm/runtime/container/map.h>
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/registry.h>
 
@@ -42,6 +43,25 @@ namespace tvm {
 namespace runtime {
 namespace vm {
 
+namespace {
+
+/*! \brief The number of buckets of the latency histogram of the sampling mode. */
+constexpr size_t kNumHistogramBuckets = 32;
+
+/*! \brief Returns the device of the first input of an operator, which is used for timing. */
+Device FirstArgDevice(const std::vector<ObjectRef>& args, Index arg_count) {
+  ICHECK_GT(arg_count, 0U);
+  ObjectRef arg = args[0];
+  while (arg->IsInstance<ADTObj>()) {
+    ADT adt = Downcast<ADT>(arg);
+    arg = adt[0];
+  }
+  ICHECK(arg->IsInstance<NDArray::ContainerType>());
+  return Downcast<NDArray>(arg)->device;
+}
+
+}  // namespace
+
 PackedFunc VirtualMachineDebug::GetFunction(const std::string& name,
                                             const ObjectPtr<Object>& sptr_to_self) {
   if (name == "profile") {
@@ -79,17 +99,114 @@ PackedFunc VirtualMachineDebug::GetFunction(const std::string& name,
   } else if (name == "profile_rpc") {
     // We cannot return a Report over RPC because TVM RPC mechanism only
     // supports a subset of Object classes. Instead we serialize it on the
-    // remote (here) and deserialize it on the other end.
-    return TypedPackedFunc<std::string(std::string)>([sptr_to_self, this](std::string arg_name) {
+    // remote (here) and deserialize it on the other end. MetricCollectors cannot be sent either,
+    // they are constructed here from the names of their global functions.
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      std::string arg_name = args[0];
+      String collectors = args.num_args > 1 ? args[1].operator String() : String("");
       PackedFunc profile = GetFunction("profile", sptr_to_self);
-      profiling::Report report = profile(arg_name, Array<profiling::MetricCollector>());
-      return report->AsJSON();
+      profiling::Report report =
+          profile(arg_name, profiling::MetricCollectorsFromNames(collectors));
+      *rv = report->AsJSON();
+    });
+  } else if (name == "invoke" || name == "invoke_stateful") {
+    return SampledInvoke(VirtualMachine::GetFunction(name, sptr_to_self), sptr_to_self);
+  } else if (name == "set_sampling") {
+    return TypedPackedFunc<void(int64_t, int64_t)>(
+        [sptr_to_self, this](int64_t sample_rate, int64_t sample_window) {
+          ICHECK_GE(sample_rate, 0) << "The sample rate must be non negative";
+          ICHECK_GE(sample_window, 0) << "The sample window must be non negative";
+          sample_rate_ = sample_rate;
+          sample_window_ = sample_window;
+          window_start_ = 0;
+          num_invocations_ = 0;
+        });
+  } else if (name == "get_sampled_profile") {
+    return TypedPackedFunc<Map<String, ObjectRef>(bool)>([sptr_to_self, this](bool reset) {
+      std::lock_guard<std::mutex> lock(sampling_mutex_);
+      ResolvePendingTimers();
+      Map<String, ObjectRef> profile;
+      for (const auto& kv : sampled_stats_) {
+        const SampledOpStats& stats = kv.second;
+        Array<ObjectRef> histogram;
+        for (int64_t count : stats.histogram) {
+          histogram.push_back(ObjectRef(make_object<profiling::CountNode>(count)));
+        }
+        profile.Set(
+            kv.first,
+            Map<String, ObjectRef>{
+                {"Count", ObjectRef(make_object<profiling::CountNode>(stats.count))},
+                {"Duration (us)", ObjectRef(make_object<profiling::DurationNode>(stats.total_us))},
+                {"Mean (us)",
+                 ObjectRef(make_object<profiling::DurationNode>(stats.total_us / stats.count))},
+                {"Min (us)", ObjectRef(make_object<profiling::DurationNode>(stats.min_us))},
+                {"Max (us)", ObjectRef(make_object<profiling::DurationNode>(stats.max_us))},
+                {"Histogram", histogram}});
+      }
+      if (reset) {
+        sampled_stats_.clear();
+      }
+      return profile;
     });
   } else {
     return VirtualMachine::GetFunction(name, sptr_to_self);
   }
 }
 
+PackedFunc VirtualMachineDebug::SampledInvoke(PackedFunc invoke,
+                                              const ObjectPtr<Object>& sptr_to_self) {
+  return PackedFunc([sptr_to_self, this, invoke](TVMArgs args, TVMRetValue* rv) {
+    if (sample_rate_ == 0 || num_invocations_++ % sample_rate_ != 0) {
+      invoke.CallPacked(args, rv);
+      return;
+    }
+    {
+      // The timers of the previous sample have most likely completed on the device by now.
+      std::lock_guard<std::mutex> lock(sampling_mutex_);
+      ResolvePendingTimers();
+    }
+    sampling_ = true;
+    num_sampled_ops_ = 0;
+    try {
+      invoke.CallPacked(args, rv);
+    } catch (...) {
+      sampling_ = false;
+      throw;
+    }
+    sampling_ = false;
+    // Move the window so that successive samples cover all the operators.
+    if (sample_window_ > 0) {
+      window_start_ += sample_window_;
+      if (window_start_ >= num_sampled_ops_) {
+        window_start_ = 0;
+      }
+    }
+  });
+}
+
+void VirtualMachineDebug::ResolvePendingTimers() {
+  for (auto& kv : pending_timers_) {
+    double us = kv.second->SyncAndGetElapsedNanos() / 1e3;
+    SampledOpStats& stats = sampled_stats_[kv.first];
+    if (stats.count == 0) {
+      stats.min_us = us;
+      stats.max_us = us;
+      stats.histogram.assign(kNumHistogramBuckets, 0);
+    } else {
+      stats.min_us = std::min(stats.min_us, us);
+      stats.max_us = std::max(stats.max_us, us);
+    }
+    stats.count++;
+    stats.total_us += us;
+    size_t bucket = 0;
+    while (bucket + 1 < kNumHistogramBuckets && us >= static_cast<double>(int64_t{1} << bucket)) {
+      ++bucket;
+    }
+    stats.histogram[bucket]++;
+  }
+  pending_timers_.clear();
+}
+
 void VirtualMachineDebug::LoadExecutable(const ObjectPtr<Executable>& exec) {
   VirtualMachine::LoadExecutable(exec);
   for (auto kv : exec_->primitive_map) {
@@ -97,7 +214,7 @@ void VirtualMachineDebug::LoadExecutable(const ObjectPtr<Executable>& exec) {
   }
 }
 
-void VirtualMachineDebug::OpStartHook(Instruction instr) {
+void VirtualMachineDebug::OpStartHook(const Instruction& instr) {
   if (prof_ && prof_.operator*().IsRunning()) {
     if (instr.op == Opcode::LoadConst) {
       Device dev = GetDevice(exec_->const_device_indexes[instr.const_index]);
@@ -151,17 +268,22 @@ void VirtualMachineDebug::InvokePacked(Index packed_index, const PackedFunc& fun
                                        Index output_size, const std::vector<ObjectRef>& args) {
   ICHECK(exec_);
   ICHECK(!devices_.empty()) << "Device has not been initialized yet.";
+  if (sampling_ && !(prof_ && prof_.operator*().IsRunning())) {
+    int64_t op_index = num_sampled_ops_++;
+    if (sample_window_ == 0 ||
+        (op_index >= window_start_ && op_index < window_start_ + sample_window_)) {
+      // Only stop the timer here, reading it would wait for the device.
+      Timer timer = Timer::Start(FirstArgDevice(args, arg_count));
+      VirtualMachine::InvokePacked(packed_index, func, arg_count, output_size, args);
+      timer->Stop();
+      std::lock_guard<std::mutex> lock(sampling_mutex_);
+      pending_timers_.emplace_back(packed_index_map_[packed_index], timer);
+      return;
+    }
+  }
   if (prof_ && prof_.operator*().IsRunning()) {
     // The device of any input of the operator is used for synchronization.
-    ICHECK_GT(arg_count, 0U);
-    ObjectRef arg = args[0];
-    while (arg->IsInstance<ADTObj>()) {
-      ADT adt = Downcast<ADT>(arg);
-      arg = adt[0];
-    }
-    ICHECK(arg->IsInstance<NDArray::ContainerType>());
-    auto nd_array = Downcast<NDArray>(arg);
-    auto dev = nd_array->device;
+    auto dev = FirstArgDevice(args, arg_count);
 
     // get argument sizes
     std::vector<NDArray> shapes;
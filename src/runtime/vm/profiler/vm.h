@@ -29,6 +29,7 @@
 #include <tvm/runtime/vm/vm.h>
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -51,11 +52,43 @@ class VirtualMachineDebug : public VirtualMachine {
  private:
   void InvokePacked(Index packed_index, const PackedFunc& func, Index arg_count, Index output_size,
                     const std::vector<ObjectRef>& args) final;
-  void OpStartHook(Instruction instr) final;
+  void OpStartHook(const Instruction& instr) final;
   void OpStopHook() final;
 
+  /*! \brief Running latency statistics of an operator under sampling. */
+  struct SampledOpStats {
+    int64_t count = 0;
+    double total_us = 0;
+    double min_us = 0;
+    double max_us = 0;
+    /*! \brief Bucket i counts the calls which took less than 2^i microseconds, and more than the
+     * bound of the previous bucket. The last bucket is unbounded. */
+    std::vector<int64_t> histogram;
+  };
+
+  /*! \brief Wraps an invoke function to profile one invocation out of \p sample_rate_. */
+  PackedFunc SampledInvoke(PackedFunc invoke, const ObjectPtr<Object>& sptr_to_self);
+  /*! \brief Adds the durations of the stopped timers to the statistics. Requires
+   * \p sampling_mutex_. */
+  void ResolvePendingTimers();
+
   std::unordered_map<Index, std::string> packed_index_map_;
   std::optional<profiling::Profiler> prof_;
+
+  /*! \brief One invocation every sample_rate_ is sampled, zero disables sampling. */
+  int64_t sample_rate_{0};
+  /*! \brief The number of operators timed per sampled invocation, zero times all of them. */
+  int64_t sample_window_{0};
+  /*! \brief The index of the first operator timed in the next sampled invocation. */
+  int64_t window_start_{0};
+  int64_t num_invocations_{0};
+  /*! \brief The number of operators invoked so far by the sampled invocation. */
+  int64_t num_sampled_ops_{0};
+  bool sampling_{false};
+  /*! \brief Timers stopped but not yet read, so that sampling never waits for the device. */
+  std::vector<std::pair<std::string, Timer>> pending_timers_;
+  std::unordered_map<std::string, SampledOpStats> sampled_stats_;
+  std::mutex sampling_mutex_;
 };
 
 }  // namespace vm
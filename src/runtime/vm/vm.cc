@@ -26,18 +26,24 @@
 #include <tvm/runtime/container/adt.h>
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/debug.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/memory.h>
 #include <tvm/runtime/object.h>
+#include <tvm/runtime/threading_backend.h>
 #include <tvm/runtime/vm/vm.h>
 
 #include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "../file_utils.h"
+#include "../op_latency_recorder.h"
 
 using namespace tvm::runtime;
 
@@ -46,14 +52,68 @@ namespace runtime {
 namespace vm {
 
 TVM_REGISTER_OBJECT_TYPE(VMClosureObj);
+TVM_REGISTER_OBJECT_TYPE(VMFutureObj);
 
 VMClosure::VMClosure(size_t func_index, std::vector<ObjectRef> free_vars) {
-  auto ptr = make_object<VMClosureObj>();
+  auto ptr = PooledObjAllocator().make_object<VMClosureObj>();
   ptr->func_index = func_index;
   ptr->free_vars = std::move(free_vars);
   data_ = std::move(ptr);
 }
 
+VMFuture::VMFuture(ObjectRef result, std::vector<std::pair<Device, void*>> events) {
+  auto ptr = make_object<VMFutureObj>();
+  ptr->result = std::move(result);
+  ptr->events = std::move(events);
+  data_ = std::move(ptr);
+}
+
+bool VMFutureObj::IsDone() {
+  while (!events.empty()) {
+    const auto& event = events.back();
+    DeviceAPI* api = DeviceAPI::Get(event.first);
+    if (event.second == nullptr) {
+      api->StreamSync(event.first, nullptr);
+    } else if (api->EventDone(event.first, event.second)) {
+      api->FreeEvent(event.first, event.second);
+    } else {
+      return false;
+    }
+    events.pop_back();
+  }
+  return true;
+}
+
+ObjectRef VMFutureObj::Wait() {
+  for (const auto& event : events) {
+    DeviceAPI* api = DeviceAPI::Get(event.first);
+    if (event.second == nullptr) {
+      api->StreamSync(event.first, nullptr);
+    } else {
+      api->EventSync(event.first, event.second);
+    }
+  }
+  ReleaseEvents();
+  return result;
+}
+
+void VMFutureObj::ReleaseEvents() {
+  for (const auto& event : events) {
+    if (event.second != nullptr) {
+      DeviceAPI::Get(event.first)->FreeEvent(event.first, event.second);
+    }
+  }
+  events.clear();
+}
+
+TVM_REGISTER_GLOBAL("runtime.VMFutureDone").set_body_typed([](VMFuture future) {
+  return future->IsDone();
+});
+
+TVM_REGISTER_GLOBAL("runtime.VMFutureWait").set_body_typed([](VMFuture future) {
+  return future->Wait();
+});
+
 void VMFunctionPrint(std::ostream& os, const VMFunction& vm_func) {
   os << vm_func.name << ": " << std::endl;
   for (size_t i = 0; i < vm_func.instructions.size(); ++i) {
@@ -66,6 +126,83 @@ std::ostream& operator<<(std::ostream& os, const VMFunction& vm_func) {
   return os;
 }
 
+/*!
+ * \brief The kinds RunLoop dispatches on. The first kinds mirror the opcodes, the others are
+ * superinstructions executing a common sequence of instructions without dispatching in between.
+ */
+enum class DispatchKind : uint8_t {
+  Move = 0U,
+  Ret = 1U,
+  Invoke = 2U,
+  InvokeClosure = 3U,
+  InvokePacked = 4U,
+  AllocTensor = 5U,
+  AllocTensorReg = 6U,
+  AllocADT = 7U,
+  AllocClosure = 8U,
+  GetField = 9U,
+  If = 10U,
+  LoadConst = 11U,
+  Goto = 12U,
+  GetTag = 13U,
+  LoadConsti = 14U,
+  Fatal = 15U,
+  AllocStorage = 16U,
+  ShapeOf = 17U,
+  ReshapeTensor = 18U,
+  DeviceCopy = 19U,
+  KillRegister = 20U,
+  /*! \brief AllocStorage followed by an AllocTensor in the new storage. */
+  AllocStorageAllocTensor = 21U,
+  /*! \brief AllocStorage, AllocTensor in the new storage, then InvokePacked. */
+  AllocStorageAllocTensorInvokePacked = 22U,
+  /*! \brief AllocTensor followed by InvokePacked. */
+  AllocTensorInvokePacked = 23U,
+};
+
+static_assert(static_cast<uint8_t>(DispatchKind::KillRegister) ==
+                  static_cast<uint8_t>(Opcode::KillRegister),
+              "The dispatch kinds must mirror the opcodes");
+
+/*!
+ * \brief Pre-decode the instructions of a function into the kinds RunLoop dispatches on.
+ *
+ * Each instruction gets its own kind, so jumping into the middle of a superinstruction
+ * simply executes the remainder of the sequence one instruction at a time.
+ */
+std::vector<uint8_t> DecodeDispatchKinds(const std::vector<Instruction>& code) {
+  std::vector<uint8_t> kinds(code.size());
+  for (size_t i = 0; i < code.size(); ++i) {
+    const Instruction& instr = code[i];
+    if (instr.op > Opcode::KillRegister) {
+      LOG(FATAL) << "Unknown instruction opcode: " << int(instr.op);
+    }
+    DispatchKind kind = static_cast<DispatchKind>(instr.op);
+    auto next_op = [&](size_t offset, Opcode op) {
+      return i + offset < code.size() && code[i + offset].op == op;
+    };
+    if (instr.op == Opcode::AllocStorage && next_op(1, Opcode::AllocTensor) &&
+        code[i + 1].alloc_tensor.storage == instr.dst) {
+      kind = next_op(2, Opcode::InvokePacked) ? DispatchKind::AllocStorageAllocTensorInvokePacked
+                                              : DispatchKind::AllocStorageAllocTensor;
+    } else if (instr.op == Opcode::AllocTensor && next_op(1, Opcode::InvokePacked)) {
+      kind = DispatchKind::AllocTensorInvokePacked;
+    }
+    kinds[i] = static_cast<uint8_t>(kind);
+  }
+  return kinds;
+}
+
+/*! \brief Track the nesting depth of packed calls, releasing the depth on unwinding. */
+class PackedCallDepthScope {
+ public:
+  explicit PackedCallDepthScope(size_t* depth) : depth_(depth) { ++*depth_; }
+  ~PackedCallDepthScope() { --*depth_; }
+
+ private:
+  size_t* depth_;
+};
+
 inline ObjectRef CopyTo(ObjectRef src, const DLDevice& dev) {
   if (src->IsInstance<NDArray::ContainerType>()) {
     auto nd_array = Downcast<NDArray>(src);
@@ -124,7 +261,7 @@ std::vector<int64_t> ToShape(NDArray shape_tensor) {
   return shape;
 }
 
-void VirtualMachine::OpStartHook(Instruction instr) {}
+void VirtualMachine::OpStartHook(const Instruction& instr) {}
 void VirtualMachine::OpStopHook() {}
 
 PackedFunc VirtualMachine::GetFunction(const std::string& name,
@@ -163,6 +300,25 @@ PackedFunc VirtualMachine::GetFunction(const std::string& name,
       TVMRetValue rv_;
       invoke.CallPacked(args, &rv_);
     });
+  } else if (name == "invoke_async") {
+    // Like invoke, but does not wait for the devices: the returned future tracks the
+    // completion of the queued work with an event on each device.
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      PackedFunc invoke = GetFunction("invoke", sptr_to_self);
+      TVMRetValue result;
+      invoke.CallPacked(args, &result);
+      std::vector<std::pair<Device, void*>> events;
+      for (const Device& dev : devices_) {
+        bool seen = std::any_of(events.begin(), events.end(), [&dev](const auto& event) {
+          return event.first.device_type == dev.device_type &&
+                 event.first.device_id == dev.device_id;
+        });
+        if (dev.device_type != kDLCPU && !seen) {
+          events.emplace_back(dev, DeviceAPI::Get(dev)->RecordEvent(dev, nullptr));
+        }
+      }
+      *rv = VMFuture(result.operator ObjectRef(), std::move(events));
+    });
   } else if (name == "invoke_return_to_device") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       Device host{static_cast<DLDeviceType>(args[1].operator int()), args[2].operator int()};
@@ -235,6 +391,30 @@ PackedFunc VirtualMachine::GetFunction(const std::string& name,
   } else if (name == "set_outputs") {
     return PackedFunc(
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { SetOutputs(args[0], args); });
+  } else if (name == "bind_numa_node") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      int nthreads = args.num_args > 1 ? args[1].operator int() : 0;
+      BindNumaNode(args[0], nthreads);
+    });
+  } else if (name == "bind_thread_pool_group") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      BindThreadPoolGroup(args[0].operator std::string());
+    });
+  } else if (name == "enable_op_latency_histograms") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      EnableOpLatencyHistograms(args[0]);
+    });
+  } else if (name == "get_op_latency_histograms") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      CHECK(op_latency_ != nullptr)
+          << "The latency histograms are disabled, call enable_op_latency_histograms first";
+      bool reset = args.num_args > 0 ? args[0].operator bool() : false;
+      *rv = op_latency_->ToJSON(reset);
+    });
+  } else if (name == "create_context" || name == "clone") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      *rv = runtime::Module(CreateContext());
+    });
   } else if (name == "load_late_bound_consts") {
     return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
       CHECK_EQ(args.size(), 1);
@@ -396,6 +576,7 @@ inline Allocator* VirtualMachine::GetAllocator(Index device_index) const {
 
 void VirtualMachine::PushFrame(Index arg_count, Index ret_pc, const VMFunction& vm_func) {
   auto frame = VMFrame(ret_pc, func_index_, arg_count, code_, vm_func.register_file_size);
+  frame.dispatch = dispatch_;
   frames_.push_back(frame);
 }
 
@@ -404,6 +585,7 @@ Index VirtualMachine::PopFrame() {
   const VMFrame& fr = frames_.back();
   func_index_ = fr.func_index;
   code_ = fr.code;
+  dispatch_ = fr.dispatch;
   pc_ = fr.pc;
   auto call_stack_size = frames_.size();
   frames_.pop_back();
@@ -421,11 +603,43 @@ void VirtualMachine::InvokeGlobal(const VMFunction& func, const std::vector<Obje
   }
 
   code_ = func.instructions.data();
+  dispatch_ = GetDispatchCode(func);
   pc_ = 0;
 }
 
+const uint8_t* VirtualMachine::GetDispatchCode(const VMFunction& func) {
+  if (exec_ && !exec_->functions.empty() && &func >= exec_->functions.data() &&
+      &func < exec_->functions.data() + exec_->functions.size()) {
+    size_t func_index = &func - exec_->functions.data();
+    if (dispatch_code_ && func_index < dispatch_code_->size()) {
+      return (*dispatch_code_)[func_index].data();
+    }
+  }
+  // Not one of the functions decoded by LoadExecutable, decode it on every invocation as
+  // the instructions may have changed since the last one. Each invocation gets its own copy, a
+  // recursive one must not free the code of the frames below it.
+  if (external_dispatch_code_.size() >= kMaxExternalDispatchCode) {
+    std::unordered_set<const uint8_t*> live{dispatch_};
+    for (const VMFrame& frame : frames_) {
+      live.insert(frame.dispatch);
+    }
+    external_dispatch_code_.remove_if(
+        [&live](const std::vector<uint8_t>& kinds) { return !live.count(kinds.data()); });
+  }
+  external_dispatch_code_.push_back(DecodeDispatchKinds(func.instructions));
+  return external_dispatch_code_.back().data();
+}
+
+VirtualMachine::PackedCallBuffer& VirtualMachine::CurrentPackedCallBuffer() {
+  while (packed_call_buffers_.size() <= packed_call_depth_) {
+    packed_call_buffers_.emplace_back();
+  }
+  return packed_call_buffers_[packed_call_depth_];
+}
+
 ObjectRef VirtualMachine::Invoke(const VMFunction& func, const std::vector<ObjectRef>& args) {
   PrintInfoAndSetInputArgs(func, args);
+  op_latency_timed_ = op_latency_ != nullptr && op_latency_->BeginRun();
   RunLoop();
   return return_register_;
 }
@@ -443,12 +657,109 @@ ObjectRef VirtualMachine::Invoke(const VMFunction& func, const std::vector<Objec
                                  const std::vector<ObjectRef>& output_args) {
   PrintInfoAndSetInputArgs(func, input_args);
   SetOutputTensorsToRegister(func.name, output_args);
+  op_latency_timed_ = op_latency_ != nullptr && op_latency_->BeginRun();
   RunLoop(output_tensor_reg_indices_[func.name]);
   return return_register_;
 }
 
+namespace {
+
+/*! \brief The most calls with distinct inputs memoized per shape function. */
+constexpr size_t kMaxShapeFuncCacheEntries = 8;
+/*! \brief The largest key of a memoized call, a data dependent shape function with larger inputs
+ * is always run. */
+constexpr size_t kMaxShapeFuncKeyBytes = 1024;
+
+/*! \brief Whether the array is contiguous on the host, so that its bytes can be copied. */
+bool IsHostContiguous(const NDArray& arr) {
+  return arr->device.device_type == kDLCPU && arr.IsContiguous();
+}
+
+}  // namespace
+
+bool VirtualMachine::LookupShapeFuncCache(ShapeFuncCache* cache, const std::vector<NDArray>& args,
+                                          size_t num_outputs, std::vector<uint8_t>* key) {
+  key->clear();
+  for (const NDArray& arr : args) {
+    if (!IsHostContiguous(arr)) return false;
+  }
+  for (size_t i = 0; i + num_outputs < args.size(); ++i) {
+    const DLTensor& tensor = *args[i].operator->();
+    size_t nbytes = GetDataSize(tensor);
+    if (key->size() + nbytes > kMaxShapeFuncKeyBytes) {
+      key->clear();
+      return false;
+    }
+    // The inputs are separated by their shapes and types.
+    auto f_append = [key](const void* data, size_t size) {
+      const uint8_t* bytes = static_cast<const uint8_t*>(data);
+      key->insert(key->end(), bytes, bytes + size);
+    };
+    f_append(&tensor.ndim, sizeof(tensor.ndim));
+    f_append(tensor.shape, sizeof(int64_t) * tensor.ndim);
+    f_append(&tensor.dtype, sizeof(tensor.dtype));
+    f_append(static_cast<const uint8_t*>(tensor.data) + tensor.byte_offset, nbytes);
+  }
+  auto& entries = cache->entries;
+  for (size_t k = 0; k < entries.size(); ++k) {
+    if (entries[k].first != *key) continue;
+    const std::vector<uint8_t>& outputs = entries[k].second;
+    size_t offset = 0;
+    for (size_t i = args.size() - num_outputs; i < args.size(); ++i) {
+      const DLTensor& tensor = *args[i].operator->();
+      size_t nbytes = GetDataSize(tensor);
+      ICHECK_LE(offset + nbytes, outputs.size());
+      std::memcpy(static_cast<uint8_t*>(tensor.data) + tensor.byte_offset, outputs.data() + offset,
+                  nbytes);
+      offset += nbytes;
+    }
+    std::rotate(entries.begin(), entries.begin() + k, entries.begin() + k + 1);
+    return true;
+  }
+  return false;
+}
+
+void VirtualMachine::UpdateShapeFuncCache(ShapeFuncCache* cache, const std::vector<NDArray>& args,
+                                          size_t num_outputs, std::vector<uint8_t> key) {
+  std::vector<uint8_t> outputs;
+  for (size_t i = args.size() - num_outputs; i < args.size(); ++i) {
+    const DLTensor& tensor = *args[i].operator->();
+    const uint8_t* data = static_cast<const uint8_t*>(tensor.data) + tensor.byte_offset;
+    outputs.insert(outputs.end(), data, data + GetDataSize(tensor));
+  }
+  auto& entries = cache->entries;
+  if (entries.size() == kMaxShapeFuncCacheEntries) {
+    entries.pop_back();
+  }
+  entries.emplace(entries.begin(), std::move(key), std::move(outputs));
+}
+
 void VirtualMachine::InvokePacked(Index packed_index, const PackedFunc& func, Index arg_count,
                                   Index output_size, const std::vector<ObjectRef>& args) {
+  ShapeFuncCache* cache = nullptr;
+  std::vector<NDArray> cache_args;
+  std::vector<uint8_t> cache_key;
+  size_t num_cache_outputs = 0;
+  if (static_cast<size_t>(packed_index) < shape_func_caches_.size() &&
+      shape_func_caches_[packed_index].enabled) {
+    cache = &shape_func_caches_[packed_index];
+    for (Index i = 0; i < arg_count; i++) {
+      bool is_output = i >= arg_count - output_size;
+      if (const auto* dt_cell = args[i].as<ADTObj>()) {
+        for (size_t fi = 0; fi < dt_cell->size; ++fi) {
+          cache_args.push_back(Downcast<NDArray>((*dt_cell)[fi]));
+          num_cache_outputs += is_output;
+        }
+      } else {
+        cache_args.push_back(Downcast<NDArray>(args[i]));
+        num_cache_outputs += is_output;
+      }
+    }
+    if (LookupShapeFuncCache(cache, cache_args, num_cache_outputs, &cache_key)) {
+      return;
+    }
+  }
+
   size_t arity = 0;
   for (Index i = 0; i < arg_count; i++) {
     if (const auto* obj = args[i].as<ADTObj>()) {
@@ -458,8 +769,12 @@ void VirtualMachine::InvokePacked(Index packed_index, const PackedFunc& func, In
     }
   }
 
-  std::vector<TVMValue> values(arity);
-  std::vector<int> codes(arity);
+  PackedCallBuffer& buffer = CurrentPackedCallBuffer();
+  PackedCallDepthScope depth_scope(&packed_call_depth_);
+  std::vector<TVMValue>& values = buffer.values;
+  std::vector<int>& codes = buffer.type_codes;
+  values.resize(arity);
+  codes.resize(arity);
   runtime::TVMArgsSetter setter(values.data(), codes.data());
   int idx = 0;
   bool is_empty_output = false;
@@ -486,9 +801,21 @@ void VirtualMachine::InvokePacked(Index packed_index, const PackedFunc& func, In
     }
   }
 
-  if (!is_empty_output) {
+  if (!is_empty_output && op_latency_timed_) {
+    if (!op_latency_device_set_[packed_index] && arity > 0) {
+      op_latency_->SetDevice(packed_index, static_cast<DLTensor*>(values[0].v_handle)->device);
+      op_latency_device_set_[packed_index] = true;
+    }
     TVMRetValue rv;
+    int64_t start = op_latency_->StartOp(packed_index);
     func.CallPacked(TVMArgs(values.data(), codes.data(), arity), &rv);
+    op_latency_->StopOp(packed_index, start);
+  } else if (!is_empty_output) {
+    TVMRetValue rv;
+    func.CallPacked(TVMArgs(values.data(), codes.data(), arity), &rv);
+  }
+  if (cache != nullptr && !cache_key.empty()) {
+    UpdateShapeFuncCache(cache, cache_args, num_cache_outputs, std::move(cache_key));
   }
 }
 
@@ -517,6 +844,52 @@ void VirtualMachine::LoadExecutable(const ObjectPtr<Executable>& exec) {
   for (size_t i = 0; i < packed_funcs_.size(); ++i) {
     ICHECK(packed_funcs_[i] != nullptr) << "Packed function " << i << " is not initialized";
   }
+  // The shape functions are named after their primitive, see MakeShapeFunc in te_compiler_cache.cc.
+  shape_func_caches_.assign(packed_funcs_.size(), ShapeFuncCache());
+  for (const auto& it : exec_->primitive_map) {
+    if (it.first.find("shape_func") != std::string::npos) {
+      shape_func_caches_[it.second].enabled = true;
+    }
+  }
+
+  auto dispatch_code = std::make_shared<std::vector<std::vector<uint8_t>>>();
+  dispatch_code->reserve(exec_->functions.size());
+  for (const VMFunction& func : exec_->functions) {
+    dispatch_code->push_back(DecodeDispatchKinds(func.instructions));
+  }
+  dispatch_code_ = std::move(dispatch_code);
+}
+
+void VirtualMachine::EnableOpLatencyHistograms(int sample_period) {
+  ICHECK(exec_) << "The executable has not been created yet.";
+  ICHECK_GE(sample_period, 0) << "ValueError: sample_period should be non-negative";
+  op_latency_ = nullptr;
+  op_latency_timed_ = false;
+  if (sample_period == 0) return;
+  std::vector<std::string> names(exec_->primitive_map.size());
+  for (const auto& it : exec_->primitive_map) names[it.second] = it.first;
+  // The device of a primitive is the one of its first argument, set when it first runs.
+  std::vector<Device> devices(names.size(), Device{kDLCPU, 0});
+  op_latency_device_set_.assign(names.size(), false);
+  op_latency_ = std::make_shared<OpLatencyRecorder>(names, names, devices, sample_period);
+}
+
+ObjectPtr<VirtualMachine> VirtualMachine::CreateContext() const {
+  ICHECK(exec_) << "The executable has not been created yet.";
+  ICHECK(!devices_.empty()) << "The VirtualMachine has not been initialized yet.";
+  auto context = make_object<VirtualMachine>();
+  context->exec_ = exec_;
+  context->packed_funcs_ = packed_funcs_;
+  context->shape_func_caches_ = shape_func_caches_;
+  context->dispatch_code_ = dispatch_code_;
+  context->devices_ = devices_;
+  context->allocators_ = allocators_;
+  context->const_pool_ = const_pool_;
+  context->const_pool_version_ = const_pool_version_;
+  context->numa_node_ = numa_node_;
+  context->numa_nthreads_ = numa_nthreads_;
+  context->thread_pool_group_ = thread_pool_group_;
+  return context;
 }
 
 void VirtualMachine::Init(const std::vector<Device>& physical_devices,
@@ -531,13 +904,21 @@ void VirtualMachine::Init(const std::vector<Device>& physical_devices,
   allocators_.reserve(num_virtual_devices);
 
   for (size_t device_index = 0; device_index < num_virtual_devices; ++device_index) {
-    // We'll retain the legacy behaviour and just match by device type.
-    // TODO(mbs): Generalize.
-    DLDeviceType virtual_device_type = exec_->virtual_devices[device_index].device_type;
+    // Prefer the physical device with the same type and id, e.g. the second GPU for the shards
+    // placed on cuda(1), else retain the legacy behaviour and just match by device type.
+    const Device& virtual_device = exec_->virtual_devices[device_index];
+    DLDeviceType virtual_device_type = virtual_device.device_type;
     auto itr = std::find_if(physical_devices.begin(), physical_devices.end(),
-                            [virtual_device_type](const Device& physical_device) {
-                              return physical_device.device_type == virtual_device_type;
+                            [&virtual_device](const Device& physical_device) {
+                              return physical_device.device_type == virtual_device.device_type &&
+                                     physical_device.device_id == virtual_device.device_id;
                             });
+    if (itr == physical_devices.end()) {
+      itr = std::find_if(physical_devices.begin(), physical_devices.end(),
+                         [virtual_device_type](const Device& physical_device) {
+                           return physical_device.device_type == virtual_device_type;
+                         });
+    }
     CHECK(itr != physical_devices.end())
         << "Unable to find a physical device (from among the " << physical_devices.size()
         << " given) to match the virtual device with device type " << virtual_device_type;
@@ -623,9 +1004,150 @@ std::vector<Index> VirtualMachine::GetOutputTensorRegIndices() {
   return reg_indices;
 }
 
+void VirtualMachine::BindNumaNode(int node, int nthreads) {
+  ICHECK(node >= 0 && node < threading::NumaNodeCount()) << "Invalid NUMA node " << node;
+  numa_node_ = node;
+  numa_nthreads_ = nthreads;
+  for (const ObjectRef& constant : const_pool_) {
+    if (const auto* tensor = constant.as<NDArray::ContainerType>()) {
+      if (tensor->dl_tensor.device.device_type == kDLCPU) {
+        threading::BindMemoryToNumaNode(tensor->dl_tensor.data, GetDataSize(tensor->dl_tensor),
+                                        node);
+      }
+    }
+  }
+  threading::ConfigureNumaNode(node, nthreads);
+}
+
+void VirtualMachine::BindThreadPoolGroup(const std::string& name) {
+  if (!name.empty()) {
+    // fail early if the group does not exist.
+    threading::ThreadPoolGroupScope scope(name);
+  }
+  thread_pool_group_ = name;
+}
+
+void VirtualMachine::ExecuteAllocStorage(const Instruction& instr) {
+  OpStartHook(instr);
+  auto size = LoadScalarInt(instr.alloc_storage.allocation_size);
+  auto alignment = instr.alloc_storage.alignment;
+
+  auto storage_obj = PooledObjAllocator().make_object<StorageObj>();
+  Allocator* allocator = GetAllocator(instr.alloc_storage.device_index);
+  ICHECK(allocator) << "Did you forget to init the VirtualMachine with devices?";
+  VLOG(2) << "allocating with allocation_size=" << size << ", alignment=" << alignment
+          << ", dtype_hint=" << DLDataType2String(instr.alloc_storage.dtype_hint)
+          << ", device_index=" << instr.alloc_storage.device_index;
+
+  storage_obj->buffer = allocator->Alloc(size, alignment, instr.alloc_storage.dtype_hint);
+  Storage storage(storage_obj);
+  WriteRegister(instr.dst, storage);
+  OpStopHook();
+}
+
+void VirtualMachine::ExecuteAllocTensor(const Instruction& instr,
+                                        const std::vector<Index>& output_tensor_reg_indices) {
+  OpStartHook(instr);
+  if (!output_tensor_reg_indices.empty() && FindIndex(output_tensor_reg_indices, instr.dst)) {
+    WriteAllocatedTensorFromOutside(instr);
+  } else {
+    WriteAllocatedTensor(instr);
+  }
+  OpStopHook();
+}
+
+void VirtualMachine::ExecuteInvokePacked(const Instruction& instr) {
+  ICHECK_LE(instr.packed_index, packed_funcs_.size());
+  const auto& func = packed_funcs_[instr.packed_index];
+  const auto& arity = instr.arity;
+  // The registers are gathered into the buffer of this nesting depth, so that a packed
+  // function invoking the VM again does not clobber them.
+  PackedCallBuffer& buffer = CurrentPackedCallBuffer();
+  PackedCallDepthScope depth_scope(&packed_call_depth_);
+  std::vector<ObjectRef>& args = buffer.args;
+  args.clear();
+  for (Index i = 0; i < arity; ++i) {
+    args.push_back(ReadRegister(instr.packed_args[i]));
+#if TVM_LOG_DEBUG
+    const bool is_input = i < arity - instr.output_size;
+    VLOG(2) << (is_input ? "input" : "placeholder") << " arg " << i << " = "
+            << RuntimeObject2String(args.back(), GetDevice(exec_->host_device_index),
+                                    /*show_contents=*/is_input);
+#endif
+  }
+
+  // We no longer need to write the registers back, we write directly
+  // through the registers mutably.
+  InvokePacked(instr.packed_index, func, arity, instr.output_size, args);
+  // Do not keep the arguments alive until the next call.
+  args.clear();
+
+#if TVM_LOG_DEBUG
+  for (Index i = arity - instr.output_size; i < arity; ++i) {
+    auto arg = ReadRegister(instr.packed_args[i]);
+    VLOG(2) << "output arg " << i << " = "
+            << RuntimeObject2String(arg, GetDevice(exec_->host_device_index));
+  }
+#endif
+}
+
+// RunLoop dispatches on the pre-decoded kinds with computed goto where the compiler supports
+// it, which saves the range check of the switch and lets the branch predictor see one
+// indirect jump per kind instead of a single shared one.
+#if defined(__GNUC__) || defined(__clang__)
+#define TVM_VM_DISPATCH(kind) goto* dispatch_table[kind];
+#define TVM_VM_CASE(kind) dispatch_##kind:
+#define TVM_VM_DEFAULT_CASE
+#else
+#define TVM_VM_DISPATCH(kind) switch (static_cast<DispatchKind>(kind))
+#define TVM_VM_CASE(kind) case DispatchKind::kind:
+#define TVM_VM_DEFAULT_CASE default:
+#endif
+
 void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices) {
   ICHECK(this->exec_);
   ICHECK(this->code_);
+  ICHECK(this->dispatch_);
+  // the thread pool is thread local, pin the one of the calling thread.
+  if (numa_node_ >= 0 && threading::CurrentNumaNode() != numa_node_) {
+    threading::ConfigureNumaNode(numa_node_, numa_nthreads_);
+  }
+  threading::ThreadPoolGroupScope thread_pool_scope(thread_pool_group_);
+  // The late-bound constants were loaded again since the pool was filled
+  if (const_pool_version_ != exec_->GetConstantsVersion()) {
+    const_pool_.clear();
+    const_pool_version_ = exec_->GetConstantsVersion();
+  }
+#if defined(__GNUC__) || defined(__clang__)
+  // Indexed by DispatchKind.
+  static const void* const dispatch_table[] = {&&dispatch_Move,
+                                               &&dispatch_Ret,
+                                               &&dispatch_Invoke,
+                                               &&dispatch_InvokeClosure,
+                                               &&dispatch_InvokePacked,
+                                               &&dispatch_AllocTensor,
+                                               &&dispatch_AllocTensorReg,
+                                               &&dispatch_AllocADT,
+                                               &&dispatch_AllocClosure,
+                                               &&dispatch_GetField,
+                                               &&dispatch_If,
+                                               &&dispatch_LoadConst,
+                                               &&dispatch_Goto,
+                                               &&dispatch_GetTag,
+                                               &&dispatch_LoadConsti,
+                                               &&dispatch_Fatal,
+                                               &&dispatch_AllocStorage,
+                                               &&dispatch_ShapeOf,
+                                               &&dispatch_ReshapeTensor,
+                                               &&dispatch_DeviceCopy,
+                                               &&dispatch_KillRegister,
+                                               &&dispatch_AllocStorageAllocTensor,
+                                               &&dispatch_AllocStorageAllocTensorInvokePacked,
+                                               &&dispatch_AllocTensorInvokePacked};
+  static_assert(sizeof(dispatch_table) / sizeof(dispatch_table[0]) ==
+                    static_cast<size_t>(DispatchKind::AllocTensorInvokePacked) + 1,
+                "The dispatch table must cover every dispatch kind");
+#endif
   pc_ = 0;
   Index frame_start = frames_.size();
   while (true) {
@@ -633,34 +1155,32 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
     auto const& instr = code_[this->pc_];
     VLOG(2) << "Executing(" << pc_ << "): " << instr;
 
-    switch (instr.op) {
-      case Opcode::Move: {
+    TVM_VM_DISPATCH(dispatch_[this->pc_]) {
+      TVM_VM_CASE(Move) {
         ObjectRef from_obj;
         from_obj = ReadRegister(instr.from);
         WriteRegister(instr.dst, from_obj);
         pc_++;
         goto main_loop;
       }
-      case Opcode::Fatal: {
-        throw std::runtime_error("VM encountered fatal error");
-      }
-      case Opcode::LoadConst: {
+      TVM_VM_CASE(Fatal) { throw std::runtime_error("VM encountered fatal error"); }
+      TVM_VM_CASE(LoadConst) {
         bool is_not_cached = const_pool_.size() <= static_cast<size_t>(instr.const_index) ||
                              !const_pool_[instr.const_index].defined();
         if (is_not_cached) {
           OpStartHook(instr);
         }
-        auto constant_obj = exec_->constants[instr.const_index];
         // We cache the allocated object in the constant pool. To measure, the
         // first iteration will set the pool up. The other iterations will
-        // directly reuse the allocated objects.
+        // directly reuse the allocated objects. The device copy itself is cached
+        // by the executable and shared with the other VMs running it.
         if (const_pool_.size() <= static_cast<size_t>(instr.const_index)) {
           const_pool_.resize(instr.const_index + 1);
         }
 
         if (!const_pool_[instr.const_index].defined()) {
           Device dev = GetDevice(exec_->const_device_indexes[instr.const_index]);
-          const_pool_[instr.const_index] = CopyTo(constant_obj, dev);
+          const_pool_[instr.const_index] = exec_->GetConstantOnDevice(instr.const_index, dev);
         }
         WriteRegister(instr.dst, const_pool_[instr.const_index]);
         if (is_not_cached) {
@@ -669,14 +1189,14 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         pc_++;
         goto main_loop;
       }
-      case Opcode::LoadConsti: {
+      TVM_VM_CASE(LoadConsti) {
         auto tensor = NDArray::Empty({1}, {kDLInt, 64, 1}, GetDevice(exec_->host_device_index));
         reinterpret_cast<int64_t*>(tensor->data)[0] = instr.load_consti.val;
         WriteRegister(instr.dst, tensor);
         pc_++;
         goto main_loop;
       }
-      case Opcode::Invoke: {
+      TVM_VM_CASE(Invoke) {
         std::vector<ObjectRef> args;
         for (Index i = 0; i < instr.num_args; ++i) {
           args.push_back(ReadRegister(instr.invoke_args_registers[i]));
@@ -685,40 +1205,12 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         frames_.back().caller_return_register = instr.dst;
         goto main_loop;
       }
-      case Opcode::InvokePacked: {
-        ICHECK_LE(instr.packed_index, packed_funcs_.size());
-        const auto& func = packed_funcs_[instr.packed_index];
-        const auto& arity = instr.arity;
-        std::vector<ObjectRef> args;
-        for (Index i = 0; i < arity; ++i) {
-          auto arg = ReadRegister(instr.packed_args[i]);
-          args.push_back(arg);
-#if TVM_LOG_DEBUG
-          if (i < arity) {
-            const bool is_input = i < arity - instr.output_size;
-            VLOG(2) << (is_input ? "input" : "placeholder") << " arg " << i << " = "
-                    << RuntimeObject2String(arg, GetDevice(exec_->host_device_index),
-                                            /*show_contents=*/is_input);
-          }
-#endif
-        }
-
-        // We no longer need to write the registers back, we write directly
-        // through the registers mutably.
-        InvokePacked(instr.packed_index, func, arity, instr.output_size, args);
-
-#if TVM_LOG_DEBUG
-        for (Index i = arity - instr.output_size; i < arity; ++i) {
-          auto arg = ReadRegister(instr.packed_args[i]);
-          VLOG(2) << "output arg " << i << " = "
-                  << RuntimeObject2String(arg, GetDevice(exec_->host_device_index));
-        }
-#endif
-
+      TVM_VM_CASE(InvokePacked) {
+        ExecuteInvokePacked(instr);
         pc_++;
         goto main_loop;
       }
-      case Opcode::InvokeClosure: {
+      TVM_VM_CASE(InvokeClosure) {
         auto object = ReadRegister(instr.closure);
         const auto* closure = object.as<VMClosureObj>();
         ICHECK(closure);
@@ -733,7 +1225,7 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         frames_.back().caller_return_register = instr.dst;
         goto main_loop;
       }
-      case Opcode::GetField: {
+      TVM_VM_CASE(GetField) {
         auto object = ReadRegister(instr.object);
         const auto& tuple = Downcast<ADT>(object);
         auto field = tuple[instr.field_index];
@@ -741,7 +1233,7 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         pc_++;
         goto main_loop;
       }
-      case Opcode::GetTag: {
+      TVM_VM_CASE(GetTag) {
         auto object = ReadRegister(instr.get_tag.object);
         const auto& adt = Downcast<ADT>(object);
         auto tag = adt.tag();
@@ -751,11 +1243,11 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         pc_++;
         goto main_loop;
       }
-      case Opcode::Goto: {
+      TVM_VM_CASE(Goto) {
         pc_ += instr.pc_offset;
         goto main_loop;
       }
-      case Opcode::If: {
+      TVM_VM_CASE(If) {
         int32_t test_val = LoadScalarInt(instr.if_op.test);
         int32_t target_val = LoadScalarInt(instr.if_op.target);
 
@@ -769,18 +1261,12 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
 
         goto main_loop;
       }
-      case Opcode::AllocTensor: {
-        OpStartHook(instr);
-        if (!output_tensor_reg_indices.empty() && FindIndex(output_tensor_reg_indices, instr.dst)) {
-          WriteAllocatedTensorFromOutside(instr);
-        } else {
-          WriteAllocatedTensor(instr);
-        }
-        OpStopHook();
+      TVM_VM_CASE(AllocTensor) {
+        ExecuteAllocTensor(instr, output_tensor_reg_indices);
         pc_++;
         goto main_loop;
       }
-      case Opcode::AllocTensorReg: {
+      TVM_VM_CASE(AllocTensorReg) {
         OpStartHook(instr);
         Device cpu_dev = GetDevice(exec_->host_device_index);
         auto shape_obj = ReadRegister(instr.alloc_tensor_reg.shape_register);
@@ -799,7 +1285,7 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         pc_++;
         goto main_loop;
       }
-      case Opcode::AllocADT: {
+      TVM_VM_CASE(AllocADT) {
         std::vector<ObjectRef> fields;
         for (Index i = 0; i < instr.num_fields; ++i) {
           fields.push_back(ReadRegister(instr.datatype_fields[i]));
@@ -809,7 +1295,7 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         pc_++;
         goto main_loop;
       }
-      case Opcode::AllocClosure: {
+      TVM_VM_CASE(AllocClosure) {
         std::vector<ObjectRef> free_vars;
         for (Index i = 0; i < instr.num_freevar; i++) {
           free_vars.push_back(ReadRegister(instr.free_vars[i]));
@@ -818,26 +1304,12 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         pc_++;
         goto main_loop;
       }
-      case Opcode::AllocStorage: {
-        OpStartHook(instr);
-        auto size = LoadScalarInt(instr.alloc_storage.allocation_size);
-        auto alignment = instr.alloc_storage.alignment;
-
-        auto storage_obj = SimpleObjAllocator().make_object<StorageObj>();
-        Allocator* allocator = GetAllocator(instr.alloc_storage.device_index);
-        ICHECK(allocator) << "Did you forget to init the VirtualMachine with devices?";
-        VLOG(2) << "allocating with allocation_size=" << size << ", alignment=" << alignment
-                << ", dtype_hint=" << DLDataType2String(instr.alloc_storage.dtype_hint)
-                << ", device_index=" << instr.alloc_storage.device_index;
-
-        storage_obj->buffer = allocator->Alloc(size, alignment, instr.alloc_storage.dtype_hint);
-        Storage storage(storage_obj);
-        WriteRegister(instr.dst, storage);
-        OpStopHook();
+      TVM_VM_CASE(AllocStorage) {
+        ExecuteAllocStorage(instr);
         pc_++;
         goto main_loop;
       }
-      case Opcode::ShapeOf: {
+      TVM_VM_CASE(ShapeOf) {
         auto input = ReadRegister(instr.shape_of.tensor);
         NDArray input_array = Downcast<NDArray>(input);
         int ndim = input_array->ndim;
@@ -852,7 +1324,7 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         pc_++;
         goto main_loop;
       }
-      case Opcode::Ret: {
+      TVM_VM_CASE(Ret) {
         // If we have hit the point from which we started
         // running, we should return to the caller breaking
         // the dispatch loop.
@@ -867,7 +1339,7 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
           goto main_loop;
         }
       }
-      case Opcode::ReshapeTensor: {
+      TVM_VM_CASE(ReshapeTensor) {
         OpStartHook(instr);
         Device cpu_dev = GetDevice(exec_->host_device_index);
         auto tensor_obj = ReadRegister(instr.reshape_tensor.tensor);
@@ -891,7 +1363,7 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         pc_++;
         goto main_loop;
       }
-      case Opcode::DeviceCopy: {
+      TVM_VM_CASE(DeviceCopy) {
         OpStartHook(instr);
         auto tensor_src = ReadRegister(instr.device_copy.src);
         NDArray src_data = Downcast<NDArray>(tensor_src);
@@ -907,19 +1379,42 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         pc_++;
         goto main_loop;
       }
-      case Opcode::KillRegister: {
+      TVM_VM_CASE(KillRegister) {
         OpStartHook(instr);
         WriteRegister(instr.dst, ObjectRef());
         OpStopHook();
         pc_++;
         goto main_loop;
       }
-      default:
+      TVM_VM_CASE(AllocStorageAllocTensor) {
+        ExecuteAllocStorage(instr);
+        ExecuteAllocTensor(code_[pc_ + 1], output_tensor_reg_indices);
+        pc_ += 2;
+        goto main_loop;
+      }
+      TVM_VM_CASE(AllocStorageAllocTensorInvokePacked) {
+        ExecuteAllocStorage(instr);
+        ExecuteAllocTensor(code_[pc_ + 1], output_tensor_reg_indices);
+        ExecuteInvokePacked(code_[pc_ + 2]);
+        pc_ += 3;
+        goto main_loop;
+      }
+      TVM_VM_CASE(AllocTensorInvokePacked) {
+        ExecuteAllocTensor(instr, output_tensor_reg_indices);
+        ExecuteInvokePacked(code_[pc_ + 1]);
+        pc_ += 2;
+        goto main_loop;
+      }
+      TVM_VM_DEFAULT_CASE
         LOG(FATAL) << "Unknown instruction opcode: " << int(instr.op);
     }
   }
 }
 
+#undef TVM_VM_DISPATCH
+#undef TVM_VM_CASE
+#undef TVM_VM_DEFAULT_CASE
+
 void VirtualMachine::WriteAllocatedTensor(const Instruction& instr) {
   auto shape = std::vector<int64_t>(instr.alloc_tensor.ndim);
 
@@ -70,6 +70,8 @@ VulkanDeviceProperties::VulkanDeviceProperties(const VulkanInstance& instance,
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_16BIT_STORAGE_FEATURES};
   VkPhysicalDeviceShaderFloat16Int8Features float16_int8 = {
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_FLOAT16_INT8_FEATURES};
+  VkPhysicalDeviceCooperativeMatrixFeaturesNV cooperative_matrix = {
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_MATRIX_FEATURES_NV};
 
   // Set up linked list for feature query
   {
@@ -86,6 +88,10 @@ VulkanDeviceProperties::VulkanDeviceProperties(const VulkanInstance& instance,
       *pp_next = &float16_int8;
       pp_next = &float16_int8.pNext;
     }
+    if (device.HasExtension("VK_NV_cooperative_matrix")) {
+      *pp_next = &cooperative_matrix;
+      pp_next = &cooperative_matrix.pNext;
+    }
   }
 
   if (instance.HasExtension("VK_KHR_get_physical_device_properties2")) {
@@ -133,6 +139,7 @@ VulkanDeviceProperties::VulkanDeviceProperties(const VulkanInstance& instance,
       !support::BoolEnvironmentVar("TVM_VULKAN_DISABLE_DEDICATED_ALLOCATION");
 
   supports_integer_dot_product = device.HasExtension("VK_KHR_shader_integer_dot_product");
+  supports_cooperative_matrix = cooperative_matrix.cooperativeMatrix;
 
   // The check of VK_SHADER_STAGE_COMPUTE_BIT isn't technically
   // needed, since it will be set so long at least one queue has
@@ -435,7 +442,8 @@ std::vector<const char*> VulkanDevice::SelectEnabledExtensions() const {
                                                "VK_KHR_get_memory_requirements2",
                                                "VK_KHR_dedicated_allocation",
                                                "VK_KHR_spirv_1_4",
-                                               "VK_KHR_shader_integer_dot_product"};
+                                               "VK_KHR_shader_integer_dot_product",
+                                               "VK_NV_cooperative_matrix"};
 
   uint32_t device_extension_prop_count;
   VULKAN_CALL(vkEnumerateDeviceExtensionProperties(physical_device_, nullptr,
@@ -461,6 +469,8 @@ void VulkanDevice::CreateVkDevice(const VulkanInstance& instance) {
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_16BIT_STORAGE_FEATURES};
   VkPhysicalDeviceShaderFloat16Int8Features float16_int8 = {
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_FLOAT16_INT8_FEATURES};
+  VkPhysicalDeviceCooperativeMatrixFeaturesNV cooperative_matrix = {
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_MATRIX_FEATURES_NV};
 
   void** pp_next = &enabled_features.pNext;
   bool needs_float16_int8 = false;
@@ -498,6 +508,12 @@ void VulkanDevice::CreateVkDevice(const VulkanInstance& instance) {
     pp_next = &float16_int8.pNext;
   }
 
+  if (device_properties.supports_cooperative_matrix) {
+    cooperative_matrix.cooperativeMatrix = true;
+    *pp_next = &cooperative_matrix;
+    pp_next = &cooperative_matrix.pNext;
+  }
+
   float priority = 1.0f;
 
   struct VkDeviceQueueCreateInfo queue_create_info;
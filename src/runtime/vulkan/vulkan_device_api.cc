@@ -240,6 +240,9 @@ void VulkanDeviceAPI::GetTargetProperty(Device dev, const std::string& property,
   if (property == "supports_integer_dot_product") {
     *rv = prop.supports_integer_dot_product;
   }
+  if (property == "supports_cooperative_matrix") {
+    *rv = prop.supports_cooperative_matrix;
+  }
 
   if (property == "device_name") {
     *rv = prop.device_name;
@@ -382,21 +385,24 @@ void VulkanDeviceAPI::CopyDataFromTo(const void* from, size_t from_offset, void*
     auto& device = this->device(dev_to.device_id);
     auto& stream = device.ThreadLocalStream();
     const auto* to_buf = static_cast<const VulkanBuffer*>(to);
-    auto& staging_buffer = device.ThreadLocalStagingBuffer(size);
-    memcpy(staging_buffer.host_addr, static_cast<const char*>(from) + from_offset, size);
+    // The staging buffer is owned by the stream until the copy completes, so that the copy is
+    // submitted together with the kernels that follow it.
+    VulkanStagingBuffer* staging_buffer = &stream.UploadStagingBuffer(size);
+    memcpy(staging_buffer->host_addr, static_cast<const char*>(from) + from_offset, size);
     // host side flush if access is not coherent.
     // so writes from CPU is visible to GPU
     if (!device.coherent_staging) {
       VkMappedMemoryRange mrange;
       mrange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
       mrange.pNext = nullptr;
-      mrange.memory = staging_buffer.vk_buf.memory;
+      mrange.memory = staging_buffer->vk_buf.memory;
       mrange.offset = 0;
       mrange.size = VK_WHOLE_SIZE;  // size;
       VULKAN_CALL(vkFlushMappedMemoryRanges(device, 1, &mrange));
     }
 
-    stream.Launch([&](VulkanStreamState* state) {
+    // The kernel may be deferred, so that it captures its arguments by value.
+    stream.Launch([=](VulkanStreamState* state) {
       // 0: barrier(host->transfer)
       VkMemoryBarrier barrier_info;
       barrier_info.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
@@ -411,14 +417,18 @@ void VulkanDeviceAPI::CopyDataFromTo(const void* from, size_t from_offset, void*
       copy_info.srcOffset = 0;
       copy_info.dstOffset = to_offset;
       copy_info.size = size;
-      vkCmdCopyBuffer(state->cmd_buffer_, staging_buffer.vk_buf.buffer, to_buf->buffer, 1,
+      vkCmdCopyBuffer(state->cmd_buffer_, staging_buffer->vk_buf.buffer, to_buf->buffer, 1,
                       &copy_info);
+      // 2: barrier(transfer->compute|transfer)
+      barrier_info.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+      barrier_info.dstAccessMask = (VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT |
+                                    VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+      vkCmdPipelineBarrier(state->cmd_buffer_, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                           1, &barrier_info, 0, nullptr, 0, nullptr);
     });
 
     stream.ProfilerReady();
-    // TODO(tulloch): should we instead make the staging buffer a property of the
-    // Stream? This would allow us to elide synchronizations here.
-    stream.Synchronize();
   } else {
     LOG(FATAL) << "Expect copy from/to Vulkan or between Vulkan"
                << ", from=" << from_dev_type << ", to=" << to_dev_type;
@@ -19,6 +19,9 @@
 
 #include "vulkan_stream.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "../../support/utils.h"
 #include "vulkan_device.h"
 
@@ -26,6 +29,9 @@ namespace tvm {
 namespace runtime {
 namespace vulkan {
 
+/*! \brief The staging memory held by the copies of a stream before it synchronizes. */
+static constexpr const size_t kMaxPendingUploadBytes = 64 << 20;
+
 VulkanStream::VulkanStream(const VulkanDevice* device)
     : device_(device), state_(new VulkanStreamState()) {
   // create command pool
@@ -117,6 +123,31 @@ void VulkanStream::LaunchDeferred(const std::function<void()>& deferred_initiali
   deferred_tokens_[deferred_token.descriptor_set_].push_back(deferred_token);
 }
 
+VulkanStagingBuffer& VulkanStream::UploadStagingBuffer(size_t min_size) {
+  if (!pending_uploads_.empty() && pending_upload_bytes_ + min_size > kMaxPendingUploadBytes) {
+    Synchronize();
+  }
+  // Reuse the smallest free buffer that is large enough.
+  auto best = free_uploads_.end();
+  for (auto it = free_uploads_.begin(); it != free_uploads_.end(); ++it) {
+    if ((*it)->size >= min_size && (best == free_uploads_.end() || (*it)->size < (*best)->size)) {
+      best = it;
+    }
+  }
+  std::unique_ptr<VulkanStagingBuffer> buffer;
+  if (best != free_uploads_.end()) {
+    buffer = std::move(*best);
+    free_uploads_.erase(best);
+  } else {
+    auto usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    buffer = std::make_unique<VulkanStagingBuffer>(*device_, min_size, usage,
+                                                   device_->staging_mtype_index);
+  }
+  pending_upload_bytes_ += buffer->size;
+  pending_uploads_.push_back(std::move(buffer));
+  return *pending_uploads_.back();
+}
+
 void VulkanStream::Synchronize() {
   if (!device_->UseImmediate()) {
     for (const auto& deferred_kernel : deferred_kernels_) {
@@ -156,6 +187,22 @@ void VulkanStream::Synchronize() {
   VULKAN_CALL(vkResetCommandBuffer(state_->cmd_buffer_, 0));
   VULKAN_CALL(vkResetFences(*device_, 1, &(state_->fence_)));
 
+  // The copies have completed, so that their staging buffers can be reused. The buffers left
+  // unused by the last copies are released first when the free buffers grow too large.
+  std::move(pending_uploads_.begin(), pending_uploads_.end(), std::back_inserter(free_uploads_));
+  pending_uploads_.clear();
+  pending_upload_bytes_ = 0;
+  size_t free_upload_bytes = 0;
+  for (const auto& buffer : free_uploads_) {
+    free_upload_bytes += buffer->size;
+  }
+  auto first_kept = free_uploads_.begin();
+  while (first_kept != free_uploads_.end() && free_upload_bytes > kMaxPendingUploadBytes) {
+    free_upload_bytes -= (*first_kept)->size;
+    ++first_kept;
+  }
+  free_uploads_.erase(free_uploads_.begin(), first_kept);
+
   // Re-initialize the command buffer
   VkCommandBufferBeginInfo cb_begin;
   cb_begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
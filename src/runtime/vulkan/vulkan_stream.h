@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "vulkan_amdrgp.h"
+#include "vulkan_buffer.h"
 #include "vulkan_common.h"
 
 namespace tvm {
@@ -114,6 +115,18 @@ class VulkanStream {
     }
   }
 
+  /*! \brief Return a staging buffer for a host to device copy recorded on the stream.
+   *
+   * Unlike the thread-local staging buffer, the buffer is reserved for
+   * the copy until the next call to Synchronize, so that the copy does
+   * not need to be submitted on its own.  Several copies and kernel
+   * launches are then submitted to the GPU together.  The buffers are
+   * reused after the stream is synchronized.
+   *
+   * \param min_size The size in bytes of the staging buffer.
+   */
+  VulkanStagingBuffer& UploadStagingBuffer(size_t min_size);
+
   // Synchronize the current stream `state_` with respect to the host.
   void Synchronize();
 
@@ -126,6 +139,12 @@ class VulkanStream {
   std::vector<std::function<void(VulkanStreamState*)>> deferred_kernels_;
   VkCommandPool cmd_pool_;
   VulkanStreamProfiler* profiler_ = nullptr;
+  // The staging buffers of the copies recorded since the last Synchronize.
+  std::vector<std::unique_ptr<VulkanStagingBuffer>> pending_uploads_;
+  // The staging buffers that can be reused for new copies.
+  std::vector<std::unique_ptr<VulkanStagingBuffer>> free_uploads_;
+  // The total size in bytes of pending_uploads_.
+  size_t pending_upload_bytes_{0};
 };
 
 }  // namespace vulkan
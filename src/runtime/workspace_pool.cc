@@ -23,120 +23,216 @@
  */
 #include "workspace_pool.h"
 
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace tvm {
 namespace runtime {
 
 // page size.
 constexpr size_t kWorkspacePageSize = 4 << 10;
+// number of size classes with an exact page count.
+constexpr size_t kNumExactClasses = 8;
+// number of size classes between two powers of two above that.
+constexpr size_t kClassesPerDoubling = 4;
+// maximum number of cached blocks per size class.
+constexpr size_t kMaxCachedPerClass = 64;
+
+/*!
+ * \brief Map a request to its size class.
+ *  Requests of up to kNumExactClasses pages get their own class; larger ones
+ *  are rounded up to one of kClassesPerDoubling steps per power of two, which
+ *  bounds the internal fragmentation by 25%.
+ * \param nbytes The requested size.
+ * \param class_bytes The size of the class.
+ * \return The index of the class.
+ */
+inline size_t SizeClassOf(size_t nbytes, size_t* class_bytes) {
+  size_t npages = std::max<size_t>((nbytes + kWorkspacePageSize - 1) / kWorkspacePageSize, 1);
+  if (npages <= kNumExactClasses) {
+    *class_bytes = npages * kWorkspacePageSize;
+    return npages - 1;
+  }
+  // 2^k < npages <= 2^(k+1), k >= 3
+  size_t k = 0;
+  while ((static_cast<size_t>(2) << k) < npages) ++k;
+  size_t base = static_cast<size_t>(1) << k;
+  size_t step = base / kClassesPerDoubling;
+  size_t sub = (npages - base + step - 1) / step;
+  *class_bytes = (base + sub * step) * kWorkspacePageSize;
+  return kNumExactClasses + (k - 3) * kClassesPerDoubling + (sub - 1);
+}
+
+// default bound of the cached bytes per pool.
+constexpr size_t kDefaultMaxCachedMB = 1024;
+
+size_t WorkspacePool::DefaultMaxCachedBytes() {
+  static size_t max_cached_bytes = []() -> size_t {
+    const char* val = getenv("TVM_WORKSPACE_POOL_MAX_CACHED_MB");
+    if (val == nullptr || atoll(val) < 0) return kDefaultMaxCachedMB << 20;
+    return static_cast<size_t>(atoll(val)) << 20;
+  }();
+  return max_cached_bytes;
+}
 
 class WorkspacePool::Pool {
  public:
-  // constructor
-  Pool() {
-    // safe guard header on each list.
-    Entry e;
-    e.data = nullptr;
-    e.size = 0;
-    free_list_.push_back(e);
-    allocated_.push_back(e);
-  }
+  explicit Pool(size_t max_cached_bytes) : max_cached_bytes_(max_cached_bytes) {}
   // allocate from pool
   void* Alloc(Device dev, DeviceAPI* device, size_t nbytes) {
-    // Allocate align to page.
-    nbytes = (nbytes + (kWorkspacePageSize - 1)) / kWorkspacePageSize * kWorkspacePageSize;
-    if (nbytes == 0) nbytes = kWorkspacePageSize;
-    Entry e;
-    DLDataType type;
-    type.code = kDLUInt;
-    type.bits = 8;
-    type.lanes = 1;
-    if (free_list_.size() == 2) {
-      e = free_list_.back();
-      free_list_.pop_back();
-      if (e.size < nbytes) {
-        // resize the page
-        device->FreeDataSpace(dev, e.data);
-        e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
-        e.size = nbytes;
-      }
-    } else if (free_list_.size() == 1) {
-      e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
-      e.size = nbytes;
+    size_t class_bytes;
+    size_t index = SizeClassOf(nbytes, &class_bytes);
+    if (index >= bins_.size()) {
+      bins_.resize(index + 1);
+    }
+    num_allocs_.fetch_add(1, std::memory_order_relaxed);
+    void* data;
+    // Without a free block of the class, take one of a larger class of up to
+    // twice its size.
+    size_t cached = index;
+    while (cached + 1 < bins_.size() && bins_[cached].empty() &&
+           ClassPages(cached + 1) <= 2 * ClassPages(index)) {
+      ++cached;
+    }
+    std::vector<void*>& bin = bins_[cached];
+    if (!bin.empty()) {
+      index = cached;
+      class_bytes = ClassPages(index) * kWorkspacePageSize;
+      data = bin.back();
+      bin.pop_back();
+      Add(&bytes_cached_, -static_cast<int64_t>(class_bytes));
+      num_cache_hits_.fetch_add(1, std::memory_order_relaxed);
     } else {
-      if (free_list_.back().size >= nbytes) {
-        // find smallest fit
-        auto it = free_list_.end() - 2;
-        for (; it->size >= nbytes; --it) {
-        }
-        e = *(it + 1);
-        free_list_.erase(it + 1);
-      } else {
-        // resize the page
-        e = free_list_.back();
-        free_list_.pop_back();
-        device->FreeDataSpace(dev, e.data);
-        e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
-        e.size = nbytes;
-      }
+      DLDataType type;
+      type.code = kDLUInt;
+      type.bits = 8;
+      type.lanes = 1;
+      data = device->AllocDataSpace(dev, class_bytes, kTempAllocaAlignment, type);
+      num_device_allocs_.fetch_add(1, std::memory_order_relaxed);
     }
-    allocated_.push_back(e);
-    return e.data;
+    allocated_[data] = index;
+    size_t in_use = Add(&bytes_in_use_, class_bytes);
+    UpdatePeak(&peak_bytes_in_use_, in_use);
+    UpdatePeak(&peak_bytes_reserved_, in_use + bytes_cached_.load(std::memory_order_relaxed));
+    return data;
   }
   // free resource back to pool
-  void Free(void* data) {
-    Entry e;
-    if (allocated_.back().data == data) {
-      // quick path, last allocated.
-      e = allocated_.back();
-      allocated_.pop_back();
-    } else {
-      int index = static_cast<int>(allocated_.size()) - 2;
-      for (; index > 0 && allocated_[index].data != data; --index) {
-      }
-      ICHECK_GT(index, 0) << "trying to free things that has not been allocated";
-      e = allocated_[index];
-      allocated_.erase(allocated_.begin() + index);
-    }
-    if (free_list_.back().size < e.size) {
-      free_list_.push_back(e);
-    } else if (free_list_.size() == 2) {
-      free_list_.push_back(free_list_.back());
-      free_list_[1] = e;
+  void Free(Device dev, DeviceAPI* device, void* data) {
+    auto it = allocated_.find(data);
+    ICHECK(it != allocated_.end()) << "trying to free things that has not been allocated";
+    size_t index = it->second;
+    allocated_.erase(it);
+    size_t class_bytes = ClassPages(index) * kWorkspacePageSize;
+    Add(&bytes_in_use_, -static_cast<int64_t>(class_bytes));
+    std::vector<void*>& bin = bins_[index];
+    if (bin.size() < kMaxCachedPerClass &&
+        bytes_cached_.load(std::memory_order_relaxed) + class_bytes <= max_cached_bytes_) {
+      bin.push_back(data);
+      Add(&bytes_cached_, class_bytes);
     } else {
-      size_t i = free_list_.size() - 1;
-      free_list_.resize(free_list_.size() + 1);
-      for (; e.size < free_list_[i].size; --i) {
-        free_list_[i + 1] = free_list_[i];
-      }
-      free_list_[i + 1] = e;
+      device->FreeDataSpace(dev, data);
+      num_device_frees_.fetch_add(1, std::memory_order_relaxed);
     }
   }
   // Release all resources
   void Release(Device dev, DeviceAPI* device) {
-    for (size_t i = 1; i < free_list_.size(); ++i) {
-      device->FreeDataSpace(dev, free_list_[i].data);
+    for (std::vector<void*>& bin : bins_) {
+      for (void* data : bin) {
+        device->FreeDataSpace(dev, data);
+      }
+      bin.clear();
     }
-    free_list_.clear();
+    bytes_cached_.store(0, std::memory_order_relaxed);
+  }
+  // Accumulate the statistics into stats
+  void AddStats(Stats* stats) const {
+    stats->bytes_in_use += bytes_in_use_.load(std::memory_order_relaxed);
+    stats->peak_bytes_in_use += peak_bytes_in_use_.load(std::memory_order_relaxed);
+    stats->bytes_cached += bytes_cached_.load(std::memory_order_relaxed);
+    stats->peak_bytes_reserved += peak_bytes_reserved_.load(std::memory_order_relaxed);
+    stats->num_allocs += num_allocs_.load(std::memory_order_relaxed);
+    stats->num_cache_hits += num_cache_hits_.load(std::memory_order_relaxed);
+    stats->num_device_allocs += num_device_allocs_.load(std::memory_order_relaxed);
+    stats->num_device_frees += num_device_frees_.load(std::memory_order_relaxed);
   }
 
  private:
-  /*! \brief a single entry in the pool */
-  struct Entry {
-    void* data;
-    size_t size;
-  };
-  /*! \brief List of free items, sorted from small to big size */
-  std::vector<Entry> free_list_;
-  /*! \brief List of allocated items */
-  std::vector<Entry> allocated_;
+  // the number of pages of a size class, inverse of SizeClassOf
+  static size_t ClassPages(size_t index) {
+    if (index < kNumExactClasses) return index + 1;
+    size_t k = (index - kNumExactClasses) / kClassesPerDoubling + 3;
+    size_t sub = (index - kNumExactClasses) % kClassesPerDoubling + 1;
+    size_t base = static_cast<size_t>(1) << k;
+    return base + sub * (base / kClassesPerDoubling);
+  }
+  // The counters are only written by the owning thread, but may be read by
+  // any thread through GetGlobalStats.
+  static size_t Add(std::atomic<size_t>* counter, int64_t delta) {
+    size_t value = counter->load(std::memory_order_relaxed) + delta;
+    counter->store(value, std::memory_order_relaxed);
+    return value;
+  }
+  static void UpdatePeak(std::atomic<size_t>* peak, size_t value) {
+    if (value > peak->load(std::memory_order_relaxed)) {
+      peak->store(value, std::memory_order_relaxed);
+    }
+  }
+  /*! \brief The bound of the bytes kept in the free bins */
+  size_t max_cached_bytes_;
+  /*! \brief Free blocks of each size class */
+  std::vector<std::vector<void*>> bins_;
+  /*! \brief Size class of each allocated block */
+  std::unordered_map<void*, size_t> allocated_;
+  std::atomic<size_t> bytes_in_use_{0};
+  std::atomic<size_t> peak_bytes_in_use_{0};
+  std::atomic<size_t> bytes_cached_{0};
+  std::atomic<size_t> peak_bytes_reserved_{0};
+  std::atomic<uint64_t> num_allocs_{0};
+  std::atomic<uint64_t> num_cache_hits_{0};
+  std::atomic<uint64_t> num_device_allocs_{0};
+  std::atomic<uint64_t> num_device_frees_{0};
+};
+
+/*!
+ * \brief The live pools, used to aggregate statistics across threads.
+ *  The mutex also guards the layout of WorkspacePool::array_.
+ */
+struct WorkspacePoolRegistry {
+  std::mutex mutex;
+  std::vector<const WorkspacePool*> pools;
+
+  static WorkspacePoolRegistry* Global() {
+    // Intentionally leaked, thread local pools may be destroyed after static destruction.
+    static WorkspacePoolRegistry* inst = new WorkspacePoolRegistry();
+    return inst;
+  }
 };
 
 WorkspacePool::WorkspacePool(DLDeviceType device_type, DeviceAPI* device)
-    : device_type_(device_type), device_(device) {}
+    : WorkspacePool(device_type, device, DefaultMaxCachedBytes()) {}
+
+WorkspacePool::WorkspacePool(DLDeviceType device_type, DeviceAPI* device, size_t max_cached_bytes)
+    : device_type_(device_type), device_(device), max_cached_bytes_(max_cached_bytes) {
+  WorkspacePoolRegistry* registry = WorkspacePoolRegistry::Global();
+  std::lock_guard<std::mutex> lock(registry->mutex);
+  registry->pools.push_back(this);
+}
 
 WorkspacePool::~WorkspacePool() {
+  WorkspacePoolRegistry* registry = WorkspacePoolRegistry::Global();
+  {
+    std::lock_guard<std::mutex> lock(registry->mutex);
+    auto it = std::find(registry->pools.begin(), registry->pools.end(), this);
+    if (it != registry->pools.end()) registry->pools.erase(it);
+  }
   for (size_t i = 0; i < array_.size(); ++i) {
     if (array_[i] != nullptr) {
       Device dev;
@@ -149,19 +245,61 @@ WorkspacePool::~WorkspacePool() {
 }
 
 void* WorkspacePool::AllocWorkspace(Device dev, size_t size) {
-  if (static_cast<size_t>(dev.device_id) >= array_.size()) {
-    array_.resize(dev.device_id + 1, nullptr);
-  }
-  if (array_[dev.device_id] == nullptr) {
-    array_[dev.device_id] = new Pool();
+  if (static_cast<size_t>(dev.device_id) >= array_.size() || array_[dev.device_id] == nullptr) {
+    std::lock_guard<std::mutex> lock(WorkspacePoolRegistry::Global()->mutex);
+    if (static_cast<size_t>(dev.device_id) >= array_.size()) {
+      array_.resize(dev.device_id + 1, nullptr);
+    }
+    if (array_[dev.device_id] == nullptr) {
+      array_[dev.device_id] = new Pool(max_cached_bytes_);
+    }
   }
   return array_[dev.device_id]->Alloc(dev, device_, size);
 }
 
 void WorkspacePool::FreeWorkspace(Device dev, void* ptr) {
   ICHECK(static_cast<size_t>(dev.device_id) < array_.size() && array_[dev.device_id] != nullptr);
-  array_[dev.device_id]->Free(ptr);
+  array_[dev.device_id]->Free(dev, device_, ptr);
+}
+
+WorkspacePool::Stats WorkspacePool::GetStats(Device dev) const {
+  Stats stats;
+  if (dev.device_type == device_type_ && dev.device_id >= 0 &&
+      static_cast<size_t>(dev.device_id) < array_.size() && array_[dev.device_id] != nullptr) {
+    array_[dev.device_id]->AddStats(&stats);
+  }
+  return stats;
 }
 
+WorkspacePool::Stats WorkspacePool::GetGlobalStats(Device dev) {
+  Stats stats;
+  WorkspacePoolRegistry* registry = WorkspacePoolRegistry::Global();
+  std::lock_guard<std::mutex> lock(registry->mutex);
+  for (const WorkspacePool* pool : registry->pools) {
+    if (pool->device_type_ == dev.device_type && dev.device_id >= 0 &&
+        static_cast<size_t>(dev.device_id) < pool->array_.size() &&
+        pool->array_[dev.device_id] != nullptr) {
+      pool->array_[dev.device_id]->AddStats(&stats);
+    }
+  }
+  return stats;
+}
+
+TVM_REGISTER_GLOBAL("runtime.WorkspacePoolStats").set_body_typed([](int device_type, int device_id) {
+  Device dev{static_cast<DLDeviceType>(device_type), device_id};
+  WorkspacePool::Stats stats = WorkspacePool::GetGlobalStats(dev);
+  auto count = [](uint64_t value) {
+    return ObjectRef(make_object<profiling::CountNode>(static_cast<int64_t>(value)));
+  };
+  return Map<String, ObjectRef>{{"bytes_in_use", count(stats.bytes_in_use)},
+                                {"peak_bytes_in_use", count(stats.peak_bytes_in_use)},
+                                {"bytes_cached", count(stats.bytes_cached)},
+                                {"peak_bytes_reserved", count(stats.peak_bytes_reserved)},
+                                {"num_allocs", count(stats.num_allocs)},
+                                {"num_cache_hits", count(stats.num_cache_hits)},
+                                {"num_device_allocs", count(stats.num_device_allocs)},
+                                {"num_device_frees", count(stats.num_device_frees)}};
+});
+
 }  // namespace runtime
 }  // namespace tvm
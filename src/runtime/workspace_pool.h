@@ -41,15 +41,47 @@ namespace runtime {
  *  - Only a few allocation will happen, and space will be released after use.
  *  - The release order is usually in reverse order of allocate
  *  - Repeative pattern of same allocations over different runs.
+ *
+ *  Free blocks are kept in size-class bins, so that both allocation and release
+ *  take constant time. A request may also take a free block of a slightly larger
+ *  class. The number of cached blocks per size class is bounded, and so are the
+ *  total cached bytes, by default 1GB per pool or TVM_WORKSPACE_POOL_MAX_CACHED_MB.
  */
 class TVM_DLL WorkspacePool {
  public:
+  /*! \brief Usage statistics of the pools of one device. */
+  struct Stats {
+    /*! \brief The bytes currently handed out. */
+    size_t bytes_in_use = 0;
+    /*! \brief The high-water mark of `bytes_in_use`. */
+    size_t peak_bytes_in_use = 0;
+    /*! \brief The bytes currently cached in the free bins. */
+    size_t bytes_cached = 0;
+    /*! \brief The high-water mark of the bytes held from the device, in use or cached. */
+    size_t peak_bytes_reserved = 0;
+    /*! \brief The number of calls to AllocWorkspace. */
+    uint64_t num_allocs = 0;
+    /*! \brief The number of allocations served from the free bins. */
+    uint64_t num_cache_hits = 0;
+    /*! \brief The number of allocations forwarded to the device API. */
+    uint64_t num_device_allocs = 0;
+    /*! \brief The number of blocks released to the device API. */
+    uint64_t num_device_frees = 0;
+  };
   /*!
    * \brief Create pool with specific device type and device.
    * \param device_type The device type.
    * \param device_api The device API.
    */
   WorkspacePool(DLDeviceType device_type, DeviceAPI* device_api);
+  /*!
+   * \brief Create pool with specific device type and device.
+   * \param device_type The device type.
+   * \param device_api The device API.
+   * \param max_cached_bytes The bound of the bytes cached per device, blocks
+   *  freed over it are released to the device.
+   */
+  WorkspacePool(DLDeviceType device_type, DeviceAPI* device_api, size_t max_cached_bytes);
   /*! \brief destructor */
   ~WorkspacePool();
   /*!
@@ -65,6 +97,24 @@ class TVM_DLL WorkspacePool {
    * \param ptr The pointer to be freed.
    */
   void FreeWorkspace(Device dev, void* ptr);
+  /*!
+   * \brief Get the usage statistics of this pool on a device.
+   * \param dev The device.
+   * \return The statistics, all zero if the device was never used.
+   */
+  Stats GetStats(Device dev) const;
+  /*!
+   * \brief Get the usage statistics summed over all live pools on a device,
+   *  e.g. the thread local pools of every thread using the device.
+   * \param dev The device.
+   * \return The statistics.
+   */
+  static Stats GetGlobalStats(Device dev);
+  /*!
+   * \brief The default bound of the cached bytes per device of a pool,
+   *  TVM_WORKSPACE_POOL_MAX_CACHED_MB if set, 1GB otherwise.
+   */
+  static size_t DefaultMaxCachedBytes();
 
  private:
   class Pool;
@@ -74,6 +124,8 @@ class TVM_DLL WorkspacePool {
   DLDeviceType device_type_;
   /*! \brief The device API */
   DeviceAPI* device_;
+  /*! \brief The bound of the cached bytes per device */
+  size_t max_cached_bytes_;
 };
 
 }  // namespace runtime
@@ -29,6 +29,9 @@ std::vector<ByteSpan> MergeAndExemptSpans(const std::vector<ByteSpan>& spans,
                                           const std::vector<ByteSpan>& spans_exempted) {
   // use prefix sum to merge and exempt spans
   std::vector<ByteSpan> res;
+  if (spans.empty()) {
+    return res;
+  }
   std::vector<std::pair<size_t, int>> prefix_stamp;
   for (ByteSpan span : spans) {
     prefix_stamp.push_back({span.first, 1});
@@ -216,6 +219,10 @@ std::string DecorateText(const std::string& text, const std::vector<size_t>& lin
   size_t line_number_width = GetLineNumberWidth(num_lines, options);
 
   std::string ret;
+  if (underlines.empty() && !options->print_line_numbers) {
+    // Nothing to decorate
+    return text;
+  }
   if (underlines.empty()) {
     PrintChunk({0, num_lines}, {underlines.begin(), underlines.begin()}, text, line_starts, options,
                line_number_width, &ret);
@@ -292,7 +299,8 @@ String DocPrinter::GetString() const {
 }
 
 void DocPrinter::PrintDoc(const Doc& doc) {
-  size_t start_pos = output_.tellp();
+  // The spans of the docs are only needed for underlining
+  size_t start_pos = path_to_underline_.empty() ? 0 : static_cast<size_t>(output_.tellp());
 
   if (auto doc_node = doc.as<LiteralDoc>()) {
     PrintTypedDoc(doc_node.value());
@@ -347,6 +355,9 @@ void DocPrinter::PrintDoc(const Doc& doc) {
     throw;
   }
 
+  if (path_to_underline_.empty()) {
+    return;
+  }
   size_t end_pos = output_.tellp();
   for (const ObjectPath& path : doc->source_paths) {
     MarkSpan({start_pos, end_pos}, path);
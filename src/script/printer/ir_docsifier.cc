@@ -21,6 +21,10 @@
 #include <tvm/runtime/registry.h>
 #include <tvm/script/printer/ir_docsifier.h>
 
+#include <algorithm>
+#include <cctype>
+#include <string>
+
 #include "./utils.h"
 
 namespace tvm {
@@ -29,7 +33,7 @@ namespace printer {
 
 IdDoc IRDocsifierNode::Define(const ObjectRef& obj, const Frame& frame, const String& name_hint) {
   ICHECK(obj2info.find(obj) == obj2info.end()) << "Duplicated object: " << obj;
-  String name = GenerateUniqueName(name_hint, this->defined_names);
+  String name = GenerateUniqueName(name_hint, this->defined_names, &this->name_suffix_begin);
   this->defined_names.insert(name);
   DocCreator doc_factory = [name]() { return IdDoc(name); };
   obj2info.insert({obj, VariableInfo{std::move(doc_factory), name}});
@@ -55,11 +59,13 @@ Optional<ExprDoc> IRDocsifierNode::GetVarDoc(const ObjectRef& obj) const {
 ExprDoc IRDocsifierNode::AddMetadata(const ObjectRef& obj) {
   ICHECK(obj.defined()) << "TypeError: Cannot add nullptr to metadata";
   String key = obj->GetTypeKey();
-  Array<ObjectRef>& array = metadata[key];
-  int index = std::find(array.begin(), array.end(), obj) - array.begin();
-  if (index == static_cast<int>(array.size())) {
+  auto [it, inserted] = metadata_index.emplace(obj, 0);
+  if (inserted) {
+    Array<ObjectRef>& array = metadata[key];
+    it->second = array.size();
     array.push_back(obj);
   }
+  int index = it->second;
   return IdDoc("metadata")[{LiteralDoc::Str(key, NullOpt)}][{LiteralDoc::Int(index, NullOpt)}];
 }
 
@@ -69,7 +75,18 @@ void IRDocsifierNode::RemoveVar(const ObjectRef& obj) {
   auto it = obj2info.find(obj);
   ICHECK(it != obj2info.end()) << "No such object: " << obj;
   if (it->second.name.defined()) {
-    defined_names.erase(it->second.name.value());
+    const String& name = it->second.name.value();
+    defined_names.erase(name);
+    // A suffixed name is free again, e.g. `i_2` for the name hint `i`
+    std::string str = name;
+    size_t pos = str.rfind('_');
+    if (pos != std::string::npos && pos + 1 < str.size() && str.size() - pos <= 9 &&
+        std::all_of(str.begin() + pos + 1, str.end(), [](char c) { return std::isdigit(c); })) {
+      auto suffix_it = name_suffix_begin.find(str.substr(0, pos));
+      if (suffix_it != name_suffix_begin.end()) {
+        suffix_it->second = std::min(suffix_it->second, std::stoi(str.substr(pos + 1)));
+      }
+    }
   }
   obj2info.erase(it);
 }
@@ -22,7 +22,9 @@
 #include <tvm/node/serialization.h>
 #include <tvm/script/printer/ir_docsifier.h>
 
+#include <algorithm>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -153,15 +155,26 @@ inline Optional<String> FindFunctionName(const IRDocsifier& d, const BaseFunc& f
 }
 
 inline String GenerateUniqueName(std::string name_hint,
-                                 const std::unordered_set<String>& defined_names) {
+                                 const std::unordered_set<String>& defined_names,
+                                 std::unordered_map<std::string, int>* suffix_begin = nullptr) {
   for (char& c : name_hint) {
     if (c != '_' && !std::isalnum(c)) {
       c = '_';
     }
   }
   std::string name = name_hint;
-  for (int i = 1; defined_names.count(name) > 0; ++i) {
-    name = name_hint + "_" + std::to_string(i);
+  if (defined_names.count(name) == 0) {
+    return name;
+  }
+  // The suffixes below `suffix_begin` are known to be used
+  int* begin = suffix_begin != nullptr ? &(*suffix_begin)[name_hint] : nullptr;
+  int i = begin != nullptr ? std::max(*begin, 1) : 1;
+  name = name_hint + "_" + std::to_string(i);
+  while (defined_names.count(name) > 0) {
+    name = name_hint + "_" + std::to_string(++i);
+  }
+  if (begin != nullptr) {
+    *begin = i + 1;
   }
   return name;
 }
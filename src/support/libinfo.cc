@@ -55,6 +55,10 @@
 #define TVM_INFO_USE_VULKAN "NOT-FOUND"
 #endif
 
+#ifndef TVM_INFO_USE_VM_CUDA_GRAPH
+#define TVM_INFO_USE_VM_CUDA_GRAPH "NOT-FOUND"
+#endif
+
 #ifndef TVM_INFO_USE_METAL
 #define TVM_INFO_USE_METAL "NOT-FOUND"
 #endif
@@ -195,6 +199,14 @@
 #define TVM_INFO_USE_RANDOM "NOT-FOUND"
 #endif
 
+#ifndef TVM_INFO_USE_COLLECTIVE
+#define TVM_INFO_USE_COLLECTIVE "NOT-FOUND"
+#endif
+
+#ifndef TVM_INFO_USE_NCCL
+#define TVM_INFO_USE_NCCL "NOT-FOUND"
+#endif
+
 #ifndef TVM_INFO_USE_MICRO_STANDALONE_RUNTIME
 #define TVM_INFO_USE_MICRO_STANDALONE_RUNTIME "NOT-FOUND"
 #endif
@@ -281,12 +293,14 @@ TVM_DLL Map<String, String> GetLibInfo() {
       {"USE_CUBLAS", TVM_INFO_USE_CUBLAS},
       {"USE_CUDA", TVM_INFO_USE_CUDA},
       {"USE_CUDNN", TVM_INFO_USE_CUDNN},
+      {"USE_CUPTI", TVM_INFO_USE_CUPTI},
       {"USE_CUSTOM_LOGGING", TVM_INFO_USE_CUSTOM_LOGGING},
       {"USE_CUTLASS", TVM_INFO_USE_CUTLASS},
       {"USE_AMX", TVM_INFO_USE_AMX},
       {"USE_DNNL", TVM_INFO_USE_DNNL},
       {"USE_ETHOSN", TVM_INFO_USE_ETHOSN},
       {"USE_FALLBACK_STL_MAP", TVM_INFO_USE_FALLBACK_STL_MAP},
+      {"USE_GBENCHMARK", TVM_INFO_USE_GBENCHMARK},
       {"USE_GRAPH_EXECUTOR_CUDA_GRAPH", TVM_INFO_USE_GRAPH_EXECUTOR_CUDA_GRAPH},
       {"USE_GRAPH_EXECUTOR", TVM_INFO_USE_GRAPH_EXECUTOR},
       {"USE_GTEST", TVM_INFO_USE_GTEST},
@@ -333,7 +347,10 @@ TVM_DLL Map<String, String> GetLibInfo() {
       {"USE_THREADS", TVM_INFO_USE_THREADS},
       {"USE_THRUST", TVM_INFO_USE_THRUST},
       {"USE_CURAND", TVM_INFO_USE_CURAND},
+      {"USE_NCCL", TVM_INFO_USE_NCCL},
+      {"USE_COLLECTIVE", TVM_INFO_USE_COLLECTIVE},
       {"USE_VITIS_AI", TVM_INFO_USE_VITIS_AI},
+      {"USE_VM_CUDA_GRAPH", TVM_INFO_USE_VM_CUDA_GRAPH},
       {"USE_VULKAN", TVM_INFO_USE_VULKAN},
       {"USE_CLML", TVM_INFO_USE_CLML},
       {"USE_CLML_GRAPH_EXECUTOR", TVM_INFO_USE_CLML_GRAPH_EXECUTOR},
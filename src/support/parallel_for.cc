@@ -24,7 +24,13 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/support/parallel_for.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <future>
+#include <mutex>
+#include <numeric>
+#include <string>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -93,51 +99,221 @@ void parallel_for(int begin, int end, const std::function<void(int)>& f, int ste
   }
 }
 
-void parallel_for_dynamic(int begin, int end, int num_threads,
-                          const std::function<void(int thread_id, int task_id)>& f) {
-  // Step 1. Sanity checks
-  if (begin == end) {
-    return;
+namespace {
+
+/*!
+ * \brief A persistent pool of worker threads backing `parallel_for_dynamic` and
+ * `parallel_for_guided`, so that repeated calls do not pay for thread creation.
+ * Worker `i` of the pool always runs as `thread_id = i`, the caller runs as `thread_id = 0`.
+ */
+class ParallelForWorkerPool {
+ public:
+  static ParallelForWorkerPool* Global() {
+    // Intentionally leaked: the workers are parked forever and must outlive static destruction.
+    static ParallelForWorkerPool* pool = new ParallelForWorkerPool();
+    return pool;
   }
-  CHECK_LE(begin, end) << "ValueError: The interval [begin, end) requires `begin <= end`";
-  CHECK_GT(num_threads, 0) << "ValueError: `num_threads` should be positive";
-  // Step 2. Launch threads
-  // Step 2.1. Launch worker 1 to worker `num_threads - 1`
-  std::atomic<int> counter{begin};
-  std::vector<std::future<void>> futures;
-  std::vector<std::thread> threads;
-  futures.reserve(num_threads - 1);
-  threads.reserve(num_threads - 1);
-  auto worker = [end, &counter, &f](int thread_id) -> void {
-    for (int task_id; (task_id = counter++) < end;) {
-      f(thread_id, task_id);
+
+  /*!
+   * \brief Run `worker(thread_id)` for every thread_id in [0, num_threads) on the pool.
+   * \return false if the pool cannot be used, i.e. it is already serving another call or the
+   * calling thread is one of its workers. The caller should then fall back to fresh threads.
+   * \note `worker` must not throw.
+   */
+  bool TryRun(int num_threads, const std::function<void(int)>& worker) {
+    if (is_worker_) {
+      return false;
     }
-  };
-  for (int thread_id = 1; thread_id < num_threads; ++thread_id) {
-    std::packaged_task<void(int)> task(worker);
-    futures.emplace_back(task.get_future());
-    threads.emplace_back(std::move(task), thread_id);
+    std::unique_lock<std::mutex> run_lock(run_mutex_, std::try_to_lock);
+    if (!run_lock.owns_lock()) {
+      return false;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      while (static_cast<int>(threads_.size()) < num_threads - 1) {
+        int thread_id = static_cast<int>(threads_.size()) + 1;
+        threads_.emplace_back([this, thread_id]() { this->WorkerLoop(thread_id); });
+        threads_.back().detach();
+      }
+      job_ = &worker;
+      job_num_threads_ = num_threads;
+      num_pending_ = num_threads - 1;
+      ++generation_;
+    }
+    job_cv_.notify_all();
+    worker(0);
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return num_pending_ == 0; });
+    job_ = nullptr;
+    return true;
   }
-  // Step 2.2. Launch worker 0 inplace
-  try {
+
+ private:
+  void WorkerLoop(int thread_id) {
+    is_worker_ = true;
+    uint64_t seen_generation = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      job_cv_.wait(lock, [this, &seen_generation]() { return generation_ != seen_generation; });
+      seen_generation = generation_;
+      if (thread_id >= job_num_threads_) {
+        continue;
+      }
+      const std::function<void(int)>* job = job_;
+      lock.unlock();
+      (*job)(thread_id);
+      lock.lock();
+      if (--num_pending_ == 0) {
+        done_cv_.notify_one();
+      }
+    }
+  }
+
+  /*! \brief Serializes the callers of the pool. */
+  std::mutex run_mutex_;
+  /*! \brief Protects the job state below. */
+  std::mutex mutex_;
+  std::condition_variable job_cv_;
+  std::condition_variable done_cv_;
+  std::vector<std::thread> threads_;
+  const std::function<void(int)>* job_{nullptr};
+  int job_num_threads_{0};
+  int num_pending_{0};
+  uint64_t generation_{0};
+  static thread_local bool is_worker_;
+};
+
+thread_local bool ParallelForWorkerPool::is_worker_ = false;
+
+/*!
+ * \brief The divisor of the guided schedule: each grab takes `1 / (kGuidedChunkFactor *
+ * num_threads)` of the remaining work, so the last chunks are small enough to balance the tail.
+ */
+constexpr int kGuidedChunkFactor = 2;
+
+/*!
+ * \brief Run a self-scheduled loop over positions [0, n).
+ * \param n The number of positions.
+ * \param num_threads The number of threads to be used.
+ * \param next_chunk Given the current position, returns the exclusive end of the next chunk.
+ * \param f The task function, taking the thread index and the position.
+ */
+void RunSelfScheduled(int n, int num_threads, const std::function<int(int)>& next_chunk,
+                      const std::function<void(int thread_id, int pos)>& f) {
+  std::atomic<int> counter{0};
+  std::mutex error_mutex;
+  std::string error;
+  auto worker = [n, &counter, &next_chunk, &f, &error_mutex, &error](int thread_id) -> void {
+    try {
+      for (int lo = counter.load(std::memory_order_relaxed); lo < n;) {
+        int hi = next_chunk(lo);
+        if (!counter.compare_exchange_weak(lo, hi, std::memory_order_relaxed)) {
+          continue;
+        }
+        for (int pos = lo; pos < hi; ++pos) {
+          f(thread_id, pos);
+        }
+        lo = counter.load(std::memory_order_relaxed);
+      }
+    } catch (const std::exception& e) {
+      // Stop handing out new chunks and keep the first error.
+      counter.store(n);
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (error.empty()) {
+        error = e.what();
+      }
+    }
+  };
+  if (num_threads == 1) {
+    worker(0);
+  } else if (!ParallelForWorkerPool::Global()->TryRun(num_threads, worker)) {
+    // The pool is busy, e.g. a nested call from one of its workers. Use dedicated threads.
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (int thread_id = 1; thread_id < num_threads; ++thread_id) {
+      threads.emplace_back(worker, thread_id);
+    }
     worker(0);
-  } catch (const std::exception& e) {
     for (auto&& thread : threads) {
       thread.join();
     }
-    LOG(FATAL) << "RuntimeError: parallel_for_dynamic error with " << e.what();
   }
-  // Step 3. Join threads and check exceptions
-  for (auto&& thread : threads) {
-    thread.join();
+  if (!error.empty()) {
+    LOG(FATAL) << "RuntimeError: parallel_for_dynamic error with " << error;
   }
-  try {
-    for (auto&& future : futures) {
-      future.get();
-    }
-  } catch (const std::exception& e) {
-    LOG(FATAL) << "RuntimeError: parallel_for_dynamic error with " << e.what();
+}
+
+void CheckDynamicArgs(int begin, int end, int num_threads) {
+  CHECK_LE(begin, end) << "ValueError: The interval [begin, end) requires `begin <= end`";
+  CHECK_GT(num_threads, 0) << "ValueError: `num_threads` should be positive";
+}
+
+}  // namespace
+
+void parallel_for_dynamic(int begin, int end, int num_threads,
+                          const std::function<void(int thread_id, int task_id)>& f) {
+  if (begin == end) {
+    return;
+  }
+  CheckDynamicArgs(begin, end, num_threads);
+  RunSelfScheduled(
+      end - begin, num_threads, [](int lo) { return lo + 1; },
+      [begin, &f](int thread_id, int pos) { f(thread_id, begin + pos); });
+}
+
+void parallel_for_guided(int begin, int end, int num_threads,
+                         const std::function<void(int thread_id, int task_id)>& f,
+                         int min_chunk_size) {
+  if (begin == end) {
+    return;
+  }
+  CheckDynamicArgs(begin, end, num_threads);
+  CHECK_GT(min_chunk_size, 0) << "ValueError: `min_chunk_size` should be positive";
+  int n = end - begin;
+  int divisor = kGuidedChunkFactor * num_threads;
+  RunSelfScheduled(
+      n, num_threads,
+      [n, divisor, min_chunk_size](int lo) {
+        int chunk = std::max(min_chunk_size, (n - lo) / divisor);
+        return std::min(n, lo + chunk);
+      },
+      [begin, &f](int thread_id, int pos) { f(thread_id, begin + pos); });
+}
+
+void parallel_for_guided(int begin, int end, int num_threads, const std::vector<double>& costs,
+                         const std::function<void(int thread_id, int task_id)>& f,
+                         int min_chunk_size) {
+  if (begin == end) {
+    return;
+  }
+  CheckDynamicArgs(begin, end, num_threads);
+  CHECK_GT(min_chunk_size, 0) << "ValueError: `min_chunk_size` should be positive";
+  int n = end - begin;
+  CHECK_EQ(costs.size(), static_cast<size_t>(n))
+      << "ValueError: Expect one cost hint per task, but got " << costs.size() << " hints for "
+      << n << " tasks";
+  // Step 1. Visit the most expensive tasks first, so that the tail consists of cheap ones
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&costs](int a, int b) { return costs[a] > costs[b]; });
+  // Step 2. Prefix sums of the costs in visiting order, used to size each chunk by cost
+  std::vector<double> prefix(n + 1, 0.0);
+  for (int i = 0; i < n; ++i) {
+    prefix[i + 1] = prefix[i] + std::max(costs[order[i]], 0.0);
   }
+  int divisor = kGuidedChunkFactor * num_threads;
+  RunSelfScheduled(
+      n, num_threads,
+      [n, divisor, min_chunk_size, &prefix](int lo) {
+        double target = prefix[lo] + (prefix[n] - prefix[lo]) / divisor;
+        int hi = std::upper_bound(prefix.begin() + lo + 1, prefix.end(), target) - prefix.begin();
+        // `prefix[hi - 1]` is the last boundary not exceeding the target. Cap the chunk at the
+        // count-based guided size, so that cheap or zero-cost tasks are still spread out.
+        int max_chunk = std::max(min_chunk_size, (n - lo) / divisor);
+        return std::min({n, lo + max_chunk, std::max(lo + min_chunk_size, hi - 1)});
+      },
+      [begin, &f, &order](int thread_id, int pos) { f(thread_id, begin + order[pos]); });
 }
 
 }  // namespace support
@@ -37,6 +37,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include "../runtime/library_module.h"
+
 namespace tvm {
 namespace codegen {
 
@@ -63,7 +65,7 @@ class ModuleSerializer {
  public:
   explicit ModuleSerializer(runtime::Module mod) : mod_(mod) { Init(); }
 
-  void SerializeModule(dmlc::Stream* stream) {
+  void SerializeModule(dmlc::SeekStream* stream) {
     // Only have one DSO module and it is in the root, then
     // we will not produce import_tree_.
     bool has_import_tree = true;
@@ -81,17 +83,21 @@ class ModuleSerializer {
     }
     stream->Write(sz);
 
+    // The offsets of the entries, see runtime::kModuleBlobEntryTableMagic.
+    std::vector<uint64_t> entry_offsets;
     for (const auto& group : mod_group_vec_) {
       ICHECK_NE(group.size(), 0) << "Every allocated group must have at least one module";
       if (!group[0]->IsDSOExportable()) {
         ICHECK_EQ(group.size(), 1U) << "Non DSO module is never merged";
         std::string mod_type_key = group[0]->type_key();
+        entry_offsets.push_back(stream->Tell());
         stream->Write(mod_type_key);
         group[0]->SaveToBinary(stream);
       } else {
         // DSOExportable: do not need binary
         if (has_import_tree) {
           std::string mod_type_key = "_lib";
+          entry_offsets.push_back(stream->Tell());
           stream->Write(mod_type_key);
         }
       }
@@ -100,10 +106,18 @@ class ModuleSerializer {
     // Write _import_tree key if we have
     if (has_import_tree) {
       std::string import_key = "_import_tree";
+      entry_offsets.push_back(stream->Tell());
       stream->Write(import_key);
       stream->Write(import_tree_row_ptr_);
       stream->Write(import_tree_child_indices_);
     }
+
+    ICHECK_EQ(entry_offsets.size(), sz);
+    for (uint64_t offset : entry_offsets) {
+      stream->Write(offset);
+    }
+    stream->Write(sz);
+    stream->Write(runtime::kModuleBlobEntryTableMagic);
   }
 
  private:
@@ -231,7 +245,7 @@ namespace {
 std::string SerializeModule(const runtime::Module& mod) {
   std::string bin;
   dmlc::MemoryStringStream ms(&bin);
-  dmlc::Stream* stream = &ms;
+  dmlc::SeekStream* stream = &ms;
 
   ModuleSerializer module_serializer(mod);
   module_serializer.SerializeModule(stream);
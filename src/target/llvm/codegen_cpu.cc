@@ -49,9 +49,11 @@
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Transforms/Utils/ModuleUtils.h>
+#include <tvm/ir/transform.h>
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/module.h>
 #include <tvm/tir/analysis.h>
+#include <tvm/tir/stmt_functor.h>
 
 #include <algorithm>
 #include <memory>
@@ -78,6 +80,9 @@ void CodeGenCPU::Init(const std::string& module_name, LLVMTarget* llvm_target, b
   static_assert(sizeof(TVMValue) == sizeof(double), "invariant");
   func_handle_map_.clear();
   export_system_symbols_.clear();
+  merge_parallel_launch_ = tvm::transform::PassContext::Current()
+                               ->GetConfig<Bool>("tir.merge_parallel_launch", Bool(false))
+                               .value();
 
   // Runtime types.
 
@@ -224,6 +229,8 @@ void CodeGenCPU::AddFunction(const PrimFunc& f) {
   di_subprogram_ = CreateDebugFunction(f);
 #endif
   EmitDebugLocation(f->span);
+  auto func_name = f->GetAttr<String>(tvm::attr::kGlobalSymbol);
+  profile_func_name_ = func_name.defined() ? func_name.value() : String("");
   CodeGenLLVM::AddFunction(f);
   if (f_tvm_register_system_symbol_ != nullptr) {
     auto global_symbol = f->GetAttr<String>(tvm::attr::kGlobalSymbol);
@@ -547,6 +554,8 @@ void CodeGenCPU::InitGlobalContext(bool dynamic_lookup) {
       // Mark as context functions
       gv_func_map_["TVMBackendAllocWorkspace"] = nullptr;
       gv_func_map_["TVMBackendFreeWorkspace"] = nullptr;
+      gv_func_map_["TVMBackendProfileRegionBegin"] = nullptr;
+      gv_func_map_["TVMBackendProfileRegionEnd"] = nullptr;
     }
   }
 }
@@ -691,6 +700,32 @@ void CodeGenCPU::UnpackClosureData(TypedPointer cdata, const Array<Var>& vfields
   }
 }
 
+namespace {
+
+/*!
+ * \brief Whether a statement may return from the parallel lambda before it completes, on a failed
+ *  assertion or call. The other tasks would then wait forever at the barrier that follows it.
+ */
+bool MayExitEarly(const Stmt& stmt) {
+  bool exit_early = false;
+  tir::PostOrderVisit(stmt, [&exit_early](const ObjectRef& node) {
+    if (node->IsInstance<AssertStmtNode>()) {
+      exit_early = true;
+    } else if (const auto* attr = node.as<AttrStmtNode>()) {
+      exit_early = exit_early || attr->attr_key == tir::attr::compute_scope;
+    } else if (const auto* call = node.as<CallNode>()) {
+      exit_early = exit_early || call->op.same_as(builtin::tvm_call_packed_lowered()) ||
+                   call->op.same_as(builtin::tvm_call_cpacked_lowered()) ||
+                   call->op.same_as(builtin::tvm_call_trace_packed_lowered()) ||
+                   call->op.same_as(builtin::tvm_throw_last_error()) ||
+                   call->op.same_as(builtin::ret());
+    }
+  });
+  return exit_early;
+}
+
+}  // namespace
+
 void CodeGenCPU::CreateParallelLaunch(const Stmt& body, int num_task, std::string name) {
   // closure data
   llvm::Function* f =
@@ -1420,6 +1455,13 @@ llvm::Value* CodeGenCPU::CreateIntrinsic(const CallNode* op) {
     return CreateCallPacked(op, false /* use_string_lookup */);
   } else if (op->op.same_as(builtin::tvm_static_handle())) {
     return CreateStaticHandle();
+  } else if (op->op.same_as(builtin::start_profile_intrinsic())) {
+    // Recorded by the loop profiler of the runtime, see profiling::StartLoopProfiling.
+    return CreateCallExtern(PrimType(DataType::Int(32)), "TVMBackendProfileRegionBegin",
+                            {StringImm(profile_func_name_), op->args[0]}, false);
+  } else if (op->op.same_as(builtin::end_profile_intrinsic())) {
+    return CreateCallExtern(PrimType(DataType::Int(32)), "TVMBackendProfileRegionEnd",
+                            {op->args[0]}, false);
   } else if (op->op.same_as(builtin::tvm_throw_last_error())) {
     builder_->CreateRet(ConstInt32(-1));
     auto next_block = std::next(builder_->GetInsertBlock()->getIterator());
@@ -1584,6 +1626,47 @@ void CodeGenCPU::VisitStmt_(const ForNode* op) {
   }
 }
 
+void CodeGenCPU::VisitStmt_(const SeqStmtNode* op) {
+  if (!merge_parallel_launch_ || parallel_env_.penv != nullptr) {
+    CodeGenLLVM::VisitStmt_(op);
+    return;
+  }
+  EmitDebugLocation(op);
+  auto is_parallel_loop = [](const Stmt& stmt) {
+    const auto* loop = stmt.as<ForNode>();
+    return loop != nullptr && loop->kind == ForKind::kParallel;
+  };
+  size_t begin = 0;
+  while (begin < op->seq.size()) {
+    // Adjacent parallel loops run in one launch, with a barrier after each loop but the last,
+    // so that every task has finished a loop before any task starts the next one.
+    size_t end = begin + 1;
+    if (is_parallel_loop(op->seq[begin])) {
+      while (end < op->seq.size() && is_parallel_loop(op->seq[end]) &&
+             !MayExitEarly(op->seq[end - 1])) {
+        ++end;
+      }
+    }
+    if (end - begin == 1) {
+      this->VisitStmt(op->seq[begin]);
+    } else {
+      Array<Stmt> loops;
+      for (size_t i = begin; i < end; ++i) {
+        Stmt loop = op->seq[i];
+        if (i + 1 != end) {
+          loop = AttrStmt(make_zero(DataType::Int(32)), "pragma_parallel_barrier_when_finish", 1,
+                          loop);
+        }
+        loops.push_back(loop);
+      }
+      const auto* first = op->seq[begin].as<ForNode>();
+      CreateParallelLaunch(SeqStmt(loops), 0,
+                           std::string("merged_parallel_") + first->loop_var->name_hint.c_str());
+    }
+    begin = end;
+  }
+}
+
 TVM_REGISTER_GLOBAL("tvm.codegen.llvm.target_cpu")
     .set_body([](const TVMArgs& targs, TVMRetValue* rv) {
       *rv = static_cast<void*>(new CodeGenCPU());
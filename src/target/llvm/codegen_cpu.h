@@ -72,6 +72,7 @@ class CodeGenCPU : public CodeGenLLVM {
   void VisitStmt_(const AssertStmtNode* op) override;
   void VisitStmt_(const AttrStmtNode* op) override;
   void VisitStmt_(const ForNode* op) override;
+  void VisitStmt_(const SeqStmtNode* op) override;
   llvm::Value* CreateIntrinsic(const CallNode* op) override;
   llvm::Value* CreateCallExtern(Type ret_type, String global_symbol, const Array<PrimExpr>& args,
                                 bool skip_first_arg) override;
@@ -192,6 +193,10 @@ class CodeGenCPU : public CodeGenLLVM {
   std::unique_ptr<DebugInfo> dbg_info_;
   bool target_c_runtime_;
   bool is_system_lib_;
+  // Whether adjacent parallel loops share a single parallel launch, see tir.merge_parallel_launch
+  bool merge_parallel_launch_{false};
+  // The name of the function the profile intrinsics are attributed to.
+  String profile_func_name_;
 
   // Get the DWARF type corresponding to the LLVM type |ty|. The current API in practice only
   // generates |int32|, and |int8*|.
@@ -176,6 +176,9 @@ void CodeGenLLVM::InitTarget() {
       native_vector_bits_ = 256;
     } else if (arch == llvm::Triple::arm || arch == llvm::Triple::aarch64) {
       native_vector_bits_ = 128;
+    } else if (arch == llvm::Triple::wasm32 || arch == llvm::Triple::wasm64) {
+      // simd128, without it the vectors are scalarized.
+      native_vector_bits_ = 128;
     } else {
       native_vector_bits_ = 128;
       std::string arch_name = std::string(tm->getTargetTriple().getArchName());
@@ -729,6 +732,36 @@ llvm::Value* CodeGenLLVM::CreateVecSlice(llvm::Value* vec, int begin, int extent
   return builder_->CreateShuffleVector(vec, vec, llvm::ConstantVector::get(indices));
 }
 
+llvm::Value* CodeGenLLVM::CreateVecReduce(const Op& op, DataType t, llvm::Value* vec) {
+  auto combine = [&](llvm::Value* a, llvm::Value* b) -> llvm::Value* {
+    if (op.same_as(builtin::vector_reduce_add())) {
+      return CreateAdd(t, a, b);
+    } else if (op.same_as(builtin::vector_reduce_mul())) {
+      return CreateMul(t, a, b);
+    } else if (op.same_as(builtin::vector_reduce_min())) {
+      return builder_->CreateSelect(CreateLT(t, a, b), a, b);
+    } else {
+      ICHECK(op.same_as(builtin::vector_reduce_max()));
+      return builder_->CreateSelect(CreateGT(t, a, b), a, b);
+    }
+  };
+  // Combine the two halves of the vector until a single lane is left, which takes log2(lanes)
+  // vector operations. The last lane of an odd number of lanes is combined at the end.
+  llvm::Value* rest = nullptr;
+  int lanes = GetVectorNumElements(vec);
+  while (lanes > 1) {
+    if (lanes % 2 == 1) {
+      llvm::Value* last = builder_->CreateExtractElement(vec, ConstInt32(lanes - 1));
+      rest = rest == nullptr ? last : combine(rest, last);
+      vec = CreateVecSlice(vec, 0, --lanes);
+    }
+    lanes /= 2;
+    vec = combine(CreateVecSlice(vec, 0, lanes), CreateVecSlice(vec, lanes, lanes));
+  }
+  llvm::Value* result = builder_->CreateExtractElement(vec, ConstInt32(0));
+  return rest == nullptr ? result : combine(result, rest);
+}
+
 llvm::Value* CodeGenLLVM::CreateVecFlip(llvm::Value* vec) {
   int num_elems = GetVectorNumElements(vec);
 #if TVM_LLVM_VERSION >= 110
@@ -1339,6 +1372,30 @@ llvm::Value* CodeGenLLVM::CreateIntrinsic(const CallNode* op) {
     TypedPointer buffer_ptr = CreateBufferPtr(MakeValue(load->buffer->data), load->buffer->dtype,
                                               indices_val, load->dtype);
     return buffer_ptr.addr;
+  } else if (op->op.same_as(builtin::masked_load())) {
+    // Lowered to AVX-512 mask registers, SVE predicates, etc. by the backend.
+    llvm::Value* ptr = MakeValue(op->args[0]);
+    llvm::Value* mask = MakeValue(op->args[1]);
+    llvm::Value* passthru = MakeValue(op->args[2]);
+    int alignment = op->dtype.bytes();
+#if TVM_LLVM_VERSION >= 130
+    return builder_->CreateMaskedLoad(DTypeToLLVMType(op->dtype), ptr, llvm::Align(alignment),
+                                      mask, passthru);
+#elif TVM_LLVM_VERSION >= 110
+    return builder_->CreateMaskedLoad(ptr, llvm::Align(alignment), mask, passthru);
+#else
+    return builder_->CreateMaskedLoad(ptr, alignment, mask, passthru);
+#endif
+  } else if (op->op.same_as(builtin::masked_store())) {
+    llvm::Value* ptr = MakeValue(op->args[0]);
+    llvm::Value* value = MakeValue(op->args[1]);
+    llvm::Value* mask = MakeValue(op->args[2]);
+    int alignment = op->args[1].dtype().bytes();
+#if TVM_LLVM_VERSION >= 110
+    return builder_->CreateMaskedStore(value, ptr, llvm::Align(alignment), mask);
+#else
+    return builder_->CreateMaskedStore(value, ptr, alignment, mask);
+#endif
   } else if (op->op.same_as(builtin::reinterpret()) && is_zero(op->args[0])) {
     return llvm::Constant::getNullValue(t_void_p_);
   } else if (op->op.same_as(builtin::isnullptr())) {
@@ -1397,6 +1454,13 @@ llvm::Value* CodeGenLLVM::CreateIntrinsic(const CallNode* op) {
     llvm::Value* v = MakeValue(op->args[0]);
     int l = GetVectorNumElements(v);
     return CreateVecSlice(v, l / 2, l / 2);
+  } else if (op->op.same_as(builtin::vector_reduce_add()) ||
+             op->op.same_as(builtin::vector_reduce_mul()) ||
+             op->op.same_as(builtin::vector_reduce_min()) ||
+             op->op.same_as(builtin::vector_reduce_max())) {
+    llvm::Value* v = MakeValue(op->args[0]);
+    if (op->args[0].dtype().lanes() == 1) return v;
+    return CreateVecReduce(Downcast<Op>(op->op), op->dtype, v);
   } else if (op->op.same_as(builtin::vectorcombine())) {
     llvm::Value* v0 = MakeValue(op->args[0]);
     llvm::Value* v1 = MakeValue(op->args[1]);
@@ -1875,6 +1939,16 @@ void CodeGenLLVM::VisitStmt_(const AllocateConstNode* op) {
   std::string symbol_name = op->buffer_var->name_hint;
   llvm::GlobalVariable* param_symbol = new llvm::GlobalVariable(
       *module_, array->getType(), true, llvm::GlobalValue::InternalLinkage, array, symbol_name);
+  // Same placement as the constants of the C codegen
+  if (llvm_target_->GetOrCreateTargetMachine()->getTargetTriple().isOSBinFormatELF()) {
+    param_symbol->setSection(".rodata.tvm");
+  }
+  unsigned alignment = std::max(constants_byte_alignment_, op->dtype.bytes());
+#if TVM_LLVM_VERSION >= 100
+  param_symbol->setAlignment(llvm::Align(alignment));
+#else
+  param_symbol->setAlignment(alignment);
+#endif
 
   var_map_[op->buffer_var.operator->()] = param_symbol;
   this->VisitStmt(op->body);
@@ -131,6 +131,14 @@ class CodeGenLLVM : public ExprFunctor<llvm::Value*(const PrimExpr&)>,
    */
   void SetFastMathFlags(llvm::FastMathFlags fmf);
 
+  /*!
+   * \brief Set the alignment of the constants linked into the module, e.g. the parameters.
+   * \param constants_byte_alignment The minimum alignment, in bytes.
+   */
+  void SetConstantsByteAlignment(int constants_byte_alignment) {
+    constants_byte_alignment_ = constants_byte_alignment;
+  }
+
   /*!
    * \brief Compile and add function f to the current module.
    * \param f The function to be added.
@@ -447,6 +455,8 @@ class CodeGenLLVM : public ExprFunctor<llvm::Value*(const PrimExpr&)>,
   llvm::Value* CreateVecFlip(llvm::Value* vec);
   llvm::Value* CreateVecConcat(std::vector<llvm::Value*> vecs);
   llvm::Value* CreateVecPad(llvm::Value* vec, int target_lanes);
+  // Reduce the lanes of a vector by halves, with one of the vector_reduce builtins.
+  llvm::Value* CreateVecReduce(const Op& op, DataType t, llvm::Value* vec);
   // Create serial for
   void CreateSerialFor(llvm::Value* begin, llvm::Value* end, llvm::Value* stride,
                        const Var& loop_var, const Stmt& body);
@@ -510,6 +520,8 @@ class CodeGenLLVM : public ExprFunctor<llvm::Value*(const PrimExpr&)>,
   std::vector<std::unique_ptr<llvm::Module>> link_modules_;
   /*! \brief native vector bits of current targetx*/
   int native_vector_bits_{0};
+  /*! \brief the minimum alignment of the constants linked into the module, in bytes */
+  int constants_byte_alignment_{16};
   /*! \brief the storage scope of allocation */
   std::unordered_map<const VarNode*, StorageInfo> alloc_storage_info_;
   // The definition of local variable.
@@ -27,7 +27,7 @@
 #include <tvm/runtime/ndarray.h>
 
 namespace llvm {
-class ConstantArray;
+class Constant;
 class LLVMContext;
 }  // namespace llvm
 
@@ -35,15 +35,16 @@ namespace tvm {
 namespace codegen {
 
 /*!
- * \brief Convert an NDArray to an LLVM array of constants.
+ * \brief Convert an NDArray to an LLVM constant data array.
  *
- * The supplied NDArray is flattened, and each element is converted to the appropriate LLVM type.
+ * The supplied NDArray is flattened, and its bytes are copied as they are into the initializer,
+ * with no LLVM constant per element, so that large parameters are cheap to convert and to emit.
  *
  * \param ctx LLVM context used to create the various primitive datatypes.
  * \param arr NDArray to convert.
  * \return LLVM array containing the array data.
  */
-llvm::ConstantArray* NDArrayToLLVMArray(llvm::LLVMContext* ctx, tvm::runtime::NDArray arr);
+llvm::Constant* NDArrayToLLVMArray(llvm::LLVMContext* ctx, tvm::runtime::NDArray arr);
 
 }  // namespace codegen
 }  // namespace tvm
@@ -73,6 +73,7 @@ namespace {
 namespace defaults {
 static const char* cpu = "generic";
 static const llvm::CodeGenOpt::Level opt_level = llvm::CodeGenOpt::Aggressive;
+static const char* jit_engine = "mcjit";
 }  // namespace defaults
 }  // namespace
 
@@ -242,6 +243,10 @@ LLVMTargetInfo::LLVMTargetInfo(LLVMInstance& instance, const Target& target) {
     opt_level_ = defaults::opt_level;
   }
 
+  jit_engine_ = target->GetAttr<String>("jit").value_or(defaults::jit_engine);
+  CHECK(jit_engine_ == "mcjit" || jit_engine_ == "orcjit")
+      << "ValueError: The JIT engine must be \"mcjit\" or \"orcjit\", but got: " << jit_engine_;
+
   target_options_.UseInitArray = true;
 
   // Fast math options
@@ -380,6 +385,10 @@ std::string LLVMTargetInfo::str() const {
     }
   }
 
+  if (jit_engine_ != defaults::jit_engine) {
+    os << " -jit=" << jit_engine_;
+  }
+
   if (size_t num = llvm_options_.size(); num > 0) {
     os << " -cl-opt=";
     std::vector<std::string> opts;
@@ -28,9 +28,16 @@
 #include <dmlc/io.h>
 #include <llvm/ADT/SmallString.h>
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/MCJIT.h>  // Force linking of MCJIT
+#if TVM_LLVM_VERSION >= 130
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#endif
 #include <llvm/IR/DataLayout.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Intrinsics.h>
@@ -41,6 +48,7 @@
 #include <llvm/IR/Module.h>
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
@@ -49,6 +57,7 @@
 #include <tvm/ir/module.h>
 #include <tvm/relay/runtime.h>
 #include <tvm/runtime/container/array.h>
+#include <tvm/runtime/container/map.h>
 #include <tvm/runtime/container/string.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/metadata.h>
@@ -66,9 +75,14 @@
 #include <sstream>
 #include <string>
 #include <system_error>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
 #include "../../runtime/file_utils.h"
 #include "../../runtime/library_module.h"
 #include "../func_registry_generator.h"
@@ -110,9 +124,14 @@ class LLVMModuleNode final : public runtime::ModuleNode {
 
  private:
   void LazyInitJIT();
+  /*! \brief Get the address of a function, compiling the module first. */
+  TVMBackendPackedCFunc GetBackendFunc(const std::string& name);
+  void InitMCJIT(const LLVMTarget& llvm_target);
+  void InitORCJIT(const LLVMTarget& llvm_target);
   bool IsCompatibleWithHost(const llvm::TargetMachine* tm) const;
   void* GetGlobalAddr(const std::string& name, const LLVMTarget& llvm_target) const;
   void* GetFunctionAddr(const std::string& name, const LLVMTarget& llvm_target) const;
+  void* LookupORCJIT(const std::string& name) const;
 
   // The LLVM scope object.
   std::unique_ptr<LLVMInstance> llvm_instance_;
@@ -120,6 +139,10 @@ class LLVMModuleNode final : public runtime::ModuleNode {
   std::mutex mutex_;
   // execution engine
   llvm::ExecutionEngine* ee_{nullptr};
+#if TVM_LLVM_VERSION >= 130
+  // The lazy ORC JIT, used instead of `ee_` when the target sets `-jit=orcjit`
+  std::unique_ptr<llvm::orc::LLLazyJIT> orc_jit_;
+#endif
   // The raw pointer to the module.
   llvm::Module* module_{nullptr};
   // The unique_ptr owning the module. This becomes empty once JIT has been initialized
@@ -134,6 +157,12 @@ LLVMModuleNode::~LLVMModuleNode() {
     ee_->runStaticConstructorsDestructors(true);
     delete ee_;
   }
+#if TVM_LLVM_VERSION >= 130
+  if (orc_jit_ != nullptr) {
+    llvm::consumeError(orc_jit_->deinitialize(orc_jit_->getMainJITDylib()));
+    orc_jit_.reset();
+  }
+#endif
   module_owning_ptr_.reset();
 }
 
@@ -152,22 +181,12 @@ PackedFunc LLVMModuleNode::GetFunction(const std::string& name,
   } else if (name == "_get_target_string") {
     std::string target_string = LLVMTarget::GetTargetMetadata(*module_);
     return PackedFunc([target_string](TVMArgs args, TVMRetValue* rv) { *rv = target_string; });
+  } else if (name == runtime::symbol::tvm_get_backend_func) {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      *rv = reinterpret_cast<void*>(GetBackendFunc(args[0]));
+    });
   }
-  if (ee_ == nullptr) LazyInitJIT();
-
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  TVMBackendPackedCFunc faddr;
-  With<LLVMTarget> llvm_target(*llvm_instance_, LLVMTarget::GetTargetMetadata(*module_));
-  if (name == runtime::symbol::tvm_module_main) {
-    const char* entry_name = reinterpret_cast<const char*>(
-        GetGlobalAddr(runtime::symbol::tvm_module_main, *llvm_target));
-    ICHECK(entry_name != nullptr) << "Symbol " << runtime::symbol::tvm_module_main
-                                  << " is not presented";
-    faddr = reinterpret_cast<TVMBackendPackedCFunc>(GetFunctionAddr(entry_name, *llvm_target));
-  } else {
-    faddr = reinterpret_cast<TVMBackendPackedCFunc>(GetFunctionAddr(name, *llvm_target));
-  }
+  TVMBackendPackedCFunc faddr = GetBackendFunc(name);
   if (faddr == nullptr) return PackedFunc();
   return WrapPackedFunc(faddr, sptr_to_self);
 }
@@ -314,6 +333,8 @@ void LLVMModuleNode::Init(const IRModule& mod, const Target& target) {
   // makes sense when we start to use multiple modules.
   cg->Init("TVMMod", llvm_target.get(), system_lib, system_lib, target_c_runtime);
   cg->SetFastMathFlags(llvm_target->GetFastMathFlags());
+  cg->SetConstantsByteAlignment(
+      target->GetAttr<Integer>("constants-byte-alignment").value_or(16).IntValue());
 
   cg->AddFunctionsOrdered(funcs.begin(), funcs.end());
   if (entry_func.length() != 0) {
@@ -353,13 +374,41 @@ void LLVMModuleNode::LazyInitJIT() {
   if (ee_) {
     return;
   }
+#if TVM_LLVM_VERSION >= 130
+  if (orc_jit_) {
+    return;
+  }
+#endif
   With<LLVMTarget> llvm_target(*llvm_instance_, LLVMTarget::GetTargetMetadata(*module_));
+  if (llvm_target->GetJITEngine() == "orcjit") {
+    InitORCJIT(*llvm_target);
+  } else {
+    InitMCJIT(*llvm_target);
+  }
+
+  if (void** ctx_addr =
+          reinterpret_cast<void**>(GetGlobalAddr(runtime::symbol::tvm_module_ctx, *llvm_target))) {
+    *ctx_addr = this;
+  }
+  runtime::InitContextFunctions(
+      [this, &llvm_target](const char* name) { return GetGlobalAddr(name, *llvm_target); });
+  if (ee_) {
+    // There is a problem when a JITed function contains a call to a runtime function.
+    // The runtime function (e.g. __truncsfhf2) may not be resolved, and calling it will
+    // lead to a runtime crash.
+    // Do name lookup on a symbol that doesn't exist. This will force MCJIT to finalize
+    // all loaded objects, which will resolve symbols in JITed code.
+    ee_->getFunctionAddress("__some_name_that_hopefully_doesnt_exist__b49f8aaade5877eaba7583b91");
+  }
+}
+
+void LLVMModuleNode::InitMCJIT(const LLVMTarget& llvm_target) {
   llvm::EngineBuilder builder(std::move(module_owning_ptr_));
   builder.setEngineKind(llvm::EngineKind::JIT);
   builder.setOptLevel(llvm::CodeGenOpt::Aggressive);
-  builder.setMCPU(llvm_target->GetCPU());
-  builder.setMAttrs(llvm_target->GetTargetFeatures());
-  builder.setTargetOptions(llvm_target->GetTargetOptions());
+  builder.setMCPU(llvm_target.GetCPU());
+  builder.setMAttrs(llvm_target.GetTargetFeatures());
+  builder.setTargetOptions(llvm_target.GetTargetOptions());
   auto tm = std::unique_ptr<llvm::TargetMachine>(builder.selectTarget());
   if (!IsCompatibleWithHost(tm.get())) {
     LOG(FATAL) << "Cannot run module, architecture mismatch";
@@ -372,19 +421,62 @@ void LLVMModuleNode::LazyInitJIT() {
   ee_ = builder.create(tm.release());
   ICHECK(ee_ != nullptr) << "Failed to initialize jit engine for " << module_->getTargetTriple();
   ee_->runStaticConstructorsDestructors(false);
+}
 
-  if (void** ctx_addr =
-          reinterpret_cast<void**>(GetGlobalAddr(runtime::symbol::tvm_module_ctx, *llvm_target))) {
-    *ctx_addr = this;
+void LLVMModuleNode::InitORCJIT(const LLVMTarget& llvm_target) {
+#if TVM_LLVM_VERSION >= 130
+  auto exit_on_error = [](llvm::Error err) {
+    if (err) {
+      LOG(FATAL) << "ORC JIT error: " << llvm::toString(std::move(err));
+    }
+  };
+  llvm::orc::JITTargetMachineBuilder tm_builder{llvm::Triple(module_->getTargetTriple())};
+  tm_builder.setCPU(llvm_target.GetCPU());
+  tm_builder.addFeatures(std::vector<std::string>(llvm_target.GetTargetFeatures().begin(),
+                                                  llvm_target.GetTargetFeatures().end()));
+  tm_builder.setOptions(llvm_target.GetTargetOptions());
+  tm_builder.setCodeGenOptLevel(llvm::CodeGenOpt::Aggressive);
+  llvm::Expected<std::unique_ptr<llvm::TargetMachine>> tm = tm_builder.createTargetMachine();
+  exit_on_error(tm.takeError());
+  if (!IsCompatibleWithHost(tm->get())) {
+    LOG(FATAL) << "Cannot run module, architecture mismatch";
   }
-  runtime::InitContextFunctions(
-      [this, &llvm_target](const char* name) { return GetGlobalAddr(name, *llvm_target); });
-  // There is a problem when a JITed function contains a call to a runtime function.
-  // The runtime function (e.g. __truncsfhf2) may not be resolved, and calling it will
-  // lead to a runtime crash.
-  // Do name lookup on a symbol that doesn't exist. This will force MCJIT to finalize
-  // all loaded objects, which will resolve symbols in JITed code.
-  ee_->getFunctionAddress("__some_name_that_hopefully_doesnt_exist__b49f8aaade5877eaba7583b91");
+  llvm::DataLayout layout((*tm)->createDataLayout());
+  ICHECK(layout == module_->getDataLayout())
+      << "Data layout mismatch between module("
+      << module_->getDataLayout().getStringRepresentation() << ")"
+      << " and ExecutionEngine (" << layout.getStringRepresentation() << ")";
+  // The functions are compiled on the first lookup of each of them, on a pool of threads so that
+  // concurrent first calls compile concurrently
+  unsigned num_threads = std::max(1u, std::thread::hardware_concurrency());
+  llvm::orc::LLLazyJITBuilder jit_builder;
+  jit_builder.setJITTargetMachineBuilder(std::move(tm_builder));
+  jit_builder.setNumCompileThreads(num_threads);
+  llvm::Expected<std::unique_ptr<llvm::orc::LLLazyJIT>> jit = jit_builder.create();
+  exit_on_error(jit.takeError());
+  orc_jit_ = std::move(*jit);
+  // Resolve the symbols of the runtime, and of the libraries loaded in the process
+  llvm::orc::JITDylib& dylib = orc_jit_->getMainJITDylib();
+  auto generator = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+      layout.getGlobalPrefix());
+  exit_on_error(generator.takeError());
+  dylib.addGenerator(std::move(*generator));
+  // The JIT takes the module in its own context, whose access it synchronizes across the compile
+  // threads. This node keeps its module to look up the symbols and print the source.
+  llvm::SmallVector<char, 0> bitcode;
+  llvm::raw_svector_ostream bitcode_os(bitcode);
+  llvm::WriteBitcodeToFile(*module_, bitcode_os);
+  auto context = std::make_unique<llvm::LLVMContext>();
+  llvm::Expected<std::unique_ptr<llvm::Module>> module = llvm::parseBitcodeFile(
+      llvm::MemoryBufferRef(llvm::StringRef(bitcode.data(), bitcode.size()), "TVMMod"), *context);
+  exit_on_error(module.takeError());
+  exit_on_error(orc_jit_->addLazyIRModule(
+      llvm::orc::ThreadSafeModule(std::move(*module), std::move(context))));
+  exit_on_error(orc_jit_->initialize(dylib));
+#else
+  LOG(FATAL) << "ValueError: The ORC JIT requires LLVM 13 or later, but TVM is built with LLVM "
+             << TVM_LLVM_VERSION;
+#endif
 }
 
 bool LLVMModuleNode::IsCompatibleWithHost(const llvm::TargetMachine* tm) const {
@@ -398,11 +490,27 @@ bool LLVMModuleNode::IsCompatibleWithHost(const llvm::TargetMachine* tm) const {
   return true;
 }
 
+TVMBackendPackedCFunc LLVMModuleNode::GetBackendFunc(const std::string& name) {
+  LazyInitJIT();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  With<LLVMTarget> llvm_target(*llvm_instance_, LLVMTarget::GetTargetMetadata(*module_));
+  if (name == runtime::symbol::tvm_module_main) {
+    const char* entry_name = reinterpret_cast<const char*>(
+        GetGlobalAddr(runtime::symbol::tvm_module_main, *llvm_target));
+    ICHECK(entry_name != nullptr) << "Symbol " << runtime::symbol::tvm_module_main
+                                  << " is not presented";
+    return reinterpret_cast<TVMBackendPackedCFunc>(GetFunctionAddr(entry_name, *llvm_target));
+  }
+  return reinterpret_cast<TVMBackendPackedCFunc>(GetFunctionAddr(name, *llvm_target));
+}
+
 // Get global address from execution engine.
 void* LLVMModuleNode::GetGlobalAddr(const std::string& name, const LLVMTarget& llvm_target) const {
   // first verifies if GV exists.
   if (module_->getGlobalVariable(name) != nullptr) {
-    return reinterpret_cast<void*>(ee_->getGlobalValueAddress(name));
+    return ee_ ? reinterpret_cast<void*>(ee_->getGlobalValueAddress(name)) : LookupORCJIT(name);
   } else {
     return nullptr;
   }
@@ -412,12 +520,29 @@ void* LLVMModuleNode::GetFunctionAddr(const std::string& name,
                                       const LLVMTarget& llvm_target) const {
   // first verifies if GV exists.
   if (module_->getFunction(name) != nullptr) {
-    return reinterpret_cast<void*>(ee_->getFunctionAddress(name));
+    return ee_ ? reinterpret_cast<void*>(ee_->getFunctionAddress(name)) : LookupORCJIT(name);
   } else {
     return nullptr;
   }
 }
 
+void* LLVMModuleNode::LookupORCJIT(const std::string& name) const {
+#if TVM_LLVM_VERSION >= 130
+  ICHECK(orc_jit_ != nullptr);
+  auto symbol = orc_jit_->lookup(name);
+  if (!symbol) {
+    LOG(FATAL) << "ORC JIT error: " << llvm::toString(symbol.takeError());
+  }
+#if TVM_LLVM_VERSION >= 150
+  return symbol->toPtr<void*>();
+#else
+  return reinterpret_cast<void*>(symbol->getAddress());
+#endif
+#else
+  return nullptr;
+#endif
+}
+
 TVM_REGISTER_GLOBAL("target.build.llvm")
     .set_body_typed([](IRModule mod, Target target) -> runtime::Module {
       auto n = make_object<LLVMModuleNode>();
@@ -463,6 +588,35 @@ TVM_REGISTER_GLOBAL("target.llvm_version_major").set_body_typed([]() -> int {
   return TVM_LLVM_VERSION / 10;
 });
 
+TVM_REGISTER_GLOBAL("target.llvm_get_host_cpu_info").set_body_typed([]() {
+  // The CPU and the features of the host, as -mcpu=native of clang, and the attributes of the
+  // llvm target which the schedules read, when the host reports them.
+  Map<String, ObjectRef> info;
+  info.Set("mcpu", String(llvm::sys::getHostCPUName().str()));
+  llvm::StringMap<bool> features;
+  std::vector<String> mattr;
+  if (llvm::sys::getHostCPUFeatures(features)) {
+    for (const auto& feature : features) {
+      if (feature.second) mattr.push_back("+" + feature.first().str());
+    }
+  }
+  std::sort(mattr.begin(), mattr.end());
+  info.Set("mattr", Array<String>(mattr.begin(), mattr.end()));
+#if TVM_LLVM_VERSION >= 40
+  int num_cores = llvm::sys::getHostNumPhysicalCores();
+#else
+  int num_cores = static_cast<int>(std::thread::hardware_concurrency());
+#endif
+  if (num_cores > 0) info.Set("num-cores", Integer(num_cores));
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+  int64_t l1_cache_bytes = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+  int64_t l2_cache_bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+  if (l1_cache_bytes > 0) info.Set("l1_cache_bytes", Integer(l1_cache_bytes));
+  if (l2_cache_bytes > 0) info.Set("l2_cache_bytes", Integer(l2_cache_bytes));
+#endif
+  return info;
+});
+
 TVM_REGISTER_GLOBAL("runtime.module.loadfile_ll")
     .set_body_typed([](std::string filename, std::string fmt) -> runtime::Module {
       auto n = make_object<LLVMModuleNode>();
@@ -18,6 +18,8 @@
  */
 #include "cpu.h"
 
+#include <tvm/runtime/registry.h>
+
 #include <string>
 
 #include "aprofile.h"
@@ -28,7 +30,41 @@ namespace target {
 namespace parsers {
 namespace cpu {
 
+/*!
+ * \brief Replace -mcpu=native of an llvm target by the CPU and the features of the host, and fill
+ * in the attributes of the host which are not given.
+ */
+TargetJSON ResolveNativeCPU(TargetJSON target) {
+  Optional<String> kind = Downcast<Optional<String>>(target.Get("kind"));
+  Optional<String> mcpu = Downcast<Optional<String>>(target.Get("mcpu"));
+  if (!kind || kind.value() != "llvm" || !mcpu || mcpu.value() != "native") {
+    return target;
+  }
+  const runtime::PackedFunc* f_host_info = runtime::Registry::Get("target.llvm_get_host_cpu_info");
+  CHECK(f_host_info != nullptr) << "ValueError: -mcpu=native requires TVM to be built with LLVM";
+  Map<String, ObjectRef> host_info = (*f_host_info)();
+  target.Set("mcpu", host_info.at("mcpu"));
+  // The features given explicitly come last, to override the ones of the host.
+  Array<String> mattr = Downcast<Array<String>>(host_info.at("mattr"));
+  if (Optional<Array<String>> given = Downcast<Optional<Array<String>>>(target.Get("mattr"))) {
+    for (const String& feature : given.value()) {
+      mattr.push_back(feature);
+    }
+  }
+  if (!mattr.empty()) {
+    target.Set("mattr", mattr);
+  }
+  for (const char* key : {"num-cores", "l1_cache_bytes", "l2_cache_bytes"}) {
+    if (!target.count(key) && host_info.count(key)) {
+      target.Set(key, host_info.at(key));
+    }
+  }
+  return target;
+}
+
 TargetJSON ParseTarget(TargetJSON target) {
+  target = ResolveNativeCPU(target);
+
   if (mprofile::IsArch(target)) {
     return mprofile::ParseTarget(target);
   }
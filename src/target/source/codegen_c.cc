@@ -595,6 +595,38 @@ void CodeGenC::VisitExpr_(const CallNode* op, std::ostream& os) {  // NOLINT(*)
       this->PrintType(op->dtype, os);
       os << " *)(&(" << rhs << ")))";
       EndScope(ssa_scope);
+    } else if (op->op.same_as(builtin::vector_reduce_add()) ||
+               op->op.same_as(builtin::vector_reduce_mul()) ||
+               op->op.same_as(builtin::vector_reduce_min()) ||
+               op->op.same_as(builtin::vector_reduce_max())) {
+      DataType t = op->args[0].dtype();
+      int ssa_scope = BeginScope();
+      std::string vec = SSAGetID(PrintExpr(op->args[0]), t);
+      std::vector<std::string> lanes;
+      for (int i = 0; i < t.lanes(); ++i) {
+        std::ostringstream elem;
+        PrintVecElemLoad(vec, t, i, elem);
+        lanes.push_back(elem.str());
+      }
+      // Combine the lanes pairwise, as a tree.
+      while (lanes.size() > 1) {
+        std::vector<std::string> combined;
+        for (size_t i = 0; i + 1 < lanes.size(); i += 2) {
+          if (op->op.same_as(builtin::vector_reduce_add())) {
+            combined.push_back("(" + lanes[i] + " + " + lanes[i + 1] + ")");
+          } else if (op->op.same_as(builtin::vector_reduce_mul())) {
+            combined.push_back("(" + lanes[i] + " * " + lanes[i + 1] + ")");
+          } else if (op->op.same_as(builtin::vector_reduce_min())) {
+            combined.push_back("min(" + lanes[i] + ", " + lanes[i + 1] + ")");
+          } else {
+            combined.push_back("max(" + lanes[i] + ", " + lanes[i + 1] + ")");
+          }
+        }
+        if (lanes.size() % 2 == 1) combined.push_back(lanes.back());
+        lanes = std::move(combined);
+      }
+      os << lanes[0];
+      EndScope(ssa_scope);
     } else if (op->op.same_as(builtin::isnan())) {
       os << "(";
       this->PrintExpr(op->args[0], os);
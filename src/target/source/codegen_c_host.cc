@@ -26,6 +26,7 @@
 #include <tvm/relay/runtime.h>
 #include <tvm/runtime/crt/error_codes.h>
 #include <tvm/runtime/module.h>
+#include <tvm/ir/transform.h>
 #include <tvm/target/codegen.h>
 
 #include <algorithm>
@@ -42,6 +43,8 @@
 namespace tvm {
 namespace codegen {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.c_host.split_translation_units", Bool);
+
 CodeGenCHost::CodeGenCHost() { module_name_ = name_supply_->FreshName("__tvm_module_ctx"); }
 
 void CodeGenCHost::Init(bool output_ssa, bool emit_asserts, bool emit_fwd_func_decl,
@@ -436,9 +439,13 @@ runtime::Module BuildCHost(IRModule mod, Target target) {
     }
   }
 
+  auto init_codegen = [&](CodeGenCHost* cg) {
+    cg->Init(output_ssa, emit_asserts, emit_fwd_func_decl, target->str(), devices);
+    cg->SetConstantsByteAlignment(
+        target->GetAttr<Integer>("constants-byte-alignment").value_or(16));
+  };
   CodeGenCHost cg;
-  cg.Init(output_ssa, emit_asserts, emit_fwd_func_decl, target->str(), devices);
-  cg.SetConstantsByteAlignment(target->GetAttr<Integer>("constants-byte-alignment").value_or(16));
+  init_codegen(&cg);
   PrimFunc aot_executor_fn;
 
   std::vector<std::pair<tvm::GlobalVar, tvm::BaseFunc>> funcs;
@@ -464,6 +471,52 @@ runtime::Module BuildCHost(IRModule mod, Target target) {
               return name_hint_a < name_hint_b;
             });
 
+  // NOTE: it's possible that kRuntime attr is not attached when the mod was built with tvm.build().
+  // See issue #10373.
+  auto opt_runtime = mod->GetAttr<relay::Runtime>(tvm::attr::kRuntime);
+  relay::Runtime runtime;
+  if (opt_runtime.get() != nullptr) {
+    runtime = opt_runtime.value();
+  } else {
+    runtime = relay::Runtime::Create("cpp", {});
+  }
+
+  bool system_lib = target->GetAttr<Bool>("system-lib").value_or(Bool(false));
+  if (system_lib) {
+    ICHECK_EQ(target->GetAttr<String>("runtime").value_or(""), "c")
+        << "c target only supports generating C runtime SystemLibs";
+  }
+
+  // Each function is emitted to its own translation unit, so that export_library compiles them
+  // in parallel and reuses the objects of the unchanged ones. The units are imported by the
+  // first one and linked into the same library. The C runtime registers the functions from the
+  // names of the host module only, so it keeps a single unit.
+  bool split = tvm::transform::PassContext::Current()
+                   ->GetConfig<Bool>("tir.c_host.split_translation_units", Bool(false))
+                   .value() &&
+               !system_lib && runtime->name == relay::kTvmRuntimeCpp && funcs.size() > 1;
+  if (split) {
+    std::vector<runtime::Module> units;
+    for (auto& kv : funcs) {
+      ICHECK(kv.second->IsInstance<PrimFuncNode>()) << "CodegenCHost: Can only take PrimFunc";
+      CodeGenCHost unit_cg;
+      init_codegen(&unit_cg);
+      unit_cg.AddFunction(Downcast<PrimFunc>(kv.second));
+      units.push_back(CSourceModuleCreate(unit_cg.Finish(), "c", unit_cg.GetFunctionNames()));
+    }
+    if (aot_executor_fn.defined()) {
+      CodeGenCHost unit_cg;
+      init_codegen(&unit_cg);
+      unit_cg.AddFunction(aot_executor_fn, true);
+      unit_cg.InitGlobalContext();
+      units.push_back(CSourceModuleCreate(unit_cg.Finish(), "c", unit_cg.GetFunctionNames()));
+    }
+    for (size_t i = 1; i < units.size(); ++i) {
+      units[0].Import(units[i]);
+    }
+    return units[0];
+  }
+
   // Add all functions except __tvm_main__
   for (auto& kv : funcs) {
     ICHECK(kv.second->IsInstance<PrimFuncNode>()) << "CodegenCHost: Can only take PrimFunc";
@@ -477,24 +530,10 @@ runtime::Module BuildCHost(IRModule mod, Target target) {
     cg.AddFunction(aot_executor_fn, emit_fwd_func_decl);
   }
 
-  // NOTE: it's possible that kRuntime attr is not attached when the mod was built with tvm.build().
-  // See issue #10373.
-  auto opt_runtime = mod->GetAttr<relay::Runtime>(tvm::attr::kRuntime);
-  relay::Runtime runtime;
-  if (opt_runtime.get() != nullptr) {
-    runtime = opt_runtime.value();
-  } else {
-    runtime = relay::Runtime::Create("cpp", {});
-  }
   if (aot_executor_fn.defined() && runtime->name == relay::kTvmRuntimeCpp) {
     cg.InitGlobalContext();
   }
 
-  if (target->GetAttr<Bool>("system-lib").value_or(Bool(false))) {
-    ICHECK_EQ(target->GetAttr<String>("runtime").value_or(""), "c")
-        << "c target only supports generating C runtime SystemLibs";
-  }
-
   std::string code = cg.Finish();
   return CSourceModuleCreate(code, "c", cg.GetFunctionNames());
 }
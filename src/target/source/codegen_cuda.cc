@@ -89,6 +89,11 @@ void CodeGenCUDA::PrintExtraAttrs(const PrimFunc& f) {
   }
 }
 
+void CodeGenCUDA::InitFuncState(const PrimFunc& f) {
+  CodeGenC::InitFuncState(f);
+  barrier_count_ = -1;
+}
+
 std::string CodeGenCUDA::Finish() {
   if (enable_fp16_) {
     decl_stream << "#if defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 530)\n";
@@ -928,6 +933,37 @@ void CodeGenCUDA::VisitExpr_(const CallNode* op, std::ostream& os) {
       this->stream << PrintPredicatedCpAsyncAssembly(dst, dst_offset, src, src_offset, size,
                                                      this->PrintExpr(op->args[5]));
     }
+  } else if (op->op.same_as(builtin::ptx_cp_async_bulk())) {
+    std::string dst = this->PrintExpr(op->args[0]);
+    std::string dst_offset = this->PrintExpr(op->args[1]);
+    std::string src = this->PrintExpr(op->args[2]);
+    std::string src_offset = this->PrintExpr(op->args[3]);
+    std::string size = this->PrintExpr(op->args[4]);
+    this->stream << PrintCpAsyncBulkAsm(dst, dst_offset, src, src_offset, size,
+                                        GetBarrier(op->args[5]));
+  } else if (op->op.same_as(builtin::ptx_cp_async_barrier())) {
+    this->stream << PrintCpAsyncBarrierAsm(GetBarrier(op->args[0]));
+  } else if (op->op.same_as(builtin::create_barriers())) {
+    CHECK_EQ(barrier_count_, -1) << "ValueError: The barriers of a kernel are created only once";
+    const auto* count = op->args[0].as<IntImmNode>();
+    CHECK(count && count->value > 0)
+        << "ValueError: The number of barriers must be a positive constant, but get "
+        << op->args[0];
+    barrier_count_ = count->value;
+    this->PrintIndent();
+    this->stream << "__shared__ __align__(8) uint64_t " << barrier_name_ << "[" << barrier_count_
+                 << "];\n";
+  } else if (op->op.same_as(builtin::ptx_init_barrier_thread_count())) {
+    std::string thread_count = this->PrintExpr(op->args[1]);
+    this->stream << PrintInitBarrierThreadCountAsm(GetBarrier(op->args[0]), thread_count);
+  } else if (op->op.same_as(builtin::ptx_arrive_barrier())) {
+    this->stream << PrintArriveBarrierAsm(GetBarrier(op->args[0]));
+  } else if (op->op.same_as(builtin::ptx_arrive_barrier_expect_tx())) {
+    std::string byte_count = this->PrintExpr(op->args[1]);
+    this->stream << PrintArriveBarrierExpectTxAsm(GetBarrier(op->args[0]), byte_count);
+  } else if (op->op.same_as(builtin::ptx_wait_barrier())) {
+    std::string phase = this->PrintExpr(op->args[1]);
+    this->stream << PrintWaitBarrierAsm(GetBarrier(op->args[0]), phase);
   } else if (op->op.same_as(builtin::ptx_commit_group())) {
     this->stream << "__asm__ __volatile__(\"cp.async.commit_group;\");\n\n";
   } else if (op->op.same_as(builtin::ptx_wait_group())) {
@@ -1328,6 +1364,17 @@ int stoi(const std::string& str) {
   }
 }
 
+std::string CodeGenCUDA::GetBarrier(const PrimExpr& barrier_id) {
+  CHECK_NE(barrier_count_, -1)
+      << "ValueError: The barriers of a kernel must be created by create_barriers before use";
+  if (const auto* id = barrier_id.as<IntImmNode>()) {
+    CHECK(id->value >= 0 && id->value < barrier_count_)
+        << "ValueError: The barrier " << id->value << " is out of the " << barrier_count_
+        << " barriers created";
+  }
+  return barrier_name_ + "[" + this->PrintExpr(barrier_id) + "]";
+}
+
 int32_t CodeGenCUDA::GetWmmaFragmentSize(const std::string& scope, const VarNode* variable,
                                          int32_t size) {
   ICHECK(fragment_shapes.count(variable))
@@ -47,6 +47,7 @@ class CodeGenCUDA final : public CodeGenC {
   // override behavior
   void PrintFuncPrefix(std::ostream& os) final;
   void PrintExtraAttrs(const PrimFunc& f) final;
+  void InitFuncState(const PrimFunc& f) final;
   void VisitStmt_(const ForNode* op) final;
   void PrintStorageSync(const CallNode* op) final;
   void PrintStorageScope(const std::string& scope, std::ostream& os) final;  // NOLINT(*)
@@ -101,6 +102,10 @@ class CodeGenCUDA final : public CodeGenC {
   bool need_math_constants_h_{false};
   // whether need mma.h
   bool need_mma_h_{false};
+  // The name of the mbarrier array in shared memory
+  const std::string barrier_name_ = "barrier";
+  // The number of mbarriers created in the current kernel, -1 if none is created
+  int64_t barrier_count_{-1};
   // Op attribute map
   OpAttrMap<bool> op_need_warp_shuffle_ = Op::GetAttrMap<bool>("cuda.need_warp_shuffle");
 
@@ -110,6 +115,8 @@ class CodeGenCUDA final : public CodeGenC {
   void PrintWmmaScope(const std::string& scope, DataType t, const VarNode* variable,
                       std::ostream& os);
   int32_t GetWmmaFragmentSize(const std::string& scope, const VarNode* variable, int32_t size);
+  // Get the mbarrier of the given index, which must have been created in the kernel.
+  std::string GetBarrier(const PrimExpr& barrier_id);
 };
 
 }  // namespace codegen
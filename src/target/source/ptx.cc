@@ -724,5 +724,103 @@ std::string PrintPredicatedCpAsyncAssembly(const std::string& shared_ptr,
   return predicated_asm_code;
 }
 
+std::string PrintCpAsyncBulkAsm(const std::string& shared_ptr,
+                                const std::string& shared_elem_offset,
+                                const std::string& global_ptr,
+                                const std::string& global_elem_offset, const std::string& bytes,
+                                const std::string& barrier) {
+  std::string asm_code = R"(
+  {
+    unsigned int smem_addr, barrier_addr;
+    __asm__ __volatile__(
+      "{ .reg .u64 addr; cvta.to.shared.u64 addr, %1; cvt.u32.u64 %0, addr; }\n"
+      : "=r"(smem_addr)
+      : "l"((void *)({smem_addr}))
+    );
+    __asm__ __volatile__(
+      "{ .reg .u64 addr; cvta.to.shared.u64 addr, %1; cvt.u32.u64 %0, addr; }\n"
+      : "=r"(barrier_addr)
+      : "l"((void *)(&{barrier}))
+    );
+    __asm__ __volatile__(
+      "cp.async.bulk.shared::cluster.global.mbarrier::complete_tx::bytes [%0], [%1], %2, [%3];"
+      :: "r"(smem_addr), "l"((void*)({global_ptr})), "r"({bytes}), "r"(barrier_addr)
+      : "memory"
+    );
+  }
+)";
+  Replacer replacer;
+  replacer.register_rule("{smem_addr}", shared_ptr + " + " + shared_elem_offset);
+  replacer.register_rule("{global_ptr}", global_ptr + " + " + global_elem_offset);
+  replacer.register_rule("{bytes}", bytes);
+  replacer.register_rule("{barrier}", barrier);
+  asm_code = replacer.rewrite(asm_code);
+  return asm_code;
+}
+
+/*!
+ * \brief Print an mbarrier instruction whose first operand is the shared memory address of the
+ *        barrier, and whose other operands are 32-bit registers.
+ * \param instruction The instruction, with the operands as `%0`, `%1`, ...
+ * \param barrier The barrier.
+ * \param operands The other operands.
+ */
+static std::string PrintBarrierAsm(const std::string& instruction, const std::string& barrier,
+                                   const std::vector<std::string>& operands = {}) {
+  std::string asm_code = R"(
+  {
+    unsigned int barrier_addr;
+    __asm__ __volatile__(
+      "{ .reg .u64 addr; cvta.to.shared.u64 addr, %1; cvt.u32.u64 %0, addr; }\n"
+      : "=r"(barrier_addr)
+      : "l"((void *)(&{barrier}))
+    );
+    __asm__ __volatile__(
+      "{instruction}"
+      :: "r"(barrier_addr){operands}
+      : "memory"
+    );
+  }
+)";
+  std::string operands_str;
+  for (const std::string& operand : operands) {
+    operands_str += ", \"r\"((unsigned int)(" + operand + "))";
+  }
+  Replacer replacer;
+  replacer.register_rule("{instruction}", instruction);
+  replacer.register_rule("{barrier}", barrier);
+  replacer.register_rule("{operands}", operands_str);
+  asm_code = replacer.rewrite(asm_code);
+  return asm_code;
+}
+
+std::string PrintCpAsyncBarrierAsm(const std::string& barrier) {
+  return PrintBarrierAsm("cp.async.mbarrier.arrive.shared.b64 [%0];", barrier);
+}
+
+std::string PrintInitBarrierThreadCountAsm(const std::string& barrier,
+                                           const std::string& thread_count) {
+  return PrintBarrierAsm("mbarrier.init.shared.b64 [%0], %1;", barrier, {thread_count});
+}
+
+std::string PrintArriveBarrierAsm(const std::string& barrier) {
+  return PrintBarrierAsm("mbarrier.arrive.shared.b64 _, [%0];", barrier);
+}
+
+std::string PrintArriveBarrierExpectTxAsm(const std::string& barrier,
+                                          const std::string& byte_count) {
+  return PrintBarrierAsm("mbarrier.arrive.expect_tx.shared.b64 _, [%0], %1;", barrier,
+                         {byte_count});
+}
+
+std::string PrintWaitBarrierAsm(const std::string& barrier, const std::string& phase) {
+  // The labels are local to the braces, so the loop can be emitted several times.
+  return PrintBarrierAsm(
+      "{ .reg .pred P1; LAB_WAIT: "
+      "mbarrier.try_wait.parity.shared.b64 P1, [%0], %1; "
+      "@P1 bra.uni DONE; bra.uni LAB_WAIT; DONE: }",
+      barrier, {phase});
+}
+
 }  // namespace codegen
 }  // namespace tvm
@@ -108,6 +108,56 @@ std::string PrintPredicatedCpAsyncAssembly(const std::string& shared_ptr,
                                            const std::string& bytes,
                                            const std::string& predicate_value);
 
+/*!
+ * \brief Print ptx bulk async copy assembly string given parameters.
+ * \param shared_ptr: The pointer to the destination shared memory.
+ * \param shared_elem_offset: The offset into the shared memory.
+ * \param global_ptr: The pointer to the global memory.
+ * \param global_elem_offset: The offset into the global memory.
+ * \param bytes: The number of bytes to copy, a multiple of 16.
+ * \param barrier: The mbarrier whose transaction count tracks the completion of the copy.
+ */
+std::string PrintCpAsyncBulkAsm(const std::string& shared_ptr,
+                                const std::string& shared_elem_offset,
+                                const std::string& global_ptr,
+                                const std::string& global_elem_offset, const std::string& bytes,
+                                const std::string& barrier);
+
+/*!
+ * \brief Print ptx async copy arrival on an mbarrier assembly string.
+ * \param barrier: The mbarrier.
+ */
+std::string PrintCpAsyncBarrierAsm(const std::string& barrier);
+
+/*!
+ * \brief Print ptx mbarrier initialization assembly string.
+ * \param barrier: The mbarrier.
+ * \param thread_count: The number of threads arriving on the barrier in each phase.
+ */
+std::string PrintInitBarrierThreadCountAsm(const std::string& barrier,
+                                           const std::string& thread_count);
+
+/*!
+ * \brief Print ptx mbarrier arrival assembly string.
+ * \param barrier: The mbarrier.
+ */
+std::string PrintArriveBarrierAsm(const std::string& barrier);
+
+/*!
+ * \brief Print ptx mbarrier arrival with expected transaction bytes assembly string.
+ * \param barrier: The mbarrier.
+ * \param byte_count: The number of bytes expected to be transferred in the current phase.
+ */
+std::string PrintArriveBarrierExpectTxAsm(const std::string& barrier,
+                                          const std::string& byte_count);
+
+/*!
+ * \brief Print ptx mbarrier wait assembly string.
+ * \param barrier: The mbarrier.
+ * \param phase: The parity of the phase to wait for.
+ */
+std::string PrintWaitBarrierAsm(const std::string& barrier, const std::string& phase);
+
 }  // namespace codegen
 }  // namespace tvm
 
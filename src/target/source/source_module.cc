@@ -133,7 +133,14 @@ class CSourceModuleNode : public runtime::ModuleNode {
   int GetPropertyMask() const override { return runtime::ModulePropertyMask::kDSOExportable; }
 
   bool ImplementsFunction(const String& name, bool query_imports) final {
-    return std::find(func_names_.begin(), func_names_.end(), name) != func_names_.end();
+    if (std::find(func_names_.begin(), func_names_.end(), name) != func_names_.end()) {
+      return true;
+    }
+    // the host of the c target may be split into translation units imported by the first one.
+    return query_imports &&
+           std::any_of(imports_.begin(), imports_.end(), [&](runtime::Module& import) {
+             return import->ImplementsFunction(name, true);
+           });
   }
 
  protected:
@@ -27,6 +27,7 @@
 #include <tvm/tir/expr.h>
 #include <tvm/tir/op.h>
 
+#include <sstream>
 #include <string>
 
 #include "../../runtime/pack_args.h"
@@ -126,6 +127,8 @@ void CodeGenSPIRV::InitFuncState() {
   std::fill(workgroup_size_, workgroup_size_ + 3, 1);
   var_map_.clear();
   storage_info_.clear();
+  fragment_shapes_.clear();
+  fragment_info_.clear();
   analyzer_.reset(new arith::Analyzer());
   builder_.reset(new spirv::IRBuilder(spirv_support_));
   builder_->InitHeader();
@@ -338,6 +341,32 @@ spirv::Value CodeGenSPIRV::VisitExpr_(const CallNode* op) {
     } else {
       return builder_->MakeValue(spv::OpShiftRightLogical, a.stype, a, b);
     }
+  } else if (op->op.same_as(builtin::vector_reduce_add()) ||
+             op->op.same_as(builtin::vector_reduce_mul()) ||
+             op->op.same_as(builtin::vector_reduce_min()) ||
+             op->op.same_as(builtin::vector_reduce_max())) {
+    ICHECK_EQ(op->args.size(), 1U);
+    std::vector<spirv::Value> lanes;
+    this->Scalarize(op->args[0], [&](int i, spirv::Value v) { lanes.push_back(v); });
+    // Combine the lanes pairwise, as a tree.
+    while (lanes.size() > 1) {
+      std::vector<spirv::Value> combined;
+      for (size_t i = 0; i + 1 < lanes.size(); i += 2) {
+        spirv::Value a = lanes[i], b = lanes[i + 1];
+        if (op->op.same_as(builtin::vector_reduce_add())) {
+          combined.push_back(builder_->Add(a, b));
+        } else if (op->op.same_as(builtin::vector_reduce_mul())) {
+          combined.push_back(builder_->Mul(a, b));
+        } else if (op->op.same_as(builtin::vector_reduce_min())) {
+          combined.push_back(builder_->Select(builder_->LT(a, b), a, b));
+        } else {
+          combined.push_back(builder_->Select(builder_->GT(a, b), a, b));
+        }
+      }
+      if (lanes.size() % 2 == 1) combined.push_back(lanes.back());
+      lanes = std::move(combined);
+    }
+    return lanes[0];
   } else if (op->op.same_as(builtin::reinterpret())) {
     return builder_->MakeValue(spv::OpBitcast, builder_->GetSType(op->dtype),
                                MakeValue(op->args[0]));
@@ -376,6 +405,11 @@ spirv::Value CodeGenSPIRV::VisitExpr_(const CallNode* op) {
   } else if (op->op.same_as(builtin::popcount())) {
     return builder_->MakeValue(spv::OpBitCount, builder_->GetSType(op->dtype),
                                MakeValue(op->args[0]));
+  } else if (op->op.same_as(builtin::tvm_fill_fragment()) ||
+             op->op.same_as(builtin::tvm_load_matrix_sync()) ||
+             op->op.same_as(builtin::tvm_store_matrix_sync()) ||
+             op->op.same_as(builtin::tvm_mma_sync())) {
+    return this->CreateCooperativeMatrixOp(op);
   } else if (op->op.same_as(builtin::call_pure_extern())) {
     ICHECK_GE(op->args.size(), 1U);
     const std::string& func_name = op->args[0].as<StringImmNode>()->value;
@@ -659,6 +693,13 @@ void CodeGenSPIRV::VisitStmt_(const AllocateNode* op) {
 
   spirv::Value buf;
   auto storage_scope = runtime::StorageScope::Create(GetPtrStorageScope(op->buffer_var));
+  if (storage_scope.rank == runtime::StorageRank::kWMMAMatrixA ||
+      storage_scope.rank == runtime::StorageRank::kWMMAMatrixB ||
+      storage_scope.rank == runtime::StorageRank::kWMMAAccumulator) {
+    this->AllocateFragment(op, storage_scope.rank);
+    this->VisitStmt(op->body);
+    return;
+  }
   spirv::SType etype = builder_->GetSType(op->dtype);
   if (storage_scope.rank == runtime::StorageRank::kLocal) {
     buf =
@@ -701,10 +742,148 @@ void CodeGenSPIRV::VisitStmt_(const AttrStmtNode* op) {
     const VarNode* v = op->node.as<VarNode>();
     ICHECK(v);
     storage_info_[v].is_volatile = true;
+  } else if (op->attr_key == tir::attr::fragment_shape) {
+    const VarNode* buffer = op->node.as<VarNode>();
+    const StringImmNode* shape_str = op->value.as<StringImmNode>();
+    ICHECK(buffer && shape_str);
+    fragment_shapes_[buffer] = shape_str->value;
   }
   this->VisitStmt(op->body);
 }
 
+void CodeGenSPIRV::AllocateFragment(const AllocateNode* op, runtime::StorageRank rank) {
+  const VarNode* buffer = op->buffer_var.get();
+  auto it = fragment_shapes_.find(buffer);
+  ICHECK(it != fragment_shapes_.end())
+      << "Cannot find shape of the wmma fragment " << buffer->name_hint;
+  uint32_t m = 0, n = 0, k = 0;
+  char sep0 = 0, sep1 = 0;
+  std::istringstream is(it->second);
+  is >> m >> sep0 >> n >> sep1 >> k;
+  ICHECK(!is.fail() && sep0 == ',' && sep1 == ',')
+      << "Invalid shape \"" << it->second << "\" of the wmma fragment " << buffer->name_hint;
+  ICHECK_EQ(op->dtype.lanes(), 1) << "The wmma fragment " << buffer->name_hint
+                                  << " must have scalar elements";
+
+  uint32_t rows = m, cols = n;
+  if (rank == runtime::StorageRank::kWMMAMatrixA) {
+    cols = k;
+  } else if (rank == runtime::StorageRank::kWMMAMatrixB) {
+    rows = k;
+  }
+  size_t constant_size = op->ConstantAllocationSize();
+  ICHECK_EQ(constant_size % (rows * cols), 0)
+      << "The size of the wmma fragment " << buffer->name_hint << " is not a multiple of " << rows
+      << "x" << cols;
+
+  FragmentInfo info;
+  spirv::SType etype = builder_->GetSType(op->dtype);
+  info.matrix_type = builder_->GetCooperativeMatrixNVType(etype, rows, cols);
+  info.array = builder_->AllocateCooperativeMatrixNV(
+      info.matrix_type, static_cast<uint32_t>(constant_size / (rows * cols)));
+  builder_->SetName(info.array, buffer->name_hint);
+  ICHECK(!fragment_info_.count(buffer));
+  fragment_info_[buffer] = info;
+}
+
+spirv::Value CodeGenSPIRV::GetFragmentPtr(const PrimExpr& buffer_var, const PrimExpr& index,
+                                          FragmentInfo* info) {
+  const VarNode* buffer = buffer_var.as<VarNode>();
+  ICHECK(buffer) << "Expected the data of a wmma fragment, but got " << buffer_var;
+  auto it = fragment_info_.find(buffer);
+  ICHECK(it != fragment_info_.end()) << "Cannot find the wmma fragment " << buffer->name_hint;
+  *info = it->second;
+  return builder_->CooperativeMatrixNVAccess(info->matrix_type, info->array, MakeValue(index));
+}
+
+spirv::Value CodeGenSPIRV::GetMatrixElementPtr(const PrimExpr& ptr) {
+  Var buffer_var;
+  PrimExpr index;
+  const CallNode* call = ptr.as<CallNode>();
+  if (call && call->op.same_as(builtin::tvm_access_ptr())) {
+    ICHECK_EQ(call->args.size(), 5U);
+    buffer_var = Downcast<Var>(call->args[1]);
+    index = call->args[2];
+  } else if (call && call->op.same_as(builtin::address_of())) {
+    const BufferLoadNode* load = call->args[0].as<BufferLoadNode>();
+    ICHECK(load && load->indices.size() == 1) << "SPIR-V codegen expects flat memory buffers";
+    buffer_var = load->buffer->data;
+    index = load->indices[0];
+  } else {
+    LOG(FATAL) << "Cannot load or store a cooperative matrix through the pointer " << ptr;
+  }
+
+  auto it = storage_info_.find(buffer_var.get());
+  ICHECK(it != storage_info_.end());
+  StorageInfo& info = it->second;
+  ICHECK(info.element_type_known)
+      << "Cannot find the element type of buffer " << buffer_var->name_hint;
+  ICHECK_EQ(info.element_type.lanes(), 1)
+      << "Cooperative matrices can only be loaded from, or stored to, the buffer "
+      << info.name_hint << " if it has scalar elements";
+
+  spirv::SType content_type = builder_->GetSType(info.element_type);
+  spirv::Value buffer = MakeValue(buffer_var);
+  spirv::SType ptr_type = builder_->GetPointerType(content_type, buffer.stype.storage_class);
+  return builder_->StructArrayAccess(ptr_type, buffer, MakeValue(analyzer_->Simplify(index)));
+}
+
+spirv::Value CodeGenSPIRV::CreateCooperativeMatrixOp(const CallNode* op) {
+  auto is_column_major = [](const PrimExpr& layout) {
+    const StringImmNode* str = layout.as<StringImmNode>();
+    ICHECK(str && (str->value == "row_major" || str->value == "col_major"))
+        << "The layout of a wmma fragment must be \"row_major\" or \"col_major\", but got "
+        << layout;
+    return str->value == "col_major";
+  };
+
+  if (op->op.same_as(builtin::tvm_fill_fragment())) {
+    // tvm_fill_fragment(fragment, m, n, k, index, value)
+    ICHECK_EQ(op->args.size(), 6U);
+    FragmentInfo info;
+    spirv::Value ptr = GetFragmentPtr(op->args[0], op->args[4], &info);
+    spirv::Value value = MakeValue(cast(info.matrix_type.type, op->args[5]));
+    spirv::Value matrix = builder_->MakeValue(spv::OpCompositeConstruct, info.matrix_type, value);
+    builder_->MakeInst(spv::OpStore, ptr, matrix);
+  } else if (op->op.same_as(builtin::tvm_load_matrix_sync())) {
+    // tvm_load_matrix_sync(fragment, m, n, k, index, buffer_ptr, stride, layout)
+    ICHECK_EQ(op->args.size(), 8U);
+    FragmentInfo info;
+    spirv::Value ptr = GetFragmentPtr(op->args[0], op->args[4], &info);
+    spirv::Value src = GetMatrixElementPtr(op->args[5]);
+    spirv::Value matrix = builder_->CooperativeMatrixLoadNV(
+        info.matrix_type, src, MakeValue(op->args[6]), is_column_major(op->args[7]));
+    builder_->MakeInst(spv::OpStore, ptr, matrix);
+  } else if (op->op.same_as(builtin::tvm_store_matrix_sync())) {
+    // tvm_store_matrix_sync(fragment, m, n, k, index, buffer_ptr, stride, layout)
+    ICHECK_EQ(op->args.size(), 8U);
+    FragmentInfo info;
+    spirv::Value ptr = GetFragmentPtr(op->args[0], op->args[4], &info);
+    spirv::Value matrix = builder_->MakeValue(spv::OpLoad, info.matrix_type, ptr);
+    spirv::Value dst = GetMatrixElementPtr(op->args[5]);
+    builder_->CooperativeMatrixStoreNV(dst, matrix, MakeValue(op->args[6]),
+                                       is_column_major(op->args[7]));
+  } else {
+    // tvm_mma_sync(fragment_d, index_d, fragment_a, index_a, fragment_b, index_b,
+    //              fragment_c, index_c)
+    ICHECK(op->op.same_as(builtin::tvm_mma_sync()));
+    ICHECK_EQ(op->args.size(), 8U);
+    FragmentInfo info_d, info_a, info_b, info_c;
+    spirv::Value ptr_d = GetFragmentPtr(op->args[0], op->args[1], &info_d);
+    spirv::Value ptr_a = GetFragmentPtr(op->args[2], op->args[3], &info_a);
+    spirv::Value ptr_b = GetFragmentPtr(op->args[4], op->args[5], &info_b);
+    spirv::Value ptr_c = GetFragmentPtr(op->args[6], op->args[7], &info_c);
+    spirv::Value a = builder_->MakeValue(spv::OpLoad, info_a.matrix_type, ptr_a);
+    spirv::Value b = builder_->MakeValue(spv::OpLoad, info_b.matrix_type, ptr_b);
+    spirv::Value c = builder_->MakeValue(spv::OpLoad, info_c.matrix_type, ptr_c);
+    spirv::Value d = builder_->CooperativeMatrixMulAddNV(a, b, c);
+    ICHECK_EQ(d.stype.id, info_d.matrix_type.id)
+        << "The accumulators of tvm_mma_sync must have the same type";
+    builder_->MakeInst(spv::OpStore, ptr_d, d);
+  }
+  return spirv::Value();
+}
+
 void CodeGenSPIRV::VisitStmt_(const AssertStmtNode* op) {
   With<arith::ConstraintContext> cctx(analyzer_.get(), op->condition);
   this->VisitStmt(op->body);
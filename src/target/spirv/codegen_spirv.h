@@ -171,12 +171,29 @@ class CodeGenSPIRV : public ExprFunctor<spirv::Value(const PrimExpr&)>,
       element_type_known = true;
     }
   };
+  /*! \brief A wmma fragment, lowered to an array of cooperative matrices */
+  struct FragmentInfo {
+    /*! \brief The cooperative matrix type of the elements of the fragment */
+    spirv::SType matrix_type;
+    /*! \brief The function-local array of cooperative matrices */
+    spirv::Value array;
+  };
   // Reset the state so it works for a new function.
   void InitFuncState();
   // Get the thread index
   spirv::Value GetThreadIndex(const IterVar& iv, const PrimExpr& extent);
 
   spirv::Value CreateStorageSync(const CallNode* op);
+  // Lower the wmma intrinsics (tvm_fill_fragment, tvm_load_matrix_sync, ...) to
+  // cooperative matrix operations.
+  spirv::Value CreateCooperativeMatrixOp(const CallNode* op);
+  // Allocate a wmma fragment as an array of cooperative matrices.
+  void AllocateFragment(const AllocateNode* op, runtime::StorageRank rank);
+  // Get the pointer to the index-th cooperative matrix of a wmma fragment.
+  spirv::Value GetFragmentPtr(const PrimExpr& buffer_var, const PrimExpr& index,
+                              FragmentInfo* info);
+  // Get the pointer to the element addressed by a tvm_access_ptr or address_of argument.
+  spirv::Value GetMatrixElementPtr(const PrimExpr& ptr);
   void Scalarize(const PrimExpr& e, std::function<void(int i, spirv::Value v)> f);
 
   // SPIRV-related capabilities of the target
@@ -203,6 +220,12 @@ class CodeGenSPIRV : public ExprFunctor<spirv::Value(const PrimExpr&)>,
   // the storage scope of allocation
   std::unordered_map<const VarNode*, StorageInfo> storage_info_;
 
+  // The shape "m, n, k" of the wmma fragments, from the fragment_shape attribute.
+  std::unordered_map<const VarNode*, std::string> fragment_shapes_;
+
+  // The wmma fragments that are allocated.
+  std::unordered_map<const VarNode*, FragmentInfo> fragment_info_;
+
   // The definition of local variable.
   std::unordered_map<const VarNode*, spirv::Value> var_map_;
 
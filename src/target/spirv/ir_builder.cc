@@ -641,6 +641,73 @@ Value IRBuilder::CallKHRIntegerDotProduct(const SType& ret_type, const std::vect
   return val;
 }
 
+SType IRBuilder::GetCooperativeMatrixNVType(const SType& elem_type, uint32_t rows, uint32_t cols) {
+  ICHECK(spirv_support_.supports_cooperative_matrix)
+      << "Vulkan target does not support cooperative matrix capability.  "
+      << "If your device supports cooperative matrix operations, "
+      << "please either add -supports_cooperative_matrix=1 to the target, "
+      << "or query all device parameters by adding -from_device=0.";
+  auto key = std::make_tuple(elem_type.id, rows, cols);
+  auto it = cooperative_matrix_type_tbl_.find(key);
+  if (it != cooperative_matrix_type_tbl_.end()) {
+    return it->second;
+  }
+  capabilities_used_.insert(spv::CapabilityCooperativeMatrixNV);
+  extensions_used_.insert("SPV_NV_cooperative_matrix");
+
+  SType t;
+  t.id = id_counter_++;
+  t.type = elem_type.type;
+  t.element_type_id = elem_type.id;
+  Value scope = UIntImm(t_uint32_, spv::ScopeSubgroup);
+  Value num_rows = UIntImm(t_uint32_, rows);
+  Value num_cols = UIntImm(t_uint32_, cols);
+  ib_.Begin(spv::OpTypeCooperativeMatrixNV)
+      .AddSeq(t, elem_type, scope, num_rows, num_cols)
+      .Commit(&global_);
+  cooperative_matrix_type_tbl_[key] = t;
+  return t;
+}
+
+Value IRBuilder::AllocateCooperativeMatrixNV(const SType& matrix_type, uint32_t num_elems) {
+  ICHECK_NE(num_elems, 0U);
+  // The matrices are opaque, the array has no explicit layout (ArrayStride).
+  SType arr_type;
+  arr_type.id = id_counter_++;
+  arr_type.type = DataType::Handle();
+  arr_type.element_type_id = matrix_type.id;
+  Value length = UIntImm(t_uint32_, num_elems);
+  ib_.Begin(spv::OpTypeArray).AddSeq(arr_type, matrix_type, length).Commit(&global_);
+
+  SType ptr_type = GetPointerType(arr_type, spv::StorageClassFunction);
+  Value val = NewValue(ptr_type, kNormal);
+  ib_.Begin(spv::OpVariable)
+      .AddSeq(ptr_type, val, spv::StorageClassFunction)
+      .Commit(&func_header_);
+  return val;
+}
+
+Value IRBuilder::CooperativeMatrixNVAccess(const SType& matrix_type, Value array, Value index) {
+  SType ptr_type = GetPointerType(matrix_type, spv::StorageClassFunction);
+  return MakeValue(spv::OpAccessChain, ptr_type, array, index);
+}
+
+Value IRBuilder::CooperativeMatrixLoadNV(const SType& matrix_type, Value ptr, Value stride,
+                                         bool column_major) {
+  Value col_major = UIntImm(t_bool_, column_major);
+  return MakeValue(spv::OpCooperativeMatrixLoadNV, matrix_type, ptr, stride, col_major);
+}
+
+void IRBuilder::CooperativeMatrixStoreNV(Value ptr, Value matrix, Value stride,
+                                         bool column_major) {
+  Value col_major = UIntImm(t_bool_, column_major);
+  MakeInst(spv::OpCooperativeMatrixStoreNV, ptr, matrix, stride, col_major);
+}
+
+Value IRBuilder::CooperativeMatrixMulAddNV(Value a, Value b, Value c) {
+  return MakeValue(spv::OpCooperativeMatrixMulAddNV, c.stype, a, b, c);
+}
+
 Value IRBuilder::Concat(const std::vector<Value>& vec) {
   bool is_const = vec[0].flag == kConstant;
   DataType etype = vec[0].stype.type;
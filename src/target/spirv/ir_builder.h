@@ -431,6 +431,62 @@ class IRBuilder {
   Value CallKHRIntegerDotProduct(const SType& ret_type, const std::vector<Value>& args,
                                  const DataType& dtype);
 
+  /*!
+   * \brief Get the type of a subgroup-scope cooperative matrix (SPV_NV_cooperative_matrix)
+   *
+   * \param elem_type The type of the matrix elements.
+   * \param rows The number of rows of the matrix.
+   * \param cols The number of columns of the matrix.
+   * \return The corresponding spirv type.
+   */
+  SType GetCooperativeMatrixNVType(const SType& elem_type, uint32_t rows, uint32_t cols);
+  /*!
+   * \brief Allocate a function-local array of cooperative matrices
+   *
+   * \param matrix_type The cooperative matrix type.
+   * \param num_elems The number of matrices in the array.
+   * \return The pointer to the array.
+   */
+  Value AllocateCooperativeMatrixNV(const SType& matrix_type, uint32_t num_elems);
+  /*!
+   * \brief Get the pointer to a cooperative matrix of an array
+   *
+   * \param matrix_type The cooperative matrix type.
+   * \param array The array, as returned by AllocateCooperativeMatrixNV.
+   * \param index The index of the matrix in the array.
+   * \return The pointer to the matrix.
+   */
+  Value CooperativeMatrixNVAccess(const SType& matrix_type, Value array, Value index);
+  /*!
+   * \brief Load a cooperative matrix from memory
+   *
+   * \param matrix_type The cooperative matrix type.
+   * \param ptr The pointer to the first element, in storage buffer or workgroup memory.
+   * \param stride The number of elements between two consecutive rows, or columns.
+   * \param column_major Whether the matrix is stored in column-major order.
+   * \return The loaded matrix.
+   */
+  Value CooperativeMatrixLoadNV(const SType& matrix_type, Value ptr, Value stride,
+                                bool column_major);
+  /*!
+   * \brief Store a cooperative matrix to memory
+   *
+   * \param ptr The pointer to the first element, in storage buffer or workgroup memory.
+   * \param matrix The matrix to be stored.
+   * \param stride The number of elements between two consecutive rows, or columns.
+   * \param column_major Whether the matrix is stored in column-major order.
+   */
+  void CooperativeMatrixStoreNV(Value ptr, Value matrix, Value stride, bool column_major);
+  /*!
+   * \brief Compute a * b + c, on cooperative matrices
+   *
+   * \param a The MxK matrix.
+   * \param b The KxN matrix.
+   * \param c The MxN matrix, whose type is the type of the result.
+   * \return The result value.
+   */
+  Value CooperativeMatrixMulAddNV(Value a, Value b, Value c);
+
   /*!
    * \brief Build vector by concatenating components
    *
@@ -699,6 +755,8 @@ class IRBuilder {
   std::unordered_map<uint32_t, SType> pod_type_tbl_;
   /*! \brief map from value to array type */
   std::map<std::tuple<uint32_t, uint32_t, bool>, SType> struct_array_type_tbl_;
+  /*! \brief map from (element type, rows, columns) to the cooperative matrix type */
+  std::map<std::tuple<uint32_t, uint32_t, uint32_t>, SType> cooperative_matrix_type_tbl_;
   /*! \brief map from value to its pointer type */
   std::map<std::pair<uint32_t, spv::StorageClass>, SType> pointer_type_tbl_;
   /*! \brief map from constant int to its value */
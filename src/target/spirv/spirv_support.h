@@ -276,6 +276,22 @@ struct SPIRVSupport {
    * attempting to perform integer dot product.
    */
   bool supports_integer_dot_product{false};
+
+  /*!
+   * \brief Whether the driver supports cooperative matrix operations.
+   *
+   * Vulkan extension: VK_NV_cooperative_matrix
+   * Vulkan struct: VkPhysicalDeviceCooperativeMatrixFeaturesNV
+   * Device Property: cooperativeMatrix
+   * SPV Extension name: SPV_NV_cooperative_matrix
+   * SPV Capability: spv::CapabilityCooperativeMatrixNV
+   *
+   * If support is present, the wmma fragments and intrinsics
+   * (tvm_load_matrix_sync, tvm_mma_sync, ...) are lowered to
+   * subgroup-scope cooperative matrices.  If support is not present,
+   * codegen will throw exception on attempting to use a wmma fragment.
+   */
+  bool supports_cooperative_matrix{false};
 };
 
 }  // namespace codegen
@@ -272,9 +272,19 @@ TVM_REGISTER_TARGET_KIND("llvm", kDLCPU)
     .add_attr_option<Bool>("fast-math-arcp")
     .add_attr_option<Bool>("fast-math-contract")
     .add_attr_option<Bool>("fast-math-reassoc")
+    // The minimum alignment of the linked parameters, in bytes
+    .add_attr_option<Integer>("constants-byte-alignment")
     .add_attr_option<Integer>("opt-level")
+    // The JIT engine running the module, "mcjit" (default) or "orcjit"
+    .add_attr_option<String>("jit")
     // LLVM command line flags, see below
     .add_attr_option<Array<String>>("cl-opt")
+    // Peak compute and memory throughput used by roofline analysis instead of measuring them
+    .add_attr_option<Integer>("peak_gflops")
+    .add_attr_option<Integer>("peak_bandwidth_gbps")
+    // Per-core data cache sizes used by the working-set model of tile size tuning
+    .add_attr_option<Integer>("l1_cache_bytes")
+    .add_attr_option<Integer>("l2_cache_bytes")
     .set_default_keys({"cpu"})
     // Force the external codegen kind attribute to be registered, even if no external
     // codegen targets are enabled by the TVM build.
@@ -314,11 +324,14 @@ TVM_REGISTER_TARGET_KIND("c", kDLCPU)
 TVM_REGISTER_TARGET_KIND("cuda", kDLCUDA)
     .add_attr_option<String>("mcpu")
     .add_attr_option<String>("arch")
+    .add_attr_option<Array<String>>("fatbin_archs")
     .add_attr_option<Integer>("max_shared_memory_per_block")
     .add_attr_option<Integer>("max_threads_per_block")
     .add_attr_option<Integer>("thread_warp_size", Integer(32))
     .add_attr_option<Integer>("registers_per_block")
     .add_attr_option<Integer>("max_num_threads", Integer(1024))  // TODO(@zxybazh): deprecate it
+    .add_attr_option<Integer>("peak_gflops")
+    .add_attr_option<Integer>("peak_bandwidth_gbps")
     .set_default_keys({"cuda", "gpu"})
     .set_target_parser(UpdateCUDAAttrs);
 
@@ -378,6 +391,7 @@ TVM_REGISTER_TARGET_KIND("vulkan", kDLVulkan)
     .add_attr_option<Bool>("supports_push_descriptor")
     .add_attr_option<Bool>("supports_dedicated_allocation")
     .add_attr_option<Bool>("supports_integer_dot_product")
+    .add_attr_option<Bool>("supports_cooperative_matrix")
     .add_attr_option<Integer>("supported_subgroup_operations")
     // Physical device limits
     .add_attr_option<Integer>("max_num_threads", Integer(256))
@@ -40,12 +40,32 @@
 namespace tvm {
 namespace tir {
 
-/*! \brief The helper mutator that transforms ProducerLoad to BufferLoad */
+/*!
+ * \brief The helper mutator that transforms ProducerLoad to BufferLoad, and substitutes the
+ * iteration variables of the compute op with the block variables in the same pass.
+ */
 class ProducerToBufferTransformer : public StmtExprMutator {
  public:
   explicit ProducerToBufferTransformer(const std::unordered_map<te::Tensor, Buffer>& tensor2buffers)
       : tensor2buffers_(tensor2buffers) {}
 
+  PrimExpr Rewrite(const PrimExpr& expr, const std::unordered_map<const VarNode*, Var>& var_map) {
+    var_map_ = &var_map;
+    PrimExpr result = VisitExpr(expr);
+    var_map_ = nullptr;
+    return result;
+  }
+
+  PrimExpr VisitExpr_(const VarNode* op) final {
+    if (var_map_ != nullptr) {
+      auto it = var_map_->find(op);
+      if (it != var_map_->end()) {
+        return it->second;
+      }
+    }
+    return GetRef<PrimExpr>(op);
+  }
+
   PrimExpr VisitExpr_(const ProducerLoadNode* op) final {
     auto visited_op = Downcast<ProducerLoad>(StmtExprMutator::VisitExpr_(op));
     te::Tensor tensor = Downcast<te::Tensor>(visited_op->producer);
@@ -58,6 +78,8 @@ class ProducerToBufferTransformer : public StmtExprMutator {
  private:
   /*! \brief The Map from Operations to buffers */
   const std::unordered_map<te::Tensor, Buffer>& tensor2buffers_;
+  /*! \brief The variables to substitute, or nullptr. */
+  const std::unordered_map<const VarNode*, Var>* var_map_{nullptr};
 };
 
 /*! \brief The helper mutator to rewrite buffer and buffer var accessed by block body */
@@ -102,6 +124,8 @@ class BufferSubstituter : public StmtExprMutator {
 struct CreateFuncInfo {
   /*! \brief The Tensor arg_list. */
   Array<te::Tensor> arg_list;
+  /*! \brief The set of arg_list, as large fused functions have many arguments and stages. */
+  std::unordered_set<te::Tensor> arg_set;
   /*! \brief The map from each Tensor to its corresponding buffer. */
   std::unordered_map<te::Tensor, Buffer> tensor2buffers;
   /*! \brief The transformer from ProducerLoad to BufferLoad. */
@@ -114,12 +138,11 @@ struct CreateFuncInfo {
   String FreshName(String base_name) { return name_supply->FreshName(base_name); }
 
   explicit CreateFuncInfo(Array<te::Tensor> arg_list)
-      : arg_list(std::move(arg_list)), transformer(tensor2buffers) {}
-
-  bool IsArg(const te::Tensor& tensor) const {
-    return std::any_of(arg_list.begin(), arg_list.end(),
-                       [&tensor](const te::Tensor& arg) { return tensor == arg; });
+      : arg_list(std::move(arg_list)), transformer(tensor2buffers) {
+    arg_set.insert(this->arg_list.begin(), this->arg_list.end());
   }
+
+  bool IsArg(const te::Tensor& tensor) const { return arg_set.count(tensor); }
 };
 
 class LayoutFreePlaceholdersNormalizer : public StmtMutator {
@@ -182,22 +205,19 @@ class LayoutFreePlaceholdersNormalizer : public StmtMutator {
 
 BlockRealize GenerateBlockFromTensors(const te::ComputeOp& compute_op,
                                       const Array<te::Tensor>& tensors, Array<PrimExpr> bindings,
-                                      PrimExpr expr_body, CreateFuncInfo* info,
-                                      arith::Analyzer* analyzer) {
+                                      const Array<Range>& doms, PrimExpr expr_body,
+                                      CreateFuncInfo* info, arith::Analyzer* analyzer) {
   // Step 1. Push_back data_par axis and reduce_axis into block_vars.
   Array<IterVar> iter_vars;
   std::unordered_map<const VarNode*, Var> var_map;
   iter_vars.reserve(compute_op->axis.size() + compute_op->reduce_axis.size());
-  auto f_push_block_vars = [&iter_vars, &var_map, &analyzer](const Array<IterVar>& iters) {
+  auto f_push_block_vars = [&iter_vars, &var_map, &doms](const Array<IterVar>& iters) {
     for (IterVar iter_var : iters) {
       // Create new var
       Var new_var("v_" + iter_var->var->name_hint, iter_var->var->dtype);
       var_map[iter_var->var.get()] = new_var;
-
-      PrimExpr dom_min = analyzer->Simplify(iter_var->dom->min);
-      PrimExpr dom_extent = analyzer->Simplify(iter_var->dom->extent);
-      iter_vars.push_back(IterVar(Range::FromMinExtent(dom_min, dom_extent), new_var,
-                                  iter_var->iter_type, iter_var->thread_tag, iter_var->span));
+      iter_vars.push_back(IterVar(doms[iter_vars.size()], new_var, iter_var->iter_type,
+                                  iter_var->thread_tag, iter_var->span));
     }
   };
   f_push_block_vars(compute_op->axis);
@@ -247,7 +267,7 @@ BlockRealize GenerateBlockFromTensors(const te::ComputeOp& compute_op,
     for (int i = 0; i < n_buffers; ++i) {
       const PrimExpr& left = BufferLoad(buffers[i], indices);
       const PrimExpr& right =
-          analyzer->Simplify(Substitute(info->transformer(reduce->source[i]), var_map));
+          analyzer->Simplify(info->transformer.Rewrite(reduce->source[i], var_map));
       lhs.push_back(left);
       rhs.push_back(right);
       ICHECK_EQ(left->dtype, right->dtype);
@@ -265,6 +285,8 @@ BlockRealize GenerateBlockFromTensors(const te::ComputeOp& compute_op,
     // - In case there are multiple buffers, to avoid incorrect results, we create some intermediate
     //   variables and use LetStmts to bind the variables with "combiner(lhs, rhs)". After that, we
     //   then store the value of the variables into the target buffer positions.
+    // The combiner builds all of its results at once, so that it is only applied once.
+    Array<PrimExpr> combined = reduce->combiner.get()->operator()(lhs, rhs);
     for (int i = 0; i < n_buffers; ++i) {
       const Buffer& buffer = buffers[i];
       init_stmts.push_back(BufferStore(buffer, reduce->combiner->identity_element[i], indices));
@@ -273,7 +295,7 @@ BlockRealize GenerateBlockFromTensors(const te::ComputeOp& compute_op,
         temp_vars.push_back(Var("v_" + buffer->name, PrimType(lhs[i].dtype())));
         value = temp_vars.back();
       } else {
-        value = reduce->combiner.get()->operator()(lhs, rhs)[i];
+        value = combined[i];
       }
       body_stmts.push_back(BufferStore(buffer, value, indices));
     }
@@ -283,15 +305,14 @@ BlockRealize GenerateBlockFromTensors(const te::ComputeOp& compute_op,
     if (n_buffers > 1) {
       // When there are multiple buffers, we wrap the body with LetStmts.
       for (int i = n_buffers - 1; i >= 0; --i) {
-        PrimExpr value = reduce->combiner.get()->operator()(lhs, rhs)[i];
-        body = LetStmt(temp_vars[i], std::move(value), std::move(body));
+        body = LetStmt(temp_vars[i], combined[i], std::move(body));
       }
     }
   } else {
     // Case 2. Data parallel compute
     ICHECK_EQ(tensors.size(), 1);
     block_name = info->FreshName(tensors[0]->GetNameHint());
-    const PrimExpr& compute_body = Substitute(info->transformer(expr_body), var_map);
+    const PrimExpr& compute_body = info->transformer.Rewrite(expr_body, var_map);
     body = BufferStore(info->tensor2buffers[tensors[0]], analyzer->Simplify(compute_body), indices);
   }
 
@@ -350,6 +371,11 @@ Stmt GenerateStmtFromCompute(const te::ComputeOp& compute_op, CreateFuncInfo* in
     int bits = std::max(iter_var->dom->min.dtype().bits(), iter_var->dom->extent.dtype().bits());
     return Var(iter_var->var->name_hint, runtime::DataType::Int(bits));
   });
+  // The domains are shared by the loops and the blocks of all outputs, simplify them once.
+  Array<Range> doms = axes.Map([&](IterVar iter_var) -> Range {
+    return Range::FromMinExtent(analyzer->Simplify(iter_var->dom->min),
+                                analyzer->Simplify(iter_var->dom->extent));
+  });
 
   // Step 2. Generate block bodies.
   Array<Stmt> seq_stmt;
@@ -374,13 +400,13 @@ Stmt GenerateStmtFromCompute(const te::ComputeOp& compute_op, CreateFuncInfo* in
       tensors.push_back(compute_op.output(k));
     }
 
-    seq_stmt.push_back(GenerateBlockFromTensors(compute_op, tensors, bindings, std::move(expr_body),
-                                                info, analyzer));
+    seq_stmt.push_back(GenerateBlockFromTensors(compute_op, tensors, bindings, doms,
+                                                std::move(expr_body), info, analyzer));
   } else {
     for (int i = 0; i < compute_op->num_outputs(); ++i) {
       const te::Tensor& tensor = compute_op.output(i);
       PrimExpr expr_body = compute_op->body[i];
-      seq_stmt.push_back(GenerateBlockFromTensors(compute_op, {tensor}, bindings,
+      seq_stmt.push_back(GenerateBlockFromTensors(compute_op, {tensor}, bindings, doms,
                                                   std::move(expr_body), info, analyzer));
     }
   }
@@ -389,11 +415,9 @@ Stmt GenerateStmtFromCompute(const te::ComputeOp& compute_op, CreateFuncInfo* in
 
   // Step 3. Generate loop nesting.
   for (size_t i = axes.size(); i > 0; --i) {
-    const IterVar& axis = axes[i - 1];
-    PrimExpr dom_min = analyzer->Simplify(axis->dom->min);
-    PrimExpr dom_extent = analyzer->Simplify(axis->dom->extent);
+    const Range& dom = doms[i - 1];
     const Var& loop_var = Downcast<Var>(bindings[i - 1]);
-    body = For(loop_var, dom_min, dom_extent, ForKind::kSerial, body);
+    body = For(loop_var, dom->min, dom->extent, ForKind::kSerial, body);
   }
 
   return body;
@@ -364,7 +364,7 @@ Stage& Stage::vectorize(IterVar var) {  // NOLINT(*)
   With<ScheduleContext> ctx(operator->()->attach_sch, __func__);
   ICHECK(var->iter_type == kDataPar || var->iter_type == kOpaque || var->iter_type == kUnrolled ||
          var->iter_type == kVectorized || var->iter_type == kTensorized ||
-         var->iter_type == kParallelized)
+         var->iter_type == kParallelized || var->iter_type == kCommReduce)
       << "Cannot vectorize on " << IterVarType2String(var->iter_type);
   SetAttrIterType(operator->(), var, kVectorized);
   return *this;
@@ -0,0 +1,210 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file estimate_register_pressure.cc
+ * \brief Estimate the number of live vector registers in the innermost loop bodies.
+ */
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace tir {
+
+/*!
+ * \brief Estimate the register pressure of a straight-line loop body.
+ *
+ * Every distinct access, i.e. a buffer and its indices, or a let-bound variable, is assumed to
+ * live in registers from the first leaf statement that touches it to the last one. An access that
+ * is read to update itself, e.g. an accumulator, is carried across the iterations of the loop, so
+ * it is live through the whole body. The pressure is the maximal number
+ * of registers occupied by the live values at any leaf statement.
+ */
+class RegisterPressureEstimator : public StmtExprVisitor {
+ public:
+  static int64_t Estimate(const Stmt& body, int vector_bits) {
+    RegisterPressureEstimator estimator;
+    estimator(body);
+    if (estimator.num_points_ == 0) {
+      return 0;
+    }
+    std::vector<int64_t> live(estimator.num_points_ + 1, 0);
+    auto f_add = [&](const LiveRange& range) {
+      int64_t bits = static_cast<int64_t>(range.dtype.bits()) * range.dtype.lanes();
+      int64_t num_regs = std::max<int64_t>(1, (bits + vector_bits - 1) / vector_bits);
+      int first = range.carried ? 0 : range.first;
+      int last = range.carried ? estimator.num_points_ - 1 : range.last;
+      live[first] += num_regs;
+      live[last + 1] -= num_regs;
+    };
+    for (const auto& kv : estimator.accesses_) {
+      f_add(kv.second);
+    }
+    for (const auto& kv : estimator.let_vars_) {
+      f_add(kv.second);
+    }
+    int64_t pressure = 0;
+    int64_t current = 0;
+    for (int i = 0; i < estimator.num_points_; ++i) {
+      current += live[i];
+      pressure = std::max(pressure, current);
+    }
+    return pressure;
+  }
+
+ private:
+  struct LiveRange {
+    DataType dtype;
+    int first;
+    int last;
+    bool carried{false};
+  };
+
+  void Touch(LiveRange* range, DataType dtype) {
+    if (range->first < 0) {
+      range->dtype = dtype;
+      range->first = num_points_;
+    }
+    if (dtype.bits() * dtype.lanes() > range->dtype.bits() * range->dtype.lanes()) {
+      range->dtype = dtype;
+    }
+    range->last = num_points_;
+  }
+
+  LiveRange* GetAccess(const Var& buffer_var, const Array<PrimExpr>& indices) {
+    Array<PrimExpr> key{buffer_var};
+    for (const PrimExpr& index : indices) {
+      key.push_back(index);
+    }
+    auto it = accesses_.find(key);
+    if (it == accesses_.end()) {
+      it = accesses_.emplace(key, LiveRange{DataType::Void(), -1, -1}).first;
+    }
+    return &it->second;
+  }
+
+  void VisitExpr_(const BufferLoadNode* op) final {
+    LiveRange* range = GetAccess(op->buffer->data, op->indices);
+    Touch(range, op->dtype);
+    reads_in_point_.push_back(range);
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const VarNode* op) final {
+    auto it = let_vars_.find(op);
+    if (it != let_vars_.end()) {
+      it->second.last = num_points_;
+    }
+  }
+
+  void VisitStmt_(const LetStmtNode* op) final {
+    this->VisitExpr(op->value);
+    let_vars_[op->var.get()] = LiveRange{op->var.dtype(), num_points_, num_points_};
+    ++num_points_;
+    this->VisitStmt(op->body);
+  }
+
+  void VisitStmt_(const BufferStoreNode* op) final {
+    reads_in_point_.clear();
+    this->VisitExpr(op->value);
+    for (const PrimExpr& index : op->indices) {
+      this->VisitExpr(index);
+    }
+    LiveRange* range = GetAccess(op->buffer->data, op->indices);
+    // The stored location is read by its own value, e.g. `C = C + A * B`.
+    if (std::find(reads_in_point_.begin(), reads_in_point_.end(), range) != reads_in_point_.end()) {
+      range->carried = true;
+    }
+    Touch(range, op->value.dtype());
+    reads_in_point_.clear();
+    ++num_points_;
+  }
+
+  void VisitStmt_(const EvaluateNode* op) final {
+    StmtExprVisitor::VisitStmt_(op);
+    ++num_points_;
+  }
+
+  /*! \brief The number of leaf statements visited so far. */
+  int num_points_{0};
+  /*! \brief The accesses read by the leaf statement being visited. */
+  std::vector<LiveRange*> reads_in_point_;
+  /*! \brief The live ranges of the distinct buffer accesses. */
+  std::unordered_map<Array<PrimExpr>, LiveRange, StructuralHash, StructuralEqual> accesses_;
+  /*! \brief The live ranges of the let-bound variables. */
+  std::unordered_map<const VarNode*, LiveRange> let_vars_;
+};
+
+/*! \brief Collect the bodies of the innermost loops, or the whole statement if it has no loop. */
+class InnermostLoopBodyCollector : public StmtVisitor {
+ public:
+  static Array<Stmt> Collect(const Stmt& stmt) {
+    InnermostLoopBodyCollector collector;
+    collector(stmt);
+    if (!collector.found_loop_) {
+      return {stmt};
+    }
+    return collector.bodies_;
+  }
+
+ private:
+  void VisitStmt_(const ForNode* op) final {
+    found_loop_ = false;
+    this->VisitStmt(op->body);
+    if (!found_loop_) {
+      bodies_.push_back(op->body);
+    }
+    found_loop_ = true;
+  }
+
+  bool found_loop_{false};
+  Array<Stmt> bodies_;
+};
+
+int64_t EstimateRegisterPressure(const Stmt& stmt, int vector_bits) {
+  CHECK_GT(vector_bits, 0) << "ValueError: The width of a vector register must be positive, but "
+                           << "gets " << vector_bits;
+  int64_t pressure = 0;
+  for (const Stmt& body : InnermostLoopBodyCollector::Collect(stmt)) {
+    pressure = std::max(pressure, RegisterPressureEstimator::Estimate(body, vector_bits));
+  }
+  return pressure;
+}
+
+TVM_REGISTER_GLOBAL("tir.analysis.EstimateRegisterPressure")
+    .set_body_typed([](ObjectRef obj, int vector_bits) -> int64_t {
+      if (auto func = obj.as<PrimFunc>()) {
+        return EstimateRegisterPressure(func.value()->body, vector_bits);
+      } else if (auto stmt = obj.as<Stmt>()) {
+        return EstimateRegisterPressure(stmt.value(), vector_bits);
+      } else {
+        LOG(FATAL) << "TypeError: Expect the input to be either PrimFunc or Stmt, but gets: "
+                   << obj->GetTypeKey();
+        throw;
+      }
+    });
+
+}  // namespace tir
+}  // namespace tvm
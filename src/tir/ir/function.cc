@@ -55,6 +55,7 @@ FuncType PrimFuncNode::func_type_annotation() const {
 }
 
 TVM_REGISTER_NODE_TYPE(PrimFuncNode);
+TVM_REGISTER_SHASH_CACHE(PrimFuncNode, shash_cache_);
 
 class TensorIntrinManager {
  public:
@@ -21,10 +21,15 @@
  * \file tir/ir/transform.cc
  * \brief TIR specific transformation passes.
  */
+#include <tvm/ir/instrument.h>
 #include <tvm/node/repr_printer.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/support/parallel_for.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace tvm {
 namespace tir {
 namespace transform {
@@ -41,6 +46,9 @@ class PrimFuncPassNode : public PassNode {
   /*! \brief The pass function called on each. */
   runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)> pass_func;
 
+  /*! \brief Whether the pass function only reads the PrimFunc it is called on. */
+  bool function_local = false;
+
   void VisitAttrs(tvm::AttrVisitor* v) { v->Visit("pass_info", &pass_info); }
 
   /*!
@@ -68,20 +76,22 @@ class PrimFuncPass : public Pass {
    * \brief The constructor
    * \param pass_func The packed function which implements a pass.
    * \param pass_info The pass info.
+   * \param function_local Whether the pass function only reads the PrimFunc it is called on.
    */
   TVM_DLL PrimFuncPass(
       runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)> pass_func,
-      PassInfo pass_info);
+      PassInfo pass_info, bool function_local = false);
 
   TVM_DEFINE_OBJECT_REF_METHODS(PrimFuncPass, Pass, PrimFuncPassNode);
 };
 
 PrimFuncPass::PrimFuncPass(
     runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)> pass_func,
-    PassInfo pass_info) {
+    PassInfo pass_info, bool function_local) {
   auto n = make_object<PrimFuncPassNode>();
   n->pass_func = std::move(pass_func);
   n->pass_info = std::move(pass_info);
+  n->function_local = function_local;
   data_ = std::move(n);
 }
 
@@ -92,17 +102,54 @@ IRModule PrimFuncPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
 
   IRModuleNode* mod_ptr = mod.CopyOnWrite();
   auto* func_dict = mod_ptr->functions.CopyOnWrite();
-  // directly loop over the underlying dict
-  for (auto& kv : *func_dict) {
-    // only picks up tir::PrimFunc
-    if (kv.second->IsInstance<PrimFuncNode>()) {
-      // move out the function so that it is the only copy.
-      PrimFunc func = Downcast<PrimFunc>(std::move(kv.second));
-      func = pass_func(std::move(func), mod, pass_ctx);
-      kv.second = std::move(func);
-
-      if (!kv.second.defined()) {
-        deleted_list.push_back(Downcast<GlobalVar>(kv.first));
+  int num_jobs =
+      function_local
+          ? pass_ctx->GetConfig<Integer>("tir.num_parallel_jobs", Integer(1)).value()->value
+          : 1;
+  if (num_jobs > 1) {
+    std::vector<MapNode::KVType*> prim_funcs;
+    for (auto& kv : *func_dict) {
+      if (kv.second->IsInstance<PrimFuncNode>()) {
+        prim_funcs.push_back(&kv);
+      }
+    }
+    // Each thread only replaces the value of its own entry, the dict itself is not modified. The
+    // pass context is thread local, so the workers enter a copy of it without the instruments, as
+    // those are not required to be thread safe.
+    PassContext worker_ctx = PassContext::Create();
+    worker_ctx->opt_level = pass_ctx->opt_level;
+    worker_ctx->required_pass = pass_ctx->required_pass;
+    worker_ctx->disabled_pass = pass_ctx->disabled_pass;
+    worker_ctx->config = pass_ctx->config;
+    int num_funcs = prim_funcs.size();
+    support::parallel_for_dynamic(
+        0, num_funcs, std::min(num_jobs, std::max(num_funcs, 1)), [&](int thread_id, int i) {
+          With<PassContext> scope(worker_ctx);
+          // move out the function so that it is the only copy.
+          PrimFunc func = Downcast<PrimFunc>(std::move(prim_funcs[i]->second));
+          prim_funcs[i]->second = pass_func(std::move(func), mod, worker_ctx);
+        });
+    for (auto* kv : prim_funcs) {
+      if (!kv->second.defined()) {
+        deleted_list.push_back(Downcast<GlobalVar>(kv->first));
+      }
+    }
+  } else {
+    // directly loop over the underlying dict
+    for (auto& kv : *func_dict) {
+      // only picks up tir::PrimFunc
+      if (kv.second->IsInstance<PrimFuncNode>()) {
+        // move out the function so that it is the only copy.
+        PrimFunc func = Downcast<PrimFunc>(std::move(kv.second));
+        {
+          instrument::FunctionPassProfileScope profile_scope(kv.first);
+          func = pass_func(std::move(func), mod, pass_ctx);
+        }
+        kv.second = std::move(func);
+
+        if (!kv.second.defined()) {
+          deleted_list.push_back(Downcast<GlobalVar>(kv.first));
+        }
       }
     }
   }
@@ -118,9 +165,9 @@ IRModule PrimFuncPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
 
 Pass CreatePrimFuncPass(
     const runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required) {
+    int opt_level, String name, tvm::Array<String> required, bool function_local) {
   PassInfo pass_info = PassInfo(opt_level, name, required);
-  return PrimFuncPass(pass_func, pass_info);
+  return PrimFuncPass(pass_func, pass_info, function_local);
 }
 
 TVM_REGISTER_NODE_TYPE(PrimFuncPassNode);
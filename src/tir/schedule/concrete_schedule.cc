@@ -55,11 +55,10 @@ class ScheduleCopier {
   static void Copy(const ConcreteScheduleNode* self, ScheduleState* new_state,
                    TSymbolTable* new_symbol_table) {
     const ScheduleState& src_state = self->state_;
-    ScheduleCopier copier(src_state);
     ObjectPtr<ScheduleStateNode> n = make_object<ScheduleStateNode>();
+    ScheduleCopier copier(src_state, &n->stmt2ref);
     n->mod = src_state->mod;
     n->block_info = copier.Copy(src_state->block_info);
-    n->stmt2ref = copier.Copy(src_state->stmt2ref);
     n->debug_mask = src_state->debug_mask;
     n->enable_check = src_state->enable_check;
     *new_state = ScheduleState(std::move(n));
@@ -67,15 +66,21 @@ class ScheduleCopier {
   }
 
  private:
-  /*! \brief Create the copier and properly set up the `old2new_` table */
-  explicit ScheduleCopier(const ScheduleState& state) {
+  /*!
+   * \brief Create the copier and properly set up the `old2new_` table, building the `stmt2ref` of
+   * the new state along the way
+   */
+  ScheduleCopier(const ScheduleState& state, UMap<const StmtNode*, StmtSRef>* new_stmt2ref) {
     // Create SRef tree without parents
+    old2new_.reserve(state->stmt2ref.size());
+    new_stmt2ref->reserve(state->stmt2ref.size());
     for (const auto& kv : state->stmt2ref) {
       const StmtSRefNode* sref = kv.second.operator->();
-      old2new_.emplace(sref,                          // the old StmtSRef
-                       StmtSRef(/*stmt=*/sref->stmt,  // the new StmtSRef
-                                /*parent=*/nullptr,   // parent is not set yet
-                                /*seq_index=*/sref->seq_index));
+      StmtSRef new_sref(/*stmt=*/sref->stmt,  // the new StmtSRef
+                        /*parent=*/nullptr,   // parent is not set yet
+                        /*seq_index=*/sref->seq_index);
+      new_stmt2ref->emplace(kv.first, new_sref);
+      old2new_.emplace(sref, std::move(new_sref));
     }
     // Fill in the parent field
     // Find out the root along the way
@@ -108,12 +113,26 @@ class ScheduleCopier {
     return result;
   }
 
+  /*!
+   * \brief Copy Dependency. Each dependency is listed in both `src2deps` and `dst2deps` of a
+   * scope, and is copied only once so that both maps share it, as they do in the original scope.
+   */
+  Dependency Copy(const Dependency& dep) {
+    auto it = dep2new_.find(dep.get());
+    if (it != dep2new_.end()) {
+      return it->second;
+    }
+    Dependency result(Copy(dep->src), Copy(dep->dst), dep->kind);
+    dep2new_.emplace(dep.get(), result);
+    return result;
+  }
+
   /*! \brief Copy Array<Dependency> */
   Array<Dependency> Copy(const Array<Dependency>& list) {
     Array<Dependency> result;
     result.reserve(list.size());
     for (const Dependency& elem : list) {
-      result.push_back(Dependency(Copy(elem->src), Copy(elem->dst), elem->kind));
+      result.push_back(Copy(elem));
     }
     return result;
   }
@@ -141,6 +160,7 @@ class ScheduleCopier {
   /*! \brief Copy SMap<StmtSRef, Scope> */
   SMap<StmtSRef, BlockInfo> Copy(const SMap<StmtSRef, BlockInfo>& scopes) {
     SMap<StmtSRef, BlockInfo> result;
+    result.reserve(scopes.size());
     for (const auto& kv : scopes) {
       const StmtSRef& old_sref = kv.first;
       const BlockInfo& old_info = kv.second;
@@ -156,18 +176,6 @@ class ScheduleCopier {
     return result;
   }
 
-  /*! \brief Copy the stmt2ref */
-  UMap<const StmtNode*, StmtSRef> Copy(const UMap<const StmtNode*, StmtSRef>& stmt2ref) {
-    UMap<const StmtNode*, StmtSRef> result;
-    result.reserve(stmt2ref.size());
-    for (const auto& kv : stmt2ref) {
-      const StmtNode* stmt = kv.first;
-      const StmtSRef& sref = kv.second;
-      result.emplace(stmt, Copy(sref));
-    }
-    return result;
-  }
-
   /*! \brief Copy the symbol table */
   TSymbolTable Copy(const TSymbolTable& tab) {
     TSymbolTable result;
@@ -183,6 +191,8 @@ class ScheduleCopier {
 
  private:
   std::unordered_map<const StmtSRefNode*, StmtSRef> old2new_;
+  /*! \brief The copies of the dependencies, shared between the maps of a scope */
+  std::unordered_map<const DependencyNode*, Dependency> dep2new_;
 };
 
 void ConcreteScheduleNode::WorkOn(const String& func_name) {
@@ -560,6 +570,15 @@ void ConcreteScheduleNode::Unroll(const LoopRV& loop_rv) {
   TVM_TIR_SCHEDULE_END("unroll", this->error_render_level_);
 }
 
+LoopRV ConcreteScheduleNode::UnrollAndJam(const LoopRV& loop_rv, int factor) {
+  LoopRV result{nullptr};
+  TVM_TIR_SCHEDULE_BEGIN();
+  result = CreateRV<LoopRV>(tir::UnrollAndJam(state_, this->GetSRef(loop_rv), factor));
+  TVM_TIR_SCHEDULE_END("unroll-and-jam", this->error_render_level_);
+  this->state_->DebugVerify();
+  return result;
+}
+
 /******** Schedule: Insert cache stages ********/
 
 BlockRV ConcreteScheduleNode::CacheRead(const BlockRV& block_rv, int read_buffer_index,
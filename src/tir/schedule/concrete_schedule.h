@@ -115,6 +115,7 @@ class ConcreteScheduleNode : public ScheduleNode {
   void Vectorize(const LoopRV& loop_rv) override;
   void Bind(const LoopRV& loop_rv, const String& thread_axis) override;
   void Unroll(const LoopRV& loop_rv) override;
+  LoopRV UnrollAndJam(const LoopRV& loop_rv, int factor) override;
   /******** Schedule: Insert cache stages ********/
   BlockRV CacheRead(const BlockRV& block_rv, int read_buffer_index, const String& storage_scope,
                     const Array<BlockRV> consumer_blocks = {}) override;
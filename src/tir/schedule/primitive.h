@@ -272,6 +272,18 @@ TVM_DLL void Bind(ScheduleState self, const StmtSRef& loop_sref, const IterVar&
  * \param loop_sref The loop to be unrolled
  */
 TVM_DLL void Unroll(ScheduleState self, const StmtSRef& loop_sref);
+/*!
+ * \brief Unroll the input loop by a factor and jam the copies into the loops nested below it.
+ * The loop is split into an outer loop and an inner loop of the factor, the inner loop is moved
+ * below the single-branch loop nest under the loop, and unrolled. It requires:
+ * 1) The factor is positive.
+ * 2) The requirements of Split on the loop and of Reorder on the loop nest.
+ * \param self The state of the schedule
+ * \param loop_sref The loop to be unrolled and jammed
+ * \param factor The number of copies of the loop body jammed together
+ * \return The outer loop after the split
+ */
+TVM_DLL StmtSRef UnrollAndJam(ScheduleState self, const StmtSRef& loop_sref, int factor);
 /******** Schedule: Insert cache stages ********/
 /*!
  * \brief Create a block that reads a buffer region into a read cache. It requires:
@@ -412,7 +424,8 @@ TVM_DLL void ComputeAt(ScheduleState self, const StmtSRef& block_sref, const Stm
  * 3) The subtree of the scope block, where the given block is in, satisfies the compact dataflow
  * condition. i.e. all the blocks in the scope block's subtree must be either complete block or
  * reduction block
- * 4) All the producers of the block are under the given loop
+ * 4) The producers of the block are under the given loop, except for those completed before it in
+ * the scope, and at least one of them is under the loop
  *
  * \param self The schedule state
  * \param block_sref The block to be moved
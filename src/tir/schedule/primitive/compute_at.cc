@@ -181,6 +181,76 @@ int FindInsertionPoint(const ScheduleState& self, const Array<Stmt>& subtrees,
   return insert_position;
 }
 
+/*!
+ * \brief Check whether a block outside a loop is completed before the loop starts, and stays so
+ * after another block in the same scope is moved under the loop
+ * \param block_sref The block outside the loop
+ * \param loop_sref The loop
+ * \param moved_block_sref The block to be moved under the loop
+ * \return Whether the block precedes the loop under their lowest common ancestor, which is also an
+ * ancestor of the block to be moved
+ */
+bool IsCompletedBeforeLoop(const StmtSRef& block_sref, const StmtSRef& loop_sref,
+                           const StmtSRef& moved_block_sref) {
+  // Maps each ancestor of `block_sref` to its child on the path to `block_sref`
+  std::unordered_map<const StmtSRefNode*, const StmtSRefNode*> block_path;
+  for (const StmtSRefNode* child = block_sref.get(); child->parent != nullptr;
+       child = child->parent) {
+    block_path.emplace(child->parent, child);
+  }
+  for (const StmtSRefNode* child = loop_sref.get(); child->parent != nullptr;
+       child = child->parent) {
+    const StmtSRefNode* lca = child->parent;
+    auto it = block_path.find(lca);
+    if (it == block_path.end()) {
+      continue;
+    }
+    // The moved block must already iterate with `lca`, or the block would have been completed
+    // only for the current iteration of it.
+    bool encloses_moved_block = false;
+    for (const StmtSRefNode* p = moved_block_sref->parent; p != nullptr; p = p->parent) {
+      if (p == lca) {
+        encloses_moved_block = true;
+        break;
+      }
+    }
+    return encloses_moved_block && it->second->seq_index >= 0 &&
+           it->second->seq_index < child->seq_index;
+  }
+  return false;
+}
+
+/*!
+ * \brief Remove the producers that are completed before the loop, whose results are fully
+ * available to a consumer moved under the loop by reverse-compute-at. It allows a consumer of
+ * several producers, e.g. the normalization after the reductions of a softmax or a layer norm, to
+ * be fused into the loop of the last of them.
+ * \param producer_srefs The producers of the block
+ * \param loop_sref The loop the block is moved under
+ * \param block_sref The block to be moved
+ * \return The producers under or after the loop, or all the producers if none is under the loop
+ */
+Array<StmtSRef> RemoveProducersCompletedBeforeLoop(const Array<StmtSRef>& producer_srefs,
+                                                   const StmtSRef& loop_sref,
+                                                   const StmtSRef& block_sref) {
+  Array<StmtSRef> result;
+  bool any_under_loop = false;
+  for (const StmtSRef& producer_sref : producer_srefs) {
+    bool under_loop = false;
+    for (const StmtSRefNode* p = producer_sref->parent; p != nullptr; p = p->parent) {
+      if (p == loop_sref.get()) {
+        under_loop = true;
+        break;
+      }
+    }
+    any_under_loop |= under_loop;
+    if (under_loop || !IsCompletedBeforeLoop(producer_sref, loop_sref, block_sref)) {
+      result.push_back(producer_sref);
+    }
+  }
+  return any_under_loop ? result : producer_srefs;
+}
+
 /*!
  * \brief Represent the iteration domain to fully cover the required region of Intersect(dom, bound)
  * The bound region may not get directly intersected with dom region, instead we try to generate
@@ -680,6 +750,9 @@ void ComputeAtOrReverseComputeAtImpl(ScheduleState self, const StmtSRef& block_s
   // Check condition 4): `block` is not an output block
   if (is_compute_at) {
     CheckNotOutputBlock(self, block_sref, scope_root_sref);
+  } else {
+    // The producers completed before `loop` are not required to be under it
+    producer_srefs = RemoveProducersCompletedBeforeLoop(producer_srefs, loop_sref, block_sref);
   }
   // Step 2. Plan for the removal of `block`
   ScopeReconstructor reconstructor(scope_root, GetRef<Block>(block), GetRef<For>(loop));
@@ -195,6 +195,58 @@ void Unroll(ScheduleState self, const StmtSRef& loop_sref) {
   self->Replace(loop_sref, For(new_loop), {});
 }
 
+class NonPositiveUnrollFactorError : public ScheduleError {
+ public:
+  explicit NonPositiveUnrollFactorError(IRModule mod, For loop, int factor)
+      : mod_(std::move(mod)), loop_(std::move(loop)), factor_(factor) {}
+
+  String FastErrorString() const final {
+    return "ScheduleError: The unroll-and-jam factor is not positive";
+  }
+
+  String DetailRenderTemplate() const final {
+    std::ostringstream os;
+    os << "The unroll-and-jam factor of loop {0} is expected to be positive, but gets " << factor_;
+    return os.str();
+  }
+
+  IRModule mod() const final { return mod_; }
+  Array<ObjectRef> LocationsOfInterest() const final { return {loop_}; }
+
+  IRModule mod_;
+  For loop_;
+  int factor_;
+};
+
+StmtSRef UnrollAndJam(ScheduleState self, const StmtSRef& loop_sref, int factor) {
+  const ForNode* loop = TVM_SREF_TO_FOR(loop_sref);
+  if (factor <= 0) {
+    throw NonPositiveUnrollFactorError(self->mod, GetRef<For>(loop), factor);
+  }
+  // Step 1. Split the loop into `ceildiv(extent, factor)` and `factor`
+  arith::Analyzer analyzer;
+  PrimExpr copies = make_const(loop->extent.dtype(), factor);
+  PrimExpr outer_extent = analyzer.Simplify(floordiv(loop->extent + copies - 1, copies));
+  Array<StmtSRef> split = Split(self, loop_sref, {outer_extent, copies},
+                                /*preserve_unit_iters=*/true);
+  StmtSRef outer_sref = split[0];
+  StmtSRef inner_sref = split[1];
+  // Step 2. Jam the copies, i.e. move the inner loop below the single-branch loop nest under it,
+  // so that each iteration of the innermost loop runs `factor` copies of the body
+  Array<StmtSRef> ordered_loop_srefs;
+  for (const ForNode* l = TVM_SREF_TO_FOR(inner_sref); const auto* child = l->body.as<ForNode>();
+       l = child) {
+    ordered_loop_srefs.push_back(self->stmt2ref.at(child));
+  }
+  if (!ordered_loop_srefs.empty()) {
+    ordered_loop_srefs.push_back(inner_sref);
+    Reorder(self, ordered_loop_srefs);
+  }
+  // Step 3. Unroll the copies
+  Unroll(self, inner_sref);
+  return outer_sref;
+}
+
 /******** InstructionKind Registration ********/
 
 struct ParallelTraits : public UnpackedInstTraits<ParallelTraits> {
@@ -288,10 +340,36 @@ struct UnrollTraits : public UnpackedInstTraits<UnrollTraits> {
   friend struct ::tvm::tir::UnpackedInstTraits;
 };
 
+struct UnrollAndJamTraits : public UnpackedInstTraits<UnrollAndJamTraits> {
+  static constexpr const char* kName = "UnrollAndJam";
+  static constexpr bool kIsPure = false;
+
+ private:
+  static constexpr size_t kNumInputs = 1;
+  static constexpr size_t kNumAttrs = 1;
+  static constexpr size_t kNumDecisions = 0;
+
+  static LoopRV UnpackedApplyToSchedule(Schedule sch, LoopRV loop_rv, Integer factor) {
+    return sch->UnrollAndJam(loop_rv, factor->value);
+  }
+
+  static String UnpackedAsPython(Array<String> outputs, String loop_rv, Integer factor) {
+    PythonAPICall py("unroll_and_jam");
+    py.Input("loop", loop_rv);
+    py.Input("factor", factor);
+    py.SingleOutput(outputs);
+    return py.Str();
+  }
+
+  template <typename>
+  friend struct ::tvm::tir::UnpackedInstTraits;
+};
+
 TVM_REGISTER_INST_KIND_TRAITS(ParallelTraits);
 TVM_REGISTER_INST_KIND_TRAITS(VectorizeTraits);
 TVM_REGISTER_INST_KIND_TRAITS(BindTraits);
 TVM_REGISTER_INST_KIND_TRAITS(UnrollTraits);
+TVM_REGISTER_INST_KIND_TRAITS(UnrollAndJamTraits);
 
 }  // namespace tir
 }  // namespace tvm
@@ -183,6 +183,8 @@ TVM_REGISTER_GLOBAL("tir.schedule.ScheduleVectorize")
     .set_body_method<Schedule>(&ScheduleNode::Vectorize);
 TVM_REGISTER_GLOBAL("tir.schedule.ScheduleBind").set_body_method<Schedule>(&ScheduleNode::Bind);
 TVM_REGISTER_GLOBAL("tir.schedule.ScheduleUnroll").set_body_method<Schedule>(&ScheduleNode::Unroll);
+TVM_REGISTER_GLOBAL("tir.schedule.ScheduleUnrollAndJam")
+    .set_body_method<Schedule>(&ScheduleNode::UnrollAndJam);
 /******** (FFI) Insert cache stages ********/
 TVM_REGISTER_GLOBAL("tir.schedule.ScheduleCacheRead")
     .set_body_method<Schedule>(&ScheduleNode::CacheRead);
@@ -311,6 +311,17 @@ void TracedScheduleNode::Unroll(const LoopRV& loop_rv) {
                                       /*outputs=*/{}));
 }
 
+LoopRV TracedScheduleNode::UnrollAndJam(const LoopRV& loop_rv, int factor) {
+  LoopRV result = ConcreteScheduleNode::UnrollAndJam(loop_rv, factor);
+
+  static const InstructionKind& kind = InstructionKind::Get("UnrollAndJam");
+  trace_->Append(/*inst=*/Instruction(/*kind=*/kind,
+                                      /*inputs=*/{loop_rv},
+                                      /*attrs=*/{Integer(factor)},
+                                      /*outputs=*/{result}));
+  return result;
+}
+
 /******** Schedule: Insert cache stages ********/
 BlockRV TracedScheduleNode::CacheRead(const BlockRV& block_rv, int read_buffer_index,
                                       const String& storage_scope,
@@ -74,6 +74,7 @@ class TracedScheduleNode : public ConcreteScheduleNode {
   void Vectorize(const LoopRV& loop_rv) final;
   void Bind(const LoopRV& loop_rv, const String& thread_axis) final;
   void Unroll(const LoopRV& loop_rv) final;
+  LoopRV UnrollAndJam(const LoopRV& loop_rv, int factor) final;
   /******** Schedule: Insert cache stages ********/
   BlockRV CacheRead(const BlockRV& block_rv, int read_buffer_index, const String& storage_scope,
                     const Array<BlockRV> consumer_blocks = {}) final;
@@ -104,6 +104,18 @@ class BF16ComputeLegalizePlanner : public StmtExprVisitor {
     }
   }
 
+  void VisitExpr_(const CallNode* op) final {
+    StmtExprVisitor::VisitExpr_(op);
+    // The bits of a bf16 buffer reinterpreted as another type, e.g. the operands of the native
+    // bf16 dot products, must stay bf16, so do not remap the buffer to f32.
+    if (op->op.same_as(builtin::reinterpret()) && op->args.size() == 1 &&
+        op->args[0].dtype().is_bfloat16()) {
+      if (const auto* load = op->args[0].as<BufferLoadNode>()) {
+        opaque_var_access_.insert(load->buffer->data);
+      }
+    }
+  }
+
  private:
   void PopulateBufferRemap(Buffer buf) {
     auto var_it = var_remap_->find(buf->data);
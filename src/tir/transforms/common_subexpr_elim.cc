@@ -120,39 +120,19 @@ bool CommonSubexpressionEliminator::CanContainEligibleComputations(const PrimExp
 }
 
 /*!
- * \brief Implements an order on pairs (expression,frequency). First attempts to compare them
-          using the size of the expression. If it is the same, decides something else still
-          deterministic.
- * \param a The first pair
- * \param b The second pair
- * \return A boolean telling if the first pair `a` comes before the second pair `b`
- * \note We need this order to be deterministic in order to have a fully deterministic pass,
- *       as we will deal with elements that are coming from a hashtable, but the order in which
- *       they appeared in the hashtable was based on some runtime addresses, so it can potentially
- *       change with every execution.
+ * \brief Gives the normal form of the value of a variable of the context, which is computed once
+          for all the computations it is compared with.
+ * \param value The value of a variable of the context
+ * \return The normal form of `value`
  */
-bool CommonSubexpressionEliminator::OrderOnExprAndFrequency(std::pair<PrimExpr, size_t> a,
-                                                            std::pair<PrimExpr, size_t> b) {
-  size_t a_size = CalculateExprComplexity(a.first);
-  size_t b_size = CalculateExprComplexity(b.first);
-
-  // Criteria 1 - Size of the expression comes first
-  // `a` comes before `b` if the size of `a` is bigger
-  if (a_size > b_size) {
-    return true;
+const PrimExpr& CommonSubexpressionEliminator::NormalFormOfContextValue(const PrimExpr& value) {
+  auto it = normal_forms_of_context_values_.find(value);
+  if (it == normal_forms_of_context_values_.end()) {
+    it = normal_forms_of_context_values_
+             .emplace(value, NormalizeTerm(value, identify_equiv_terms_))
+             .first;
   }
-  // `a` does NOT come before `b` if the size of `b` is bigger
-  if (b_size > a_size) {
-    return false;
-  }
-
-  // Criteria 2 - If they had the same size, use the lexicographic order as a last resort
-  // as we need a deterministic order
-  std::stringstream a_stream;
-  std::stringstream b_stream;
-  a_stream << AsLegacyRepr(a.first);
-  b_stream << AsLegacyRepr(b.first);
-  return (a_stream.str().compare(b_stream.str()) < 0);
+  return it->second;
 }
 
 /*!
@@ -237,29 +217,29 @@ PrimExpr CommonSubexpressionEliminator::VisitExpr(const PrimExpr& expr) {
 
   // Transform the hashtable of *syntactic* eligible computations into a vector of pairs
   // containing *semantic* entities, i.e. where equivalent computations are merged.
-  std::vector<std::pair<PrimExpr, size_t>> semantic_comp_done_by_expr =
-      SyntacticToSemanticComputations(table_syntactic_comp_done_by_expr, identify_equiv_terms_);
-
-  // Sort the vector of semantic entities by decreasing size
-  std::sort(semantic_comp_done_by_expr.begin(), semantic_comp_done_by_expr.end(),
-            OrderOnExprAndFrequency);
+  // These are sorted by decreasing size.
+  SortedSemanticComputations semantic_comp_done_by_expr(
+      SyntacticToSemanticComputations(table_syntactic_comp_done_by_expr, identify_equiv_terms_),
+      identify_equiv_terms_);
 
   // For each computation done (considering them from biggest to smallest)
   for (size_t i = 0; i < semantic_comp_done_by_expr.size(); i++) {
-    std::pair<PrimExpr, size_t>& computation_and_nb = semantic_comp_done_by_expr[i];
+    std::pair<PrimExpr, size_t> computation_and_nb = semantic_comp_done_by_expr[i];
+    // The normal form of the computation, computed once for all the comparisons below
+    PrimExpr normal_form = semantic_comp_done_by_expr.NormalForm(i);
 
     bool ident_equiv_terms = identify_equiv_terms_;  // To avoid the capture of "this"
 
     // The predicate later used (when doing replacements) to select expressions that are
     // equivalent to the current computation (`computation_and_nb.first`)
     std::function<bool(const PrimExpr&)> predicate_selector =
-        [computation_and_nb, ident_equiv_terms](const PrimExpr& current_expr) {
+        [normal_form, ident_equiv_terms](const PrimExpr& current_expr) {
           // `current_expr` should be equivalent to `computation_and_nb.first`, but we also check
           // that `current_expr` is an eligible computation even if we know that
           // `computation_and_nb.first` is eligible by construction, in case that one day the
           // equivalence relation would not preserve the eligibility any more (even though that
           // would probably be a very weird equivalence).
-          return (EquivalentTerms(current_expr, computation_and_nb.first, ident_equiv_terms) &&
+          return (EqualTerms(NormalizeTerm(current_expr, ident_equiv_terms), normal_form) &&
                   IsEligibleComputation(current_expr));
         };
 
@@ -267,11 +247,10 @@ PrimExpr CommonSubexpressionEliminator::VisitExpr(const PrimExpr& expr) {
     // equivalent to `computation_and_nb.first`
     auto it_on_var = std::find_if(
         context_.begin(), context_.end(),
-        [computation_and_nb, ident_equiv_terms](const std::pair<Var, MaybeValue>& var_and_value) {
+        [this, &normal_form](const std::pair<Var, MaybeValue>& var_and_value) {
           // Note : safe to call value() as we check has_value() just before
           return (var_and_value.second.has_value() &&
-                  EquivalentTerms(var_and_value.second.value(), computation_and_nb.first,
-                                  ident_equiv_terms));
+                  EqualTerms(NormalFormOfContextValue(var_and_value.second.value()), normal_form));
         });
 
     // Case where we have a perfectly equivalent computation already available in a variable
@@ -337,8 +316,7 @@ PrimExpr CommonSubexpressionEliminator::VisitExpr(const PrimExpr& expr) {
         // The following insertion will maintain `semantic_comp_done_by_expr` sorted (by
         // decreasing size/complexity), and it will only insert at locations > i as the
         // direct subexprs are necessarily smaller than the current computation.
-        InsertVectorToSortedSemanticComputations(&semantic_comp_done_by_expr, direct_subexprs,
-                                                 identify_equiv_terms_);
+        semantic_comp_done_by_expr.Insert(direct_subexprs);
       }
     }
     // Note : we do not remove the current element, as we never look back in the local vector
@@ -417,29 +395,29 @@ Stmt CommonSubexpressionEliminator::VisitStmt(const Stmt& stmt) {
 
   // Transform the hashtable of *syntactic* eligible computations into a vector of pairs
   // containing *semantic* entities, i.e. where equivalent computations are merged.
-  std::vector<std::pair<PrimExpr, size_t>> semantic_comp_done_by_stmt =
-      SyntacticToSemanticComputations(table_syntactic_comp_done_by_stmt, identify_equiv_terms_);
-
-  // Sort the vector of semantic entities by decreasing size
-  std::sort(semantic_comp_done_by_stmt.begin(), semantic_comp_done_by_stmt.end(),
-            OrderOnExprAndFrequency);
+  // These are sorted by decreasing size.
+  SortedSemanticComputations semantic_comp_done_by_stmt(
+      SyntacticToSemanticComputations(table_syntactic_comp_done_by_stmt, identify_equiv_terms_),
+      identify_equiv_terms_);
 
   // For each computation done (considering them from biggest to smallest)
   for (size_t i = 0; i < semantic_comp_done_by_stmt.size(); i++) {
-    std::pair<PrimExpr, size_t>& computation_and_nb = semantic_comp_done_by_stmt[i];
+    std::pair<PrimExpr, size_t> computation_and_nb = semantic_comp_done_by_stmt[i];
+    // The normal form of the computation, computed once for all the comparisons below
+    PrimExpr normal_form = semantic_comp_done_by_stmt.NormalForm(i);
 
     bool ident_equiv_terms = identify_equiv_terms_;  // To avoid the capture of "this"
 
     // The predicate later used (when doing replacements) to select expressions that are
     // equivalent to the current computation (`computation_and_nb.first`)
     std::function<bool(const PrimExpr&)> predicate_selector =
-        [computation_and_nb, ident_equiv_terms](const PrimExpr& current_expr) {
+        [normal_form, ident_equiv_terms](const PrimExpr& current_expr) {
           // `current_expr` should be equivalent to `computation_and_nb.first`, but we also check
           // that `current_expr` is an eligible computation even if we know that
           // `computation_and_nb.first` is eligible by construction, in case that one day the
           // equivalence relation would not preserve the eligibility any more (even though that
           // would probably be a very weird equivalence).
-          return (EquivalentTerms(current_expr, computation_and_nb.first, ident_equiv_terms) &&
+          return (EqualTerms(NormalizeTerm(current_expr, ident_equiv_terms), normal_form) &&
                   IsEligibleComputation(current_expr));
         };
 
@@ -447,11 +425,10 @@ Stmt CommonSubexpressionEliminator::VisitStmt(const Stmt& stmt) {
     // equivalent to `computation_and_nb.first`
     auto it_on_var = std::find_if(
         context_.begin(), context_.end(),
-        [computation_and_nb, ident_equiv_terms](const std::pair<Var, MaybeValue>& var_and_value) {
+        [this, &normal_form](const std::pair<Var, MaybeValue>& var_and_value) {
           // Note : safe to call value() as we check has_value() just before
           return (var_and_value.second.has_value() &&
-                  EquivalentTerms(var_and_value.second.value(), computation_and_nb.first,
-                                  ident_equiv_terms));
+                  EqualTerms(NormalFormOfContextValue(var_and_value.second.value()), normal_form));
         });
 
     // Case where we have a perfectly equivalent computation already available in a variable
@@ -518,8 +495,7 @@ Stmt CommonSubexpressionEliminator::VisitStmt(const Stmt& stmt) {
         // The following insertion will maintain `semantic_comp_done_by_stmt` sorted (by
         // decreasing size/complexity), and it will only insert at locations > i as the
         // direct subexprs are necessarily smaller than the current computation.
-        InsertVectorToSortedSemanticComputations(&semantic_comp_done_by_stmt, direct_subexprs,
-                                                 identify_equiv_terms_);
+        semantic_comp_done_by_stmt.Insert(direct_subexprs);
       }
     }
     // Note : we do not remove the current element, as we never look back in the local vector
@@ -651,7 +627,7 @@ Pass CommonSubexprElimTIR(bool enable_cse_tir, bool identify_equiv_terms) {
 
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.CommonSubexprElimTIR", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.CommonSubexprElimTIR", {}, /*function_local=*/true);
 }
 
 // The pass can now be invoked via the pass infrastructure, but we also add a Python binding for it
@@ -34,6 +34,7 @@
 #include <tvm/tir/stmt_functor.h>  // For the class StmtExprMutator
 #include <tvm/tir/var.h>
 
+#include <unordered_map>
 #include <utility>  // For std::pair
 #include <vector>
 
@@ -79,11 +80,14 @@ class CommonSubexpressionEliminator : public StmtExprMutator {
   int nb_var_ = 0;        // Number of variables introduced by the CSE pass
 
   bool identify_equiv_terms_ = false;
+  // Normal forms of the values of the context, keyed by the values
+  std::unordered_map<PrimExpr, PrimExpr, ObjectPtrHash, ObjectPtrEqual>
+      normal_forms_of_context_values_;
 
   static bool ForbiddenComputation(const PrimExpr& expr);
   static bool IsEligibleComputation(const PrimExpr& expr);
   static bool CanContainEligibleComputations(const PrimExpr& expr);
-  static bool OrderOnExprAndFrequency(std::pair<PrimExpr, size_t> a, std::pair<PrimExpr, size_t> b);
+  const PrimExpr& NormalFormOfContextValue(const PrimExpr& value);
   Var GenerateNewVar(DataType type_annotation);
 };
 
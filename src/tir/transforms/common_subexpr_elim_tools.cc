@@ -37,6 +37,7 @@
 #include <tvm/tir/transform.h>  // For the declaration of the pass
 
 #include <algorithm>      // For std::find_if
+#include <string>
 #include <unordered_map>  // For the hashtable datatype
 #include <utility>
 #include <vector>
@@ -810,19 +811,23 @@ std::vector<std::pair<PrimExpr, size_t>> SyntacticToSemanticComputations(
   // iterating through its items soon, and the order of appearance will be used to determine the
   // individual representant for each class of equivalence, which we want to be deterministic
   // (otherwise {x+y, y+x} could be both replaced by x+y, and on another run by y+x).
-  std::vector<std::pair<PrimExpr, size_t>> sorted_items_of_table(table.begin(), table.end());
-
-  // We do the ordering by comparing the string repr of each expr to get a determinstic ordering
+  // We do the ordering by comparing the string repr of each expr to get a determinstic ordering.
+  // The repr of each expr is computed once, rather than at each comparison.
+  std::vector<std::pair<std::string, std::pair<PrimExpr, size_t>>> sorted_items_of_table;
+  sorted_items_of_table.reserve(table.size());
+  for (const auto& elem : table) {
+    std::stringstream stream;
+    stream << AsLegacyRepr(elem.first);
+    sorted_items_of_table.emplace_back(stream.str(), elem);
+  }
   sort(sorted_items_of_table.begin(), sorted_items_of_table.end(),
-       [](std::pair<PrimExpr, size_t> a, std::pair<PrimExpr, size_t> b) {
-         std::stringstream a_stream;
-         std::stringstream b_stream;
-         a_stream << AsLegacyRepr(a.first);
-         b_stream << AsLegacyRepr(b.first);
-         return a_stream.str().compare(b_stream.str()) < 0;
+       [](const std::pair<std::string, std::pair<PrimExpr, size_t>>& a,
+          const std::pair<std::string, std::pair<PrimExpr, size_t>>& b) {
+         return a.first.compare(b.first) < 0;
        });
 
-  for (const auto& elem : sorted_items_of_table) {
+  for (const auto& repr_and_elem : sorted_items_of_table) {
+    const std::pair<PrimExpr, size_t>& elem = repr_and_elem.second;
     PrimExpr norm_elem = NormalizeTerm(elem.first, identify_equiv_terms);
     // If the normalized term is not already a key in the normalized table
     auto it_found = norm_table.find(norm_elem);
@@ -926,5 +931,65 @@ void InsertVectorToSortedSemanticComputations(std::vector<std::pair<PrimExpr, si
   }
 }
 
+/*!
+ * \brief Sorts semantic computations by decreasing size, and in the lexicographic order of their
+          repr for the ones of the same size, as we need a deterministic order. The size and the
+          repr of each computation are computed once, rather than at each comparison.
+ */
+SortedSemanticComputations::SortedSemanticComputations(
+    const std::vector<std::pair<PrimExpr, size_t>>& computations, bool identify_equiv_terms)
+    : identify_equiv_terms_(identify_equiv_terms) {
+  std::vector<std::pair<std::string, Entry>> entries_and_reprs;
+  entries_and_reprs.reserve(computations.size());
+  counts_.reserve(computations.size());
+  for (const auto& computation : computations) {
+    std::stringstream stream;
+    stream << AsLegacyRepr(computation.first);
+    PrimExpr normal_form = NormalizeTerm(computation.first, identify_equiv_terms);
+    counts_[normal_form] += computation.second;
+    entries_and_reprs.emplace_back(
+        stream.str(),
+        Entry{computation.first, normal_form, CalculateExprComplexity(computation.first)});
+  }
+  std::sort(entries_and_reprs.begin(), entries_and_reprs.end(),
+            [](const std::pair<std::string, Entry>& a, const std::pair<std::string, Entry>& b) {
+              if (a.second.complexity != b.second.complexity) {
+                return a.second.complexity > b.second.complexity;
+              }
+              return a.first.compare(b.first) < 0;
+            });
+  entries_.reserve(entries_and_reprs.size());
+  for (auto& entry_and_repr : entries_and_reprs) {
+    entries_.push_back(std::move(entry_and_repr.second));
+  }
+}
+
+std::pair<PrimExpr, size_t> SortedSemanticComputations::operator[](size_t i) const {
+  return {entries_[i].expr, counts_.at(entries_[i].normal_form)};
+}
+
+/*!
+ * \brief Adds computations to the sorted semantic computations, in the same way as
+          InsertVectorToSortedSemanticComputations(): a computation that is new is inserted before
+          the first computation that is strictly smaller.
+ */
+void SortedSemanticComputations::Insert(const std::vector<PrimExpr>& exprs,
+                                        size_t increase_count) {
+  for (const PrimExpr& expr : exprs) {
+    PrimExpr normal_form = NormalizeTerm(expr, identify_equiv_terms_);
+    auto it_found = counts_.find(normal_form);
+    if (it_found != counts_.end()) {
+      it_found->second += increase_count;
+      continue;
+    }
+    counts_[normal_form] = increase_count;
+    size_t complexity = CalculateExprComplexity(expr);
+    auto insertion_point =
+        std::lower_bound(entries_.begin(), entries_.end(), complexity,
+                         [](const Entry& entry, size_t size) { return entry.complexity >= size; });
+    entries_.insert(insertion_point, Entry{expr, normal_form, complexity});
+  }
+}
+
 }  // namespace tir
 }  // namespace tvm
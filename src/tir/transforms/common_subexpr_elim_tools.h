@@ -187,6 +187,51 @@ std::vector<std::pair<PrimExpr, size_t>> SyntacticToSemanticComputations(
     const ComputationTable& table, bool identify_equiv_terms);
 bool PredicateIntroVarForComputation(const PrimExpr& computation, size_t nb_times_seen);
 
+/*!
+ * \brief Semantic computations sorted by decreasing size, whose counts are hash-consed on the
+          normal form of the computations. Adding a computation looks its equivalence class up in
+          the table, instead of comparing it with every computation already known, and the size and
+          the normal form of each computation are computed only once.
+ */
+class SortedSemanticComputations {
+ public:
+  /*!
+   * \brief Sort semantic computations, where equivalent computations are already merged.
+   * \param computations The computations and the number of times each one is seen
+   * \param identify_equiv_terms Whether equivalent terms are identified
+   */
+  SortedSemanticComputations(const std::vector<std::pair<PrimExpr, size_t>>& computations,
+                             bool identify_equiv_terms);
+
+  /*! \brief The number of computations */
+  size_t size() const { return entries_.size(); }
+  /*! \brief The i-th computation, and the number of times it is seen */
+  std::pair<PrimExpr, size_t> operator[](size_t i) const;
+  /*! \brief The normal form of the i-th computation */
+  const PrimExpr& NormalForm(size_t i) const { return entries_[i].normal_form; }
+
+  /*!
+   * \brief Add computations, keeping the computations sorted. The count of a computation that is
+            equivalent to a known one is added to the count of the known one.
+   * \param exprs The computations to add
+   * \param increase_count The number of times each computation is seen
+   */
+  void Insert(const std::vector<PrimExpr>& exprs, size_t increase_count = 1);
+
+ private:
+  struct Entry {
+    PrimExpr expr;
+    PrimExpr normal_form;
+    size_t complexity;
+  };
+
+  // The computations, sorted by decreasing complexity
+  std::vector<Entry> entries_;
+  // The number of times each class of equivalent computations is seen, keyed by normal form
+  std::unordered_map<PrimExpr, size_t, StructuralHash, ExprDeepEqual> counts_;
+  bool identify_equiv_terms_;
+};
+
 // Polymorphic (functional) map on a vector, which builds a news vector with the same number of
 // elements, where each element is the application of a given function on the corresponding element
 // in the input vector.
@@ -605,7 +605,8 @@ Pass CompactBufferAllocation() {
   auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
     return CompactBufferAllocation(std::move(f));
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.CompactBufferAllocation", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.CompactBufferAllocation", {},
+                            /*function_local=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.CompactBufferAllocation")
@@ -124,7 +124,7 @@ Pass ConvertBlocksToOpaque() {
   auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
     return ConvertBlocksToOpaque(std::move(f));
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.ConvertBlocksToOpaque", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.ConvertBlocksToOpaque", {}, /*function_local=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.ConvertBlocksToOpaque").set_body_typed(ConvertBlocksToOpaque);
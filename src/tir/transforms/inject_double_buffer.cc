@@ -310,7 +310,7 @@ Pass InjectDoubleBuffer() {
     n->body = DoubleBufferInjector(cfg.value()->split_loop).Inject(std::move(n->body));
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.InjectDoubleBuffer", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.InjectDoubleBuffer", {}, /*function_local=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.InjectDoubleBuffer").set_body_typed(InjectDoubleBuffer);
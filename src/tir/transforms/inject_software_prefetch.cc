@@ -0,0 +1,254 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file inject_software_prefetch.cc
+ * \brief Prefetch the strided and gathered loads of the annotated loops ahead of their use.
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "./ir_utils.h"
+
+namespace tvm {
+namespace tir {
+
+/*! \brief The size of a cache line. The hardware prefetcher follows the shorter strides. */
+constexpr int64_t kCacheLineBytes = 64;
+/*! \brief The estimated latency of a load missing the cache, in cycles. */
+constexpr int64_t kMemoryLatencyCycles = 300;
+/*! \brief The maximum prefetch distance, in iterations. */
+constexpr int64_t kMaxPrefetchDistance = 64;
+
+bool IsIrregularAccess(const Buffer& buffer, const Array<PrimExpr>& indices, const Var& var,
+                       arith::Analyzer* analyzer) {
+  auto f_uses_var = [&var](const VarNode* v) { return v == var.get(); };
+  bool uses_var = false;
+  bool gathered = false;
+  for (const PrimExpr& index : indices) {
+    uses_var = uses_var || UsesVar(index, f_uses_var);
+    PostOrderVisit(index, [&](const ObjectRef& obj) {
+      if (const auto* load = obj.as<BufferLoadNode>()) {
+        for (const PrimExpr& load_index : load->indices) {
+          gathered = gathered || UsesVar(load_index, f_uses_var);
+        }
+      }
+    });
+  }
+  if (!uses_var || gathered) {
+    return gathered;
+  }
+  Array<PrimExpr> offset = buffer.OffsetOf(indices);
+  if (offset.size() != 1) {
+    return false;
+  }
+  Array<PrimExpr> next_indices = Substitute(indices, {{var, var + 1}});
+  PrimExpr stride = analyzer->Simplify(buffer.OffsetOf(next_indices)[0] - offset[0]);
+  const auto* stride_imm = stride.as<IntImmNode>();
+  return !stride_imm || std::abs(stride_imm->value) * buffer->dtype.bytes() >= kCacheLineBytes;
+}
+
+namespace {
+
+/*!
+ * \brief Estimate the cycles of one iteration of a loop, counting one cycle per expression and
+ * multiplying by the constant extents of the inner loops.
+ */
+class IterationCycleEstimator : public StmtExprVisitor {
+ public:
+  static int64_t Estimate(const Stmt& body) {
+    IterationCycleEstimator estimator;
+    estimator(body);
+    return std::max<int64_t>(estimator.cycles_, 1);
+  }
+
+ private:
+  void VisitExpr(const PrimExpr& expr) final {
+    cycles_ = std::min(cycles_ + scale_, kMemoryLatencyCycles);
+    StmtExprVisitor::VisitExpr(expr);
+  }
+
+  void VisitStmt_(const ForNode* op) final {
+    int64_t scale = scale_;
+    if (const int64_t* extent = as_const_int(op->extent)) {
+      scale_ = std::min(scale_ * std::max<int64_t>(*extent, 1), kMemoryLatencyCycles);
+    }
+    StmtExprVisitor::VisitStmt_(op);
+    scale_ = scale;
+  }
+
+  int64_t cycles_ = 0;
+  int64_t scale_ = 1;
+};
+
+/*! \brief Collect the loads of a loop body, and the variables it defines. */
+class LoadCollector : public StmtExprVisitor {
+ public:
+  /*! \brief The loads, in the order of appearance. */
+  std::vector<const BufferLoadNode*> loads;
+  /*! \brief The loop variables of the inner loops, mapped to their minimum. */
+  Map<Var, PrimExpr> inner_loop_mins;
+  /*! \brief The other variables defined in the body. */
+  std::unordered_set<const VarNode*> bound_vars;
+
+ private:
+  void VisitExpr_(const BufferLoadNode* op) final {
+    loads.push_back(op);
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const CallNode* op) final {
+    // The loads taken the address of, e.g. by prefetches of inner loops, are not performed.
+    if (!op->op.same_as(builtin::address_of())) {
+      StmtExprVisitor::VisitExpr_(op);
+    }
+  }
+
+  void VisitExpr_(const LetNode* op) final {
+    bound_vars.insert(op->var.get());
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitStmt_(const LetStmtNode* op) final {
+    bound_vars.insert(op->var.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const ForNode* op) final {
+    inner_loop_mins.Set(op->loop_var, op->min);
+    StmtExprVisitor::VisitStmt_(op);
+  }
+};
+
+class SoftwarePrefetchInjector : public StmtExprMutator {
+ public:
+  explicit SoftwarePrefetchInjector(const PrimFunc& f) {
+    for (const auto& kv : f->buffer_map) {
+      param_buffer_vars_.insert(kv.second->data.get());
+    }
+  }
+
+ private:
+  Stmt VisitStmt_(const ForNode* op) final {
+    For loop = Downcast<For>(StmtExprMutator::VisitStmt_(op));
+    auto it = loop->annotations.find(attr::software_prefetch);
+    if (it == loop->annotations.end()) {
+      return std::move(loop);
+    }
+    const auto* distance_imm = (*it).second.as<IntImmNode>();
+    CHECK(distance_imm) << "ValueError: The annotation " << attr::software_prefetch
+                        << " of a loop must be an integer, but got " << (*it).second;
+    int64_t distance = distance_imm->value;
+    loop.CopyOnWrite()->annotations.erase(attr::software_prefetch);
+    if (loop->kind == ForKind::kVectorized || loop->kind == ForKind::kThreadBinding) {
+      return std::move(loop);
+    }
+    if (distance <= 0) {
+      int64_t cycles = IterationCycleEstimator::Estimate(loop->body);
+      distance = std::min((kMemoryLatencyCycles + cycles - 1) / cycles, kMaxPrefetchDistance);
+    }
+    if (const int64_t* extent = as_const_int(loop->extent)) {
+      distance = std::min(distance, *extent);
+    }
+    Array<Stmt> seq = MakePrefetches(loop.get(), distance);
+    if (seq.empty()) {
+      return std::move(loop);
+    }
+    seq.push_back(loop->body);
+    loop.CopyOnWrite()->body = SeqStmt(seq);
+    return std::move(loop);
+  }
+
+  /*! \brief Make the prefetches of the irregular loads `distance` iterations ahead. */
+  Array<Stmt> MakePrefetches(const ForNode* loop, int64_t distance) {
+    LoadCollector collector;
+    collector(loop->body);
+    auto f_is_bound = [&collector](const VarNode* v) { return collector.bound_vars.count(v) > 0; };
+    PrimExpr ahead = loop->loop_var + make_const(loop->loop_var.dtype(), distance);
+    std::vector<BufferLoad> prefetched;
+    Array<Stmt> prefetches;
+    for (const BufferLoadNode* load : collector.loads) {
+      if (!param_buffer_vars_.count(load->buffer->data.get()) ||
+          std::any_of(load->indices.begin(), load->indices.end(),
+                      [&](const PrimExpr& index) { return UsesVar(index, f_is_bound); })) {
+        continue;
+      }
+      // Prefetch the first element accessed by the inner loops.
+      Array<PrimExpr> indices = Substitute(load->indices, collector.inner_loop_mins);
+      if (!IsIrregularAccess(load->buffer, indices, loop->loop_var, &analyzer_)) {
+        continue;
+      }
+      BufferLoad target(load->buffer, Substitute(indices, {{loop->loop_var, ahead}}));
+      if (std::any_of(prefetched.begin(), prefetched.end(), [&](const BufferLoad& other) {
+            return StructuralEqual()(target, other);
+          })) {
+        continue;
+      }
+      prefetched.push_back(target);
+      PrimExpr address = Call(DataType::Handle(), builtin::address_of(), {target});
+      Stmt prefetch = Evaluate(Call(load->buffer->dtype, builtin::prefetch(), {address, 0, 3, 1}));
+      // The indices of a gathered load are loaded too, which must stay within the loop.
+      bool gathered = false;
+      for (const PrimExpr& index : target->indices) {
+        PostOrderVisit(index, [&gathered](const ObjectRef& obj) {
+          gathered = gathered || obj->IsInstance<BufferLoadNode>();
+        });
+      }
+      if (gathered) {
+        prefetch = IfThenElse(ahead < loop->min + loop->extent, prefetch);
+      }
+      prefetches.push_back(prefetch);
+    }
+    return prefetches;
+  }
+
+  /*! \brief The data variables of the buffers of the parameters, which live in main memory. */
+  std::unordered_set<const VarNode*> param_buffer_vars_;
+  /*! \brief The analyzer to simplify the strides. */
+  arith::Analyzer analyzer_;
+};
+
+}  // namespace
+
+namespace transform {
+
+Pass InjectSoftwarePrefetch() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    auto* n = f.CopyOnWrite();
+    n->body = SoftwarePrefetchInjector(f)(std::move(n->body));
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.InjectSoftwarePrefetch", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.InjectSoftwarePrefetch").set_body_typed(InjectSoftwarePrefetch);
+
+}  // namespace transform
+
+}  // namespace tir
+}  // namespace tvm
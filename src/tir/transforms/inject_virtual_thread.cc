@@ -524,7 +524,7 @@ Pass InjectVirtualThread() {
     n->body = ConvertSSA(std::move(n->body));
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.InjectVirtualThread", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.InjectVirtualThread", {}, /*function_local=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.InjectVirtualThread").set_body_typed(InjectVirtualThread);
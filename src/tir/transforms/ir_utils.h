@@ -311,6 +311,18 @@ std::unordered_map<const VarNode*, FragmentInfo> GetTensorCoreFragmentInfo(const
 // attr::async_wait_queue_scope annotation.
 std::pair<PrimExpr, PrimExpr> GetAsyncWaitAttributes(const AttrStmtNode* op);
 
+/*!
+ * \brief Check whether consecutive iterations of a loop access a buffer at places the hardware
+ * prefetcher does not follow, i.e. a cache line or more apart, or through loaded indices.
+ * \param buffer The buffer accessed.
+ * \param indices The indices of the access.
+ * \param var The loop variable.
+ * \param analyzer The analyzer to simplify the stride of the access.
+ * \return Whether the access is strided or gathered along the loop.
+ */
+bool IsIrregularAccess(const Buffer& buffer, const Array<PrimExpr>& indices, const Var& var,
+                       arith::Analyzer* analyzer);
+
 /*!
  * \brief Bind a subset of parameter tensors to constants, replacing them by AllocateConst nodes.
  * \param f The function to bind constants to.
@@ -44,6 +44,7 @@ struct LoopPartitionConfigNode : public tvm::AttrsNode<LoopPartitionConfigNode>
   bool partition_const_loop;
   bool no_unroll_loop_with_extent_one;
   bool unroll_loop_with_partition_hint_no_interval;
+  double max_code_growth;
 
   TVM_DECLARE_ATTRS(LoopPartitionConfigNode, "tir.transform.LoopPartitionConfig") {
     TVM_ATTR_FIELD(partition_const_loop).describe("Split constant loop").set_default(false);
@@ -53,6 +54,12 @@ struct LoopPartitionConfigNode : public tvm::AttrsNode<LoopPartitionConfigNode>
     TVM_ATTR_FIELD(unroll_loop_with_partition_hint_no_interval)
         .describe("Unroll loops with pragma_loop_partition_hint and no interval")
         .set_default(false);
+    TVM_ATTR_FIELD(max_code_growth)
+        .describe(
+            "The maximal size of the code duplicated by the partitions, relative to the size of "
+            "the function. The loops which would exceed it keep their conditions. A negative "
+            "value puts no limit")
+        .set_default(-1.0);
   }
 };
 
@@ -382,10 +389,12 @@ class ThreadPartitionInserter : public StmtMutator {
 class LoopPartitioner : public StmtMutator {
  public:
   explicit LoopPartitioner(bool partition_const_loop, bool no_unroll_loop_with_extent_one,
-                           bool unroll_loop_with_partition_hint_no_interval)
+                           bool unroll_loop_with_partition_hint_no_interval,
+                           int64_t code_growth_budget = -1)
       : selector(CandidateSelector(partition_const_loop)),
         no_unroll_loop_with_extent_one_(no_unroll_loop_with_extent_one),
-        unroll_loop_with_partition_hint_no_interval_(unroll_loop_with_partition_hint_no_interval) {}
+        unroll_loop_with_partition_hint_no_interval_(unroll_loop_with_partition_hint_no_interval),
+        code_growth_budget_(code_growth_budget) {}
 
   Stmt VisitAndMutate(Stmt stmt) {
     selector(stmt);
@@ -455,8 +464,18 @@ class LoopPartitioner : public StmtMutator {
   CandidateSelector selector;
   bool no_unroll_loop_with_extent_one_;
   bool unroll_loop_with_partition_hint_no_interval_;
+  /*! \brief The size of the code the partitions may still duplicate, negative for no limit. */
+  int64_t code_growth_budget_;
 };
 
+/*! \brief The number of distinct nodes of a statement, as an estimate of its code size. */
+int64_t StmtSize(const Stmt& stmt) {
+  if (!stmt.defined()) return 0;
+  int64_t size = 0;
+  PostOrderVisit(stmt, [&size](const ObjectRef&) { ++size; });
+  return size;
+}
+
 // Returns an interval (in the first component) in which all the conditions
 // given in the second component provably have value given by cond_value
 std::pair<IntSet, ExpressionSet> LoopPartitioner::GetIntervalAndCondset(
@@ -661,6 +680,14 @@ Stmt LoopPartitioner::TryPartition(const Stmt& stmt, Var var, PrimExpr min, Prim
     post_doubt_begin = max + 1;
   }
 
+  // The middle subrange replaces the loop, the others are copies of its body. When they exceed
+  // the budget, the loop keeps its conditions, which are cheaper than the copies of a whole nest.
+  if (code_growth_budget_ >= 0) {
+    int64_t growth = StmtSize(pre_stmt) + StmtSize(post_stmt);
+    if (growth > code_growth_budget_) return Stmt();
+    code_growth_budget_ -= growth;
+  }
+
   Stmt s;
 
   // Generating code for middle subrange
@@ -729,9 +756,11 @@ class RemoveLikelyTagsAndHints : public StmtExprMutator {
 };
 
 Stmt LoopPartition(Stmt stmt, bool partition_const_loop, bool no_unroll_loop_with_extent_one,
-                   bool unroll_loop_with_partition_hint_no_interval) {
+                   bool unroll_loop_with_partition_hint_no_interval, double max_code_growth) {
+  int64_t budget =
+      max_code_growth < 0 ? -1 : static_cast<int64_t>(max_code_growth * StmtSize(stmt));
   stmt = LoopPartitioner(partition_const_loop, no_unroll_loop_with_extent_one,
-                         unroll_loop_with_partition_hint_no_interval)
+                         unroll_loop_with_partition_hint_no_interval, budget)
              .VisitAndMutate(std::move(stmt));
   stmt = RemoveLikelyTagsAndHints()(std::move(stmt));
   return stmt;
@@ -748,10 +777,11 @@ Pass LoopPartition() {
     }
     n->body = LoopPartition(std::move(n->body), cfg.value()->partition_const_loop,
                             cfg.value()->no_unroll_loop_with_extent_one,
-                            cfg.value()->unroll_loop_with_partition_hint_no_interval);
+                            cfg.value()->unroll_loop_with_partition_hint_no_interval,
+                            cfg.value()->max_code_growth);
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.LoopPartition", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.LoopPartition", {}, /*function_local=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.LoopPartition").set_body_typed(LoopPartition);
@@ -24,6 +24,7 @@
 #include <tvm/arith/analyzer.h>
 #include <tvm/arith/bound.h>
 #include <tvm/arith/iter_affine_map.h>
+#include <tvm/arith/pattern.h>
 #include <tvm/tir/analysis.h>
 #include <tvm/tir/buffer.h>
 #include <tvm/tir/stmt.h>
@@ -54,6 +55,10 @@ class AsyncDMALowerer : public arith::IRMutatorWithAnalyzer {
     std::optional<tvm::tir::MemCpyDetails> mem_copy = IdentifyMemCpy(GetRef<For>(loop), analyzer_);
     if (!mem_copy.has_value() || mem_copy->dest->region.size() != 1 ||
         mem_copy->source->region.size() != 1) {
+      // a strided tile is copied with a single 2D DMA, rather than a DMA per row
+      if (std::optional<Stmt> copy_2d = LowerCopy2D(loop)) {
+        return copy_2d.value();
+      }
       return arith::IRMutatorWithAnalyzer::VisitStmt_(loop);
     }
 
@@ -154,6 +159,85 @@ class AsyncDMALowerer : public arith::IRMutatorWithAnalyzer {
   }
 
  private:
+  // Lower a copy of rows, which are contiguous in both buffers, to a 2D DMA
+  //
+  // Convert this, for example:
+  // for (ax0: int32, 0, 32) {
+  //   for (ax1: int32, 0, 64) {
+  //     A_global[((ax0*64) + ax1)] = A[(((ax0*256) + ax1) + 128)]
+  //   }
+  // }
+  //
+  // To this:
+  // @tir.dma_copy_2d(
+  //   0, /* queue id */
+  //   @tir.address_of(A_global[0], dtype=handle),
+  //   @tir.address_of(A[128], dtype=handle),
+  //   64, /* width */
+  //   32, /* height */
+  //   64, /* dst stride */
+  //   256, /* src stride */
+  //   dtype=int32
+  // )
+  //
+  // with the width and strides in bytes.
+  std::optional<Stmt> LowerCopy2D(const ForNode* outer) {
+    const auto* inner = outer->body.as<ForNode>();
+    if (!inner) return std::nullopt;
+    const auto* store = inner->body.as<BufferStoreNode>();
+    if (!store) return std::nullopt;
+    const auto* load = store->value.as<BufferLoadNode>();
+    if (!load || load->dtype != store->buffer->dtype || load->dtype.lanes() != 1) {
+      return std::nullopt;
+    }
+    auto uses_outer = [outer](const VarNode* var) { return var == outer->loop_var.get(); };
+    if (UsesVar(inner->min, uses_outer) || UsesVar(inner->extent, uses_outer)) {
+      return std::nullopt;
+    }
+
+    Array<PrimExpr> dst_index = store->buffer.OffsetOf(store->indices);
+    Array<PrimExpr> src_index = load->buffer.OffsetOf(load->indices);
+    if (dst_index.size() != 1 || src_index.size() != 1) return std::nullopt;
+    Array<Var> loop_vars = {outer->loop_var, inner->loop_var};
+    Array<PrimExpr> dst_coef = arith::DetectLinearEquation(dst_index[0], loop_vars);
+    Array<PrimExpr> src_coef = arith::DetectLinearEquation(src_index[0], loop_vars);
+    if (dst_coef.empty() || src_coef.empty() || !is_one(analyzer_->Simplify(dst_coef[1])) ||
+        !is_one(analyzer_->Simplify(src_coef[1]))) {
+      return std::nullopt;
+    }
+    // the rows must not overlap
+    if (!analyzer_->CanProve(dst_coef[0] >= inner->extent) ||
+        !analyzer_->CanProve(src_coef[0] >= inner->extent)) {
+      return std::nullopt;
+    }
+
+    int bytes = load->dtype.bytes();
+    PrimExpr width = analyzer_->Simplify(inner->extent * bytes);
+    PrimExpr dst_stride = analyzer_->Simplify(dst_coef[0] * bytes);
+    PrimExpr src_stride = analyzer_->Simplify(src_coef[0] * bytes);
+    // the fields of the 2D descriptor are limited to 16 bits
+    for (const PrimExpr& field : {width, outer->extent, dst_stride, src_stride}) {
+      const int64_t* value = as_const_int(field);
+      if (value && *value > 0xFFFF) return std::nullopt;
+    }
+
+    queue_ids_.insert(async_queue_id_.value());
+    dmas_in_group_++;
+
+    Map<Var, PrimExpr> first = {{outer->loop_var, outer->min}, {inner->loop_var, inner->min}};
+    auto substitute_first = [&](const Array<PrimExpr>& indices) {
+      return indices.Map(
+          [&](const PrimExpr& index) { return analyzer_->Simplify(Substitute(index, first)); });
+    };
+    auto src = BufferLoad(load->buffer, substitute_first(load->indices));
+    auto dst = BufferLoad(store->buffer, substitute_first(store->indices));
+    return Evaluate(Call(DataType::Int(32), builtin::dma_copy_2d(),
+                         {async_queue_id_.value(),
+                          Call(DataType::Handle(), builtin::address_of(), {dst}),
+                          Call(DataType::Handle(), builtin::address_of(), {src}), width,
+                          outer->extent, dst_stride, src_stride, dma_bypass_cache_}));
+  }
+
   int dmas_in_group_ = 0;
   std::set<int> queue_ids_;
   std::optional<int> async_queue_id_ = std::nullopt;
@@ -260,7 +260,7 @@ Pass LowerMatchBuffer() {
   auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
     return LowerMatchBuffer(std::move(f));
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.LowerMatchBuffer", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.LowerMatchBuffer", {}, /*function_local=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.LowerMatchBuffer").set_body_typed(LowerMatchBuffer);
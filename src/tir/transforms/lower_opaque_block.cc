@@ -200,7 +200,7 @@ Pass LowerOpaqueBlock() {
   auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
     return LowerOpaqueBlock(std::move(f));
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.LowerOpaqueBlock", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.LowerOpaqueBlock", {}, /*function_local=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.LowerOpaqueBlock").set_body_typed(LowerOpaqueBlock);
@@ -304,6 +304,7 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
     std::vector<Var> shared_buffer_vars(size);
     std::vector<Buffer> shared_bufs(size);
     std::vector<Buffer> local_bufs;
+    std::vector<Buffer> staging_bufs;
     //
     // This is an optimization. For small reduction sizes, it may be beneficial
     // for a single warp to performance the entire reduction. No trips to shared
@@ -321,8 +322,20 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
     // broadcast results from lane 0 to all other lanes and store
     // the final reduction result to the proper location.
     //
+    // When the reduce extent spans several warps, each warp is reduced as
+    // above, lane 0 of each warp writes its partial result to shared memory,
+    // and after a single synchronization every warp reduces the partial
+    // results with shuffles again:
+    //
+    // warp reduction of v[i]
+    // if lane == 0: staging[i][warp_id] <- v[i]
+    // sync
+    // v[i] <- lane < num_warps ? staging[i][lane] : identity
+    // warp reduction of v[i]
+    //
     if (is_warp_reduction(types, group_extent, reduce_extent, contiguous_reduce_extent)) {
-      ICHECK_LE(reduce_extent, warp_size_) << "not a warp reduction";
+      bool multi_warp = reduce_extent > warp_size_;
+      ICHECK(!multi_warp || reduce_extent % warp_size_ == 0) << "not a warp reduction";
       //
       // This is the index to the reduction variable, one reduction
       // variable per warp. Local scope seems easier to reason without
@@ -354,7 +367,7 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
       Buffer mask_buffer = decl_buffer({1}, mask_dtype, "mask");
       {
         PrimExpr mask = Call(mask_dtype, builtin::tvm_warp_activemask(), {});
-        if (group_extent > 1) {
+        if (group_extent > 1 && !multi_warp) {
           mask = mask & (((1 << reduce_extent) - 1) << (reduce_extent * group_index));
         }
         seq.emplace_back(BufferStore(mask_buffer, mask, zero_indices));
@@ -363,80 +376,64 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
         local_bufs.push_back(mask_buffer);
       }
 
-      // Emit reductions within a warp.
-      int start_offset = 1;
-      while (start_offset * 2 < reduce_extent) {
-        start_offset *= 2;
-      }
-      for (int offset = start_offset; offset > 0; offset /= 2) {
-        // Load reduction values, no synchronization needed.
-        Array<PrimExpr> a, b;
+      if (!multi_warp) {
+        // Emit reductions within a warp.
+        MakeWarpReduce(combiner, types, shared_bufs, local_bufs, mask_buffer, reduce_index,
+                       reduce_extent, &seq);
+
+        // Broadcast the reduction result from lane 0 to all other lanes.
+        // This avoids to emit predicated stores, as all threads are
+        // uniformly writting the same result.
+        //
         for (size_t i = 0; i < size; ++i) {
-          Buffer shared_buf = shared_bufs[i];
-          BufferLoad val(shared_buf, zero_indices);
+          Buffer buf = shared_bufs[i];
+          PrimExpr val = BufferLoad(buf, zero_indices);
           ICHECK_EQ(val->dtype, types[i]);
-          a.push_back(val);
-
-          // __shfl_*sync calls shall not appear in if_then_else expressions
-          // as this is causing extra divergency. E.g.
-          //
-          // v1 = (v2 < v3) ? v3 : __shfl_sync(mask, v1, 0);
-          //
-          // behaves differently from
-          //
-          // int t = __shfl_sync(mask, v1, 0);
-          // v1 = (v2 < v3) ? v3 : t;
-          //
-          // The former may cause dead lock as there is a divergent
-          // branch with a warp sync call inside.
-          //
-          PrimExpr other = WarpShuffle(builtin::tvm_warp_shuffle_down(), mask_buffer, val, offset);
-          Buffer local_buf = local_bufs[i];
-          Stmt s = BufferStore(local_buf, other, zero_indices);
-          seq.push_back(s);
-
-          BufferLoad load = BufferLoad(local_buf, zero_indices);
-          ICHECK_EQ(load->dtype, types[i]);
-          b.push_back(load);
+          PrimExpr splat = WarpShuffle(builtin::tvm_warp_shuffle(), mask_buffer, val,
+                                       reduce_extent * group_index);
+          seq.push_back(BufferStore(buf, splat, zero_indices));
         }
-
-        // Do reductions.
-        Array<PrimExpr> ret = (*combiner)(a, b);
-
-        // Store the reduction result to itself.
-        std::vector<Stmt> stores(size);
+      } else {
+        int num_warps = reduce_extent / warp_size_;
+        PrimExpr lane_index = indexmod(reduce_index, warp_size_);
+        PrimExpr warp_index = indexdiv(reduce_index, warp_size_);
+
+        // Reduce within each warp, lane 0 of the warp holds its partial result.
+        MakeWarpReduce(combiner, types, shared_bufs, local_bufs, mask_buffer, lane_index,
+                       warp_size_, &seq);
+
+        // Exchange the partial results of the warps through shared memory.
+        // This sync is necessary because there might be incomplete read of
+        // previous iteration on the same buffer.
+        seq.emplace_back(SyncThread("shared"));
+        std::vector<Stmt> stage_stores, init_stores, stage_loads;
         for (size_t i = 0; i < size; ++i) {
-          Buffer buf = shared_bufs[i];
-          stores[i] = BufferStore(buf, ret[i], zero_indices);
+          Buffer staging_buf = decl_buffer({group_extent * num_warps}, types[i],
+                                           "red_buf_staging" + std::to_string(i));
+          staging_bufs.push_back(staging_buf);
+          stage_stores.push_back(BufferStore(staging_buf, BufferLoad(shared_bufs[i], zero_indices),
+                                             {BufIndex(warp_index, group_index, num_warps)}));
+          init_stores.push_back(BufferStore(shared_bufs[i], inits[i], zero_indices));
+          BufferLoad partial(staging_buf, {BufIndex(lane_index, group_index, num_warps)});
+          stage_loads.push_back(BufferStore(shared_bufs[i], partial, zero_indices));
         }
-
-        // During the sub-warp reduction, values from inactive threads could be read,
-        // which is an undefined behavior according to the cuda document.
-        //
-        // In practise, the return value are usually 0, which does no harm to sum reduction.
-        // However, the result can be incorrect in max or prod reduction.
-        // Therefore an additional range check has to be performed to ensure the correctness.
-        if (offset * 2 > reduce_extent) {
-          PrimExpr cond = reduce_index + offset < reduce_extent;
-          seq.push_back(IfThenElse(cond, SeqStmt::Flatten(stores)));
-        } else {
-          seq.push_back(SeqStmt::Flatten(stores));
+        seq.push_back(IfThenElse(lane_index == 0, SeqStmt::Flatten(stage_stores)));
+        seq.emplace_back(SyncThread("shared"));
+        seq.push_back(SeqStmt::Flatten(init_stores));
+        seq.push_back(IfThenElse(lane_index < num_warps, SeqStmt::Flatten(stage_loads)));
+
+        // Every warp reduces the partial results, so that no second
+        // exchange is needed to broadcast the result across warps.
+        MakeWarpReduce(combiner, types, shared_bufs, local_bufs, mask_buffer, lane_index, num_warps,
+                       &seq);
+        for (size_t i = 0; i < size; ++i) {
+          Buffer buf = shared_bufs[i];
+          PrimExpr val = BufferLoad(buf, zero_indices);
+          PrimExpr splat = WarpShuffle(builtin::tvm_warp_shuffle(), mask_buffer, val, 0);
+          seq.push_back(BufferStore(buf, splat, zero_indices));
         }
       }
 
-      // Broadcast the reduction result from lane 0 to all other lanes.
-      // This avoids to emit predicated stores, as all threads are
-      // uniformly writting the same result.
-      //
-      for (size_t i = 0; i < size; ++i) {
-        Buffer buf = shared_bufs[i];
-        PrimExpr val = BufferLoad(buf, zero_indices);
-        ICHECK_EQ(val->dtype, types[i]);
-        PrimExpr splat =
-            WarpShuffle(builtin::tvm_warp_shuffle(), mask_buffer, val, reduce_extent * group_index);
-        seq.push_back(BufferStore(buf, splat, zero_indices));
-      }
-
       // Update existing allocations.
       for (size_t i = 0; i < size; ++i) {
         ICHECK(!load_remap_.count(buffers[i]->data.get()));
@@ -498,10 +495,80 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
       body = Allocate(buf->data, buf->dtype, buf->shape, const_true(buf->dtype.lanes()), body);
       new_storage_scopes_[buf->data.get()] = "local";
     }
+    for (Buffer buf : staging_bufs) {
+      body = Allocate(buf->data, buf->dtype, buf->shape, const_true(buf->dtype.lanes()), body);
+      new_storage_scopes_[buf->data.get()] = "shared";
+    }
 
     return body;
   }
 
+  // Emit a shuffle down reduction of the values in red_bufs over the first
+  // reduce_extent lanes of a warp. The result is left in the first lane.
+  void MakeWarpReduce(const CommReducerNode* combiner, const std::vector<DataType>& types,
+                      const std::vector<Buffer>& red_bufs, const std::vector<Buffer>& local_bufs,
+                      Buffer mask_buffer, PrimExpr lane_index, int reduce_extent,
+                      std::vector<Stmt>* seq) {
+    Array<PrimExpr> zero_indices = {0};
+    size_t size = red_bufs.size();
+    int start_offset = 1;
+    while (start_offset * 2 < reduce_extent) {
+      start_offset *= 2;
+    }
+    for (int offset = start_offset; offset > 0; offset /= 2) {
+      // Load reduction values, no synchronization needed.
+      Array<PrimExpr> a, b;
+      for (size_t i = 0; i < size; ++i) {
+        BufferLoad val(red_bufs[i], zero_indices);
+        ICHECK_EQ(val->dtype, types[i]);
+        a.push_back(val);
+
+        // __shfl_*sync calls shall not appear in if_then_else expressions
+        // as this is causing extra divergency. E.g.
+        //
+        // v1 = (v2 < v3) ? v3 : __shfl_sync(mask, v1, 0);
+        //
+        // behaves differently from
+        //
+        // int t = __shfl_sync(mask, v1, 0);
+        // v1 = (v2 < v3) ? v3 : t;
+        //
+        // The former may cause dead lock as there is a divergent
+        // branch with a warp sync call inside.
+        //
+        PrimExpr other = WarpShuffle(builtin::tvm_warp_shuffle_down(), mask_buffer, val, offset);
+        Buffer local_buf = local_bufs[i];
+        seq->push_back(BufferStore(local_buf, other, zero_indices));
+
+        BufferLoad load = BufferLoad(local_buf, zero_indices);
+        ICHECK_EQ(load->dtype, types[i]);
+        b.push_back(load);
+      }
+
+      // Do reductions.
+      Array<PrimExpr> ret = (*combiner)(a, b);
+
+      // Store the reduction result to itself.
+      std::vector<Stmt> stores(size);
+      for (size_t i = 0; i < size; ++i) {
+        stores[i] = BufferStore(red_bufs[i], ret[i], zero_indices);
+      }
+
+      // During the sub-warp reduction, values from inactive threads could be read,
+      // which is an undefined behavior according to the cuda document.
+      //
+      // In practise, the return value are usually 0, which does no harm to sum reduction.
+      // However, the result can be incorrect in max or prod reduction.
+      // Therefore an additional range check has to be performed to ensure the correctness.
+      if (offset * 2 > reduce_extent) {
+        PrimExpr cond = lane_index + offset < reduce_extent;
+        seq->push_back(IfThenElse(cond, SeqStmt::Flatten(stores)));
+      } else {
+        seq->push_back(SeqStmt::Flatten(stores));
+      }
+    }
+  }
+
   // make allreduce.
   Stmt MakeBufAllreduce(const CommReducerNode* combiner, const std::vector<DataType>& types,
                         const Array<Buffer>& shared_bufs, PrimExpr reduce_index,
@@ -656,7 +723,7 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
 
   // Check if we can use warp level reduction.
   //
-  // Note: The ROCm backend will only have warp reductions for now.
+  // Note: The ROCm backend will only have full warp reductions for now.
   // Also, the warp/wavefront size differs (64 on rocm, 32 on cuda).
   bool is_warp_reduction(const std::vector<DataType>& types, int group_extent, int reduce_extent,
                          int contiguous_reduce_extent) const {
@@ -690,6 +757,12 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
       return false;
     }
 
+    // Reductions over several whole warps exchange one partial result per
+    // warp through shared memory, which is reduced by a single warp.
+    if (reduce_extent > warp_size_) {
+      return reduce_extent % warp_size_ == 0 && reduce_extent / warp_size_ <= warp_size_;
+    }
+
     // whether reduce_extent and group_extent are vaild for warp reduction.
     if (target_->kind->name == "rocm") {
       return reduce_extent == warp_size_;
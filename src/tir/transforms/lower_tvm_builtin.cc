@@ -317,6 +317,8 @@ class BuiltinLower : public StmtExprMutator {
       return make_zero(op->dtype);
     } else if (op->op.same_as(builtin::dma_copy())) {
       return MakeDMACopy(op);
+    } else if (op->op.same_as(builtin::dma_copy_2d())) {
+      return MakeDMACopy2D(op);
     } else if (op->op.same_as(builtin::dma_wait())) {
       return MakeDMAWait(op);
     } else if (op->op.same_as(builtin::dma_start_group())) {
@@ -355,6 +357,13 @@ class BuiltinLower : public StmtExprMutator {
     return VisitExpr(call_packed);
   }
 
+  PrimExpr MakeDMACopy2D(const CallNode* op) {
+    Array<PrimExpr> args = {GetDeviceMethodName("dma_copy_2d")};
+    args.insert(args.end(), op->args.begin(), op->args.end());
+    Call call_packed = Call(DataType::Int(32), builtin::tvm_call_packed(), args);
+    return VisitExpr(call_packed);
+  }
+
   PrimExpr MakeDMAWait(const CallNode* op) {
     PrimExpr queue_id = op->args[0];
     PrimExpr inflight = op->args[1];
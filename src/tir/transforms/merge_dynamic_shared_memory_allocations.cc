@@ -21,12 +21,16 @@
  * \file merge_dynamic_shared_memory_allocations.cc
  * \brief Each GPU kernel is allowed to have only one dynamic shared memory allocation.
  * This pass merges multiple TIR-level dynamic shared memory allocations into one allocation.
+ * When `tir.merge_static_smem` is set, the static shared memory allocations are merged into
+ * one allocation the same way, so that buffers with disjoint lifetimes share memory.
  */
+#include <tvm/arith/analyzer.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/tir/expr.h>
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <list>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -40,11 +44,27 @@ namespace tir {
 using runtime::StorageRank;
 using runtime::StorageScope;
 
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.merge_static_smem", Bool);
+
 bool IsDynamicSharedMemory(Var buffer_var) {
   StorageScope storage_scope = runtime::StorageScope::Create(GetPtrStorageScope(buffer_var));
   return storage_scope.rank == runtime::StorageRank::kShared && storage_scope.tag == ".dyn";
 }
 
+bool IsStaticSharedMemory(Var buffer_var) {
+  StorageScope storage_scope = runtime::StorageScope::Create(GetPtrStorageScope(buffer_var));
+  return storage_scope.rank == runtime::StorageRank::kShared && storage_scope.tag == "";
+}
+
+/*!
+ * \brief Whether the buffer var is in the kind of shared memory being merged.
+ * \param buffer_var The buffer var.
+ * \param is_dynamic Whether the dynamic or the static shared memory is merged.
+ */
+bool IsMergedSharedMemory(Var buffer_var, bool is_dynamic) {
+  return is_dynamic ? IsDynamicSharedMemory(buffer_var) : IsStaticSharedMemory(buffer_var);
+}
+
 /*!
  * \brief collect the mapping from the buffer var to its allocate
  */
@@ -53,11 +73,15 @@ class AllocateCollector : public StmtExprVisitor {
   void VisitStmt_(const AllocateNode* op) final {
     if (IsDynamicSharedMemory(op->buffer_var)) {
       dyn_shmem_allocs_[op->buffer_var.get()] = op;
+    } else if (IsStaticSharedMemory(op->buffer_var)) {
+      static_shmem_allocs_[op->buffer_var.get()] = op;
     }
     StmtExprVisitor::VisitStmt_(op);
   }
   // The mapping from the original buffer var to its allocate
   std::unordered_map<const VarNode*, const AllocateNode*> dyn_shmem_allocs_;
+  // The mapping from the original static shared buffer var to its allocate
+  std::unordered_map<const VarNode*, const AllocateNode*> static_shmem_allocs_;
 };
 
 // Find a linear pattern of storage access
@@ -75,6 +99,9 @@ class AllocateCollector : public StmtExprVisitor {
 //
 class DynSharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
  public:
+  explicit DynSharedMemLinearAccessPatternFinder(bool is_dynamic = true)
+      : is_dynamic_(is_dynamic) {}
+
   /*! \brief record the touch list of statement. */
   struct StmtEntry {
     // The statement
@@ -112,7 +139,7 @@ class DynSharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
     auto it = alloc_info_.find(buf);
     if (it != alloc_info_.end() && it->second.alloc) {
       ICHECK_LT(it->second.level, scope_.size());
-      if (IsDynamicSharedMemory(GetRef<Var>(buf))) {
+      if (IsMergedSharedMemory(GetRef<Var>(buf), is_dynamic_)) {
         scope_[it->second.level].touched.push_back(buf);
       }
     }
@@ -143,7 +170,7 @@ class DynSharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
     auto it = alloc_info_.find(buf);
     if (it != alloc_info_.end() && it->second.alloc) {
       ICHECK_LT(it->second.level, scope_.size()) << "Load memory in places other than store.";
-      if (IsDynamicSharedMemory(GetRef<Var>(buf))) {
+      if (IsMergedSharedMemory(GetRef<Var>(buf), is_dynamic_)) {
         scope_[it->second.level].touched.push_back(buf);
       }
     }
@@ -164,7 +191,7 @@ class DynSharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
     auto it = alloc_info_.find(buf);
     if (it != alloc_info_.end() && it->second.alloc) {
       ICHECK_LT(it->second.level, scope_.size());
-      if (IsDynamicSharedMemory(GetRef<Var>(buf))) {
+      if (IsMergedSharedMemory(GetRef<Var>(buf), is_dynamic_)) {
         scope_[it->second.level].touched.push_back(buf);
       }
     }
@@ -217,6 +244,8 @@ class DynSharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
   std::unordered_map<const VarNode*, AllocEntry> alloc_info_;
 
  private:
+  // Whether the dynamic or the static shared memory is merged.
+  bool is_dynamic_;
   // Whether already in thread env.
   bool in_thread_env_{false};
   // The scope stack.
@@ -229,15 +258,20 @@ class DynSharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
 class DynamicSharedMemoryRewriter : public StmtExprMutator {
  public:
   explicit DynamicSharedMemoryRewriter(
-      const std::unordered_map<const VarNode*, const AllocateNode*>& dyn_shmem_allocs)
-      : dyn_shmem_allocs_{dyn_shmem_allocs} {}
+      const std::unordered_map<const VarNode*, const AllocateNode*>& dyn_shmem_allocs,
+      bool is_dynamic = true)
+      : is_dynamic_{is_dynamic},
+        merged_buf_var_{is_dynamic ? "buf_dyn_shmem" : "buf_shmem",
+                        PointerType(PrimType(DataType::UInt(8)),
+                                    is_dynamic ? "shared.dyn" : "shared")},
+        dyn_shmem_allocs_{dyn_shmem_allocs} {}
 
   /*!
    * \brief plan the memory reuse for all the buffer allocated in the statement
    * \param stmt the statement
    */
   void PlanReuse(const Stmt& stmt) {
-    DynSharedMemLinearAccessPatternFinder finder;
+    DynSharedMemLinearAccessPatternFinder finder(is_dynamic_);
     finder(stmt);
     this->LivenessAnalysis(finder.linear_seq_);
     this->PlanMemory(finder.linear_seq_);
@@ -269,7 +303,18 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
         }
       }
       // calculate offset for each buffer based on the align of each layer
+      arith::Analyzer analyzer;
       for (const StorageEntry* e : all_entry) {
+        // start the entry at an offset aligned for all of its layers
+        int entry_align = 1;
+        for (int i = 0; i < static_cast<int>(e->allocs.size()); i++) {
+          entry_align = std::max(entry_align, align[i]);
+        }
+        PrimExpr entry_pad = analyzer.Simplify(
+            indexmod(entry_align - indexmod(merged_alloc_size_, entry_align), entry_align));
+        if (!is_zero(entry_pad)) {
+          merged_alloc_size_ += entry_pad;
+        }
         PrimExpr max_inner_offset = 0;
         for (int i = 0; i < static_cast<int>(e->allocs.size()); i++) {
           PrimExpr inner_offset = 0;
@@ -293,7 +338,7 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
   }
 
   Stmt VisitStmt_(const AllocateNode* op) final {
-    if (IsDynamicSharedMemory(op->buffer_var)) {
+    if (IsMergedSharedMemory(op->buffer_var, is_dynamic_)) {
       return StmtExprMutator::VisitStmt(op->body);
     }
     return StmtExprMutator::VisitStmt_(op);
@@ -311,7 +356,7 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
 
   template <typename Node>
   Node VisitBufferAccess(Node node) {
-    if (IsDynamicSharedMemory(node->buffer->data)) {
+    if (IsMergedSharedMemory(node->buffer->data, is_dynamic_)) {
       ICHECK_EQ(node->indices.size(), 1)
           << "MergeDynamicSharedMemoryAllocations expects flat memory buffers, "
           << "and is to be run after "
@@ -334,7 +379,7 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
       return it->second;
     }
 
-    if (IsDynamicSharedMemory(buffer->data)) {
+    if (IsMergedSharedMemory(buffer->data, is_dynamic_)) {
       ICHECK_EQ(buffer->shape.size(), 1)
           << "MergeDynamicSharedMemoryAllocations expects flat memory buffers, "
           << "and is to be run after "
@@ -352,7 +397,7 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
       ICHECK_EQ(op->args.size(), 5U);
       DataType dtype = op->args[0].dtype();
       Var buffer = Downcast<Var>(op->args[1]);
-      if (!IsDynamicSharedMemory(buffer)) {
+      if (!IsMergedSharedMemory(buffer, is_dynamic_)) {
         return StmtExprMutator::VisitExpr_(op);
       }
       PrimExpr extra_offset = GetBufferOffset(buffer, dtype);
@@ -569,8 +614,10 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
       sym_free_list_.push_back(e);
     }
   }
+  // Whether the dynamic or the static shared memory is merged
+  bool is_dynamic_;
   // The var for the merged buffer
-  Var merged_buf_var_{"buf_dyn_shmem", PointerType(PrimType(DataType::UInt(8)), "shared.dyn")};
+  Var merged_buf_var_;
   // The mapping from the original buffer var to its allocate
   std::unordered_map<const VarNode*, const AllocateNode*> dyn_shmem_allocs_;
   // The size of the merged buffer
@@ -593,13 +640,18 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
   support::Arena arena_;
 };
 
-Stmt MergeDynamicSharedMemoryAllocations(Stmt stmt) {
+Stmt MergeDynamicSharedMemoryAllocations(Stmt stmt, bool merge_static_smem) {
   AllocateCollector collector;
   collector(stmt);
   if (collector.dyn_shmem_allocs_.size() > 1) {
     DynamicSharedMemoryRewriter rewriter(collector.dyn_shmem_allocs_);
     rewriter.PlanReuse(stmt);
-    return rewriter(std::move(stmt));
+    stmt = rewriter(std::move(stmt));
+  }
+  if (merge_static_smem && collector.static_shmem_allocs_.size() > 1) {
+    DynamicSharedMemoryRewriter rewriter(collector.static_shmem_allocs_, false);
+    rewriter.PlanReuse(stmt);
+    stmt = rewriter(std::move(stmt));
   }
   return stmt;
 }
@@ -608,8 +660,9 @@ namespace transform {
 
 Pass MergeDynamicSharedMemoryAllocations() {
   auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
+    bool merge_static_smem = ctx->GetConfig<Bool>("tir.merge_static_smem", Bool(false)).value();
     auto* n = f.CopyOnWrite();
-    n->body = MergeDynamicSharedMemoryAllocations(std::move(n->body));
+    n->body = MergeDynamicSharedMemoryAllocations(std::move(n->body), merge_static_smem);
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tir.MergeDynamicSharedMemoryAllocations", {});
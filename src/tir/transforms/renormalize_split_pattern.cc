@@ -202,7 +202,8 @@ Pass RenormalizeSplitPattern() {
     n->body = SplitPatternReNormalizer(&analyzer)(std::move(n->body));
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.RenormalizeSplitPattern", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.RenormalizeSplitPattern", {},
+                            /*function_local=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.RenormalizeSplitPattern")
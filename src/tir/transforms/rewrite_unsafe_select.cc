@@ -136,7 +136,7 @@ Pass RewriteUnsafeSelect() {
     n->body = UnsafeSelectRewriter()(std::move(n->body));
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.RewriteUnsafeSelect", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.RewriteUnsafeSelect", {}, /*function_local=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.RewriteUnsafeSelect").set_body_typed(RewriteUnsafeSelect);
@@ -608,13 +608,17 @@ class StoragePlanRewriter : public StmtExprMutator {
           continue;
         }
         // Get the allocation size;
-        e->alloc_var = e->allocs[0]->buffer_var;
-        DataType alloc_type = e->allocs[0]->dtype;
+        // The allocations sharing the storage may differ in dtype and lanes.
+        // Declare the storage with the widest element type among them, so that
+        // the accesses of every allocation are aligned to their element size.
+        const AllocateNode* widest = e->allocs[0];
         for (const AllocateNode* op : e->allocs) {
-          if (op->dtype.lanes() > alloc_type.lanes()) {
-            alloc_type = op->dtype;
+          if (op->dtype.bits() * op->dtype.lanes() > widest->dtype.bits() * widest->dtype.lanes()) {
+            widest = op;
           }
         }
+        e->alloc_var = widest->buffer_var;
+        DataType alloc_type = widest->dtype;
 
         bool all_allocs_identical = std::all_of(
             e->allocs.begin() + 1, e->allocs.end(), [&](const AllocateNode* op) -> bool {
@@ -938,7 +942,7 @@ class StoragePlanRewriter : public StmtExprMutator {
         StorageEntry* e = it->second;
         if (e->attach_scope_ != attach_scope) continue;
         if (e->scope != scope) continue;
-        if (e->elem_type != op->dtype.element_of()) continue;
+        if (e->bits_offset % op_elem_bits != 0) continue;
         e->const_nbits = std::max(const_nbits, e->const_nbits);
         const_free_map_.erase(it);
         return e;
@@ -949,7 +953,6 @@ class StoragePlanRewriter : public StmtExprMutator {
         StorageEntry* e = *it;
         if (e->attach_scope_ != attach_scope) continue;
         if (e->scope != scope) continue;
-        if (e->elem_type != op->dtype.element_of()) continue;
         sym_free_list_.erase(it);
         return e;
       }
@@ -1631,7 +1634,7 @@ Pass StorageRewrite() {
     // handle vectorized constants.
     return PointerValueTypeRewrite(std::move(f), true, false, false, true, true, true, false);
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.StorageRewrite", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.StorageRewrite", {}, /*function_local=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.StorageRewrite").set_body_typed(StorageRewrite);
@@ -1640,7 +1643,8 @@ Pass PointerValueTypeRewrite() {
   auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
     return PointerValueTypeRewrite(std::move(f));
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.PointerValueTypeRewrite", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.PointerValueTypeRewrite", {},
+                            /*function_local=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.PointerValueTypeRewrite")
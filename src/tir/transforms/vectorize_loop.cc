@@ -149,7 +149,8 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   using ExprFunctor::VisitExpr;
   using StmtMutator::operator();
 
-  Vectorizer(Var var, int var_lanes) : var_(var), var_lanes_(var_lanes) {
+  Vectorizer(Var var, int var_lanes, bool predicated = false)
+      : var_(var), var_lanes_(var_lanes), predicated_(predicated) {
     ramp_ = Ramp(IntImm(var->dtype, 0), IntImm(var->dtype, 1), var_lanes);
   }
 
@@ -296,6 +297,12 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   PrimExpr MutateIfThenElseExpr_(const CallNode* op) {
     PrimExpr cond = this->VisitExpr(op->args[0]);
     if (cond.dtype().is_vector()) {
+      if (predicated_) {
+        PrimExpr masked = MaskIfThenElseExpr(cond, op);
+        if (masked.defined()) {
+          return masked;
+        }
+      }
       need_scalarize_ = true;
       return GetRef<PrimExpr>(op);
     }
@@ -372,6 +379,14 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
       writer->LegalizeDType();
     }
 
+    if (mask_.defined()) {
+      if (!IsMaskableAccess(load->buffer, load->indices, load->dtype.lanes())) {
+        mask_failed_ = true;
+        return std::move(load);
+      }
+      PrimExpr ptr = Call(DataType::Handle(), builtin::address_of(), {load});
+      return Call(load->dtype, builtin::masked_load(), {ptr, mask_, make_zero(load->dtype)});
+    }
     return std::move(load);
   }
   // Let
@@ -409,6 +424,15 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     auto fmutate = [this](const PrimExpr& index) { return this->VisitExpr(index); };
     Array<PrimExpr> indices = op->indices.Map(fmutate);
 
+    // A reduction into a location that does not depend on the loop,
+    // e.g. A[0] = A[0] + B[i], combines the lanes of the vector term.
+    if (indices.same_as(op->indices) && op->buffer->dtype.lanes() == 1 && !mask_.defined()) {
+      if (Optional<PrimExpr> reduced = VectorizeReduction(op)) {
+        store.CopyOnWrite()->value = reduced.value();
+        return std::move(store);
+      }
+    }
+
     PrimExpr value = this->VisitExpr(op->value);
 
     if (!indices.same_as(op->indices) || !value.same_as(op->value)) {
@@ -441,6 +465,15 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
       writer->value = BroadcastTo(value, total_lanes);
     }
 
+    if (mask_.defined()) {
+      if (!IsMaskableAccess(store->buffer, store->indices, store->value.dtype().lanes())) {
+        mask_failed_ = true;
+        return std::move(store);
+      }
+      BufferLoad address(store->buffer, store->indices);
+      PrimExpr ptr = Call(DataType::Handle(), builtin::address_of(), {address});
+      return Evaluate(Call(DataType::Void(), builtin::masked_store(), {ptr, store->value, mask_}));
+    }
     return std::move(store);
   }
   // For
@@ -467,6 +500,12 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     ICHECK(!op->condition.dtype().is_vector());
     PrimExpr condition = this->VisitExpr(op->condition);
     if (condition.dtype().is_vector()) {
+      if (predicated_) {
+        Optional<Stmt> masked = MaskIfThenElse(condition, op);
+        if (masked) {
+          return masked.value();
+        }
+      }
       return Scalarize(GetRef<Stmt>(op));
     }
     Stmt then_case = this->VisitStmt(op->then_case);
@@ -507,6 +546,10 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   }
   // Allocate
   Stmt VisitStmt_(const AllocateNode* op) final {
+    if (mask_.defined()) {
+      mask_failed_ = true;
+      return GetRef<Stmt>(op);
+    }
     // Mutate the condition
     PrimExpr condition = this->VisitExpr(op->condition);
     if (condition.dtype().is_vector()) {
@@ -541,8 +584,55 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     return Allocate(op->buffer_var, op->dtype, extents, condition, body);
   }
 
+  // Rewrite the value of a store of Op(A[idx], term) to A[idx], where Op is a
+  // commutative reduction and term is vectorized, to reduce the lanes of term.
+  Optional<PrimExpr> VectorizeReduction(const BufferStoreNode* op) {
+    PrimExpr a, b;
+    Op reduce_op;
+    if (const AddNode* add = op->value.as<AddNode>()) {
+      a = add->a, b = add->b, reduce_op = builtin::vector_reduce_add();
+    } else if (const MulNode* mul = op->value.as<MulNode>()) {
+      a = mul->a, b = mul->b, reduce_op = builtin::vector_reduce_mul();
+    } else if (const MinNode* min = op->value.as<MinNode>()) {
+      a = min->a, b = min->b, reduce_op = builtin::vector_reduce_min();
+    } else if (const MaxNode* max = op->value.as<MaxNode>()) {
+      a = max->a, b = max->b, reduce_op = builtin::vector_reduce_max();
+    } else {
+      return NullOpt;
+    }
+    auto is_accumulator = [&](const PrimExpr& e) {
+      const BufferLoadNode* load = e.as<BufferLoadNode>();
+      if (load == nullptr || !load->buffer.same_as(op->buffer) ||
+          load->indices.size() != op->indices.size()) {
+        return false;
+      }
+      for (size_t i = 0; i < op->indices.size(); ++i) {
+        if (!deep_equal_(load->indices[i], op->indices[i])) return false;
+      }
+      return true;
+    };
+    if (!is_accumulator(a)) std::swap(a, b);
+    const VarNode* buffer_var = op->buffer->data.get();
+    if (!is_accumulator(a) || UsesVar(b, [&](const VarNode* v) { return v == buffer_var; })) {
+      return NullOpt;
+    }
+    PrimExpr term = this->VisitExpr(b);
+    if (need_scalarize_ || term.dtype().lanes() == 1) {
+      return NullOpt;
+    }
+    PrimExpr reduced = Call(a.dtype(), reduce_op, {term});
+    if (op->value.as<AddNode>()) return a + reduced;
+    if (op->value.as<MulNode>()) return a * reduced;
+    if (op->value.as<MinNode>()) return min(a, reduced);
+    return max(a, reduced);
+  }
+
   // scalarize the statment
   Stmt Scalarize(Stmt stmt) {
+    // The scalarized statement would run regardless of the mask.
+    if (mask_.defined()) {
+      mask_failed_ = true;
+    }
     Var idx(var_->name_hint + ".s", var_->dtype);
     stmt = Substitute(stmt, {{var_, idx}});
     return For(idx, IntImm(var_->dtype, 0), IntImm(var_->dtype, var_lanes_), ForKind::kSerial,
@@ -566,11 +656,83 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   PrimExpr ramp_;
   // flag to mark requirment of scalarization.
   bool need_scalarize_{false};
+  // whether vector conditions of memory accesses are turned into masks.
+  bool predicated_{false};
+  // the mask of the memory accesses, undefined outside of a masked region.
+  PrimExpr mask_;
+  // flag to mark that the masked region cannot be vectorized.
+  bool mask_failed_{false};
   // Let binding
   std::unordered_map<Var, PrimExpr, ObjectPtrHash, ObjectPtrEqual> let_binding_;
   // vectorizable property
   OpAttrMap<TVectorizable> op_vectorizable_ = Op::GetAttrMap<TVectorizable>("TVectorizable");
 
+  // Combine a vector condition with the mask of the enclosing region.
+  PrimExpr CombineMask(const PrimExpr& outer, const PrimExpr& cond) {
+    if (cond.dtype().lanes() != var_lanes_) {
+      return PrimExpr();
+    }
+    return outer.defined() ? (outer && cond) : cond;
+  }
+  // Whether the access reads or writes one contiguous element per lane of the mask.
+  bool IsMaskableAccess(const Buffer& buffer, const Array<PrimExpr>& indices, int lanes) {
+    if (buffer->dtype.lanes() != 1 || lanes != mask_.dtype().lanes()) {
+      return false;
+    }
+    for (size_t i = 0; i + 1 < indices.size(); ++i) {
+      if (indices[i].dtype().is_vector()) {
+        return false;
+      }
+    }
+    const RampNode* ramp = indices.back().as<RampNode>();
+    return ramp && is_one(ramp->stride) && ramp->lanes == lanes;
+  }
+  // Vectorize the branches of an if statement with a vector condition as
+  // masked loads and stores, or return NullOpt if they cannot be masked.
+  Optional<Stmt> MaskIfThenElse(const PrimExpr& condition, const IfThenElseNode* op) {
+    PrimExpr outer_mask = mask_;
+    bool outer_failed = mask_failed_;
+    mask_failed_ = false;
+    Stmt then_case, else_case;
+    mask_ = CombineMask(outer_mask, condition);
+    if (mask_.defined()) {
+      then_case = this->VisitStmt(op->then_case);
+    }
+    if (op->else_case && mask_.defined() && !mask_failed_) {
+      mask_ = CombineMask(outer_mask, !condition);
+      else_case = this->VisitStmt(op->else_case.value());
+    }
+    bool failed = !mask_.defined() || mask_failed_;
+    mask_ = outer_mask;
+    mask_failed_ = outer_failed;
+    if (failed) {
+      return NullOpt;
+    }
+    return else_case.defined() ? SeqStmt({then_case, else_case}) : then_case;
+  }
+  // Vectorize the values of an if_then_else with a vector condition as
+  // masked loads, or return an undefined expression if they cannot be masked.
+  PrimExpr MaskIfThenElseExpr(const PrimExpr& cond, const CallNode* op) {
+    PrimExpr outer_mask = mask_;
+    bool outer_failed = mask_failed_;
+    mask_failed_ = false;
+    PrimExpr t, f;
+    mask_ = CombineMask(outer_mask, cond);
+    if (mask_.defined()) {
+      t = this->VisitExpr(op->args[1]);
+      mask_ = CombineMask(outer_mask, !cond);
+      f = this->VisitExpr(op->args[2]);
+    }
+    bool failed = !mask_.defined() || mask_failed_;
+    mask_ = outer_mask;
+    mask_failed_ = outer_failed;
+    if (failed) {
+      return PrimExpr();
+    }
+    int lanes = std::max(std::max(cond.dtype().lanes(), t.dtype().lanes()), f.dtype().lanes());
+    return Select(cond, BroadcastTo(t, lanes), BroadcastTo(f, lanes));
+  }
+
   // mutate array, with given lane requirement
   // when finished, p_lane updates the lane requirement.
   Array<PrimExpr> MutateArray(Array<PrimExpr> arr, int* p_lanes) {
@@ -633,6 +795,8 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
 
 class LoopVectorizer : public StmtMutator {
  public:
+  explicit LoopVectorizer(bool predicated = false) : predicated_(predicated) {}
+
   Stmt VisitStmt_(const ForNode* op) final {
     if (op->kind == ForKind::kVectorized) {
       ICHECK(is_zero(op->min));
@@ -640,11 +804,16 @@ class LoopVectorizer : public StmtMutator {
       if (!extent_as_int || extent_as_int->value < 1) {
         LOG(FATAL) << "Failed to vectorize loop with extent " << op->extent;
       }
-      return Vectorizer(op->loop_var, static_cast<int>(extent_as_int->value))(op->body);
+      return Vectorizer(op->loop_var, static_cast<int>(extent_as_int->value),
+                        predicated_)(op->body);
     } else {
       return StmtMutator::VisitStmt_(op);
     }
   }
+
+ private:
+  // whether vector conditions of memory accesses are turned into masks.
+  bool predicated_;
 };
 
 Stmt VectorizeLoop(Stmt stmt) { return LoopVectorizer()(std::move(stmt)); }
@@ -666,18 +835,21 @@ Stmt SkipVectorize(Stmt stmt) { return VectorizeSkipper()(std::move(stmt)); }
 
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.vectorize_predicated", Bool);
+
 // TODO(tvm-team): Make it as a target property.
 Pass VectorizeLoop(bool enable_vectorize) {
   auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
     auto* n = f.CopyOnWrite();
     if (enable_vectorize) {
-      n->body = LoopVectorizer()(std::move(n->body));
+      bool predicated = ctx->GetConfig<Bool>("tir.vectorize_predicated", Bool(false)).value();
+      n->body = LoopVectorizer(predicated)(std::move(n->body));
     } else {
       n->body = VectorizeSkipper()(std::move(n->body));
     }
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.VectorizeLoop", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.VectorizeLoop", {}, /*function_local=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.VectorizeLoop").set_body_typed(VectorizeLoop);
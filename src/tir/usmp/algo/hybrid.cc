@@ -0,0 +1,476 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tir/usmp/algo/hybrid.cc
+ * \brief A memory planning algorithm which searches the small conflict components exhaustively,
+ * and anneals the large ones.
+ *
+ * The buffers of two connected components of the conflict graph never conflict, so each
+ * component is planned on its own, from offset 0 of the pools. An order of the buffers is turned
+ * into a placement by placing each buffer, in the first of its pool candidates where it fits the
+ * size hint, at the lowest aligned offset where it overlaps no placed conflicting buffer. Some
+ * order gives an optimal placement in a single pool: the order of the optimal offsets.
+ *
+ * The components of at most kMaxExhaustiveBuffers buffers try all the orders. The others are
+ * annealed from the best of the greedy by size and greedy by conflicts orders, by moving a buffer
+ * which ends at the highest address of its pool earlier in the order. The search of a component
+ * stops at a lower bound of its cost, the memory pressure or the largest size of a clique of
+ * conflicting buffers found greedily, or when it is no larger than the components already
+ * planned. The time budget of the search is given by the tir.usmp.time_budget_ms PassContext
+ * option, unlimited by default; the search is deterministic when the budget is not reached.
+ */
+#include <tvm/ir/transform.h>
+#include <tvm/tir/usmp/algo/greedy.h>
+#include <tvm/tir/usmp/algorithms.h>
+#include <tvm/tir/usmp/utils.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace tir {
+namespace usmp {
+namespace algo {
+
+/*! \brief The largest components whose orders are all tried. */
+constexpr size_t kMaxExhaustiveBuffers = 7;
+/*! \brief The number of annealing steps per buffer of a component. */
+constexpr int64_t kAnnealingStepsPerBuffer = 64;
+/*! \brief The number of buffers placed by the annealing of a component, at most. */
+constexpr int64_t kMaxAnnealingPlacements = 4000000;
+/*! \brief The number of annealing steps of a component, at least. */
+constexpr int64_t kMinAnnealingSteps = 200;
+
+class HybridAllocator : public GreedyBase {
+ public:
+  HybridAllocator(int64_t memory_pressure, int64_t time_budget_ms)
+      : memory_pressure_(memory_pressure) {
+    if (time_budget_ms > 0) {
+      deadline_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(time_budget_ms);
+      has_deadline_ = true;
+    }
+  }
+
+  Map<BufferInfo, PoolAllocation> PlanMemory(const Array<BufferInfo>& buffer_info_arr) final {
+    Map<BufferInfo, PoolAllocation> result;
+    if (buffer_info_arr.empty()) {
+      return result;
+    }
+    Index(buffer_info_arr);
+    std::vector<int> pool_of(buffers_.size(), -1);
+    std::vector<int64_t> offset_of(buffers_.size(), 0);
+    std::vector<int64_t> planned_highest(pools_.size(), 0);
+    for (const std::vector<int>& component : Components()) {
+      Placement best = PlanComponent(component, planned_highest);
+      for (size_t i = 0; i < component.size(); ++i) {
+        int buf = component[i];
+        pool_of[buf] = best.pool[i];
+        offset_of[buf] = best.offset[i];
+        if (best.pool[i] >= 0) {
+          planned_highest[best.pool[i]] =
+              std::max(planned_highest[best.pool[i]], best.offset[i] + buffers_[buf].size);
+        }
+      }
+    }
+    for (size_t buf = 0; buf < buffers_.size(); ++buf) {
+      const BufferInfo& buffer_info = buffer_info_arr[buf];
+      if (pool_of[buf] < 0) {
+        // Reports the error of a buffer which fits in none of its pools
+        SelectPlacementPool(buffer_info, {});
+      }
+      result.Set(buffer_info, PoolAllocation(pools_[pool_of[buf]], Integer(offset_of[buf])));
+    }
+    return result;
+  }
+
+ private:
+  struct Buffer {
+    int64_t size;
+    int alignment;
+    std::string name;
+    /*! \brief The indices of the conflicting buffers, sorted. */
+    std::vector<int> conflicts;
+    /*! \brief The indices of the pool candidates, in order of preference. */
+    std::vector<int> pools;
+  };
+
+  /*! \brief The placement of the buffers of a component, in the order of the component. */
+  struct Placement {
+    std::vector<int> pool;
+    std::vector<int64_t> offset;
+    /*! \brief The number of buffers which fit in none of their pools. */
+    int64_t num_unplaced{0};
+    /*! \brief The highest address of each pool. */
+    std::vector<int64_t> highest;
+    /*! \brief The sum of the highest addresses of the pools. */
+    int64_t cost{0};
+
+    bool BetterThan(const Placement& other) const {
+      return num_unplaced != other.num_unplaced ? num_unplaced < other.num_unplaced
+                                                : cost < other.cost;
+    }
+  };
+
+  /*! \brief Converts the buffers and their pools to indices. */
+  void Index(const Array<BufferInfo>& buffer_info_arr) {
+    std::unordered_map<const BufferInfoNode*, int> buffer_index;
+    for (const BufferInfo& buffer_info : buffer_info_arr) {
+      buffer_index.emplace(buffer_info.operator->(), buffer_index.size());
+    }
+    std::unordered_map<PoolInfo, int, ObjectPtrHash, ObjectPtrEqual> pool_index;
+    for (const BufferInfo& buffer_info : buffer_info_arr) {
+      ICHECK(buffer_info->pool_candidates.size())
+          << "Cannot process buffer \"" << buffer_info->name_hint << "\" with no pool candidates";
+      Buffer buf;
+      buf.size = buffer_info->size_bytes->value;
+      buf.alignment = std::max<int>(1, buffer_info->alignment->value);
+      buf.name = buffer_info->name_hint;
+      for (const ObjectRef& conflict : buffer_info->conflicts) {
+        auto it = buffer_index.find(conflict.as<BufferInfoNode>());
+        // The conflicts with buffers planned elsewhere don't constrain this plan
+        if (it != buffer_index.end() && it->second != static_cast<int>(buffers_.size())) {
+          buf.conflicts.push_back(it->second);
+        }
+      }
+      std::sort(buf.conflicts.begin(), buf.conflicts.end());
+      buf.conflicts.erase(std::unique(buf.conflicts.begin(), buf.conflicts.end()),
+                          buf.conflicts.end());
+      for (const PoolInfo& pool_info : buffer_info->pool_candidates) {
+        auto it = pool_index.emplace(pool_info, pools_.size()).first;
+        if (it->second == static_cast<int>(pools_.size())) {
+          pools_.push_back(pool_info);
+        }
+        buf.pools.push_back(it->second);
+      }
+      buffers_.push_back(std::move(buf));
+    }
+    position_.assign(buffers_.size(), -1);
+    // The conflicts are made symmetric, as the placement only looks at the placed buffers
+    for (size_t i = 0; i < buffers_.size(); ++i) {
+      for (int j : buffers_[i].conflicts) {
+        std::vector<int>& other = buffers_[j].conflicts;
+        auto it = std::lower_bound(other.begin(), other.end(), static_cast<int>(i));
+        if (it == other.end() || *it != static_cast<int>(i)) {
+          other.insert(it, i);
+        }
+      }
+    }
+  }
+
+  /*! \return The connected components of the conflict graph, the largest first. */
+  std::vector<std::vector<int>> Components() const {
+    std::vector<int> component_of(buffers_.size(), -1);
+    std::vector<std::vector<int>> components;
+    for (size_t root = 0; root < buffers_.size(); ++root) {
+      if (component_of[root] >= 0) continue;
+      std::vector<int> component{static_cast<int>(root)};
+      component_of[root] = components.size();
+      for (size_t i = 0; i < component.size(); ++i) {
+        for (int conflict : buffers_[component[i]].conflicts) {
+          if (component_of[conflict] < 0) {
+            component_of[conflict] = components.size();
+            component.push_back(conflict);
+          }
+        }
+      }
+      components.push_back(std::move(component));
+    }
+    std::vector<int64_t> weight(components.size(), 0);
+    for (size_t i = 0; i < components.size(); ++i) {
+      weight[i] = CliqueBound(components[i]);
+    }
+    std::vector<size_t> ids(components.size());
+    std::iota(ids.begin(), ids.end(), 0);
+    std::stable_sort(ids.begin(), ids.end(), [&](size_t a, size_t b) {
+      return weight[a] != weight[b] ? weight[a] > weight[b]
+                                    : components[a].size() > components[b].size();
+    });
+    std::vector<std::vector<int>> sorted;
+    for (size_t id : ids) {
+      sorted.push_back(std::move(components[id]));
+    }
+    return sorted;
+  }
+
+  bool Conflicts(int a, int b) const {
+    const std::vector<int>& conflicts = buffers_[a].conflicts;
+    return std::binary_search(conflicts.begin(), conflicts.end(), b);
+  }
+
+  /*!
+   * \return The total size of a clique of conflicting buffers of the component, found greedily
+   * from each buffer. All the buffers of a clique are live at once.
+   */
+  int64_t CliqueBound(const std::vector<int>& component) const {
+    int64_t bound = 0;
+    std::vector<int> clique;
+    for (int root : component) {
+      std::vector<int> candidates = buffers_[root].conflicts;
+      std::sort(candidates.begin(), candidates.end(),
+                [this](int a, int b) { return buffers_[a].size > buffers_[b].size; });
+      clique.assign(1, root);
+      int64_t weight = buffers_[root].size;
+      for (int candidate : candidates) {
+        bool in_clique = std::all_of(clique.begin() + 1, clique.end(),
+                                     [&](int member) { return Conflicts(candidate, member); });
+        if (in_clique) {
+          clique.push_back(candidate);
+          weight += buffers_[candidate].size;
+        }
+      }
+      bound = std::max(bound, weight);
+    }
+    return bound;
+  }
+
+  /*! \brief Places the buffers of a component in \p order, given as positions in the component. */
+  Placement Place(const std::vector<int>& component, const std::vector<int>& order) {
+    Placement placement;
+    placement.pool.assign(component.size(), -1);
+    placement.offset.assign(component.size(), 0);
+    placement.highest.assign(pools_.size(), 0);
+    for (size_t i = 0; i < component.size(); ++i) {
+      position_[component[i]] = i;
+    }
+    std::vector<std::pair<int64_t, int64_t>> intervals;
+    for (int pos : order) {
+      const Buffer& buf = buffers_[component[pos]];
+      for (int pool : buf.pools) {
+        intervals.clear();
+        for (int conflict : buf.conflicts) {
+          int conflict_pos = position_[conflict];
+          if (placement.pool[conflict_pos] == pool) {
+            int64_t start = placement.offset[conflict_pos];
+            intervals.emplace_back(start, start + buffers_[conflict].size);
+          }
+        }
+        std::sort(intervals.begin(), intervals.end());
+        // The lowest aligned gap between the placed conflicting buffers
+        int64_t offset = 0;
+        for (const auto& interval : intervals) {
+          if (interval.second <= offset) continue;
+          if (offset + buf.size <= interval.first) break;
+          offset = round_up_to_byte_alignment(interval.second, buf.alignment);
+        }
+        if (IsValidPlacement(pools_[pool], offset, buf.size)) {
+          placement.pool[pos] = pool;
+          placement.offset[pos] = offset;
+          placement.highest[pool] = std::max(placement.highest[pool], offset + buf.size);
+          break;
+        }
+      }
+      if (placement.pool[pos] < 0) {
+        ++placement.num_unplaced;
+      }
+    }
+    placement.cost = std::accumulate(placement.highest.begin(), placement.highest.end(),
+                                     static_cast<int64_t>(0));
+    return placement;
+  }
+
+  /*! \return Whether the search of a component can stop at \p placement. */
+  static bool GoodEnough(const Placement& placement, int64_t bound,
+                         const std::vector<int64_t>& planned_highest) {
+    if (placement.num_unplaced != 0) {
+      return false;
+    }
+    if (placement.cost <= bound) {
+      return true;
+    }
+    // The pools are shared with the components already planned, which overlap this one
+    for (size_t pool = 0; pool < planned_highest.size(); ++pool) {
+      if (placement.highest[pool] > planned_highest[pool]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool OutOfTime() const {
+    return has_deadline_ && std::chrono::steady_clock::now() >= deadline_;
+  }
+
+  /*! \return The order of the positions of a component, sorted by \p less of the buffers. */
+  template <typename Less>
+  std::vector<int> SortedOrder(const std::vector<int>& component, Less less) const {
+    std::vector<int> order(component.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+      const Buffer& lhs = buffers_[component[a]];
+      const Buffer& rhs = buffers_[component[b]];
+      return less(lhs, rhs);
+    });
+    return order;
+  }
+
+  Placement PlanComponent(const std::vector<int>& component,
+                          const std::vector<int64_t>& planned_highest) {
+    // No plan is below the bytes live at once, which are in one of the components
+    int64_t bound = std::max(CliqueBound(component), memory_pressure_);
+    // The same orders as greedy_by_size and greedy_by_conflicts, names breaking the ties
+    std::vector<int> order = SortedOrder(component, [](const Buffer& a, const Buffer& b) {
+      if (a.size != b.size) return a.size > b.size;
+      if (a.conflicts.size() != b.conflicts.size()) return a.conflicts.size() > b.conflicts.size();
+      return a.name > b.name;
+    });
+    Placement best = Place(component, order);
+    std::vector<int> best_order = order;
+    if (GoodEnough(best, bound, planned_highest)) {
+      return best;
+    }
+    std::vector<int> by_conflicts = SortedOrder(component, [](const Buffer& a, const Buffer& b) {
+      if (a.conflicts.size() != b.conflicts.size()) return a.conflicts.size() > b.conflicts.size();
+      if (a.size != b.size) return a.size > b.size;
+      return a.name > b.name;
+    });
+    Placement placement = Place(component, by_conflicts);
+    if (placement.BetterThan(best)) {
+      best = std::move(placement);
+      best_order = by_conflicts;
+      if (GoodEnough(best, bound, planned_highest)) {
+        return best;
+      }
+    }
+
+    if (component.size() <= kMaxExhaustiveBuffers) {
+      // Permutes the positions in the greedy by size order, starting from it
+      std::vector<int> permutation(order.size());
+      std::iota(permutation.begin(), permutation.end(), 0);
+      std::vector<int> permuted(order.size());
+      while (std::next_permutation(permutation.begin(), permutation.end()) && !OutOfTime()) {
+        for (size_t i = 0; i < permutation.size(); ++i) {
+          permuted[i] = order[permutation[i]];
+        }
+        Placement placement = Place(component, permuted);
+        if (placement.BetterThan(best)) {
+          best = std::move(placement);
+          if (GoodEnough(best, bound, planned_highest)) {
+            break;
+          }
+        }
+      }
+      return best;
+    }
+    return Anneal(component, best_order, std::move(best), bound, planned_highest);
+  }
+
+  Placement Anneal(const std::vector<int>& component, std::vector<int> order, Placement best,
+                   int64_t bound, const std::vector<int64_t>& planned_highest) {
+    std::mt19937 rng(0);
+    Placement current = best;
+    int64_t num_buffers = component.size();
+    int64_t num_steps =
+        std::min(kAnnealingStepsPerBuffer * num_buffers,
+                 std::max(kMinAnnealingSteps, kMaxAnnealingPlacements / num_buffers));
+    // The temperature starts at a few percent of the cost, and decreases geometrically
+    double initial_temperature = std::max(1.0, 0.02 * static_cast<double>(current.cost));
+    double cooling = std::pow(1e-3, 1.0 / static_cast<double>(num_steps));
+    double temperature = initial_temperature;
+    std::vector<int> critical;
+    std::vector<int> order_index(order.size());
+    for (int64_t step = 0; step < num_steps; ++step, temperature *= cooling) {
+      if ((step & 15) == 0 && OutOfTime()) {
+        break;
+      }
+      // The buffers which end at the highest address of a pool, or which are not placed
+      critical.clear();
+      for (size_t pos = 0; pos < component.size(); ++pos) {
+        int pool = current.pool[pos];
+        if (pool < 0 ||
+            current.offset[pos] + buffers_[component[pos]].size == current.highest[pool]) {
+          critical.push_back(pos);
+        }
+      }
+      for (size_t i = 0; i < order.size(); ++i) {
+        order_index[order[i]] = i;
+      }
+      int moved = critical[rng() % critical.size()];
+      size_t from = order_index[moved];
+      if (from == 0) {
+        continue;
+      }
+      // Moves the buffer before a conflicting buffer placed earlier, or anywhere earlier
+      std::vector<int> earlier;
+      for (int conflict : buffers_[component[moved]].conflicts) {
+        size_t index = order_index[position_[conflict]];
+        if (index < from) {
+          earlier.push_back(index);
+        }
+      }
+      size_t to = earlier.empty() || rng() % 4 == 0 ? rng() % from : earlier[rng() % earlier.size()];
+      std::vector<int> candidate = order;
+      std::rotate(candidate.begin() + to, candidate.begin() + from, candidate.begin() + from + 1);
+      Placement placement = Place(component, candidate);
+      bool accept = placement.BetterThan(current);
+      if (!accept && placement.num_unplaced == current.num_unplaced) {
+        double delta = static_cast<double>(placement.cost - current.cost);
+        accept = std::uniform_real_distribution<double>(0.0, 1.0)(rng) <
+                 std::exp(-delta / temperature);
+      }
+      if (!accept) {
+        continue;
+      }
+      order = std::move(candidate);
+      current = std::move(placement);
+      if (current.BetterThan(best)) {
+        best = current;
+        if (GoodEnough(best, bound, planned_highest)) {
+          break;
+        }
+      }
+    }
+    return best;
+  }
+
+  int64_t memory_pressure_;
+  std::vector<Buffer> buffers_;
+  std::vector<PoolInfo> pools_;
+  /*! \brief The position of each buffer in the component being placed. */
+  std::vector<int> position_;
+  std::chrono::steady_clock::time_point deadline_;
+  bool has_deadline_{false};
+};
+
+Map<BufferInfo, PoolAllocation> Hybrid(const Array<BufferInfo>& buffer_info_arr,
+                                       const Integer& memory_pressure) {
+  Integer time_budget_ms = transform::PassContext::Current()
+                              ->GetConfig<Integer>(kUSMPTimeBudgetOption, Integer(0))
+                              .value();
+  return HybridAllocator(memory_pressure.IntValue(), time_budget_ms.IntValue())
+      .PlanMemory(buffer_info_arr);
+}
+
+TVM_REGISTER_GLOBAL("tir.usmp.algo.hybrid")
+    .set_body_typed([](Array<BufferInfo> buffer_info_arr, Integer memory_pressure) {
+      return Hybrid(buffer_info_arr, memory_pressure);
+    });
+
+}  // namespace algo
+}  // namespace usmp
+}  // namespace tir
+}  // namespace tvm
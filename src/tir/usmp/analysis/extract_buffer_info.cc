@@ -34,6 +34,8 @@
 #include <tvm/tir/usmp/analysis.h>
 #include <tvm/tir/usmp/utils.h>
 
+#include <algorithm>
+#include <limits>
 #include <stack>
 
 #include "../../../runtime/thread_storage_scope.h"
@@ -80,6 +82,7 @@ class BufferInfoExtractor : public StmtExprVisitor {
   void VisitStmt_(const BufferStoreNode* op) override;
   void VisitStmt_(const ForNode* op) override;
 
+  void RecordAccess(const Var& buffer_var);
   void UpdateAliases(const Array<PrimExpr>& args, const PrimFunc& func);
   void RecordAllocateNodeInfo(const AllocateNode* op);
   void RecordAllocateConstNodeInfo(const AllocateConstNode* op);
@@ -130,6 +133,14 @@ class BufferInfoExtractor : public StmtExprVisitor {
    * \brief Indicates a count of stmts visited so far to use as a metric of liveness
    */
   int current_stmt_idx_ = 0;
+  /*!
+   * \brief The product of the extents of the enclosing loops, the constant ones
+   */
+  int64_t loop_trip_count_ = 1;
+  /*!
+   * \brief The number of accesses to each allocate node, counting the loop iterations
+   */
+  std::unordered_map<tir::Stmt, int64_t, ObjectPtrHash, ObjectPtrEqual> access_counts_;
   /*!
    * \brief This structure is supposed to contain information around the scope
    * the visitor is currently in.
@@ -361,8 +372,16 @@ void BufferInfoExtractor::VisitStmt_(const ForNode* op) {
   }
   Call current_call = scope_stack_.top().call;
   PrimFunc current_primfunc = scope_stack_.top().func;
+  int64_t outer_trip_count = loop_trip_count_;
+  if (const auto* extent = op->extent.as<IntImmNode>()) {
+    int64_t max_trip_count = std::numeric_limits<int64_t>::max();
+    loop_trip_count_ = extent->value > 0 && loop_trip_count_ > max_trip_count / extent->value
+                           ? max_trip_count
+                           : loop_trip_count_ * std::max<int64_t>(extent->value, 0);
+  }
   scope_stack_.push(si);
   StmtExprVisitor::VisitStmt_(op);
+  loop_trip_count_ = outer_trip_count;
   // Extending the liveness to beginning of for-loop next and end of the current for-loop
   for (const Allocate& allocate : scope_stack_.top().allocate_nodes) {
     AllocateInfo ai = allocate_infos[allocate->buffer_var];
@@ -384,13 +403,24 @@ void BufferInfoExtractor::VisitStmt_(const ForNode* op) {
   scope_stack_.pop();
 }
 
+void BufferInfoExtractor::RecordAccess(const Var& buffer_var) {
+  auto it = allocate_infos.find(buffer_var);
+  if (it != allocate_infos.end()) {
+    int64_t& access_count = access_counts_[it->second.Allocate];
+    access_count = std::min(access_count, std::numeric_limits<int64_t>::max() - loop_trip_count_) +
+                   loop_trip_count_;
+  }
+}
+
 void BufferInfoExtractor::VisitExpr_(const BufferLoadNode* op) {
   this->VisitExpr(op->buffer->data);
+  RecordAccess(op->buffer->data);
   StmtExprVisitor::VisitExpr_(op);
 }
 
 void BufferInfoExtractor::VisitStmt_(const BufferStoreNode* op) {
   this->VisitExpr(op->buffer->data);
+  RecordAccess(op->buffer->data);
   StmtExprVisitor::VisitStmt_(op);
 }
 
@@ -502,6 +532,13 @@ void BufferInfoExtractor::VisitExpr_(const CallNode* op) {
 BufferInfoAnalysis BufferInfoExtractor::operator()(const PrimFunc& main_func) {
   VisitPrimFunc(main_func, Call());
 
+  for (const auto& kv : buffer_info_map_) {
+    auto it = access_counts_.find(kv.second);
+    if (it != access_counts_.end()) {
+      kv.first->access_count = IntImm(DataType::Int(64), it->second);
+    }
+  }
+
   // Create a vector of liveness events
   // associated with each BufferNodes.
   std::vector<LivenessEvent> le_events_timeline;
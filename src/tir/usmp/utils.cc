@@ -32,6 +32,10 @@
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/usmp/utils.h>
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
 namespace tvm {
 namespace tir {
 namespace usmp {
@@ -44,6 +48,7 @@ BufferInfo::BufferInfo(String name_hint, Integer size_bytes, Array<PoolInfo> poo
   bufinfo_node->pool_candidates = pool_candidates;
   bufinfo_node->alignment = alignment;
   bufinfo_node->kind = kind;
+  bufinfo_node->access_count = 0;
   data_ = std::move(bufinfo_node);
 }
 
@@ -54,11 +59,14 @@ void BufferInfoNode::SetConflicts(Array<ObjectRef> conflicting_buffer_info_objs)
 TVM_REGISTER_NODE_TYPE(BufferInfoNode);
 TVM_REGISTER_GLOBAL("tir.usmp.BufferInfo")
     .set_body_typed([](String name_hint, Integer size_bytes, Array<PoolInfo> pool_candidates,
-                       Integer alignment) {
-      if (!alignment.defined()) {
-        return BufferInfo(name_hint, size_bytes, pool_candidates);
+                       Integer alignment, Integer access_count) {
+      BufferInfo buffer_info = alignment.defined()
+                                   ? BufferInfo(name_hint, size_bytes, pool_candidates, alignment)
+                                   : BufferInfo(name_hint, size_bytes, pool_candidates);
+      if (access_count.defined()) {
+        buffer_info->access_count = access_count;
       }
-      return BufferInfo(name_hint, size_bytes, pool_candidates, alignment);
+      return buffer_info;
     });
 TVM_REGISTER_GLOBAL("tir.usmp.BufferInfoSetConflicts")
     .set_body_method<BufferInfo>(&BufferInfoNode::SetConflicts);
@@ -74,6 +82,7 @@ TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
                 << "name_hint=" << node->name_hint << ",\n  size_bytes=" << node->size_bytes
                 << ",\n  pool_candidates=" << node->pool_candidates
                 << ",\n  alignment=" << node->alignment << ",\n  kind=" << toString[node->kind]
+                << ",\n  access_count=" << node->access_count
                 << ",\n  conflicts=" << node->conflicts.size() << ")";
     });
 
@@ -154,6 +163,66 @@ Array<BufferInfo> ConvertToArrayOfBufferInfo(const Map<BufferInfo, Stmt>& buffer
   return ret;
 }
 
+void PrioritizePoolCandidatesByAccessFrequency(const Array<BufferInfo>& buffer_info_arr) {
+  std::vector<BufferInfo> buffer_infos(buffer_info_arr.begin(), buffer_info_arr.end());
+  // The most accesses per byte first, then the smallest, so that more buffers fit
+  std::sort(buffer_infos.begin(), buffer_infos.end(),
+            [](const BufferInfo& a, const BufferInfo& b) {
+              double a_density = static_cast<double>(a->access_count.IntValue()) /
+                                 std::max<int64_t>(1, a->size_bytes.IntValue());
+              double b_density = static_cast<double>(b->access_count.IntValue()) /
+                                 std::max<int64_t>(1, b->size_bytes.IntValue());
+              if (a_density != b_density) return a_density > b_density;
+              if (a->size_bytes.IntValue() != b->size_bytes.IntValue()) {
+                return a->size_bytes.IntValue() < b->size_bytes.IntValue();
+              }
+              return a->name_hint < b->name_hint;
+            });
+  // The pool kept first by each buffer, starting with the buffers of a single candidate
+  std::unordered_map<const BufferInfoNode*, PoolInfo> kept_pool;
+  for (const BufferInfo& buffer_info : buffer_infos) {
+    if (buffer_info->pool_candidates.size() == 1) {
+      kept_pool[buffer_info.operator->()] = buffer_info->pool_candidates[0];
+    }
+  }
+  for (const BufferInfo& buffer_info : buffer_infos) {
+    if (buffer_info->pool_candidates.size() <= 1) continue;
+    Array<PoolInfo> pool_candidates;
+    bool kept = false;
+    for (size_t i = 0; i < buffer_info->pool_candidates.size(); ++i) {
+      const PoolInfo& pool_info = buffer_info->pool_candidates[i];
+      int64_t size_hint_bytes = pool_info->size_hint_bytes.IntValue();
+      if (kept || size_hint_bytes == kUnrestrictedPoolSizeHint ||
+          i + 1 == buffer_info->pool_candidates.size()) {
+        if (!kept) {
+          kept_pool[buffer_info.operator->()] = pool_info;
+          kept = true;
+        }
+        pool_candidates.push_back(pool_info);
+        continue;
+      }
+      // The lowest offset in the pool is below the sizes of the conflicts placed in it
+      int64_t live_bytes = buffer_info->size_bytes.IntValue();
+      for (const ObjectRef& conflict : buffer_info->conflicts) {
+        const auto* conflict_info = conflict.as<BufferInfoNode>();
+        auto it = kept_pool.find(conflict_info);
+        if (it != kept_pool.end() && it->second == pool_info) {
+          live_bytes += conflict_info->size_bytes.IntValue() + conflict_info->alignment.IntValue();
+        }
+      }
+      if (live_bytes <= size_hint_bytes) {
+        kept_pool[buffer_info.operator->()] = pool_info;
+        pool_candidates.push_back(pool_info);
+        kept = true;
+      }
+    }
+    buffer_info->pool_candidates = pool_candidates;
+  }
+}
+
+TVM_REGISTER_GLOBAL("tir.usmp.PrioritizePoolCandidatesByAccessFrequency")
+    .set_body_typed(PrioritizePoolCandidatesByAccessFrequency);
+
 Map<Stmt, PoolAllocation> AssignStmtPoolAllocations(
     const Map<BufferInfo, Stmt>& buffer_info_to_stmt,
     const Map<BufferInfo, PoolAllocation>& buffer_info_to_pool_allocation) {
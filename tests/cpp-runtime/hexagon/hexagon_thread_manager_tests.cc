@@ -359,3 +359,53 @@ TEST_F(HexagonThreadManagerTest, threads_for_resource_types) {
   thread = reinterpret_cast<TVMStreamHandle>(6);
   EXPECT_THROW(thread_manager->GetResourceTypeForStreamHandle(thread), InternalError);
 }
+
+struct ParallelSum {
+  std::vector<int> task_ids;
+  std::atomic<int> num_task{0};
+};
+
+int parallel_sum_task(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  ParallelSum* sum = static_cast<ParallelSum*>(cdata);
+  sum->task_ids[task_id] += task_id;
+  sum->num_task = penv->num_task;
+  return 0;
+}
+
+int parallel_barrier_task(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  ParallelSum* sum = static_cast<ParallelSum*>(cdata);
+  sum->task_ids[task_id] = 1;
+  TVMBackendParallelBarrier(task_id, penv);
+  // all the tasks have written before the barrier
+  for (int i = 0; i < penv->num_task; i++) {
+    CHECK_EQ(sum->task_ids[i], 1);
+  }
+  return 0;
+}
+
+// Without HVX threads, the tasks run in one task on the calling thread
+TEST_F(HexagonThreadManagerTest, parallel_launch_no_hvx) {
+  ParallelSum sum;
+  sum.task_ids.resize(1);
+  CHECK_EQ(htm->ParallelLaunch(parallel_sum_task, &sum, 4), 0);
+  CHECK_EQ(sum.num_task, 1);
+  CHECK_EQ(sum.task_ids[0], 0);
+}
+
+TEST_F(HexagonThreadManagerTest, parallel_launch_hvx) {
+  HexagonThreadManager* thread_manager = HexagonDeviceAPI::Global()->ThreadManager();
+  for (int num_task : {2, 4, 13}) {
+    ParallelSum sum;
+    sum.task_ids.resize(num_task);
+    CHECK_EQ(thread_manager->ParallelLaunch(parallel_sum_task, &sum, num_task), 0);
+    CHECK_EQ(sum.num_task, num_task);
+    for (int i = 0; i < num_task; i++) {
+      CHECK_EQ(sum.task_ids[i], i);
+    }
+  }
+
+  // one task per HVX thread
+  ParallelSum sum;
+  sum.task_ids.resize(4);
+  CHECK_EQ(thread_manager->ParallelLaunch(parallel_barrier_task, &sum, 0), 0);
+}
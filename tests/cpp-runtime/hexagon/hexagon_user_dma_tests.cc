@@ -349,3 +349,41 @@ TEST_F(HexagonUserDMATest, sync_dma_bypass_) {
     ASSERT_EQ(src_char[i], dst_char[i]);
   }
 }
+
+TEST_F(HexagonUserDMATest, bad_copy_2d) {
+  uint32_t width = 128;
+  uint32_t height = 16;
+  ASSERT_NE(user_dma->Copy2D(queue_id, dst, src, 0, height, width, width, DISABLE_BYPASS),
+            DMA_SUCCESS);
+  ASSERT_NE(user_dma->Copy2D(queue_id, dst, src, 0x10000, 1, 0, 0, DISABLE_BYPASS), DMA_SUCCESS);
+  ASSERT_NE(user_dma->Copy2D(queue_id, dst, src, width, height, width / 2, width, DISABLE_BYPASS),
+            DMA_SUCCESS);
+  ASSERT_NE(user_dma->Copy2D(queue_id, dst, src, width, height, width, 0x10000, DISABLE_BYPASS),
+            DMA_SUCCESS);
+}
+
+TEST_F(HexagonUserDMATest, sync_dma_2d) {
+  // copy the first half of each of the 64 rows of src to a contiguous tile of dst
+  uint32_t height = 64;
+  uint32_t src_stride = length / height;
+  uint32_t width = src_stride / 2;
+  for (uint32_t i = 0; i < length; ++i) {
+    src_char[i] = static_cast<char>(i % 251);
+  }
+
+  ret = user_dma->Copy2D(queue_id, dst, src, width, height, width, src_stride, DISABLE_BYPASS);
+  ASSERT_EQ(ret, DMA_SUCCESS);
+
+  // wait for DMA to complete
+  user_dma->Wait(queue_id, 0);
+
+  // verify the tile, and that no byte past it was written
+  for (uint32_t row = 0; row < height; ++row) {
+    for (uint32_t col = 0; col < width; ++col) {
+      ASSERT_EQ(src_char[row * src_stride + col], dst_char[row * width + col]);
+    }
+  }
+  for (uint32_t i = height * width; i < length; ++i) {
+    ASSERT_EQ(0, dst_char[i]);
+  }
+}
@@ -22,6 +22,7 @@
 #include <tvm/runtime/container/adt.h>
 #include <tvm/runtime/container/array.h>
 #include <tvm/runtime/container/map.h>
+#include <tvm/runtime/container/shape_tuple.h>
 #include <tvm/runtime/container/string.h>
 #include <tvm/tir/function.h>
 #include <tvm/tir/op.h>
@@ -32,6 +33,7 @@
 #include <iterator>
 #include <new>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -111,6 +113,30 @@ TEST(ADT, Constructor) {
   ASSERT_EQ(Downcast<ADT>(v1[1]).size(), 0);
 }
 
+TEST(ADT, PooledAllocation) {
+  const Object* freed;
+  {
+    ADT v{1, {ADT::Tuple(std::vector<ObjectRef>()), ADT::Tuple(std::vector<ObjectRef>())}};
+    freed = v.get();
+  }
+  // The memory of a freed object is reused by the next one of its size on the thread
+  ADT v{2, {String("a"), String("b")}};
+  ASSERT_EQ(v.get(), freed);
+  ASSERT_EQ(v.tag(), 2);
+  ASSERT_EQ(Downcast<String>(v[1]), "b");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    // Objects freed by another thread than the one that created them go to its pool
+    threads.emplace_back([v]() {
+      for (int i = 0; i < 10000; ++i) {
+        ADT copy = ADT::Tuple(std::vector<ObjectRef>{v[0], v[1], ShapeTuple({i, i})});
+        ASSERT_EQ(Downcast<ShapeTuple>(copy[2])[1], i);
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+}
+
 TEST(InplaceArrayBase, BadExceptionSafety) {
   auto wrong_init = []() {
     TestErrorSwitch f1{false};
@@ -24,6 +24,10 @@
 #include <tvm/tir/expr.h>
 #include <tvm/tir/transform.h>
 
+#include <atomic>
+#include <string>
+#include <thread>
+
 TEST(PackedFunc, Basic) {
   using namespace tvm;
   using namespace tvm::tir;
@@ -319,3 +323,40 @@ TEST(TypedPackedFunc, RValue) {
     tf(1, true);
   }
 }
+
+TEST(Registry, ConcurrentLookup) {
+  using namespace tvm::runtime;
+  const int num_funcs = 4096;
+  auto name = [](int i) { return "testing.registry_concurrent_" + std::to_string(i); };
+  std::atomic<bool> done{false};
+  std::thread reader([&]() {
+    // The functions registered so far remain visible while the table grows
+    while (!done.load()) {
+      const PackedFunc* f = Registry::Get(name(0));
+      if (f != nullptr) EXPECT_NE(*f, nullptr);
+    }
+  });
+  for (int i = 0; i < num_funcs; ++i) {
+    Registry::Register(name(i)).set_body_typed([i]() { return i; });
+  }
+  done = true;
+  reader.join();
+  for (int i = 0; i < num_funcs; ++i) {
+    const PackedFunc* f = Registry::Get(name(i));
+    ASSERT_NE(f, nullptr);
+    EXPECT_EQ((*f)().operator int(), i);
+  }
+  EXPECT_TRUE(Registry::Remove(name(1)));
+  EXPECT_FALSE(Registry::Remove(name(1)));
+  EXPECT_EQ(Registry::Get(name(1)), nullptr);
+  Registry::Register(name(1)).set_body_typed([]() { return -1; });
+  EXPECT_EQ((*Registry::Get(name(1)))().operator int(), -1);
+  // A function is only published once its body is set
+  Registry& unset = Registry::Register(name(num_funcs));
+  EXPECT_EQ(Registry::Get(name(num_funcs)), nullptr);
+  unset.set_body_typed([]() { return 0; });
+  EXPECT_NE(Registry::Get(name(num_funcs)), nullptr);
+  for (int i = 0; i <= num_funcs; ++i) {
+    Registry::Remove(name(i));
+  }
+}
@@ -22,6 +22,7 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/support/parallel_for.h>
 
+#include <atomic>
 #include <thread>
 #include <vector>
 
@@ -158,3 +159,99 @@ TEST(ParallelForDynamic, ExceptionOnArbitrary) {
   }
   ICHECK(exception);
 }
+
+TEST(ParallelForDynamic, ReuseThreads) {
+  using tvm::support::parallel_for_dynamic;
+  int num_threads = 4;
+  std::vector<std::thread::id> first(num_threads), second(num_threads);
+  auto record = [num_threads](std::vector<std::thread::id>* ids) {
+    std::atomic<int> arrived{0};
+    parallel_for_dynamic(0, num_threads, num_threads, [&](int thread_id, int task_id) {
+      (*ids)[thread_id] = std::this_thread::get_id();
+      // Hold every thread until all of them picked a task, so each thread_id is used once
+      ++arrived;
+      while (arrived < num_threads) {
+        std::this_thread::yield();
+      }
+    });
+  };
+  record(&first);
+  record(&second);
+  for (int i = 0; i < num_threads; i++) {
+    ICHECK(first[i] == second[i]);
+  }
+}
+
+TEST(ParallelForDynamic, Nested) {
+  using tvm::support::parallel_for_dynamic;
+  std::atomic<int> count{0};
+  parallel_for_dynamic(0, 8, 4, [&count](int, int) {
+    parallel_for_dynamic(0, 8, 2, [&count](int, int) { ++count; });
+  });
+  ICHECK_EQ(count, 64);
+}
+
+TEST(ParallelForGuided, Basic) {
+  using tvm::support::parallel_for_guided;
+  int num_threads = 3;
+  for (int min_chunk_size : {1, 7, 2000}) {
+    std::vector<std::atomic<int>> visited(1000);
+    parallel_for_guided(
+        10, 1010, num_threads,
+        [&visited, num_threads](int thread_id, int i) {
+          ICHECK_LT(thread_id, num_threads);
+          ++visited[i - 10];
+        },
+        min_chunk_size);
+    for (int i = 0; i < 1000; i++) {
+      ICHECK_EQ(visited[i], 1);
+    }
+  }
+}
+
+TEST(ParallelForGuided, CostHints) {
+  using tvm::support::parallel_for_guided;
+  int n = 1000;
+  std::vector<double> costs(n, 1.0);
+  costs[500] = 1e6;
+  costs[3] = 0.0;
+  std::vector<std::atomic<int>> visited(n);
+  std::atomic<int> order{0};
+  int expensive_order = -1;
+  parallel_for_guided(0, n, 1, costs, [&](int thread_id, int i) {
+    if (i == 500) {
+      expensive_order = order;
+    }
+    ++order;
+    ++visited[i];
+  });
+  // The most expensive task is visited first
+  ICHECK_EQ(expensive_order, 0);
+  for (int i = 0; i < n; i++) {
+    ICHECK_EQ(visited[i], 1);
+  }
+  // All-zero hints still cover every task
+  std::vector<double> zeros(n, 0.0);
+  std::atomic<int> count{0};
+  parallel_for_guided(0, n, 4, zeros, [&count](int, int) { ++count; });
+  ICHECK_EQ(count, n);
+}
+
+TEST(ParallelForGuided, Exception) {
+  using tvm::support::parallel_for_guided;
+  bool exception = false;
+  try {
+    parallel_for_guided(0, 100, 3, [](int thread_id, int task_id) {
+      if (task_id == 42) {
+        LOG(FATAL) << "Error";
+      }
+    });
+  } catch (const std::exception& e) {
+    exception = true;
+  }
+  ICHECK(exception);
+  // The pool is still usable afterwards
+  std::atomic<int> count{0};
+  parallel_for_guided(0, 100, 3, [&count](int, int) { ++count; });
+  ICHECK_EQ(count, 100);
+}
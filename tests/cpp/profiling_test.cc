@@ -21,7 +21,11 @@
 #include <tvm/runtime/profiling.h>
 
 #include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace tvm {
 namespace runtime {
@@ -37,5 +41,49 @@ TEST(DefaultTimer, Basic) {
   int64_t elapsed = t->SyncAndGetElapsedNanos();
   CHECK_GT(elapsed, 9 * 1e6);
 }
+
+TEST(SummarizeTimings, DropsSlowOutliers) {
+  std::vector<double> samples = {1.00, 1.02, 0.98, 1.01, 0.99, 3.0, 1.00, 0.5};
+  profiling::TimingSummary summary = profiling::SummarizeTimings(samples, 3.5);
+  ASSERT_EQ(summary.dropped.size(), 1U);
+  EXPECT_EQ(summary.dropped[0], 3.0);
+  // fast timings are kept.
+  EXPECT_EQ(summary.kept.size(), 7U);
+  EXPECT_NEAR(summary.mean, 6.5 / 7, 1e-9);
+  EXPECT_GT(summary.std, 0);
+  EXPECT_GT(summary.ci, summary.std / std::sqrt(7.0));
+
+  EXPECT_EQ(profiling::SummarizeTimings(samples, 0).dropped.size(), 0U);
+  profiling::TimingSummary constant = profiling::SummarizeTimings({2, 2, 2}, 3.5);
+  EXPECT_EQ(constant.kept.size(), 3U);
+  EXPECT_EQ(constant.ci, 0);
+}
+
+TEST(AdaptiveTimeEvaluator, InterleavedCandidates) {
+  Device dev{kDLCPU, 0};
+  std::vector<int> calls(2, 0);
+  std::vector<int> order;
+  auto candidate = [&](int index, int sleep_us) {
+    return PackedFunc([&, index, sleep_us](TVMArgs args, TVMRetValue* rv) {
+      ++calls[index];
+      order.push_back(index);
+      std::this_thread::sleep_for(std::chrono::microseconds(sleep_us));
+    });
+  };
+  PackedFunc timer = profiling::WrapAdaptiveTimeEvaluator(
+      {candidate(0, 200), candidate(1, 1000)}, dev, 1, 3, 50, 0, 1.0, 3.5, 0);
+  std::string blob = timer();
+  std::vector<double> values(blob.size() / sizeof(double));
+  std::memcpy(values.data(), blob.data(), blob.size());
+  // a loose target converges after the minimum number of rounds.
+  ASSERT_EQ(values[0] + values[1], 3);
+  size_t second = 5 + values[0] + values[1];
+  ASSERT_EQ(values[second] + values[second + 1], 3);
+  EXPECT_GT(values[second + 2], values[2]);
+  EXPECT_EQ(calls[0], 4);
+  EXPECT_EQ(calls[1], 4);
+  // the order of the candidates is rotated every round, after the warm up calls.
+  EXPECT_EQ(order, std::vector<int>({0, 1, 0, 1, 1, 0, 0, 1}));
+}
 }  // namespace runtime
 }  // namespace tvm
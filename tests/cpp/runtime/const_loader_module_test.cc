@@ -0,0 +1,124 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/container/array.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../../../src/runtime/const_loader_module.h"
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief A module exposing the functions of several symbols, which count how many times they were
+ *  initialized and check that they are initialized when called.
+ */
+class InitCountingModuleNode : public ModuleNode {
+ public:
+  explicit InitCountingModuleNode(const std::vector<std::string>& symbols) {
+    for (const std::string& symbol : symbols) {
+      init_counts_[symbol] = 0;
+      uninitialized_calls_[symbol] = 0;
+    }
+  }
+
+  const char* type_key() const final { return "init_counting"; }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    const std::string init_prefix = "__init_";
+    if (name.compare(0, init_prefix.size(), init_prefix) == 0) {
+      std::string symbol = name.substr(init_prefix.size());
+      if (!init_counts_.count(symbol)) return PackedFunc();
+      return PackedFunc([sptr_to_self, this, symbol](TVMArgs args, TVMRetValue* rv) {
+        Array<NDArray> consts = args[0];
+        EXPECT_EQ(consts.size(), 1U);
+        // Long enough for the callers and the warmup to overlap
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        init_counts_.at(symbol)++;
+        *rv = 0;
+      });
+    }
+    if (!init_counts_.count(name)) return PackedFunc();
+    return PackedFunc([sptr_to_self, this, name](TVMArgs args, TVMRetValue* rv) {
+      if (init_counts_.at(name) == 0) {
+        uninitialized_calls_.at(name)++;
+      }
+    });
+  }
+
+  std::unordered_map<std::string, std::atomic<int>> init_counts_;
+  std::unordered_map<std::string, std::atomic<int>> uninitialized_calls_;
+};
+
+TEST(ConstLoaderModule, InitializesEachSubModuleOnce) {
+  const int num_symbols = 8;
+  const int num_threads = 4;
+  std::vector<std::string> symbols;
+  std::unordered_map<std::string, NDArray> const_var_ndarray;
+  std::unordered_map<std::string, std::vector<std::string>> const_vars_by_symbol;
+  for (int i = 0; i < num_symbols; ++i) {
+    std::string symbol = "func_" + std::to_string(i);
+    std::string var = "const_" + std::to_string(i);
+    symbols.push_back(symbol);
+    const_var_ndarray[var] = NDArray::Empty({4}, DataType::Float(32), {kDLCPU, 0});
+    const_vars_by_symbol[symbol] = {var};
+  }
+  auto node = make_object<InitCountingModuleNode>(symbols);
+  InitCountingModuleNode* counting = node.get();
+  Module loader = ConstLoaderModuleCreate(const_var_ndarray, const_vars_by_symbol);
+  loader.Import(Module(node));
+
+  // The warmup initializes the submodules in background while the symbols are called.
+  loader.GetFunction("warmup")(true);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&loader, &symbols, t]() {
+      for (size_t i = 0; i < symbols.size(); ++i) {
+        const std::string& symbol = symbols[(i + t) % symbols.size()];
+        PackedFunc f = loader.GetFunction(symbol);
+        ASSERT_TRUE(f != nullptr);
+        f();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const std::string& symbol : symbols) {
+    EXPECT_EQ(counting->init_counts_.at(symbol), 1) << symbol;
+    EXPECT_EQ(counting->uninitialized_calls_.at(symbol), 0) << symbol;
+  }
+  // A later warmup does not initialize them again.
+  loader.GetFunction("warmup")();
+  for (const std::string& symbol : symbols) {
+    EXPECT_EQ(counting->init_counts_.at(symbol), 1) << symbol;
+  }
+}
+
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,185 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/registry.h>
+
+#include <cstdint>
+#include <string>
+
+#include "../../../src/runtime/contrib/json/json_runtime.h"
+
+namespace tvm {
+namespace runtime {
+
+/*! \brief A BYOC runtime adding one to its input, which requires a larger alignment. */
+class AlignedAddOneRuntime : public json::JSONRuntimeBase {
+ public:
+  static constexpr size_t kAlignment = 4 * kAllocAlignment;
+
+  AlignedAddOneRuntime(const std::string& symbol_name, const std::string& graph_json,
+                       const Array<String> const_names)
+      : json::JSONRuntimeBase(symbol_name, graph_json, const_names) {}
+
+  const char* type_key() const final { return "aligned_add_one"; }
+
+  void Init(const Array<NDArray>& consts) final {}
+
+  void Run() final {
+    const DLTensor* input = data_entry_[input_var_eid_[0]];
+    const DLTensor* output = data_entry_[EntryID(outputs_[0])];
+    input_data_ = input->data;
+    output_data_ = output->data;
+    EXPECT_EQ(input->byte_offset, 0U);
+    EXPECT_EQ(output->byte_offset, 0U);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(input->data) % kAlignment, 0U);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(output->data) % kAlignment, 0U);
+    const float* in = static_cast<const float*>(input->data);
+    float* out = static_cast<float*>(output->data);
+    for (int64_t i = 0; i < input->shape[0]; ++i) {
+      out[i] = in[i] + 1.0f;
+    }
+  }
+
+  size_t GetIOAlignment() const final { return kAlignment; }
+
+  /*! \brief The data pointers of the arguments used by the last run. */
+  const void* input_data_{nullptr};
+  const void* output_data_{nullptr};
+};
+
+static constexpr int64_t kLength = 8;
+
+static const char* kSubgraphJSON = R"({
+  "nodes": [
+    {"op": "input", "name": "x", "attrs": {"shape": [[[8]]], "dtype": [["float32"]]}},
+    {"op": "kernel", "name": "add_one", "inputs": [[0, 0, 0]],
+     "attrs": {"num_inputs": "1", "num_outputs": "1", "shape": [[[8]]], "dtype": [["float32"]]}}
+  ],
+  "arg_nodes": [0],
+  "heads": [[1, 0, 0]],
+  "node_row_ptr": [0, 1, 2]
+})";
+
+static ObjectPtr<AlignedAddOneRuntime> CreateRuntime() {
+  auto n = make_object<AlignedAddOneRuntime>("add_one", kSubgraphJSON, Array<String>());
+  Module(n).GetFunction("__init_add_one")(Array<NDArray>());
+  return n;
+}
+
+/*! \brief A 1-D view of \p length floats of \p storage, starting \p byte_offset bytes in. */
+static DLTensor MakeView(const NDArray& storage, uint64_t byte_offset, int64_t* length) {
+  DLTensor view = *storage.operator->();
+  view.shape = length;
+  view.strides = nullptr;
+  view.byte_offset = byte_offset;
+  return view;
+}
+
+/*! \brief The byte offset of \p storage at which a view is aligned, shifted by \p shift bytes. */
+static uint64_t AlignedOffset(const NDArray& storage, uint64_t shift) {
+  auto addr = reinterpret_cast<uintptr_t>(storage->data);
+  const uint64_t alignment = AlignedAddOneRuntime::kAlignment;
+  return (alignment - addr % alignment) % alignment + shift;
+}
+
+TEST(JSONRuntime, StagesMisalignedArguments) {
+  auto runtime = CreateRuntime();
+  Module mod(runtime);
+  EXPECT_EQ(mod.GetFunction("__io_alignment_add_one")().operator int64_t(),
+            static_cast<int64_t>(AlignedAddOneRuntime::kAlignment));
+  PackedFunc add_one = mod.GetFunction("add_one");
+  int64_t length = kLength;
+  // Room for a view at any offset up to the alignment.
+  int64_t storage_length = kLength + AlignedAddOneRuntime::kAlignment / sizeof(float) + 1;
+  NDArray in_storage = NDArray::Empty({storage_length}, DataType::Float(32), {kDLCPU, 0});
+  NDArray out_storage = NDArray::Empty({storage_length}, DataType::Float(32), {kDLCPU, 0});
+
+  for (uint64_t shift : {uint64_t(0), uint64_t(sizeof(float))}) {
+    uint64_t in_offset = AlignedOffset(in_storage, shift);
+    uint64_t out_offset = AlignedOffset(out_storage, shift);
+    DLTensor input = MakeView(in_storage, in_offset, &length);
+    DLTensor output = MakeView(out_storage, out_offset, &length);
+    float* in = reinterpret_cast<float*>(static_cast<char*>(in_storage->data) + in_offset);
+    float* out = reinterpret_cast<float*>(static_cast<char*>(out_storage->data) + out_offset);
+    for (int64_t i = 0; i < kLength; ++i) {
+      in[i] = static_cast<float>(i + shift);
+      out[i] = 0.0f;
+    }
+    add_one(&input, &output);
+    for (int64_t i = 0; i < kLength; ++i) {
+      EXPECT_EQ(out[i], static_cast<float>(i + shift) + 1.0f);
+    }
+    if (shift == 0) {
+      // The aligned arguments are used in place.
+      EXPECT_EQ(runtime->input_data_, in);
+      EXPECT_EQ(runtime->output_data_, out);
+    } else {
+      // The misaligned arguments are copied through the staging buffers.
+      EXPECT_NE(runtime->input_data_, in);
+      EXPECT_NE(runtime->output_data_, out);
+    }
+  }
+}
+
+TEST(JSONRuntime, GraphExecutorAlignsStorage) {
+  auto runtime = CreateRuntime();
+  std::string graph_json = R"({
+    "nodes": [
+      {"op": "null", "name": "x", "inputs": []},
+      {"op": "tvm_op", "name": "add_one", "inputs": [[0, 0, 0]],
+       "attrs": {"func_name": "add_one", "flatten_data": "0", "num_inputs": "1",
+                 "num_outputs": "1"}}
+    ],
+    "arg_nodes": [0],
+    "node_row_ptr": [0, 1, 2],
+    "heads": [[1, 0, 0]],
+    "attrs": {
+      "shape": ["list_shape", [[8], [8]]],
+      "dltype": ["list_str", ["float32", "float32"]],
+      "storage_id": ["list_int", [0, 1]]
+    }
+  })";
+  const PackedFunc* create = Registry::Get("tvm.graph_executor.create");
+  ASSERT_NE(create, nullptr);
+  Module executor = (*create)(graph_json, Module(runtime), static_cast<int>(kDLCPU), 0);
+
+  NDArray x = NDArray::Empty({kLength}, DataType::Float(32), {kDLCPU, 0});
+  for (int64_t i = 0; i < kLength; ++i) {
+    static_cast<float*>(x->data)[i] = static_cast<float>(i);
+  }
+  executor.GetFunction("set_input")(0, x);
+  executor.GetFunction("run")();
+  NDArray input = executor.GetFunction("get_input")(0);
+  NDArray output = executor.GetFunction("get_output")(0);
+  const void* input_data = static_cast<char*>(input->data) + input->byte_offset;
+  const float* out =
+      reinterpret_cast<float*>(static_cast<char*>(output->data) + output->byte_offset);
+  // The storage of the arguments is aligned as the runtime requires, so it is used in place.
+  EXPECT_EQ(runtime->input_data_, input_data);
+  EXPECT_EQ(runtime->output_data_, out);
+  for (int64_t i = 0; i < kLength; ++i) {
+    EXPECT_EQ(out[i], static_cast<float>(i) + 1.0f);
+  }
+}
+
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,90 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/profiling.h>
+
+#include <string>
+#include <thread>
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+static Map<String, ObjectRef> FindCall(const Report& report, const std::string& name) {
+  for (const auto& call : report->calls) {
+    if (Downcast<String>(call["Name"]) == name) return call;
+  }
+  return Map<String, ObjectRef>();
+}
+
+TEST(LoopProfiler, NestedRegions) {
+  const char* func = "fused_add";
+  // nothing is recorded before the profiling starts.
+  TVMBackendProfileRegionBegin(func, 0);
+  TVMBackendProfileRegionEnd(0);
+  StartLoopProfiling();
+  for (int i = 0; i < 2; ++i) {
+    TVMBackendProfileRegionBegin(func, 0);
+    TVMBackendProfileRegionBegin(func, 3);
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    TVMBackendProfileRegionEnd(3);
+    TVMBackendProfileRegionBegin(func, 5);
+    TVMBackendProfileRegionEnd(5);
+    TVMBackendProfileRegionEnd(0);
+  }
+  // an End without a Begin is ignored.
+  TVMBackendProfileRegionEnd(7);
+  Report report = StopLoopProfiling();
+  ASSERT_EQ(report->calls.size(), 3U);
+  Map<String, ObjectRef> outer = FindCall(report, "fused_add/0");
+  Map<String, ObjectRef> inner = FindCall(report, "fused_add/0/3");
+  ASSERT_TRUE(outer.defined() && inner.defined() && FindCall(report, "fused_add/0/5").defined());
+  EXPECT_EQ(Downcast<String>(inner["Function"]), "fused_add");
+  EXPECT_EQ(inner["Count"].as<CountNode>()->value, 2);
+  double outer_us = outer["Duration (us)"].as<DurationNode>()->microseconds;
+  double inner_us = inner["Duration (us)"].as<DurationNode>()->microseconds;
+  EXPECT_GE(inner_us, 200);
+  EXPECT_GE(outer_us, inner_us);
+  EXPECT_LE(outer["Self (us)"].as<DurationNode>()->microseconds, outer_us - inner_us);
+  EXPECT_DOUBLE_EQ(outer["Percent"].as<PercentNode>()->percent, 100);
+  EXPECT_NE(std::string(report->AsTable()).find("fused_add/0/3"), std::string::npos);
+
+  StartLoopProfiling();
+  EXPECT_EQ(StopLoopProfiling()->calls.size(), 0U);
+}
+
+TEST(LoopProfiler, Threads) {
+  StartLoopProfiling();
+  std::thread worker([]() {
+    TVMBackendProfileRegionBegin("worker", 1);
+    TVMBackendProfileRegionEnd(1);
+  });
+  worker.join();
+  TVMBackendProfileRegionBegin("main", 1);
+  TVMBackendProfileRegionEnd(1);
+  Report report = StopLoopProfiling();
+  EXPECT_EQ(report->calls.size(), 2U);
+  EXPECT_TRUE(FindCall(report, "worker/1").defined());
+}
+
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
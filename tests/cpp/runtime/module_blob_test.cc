@@ -0,0 +1,152 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <dmlc/memory_io.h>
+#include <gtest/gtest.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/registry.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../../src/runtime/library_module.h"
+
+namespace tvm {
+namespace runtime {
+
+/*! \brief A module serialized as its payload, which records the thread that loaded it. */
+class BlobTestModuleNode : public ModuleNode {
+ public:
+  explicit BlobTestModuleNode(std::string payload)
+      : payload_(std::move(payload)), load_thread_(std::this_thread::get_id()) {}
+
+  const char* type_key() const final { return "blob_test"; }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    return PackedFunc();
+  }
+
+  void SaveToBinary(dmlc::Stream* stream) final { stream->Write(payload_); }
+
+  std::string payload_;
+  std::thread::id load_thread_;
+};
+
+TVM_REGISTER_GLOBAL("runtime.module.loadbinary_blob_test").set_body_typed([](void* strm) {
+  dmlc::Stream* stream = static_cast<dmlc::Stream*>(strm);
+  std::string payload;
+  ICHECK(stream->Read(&payload));
+  // Long enough for the loader threads to share the entries
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  return Module(make_object<BlobTestModuleNode>(payload));
+});
+
+/*! \brief A library that only holds a module blob. */
+class BlobLibrary : public Library {
+ public:
+  explicit BlobLibrary(std::string blob) : blob_(std::move(blob)) {}
+
+  void* GetSymbol(const char* name) final {
+    return std::string(name) == symbol::tvm_dev_mblob ? &blob_[0] : nullptr;
+  }
+
+ private:
+  std::string blob_;
+};
+
+/*!
+ * \brief Make the blob of a library importing \p num_modules "blob_test" modules, laid out as
+ *  ModuleSerializer does.
+ */
+static std::string MakeModuleBlob(int num_modules, bool with_entry_table) {
+  std::string data;
+  dmlc::MemoryStringStream fs(&data);
+  dmlc::Stream* stream = &fs;
+  uint64_t size = num_modules + 2;
+  stream->Write(size);
+  std::vector<uint64_t> offsets;
+  offsets.push_back(fs.Tell());
+  stream->Write(std::string("_lib"));
+  for (int i = 0; i < num_modules; ++i) {
+    offsets.push_back(fs.Tell());
+    stream->Write(std::string("blob_test"));
+    stream->Write("payload" + std::to_string(i));
+  }
+  // The library at index 0 imports all the other modules.
+  std::vector<uint64_t> row_ptr(num_modules + 2, num_modules);
+  row_ptr[0] = 0;
+  std::vector<uint64_t> child_indices;
+  for (int i = 0; i < num_modules; ++i) {
+    child_indices.push_back(i + 1);
+  }
+  offsets.push_back(fs.Tell());
+  stream->Write(std::string("_import_tree"));
+  stream->Write(row_ptr);
+  stream->Write(child_indices);
+  if (with_entry_table) {
+    for (uint64_t offset : offsets) {
+      stream->Write(offset);
+    }
+    stream->Write(size);
+    stream->Write(kModuleBlobEntryTableMagic);
+  }
+  std::string blob(sizeof(uint64_t), '\0');
+  uint64_t nbytes = data.size();
+  for (size_t i = 0; i < sizeof(nbytes); ++i) {
+    blob[i] = static_cast<char>((nbytes >> (i * 8)) & 0xff);
+  }
+  return blob + data;
+}
+
+/*! \brief Load the blob, and return the number of threads that loaded its modules. */
+static size_t LoadAndCheck(const std::string& blob, int num_modules) {
+  Module root = CreateModuleFromLibrary(make_object<BlobLibrary>(blob));
+  EXPECT_EQ(std::string(root->type_key()), "library");
+  const std::vector<Module>& imports = root->imports();
+  EXPECT_EQ(imports.size(), static_cast<size_t>(num_modules));
+  std::set<std::thread::id> threads;
+  for (size_t i = 0; i < imports.size(); ++i) {
+    EXPECT_EQ(std::string(imports[i]->type_key()), "blob_test");
+    auto* node = static_cast<BlobTestModuleNode*>(imports[i].operator->());
+    EXPECT_EQ(node->payload_, "payload" + std::to_string(i));
+    threads.insert(node->load_thread_);
+  }
+  return threads.size();
+}
+
+TEST(ModuleBlob, EntryTableLoadsInParallel) {
+  setenv("TVM_MODULE_LOAD_THREADS", "4", 1);
+  EXPECT_GT(LoadAndCheck(MakeModuleBlob(16, true), 16), 1U);
+  setenv("TVM_MODULE_LOAD_THREADS", "1", 1);
+  EXPECT_EQ(LoadAndCheck(MakeModuleBlob(16, true), 16), 1U);
+  unsetenv("TVM_MODULE_LOAD_THREADS");
+}
+
+TEST(ModuleBlob, NoEntryTableLoadsSerially) {
+  setenv("TVM_MODULE_LOAD_THREADS", "4", 1);
+  EXPECT_EQ(LoadAndCheck(MakeModuleBlob(16, false), 16), 1U);
+  unsetenv("TVM_MODULE_LOAD_THREADS");
+}
+
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,99 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../../src/runtime/op_latency_recorder.h"
+
+namespace tvm {
+namespace runtime {
+
+TEST(LatencyHistogram, Buckets) {
+  for (uint64_t v : {0, 1, 3, 4, 5, 7, 8, 9, 100, 12345, 1000000007}) {
+    int index = LatencyHistogram::BucketIndex(v);
+    EXPECT_LE(v, LatencyHistogram::BucketUpperBound(index));
+    if (index > 0) {
+      EXPECT_GT(v, LatencyHistogram::BucketUpperBound(index - 1));
+    }
+  }
+  // the relative error of a bucket is bounded.
+  int index = LatencyHistogram::BucketIndex(1000000);
+  EXPECT_LE(LatencyHistogram::BucketUpperBound(index), 1250000U);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(1ULL << 62), LatencyHistogram::kNumBuckets - 1);
+}
+
+TEST(LatencyHistogram, Quantiles) {
+  LatencyHistogram histogram;
+  for (int i = 1; i <= 100; ++i) histogram.Record(i * 1000);
+  LatencyHistogram::Snapshot s = histogram.Read(true);
+  EXPECT_EQ(s.count, 100U);
+  EXPECT_EQ(s.sum, 5050000U);
+  EXPECT_EQ(s.max, 100000U);
+  EXPECT_GE(s.Quantile(0.5), 50000U);
+  EXPECT_LE(s.Quantile(0.5), 50000U * 5 / 4);
+  EXPECT_GE(s.Quantile(0.99), 99000U);
+  EXPECT_LE(s.Quantile(0.99), 100000U);
+  EXPECT_EQ(histogram.Read(false).count, 0U);
+}
+
+TEST(LatencyHistogram, ConcurrentRecord) {
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&histogram, t]() {
+      for (int i = 0; i < 10000; ++i) histogram.Record(t * 100 + i % 7);
+    });
+  }
+  for (auto& t : threads) t.join();
+  LatencyHistogram::Snapshot s = histogram.Read(false);
+  EXPECT_EQ(s.count, 40000U);
+  EXPECT_EQ(s.max, 306U);
+}
+
+TEST(OpLatencyRecorder, SampledCPURuns) {
+  Device cpu{kDLCPU, 0};
+  OpLatencyRecorder recorder({"add", "mul"}, {"fused_add", "fused_mul"}, {cpu, cpu}, 2);
+  int timed = 0;
+  for (int run = 0; run < 10; ++run) {
+    if (!recorder.BeginRun()) continue;
+    ++timed;
+    for (size_t op = 0; op < 2; ++op) {
+      int64_t start = recorder.StartOp(op);
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+      recorder.StopOp(op, start);
+    }
+  }
+  EXPECT_EQ(timed, 5);
+  std::string json = recorder.ToJSON(false);
+  EXPECT_NE(json.find("\"sample_period\":2"), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"add\",\"function\":\"fused_add\",\"device\":\"cpu(0)\""),
+            std::string::npos);
+  EXPECT_NE(json.find("\"count\":5"), std::string::npos);
+  EXPECT_NE(json.find("\"buckets\":[["), std::string::npos);
+  recorder.ToJSON(true);
+  EXPECT_NE(recorder.ToJSON(false).find("\"count\":0,"), std::string::npos);
+}
+
+}  // namespace runtime
+}  // namespace tvm
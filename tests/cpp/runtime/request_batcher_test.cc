@@ -0,0 +1,210 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/container/map.h>
+#include <tvm/runtime/container/shape_tuple.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace {
+
+const DLDataType kFloat32{kDLFloat, 32, 1};
+const Device kCPU{kDLCPU, 0};
+
+/*! \brief A graph-executor-like module computing out = 2 * data over a [batch, 3] input. */
+class ScaleExecutor : public ModuleNode {
+ public:
+  explicit ScaleExecutor(int64_t batch)
+      : input_(NDArray::Empty({batch, 3}, kFloat32, kCPU)),
+        output_(NDArray::Empty({batch, 3}, kFloat32, kCPU)) {}
+
+  const char* type_key() const final { return "test.ScaleExecutor"; }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name == "get_num_inputs" || name == "get_num_outputs") {
+      return PackedFunc([](TVMArgs args, TVMRetValue* rv) { *rv = 1; });
+    } else if (name == "get_input") {
+      return PackedFunc([this](TVMArgs args, TVMRetValue* rv) { *rv = input_; });
+    } else if (name == "get_output") {
+      return PackedFunc([this](TVMArgs args, TVMRetValue* rv) { *rv = output_; });
+    } else if (name == "set_input_zero_copy") {
+      return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
+        input_ = args[1].operator NDArray();
+      });
+    } else if (name == "run") {
+      return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
+        const float* in = static_cast<const float*>(input_->data);
+        float* out = static_cast<float*>(output_->data);
+        for (int64_t i = 0; i < input_->shape[0] * 3; ++i) out[i] = 2 * in[i];
+      });
+    }
+    return PackedFunc();
+  }
+
+ private:
+  NDArray input_;
+  NDArray output_;
+};
+
+/*! \brief A VM-like module whose function returns 2 * data for a data of any shape. */
+class ScaleVM : public ModuleNode {
+ public:
+  const char* type_key() const final { return "test.ScaleVM"; }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name == "set_input") {
+      return PackedFunc(
+          [this](TVMArgs args, TVMRetValue* rv) { input_ = args[1].operator NDArray(); });
+    } else if (name == "invoke") {
+      return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
+        std::vector<int64_t> shape(input_->shape, input_->shape + input_->ndim);
+        NDArray output = NDArray::Empty(shape, kFloat32, kCPU);
+        const float* in = static_cast<const float*>(input_->data);
+        float* out = static_cast<float*>(output->data);
+        for (size_t i = 0; i < GetDataSize(*input_.operator->()) / sizeof(float); ++i) {
+          out[i] = 2 * in[i];
+        }
+        *rv = output;
+      });
+    }
+    return PackedFunc();
+  }
+
+ private:
+  NDArray input_;
+};
+
+int64_t GetCount(const Map<String, ObjectRef>& stats, const std::string& key) {
+  return stats[key].as<profiling::CountNode>()->value;
+}
+
+TEST(RequestBatcher, BatchesConcurrentRequests) {
+  const PackedFunc* create = Registry::Get("tvm.runtime.RequestBatcher");
+  ASSERT_NE(create, nullptr);
+  Array<Module> executors{Module(make_object<ScaleExecutor>(4)),
+                          Module(make_object<ScaleExecutor>(2))};
+  Module batcher = (*create)(executors, ShapeTuple({4, 2}), 200000, String(""));
+  PackedFunc submit = batcher.GetFunction("submit");
+
+  constexpr int kNumRequests = 8;
+  std::vector<NDArray> inputs, outputs;
+  for (int r = 0; r < kNumRequests; ++r) {
+    NDArray input = NDArray::Empty({3}, kFloat32, kCPU);
+    for (int i = 0; i < 3; ++i) static_cast<float*>(input->data)[i] = r * 10 + i;
+    inputs.push_back(input);
+    // Outputs may also carry a batch dimension of 1.
+    outputs.push_back(NDArray::Empty({1, 3}, kFloat32, kCPU));
+  }
+  std::vector<std::thread> clients;
+  for (int r = 0; r < kNumRequests; ++r) {
+    clients.emplace_back([&, r]() {
+      submit(Array<NDArray>{inputs[r]}, Array<NDArray>{outputs[r]});
+    });
+  }
+  for (auto& client : clients) client.join();
+
+  for (int r = 0; r < kNumRequests; ++r) {
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_EQ(static_cast<float*>(outputs[r]->data)[i], 2 * (r * 10 + i));
+    }
+  }
+  Map<String, ObjectRef> stats = batcher.GetFunction("get_statistics")();
+  EXPECT_EQ(GetCount(stats, "Requests"), kNumRequests);
+  EXPECT_LT(GetCount(stats, "Batches"), kNumRequests);
+
+  // A lone request runs on the smallest bucket once the latency budget expires.
+  Module eager = (*create)(executors, ShapeTuple({4, 2}), 0, String(""));
+  eager.GetFunction("submit")(Array<NDArray>{inputs[1]}, Array<NDArray>{outputs[0]});
+  EXPECT_EQ(static_cast<float*>(outputs[0]->data)[2], 2 * 12);
+  stats = eager.GetFunction("get_statistics")();
+  EXPECT_EQ(GetCount(stats, "Batches"), 1);
+  EXPECT_EQ(GetCount(stats, "Padded Samples"), 1);
+}
+
+TEST(RequestBatcher, ReportsShapeMismatch) {
+  const PackedFunc* create = Registry::Get("tvm.runtime.RequestBatcher");
+  Module batcher = (*create)(Array<Module>{Module(make_object<ScaleExecutor>(2))},
+                             ShapeTuple({2}), 0, String(""));
+  NDArray input = NDArray::Empty({4}, kFloat32, kCPU);
+  NDArray output = NDArray::Empty({3}, kFloat32, kCPU);
+  EXPECT_THROW(batcher.GetFunction("submit")(Array<NDArray>{input}, Array<NDArray>{output}),
+               Error);
+}
+
+TEST(RequestBatcher, InvalidRequestFailsAlone) {
+  const PackedFunc* create = Registry::Get("tvm.runtime.RequestBatcher");
+  Module batcher = (*create)(Array<Module>{Module(make_object<ScaleExecutor>(2))},
+                             ShapeTuple({2}), 200000, String(""));
+  PackedFunc submit = batcher.GetFunction("submit");
+  NDArray input = NDArray::Empty({3}, kFloat32, kCPU);
+  for (int i = 0; i < 3; ++i) static_cast<float*>(input->data)[i] = i;
+  NDArray output = NDArray::Empty({3}, kFloat32, kCPU);
+  std::thread valid([&]() { submit(Array<NDArray>{input}, Array<NDArray>{output}); });
+  // Rejected when submitted, so it never joins the batch of the valid request
+  NDArray bad_output = NDArray::Empty({4}, kFloat32, kCPU);
+  EXPECT_THROW(submit(Array<NDArray>{input}, Array<NDArray>{bad_output}), Error);
+  valid.join();
+  EXPECT_EQ(static_cast<float*>(output->data)[2], 4);
+}
+
+TEST(RequestBatcher, BatchesVMRequestsByShape) {
+  const PackedFunc* create = Registry::Get("tvm.runtime.RequestBatcher");
+  Module batcher = (*create)(Array<Module>{Module(make_object<ScaleVM>())}, ShapeTuple({2}),
+                             200000, String("main"));
+  PackedFunc submit = batcher.GetFunction("submit");
+  std::vector<NDArray> inputs, outputs;
+  for (int64_t size : {3, 5, 3, 5}) {
+    NDArray input = NDArray::Empty({size}, kFloat32, kCPU);
+    for (int64_t i = 0; i < size; ++i) static_cast<float*>(input->data)[i] = size * 10 + i;
+    inputs.push_back(input);
+    outputs.push_back(NDArray::Empty({size}, kFloat32, kCPU));
+  }
+  std::vector<std::thread> clients;
+  for (size_t r = 0; r < inputs.size(); ++r) {
+    clients.emplace_back([&, r]() {
+      submit(Array<NDArray>{inputs[r]}, Array<NDArray>{outputs[r]});
+    });
+  }
+  for (auto& client : clients) client.join();
+  for (size_t r = 0; r < inputs.size(); ++r) {
+    int64_t size = inputs[r]->shape[0];
+    for (int64_t i = 0; i < size; ++i) {
+      EXPECT_EQ(static_cast<float*>(outputs[r]->data)[i], 2 * (size * 10 + i));
+    }
+  }
+  Map<String, ObjectRef> stats = batcher.GetFunction("get_statistics")();
+  EXPECT_EQ(GetCount(stats, "Requests"), 4);
+
+  // The outputs of a VM are checked once it ran, failing only the request they belong to
+  NDArray bad_output = NDArray::Empty({4}, kFloat32, kCPU);
+  EXPECT_THROW(submit(Array<NDArray>{inputs[0]}, Array<NDArray>{bad_output}), Error);
+}
+
+}  // namespace
+}  // namespace runtime
+}  // namespace tvm
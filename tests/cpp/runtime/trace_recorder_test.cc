@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/c_backend_api.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../../src/runtime/trace_recorder.h"
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+static size_t CountOccurrences(const std::string& s, const std::string& pattern) {
+  size_t count = 0;
+  for (size_t pos = s.find(pattern); pos != std::string::npos; pos = s.find(pattern, pos + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+TEST(TraceRecorder, RecordAndDrain) {
+  TraceRecorder* recorder = TraceRecorder::Global();
+  recorder->Start(16);
+  { TraceScope scope("test", "outer"); }
+  Device dev{kDLCUDA, 1};
+  recorder->Record("device", "kernel", 1000, 3000, recorder->DeviceProcess(dev), 0);
+  std::string trace = recorder->Drain();
+  EXPECT_EQ(CountOccurrences(trace, "\"ph\":\"X\""), 2);
+  EXPECT_NE(trace.find("\"name\":\"outer\",\"cat\":\"test\""), std::string::npos);
+  EXPECT_NE(trace.find("\"dur\":2.000"), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"cuda(1)\""), std::string::npos);
+  // events are only drained once.
+  EXPECT_EQ(CountOccurrences(recorder->Drain(), "\"ph\":\"X\""), 0);
+
+  recorder->Stop();
+  { TraceScope scope("test", "ignored"); }
+  EXPECT_EQ(CountOccurrences(recorder->Drain(), "\"ph\":\"X\""), 0);
+}
+
+TEST(TraceRecorder, RingBufferKeepsNewest) {
+  TraceRecorder* recorder = TraceRecorder::Global();
+  recorder->Start(8);
+  for (int i = 0; i < 20; ++i) {
+    std::string name = "event" + std::to_string(i);
+    recorder->Record("test", name.c_str(), i, i + 1);
+  }
+  std::string trace = recorder->Drain();
+  recorder->Stop();
+  EXPECT_EQ(CountOccurrences(trace, "\"ph\":\"X\""), 8);
+  EXPECT_EQ(trace.find("\"event11\""), std::string::npos);
+  EXPECT_NE(trace.find("\"event12\""), std::string::npos);
+  EXPECT_NE(trace.find("\"event19\""), std::string::npos);
+}
+
+TEST(TraceRecorder, ConcurrentThreads) {
+  TraceRecorder* recorder = TraceRecorder::Global();
+  recorder->Start(1 << 12);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([recorder, t] {
+      recorder->SetThreadName("writer " + std::to_string(t));
+      for (int i = 0; i < 100; ++i) {
+        TraceScope scope("test", "work");
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  std::string trace = recorder->Drain();
+  recorder->Stop();
+  EXPECT_EQ(CountOccurrences(trace, "\"name\":\"work\""), 400);
+  for (int t = 0; t < 4; ++t) {
+    EXPECT_NE(trace.find("\"name\":\"writer " + std::to_string(t) + "\""), std::string::npos);
+  }
+}
+
+TEST(TraceRecorder, ThreadPoolTasks) {
+  TraceRecorder* recorder = TraceRecorder::Global();
+  recorder->Start(1 << 12);
+  auto flambda = [](int task_id, TVMParallelGroupEnv* penv, void* cdata) -> int { return 0; };
+  TVMBackendParallelLaunch(flambda, nullptr, 0);
+  std::string trace = recorder->Drain();
+  recorder->Stop();
+  EXPECT_GT(CountOccurrences(trace, "\"name\":\"parallel task\""), 0);
+}
+
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
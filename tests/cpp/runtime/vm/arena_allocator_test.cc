@@ -0,0 +1,118 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "../../../../src/runtime/vm/arena_allocator.h"
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
+
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+namespace {
+
+constexpr size_t kArenaSize = 1 << 20;
+const DLDataType kByte{kDLUInt, 8, 1};
+
+TEST(ArenaAllocator, CarveAndCoalesce) {
+  Device dev{kDLCPU, 0};
+  ArenaAllocator alloc(dev, kArenaSize);
+  Buffer a = alloc.Alloc(1000, 64, kByte);
+  Buffer b = alloc.Alloc(3000, 64, kByte);
+  Buffer c = alloc.Alloc(1000, 64, kByte);
+  EXPECT_EQ(a.size % ArenaAllocator::kBlockAlignment, 0);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(b.data) % ArenaAllocator::kBlockAlignment, 0);
+  // All carved from a single arena
+  EXPECT_EQ(alloc.UsedMemory(), kArenaSize);
+  EXPECT_EQ(alloc.GetStats().live_bytes, a.size + b.size + c.size);
+  // A hole between two live blocks is fragmentation
+  alloc.Free(b);
+  AllocatorStats stats = alloc.GetStats();
+  EXPECT_GT(stats.fragmentation, 0.0);
+  // A slightly different size reuses the hole
+  Buffer d = alloc.Alloc(2900, 64, kByte);
+  EXPECT_EQ(d.data, b.data);
+  alloc.Free(d);
+  // Freeing the neighbours coalesces everything back into one block
+  alloc.Free(a);
+  alloc.Free(c);
+  stats = alloc.GetStats();
+  EXPECT_EQ(stats.live_bytes, 0);
+  EXPECT_EQ(stats.largest_free_block, kArenaSize);
+  EXPECT_EQ(stats.fragmentation, 0.0);
+  EXPECT_EQ(stats.peak_live_bytes, a.size + b.size + c.size);
+}
+
+TEST(ArenaAllocator, VaryingShapesStayBounded) {
+  Device dev{kDLCPU, 0};
+  ArenaAllocator alloc(dev, kArenaSize);
+  for (size_t len = 1; len < 200; ++len) {
+    Buffer x = alloc.Alloc(len * 1024, 64, kByte);
+    Buffer y = alloc.Alloc(len * 512, 64, kByte);
+    alloc.Free(x);
+    alloc.Free(y);
+  }
+  AllocatorStats stats = alloc.GetStats();
+  EXPECT_EQ(stats.live_bytes, 0);
+  EXPECT_EQ(stats.reserved_bytes, kArenaSize);
+  EXPECT_EQ(stats.peak_reserved_bytes, kArenaSize);
+}
+
+TEST(ArenaAllocator, LargeAndEmptyArenas) {
+  Device dev{kDLCPU, 0};
+  ArenaAllocator alloc(dev, kArenaSize);
+  std::vector<Buffer> bufs;
+  for (int i = 0; i < 3; ++i) {
+    bufs.push_back(alloc.Alloc(kArenaSize, 64, kByte));
+  }
+  Buffer large = alloc.Alloc(4 * kArenaSize, 64, kByte);
+  EXPECT_EQ(alloc.UsedMemory(), 7 * kArenaSize);
+  alloc.Free(large);
+  for (const Buffer& buf : bufs) {
+    alloc.Free(buf);
+  }
+  // Only a single empty arena is kept
+  EXPECT_EQ(alloc.UsedMemory(), 4 * kArenaSize);
+  // Stricter alignment than the blocks get a dedicated arena
+  Buffer aligned = alloc.Alloc(100, 4096, kByte);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned.data) % 4096, 0);
+  alloc.Free(aligned);
+}
+
+TEST(ArenaAllocator, StatsThroughMemoryManager) {
+  // The allocators of the memory manager are global and cannot be replaced, so the test uses a
+  // CPU device id of its own rather than changing the allocator type of the CPU for other tests.
+  constexpr int kDeviceId = 0x7e;
+  Device dev{kDLCPU, kDeviceId};
+  Allocator* alloc = MemoryManager::GetOrCreateAllocator(dev, kArena);
+  ASSERT_EQ(alloc->type(), kArena);
+  NDArray arr = alloc->Empty({256, 256}, DLDataType{kDLFloat, 32, 1}, dev);
+  const PackedFunc* f = Registry::Get("runtime.VMAllocatorStats");
+  ASSERT_NE(f, nullptr);
+  Map<String, ObjectRef> stats = (*f)(static_cast<int>(kDLCPU), kDeviceId);
+  EXPECT_EQ(stats["live_bytes"].as<profiling::CountNode>()->value, 256 * 256 * 4);
+}
+
+}  // namespace
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,167 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/vm/executable.h>
+#include <tvm/runtime/vm/vm.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+namespace {
+
+const DLDataType kFloat32{kDLFloat, 32, 1};
+const Device kCPU{kDLCPU, 0};
+
+/*! \brief A kernel library with a single "add" kernel computing out = a + b. */
+class AddModule : public ModuleNode {
+ public:
+  const char* type_key() const final { return "test.Add"; }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name != "add") return PackedFunc();
+    return PackedFunc([](TVMArgs args, TVMRetValue* rv) {
+      DLTensor* a = args[0];
+      DLTensor* b = args[1];
+      DLTensor* out = args[2];
+      for (int64_t i = 0; i < a->shape[0]; ++i) {
+        static_cast<float*>(out->data)[i] =
+            static_cast<float*>(a->data)[i] + static_cast<float*>(b->data)[i];
+      }
+    });
+  }
+};
+
+/*! \brief Expose the protected entry points the tests drive directly. */
+class TestVirtualMachine : public VirtualMachine {
+ public:
+  using VirtualMachine::Init;
+};
+
+NDArray Full(int64_t n, float value) {
+  NDArray arr = NDArray::Empty({n}, kFloat32, kCPU);
+  for (int64_t i = 0; i < n; ++i) {
+    static_cast<float*>(arr->data)[i] = value;
+  }
+  return arr;
+}
+
+/*! \brief Build an executable whose main function adds a constant to its input. */
+ObjectPtr<Executable> MakeExecutable(int64_t n) {
+  auto exec = make_object<Executable>();
+  exec->SetLib(Module(make_object<AddModule>()));
+  exec->virtual_devices = {kCPU};
+  exec->host_device_index = 0;
+  exec->primitive_map["add"] = 0;
+  exec->constants = {Full(n, 10.0f)};
+  exec->const_device_indexes = {0};
+  std::vector<Instruction> code = {
+      Instruction::LoadConst(0, 1),
+      Instruction::LoadConsti(n * 4, 2),
+      Instruction::LoadConsti(0, 3),
+      Instruction::AllocStorage(2, 64, kFloat32, 0, 4),
+      Instruction::AllocTensor(4, 3, {n}, kFloat32, 5),
+      Instruction::InvokePacked(0, 3, 1, {0, 1, 5}),
+      Instruction::Ret(5),
+  };
+  exec->functions.emplace_back("main", std::vector<std::string>{"x"}, code, 6,
+                               std::vector<Index>{0});
+  exec->global_map["main"] = 0;
+  return exec;
+}
+
+TEST(VirtualMachine, ConcurrentContexts) {
+  const int64_t n = 64;
+  const int num_contexts = 8;
+  auto exec = MakeExecutable(n);
+  auto vm = make_object<TestVirtualMachine>();
+  vm->LoadExecutable(exec);
+  vm->Init({kCPU}, {kPooled});
+
+  Module vm_mod(vm);
+  std::vector<Module> contexts;
+  for (int i = 0; i < num_contexts; ++i) {
+    contexts.push_back(vm_mod.GetFunction("create_context")());
+  }
+  std::vector<int> mismatches(num_contexts, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_contexts; ++t) {
+    threads.emplace_back([&, t]() {
+      PackedFunc set_input = contexts[t].GetFunction("set_input");
+      PackedFunc invoke = contexts[t].GetFunction("invoke");
+      for (int iter = 0; iter < 50; ++iter) {
+        set_input("main", Full(n, t));
+        NDArray out = invoke("main");
+        for (int64_t i = 0; i < n; ++i) {
+          mismatches[t] += static_cast<float*>(out->data)[i] != t + 10.0f;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (int t = 0; t < num_contexts; ++t) {
+    EXPECT_EQ(mismatches[t], 0) << "context " << t;
+  }
+  // A single copy of the constant is shared by all the contexts.
+  EXPECT_TRUE(exec->GetConstantOnDevice(0, kCPU).same_as(exec->constants[0]));
+}
+
+TEST(VirtualMachine, ContextHasItsOwnInputs) {
+  const int64_t n = 4;
+  auto vm = make_object<TestVirtualMachine>();
+  vm->LoadExecutable(MakeExecutable(n));
+  vm->Init({kCPU}, {kPooled});
+  Module vm_mod(vm);
+  Module context = vm_mod.GetFunction("create_context")();
+
+  vm_mod.GetFunction("set_input")("main", Full(n, 1.0f));
+  context.GetFunction("set_input")("main", Full(n, 2.0f));
+  NDArray out = context.GetFunction("invoke")("main");
+  EXPECT_EQ(static_cast<float*>(out->data)[0], 12.0f);
+  out = vm_mod.GetFunction("invoke")("main");
+  EXPECT_EQ(static_cast<float*>(out->data)[0], 11.0f);
+}
+
+TEST(VirtualMachine, InvokeAsync) {
+  const int64_t n = 4;
+  auto vm = make_object<TestVirtualMachine>();
+  vm->LoadExecutable(MakeExecutable(n));
+  vm->Init({kCPU}, {kPooled});
+  Module vm_mod(vm);
+
+  vm_mod.GetFunction("set_input")("main", Full(n, 5.0f));
+  VMFuture future = vm_mod.GetFunction("invoke_async")("main");
+  // The CPU work is synchronous, there is nothing left to wait for.
+  EXPECT_TRUE(future->IsDone());
+  NDArray out = Downcast<NDArray>(future->Wait());
+  EXPECT_EQ(static_cast<float*>(out->data)[n - 1], 15.0f);
+  NDArray same = vm_mod.GetFunction("get_output")(0);
+  EXPECT_TRUE(same.same_as(out));
+}
+
+}  // namespace
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
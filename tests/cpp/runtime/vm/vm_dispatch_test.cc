@@ -0,0 +1,150 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/vm/executable.h>
+#include <tvm/runtime/vm/vm.h>
+
+#include <string>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+namespace {
+
+const DLDataType kFloat32{kDLFloat, 32, 1};
+
+/*! \brief A kernel library with a single "add_one" kernel computing out = in + 1. */
+class AddOneModule : public ModuleNode {
+ public:
+  const char* type_key() const final { return "test.AddOne"; }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name != "add_one") return PackedFunc();
+    return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
+      DLTensor* in = args[0];
+      DLTensor* out = args[1];
+      for (int64_t i = 0; i < in->shape[0]; ++i) {
+        static_cast<float*>(out->data)[i] = static_cast<float*>(in->data)[i] + 1.0f;
+      }
+      ++num_calls;
+    });
+  }
+
+  int num_calls = 0;
+};
+
+/*! \brief Expose the protected entry points the tests drive directly. */
+class TestVirtualMachine : public VirtualMachine {
+ public:
+  using VirtualMachine::external_dispatch_code_;
+  using VirtualMachine::Init;
+  using VirtualMachine::Invoke;
+  using VirtualMachine::kMaxExternalDispatchCode;
+};
+
+/*!
+ * \brief Build an executable whose main function applies add_one twice, covering the
+ * AllocStorage -> AllocTensor -> InvokePacked and AllocTensor -> InvokePacked sequences.
+ */
+ObjectPtr<Executable> MakeExecutable(ObjectPtr<AddOneModule> lib, int64_t n) {
+  auto exec = make_object<Executable>();
+  exec->SetLib(Module(lib));
+  exec->virtual_devices = {Device{kDLCPU, 0}};
+  exec->host_device_index = 0;
+  exec->primitive_map["add_one"] = 0;
+  std::vector<Instruction> code = {
+      Instruction::LoadConsti(n * 4 * 2, 1),
+      Instruction::LoadConsti(0, 2),
+      Instruction::LoadConsti(n * 4, 3),
+      Instruction::AllocStorage(1, 64, kFloat32, 0, 4),
+      Instruction::AllocTensor(4, 2, {n}, kFloat32, 5),
+      Instruction::InvokePacked(0, 2, 1, {0, 5}),
+      Instruction::AllocTensor(4, 3, {n}, kFloat32, 6),
+      Instruction::InvokePacked(0, 2, 1, {5, 6}),
+      Instruction::Ret(6),
+  };
+  exec->functions.emplace_back("main", std::vector<std::string>{"x"}, code, 7,
+                               std::vector<Index>{0});
+  exec->global_map["main"] = 0;
+  return exec;
+}
+
+TEST(VirtualMachine, FusedAllocAndInvoke) {
+  const int64_t n = 16;
+  auto lib = make_object<AddOneModule>();
+  auto vm = make_object<TestVirtualMachine>();
+  vm->LoadExecutable(MakeExecutable(lib, n));
+  vm->Init({Device{kDLCPU, 0}}, {kPooled});
+
+  NDArray x = NDArray::Empty({n}, kFloat32, Device{kDLCPU, 0});
+  for (int64_t i = 0; i < n; ++i) {
+    static_cast<float*>(x->data)[i] = static_cast<float>(i);
+  }
+  // Run several times so the packed call buffers are reused.
+  for (int iter = 0; iter < 3; ++iter) {
+    NDArray out = Downcast<NDArray>(vm->Invoke("main", {x}));
+    ASSERT_EQ(out->shape[0], n);
+    for (int64_t i = 0; i < n; ++i) {
+      EXPECT_EQ(static_cast<float*>(out->data)[i], static_cast<float>(i) + 2.0f);
+    }
+  }
+  EXPECT_EQ(lib->num_calls, 6);
+}
+
+TEST(VirtualMachine, InvokeFunctionOutsideExecutable) {
+  const int64_t n = 4;
+  auto lib = make_object<AddOneModule>();
+  auto exec = MakeExecutable(lib, n);
+  auto vm = make_object<TestVirtualMachine>();
+  vm->LoadExecutable(exec);
+  vm->Init({Device{kDLCPU, 0}}, {kPooled});
+
+  // A copy of main with an extra leading move, so no instruction lines up with main.
+  VMFunction func = exec->functions[0];
+  func.instructions.insert(func.instructions.begin(), Instruction::Move(0, 7));
+  func.register_file_size = 8;
+  for (size_t i = 1; i < func.instructions.size(); ++i) {
+    Instruction& instr = func.instructions[i];
+    if (instr.op == Opcode::InvokePacked && instr.packed_args[0] == 0) {
+      instr.packed_args[0] = 7;
+    }
+  }
+  NDArray x = NDArray::Empty({n}, kFloat32, Device{kDLCPU, 0});
+  for (int64_t i = 0; i < n; ++i) {
+    static_cast<float*>(x->data)[i] = 1.0f;
+  }
+  // Each invocation decodes its own copy, only a bounded number of them are kept.
+  for (size_t iter = 0; iter < 3 * TestVirtualMachine::kMaxExternalDispatchCode; ++iter) {
+    VMFunction copy = func;
+    NDArray out = Downcast<NDArray>(vm->Invoke(copy, {x}));
+    for (int64_t i = 0; i < n; ++i) {
+      EXPECT_EQ(static_cast<float*>(out->data)[i], 3.0f);
+    }
+    EXPECT_LE(vm->external_dispatch_code_.size(), TestVirtualMachine::kMaxExternalDispatchCode);
+  }
+}
+
+}  // namespace
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
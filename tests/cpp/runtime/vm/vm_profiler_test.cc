@@ -0,0 +1,134 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/container/map.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/runtime/vm/executable.h>
+#include <tvm/runtime/vm/vm.h>
+
+#include <string>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+namespace {
+
+const DLDataType kFloat32{kDLFloat, 32, 1};
+const Device kCPU{kDLCPU, 0};
+
+/*! \brief A kernel library with a single "scale" kernel computing out = 2 * a. */
+class ScaleModule : public ModuleNode {
+ public:
+  const char* type_key() const final { return "test.Scale"; }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name != "scale") return PackedFunc();
+    return PackedFunc([](TVMArgs args, TVMRetValue* rv) {
+      DLTensor* a = args[0];
+      DLTensor* out = args[1];
+      for (int64_t i = 0; i < a->shape[0]; ++i) {
+        static_cast<float*>(out->data)[i] = 2 * static_cast<float*>(a->data)[i];
+      }
+    });
+  }
+};
+
+/*! \brief Build an executable whose main function scales its input \p num_ops times. */
+Module MakeExecutable(int64_t n, int num_ops) {
+  auto exec = make_object<Executable>();
+  exec->SetLib(Module(make_object<ScaleModule>()));
+  exec->virtual_devices = {kCPU};
+  exec->host_device_index = 0;
+  exec->primitive_map["scale"] = 0;
+  std::vector<Instruction> code = {
+      Instruction::LoadConsti(n * 4, 1),
+      Instruction::LoadConsti(0, 2),
+  };
+  RegName input = 0;
+  for (int i = 0; i < num_ops; ++i) {
+    RegName storage = 3 + 2 * i;
+    RegName output = storage + 1;
+    code.push_back(Instruction::AllocStorage(1, 64, kFloat32, 0, storage));
+    code.push_back(Instruction::AllocTensor(storage, 2, {n}, kFloat32, output));
+    code.push_back(Instruction::InvokePacked(0, 2, 1, {input, output}));
+    input = output;
+  }
+  code.push_back(Instruction::Ret(input));
+  exec->functions.emplace_back("main", std::vector<std::string>{"x"}, code, 3 + 2 * num_ops,
+                               std::vector<Index>{0});
+  exec->global_map["main"] = 0;
+  return Module(exec);
+}
+
+int64_t CountOf(const ObjectRef& obj) { return obj.as<profiling::CountNode>()->value; }
+
+double MicrosecondsOf(const ObjectRef& obj) {
+  return obj.as<profiling::DurationNode>()->microseconds;
+}
+
+TEST(VirtualMachineDebug, SampledProfile) {
+  const int64_t n = 16;
+  const int num_ops = 4;
+  const PackedFunc* create = Registry::Get("runtime._VirtualMachineDebug");
+  ASSERT_NE(create, nullptr);
+  Module vm = (*create)(MakeExecutable(n, num_ops));
+  vm.GetFunction("init")(static_cast<int>(kDLCPU), 0, static_cast<int>(kPooled));
+
+  // Sample one invocation out of 3, timing 3 operators of it at a time.
+  vm.GetFunction("set_sampling")(3, 3);
+  NDArray input = NDArray::Empty({n}, kFloat32, kCPU);
+  for (int64_t i = 0; i < n; ++i) {
+    static_cast<float*>(input->data)[i] = 1.0f;
+  }
+  PackedFunc set_input = vm.GetFunction("set_input");
+  PackedFunc invoke = vm.GetFunction("invoke");
+  set_input("main", input);
+  for (int i = 0; i < 6; ++i) {
+    NDArray out = invoke("main");
+    EXPECT_EQ(static_cast<float*>(out->data)[0], 16.0f);
+  }
+
+  // Invocations 0 and 3 were sampled, timing operators 0-2 then 3: 4 calls in total.
+  Map<String, ObjectRef> profile = vm.GetFunction("get_sampled_profile")(true);
+  ASSERT_EQ(profile.size(), 1U);
+  Map<String, ObjectRef> stats = Downcast<Map<String, ObjectRef>>(profile["scale"]);
+  EXPECT_EQ(CountOf(stats["Count"]), 4);
+  int64_t histogram_total = 0;
+  for (const ObjectRef& count : Downcast<Array<ObjectRef>>(stats["Histogram"])) {
+    histogram_total += CountOf(count);
+  }
+  EXPECT_EQ(histogram_total, 4);
+  EXPECT_LE(MicrosecondsOf(stats["Min (us)"]), MicrosecondsOf(stats["Max (us)"]));
+
+  // The statistics were reset, and sampling can be turned off.
+  vm.GetFunction("set_sampling")(0, 0);
+  invoke("main");
+  Map<String, ObjectRef> empty = vm.GetFunction("get_sampled_profile")(false);
+  EXPECT_EQ(empty.size(), 0U);
+}
+
+}  // namespace
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
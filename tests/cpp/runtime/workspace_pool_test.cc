@@ -0,0 +1,191 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "../../../src/runtime/workspace_pool.h"
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/device_api.h>
+
+#include <cstdlib>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace {
+
+/*! \brief A host memory device API counting the calls into it. */
+class CountingDeviceAPI : public DeviceAPI {
+ public:
+  void SetDevice(Device dev) final {}
+  void GetAttr(Device dev, DeviceAttrKind kind, TVMRetValue* rv) final {}
+  void* AllocDataSpace(Device dev, size_t nbytes, size_t alignment, DLDataType type_hint) final {
+    ++num_allocs;
+    last_alloc_bytes = nbytes;
+    return malloc(nbytes);
+  }
+  void FreeDataSpace(Device dev, void* ptr) final {
+    ++num_frees;
+    free(ptr);
+  }
+  void StreamSync(Device dev, TVMStreamHandle stream) final {}
+
+  int num_allocs = 0;
+  int num_frees = 0;
+  size_t last_alloc_bytes = 0;
+};
+
+TEST(WorkspacePool, ReuseSizeClass) {
+  CountingDeviceAPI api;
+  Device dev{kDLExtDev, 0};
+  {
+    WorkspacePool pool(kDLExtDev, &api);
+    for (int iter = 0; iter < 10; ++iter) {
+      void* a = pool.AllocWorkspace(dev, 100);
+      void* b = pool.AllocWorkspace(dev, 40000);
+      void* c = pool.AllocWorkspace(dev, 100);
+      // Out of order release
+      pool.FreeWorkspace(dev, a);
+      pool.FreeWorkspace(dev, b);
+      pool.FreeWorkspace(dev, c);
+    }
+    // Steady state does not touch the device
+    EXPECT_EQ(api.num_allocs, 3);
+    EXPECT_EQ(api.num_frees, 0);
+    WorkspacePool::Stats stats = pool.GetStats(dev);
+    EXPECT_EQ(stats.num_allocs, 30);
+    EXPECT_EQ(stats.num_cache_hits, 27);
+    EXPECT_EQ(stats.num_device_allocs, 3);
+    EXPECT_EQ(stats.bytes_in_use, 0);
+    EXPECT_EQ(stats.bytes_cached, stats.peak_bytes_in_use);
+    EXPECT_GE(stats.peak_bytes_in_use, 40000 + 2 * 100);
+  }
+  // Cached blocks are released with the pool
+  EXPECT_EQ(api.num_frees, 3);
+}
+
+TEST(WorkspacePool, SizeClassRounding) {
+  CountingDeviceAPI api;
+  Device dev{kDLExtDev, 0};
+  WorkspacePool pool(kDLExtDev, &api);
+  // Within the same class the block is reused
+  void* a = pool.AllocWorkspace(dev, 9 * 4096 + 1);
+  size_t class_bytes = api.last_alloc_bytes;
+  EXPECT_GE(class_bytes, 9 * 4096 + 1);
+  EXPECT_LE(class_bytes, (9 * 4096 + 1) * 5 / 4 + 4096);
+  pool.FreeWorkspace(dev, a);
+  void* b = pool.AllocWorkspace(dev, class_bytes);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(api.num_allocs, 1);
+  pool.FreeWorkspace(dev, b);
+  // A larger class needs a new block
+  void* c = pool.AllocWorkspace(dev, class_bytes + 1);
+  EXPECT_EQ(api.num_allocs, 2);
+  EXPECT_GT(api.last_alloc_bytes, class_bytes);
+  pool.FreeWorkspace(dev, c);
+}
+
+TEST(WorkspacePool, BoundedCache) {
+  CountingDeviceAPI api;
+  Device dev{kDLExtDev, 0};
+  WorkspacePool pool(kDLExtDev, &api);
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 100; ++i) {
+    ptrs.push_back(pool.AllocWorkspace(dev, 64));
+  }
+  for (void* ptr : ptrs) {
+    pool.FreeWorkspace(dev, ptr);
+  }
+  WorkspacePool::Stats stats = pool.GetStats(dev);
+  EXPECT_GT(stats.num_device_frees, 0);
+  EXPECT_LT(stats.bytes_cached, stats.peak_bytes_in_use);
+}
+
+TEST(WorkspacePool, MaxCachedBytes) {
+  CountingDeviceAPI api;
+  Device dev{kDLExtDev, 0};
+  WorkspacePool pool(kDLExtDev, &api, 3 * 4096);
+  // Blocks of varying sizes are only cached up to the bound
+  std::vector<void*> ptrs;
+  for (int npages = 1; npages <= 8; ++npages) {
+    ptrs.push_back(pool.AllocWorkspace(dev, npages * 4096));
+  }
+  for (void* ptr : ptrs) {
+    pool.FreeWorkspace(dev, ptr);
+    EXPECT_LE(pool.GetStats(dev).bytes_cached, 3 * 4096);
+  }
+  WorkspacePool::Stats stats = pool.GetStats(dev);
+  EXPECT_EQ(stats.bytes_cached, 3 * 4096);
+  EXPECT_EQ(stats.num_device_frees, 6);
+  EXPECT_EQ(api.num_frees, 6);
+  // The default bound is finite
+  EXPECT_LT(WorkspacePool::DefaultMaxCachedBytes(), std::numeric_limits<size_t>::max());
+}
+
+TEST(WorkspacePool, ReuseLargerSizeClass) {
+  CountingDeviceAPI api;
+  Device dev{kDLExtDev, 0};
+  WorkspacePool pool(kDLExtDev, &api);
+  void* a = pool.AllocWorkspace(dev, 5 * 4096);
+  pool.FreeWorkspace(dev, a);
+  // A smaller request takes the free block of the next larger class
+  void* b = pool.AllocWorkspace(dev, 4 * 4096);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(api.num_allocs, 1);
+  WorkspacePool::Stats stats = pool.GetStats(dev);
+  EXPECT_EQ(stats.bytes_in_use, 5 * 4096);
+  EXPECT_EQ(stats.num_cache_hits, 1);
+  // It goes back to its own class
+  pool.FreeWorkspace(dev, b);
+  void* c = pool.AllocWorkspace(dev, 5 * 4096);
+  EXPECT_EQ(a, c);
+  EXPECT_EQ(api.num_allocs, 1);
+  pool.FreeWorkspace(dev, c);
+  // A much smaller request does not take it
+  void* d = pool.AllocWorkspace(dev, 4096);
+  EXPECT_NE(a, d);
+  EXPECT_EQ(api.num_allocs, 2);
+  pool.FreeWorkspace(dev, d);
+}
+
+TEST(WorkspacePool, GlobalStats) {
+  CountingDeviceAPI api;
+  Device dev{kDLExtDev, 1};
+  WorkspacePool pool(kDLExtDev, &api);
+  void* a = pool.AllocWorkspace(dev, 4096);
+  std::thread worker([&api, dev]() {
+    WorkspacePool local(kDLExtDev, &api);
+    local.FreeWorkspace(dev, local.AllocWorkspace(dev, 4096));
+    WorkspacePool::Stats stats = WorkspacePool::GetGlobalStats(dev);
+    EXPECT_EQ(stats.num_allocs, 2);
+    EXPECT_EQ(stats.bytes_in_use, 4096);
+    EXPECT_EQ(stats.bytes_cached, 4096);
+  });
+  worker.join();
+  // The pool of the exited thread is no longer counted
+  WorkspacePool::Stats stats = WorkspacePool::GetGlobalStats(dev);
+  EXPECT_EQ(stats.num_allocs, 1);
+  EXPECT_EQ(stats.peak_bytes_in_use, 4096);
+  pool.FreeWorkspace(dev, a);
+}
+
+}  // namespace
+}  // namespace runtime
+}  // namespace tvm
@@ -20,9 +20,12 @@
 #include <dmlc/logging.h>
 #include <gtest/gtest.h>
 #include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
 #include <tvm/runtime/threading_backend.h>
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <sstream>
 #include <thread>
@@ -185,3 +188,126 @@ TEST(ThreadingBackend, TVMBackendAffinityConfigure) {
     t->join();
   }
 }
+
+static FTVMParallelLambda nested_atomic_add_task_id = [](int task_id, TVMParallelGroupEnv* penv,
+                                                         void* cdata) -> int {
+  auto* data = reinterpret_cast<std::atomic<size_t>*>(cdata);
+  std::atomic<size_t> acc(0);
+  if (TVMBackendParallelLaunch(atomic_add_task_id, &acc, 0) != 0) return -1;
+  const size_t N_per_task = (N + penv->num_task - 1) / penv->num_task;
+  // Every outer task contributes the full inner sum for each index it owns.
+  for (size_t i = task_id * N_per_task; i < N && i < (task_id + 1) * N_per_task; ++i) {
+    data->fetch_add(acc.load(), std::memory_order_relaxed);
+  }
+  return 0;
+};
+
+TEST(ThreadingBackend, TVMBackendParallelLaunchNested) {
+  // The default pool runs the launches from inside a task inline.
+  std::atomic<size_t> acc(0);
+  EXPECT_EQ(TVMBackendParallelLaunch(nested_atomic_add_task_id, &acc, 0), 0);
+  EXPECT_EQ(acc.load(std::memory_order_relaxed), N * N * (N - 1) / 2);
+}
+
+TEST(ThreadingBackend, TVMBackendParallelLaunchWorkStealing) {
+  setenv("TVM_THREAD_POOL_WORK_STEALING", "1", 1);
+  setenv("TVM_THREAD_POOL_CHUNK_FACTOR", "3", 1);
+  // The thread pool is thread local and reads the configuration when it is created,
+  // launch from a fresh thread to get a work-stealing pool.
+  std::thread t([]() {
+    for (int i = 0; i < 10; ++i) {
+      std::atomic<size_t> acc(0);
+      EXPECT_EQ(TVMBackendParallelLaunch(atomic_add_task_id, &acc, 0), 0);
+      EXPECT_EQ(acc.load(std::memory_order_relaxed), N * (N - 1) / 2);
+    }
+    // Nested launches are split across the pool instead of being rejected.
+    std::atomic<size_t> nested_acc(0);
+    EXPECT_EQ(TVMBackendParallelLaunch(nested_atomic_add_task_id, &nested_acc, 0), 0);
+    EXPECT_EQ(nested_acc.load(std::memory_order_relaxed), N * N * (N - 1) / 2);
+  });
+  t.join();
+  unsetenv("TVM_THREAD_POOL_WORK_STEALING");
+  unsetenv("TVM_THREAD_POOL_CHUNK_FACTOR");
+}
+
+TEST(ThreadingBackend, TVMBackendNumaConfigure) {
+  int num_nodes = tvm::runtime::threading::NumaNodeCount();
+  EXPECT_GE(num_nodes, 1);
+  for (int node = 0; node < num_nodes; ++node) {
+    EXPECT_FALSE(tvm::runtime::threading::NumaNodeCpus(node).empty());
+  }
+  std::thread t([]() {
+    EXPECT_EQ(tvm::runtime::threading::CurrentNumaNode(), -1);
+    tvm::runtime::threading::ConfigureNumaNode(0, 0);
+    EXPECT_EQ(tvm::runtime::threading::CurrentNumaNode(), 0);
+    std::atomic<size_t> acc(0);
+    TVMBackendParallelLaunch(atomic_add_task_id, &acc, 0);
+    EXPECT_EQ(acc.load(std::memory_order_relaxed), N * (N - 1) / 2);
+    // Placement is best effort, it must leave the data intact either way.
+    std::vector<int> buffer(1 << 16, 7);
+    tvm::runtime::threading::BindMemoryToNumaNode(buffer.data(), buffer.size() * sizeof(int), 0);
+    EXPECT_EQ(buffer[0], 7);
+    EXPECT_EQ(buffer.back(), 7);
+  });
+  t.join();
+}
+
+TEST(ThreadingBackend, TVMBackendThreadPoolGroup) {
+  using tvm::runtime::threading::CreateThreadPoolGroup;
+  using tvm::runtime::threading::ListThreadPoolGroups;
+  using tvm::runtime::threading::RemoveThreadPoolGroup;
+  using tvm::runtime::threading::ThreadPoolGroupScope;
+  CreateThreadPoolGroup("group_a", {0, 1});
+  CreateThreadPoolGroup("group_b", {2, 3});
+  // Groups must not share CPUs.
+  EXPECT_THROW(CreateThreadPoolGroup("group_c", {1, 4}), tvm::runtime::Error);
+  EXPECT_EQ(ListThreadPoolGroups(), std::vector<std::string>({"group_a", "group_b"}));
+
+  std::vector<std::unique_ptr<std::thread>> ts;
+  for (int i = 0; i < 4; ++i) {
+    // Several request threads share each group.
+    ts.emplace_back(new std::thread([i]() {
+      ThreadPoolGroupScope scope(i % 2 == 0 ? "group_a" : "group_b");
+      EXPECT_EQ(tvm::runtime::threading::NumThreads(), 2);
+      for (int j = 0; j < 10; ++j) {
+        std::atomic<size_t> acc(0);
+        EXPECT_EQ(TVMBackendParallelLaunch(atomic_add_task_id, &acc, 0), 0);
+        EXPECT_EQ(acc.load(std::memory_order_relaxed), N * (N - 1) / 2);
+      }
+    }));
+  }
+  for (auto& t : ts) {
+    t->join();
+  }
+  RemoveThreadPoolGroup("group_a");
+  RemoveThreadPoolGroup("group_b");
+  EXPECT_TRUE(ListThreadPoolGroups().empty());
+  EXPECT_THROW(ThreadPoolGroupScope("group_a"), tvm::runtime::Error);
+}
+
+TEST(ThreadingBackend, TVMBackendAdaptiveSpin) {
+  setenv("TVM_THREAD_POOL_ADAPTIVE_SPIN", "1", 1);
+  setenv("TVM_THREAD_POOL_MAX_SPIN_US", "100", 1);
+  std::thread t([]() {
+    auto stats = tvm::runtime::Registry::Get("runtime.ThreadPoolWaitStats");
+    ASSERT_NE(stats, nullptr);
+    auto get = [&](const char* key) {
+      tvm::runtime::Map<tvm::runtime::String, tvm::runtime::ObjectRef> m = (*stats)();
+      return m[key].as<tvm::runtime::profiling::CountNode>()->value;
+    };
+    for (int i = 0; i < 5; ++i) {
+      std::atomic<size_t> acc(0);
+      EXPECT_EQ(TVMBackendParallelLaunch(atomic_add_task_id, &acc, 0), 0);
+      EXPECT_EQ(acc.load(std::memory_order_relaxed), N * (N - 1) / 2);
+      // Idle gaps much longer than the spin limit put the workers to sleep.
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_LE(get("spin_budget_ns"), 100000);
+    if (tvm::runtime::threading::NumThreads() > 1) {
+      EXPECT_GT(get("sleeps"), 0);
+    }
+  });
+  t.join();
+  unsetenv("TVM_THREAD_POOL_ADAPTIVE_SPIN");
+  unsetenv("TVM_THREAD_POOL_MAX_SPIN_US");
+}
@@ -21,6 +21,8 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include "../../src/runtime/crt/include/tvm/runtime/crt/internal/graph_executor/load_json.h"
 
 namespace {
@@ -112,4 +114,22 @@ TEST(TVMGraphExecutor_Load, Parse) {
   EXPECT_EQ(executor.nodes_count, 3);
 }
 
+// Check the offsets of the entries packed into one storage are loaded.
+TEST(TVMGraphExecutor_Load, ParseStorageOffset) {
+  std::string json = kJson;
+  const std::string storage_id_key = "\"storage_id\": [";
+  json.replace(json.find(storage_id_key), storage_id_key.size(),
+               "\"storage_offset\": [\"list_int\", [0, 0, 256]],\n" + storage_id_key);
+  JSONReader reader;
+  tvm_crt_error_t err = JSONReader_Create(json.c_str(), &reader);
+  EXPECT_EQ(err, kTvmErrorNoError);
+  TVMGraphExecutor executor;
+  memset(&executor, 0, sizeof(executor));
+  int status = TVMGraphExecutor_Load(&executor, &reader);
+  EXPECT_EQ(status, 0);
+  ASSERT_NE(executor.attrs.storage_offset, nullptr);
+  EXPECT_EQ(executor.attrs.storage_offset[0], 0);
+  EXPECT_EQ(executor.attrs.storage_offset[2], 256);
+}
+
 }  // namespace
@@ -22,6 +22,7 @@
 #include <tvm/runtime/crt/rpc_common/frame_buffer.h>
 #include <tvm/runtime/crt/rpc_common/session.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -35,6 +36,7 @@ using ::tvm::runtime::micro_rpc::Unframer;
 
 extern "C" {
 void TestSessionMessageReceivedThunk(void* context, MessageType message_type, FrameBuffer* buf);
+void TestSessionMessageChunkReceivedThunk(void* context, FrameBuffer* buf);
 }
 
 class ReceivedMessage {
@@ -78,6 +80,10 @@ class TestSession {
   }
 
   std::vector<ReceivedMessage> messages_received;
+  /*! \brief Where the message body after its first stream_after_bytes bytes is streamed. */
+  std::vector<uint8_t> stream_body;
+  size_t stream_after_bytes = 0;
+  size_t stream_bytes_read = 0;
   BufferWriteStream<300> framer_write_stream;
   Framer framer;
   uint8_t receive_buffer_array[300];
@@ -101,8 +107,19 @@ void TestSessionMessageReceivedThunk(void* context, MessageType message_type, Fr
     message = std::string(reinterpret_cast<char*>(message_buf), message_size_bytes);
   }
 
-  static_cast<TestSession*>(context)->messages_received.emplace_back(
-      ReceivedMessage(message_type, message));
+  TestSession* session = static_cast<TestSession*>(context);
+  session->messages_received.emplace_back(ReceivedMessage(message_type, message));
+  if (!session->stream_body.empty()) {
+    session->stream_bytes_read =
+        session->sess.ReadStreamedMessageBody(session->stream_body.data(), 1000);
+  }
+}
+
+void TestSessionMessageChunkReceivedThunk(void* context, FrameBuffer* buf) {
+  TestSession* session = static_cast<TestSession*>(context);
+  if (buf->Size() == sizeof(::tvm::runtime::micro_rpc::SessionHeader) + session->stream_after_bytes) {
+    session->sess.StreamMessageBody(session->stream_body.data(), session->stream_body.size());
+  }
 }
 }
 
@@ -248,3 +265,51 @@ TEST_F(SessionTest, DoubleStart) {
   alice_.WriteTo(&bob_);
   EXPECT_TRUE(bob_.sess.IsEstablished());
 }
+
+TEST_F(SessionTest, StreamMessageBody) {
+  EXPECT_EQ(kTvmErrorNoError, alice_.sess.Initialize(alice_.initial_nonce));
+  EXPECT_EQ(kTvmErrorNoError, bob_.sess.Initialize(bob_.initial_nonce));
+  bob_.ClearBuffers();
+  alice_.ClearBuffers();
+  EXPECT_EQ(kTvmErrorNoError, alice_.sess.StartSession());
+  alice_.WriteTo(&bob_);
+  bob_.WriteTo(&alice_);
+  ASSERT_TRUE(bob_.sess.IsEstablished());
+  ASSERT_TRUE(alice_.sess.IsEstablished());
+  bob_.ClearBuffers();
+  alice_.ClearBuffers();
+
+  // The message is twice the size of the receive buffer, but only its first bytes are kept there
+  std::string body;
+  for (int i = 0; i < 600; ++i) {
+    body.push_back(static_cast<char>(i * 7));
+  }
+  bob_.stream_body.resize(body.size() - 4);
+  bob_.stream_after_bytes = 4;
+  bob_.sess.SetMessageChunkReceivedFunc(TestSessionMessageChunkReceivedThunk, &bob_);
+  EXPECT_EQ(kTvmErrorNoError, alice_.sess.StartMessage(MessageType::kNormal, body.size()));
+  for (size_t offset = 0; offset < body.size(); offset = std::min(body.size(), offset * 2 + 4)) {
+    size_t size_bytes = std::min(body.size(), offset * 2 + 4) - offset;
+    EXPECT_EQ(kTvmErrorNoError,
+              alice_.sess.SendBodyChunk(reinterpret_cast<const uint8_t*>(&body[offset]),
+                                        size_bytes));
+    alice_.WriteTo(&bob_);
+    alice_.framer_write_stream.Reset();
+  }
+  EXPECT_EQ(kTvmErrorNoError, alice_.sess.FinishMessage());
+  alice_.WriteTo(&bob_);
+
+  ASSERT_EQ(bob_.messages_received.size(), 1UL);
+  EXPECT_EQ(bob_.messages_received[0], ReceivedMessage(MessageType::kNormal, body.substr(0, 4)));
+  EXPECT_EQ(bob_.stream_bytes_read, body.size() - 4);
+  EXPECT_EQ(std::string(bob_.stream_body.begin(), bob_.stream_body.end()), body.substr(4));
+
+  // The next messages are received in the receive buffer again
+  bob_.ClearBuffers();
+  bob_.stream_body.clear();
+  bob_.sess.SetMessageChunkReceivedFunc(nullptr, nullptr);
+  alice_.sess.SendMessage(MessageType::kNormal, reinterpret_cast<const uint8_t*>("hello"), 5);
+  alice_.WriteTo(&bob_);
+  ASSERT_EQ(bob_.messages_received.size(), 1UL);
+  EXPECT_EQ(bob_.messages_received[0], ReceivedMessage(MessageType::kNormal, "hello"));
+}
@@ -0,0 +1,133 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/crt/tlsf_allocator.h>
+
+#include <vector>
+
+#include "crt_config.h"
+
+static constexpr const size_t kMemoryPoolSizeBytes = 64 * 1024;
+#ifndef TVM_RUNTIME_ALLOC_ALIGNMENT_BYTES
+#define TVM_RUNTIME_ALLOC_ALIGNMENT_BYTES 16
+#endif
+
+static constexpr const size_t kAlignment = TVM_RUNTIME_ALLOC_ALIGNMENT_BYTES;
+
+class TLSFAllocatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    memset(memory_pool, 0, sizeof(memory_pool));
+    ASSERT_EQ(TLSFMemoryManagerCreate(&interface, memory_pool, sizeof(memory_pool)),
+              kTvmErrorNoError);
+    dev_ = {kDLCPU, 0};
+    ASSERT_EQ(interface->GetStats(interface, &initial_stats), kTvmErrorNoError);
+  }
+
+  MemoryManagerStats GetStats() {
+    MemoryManagerStats stats;
+    EXPECT_EQ(interface->GetStats(interface, &stats), kTvmErrorNoError);
+    return stats;
+  }
+
+  alignas(kAlignment) uint8_t memory_pool[kMemoryPoolSizeBytes];
+  MemoryManagerInterface* interface;
+  MemoryManagerStats initial_stats;
+  DLDevice dev_;
+};
+
+TEST_F(TLSFAllocatorTest, Create) {
+  EXPECT_EQ(initial_stats.used_bytes, 0);
+  EXPECT_EQ(initial_stats.num_allocations, 0);
+  EXPECT_GT(initial_stats.total_bytes, kMemoryPoolSizeBytes / 2);
+  EXPECT_LE(initial_stats.total_bytes, kMemoryPoolSizeBytes);
+  EXPECT_EQ(initial_stats.largest_free_bytes, initial_stats.total_bytes);
+
+  MemoryManagerInterface* small;
+  uint8_t small_pool[16];
+  EXPECT_EQ(TLSFMemoryManagerCreate(&small, small_pool, sizeof(small_pool)),
+            kTvmErrorPlatformNoMemory);
+}
+
+TEST_F(TLSFAllocatorTest, AllocFreeAligned) {
+  std::vector<void*> ptrs;
+  for (size_t size = 1; size < 2048; size = size * 3 + 1) {
+    void* ptr;
+    ASSERT_EQ(interface->Allocate(interface, size, dev_, &ptr), kTvmErrorNoError);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % kAlignment, 0);
+    EXPECT_GE(static_cast<uint8_t*>(ptr), memory_pool);
+    EXPECT_LE(static_cast<uint8_t*>(ptr) + size, memory_pool + sizeof(memory_pool));
+    memset(ptr, 0xa5, size);
+    ptrs.push_back(ptr);
+  }
+  EXPECT_EQ(static_cast<size_t>(interface->vleak_size), ptrs.size());
+  EXPECT_EQ(GetStats().num_allocations, ptrs.size());
+  EXPECT_GT(GetStats().used_bytes, 0);
+
+  for (void* ptr : ptrs) {
+    EXPECT_EQ(interface->Free(interface, ptr, dev_), kTvmErrorNoError);
+  }
+  MemoryManagerStats stats = GetStats();
+  EXPECT_EQ(interface->vleak_size, 0);
+  EXPECT_EQ(stats.used_bytes, 0);
+  EXPECT_GT(stats.peak_used_bytes, 0);
+  // The freed blocks are merged back into one
+  EXPECT_EQ(stats.largest_free_bytes, initial_stats.largest_free_bytes);
+}
+
+TEST_F(TLSFAllocatorTest, Coalesce) {
+  void* ptrs[3];
+  for (int i = 0; i < 3; i++) {
+    ASSERT_EQ(interface->Allocate(interface, 1024, dev_, &ptrs[i]), kTvmErrorNoError);
+  }
+  // Free the middle block, then its neighbors, in both orders of merging
+  EXPECT_EQ(interface->Free(interface, ptrs[1], dev_), kTvmErrorNoError);
+  void* reused;
+  ASSERT_EQ(interface->Allocate(interface, 1024, dev_, &reused), kTvmErrorNoError);
+  EXPECT_EQ(reused, ptrs[1]);
+  EXPECT_EQ(interface->Free(interface, reused, dev_), kTvmErrorNoError);
+  EXPECT_EQ(interface->Free(interface, ptrs[0], dev_), kTvmErrorNoError);
+  EXPECT_EQ(interface->Free(interface, ptrs[2], dev_), kTvmErrorNoError);
+  EXPECT_EQ(GetStats().largest_free_bytes, initial_stats.largest_free_bytes);
+}
+
+TEST_F(TLSFAllocatorTest, AllocWholePool) {
+  void* ptr;
+  ASSERT_EQ(interface->Allocate(interface, initial_stats.largest_free_bytes, dev_, &ptr),
+            kTvmErrorNoError);
+  void* other;
+  EXPECT_EQ(interface->Allocate(interface, 1, dev_, &other), kTvmErrorPlatformNoMemory);
+  EXPECT_EQ(interface->Free(interface, ptr, dev_), kTvmErrorNoError);
+  EXPECT_EQ(interface->Allocate(interface, kMemoryPoolSizeBytes, dev_, &other),
+            kTvmErrorPlatformNoMemory);
+}
+
+TEST_F(TLSFAllocatorTest, BadFree) {
+  void* ptr;
+  ASSERT_EQ(interface->Allocate(interface, 64, dev_, &ptr), kTvmErrorNoError);
+  EXPECT_EQ(interface->Free(interface, static_cast<uint8_t*>(ptr) + 1, dev_),
+            kTvmErrorPlatformMemoryBadFree);
+  uint8_t outside;
+  EXPECT_EQ(interface->Free(interface, &outside, dev_), kTvmErrorPlatformMemoryBadFree);
+  EXPECT_EQ(interface->Free(interface, ptr, dev_), kTvmErrorNoError);
+  EXPECT_EQ(interface->Free(interface, ptr, dev_), kTvmErrorPlatformMemoryBadFree);
+  EXPECT_EQ(GetStats().num_allocations, 0);
+}
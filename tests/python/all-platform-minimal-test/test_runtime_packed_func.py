@@ -153,6 +153,57 @@ def test_ndarray_args():
     assert tvm.testing.object_use_count(x) == 1
 
 
+def _aligned_empty(shape, dtype, alignment=64, offset=0):
+    """Allocate a numpy array starting `offset` bytes after an aligned address."""
+    nbytes = int(np.prod(shape)) * np.dtype(dtype).itemsize
+    buf = np.empty(nbytes + alignment + offset, dtype="uint8")
+    start = -buf.ctypes.data % alignment + offset
+    return buf[start : start + nbytes].view(dtype).reshape(shape)
+
+
+def test_dlpack_args():
+    if not hasattr(np.ndarray, "__dlpack__"):
+        return
+    x = _aligned_empty((2, 4), "float32")
+    x[:] = np.arange(8, dtype="float32").reshape(2, 4)
+    expected = [x.copy()]
+
+    def check(arr):
+        assert isinstance(arr, tvm.nd.NDArray)
+        np.testing.assert_equal(arr.numpy(), expected[0])
+        arr.copyfrom(np.zeros(arr.shape, dtype=arr.dtype))
+
+    fcheck = tvm.runtime.convert(check)
+    # An aligned compact tensor is passed without a copy
+    fcheck(x)
+    np.testing.assert_equal(x, np.zeros_like(x))
+    # The second call is packed with the converter cached by the first one.
+    x[:] = expected[0]
+    fcheck(x)
+    np.testing.assert_equal(x, np.zeros_like(x))
+
+    # A misaligned or strided tensor is copied
+    misaligned = _aligned_empty((2, 4), "float32", offset=4)
+    strided = _aligned_empty((2, 8), "float32")[:, ::2]
+    for y in [misaligned, strided]:
+        y[:] = np.arange(8, dtype="float32").reshape(2, 4)
+        expected[0] = y.copy()
+        fcheck(y)
+        fcheck(y)
+        np.testing.assert_equal(y, expected[0])
+
+
+def test_changing_arg_types():
+    echo = tvm.testing.echo
+    for value in [1, 2.5, "hello", None, 3, 1.5, "world"]:
+        assert echo(value) == value
+    assert echo(True) == 1
+    assert list(echo(tvm.runtime.convert([1, 2]))) == [1, 2]
+    # A nested list calls the same constructor again while its arguments are packed.
+    nested = tvm.runtime.convert([[1, 2], [3]])
+    assert [list(x) for x in nested] == [[1, 2], [3]]
+
+
 def test_dict_function_value_type():
     from tvm import tir  # pylint: disable=import-outside-toplevel
 
@@ -167,6 +218,8 @@ def test_dict_function_value_type():
 
 if __name__ == "__main__":
     test_ndarray_args()
+    test_dlpack_args()
+    test_changing_arg_types()
     test_numpy_scalar()
     test_rvalue_ref()
     test_empty_array()
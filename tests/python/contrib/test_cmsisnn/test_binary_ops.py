@@ -337,6 +337,70 @@ def test_same_input_to_binary_op(op, relu_type):
     )
 
 
+@skip_if_no_reference_system
+@tvm.testing.requires_cmsisnn
+@pytest.mark.parametrize("op", [relay.qnn.op.mul, relay.qnn.op.add])
+@pytest.mark.parametrize(
+    "requantize_scale, requantize_zero_point, fused",
+    [[1.0 / 512, -128, True], [1.0 / 128, 0, False]],
+)
+def test_requantize_fused_into_binary_op(op, requantize_scale, requantize_zero_point, fused):
+    """Tests that a requantize of the output is fused if it drops no saturation"""
+    interface_api = "c"
+    use_unpacked_api = True
+    test_runner = AOT_USMP_CORSTONE300_RUNNER
+
+    dtype = "int8"
+    shape = [1, 16, 16, 3]
+    out_scale = 1.0 / 256
+    out_zero_point = -128
+    binary_op = make_model(
+        op,
+        generate_variable("input_0"),
+        generate_variable("input_1"),
+        0.0128,
+        -64,
+        0.256,
+        33,
+        out_scale=out_scale,
+        out_zero_point=out_zero_point,
+    )
+    model = relay.qnn.op.requantize(
+        binary_op,
+        relay.const(out_scale, "float32"),
+        relay.const(out_zero_point, "int32"),
+        relay.const(requantize_scale, "float32"),
+        relay.const(requantize_zero_point, "int32"),
+        out_dtype=dtype,
+    )
+    orig_mod = make_module(model)
+
+    cmsisnn_mod = cmsisnn.partition_for_cmsisnn(orig_mod)
+
+    # validate pattern matching
+    assert_partitioned_function(orig_mod, cmsisnn_mod)
+    assert ("qnn.requantize" not in cmsisnn_mod["main"].astext()) == fused
+
+    # validate the output
+    in_min, in_max = get_dtype_range(dtype)
+    inputs = {
+        "input_0": np.random.randint(in_min, high=in_max, size=shape, dtype=dtype),
+        "input_1": np.random.randint(in_min, high=in_max, size=shape, dtype=dtype),
+    }
+    output_list = generate_ref_data(orig_mod["main"], inputs)
+    compile_and_run(
+        AOTTestModel(
+            module=cmsisnn_mod,
+            inputs=inputs,
+            outputs=output_list,
+            output_tolerance=1,
+        ),
+        test_runner,
+        interface_api,
+        use_unpacked_api,
+    )
+
+
 def parameterize_for_constant_inputs(test):
     """Generates parameters in such a way so that at least one of the inputs is a constant,
     both can't be variables, both can't be scalars.
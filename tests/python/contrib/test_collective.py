@@ -0,0 +1,49 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Tests for the collective operations of tvm.contrib.collective."""
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm.contrib import collective
+
+
+def _shards(num_shards, shape, dtype):
+    data = [np.random.uniform(-1, 1, shape).astype(dtype) for _ in range(num_shards)]
+    return data, [tvm.nd.array(d, tvm.cpu(i)) for i, d in enumerate(data)]
+
+
+def test_allreduce():
+    for dtype in ["float32", "int64"]:
+        data, shards = _shards(3, (4, 5), dtype)
+        outs = collective.allreduce(shards)
+        assert len(outs) == 3
+        for i, out in enumerate(outs):
+            assert out.device == tvm.cpu(i)
+            tvm.testing.assert_allclose(out.numpy(), sum(data), rtol=1e-5)
+
+
+def test_allgather():
+    for axis in [0, 1, -1]:
+        data, shards = _shards(2, (3, 4, 2), "float32")
+        outs = collective.allgather(shards, axis)
+        for out in outs:
+            tvm.testing.assert_allclose(out.numpy(), np.concatenate(data, axis=axis))
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
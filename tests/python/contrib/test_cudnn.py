@@ -182,6 +182,21 @@ def test_conv3d():
     verify_conv3d("float32", "float32", tensor_format=0, groups=2)
 
 
+@tvm.testing.requires_gpu
+@requires_cudnn
+def test_conv_find_algo_cache(tmp_path, monkeypatch):
+    cache_file = tmp_path / "algo_cache.txt"
+    monkeypatch.setenv("TVM_CONTRIB_ALGO_CACHE_FILE", str(cache_file))
+    args = (0, [1, 1], [1, 1], [1, 1], [4, 8, 16, 16], [16, 8, 3, 3], [4, 16, 16, 16])
+    algo = cudnn.conv_forward_find_algo(*args, "float32", "float32")
+    lines = cache_file.read_text().splitlines()
+    assert len(lines) == 1
+    assert lines[0].startswith("cudnn.conv.fwd|")
+    # The second search is a hit in the cache
+    assert cudnn.conv_forward_find_algo(*args, "float32", "float32") == algo
+    assert len(cache_file.read_text().splitlines()) == 1
+
+
 def verify_softmax(shape, axis, dtype="float32", log_softmax=False):
     cudnn_op = cudnn.log_softmax if log_softmax else cudnn.softmax
     testing_op = (
@@ -761,6 +761,29 @@ def test_conv2d_weights_const(run_module, dtype="float32"):
     run_and_verify_func(config, run_module=run_module, dtype=dtype)
 
 
+def test_conv2d_repeated_runs(run_module, dtype="float32"):
+    """The intermediate buffers and packed weights are reused by the next runs."""
+    x_shape = (1, 32, 8, 8)
+    k_shape = (16, 32, 3, 3)
+    conv2d, dic, param_lst = get_conv2d_bias(x_shape, k_shape, activation="relu", dtype=dtype)
+    mod = tvm.IRModule.from_expr(conv2d)
+    params = {x: np.random.uniform(-1, 1, dic[x]).astype(dtype) for x in param_lst}
+    ref_mod = mod
+    mod = partition_for_dnnl(mod, params)
+    check_dnnl_used(mod)
+    if not run_module:
+        return
+    dev = tvm.cpu()
+    with tvm.transform.PassContext(opt_level=3):
+        ref_func = relay.create_executor("graph", mod=ref_mod, device=dev).evaluate()
+        func = relay.create_executor("graph", mod=mod, device=dev).evaluate()
+    for _ in range(3):
+        x = np.random.uniform(-1, 1, x_shape).astype(dtype)
+        tvm.testing.assert_allclose(
+            func(x, **params).numpy(), ref_func(x, **params).numpy(), rtol=1e-5, atol=1e-5
+        )
+
+
 def test_conv2d_pattern(run_module, dtype="float32"):
     x_shape = (1, 32, 8, 8)
     k_shape = (16, 32, 3, 3)
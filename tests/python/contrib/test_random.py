@@ -182,9 +182,28 @@ def test_random_fill_mt():
     assert no_exception_happened
 
 
+def test_random_fill_parallel():
+    """Check that the parallel fill covers the whole tensor, whose size is not a multiple of the
+    number of tasks."""
+    for name in ["tvm.contrib.random.random_fill", "tvm.contrib.random.random_fill_for_measure"]:
+        random_fill = tvm.get_global_func(name, True)
+        if not random_fill:
+            print("skip because extern function is not available")
+            return
+        value = tvm.nd.array(np.zeros((1000003,), dtype="float32"))
+        random_fill(value)
+        np_values = value.numpy()
+        assert np.all(np_values >= 1.0) and np.all(np_values < 10.0)
+        assert abs(np.mean(np_values) - 5.5) < 1e-1
+        # The next fill draws other values
+        random_fill(value)
+        assert not np.array_equal(value.numpy(), np_values)
+
+
 if __name__ == "__main__":
     test_randint()
     test_uniform()
     test_normal()
     test_random_fill()
     test_random_fill_mt()
+    test_random_fill_parallel()
@@ -19,6 +19,7 @@ import tvm.testing
 from tvm import te
 from tvm.topi.cuda import sort_by_key
 import numpy as np
+import pytest
 
 
 def test_sort():
@@ -91,6 +92,52 @@ def test_sort_np():
     tvm.testing.assert_allclose(c.numpy(), np_out, rtol=1e-5)
 
 
+@tvm.testing.parametrize_targets("llvm")
+@pytest.mark.parametrize("dtype", ["float32", "float64", "int32", "int64"])
+def test_argsort_topk_large_rows(target, dev, dtype):
+    """Rows long enough for the radix sort, and enough of them to run in parallel."""
+    dshape = (64, 1000)
+    # Few distinct values, to check that the ties keep their order
+    np_data = np.random.randint(-20, 20, size=dshape).astype(dtype)
+    a = tvm.nd.array(np_data, dev)
+
+    data = te.placeholder(dshape, name="data", dtype=dtype)
+    for is_ascend in [True, False]:
+        out = te.extern(
+            dshape,
+            [data],
+            lambda ins, outs: tvm.tir.call_packed(
+                "tvm.contrib.sort.argsort", ins[0], outs[0], -1, is_ascend
+            ),
+            dtype="int32",
+            name="argsort",
+        )
+        f = tvm.build(te.create_schedule(out.op), [data, out], target)
+        c = tvm.nd.array(np.zeros(dshape, dtype="int32"), dev)
+        f(a, c)
+        key = np_data if is_ascend else -np_data
+        np_out = np.argsort(key, axis=-1, kind="stable")
+        tvm.testing.assert_allclose(c.numpy(), np_out)
+
+    k = 10
+    for is_ascend in [True, False]:
+        out = te.extern(
+            (dshape[0], k),
+            [data],
+            lambda ins, outs: tvm.tir.call_packed(
+                "tvm.contrib.sort.topk", ins[0], outs[0], k, -1, "indices", is_ascend
+            ),
+            dtype="int32",
+            name="topk",
+        )
+        f = tvm.build(te.create_schedule(out.op), [data, out], target)
+        c = tvm.nd.array(np.zeros((dshape[0], k), dtype="int32"), dev)
+        f(a, c)
+        key = np_data if is_ascend else -np_data
+        np_out = np.argsort(key, axis=-1, kind="stable")[:, :k]
+        tvm.testing.assert_allclose(c.numpy(), np_out)
+
+
 def test_sort_by_key_gpu():
     size = 6
     keys = te.placeholder((size,), name="keys", dtype="int32")
@@ -1264,6 +1264,43 @@ def test_tensorrt_dynamic_batch_conv(run_module):
                     assert_result_dict_holds(result_arr[i][target])
 
 
+def test_tensorrt_batch_profile(run_module):
+    batches_to_test = [1, 5, 1, 2, 3, 0, 4, 2]
+    x_shape = (relay.Any(), 32, 8, 8)
+    x_data = np.ones([max(batches_to_test)] + list(x_shape)[1:]).astype("float32")
+    k_shape = (16, 32, 3, 3)
+    params = {"kernel": np.random.uniform(-1, 1, k_shape).astype("float32")}
+    for use_implicit_batch in [True, False]:
+        result_arr = [{} for _ in range(len(batches_to_test))]
+        for use_trt in [True, False]:
+            x = relay.var("x", shape=x_shape, dtype="float32")
+            kernel = relay.var("kernel", shape=k_shape, dtype="float32")
+            out = relay.nn.conv2d(x, kernel, channels=16, kernel_size=(3, 3), groups=1)
+            f = relay.Function([x, kernel], out)
+            mod = tvm.IRModule()
+            mod["main"] = f
+            # A single engine covers all the batch sizes.
+            trt_target = tvm.target.Target(
+                f"tensorrt -use_implicit_batch={use_implicit_batch} -batch_profile=1,2,5"
+            )
+            assert [int(size) for size in trt_target.attrs["batch_profile"]] == [1, 2, 5]
+            if use_trt:
+                mod = tensorrt.partition_for_tensorrt(mod, params=params, target=trt_target)
+            if run_module:
+                targets = ["cuda"]
+                if use_trt:
+                    targets.append(trt_target)
+                with tvm.transform.PassContext(opt_level=3):
+                    func = relay.create_executor(
+                        "vm", mod=mod, device=tvm.cuda(0), target=targets
+                    ).evaluate()
+                for i, batch_size in enumerate(batches_to_test):
+                    result_arr[i][use_trt] = func(x_data[:batch_size, ...], **params)
+        if run_module:
+            for i in range(len(batches_to_test)):
+                assert_result_dict_holds(result_arr[i])
+
+
 def test_maskrcnn_resnet50(run_module) -> None:
     """
     This function tests the working of pytorch maskrcnn with resnet50 as backbone with
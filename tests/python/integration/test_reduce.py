@@ -607,6 +607,60 @@ def test_warp_reduction2():
     check_target("rocm")
 
 
+@tvm.testing.requires_gpu
+def test_multi_warp_reduction():
+    """Test reductions over several warps, with the sum and the sum of squares fused."""
+
+    def fcombine(tensor1, tensor2):
+        return tensor1[0] + tensor2[0], tensor1[1] + tensor2[1]
+
+    def fidentity(tensor1, tensor2):
+        return tvm.tir.const(0, tensor1), tvm.tir.const(0, tensor2)
+
+    moments = te.comm_reducer(fcombine, fidentity, name="moments")
+
+    def check_target(device, num_m, num_n, nthdx, nthdy):
+        dev = tvm.device(device, 0)
+        if not tvm.testing.device_enabled(device):
+            print("skip because %s is not enabled.." % device)
+            return
+
+        placeholder_a = te.placeholder((num_m, num_n), name="A", dtype="float32")
+        axis_k = te.reduce_axis((0, num_n), "k")
+        result0, result1 = te.compute(
+            (num_m,),
+            lambda i: moments(
+                (placeholder_a[i, axis_k], placeholder_a[i, axis_k] * placeholder_a[i, axis_k]),
+                axis=axis_k,
+            ),
+            name="T",
+        )
+
+        block_x = te.thread_axis("blockIdx.x")
+        thread_x = te.thread_axis((0, nthdx), "threadIdx.x")
+        thread_y = te.thread_axis((0, nthdy), "threadIdx.y")
+        schedule = te.create_schedule(result0.op)
+        axis_ko, _ = schedule[result0].split(axis_k, nparts=nthdx)
+        axis_xo, axis_xi = schedule[result0].split(schedule[result0].op.axis[0], factor=nthdy)
+        schedule[result0].bind(axis_ko, thread_x)
+        schedule[result0].bind(axis_xi, thread_y)
+        schedule[result0].bind(axis_xo, block_x)
+
+        func = tvm.build(schedule, [placeholder_a, result0, result1], device, name="moments")
+        a_np = np.random.uniform(size=(num_m, num_n)).astype(placeholder_a.dtype)
+        buff_a = tvm.nd.array(a_np, dev)
+        buff_t0 = tvm.nd.array(np.zeros((num_m,), dtype="float32"), dev)
+        buff_t1 = tvm.nd.array(np.zeros((num_m,), dtype="float32"), dev)
+        func(buff_a, buff_t0, buff_t1)
+        tvm.testing.assert_allclose(buff_t0.numpy(), np.sum(a_np, axis=1), rtol=1e-3)
+        tvm.testing.assert_allclose(buff_t1.numpy(), np.sum(a_np * a_np, axis=1), rtol=1e-3)
+
+    check_target("cuda", num_m=4, num_n=4096, nthdx=1024, nthdy=1)
+    check_target("cuda", num_m=16, num_n=1024, nthdx=128, nthdy=4)
+    check_target("rocm", num_m=4, num_n=4096, nthdx=1024, nthdy=1)
+    check_target("rocm", num_m=16, num_n=1024, nthdx=128, nthdy=4)
+
+
 @tvm.testing.requires_cuda
 def test_reduce_storage_reuse():
     """Test reduction reuses storage."""
@@ -152,6 +152,86 @@ def test_mobilenet(enable_usmp: bool, target_kind: str):
     assert (runner.get_output(0).asnumpy() == list(ref_outputs.values())[0]).all()
 
 
+def test_parallel_dispatch():
+    """Checks independent operators are dispatched on the thread pool with parallel-dispatch"""
+    relay_model = textwrap.dedent(
+        """\
+        #[version = "0.0.5"]
+        def @main(%data : Tensor[(1, 8, 16, 16), float32], %w1 : Tensor[(8, 8, 3, 3), float32],
+                  %w2 : Tensor[(8, 8, 3, 3), float32]) {
+            %0 = nn.conv2d(%data, %w1, padding=[1, 1], channels=8, kernel_size=[3, 3]);
+            %1 = nn.conv2d(%data, %w2, padding=[1, 1], channels=8, kernel_size=[3, 3]);
+            %2 = nn.relu(%0);
+            %3 = sigmoid(%1);
+            add(%2, %3)
+        }
+    """
+    )
+    ir_mod = tvm.relay.fromtext(relay_model)
+    params = {
+        "w1": np.random.uniform(size=(8, 8, 3, 3)).astype("float32"),
+        "w2": np.random.uniform(size=(8, 8, 3, 3)).astype("float32"),
+    }
+    inputs = {"data": np.random.uniform(size=(1, 8, 16, 16)).astype("float32")}
+    ref_outputs = generate_ref_data(ir_mod, inputs, params)
+
+    with tvm.transform.PassContext(opt_level=3, config={"relay.FuseOps.max_depth": 1}):
+        mod = tvm.relay.build(
+            ir_mod,
+            params=params,
+            target="llvm",
+            executor=backend.Executor(
+                "aot", {"interface-api": "packed", "parallel-dispatch": True}
+            ),
+        )
+    # The operators themselves are serial in AOT, so only main launches parallel tasks.
+    llvm_mods = [m for m in [mod.lib] + list(mod.lib.imported_modules) if m.type_key == "llvm"]
+    assert any("TVMBackendParallelLaunch" in m.get_source("ll") for m in llvm_mods)
+
+    temp_dir = tvm.contrib.utils.TempDirectory()
+    test_so_path = temp_dir / "test.so"
+    mod.export_library(test_so_path, cc="c++", options=["-std=gnu++17", "-g3", "-O0"])
+    loaded_mod = tvm.runtime.load_module(test_so_path)
+    runner = tvm.runtime.executor.AotModule(loaded_mod["default"](tvm.cpu(0)))
+    runner.set_input(**inputs)
+    runner.run()
+    tvm.testing.assert_allclose(
+        runner.get_output(0).numpy(), list(ref_outputs.values())[0], rtol=1e-5
+    )
+
+
+@pytest.mark.parametrize("enable_usmp", [True, False])
+def test_clone(enable_usmp):
+    """Checks clones share the parameters, and run independently"""
+    x = relay.var("x", shape=(1, 8, 8, 8), dtype="float32")
+    w = relay.var("w", shape=(8, 8, 3, 3), dtype="float32")
+    out = relay.nn.relu(relay.nn.conv2d(relay.exp(x), w, padding=(1, 1)))
+    ir_mod = IRModule.from_expr(relay.Function([x, w], out))
+    params = {"w": np.random.uniform(size=(8, 8, 3, 3)).astype("float32")}
+    inputs = [{"x": np.random.uniform(size=(1, 8, 8, 8)).astype("float32")} for _ in range(2)]
+    ref_outputs = [list(generate_ref_data(ir_mod, i, params).values())[0] for i in inputs]
+
+    with tvm.transform.PassContext(opt_level=3, config={"tir.usmp.enable": enable_usmp}):
+        mod = tvm.relay.build(
+            ir_mod,
+            params=params,
+            target="llvm",
+            executor=backend.Executor("aot", {"interface-api": "packed"}),
+        )
+    temp_dir = tvm.contrib.utils.TempDirectory()
+    test_so_path = temp_dir / "test.so"
+    mod.export_library(test_so_path, cc="c++", options=["-std=gnu++17", "-g3", "-O0"])
+    loaded_mod = tvm.runtime.load_module(test_so_path)
+    runner = tvm.runtime.executor.AotModule(loaded_mod["default"](tvm.cpu(0)))
+    clone = runner.clone()
+    runner.set_input(**inputs[0])
+    clone.set_input(**inputs[1])
+    runner.run()
+    clone.run()
+    tvm.testing.assert_allclose(runner.get_output(0).numpy(), ref_outputs[0], rtol=1e-5)
+    tvm.testing.assert_allclose(clone.get_output(0).numpy(), ref_outputs[1], rtol=1e-5)
+
+
 def test_module_list():
     """Checks the correct list of module names is generated"""
     input_x = tvm.relay.var("x", tvm.relay.TensorType([1], dtype="float32"))
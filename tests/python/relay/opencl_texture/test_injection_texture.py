@@ -81,5 +81,25 @@ def test_layout_transform_to_block_nhwc(remote, target, dtype):
     build_run_compare(remote, mod, {}, {"data": input_shape}, {"data": dtype}, target)
 
 
+@tvm.testing.requires_opencl
+@tvm.testing.parametrize_targets("opencl -device=adreno")
+def test_concat_nchw4c_texture(remote, target, dtype):
+    """Verification of the concatenation of textures along the channel blocks"""
+    input_shape = (1, 8, 40, 40, 4)
+    A = relay.var("data", shape=input_shape, dtype=dtype)
+    B = relay.var("data2", shape=input_shape, dtype=dtype)
+    c = relay.concatenate([relay.nn.relu(A), relay.nn.relu(B)], axis=1)
+    mod = relay.Function([A, B], relay.add(c, relay.const(1, dtype)))
+
+    build_run_compare(
+        remote,
+        mod,
+        {},
+        {"data": input_shape, "data2": input_shape},
+        {"data": dtype, "data2": dtype},
+        target,
+    )
+
+
 if __name__ == "__main__":
     test_layout_transform_to_block_nhwc(None, "opencl -device=adreno", "float16")
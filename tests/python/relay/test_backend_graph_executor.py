@@ -324,6 +324,196 @@ def test_reshape_nop():
     tvm.testing.assert_allclose(gmod.get_output(2).numpy(), z2_np)
 
 
+@pytest.mark.parametrize(
+    "begin,end,is_view",
+    [([1], [3], True), ([1, 0], [2, 8], True), ([0, 4], [4, 8], False), ([0, 1], [1, 16], False)],
+    ids=["rows", "row_prefix", "cols", "unaligned"],
+)
+def test_strided_slice_view(begin, end, is_view):
+    # test that a contiguous slice, aligned in its input, is a view of the input
+    x = relay.var("x", shape=(4, 16))
+    w = relay.var("w", shape=(16, 16))
+    y = relay.nn.dense(x, w)
+    s = relay.strided_slice(y, begin=begin, end=end)
+    x_data = np.random.rand(4, 16).astype("float32")
+    w_data = np.random.rand(16, 16).astype("float32")
+    s_np = (x_data @ w_data.T)[tuple(slice(b, e) for b, e in zip(begin, end))]
+    w2 = relay.var("w2", shape=(8, s_np.shape[1]))
+    w2_data = np.random.rand(8, s_np.shape[1]).astype("float32")
+    func = relay.Function([x, w, w2], relay.nn.dense(s, w2))
+    graph = relay.build(tvm.IRModule.from_expr(func), "llvm")
+    graph_json = json.loads(graph.get_graph_json())
+
+    # The nodes of the kernels are the dense, the slice and the dense.
+    slice_nid = [nid for nid, node in enumerate(graph_json["nodes"]) if node["op"] == "tvm_op"][1]
+    slice_node = graph_json["nodes"][slice_nid]
+    assert (slice_node["attrs"]["func_name"] == "__nop") == is_view
+    if is_view:
+        # The slice shares the storage of the dense it slices, at the offset of its first row.
+        storage_ids = graph_json["attrs"]["storage_id"][1]
+        storage_offsets = graph_json["attrs"]["storage_offset"][1]
+        input_eid = graph_json["node_row_ptr"][slice_node["inputs"][0][0]]
+        slice_eid = graph_json["node_row_ptr"][slice_nid]
+        assert storage_ids[slice_eid] == storage_ids[input_eid]
+        assert storage_offsets[slice_eid] == storage_offsets[input_eid] + begin[0] * 16 * 4
+
+    gmod = graph_executor.GraphModule(graph["default"](tvm.cpu(0)))
+    gmod.set_input(x=x_data, w=w_data, w2=w2_data)
+    gmod.run()
+    tvm.testing.assert_allclose(gmod.get_output(0).numpy(), s_np @ w2_data.T, rtol=1e-5)
+
+
+@pytest.mark.parametrize("axis,in_place", [(0, True), (1, False)], ids=["rows", "cols"])
+def test_concatenate_in_place(axis, in_place):
+    # test that the producers of a contiguous concatenate write into its result
+    x = relay.var("x", shape=(4, 16))
+    w0 = relay.var("w0", shape=(16, 16))
+    w1 = relay.var("w1", shape=(16, 16))
+    c = relay.concatenate([relay.nn.dense(x, w0), relay.nn.dense(x, w1)], axis=axis)
+    x_data = np.random.rand(4, 16).astype("float32")
+    w0_data = np.random.rand(16, 16).astype("float32")
+    w1_data = np.random.rand(16, 16).astype("float32")
+    c_np = np.concatenate([x_data @ w0_data.T, x_data @ w1_data.T], axis=axis)
+    w2 = relay.var("w2", shape=(8, c_np.shape[1]))
+    w2_data = np.random.rand(8, c_np.shape[1]).astype("float32")
+    func = relay.Function([x, w0, w1, w2], relay.nn.dense(c, w2))
+    graph = relay.build(tvm.IRModule.from_expr(func), "llvm")
+    graph_json = json.loads(graph.get_graph_json())
+
+    # The nodes of the kernels are the two denses, the concatenate and the dense.
+    concat_nid = [nid for nid, node in enumerate(graph_json["nodes"]) if node["op"] == "tvm_op"][2]
+    concat_node = graph_json["nodes"][concat_nid]
+    assert (concat_node["attrs"]["func_name"] == "__nop") == in_place
+    if in_place:
+        # Each dense is stored in its slice of the storage of the concatenate.
+        storage_ids = graph_json["attrs"]["storage_id"][1]
+        storage_offsets = graph_json["attrs"]["storage_offset"][1]
+        concat_eid = graph_json["node_row_ptr"][concat_nid]
+        for i, (input_nid, _, _) in enumerate(concat_node["inputs"]):
+            input_eid = graph_json["node_row_ptr"][input_nid]
+            assert storage_ids[input_eid] == storage_ids[concat_eid]
+            assert storage_offsets[input_eid] == storage_offsets[concat_eid] + i * 4 * 16 * 4
+
+    gmod = graph_executor.GraphModule(graph["default"](tvm.cpu(0)))
+    gmod.set_input(x=x_data, w0=w0_data, w1=w1_data, w2=w2_data)
+    gmod.run()
+    tvm.testing.assert_allclose(gmod.get_output(0).numpy(), c_np @ w2_data.T, rtol=1e-5)
+
+
+@pytest.mark.parametrize("inplace", [False, True])
+def test_plan_memory_inplace(inplace):
+    # test that the residual add of a dense writes over its input at its last use
+    x = relay.var("x", shape=(4, 16))
+    w = relay.var("w", shape=(16, 16))
+    a = relay.exp(x)
+    func = relay.Function([x, w], relay.add(relay.nn.dense(x, w), a))
+    x_data = np.random.rand(4, 16).astype("float32")
+    w_data = np.random.rand(16, 16).astype("float32")
+
+    config = {"relay.backend.inplace_elemwise": inplace}
+    with tvm.transform.PassContext(opt_level=3, config=config):
+        graph = relay.build(tvm.IRModule.from_expr(func), "llvm")
+    graph_json = json.loads(graph.get_graph_json())
+
+    def _storage_id(name):
+        nid = next(nid for nid, node in enumerate(graph_json["nodes"]) if name in node["name"])
+        return graph_json["attrs"]["storage_id"][1][graph_json["node_row_ptr"][nid]]
+
+    assert (_storage_id("fused_exp") == _storage_id("fused_nn_dense_add")) == inplace
+
+    gmod = graph_executor.GraphModule(graph["default"](tvm.cpu(0)))
+    gmod.set_input(x=x_data, w=w_data)
+    gmod.run()
+    expected = x_data @ w_data.T + np.exp(x_data)
+    tvm.testing.assert_allclose(gmod.get_output(0).numpy(), expected, rtol=1e-5)
+
+
+@pytest.mark.parametrize("algorithm", ["greedy_by_size", "greedy_by_conflicts", "hill_climb"])
+def test_plan_memory_packing(algorithm):
+    x = relay.var("x", shape=(4, 256))
+    a = relay.exp(x)
+    b = relay.sqrt(a)
+    c = relay.concatenate([a, b], axis=1)
+    d = relay.sum(c, axis=1)
+    func = relay.Function([x], relay.add(d, relay.const(1.0)))
+    x_data = np.random.rand(4, 256).astype("float32")
+
+    config = {"relay.backend.graph_memory_planning_algorithm": algorithm}
+    with tvm.transform.PassContext(opt_level=0, config=config):
+        graph = relay.build(tvm.IRModule.from_expr(func), "llvm")
+    graph_json = json.loads(graph.get_graph_json())
+
+    # The intermediates are packed at distinct offsets into one storage id, while the input and
+    # the output keep their own.
+    storage_ids = graph_json["attrs"]["storage_id"][1]
+    storage_offsets = graph_json["attrs"]["storage_offset"][1]
+    assert len(storage_offsets) == len(storage_ids)
+    packed = [
+        (storage_offset, shape)
+        for storage_id, storage_offset, shape in zip(
+            storage_ids, storage_offsets, graph_json["attrs"]["shape"][1]
+        )
+        if storage_id == storage_ids[1]
+    ]
+    assert len(packed) > 2
+    assert all(storage_offset % 64 == 0 for storage_offset, _ in packed)
+    # a, b and c are live at once, so must not overlap.
+    live = sorted((offset, offset + 4 * int(np.prod(shape))) for offset, shape in packed[:3])
+    assert all(live[i][1] <= live[i + 1][0] for i in range(len(live) - 1))
+
+    gmod = graph_executor.GraphModule(graph["default"](tvm.cpu(0)))
+    gmod.set_input(x=x_data)
+    gmod.run()
+    exp = np.exp(x_data)
+    expected = np.concatenate([exp, np.sqrt(exp)], axis=1).sum(axis=1) + 1.0
+    tvm.testing.assert_allclose(gmod.get_output(0).numpy(), expected, rtol=1e-5)
+
+
+def test_plan_memory_static_workspace():
+    x = relay.var("x", shape=(4, 64))
+    a = relay.exp(x)
+    b = relay.sqrt(a)
+    func = relay.Function([x], relay.Tuple([relay.add(b, relay.const(1.0)), a]))
+    x_data = np.random.rand(4, 64).astype("float32")
+
+    config = {"relay.backend.graph_static_workspace": True}
+    with tvm.transform.PassContext(opt_level=0, config=config):
+        graph = relay.build(tvm.IRModule.from_expr(func), "llvm")
+    graph_json = json.loads(graph.get_graph_json())
+
+    # All the tensors but the constant are packed into one storage id.
+    storage_ids = graph_json["attrs"]["storage_id"][1]
+    storage_offsets = graph_json["attrs"]["storage_offset"][1]
+    constant_entries = [
+        graph_json["node_row_ptr"][nid]
+        for nid, node in enumerate(graph_json["nodes"])
+        if node["op"] == "null" and node["name"] != "x"
+    ]
+    assert len(constant_entries) == 1
+    workspace_ids = {
+        storage_id for eid, storage_id in enumerate(storage_ids) if eid not in constant_entries
+    }
+    assert len(workspace_ids) == 1
+    assert storage_ids[constant_entries[0]] not in workspace_ids
+    assert len(set(storage_offsets)) > 2
+
+    gmod = graph_executor.GraphModule(graph["default"](tvm.cpu(0)))
+    gmod.set_input(x=x_data)
+    gmod.run()
+    exp = np.exp(x_data)
+    tvm.testing.assert_allclose(gmod.get_output(0).numpy(), np.sqrt(exp) + 1.0, rtol=1e-5)
+    tvm.testing.assert_allclose(gmod.get_output(1).numpy(), exp, rtol=1e-5)
+
+
+def test_plan_memory_packing_unknown_algorithm():
+    x = relay.var("x", shape=(4,))
+    func = relay.Function([x], relay.exp(relay.exp(x)))
+    config = {"relay.backend.graph_memory_planning_algorithm": "first_fit"}
+    with pytest.raises(ValueError, match="unknown memory planning algorithm"):
+        with tvm.transform.PassContext(opt_level=0, config=config):
+            relay.build(tvm.IRModule.from_expr(func), "llvm")
+
+
 @tvm.testing.uses_gpu
 def test_gru_like():
     def unit(rnn_dim):
@@ -439,6 +629,82 @@ def test_graph_executor_nested_tuples():
     tvm.testing.assert_allclose(out[1][1][1].numpy(), data[3])
 
 
+@pytest.mark.parametrize("share_workspace", [False, True])
+def test_graph_executor_clone(share_workspace):
+    x = relay.var("x", shape=(4, 8), dtype="float32")
+    w = relay.var("w", shape=(16, 8), dtype="float32")
+    out = relay.nn.relu(relay.nn.dense(relay.exp(x), w))
+    func = relay.Function([x, w], out)
+    w_data = np.random.uniform(size=(16, 8)).astype("float32")
+    with tvm.transform.PassContext(opt_level=3):
+        lib = relay.build(tvm.IRModule.from_expr(func), "llvm", params={"w": w_data})
+    mod = graph_executor.GraphModule(lib["default"](tvm.cpu(0)))
+    clone = mod.clone(share_workspace)
+
+    # The parameters are shared, the inputs and the outputs are not.
+    def data_ptr(array):
+        return array.handle.contents.data
+
+    w_index = mod.get_input_index(list(lib.get_params().keys())[0])
+    x_index = mod.get_input_index("x")
+    assert data_ptr(mod.get_input(w_index)) == data_ptr(clone.get_input(w_index))
+    assert data_ptr(mod.get_input(x_index)) != data_ptr(clone.get_input(x_index))
+    assert data_ptr(mod.get_output(0)) != data_ptr(clone.get_output(0))
+
+    x_0 = np.random.uniform(size=(4, 8)).astype("float32")
+    x_1 = np.random.uniform(size=(4, 8)).astype("float32")
+    mod.set_input("x", x_0)
+    clone.set_input("x", x_1)
+    mod.run()
+    clone.run()
+    for executor, data in [(mod, x_0), (clone, x_1)]:
+        ref = np.maximum(np.exp(data) @ w_data.T, 0)
+        tvm.testing.assert_allclose(executor.get_output(0).numpy(), ref, rtol=1e-5)
+
+
+@tvm.testing.requires_llvm
+def test_graph_executor_param_layout_transform():
+    x = relay.var("x", shape=(4, 8), dtype="float32")
+    w = relay.var("w", shape=(8, 16), dtype="float32")
+    index_map = tvm.tir.IndexMap.from_func(lambda i, j: [j, i])
+    w_packed = relay.op._make.meta_schedule_layout_transform(w, index_map)
+    func = relay.Function([x, w], relay.nn.dense(x, w_packed))
+    with tvm.transform.PassContext(opt_level=3):
+        lib = relay.build(tvm.IRModule.from_expr(func), "llvm")
+    mod = graph_executor.GraphModule(lib["default"](tvm.cpu(0)))
+    # The weight is transformed when it is loaded, not at every run.
+    transforms = mod.get_param_layout_transforms()
+    assert list(transforms.keys()) == ["w"]
+    assert "layout_transform" in transforms["w"]
+
+    x_data = np.random.uniform(size=(4, 8)).astype("float32")
+    mod.set_input("x", x_data)
+    for _ in range(2):
+        w_data = np.random.uniform(size=(8, 16)).astype("float32")
+        mod.load_params(relay.save_param_dict({"w": w_data}))
+        mod.run()
+        mod.run()
+        tvm.testing.assert_allclose(mod.get_output(0).numpy(), x_data @ w_data, rtol=1e-5)
+    w_data = np.random.uniform(size=(8, 16)).astype("float32")
+    mod.set_input("w", w_data)
+    mod.run()
+    tvm.testing.assert_allclose(mod.get_output(0).numpy(), x_data @ w_data, rtol=1e-5)
+
+    # Writes through get_input, or into a buffer set without copy, are seen by the next run.
+    w_index = mod.get_input_index("w")
+    w_data = np.random.uniform(size=(8, 16)).astype("float32")
+    mod.get_input(w_index).copyfrom(w_data)
+    mod.run()
+    tvm.testing.assert_allclose(mod.get_output(0).numpy(), x_data @ w_data, rtol=1e-5)
+    w_buffer = tvm.nd.empty((8, 16), "float32")
+    mod.set_input_zero_copy("w", w_buffer)
+    for _ in range(2):
+        w_data = np.random.uniform(size=(8, 16)).astype("float32")
+        w_buffer.copyfrom(w_data)
+        mod.run()
+        tvm.testing.assert_allclose(mod.get_output(0).numpy(), x_data @ w_data, rtol=1e-5)
+
+
 def test_graph_executor_api():
     dname_0, dname_1 = "data_0", "data_1"
     data_0, data_1 = [relay.var(c, shape=(1, 1), dtype="float32") for c in [dname_0, dname_1]]
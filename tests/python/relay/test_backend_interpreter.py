@@ -285,5 +285,35 @@ def test_functional_returns():
     testing.assert_allclose(result2(c).numpy(), c)
 
 
+def test_compiled_cache_across_evaluations():
+    tvm.get_global_func("relay.backend.InterpreterClearCompiledCache")()
+    cache_size = tvm.get_global_func("relay.backend.InterpreterCompiledCacheSize")
+
+    x = relay.var("x", shape=(4,), dtype="float32")
+    func = relay.Function([x], relay.add(x, relay.const(1.0)))
+    data = np.arange(4, dtype="float32")
+    check_eval(func, [data], data + 1.0)
+    num_modules = cache_size()
+    assert num_modules > 0
+    # A fresh evaluation of the same primitive reuses the built module.
+    check_eval(func, [data], data + 1.0)
+    assert cache_size() == num_modules
+    # A different pass config is not served the module built under the default one.
+    with tvm.transform.PassContext(config={"tir.disable_vectorize": True}):
+        check_eval(func, [data], data + 1.0)
+    assert cache_size() > num_modules
+    num_modules = cache_size()
+
+    # The modules built under instruments are not cached.
+    @tvm.instrument.pass_instrument
+    class NoOpInstrument:
+        pass
+
+    with tvm.transform.PassContext(instruments=[NoOpInstrument()]):
+        check_eval(func, [data], data + 1.0)
+    assert cache_size() == num_modules
+    tvm.get_global_func("relay.backend.InterpreterClearCompiledCache")()
+
+
 if __name__ == "__main__":
     tvm.testing.main()
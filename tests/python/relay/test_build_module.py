@@ -15,6 +15,10 @@
 # specific language governing permissions and limitations
 # under the License.
 
+import os
+import tempfile
+
+import numpy as np
 import pytest
 
 import tvm
@@ -22,6 +26,7 @@ import tvm.testing
 from tvm import relay
 from tvm.target.target import Target
 from tvm.relay import testing
+from tvm.contrib import graph_executor
 from tvm.relay.backend import Runtime, Executor, graph_executor_codegen
 
 
@@ -99,5 +104,113 @@ def test_schedule_record():
     check_schedule(graph_executor_factory)
 
 
+@tvm.testing.requires_llvm
+def test_codegen_cache():
+    """Test to reuse the object code of the functions cached by a previous build"""
+    data = relay.var("data", shape=(1, 16), dtype="float32")
+    weight = relay.var("weight", shape=(8, 16), dtype="float32")
+    out = relay.nn.relu(relay.nn.dense(data, weight) + relay.const(1.0))
+    relay_mod = tvm.IRModule.from_expr(relay.Function([data, weight], out))
+    data_np = np.random.uniform(size=(1, 16)).astype("float32")
+    weight_np = np.random.uniform(size=(8, 16)).astype("float32")
+    ref = np.maximum(data_np @ weight_np.T + 1.0, 0.0)
+
+    with tempfile.TemporaryDirectory() as cache_dir, tempfile.TemporaryDirectory() as tmp_dir:
+        config = {"tir.codegen_cache_dir": cache_dir}
+        num_cached = None
+        for i in range(2):
+            with tvm.transform.PassContext(opt_level=3, config=config):
+                lib = relay.build(relay_mod, "llvm")
+            cached = os.listdir(cache_dir)
+            assert cached
+            # The second build only hits the cache
+            assert num_cached is None or len(cached) == num_cached
+            num_cached = len(cached)
+            path = os.path.join(tmp_dir, f"lib{i}.so")
+            lib.export_library(path)
+            dev = tvm.cpu()
+            module = graph_executor.GraphModule(tvm.runtime.load_module(path)["default"](dev))
+            module.set_input("data", data_np)
+            module.set_input("weight", weight_np)
+            module.run()
+            tvm.testing.assert_allclose(module.get_output(0).numpy(), ref, rtol=1e-5)
+
+
+@tvm.testing.requires_llvm
+def test_incremental_build():
+    """Test to reuse the unchanged primitive functions of the previous build"""
+    from tvm.relay.backend import te_compiler
+
+    def make_mod(head):
+        data = relay.var("data", shape=(1, 16), dtype="float32")
+        weight = relay.var("weight", shape=(8, 16), dtype="float32")
+        out = relay.nn.relu(relay.nn.dense(data, weight) + relay.const(1.0))
+        return tvm.IRModule.from_expr(relay.Function([data, weight], head(out)))
+
+    data_np = np.random.uniform(size=(1, 16)).astype("float32")
+    weight_np = np.random.uniform(size=(8, 16)).astype("float32")
+    hidden = np.maximum(data_np @ weight_np.T + 1.0, 0.0)
+
+    def build_and_run(relay_mod, **config):
+        with tvm.transform.PassContext(
+            opt_level=3, config={"relay.backend.incremental_build": True, **config}
+        ):
+            lib = relay.build(relay_mod, "llvm")
+        module = graph_executor.GraphModule(lib["default"](tvm.cpu()))
+        module.set_input("data", data_np)
+        module.set_input("weight", weight_np)
+        module.run()
+        return module.get_output(0).numpy(), te_compiler.incremental_build_stats()
+
+    te_compiler.clear_incremental_build_cache()
+    out, stats = build_and_run(make_mod(relay.nn.softmax))
+    exp = np.exp(hidden - hidden.max(axis=1, keepdims=True))
+    tvm.testing.assert_allclose(out, exp / exp.sum(axis=1, keepdims=True), rtol=1e-5)
+    assert stats["reused"] == 0
+
+    # The head is not fused with the dense layer, so only the new head is lowered
+    out, stats = build_and_run(make_mod(relay.nn.log_softmax))
+    tvm.testing.assert_allclose(out, np.log(exp / exp.sum(axis=1, keepdims=True)), rtol=1e-5)
+    assert stats["reused"] == 1
+    assert stats["lowered"] >= 1
+
+    # A change of the pass config may change every schedule, so nothing is reused
+    out, stats = build_and_run(make_mod(relay.nn.log_softmax), **{"tir.disable_vectorize": True})
+    tvm.testing.assert_allclose(out, np.log(exp / exp.sum(axis=1, keepdims=True)), rtol=1e-5)
+    assert stats["reused"] == 0
+    te_compiler.clear_incremental_build_cache()
+
+
+@tvm.testing.requires_llvm
+def test_codegen_num_partitions():
+    """Test to generate the host functions in several partitions"""
+    data = relay.var("data", shape=(1, 16), dtype="float32")
+    weight = relay.var("weight", shape=(8, 16), dtype="float32")
+    out = relay.nn.relu(relay.nn.dense(data, weight) + relay.const(1.0))
+    out = relay.sigmoid(relay.nn.softmax(out))
+    relay_mod = tvm.IRModule.from_expr(relay.Function([data, weight], out))
+    data_np = np.random.uniform(size=(1, 16)).astype("float32")
+    weight_np = np.random.uniform(size=(8, 16)).astype("float32")
+
+    def run(lib):
+        module = graph_executor.GraphModule(lib["default"](tvm.cpu()))
+        module.set_input("data", data_np)
+        module.set_input("weight", weight_np)
+        module.run()
+        return module.get_output(0).numpy()
+
+    with tvm.transform.PassContext(opt_level=3):
+        ref = run(relay.build(relay_mod, "llvm"))
+    config = {"tir.codegen_num_partitions": 2}
+    with tvm.transform.PassContext(opt_level=3, config=config):
+        lib = relay.build(relay_mod, "llvm")
+    assert "llvm" in [m.type_key for m in lib.get_lib().imported_modules]
+    tvm.testing.assert_allclose(run(lib), ref, rtol=1e-5)
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        path = os.path.join(tmp_dir, "lib.so")
+        lib.export_library(path)
+        tvm.testing.assert_allclose(run(tvm.runtime.load_module(path)), ref, rtol=1e-5)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
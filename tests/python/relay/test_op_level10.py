@@ -473,6 +473,48 @@ def test_batch_matmul(executor_kind):
     verify_batch_matmul_with_inputs(executor_kind, x, x, x_np, x_np, (10, 27, 27))
 
 
+def attention_ref(q, k, v, kv_length, scale, causal):
+    out = np.zeros(q.shape[:3] + v.shape[3:], dtype="float32")
+    for b in range(q.shape[0]):
+        length = kv_length[b] if kv_length.ndim == 1 else kv_length
+        scores = scale * np.matmul(q[b], k[b, :, :length].transpose(0, 2, 1))
+        if causal:
+            q_len = q.shape[2]
+            positions = np.arange(q_len)[:, None] + length - q_len
+            scores = np.where(np.arange(length)[None, :] <= positions, scores, -np.inf)
+        scores = np.exp(scores - scores.max(axis=-1, keepdims=True))
+        out[b] = np.matmul(scores / scores.sum(axis=-1, keepdims=True), v[b, :, :length])
+    return out
+
+
+@tvm.testing.uses_gpu
+@pytest.mark.parametrize("causal", [False, True])
+@pytest.mark.parametrize("kv_length", [None, 20, [7, 20]])
+def test_attention(executor_kind, causal, kv_length):
+    batch, heads, q_len, kv_len, head_size, value_size = 2, 3, 5, 24, 16, 8
+    q = relay.var("q", relay.TensorType((batch, heads, q_len, head_size), "float32"))
+    k = relay.var("k", relay.TensorType((batch, heads, kv_len, head_size), "float32"))
+    v = relay.var("v", relay.TensorType((batch, heads, kv_len, value_size), "float32"))
+    kv_length_np = np.array(kv_len if kv_length is None else kv_length, dtype="int32")
+    z = relay.nn.attention(
+        q, k, v, None if kv_length is None else relay.const(kv_length_np), causal=causal
+    )
+    zz = run_infer_type(z)
+    assert zz.checked_type == relay.TensorType((batch, heads, q_len, value_size), "float32")
+
+    q_np = np.random.uniform(-1, 1, size=(batch, heads, q_len, head_size)).astype("float32")
+    k_np = np.random.uniform(-1, 1, size=(batch, heads, kv_len, head_size)).astype("float32")
+    v_np = np.random.uniform(-1, 1, size=(batch, heads, kv_len, value_size)).astype("float32")
+    ref = attention_ref(q_np, k_np, v_np, kv_length_np, 1 / np.sqrt(head_size), causal)
+
+    func = relay.Function([q, k, v], z)
+    for target, dev in tvm.testing.enabled_targets():
+        out = relay.create_executor(executor_kind, device=dev, target=target).evaluate(func)(
+            q_np, k_np, v_np
+        )
+        tvm.testing.assert_allclose(out.numpy(), ref, rtol=1e-5, atol=1e-5)
+
+
 def batch_matmul_x86_test(b, m, n, k, target="llvm -mcpu=cascadelake", intrins=["vpdpbusd"]):
     x_shape = (b, m, k)
     y_shape = (b, n, k)
@@ -15,7 +15,9 @@
 # specific language governing permissions and limitations
 # under the License.
 
+import pytest
 import tvm
+import tvm.testing
 from tvm import te
 import numpy as np
 from tvm import relay
@@ -252,6 +254,55 @@ def test_per_channel_weight_scale():
         qnn_dense_driver(config)
 
 
+@tvm.testing.requires_cascadelake
+@pytest.mark.parametrize("input_zp,kernel_zp", [(0, 0), (2, 0), (2, 3)])
+def test_qnn_dense_vnni_without_canonicalization(input_zp, kernel_zp):
+    """qnn.dense + bias + qnn.requantize lowered natively, with the requantize in the epilogue."""
+    data_shape, weight_shape = (32, 96), (64, 96)
+    data = relay.var("data", shape=data_shape, dtype="uint8")
+    weight = relay.var("weight", shape=weight_shape, dtype="int8")
+    bias = relay.var("bias", shape=(weight_shape[0],), dtype="int32")
+    dense = relay.qnn.op.dense(
+        data,
+        weight,
+        input_zero_point=relay.const(input_zp),
+        kernel_zero_point=relay.const(kernel_zp),
+        input_scale=relay.const(0.08),
+        kernel_scale=relay.const(0.07),
+        units=weight_shape[0],
+    )
+    out = relay.qnn.op.requantize(
+        relay.nn.bias_add(dense, bias),
+        input_scale=relay.const(0.08 * 0.07),
+        input_zero_point=relay.const(0),
+        output_scale=relay.const(0.5),
+        output_zero_point=relay.const(10),
+        out_dtype="uint8",
+    )
+    mod = tvm.IRModule.from_expr(out)
+
+    target = "llvm -mcpu=cascadelake"
+    with tvm.transform.PassContext(opt_level=3, disabled_pass=["QnnCanonicalize"]):
+        lib = relay.build(mod, target=target)
+    assert "vpdpbusd" in lib.lib.get_source("asm")
+    with tvm.transform.PassContext(opt_level=3):
+        ref_lib = relay.build(mod, target=target)
+
+    np.random.seed(0)
+    inputs = {
+        "data": np.random.randint(0, 255, size=data_shape).astype("uint8"),
+        "weight": np.random.randint(-128, 127, size=weight_shape).astype("int8"),
+        "bias": np.random.randint(-1000, 1000, size=(weight_shape[0],)).astype("int32"),
+    }
+    dev = tvm.cpu(0)
+    outputs = []
+    for built in [lib, ref_lib]:
+        rt_mod = graph_executor.GraphModule(built["default"](dev))
+        rt_mod.run(**inputs)
+        outputs.append(rt_mod.get_output(0).numpy())
+    np.testing.assert_allclose(outputs[0], outputs[1], atol=1)
+
+
 if __name__ == "__main__":
     test_qnn_dense_without_bias()
     test_qnn_dense_with_bias()
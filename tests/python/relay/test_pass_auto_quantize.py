@@ -173,6 +173,39 @@ def test_calibrate_percentile():
         relay.quantize.quantize(mod, params, dataset)
 
 
+@pytest.mark.parametrize("calibrate_mode", ["kl_divergence", "percentile"])
+def test_calibrate_on_device(calibrate_mode):
+    mod, params = testing.synthetic.get_workload()
+    dataset = get_calibration_dataset(mod, "data")
+    with relay.quantize.qconfig(calibrate_mode=calibrate_mode, calibrate_on_device=True):
+        relay.quantize.quantize(mod, params, dataset)
+
+
+def test_reduce_stats():
+    mod, params = testing.synthetic.get_workload()
+    dataset = get_calibration_dataset(mod, "data")
+    from tvm.relay.quantize import _calibrate
+
+    with relay.quantize.qconfig(calibrate_mode="kl_divergence"):
+        mod = relay.quantize.prerequisite_optimize(mod, params)
+        with tvm.transform.PassContext(opt_level=3):
+            with relay.quantize.quantize_context():
+                mod = tvm.transform.Sequential(
+                    [relay.quantize.partition(), relay.quantize.annotate()]
+                )(mod)
+        samples = next(_calibrate.collect_stats(mod, dataset))
+        maxes = _calibrate.reduce_stats(mod, dataset, "max")
+        hists = _calibrate.reduce_stats(mod, dataset, "histogram", 101, maxes)
+
+    assert len(samples) == len(maxes) == len(hists)
+    for sample, max_val, hist in zip(samples, maxes, hists):
+        np.testing.assert_allclose(max_val, np.max(np.abs(sample)), rtol=1e-5)
+        expected, _ = np.histogram(sample, bins=101, range=(-max_val, max_val))
+        # the bins of the values on the bin edges may differ by rounding
+        assert int(hist.sum()) == sample.size
+        assert np.abs(hist - expected).sum() <= 0.01 * sample.size
+
+
 ####################################
 # Quant/Dequant Partitioning Tests #
 ####################################
@@ -15,12 +15,15 @@
 # specific language governing permissions and limitations
 # under the License.
 
+import math
+
 import tvm
 import tvm.testing
+import tvm.contrib.utils
 import pytest
 from tvm.relay.transform import CollagePartition, InferType, CapturePostDfsIndexInSpans
 from tvm.target import make_compilation_config
-from tvm.relay.collage import MockCostEstimator
+from tvm.relay.collage import CustomCostEstimator, MockCostEstimator
 from unittest.mock import patch
 from tvm.relay.dataflow_pattern import is_op, wildcard
 
@@ -56,12 +59,19 @@ def _mock_get_pattern_table(target):
 
 
 def run_collage(
-    input_mod, targets, cost_estimator, expected_mod, tvm_max_depth=8, byoc_max_depth=8
+    input_mod,
+    targets,
+    cost_estimator,
+    expected_mod,
+    tvm_max_depth=8,
+    byoc_max_depth=8,
+    extra_config=None,
 ):
     ctxt = {
         "relay.collage.tvm_max_depth": tvm_max_depth,
         "relay.collage.byoc_max_depth": byoc_max_depth,
     }
+    ctxt.update(extra_config or {})
     expected_mod = InferType()(expected_mod)
     pass_ctxt = tvm.transform.PassContext(config=ctxt)
     with pass_ctxt:
@@ -679,5 +689,90 @@ def test_pruning_heuristic(mock_get_pattern_table):
     run_collage(mod, targets, cost_estimator, expected_mod, tvm_max_depth=4, byoc_max_depth=4)
 
 
+@patch("tvm.relay.op.contrib.get_pattern_table", wraps=_mock_get_pattern_table)
+def test_cost_cache_file(mock_get_pattern_table):
+    mod_txt = """
+      #[version = "0.0.5"]
+      def @main(%x: Tensor[(10, 10), float32]) {
+        nn.relu(%x)
+      }
+    """
+    expected_txt = """
+      #[version = "0.0.5"]
+      def @main(%x: Tensor[(10, 10), float32]) -> Tensor[(10, 10), float32] {
+        nn.relu(%x)
+      }
+    """
+    targets = [
+        tvm.target.Target("llvm"),
+        tvm.target.Target("example_target_hook"),
+    ]
+    cost_cache_path = tvm.contrib.utils.tempdir().relpath("collage_costs.txt")
+    extra_config = {"relay.collage.cost_cache_path": cost_cache_path}
+
+    run_collage(
+        tvm.relay.fromtext(mod_txt),
+        targets,
+        MockCostEstimator({"llvm": 1, "example_target_hook": 2}),
+        tvm.relay.fromtext(expected_txt),
+        extra_config=extra_config,
+    )
+    with open(cost_cache_path) as cost_cache_file:
+        lines = cost_cache_file.readlines()
+    assert lines
+
+    # The costs recorded by the first run win over the ones the estimator would now give, and
+    # nothing is estimated again.
+    run_collage(
+        tvm.relay.fromtext(mod_txt),
+        targets,
+        MockCostEstimator({"llvm": 2, "example_target_hook": 1}),
+        tvm.relay.fromtext(expected_txt),
+        extra_config=extra_config,
+    )
+    with open(cost_cache_path) as cost_cache_file:
+        assert cost_cache_file.readlines() == lines
+
+
+@patch("tvm.relay.op.contrib.get_pattern_table", wraps=_mock_get_pattern_table)
+def test_cost_cache_file_skips_build_failures(mock_get_pattern_table):
+    mod_txt = """
+      #[version = "0.0.5"]
+      def @main(%x: Tensor[(10, 10), float32]) {
+        nn.relu(%x)
+      }
+    """
+    expected_txt = """
+      #[version = "0.0.5"]
+      def @main(%x: Tensor[(10, 10), float32]) -> Tensor[(10, 10), float32] {
+        nn.relu(%x)
+      }
+    """
+    targets = [
+        tvm.target.Target("llvm"),
+        tvm.target.Target("example_target_hook"),
+    ]
+
+    # The candidates of the BYOC target fail to build, e.g. as its codegen is not registered.
+    @tvm.register_func("tvm.relay.collage.test_estimate_seconds_byoc_fails", override=True)
+    def estimate_seconds(mod, target):  # pylint: disable=unused-variable
+        return math.inf if target.kind.name == "example_target_hook" else 1.0
+
+    cost_cache_path = tvm.contrib.utils.tempdir().relpath("collage_costs.txt")
+    run_collage(
+        tvm.relay.fromtext(mod_txt),
+        targets,
+        CustomCostEstimator("tvm.relay.collage.test_estimate_seconds_byoc_fails"),
+        tvm.relay.fromtext(expected_txt),
+        extra_config={"relay.collage.cost_cache_path": cost_cache_path},
+    )
+    with open(cost_cache_path) as cost_cache_file:
+        lines = cost_cache_file.readlines()
+    # Only the costs of the candidates which built are remembered
+    assert lines
+    assert all(line.split()[2] == "llvm" for line in lines)
+    assert all(math.isfinite(float(line.split()[1])) for line in lines)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -0,0 +1,101 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.relay import transform
+
+
+def run_opt_pass(expr, opt_pass):
+    assert isinstance(opt_pass, tvm.transform.Pass)
+    mod = tvm.IRModule.from_expr(expr)
+    mod = tvm.relay.transform.InferType()(mod)
+    mod = opt_pass(mod)
+    return mod["main"]
+
+
+def test_combine_independent_dense():
+    """Dense ops with different inputs are combined, except the one of another shape."""
+
+    def before(xs, ws):
+        ys = [relay.nn.dense(x, w) for x, w in zip(xs, ws)]
+        return relay.Function(xs + ws, relay.concatenate(ys, axis=1))
+
+    def expected(xs, ws):
+        y = relay.nn.batch_matmul(
+            relay.stack([xs[0], xs[1], xs[3]], axis=0), relay.stack([ws[0], ws[1], ws[3]], axis=0)
+        )
+        y0, y1, y3 = relay.split(y, 3)
+        ys = [
+            relay.squeeze(y0, [0]),
+            relay.squeeze(y1, [0]),
+            relay.nn.dense(xs[2], ws[2]),
+            relay.squeeze(y3, [0]),
+        ]
+        return relay.Function(xs + ws, relay.concatenate(ys, axis=1))
+
+    xs = [relay.var("x%d" % i, shape=(4, 8)) for i in range(4)]
+    ws = [relay.var("w%d" % i, shape=(16 if i == 2 else 6, 8)) for i in range(4)]
+    y = run_opt_pass(before(xs, ws), transform.CombineIndependentDense(3))
+    y_expected = run_opt_pass(expected(xs, ws), transform.InferType())
+    tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
+
+
+def test_combine_independent_dense_dependent():
+    """A dense op consuming another one is not combined with it."""
+
+    def before(x, w0, w1, w2):
+        y0 = relay.nn.dense(x, w0)
+        y1 = relay.nn.dense(x, w1)
+        y2 = relay.nn.dense(y0, w2)
+        return relay.Function([x, w0, w1, w2], relay.Tuple([y1, y2]))
+
+    x = relay.var("x", shape=(4, 8))
+    w0, w1, w2 = [relay.var("w%d" % i, shape=(8, 8)) for i in range(3)]
+    y = run_opt_pass(before(x, w0, w1, w2), transform.CombineIndependentDense(2))
+
+    def expected(x, w0, w1, w2):
+        # The dense ops are stacked in post-DFS order, which visits y1 first.
+        y = relay.nn.batch_matmul(relay.stack([x, x], axis=0), relay.stack([w1, w0], axis=0))
+        y1, y0 = relay.split(y, 2)
+        y2 = relay.nn.dense(relay.squeeze(y0, [0]), w2)
+        return relay.Function([x, w0, w1, w2], relay.Tuple([relay.squeeze(y1, [0]), y2]))
+
+    y_expected = run_opt_pass(expected(x, w0, w1, w2), transform.InferType())
+    tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
+
+
+def test_combine_independent_dense_scopes():
+    """Dense ops in if branches, nested functions and the outer body are not combined."""
+
+    def before(cond, x, ws):
+        a = relay.var("a", shape=(4, 8))
+        f = relay.Function([a], relay.nn.dense(a, ws[2]))
+        y_if = relay.If(cond, relay.nn.dense(x, ws[0]), relay.nn.dense(x, ws[1]))
+        y = relay.Tuple([y_if, f(x), relay.nn.dense(x, ws[3])])
+        return relay.Function([cond, x] + ws, y)
+
+    cond = relay.var("cond", shape=(), dtype="bool")
+    x = relay.var("x", shape=(4, 8))
+    ws = [relay.var("w%d" % i, shape=(6, 8)) for i in range(4)]
+    y = run_opt_pass(before(cond, x, ws), transform.CombineIndependentDense(2))
+    y_expected = run_opt_pass(before(cond, x, ws), transform.InferType())
+    tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -1114,5 +1114,48 @@ def test_fake_quantize_take():
     compare_fq_to_int(op, [x_np])
 
 
+def test_fake_quantize_softmax():
+    x = relay.var("x", shape=[4, 32], dtype="int8")
+    x = relay.qnn.op.dequantize(x, relay.const(0.1), relay.const(0))
+    op = relay.nn.softmax(x)
+    op = relay.nn.relu(op)
+    op = relay.qnn.op.quantize(op, relay.const(1.0 / 256), relay.const(-128), out_dtype="int8")
+
+    x_np = np.random.randint(-128, 127, size=[4, 32], dtype="int8")
+
+    compare_fq_to_int(op, [x_np], True)
+
+
+def test_fake_quantize_cost_check():
+    def fq2i(expr):
+        mod = tvm.IRModule.from_expr(expr)
+        mod = relay.transform.InferType()(mod)
+        with tvm.transform.PassContext(
+            config={"relay.FakeQuantizationToInteger.cost_check": True}
+        ):
+            mod_int = relay.transform.FakeQuantizationToInteger()(mod)
+        return mod, mod_int
+
+    x = relay.var("x", shape=[1, 16, 32, 32], dtype="int8")
+    w = relay.var("w", shape=[16, 16, 3, 3], dtype="int8")
+    zero = relay.const(0)
+    op = relay.op.nn.conv2d(
+        relay.qnn.op.dequantize(x, relay.const(2.0), zero),
+        relay.qnn.op.dequantize(w, relay.const(0.5), zero),
+        kernel_size=[3, 3],
+    )
+    op = relay.qnn.op.quantize(op, relay.const(1.0), zero, out_dtype="int8")
+    mod, mod_int = fq2i(op)
+    # The integer convolution outweighs its requantize.
+    assert not tvm.ir.structural_equal(mod, mod_int)
+
+    x = relay.var("x", shape=[4, 32], dtype="int8")
+    op = relay.nn.softmax(relay.qnn.op.dequantize(x, relay.const(0.1), zero))
+    op = relay.qnn.op.quantize(op, relay.const(1.0 / 256), relay.const(-128), out_dtype="int8")
+    mod, mod_int = fq2i(op)
+    # The softmax is computed in float either way, so nothing is saved.
+    assert tvm.ir.structural_equal(mod, mod_int)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
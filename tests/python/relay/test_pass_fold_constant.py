@@ -572,5 +572,34 @@ def test_pass_link_params():
     mod = tvm.relay.transform.FoldConstant()(mod)
 
 
+def test_fold_same_signature_reuses_kernel():
+    """Constant calls sharing an op, attributes and argument types fold to their own values."""
+    a_data = np.arange(6).reshape(2, 3).astype("float32")
+    b_data = np.ones((2, 3), "float32")
+    c_data = np.full((2, 3), 3, "float32")
+
+    def before():
+        x = relay.var("x", shape=(2, 3), dtype="float32")
+        y = relay.add(relay.const(a_data), relay.const(b_data))
+        z = relay.add(relay.const(a_data), relay.const(c_data))
+        return relay.Function([x], relay.add(relay.add(x, y), z))
+
+    def expected():
+        x = relay.var("x", shape=(2, 3), dtype="float32")
+        y = relay.const(a_data + b_data)
+        z = relay.const(a_data + c_data)
+        return relay.Function([x], relay.add(relay.add(x, y), z))
+
+    with tvm.transform.PassContext(opt_level=3):
+        zz = run_opt_pass(before(), transform.FoldConstant())
+    with tvm.transform.PassContext(opt_level=3, config={"relay.FoldConstant.share_cache": True}):
+        run_opt_pass(before(), transform.FoldConstant())
+        # A second run in the same context is served from the folded results.
+        zz_again = run_opt_pass(before(), transform.FoldConstant())
+    zexpected = run_opt_pass(expected(), transform.InferType())
+    tvm.ir.assert_structural_equal(zz, zexpected)
+    tvm.ir.assert_structural_equal(zz_again, zexpected)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
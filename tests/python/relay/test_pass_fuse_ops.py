@@ -625,6 +625,68 @@ def test_fuse_max():
     assert tvm.ir.structural_equal(zz, after)
 
 
+def test_fuse_cost_driven_broadcast_recompute():
+    """Test that fusing by cost does not recompute a producer for a much larger consumer"""
+
+    def before():
+        x = relay.var("x", shape=(1, 64))
+        y = relay.var("y", shape=(4096, 64))
+        z = relay.exp(relay.tanh(x))
+        w = relay.add(z, y)
+        return relay.Function([x, y], w)
+
+    def expected():
+        x = relay.var("p0", shape=(1, 64))
+        z = relay.exp(relay.tanh(x))
+        f1 = relay.Function([x], z)
+        f1 = f1.with_attr("Primitive", tvm.tir.IntImm("int32", 1))
+        x = relay.var("p0", shape=(1, 64))
+        y = relay.var("p1", shape=(4096, 64))
+        w = relay.add(x, y)
+        f2 = relay.Function([x, y], w)
+        f2 = f2.with_attr("Primitive", tvm.tir.IntImm("int32", 1))
+        x = relay.var("x", shape=(1, 64))
+        y = relay.var("y", shape=(4096, 64))
+        z = relay.Call(f1, [x])
+        w = relay.Call(f2, [z, y])
+        return relay.Function([x, y], w)
+
+    with tvm.transform.PassContext(config={"relay.FuseOps.cost_driven": True}):
+        zz = run_opt_pass(before(), transform.FuseOps())
+    after = run_opt_pass(expected(), transform.InferType())
+    assert tvm.ir.structural_equal(zz, after)
+
+
+def test_fuse_cost_driven_reduce_consumers():
+    """Test that fusing by cost fuses a reduction into its broadcast consumers"""
+
+    def before():
+        x = relay.var("x", shape=(16, 64))
+        s = relay.sum(x, axis=1, keepdims=True)
+        y = relay.divide(x, s)
+        z = relay.multiply(y, relay.const(2.0, "float32"))
+        return relay.Function([x], z)
+
+    def expected():
+        x = relay.var("p0", shape=(16, 64))
+        s = relay.sum(x, axis=1, keepdims=True)
+        y = relay.divide(x, s)
+        z = relay.multiply(y, relay.const(2.0, "float32"))
+        f1 = relay.Function([x], z)
+        f1 = f1.with_attr("Primitive", tvm.tir.IntImm("int32", 1))
+        x = relay.var("x", shape=(16, 64))
+        y = relay.Call(f1, [x])
+        return relay.Function([x], y)
+
+    config = {"relay.FuseOps.cost_driven": True, "relay.FuseOps.flops_per_byte": 4.0}
+    with tvm.transform.PassContext(config=config):
+        zz = run_opt_pass(before(), transform.FuseOps())
+    after = run_opt_pass(expected(), transform.InferType())
+    assert tvm.ir.structural_equal(zz, after)
+    with tvm.transform.PassContext(opt_level=3, config=config):
+        relay.build(tvm.IRModule.from_expr(before()), "llvm")
+
+
 link_params = tvm.testing.parameter(False, True)
 
 
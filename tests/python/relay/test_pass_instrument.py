@@ -16,11 +16,13 @@
 # under the License.
 """ Instrument test cases.
 """
+import json
+
 import pytest
 import tvm
 import tvm.relay
 from tvm.relay import op
-from tvm.ir.instrument import PassTimingInstrument, pass_instrument
+from tvm.ir.instrument import PassProfilingInstrument, PassTimingInstrument, pass_instrument
 
 
 def get_test_model():
@@ -59,6 +61,40 @@ def test_pass_timing_instrument():
     assert profiles == ""
 
 
+def test_pass_profiling_instrument():
+    profiler = PassProfilingInstrument()
+    seq = tvm.transform.Sequential(
+        [tvm.relay.transform.InferType(), tvm.relay.transform.FoldConstant()], name="seq"
+    )
+    with tvm.transform.PassContext(instruments=[profiler]):
+        seq(get_test_model())
+
+    # The profile is kept after the context is exited
+    profiles = profiler.render()
+    assert "seq" in profiles
+    assert "\tFoldConstant" in profiles
+    assert "nodes:" in profiles
+
+    events = json.loads(profiler.as_trace_json())["traceEvents"]
+    by_name = {event["name"]: event for event in events}
+    fold = by_name["FoldConstant"]
+    assert fold["ph"] == "X"
+    assert fold["args"]["nodes_before"] > 0
+    assert by_name["seq"]["dur"] >= fold["dur"]
+
+    # The function-level passes of TIR are broken down by functions
+    a = tvm.te.placeholder((16,), name="A")
+    b = tvm.te.compute((16,), lambda i: a[i] + 1.0, name="B")
+    func = tvm.te.create_prim_func([a, b])
+    mod = tvm.IRModule({"f0": func, "f1": func})
+    profiler = PassProfilingInstrument(count_nodes=False)
+    with tvm.transform.PassContext(instruments=[profiler]):
+        tvm.tir.transform.Simplify()(mod)
+    events = json.loads(profiler.as_trace_json())["traceEvents"]
+    assert sorted(e["name"] for e in events if e["cat"] == "function") == ["f0", "f1"]
+    assert "nodes_before" not in events[0]["args"]
+
+
 instrument_definition_type = tvm.testing.parameter("decorator", "subclass")
 
 
@@ -17,6 +17,7 @@
 """Test legalize pass"""
 import numpy as np
 import tvm
+import tvm.testing
 from tvm import te
 
 from tvm import relay
@@ -178,8 +179,39 @@ def test_legalize_multi_input():
     assert tvm.ir.structural_equal(a, b), "Actual = \n" + str(a)
 
 
+def test_legalize_einsum():
+    """Test the decomposition of an einsum into batch_matmul along a contraction path"""
+
+    def count_ops(expr):
+        counts = {}
+
+        def visit(node):
+            if isinstance(node, relay.Call):
+                counts[node.op.name] = counts.get(node.op.name, 0) + 1
+
+        relay.analysis.post_order_visit(expr, visit)
+        return counts
+
+    shapes = {"a": (8, 32), "b": (32, 4), "c": (4, 16)}
+    args = [relay.var(name, shape=shape) for name, shape in shapes.items()]
+    func = relay.Function(args, relay.einsum(args, "ij,jk,kl->il"))
+    legalized = run_opt_pass(func, transform.Legalize())
+    assert count_ops(legalized) == {"nn.batch_matmul": 2, "reshape": 6}, legalized
+
+    data = [np.random.uniform(size=shape).astype("float32") for shape in shapes.values()]
+    out = relay.create_executor("graph", target="llvm").evaluate(legalized)(*data)
+    tvm.testing.assert_allclose(out.numpy(), np.einsum("ij,jk,kl->il", *data), rtol=1e-5)
+
+    # An einsum with an ellipsis is kept
+    x = relay.var("x", shape=(2, 3, 4))
+    y = relay.var("y", shape=(2, 4, 5))
+    func = relay.Function([x, y], relay.einsum([x, y], "...ij,...jk->...ik"))
+    assert count_ops(run_opt_pass(func, transform.Legalize())) == {"einsum": 1}
+
+
 if __name__ == "__main__":
     test_legalize()
     test_legalize_none()
     test_legalize_multiple_ops()
     test_legalize_multi_input()
+    test_legalize_einsum()
@@ -1024,5 +1024,51 @@ def test_einsum_reshape_pattern():
     check_result(pattern_table, before(), expected())
 
 
+def test_patterns_of_uncalled_ops():
+    r"""Test patterns rooted at operators which are not called are skipped, while a pattern with
+    alternative root operators still merges.
+
+        a  b
+        \ /                 a  b
+        add      ====>      \ /
+         |               add_relu
+       relu                 |
+         |                tanh
+       tanh
+
+    """
+    pattern_table = [
+        ("conv2d_bias_relu", make_conv_bias_relu_pattern()),
+        ("add_relu", make_add_relu_pattern()),
+        ("sigmoid_or_tanh", is_op("sigmoid")(wildcard()) | is_op("tanh")(wildcard())),
+    ]
+
+    def before():
+        a = relay.var("a", shape=(10, 10))
+        b = relay.var("b", shape=(10, 10))
+        r = relay.nn.relu(relay.add(a, b))
+        return relay.Function([a, b], relay.tanh(r))
+
+    def expected():
+        a = relay.var("a", shape=(10, 10))
+        b = relay.var("b", shape=(10, 10))
+
+        in_1 = relay.var("in_1", shape=(10, 10))
+        in_2 = relay.var("in_2", shape=(10, 10))
+        add_relu = relay.Function([in_1, in_2], relay.nn.relu(relay.add(in_1, in_2)))
+        add_relu = add_relu.with_attr("Composite", "add_relu")
+        add_relu = add_relu.with_attr("PartitionedFromPattern", "add_nn.relu_")
+
+        in_3 = relay.var("in_3", shape=(10, 10))
+        tanh = relay.Function([in_3], relay.tanh(in_3))
+        tanh = tanh.with_attr("Composite", "sigmoid_or_tanh")
+        tanh = tanh.with_attr("PartitionedFromPattern", "tanh_")
+
+        r = relay.Call(tanh, [relay.Call(add_relu, [a, b])])
+        return relay.Function([a, b], r)
+
+    check_result(pattern_table, before(), expected())
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -0,0 +1,85 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Tests for the PlanLayoutTransforms pass."""
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.relay import transform
+
+
+def run_opt_pass(expr, opt_pass):
+    mod = tvm.IRModule.from_expr(expr)
+    mod = tvm.transform.Sequential([transform.InferType(), opt_pass, transform.InferType()])(mod)
+    return mod["main"]
+
+
+def test_remove_round_trip():
+    """Element-wise ops between inverse layout_transforms run in the outer layout."""
+
+    def before():
+        x = relay.var("x", shape=(1, 2, 4, 4, 16))
+        y = relay.layout_transform(x, "NCHW16c", "NCHW")
+        y = relay.add(relay.nn.relu(y), relay.const(1.0))
+        y = relay.layout_transform(y, "NCHW", "NCHW16c")
+        return relay.Function([x], y)
+
+    def expected():
+        x = relay.var("x", shape=(1, 2, 4, 4, 16))
+        y = relay.add(relay.nn.relu(x), relay.const(1.0))
+        return relay.Function([x], y)
+
+    after = run_opt_pass(before(), transform.PlanLayoutTransforms())
+    tvm.ir.assert_structural_equal(after, run_opt_pass(expected(), transform.InferType()))
+
+
+def test_transform_back_for_other_consumers():
+    """A region changes layout when the transform back for its other consumers costs less."""
+
+    def before():
+        x = relay.var("x", shape=(1, 2, 4, 4, 16))
+        y = relay.layout_transform(x, "NCHW16c", "NCHW")
+        y = relay.nn.relu(y)
+        z = relay.layout_transform(y, "NCHW", "NCHW16c")
+        return relay.Function([x], relay.Tuple([z, y]))
+
+    def expected():
+        x = relay.var("x", shape=(1, 2, 4, 4, 16))
+        y = relay.nn.relu(x)
+        return relay.Function([x], relay.Tuple([y, relay.layout_transform(y, "NCHW16c", "NCHW")]))
+
+    after = run_opt_pass(before(), transform.PlanLayoutTransforms())
+    tvm.ir.assert_structural_equal(after, run_opt_pass(expected(), transform.InferType()))
+
+
+def test_keep_cheaper_layout():
+    """A region stays in its layout when changing it moves more bytes."""
+
+    def before():
+        x = relay.var("x", shape=(1, 2, 4, 4, 16))
+        a = relay.var("a", shape=(1, 32, 4, 4))
+        b = relay.var("b", shape=(1, 32, 4, 4))
+        y = relay.layout_transform(x, "NCHW16c", "NCHW")
+        y = relay.add(relay.add(y, a), b)
+        return relay.Function([x, a, b], y)
+
+    before_func = run_opt_pass(before(), transform.InferType())
+    after = run_opt_pass(before(), transform.PlanLayoutTransforms())
+    tvm.ir.assert_structural_equal(after, before_func)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -0,0 +1,94 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Tests for the Rematerialize pass."""
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.relay import transform
+
+
+def run_opt_pass(expr, opt_pass):
+    mod = tvm.IRModule.from_expr(expr)
+    mod = tvm.transform.Sequential([transform.InferType(), opt_pass, transform.InferType()])(mod)
+    return mod["main"]
+
+
+def chain(x, num_ops):
+    for _ in range(num_ops):
+        x = relay.tanh(x)
+    return x
+
+
+def test_recompute_for_late_consumer():
+    """A tensor read early and late is recomputed from the parameter at its late consumer."""
+
+    def before():
+        x = relay.var("x", shape=(64, 64))
+        a = relay.exp(x)
+        return relay.Function([x], relay.add(chain(a, 3), a))
+
+    def expected():
+        x = relay.var("x", shape=(64, 64))
+        a = relay.exp(x)
+        return relay.Function([x], relay.add(chain(a, 3), relay.exp(x)))
+
+    after = run_opt_pass(before(), transform.Rematerialize(0))
+    tvm.ir.assert_structural_equal(after, run_opt_pass(expected(), transform.InferType()))
+
+
+def test_keep_within_budget():
+    """Nothing is recomputed when the live tensors already fit in the budget."""
+    x = relay.var("x", shape=(64, 64))
+    a = relay.exp(x)
+    func = relay.Function([x], relay.add(chain(a, 3), a))
+
+    after = run_opt_pass(func, transform.Rematerialize(1 << 20))
+    tvm.ir.assert_structural_equal(after, run_opt_pass(func, transform.InferType()))
+
+
+def test_keep_when_inputs_would_live_longer():
+    """A tensor whose input is freed early is not recomputed, nor are the non-injective ops."""
+    x = relay.var("x", shape=(64, 64))
+    w = relay.var("w", shape=(64, 64))
+    a = relay.exp(relay.nn.relu(x))
+    d = relay.nn.dense(x, w)
+    y = relay.add(relay.add(chain(a, 3), chain(d, 3)), relay.add(a, d))
+    func = relay.Function([x, w], y)
+
+    after = run_opt_pass(func, transform.Rematerialize(0))
+    tvm.ir.assert_structural_equal(after, run_opt_pass(func, transform.InferType()))
+
+
+def test_build_with_memory_budget():
+    """The build runs the pass from the config, and computes the same result."""
+    x = relay.var("x", shape=(64, 64))
+    a = relay.exp(x)
+    mod = tvm.IRModule.from_expr(relay.Function([x], relay.add(chain(a, 3), a)))
+    x_np = np.random.uniform(-1, 1, size=(64, 64)).astype("float32")
+
+    with tvm.transform.PassContext(
+        opt_level=3, config={"relay.Rematerialize.memory_budget": 0}
+    ):
+        res = relay.create_executor("graph", mod=mod, target="llvm").evaluate()(x_np)
+    expected = np.exp(x_np)
+    tvm.testing.assert_allclose(res.numpy(), np.tanh(np.tanh(np.tanh(expected))) + expected, 1e-5)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -0,0 +1,97 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Tests for the ShardDense pass."""
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.relay import transform
+
+DEVICES = [tvm.target.VirtualDevice(tvm.cpu(i), tvm.target.Target("llvm")) for i in range(2)]
+
+
+def run_opt_pass(expr, opt_pass):
+    mod = tvm.IRModule.from_expr(expr)
+    mod = tvm.transform.Sequential([transform.InferType(), opt_pass, transform.InferType()])(mod)
+    return mod["main"]
+
+
+def _dense(weight):
+    x = relay.var("x", shape=(3, 8))
+    return relay.Function([x], relay.nn.dense(x, relay.const(weight)))
+
+
+def test_shard_by_column():
+    weight = np.random.uniform(-1, 1, (6, 8)).astype("float32")
+
+    def expected():
+        x = relay.var("x", shape=(3, 8))
+        shards = [
+            relay.annotation.on_device(
+                relay.nn.dense(x, relay.const(weight[3 * i : 3 * (i + 1)]), units=3), DEVICES[i]
+            )
+            for i in range(2)
+        ]
+        return relay.Function([x], relay.concatenate(shards, -1))
+
+    after = run_opt_pass(_dense(weight), transform.ShardDense(DEVICES, "column"))
+    tvm.ir.assert_structural_equal(after, run_opt_pass(expected(), transform.InferType()))
+
+
+def test_shard_by_row():
+    weight = np.random.uniform(-1, 1, (6, 8)).astype("float32")
+
+    def expected():
+        x = relay.var("x", shape=(3, 8))
+        shards = [
+            relay.annotation.on_device(
+                relay.nn.dense(
+                    relay.strided_slice(x, [4 * i], [4 * (i + 1)], axes=[1]),
+                    relay.const(weight[:, 4 * i : 4 * (i + 1)]),
+                ),
+                DEVICES[i],
+            )
+            for i in range(2)
+        ]
+        return relay.Function([x], relay.add(shards[0], shards[1]))
+
+    after = run_opt_pass(_dense(weight), transform.ShardDense(DEVICES, "row"))
+    tvm.ir.assert_structural_equal(after, run_opt_pass(expected(), transform.InferType()))
+
+
+def test_indivisible_weight_is_kept():
+    weight = np.random.uniform(-1, 1, (5, 8)).astype("float32")
+    after = run_opt_pass(_dense(weight), transform.ShardDense(DEVICES, "column"))
+    tvm.ir.assert_structural_equal(after, run_opt_pass(_dense(weight), transform.InferType()))
+
+
+@tvm.testing.requires_llvm
+def test_sharded_result():
+    weight = np.random.uniform(-1, 1, (6, 8)).astype("float32")
+    x_data = np.random.uniform(-1, 1, (3, 8)).astype("float32")
+    for mode in ["column", "row"]:
+        mod = tvm.IRModule.from_expr(_dense(weight))
+        mod = transform.ShardDense(DEVICES, mode)(transform.InferType()(mod))
+        result = relay.create_executor("vm", mod, device=tvm.cpu(), target="llvm").evaluate()(
+            x_data
+        )
+        tvm.testing.assert_allclose(result.numpy(), x_data @ weight.T, rtol=1e-5)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -623,5 +623,52 @@ def test_pipeline():
             reset_cpu_affinity(affinity)
 
 
+def test_pipeline_stage_statistics():
+    if pipeline_executor_build.pipeline_executor_build_enabled():
+        dshape = (3, 3)
+        data_0 = relay.var("data_0", relay.TensorType(dshape, "float32"))
+        data_1 = relay.var("data_1", relay.TensorType(dshape, "float32"))
+        mod1 = tvm.IRModule.from_expr(relay.Function([data_0], relay.add(data_0, data_0)))
+        mod2 = tvm.IRModule.from_expr(relay.Function([data_1], relay.multiply(data_1, data_1)))
+
+        pipe_config = pipeline_executor_build.PipelineConfig()
+        pipe_config["input"]["data_a"].connect(pipe_config[mod1]["input"]["data_0"])
+        pipe_config[mod1]["output"][0].connect(pipe_config[mod2]["input"]["data_1"])
+        pipe_config[mod2]["output"][0].connect(pipe_config["output"]["0"])
+        for mod in [mod1, mod2]:
+            pipe_config[mod].target = "llvm"
+            pipe_config[mod].dev = tvm.cpu(0)
+        pipe_config.queue_capacity = 1
+        with tvm.transform.PassContext(opt_level=3):
+            pipeline_mod_factory = pipeline_executor_build.build(pipe_config)
+        pipeline_module = pipeline_executor.PipelineModule(pipeline_mod_factory)
+
+        # Waiting for the output of each run before starting the next one, each forwarding
+        # queue holds at most one item and no stage ever waits on a full queue.
+        num_runs = 4
+        for i in range(num_runs):
+            data = np.full(dshape, i).astype("float32")
+            pipeline_module.set_input("data_a", tvm.nd.array(data))
+            pipeline_module.run()
+            outputs = pipeline_module.get_output()
+            wait_time = 0
+            while len(outputs) == 0:
+                assert wait_time < 5
+                time.sleep(1)
+                wait_time = wait_time + 1
+                outputs = pipeline_module.get_output()
+            tvm.testing.assert_allclose(outputs[0].numpy(), (data + data) * (data + data))
+
+        stage_statistics = pipeline_module.get_stage_statistics()
+        assert len(stage_statistics) == 2
+        # The first stage is fed by the caller and has no forwarding queue.
+        expected_max_queue_depth = [0, 1]
+        for stage, max_queue_depth in zip(stage_statistics, expected_max_queue_depth):
+            assert stage["Count"].value == num_runs
+            assert stage["Backpressure (us)"].microseconds == 0
+            assert stage["Queue Depth"].value == 0
+            assert stage["Max Queue Depth"].value == max_queue_depth
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -537,5 +537,36 @@ def test_convert_follow_node_with_integer_arguments(target_precision):
     assert tvm.ir.structural_equal(expected_mod, output_mod)
 
 
+def test_cost_aware_skips_unprofitable_ops():
+    """In cost aware mode, a dense op whose casts cost more than its speedup stays in fp32."""
+    data = relay.var("data", shape=[128, 512])
+    small_weight = relay.var("small_weight", shape=[1024, 8])
+    big = relay.nn.dense(data, relay.const(np.zeros([512, 512], "float32")))
+    small = relay.nn.dense(relay.var("small_data", shape=[1, 8]), small_weight)
+    mod = InferType()(tvm.IRModule.from_expr(relay.Tuple([big, small])))
+    with tvm.transform.PassContext(config={"relay.ToMixedPrecision.cost_aware": True}):
+        output_mod = ToMixedPrecision("float16")(mod)
+    big_type, small_type = output_mod["main"].body.checked_type.fields
+    assert big_type.dtype == "float16"
+    assert small_type.dtype == "float32"
+
+
+def test_mixed_precision_within_budget():
+    """The budget helper returns a mixed precision module when its error is within budget."""
+    data = relay.var("data", shape=[1024, 64])
+    weight = relay.var("weight", shape=[64, 64])
+    mod = tvm.IRModule.from_expr(relay.nn.dense(data, weight))
+    inputs = [
+        {
+            "data": np.random.uniform(-1, 1, size=[1024, 64]).astype("float32"),
+            "weight": np.random.uniform(-1, 1, size=[64, 64]).astype("float32"),
+        }
+    ]
+    amp_mod = mixed_precision.to_mixed_precision_within_budget(mod, inputs, budget=0.05)
+    assert amp_mod["main"].body.checked_type.dtype == "float16"
+    fp32_mod = mixed_precision.to_mixed_precision_within_budget(mod, inputs, budget=0.0)
+    assert fp32_mod["main"].body.checked_type.dtype == "float32"
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -590,5 +590,62 @@ def test_argreduce_infer_return_type():
         )
 
 
+def test_incremental_infer_type():
+    """Rewritten expressions and their users are re-checked, the rest keeps its types."""
+    x = relay.var("x", shape=(2, 3), dtype="float32")
+    y = relay.nn.relu(relay.add(x, relay.const(1.0)))
+    z = relay.exp(relay.add(x, relay.const(2.0)))
+    mod = tvm.IRModule.from_expr(relay.Function([x], relay.Tuple([y, z])))
+
+    with tvm.transform.PassContext(config={"relay.InferType.incremental": True}):
+        mod = transform.InferType()(mod)
+        relu, exp = mod["main"].body.fields
+        widened = relay.concatenate([exp, exp], axis=0)
+        mod = tvm.IRModule.from_expr(relay.Function([x], relay.Tuple([relu, widened])))
+        incremental = transform.InferType()(mod)
+    full = transform.InferType()(mod)
+
+    tvm.ir.assert_structural_equal(incremental, full)
+    assert incremental["main"].body.fields[0].same_as(relu)
+    assert incremental["main"].body.fields[1].checked_type == relay.TensorType((4, 3), "float32")
+
+
+def test_incremental_infer_type_after_cpp_passes():
+    """Rewrites of C++ passes that copy nodes with their old types are re-checked."""
+
+    def before():
+        x = relay.var("x", shape=(1, 16), dtype="float32")
+        w = relay.var("w", shape=(4, 4), dtype="float32")
+        r = relay.reshape(x, relay.shape_of(w))
+        y = relay.nn.relu(relay.add(relay.nn.relu(r), w))
+        return tvm.IRModule.from_expr(relay.Function([x, w], y))
+
+    def checked_types(mod):
+        types = []
+
+        def visit(expr):
+            if not isinstance(expr, tvm.ir.Op):
+                types.append(str(expr.checked_type))
+
+        relay.analysis.post_order_visit(mod["main"], visit)
+        return types
+
+    seq = tvm.transform.Sequential(
+        [
+            transform.InferType(),
+            transform.DynamicToStatic(),
+            transform.InferType(),
+            transform.SimplifyExpr(),
+            transform.FoldConstant(),
+            transform.InferType(),
+        ]
+    )
+    with tvm.transform.PassContext(config={"relay.InferType.incremental": True}):
+        incremental = seq(before())
+    full = seq(before())
+
+    tvm.ir.assert_structural_equal(incremental, full)
+    assert checked_types(incremental) == checked_types(full)
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -1255,6 +1255,21 @@ def test_shape_func_nested_function():
     compiler.lower(mod, "llvm")
 
 
+def test_shape_func_memoized_with_changing_shapes():
+    x = relay.var("x", shape=(relay.Any(),), dtype="float32")
+    newshape = relay.var("newshape", shape=(2,), dtype="int64")
+    y = relay.reshape(x + relay.const(1.0), newshape)
+    mod = tvm.IRModule.from_expr(relay.Function([x, newshape], y))
+    exe = relay.vm.compile(mod, "llvm")
+    vm = runtime.vm.VirtualMachine(exe, tvm.cpu())
+
+    # The shape functions see inputs they saw before, and new ones, in turn.
+    for size, shape in [(16, (2, 8)), (16, (4, 4)), (16, (2, 8)), (12, (3, 4)), (16, (4, 4))]:
+        x_np = np.arange(size).astype("float32")
+        res = vm.invoke("main", x_np, np.array(shape, dtype="int64"))
+        tvm.testing.assert_allclose(res.numpy(), (x_np + 1).reshape(shape))
+
+
 @tvm.testing.requires_cuda
 def test_storage_size_and_offset_on_cpu():
     """Tests allocations place sizes and offsets on the CPU host even if the rest
@@ -1359,6 +1374,32 @@ def test_multi_targets():
     tvm.testing.assert_allclose(actual_result.numpy(), expected_result)
 
 
+@tvm.testing.requires_cuda
+def test_copy_between_gpus():
+    if not tvm.cuda(1).exist:
+        pytest.skip("Needs two CUDA devices")
+    n = 10
+    x = relay.var("x", shape=(n,))
+    y = relay.var("y", shape=(n,))
+    second_gpu = tvm.target.VirtualDevice(tvm.cuda(1), tvm.target.Target("cuda"))
+    f = relay.Function([x, y], x + relay.op.annotation.on_device(y * y, second_gpu))
+    mod = IRModule.from_expr(f)
+    with tvm.transform.PassContext(
+        opt_level=3, config={"relay.fallback_device_type": tvm.cuda().device_type}
+    ):
+        exe = relay.vm.compile(
+            mod, target={"cpu": tvm.target.Target("llvm"), "cuda": tvm.target.Target("cuda")}
+        )
+    assert "device type 2 and id 1" in exe.virtual_devices
+
+    # The virtual device on cuda(1) runs on the second GPU rather than on the first one
+    vm = runtime.vm.VirtualMachine(exe, [tvm.cuda(0), tvm.cuda(1), tvm.cpu()])
+    x_data = np.random.rand(n).astype("float32")
+    y_data = np.random.rand(n).astype("float32")
+    actual_result = vm.invoke("main", x_data, y_data)
+    tvm.testing.assert_allclose(actual_result.numpy(), x_data + y_data * y_data, rtol=1e-6)
+
+
 def test_let_bound_constants():
     """This tests for an ICHECK failure for ill-formed IR with let-bound constants"""
 
@@ -1421,6 +1462,26 @@ def test_large_constants():
     tvm.testing.assert_allclose(expected, actual.numpy())
 
 
+def test_reload_late_bound_consts_after_run():
+    """Constants loaded again replace the ones copied for the previous runs."""
+    dev = tvm.cpu()
+    x = relay.var("x", shape=(100, 100))
+    const_data = np.random.rand(100, 100).astype("float32")
+    func = relay.Function([x], relay.op.add(x, relay.const(const_data)))
+    vm_exec = vm.compile(tvm.IRModule.from_expr(func), target="llvm")
+
+    consts_map = vm_exec.get_late_bound_consts(byte_limit=256)
+    vm_exec.load_late_bound_consts_from_map(consts_map)
+    the_vm = runtime.vm.VirtualMachine(vm_exec, dev)
+    x_data = np.random.rand(100, 100).astype("float32")
+    tvm.testing.assert_allclose(the_vm.invoke("main", x_data).numpy(), x_data + const_data)
+
+    (name,) = vm_exec.get_late_bound_consts(byte_limit=256).keys()
+    new_data = np.random.rand(100, 100).astype("float32")
+    vm_exec.load_late_bound_consts_from_map({name: tvm.nd.array(new_data)})
+    tvm.testing.assert_allclose(the_vm.invoke("main", x_data).numpy(), x_data + new_data)
+
+
 def test_load_late_bound_consts_with_no_late_bound_consts():
     """Check that load_late_bound_consts handles a model with no late bound consts."""
     target = tvm.target.Target("llvm")
@@ -1563,5 +1624,103 @@ def test_load_late_bound_consts_via_map_with_no_late_bound_consts():
     tvm.testing.assert_allclose(expected, actual.numpy())
 
 
+def test_plan_static_storage():
+    """Check that statically sized intermediates share a single arena allocation."""
+    target = tvm.target.Target("llvm")
+    dev = tvm.cpu()
+    mod, params = mlp.get_workload(batch_size=1)
+
+    exe = vm.compile(mod, target=target, params=params)
+    with tvm.transform.PassContext(opt_level=3, config={"relay.vm.plan_static_storage": True}):
+        planned_exe = vm.compile(mod, target=target, params=params)
+    assert planned_exe.bytecode.count("alloc_storage") < exe.bytecode.count("alloc_storage")
+
+    data = np.random.rand(1, 1, 28, 28).astype("float32")
+    expected = runtime.vm.VirtualMachine(exe, dev).invoke("main", data)
+    actual = runtime.vm.VirtualMachine(planned_exe, dev).invoke("main", data)
+    tvm.testing.assert_allclose(expected.numpy(), actual.numpy(), rtol=1e-5)
+
+
+
+def test_inplace_elemwise():
+    """Check that an elementwise call writes its result over an input at its only use."""
+    target = tvm.target.Target("llvm")
+    dev = tvm.cpu()
+    x = relay.var("x", shape=(4, 16))
+    w = relay.var("w", shape=(16, 16))
+    a = relay.exp(x)
+    func = relay.Function([x, w], relay.add(relay.nn.dense(x, w), a))
+    mod = tvm.IRModule.from_expr(func)
+
+    exe = vm.compile(mod, target=target)
+    with tvm.transform.PassContext(opt_level=3, config={"relay.backend.inplace_elemwise": True}):
+        inplace_exe = vm.compile(mod, target=target)
+    assert inplace_exe.bytecode.count("alloc_tensor") < exe.bytecode.count("alloc_tensor")
+
+    x_data = np.random.rand(4, 16).astype("float32")
+    w_data = np.random.rand(16, 16).astype("float32")
+    actual = runtime.vm.VirtualMachine(inplace_exe, dev).invoke("main", x_data, w_data)
+    expected = x_data @ w_data.T + np.exp(x_data)
+    tvm.testing.assert_allclose(actual.numpy(), expected, rtol=1e-5)
+
+
+
+def test_parallel_function_compilation():
+    """Check that compiling the VMFunctions in parallel gives the same executable."""
+    target = tvm.target.Target("llvm")
+    mod = tvm.IRModule({})
+    sum_up = relay.GlobalVar("sum_up")
+    i = relay.var("i", shape=[], dtype="int32")
+    accum = relay.var("accum", shape=[], dtype="int32")
+    sb = ScopeBuilder()
+    with sb.if_scope(relay.equal(i, relay.const(0, "int32"))):
+        sb.ret(accum)
+    with sb.else_scope():
+        one_less = relay.subtract(i, relay.const(1, "int32"))
+        new_accum = relay.add(accum, relay.multiply(i, relay.const(2, "int32")))
+        sb.ret(relay.Call(sum_up, [one_less, new_accum]))
+    mod[sum_up] = relay.Function([i, accum], sb.get())
+    iarg = relay.var("i", shape=[], dtype="int32")
+    aarg = relay.var("accum", shape=[], dtype="int32")
+    mod["main"] = relay.Function([iarg, aarg], relay.add(sum_up(iarg, aarg), relay.const(3)))
+
+    exe = vm.compile(mod, target=target)
+    with tvm.transform.PassContext(opt_level=3, config={"relay.vm.num_parallel_jobs": 4}):
+        parallel_exe = vm.compile(mod, target=target)
+    assert parallel_exe.bytecode == exe.bytecode
+    assert parallel_exe.constants == exe.constants
+    assert parallel_exe.primitive_ops == exe.primitive_ops
+
+    i_data = np.array(5, dtype="int32")
+    accum_data = np.array(0, dtype="int32")
+    result = runtime.vm.VirtualMachine(parallel_exe, tvm.cpu()).invoke("main", i_data, accum_data)
+    assert result.numpy() == 2 * sum(range(1, 6)) + 3
+
+
+def test_concatenate_in_place():
+    """Check that the producers of a contiguous concatenate allocate in its result."""
+    target = tvm.target.Target("llvm")
+    dev = tvm.cpu()
+    x = relay.var("x", shape=(4, 16))
+    w0 = relay.var("w0", shape=(16, 16))
+    w1 = relay.var("w1", shape=(16, 16))
+    w2 = relay.var("w2", shape=(8, 16))
+    c = relay.concatenate([relay.nn.dense(x, w0), relay.nn.dense(x, w1)], axis=0)
+    func = relay.Function([x, w0, w1, w2], relay.nn.dense(c, w2))
+    mod = tvm.IRModule.from_expr(func)
+
+    exe = vm.compile(mod, target=target)
+    # The concatenate is not invoked, only the denses are.
+    assert exe.bytecode.count("invoke_packed") == 3
+
+    x_data = np.random.rand(4, 16).astype("float32")
+    w0_data = np.random.rand(16, 16).astype("float32")
+    w1_data = np.random.rand(16, 16).astype("float32")
+    w2_data = np.random.rand(8, 16).astype("float32")
+    actual = runtime.vm.VirtualMachine(exe, dev).invoke("main", x_data, w0_data, w1_data, w2_data)
+    c_np = np.concatenate([x_data @ w0_data.T, x_data @ w1_data.T], axis=0)
+    tvm.testing.assert_allclose(actual.numpy(), c_np @ w2_data.T, rtol=1e-5)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -1204,5 +1204,22 @@ def test_iter_map_simplify_unit_loop_order():
     )
 
 
+def test_deep_fused_split_chain():
+    """Deep chains of fuse and split, as produced by composed layout transforms"""
+    for depth, factor in [(6, 4), (6, 8), (8, 2)]:
+        iters = [(tvm.tir.Var("x%d" % i, "int32"), 4) for i in range(depth)]
+        axis = ifuse(iters)
+        indices = []
+        while True:
+            outer, inner = isplit(axis, factor)
+            indices.append(inner[0])
+            axis = outer
+            if tvm.arith.Analyzer().simplify(axis[1]).value <= factor:
+                indices.append(axis[0])
+                break
+        res = tvm.arith.detect_iter_map(indices[::-1], var_dom(iters), check_level="bijective")
+        assert len(res.indices) == len(indices), res.errors
+
+
 if __name__ == "__main__":
     tvm.testing.main()
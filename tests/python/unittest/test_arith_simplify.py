@@ -65,5 +65,28 @@ def test_regression_simplify_inf_recursion():
     ana.rewrite_simplify(res)
 
 
+def test_simplify_cache_respects_context():
+    ana = tvm.arith.Analyzer()
+    ana.enable_cache(max_entries=2)
+    x = tir.Var("x", "int32")
+    y = tir.Var("y", "int32")
+    expr = tvm.tir.min(x, 16)
+
+    assert tvm.ir.structural_equal(ana.simplify(expr), expr)
+    with ana.constraint_scope(x < 8):
+        assert tvm.ir.structural_equal(ana.simplify(expr), x)
+        assert ana.const_int_bound(x + 1).max_value == 8
+    assert tvm.ir.structural_equal(ana.simplify(expr), expr)
+    assert ana.const_int_bound(x + 1).max_value != 8
+
+    ana.bind(x, tvm.ir.Range(0, 4))
+    assert tvm.ir.structural_equal(ana.simplify(expr), x)
+    assert ana.const_int_bound(x + 1).max_value == 4
+
+    # More queries than the cache holds.
+    for i in range(4):
+        assert tvm.ir.structural_equal(ana.simplify(tvm.tir.max(x, i + 4) + y), i + 4 + y)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
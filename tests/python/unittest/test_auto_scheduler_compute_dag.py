@@ -43,6 +43,20 @@ def test_infer_bound():
     s = dag.infer_bound_from_state(s)
 
 
+def test_infer_bound_memo():
+    dag, s = get_tiled_matmul()
+    s1 = dag.infer_bound_from_state(s)
+    # The second inference of the same steps is served by the memo
+    s2 = dag.infer_bound_from_state(s)
+    assert str(s1) == str(s2)
+
+    # A modified state gets its own bounds
+    C = dag.tensors[-1]
+    s.split(C, s[C].iters[8], [4])
+    s3 = dag.infer_bound_from_state(s)
+    assert str(s3) != str(s1)
+
+
 def test_estimate_flop():
     N = 512
     A, B, C = matmul_auto_scheduler_test(N, N, N)
@@ -152,6 +166,7 @@ def test_invalid_compute_dag():
 if __name__ == "__main__":
     test_apply_steps()
     test_infer_bound()
+    test_infer_bound_memo()
     test_estimate_flop()
     test_stage_order()
     test_invalid_compute_dag()
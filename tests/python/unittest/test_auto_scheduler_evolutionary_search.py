@@ -117,6 +117,34 @@ def test_mutate_parallel():
     assert found
 
 
+def test_evolutionary_search_is_deterministic(monkeypatch):
+    """The same seed gives the same states, whatever the number of search threads."""
+
+    class MockCostModel(PythonBasedModel):
+        """A mock cost model whose scores only depend on the states."""
+
+        def predict(self, task, states):
+            return [float(sum(map(ord, str(state))) % 97) for state in states]
+
+    task = auto_scheduler.SearchTask(
+        func=matmul_auto_scheduler_test, args=(64, 64, 64), target=tvm.target.Target("llvm")
+    )
+
+    def search(num_threads):
+        monkeypatch.setenv("TVM_NUM_THREADS", str(num_threads))
+        policy = auto_scheduler.SketchPolicy(
+            task, program_cost_model=MockCostModel(), seed=42, verbose=0
+        )
+        states = policy.sample_initial_population()[:50]
+        return [str(state) for state in policy.evolutionary_search(states, 20)]
+
+    expected = search(1)
+    assert expected
+    assert search(1) == expected
+    assert search(4) == expected
+
+
 if __name__ == "__main__":
     test_mutate_tile_size()
     test_mutate_parallel()
+    test_evolutionary_search_is_deterministic(pytest.MonkeyPatch())
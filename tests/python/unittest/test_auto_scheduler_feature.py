@@ -201,6 +201,22 @@ def test_gpu_feature():
         assert fequal(fea_dicts[0]["is_gpu"], 1.0)
 
 
+def test_feature_cache():
+    target = tvm.target.Target("llvm")
+    features = []
+    for n in [64, 128]:
+        # The same workload key on purpose, the cached features must not leak across DAGs
+        dag = auto_scheduler.ComputeDAG(matmul_auto_scheduler_test(n, n, n))
+        task = auto_scheduler.SearchTask(compute_dag=dag, workload_key="test", target=target)
+        s = dag.get_init_state()
+        first = auto_scheduler.feature.get_per_store_features_from_states([s, s], task)
+        second = auto_scheduler.feature.get_per_store_features_from_states([s], task)
+        assert first[0].dtype == "float32"
+        assert (first[0] == first[1]).all() and (first[0] == second[0]).all()
+        features.append(first[0])
+    assert not (features[0] == features[1]).all()
+
+
 @T.prim_func
 def tir_matmul(
     A: T.Buffer((256, 256), "float32"),
@@ -19,6 +19,7 @@
 import json
 
 import multiprocessing
+import os
 import numpy as np
 import tvm
 from tvm import topi
@@ -203,6 +204,55 @@ def test_recover_measure_input():
         assert str(correct_inp.state) == str(inp.state)
 
 
+def test_binary_records():
+    tasks = [
+        auto_scheduler.SearchTask(func=matmul_auto_scheduler_test, args=(n, n, n), target="llvm")
+        for n in [256, 512]
+    ]
+    inputs, results = [], []
+    for task, costs in zip(tasks, [[0.3, 0.1, 0.2], [0.5]]):
+        for cost in costs:
+            inputs.append(auto_scheduler.MeasureInput(task, task.compute_dag.init_state))
+            results.append(auto_scheduler.MeasureResult([cost], 0, "", 0.2, 1))
+    # A failed record is never picked, whatever its cost
+    inputs.append(auto_scheduler.MeasureInput(tasks[0], tasks[0].compute_dag.init_state))
+    results.append(auto_scheduler.MeasureResult([0.01], 1, "", 0.2, 1))
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        json_file = os.path.join(tmpdir, "records.json")
+        bin_file = os.path.join(tmpdir, "records.bin")
+        auto_scheduler.save_records(json_file, inputs, results)
+        auto_scheduler.convert_records_to_binary(json_file, bin_file)
+        assert auto_scheduler.measure_record.is_binary_record_file(bin_file)
+        assert not auto_scheduler.measure_record.is_binary_record_file(json_file)
+
+        def check(filename):
+            best = auto_scheduler.load_best_binary_records(filename)
+            costs = {inp.task.workload_key: round(res.costs[0].value, 6) for inp, res in best}
+            assert costs == {tasks[0].workload_key: 0.1, tasks[1].workload_key: 0.5}
+            top2 = {}
+            for inp, res in auto_scheduler.load_best_binary_records(filename, top_k=2):
+                top2.setdefault(inp.task.workload_key, []).append(round(res.costs[0].value, 6))
+            assert top2 == {tasks[0].workload_key: [0.1, 0.2], tasks[1].workload_key: [0.5]}
+
+        check(bin_file)
+        # Without the index, the records are found by scanning the file
+        with open(bin_file, "rb") as f:
+            data = f.read()
+        truncated_file = os.path.join(tmpdir, "truncated.bin")
+        with open(truncated_file, "wb") as f:
+            f.write(data[:-16])
+        check(truncated_file)
+
+        # ApplyHistoryBest picks the same records from both formats
+        for filename in [json_file, bin_file]:
+            context = auto_scheduler.ApplyHistoryBest(filename)
+            entry = context.best_by_targetkey["cpu"]
+            assert sorted(
+                round(cost, 6) for workload in entry.values() for _, cost in workload.values()
+            ) == [0.1, 0.5]
+
+
 def test_workload_dis_factor():
     calc = auto_scheduler.utils.calc_workload_dis_factor
     decode = auto_scheduler.utils.decode_workload_key
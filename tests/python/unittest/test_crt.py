@@ -17,6 +17,7 @@
 
 """Test C runtime"""
 
+import json
 import pathlib
 import pytest
 
@@ -161,6 +162,49 @@ def test_graph_executor():
         do_test(graph_mod)
 
 
+@tvm.testing.requires_micro
+def test_graph_executor_static_workspace():
+    """Test the graph executor with all the tensors but the constants packed in one storage."""
+
+    temp_dir = tvm.contrib.utils.tempdir()
+    relay_mod = tvm.relay.fromtext(
+        """
+      #[version = "0.0.5"]
+      def @main(%a : Tensor[(1, 8), uint8], %b : Tensor[(1, 8), uint8]) {
+          %0 = %a + %b;
+          %1 = %0 * %a;
+          %2 = %1 + %0;
+          %2 + meta[relay.Constant][0]
+      }""",
+        init_meta_table={"relay.Constant": [tvm.nd.array(np.full((1, 8), 1, dtype="uint8"))]},
+    )
+
+    runtime = Runtime("crt", {"system-lib": True})
+    config = {"tir.disable_vectorize": True, "relay.backend.graph_static_workspace": True}
+    with tvm.transform.PassContext(opt_level=0, config=config):
+        factory = tvm.relay.build(relay_mod, target=TARGET, runtime=runtime)
+
+    graph_json = json.loads(factory.get_graph_json())
+    storage_ids = graph_json["attrs"]["storage_id"][1]
+    storage_offsets = graph_json["attrs"]["storage_offset"][1]
+    # The inputs, intermediates and output share one storage, the constant has its own.
+    assert len(set(storage_ids)) == 2
+    assert len(set(zip(storage_ids, storage_offsets))) > 2
+
+    a = np.arange(8, dtype="uint8").reshape(1, 8)
+    b = np.full((1, 8), 3, dtype="uint8")
+    with _make_session(temp_dir, factory) as sess:
+        graph_mod = tvm.contrib.graph_executor.create(
+            factory.get_graph_json(), sess.get_system_lib(), sess.device
+        )
+        graph_mod.set_input(**factory.get_params())
+        graph_mod.run(
+            a=tvm.nd.array(a, device=sess.device), b=tvm.nd.array(b, device=sess.device)
+        )
+        expected = (a + b) * a + (a + b) + 1
+        np.testing.assert_equal(graph_mod.get_output(0).numpy(), expected)
+
+
 @tvm.testing.requires_micro
 def test_aot_executor():
     """Test use of the AOT executor with microTVM."""
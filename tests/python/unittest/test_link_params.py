@@ -233,6 +233,22 @@ def test_llvm_link_params(linkable_dtype):
         np.testing.assert_allclose(unlinked_output.numpy(), linked_output.numpy())
 
 
+@tvm.testing.requires_llvm
+def test_llvm_link_params_alignment():
+    ir_mod, param_init = _make_mod_and_params("float32")
+    target = tvm.target.Target("llvm -mtriple=x86_64-linux-gnu -constants-byte-alignment=64")
+    executor = Executor("graph", {"link-params": True})
+    with tvm.transform.PassContext(opt_level=3):
+        lib = tvm.relay.build(ir_mod, target, executor=executor, params=param_init)
+
+    # The parameters are emitted as data arrays, which are aligned as requested by the target.
+    ll_source = lib.lib.get_source("ll")
+    linked = re.findall(r"internal constant \[\d+ x float\] .*", ll_source)
+    assert linked
+    for global_def in linked:
+        assert global_def.endswith('section ".rodata.tvm", align 64')
+
+
 def _get_c_datatype(dtype):
     """Translate LINKABLE_DTYPES element to c datatype."""
     if "int" in dtype:
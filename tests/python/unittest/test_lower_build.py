@@ -143,8 +143,27 @@ def test_lower_build_lowered_module():
     _check_module_with_numpy(mod)
 
 
+def test_lower_build_parallel_jobs():
+    funcs = {}
+    for i in range(8):
+        name = f"matmul_{i}"
+        funcs[name] = matmul.with_attr("global_symbol", name).with_attr("tir.noalias", True)
+    ir_mod = IRModule(funcs)
+    with tvm.transform.PassContext(opt_level=3):
+        ref_mod = tvm.lower(ir_mod)
+    # The function-local passes lower the PrimFuncs on several threads
+    config = {"tir.num_parallel_jobs": 4}
+    with tvm.transform.PassContext(opt_level=3, config=config):
+        lowered_mod = tvm.lower(ir_mod)
+        mod = tvm.build(ir_mod, target="llvm")
+    tvm.ir.assert_structural_equal(lowered_mod, ref_mod)
+    for i in range(8):
+        _check_module_with_numpy(mod[f"matmul_{i}"])
+
+
 if __name__ == "__main__":
     test_lower_build_te_schedule()
     test_lower_build_tir_func()
     test_lower_build_tir_module()
     test_lower_build_lowered_module()
+    test_lower_build_parallel_jobs()
@@ -29,9 +29,14 @@ from tvm._ffi import register_func
 from tvm.meta_schedule.builder import (
     BuilderInput,
     BuilderResult,
+    InProcessBuilder,
     LocalBuilder,
     PyBuilder,
 )
+from tvm.meta_schedule.builder.in_process_builder import (
+    get_in_memory_artifact,
+    is_in_memory_artifact,
+)
 from tvm.runtime import Module
 from tvm.script import tir as T
 from tvm.target import Target
@@ -225,5 +230,37 @@ def test_meta_schedule_missing_build_func():
         LocalBuilder(f_build="wrong-name")
 
 
+def test_meta_schedule_in_process_build():
+    """Test meta schedule in-process builder for multiple builds"""
+    builder = InProcessBuilder(max_workers=2)
+    builder_inputs = [
+        BuilderInput(MatmulModule, Target("llvm")),
+        BuilderInput(MatmulReluModule, Target("llvm")),
+        BuilderInput(BatchMatmulModule, Target("llvm")),
+    ]
+    builder_results = builder.build(builder_inputs)
+    assert len(builder_results) == len(builder_inputs)
+    artifact_paths = set()
+    for result in builder_results:
+        assert result.error_msg is None
+        assert is_in_memory_artifact(result.artifact_path)
+        assert isinstance(get_in_memory_artifact(result.artifact_path), Module)
+        artifact_paths.add(str(result.artifact_path))
+    assert len(artifact_paths) == len(builder_inputs)
+
+
+def test_meta_schedule_in_process_build_error():
+    """Test meta schedule in-process builder reporting the failed builds"""
+    builder = InProcessBuilder(max_workers=2)
+    builder_inputs = [
+        BuilderInput(MatmulModule, Target("llvm")),
+        BuilderInput(MatmulModule, Target("llvm"), params={"a": tvm.nd.array([1.0])}),
+    ]
+    ok_result, error_result = builder.build(builder_inputs)
+    assert ok_result.error_msg is None
+    assert error_result.artifact_path is None
+    assert error_result.error_msg.startswith("InProcessBuilder: An exception occurred")
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -24,9 +24,16 @@ from functools import partial
 from typing import List
 
 import numpy as np
+import pytest
 import tvm
 import tvm.testing
-from tvm.meta_schedule.cost_model import PyCostModel, RandomModel, XGBModel
+from tvm.meta_schedule.cost_model import (
+    GBDTModel,
+    PyCostModel,
+    RandomModel,
+    SegmentSumMLPModel,
+    XGBModel,
+)
 from tvm.meta_schedule.cost_model.xgb_model import PackSum, _get_custom_call_back
 from tvm.meta_schedule.feature_extractor import RandomFeatureExtractor
 from tvm.meta_schedule.runner import RunnerResult
@@ -257,6 +264,143 @@ def test_meta_schedule_xgb_model_reupdate():
     model.predict(TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)])
 
 
+def test_meta_schedule_gbdt_model():
+    extractor = RandomFeatureExtractor()
+    model = GBDTModel(extractor=extractor, num_warmup_samples=2)
+    update_sample_count = 10
+    predict_sample_count = 100
+    model.update(
+        TuneContext(),
+        [_dummy_candidate() for i in range(update_sample_count)],
+        [_dummy_result() for i in range(update_sample_count)],
+    )
+    res = model.predict(TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)])
+    assert res.shape == (predict_sample_count,)
+    assert model.data_size == update_sample_count
+    assert "num_trees=" in str(model)
+
+
+def test_meta_schedule_gbdt_model_reupdate():
+    extractor = RandomFeatureExtractor()
+    model = GBDTModel(extractor=extractor, num_warmup_samples=2, adaptive_training=False)
+    update_sample_count = 60
+    predict_sample_count = 100
+    for _ in range(3):
+        # each update keeps boosting from the trees of the previous one
+        model.update(
+            TuneContext(),
+            [_dummy_candidate() for i in range(update_sample_count)],
+            [_dummy_result() for i in range(update_sample_count)],
+        )
+    assert model.data_size == 3 * update_sample_count
+    model.predict(TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)])
+
+
+def test_meta_schedule_gbdt_model_reload():
+    extractor = RandomFeatureExtractor()
+    model = GBDTModel(extractor=extractor, num_warmup_samples=10)
+    update_sample_count = 20
+    predict_sample_count = 30
+    model.update(
+        TuneContext(),
+        [_dummy_candidate() for i in range(update_sample_count)],
+        [_dummy_result() for i in range(update_sample_count)],
+    )
+    with tempfile.NamedTemporaryFile() as path:
+        random_state = model.extractor.random_state  # save feature extractor's random state
+        model.save(path.name)
+        res1 = model.predict(
+            TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)]
+        )
+        new_model = GBDTModel(extractor=extractor, num_warmup_samples=10)
+        new_model.extractor.random_state = random_state  # load feature extractor's random state
+        new_model.load(path.name)
+        res2 = new_model.predict(
+            TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)]
+        )
+    assert new_model.data_size == update_sample_count
+    assert (res1 == res2).all()
+
+
+def test_meta_schedule_segment_sum_mlp_model():
+    extractor = RandomFeatureExtractor()
+    model = SegmentSumMLPModel(
+        extractor=extractor, hidden_dim=16, num_epoch_full=2, num_epoch_incremental=1, seed=0
+    )
+    update_sample_count = 10
+    predict_sample_count = 100
+    for _ in range(2):
+        model.update(
+            TuneContext(),
+            [_dummy_candidate() for i in range(update_sample_count)],
+            [_dummy_result() for i in range(update_sample_count)],
+        )
+    res = model.predict(TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)])
+    assert res.shape == (predict_sample_count,)
+    assert np.isfinite(res).all()
+    assert model.data_size == 2 * update_sample_count
+    assert "hidden_dim=16" in str(model)
+
+
+def test_meta_schedule_segment_sum_mlp_model_reload():
+    extractor = RandomFeatureExtractor()
+    model = SegmentSumMLPModel(extractor=extractor, hidden_dim=16, num_epoch_full=2, seed=0)
+    update_sample_count = 20
+    predict_sample_count = 30
+    model.update(
+        TuneContext(),
+        [_dummy_candidate() for i in range(update_sample_count)],
+        [_dummy_result() for i in range(update_sample_count)],
+    )
+    with tempfile.NamedTemporaryFile() as path:
+        random_state = model.extractor.random_state  # save feature extractor's random state
+        model.save(path.name)
+        res1 = model.predict(
+            TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)]
+        )
+        # The weights are a parameter dict named after the PyTorch state dict
+        params = tvm.runtime.load_param_dict_from_file(path.name)
+        assert params["encoder.0.weight"].shape == (16, extractor.feature_size)
+        assert params["decoder.weight"].shape == (1, 16)
+        new_model = SegmentSumMLPModel(extractor=extractor, hidden_dim=8, frozen=True)
+        new_model.extractor.random_state = random_state  # load feature extractor's random state
+        new_model.load(path.name)
+        res2 = new_model.predict(
+            TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)]
+        )
+    assert new_model.hidden_dim == 16
+    np.testing.assert_allclose(res1, res2, rtol=1e-6)
+
+
+def test_meta_schedule_segment_sum_mlp_model_torch_parity():
+    """The weights exported from the PyTorch model give the same predictions natively."""
+    torch = pytest.importorskip("torch")
+    from tvm.meta_schedule.cost_model.mlp_model import (  # pylint: disable=import-outside-toplevel
+        SegmentSumMLP,
+        export_segment_sum_mlp,
+    )
+
+    extractor = RandomFeatureExtractor()
+    torch.manual_seed(0)
+    torch_model = SegmentSumMLP(input_dim=extractor.feature_size, hidden_dim=16).eval()
+    candidates = [_dummy_candidate() for _ in range(30)]
+    random_state = extractor.random_state
+    features = [f.numpy() for f in extractor.extract_from(TuneContext(), candidates)]
+    with torch.no_grad():
+        expected = torch_model(
+            torch.tensor([len(f) for f in features]),
+            torch.from_numpy(np.concatenate(features).astype("float32")),
+        ).numpy()
+
+    with tempfile.NamedTemporaryFile() as path:
+        export_segment_sum_mlp(torch_model, path.name)
+        model = SegmentSumMLPModel(extractor=extractor, frozen=True)
+        model.load(path.name)
+    extractor.random_state = random_state
+    res = model.predict(TuneContext(), candidates)
+    np.testing.assert_allclose(res, expected, rtol=1e-4, atol=1e-5)
+
+
 def xgb_version_check():
 
     # pylint: disable=import-outside-toplevel
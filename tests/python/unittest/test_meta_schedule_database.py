@@ -16,6 +16,7 @@
 # under the License.
 # pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
 """Test Meta Schedule Database"""
+import os
 import os.path as osp
 import tempfile
 from typing import Callable, List, Optional
@@ -414,6 +415,50 @@ def test_meta_schedule_database_reload():
             _equal_record(ret[1], records[2])
 
 
+def test_meta_schedule_database_reload_multiple_workloads():
+    mod: IRModule = Matmul
+    mod_2: IRModule = MatmulRelu
+    with tempfile.TemporaryDirectory() as tmpdir:
+        database = _create_tmp_database(tmpdir)
+        token = database.commit_workload(mod)
+        token_2 = database.commit_workload(mod_2)
+        trace = _create_schedule(mod, _schedule_matmul).trace
+        trace_2 = _create_schedule(mod_2, lambda sch: None).trace
+        for run_secs in [[3.0], [1.0], [2.0]]:
+            database.commit_tuning_record(
+                ms.database.TuningRecord(
+                    trace,
+                    token,
+                    run_secs,
+                    tvm.target.Target("llvm"),
+                    ms.arg_info.ArgInfo.from_prim_func(func=mod["main"]),
+                )
+            )
+        for run_secs in [[5.0], [4.0]]:
+            database.commit_tuning_record(
+                ms.database.TuningRecord(
+                    trace_2,
+                    token_2,
+                    run_secs,
+                    tvm.target.Target("llvm"),
+                    ms.arg_info.ArgInfo.from_prim_func(func=mod_2["main"]),
+                )
+            )
+        new_database = ms.database.JSONDatabase(
+            path_workload=database.path_workload,
+            path_tuning_record=database.path_tuning_record,
+        )
+        # the records are counted before they are parsed
+        assert len(new_database) == 5
+        ret = new_database.get_top_k(new_database.commit_workload(mod_2), 3)
+        assert [[v.value for v in r.run_secs] for r in ret] == [[4.0], [5.0]]
+        ret = new_database.get_top_k(new_database.commit_workload(mod), 2)
+        assert [[v.value for v in r.run_secs] for r in ret] == [[1.0], [2.0]]
+        ret = new_database.get_all_tuning_records()
+        assert [r.run_secs[0].value for r in ret] == [1.0, 2.0, 3.0, 4.0, 5.0]
+        assert len(new_database) == 5
+
+
 def test_meta_schedule_database_union():
     mod: IRModule = Matmul
     target = tvm.target.Target("llvm")
@@ -584,6 +629,125 @@ def test_json_database_get_top_k(k, expected):
     assert result == expected
 
 
+def _commit_matmul_records(database, run_secs_list):
+    mod: IRModule = Matmul
+    workload = database.commit_workload(mod)
+    records = []
+    for run_secs in run_secs_list:
+        record = ms.database.TuningRecord(
+            _create_schedule(mod, _schedule_matmul).trace,
+            workload,
+            run_secs,
+            tvm.target.Target("llvm"),
+            ms.arg_info.ArgInfo.from_prim_func(func=mod["main"]),
+        )
+        database.commit_tuning_record(record)
+        records.append(record)
+    return workload, records
+
+
+@pytest.mark.parametrize(
+    "k,expected",
+    [
+        (0, []),
+        (4, [[0.0, 2.0], [2.0], [1.5, 4.5], [3.0, 1e10]]),
+        (5, [[0.0, 2.0], [2.0], [1.5, 4.5], [3.0, 1e10]]),
+    ],
+)
+def test_binary_database_get_top_k(k, expected):
+    run_secs_list = [[1.5, 4.5], [], [0.0, 2.0], None, [2.0], [3.0, 1e10], [1e10]]
+    with tempfile.TemporaryDirectory() as tmpdir:
+        database = ms.database.BinaryDatabase(work_dir=tmpdir)
+        result = call_get_top_k(run_secs_list, database, k)
+    assert result == expected
+
+
+def test_binary_database_reload():
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path = osp.join(tmpdir, "database.bin")
+        database = ms.database.BinaryDatabase(path)
+        _, records = _commit_matmul_records(database, [[7.0, 8.0, 9.0], [1.0, 2.0, 3.0], [4.0]])
+        del database
+        for drop_index in [False, True]:
+            if drop_index:
+                # the index is rebuilt from the log
+                os.remove(path + ".index")
+            new_database = ms.database.BinaryDatabase(path)
+            assert len(new_database) == 3
+            assert new_database.has_workload(Matmul)
+            ret = new_database.get_top_k(new_database.commit_workload(Matmul), 2)
+            assert len(ret) == 2
+            _equal_record(ret[0], records[1])
+            _equal_record(ret[1], records[2])
+            ret = new_database.get_all_tuning_records()
+            assert [r.run_secs[0].value for r in ret] == [1.0, 4.0, 7.0]
+            del new_database
+
+
+def test_binary_database_truncated_tail():
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path = osp.join(tmpdir, "database.bin")
+        database = ms.database.BinaryDatabase(path)
+        _commit_matmul_records(database, [[2.0], [1.0]])
+        del database
+        # an interrupted append leaves a partial entry at the end of the log
+        with open(path, "ab") as log:
+            log.write(b"\x03\x00\x00")
+        database = ms.database.BinaryDatabase(path)
+        assert len(database) == 2
+        _commit_matmul_records(database, [[0.5]])
+        del database
+        database = ms.database.BinaryDatabase(path)
+        assert len(database) == 3
+        ret = database.get_top_k(database.commit_workload(Matmul), 1)
+        assert ret[0].run_secs[0].value == 0.5
+
+
+def test_binary_database_missing():
+    with tempfile.TemporaryDirectory() as tmpdir:
+        with pytest.raises(ValueError):
+            ms.database.BinaryDatabase(osp.join(tmpdir, "database.bin"), allow_missing=False)
+
+
+def test_shared_database_concurrent_writers():
+    with tempfile.TemporaryDirectory() as tmpdir:
+        db_1 = ms.database.SharedDatabase(tmpdir, refresh_interval_sec=0)
+        db_2 = ms.database.SharedDatabase(tmpdir, refresh_interval_sec=0)
+        assert db_1.segment != db_2.segment
+        _, records_1 = _commit_matmul_records(db_1, [[3.0], [1.0]])
+        _, records_2 = _commit_matmul_records(db_2, [[2.0]])
+        for database in [db_1, db_2]:
+            assert len(database) == 3
+            assert database.has_workload(Matmul)
+            ret = database.get_top_k(database.commit_workload(Matmul), 2)
+            assert len(ret) == 2
+            _equal_record(ret[0], records_1[1])
+            _equal_record(ret[1], records_2[0])
+            ret = database.query_tuning_record(Matmul, tvm.target.Target("llvm"), "main")
+            _equal_record(ret, records_1[1])
+
+
+def test_shared_database_take_over_segment():
+    with tempfile.TemporaryDirectory() as tmpdir:
+        database = ms.database.SharedDatabase(tmpdir)
+        segment = database.segment
+        _commit_matmul_records(database, [[2.0], [1.0]])
+        del database
+        # the segment of a database that is gone is unlocked, and appended to by the next one
+        database = ms.database.SharedDatabase(tmpdir)
+        assert database.segment == segment
+        assert len(database) == 2
+        _commit_matmul_records(database, [[0.5]])
+        assert len(database) == 3
+        assert len(os.listdir(tmpdir)) == 2  # the log and its index
+
+
+def test_shared_database_missing():
+    with tempfile.TemporaryDirectory() as tmpdir:
+        with pytest.raises(ValueError):
+            ms.database.SharedDatabase(osp.join(tmpdir, "shared"), allow_missing=False)
+
+
 def MatmulFunc() -> IRModule:
     a = relay.var("a", relay.TensorType((1024, 1024), "float32"))
     b = relay.var("b", relay.TensorType((1024, 1024), "float32"))
@@ -20,10 +20,11 @@ from typing import List
 
 import numpy as np
 from tvm.meta_schedule import TuneContext
-from tvm.meta_schedule.feature_extractor import PyFeatureExtractor
+from tvm.meta_schedule.feature_extractor import PyFeatureExtractor, TargetFeature
 from tvm.meta_schedule.search_strategy import MeasureCandidate
 from tvm.meta_schedule.utils import derived_object
 from tvm.runtime.ndarray import array
+from tvm.target import Target
 
 
 def test_meta_schedule_feature_extractor():
@@ -57,6 +58,30 @@ def test_meta_schedule_feature_extractor_as_string():
     assert pattern.match(str(feature_extractor))
 
 
+def test_meta_schedule_target_feature():
+    @derived_object
+    class FancyFeatureExtractor(PyFeatureExtractor):
+        def extract_from(
+            self,
+            context: TuneContext,  # pylint: disable = unused-argument
+            candidates: List[MeasureCandidate],  # pylint: disable = unused-argument
+        ) -> List[np.ndarray]:
+            return [array(np.ones((4, 5), dtype="float64"))]
+
+    extractor = TargetFeature(FancyFeatureExtractor())
+    skylake = Target("llvm -mcpu=skylake-avx512 -num-cores 8")
+    haswell = Target("llvm -mcpu=haswell -num-cores 8")
+    (features,) = extractor.extract_from(TuneContext(target=skylake), [])
+    features = features.numpy()
+    num_target_features = len(TargetFeature.extract(skylake))
+    assert features.shape == (4, 5 + num_target_features)
+    np.testing.assert_equal(features[:, :5], 1.0)
+    for row in features:
+        np.testing.assert_equal(row[5:], TargetFeature.extract(skylake))
+    assert TargetFeature.extract(skylake) != TargetFeature.extract(haswell)
+
+
 if __name__ == "__main__":
     test_meta_schedule_feature_extractor()
     test_meta_schedule_feature_extractor_as_string()
+    test_meta_schedule_target_feature()
@@ -1632,5 +1632,52 @@ def test_negative_extent():
     assert named_features["B0.unique_bytes"] == 0
 
 
+@T.prim_func
+def matmul_relu(
+    A: T.Buffer((128, 128), "float32"),
+    B: T.Buffer((128, 128), "float32"),
+    D: T.Buffer((128, 128), "float32"),
+) -> None:
+    T.func_attr({"global_symbol": "main", "tir.noalias": True})
+    C = T.alloc_buffer((128, 128), "float32")
+    for i0, i1, i2 in T.grid(128, 128, 128):
+        with T.block("C"):
+            i, j, k = T.axis.remap("SSR", [i0, i1, i2])
+            with T.init():
+                C[i, j] = T.float32(0)
+            C[i, j] = C[i, j] + A[i, k] * B[k, j]
+    for i0, i1 in T.grid(128, 128):
+        with T.block("D"):
+            i, j = T.axis.remap("SS", [i0, i1])
+            D[i, j] = T.max(C[i, j], T.float32(0))
+
+
+def test_cached_features():
+    def _split(block, factor):
+        def f_sch():
+            sch = tir.Schedule(matmul_relu)
+            if block is not None:
+                loop = sch.get_loops(sch.get_block(block))[0]
+                sch.split(loop, [None, factor])
+            return sch
+
+        return f_sch
+
+    f_schs = [_split(None, 0), _split("D", 16), _split("C", 8), _split("D", 16)]
+    context = _make_context(tvm.target.Target("llvm"))
+    # The candidates share the loop nests that were not split, whose features are reused
+    features = ms.feature_extractor.PerStoreFeature().extract_from(
+        context,
+        candidates=[_make_candidate(f_sch) for f_sch in f_schs],
+    )
+    for f_sch, feature in zip(f_schs, features):
+        (expected,) = ms.feature_extractor.PerStoreFeature().extract_from(
+            context,
+            candidates=[_make_candidate(f_sch)],
+        )
+        assert feature.shape == (2, N_FEATURES)
+        assert_allclose(feature.numpy(), expected.numpy())
+
+
 if __name__ == "__main__":
     tvm.testing.main()
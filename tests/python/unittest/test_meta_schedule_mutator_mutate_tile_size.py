@@ -17,7 +17,7 @@
 # pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
 import operator
 from functools import reduce
-from typing import List
+from typing import List, Optional
 
 from tvm import meta_schedule as ms
 from tvm.script import tir as T
@@ -66,14 +66,16 @@ def _sch(decisions: List[List[int]]) -> Schedule:
     return sch
 
 
-def _make_mutator(target: Target) -> ms.Mutator:
+def _make_mutator(target: Target, mutator: Optional[ms.Mutator] = None) -> ms.Mutator:
+    if mutator is None:
+        mutator = ms.mutator.MutateTileSize()
     ctx = ms.TuneContext(
         mod=matmul,
         target=target,
         space_generator=ms.space_generator.PostOrderApply(
             sch_rules=[],
             postprocs=[],
-            mutator_probs={ms.mutator.MutateTileSize(): 1.0},
+            mutator_probs={mutator: 1.0},
         ),
     )
     return list(ctx.space_generator.mutator_probs.keys())[0]
@@ -95,6 +97,57 @@ def test_mutate_tile_size_matmul():
     assert len(results) > 15
 
 
+def test_mutate_tile_size_cache_aware_matmul():
+    mutator = _make_mutator(
+        target=Target("llvm --num-cores=16 -l1_cache_bytes=32768 -l2_cache_bytes=1048576"),
+        mutator=ms.mutator.MutateTileSizeCacheAware(num_proposals=4),
+    )
+    results = {}
+    sch = _sch(decisions=[[4, 32, 4, 1]])
+    for _ in range(100):
+        trace = mutator.apply(sch.trace)
+        if trace is None:
+            continue
+        assert trace.insts[4].kind.name == "SamplePerfectTile"
+        decision = trace.decisions[trace.insts[4]]
+        decision = [int(x) for x in decision]
+        results[str(decision)] = decision
+        assert reduce(operator.mul, decision, 1) == 512
+        assert decision[-1] <= 64
+    assert len(results) > 1
+
+
+def test_mutate_tile_size_cache_aware_score():
+    target = Target("llvm --num-cores=16 -l1_cache_bytes=32768 -l2_cache_bytes=1048576")
+    mutator = _make_mutator(
+        target=target,
+        mutator=ms.mutator.MutateTileSizeCacheAware(num_proposals=1),
+    )
+    # An innermost tile of 64 rows of A leaves no level of the loop nest with reuse in L1
+    low = mutator.score(_sch(decisions=[[1, 1, 8, 64]]).trace)
+    mid = mutator.score(_sch(decisions=[[4, 32, 4, 1]]).trace)
+    high = mutator.score(_sch(decisions=[[2, 1, 4, 64]]).trace)
+    assert low is not None and mid is not None and high is not None
+    assert low < mid < high
+
+    # More proposals to choose from pick mutations with more reuse on average
+    def mean_score(num_proposals: int) -> float:
+        mutator = _make_mutator(
+            target=target,
+            mutator=ms.mutator.MutateTileSizeCacheAware(num_proposals=num_proposals),
+        )
+        sch = _sch(decisions=[[1, 1, 8, 64]])
+        scores = []
+        for _ in range(50):
+            trace = mutator.apply(sch.trace)
+            if trace is not None:
+                scores.append(mutator.score(trace))
+        assert scores
+        return sum(scores) / len(scores)
+
+    assert mean_score(num_proposals=16) > mean_score(num_proposals=1)
+
+
 def test_mutate_sample_categorical_single_candidate():
     mutator = _make_mutator(
         target=Target("llvm --num-cores=16"),
@@ -109,4 +162,6 @@ def test_mutate_sample_categorical_single_candidate():
 
 if __name__ == "__main__":
     test_mutate_tile_size_matmul()
+    test_mutate_tile_size_cache_aware_matmul()
+    test_mutate_tile_size_cache_aware_score()
     test_mutate_sample_categorical_single_candidate()
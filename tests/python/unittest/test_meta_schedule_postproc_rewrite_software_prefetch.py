@@ -0,0 +1,95 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
+
+
+import tvm
+from tvm import meta_schedule as ms
+from tvm import tir
+from tvm.script import tir as T
+from tvm.target import Target
+
+
+def _create_context(mod, target) -> ms.TuneContext:
+    ctx = ms.TuneContext(
+        mod=mod,
+        target=target,
+        space_generator=ms.space_generator.PostOrderApply(
+            sch_rules=[],
+            postprocs=[
+                ms.postproc.RewriteSoftwarePrefetch(),
+            ],
+            mutator_probs={},
+        ),
+        task_name="test",
+    )
+    return ctx
+
+
+# pylint: disable=invalid-name,no-member,line-too-long,too-many-nested-blocks,no-self-argument
+# fmt: off
+
+@tvm.script.ir_module
+class Embedding:
+    @T.prim_func
+    def main(a: T.handle, idx: T.handle, b: T.handle) -> None:
+        T.func_attr({"global_symbol": "main"})
+        A = T.match_buffer(a, (1000, 64), "float32")
+        I = T.match_buffer(idx, (128,), "int32")
+        B = T.match_buffer(b, (128, 64), "float32")
+        for i, j in T.grid(128, 64):
+            with T.block("B"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                B[vi, vj] = A[I[vi], vj]
+
+
+@tvm.script.ir_module
+class Add:
+    @T.prim_func
+    def main(a: T.handle, b: T.handle) -> None:
+        T.func_attr({"global_symbol": "main"})
+        A = T.match_buffer(a, (1024,), "float32")
+        B = T.match_buffer(b, (1024,), "float32")
+        for i in T.serial(1024):
+            with T.block("B"):
+                vi = T.axis.spatial(1024, i)
+                B[vi] = A[vi] + 1.0
+
+# fmt: on
+# pylint: enable=invalid-name,no-member,line-too-long,too-many-nested-blocks,no-self-argument
+
+
+def test_postproc_rewrite_software_prefetch_gather():
+    ctx = _create_context(Embedding, target=Target("llvm"))
+    sch = tir.Schedule(Embedding, debug_mask="all")
+    assert ctx.space_generator.postprocs[0].apply(sch)
+    i, j = sch.get_loops(sch.get_block("B"))
+    assert sch.get(i).annotations["software_prefetch"] == 0
+    assert "software_prefetch" not in sch.get(j).annotations
+
+
+def test_postproc_rewrite_software_prefetch_sequential():
+    ctx = _create_context(Add, target=Target("llvm"))
+    sch = tir.Schedule(Add, debug_mask="all")
+    assert ctx.space_generator.postprocs[0].apply(sch)
+    (i,) = sch.get_loops(sch.get_block("B"))
+    assert "software_prefetch" not in sch.get(i).annotations
+
+
+if __name__ == "__main__":
+    test_postproc_rewrite_software_prefetch_gather()
+    test_postproc_rewrite_software_prefetch_sequential()
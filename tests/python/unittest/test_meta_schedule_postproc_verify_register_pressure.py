@@ -0,0 +1,74 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
+import tvm
+import tvm.testing
+from tvm import meta_schedule as ms
+from tvm import tir
+from tvm.script import tir as T
+
+
+def _create_context(mod, target, postproc) -> ms.TuneContext:
+    return ms.TuneContext(
+        mod=mod,
+        target=target,
+        space_generator=ms.space_generator.PostOrderApply(
+            sch_rules=[],
+            postprocs=[postproc],
+            mutator_probs={},
+        ),
+        task_name="test",
+    )
+
+
+# pylint: disable=invalid-name,no-member,line-too-long,too-many-nested-blocks,no-self-argument,not-callable
+# fmt: off
+
+
+@tvm.script.ir_module
+class Matmul4x4:
+    @T.prim_func
+    def main(A: T.Buffer((4, 128), "float32"), B: T.Buffer((128, 4), "float32"), C: T.Buffer((4, 4), "float32")):
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for k in T.serial(128):
+            for i in T.unroll(4):
+                for j in T.vectorized(4):
+                    with T.block("update"):
+                        vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+                        C[vi, vj] = C[vi, vj] + A[vi, vk] * B[vk, vj]
+
+
+# fmt: on
+# pylint: enable=invalid-name,no-member,line-too-long,too-many-nested-blocks,no-self-argument,not-callable
+
+
+def test_matmul_register_pressure():
+    sch = tir.Schedule(Matmul4x4, debug_mask="all")
+    # 4 accumulators, plus the vector of B and the scalars of A shared by the jammed copies
+    ctx = _create_context(
+        Matmul4x4, "llvm", ms.postproc.VerifyRegisterPressure(max_registers=4, vector_bits=128)
+    )
+    assert not ctx.space_generator.postprocs[0].apply(sch)
+
+    ctx = _create_context(
+        Matmul4x4, "llvm", ms.postproc.VerifyRegisterPressure(max_registers=16, vector_bits=128)
+    )
+    assert ctx.space_generator.postprocs[0].apply(sch)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
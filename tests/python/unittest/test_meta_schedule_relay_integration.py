@@ -15,6 +15,7 @@
 # specific language governing permissions and limitations
 # under the License.
 """Integration test for MetaSchedule"""
+import os
 import tempfile
 from typing import List
 
@@ -28,6 +29,7 @@ from tvm import meta_schedule as ms
 from tvm import relay, te, tir
 from tvm._ffi import register_func
 from tvm.contrib import graph_executor
+from tvm.runtime.vm import VirtualMachine
 from tvm.ir.transform import PassContext
 from tvm.meta_schedule.database import TuningRecord, Workload
 from tvm.meta_schedule.testing.relay_workload import get_network
@@ -727,6 +729,32 @@ def test_module_equality_ignore_ndarray():
     np.testing.assert_allclose(ref, out, rtol=1e-4, atol=1e-4)
 
 
+def test_extract_tasks_repeated_layers():
+    shape = (128, 128)
+
+    def _dense_relu_layers(num_layers):
+        x = relay.var("data", shape=shape, dtype="float32")
+        y = x
+        for i in range(num_layers):
+            weight = relay.var("weight%d" % i, shape=shape, dtype="float32")
+            y = relay.nn.relu(relay.nn.dense(y, weight))
+        return tvm.IRModule.from_expr(y)
+
+    target = "llvm --num-cores=4"
+    # The repeated layers fuse into structurally equal functions, the later ones of which reuse the
+    # lowered TIR of the first one.
+    repeated = ms.relay_integration.extract_tasks(_dense_relu_layers(3), target, params={})
+    single = ms.relay_integration.extract_tasks(_dense_relu_layers(1), target, params={})
+    assert len(repeated) == 1
+    assert len(single) == 1
+    assert repeated[0].task_name == single[0].task_name
+    assert repeated[0].weight == 3
+    assert single[0].weight == 1
+    assert len(repeated[0].dispatched) == 1
+    tvm.ir.assert_structural_equal(repeated[0].dispatched[0], single[0].dispatched[0])
+    tvm.ir.assert_structural_equal(repeated[0].mod, single[0].mod)
+
+
 def _test_anchor_tuning(target, space):
     data_shape = (128, 128)
     weight_shape1 = (128, 128)
@@ -846,6 +874,70 @@ def test_anchor_tuning_cpu_link_params():
     np.testing.assert_allclose(ref, out, atol=1e-3)
 
 
+def test_anchor_tuning_refine_variants():
+    data_shape = (128, 128)
+    weight_shape1 = (128, 128)
+    weight_shape2 = (128, 128)
+
+    data = relay.var("data", shape=data_shape, dtype="float32")
+    weight1 = relay.var("weight1", shape=weight_shape1, dtype="float32")
+    weight2 = relay.var("weight2", shape=weight_shape2, dtype="float32")
+    dense1 = relay.nn.dense(data, weight1)
+    dense2 = relay.nn.dense(dense1 + relay.const(1.0, dtype="float32"), weight2)
+    mod = tvm.IRModule.from_expr(dense2 - data + relay.const(1.0, dtype="float32"))
+
+    weight1_np = np.random.randn(*weight_shape1).astype("float32")
+    weight2_np = np.random.randn(*weight_shape2).astype("float32")
+
+    data_np = np.random.randn(*data_shape).astype("float32")
+    params = {"weight1": weight1_np, "weight2": weight2_np}
+
+    module_equality = "anchor-block"
+    target = "llvm --num-cores=4"
+
+    extracted_tasks = ms.relay_integration.extract_tasks(
+        mod, target, params, module_equality=module_equality
+    )
+    # Both dense subgraphs are deduplicated into one task, which keeps the other one
+    assert len(extracted_tasks) == 1
+    assert len(extracted_tasks[0].dispatched) == 2
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        database = ms.relay_integration.tune_relay(
+            mod=mod,
+            target=target,
+            params=params,
+            work_dir=work_dir,
+            max_trials_global=4,
+            num_trials_per_iter=2,
+            module_equality=module_equality,
+            anchor_refine_trials=2,
+        )
+        assert isinstance(database, ms.database.OrderedUnionDatabase)
+        variant = extracted_tasks[0].dispatched[1]
+        variant_database = ms.database.JSONDatabase(
+            path_workload=os.path.join(work_dir, "database_anchor_variant_workload.json"),
+            path_tuning_record=os.path.join(work_dir, "database_anchor_variant_tuning_record.json"),
+        )
+        assert variant_database.has_workload(variant)
+        lib = ms.relay_integration.compile_relay(database, mod, target, params)
+
+    dev = tvm.device(target, 0)
+    runtime = tvm.contrib.graph_executor.GraphModule(lib["default"](dev))
+
+    runtime.set_input("data", data_np)
+    runtime.run()
+    out = runtime.get_output(0).numpy()
+
+    ref = (
+        relay.create_executor("graph", mod=mod, device=tvm.cpu(0), target="llvm")
+        .evaluate()(*[data_np, weight1_np, weight2_np])
+        .numpy()
+    )
+
+    np.testing.assert_allclose(ref, out, atol=1e-3)
+
+
 @pytest.mark.xfail(raises=tvm.error.TVMError)
 def test_disabled_pass_param():
     """
@@ -965,5 +1057,107 @@ def test_rewrite_layout_link_params_1x1_conv2d():
     np.testing.assert_allclose(ref, out, rtol=1e-4, atol=1e-4)
 
 
+@tvm.script.ir_module
+class DynamicAddOne:
+    @T.prim_func
+    def main(a: T.handle, b: T.handle) -> None:  # type: ignore
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        n = T.int32()
+        A = T.match_buffer(a, (n, 16), "float32")
+        B = T.match_buffer(b, (n, 16), "float32")
+        for i, j in T.grid(n, 16):
+            with T.block("add_one"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                B[vi, vj] = A[vi, vj] + T.float32(1)
+
+
+def test_shape_bucket_dispatch():
+    specialize = tvm.get_global_func("relay.backend.SpecializeShapeBucket")
+    make_dispatch = tvm.get_global_func("relay.backend.MakeShapeBucketDispatch")
+    generic = DynamicAddOne["main"]
+    kernels = []
+    for bucket in [4, 8]:
+        sch = tir.Schedule(specialize(generic, bucket))
+        _, j = sch.get_loops(sch.get_block("add_one"))
+        sch.vectorize(j)
+        kernels.append(sch.mod["main"])
+    assert kernels[0].buffer_map[kernels[0].params[0]].shape[0] == 4
+    dispatch = make_dispatch(generic, [4, 8], kernels)
+    lib = tvm.build(dispatch, target="llvm")
+    for n in [3, 4, 8, 9]:
+        a_np = np.random.uniform(size=(n, 16)).astype("float32")
+        a = tvm.nd.array(a_np)
+        b = tvm.nd.empty((n, 16), "float32")
+        lib(a, b)
+        np.testing.assert_allclose(b.numpy(), a_np + 1, rtol=1e-6)
+
+
+def test_extract_task_shape_buckets():
+    data = relay.var("data", shape=(relay.Any(), 16), dtype="float32")
+    weight = relay.var("weight", shape=(32, 16), dtype="float32")
+    mod = IRModule.from_expr(relay.nn.relu(relay.nn.dense(data, weight)))
+    params = {"weight": np.random.uniform(size=(32, 16)).astype("float32")}
+    extracted_tasks = ms.relay_integration.extract_tasks(
+        mod,
+        target="llvm",
+        params=params,
+        pass_config={
+            "relay.backend.use_meta_schedule": True,
+            "relay.backend.tir_converter": "default",
+            "relay.backend.meta_schedule_shape_buckets": [1, 8],
+        },
+    )
+    assert len(extracted_tasks) == 3
+    batches = []
+    for task in extracted_tasks:
+        func = task.dispatched[0]["main"]
+        batches.append(func.buffer_map[func.params[0]].shape[0])
+    assert sorted(int(b) for b in batches if isinstance(b, tir.IntImm)) == [1, 8]
+
+
+def test_shape_bucket_dispatch_rewrite_layout():
+    data = relay.var("data", shape=(relay.Any(), 16), dtype="float32")
+    weight = relay.var("weight", shape=(32, 16), dtype="float32")
+    mod = IRModule.from_expr(relay.nn.relu(relay.nn.dense(data, weight)))
+    weight_np = np.random.uniform(size=(32, 16)).astype("float32")
+    params = {"weight": weight_np}
+    target = Target("llvm --num-cores=4")
+    extracted_tasks = ms.relay_integration.extract_tasks(
+        mod,
+        target=target,
+        params=params,
+        pass_config={
+            "relay.backend.use_meta_schedule": True,
+            "relay.backend.tir_converter": "default",
+            "relay.backend.meta_schedule_shape_buckets": [4],
+        },
+    )
+    # Record a trace rewriting the layout of the weight for the bucket, as tuning on CPU does
+    database = ms.database.MemoryDatabase()
+    for task in extracted_tasks:
+        func = task.dispatched[0]["main"]
+        if not isinstance(func.buffer_map[func.params[0]].shape[0], tir.IntImm):
+            continue
+        sch = tir.Schedule(task.dispatched[0])
+        _, j, k = sch.get_loops(sch.get_block("T_matmul_NT"))
+        j_o, j_i = sch.split(j, [None, 8])
+        sch.reorder(j_o, k, j_i)
+        assert ms.postproc.RewriteLayout().apply(sch)
+        assert any(inst.kind.name == "TransformLayout" for inst in sch.trace.insts)
+        workload = database.commit_workload(task.dispatched[0])
+        args_info = ms.arg_info.ArgInfo.from_prim_func(func)
+        database.commit_tuning_record(TuningRecord(sch.trace, workload, [1e-3], target, args_info))
+
+    exe = ms.relay_integration.compile_relay(
+        database, mod, target, params, backend="vm", shape_buckets=[4]
+    )
+    vm = VirtualMachine(exe, tvm.cpu())
+    # The bucket kernel still takes the weight in its original layout, like the generic one
+    for n in [3, 4]:
+        data_np = np.random.uniform(size=(n, 16)).astype("float32")
+        out = vm.invoke("main", data_np).numpy()
+        np.testing.assert_allclose(out, np.maximum(data_np @ weight_np.T, 0), rtol=1e-5)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
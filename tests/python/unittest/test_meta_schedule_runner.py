@@ -27,7 +27,7 @@ import tvm
 import tvm.testing
 from tvm._ffi import register_func
 from tvm.meta_schedule.arg_info import TensorInfo
-from tvm.meta_schedule.builder import BuilderInput, LocalBuilder
+from tvm.meta_schedule.builder import BuilderInput, InProcessBuilder, LocalBuilder
 from tvm.meta_schedule.runner import (
     EvaluatorConfig,
     LocalRunner,
@@ -47,6 +47,9 @@ from tvm.meta_schedule.runner.rpc_runner import (
 from tvm.meta_schedule.runner.rpc_runner import (
     default_alloc_argument as rpc_default_alloc_argument,
 )
+from tvm.meta_schedule.runner.rpc_runner import (
+    default_run_evaluator as rpc_default_run_evaluator,
+)
 from tvm.meta_schedule.testing.local_rpc import LocalRPC
 from tvm.meta_schedule.utils import (
     derived_object,
@@ -535,6 +538,79 @@ def test_meta_schedule_rpc_runner_exception():
     assert runner_result.run_secs is None
 
 
+def test_meta_schedule_rpc_runner_device_retry():
+    """Test meta schedule RPC Runner re-running a measurement failing on a device"""
+
+    def initializer():
+        num_calls = [0]
+
+        @register_func("meta_schedule.runner.test_flaky_run_evaluator")
+        def flaky_run_evaluator(  # pylint: disable=unused-variable
+            session: RPCSession,
+            rt_mod: Module,
+            device: Device,
+            evaluator_config: EvaluatorConfig,
+            repeated_args: List[Any],
+        ) -> List[float]:
+            num_calls[0] += 1
+            if num_calls[0] == 1:
+                raise Exception("Device failure")
+            return rpc_default_run_evaluator(
+                session, rt_mod, device, evaluator_config, repeated_args
+            )
+
+    mod = MatmulModule
+    builder = LocalBuilder()
+    (builder_result,) = builder.build([BuilderInput(mod, Target("llvm"))])
+    assert builder_result.artifact_path is not None
+    assert builder_result.error_msg is None
+
+    runner_input = RunnerInput(
+        builder_result.artifact_path,
+        "llvm",
+        [
+            TensorInfo("float32", (MATMUL_N, MATMUL_N)),
+            TensorInfo("float32", (MATMUL_N, MATMUL_N)),
+            TensorInfo("float32", (MATMUL_N, MATMUL_N)),
+        ],
+    )
+
+    def run(rpc: LocalRPC, **kwargs):
+        rpc_config = RPCConfig(
+            tracker_host=rpc.tracker_host,
+            tracker_port=rpc.tracker_port,
+            tracker_key=rpc.tracker_key,
+            session_priority=1,
+            session_timeout_sec=100,
+        )
+        evaluator_config = EvaluatorConfig(
+            number=1,
+            repeat=1,
+            min_repeat_ms=0,
+            enable_cpu_cache_flush=False,
+        )
+        runner = RPCRunner(
+            rpc_config,
+            evaluator_config,
+            initializer=initializer,
+            f_run_evaluator="meta_schedule.runner.test_flaky_run_evaluator",
+            **kwargs,
+        )
+        (runner_future,) = runner.run([runner_input])
+        return runner_future.result()
+
+    with LocalRPC() as rpc:
+        # The failure is reported as is without retry by default.
+        runner_result = run(rpc)
+        assert runner_result.error_msg is not None and "Device failure" in runner_result.error_msg
+        assert runner_result.run_secs is None
+        # The failed measurement is re-run, on the only device of the tracker here.
+        runner_result = run(rpc, max_device_retry=1)
+        assert runner_result.error_msg is None
+        assert len(runner_result.run_secs) == 1
+    _clean_build(builder_result.artifact_path)
+
+
 def test_meta_schedule_local_runner_exception():
     """Test meta schedule Local Runner exception"""
     mod = MatmulModule
@@ -902,5 +978,120 @@ def test_meta_schedule_local_runner_add_test():
     _clean_build(builder_result.artifact_path)
 
 
+def test_meta_schedule_local_runner_in_process():
+    """Test meta schedule local runner measuring the modules kept in memory"""
+    builder = InProcessBuilder(max_workers=2)
+    (builder_result,) = builder.build([BuilderInput(MatmulModule, Target("llvm"))])
+    assert builder_result.artifact_path is not None
+    assert builder_result.error_msg is None
+
+    runner_input = RunnerInput(
+        builder_result.artifact_path,
+        "llvm",
+        [
+            TensorInfo("float32", (MATMUL_N, MATMUL_N)),
+            TensorInfo("float32", (MATMUL_N, MATMUL_N)),
+            TensorInfo("float32", (MATMUL_N, MATMUL_N)),
+        ],
+    )
+    evaluator_config = EvaluatorConfig(
+        number=1,
+        repeat=1,
+        min_repeat_ms=0,
+        enable_cpu_cache_flush=False,
+    )
+    runner = LocalRunner(evaluator_config=evaluator_config, in_process=True)
+    (runner_future,) = runner.run([runner_input])
+    runner_result = runner_future.result()
+    assert runner_result.error_msg is None
+    for result in runner_result.run_secs:
+        if isinstance(result, FloatImm):
+            result = result.value
+        assert isinstance(result, float)
+        assert result >= 0.0
+
+
+def test_meta_schedule_local_runner_batched():
+    """Test meta schedule local runner measuring batches of candidates on shared arguments"""
+    mods = [
+        MatmulModule,
+        MatmulReluModule,
+        BatchMatmulModule,
+        MatmulModule,
+    ]
+    builder = LocalBuilder()
+    builder_results = builder.build([BuilderInput(mod, Target("llvm")) for mod in mods])
+    for builder_result in builder_results:
+        assert builder_result.artifact_path is not None
+        assert builder_result.error_msg is None
+
+    matmul_args_info = [TensorInfo("float32", (MATMUL_N, MATMUL_N)) for _ in range(3)]
+    batch_matmul_args_info = [TensorInfo("float32", [16, MATMUL_M, MATMUL_M]) for _ in range(3)]
+    args_infos = [matmul_args_info, matmul_args_info, batch_matmul_args_info, matmul_args_info]
+    runner_inputs = [
+        RunnerInput(builder_results[i].artifact_path, "llvm", args_infos[i])
+        for i in range(len(mods))
+    ] + [RunnerInput("/non/existent/artifact.tar", "llvm", matmul_args_info)]
+
+    evaluator_config = EvaluatorConfig(
+        number=1,
+        repeat=3,
+        min_repeat_ms=0,
+        enable_cpu_cache_flush=False,
+    )
+    runner = LocalRunner(timeout_sec=100, evaluator_config=evaluator_config, batch_size=2)
+    runner_results = [runner_future.result() for runner_future in runner.run(runner_inputs)]
+    assert len(runner_results) == len(runner_inputs)
+    for runner_result in runner_results[:-1]:
+        assert runner_result.error_msg is None
+        assert len(runner_result.run_secs) == evaluator_config.repeat
+        for result in runner_result.run_secs:
+            if isinstance(result, FloatImm):
+                result = result.value
+            assert isinstance(result, float)
+            assert result >= 0.0
+    # A candidate that fails doesn't fail the others in its batch
+    assert runner_results[-1].run_secs is None
+    assert runner_results[-1].error_msg.startswith("LocalRunner: An exception occurred")
+
+    for builder_result in builder_results:
+        _clean_build(builder_result.artifact_path)
+
+
+def test_meta_schedule_local_runner_rotate_args_with_device_cache_flush():
+    """Test meta schedule local runner rotating the argument sets with a flushed cache"""
+    mod = MatmulModule
+    builder = LocalBuilder()
+    (builder_result,) = builder.build([BuilderInput(mod, Target("llvm"))])
+    assert builder_result.artifact_path is not None
+    assert builder_result.error_msg is None
+
+    runner_input = RunnerInput(
+        builder_result.artifact_path,
+        "llvm",
+        [TensorInfo("float32", (MATMUL_N, MATMUL_N)) for _ in range(3)],
+    )
+    evaluator_config = EvaluatorConfig(
+        number=1,
+        repeat=3,
+        min_repeat_ms=0,
+        enable_device_cache_flush=True,
+        rotate_args=True,
+    )
+    alloc_repeat = 2
+    runner = LocalRunner(
+        timeout_sec=100, evaluator_config=evaluator_config, alloc_repeat=alloc_repeat
+    )
+    (runner_future,) = runner.run([runner_input])
+    runner_result = runner_future.result()
+    assert runner_result.error_msg is None
+    assert len(runner_result.run_secs) == evaluator_config.repeat * alloc_repeat
+    for result in runner_result.run_secs:
+        if isinstance(result, FloatImm):
+            result = result.value
+        assert result >= 0.0
+    _clean_build(builder_result.artifact_path)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
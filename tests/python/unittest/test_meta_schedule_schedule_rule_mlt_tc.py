@@ -28,7 +28,7 @@ from tvm.meta_schedule.testing.space_generation import (
     get_rules,
 )
 from tvm.script import tir as T
-from tvm.tir.tensor_intrin.cuda import get_wmma_intrin_group
+from tvm.tir.tensor_intrin.cuda import get_mma_intrin_group, get_wmma_intrin_group
 
 
 def multi_level_tiling_tensor_core(
@@ -39,6 +39,7 @@ def multi_level_tiling_tensor_core(
     out_dtype="float32",
     trans_b=False,
     use_software_pipeline=False,
+    raster_group_sizes=None,
 ) -> ms.schedule_rule.ScheduleRule:
     assert read_reuse_scope in ["shared", "shared.dyn"]
     assert write_reuse_scope in ["shared", "shared.dyn", "global"]
@@ -72,6 +73,7 @@ def multi_level_tiling_tensor_core(
             scope=write_reuse_scope,
         ),
         use_software_pipeline=use_software_pipeline,
+        raster_group_sizes=raster_group_sizes,
     )
 
 
@@ -747,6 +749,97 @@ def test_matmul_relu_non_tensorizable():
     tvm.ir.assert_structural_equal(mod, sch.mod["main"])
 
 
+def test_matmul_relu_rasterized():
+    mod = te.create_prim_func(
+        te_workload.matmul_relu(
+            n=256,
+            m=256,
+            k=128,
+            in_dtype="float16",
+            out_dtype="float32",
+        )
+    )
+    (sch,) = generate_design_space(
+        kind="cuda",
+        mod=mod,
+        target=tvm.target.Target("cuda"),
+        types=None,
+        sch_rules=[
+            multi_level_tiling_tensor_core(write_reuse_scope="shared", raster_group_sizes=[2, 4])
+        ]
+        + get_rules("cuda", ms.schedule_rule.AutoInline),
+    )
+    candidates = [
+        [int(c) for c in inst.attrs[0]]
+        for inst in sch.trace.insts
+        if inst.kind.name == "SampleCategorical"
+    ]
+    assert [2, 4] in candidates
+    block_loops = [
+        loop
+        for loop in sch.get_loops(sch.get_block("C_o"))
+        if sch.get(loop).thread_binding is not None
+        and sch.get(loop).thread_binding.thread_tag == "blockIdx.y"
+    ]
+    assert len(block_loops) == 1
+
+
+def test_matmul_relu_mma_register_epilogue():
+    mod = te.create_prim_func(
+        te_workload.matmul_relu(
+            n=128,
+            m=128,
+            k=128,
+            in_dtype="float16",
+            out_dtype="float32",
+        )
+    )
+    (sch,) = generate_design_space(
+        kind="cuda",
+        mod=mod,
+        target=tvm.target.Target("cuda"),
+        types=None,
+        sch_rules=[
+            ms.schedule_rule.MultiLevelTilingTensorCore(
+                intrin_groups=[get_mma_intrin_group("shared", "float32", False)],
+                structure="SSSRRSRS",
+                tile_binds=["blockIdx.y", "blockIdx.x", "threadIdx.y"],
+                max_innermost_factor=4,
+                vector_load_lens=[1, 2, 3, 4, 8, 16],
+                reuse_read=ms.schedule_rule.ReuseType(req="must", levels=[4], scope="shared"),
+                reuse_write=ms.schedule_rule.ReuseType(req="no", levels=[], scope="global"),
+            )
+        ]
+        + get_rules("cuda", ms.schedule_rule.AutoInline),
+    )
+    func = sch.mod["main"]
+    output = func.buffer_map[func.params[2]]
+    alloc_buffers = []
+    write_backs = []
+
+    def _visit(node):
+        if isinstance(node, tvm.tir.Block):
+            alloc_buffers.extend(node.alloc_buffers)
+            if any(region.buffer.same_as(output) for region in node.writes):
+                write_backs.append(node)
+
+    tvm.tir.stmt_functor.post_order_visit(func.body, _visit)
+    # The accumulator is not staged in the shared memory.
+    assert all(buf.dtype == "float16" for buf in alloc_buffers if buf.scope().startswith("shared"))
+    assert any(buf.dtype == "float32" and buf.scope() == "warp" for buf in alloc_buffers)
+    # relu is computed by the threads holding the accumulator, which store the output once.
+    (write_back,) = write_backs
+    assert isinstance(write_back.body, tvm.tir.BufferStore)
+    assert isinstance(write_back.body.value, tvm.tir.Max)
+    lanes = [
+        loop
+        for loop in sch.get_loops(sch.get_block(write_back.name_hint))
+        if sch.get(loop).thread_binding is not None
+        and sch.get(loop).thread_binding.thread_tag == "threadIdx.x"
+    ]
+    assert len(lanes) == 1 and int(sch.get(lanes[0]).extent) == 32
+
+
 def test_padded_matmul_relu():
     # fmt: off
     @T.prim_func
@@ -0,0 +1,129 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import meta_schedule as ms
+from tvm import te, tir
+from tvm.meta_schedule.testing.space_generation import generate_design_space
+from tvm.target import Target
+from tvm.te import create_prim_func
+
+
+def _depthwise_conv_chain(kernel):
+    """A 3x3 depthwise convolution followed by a convolution of the given kernel size, in NHWC"""
+    data = te.placeholder((1, 12, 12, 8), name="data")
+    dw_weight = te.placeholder((3, 3, 8), name="dw_weight")
+    weight = te.placeholder((kernel, kernel, 8, 16), name="weight")
+    rh = te.reduce_axis((0, 3), name="rh")
+    rw = te.reduce_axis((0, 3), name="rw")
+    dw = te.compute(
+        (1, 10, 10, 8),
+        lambda n, h, w, c: te.sum(
+            data[n, h + rh, w + rw, c] * dw_weight[rh, rw, c], axis=[rh, rw]
+        ),
+        name="depthwise",
+    )
+    kh = te.reduce_axis((0, kernel), name="kh")
+    kw = te.reduce_axis((0, kernel), name="kw")
+    rc = te.reduce_axis((0, 8), name="rc")
+    out = te.compute(
+        (1, 11 - kernel, 11 - kernel, 16),
+        lambda n, h, w, co: te.sum(
+            dw[n, h + kh, w + kw, rc] * weight[kh, kw, rc, co], axis=[kh, kw, rc]
+        ),
+        name="conv",
+    )
+    return create_prim_func([data, dw_weight, weight, out])
+
+
+def _generate(func):
+    """Generate the design space, with the unfused candidate first"""
+    spaces = generate_design_space(
+        kind="llvm",
+        mod=tvm.IRModule({"main": func}),
+        target=Target("llvm"),
+        types=None,
+        sch_rules=[ms.schedule_rule.RollingBufferFusion()],
+    )
+    return sorted(spaces, key=lambda sch: len(sch.trace.insts))
+
+
+def _intermediate_shape(sch):
+    (buffer,) = sch.mod["main"].body.block.alloc_buffers
+    return [int(extent) for extent in buffer.shape]
+
+
+def _annotated_loops(sch):
+    loops = []
+
+    def _visit(node):
+        if isinstance(node, tir.For) and "meta_schedule.rolling_buffer" in node.annotations:
+            loops.append(node)
+
+    tir.stmt_functor.post_order_visit(sch.mod["main"].body, _visit)
+    return loops
+
+
+def _check_numerics(func, sch):
+    args = [
+        np.random.uniform(size=[int(extent) for extent in func.buffer_map[param].shape]).astype(
+            "float32"
+        )
+        for param in func.params
+    ]
+    results = []
+    for mod in [tvm.IRModule({"main": func}), sch.mod]:
+        lib = tvm.build(mod, target="llvm")
+        tensors = [tvm.nd.array(arg) for arg in args]
+        lib(*tensors)
+        results.append(tensors[-1].numpy())
+    tvm.testing.assert_allclose(results[0], results[1], rtol=1e-5)
+
+
+def test_rolling_buffer_fusion_overlapping_windows():
+    func = _depthwise_conv_chain(kernel=3)
+    spaces = _generate(func)
+    assert len(spaces) == 2
+    unfused, fused = spaces
+    assert _intermediate_shape(unfused) == [1, 10, 10, 8]
+    # The depthwise convolution keeps 3 lines, the height of the kernel of its consumer.
+    assert _intermediate_shape(fused) == [1, 3, 10, 8]
+    (loop,) = _annotated_loops(fused)
+    assert int(loop.extent) == 8
+    _check_numerics(func, fused)
+
+
+def test_rolling_buffer_fusion_pointwise():
+    func = _depthwise_conv_chain(kernel=1)
+    spaces = _generate(func)
+    assert len(spaces) == 2
+    _, fused = spaces
+    # The windows of a pointwise convolution do not overlap, so no rolling buffer is needed.
+    assert not _annotated_loops(fused)
+    # The depthwise convolution is computed per pixel, under the loops n, h and w of its consumer.
+    dw_loops = fused.get_loops(fused.get_block("depthwise"))
+    conv_loops = fused.get_loops(fused.get_block("conv"))
+    assert all(fused.get(dw_loops[i]).same_as(fused.get(conv_loops[i])) for i in range(3))
+    assert not fused.get(dw_loops[3]).same_as(fused.get(conv_loops[3]))
+    _check_numerics(func, fused)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
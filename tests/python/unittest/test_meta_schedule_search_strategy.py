@@ -306,9 +306,203 @@ def test_meta_schedule_evolutionary_search_fail_init_population():  # pylint: di
     assert candidates is None
 
 
+def test_meta_schedule_evolutionary_search_invalid_decisions():  # pylint: disable = invalid-name
+    num_applies = [0]
+
+    @derived_object
+    class CountingFailPostproc(ms.postproc.PyPostproc):
+        """A postproc that always fails and counts the schedules it is applied to."""
+
+        def _initialize_with_tune_context(self, context: ms.TuneContext) -> None:
+            pass
+
+        def apply(self, sch: Schedule) -> bool:
+            num_applies[0] += 1
+            return False
+
+        def clone(self) -> "CountingFailPostproc":
+            return CountingFailPostproc()
+
+        def __str__(self) -> str:
+            return "CountingFailPostproc"
+
+    def _sample_init_population():
+        num_applies[0] = 0
+        context = ms.TuneContext(
+            mod=Matmul,
+            space_generator=ms.space_generator.ScheduleFn(
+                sch_fn=_schedule_matmul,
+                sch_rules=[],
+                postprocs=[CountingFailPostproc()],
+                mutator_probs={},
+            ),
+            search_strategy=ms.search_strategy.EvolutionarySearch(
+                population_size=100,
+                init_min_unmeasured=50,
+                max_fail_count=2,
+            ),
+            target=tvm.target.Target("llvm"),
+            num_threads=1,
+            rand_state=42,
+        )
+        strategy = context.search_strategy
+        strategy.pre_tuning(
+            max_trials=100,
+            num_trials_per_iter=10,
+            design_spaces=context.space_generator.generate_design_space(context.mod),
+            database=ms.database.MemoryDatabase(),
+            cost_model=ms.cost_model.RandomModel(),
+        )
+        assert strategy.generate_measure_candidates() is None
+        return num_applies[0]
+
+    # The search samples 2 rounds of 100 traces. The tile sizes of `k` have few choices, which are
+    # soon known invalid, so that traces are rejected before lowering.
+    first = _sample_init_population()
+    assert 0 < first < 200
+    # What a search learnt is not shared with the next one, which thus behaves the same
+    second = _sample_init_population()
+    assert second == first
+
+
+def test_meta_schedule_evolutionary_search_postprocs_not_shared():  # pylint: disable = invalid-name
+    def _schedule_matmul_small(sch: Schedule):
+        block = sch.get_block("matmul")
+        _, j, k = sch.get_loops(block=block)
+        _, _ = sch.split(j, sch.sample_perfect_tile(j, n=2))
+        _, _ = sch.split(k, sch.sample_perfect_tile(k, n=2))
+
+    @derived_object
+    class TagPostproc(ms.postproc.PyPostproc):
+        """A postproc that annotates the matmul block with its tag."""
+
+        def __init__(self, tag: str) -> None:
+            self.tag = tag
+
+        def _initialize_with_tune_context(self, context: ms.TuneContext) -> None:
+            pass
+
+        def apply(self, sch: Schedule) -> bool:
+            sch.annotate(sch.get_block("matmul"), "postproc_tag", self.tag)
+            return True
+
+        def clone(self) -> "TagPostproc":
+            return TagPostproc(self.tag)
+
+        def __str__(self) -> str:
+            return "TagPostproc"
+
+    def _search(tag: str) -> List[str]:
+        context = ms.TuneContext(
+            mod=Matmul,
+            space_generator=ms.space_generator.ScheduleFn(
+                sch_fn=_schedule_matmul_small,
+                sch_rules=[],
+                postprocs=[TagPostproc(tag)],
+                mutator_probs={
+                    DummyMutator(): 1.0,
+                },
+            ),
+            search_strategy=ms.search_strategy.EvolutionarySearch(
+                population_size=8,
+                init_measured_ratio=0.0,
+                init_min_unmeasured=8,
+                genetic_num_iters=2,
+                genetic_mutate_prob=1.0,
+                eps_greedy=0.0,
+            ),
+            target=tvm.target.Target("llvm"),
+            num_threads=1,  # because we are using a mutator from the python side
+        )
+        strategy = context.search_strategy
+        strategy.pre_tuning(
+            max_trials=4,
+            num_trials_per_iter=4,
+            design_spaces=context.space_generator.generate_design_space(context.mod),
+            database=ms.database.MemoryDatabase(),
+            cost_model=ms.cost_model.RandomModel(),
+        )
+        candidates = strategy.generate_measure_candidates()
+        strategy.post_tuning()
+        assert candidates
+        return [
+            str(c.sch.get(c.sch.get_block("matmul")).annotations["postproc_tag"])
+            for c in candidates
+        ]
+
+    # The mutated traces of both searches are identical before post-processing, so the second
+    # search must not reuse the schedules post-processed by the first one
+    assert set(_search("first")) == {"first"}
+    assert set(_search("second")) == {"second"}
+
+
+def test_meta_schedule_evolutionary_search_transfer_database():  # pylint: disable = invalid-name
+    def _schedule_matmul_small(sch: Schedule):
+        block = sch.get_block("matmul")
+        _, j, k = sch.get_loops(block=block)
+        _, _ = sch.split(j, sch.sample_perfect_tile(j, n=2))
+        _, _ = sch.split(k, sch.sample_perfect_tile(k, n=2))
+
+    # The records tuned on another target
+    transfer_database = ms.database.MemoryDatabase()
+    workload = transfer_database.commit_workload(Matmul)
+    transferred = []
+    for _ in range(8):
+        (sch,) = ms.space_generator.ScheduleFn(sch_fn=_schedule_matmul_small).generate_design_space(
+            Matmul
+        )
+        transferred.append(sch.mod)
+        transfer_database.commit_tuning_record(
+            ms.database.TuningRecord(
+                sch.trace,
+                workload,
+                run_secs=[0.1],
+                target=tvm.target.Target("llvm -mcpu=haswell"),
+            )
+        )
+
+    context = ms.TuneContext(
+        mod=Matmul,
+        space_generator=ms.space_generator.ScheduleFn(
+            sch_fn=_schedule_matmul_small,
+            sch_rules=[],
+            postprocs=[],
+            mutator_probs={
+                DummyMutator(): 1.0,
+            },
+        ),
+        search_strategy=ms.search_strategy.EvolutionarySearch(
+            population_size=8,
+            init_measured_ratio=1.0,
+            init_min_unmeasured=1,
+            genetic_num_iters=1,
+            eps_greedy=1.0,
+            transfer_database=transfer_database,
+        ),
+        target=tvm.target.Target("llvm -mcpu=skylake-avx512"),
+        num_threads=1,  # because we are using a mutator from the python side
+    )
+    strategy = context.search_strategy
+    strategy.pre_tuning(
+        max_trials=2,
+        num_trials_per_iter=2,
+        design_spaces=context.space_generator.generate_design_space(context.mod),
+        database=ms.database.MemoryDatabase(),
+        cost_model=ms.cost_model.RandomModel(),
+    )
+    candidates = strategy.generate_measure_candidates()
+    # The empty database of this target is warm-started by the transferred candidates only
+    assert candidates
+    for candidate in candidates:
+        assert any(tvm.ir.structural_equal(candidate.sch.mod, mod) for mod in transferred)
+    strategy.post_tuning()
+
+
 if __name__ == "__main__":
     test_meta_schedule_replay_func(ms.search_strategy.ReplayFunc)
     test_meta_schedule_replay_func(ms.search_strategy.ReplayTrace)
     test_meta_schedule_evolutionary_search()
     test_meta_schedule_evolutionary_search_early_stop()
     test_meta_schedule_evolutionary_search_fail_init_population()
+    test_meta_schedule_evolutionary_search_postprocs_not_shared()
+    test_meta_schedule_evolutionary_search_transfer_database()
@@ -106,5 +106,18 @@ def test_meta_schedule_design_space_generator_NIE():
         generator._initialize_with_tune_context(TuneContext())
 
 
+def test_meta_schedule_space_generator_amx_is_opt_in():
+    from tvm.meta_schedule.schedule_rule import ScheduleRule, _ffi_api
+
+    vnni_rules = _ffi_api.ScheduleRuleDefaultX86("vnni")
+    context = TuneContext(
+        mod=Matmul,
+        target=tvm.target.Target("llvm -mcpu=sapphirerapids -num-cores=4"),
+        space_generator="post-order-apply",
+    )
+    assert len(context.space_generator.sch_rules) == len(vnni_rules)
+    assert len(ScheduleRule.create("x86-amx")) > len(vnni_rules)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
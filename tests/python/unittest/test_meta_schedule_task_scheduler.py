@@ -436,6 +436,48 @@ def test_meta_schedule_task_scheduler_gradient_based_with_null_search_strategy()
     assert len(database.get_top_k(database.commit_workload(MatmulReluModule), 100)) == 10
 
 
+def test_meta_schedule_task_scheduler_convergence_based():
+    max_trials_per_task = 300
+    tasks = [
+        ms.TuneContext(
+            MatmulModule,
+            target=tvm.target.Target("llvm"),
+            space_generator=_schedule_matmul,
+            search_strategy=ms.search_strategy.ReplayTrace(),
+            task_name="Matmul",
+            rand_state=42,
+        ),
+        ms.TuneContext(
+            BatchMatmulModule,
+            target=tvm.target.Target("llvm"),
+            space_generator=_schedule_batch_matmul,
+            search_strategy=ms.search_strategy.ReplayTrace(),
+            task_name="BatchMatmul",
+            rand_state=0x114514,
+        ),
+    ]
+    database = ms.database.MemoryDatabase()
+    scheduler = ms.task_scheduler.create("convergence", window_size=3, tolerance=0.01)
+    assert isinstance(scheduler, ms.task_scheduler.ConvergenceBased)
+    scheduler.tune(
+        tasks,
+        task_weights=[1.0, 1.0],
+        builder=DummyBuilder(),
+        runner=DummyRunner(),
+        database=database,
+        measure_callbacks=[ms.measure_callback.AddToDatabase()],
+        max_trials_global=max_trials_per_task * len(tasks),
+        max_trials_per_task=max_trials_per_task,
+        num_trials_per_iter=6,
+        cost_model=None,
+    )
+    # The best latency of the dummy runner plateaus quickly, so every task is retired early
+    assert len(database) < max_trials_per_task * len(tasks)
+    for task in tasks:
+        num_records = len(database.get_top_k(database.commit_workload(task.mod), 10000))
+        assert 6 * 4 <= num_records < max_trials_per_task
+
+
 if __name__ == "__main__":
     test_meta_schedule_task_scheduler_single()
     test_meta_schedule_task_scheduler_multiple()
@@ -444,3 +486,4 @@ if __name__ == "__main__":
     test_meta_schedule_task_scheduler_override_next_task_id_only()
     test_meta_schedule_task_scheduler_multiple_gradient_based()
     test_meta_schedule_task_scheduler_gradient_based_with_null_search_strategy()
+    test_meta_schedule_task_scheduler_convergence_based()
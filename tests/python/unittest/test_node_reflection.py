@@ -14,6 +14,8 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import pickle
+import struct
 import tvm
 import tvm.testing
 import sys
@@ -195,5 +197,52 @@ def test_alloc_const():
     np.testing.assert_array_equal(np_data, alloc_const2.data.numpy())
 
 
+def test_saveload_binary(tmp_path):
+    dtype = "float32"
+    shape = (16,)
+    buf = tvm.tir.decl_buffer(shape, dtype)
+    np_data = np.random.rand(*shape).astype(dtype)
+    body = tvm.tir.Evaluate(tvm.tir.const(1.5, "float64") + tvm.tir.const(-3, "int64"))
+    node = {
+        "alloc": tvm.tir.AllocateConst(buf.data, dtype, shape, tvm.nd.array(np_data), body),
+        "list": [tvm.tir.Var("x", "int32x4"), None, tvm.runtime.String("y")],
+    }
+    blob = tvm.ir.save_binary(node)
+    node2 = tvm.ir.load_binary(blob)
+    tvm.ir.assert_structural_equal(node, node2)
+    np.testing.assert_array_equal(np_data, node2["alloc"].data.numpy())
+
+    path = tmp_path / "node.bin"
+    path.write_bytes(bytes(blob))
+    node3 = tvm.ir.load_binary_file(str(path))
+    tvm.ir.assert_structural_equal(node, node3)
+    np.testing.assert_array_equal(np_data, node3["alloc"].data.numpy())
+
+    # Pickled as JSON by the earlier versions
+    x = tvm.tir.Var("x", "float32")
+    assert pickle.loads(pickle.dumps(x)).dtype == "float32"
+    legacy = tvm.tir.Var.__new__(tvm.tir.Var)
+    legacy.__setstate__({"handle": tvm.ir.save_json(x)})
+    assert legacy.name_hint == "x"
+
+
+def test_load_binary_invalid_tensor():
+    shape = (16,)
+    buf = tvm.tir.decl_buffer(shape, "float32")
+    data = tvm.nd.array(np.zeros(shape, "float32"))
+    node = tvm.tir.AllocateConst(buf.data, "float32", shape, data, tvm.tir.Evaluate(0))
+    blob = bytes(tvm.ir.save_binary(node))
+
+    # The recorded size must match the shape before any data is copied
+    offset_nbytes = struct.pack("<QQ", 0, 64)
+    assert blob.count(offset_nbytes) == 1
+    with pytest.raises(tvm.TVMError, match="invalid format"):
+        tvm.ir.load_binary(blob.replace(offset_nbytes, struct.pack("<QQ", 0, 32)))
+    # Offsets and sizes wrapping around must not pass the bounds check
+    for offset, nbytes in [((1 << 64) - 8, 64), (0, (1 << 64) - 8)]:
+        with pytest.raises(tvm.TVMError, match="out of the data"):
+            tvm.ir.load_binary(blob.replace(offset_nbytes, struct.pack("<QQ", offset, nbytes)))
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -130,6 +130,20 @@ def test_roofline_analysis(target, dev):
                 # The cuda gpu kernel is really poorly optimized
                 assert 90 >= call["Percent of Theoretical Optimal"].ratio >= 0.01
 
+    ranking = report.roofline_headroom()
+    assert len(ranking) > 0
+    assert all(x["Headroom (us)"] >= y["Headroom (us)"] for x, y in zip(ranking, ranking[1:]))
+    assert all(0 <= x["Headroom (us)"] <= x["Duration (us)"] for x in ranking)
+
+
+@tvm.testing.requires_llvm
+def test_roofline_peaks_from_target():
+    target = tvm.target.Target("llvm -peak_gflops=100 -peak_bandwidth_gbps=20")
+    assert tvm.utils.roofline.registry.peak_from_target(target, "peak_gflops") == 100e9
+    assert tvm.utils.roofline.registry.peak_from_target(target, "peak_bandwidth_gbps") == 20e9
+    target = tvm.target.Target("llvm")
+    assert tvm.utils.roofline.registry.peak_from_target(target, "peak_gflops") is None
+
 
 if __name__ == "__main__":
     tvm.testing.main()
@@ -0,0 +1,77 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Test the stream-ordered allocation of CUDA device memory"""
+import os
+import subprocess
+import sys
+import textwrap
+
+import tvm
+import tvm.testing
+
+# The allocation mode is read once per process, so the checks run in a fresh interpreter
+_FREE_ON_OTHER_STREAM = textwrap.dedent(
+    """
+    import numpy as np
+    import tvm
+    from tvm import te
+
+    n = 1 << 20
+    A = te.placeholder((n,), name="A")
+    k = te.reduce_axis((0, 4096), name="k")
+    B = te.compute((n,), lambda i: te.sum(A[i] * 1.0001, axis=k), name="B")
+    C = te.compute((n,), lambda i: tvm.tir.const(2.0, "float32"), name="C")
+
+    def build(args, out):
+        sch = te.create_schedule(out.op)
+        block, thread = sch[out].split(out.op.axis[0], factor=256)
+        sch[out].bind(block, te.thread_axis("blockIdx.x"))
+        sch[out].bind(thread, te.thread_axis("threadIdx.x"))
+        return tvm.build(sch, args, "cuda")
+
+    slow, fill = build([A, B], B), build([C], C)
+    dev = tvm.cuda()
+    a = tvm.nd.array(np.ones(n, "float32"), dev)
+    s1, s2 = dev.create_raw_stream(), dev.create_raw_stream()
+    for _ in range(4):
+        # Used on s2, freed on s1, whose next allocation gets the memory back from the pool
+        dev.set_raw_stream(s2)
+        b = tvm.nd.empty((n,), "float32", dev)
+        slow(a, b)
+        dev.set_raw_stream(s1)
+        del b
+        c = tvm.nd.empty((n,), "float32", dev)
+        fill(c)
+        dev.sync(s1)
+        dev.sync(s2)
+        assert (c.numpy() == 2).all()
+        del c
+    dev.set_raw_stream(None)
+    dev.free_raw_stream(s1)
+    dev.free_raw_stream(s2)
+    """
+)
+
+
+@tvm.testing.requires_cuda
+def test_free_waits_for_other_streams():
+    env = dict(os.environ, TVM_CUDA_STREAM_ORDERED_ALLOC="1")
+    subprocess.run([sys.executable, "-c", _FREE_ON_OTHER_STREAM], env=env, check=True)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
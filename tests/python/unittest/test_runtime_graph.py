@@ -151,5 +151,155 @@ def test_save_load_file():
         np.testing.assert_equal(p, params_loaded["x"].numpy())
 
 
+def test_load_params_from_mappable_file():
+    x = relay.var("x", shape=(1, 10))
+    y = relay.var("y", shape=(1, 10))
+    w = relay.var("w", shape=(1, 10))
+    mod = tvm.IRModule.from_expr(relay.Function([x, y, w], relay.multiply(relay.add(x, y), w)))
+    graph_module = relay.build(mod, target="llvm")
+
+    params = {
+        "y": np.random.uniform(size=(1, 10)).astype("float32"),
+        "w": np.random.uniform(size=(1, 10)).astype("float32"),
+    }
+    temp = utils.tempdir()
+    path = temp.relpath("params.bin")
+    runtime.save_param_dict_to_file(params, path, mappable=True)
+    loaded = runtime.load_param_dict_from_file(path)
+    for name, value in params.items():
+        np.testing.assert_equal(loaded[name].numpy(), value)
+
+    data = np.random.uniform(size=(1, 10)).astype("float32")
+    gmod = graph_executor.GraphModule(graph_module["default"](tvm.cpu()))
+    gmod.load_params_from_file(path)
+    gmod.set_input("x", data)
+    gmod.run()
+    expected = (data + params["y"]) * params["w"]
+    tvm.testing.assert_allclose(gmod.get_output(0).numpy(), expected, rtol=1e-5)
+
+
+def test_parallel_execution():
+    # Several independent branches, whose intermediate storages are shared by the memory plan.
+    x = relay.var("x", shape=(16, 64))
+    branches = []
+    for i in range(4):
+        y = x
+        for j in range(3):
+            y = relay.nn.relu(relay.add(y, relay.const(float(i * 3 + j))))
+        branches.append(relay.exp(relay.negative(y)))
+    z = branches[0]
+    for b in branches[1:]:
+        z = relay.add(z, b)
+    mod = tvm.IRModule.from_expr(relay.Function([x], z))
+    with tvm.transform.PassContext(opt_level=0):
+        lib = relay.build(mod, target="llvm")
+
+    data = np.random.uniform(-5, 5, size=(16, 64)).astype("float32")
+    gmod = graph_executor.GraphModule(lib["default"](tvm.cpu()))
+    gmod.set_input("x", data)
+    gmod.run()
+    expected = gmod.get_output(0).numpy()
+    for num_workers in [2, 4, 1]:
+        gmod.set_parallel_execution(num_workers)
+        for _ in range(5):
+            gmod.set_input("x", data)
+            gmod.run()
+            tvm.testing.assert_allclose(gmod.get_output(0).numpy(), expected, rtol=1e-5)
+
+
+@tvm.testing.requires_llvm
+def test_async_submission():
+    n = 4
+    A = te.placeholder((n,), name="A")
+    B = te.compute(A.shape, lambda *i: A(*i) + 1.0, name="B")
+    C = te.compute(A.shape, lambda *i: A(*i) + 2.0, name="C")
+    mod = tvm.lower(te.create_schedule(B.op), [A, B], name="myadd")
+    # Tells the two functions apart, a real asynchronous submission computes the same outputs.
+    mod.update(tvm.lower(te.create_schedule(C.op), [A, C], name="__async_myadd"))
+    mlib = tvm.build(mod, target="llvm")
+
+    def add_node(name, input_nid):
+        attrs = {"func_name": "myadd", "flatten_data": "1", "num_inputs": "1", "num_outputs": "1"}
+        return {"op": "tvm_op", "name": name, "inputs": [[input_nid, 0, 0]], "attrs": attrs}
+
+    shape = (n,)
+    graph = {
+        "nodes": [{"op": "null", "name": "x", "inputs": []}, add_node("a", 0), add_node("b", 1)],
+        "arg_nodes": [0],
+        "node_row_ptr": [0, 1, 2, 3],
+        "heads": [[2, 0, 0]],
+        "attrs": {
+            "shape": ["list_shape", [shape, shape, shape]],
+            "dltype": ["list_str", ["float32", "float32", "float32"]],
+            "storage_id": ["list_int", [0, 1, 2]],
+        },
+    }
+    gmod = graph_executor.create(json.dumps(graph), mlib, tvm.cpu(0))
+    a = np.random.uniform(size=(n,)).astype(A.dtype)
+    gmod.run(x=a)
+    np.testing.assert_equal(gmod.get_output(0).numpy(), a + 4)
+    # The workers of the parallel execution run the synchronous functions
+    gmod.set_parallel_execution(2)
+    gmod.run(x=a)
+    np.testing.assert_equal(gmod.get_output(0).numpy(), a + 2)
+
+
+def test_backend_func_address():
+    n = 4
+    A = te.placeholder((n,), name="A")
+    B = te.compute(A.shape, lambda *i: A(*i) + 1.0, name="B")
+    mlib = tvm.build(te.create_schedule(B.op), [A, B], "llvm", name="myadd")
+    temp = utils.tempdir()
+    path_lib = temp.relpath("deploy_lib.so")
+    mlib.export_library(path_lib)
+
+    attrs = {"func_name": "myadd", "flatten_data": "0", "num_inputs": "1", "num_outputs": "1"}
+    graph = {
+        "nodes": [
+            {"op": "null", "name": "x", "inputs": []},
+            {"op": "tvm_op", "name": "add", "inputs": [[0, 0, 0]], "attrs": attrs},
+        ],
+        "arg_nodes": [0],
+        "node_row_ptr": [0, 1, 2],
+        "heads": [[1, 0, 0]],
+        "attrs": {
+            "shape": ["list_shape", [[n], [n]]],
+            "dltype": ["list_str", ["float32", "float32"]],
+            "storage_id": ["list_int", [0, 1]],
+        },
+    }
+    # The executor calls the kernels of both the JIT and the loaded library by their address
+    for lib in [mlib, tvm.runtime.load_module(path_lib)]:
+        fget = lib.get_function("__tvm_get_backend_func")
+        assert fget("myadd") is not None
+        assert fget("missing") is None
+        gmod = graph_executor.create(json.dumps(graph), lib, tvm.cpu(0))
+        a = np.random.uniform(size=(n,)).astype(A.dtype)
+        gmod.run(x=a)
+        np.testing.assert_equal(gmod.get_output(0).numpy(), a + 1)
+
+
+@tvm.testing.requires_cuda
+def test_staging():
+    x = relay.var("x", shape=(8, 32))
+    y = relay.exp(relay.negative(relay.nn.relu(x)))
+    mod = tvm.IRModule.from_expr(relay.Function([x], y))
+    with tvm.transform.PassContext(opt_level=3):
+        lib = relay.build(mod, target="cuda")
+
+    gmod = graph_executor.GraphModule(lib["default"](tvm.cuda(0)))
+    gmod.set_staging(True)
+    out = tvm.nd.empty((8, 32), "float32")
+    for _ in range(4):
+        data = np.random.uniform(-5, 5, size=(8, 32)).astype("float32")
+        gmod.set_input("x", data)
+        gmod.run()
+        gmod.get_output(0, out)
+        tvm.testing.assert_allclose(out.numpy(), np.exp(-np.maximum(data, 0)), rtol=1e-5)
+    gmod.set_staging(False)
+    gmod.run()
+    tvm.testing.assert_allclose(gmod.get_output(0).numpy(), out.numpy(), rtol=1e-5)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -275,6 +275,28 @@ def test_run_single_node(graph, n, A, myadd):
         mod.run_individual_node(2)
 
 
+@tvm.testing.requires_llvm
+@pytest.mark.skipif(
+    tvm.support.libinfo()["USE_PROFILER"] != "ON", reason="TVM was not built with profiler support"
+)
+def test_run_individual_batched(graph, n, A, myadd):
+    mlib_proxy = tvm.support.FrontendTestModule()
+    mlib_proxy["myadd"] = myadd
+    mod: debug_executor.GraphModuleDebug = debug_executor.create(graph, mlib_proxy, tvm.cpu(0))
+
+    a = np.random.uniform(size=(n,)).astype(A.dtype)
+    mod.set_input(x=a)
+
+    results = mod.run_individual(number=1, repeat=3, batched=True)
+    assert len(results) == 2
+    assert all(len(node_results) == 3 for node_results in results)
+    # The param node has no function to time.
+    assert all(t == 0 for t in results[0])
+    assert all(t > 0 for t in results[1])
+
+    np.testing.assert_equal(mod.get_output(0).numpy(), a + 1)
+
+
 @tvm.testing.requires_llvm
 def test_multiple_output():
     x = relay.var("x", shape=(1, 3, 48, 16), dtype="float32")
@@ -66,6 +66,50 @@ def test_benchmark_result():
     assert r.std == 1.5
 
 
+def test_adaptive_time_evaluator():
+    n = 1024
+    A = te.placeholder((n,), name="A")
+    B = te.compute((n,), lambda i: A[i] + 1.0, name="B")
+    C = te.compute((n,), lambda i: A[i] * 2.0, name="C")
+    funcs = {
+        "add_one": te.create_prim_func([A, B]).with_attr("global_symbol", "add_one"),
+        "times_two": te.create_prim_func([A, C]).with_attr("global_symbol", "times_two"),
+    }
+    mod = tvm.build(tvm.IRModule(funcs), target="llvm")
+    dev = tvm.cpu()
+    a = tvm.nd.empty((n,), "float32", dev)
+    b = tvm.nd.empty((n,), "float32", dev)
+    ftimer = mod.adaptive_time_evaluator(
+        ["add_one", "times_two"], dev, number=10, min_repeat=3, max_repeat=50, max_rel_ci=0.5
+    )
+    results = ftimer(a, b)
+    assert len(results) == 2
+    for r in results:
+        assert len(r.results) + len(r.dropped) >= 3
+        assert r.mean > 0 and r.ci >= 0
+
+    single = mod.adaptive_time_evaluator("add_one", dev, min_repeat=2, max_repeat=2)(a, b)
+    assert len(single.results) + len(single.dropped) == 2
+
+
+def test_batched_time_evaluator():
+    n = 1024
+    A = te.placeholder((n,), name="A")
+    B = te.compute((n,), lambda i: A[i] + 1.0, name="B")
+    func = te.create_prim_func([A, B]).with_attr("global_symbol", "add_one")
+    mod = tvm.build(func, target="llvm")
+    dev = tvm.cpu()
+    a = tvm.nd.empty((n,), "float32", dev)
+    b = tvm.nd.empty((n,), "float32", dev)
+    result = mod.batched_time_evaluator("add_one", dev, number=10, repeat=5)(a, b)
+    assert len(result.results) == 5
+    assert len(result.gaps) == 4
+    assert result.mean > 0
+    assert 0 <= result.mean_gap <= result.max_gap
+
+
 if __name__ == "__main__":
     test_min_repeat_ms()
     test_benchmark_result()
+    test_adaptive_time_evaluator()
+    test_batched_time_evaluator()
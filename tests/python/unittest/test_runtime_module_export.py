@@ -221,6 +221,52 @@ def test_mod_export():
     verify_multi_c_mod_export()
 
 
+@tvm.testing.requires_llvm
+def test_export_load_imported_modules():
+    """The imported modules load the same in parallel and serially."""
+    import numpy as np
+    from tvm.contrib import graph_executor
+
+    num_nets = 4
+    data = np.random.uniform(size=(1, 8)).astype("float32")
+    factories = []
+    for i in range(num_nets):
+        x = relay.var("x", shape=(1, 8), dtype="float32")
+        func = relay.Function([x], relay.add(x, relay.const(float(i))))
+        with tvm.transform.PassContext(opt_level=3):
+            factories.append(relay.build(func, "llvm", mod_name="net%d" % i))
+    # The root factory imports the others, which makes one entry per factory in the blob.
+    root = factories[0].module
+    for factory in factories[1:]:
+        root.import_module(factory.module)
+    temp = utils.tempdir()
+    path_lib = temp.relpath("deploy_lib.so")
+    root.export_library(path_lib)
+
+    def load_and_run():
+        loaded = tvm.runtime.load_module(path_lib)
+        nets = [loaded] + [m for m in loaded.imported_modules if m.type_key != "library"]
+        assert len(nets) == num_nets
+        for i in range(num_nets):
+            (net,) = [m for m in nets if m.implements_function("net%d" % i)]
+            module = graph_executor.GraphModule(net["net%d" % i](tvm.cpu()))
+            module.set_input("x", data)
+            module.run()
+            tvm.testing.assert_allclose(module.get_output(0).numpy(), data + i)
+
+    load_and_run()
+    old = os.environ.get("TVM_MODULE_LOAD_THREADS")
+    try:
+        for num_threads in ["1", "4"]:
+            os.environ["TVM_MODULE_LOAD_THREADS"] = num_threads
+            load_and_run()
+    finally:
+        if old is None:
+            del os.environ["TVM_MODULE_LOAD_THREADS"]
+        else:
+            os.environ["TVM_MODULE_LOAD_THREADS"] = old
+
+
 @tvm.testing.requires_llvm
 def test_import_static_library():
     # Generate two LLVM modules.
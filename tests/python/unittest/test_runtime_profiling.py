@@ -138,6 +138,36 @@ def test_papi(target, dev):
     assert any([float(x) > 0 for x in csv[metric]])
 
 
+@tvm.testing.requires_cuda
+@pytest.mark.skipif(
+    tvm.get_global_func("runtime.profiling.CUPTIMetricCollector", allow_missing=True) is None,
+    reason="CUPTI profiling not enabled",
+)
+def test_cupti():
+    dev = tvm.cuda()
+    metric = "dram__throughput.avg.pct_of_peak_sustained_elapsed"
+    mod, params = mlp.get_workload(1)
+
+    exe = relay.vm.compile(mod, "cuda", params=params)
+    vm = profiler_vm.VirtualMachineProfiler(exe, dev)
+
+    data = tvm.nd.array(np.random.rand(1, 1, 28, 28).astype("float32"), device=dev)
+    report = vm.profile(
+        data,
+        func_name="main",
+        collectors=[tvm.runtime.profiling.CUPTIMetricCollector({dev: [metric]})],
+    )
+    csv = read_csv(report)
+    assert metric in csv.keys()
+    assert any([float(x) > 0 for x in csv[metric]])
+
+    # the default metrics are reported through the graph executor too.
+    lib = relay.build(mod, "cuda", params=params)
+    gr = debug_executor.create(lib.get_graph_json(), lib.lib, dev)
+    report = gr.profile(data=data, collectors=[tvm.runtime.profiling.CUPTIMetricCollector()])
+    assert "lts__t_sector_hit_rate.pct" in str(report)
+
+
 @tvm.testing.requires_llvm
 def test_json():
     mod, params = mlp.get_workload(1)
@@ -196,6 +226,32 @@ def test_rpc_graph():
     assert len(report.calls) > 0
 
 
+def test_rpc_graph_collectors():
+    server = rpc.Server(key="profiling")
+    remote = rpc.connect("127.0.0.1", server.port, key="profiling")
+
+    mod, params = mlp.get_workload(1)
+    exe = relay.build(mod, "llvm", params=params)
+    temp = utils.tempdir()
+    path = temp.relpath("lib.tar")
+    exe.export_library(path)
+    remote.upload(path)
+    rexec = remote.load_module("lib.tar")
+
+    gr = debug_executor.create(exe.get_graph_json(), rexec, remote.cpu())
+
+    data = np.random.rand(1, 1, 28, 28).astype("float32")
+    # The collectors are constructed on the remote from the names of their global functions.
+    report = gr.profile(data=data, collectors=["runtime.profiling.ThreadPoolMetricCollector"])
+    assert len(report.calls) > 0
+    # The collector only reports metrics for the thread pool of TVM.
+    if tvm.support.libinfo().get("USE_OPENMP", "none") in ["none", "OFF", "NOT-FOUND"]:
+        assert all("Thread Pool Sleeps" in call for call in report.calls)
+
+    with pytest.raises(AssertionError):
+        gr.profile(data=data, collectors=[tvm.runtime.profiling.ThreadPoolMetricCollector()])
+
+
 def test_report_serialization():
     mod, params = mlp.get_workload(1)
 
@@ -17,6 +17,7 @@
 import tvm
 from tvm import te
 import tvm.testing
+import hashlib
 import multiprocessing
 import os
 import stat
@@ -176,6 +177,36 @@ def test_rpc_large_array():
     check_remote()
 
 
+@tvm.testing.requires_rpc
+def test_rpc_pipelined_copies():
+    server = rpc.Server()
+    remote = rpc.connect("127.0.0.1", server.port)
+
+    dev = remote.cpu(0)
+    # more uploads and frees in flight than the session keeps pending.
+    arrays = [tvm.nd.array(np.full((16,), i, "float32"), dev) for i in range(200)]
+    for i, arr in enumerate(arrays):
+        np.testing.assert_equal(arr.numpy(), np.full((16,), i, "float32"))
+    del arrays
+    f1 = remote.get_function("rpc.test.addone")
+    assert f1(10) == 11
+
+
+@tvm.testing.requires_rpc
+def test_rpc_shared_memory():
+    server = rpc.Server()
+    remote = rpc.connect("127.0.0.1", server.port, enable_shared_memory=True)
+
+    dev = remote.cpu(0)
+    # large enough to go through the shared memory ring, and to wrap around it.
+    for shape in [(3, 4), (5041, 720), (4096, 2048)]:
+        a_np = np.random.uniform(size=shape).astype("float32")
+        a = tvm.nd.array(a_np, dev)
+        np.testing.assert_equal(a.numpy(), a_np)
+    f1 = remote.get_function("rpc.test.addone")
+    assert f1(10) == 11
+
+
 @tvm.testing.requires_rpc
 def test_rpc_echo():
     def check(remote):
@@ -234,6 +265,25 @@ def test_rpc_file_exchange():
     check_remote()
 
 
+@tvm.testing.requires_rpc
+def test_rpc_cached_upload(tmp_path, monkeypatch):
+    monkeypatch.setenv("TVM_RPC_UPLOAD_CACHE", str(tmp_path))
+    server = rpc.Server()
+    remote = rpc.connect("127.0.0.1", server.port)
+
+    blob = bytearray(np.random.randint(0, 4, size=(1 << 18), dtype="uint8"))
+    remote.upload(blob, "dat0.bin")
+    assert remote.download("dat0.bin") == blob
+    digest = hashlib.sha256(blob).hexdigest()
+    assert (tmp_path / digest).is_file()
+
+    # a second upload of the same content is served from the cache.
+    upload_cached = remote.get_function("tvm.rpc.server.upload_cached")
+    assert upload_cached("dat1.bin", digest)
+    assert remote.download("dat1.bin") == blob
+    assert not upload_cached("dat2.bin", hashlib.sha256(b"missing").hexdigest())
+
+
 @tvm.testing.requires_rpc
 @tvm.testing.requires_llvm
 def test_rpc_remote_module():
@@ -561,6 +611,78 @@ def test_rpc_tracker_request(device_key):
     tracker.terminate()
 
 
+class _FakeConn:
+    def __init__(self):
+        self.pending_matchkeys = set()
+
+
+def _put(sched, conn, port, matchkey):
+    value = (conn, "127.0.0.1", port, matchkey)
+    conn.pending_matchkeys.add(matchkey)
+    sched.put(value)
+    return value
+
+
+def test_rpc_tracker_health_scheduling():
+    from tvm.rpc.tracker import DeviceHealth, PriorityScheduler
+
+    health = {}
+    sched = PriorityScheduler("dev", health)
+    conn_a, conn_b = _FakeConn(), _FakeConn()
+    _put(sched, conn_a, 9001, "dev:a")
+    _put(sched, conn_b, 9002, "dev:b")
+
+    got = []
+    health["127.0.0.1:9001"] = DeviceHealth()
+    health["127.0.0.1:9001"].update({"runs": 8, "errors": 0, "seconds": 8.0})
+    health["127.0.0.1:9002"] = DeviceHealth()
+    health["127.0.0.1:9002"].update({"runs": 8, "errors": 0, "seconds": 2.0})
+    # the faster device is handed out first
+    sched.request("user", 1, lambda value: got.append(value) or True)
+    assert got[-1][1] == 9002
+
+    # the excluded device is only used when no other device is alive
+    _put(sched, conn_b, 9002, "dev:b2")
+    sched.request("user", 1, lambda value: got.append(value) or True, exclude=("127.0.0.1:9002",))
+    assert got[-1][1] == 9001
+    sched.request("user", 1, lambda value: got.append(value) or True, exclude=("127.0.0.1:9001",))
+    assert got[-1][1] == 9002
+
+    # unhealthy devices are skipped while a healthy one is alive
+    health["127.0.0.1:9002"].update({"runs": 16, "errors": 16, "seconds": 1.0})
+    assert not health["127.0.0.1:9002"].healthy()
+    _put(sched, conn_b, 9002, "dev:b3")
+    sched.request("user", 1, lambda value: got.append(value) or True)
+    assert sched.summary() == {"free": 1, "pending": 1}
+    _put(sched, conn_a, 9001, "dev:a2")
+    assert got[-1][1] == 9001
+    assert sched.summary() == {"free": 1, "pending": 0}
+
+
+@tvm.testing.requires_rpc
+def test_rpc_tracker_report_stats():
+    device_key = "test_device"
+    tracker = Tracker(port=9000, port_end=10000)
+    server = rpc.Server(
+        port=9000,
+        port_end=10000,
+        key=device_key,
+        tracker_addr=("127.0.0.1", tracker.port),
+    )
+    time.sleep(0.5)
+    client = rpc.connect_tracker("127.0.0.1", tracker.port)
+    remote = client.request(device_key)
+    assert remote.tracker_device == "127.0.0.1:%d" % server.port
+    client.report_stats(remote.tracker_device, runs=4, errors=1, seconds=2.0)
+    health = client.summary()["device_health"][remote.tracker_device]
+    assert health["runs"] == 4
+    assert health["errors"] == 1
+    assert health["healthy"]
+    assert "Device Health" in client.text_summary()
+    server.terminate()
+    tracker.terminate()
+
+
 @tvm.testing.requires_rpc
 @pytest.mark.parametrize("device_key", ["test_device", "127.0.0.1:5555"])
 def test_rpc_tracker_via_proxy(device_key):
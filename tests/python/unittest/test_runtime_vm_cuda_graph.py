@@ -0,0 +1,65 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+import pytest
+
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.contrib.cuda_graph import cuda_graph_vm
+
+
+@tvm.testing.requires_cudagraph
+def test_vm_cuda_graph_replay():
+    if not cuda_graph_vm.enabled():
+        pytest.skip("USE_VM_CUDA_GRAPH is not enabled")
+
+    x = relay.var("x", shape=(relay.Any(), 16), dtype="float32")
+    y = relay.nn.relu(relay.add(x, relay.const(1.0)) * relay.const(2.0))
+    mod = tvm.IRModule.from_expr(relay.Function([x], y))
+    exe = relay.vm.compile(mod, target="cuda")
+    dev = tvm.cuda(0)
+    vm = cuda_graph_vm.VirtualMachineCudaGraph(exe, dev)
+
+    def check(n):
+        data = np.random.uniform(-1, 1, size=(n, 16)).astype("float32")
+        out = vm.invoke("main", tvm.nd.array(data, dev))
+        tvm.testing.assert_allclose(out.numpy(), np.maximum((data + 1) * 2, 0), rtol=1e-5)
+
+    # warm-up, capture, replay
+    for _ in range(3):
+        check(8)
+    stats = vm.cuda_graph_stats()
+    assert stats["num_graphs"] == 1
+    assert stats["num_captures"] == 1
+    assert stats["num_launches"] == 2
+
+    # a new input shape gets its own graph
+    for _ in range(2):
+        check(4)
+    check(8)
+    stats = vm.cuda_graph_stats()
+    assert stats["num_graphs"] == 2
+    assert stats["num_launches"] == 4
+
+    vm.clear_cuda_graphs()
+    assert vm.cuda_graph_stats()["num_graphs"] == 0
+    check(8)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -14,6 +14,8 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import os
+
 import tvm
 import tvm.testing
 from tvm import te
@@ -227,6 +229,48 @@ def test_call_packed():
     check_global_packed_func()
 
 
+def test_split_translation_units():
+    n = 1024
+    A = te.placeholder((n,), name="A")
+    B = te.compute((n,), lambda i: A[i] + 1.0, name="B")
+    C = te.compute((n,), lambda i: A[i] * 2.0, name="C")
+    mod = tvm.IRModule(
+        {
+            "add_one": te.create_prim_func([A, B]).with_attr("global_symbol", "add_one"),
+            "times_two": te.create_prim_func([A, C]).with_attr("global_symbol", "times_two"),
+        }
+    )
+    with tvm.transform.PassContext(config={"tir.c_host.split_translation_units": True}):
+        mhost = tvm.build(mod, target="c")
+    units = [mhost] + [m for m in mhost.imported_modules if m.type_key == "c"]
+    assert len(units) == 2
+    assert all(unit.get_source().count("TVM_DLL int32_t") == 1 for unit in units)
+
+    temp = utils.tempdir()
+    cache_dir = temp.relpath("objects")
+    os.environ["TVM_CC_OBJECT_CACHE_DIR"] = cache_dir
+    try:
+        num_objects = []
+        for i in range(2):
+            path_dso = temp.relpath("temp%d.so" % i)
+            mhost.export_library(path_dso)
+            num_objects.append(len(os.listdir(cache_dir)))
+        # the second export reuses the objects of the first
+        assert num_objects[0] >= len(units) and num_objects[1] == num_objects[0]
+    finally:
+        del os.environ["TVM_CC_OBJECT_CACHE_DIR"]
+
+    m = tvm.runtime.load_module(path_dso)
+    dev = tvm.cpu(0)
+    a = tvm.nd.array(np.random.uniform(size=n).astype(A.dtype), dev)
+    b = tvm.nd.array(np.zeros(n, dtype=B.dtype), dev)
+    c = tvm.nd.array(np.zeros(n, dtype=C.dtype), dev)
+    m["add_one"](a, b)
+    m["times_two"](a, c)
+    tvm.testing.assert_allclose(b.numpy(), a.numpy() + 1.0)
+    tvm.testing.assert_allclose(c.numpy(), a.numpy() * 2.0)
+
+
 if __name__ == "__main__":
     test_add()
     test_add_pipeline()
@@ -235,3 +279,4 @@ if __name__ == "__main__":
     test_floor()
     test_round()
     test_call_packed()
+    test_split_translation_units()
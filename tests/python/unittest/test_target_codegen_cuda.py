@@ -15,12 +15,14 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import os
 import re
 
 import tvm
 from tvm import te
 import numpy as np
 from tvm import topi
+from tvm.contrib import nvcc, utils
 from tvm.contrib.nvcc import have_fp16, have_int8, have_bf16
 import tvm.testing
 import pytest
@@ -1044,5 +1046,53 @@ def test_try_unaligned_vector_load():
     assert np.allclose(c, expected), f"expected={expected}\nactual={c}"
 
 
+def test_cuda_fatbin_gencode():
+    assert nvcc.get_fatbin_gencode(["sm_80", "sm_70"]) == [
+        "-gencode",
+        "arch=compute_80,code=sm_80",
+        "-gencode",
+        "arch=compute_70,code=sm_70",
+        "-gencode",
+        "arch=compute_80,code=compute_80",
+    ]
+    with pytest.raises(ValueError):
+        nvcc.get_fatbin_gencode(["compute_70"])
+    target = tvm.target.Target("cuda -fatbin_archs=sm_70,sm_80")
+    assert [str(arch) for arch in target.attrs["fatbin_archs"]] == ["sm_70", "sm_80"]
+
+
+@tvm.testing.requires_gpu
+@tvm.testing.requires_cuda
+def test_cuda_ptx_jit_cache(monkeypatch):
+    n = 64
+    A = te.placeholder((n,), name="A")
+    B = te.compute((n,), lambda i: A[i] + 1.0, name="B")
+    s = te.create_schedule(B.op)
+    xo, xi = s[B].split(B.op.axis[0], factor=32)
+    s[B].bind(xo, bx)
+    s[B].bind(xi, tx)
+    fun = tvm.build(s, [A, B], "cuda", name="add_one")
+    dev_module = fun.imported_modules[0]
+
+    temp = utils.tempdir()
+    # The metadata of the kernels is saved along with the source
+    dev_module.save(temp.relpath("add_one.cu"))
+    with open(temp.relpath("add_one.ptx"), "wb") as f:
+        f.write(nvcc.compile_cuda(dev_module.get_source("cu"), target_format="ptx"))
+    cache_dir = temp.relpath("jit_cache")
+    os.mkdir(cache_dir)
+    monkeypatch.setenv("TVM_CUDA_JIT_CACHE_DIR", cache_dir)
+    monkeypatch.setenv("TVM_CUDA_EAGER_MODULE_LOAD", "1")
+
+    # The PTX is compiled when the module is loaded, and the cubin is cached
+    tvm.runtime.load_module(temp.relpath("add_one.ptx"))
+    cached = os.listdir(cache_dir)
+    assert len(cached) == len([f for f in cached if f.endswith(".cubin")]) >= 1
+    # The module is loaded from the cached cubin
+    module = tvm.runtime.load_module(temp.relpath("add_one.ptx"))
+    assert module.get_function("add_one_kernel0") is not None
+    assert sorted(os.listdir(cache_dir)) == sorted(cached)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
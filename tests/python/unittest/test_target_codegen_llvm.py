@@ -104,6 +104,34 @@ def test_llvm_lookup_intrin():
     fcode = tvm.build(mod, None, "llvm")
 
 
+@tvm.testing.requires_llvm
+def test_llvm_orc_jit():
+    n = 64
+    A = te.placeholder((n,), name="A")
+    B = te.compute((n,), lambda i: A[i] + 1.0, name="B")
+    C = te.compute((n,), lambda i: A[i] * 2.0, name="C")
+    s_b = te.create_schedule(B.op)
+    s_c = te.create_schedule(C.op)
+    mod = tvm.lower(s_b, [A, B], name="add_one")
+    mod.update(tvm.lower(s_c, [A, C], name="times_two"))
+    target = tvm.target.Target("llvm -jit=orcjit")
+    assert "-jit=orcjit" in str(target)
+    f = tvm.build(mod, target=target)
+    dev = tvm.cpu(0)
+    a = tvm.nd.array(np.random.uniform(size=n).astype(A.dtype), dev)
+    b = tvm.nd.empty((n,), B.dtype, dev)
+    c = tvm.nd.empty((n,), C.dtype, dev)
+    # Each function is compiled on its own first lookup
+    f["add_one"](a, b)
+    tvm.testing.assert_allclose(b.numpy(), a.numpy() + 1.0)
+    f["times_two"](a, c)
+    tvm.testing.assert_allclose(c.numpy(), a.numpy() * 2.0)
+    # The source is still available after the module is JIT-compiled
+    assert "add_one" in f.get_source()
+    with pytest.raises(ValueError):
+        tvm.build(mod, target="llvm -jit=unknown")
+
+
 @tvm.testing.requires_llvm
 def test_llvm_large_uintimm():
     value = (1 << 63) + 123
@@ -151,6 +179,31 @@ def test_llvm_persist_parallel():
     check_llvm()
 
 
+@tvm.testing.requires_llvm
+def test_llvm_merge_parallel_launch():
+    n = 128
+    A = te.placeholder((n,), name="A")
+    B = te.compute(A.shape, lambda i: A[i] + 1, name="B")
+    C = te.compute(A.shape, lambda i: B[n - 1 - i] * 2, name="C")
+    s = te.create_schedule(C.op)
+    s[B].parallel(s[B].op.axis[0])
+    s[C].parallel(s[C].op.axis[0])
+
+    def count_launches(f):
+        return len(re.findall(r"define .*@__tvm_parallel_lambda", f.get_source("ll")))
+
+    assert count_launches(tvm.build(s, [A, C], "llvm")) == 2
+    with tvm.transform.PassContext(config={"tir.merge_parallel_launch": True}):
+        f = tvm.build(s, [A, C], "llvm")
+    assert count_launches(f) == 1
+    assert "TVMBackendParallelBarrier" in f.get_source("ll")
+    dev = tvm.cpu(0)
+    a = tvm.nd.array(np.random.uniform(size=n).astype(A.dtype), dev)
+    c = tvm.nd.array(np.zeros(n, dtype=C.dtype), dev)
+    f(a, c)
+    tvm.testing.assert_allclose(c.numpy(), (a.numpy()[::-1] + 1) * 2, rtol=1e-5)
+
+
 @tvm.testing.requires_llvm
 def test_llvm_flip_pipeline():
     def check_llvm(nn, base):
@@ -125,7 +125,34 @@ def test_ramp():
     assert tuple(a_nd.numpy()[0, :]) == (0, 3)
 
 
+@tvm.testing.requires_gpu
+@tvm.testing.requires_metal
+def test_metal_batched_launches():
+    n = 1024
+    A = te.placeholder((n,), name="A")
+    B = te.compute((n,), lambda i: A[i] + 1.0, name="B")
+    s = te.create_schedule(B.op)
+    xo, xi = s[B].split(B.op.axis[0], factor=64)
+    s[B].bind(xo, bx)
+    s[B].bind(xi, tx)
+    fun = tvm.build(s, [A, B], "metal")
+    dev = tvm.metal()
+    a_np = np.random.uniform(size=n).astype(A.dtype)
+    bufs = [tvm.nd.array(a_np, dev), tvm.nd.empty((n,), A.dtype, dev)]
+    # The launches are recorded in one encoder, and each one reads the output of the previous one.
+    num_launches = 200
+    for i in range(num_launches):
+        fun(bufs[i % 2], bufs[(i + 1) % 2])
+    tvm.testing.assert_allclose(bufs[num_launches % 2].numpy(), a_np + num_launches)
+    # A copy from the host is ordered after the pending launches.
+    fun(bufs[0], bufs[1])
+    bufs[0].copyfrom(np.zeros(n, dtype=A.dtype))
+    fun(bufs[0], bufs[1])
+    tvm.testing.assert_allclose(bufs[1].numpy(), np.ones(n))
+
+
 if __name__ == "__main__":
+    test_metal_batched_launches()
     test_ramp()
     test_metal_inf_nan()
     test_metal_erf()
@@ -14,6 +14,7 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import numpy as np
 import tvm
 from tvm import te
 import tvm.testing
@@ -184,5 +185,36 @@ def test_opencl_type_casting():
     check_type_casting(dev, 16, "float32")
 
 
+@tvm.testing.requires_gpu
+@tvm.testing.requires_opencl
+def test_opencl_program_cache(tmp_path, monkeypatch):
+    monkeypatch.setenv("TVM_OPENCL_PROGRAM_CACHE_DIR", str(tmp_path))
+    n = 64
+    A = te.placeholder((n,), name="A", dtype="float32")
+    B = te.compute((n,), lambda i: A[i] * 2.0, name="B")
+    s = te.create_schedule(B.op)
+    s[B].bind(s[B].op.axis[0], te.thread_axis("threadIdx.x"))
+    dev = tvm.device(target, 0)
+    a_np = np.random.uniform(size=n).astype("float32")
+    for _ in range(2):
+        # The second module is built from the cached program binary
+        fun = tvm.build(s, [A, B], target)
+        a = tvm.nd.array(a_np, dev)
+        b = tvm.nd.empty((n,), B.dtype, dev)
+        fun(a, b)
+        tvm.testing.assert_allclose(b.numpy(), a_np * 2.0)
+        assert len(list(tmp_path.glob("*.clbin"))) == 1
+
+
+@tvm.testing.requires_gpu
+@tvm.testing.requires_opencl
+def test_opencl_copy_pipelined():
+    dev = tvm.device(target, 0)
+    arrays = [np.random.uniform(size=(1 << 10) * (i + 1)).astype("float32") for i in range(32)]
+    device_arrays = [tvm.nd.array(a, dev) for a in arrays]
+    for a, a_dev in zip(arrays, device_arrays):
+        tvm.testing.assert_allclose(a_dev.numpy(), a)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
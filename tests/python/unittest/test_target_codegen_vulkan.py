@@ -89,6 +89,17 @@ def test_array_copy(dev, dtype, fuzz_seed):
     tvm.testing.assert_allclose(a_np, a.numpy())
 
 
+def test_array_copy_batched(dev, dtype):
+    # Host to device copies are submitted together, up to the next read back to the host.
+    sizes = [1, 17, 1024, 32768]
+    arrays_np = [np.random.uniform(size=(size,)).astype(dtype) for size in sizes]
+    arrays = [tvm.nd.empty(a_np.shape, dtype, dev).copyfrom(a_np) for a_np in arrays_np]
+    arrays_np[0] = np.random.uniform(size=(sizes[0],)).astype(dtype)
+    arrays[0].copyfrom(arrays_np[0])
+    for a_np, a in zip(arrays_np, arrays):
+        tvm.testing.assert_allclose(a_np, a.numpy())
+
+
 @tvm.testing.exclude_targets("llvm")
 def test_array_vectorize_add(target, dev, dtype):
     arr_size = 64
@@ -600,5 +611,82 @@ def test_negative_operand_divmod(target, dev):
     np.testing.assert_array_equal(a[:, 1], (np.arange(N) - offset) % divisor)
 
 
+# Explicitly specify a target, as this test is looking at the
+# generated shader code, and is not running on an actual device.
+@tvm.testing.parametrize_targets(
+    " ".join(
+        [
+            "vulkan",
+            "-supports_storage_buffer_storage_class=1",
+            "-supports_float16=1",
+            "-supports_16bit_buffer=1",
+            "-supports_cooperative_matrix=1",
+        ]
+    )
+)
+def test_cooperative_matrix(target):
+    """The wmma intrinsics are lowered to SPV_NV_cooperative_matrix"""
+    from tvm.tir.tensor_intrin import cuda  # pylint: disable=import-outside-toplevel
+
+    @T.prim_func
+    def matmul(
+        A: T.Buffer((32, 32), "float16"),
+        B: T.Buffer((32, 32), "float16"),
+        C: T.Buffer((32, 32), "float32"),
+    ):
+        for i, j, k in T.grid(32, 32, 32):
+            with T.block("C"):
+                vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+                with T.init():
+                    C[vi, vj] = T.float32(0)
+                C[vi, vj] = C[vi, vj] + T.Cast("float32", A[vi, vk]) * T.Cast("float32", B[vk, vj])
+
+    sch = tvm.tir.Schedule(matmul)
+    block = sch.get_block("C")
+    i, j, k = sch.get_loops(block)
+    i_o, i_i = sch.split(i, [None, 16])
+    j_o, j_i = sch.split(j, [None, 16])
+    k_o, k_i = sch.split(k, [None, 16])
+    sch.reorder(i_o, j_o, k_o, i_i, j_i, k_i)
+    b_x = sch.fuse(i_o, j_o)
+    sch.bind(b_x, "blockIdx.x")
+
+    def bind_copy(copy):
+        fused = sch.fuse(*sch.get_loops(copy)[-2:])
+        _, t_x = sch.split(fused, [None, 32])
+        sch.bind(t_x, "threadIdx.x")
+
+    C_shared = sch.cache_write(block, 0, "shared")
+    C_acc = sch.cache_write(block, 0, "wmma.accumulator")
+    sch.reverse_compute_at(C_acc, b_x)
+    sch.reverse_compute_at(C_shared, b_x)
+    bind_copy(C_shared)
+    for index, frag_scope in [(0, "wmma.matrix_a"), (1, "wmma.matrix_b")]:
+        shared = sch.cache_read(block, index, "shared")
+        frag = sch.cache_read(block, index, frag_scope)
+        sch.compute_at(frag, k_o)
+        sch.compute_at(shared, k_o)
+        bind_copy(shared)
+        load_intrin = cuda.WMMA_LOAD_16x16x16_F16_A_INTRIN
+        if index == 1:
+            load_intrin = cuda.WMMA_LOAD_16x16x16_F16_B_INTRIN
+        sch.tensorize(sch.get_loops(frag)[-2], load_intrin)
+    init = sch.decompose_reduction(block, k_o)
+    sch.tensorize(sch.get_loops(init)[-2], cuda.WMMA_FILL_16x16x16_F32_INTRIN)
+    sch.tensorize(sch.get_loops(block)[-3], cuda.WMMA_SYNC_16x16x16_f16f16f32_INTRIN)
+    sch.tensorize(sch.get_loops(C_acc)[-2], cuda.WMMA_STORE_16x16x16_F32_SHARED_INTRIN)
+
+    f = tvm.build(sch.mod, target=target)
+    assembly = f.imported_modules[0].get_source()
+    assert "OpCapability CooperativeMatrixNV" in assembly
+    assert len(re.findall("OpCooperativeMatrixLoadNV", assembly)) == 2
+    assert len(re.findall("OpCooperativeMatrixMulAddNV", assembly)) == 1
+    assert len(re.findall("OpCooperativeMatrixStoreNV", assembly)) == 1
+
+    # Without the capability, the fragments cannot be lowered
+    with pytest.raises(tvm.TVMError):
+        tvm.build(sch.mod, target=target.replace("-supports_cooperative_matrix=1", ""))
+
+
 if __name__ == "__main__":
     tvm.testing.main()
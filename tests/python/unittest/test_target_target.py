@@ -19,7 +19,7 @@ import json
 import pytest
 import tvm
 import tvm.testing
-from tvm.target import Target, arm_cpu, bifrost, cuda, intel_graphics, mali, rocm, vta
+from tvm.target import Target, arm_cpu, bifrost, cuda, intel_graphics, mali, rocm, vta, wasm
 
 
 @tvm.target.generic_func
@@ -171,12 +171,31 @@ def test_target_llvm_options():
     )
 
 
+@tvm.testing.requires_llvm
+def test_target_llvm_native():
+    target = tvm.target.Target("llvm -mcpu=native -num-cores=3")
+    assert target.mcpu not in ["", "native"]
+    # The attributes given explicitly are kept.
+    assert target.attrs["num-cores"] == 3
+    assert "-mcpu=" + target.mcpu in str(target)
+    assert tvm.target.Target("llvm -mcpu=native").attrs.get("num-cores", 1) > 0
+
+
 def test_target_create():
     targets = [cuda(), rocm(), mali(), intel_graphics(), arm_cpu("rk3399"), vta(), bifrost()]
     for tgt in targets:
         assert tgt is not None
 
 
+def test_target_wasm():
+    target = wasm()
+    assert target.kind.name == "llvm"
+    assert target.attrs["mtriple"] == "wasm32-unknown-unknown-wasm"
+    assert list(target.mattr) == ["+simd128"]
+    assert list(wasm(threads=True).mattr) == ["+simd128", "+atomics", "+bulk-memory"]
+    assert "mattr" not in wasm(simd=False).attrs
+
+
 def test_target_config():
     """
     Test that constructing a target from a dictionary works.
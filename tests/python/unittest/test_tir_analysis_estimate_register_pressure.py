@@ -0,0 +1,58 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-module-docstring,missing-function-docstring
+import tvm.testing
+from tvm.script import tir as T
+from tvm.tir.analysis import estimate_register_pressure
+
+# pylint: disable=no-member,invalid-name
+
+
+@T.prim_func
+def jammed_accumulators(
+    A: T.Buffer((128,), "float32"), B: T.Buffer((512,), "float32"), C: T.Buffer((16,), "float32")
+):
+    for k in range(128):
+        C[T.ramp(0, 1, 4)] = C[T.ramp(0, 1, 4)] + T.broadcast(A[k], 4) * B[T.ramp(k * 4, 1, 4)]
+        C[T.ramp(4, 1, 4)] = C[T.ramp(4, 1, 4)] + T.broadcast(A[k], 4) * B[T.ramp(k * 4, 1, 4)]
+        C[T.ramp(8, 1, 4)] = C[T.ramp(8, 1, 4)] + T.broadcast(A[k], 4) * B[T.ramp(k * 4, 1, 4)]
+        C[T.ramp(12, 1, 4)] = C[T.ramp(12, 1, 4)] + T.broadcast(A[k], 4) * B[T.ramp(k * 4, 1, 4)]
+
+
+@T.prim_func
+def sequential_copies(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+    for i in range(4):
+        B[i * 4] = A[i * 4]
+        B[i * 4 + 1] = A[i * 4 + 1]
+        B[i * 4 + 2] = A[i * 4 + 2]
+        B[i * 4 + 3] = A[i * 4 + 3]
+
+
+def test_jammed_accumulators():
+    # 4 accumulators live through the body, plus the loads of A and B shared by the 4 updates
+    assert estimate_register_pressure(jammed_accumulators, vector_bits=128) == 6
+    # Each float32x4 value takes 2 registers of 64 bits, while the scalar load of A takes 1
+    assert estimate_register_pressure(jammed_accumulators, vector_bits=64) == 11
+
+
+def test_sequential_copies():
+    # Each copy only keeps its loaded value and its stored value live
+    assert estimate_register_pressure(sequential_copies, vector_bits=128) == 2
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
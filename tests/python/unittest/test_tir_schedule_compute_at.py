@@ -1404,7 +1404,8 @@ def test_fail_all_consumers_under_loop(use_block_name):
 def test_fail_all_producers_under_loop(use_block_name):
     sch = tir.Schedule(fail_all_producers_under_loop, debug_mask="all")
     block = "D" if use_block_name else sch.get_block("D")
-    loop, _ = sch.get_loops(sch.get_block("C"))
+    # The producer "C" runs after the loop of "B"
+    loop, _ = sch.get_loops(sch.get_block("B"))
     with pytest.raises(tvm.tir.ScheduleError, match="requires all the producer"):
         sch.reverse_compute_at(block, loop)
 
@@ -1672,5 +1673,52 @@ def test_reverse_compute_at_layout_trans():
     verify_trace_roundtrip(sch=sch, mod=before)
 
 
+def test_reverse_compute_at_with_producer_completed_before_loop():
+    @T.prim_func
+    def before(A: T.Buffer((128, 128), "float32"), C: T.Buffer((128, 128), "float32")):
+        B = T.alloc_buffer((128, 128))
+        B_sum = T.alloc_buffer((128,))
+        for i, j in T.grid(128, 128):
+            with T.block("B"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                B[vi, vj] = T.exp(A[vi, vj])
+        for i, k in T.grid(128, 128):
+            with T.block("B_sum"):
+                vi, vk = T.axis.remap("SR", [i, k])
+                with T.init():
+                    B_sum[vi] = T.float32(0)
+                B_sum[vi] = B_sum[vi] + B[vi, vk]
+        for i, j in T.grid(128, 128):
+            with T.block("C"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                C[vi, vj] = B[vi, vj] / B_sum[vi]
+
+    @T.prim_func
+    def after(A: T.Buffer((128, 128), "float32"), C: T.Buffer((128, 128), "float32")):
+        B = T.alloc_buffer((128, 128))
+        B_sum = T.alloc_buffer((128,))
+        for i, j in T.grid(128, 128):
+            with T.block("B"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                B[vi, vj] = T.exp(A[vi, vj])
+        for i in range(128):
+            for k in range(128):
+                with T.block("B_sum"):
+                    vi, vk = T.axis.remap("SR", [i, k])
+                    with T.init():
+                        B_sum[vi] = T.float32(0)
+                    B_sum[vi] = B_sum[vi] + B[vi, vk]
+            for ax0 in range(128):
+                with T.block("C"):
+                    vi, vj = T.axis.remap("SS", [i, ax0])
+                    C[vi, vj] = B[vi, vj] / B_sum[vi]
+
+    sch = tir.Schedule(before, debug_mask="all")
+    i, _ = sch.get_loops("B_sum")
+    sch.reverse_compute_at(sch.get_block("C"), i)
+    tvm.ir.assert_structural_equal(after, sch.mod["main"])
+    verify_trace_roundtrip(sch=sch, mod=before)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -191,6 +191,21 @@ def rowsum_unrolled(a: T.handle, b: T.handle) -> None:
                 B[vi] = B[vi] + A[vi, vk]
 
 
+@T.prim_func
+def rowsum_unrolled_and_jammed(a: T.handle, b: T.handle) -> None:
+    A = T.match_buffer(a, (128, 128))
+    B = T.match_buffer(b, (128,))
+    for i0_0 in T.serial(0, 32):
+        for i1 in T.serial(0, 128):
+            for i0_1 in T.unroll(0, 4):
+                with T.block("B"):
+                    vi = T.axis.spatial(128, i0_0 * 4 + i0_1)
+                    vk = T.axis.reduce(128, i1)
+                    with T.init():
+                        B[vi] = 0.0
+                    B[vi] = B[vi] + A[vi, vk]
+
+
 @T.prim_func
 def rowsum_not_quasi_affine(a: T.handle, b: T.handle) -> None:
     A = T.match_buffer(a, (128, 128))
@@ -550,6 +565,21 @@ def test_unroll_after_bind():
     verify_trace_roundtrip(s, mod=rowsum)
 
 
+def test_unroll_and_jam():
+    s = tir.Schedule(rowsum, debug_mask="all")
+    i, _ = s.get_loops(s.get_block("B"))
+    s.unroll_and_jam(i, factor=4)
+    tvm.ir.assert_structural_equal(s.mod["main"], rowsum_unrolled_and_jammed)
+    verify_trace_roundtrip(s, mod=rowsum)
+
+
+def test_unroll_and_jam_non_positive_factor():
+    s = tir.Schedule(rowsum, debug_mask="all")
+    i, _ = s.get_loops(s.get_block("B"))
+    with pytest.raises(tvm.tir.ScheduleError):
+        s.unroll_and_jam(i, factor=0)
+
+
 def test_bind1():
     s = tir.Schedule(element_wise, debug_mask="all")
     i, _ = s.get_loops(s.get_block("B"))
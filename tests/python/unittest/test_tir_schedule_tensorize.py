@@ -29,7 +29,16 @@ from tvm.tir.tensor_intrin.arm_cpu import (
     ARM_DOT_4x4_i8_SDOT_INTRIN,
 )
 from tvm.tir.tensor_intrin.rocm import AMDGPU_SDOT4_INTRIN
-from tvm.tir.tensor_intrin.x86 import VNNI_DOT_16x4_INTRIN, AVX512_DOT_16x4_INTRIN
+from tvm.tir.tensor_intrin.x86 import (
+    VNNI_DOT_16x4_INTRIN,
+    AVX512_DOT_16x4_INTRIN,
+    AMX_INT8_DOT_16x16x64_INTRIN,
+    AMX_INT8_DOT_16x16x256_INTRIN,
+    AMX_BF16_DOT_16x16x32_INTRIN,
+    AMX_BF16_DOT_16x16x128_INTRIN,
+    AVX512_FP16_DOT_32x1_INTRIN,
+    AVX512_BF16_DOT_16x2_INTRIN,
+)
 from tvm.tir.tensor_intrin.hexagon import VRMPY_u8u8i32_INTRIN, VDMPY_i16i16i32_INTRIN
 
 # fmt: off
@@ -540,7 +549,7 @@ def test_tensorize_with_annotation():
     verify_trace_roundtrip(sch=s, mod=func)
 
 
-def get_matmul_packed(m, n, k, lhs_type, rhs_dtype="int8"):
+def get_matmul_packed(m, n, k, lhs_type, rhs_dtype="int8", out_dtype="int32"):
     X = te.placeholder((m, k), name="X", dtype=lhs_type)
     W = te.placeholder((n, k), name="W", dtype=rhs_dtype)
 
@@ -548,7 +557,7 @@ def get_matmul_packed(m, n, k, lhs_type, rhs_dtype="int8"):
     matmul = te.compute(
         (m, n),
         lambda i, j: te.sum(
-            X[i, ak].astype("int32") * W[j, ak].astype("int32"),
+            X[i, ak].astype(out_dtype) * W[j, ak].astype(out_dtype),
             axis=ak,
         ),
         name="compute",
@@ -585,6 +594,77 @@ def test_tensorize_avx512():
     tensorize_16x4_test(AVX512_DOT_16x4_INTRIN)
 
 
+def tensorize_amx_test(intrin, lhs_dtype, rhs_dtype, out_dtype, lanes, k_dim):
+    m, n, k = 128, 128, 256
+
+    func = get_matmul_packed(m, n, k, lhs_dtype, rhs_dtype, out_dtype)
+
+    sch = tir.Schedule(func, debug_mask="all")
+    block = sch.get_block("compute")
+    sch.transform_layout(block, "W", lambda i, j: [i//16, j//lanes, i%16, j%lanes])
+    i, j, k = sch.get_loops(block)
+
+    _, ii = sch.split(i, factors=[None, 16])
+    _, ji = sch.split(j, factors=[None, 16])
+    ko, ki = sch.split(k, factors=[None, k_dim])
+    sch.reorder(ko, ii, ji, ki)
+
+    sch.decompose_reduction(block, ko)
+    sch.tensorize(ii, intrin)
+
+    verify_trace_roundtrip(sch=sch, mod=func)
+
+
+def test_tensorize_amx_int8():
+    tensorize_amx_test(AMX_INT8_DOT_16x16x64_INTRIN, "uint8", "int8", "int32", 4, 64)
+    tensorize_amx_test(AMX_INT8_DOT_16x16x256_INTRIN, "uint8", "int8", "int32", 4, 256)
+
+
+def test_tensorize_amx_bf16():
+    tensorize_amx_test(AMX_BF16_DOT_16x16x32_INTRIN, "bfloat16", "bfloat16", "float32", 2, 32)
+    tensorize_amx_test(AMX_BF16_DOT_16x16x128_INTRIN, "bfloat16", "bfloat16", "float32", 2, 128)
+
+
+def test_tensorize_avx512fp16():
+    m, n, k = 128, 128, 128
+
+    func = get_matmul_packed(m, n, k, "float16", "float16", "float16")
+
+    sch = tir.Schedule(func, debug_mask="all")
+    block = sch.get_block("compute")
+    sch.transform_layout(block, "W", lambda i, j: [i//32, j, i%32])
+    _, j, k = sch.get_loops(block)
+
+    _, ji = sch.split(j, factors=[None, 32])
+    ko, ki = sch.split(k, factors=[None, 1])
+    sch.reorder(ko, ji, ki)
+
+    sch.decompose_reduction(block, ko)
+    sch.tensorize(ji, AVX512_FP16_DOT_32x1_INTRIN)
+
+    verify_trace_roundtrip(sch=sch, mod=func)
+
+
+def test_tensorize_avx512bf16():
+    m, n, k = 128, 128, 128
+
+    func = get_matmul_packed(m, n, k, "bfloat16", "bfloat16", "float32")
+
+    sch = tir.Schedule(func, debug_mask="all")
+    block = sch.get_block("compute")
+    sch.transform_layout(block, "W", lambda i, j: [i//16, j//2, i%16, j%2])
+    _, j, k = sch.get_loops(block)
+
+    _, ji = sch.split(j, factors=[None, 16])
+    ko, ki = sch.split(k, factors=[None, 2])
+    sch.reorder(ko, ji, ki)
+
+    sch.decompose_reduction(block, ko)
+    sch.tensorize(ji, AVX512_BF16_DOT_16x2_INTRIN)
+
+    verify_trace_roundtrip(sch=sch, mod=func)
+
+
 def test_tensorize_arm_dot():
     m, n, k = 128, 128, 128
 
@@ -255,6 +255,20 @@ def test_tir_schedule_copy_2():
     verify_trace_roundtrip(sch_copy, mod=matmul)
 
 
+def test_tir_schedule_copy_dependencies():
+    sch = tir.Schedule(mod=matmul_relu, debug_mask="all")
+    sch_copy = sch.copy()
+    root = sch_copy.get_sref(sch_copy.get_block("root"))
+    matmul_block = sch_copy.get_sref(sch_copy.get_block("matmul"))
+    relu_block = sch_copy.get_sref(sch_copy.get_block("relu"))
+    scope = sch_copy.state.get_block_scope(root)
+    (dep_by_src,) = scope.get_deps_by_src(matmul_block)
+    (dep_by_dst,) = scope.get_deps_by_dst(relu_block)
+    assert dep_by_src.same_as(dep_by_dst)
+    assert dep_by_src.src.same_as(matmul_block)
+    assert dep_by_src.dst.same_as(relu_block)
+
+
 def test_tir_schedule_remove_rv():
     # Tests:
     # - Schedule.remove_rv
@@ -172,6 +172,40 @@ def test_prim_func_body_mismatch():
     assert rhs_path == expected_path
 
 
+def test_prim_func_cached_hash():
+    x = te.var("x")
+    y = te.var("y")
+    func0 = tvm.tir.PrimFunc([x, y], tvm.tir.Evaluate(x + y))
+    func1 = tvm.tir.PrimFunc([x, y], tvm.tir.Evaluate(y + x))
+    # The second hashes are the cached ones
+    for map_free_vars in [False, True]:
+        for func in [func0, func1]:
+            assert tvm.ir.structural_hash(func, map_free_vars) == tvm.ir.structural_hash(
+                func, map_free_vars
+            )
+    # The cached hashes differ, and must still give the same answers
+    assert not consistent_equal(func0, func1)
+    assert get_sequal_mismatch(func0, func1) is not None
+    # A copy of the function has its own cache
+    func2 = func0.with_attr("global_symbol", "main")
+    assert tvm.ir.structural_hash(func2) != tvm.ir.structural_hash(func0)
+    func3 = tvm.ir.load_json(tvm.ir.save_json(func0))
+    assert consistent_equal(func0, func3)
+
+
+def test_prim_func_cached_hash_float():
+    x = te.var("x", "float32")
+    funcs = [
+        tvm.tir.PrimFunc([x], tvm.tir.Evaluate(x + tvm.tir.const(value, "float32")))
+        for value in [0.0, -0.0]
+    ]
+    # 0.0 equals -0.0 but hashes differently, so the cached hashes must not decide the comparison
+    for func in funcs:
+        tvm.ir.structural_hash(func)
+    assert tvm.ir.structural_hash(funcs[0]) != tvm.ir.structural_hash(funcs[1])
+    assert tvm.ir.structural_equal(funcs[0], funcs[1])
+
+
 def test_array():
     x = np.arange(10)
     nx = tvm.nd.array(x)
@@ -115,5 +115,22 @@ def test_bf16_storage_legalize():
     tvm.ir.assert_structural_equal(after, expected)
 
 
+def test_bf16_compute_legalize_keep_reinterpreted_buffer():
+    """A local bf16 buffer whose bits are reinterpreted is not remapped to f32."""
+
+    @T.prim_func
+    def before(Aptr: T.handle("bfloat16"), Bptr: T.handle("int32")):
+        T.func_attr({"global_symbol": "main"})
+        A = T.decl_buffer((32,), "bfloat16", data=Aptr)
+        B = T.decl_buffer((16,), "int32", data=Bptr)
+        C = T.decl_buffer((32,), "bfloat16")
+        for i in T.grid(32):
+            C[i] = A[i]
+        B[T.ramp(0, 1, 16)] = T.reinterpret(C[T.ramp(0, 1, 32)], dtype="int32x16")
+
+    after = tvm.tir.transform.BF16ComputeLegalize()(tvm.IRModule.from_expr(before))
+    tvm.ir.assert_structural_equal(after["main"], before)
+
+
 if __name__ == "__main__":
     test_bf16_storage_legalize()
@@ -0,0 +1,119 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-module-docstring,missing-function-docstring
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm.script import tir as T
+
+
+# pylint: disable=invalid-name,no-member,no-self-argument
+@T.prim_func
+def embedding(a: T.handle, idx: T.handle, b: T.handle) -> None:
+    A = T.match_buffer(a, (1000, 64), "float32")
+    I = T.match_buffer(idx, (128,), "int32")
+    B = T.match_buffer(b, (128, 64), "float32")
+    for i in T.serial(128, annotations={"software_prefetch": 4}):
+        for j in T.serial(64):
+            with T.block("B"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                B[vi, vj] = A[I[vi], vj]
+
+
+@T.prim_func
+def transpose(a: T.handle, b: T.handle) -> None:
+    A = T.match_buffer(a, (64, 64), "float32")
+    B = T.match_buffer(b, (64, 64), "float32")
+    for i in T.serial(64):
+        for j in T.serial(64, annotations={"software_prefetch": 0}):
+            with T.block("B"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                B[vi, vj] = A[vj, vi]
+
+
+@T.prim_func
+def add(a: T.handle, b: T.handle) -> None:
+    A = T.match_buffer(a, (1024,), "float32")
+    B = T.match_buffer(b, (1024,), "float32")
+    for i in T.serial(1024, annotations={"software_prefetch": 0}):
+        with T.block("B"):
+            vi = T.axis.spatial(1024, i)
+            B[vi] = A[vi] + 1.0
+
+
+# pylint: enable=invalid-name,no-member,no-self-argument
+
+
+def _inject(func):
+    mod = tvm.IRModule.from_expr(func)
+    mod = tvm.tir.transform.LowerOpaqueBlock()(mod)
+    mod = tvm.tir.transform.InjectSoftwarePrefetch()(mod)
+    return mod["main"].body
+
+
+def _prefetches(stmt):
+    result = []
+
+    def _visit(node):
+        if isinstance(node, tvm.tir.Call) and node.op.name == "tir.prefetch":
+            result.append(node)
+
+    tvm.tir.stmt_functor.post_order_visit(stmt, _visit)
+    return result
+
+
+def test_gather():
+    loop = _inject(embedding)
+    assert "software_prefetch" not in loop.annotations
+    assert isinstance(loop.body, tvm.tir.SeqStmt)
+    guarded = loop.body[0]
+    assert isinstance(guarded, tvm.tir.IfThenElse)
+    (prefetch,) = _prefetches(guarded)
+    target = prefetch.args[0].args[0]
+    assert target.buffer.name == "A"
+    tvm.ir.assert_structural_equal(target.indices[1], tvm.tir.const(0, "int32"))
+
+
+def test_strided():
+    loop = _inject(transpose).body
+    assert "software_prefetch" not in loop.annotations
+    assert isinstance(loop.body, tvm.tir.SeqStmt)
+    (prefetch,) = _prefetches(loop.body[0])
+    assert prefetch.args[0].args[0].buffer.name == "A"
+
+
+def test_sequential():
+    loop = _inject(add)
+    assert "software_prefetch" not in loop.annotations
+    assert not _prefetches(loop)
+
+
+@tvm.testing.requires_llvm
+def test_build_gather():
+    func = tvm.build(embedding, target="llvm")
+    a_np = np.random.uniform(size=(1000, 64)).astype("float32")
+    idx_np = np.random.randint(0, 1000, size=(128,)).astype("int32")
+    a = tvm.nd.array(a_np)
+    idx = tvm.nd.array(idx_np)
+    b = tvm.nd.empty((128, 64), "float32")
+    func(a, idx, b)
+    tvm.testing.assert_allclose(b.numpy(), a_np[idx_np])
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
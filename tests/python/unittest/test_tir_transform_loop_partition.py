@@ -828,5 +828,33 @@ def test_loop_partition_with_unit_loop_in_condition():
     assert tvm.ir.structural_equal(mod["main"], after)
 
 
+def test_max_code_growth():
+    def _partition(config):
+        ib = tvm.tir.ir_builder.create()
+        data = ib.pointer("float32", name="A")
+        out = ib.pointer("float32", name="B")
+        with ib.for_range(0, 16, "oh") as oh:
+            with ib.for_range(0, 16, "ow") as ow:
+                with ib.if_scope(ib.likely(oh > 0)):
+                    with ib.if_scope(ib.likely(ow > 0)):
+                        out[oh * 16 + ow] = data[oh * 16 + ow - 17]
+        mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([data, out], ib.get()))
+        config = {"tir.LoopPartition": {"partition_const_loop": True, **config}}
+        with tvm.transform.PassContext(config=config):
+            mod = tvm.tir.transform.LoopPartition()(mod)
+            return tvm.tir.transform.Simplify()(mod)["main"].body
+
+    def _count(stmt, node_type):
+        return sum(collect_visit(stmt, lambda x: isinstance(x, node_type)))
+
+    for config in [{}, {"max_code_growth": 10.0}]:
+        stmt = _partition(config)
+        assert _count(stmt, tvm.tir.IfThenElse) == 0
+    # Without a budget for the copies, the loops keep their conditions.
+    stmt = _partition({"max_code_growth": 0.0})
+    assert _count(stmt, tvm.tir.IfThenElse) == 2
+    assert _count(stmt, tvm.tir.For) == 2
+
+
 if __name__ == "__main__":
     tvm.testing.main()
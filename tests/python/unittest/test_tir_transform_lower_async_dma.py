@@ -0,0 +1,81 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+import tvm.testing
+from tvm.script import tir as T
+
+
+def _dma_calls(func):
+    mod = tvm.tir.transform.LowerAsyncDMA()(tvm.IRModule.from_expr(func))
+    calls = []
+
+    def visit(node):
+        if isinstance(node, tvm.tir.Call) and node.op.name.startswith("tir.dma_"):
+            calls.append(node)
+
+    tvm.tir.stmt_functor.post_order_visit(mod["main"].body, visit)
+    return calls
+
+
+def test_contiguous_copy():
+    @T.prim_func
+    def func(A: T.Buffer((256,), "int8"), B: T.Buffer((256,), "int8")):
+        with T.attr(0, "async_commit_queue_scope", 0):
+            with T.attr(0, "async_scope", 1):
+                for i, j in T.grid(4, 64):
+                    B[i * 64 + j] = A[i * 64 + j]
+        with T.attr(0, "async_wait_queue_scope", 0):
+            with T.attr(0, "async_wait_inflight_count", 0):
+                T.evaluate(0)
+
+    calls = _dma_calls(func)
+    assert [call.op.name for call in calls] == ["tir.dma_copy", "tir.dma_wait"]
+    assert calls[0].args[3] == 256
+
+
+def test_strided_copy():
+    @T.prim_func
+    def func(A: T.Buffer((8192,), "float16"), B: T.Buffer((2048,), "float16")):
+        with T.attr(0, "async_commit_queue_scope", 0):
+            with T.attr(0, "async_scope", 1):
+                for i, j in T.grid(32, 64):
+                    B[i * 64 + j] = A[i * 256 + j + 128]
+        with T.attr(0, "async_wait_queue_scope", 0):
+            with T.attr(0, "async_wait_inflight_count", 0):
+                T.evaluate(0)
+
+    calls = _dma_calls(func)
+    assert [call.op.name for call in calls] == ["tir.dma_copy_2d", "tir.dma_wait"]
+    queue_id, dst, src, width, height, dst_stride, src_stride, _ = calls[0].args
+    assert queue_id == 0
+    assert src.args[0].indices[0] == 128
+    assert [width, height, dst_stride, src_stride] == [128, 32, 128, 512]
+
+
+def test_overlapping_rows_not_lowered():
+    @T.prim_func
+    def func(A: T.Buffer((8192,), "int8"), B: T.Buffer((2048,), "int8")):
+        with T.attr(0, "async_commit_queue_scope", 0):
+            with T.attr(0, "async_scope", 1):
+                for i, j in T.grid(32, 64):
+                    B[i * 64 + j] = A[i * 32 + j]
+
+    assert not any(call.op.name == "tir.dma_copy_2d" for call in _dma_calls(func))
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -36,15 +36,12 @@ def run_passes(sch, args):
     )(mod)
 
 
-def verify_single_allocation(stmt, alloc_size=None):
+def verify_single_allocation(stmt, alloc_size=None, scope="shared.dyn"):
     num_alloc = [0]
     alloc_extents = []
 
     def verify(n):
-        if (
-            isinstance(n, tvm.tir.Allocate)
-            and n.buffer_var.type_annotation.storage_scope == "shared.dyn"
-        ):
+        if isinstance(n, tvm.tir.Allocate) and n.buffer_var.type_annotation.storage_scope == scope:
             num_alloc[0] += 1
             alloc_extents.append(n.extents[0])
 
@@ -326,8 +323,67 @@ def test_dyn_shared_more_dtype():
         check_target(target)
 
 
+def test_static_shared_reuse_and_merge():
+    """Test lifetime-based reuse of static shared memory"""
+    n = 64
+    A = te.placeholder((n,), name="A", dtype="float32")
+    B = te.placeholder((n,), name="B", dtype="float16")
+
+    def test_device_ir(A, B, D):
+        ib = tvm.tir.ir_builder.create()
+
+        tx = te.thread_axis("threadIdx.x")
+        ib.scope_attr(tx, "thread_extent", n)
+
+        A_sh = ib.allocate(A.dtype, (n,), scope="shared", name="A_sh")
+        B_sh = ib.allocate(B.dtype, (n,), scope="shared", name="B_sh")
+
+        Aptr = ib.buffer_ptr(A)
+        Bptr = ib.buffer_ptr(B)
+        Dptr = ib.buffer_ptr(D)
+
+        A_sh[tx] = Aptr[tx]
+        Dptr[tx] = A_sh[tx]
+
+        B_sh[tx] = Bptr[tx]
+        Dptr[tx] += cast(B_sh[tx], "float32")
+
+        return ib.get()
+
+    D = te.extern(
+        (n,),
+        [A, B],
+        lambda ins, outs: test_device_ir(ins[0], ins[1], outs[0]),
+        name="vadd",
+        dtype="float32",
+    )
+    s = te.create_schedule(D.op)
+    passes = tvm.transform.Sequential(
+        [
+            tvm.tir.transform.StorageFlatten(64),
+            tvm.tir.transform.MergeDynamicSharedMemoryAllocations(),
+        ]
+    )
+
+    with tvm.transform.PassContext(config={"tir.merge_static_smem": True}):
+        mod = passes(schedule_to_module(s, [A, B, D]))
+    # B_sh reuses the memory of A_sh, whose lifetime ended.
+    verify_single_allocation(mod["main"].body, n * 4, scope="shared")
+
+    mod = passes(schedule_to_module(s, [A, B, D]))
+    num_alloc = [0]
+
+    def count(stmt):
+        if isinstance(stmt, tvm.tir.Allocate):
+            num_alloc[0] += stmt.buffer_var.type_annotation.storage_scope == "shared"
+
+    tvm.tir.stmt_functor.post_order_visit(mod["main"].body, count)
+    assert num_alloc[0] == 2
+
+
 if __name__ == "__main__":
     test_matmul_dyn_shared()
     test_dyn_shared_vectorized_store()
     test_dyn_shared_reuse_and_merge()
     test_dyn_shared_more_dtype()
+    test_static_shared_reuse_and_merge()
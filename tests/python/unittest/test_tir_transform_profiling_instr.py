@@ -336,5 +336,34 @@ def test6():
     tvm.ir.assert_structural_equal(mod["main"], test6_expected_output)
 
 
+# test7: The loop regions of a CPU kernel are recorded by the runtime.
+@tvm.testing.requires_llvm
+def test7_loop_profiling():
+    config = {"tir.instrument_lwp": True, "tir.lwp_max_depth": 2, "tir.reset_start_id": True}
+    with tvm.transform.PassContext(config=config):
+        f = tvm.build(input1, target="llvm")
+    dev = tvm.cpu()
+    a = tvm.nd.array(numpy.ones((8, 8, 128), dtype="int32"), dev)
+    b = tvm.nd.array(numpy.zeros((8, 8, 128), dtype="int32"), dev)
+    c = tvm.nd.array(numpy.zeros((8, 8, 128), dtype="int32"), dev)
+    f(a, b, c)
+    tvm.runtime.profiling.start_loop_profiling()
+    for _ in range(3):
+        f(a, b, c)
+    report = tvm.runtime.profiling.stop_loop_profiling()
+    regions = [str(call["Region"]).split("/") for call in report.calls]
+    # The function region encloses the two sibling loops.
+    assert [len(r) for r in regions].count(1) == 1
+    assert [len(r) for r in regions].count(2) == 2
+    for call in report.calls:
+        assert call["Count"].value % 3 == 0
+    numpy.testing.assert_equal(c.numpy(), 4)
+    assert "Self (us)" in report.table()
+    # Nothing is recorded while the profiling is off.
+    f(a, b, c)
+    tvm.runtime.profiling.start_loop_profiling()
+    assert len(tvm.runtime.profiling.stop_loop_profiling().calls) == 0
+
+
 if __name__ == "__main__":
     tvm.testing.main()
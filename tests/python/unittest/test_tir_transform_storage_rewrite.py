@@ -161,6 +161,34 @@ def test_alloc_different_dtypes():
     dtype_test(dtype_list, length)
 
 
+def test_alloc_different_dtypes_share_storage():
+    ib = tvm.tir.ir_builder.create()
+    n = te.var("n")
+    with ib.for_range(0, n, name="i") as i:
+        A = ib.allocate("int8", 64, name="A", scope="global")
+        with ib.for_range(0, 64, name="j") as j:
+            A[j] = tvm.tir.const(1, "int8")
+        B = ib.allocate("float32", 32, name="B", scope="global")
+        with ib.for_range(0, 32, name="j") as j:
+            B[j] = tvm.tir.const(1, "float32")
+    body = ib.get()
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([n], body))
+    body = tvm.tir.transform.StorageRewrite()(mod)["main"].body
+
+    allocs = []
+
+    def verify(n):
+        if isinstance(n, tvm.tir.Allocate):
+            allocs.append(n)
+
+    tvm.tir.stmt_functor.post_order_visit(body, verify)
+    # The int8 storage is grown for the float32 buffer, and declared with the wider type.
+    assert len(allocs) == 1
+    assert allocs[0].dtype == "float32"
+    assert allocs[0].extents[0].value == 32
+
+
 def test_inplace_rule():
     m = 10
     A = te.placeholder((m,), name="A")
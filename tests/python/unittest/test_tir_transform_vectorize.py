@@ -14,7 +14,10 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import numpy as np
+
 import tvm
+import tvm.testing
 from tvm import te
 
 
@@ -226,6 +229,89 @@ def test_vectorize_dtype_mismatch():
     tvm.lower(s, [A], "llvm", simple_mode=True)
 
 
+def test_vectorize_predicated():
+    n = te.var("n")
+    ib = tvm.tir.ir_builder.create()
+    A = ib.pointer("float32", name="A")
+    B = ib.pointer("float32", name="B")
+    with ib.for_range(0, 4, kind="vectorize") as i:
+        with ib.if_scope(i < n):
+            B[i] = A[i] + 1.0
+    stmt = ib.get()
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([A, B, n], stmt))
+    with tvm.transform.PassContext(config={"tir.vectorize_predicated": True}):
+        stmt = tvm.tir.transform.VectorizeLoop()(mod)["main"].body
+
+    assert isinstance(stmt, tvm.tir.Evaluate)
+    assert stmt.value.op.name == "tir.masked_store"
+    value = stmt.value.args[1]
+    assert value.dtype == "float32x4"
+    assert value.a.op.name == "tir.masked_load"
+
+    # A scalar store cannot be masked, the loop is scalarized.
+    ib = tvm.tir.ir_builder.create()
+    A = ib.pointer("float32", name="A")
+    with ib.for_range(0, 4, kind="vectorize") as i:
+        with ib.if_scope(i < n):
+            A[0] = 1.0
+    stmt = ib.get()
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([A, n], stmt))
+    with tvm.transform.PassContext(config={"tir.vectorize_predicated": True}):
+        stmt = tvm.tir.transform.VectorizeLoop()(mod)["main"].body
+
+    assert isinstance(stmt, tvm.tir.For)
+
+
+@tvm.testing.requires_llvm
+def test_vectorize_predicated_tail():
+    n = 10
+    A = te.placeholder((n,), name="A")
+    B = te.compute((n,), lambda i: tvm.tir.if_then_else(i > 2, A[i] * 2.0, A[i] + 1.0), name="B")
+    s = te.create_schedule(B.op)
+    _, inner = s[B].split(B.op.axis[0], factor=4)
+    s[B].vectorize(inner)
+
+    with tvm.transform.PassContext(config={"tir.vectorize_predicated": True}):
+        mod = tvm.lower(s, [A, B])
+        f = tvm.build(s, [A, B], "llvm")
+    assert "masked_store" in str(mod)
+
+    dev = tvm.cpu()
+    a_np = np.random.uniform(size=n).astype(A.dtype)
+    a = tvm.nd.array(a_np, dev)
+    b = tvm.nd.array(np.zeros(n, dtype=B.dtype), dev)
+    f(a, b)
+    expected = np.where(np.arange(n) > 2, a_np * 2.0, a_np + 1.0)
+    tvm.testing.assert_allclose(b.numpy(), expected)
+
+
+def test_vectorize_reduce_axis():
+    n, m = 8, 64
+    A = te.placeholder((n, m), name="A")
+    k = te.reduce_axis((0, m), name="k")
+    B = te.compute((n,), lambda i: te.sum(A[i, k], axis=k), name="B")
+    s = te.create_schedule(B.op)
+    _, ki = s[B].split(k, factor=4)
+    BF = s.rfactor(B, ki)
+    s[BF].reorder(s[BF].op.axis[1], s[BF].op.reduce_axis[0], s[BF].op.axis[0])
+    s[BF].vectorize(s[BF].op.axis[0])
+    s[BF].compute_at(s[B], s[B].op.axis[0])
+    s[B].vectorize(s[B].op.reduce_axis[0])
+
+    mod = tvm.lower(s, [A, B])
+    assert "vector_reduce_add" in str(mod)
+
+    f = tvm.build(s, [A, B], "llvm")
+    dev = tvm.cpu()
+    a_np = np.random.uniform(size=(n, m)).astype(A.dtype)
+    a = tvm.nd.array(a_np, dev)
+    b = tvm.nd.array(np.zeros(n, dtype=B.dtype), dev)
+    f(a, b)
+    tvm.testing.assert_allclose(b.numpy(), a_np.sum(axis=1), rtol=1e-5)
+
+
 if __name__ == "__main__":
     test_vectorize_vector()
     test_vectorize_with_if()
@@ -236,3 +322,6 @@ if __name__ == "__main__":
     test_vectorize_let()
     test_vectorize_while_fail()
     test_vectorize_dtype_mismatch()
+    test_vectorize_predicated()
+    test_vectorize_predicated_tail()
+    test_vectorize_reduce_axis()
@@ -14,6 +14,7 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import numpy as np
 import pytest
 
 import tvm
@@ -124,7 +125,9 @@ def test_no_pool_error():
         buffer_pool_allocations = fusmp_algo(buffer_info_arr, 0)
 
 
-@pytest.mark.parametrize("algorithm", ["greedy_by_size", "greedy_by_conflicts", "hill_climb"])
+@pytest.mark.parametrize(
+    "algorithm", ["greedy_by_size", "greedy_by_conflicts", "hill_climb", "hybrid"]
+)
 def test_name_based_ordering(algorithm):
     """This checks when the size and conlicts are same a stable result is generated"""
 
@@ -161,7 +164,12 @@ def test_name_based_ordering(algorithm):
 
 @pytest.mark.parametrize(
     ["algorithm", "workspace_size"],
-    [("greedy_by_size", 140), ("greedy_by_conflicts", 140), ("hill_climb", 140)],
+    [
+        ("greedy_by_size", 140),
+        ("greedy_by_conflicts", 140),
+        ("hill_climb", 140),
+        ("hybrid", 140),
+    ],
 )
 def test_linear(algorithm, workspace_size):
     """
@@ -223,7 +231,13 @@ def test_linear(algorithm, workspace_size):
 
 @pytest.mark.parametrize(
     ["algorithm", "workspace_size"],
-    [("greedy_by_size", 190), ("greedy_by_conflicts", 320), ("hill_climb", 190)],
+    [
+        ("greedy_by_size", 190),
+        ("greedy_by_conflicts", 320),
+        ("hill_climb", 190),
+        # hybrid makes the conflicts symmetric: bi_b, bi_c, bi_d and bi_e are live at once
+        ("hybrid", 210),
+    ],
 )
 def test_fanout(algorithm, workspace_size):
     """
@@ -292,6 +306,113 @@ def test_fanout(algorithm, workspace_size):
     _check_max_workspace_size(buffer_pool_allocations, global_workspace_pool, workspace_size)
 
 
+def _check_no_overlap(buffer_pool_allocations):
+    for buffer_info, pool_allocation in buffer_pool_allocations.items():
+        start = pool_allocation.byte_offset
+        end = start + buffer_info.size_bytes
+        for conflict in buffer_info.conflicts:
+            conflict_allocation = buffer_pool_allocations[conflict]
+            if conflict_allocation.pool_info != pool_allocation.pool_info:
+                continue
+            conflict_start = conflict_allocation.byte_offset
+            conflict_end = conflict_start + conflict.size_bytes
+            assert end <= conflict_start or conflict_end <= start
+
+
+def _pool_usage(buffer_pool_allocations, pool_info):
+    usage = 0
+    for buffer_info, pool_allocation in buffer_pool_allocations.items():
+        if pool_allocation.pool_info == pool_info:
+            usage = max(usage, pool_allocation.byte_offset + buffer_info.size_bytes)
+    return usage
+
+
+@pytest.mark.parametrize("time_budget_ms", [0, 10000])
+def test_hybrid_bounded_pools(time_budget_ms):
+    """
+    The buffers of random live ranges are planned in a bounded fast pool first, and in an
+    unbounded slow pool otherwise
+    """
+    target = Target("c")
+    fast_memory_pool = WorkspacePoolInfo(
+        "fast_memory",
+        [target],
+        PoolInfoProperties(size_hint_bytes=2000),
+    )
+    slow_memory_pool = WorkspacePoolInfo("slow_memory", [target])
+    rng = np.random.default_rng(0)
+    buffer_info_arr = []
+    live_ranges = []
+    for i in range(40):
+        start = int(rng.integers(0, 100))
+        live_ranges.append((start, start + int(rng.integers(1, 20))))
+        buffer_info_arr.append(
+            usmp_utils.BufferInfo(
+                name_hint=f"bi_{i}",
+                size_bytes=int(rng.integers(1, 50)) * 16,
+                pool_candidates=[fast_memory_pool, slow_memory_pool],
+            )
+        )
+    for i, buffer_info in enumerate(buffer_info_arr):
+        buffer_info.set_conflicts(
+            [
+                other
+                for j, other in enumerate(buffer_info_arr)
+                if i != j
+                and live_ranges[i][0] < live_ranges[j][1]
+                and live_ranges[j][0] < live_ranges[i][1]
+            ]
+        )
+
+    def total_usage(algorithm):
+        fusmp_algo = tvm.get_global_func(f"tir.usmp.algo.{algorithm}")
+        with tvm.transform.PassContext(config={"tir.usmp.time_budget_ms": time_budget_ms}):
+            buffer_pool_allocations = fusmp_algo(buffer_info_arr, 0)
+        assert len(buffer_pool_allocations) == len(buffer_info_arr)
+        _check_no_overlap(buffer_pool_allocations)
+        fast_usage = _pool_usage(buffer_pool_allocations, fast_memory_pool)
+        assert fast_usage <= 2000
+        return fast_usage + _pool_usage(buffer_pool_allocations, slow_memory_pool)
+
+    assert total_usage("hybrid") <= total_usage("greedy_by_size")
+
+
+
+@pytest.mark.parametrize("algorithm", ["greedy_by_size", "hill_climb", "hybrid"])
+def test_access_frequency_placement(algorithm):
+    """The bounded fast pool is kept for the buffers accessed most per byte"""
+    target = Target("c")
+    fast_memory_pool = WorkspacePoolInfo(
+        "fast_memory",
+        [target],
+        PoolInfoProperties(size_hint_bytes=1000),
+    )
+    slow_memory_pool = WorkspacePoolInfo("slow_memory", [target])
+    pool_candidates = [fast_memory_pool, slow_memory_pool]
+    bi_cold = usmp_utils.BufferInfo(
+        name_hint="bi_cold", size_bytes=800, pool_candidates=pool_candidates, access_count=10
+    )
+    bi_hot_a = usmp_utils.BufferInfo(
+        name_hint="bi_hot_a", size_bytes=300, pool_candidates=pool_candidates, access_count=10000
+    )
+    bi_hot_b = usmp_utils.BufferInfo(
+        name_hint="bi_hot_b", size_bytes=300, pool_candidates=pool_candidates, access_count=10000
+    )
+    bi_cold.set_conflicts([bi_hot_a, bi_hot_b])
+    bi_hot_a.set_conflicts([bi_cold, bi_hot_b])
+    bi_hot_b.set_conflicts([bi_cold, bi_hot_a])
+    buffer_info_arr = [bi_cold, bi_hot_a, bi_hot_b]
+    tvm.get_global_func("tir.usmp.PrioritizePoolCandidatesByAccessFrequency")(buffer_info_arr)
+    assert list(bi_cold.pool_candidates) == [slow_memory_pool]
+    assert list(bi_hot_a.pool_candidates) == pool_candidates
+
+    fusmp_algo = tvm.get_global_func(f"tir.usmp.algo.{algorithm}")
+    buffer_pool_allocations = fusmp_algo(buffer_info_arr, 0)
+    assert buffer_pool_allocations[bi_cold].pool_info == slow_memory_pool
+    assert buffer_pool_allocations[bi_hot_a].pool_info == fast_memory_pool
+    assert buffer_pool_allocations[bi_hot_b].pool_info == fast_memory_pool
+
+
 # fmt: off
 @tvm.script.ir_module
 class MobilenetStructure:
@@ -207,6 +207,13 @@ def test_linear():
         pool_info.pool_name for pool_info in list(buffer_info_map["sid_8"].pool_candidates)
     ] == ["fast_memory", "slow_memory"]
 
+    # check access counts, with the loads and stores of the callees to their arguments
+    assert buffer_info_map["sid_8"].access_count == 2609152
+    assert buffer_info_map["Conv2dOutput_7"].access_count == 237633536
+    assert buffer_info_map["PaddedInput_7"].access_count == 118171275
+    assert buffer_info_map["tensor_2"].access_count == 4014080
+    assert buffer_info_map["sid_9"].access_count == 307851
+
 
 # fmt: off
 @tvm.script.ir_module
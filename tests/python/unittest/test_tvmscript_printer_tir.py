@@ -246,6 +246,24 @@ for i, j, k in T.grid(128, 128, 128):
     )
 
 
+def test_for_same_name_hint():
+    def _loop(body):
+        return tir.For(tir.Var("i", "int32"), 0, 4, tir.ForKind.SERIAL, body)
+
+    obj = _loop(tir.SeqStmt([_loop(_loop(tir.Evaluate(0))), _loop(tir.Evaluate(0))]))
+    # The suffixes freed by the first inner loops are reused
+    _assert_print(
+        obj,
+        """
+for i in range(4):
+    for i_1, i_2 in T.grid(4, 4):
+        T.evaluate(0)
+    for i_1 in range(4):
+        T.evaluate(0)
+""",
+    )
+
+
 def test_let_stmt():
     with IRBuilder() as ib:
         with T.LetStmt(T.float32(10)) as v:
@@ -60,7 +60,9 @@ class VTADeviceAPI final : public DeviceAPI {
     VTABufferCopy(from, from_offset, to, to_offset, size, kind_mask);
   }
 
-  void StreamSync(Device dev, TVMStreamHandle stream) final {}
+  void StreamSync(Device dev, TVMStreamHandle stream) final {
+    VTACommandSync(VTATLSCommandHandle());
+  }
 
   void* AllocWorkspace(Device dev, size_t size, DLDataType type_hint) final;
 
@@ -35,11 +35,13 @@
 
 #include <algorithm>
 #include <cassert>
+#include <condition_variable>
 #include <cstring>
 #include <memory>
 #include <mutex>
 #include <set>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace vta {
@@ -514,6 +516,9 @@ class UopQueue : public BaseQueue<VTAUop> {
   void ReadBarrier() {
     CHECK(fpga_buff_ != nullptr);
     CHECK(fpga_buff_phy_);
+    // The FPGA buffer still holds the image of the micro-ops when the same kernels are cached in
+    // the same order as at the last write, e.g. when the same layer is run again.
+    if (cache_ == written_) return;
     // Iterate over caches; allocate buffer in FPGA-readable memory
     uint32_t buff_size = 0;
     for (uint32_t i = 0; i < cache_.size(); ++i) {
@@ -543,6 +548,7 @@ class UopQueue : public BaseQueue<VTAUop> {
     if (!coherent_ && always_cache_) {
       VTAFlushCache(fpga_buff_, fpga_buff_phy_, offset);
     }
+    written_ = cache_;
   }
 
  private:
@@ -550,6 +556,8 @@ class UopQueue : public BaseQueue<VTAUop> {
   uint32_t cache_idx_{0};
   // Cached ring, sorted by sram_begin
   std::vector<UopKernel*> cache_;
+  // The kernels whose micro-ops were last written into the FPGA buffer, in order
+  std::vector<UopKernel*> written_;
   // Constants
   static constexpr int kElemBytes = sizeof(VTAUop);
   static constexpr int kMaxNumUop = VTA_UOP_BUFF_DEPTH;
@@ -584,6 +592,11 @@ enum PipelineStage : int { kNoneStage = 0, kLoadStage = 1, kComputeStage = 2, kS
 template <int kMaxBytes, bool kCoherent, bool kAlwaysCache>
 class InsnQueue : public BaseQueue<VTAGenericInsn> {
  public:
+  ~InsnQueue() {
+    for (auto& kv : stream_cache_) {
+      VTAMemFree(kv.second.fpga_buff);
+    }
+  }
   /*! \brief Initialize the space. */
   void InitSpace() {
     BaseQueue::InitSpace(kElemBytes, kMaxBytes, kCoherent, kAlwaysCache);
@@ -897,6 +910,55 @@ class InsnQueue : public BaseQueue<VTAGenericInsn> {
     return false;
   }
   void AutoReadBarrier() { ReadBarrier(); }
+  /*!
+   * \brief Make the instruction stream visible to VTA through the cache of streams.
+   *
+   *  The streams are kept in FPGA-readable buffers. A stream which only differs from a cached one
+   *  in the DRAM addresses of its loads and stores, e.g. the same kernel run on the same shapes
+   *  with other data buffers, reuses the cached buffer in which only these instructions are
+   *  patched, instead of being copied and flushed again.
+   *
+   * \return The physical address of the stream.
+   */
+  vta_phy_addr_t CachedReadBarrier() {
+    uint64_t key = StreamKey();
+    auto it = stream_cache_.find(key);
+    if (it == stream_cache_.end()) {
+      if (stream_cache_.size() >= kMaxCachedStreams) {
+        ReadBarrier();
+        return dram_phy_addr();
+      }
+      CachedStream stream;
+      uint32_t buff_size = count() * kElemBytes;
+      stream.fpga_buff = static_cast<char*>(VTAMemAlloc(buff_size, coherent_ || always_cache_));
+      CHECK(stream.fpga_buff != nullptr);
+      stream.fpga_buff_phy = VTAMemGetPhyAddr(stream.fpga_buff);
+      stream.insns.assign(dram_buffer_.begin(), dram_buffer_.end());
+      CopyToStream(&stream, 0, count());
+      vta_phy_addr_t phy_addr = stream.fpga_buff_phy;
+      stream_cache_.emplace(key, std::move(stream));
+      return phy_addr;
+    }
+    CachedStream& stream = it->second;
+    if (!SameStream(stream.insns)) {
+      // A collision of the keys, the stream is not cached.
+      ReadBarrier();
+      return dram_phy_addr();
+    }
+    uint32_t begin = count();
+    uint32_t end = 0;
+    for (uint32_t i = 0; i < count(); ++i) {
+      if (memcmp(&stream.insns[i], &dram_buffer_[i], kElemBytes) != 0) {
+        stream.insns[i] = dram_buffer_[i];
+        begin = std::min(begin, i);
+        end = i + 1;
+      }
+    }
+    if (begin < end) {
+      CopyToStream(&stream, begin, end);
+    }
+    return stream.fpga_buff_phy;
+  }
   /*! \brief Writer barrier to make sure that data written by CPU is visible to VTA. */
   void ReadBarrier() {
     CHECK(fpga_buff_ != nullptr);
@@ -986,11 +1048,139 @@ class InsnQueue : public BaseQueue<VTAGenericInsn> {
   }
 
  private:
+  // An instruction stream cached in FPGA-readable memory
+  struct CachedStream {
+    // The instructions in the FPGA buffer
+    std::vector<VTAGenericInsn> insns;
+    // FPGA accessible buffer
+    char* fpga_buff{nullptr};
+    // Physical address of the FPGA buffer
+    vta_phy_addr_t fpga_buff_phy{0};
+  };
+  // The instruction without the DRAM address of a load or a store
+  static VTAGenericInsn MaskAddress(const VTAGenericInsn& insn) {
+    VTAGenericInsn masked = insn;
+    VTAMemInsn* mptr = reinterpret_cast<VTAMemInsn*>(&masked);
+    if (mptr->opcode == VTA_OPCODE_LOAD || mptr->opcode == VTA_OPCODE_STORE) {
+      mptr->dram_base = 0;
+    }
+    return masked;
+  }
+  // The key of the stream in the cache, the FNV-1a hash of its instructions without addresses
+  uint64_t StreamKey() const {
+    uint64_t key = 14695981039346656037ULL;
+    for (const VTAGenericInsn& insn : dram_buffer_) {
+      VTAGenericInsn masked = MaskAddress(insn);
+      uint64_t words[sizeof(VTAGenericInsn) / sizeof(uint64_t)];
+      memcpy(words, &masked, sizeof(words));
+      for (uint64_t word : words) {
+        key = (key ^ word) * 1099511628211ULL;
+      }
+    }
+    return key;
+  }
+  // Whether the stream only differs from the cached instructions in the addresses
+  bool SameStream(const std::vector<VTAGenericInsn>& insns) const {
+    if (insns.size() != dram_buffer_.size()) return false;
+    for (size_t i = 0; i < insns.size(); ++i) {
+      VTAGenericInsn lhs = MaskAddress(insns[i]);
+      VTAGenericInsn rhs = MaskAddress(dram_buffer_[i]);
+      if (memcmp(&lhs, &rhs, kElemBytes) != 0) return false;
+    }
+    return true;
+  }
+  // Copy the instructions [begin, end) of the stream into its FPGA buffer
+  void CopyToStream(CachedStream* stream, uint32_t begin, uint32_t end) {
+    uint32_t offset = begin * kElemBytes;
+    uint32_t size = (end - begin) * kElemBytes;
+    VTAMemCopyFromHost(stream->fpga_buff + offset, &dram_buffer_[begin], size);
+    if (!coherent_ && always_cache_) {
+      VTAFlushCache(stream->fpga_buff + offset, stream->fpga_buff_phy + offset, size);
+    }
+  }
   // Pending pop of each isntruction queue, qid=0 is not used
   int pending_pop_prev_[4];
   int pending_pop_next_[4];
+  // The cached instruction streams
+  std::unordered_map<uint64_t, CachedStream> stream_cache_;
   static constexpr int kElemBytes = sizeof(VTAGenericInsn);
   static constexpr int kMaxElems = kMaxBytes / kElemBytes;
+  // The largest number of cached instruction streams
+  static constexpr size_t kMaxCachedStreams = 64;
+};
+
+/*!
+ * \brief Runs the instruction streams on the device from a worker thread, so that the host builds
+ *  the next stream while the device executes the current one.
+ */
+class AsyncDeviceRunner {
+ public:
+  explicit AsyncDeviceRunner(VTADeviceHandle device)
+      : device_(device), worker_([this]() { this->Loop(); }) {}
+
+  ~AsyncDeviceRunner() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      exit_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+  }
+  // Start running a stream, once the previous one is waited for
+  void Launch(vta_phy_addr_t insn_phy_addr, uint32_t insn_count, uint32_t wait_cycles) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      CHECK(!running_);
+      insn_phy_addr_ = insn_phy_addr;
+      insn_count_ = insn_count;
+      wait_cycles_ = wait_cycles;
+      launched_ = true;
+      running_ = true;
+    }
+    cv_.notify_all();
+  }
+  // Wait for the running stream to finish, and return the time out of its run
+  int Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return !running_; });
+    int timeout = timeout_;
+    timeout_ = 0;
+    return timeout;
+  }
+
+ private:
+  void Loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [this]() { return launched_ || exit_; });
+      if (!launched_) return;
+      launched_ = false;
+      lock.unlock();
+      int timeout = VTADeviceRun(device_, insn_phy_addr_, insn_count_, wait_cycles_);
+      lock.lock();
+      timeout_ = timeout;
+      running_ = false;
+      cv_.notify_all();
+    }
+  }
+
+  // Device handle
+  VTADeviceHandle device_;
+  // The stream to run
+  vta_phy_addr_t insn_phy_addr_{0};
+  uint32_t insn_count_{0};
+  uint32_t wait_cycles_{0};
+  // Whether a stream is launched and not taken by the worker yet
+  bool launched_{false};
+  // Whether a stream is launched and not finished yet
+  bool running_{false};
+  // The time out returned by the last run
+  int timeout_{0};
+  // Whether the worker should exit
+  bool exit_{false};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread worker_;
 };
 
 /*!
@@ -1004,9 +1194,35 @@ class CommandQueue {
     insn_queue_.InitSpace();
     device_ = VTADeviceAlloc();
     CHECK(device_ != nullptr);
+    runner_ = std::make_unique<AsyncDeviceRunner>(device_);
+  }
+
+  ~CommandQueue() {
+    // Nobody is left to report a time out to
+    if (runner_->Wait() != 0) {
+      LOG(WARNING) << "The instruction stream of VTASynchronize #" << num_syncs_ << " timed out";
+    }
+    runner_.reset();
+    VTADeviceFree(device_);
+  }
+
+  // Wait for the instruction stream running on the device. A time out is kept until a
+  // synchronization reports it, so that waiting never throws.
+  void Wait() {
+    int timeout = runner_->Wait();
+    if (timeout != 0 && timeout_sync_ == 0) {
+      timeout_sync_ = num_syncs_;
+    }
   }
 
-  ~CommandQueue() { VTADeviceFree(device_); }
+  // Wait for the instruction stream running on the device, and report its time out
+  void Sync() {
+    this->Wait();
+    uint64_t timeout_sync = timeout_sync_;
+    timeout_sync_ = 0;
+    CHECK_EQ(timeout_sync, 0) << "The instruction stream of VTASynchronize #" << timeout_sync
+                              << " timed out";
+  }
 
   uint32_t GetElemBytes(uint32_t memory_id) {
     uint32_t elem_bytes = 0;
@@ -1116,9 +1332,6 @@ class CommandQueue {
     CHECK(!insn_queue_.PendingPop());
     // Check if there are no instruction to execute at all
     if (insn_queue_.count() == 0) return;
-    // Synchronization for the queues
-    uop_queue_.AutoReadBarrier();
-    insn_queue_.AutoReadBarrier();
     // Dump instructions if debug enabled
     if (debug_flag_ & VTA_DEBUG_DUMP_INSN) {
       insn_queue_.DumpInsn();
@@ -1129,9 +1342,17 @@ class CommandQueue {
 
     // Make sure that we don't exceed contiguous physical memory limits
     CHECK(insn_queue_.count() * sizeof(VTAGenericInsn) <= VTA_MAX_XFER);
-    int timeout =
-        VTADeviceRun(device_, insn_queue_.dram_phy_addr(), insn_queue_.count(), wait_cycles);
-    CHECK_EQ(timeout, 0);
+    // Synchronization for the queues, once the previous stream does not read them anymore
+    this->Sync();
+    uop_queue_.AutoReadBarrier();
+    vta_phy_addr_t insn_phy_addr = insn_queue_.CachedReadBarrier();
+    // The run overlaps with the host building the next stream, the host waits for it before
+    // accessing the data buffers.
+    runner_->Launch(insn_phy_addr, insn_queue_.count(), wait_cycles);
+    ++num_syncs_;
+    if (debug_flag_ & VTA_DEBUG_BLOCKING_RUN) {
+      this->Sync();
+    }
     // Reset buffers
     uop_queue_.Reset();
     insn_queue_.Reset();
@@ -1185,14 +1406,22 @@ class CommandQueue {
   }
 
   static std::shared_ptr<CommandQueue>& ThreadLocal() {
-    static std::shared_ptr<CommandQueue> inst = std::make_shared<CommandQueue>();
+    std::shared_ptr<CommandQueue>& inst = Instance();
     if (inst == nullptr) {
       inst = std::make_shared<CommandQueue>();
     }
     return inst;
   }
 
-  static void Shutdown() { ThreadLocal().reset(); }
+  static void Shutdown() { Instance().reset(); }
+
+  // Wait for the instruction stream running on the device, if the command queue exists
+  static void WaitForDevice() {
+    std::shared_ptr<CommandQueue>& inst = Instance();
+    if (inst != nullptr) {
+      inst->Wait();
+    }
+  }
 
  private:
   // Push GEMM uop to the command buffer
@@ -1294,16 +1523,34 @@ class CommandQueue {
   InsnQueue<VTA_MAX_XFER, kBufferCoherent, kAlwaysCache> insn_queue_;
   // Device handle
   VTADeviceHandle device_{nullptr};
+  // The runner of the instruction streams
+  std::unique_ptr<AsyncDeviceRunner> runner_;
+  // The number of instruction streams launched so far
+  uint64_t num_syncs_{0};
+  // The launch number of the stream which timed out and was not reported yet, or 0
+  uint64_t timeout_sync_{0};
+
+  static std::shared_ptr<CommandQueue>& Instance() {
+    static std::shared_ptr<CommandQueue> inst;
+    return inst;
+  }
 };
 
 }  // namespace vta
 
-void* VTABufferAlloc(size_t size) { return vta::DataBuffer::Alloc(size); }
+void* VTABufferAlloc(size_t size) {
+  vta::CommandQueue::WaitForDevice();
+  return vta::DataBuffer::Alloc(size);
+}
 
-void VTABufferFree(void* buffer) { vta::DataBuffer::Free(vta::DataBuffer::FromHandle(buffer)); }
+void VTABufferFree(void* buffer) {
+  vta::CommandQueue::WaitForDevice();
+  vta::DataBuffer::Free(vta::DataBuffer::FromHandle(buffer));
+}
 
 void VTABufferCopy(const void* from, size_t from_offset, void* to, size_t to_offset, size_t size,
                    int kind_mask) {
+  vta::CommandQueue::WaitForDevice();
   vta::DataBuffer* from_buffer = nullptr;
   vta::DataBuffer* to_buffer = nullptr;
 
@@ -1337,7 +1584,10 @@ void VTASetDebugMode(VTACommandHandle cmd, int debug_flag) {
   static_cast<vta::CommandQueue*>(cmd)->SetDebugFlag(debug_flag);
 }
 
+void VTACommandSync(VTACommandHandle cmd) { static_cast<vta::CommandQueue*>(cmd)->Sync(); }
+
 void* VTABufferCPUPtr(VTACommandHandle cmd, void* buffer) {
+  static_cast<vta::CommandQueue*>(cmd)->Wait();
   auto data_buf = vta::DataBuffer::FromHandle(buffer);
   if (data_buf) {
     return data_buf->virt_addr();
@@ -1348,11 +1598,13 @@ void* VTABufferCPUPtr(VTACommandHandle cmd, void* buffer) {
 
 void VTAWriteBarrier(VTACommandHandle cmd, void* buffer, uint32_t elem_bits, uint32_t start,
                      uint32_t extent) {
+  static_cast<vta::CommandQueue*>(cmd)->Wait();
   static_cast<vta::CommandQueue*>(cmd)->WriteBarrier(buffer, elem_bits, start, extent);
 }
 
 void VTAReadBarrier(VTACommandHandle cmd, void* buffer, uint32_t elem_bits, uint32_t start,
                     uint32_t extent) {
+  static_cast<vta::CommandQueue*>(cmd)->Wait();
   static_cast<vta::CommandQueue*>(cmd)->ReadBarrier(buffer, elem_bits, start, extent);
 }
 
@@ -41,6 +41,7 @@ extern "C" {
 #define VTA_DEBUG_SKIP_READ_BARRIER (1 << 3)
 #define VTA_DEBUG_SKIP_WRITE_BARRIER (1 << 4)
 #define VTA_DEBUG_FORCE_SERIAL (1 << 5)
+#define VTA_DEBUG_BLOCKING_RUN (1 << 6)
 
 #define ALLOC_ALIGNMENT 64
 
@@ -81,6 +82,16 @@ TVM_DLL void VTARuntimeShutdown();
  */
 TVM_DLL VTACommandHandle VTATLSCommandHandle();
 
+/*!
+ * \brief Wait for the instruction stream launched by VTASynchronize to finish on the device.
+ *
+ *  VTASynchronize returns once the stream is launched, so that the host builds the next stream
+ *  meanwhile. The buffer functions wait for the stream before accessing the data. A time out of
+ *  the stream is reported here, or by the next VTASynchronize.
+ * \param cmd The VTA command handle.
+ */
+TVM_DLL void VTACommandSync(VTACommandHandle cmd);
+
 /*!
  * \brief Get the buffer access pointer on CPU.
  * \param cmd The VTA command handle.
@@ -246,8 +257,10 @@ TVM_DLL int VTADepPop(VTACommandHandle cmd, int from_qid, int to_qid);
 
 /*!
  * \brief Synchronize the command handle.
- *  Commit all the instructions to VTA and wait until
- *  the accelerator finishes its job.
+ *  Commit all the instructions to VTA, which run while the
+ *  host builds the next instructions. The host waits until
+ *  the accelerator finishes its job before accessing the data
+ *  buffers, see VTACommandSync.
  *  Perform all of the out-of-order DRAM stores.
  * \param cmd The VTA command handle.
  * \param wait_cycles The limit of poll cycles.
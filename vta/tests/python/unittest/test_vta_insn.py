@@ -559,6 +559,42 @@ def test_runtime_array():
     vta.testing.run(_run)
 
 
+def test_runtime_shutdown_with_running_stream():
+    """Test shutting down the runtime while an instruction stream may still run."""
+
+    def _run(env, remote):
+        if env.TARGET != "sim" or not simulator.LIBS:
+            return
+        n = 6
+        x = te.placeholder((n, n, env.BATCH, env.BLOCK_OUT), name="x", dtype=env.acc_dtype)
+        x_buf = te.compute((n, n, env.BATCH, env.BLOCK_OUT), lambda *i: x(*i), "x_buf")
+        y_buf = te.compute((n, n, env.BATCH, env.BLOCK_OUT), lambda *i: x_buf(*i) >> 0, "y_buf")
+        y = te.compute(
+            (n, n, env.BATCH, env.BLOCK_OUT), lambda *i: y_buf(*i).astype(env.inp_dtype), "y"
+        )
+        s = te.create_schedule(y.op)
+        s[x_buf].set_scope(env.acc_scope)
+        s[x_buf].pragma(x_buf.op.axis[0], env.dma_copy)
+        s[y_buf].set_scope(env.acc_scope)
+        s[y_buf].pragma(y_buf.op.axis[0], env.alu)
+        s[y].pragma(y.op.axis[0], env.dma_copy)
+        with vta.build_config():
+            f = vta.build(s, [x, y], tvm.target.Target("ext_dev", host=env.target_host))
+
+        dev = remote.ext_dev(0)
+        for _ in range(2):
+            x_np = np.random.randint(1, 10, size=(n, n, env.BATCH, env.BLOCK_OUT)).astype(x.dtype)
+            x_nd = tvm.nd.array(x_np, dev)
+            y_nd = tvm.nd.empty(x_np.shape, device=dev, dtype=y.dtype)
+            f(x_nd, y_nd)
+            # The command queue waits for the launched stream when destroyed, and is recreated
+            # by the next call.
+            simulator.LIBS[0].VTARuntimeShutdown()
+            np.testing.assert_equal(x_np.astype(y.dtype), y_nd.numpy())
+
+    vta.testing.run(_run)
+
+
 if __name__ == "__main__":
     test_runtime_array()
     test_save_load_out()
@@ -567,3 +603,4 @@ if __name__ == "__main__":
     test_alu()
     test_relu()
     test_shift_and_scale()
+    test_runtime_shutdown_with_running_stream()
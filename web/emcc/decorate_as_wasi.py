@@ -35,8 +35,13 @@ if (typeof module !== "undefined" && module.exports) {
 """
 
 if __name__ == "__main__":
-    if len(sys.argv) != 3:
-        print("Usage <file-in> <file-out>")
-    result = template_head + open(sys.argv[1]).read() + template_tail
+    if len(sys.argv) not in (3, 4) or (len(sys.argv) == 4 and sys.argv[3] != "--pthread"):
+        print("Usage <file-in> <file-out> [--pthread]")
+    if len(sys.argv) == 4:
+        # The Web Workers of the pthreads load the same script, which has to set up the
+        # emscripten Module in their global scope, so the emcc generated js stays at the top.
+        result = open(sys.argv[1]).read() + template_head + template_tail
+    else:
+        result = template_head + open(sys.argv[1]).read() + template_tail
     with open(sys.argv[2], "w") as fo:
         fo.write(result)
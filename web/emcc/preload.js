@@ -29,13 +29,19 @@ function __wasmLibInstantiateWasm(imports, successCallback) {
     __wasmLib.successCallback = successCallback;
 }
 
-function __wasmLibStart(wasmInstance) {
-    __wasmLib.successCallback(wasmInstance);
+function __wasmLibStart(wasmInstance, wasmModule) {
+    // The pthreads post the module to their Web Workers.
+    __wasmLib.successCallback(wasmInstance, wasmModule);
 }
 
 __wasmLib.start = __wasmLibStart;
 
-var Module = {
-    "instantiateWasm": __wasmLibInstantiateWasm,
-    "wasmLibraryProvider": __wasmLib
-};
+// The Web Worker of a pthread sets up Module to instantiate the module and the memory
+// of the main thread before loading this script, keep it as is.
+var __wasmLibIsPThread = Module["ENVIRONMENT_IS_PTHREAD"] ||
+    (typeof importScripts === "function" && self.name === "em-pthread");
+
+if (!__wasmLibIsPThread) {
+    Module["instantiateWasm"] = __wasmLibInstantiateWasm;
+    Module["wasmLibraryProvider"] = __wasmLib;
+}
@@ -50,10 +50,16 @@
 #include "src/runtime/rpc/rpc_module.cc"
 #include "src/runtime/rpc/rpc_session.cc"
 #include "src/runtime/system_library.cc"
+#include "src/runtime/trace_recorder.cc"
 #include "src/runtime/workspace_pool.cc"
 
 // --- Implementations of backend and wasm runtime API. ---
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+// The thread pool runs on the Web Workers of the emscripten pthreads.
+#include "src/runtime/thread_pool.cc"
+#include "src/runtime/threading_backend.cc"
+#else
 int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task) {
   TVMParallelGroupEnv env;
   env.num_task = 1;
@@ -62,6 +68,7 @@ int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_ta
 }
 
 int TVMBackendParallelBarrier(int task_id, TVMParallelGroupEnv* penv) { return 0; }
+#endif
 
 // --- Environment PackedFuncs for testing ---
 namespace tvm {
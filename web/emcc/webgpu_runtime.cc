@@ -155,6 +155,13 @@ class WebGPUModuleNode final : public runtime::ModuleNode {
     auto* fp = tvm::runtime::Registry::Get("wasm.WebGPUCreateShader");
     CHECK(fp != nullptr);
     create_shader_ = *fp;
+    // Start compiling all the shaders in the background, so that the first call of each
+    // function does not wait for the compilation of its pipeline.
+    if (auto* fprecompile = tvm::runtime::Registry::Get("wasm.WebGPUPrecompileShader")) {
+      for (const auto& kv : smap_) {
+        (*fprecompile)(GetFunctionInfoJSON(kv.first), kv.second);
+      }
+    }
   }
 
   const char* type_key() const final { return "webgpu"; }
@@ -162,12 +169,7 @@ class WebGPUModuleNode final : public runtime::ModuleNode {
   PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
     auto it = smap_.find(name);
     if (it != smap_.end()) {
-      FunctionInfo info = fmap_.at(name);
-      info.name = name;
-      std::ostringstream os;
-      dmlc::JSONWriter writer(&os);
-      info.Save(&writer);
-      return create_shader_(os.str(), it->second);
+      return create_shader_(GetFunctionInfoJSON(name), it->second);
     } else {
       return PackedFunc(nullptr);
     }
@@ -185,6 +187,16 @@ class WebGPUModuleNode final : public runtime::ModuleNode {
   }
 
  private:
+  // Get the function information of a shader, in the json expected by the js side.
+  std::string GetFunctionInfoJSON(const std::string& name) {
+    FunctionInfo info = fmap_.at(name);
+    info.name = name;
+    std::ostringstream os;
+    dmlc::JSONWriter writer(&os);
+    info.Save(&writer);
+    return os.str();
+  }
+
   // function information table.
   std::unordered_map<std::string, std::string> smap_;
   // function information table.
@@ -873,7 +873,7 @@ export class Instance implements Disposable {
       wasmInstance = new WebAssembly.Instance(wasmModule, env.imports);
     }
 
-    env.start(wasmInstance);
+    env.start(wasmInstance, wasmModule);
     this.env = env;
     this.lib = new FFILibrary(wasmInstance, env.imports);
     this.memory = this.lib.memory;
@@ -1370,6 +1370,9 @@ export class Instance implements Disposable {
     this.registerFunc("wasm.WebGPUCreateShader", (info: string, code: string) => {
       return webGPUContext.createShader(info, code);
     });
+    this.registerFunc("wasm.WebGPUPrecompileShader", (info: string, code: string) => {
+      webGPUContext.precompileShader(info, code);
+    });
     this.registerAsyncServerFunc("wasm.WebGPUWaitForTasks", async () => {
       await webGPUContext.sync();
     });
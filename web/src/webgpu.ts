@@ -42,6 +42,19 @@ interface FunctionInfo {
   launch_param_tags: Array<string>;
 }
 
+/** A compiled compute pipeline and the layout of its arguments. */
+interface PipelineEntry {
+  bindGroupLayout: GPUBindGroupLayout;
+  pipeline: GPUComputePipeline;
+  /** The bind groups of the launches, keyed by their buffers. */
+  bindGroupTable: Map<string, GPUBindGroup>;
+}
+
+/** The maximum number of kernel launches recorded before they are submitted. */
+const kMaxPendingDispatches = 128;
+/** The maximum number of bind groups cached per shader. */
+const kMaxCachedBindGroups = 64;
+
 /**
  * WebGPU context
  * Manages all the webgpu resources here.
@@ -55,6 +68,13 @@ export class WebGPUContext {
   private bufferTableFreeId: Array<number> = [];
   private pendingRead: Promise<void> = Promise.resolve();
   private numPendingReads = 0;
+  // The encoder recording the pending work, submitted together on flush.
+  private pendingEncoder?: GPUCommandEncoder = undefined;
+  private pendingComputePass?: GPUComputePassEncoder = undefined;
+  private numPendingDispatches = 0;
+  // The compiled pipelines, keyed by the shader code.
+  private pipelineTable: Map<string, PipelineEntry> = new Map();
+  private pendingPipelines: Array<Promise<void>> = [];
 
   constructor(memory: Memory, device: GPUDevice) {
     this.memory = memory;
@@ -65,6 +85,7 @@ export class WebGPUContext {
    * Wait for all pending GPU tasks to complete
    */
   async sync(): Promise<void> {
+    this.flush();
     if (this.numPendingReads != 0) {
       await Promise.all([
         this.device.queue.onSubmittedWorkDone(),
@@ -76,43 +97,79 @@ export class WebGPUContext {
   }
 
   /**
-   * Create a PackedFunc that runs the given shader
+   * Wait for the shaders compiled in the background to be ready.
+   */
+  async waitForPipelines(): Promise<void> {
+    while (this.pendingPipelines.length != 0) {
+      const pending = this.pendingPipelines;
+      this.pendingPipelines = [];
+      await Promise.all(pending);
+    }
+  }
+
+  /**
+   * Submit the pending work to the queue.
+   */
+  flush(): void {
+    if (this.pendingEncoder === undefined) return;
+    this.endComputePass();
+    const command = this.pendingEncoder.finish();
+    this.pendingEncoder = undefined;
+    this.numPendingDispatches = 0;
+    this.device.queue.submit([command]);
+  }
+
+  /**
+   * Compile the pipeline of a shader in the background,
+   * so that a later createShader of the same shader does not wait for it.
    *
    * @param info The function information in json.
    * @param code The shader data(in WGSL)
    */
-  createShader(info: string, code: string): Function {
+  precompileShader(info: string, code: string): void {
     const finfo = JSON.parse(info);
-    const layoutEntries: Array<GPUBindGroupLayoutEntry> = [];
-    for (let i = 0; i < finfo.arg_types.length; ++i) {
-      const dtype = finfo.arg_types[i];
-      if (dtype == "handle") {
-        layoutEntries.push({
-          binding: i,
-          visibility: GPUShaderStage.COMPUTE,
-          buffer :  {
-            type: "storage"
-          }
+    const key = this.pipelineKey(finfo, code);
+    if (this.pipelineTable.has(key)) return;
+    const bindGroupLayout = this.createBindGroupLayout(finfo);
+    const pending = this.device.createComputePipelineAsync(
+      this.pipelineDescriptor(bindGroupLayout, code)
+    ).then((pipeline: GPUComputePipeline) => {
+      if (!this.pipelineTable.has(key)) {
+        this.pipelineTable.set(key, {
+          bindGroupLayout: bindGroupLayout,
+          pipeline: pipeline,
+          bindGroupTable: new Map()
         });
-      } else {
-        throw new Error("Cannot handle argument type " + dtype + " in WebGPU shader");
       }
-    }
-    const bindGroupLayout = this.device.createBindGroupLayout({
-      entries: layoutEntries
     });
+    this.pendingPipelines.push(pending);
+  }
 
-    const pipeline = this.device.createComputePipeline({
-      layout: this.device.createPipelineLayout({
-        bindGroupLayouts: [ bindGroupLayout ]
-      }),
-      compute: {
-        module: this.device.createShaderModule({
-          code: code
-        }),
-        entryPoint: "main"
-      }
-    });
+  /**
+   * Create a PackedFunc that runs the given shader
+   *
+   * @param info The function information in json.
+   * @param code The shader data(in WGSL)
+   */
+  createShader(info: string, code: string): Function {
+    const finfo = JSON.parse(info);
+    const key = this.pipelineKey(finfo, code);
+    let entry = this.pipelineTable.get(key);
+    if (entry === undefined) {
+      const bindGroupLayout = this.createBindGroupLayout(finfo);
+      entry = {
+        bindGroupLayout: bindGroupLayout,
+        pipeline: this.device.createComputePipeline(
+          this.pipelineDescriptor(bindGroupLayout, code)
+        ),
+        bindGroupTable: new Map()
+      };
+      this.pipelineTable.set(key, entry);
+    }
+    const bindGroupLayout = entry.bindGroupLayout;
+    const pipeline = entry.pipeline;
+    const bindGroupTable = entry.bindGroupTable;
+    const numBufferArgs = finfo.arg_types.length;
 
     const dispatchToDim: Array<number> = [];
 
@@ -132,33 +189,41 @@ export class WebGPUContext {
     }
 
     const submitShader = (...args: Array<GPUPointer | number>): void => {
-      const commandEncoder = this.device.createCommandEncoder();
-      const compute = commandEncoder.beginComputePass();
-      compute.setPipeline(pipeline);
-      const bindGroupEntries: Array<GPUBindGroupEntry> = [];
-      assert(args.length == layoutEntries.length + dispatchToDim.length);
-
-      for (let i = 0; i < layoutEntries.length; ++i) {
-        bindGroupEntries.push({
-          binding: i,
-          resource: {
-            buffer: this.gpuBufferFromPtr(args[i])
-          }
+      assert(args.length == numBufferArgs + dispatchToDim.length);
+      // The bind group is reused when the shader is launched again with the same buffers.
+      const bindGroupKey = args.slice(0, numBufferArgs).join(",");
+      let bindGroup = bindGroupTable.get(bindGroupKey);
+      if (bindGroup === undefined) {
+        const bindGroupEntries: Array<GPUBindGroupEntry> = [];
+        for (let i = 0; i < numBufferArgs; ++i) {
+          bindGroupEntries.push({
+            binding: i,
+            resource: {
+              buffer: this.gpuBufferFromPtr(args[i])
+            }
+          });
+        }
+        bindGroup = this.device.createBindGroup({
+          layout: bindGroupLayout,
+          entries: bindGroupEntries
         });
+        if (bindGroupTable.size >= kMaxCachedBindGroups) {
+          bindGroupTable.clear();
+        }
+        bindGroupTable.set(bindGroupKey, bindGroup);
       }
-
-      compute.setBindGroup(0, this.device.createBindGroup({
-        layout: bindGroupLayout,
-        entries: bindGroupEntries
-      }));
+      const compute = this.getComputePass();
+      compute.setPipeline(pipeline);
+      compute.setBindGroup(0, bindGroup);
       const wl: Array<number> = [1, 1, 1, 1, 1, 1];
       for (let i = 0; i < dispatchToDim.length; ++i) {
-        wl[dispatchToDim[i]] = args[layoutEntries.length + i];
+        wl[dispatchToDim[i]] = args[numBufferArgs + i];
       }
       compute.dispatchWorkgroups(wl[0], wl[1], wl[2])
-      compute.end()
-      const command = commandEncoder.finish();
-      this.device.queue.submit([command]);
+      this.numPendingDispatches += 1;
+      if (this.numPendingDispatches >= kMaxPendingDispatches) {
+        this.flush();
+      }
     };
 
     return submitShader;
@@ -227,6 +292,11 @@ export class WebGPUContext {
     this.bufferTable[idx] = undefined;
     assert(buffer !== undefined);
     this.bufferTableFreeId.push(idx);
+    // The pending work may use the buffer, and the bind groups refer to it by pointer.
+    this.flush();
+    this.pipelineTable.forEach((entry: PipelineEntry) => {
+      entry.bindGroupTable.clear();
+    });
     buffer.destroy();
   }
 
@@ -236,30 +306,15 @@ export class WebGPUContext {
     toOffset: number,
     nbytes: number
   ): void {
-    // Perhaps it would be more useful to use a staging buffer?
-    const gpuTemp = this.device.createBuffer({
-      mappedAtCreation: true,
-      size: nbytes,
-      usage: GPUBufferUsage.MAP_WRITE | GPUBufferUsage.COPY_SRC
-    });
-
-    const cpuTemp = gpuTemp.getMappedRange();
-
-    const viewU8 = new Uint8Array(cpuTemp);
-    viewU8.set(this.memory.loadRawBytes(from, nbytes));
-    gpuTemp.unmap();
-
-    const copyEncoder = this.device.createCommandEncoder();
-    copyEncoder.copyBufferToBuffer(
-      gpuTemp,
-      0,
+    // The write is ordered after the submitted work, so the pending work is submitted first.
+    this.flush();
+    this.device.queue.writeBuffer(
       this.gpuBufferFromPtr(to),
       toOffset,
+      this.memory.loadRawBytes(from, nbytes),
+      0,
       nbytes
     );
-    const copyCommands = copyEncoder.finish();
-    this.device.queue.submit([copyCommands]);
-    gpuTemp.destroy();
   }
 
   private deviceCopyFromGPU(
@@ -274,16 +329,14 @@ export class WebGPUContext {
       usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST,
     });
 
-    const copyEncoder = this.device.createCommandEncoder();
-    copyEncoder.copyBufferToBuffer(
+    this.getCopyEncoder().copyBufferToBuffer(
       this.gpuBufferFromPtr(from),
       fromOffset,
       gpuTemp,
       0,
       nbytes
     );
-    const copyCommands = copyEncoder.finish();
-    this.device.queue.submit([copyCommands]);
+    this.flush();
 
     this.numPendingReads += 1;
 
@@ -312,16 +365,83 @@ export class WebGPUContext {
     toOffset: number,
     nbytes: number
   ): void {
-    const copyEncoder = this.device.createCommandEncoder();
-    copyEncoder.copyBufferToBuffer(
+    this.getCopyEncoder().copyBufferToBuffer(
       this.gpuBufferFromPtr(from),
       fromOffset,
       this.gpuBufferFromPtr(to),
       toOffset,
       nbytes
     );
-    const copyCommands = copyEncoder.finish();
-    this.device.queue.submit([copyCommands]);
+  }
+
+  private pipelineKey(finfo: FunctionInfo, code: string): string {
+    return finfo.arg_types.length + ":" + code;
+  }
+
+  private createBindGroupLayout(finfo: FunctionInfo): GPUBindGroupLayout {
+    const layoutEntries: Array<GPUBindGroupLayoutEntry> = [];
+    for (let i = 0; i < finfo.arg_types.length; ++i) {
+      const dtype = finfo.arg_types[i];
+      if (dtype == "handle") {
+        layoutEntries.push({
+          binding: i,
+          visibility: GPUShaderStage.COMPUTE,
+          buffer :  {
+            type: "storage"
+          }
+        });
+      } else {
+        throw new Error("Cannot handle argument type " + dtype + " in WebGPU shader");
+      }
+    }
+    return this.device.createBindGroupLayout({
+      entries: layoutEntries
+    });
+  }
+
+  private pipelineDescriptor(
+    bindGroupLayout: GPUBindGroupLayout, code: string
+  ): GPUComputePipelineDescriptor {
+    return {
+      layout: this.device.createPipelineLayout({
+        bindGroupLayouts: [ bindGroupLayout ]
+      }),
+      compute: {
+        module: this.device.createShaderModule({
+          code: code
+        }),
+        entryPoint: "main"
+      }
+    };
+  }
+
+  // Get the encoder of the pending work, which is submitted at the latest when the
+  // current task of the event loop finishes.
+  private getPendingEncoder(): GPUCommandEncoder {
+    if (this.pendingEncoder === undefined) {
+      this.pendingEncoder = this.device.createCommandEncoder();
+      Promise.resolve().then(() => this.flush());
+    }
+    return this.pendingEncoder;
+  }
+
+  private getComputePass(): GPUComputePassEncoder {
+    if (this.pendingComputePass === undefined) {
+      this.pendingComputePass = this.getPendingEncoder().beginComputePass();
+    }
+    return this.pendingComputePass;
+  }
+
+  private getCopyEncoder(): GPUCommandEncoder {
+    this.endComputePass();
+    return this.getPendingEncoder();
+  }
+
+  private endComputePass(): void {
+    if (this.pendingComputePass !== undefined) {
+      this.pendingComputePass.end();
+      this.pendingComputePass = undefined;
+    }
   }
 
   private gpuBufferFromPtr(ptr: GPUPointer): GPUBuffer {